@@ -22,6 +22,8 @@
 #include <ossim/base/ossimTimer.h>
 #include <ossim/base/ossimTrace.h>
 #include <ossim/init/ossimInit.h>
+#include <ossim/parallel/ossimJobStatistics.h>
+#include <ossim/util/ossimChipperServer.h>
 #include <ossim/util/ossimChipperUtil.h>
 
 #include <cstdlib> /* for exit */
@@ -48,6 +50,18 @@ int main(int argc, char* argv[])
    // Initialize ossim stuff, factories, plugin, etc.
    ossimInit::instance()->initialize(ap);
 
+   //---
+   // Server mode: requests on standard in, answers on standard out, so all
+   // notifications go to standard error.
+   //---
+   if ( ap.read("--server") )
+   {
+      ossimSetNotifyStream( &std::cerr );
+      ossimRefPtr<ossimChipperServer> server = new ossimChipperServer;
+      server->serve( std::cin, std::cout );
+      exit(0);
+   }
+
    //---
    // Avoid going on if a global option was consumed by ossimInit::initialize
    // like -V or --version option and the arg count is down to 1.
@@ -76,6 +90,11 @@ int main(int argc, char* argv[])
                << std::setiosflags(ios::fixed)
                << std::setprecision(3)
                << ossimTimer::instance()->time_s() << endl;
+
+            if ( ossimJobStatistics::isEnabled() )
+            {
+               ossimJobStatistics::instance()->print( ossimNotify(ossimNotifyLevel_NOTICE) );
+            }
          }
       }
       catch (const ossimException& e)
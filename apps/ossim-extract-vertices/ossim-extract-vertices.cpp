@@ -20,6 +20,7 @@ using namespace std;
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/init/ossimInit.h>
 #include <ossim/imaging/ossimVertexExtractor.h>
+#include <ossim/base/ossimArgumentParser.h>
 #include <ossim/base/ossimStdOutProgress.h>
 #include <ossim/base/ossimTrace.h>
 
@@ -27,7 +28,12 @@ static ossimTrace traceDebug("extract_vertices:main");
 
 void usage()
 {
-   cout << "\nextract_vertices <image_file> <optional_output_file>"
+   cout << "\nextract_vertices [options] <image_file> <optional_output_file>"
+        << "\nOPTIONS:\n"
+        << "   --coarse-to-fine  Finds the edges on the smallest overview first,\n"
+        << "                     then refines them near those edges at each finer level.\n"
+        << "   --threads <n>     Threads for --coarse-to-fine when the reader allows\n"
+        << "                     concurrent reads. 0 is all cores. (default=1)\n"
         << "\nNOTE:\n"
         << "   Scans the image, extracts vertices and writes results to"
         << " a keyword list.\n"
@@ -47,7 +53,13 @@ int main(int argc, char *argv[])
    
    ossimInit::instance()->initialize(argc, argv);
 
-   if (argc != 2)
+   ossimArgumentParser ap(&argc, argv);
+   bool coarseToFine = ap.read("--coarse-to-fine");
+   std::string threadsString;
+   ossimArgumentParser::ossimParameter threadsParam(threadsString);
+   bool threadsSet = ap.read("--threads", threadsParam);
+
+   if ( (argc != 2) && (argc != 3) )
    {
       usage();
       exit(0);
@@ -109,6 +121,12 @@ int main(int argc, char *argv[])
    // Set the area of interest to the full bounding rect of the source.
    ve->setAreaOfInterest(ih->getBoundingRect(0));
 
+   ve->setCoarseToFineFlag(coarseToFine);
+   if (threadsSet)
+   {
+      ve->setNumberOfThreads(ossimString(threadsString).toUInt32());
+   }
+
    // Add a listener for the percent complete to standard output.
    ossimStdOutProgress prog(0, true);
    ve->addListener(&prog);
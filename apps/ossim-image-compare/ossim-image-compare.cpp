@@ -8,7 +8,7 @@
 //
 // Description: Compares pixel data between two images. Returns with 0 if same or 1 of different.
 //              The input formats can be different -- the pixels are compared after any 
-//              unpacking and decompression. Only R0 is compared.
+//              unpacking and decompression. Only R0 is compared (see ossimImageCompare).
 //
 // $Id: ossim-image-compare.cpp 19753 2011-06-13 15:20:31Z dburken $
 //----------------------------------------------------------------------------
@@ -18,36 +18,22 @@
 #include <ossim/base/ossimConstants.h>
 #include <ossim/base/ossimException.h>
 #include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimRefPtr.h>
 #include <ossim/init/ossimInit.h>
+#include <ossim/imaging/ossimImageCompare.h>
 #include <iostream>
-#include <ossim/imaging/ossimImageHandlerRegistry.h>
-#include <ossim/imaging/ossimImageSourceSequencer.h>
 
 using namespace std;
 
-template <typename T> bool tilesAreDifferent(const ossimImageData* t1, const ossimImageData* t2)
+static void usage(const ossimArgumentParser& ap)
 {
-   ossimIpt size1 = t1->getImageRectangle().size();
-   ossimIpt size2 = t2->getImageRectangle().size();
-   int nbands1 = t1->getNumberOfBands();
-   int nbands2 = t2->getNumberOfBands();
-   if ((size1 != size2) || (nbands1 != nbands2))
-      return true;
-
-   ossim_uint32 num_pixels = (ossim_uint32) (size1.x * size1.y);
-   
-   for (int band=0; band<nbands1; band++)
-   {
-      T* buf1 = (T*) t1->getBuf(band);
-      T* buf2 = (T*) t2->getBuf(band);
-      
-      for ( ossim_uint32 p=0; p<num_pixels; ++p)
-      {
-         if (buf1[p] != buf2[p])
-            return true;
-      }
-   }
-   return false;
+   cout << "\nUsage: "<<ap.getApplicationName()<<" [options] <image1> <image2>"
+        << "\n\nOptions:"
+        << "\n  --equal-only    Stop at the first difference; no statistics."
+        << "\n  --threads <n>   Threads to compare with; default one per core."
+        << "\n  --no-raw        Always decode, even TIFFs of the same layout and compression."
+        << "\n  --stats         Print the differences of each band (image2 - image1)."
+        << endl;
 }
 
 int main(int argc, char *argv[])
@@ -58,91 +44,54 @@ int main(int argc, char *argv[])
 
    try
    {
+      ossimRefPtr<ossimImageCompare> comparator = new ossimImageCompare;
+      unsigned int threads = 0;
+      bool statsFlag = false;
+      if (ap.read("--equal-only"))
+         comparator->setEqualityOnly(true);
+      if (ap.read("--threads", threads))
+         comparator->setNumberOfThreads(threads);
+      if (ap.read("--no-raw"))
+         comparator->setRawCompare(false);
+      if (ap.read("--stats"))
+         statsFlag = true;
+
       if (ap.argc() != 3)
       {
-         cout << "\nUsage: "<<ap.getApplicationName()<<" <image1> <image2>"<<endl;
+         usage(ap);
          return 1;
       }
       
-      ossimFilename f1 (argv[1]);
-      ossimFilename f2 (argv[2]);
+      ossimFilename f1 (ap[1]);
+      ossimFilename f2 (ap[2]);
       cout << "\nComparing <"<<f1<<"> to <"<<f2<<">..."<<endl;
-      // Establish input image handlers:
-      ossimImageHandlerRegistry* registry = ossimImageHandlerRegistry::instance();
-      ossimRefPtr<ossimImageHandler> h1 = registry->open(ossimFilename(argv[1]));
-      if (!h1.valid())
-      {
-         cout<<"  Could not open first image at <"<<argv[1]<<">. Aborting..."<<endl;
-         return 1;
-      }
-      ossimRefPtr<ossimImageHandler> h2 = registry->open(ossimFilename(argv[2]));
-      if (!h1.valid())
+      if (!comparator->compare(f1, f2))
       {
-         cout<<"  Could not open second image at <"<<argv[2]<<">. Aborting..."<<endl;
-         h1->close();
+         cout<<"  Could not compare the images. Aborting..."<<endl;
          return 1;
       }
 
-      // Establish the tile sequencer to loop over all tiles:
-      ossimRefPtr<ossimImageSourceSequencer> sequencer1 = new ossimImageSourceSequencer(h1.get());
-      ossimRefPtr<ossimImageSourceSequencer> sequencer2 = new ossimImageSourceSequencer(h2.get());
-      sequencer1->setToStartOfSequence();
-      sequencer2->setToStartOfSequence();
-      
-      // Begin loop over all tiles, checking them for any non-empty status:
-      int tile_count = 0;
-      bool diff_found = false;
-
-      ossimRefPtr<ossimImageData> tile1 = sequencer1->getNextTile();
-      ossimRefPtr<ossimImageData> tile2 = sequencer2->getNextTile();
-      ossimScalarType stype = tile1->getScalarType();
-      while (tile1.valid() && tile2.valid() && !diff_found)
+      if (statsFlag)
       {
-         switch (stype)
+         cout << "  Samples per band: " << comparator->getNumberOfSamples() << endl;
+         for (ossim_uint32 band = 0; band < comparator->getNumberOfBands(); ++band)
          {
-         case OSSIM_UINT8:
-         case OSSIM_SINT8:
-            diff_found = tilesAreDifferent<ossim_uint8>(tile1.get(), tile2.get());
-            break;
-
-         case OSSIM_UINT16:
-         case OSSIM_SINT16:
-         case OSSIM_USHORT11:
-            diff_found = tilesAreDifferent<ossim_uint16>(tile1.get(), tile2.get());
-            break;
-
-         case OSSIM_UINT32:
-         case OSSIM_SINT32:
-            diff_found = tilesAreDifferent<ossim_uint32>(tile1.get(), tile2.get());
-            break;
-
-         case OSSIM_FLOAT32:
-            diff_found = tilesAreDifferent<ossim_float32>(tile1.get(), tile2.get());
-            break;
-
-         case OSSIM_FLOAT64:
-            diff_found = tilesAreDifferent<ossim_float64>(tile1.get(), tile2.get());
-            break;
-
-         default:
-            cout<<"  This datatype is not supported. Aborting..."<<endl;
-            diff_found = true;
+            cout << "  Band " << band + 1
+                 << ": different=" << comparator->getDifferentSamples(band)
+                 << " min=" << comparator->getMinDifference(band)
+                 << " max=" << comparator->getMaxDifference(band)
+                 << " rmse=" << comparator->getRmsDifference(band) << endl;
          }
-
-         tile1 = sequencer1->getNextTile();
-         tile2 = sequencer2->getNextTile();
-         ++tile_count;
       }
 
-      h1->close();
-      h2->close();
-      
-      if (diff_found)
+      if (!comparator->isEqual())
       {
-         cout << "  DIFFERENCE FOUND AT TILE "<<tile_count<<"."<<endl;
+         // Tiles are counted from 1, as before.
+         cout << "  DIFFERENCE FOUND AT TILE "<<comparator->getDifferentTile() + 1<<"."<<endl;
          return 1;
       }
-      cout << "  No differences found."<<endl;
+      cout << "  No differences found"
+           << (comparator->usedRawCompare() ? " (compressed tiles match)." : ".") << endl;
       return 0;
    }
    catch (const ossimException& e)
@@ -4,43 +4,561 @@
 //
 // Description: Utility to generate custom synthesized image for testing code..
 //
+// With --workload it writes parameterized datasets and the chain definitions
+// to run them, so scalability tests need no proprietary data:
+//
+//   mosaic  Grid of overlapping geographic images plus an ossim-chipper
+//           options keyword list mosaicking them.
+//   rpc     Image with an RPC model (.geom), a DEM covering it and the
+//           chipper options and elevation preferences to ortho it.
+//   chain   Image plus an ossim-orthoigen --chain-template with a
+//           configurable number of filters ahead of the renderer.
+//
+// Pixels are made per tile from the seed, so images of any size are written
+// without holding them in memory and runs are the same on every platform.
+//
 // $Id: ossim-image-synth.cpp 23163 2015-02-23 16:04:05Z okramer $
 //----------------------------------------------------------------------------
 
 #include <ossim/base/ossimArgumentParser.h>
+#include <ossim/base/ossimApplicationUsage.h>
+#include <ossim/base/ossimCommon.h>
 #include <ossim/base/ossimDpt.h>
 #include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimKeywordNames.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimObjectFactoryRegistry.h>
 #include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimScalarTypeLut.h>
+#include <ossim/base/ossimStdOutProgress.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/imaging/ossimImageChain.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageRenderer.h>
+#include <ossim/imaging/ossimImageSource.h>
 #include <ossim/imaging/ossimTiffWriter.h>
 #include <ossim/imaging/ossimMemoryImageSource.h>
 #include <ossim/imaging/ossimImageGeometry.h>
 #include <ossim/init/ossimInit.h>
 #include <ossim/projection/ossimEquDistCylProjection.h>
 #include <ossim/projection/ossimMapProjection.h>
+#include <ossim/projection/ossimRpcModel.h>
 #include <cmath>
+#include <iomanip>
 #include <sstream>
 #include <iostream>
+#include <vector>
 
 using namespace std;
 
-int main(int argc, char *argv[])
+// Center of the synthetic scenes.
+static const double SCENE_LAT = 35.0;
+static const double SCENE_LON = -105.0;
+
+// Heights of the synthetic terrain, meters.
+static const double TERRAIN_BASE      = 1500.0;
+static const double TERRAIN_AMPLITUDE = 800.0;
+
+/** Workload parameters from the command line. */
+struct SynthOptions
 {
-   int returnCode = 0;
-   
-   ossimArgumentParser ap(&argc, argv);
-   ossimInit::instance()->addOptions(ap);
-   ossimInit::instance()->initialize(ap);
-   
-   if ( (ap.argc() < 2) || ap.read("-h") || ap.read("--help") )
+   SynthOptions()
+      : theSize(4096),
+        theCount(4),
+        theOverlap(0.1),
+        theBands(3),
+        theScalar(OSSIM_UINT8),
+        theTileSize(256),
+        theSeed(1),
+        theGsd(1.0),
+        theFilters(4),
+        theFilterTypes()
+   {}
+
+   ossim_uint32           theSize;
+   ossim_uint32           theCount;
+   double                 theOverlap;
+   ossim_uint32           theBands;
+   ossimScalarType        theScalar;
+   ossim_uint32           theTileSize;
+   ossim_uint32           theSeed;
+   double                 theGsd;
+   ossim_uint32           theFilters;
+   std::vector<ossimString> theFilterTypes;
+};
+
+/** Hash of a pixel to [0, 1), the same on every platform. */
+static double hashNoise(ossim_int64 x, ossim_int64 y, ossim_uint32 band, ossim_uint32 seed)
+{
+   ossim_uint64 h = (ossim_uint64)x * 0x9E3779B97F4A7C15ULL;
+   h ^= (ossim_uint64)y * 0xC2B2AE3D27D4EB4FULL;
+   h ^= ((ossim_uint64)band << 32) ^ (ossim_uint64)seed;
+   h ^= h >> 33;
+   h *= 0xFF51AFD7ED558CCDULL;
+   h ^= h >> 33;
+   h *= 0xC4CEB9FE1A85EC53ULL;
+   h ^= h >> 33;
+   return (double)(h >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/** Synthetic terrain height in meters at a ground point. */
+static double terrainHeight(double lat, double lon)
+{
+   // Ridges a few kilometers apart over a slow regional trend.
+   const double U = (lon - SCENE_LON) * 40.0;
+   const double V = (lat - SCENE_LAT) * 40.0;
+   return TERRAIN_BASE +
+      TERRAIN_AMPLITUDE * ( 0.6 * std::sin(U * 3.1) * std::cos(V * 2.3) +
+                            0.3 * std::sin((U + V) * 7.7) + 0.1 * std::cos(U - 2.0 * V) );
+}
+
+/**
+ * Image source making its tiles on demand, so the writers see the same
+ * tiled requests as from a real handler and the size is not bounded by
+ * memory.
+ *
+ * Image content is gradients, blocks and noise keyed to the pixel position
+ * plus theOffset, so overlapping images of a mosaic agree where they overlap.
+ * A terrain source makes one float band of heights of its geometry instead.
+ */
+class ossimSynthImageSource : public ossimImageSource
+{
+public:
+   ossimSynthImageSource(const ossimIpt& size, ossim_uint32 bands, ossimScalarType scalar,
+                         ossim_uint32 seed, const ossimIpt& offset, bool terrainFlag)
+      : ossimImageSource(0, 0, 0, true, false),
+        theSize(size),
+        theBands(terrainFlag ? 1 : bands),
+        theScalar(terrainFlag ? OSSIM_FLOAT32 : scalar),
+        theSeed(seed),
+        theOffset(offset),
+        theTerrainFlag(terrainFlag),
+        theGeometry(0),
+        theTile(0)
+   {}
+
+   virtual ossim_uint32 getNumberOfInputBands() const { return theBands; }
+   virtual ossim_uint32 getNumberOfOutputBands() const { return theBands; }
+   virtual ossimScalarType getOutputScalarType() const { return theScalar; }
+
+   virtual double getNullPixelValue(ossim_uint32 /* band */ = 0) const
    {
-      cout << "\nUsage: "<<ap[0]<<" <filename>\n"<<endl;
-      return 0;
+      return ossim::defaultNull(theScalar);
+   }
+   virtual double getMinPixelValue(ossim_uint32 /* band */ = 0) const
+   {
+      return theTerrainFlag ? (TERRAIN_BASE - TERRAIN_AMPLITUDE) : 1.0;
+   }
+   virtual double getMaxPixelValue(ossim_uint32 /* band */ = 0) const
+   {
+      return theTerrainFlag ? (TERRAIN_BASE + TERRAIN_AMPLITUDE) : getRange();
+   }
+
+   virtual ossimIrect getBoundingRect(ossim_uint32 /* resLevel */ = 0) const
+   {
+      return ossimIrect(0, 0, theSize.x - 1, theSize.y - 1);
+   }
+
+   virtual ossimRefPtr<ossimImageData> getTile(const ossimIrect& rect, ossim_uint32 resLevel = 0)
+   {
+      if ( !isSourceEnabled() || resLevel )
+      {
+         return 0;
+      }
+      if ( !theTile.valid() )
+      {
+         theTile = ossimImageDataFactory::instance()->create(this, this);
+         theTile->initialize();
+      }
+      theTile->setImageRectangle(rect);
+      theTile->makeBlank();
+
+      const ossimIrect CLIP = rect.clipToRect(getBoundingRect());
+      if ( !CLIP.hasNans() && rect.intersects(getBoundingRect()) )
+      {
+         switch (theScalar)
+         {
+            case OSSIM_UINT8:
+               fill(ossim_uint8(0), CLIP);
+               break;
+            case OSSIM_SINT16:
+               fill(ossim_sint16(0), CLIP);
+               break;
+            case OSSIM_USHORT11:
+            case OSSIM_UINT16:
+               fill(ossim_uint16(0), CLIP);
+               break;
+            case OSSIM_FLOAT32:
+            case OSSIM_NORMALIZED_FLOAT:
+               fill(ossim_float32(0), CLIP);
+               break;
+            case OSSIM_FLOAT64:
+            case OSSIM_NORMALIZED_DOUBLE:
+               fill(ossim_float64(0), CLIP);
+               break;
+            default:
+               fill(ossim_uint8(0), CLIP);
+               break;
+         }
+         theTile->validate();
+      }
+      return theTile;
+   }
+
+   virtual bool canConnectMyInputTo(ossim_int32 /* inputIndex */,
+                                    const ossimConnectableObject* /* object */) const
+   {
+      return false;
    }
 
-   ossimFilename filename = ap[1];
-   filename.setExtension(".tif");
+   virtual void initialize()
+   {
+      theTile = 0;
+   }
+
+   virtual ossim_uint32 getNumberOfDecimationLevels() const { return 1; }
+
+   virtual void getDecimationFactor(ossim_uint32 resLevel, ossimDpt& result) const
+   {
+      result.x = result.y = (resLevel == 0) ? 1.0 : 0.0;
+   }
+
+   virtual void getDecimationFactors(std::vector<ossimDpt>& decimations) const
+   {
+      decimations.clear();
+      decimations.push_back(ossimDpt(1.0, 1.0));
+   }
+
+   virtual ossimRefPtr<ossimImageGeometry> getImageGeometry() { return theGeometry; }
+
+   virtual void setImageGeometry(ossimImageGeometry* geom) { theGeometry = geom; }
+
+private:
+   double getRange() const
+   {
+      switch (theScalar)
+      {
+         case OSSIM_UINT8:
+            return 255.0;
+         case OSSIM_FLOAT32:
+         case OSSIM_FLOAT64:
+            return 1000.0;
+         case OSSIM_NORMALIZED_FLOAT:
+         case OSSIM_NORMALIZED_DOUBLE:
+            return 1.0;
+         default:
+            return 2047.0;
+      }
+   }
+
+   template <class T> void fill(T /* dummy */, const ossimIrect& clip)
+   {
+      const ossimIrect TILE_RECT = theTile->getImageRectangle();
+      const ossim_int32 WIDTH = (ossim_int32)TILE_RECT.width();
+      const double RANGE = getRange();
+      const double LOW = (theScalar == OSSIM_NORMALIZED_FLOAT ||
+                          theScalar == OSSIM_NORMALIZED_DOUBLE) ? 0.001 : 1.0;
+
+      for (ossim_uint32 band = 0; band < theBands; ++band)
+      {
+         T* buf = static_cast<T*>(theTile->getBuf(band));
+         for (ossim_int32 y = clip.ul().y; y <= clip.lr().y; ++y)
+         {
+            T* row = buf + (y - TILE_RECT.ul().y) * WIDTH - TILE_RECT.ul().x;
+            for (ossim_int32 x = clip.ul().x; x <= clip.lr().x; ++x)
+            {
+               double v;
+               if (theTerrainFlag)
+               {
+                  v = terrainAt(x, y);
+               }
+               else
+               {
+                  v = LOW + (RANGE - LOW) * pattern(x + theOffset.x, y + theOffset.y, band);
+               }
+               row[x] = (T)v;
+            }
+         }
+      }
+   }
+
+   /** Image content in [0, 1] at a pixel of the whole scene. */
+   double pattern(ossim_int64 x, ossim_int64 y, ossim_uint32 band) const
+   {
+      // Blocks of 64 pixels at random levels stand in for fields and roofs,
+      // waves for texture and the noise for sensor noise.
+      const double BLOCK = hashNoise(x >> 6, y >> 6, band, theSeed);
+      const double WAVE  = 0.5 + 0.5 * std::sin(0.013 * x * (band + 1) + 0.021 * y);
+      const double NOISE = hashNoise(x, y, band, theSeed + 1);
+      return 0.5 * BLOCK + 0.3 * WAVE + 0.2 * NOISE;
+   }
+
+   double terrainAt(ossim_int32 x, ossim_int32 y) const
+   {
+      ossimGpt gpt;
+      if ( theGeometry.valid() )
+      {
+         theGeometry->localToWorld(ossimDpt(x, y), gpt);
+      }
+      return terrainHeight(gpt.lat, gpt.lon);
+   }
+
+   ossimIpt                         theSize;
+   ossim_uint32                     theBands;
+   ossimScalarType                  theScalar;
+   ossim_uint32                     theSeed;
+   ossimIpt                         theOffset;
+   bool                             theTerrainFlag;
+   ossimRefPtr<ossimImageGeometry>  theGeometry;
+   ossimRefPtr<ossimImageData>      theTile;
+};
+
+/** Geographic geometry of size pixels with the upper left at ul. */
+static ossimRefPtr<ossimImageGeometry> createGeographicGeometry(const ossimGpt& ul,
+                                                                 const ossimDpt& degPerPixel,
+                                                                 const ossimIpt& size)
+{
+   ossimRefPtr<ossimEquDistCylProjection> proj = new ossimEquDistCylProjection();
+   proj->setOrigin(ossimGpt(SCENE_LAT, SCENE_LON));
+   proj->setDecimalDegreesPerPixel(degPerPixel);
+   proj->setElevationLookupFlag(false);
+   proj->setUlTiePoints(ul);
+   ossimRefPtr<ossimImageGeometry> geom = new ossimImageGeometry(0, proj.get());
+   geom->setImageSize(size);
+   return geom;
+}
+
+/** Degrees per pixel of gsd meters at the scene latitude. */
+static ossimDpt degreesPerPixel(double gsd)
+{
+   const double METERS_PER_DEGREE = 111319.49;
+   return ossimDpt(gsd / (METERS_PER_DEGREE * ossim::cosd(SCENE_LAT)),
+                   gsd / METERS_PER_DEGREE);
+}
+
+static bool writeSource(ossimSynthImageSource* source, const ossimFilename& file,
+                        const SynthOptions& options, bool geotiffFlag)
+{
+   cout << "Writing " << file << "..." << endl;
+
+   ossimRefPtr<ossimTiffWriter> writer = new ossimTiffWriter();
+   writer->connectMyInputTo(0, source);
+   writer->setFilename(file);
+   writer->setTileSize(ossimIpt(options.theTileSize, options.theTileSize));
+   writer->setGeotiffFlag(geotiffFlag);
+   writer->setWriteExternalGeometryFlag(!geotiffFlag);
+   writer->addListener(&theStdOutProgress);
+   bool status = writer->execute();
+   writer->removeListener(&theStdOutProgress);
+   writer->disconnect();
+   if (!status)
+   {
+      cerr << "Failed writing " << file << endl;
+   }
+   return status;
+}
 
+static bool writeKeywordlist(const ossimKeywordlist& kwl, const ossimFilename& file)
+{
+   cout << "Writing " << file << endl;
+   bool status = kwl.write(file.c_str());
+   if (!status)
+   {
+      cerr << "Failed writing " << file << endl;
+   }
+   return status;
+}
+
+/** Chipper options mosaicking images to a geographic output. */
+static void addChipperOptions(ossimKeywordlist& kwl, const std::vector<ossimFilename>& images,
+                              const ossimFilename& output)
+{
+   kwl.add("operation", "ortho");
+   kwl.add(ossimKeywordNames::PROJECTION_KW, "geo-scaled");
+   kwl.add("resampler_filter", "bilinear");
+   for (ossim_uint32 i = 0; i < images.size(); ++i)
+   {
+      std::string prefix = "image" + ossimString::toString(i).string() + ".";
+      kwl.add(prefix.c_str(), "file", images[i].c_str());
+   }
+   kwl.add(ossimKeywordNames::OUTPUT_FILE_KW, output.c_str());
+}
+
+/**
+ * Writes options.theCount images on a grid overlapping by options.theOverlap
+ * and mosaic.kwl, the ossim-chipper options to mosaic them.
+ */
+static bool writeMosaicWorkload(const ossimFilename& dir, const SynthOptions& options)
+{
+   const ossim_uint32 COLS = (ossim_uint32)std::ceil(std::sqrt((double)options.theCount));
+   const ossim_uint32 STEP = (ossim_uint32)(options.theSize * (1.0 - options.theOverlap));
+   const ossimDpt DPP = degreesPerPixel(options.theGsd);
+   const ossimIpt SIZE(options.theSize, options.theSize);
+
+   std::vector<ossimFilename> images;
+   bool status = true;
+   for (ossim_uint32 i = 0; status && (i < options.theCount); ++i)
+   {
+      const ossimIpt OFFSET((i % COLS) * STEP, (i / COLS) * STEP);
+      const ossimGpt UL(SCENE_LAT - OFFSET.y * DPP.y, SCENE_LON + OFFSET.x * DPP.x);
+
+      ostringstream name;
+      name << "mosaic_" << setw(3) << setfill('0') << i << ".tif";
+      ossimFilename file = dir.dirCat(ossimFilename(name.str()));
+
+      ossimRefPtr<ossimSynthImageSource> source =
+         new ossimSynthImageSource(SIZE, options.theBands, options.theScalar, options.theSeed,
+                                   OFFSET, false);
+      source->setImageGeometry(createGeographicGeometry(UL, DPP, SIZE).get());
+      status = writeSource(source.get(), file, options, true);
+      images.push_back(file);
+   }
+
+   if (status)
+   {
+      ossimKeywordlist kwl;
+      addChipperOptions(kwl, images, dir.dirCat(ossimFilename("mosaic_output.tif")));
+      status = writeKeywordlist(kwl, dir.dirCat(ossimFilename("mosaic.kwl")));
+      cout << "\nRun: ossim-chipper --options " << dir.dirCat(ossimFilename("mosaic.kwl"))
+           << endl;
+   }
+   return status;
+}
+
+/**
+ * Writes rpc.tif with an RPC model in rpc.geom, a DEM over it in dem/, the
+ * ossim-chipper options rpc.kwl to ortho it on the DEM and
+ * rpc_elevation.kwl, preferences with the DEM directory for the other
+ * applications.
+ */
+static bool writeRpcWorkload(const ossimFilename& dir, const SynthOptions& options)
+{
+   const ossimIpt SIZE(options.theSize, options.theSize);
+   const ossimDpt DPP = degreesPerPixel(options.theGsd);
+   const double HALF = options.theSize / 2.0;
+
+   // Sample from longitude, line from latitude, with cross and height terms
+   // so the model is not trivial and the DEM moves the pixels.
+   std::vector<double> sNum(20, 0.0), sDen(20, 0.0), lNum(20, 0.0), lDen(20, 0.0);
+   sNum[1] = 1.0;  sNum[2] = 0.01;  sNum[3] = 0.02;  sNum[4] = 0.001;
+   lNum[2] = -1.0; lNum[1] = 0.01;  lNum[3] = -0.02; lNum[7] = 0.001;
+   sDen[0] = 1.0;  sDen[1] = 0.0005;
+   lDen[0] = 1.0;  lDen[2] = 0.0005;
+   ossimRefPtr<ossimRpcModel> rpc = new ossimRpcModel();
+   rpc->setAttributes(HALF, HALF, HALF, HALF,
+                      SCENE_LAT, SCENE_LON, TERRAIN_BASE,
+                      HALF * DPP.y, HALF * DPP.x, TERRAIN_AMPLITUDE,
+                      sNum, sDen, lNum, lDen);
+   rpc->setImageSize(ossimDpt(SIZE));
+   ossimRefPtr<ossimImageGeometry> geom = new ossimImageGeometry(0, rpc.get());
+   geom->setImageSize(SIZE);
+
+   const ossimFilename IMAGE = dir.dirCat(ossimFilename("rpc.tif"));
+   ossimRefPtr<ossimSynthImageSource> source =
+      new ossimSynthImageSource(SIZE, options.theBands, options.theScalar, options.theSeed,
+                                ossimIpt(0, 0), false);
+   source->setImageGeometry(geom.get());
+   bool status = writeSource(source.get(), IMAGE, options, false);
+
+   // DEM of about 30 meter posts over the footprint plus a margin for the
+   // cross and height terms.
+   const ossimFilename DEM_DIR = dir.dirCat(ossimFilename("dem"));
+   const ossimFilename DEM = DEM_DIR.dirCat(ossimFilename("dem.tif"));
+   if (status)
+   {
+      status = DEM_DIR.createDirectory();
+   }
+   if (status)
+   {
+      const double MARGIN = 1.5;
+      const ossimDpt DEM_DPP = degreesPerPixel(30.0);
+      const ossimIpt DEM_SIZE(
+         (ossim_int32)std::ceil(2.0 * MARGIN * HALF * DPP.x / DEM_DPP.x) + 1,
+         (ossim_int32)std::ceil(2.0 * MARGIN * HALF * DPP.y / DEM_DPP.y) + 1);
+      const ossimGpt UL(SCENE_LAT + MARGIN * HALF * DPP.y, SCENE_LON - MARGIN * HALF * DPP.x);
+      ossimRefPtr<ossimSynthImageSource> dem =
+         new ossimSynthImageSource(DEM_SIZE, 1, OSSIM_FLOAT32, options.theSeed,
+                                   ossimIpt(0, 0), true);
+      dem->setImageGeometry(createGeographicGeometry(UL, DEM_DPP, DEM_SIZE).get());
+      status = writeSource(dem.get(), DEM, options, true);
+   }
+
+   if (status)
+   {
+      ossimKeywordlist kwl;
+      std::vector<ossimFilename> images(1, IMAGE);
+      addChipperOptions(kwl, images, dir.dirCat(ossimFilename("rpc_ortho.tif")));
+      kwl.add("dem0.", "file", DEM.c_str());
+      status = writeKeywordlist(kwl, dir.dirCat(ossimFilename("rpc.kwl")));
+   }
+   if (status)
+   {
+      ossimKeywordlist prefs;
+      prefs.add("elevation_manager.elevation_source0.", "type", "image_directory");
+      prefs.add("elevation_manager.elevation_source0.", "connection_string", DEM_DIR.c_str());
+      prefs.add("elevation_manager.elevation_source0.", "enabled", "true");
+      prefs.add("elevation_manager.elevation_source0.", "min_open_cells", "5");
+      prefs.add("elevation_manager.elevation_source0.", "max_open_cells", "25");
+      status = writeKeywordlist(prefs, dir.dirCat(ossimFilename("rpc_elevation.kwl")));
+      cout << "\nRun: ossim-chipper --options " << dir.dirCat(ossimFilename("rpc.kwl"))
+           << "\n or: ossim-orthoigen -P " << dir.dirCat(ossimFilename("rpc_elevation.kwl"))
+           << " --threads <n> " << IMAGE << " " << dir.dirCat(ossimFilename("rpc_ortho.tif"))
+           << endl;
+   }
+   return status;
+}
+
+/**
+ * Writes chain.tif and chain.kwl, an ossim-orthoigen chain template of
+ * options.theFilters filters, cycling through options.theFilterTypes, ahead
+ * of the renderer.
+ */
+static bool writeChainWorkload(const ossimFilename& dir, const SynthOptions& options)
+{
+   const ossimIpt SIZE(options.theSize, options.theSize);
+   const ossimDpt DPP = degreesPerPixel(options.theGsd);
+   const ossimGpt UL(SCENE_LAT, SCENE_LON);
+
+   // Build the chain for its saveState, which is what the template loads.
+   ossimRefPtr<ossimImageChain> chain = new ossimImageChain();
+   for (ossim_uint32 i = 0; i < options.theFilters; ++i)
+   {
+      const ossimString& TYPE = options.theFilterTypes[i % options.theFilterTypes.size()];
+      ossimRefPtr<ossimObject> obj = ossimObjectFactoryRegistry::instance()->createObject(TYPE);
+      ossimImageSource* filter = dynamic_cast<ossimImageSource*>(obj.get());
+      if (!filter)
+      {
+         cerr << "Unknown filter type: " << TYPE << endl;
+         return false;
+      }
+      chain->addChild(filter); // Each new child is the output of the previous.
+   }
+   chain->addChild(new ossimImageRenderer());
+
+   const ossimFilename IMAGE = dir.dirCat(ossimFilename("chain.tif"));
+   ossimRefPtr<ossimSynthImageSource> source =
+      new ossimSynthImageSource(SIZE, options.theBands, options.theScalar, options.theSeed,
+                                ossimIpt(0, 0), false);
+   source->setImageGeometry(createGeographicGeometry(UL, DPP, SIZE).get());
+   bool status = writeSource(source.get(), IMAGE, options, true);
+
+   if (status)
+   {
+      ossimKeywordlist kwl;
+      chain->saveState(kwl, "object1.");
+      status = writeKeywordlist(kwl, dir.dirCat(ossimFilename("chain.kwl")));
+      cout << "\nRun: ossim-orthoigen --threads <n> --chain-template "
+           << dir.dirCat(ossimFilename("chain.kwl")) << " " << IMAGE << " "
+           << dir.dirCat(ossimFilename("chain_output.tif")) << endl;
+   }
+   return status;
+}
+
+/** The original 512 x 512 float test pattern of noisy, inclined and flat tiles. */
+static bool writeTestPattern(const ossimFilename& filename)
+{
    // Set the destination image size:
    ossimIpt image_size (512 , 512);
    ossimRefPtr<ossimImageData> outImage =
@@ -48,7 +566,7 @@ int main(int argc, char *argv[])
    if(outImage.valid())
       outImage->initialize();
    else
-      return -1;
+      return false;
    
    // Fill the buffer with test image pattern. Start with fill:
    outImage->fill(1);
@@ -178,7 +696,112 @@ int main(int argc, char *argv[])
    writer->connectMyInputTo(0, memSource.get());
    writer->setFilename(filename);
    writer->setGeotiffFlag(true);
-   bool success = writer->execute();
+   return writer->execute();
+}
+
+
+int main(int argc, char *argv[])
+{
+   ossimArgumentParser ap(&argc, argv);
+   ossimInit::instance()->addOptions(ap);
+
+   ossimApplicationUsage* au = ap.getApplicationUsage();
+   au->setApplicationName(ap.getApplicationName());
+   au->setDescription(ap.getApplicationName() + " writes a test pattern image, or with "
+                      "--workload the images and chain definitions of a scalability "
+                      "workload.");
+   au->setCommandLineUsage(ap.getApplicationName() + " <filename>\n"
+                           "       " + ap.getApplicationName() +
+                           " --workload <mosaic|rpc|chain> [options] <output_directory>");
+   au->addCommandLineOption("--workload <type>",
+                            "mosaic: overlapping images and chipper options to mosaic them. "
+                            "rpc: RPC image, DEM and chipper options to ortho it. "
+                            "chain: image and orthoigen chain template of --filters filters.");
+   au->addCommandLineOption("--size <pixels>", "Width and height of each image (default 4096).");
+   au->addCommandLineOption("--count <n>", "Number of mosaic images, on a grid (default 4).");
+   au->addCommandLineOption("--overlap <fraction>", "Mosaic image overlap (default 0.1).");
+   au->addCommandLineOption("--bands <n>", "Bands of the images (default 3).");
+   au->addCommandLineOption("--scalar <type>",
+                            "Scalar type of the images, e.g. uint8, uint16, float32 "
+                            "(default uint8).");
+   au->addCommandLineOption("--tile-size <pixels>", "Output tile size (default 256).");
+   au->addCommandLineOption("--gsd <meters>", "Image ground sample distance (default 1).");
+   au->addCommandLineOption("--seed <n>", "Seed of the image content (default 1).");
+   au->addCommandLineOption("--filters <n>", "Filters in the chain template (default 4).");
+   au->addCommandLineOption("--filter-types <list>",
+                            "Comma separated filter classes the chain cycles through "
+                            "(default ossimImageGaussianFilter,ossimBrightnessContrastSource,"
+                            "ossimImageSharpenFilter).");
+
+   ossimInit::instance()->initialize(ap);
 
-   return 0;
+   if ( (ap.argc() < 2) || ap.read("-h") || ap.read("--help") )
+   {
+      au->write(ossimNotify(ossimNotifyLevel_INFO));
+      return 0;
+   }
+
+   std::string workload;
+   if ( !ap.read("--workload", workload) )
+   {
+      ossimFilename filename = ap[1];
+      filename.setExtension(".tif");
+      return writeTestPattern(filename) ? 0 : 1;
+   }
+
+   SynthOptions options;
+   std::string stringParam;
+   ap.read("--size", options.theSize);
+   ap.read("--count", options.theCount);
+   ap.read("--overlap", options.theOverlap);
+   ap.read("--bands", options.theBands);
+   ap.read("--tile-size", options.theTileSize);
+   ap.read("--gsd", options.theGsd);
+   ap.read("--seed", options.theSeed);
+   ap.read("--filters", options.theFilters);
+   if ( ap.read("--scalar", stringParam) )
+   {
+      options.theScalar = ossimScalarTypeLut::instance()->getScalarTypeFromString(stringParam);
+   }
+   ap.read("--filter-types", options.theFilterTypes);
+   if ( options.theFilterTypes.empty() )
+   {
+      options.theFilterTypes.push_back("ossimImageGaussianFilter");
+      options.theFilterTypes.push_back("ossimBrightnessContrastSource");
+      options.theFilterTypes.push_back("ossimImageSharpenFilter");
+   }
+
+   if ( (ap.argc() < 2) || !options.theSize || !options.theCount || !options.theBands ||
+        !options.theTileSize || (options.theOverlap < 0.0) || (options.theOverlap >= 1.0) ||
+        (options.theGsd <= 0.0) || (options.theScalar == OSSIM_SCALAR_UNKNOWN) )
+   {
+      au->write(ossimNotify(ossimNotifyLevel_INFO));
+      return 1;
+   }
+
+   ossimFilename dir = ap[1];
+   if ( !dir.exists() && !dir.createDirectory() )
+   {
+      cerr << "Could not create " << dir << endl;
+      return 1;
+   }
+
+   bool status = false;
+   if (workload == "mosaic")
+   {
+      status = writeMosaicWorkload(dir, options);
+   }
+   else if (workload == "rpc")
+   {
+      status = writeRpcWorkload(dir, options);
+   }
+   else if (workload == "chain")
+   {
+      status = writeChainWorkload(dir, options);
+   }
+   else
+   {
+      cerr << "Unknown workload: " << workload << endl;
+   }
+   return status ? 0 : 1;
 }
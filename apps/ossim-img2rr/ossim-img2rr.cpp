@@ -286,6 +286,11 @@ int main(int argc, char* argv[])
    au->addCommandLineOption("--scanForMinMaxNull",
       "Turns on min, max, null scanning when reading tiles.  This option tries to find a null value which is useful for float data.");
 
+   au->addCommandLineOption("--single-pass",
+      "Builds all reduced res sets in one multi-threaded pass over the starting level.  Tiff "
+      "overviews only.  Note a default can be set in the ossim preferences file, setting the "
+      "keyword \"overview_builder.single_pass\".");
+
    au->addCommandLineOption("--set-property",
       "key:value NOTE: separate key value by a colon.  Deprecated, use --writer-prop instead.");
 
@@ -304,6 +309,7 @@ int main(int argc, char* argv[])
 
    // Optional arguments.
    bool copyAllFlag       = false;
+   bool singlePassFlag    = false;
    bool useEntryIndex     = false;
    bool listEntriesFlag   = false;
    bool tileSizeFlag      = false;
@@ -436,6 +442,11 @@ int main(int argc, char* argv[])
       copyAllFlag = true;
    }
 
+   if( ap.read("--single-pass") )
+   {
+      singlePassFlag = true;
+   }
+
    if(ap.read("-r") || ap.read("--rebuild"))
    {
       rebuildFlag = true;
@@ -598,6 +609,11 @@ int main(int argc, char* argv[])
       }
       propertyList.push_back(new ossimStringProperty("copy_all_flag",
          ossimString::toString(copyAllFlag)));
+      if (singlePassFlag)
+      {
+         propertyList.push_back(new ossimStringProperty("single_pass_flag",
+            ossimString::toString(singlePassFlag)));
+      }
       propertyList.push_back(new ossimStringProperty(ossimKeywordNames::COMPRESSION_TYPE_KW,
          compressionType));
       propertyList.push_back(new ossimStringProperty(ossimKeywordNames::COMPRESSION_QUALITY_KW,
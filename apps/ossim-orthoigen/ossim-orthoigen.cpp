@@ -19,6 +19,7 @@ using namespace std;
 
 #include <ossim/util/ossimOrthoIgen.h>
 #include <ossim/parallel/ossimMpi.h>
+#include <ossim/parallel/ossimJobStatistics.h>
 #include <ossim/init/ossimInit.h>
 #include <ossim/base/ossimException.h>
 #include <ossim/base/ossimNotifyContext.h>
@@ -161,6 +162,11 @@ int main(int argc, char* argv[])
          << "Time elapsed : " << ossimTimer::instance()->time_s() 
          << std::endl;
    }
+   if ( ossimJobStatistics::isEnabled() )
+   {
+      // Per rank, each process has its own queues.
+      ossimJobStatistics::instance()->print( ossimNotify(ossimNotifyLevel_NOTICE) );
+   }
    
    ossimMpi::instance()->finalize();
    finalize(status); 
@@ -207,6 +207,9 @@ void printFrameList( const ossimFilename& imageFile,
          ossim_uint32 nCols = -1;
          
          const ossimRpfToc* pRpfToc = pRpf->getToc();
+
+         // Parses the frame headers, concurrently if rpf.util_threads > 1.
+         ossimRefPtr<ossimRpfUtil> rpfUtil = new ossimRpfUtil();
          
          ossimFilename rootDir;
          pRpfToc->getRootDirectory( rootDir );
@@ -289,8 +292,25 @@ void printFrameList( const ossimFilename& imageFile,
                
             nRows = pRpfToc->getNumberOfFramesVertical(iE);
             nCols = pRpfToc->getNumberOfFramesHorizontal(iE);
-               
+
             ossim_uint32 iV,iH;
+
+            // Parse the entry's frames up front, in the order listed below.
+            std::vector<ossimFilename> framePaths;
+            for ( iV=0; iV<nRows; ++iV )
+            {
+               for ( iH=0; iH<nCols; ++iH )
+               {
+                  ossimFilename framePath = pRpfToc->getRelativeFramePath(iE,iV,iH);
+                  if ( framePath.length() > 0 )
+                  {
+                     framePaths.push_back( rootDir.dirCat(framePath) );
+                  }
+               }
+            }
+            std::vector< ossimRefPtr<ossimRpfFrame> > frames;
+            rpfUtil->parseFrames( framePaths, frames );
+
             ossim_uint32 rowIndex = nRows;
             for ( iV=0; iV<nRows; ++iV )
             {
@@ -323,8 +343,8 @@ void printFrameList( const ossimFilename& imageFile,
                      }
                         
                      const ossimRpfAttributes* pRpfAttr = 0;
-                     ossimRpfFrame rpfFrame;
-                     ossimFilename fullPath = rootDir.dirCat(framePath);
+                     ossimRefPtr<ossimRpfFrame> rpfFrame = frames[nEntryFramesFound-1];
+                     ossimFilename fullPath = framePaths[nEntryFramesFound-1];
                      const char* pFileDateTime = 0;
                      ossimString acqDate("");
                      ossimGpt ulg;
@@ -333,17 +353,17 @@ void printFrameList( const ossimFilename& imageFile,
                      ossimGpt urg;
                      ossimRefPtr<ossimRpfReplaceUpdateTable> replaceUpdateTable = 0;
                      
-                     if ( rpfFrame.parseFile(fullPath,true) == ossimErrorCodes::OSSIM_OK )
+                     if ( rpfFrame.valid() )
                      {
-                        replaceUpdateTable = rpfFrame.getRpfReplaceUpdateTable();
+                        replaceUpdateTable = rpfFrame->getRpfReplaceUpdateTable();
                         if ( replaceUpdateTable.valid() )
                         {
                            replaceUpdateTable->print(out, framePrefix);
                         }
                         
-                        pRpfAttr = rpfFrame.getAttributes();
+                        pRpfAttr = rpfFrame->getAttributes();
                            
-                        const ossimNitfFile* pNitfFile = rpfFrame.getNitfFile();
+                        const ossimNitfFile* pNitfFile = rpfFrame->getNitfFile();
                         const ossimNitfFileHeader* pNitfFileHeader =
                            pNitfFile!=0 ? pNitfFile->getHeader() : 0;
                         pFileDateTime = pNitfFileHeader!=0 ? 
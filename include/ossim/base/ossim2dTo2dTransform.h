@@ -26,6 +26,18 @@ public:
                         ossimDpt&       output) const;
 
    virtual void inverse(ossimDpt&  modify_this) const;
+
+   /*!
+    * forward() and inverse() for count points.  The defaults loop; output
+    * may be the same array as input.
+    */
+   virtual void forwardPoints(const ossimDpt* input,
+                              ossimDpt*       output,
+                              ossim_uint32    count) const;
+
+   virtual void inversePoints(const ossimDpt* input,
+                              ossimDpt*       output,
+                              ossim_uint32    count) const;
       
    virtual const ossim2dTo2dTransform& operator=(
       const ossim2dTo2dTransform& rhs);
@@ -18,6 +18,7 @@
 #include <streambuf>
 #include <iosfwd>
 #include <ios>
+#include <vector>
 
 //using namespace std;
 class OSSIM_DLL ossimByteStreamBuffer : public std::basic_streambuf<char, std::char_traits<char> >
@@ -34,19 +35,55 @@ public:
    // added so we can set a buffer and make it shared
    std::streambuf* setBuf(char* buf, std::streamsize bufSize, bool shared);
    virtual int overflow( int c = EOF);
+
+   /**
+    * Sets the segment size.  With a size, the data is held in a chain of
+    * fixed size segments and growing it allocates the next segment instead of
+    * reallocating and copying everything written so far.  0 (the default)
+    * holds one contiguous buffer.  The contents and the read and write
+    * positions are kept.  clear() keeps the mode; setBuf() with a buffer
+    * goes back to one contiguous buffer.
+    */
+   void setSegmentSize(ossim_uint64 bytes);
+   ossim_uint64 getSegmentSize()const;
+
    /**
-    * Returns a pointer to the buffer
+    * @return The number of segments holding data; 1 for a non empty
+    * contiguous buffer.
+    */
+   ossim_uint32 getNumberOfSegments()const;
+
+   /**
+    * Gather access for writers and sockets (e.g. one iovec per segment),
+    * without copying the segments together.
+    * @param index Zero based segment index.
+    * @param size Initialized to the bytes of data in the segment.
+    * @return The start of the segment, null if index is out of range.
+    */
+   const char_type* getSegment(ossim_uint32 index, ossim_uint64& size)const;
+
+   /**
+    * Writes all data to out a segment at a time.
+    * @return true if out is good after.
+    */
+   bool writeSegments(std::ostream& out)const;
+
+   /**
+    * Returns a pointer to the buffer.  In segmented mode the segments are
+    * first copied into one contiguous buffer, which leaves segmented mode.
     */
    char_type* buffer();
    const char_type* buffer()const;
     
    /**
     * The buffer is no longer managed by this stream buffer and is removed.
+    * In segmented mode the segments are first copied into one buffer.
     */
    char_type* takeBuffer();
    ossim_uint64 bufferSize()const;
     
 protected:
+   virtual int_type underflow();
    virtual int_type pbackfail(int_type __c  = traits_type::eof());
    virtual pos_type seekoff(off_type offset, std::ios_base::seekdir dir,
                             std::ios_base::openmode __mode = std::ios_base::in | std::ios_base::out);
@@ -58,9 +95,26 @@ protected:
    void deleteBuffer();
    void extendBuffer(ossim_uint64 bytes);
 
+   /** Segmented mode: bytes written so far, including the put area. */
+   ossim_uint64 dataSize()const;
+   /** Segmented mode: read and write positions. */
+   ossim_uint64 getPosition()const;
+   ossim_uint64 putPosition()const;
+   /** Segmented mode: moves the get or put area to the segment of pos. */
+   void setGetPosition(ossim_uint64 pos);
+   void setPutPosition(ossim_uint64 pos);
+   /** Copies the segments into one contiguous buffer and leaves segmented mode. */
+   void gatherSegments();
+
    char_type* m_buffer;
    ossim_int64 m_bufferSize;
    bool m_sharedBuffer;
+
+   ossim_uint64             m_segmentSize; // 0 if contiguous.
+   std::vector<char_type*>  m_segments;
+   ossim_uint64             m_dataSize;    // Segmented data size as of the last put area move.
+   ossim_uint64             m_getSegment;  // Segment of the get area.
+   ossim_uint64             m_putSegment;  // Segment of the put area.
 };
 
 #endif
@@ -164,6 +164,32 @@ public:
    double operator() (const double& u, const double& v) const;
    double value (const double& u, const double& v) const {return (*this)(u,v);}
 
+   /*!
+    * Batch form of operator(): result[i] is the value at (u[i], v[i]) for
+    * i in [0, count).
+    */
+   void values(int count, const double* u, const double* v, double* result) const;
+
+   /*!
+    * Values at the count U/V points start + i*step, e.g. one line of output
+    * pixels. The four nodes of a cell are fetched and domain adjusted once for
+    * all consecutive points falling in it, leaving a branch free weighted sum
+    * per point. Points outside the grid are handled as in operator().
+    */
+   void valuesAlongLine(const ossimDpt& start,
+                        const ossimDpt& step,
+                        int count,
+                        double* result) const;
+
+   /*!
+    * Keeps the nodes as float instead of double, halving the memory and cache
+    * footprint of grids not needing double precision (e.g. datum shifts in
+    * arc seconds). Existing nodes are converted; null nodes stay null. Values
+    * are still passed and returned as double.
+    */
+   void setFloatStorage(bool flag);
+   bool getFloatStorage() const { return theFloatStorageFlag; }
+
    /*!
     * operator for initializing this grid with another.
     */
@@ -187,7 +213,8 @@ public:
    const ossimIpt& size()    const { return theSize; }
    const ossimDpt& origin()  const { return theOrigin; }
    const ossimDpt& spacing() const { return theSpacing; }
-   unsigned long   getSizeInBytes() const { return theSize.x*theSize.y*sizeof(double); }
+   unsigned long   getSizeInBytes() const
+   { return theSize.x*theSize.y*(theFloatStorageFlag ? sizeof(float) : sizeof(double)); }
    
    /*!
     * Returns true if double point lies within world space coverage:
@@ -209,12 +236,42 @@ private:
    double interpolate(double x, double y) const;
    double extrapolate(double x, double y) const;
 
+   /*!
+    * Loads the four nodes of the cell with origin node (x0, y0), repeating
+    * edge nodes past the last row/column and adjusting for a wrapped domain.
+    * Returns false if the cell is outside the grid.
+    */
+   bool loadCell(int x0, int y0, double& p00, double& p01, double& p10, double& p11) const;
+
+   bool hasData() const { return theGridData || theFloatData; }
+
+   //! Node value by buffer index, from whichever storage is in use.
+   double nodeValue(ossim_uint32 i) const
+   {
+      if (theGridData)
+         return theGridData[i];
+      return (theFloatData[i] == (float) theNullValue) ? theNullValue : (double) theFloatData[i];
+   }
+   void setNodeValue(ossim_uint32 i, double value)
+   {
+      if (theGridData)
+         theGridData[i] = value;
+      else
+         theFloatData[i] = (float) value;
+   }
+
+   //! Allocates the node buffer for theSize in the storage selected, filled with null.
+   void allocate();
+   void deleteData();
+
    //! Constrains the value to the numerical domain specified in theDomainType.
    void constrain(double& value) const;
 
    ossim_uint32   index(int x, int y) const { return y*theSize.x + x; }
    
    double*      theGridData;
+   float*       theFloatData;
+   bool         theFloatStorageFlag;
    ossimIpt     theSize;
    ossimDpt     theOrigin;
    ossimDpt     theSpacing;
@@ -14,6 +14,8 @@
 #include <OpenThreads/ScopedLock>
 #include <vector>
 #include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimFactoryTypeCache.h>
+#include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimObject.h>
 #include <ossim/base/ossimString.h>
 #include <ossim/base/ossimKeywordlist.h>
@@ -59,6 +61,7 @@ class ossimFactoryListInterface
       {
          if(!factory) return;
          OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_factoryListMutex);
+         clearTypeCaches();
          if(!findFactory(factory))
          {
             if (pushToFrontFlag)
@@ -77,6 +80,7 @@ class ossimFactoryListInterface
       void unregisterFactory(T* factory)
       {
          OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_factoryListMutex);
+         clearTypeCaches();
          ossim_uint32 idx = 0;
          for(idx = 0; idx < m_factoryList.size(); ++idx)
          {
@@ -94,6 +98,7 @@ class ossimFactoryListInterface
       void unregisterAllFactories()
       {
          OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_factoryListMutex);
+         clearTypeCaches();
          m_factoryList.clear();
       }
       
@@ -103,6 +108,7 @@ class ossimFactoryListInterface
       void registerFactoryToFront(T* factory)
       {
          OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_factoryListMutex);
+         clearTypeCaches();
          if(!findFactory(factory))
          {
             m_factoryList.insert(m_factoryList.begin(), factory);
@@ -116,6 +122,7 @@ class ossimFactoryListInterface
       void registerFactoryBefore(T* factory, T* beforeThisFactory)
       {
          OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_factoryListMutex);
+         clearTypeCaches();
          if(!findFactory(factory))
          {
             ossim_uint32 idx = 0;
@@ -186,8 +193,21 @@ class ossimFactoryListInterface
          
          return false;
       }
+
+      void clearTypeCaches()const
+      {
+         m_typeNameCache.clear();
+         m_stateTypeCache.clear();
+      }
+
       mutable OpenThreads::Mutex m_factoryListMutex;
       FactoryListType m_factoryList;
+
+      /** Factories by type name, for createObjectFromRegistry(typeName). */
+      ossimFactoryTypeCache<T> m_typeNameCache;
+
+      /** Factories by keyword list type, for createObjectFromRegistry(kwl). */
+      ossimFactoryTypeCache<T> m_stateTypeCache;
    };
 
 template <class T, class NativeType>
@@ -205,10 +225,22 @@ ossimObject* ossimFactoryListInterface<T, NativeType>::createObjectFromRegistry(
 {
    //OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_factoryListMutex);
    ossimObject* result = 0;
+   T* cached = m_typeNameCache.find(typeName);
+   if(cached)
+   {
+      result = cached->createObject(typeName);
+   }
    ossim_uint32 idx = 0;
    for(;((idx<m_factoryList.size())&&!result); ++idx)
    {
-      result = m_factoryList[idx]->createObject(typeName);
+      if(m_factoryList[idx] != cached)
+      {
+         result = m_factoryList[idx]->createObject(typeName);
+         if(result)
+         {
+            m_typeNameCache.insert(typeName, m_factoryList[idx]);
+         }
+      }
    }
    return result;
 }
@@ -219,10 +251,23 @@ ossimObject* ossimFactoryListInterface<T, NativeType>::createObjectFromRegistry(
 {
    // OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_factoryListMutex);
    ossimObject* result = 0;
+   const ossimString TYPE = kwl.find(prefix, ossimKeywordNames::TYPE_KW);
+   T* cached = m_stateTypeCache.find(TYPE);
+   if(cached)
+   {
+      result = cached->createObject(kwl, prefix);
+   }
    ossim_uint32 idx = 0;
    for(;((idx<m_factoryList.size())&&!result); ++idx)
    {
-      result = m_factoryList[idx]->createObject(kwl, prefix);
+      if(m_factoryList[idx] != cached)
+      {
+         result = m_factoryList[idx]->createObject(kwl, prefix);
+         if(result)
+         {
+            m_stateTypeCache.insert(TYPE, m_factoryList[idx]);
+         }
+      }
    }
    return result;
 }
@@ -0,0 +1,68 @@
+//**************************************************************************************************
+//
+// License:  LGPL
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description: Class declaration of ossimFactoryTypeCache.
+//
+//**************************************************************************************************
+#ifndef ossimFactoryTypeCache_HEADER
+#define ossimFactoryTypeCache_HEADER 1
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <map>
+#include <string>
+#include <ossim/base/ossimString.h>
+
+/**
+ * Map from type name to the factory of a registry that created it, so
+ * registries dispatch repeat requests for a type, e.g. the thousands of
+ * objects of a large chain's loadState, straight to its factory instead of
+ * asking each in turn.
+ *
+ * Entries are recorded from successful creations rather than built from
+ * getTypeNameList at registration: factories that are registries
+ * themselves or come from plugins loaded on demand do not know all their
+ * types up front, and listing them would load every deferred plugin.
+ * Registries clear the cache whenever their factory list changes, and fall
+ * back to asking every factory when it misses or the cached factory fails.
+ */
+template <class T>
+class ossimFactoryTypeCache
+{
+public:
+   ossimFactoryTypeCache(){}
+
+   /** @return Factory that last created typeName, or 0. */
+   T* find(const ossimString& typeName)const
+   {
+      if(typeName.empty()) return 0;
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      typename std::map<std::string, T*>::const_iterator i = m_factories.find(typeName.string());
+      return (i != m_factories.end()) ? i->second : 0;
+   }
+
+   void insert(const ossimString& typeName, T* factory)const
+   {
+      if(typeName.empty()) return;
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      m_factories[typeName.string()] = factory;
+   }
+
+   void clear()const
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      m_factories.clear();
+   }
+
+private:
+   // Not copyable; copies of a registry start empty.
+   ossimFactoryTypeCache(const ossimFactoryTypeCache&){}
+   const ossimFactoryTypeCache& operator=(const ossimFactoryTypeCache&){ return *this; }
+
+   mutable OpenThreads::Mutex m_mutex;
+   mutable std::map<std::string, T*> m_factories;
+};
+
+#endif
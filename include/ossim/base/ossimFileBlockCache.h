@@ -0,0 +1,114 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Input stream reading a local file in large blocks kept in memory, so parsers
+// doing many small reads and seeks (e.g. the NITF headers) make a few large reads instead.
+//
+// Classes:
+//   ossimFileBlockCache        - Least recently used block cache of one file.
+//   ossimFileBlockStreamBuffer - std::streambuf reading through the cache.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimFileBlockCache_HEADER
+#define ossimFileBlockCache_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimReferenced.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <OpenThreads/Mutex>
+#include <list>
+#include <map>
+#include <streambuf>
+#include <vector>
+
+/**
+ * @brief Least recently used cache of the fixed size blocks of one file.
+ *
+ * The blocks missing from a read are read with one call per run of consecutive blocks; the
+ * file is opened for the read only, so a cache does not hold a file descriptor.  Thread safe.
+ *
+ * Preferences (see ossim_preferences_template):
+ *   file_block_cache.block_size  Bytes per block, default 65536.
+ *   file_block_cache.max_blocks  Blocks kept per file, default 64.
+ */
+class OSSIM_DLL ossimFileBlockCache : public ossimReferenced
+{
+public:
+   ossimFileBlockCache(const ossimFilename& file);
+
+   /** @return Size in bytes of the file, 0 if it could not be opened. */
+   ossim_uint64 getSize() const;
+
+   ossim_uint64 getBlockSize() const;
+
+   /**
+    * @brief Copies bytes [offset, offset+count) clipped to the size of the file.
+    * @return Bytes copied; less than count at the end of the file or on a failed read.
+    */
+   ossim_uint64 read(ossim_uint64 offset, char* buffer, ossim_uint64 count);
+
+   /** @return Reads of the file made so far. */
+   ossim_uint64 getNumberOfFileReads() const;
+
+   /** Drops the blocks held. */
+   void clear();
+
+protected:
+   virtual ~ossimFileBlockCache();
+
+   struct Block
+   {
+      std::vector<char>                 m_data;
+      std::list<ossim_uint64>::iterator m_lru;
+   };
+
+   /** Reads blocks [first, last] from the file and adds them; call with m_mutex locked. */
+   bool readRun(ossim_uint64 first, ossim_uint64 last);
+
+   ossimFilename                 m_file;
+   ossim_uint64                  m_size;
+   ossim_uint64                  m_blockSize;
+   ossim_uint32                  m_maxBlocks;
+   ossim_uint64                  m_fileReads;
+   std::map<ossim_uint64, Block> m_blocks;
+   std::list<ossim_uint64>       m_lru;      // Most recent at front.
+   mutable OpenThreads::Mutex    m_mutex;
+};
+
+/**
+ * @brief Seekable read only std::streambuf on an ossimFileBlockCache.  Positions are file
+ * offsets, so code using tellg() and seekg() reads as from a std::ifstream:
+ *
+ *    ossimFileBlockStreamBuffer buffer(cache);
+ *    std::istream in(&buffer);
+ */
+class OSSIM_DLL ossimFileBlockStreamBuffer : public std::streambuf
+{
+public:
+   ossimFileBlockStreamBuffer(ossimFileBlockCache* cache);
+
+protected:
+   virtual int_type underflow();
+   virtual std::streamsize xsgetn(char_type* s, std::streamsize n);
+   virtual std::streamsize showmanyc();
+   virtual pos_type seekoff(off_type offset, std::ios_base::seekdir dir,
+                            std::ios_base::openmode mode = std::ios_base::in);
+   virtual pos_type seekpos(pos_type pos,
+                            std::ios_base::openmode mode = std::ios_base::in);
+
+   /** @return File offset of gptr(). */
+   ossim_uint64 position() const;
+
+   /** Empties the get area and puts the position at pos. */
+   void setPosition(ossim_uint64 pos);
+
+   ossimRefPtr<ossimFileBlockCache> m_cache;
+   std::vector<char>                m_buffer;
+   ossim_uint64                     m_bufferOffset; // File offset of eback().
+};
+
+#endif /* #ifndef ossimFileBlockCache_HEADER */
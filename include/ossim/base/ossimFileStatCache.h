@@ -0,0 +1,103 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description:
+//
+// Contains declaration of class ossimFileStatCache.
+//
+//*******************************************************************
+#ifndef ossimFileStatCache_HEADER
+#define ossimFileStatCache_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <map>
+#include <set>
+#include <string>
+
+class ossimFilename;
+
+/**
+ * Scoped cache of file system metadata for the calling thread.  While an
+ * instance is alive on a thread, ossimFilename::exists, isFile, isDir,
+ * fileSize and getTimes there answer from one stat per path, and a
+ * directory looked into more than once is listed by a single readdir, so
+ * probing for sidecar files that do not exist (.ovr, .geom, .omd, ...)
+ * costs no stat at all.  Meant for short operations such as opening an
+ * image:
+ *
+ *    {
+ *       ossimFileStatCache statCache;
+ *       ... probe and open ...
+ *    }
+ *
+ * Scopes nest; inner ones use the outermost's cache.  Paths changed through
+ * ossimFilename (touch, rename, remove, createDirectory, copyFileTo) are
+ * dropped from the cache; changes made otherwise, e.g. by another thread or
+ * process, are not seen until the scope ends.  Access permissions
+ * (isReadable, isWriteable, isExecutable) are not cached.
+ */
+class OSSIMDLLEXPORT ossimFileStatCache
+{
+public:
+   /** Metadata of a path. */
+   struct Stat
+   {
+      Stat();
+
+      bool        theExistsFlag;
+      bool        theDirFlag;
+      bool        theFileFlag;
+      ossim_int64 theSize;
+      ossim_int64 theAccessTime;   // time_t
+      ossim_int64 theModifyTime;
+      ossim_int64 theChangeTime;
+   };
+
+   /** Makes this the calling thread's cache unless one is already active. */
+   ossimFileStatCache();
+   ~ossimFileStatCache();
+
+   /** @return The calling thread's active cache, or 0 if none. */
+   static ossimFileStatCache* current();
+
+   /**
+    * Gets the metadata of path, from the cache or a stat.
+    * @return stat.theExistsFlag.
+    */
+   bool getStat(const ossimFilename& path, Stat& stat);
+
+   /** Drops path and its directory's listing. */
+   void invalidate(const ossimFilename& path);
+
+   /** Drops everything. */
+   void clear();
+
+   /** @return Number of stat and readdir calls made, for diagnostics. */
+   ossim_uint64 getSystemCallCount() const;
+
+private:
+   struct Listing
+   {
+      Listing();
+
+      ossim_uint32          theLookupCount;
+      bool                  theListedFlag;
+      std::set<std::string> theNames;
+   };
+
+   bool statPath(const std::string& path, Stat& stat);
+   bool listDirectory(const std::string& dir, Listing& listing);
+
+   // Not copyable.
+   ossimFileStatCache(const ossimFileStatCache&);
+   const ossimFileStatCache& operator=(const ossimFileStatCache&);
+
+   /** The cache in use, this one if outermost. */
+   ossimFileStatCache*             theActive;
+   std::map<std::string, Stat>     theStats;
+   std::map<std::string, Listing> theListings;
+   ossim_uint64                    theSystemCallCount;
+};
+
+#endif /* #ifndef ossimFileStatCache_HEADER */
@@ -36,6 +36,15 @@ public:
     */
    virtual double offsetFromEllipsoid(const ossimGpt& gpt) = 0;
 
+   /**
+    *  Batch form of offsetFromEllipsoid for count points.  Grids can
+    *  override it to look the points up in one go; this one loops.
+    *  @param offsets Set to the offset of each point or ossim::nan().
+    */
+   virtual void offsetsFromEllipsoid(const ossimGpt* gpts,
+                                     double* offsets,
+                                     ossim_uint32 count);
+
 protected:
    virtual ~ossimGeoid();
    
@@ -16,6 +16,7 @@
 #define ossimGeoidEgm96_HEADER
 
 #include <ossim/base/ossimGeoid.h>
+#include <ossim/base/ossimGeoidGrid.h>
 #include <vector>
 
 #define GEOID_NO_ERROR              0x0000
@@ -48,6 +49,11 @@ public:
     */
    virtual double offsetFromEllipsoid(const ossimGpt& gpt);
 
+   /** Batch form; one grid lookup per point when the geoid grid is on. */
+   virtual void offsetsFromEllipsoid(const ossimGpt* gpts,
+                                     double* offsets,
+                                     ossim_uint32 count);
+
    double geoidToEllipsoidHeight(double lat,
                                  double lon,
                                  double geoidHeight);
@@ -60,6 +66,9 @@ protected:
 
    std::vector<float> theGeoidHeightBuffer;
    mutable float* theGeoidHeightBufferPtr;
+
+   /** See ossimGeoidGrid::create; 0 when off. */
+   ossimRefPtr<ossimGeoidGrid> theGrid;
    TYPE_DATA
 };
 
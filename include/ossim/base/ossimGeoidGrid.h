@@ -0,0 +1,117 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Global float32 lat/lon grid of geoid heights with a bilinear lookup.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimGeoidGrid_HEADER
+#define ossimGeoidGrid_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimReferenced.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimFilename.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+class ossimDatum;
+class ossimGeoid;
+
+//*************************************************************************************************
+//! Geoid heights sampled once on a regular WGS84 lat/lon grid, row 0 at 90 north and column 0 at
+//! 180 west, with an extra column at 180 east so lookups never wrap between posts.
+//!
+//! height() has no branches: longitude is wrapped and latitude clamped arithmetically, then
+//! four neighbouring floats are blended. Posts where the source geoid had no value are nan, so
+//! lookups next to them return nan as the source would.
+//!
+//! Used by ossimGeoidEgm96 and ossimGeoidImage when the preferences keyword
+//! geoid_manager.grid.enabled is true; see create().
+//*************************************************************************************************
+class OSSIM_DLL ossimGeoidGrid : public ossimReferenced
+{
+public:
+   ossimGeoidGrid();
+
+   //! Samples geoid every spacing degrees (rounded so 180 is a whole number of posts).
+   bool build(ossimGeoid& geoid, double spacing);
+
+   //! Reads a grid written by save(). Either byte order is accepted.
+   bool load(const ossimFilename& file);
+
+   //! Writes the grid in native byte order.
+   bool save(const ossimFilename& file) const;
+
+   bool isValid() const { return !m_posts.empty(); }
+
+   double getSpacing() const { return m_spacing; }
+
+   //! @return Interpolated geoid height at WGS84 lat, lon (decimal degrees).
+   inline double height(double lat, double lon) const;
+
+   //! @return Height at gpt, shifted to WGS84 first if needed; nan for a nan point.
+   inline double height(const ossimGpt& gpt) const;
+
+   //! height(gpt) for count points.
+   void heights(const ossimGpt* gpts, double* offsets, ossim_uint32 count) const;
+
+   //! Grid for geoid per the preferences, or 0 when geoid_manager.grid.enabled is off.
+   //!
+   //! With geoid_manager.grid.directory set the grid is read from, or after building saved
+   //! to, <directory>/<geoid short name>.grid. The spacing is geoid_manager.grid.spacing,
+   //! else defaultSpacing.
+   static ossimRefPtr<ossimGeoidGrid> create(ossimGeoid& geoid, double defaultSpacing);
+
+protected:
+   virtual ~ossimGeoidGrid();
+
+   //! Sizes m_posts for spacing.
+   void allocate(double spacing);
+
+   //! height(gpt) for a point on another datum.
+   double heightShifted(const ossimGpt& gpt) const;
+
+   ossim_uint32       m_rows;
+   ossim_uint32       m_cols;
+   double             m_spacing;    //!< Degrees between posts.
+   double             m_invSpacing;
+   std::vector<float> m_posts;      //!< m_rows * m_cols, north to south.
+   const ossimDatum*  m_wgs84;
+};
+
+inline double ossimGeoidGrid::height(const ossimGpt& gpt) const
+{
+   if ( gpt.isLatNan() || gpt.isLonNan() )
+   {
+      return ossim::nan();
+   }
+   if ( (gpt.datum() == m_wgs84) || !m_wgs84 )
+   {
+      return height(gpt.lat, gpt.lon);
+   }
+   return heightShifted(gpt);
+}
+
+inline double ossimGeoidGrid::height(double lat, double lon) const
+{
+   double l = lon + 180.0;
+   l -= 360.0 * std::floor(l * (1.0 / 360.0));
+   const double x = l * m_invSpacing;
+   const double y = std::min(std::max((90.0 - lat) * m_invSpacing, 0.0), (double)(m_rows - 1));
+   const ossim_uint32 ix = std::min((ossim_uint32)x, m_cols - 2);
+   const ossim_uint32 iy = std::min((ossim_uint32)y, m_rows - 2);
+   const float fx = (float)(x - ix);
+   const float fy = (float)(y - iy);
+   const float* p = &m_posts[iy * m_cols + ix];
+   const float n = p[0] + fx * (p[1] - p[0]);
+   const float s = p[m_cols] + fx * (p[m_cols + 1] - p[m_cols]);
+   return n + fy * (s - n);
+}
+
+#endif /* #ifndef ossimGeoidGrid_HEADER */
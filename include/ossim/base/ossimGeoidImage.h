@@ -15,6 +15,7 @@
 #define ossimGeoidImage_HEADER 1
    
 #include <ossim/base/ossimGeoid.h>
+#include <ossim/base/ossimGeoidGrid.h>
 #include <ossim/base/ossimString.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageGeometry.h>
@@ -93,6 +94,14 @@ public:
     */
    virtual double offsetFromEllipsoid(const ossimGpt& gpt);
 
+   /**
+    * @brief Batch form.  One grid lookup per point when the geoid grid is
+    * on, else the single point call in a loop.
+    */
+   virtual void offsetsFromEllipsoid(const ossimGpt* gpts,
+                                     double* offsets,
+                                     ossim_uint32 count);
+
    bool getEnableFlag() const;
 
    void setEnableFlag(bool flag);
@@ -111,6 +120,9 @@ protected:
    bool                            m_enabledFlag;
    ossimIrect                      m_imageRect;
    ossimScalarType                 m_scalarType;
+
+   /** Sampled from the image at open, see ossimGeoidGrid::create; 0 when off. */
+   ossimRefPtr<ossimGeoidGrid>     m_grid;
 };
 
 #endif /* #define ossimGeoidImage_HEADER 1 */
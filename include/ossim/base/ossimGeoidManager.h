@@ -48,6 +48,14 @@ public:
     */
    virtual double offsetFromEllipsoid(const ossimGpt& gpt);
 
+   /**
+    *  Batch form of offsetFromEllipsoid.  Each geoid is asked once for all
+    *  the points the geoids ahead of it did not cover.
+    */
+   virtual void offsetsFromEllipsoid(const ossimGpt* gpts,
+                                     double* offsets,
+                                     ossim_uint32 count);
+
    /**
     * Method to save the state of the object to a keyword list.
     * Return true if ok or false on error. DO NOTHING
@@ -140,6 +140,125 @@ protected:
 
 }; // End of class ossimOgzStream
 
+/**
+ * @brief Streambuf for block gzip files: a series of independent gzip
+ * members of up to getBlockSize() uncompressed bytes each (pigz/bgzf style),
+ * so any gzip reader still reads the whole file.
+ *
+ * Each member's header carries an extra field (subfield "OB", four byte
+ * little endian size of the member), so the members can be indexed by
+ * hopping from header to header without inflating anything.
+ *
+ * Writing: full blocks are deflated on up to getThreads() threads and written
+ * in order.  flush() ends the current block early.
+ *
+ * Reading: open() indexes the members.  Seeks go straight to the block
+ * holding the position; sequential reads inflate the next blocks on the
+ * other threads while the current one is consumed.  Fails to open files
+ * that are not block gzip; use ossimGzStreamBuf for those.
+ *
+ * The thread count defaults to the preferences keyword "gzip.block_threads",
+ * 1 (no threads) if not set.
+ */
+class OSSIM_DLL ossimGzBlockStreamBuf : public std::streambuf
+{
+public:
+   ossimGzBlockStreamBuf();
+
+   virtual ~ossimGzBlockStreamBuf();
+
+   bool is_open()const;
+   ossimGzBlockStreamBuf* open( const char* name, int open_mode);
+   ossimGzBlockStreamBuf* close();
+
+   /** @brief Uncompressed bytes per written block, default 1 MiB. Set before open. */
+   void setBlockSize(ossim_uint32 bytes);
+   ossim_uint32 getBlockSize()const;
+
+   /** @brief Threads to deflate or inflate blocks on. Set before open. */
+   void setThreads(ossim_uint32 threads);
+   ossim_uint32 getThreads()const;
+
+   /** @return Uncompressed size of a file open for reading. */
+   ossim_uint64 getSize()const;
+
+   /** @return true if the first member of file carries the block extra field. */
+   static bool isBlockGzip(const char* name);
+
+   virtual int overflow( int c = EOF);
+   virtual int underflow();
+   virtual int sync();
+   virtual pos_type seekoff(off_type t, std::ios_base::seekdir dir,
+                            std::ios_base::openmode omode = std::ios_base::in |
+                            std::ios_base::out);
+   virtual pos_type seekpos(pos_type pos,
+                            std::ios_base::openmode omode = std::ios_base::in |
+                            std::ios_base::out);
+
+private:
+   struct PrivateData;
+
+   /** Hands the put area to a deflate job. */
+   bool queueBlock();
+
+   /** Waits for the oldest deflate job and writes its member. */
+   bool writeOldestBlock();
+
+   /** Reads the members at index block and after, up to one per thread, for inflating. */
+   void loadBlocks(ossim_uint64 block);
+
+   /** @return Uncompressed position of gptr() when reading. */
+   ossim_uint64 getPosition()const;
+
+   PrivateData* prvtData;
+   bool         opened;
+   int          mode;
+
+}; // End of class ossimGzBlockStreamBuf
+
+class OSSIM_DLL ossimIgzBlockStream : public ossimIFStream
+{
+public:
+   ossimIgzBlockStream();
+   ossimIgzBlockStream( const char* name,
+                        std::ios_base::openmode mode = std::ios_base::in);
+   virtual ~ossimIgzBlockStream();
+   ossimGzBlockStreamBuf* rdbuf();
+
+   virtual void open( const char* name,
+                      std::ios_base::openmode mode = std::ios_base::in);
+
+   virtual void close();
+   virtual bool is_open()const;
+   virtual bool isCompressed()const;
+
+protected:
+   ossimGzBlockStreamBuf buf;
+
+}; // End of class ossimIgzBlockStream
+
+class OSSIM_DLL ossimOgzBlockStream : public ossimOFStream
+{
+public:
+   ossimOgzBlockStream();
+   ossimOgzBlockStream( const char* name,
+                        std::ios_base::openmode mode =
+                        std::ios_base::out|std::ios_base::trunc );
+   virtual ~ossimOgzBlockStream();
+
+   ossimGzBlockStreamBuf* rdbuf();
+   void open( const char* name,
+              std::ios_base::openmode mode =
+              std::ios_base::out|std::ios_base::trunc );
+   virtual void close();
+   virtual bool is_open()const;
+   virtual bool isCompressed()const;
+
+protected:
+   ossimGzBlockStreamBuf buf;
+
+}; // End of class ossimOgzBlockStream
+
 #endif /* #if OSSIM_HAS_LIBZ */
    
 #endif /* #define ossimGzStream_HEADER */
@@ -48,6 +48,18 @@ class OSSIMDLLEXPORT ossimHistogram : public ossimObject
     float vmin, vmax;        // Maximum and minimum values on plot
     mutable float mean;               // Mean value of the distribution
     mutable float standard_dev;       // 
+
+    ossim_uint64 * intCounts;  // exact counts while counting integers, else NULL
+    mutable bool countsStale;  // counts lags intCounts
+    bool fractionalCounts;     // counts were found not to be whole numbers
+
+    // Refreshes the float view of intCounts.
+    void syncCounts()const
+    { if (countsStale) refreshCounts(); }
+    void refreshCounts()const;
+
+    // Back to float counts, for callers that may write to them.
+    void releaseIntCounts();
   protected:
 
 
@@ -128,16 +140,51 @@ class OSSIMDLLEXPORT ossimHistogram : public ossimObject
 
     float * GetCounts()
     { 
+	releaseIntCounts();
 	stats_consistent = 0; // Counts might change.
 	return counts; 
     }
 
    const float * GetCounts()const
     { 
+	syncCounts();
 	stats_consistent = 0; // Counts might change.
 	return counts; 
     }
 
+    /*!
+     * Exact counts, indexed as GetCounts().  The first call switches the
+     * histogram to 64 bit integer counts, which UpCount() and AddCounts()
+     * then use, the float counts becoming a view refreshed when read.
+     * Returns NULL, keeping float counts, if a count is not a whole number.
+     * The non-const GetCounts() and SetCount() switch back to float counts.
+     * As the view is refreshed by the first read after counting, finish
+     * counting before reading from several threads.
+     */
+    ossim_uint64 * GetIntCounts();
+
+    /*!
+     * Returns the integer counts, NULL when counting in float.
+     */
+    const ossim_uint64 * GetIntCounts()const
+    { return intCounts; }
+
+    /*!
+     * Returns true if the buckets are one unit wide from a whole number,
+     * as for integer scalar histograms made with res == max - min + 1.
+     * GetIndex() then places an integer value v in bucket v - first if v
+     * is within [first, last], letting integer data index the counts
+     * directly.
+     */
+    bool GetUnitBinRange(ossim_int64& first, ossim_int64& last)const;
+
+    /*!
+     * Adds the counts of his, which must have the same buckets.  Exact when
+     * both histograms count integers.  Returns false if the resolutions
+     * differ.
+     */
+    bool AddCounts(const ossimHistogram& his);
+
     int GetRes()const
     { return num; }
 
@@ -147,13 +194,13 @@ class OSSIMDLLEXPORT ossimHistogram : public ossimObject
     { return vals+GetIndex(GetMinVal());  }
 
     float * GetMinCountAddr()
-    { return counts+GetIndex(GetMinVal());  }
+    { releaseIntCounts(); return counts+GetIndex(GetMinVal());  }
 
    const float * GetMinValAddr()const
     { return vals+GetIndex(GetMinVal());  }
 
     const float * GetMinCountAddr()const
-    { return counts+GetIndex(GetMinVal());  }
+    { syncCounts(); return counts+GetIndex(GetMinVal());  }
 
     float ComputeArea(float low, float high)const;// bounded area
     float ComputeArea()const;//total area
@@ -0,0 +1,212 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Built in http transport keeping keep-alive connections per host, so repeated
+// requests to a server (range reads, WMS tiles) do not each pay a TCP handshake.
+//
+// Classes:
+//   ossimHttpConnectionPool        - Idle connections per host, request execution with timeouts
+//                                    and retries, and the threads of the asynchronous requests.
+//   ossimHttpPendingResponse       - Result of an asynchronous request.
+//   ossimPooledHttpRequest         - ossimHttpRequest going through the pool.
+//   ossimPooledHttpRequestFactory  - Registered with ossimWebRequestFactoryRegistry for http://
+//                                    urls.
+//
+// https:// urls are left to the other factories (e.g. the curl plugin), as there is no TLS here.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimHttpConnectionPool_HEADER
+#define ossimHttpConnectionPool_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimHttpRequest.h>
+#include <ossim/base/ossimHttpResponse.h>
+#include <ossim/base/ossimReferenced.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimUrl.h>
+#include <ossim/base/ossimWebRequestFactoryBase.h>
+#include <OpenThreads/Block>
+#include <OpenThreads/Mutex>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+class ossimJobMultiThreadQueue;
+
+/**
+ * @brief Result of ossimPooledHttpRequest::getResponseAsync, completed on a pool thread.
+ * Thread safe.
+ */
+class OSSIM_DLL ossimHttpPendingResponse : public ossimReferenced
+{
+public:
+   ossimHttpPendingResponse();
+
+   /** @return true once the request has completed or failed. */
+   bool isDone() const;
+
+   /**
+    * @brief Blocks until the request completes.
+    * @return The response, or null if no answer was had (see getLastError()).
+    */
+   ossimHttpResponse* wait();
+
+   ossimString getLastError() const;
+
+   /** @brief Completes this; called by the pool. response may be null. */
+   void finish(ossimHttpResponse* response, const ossimString& error);
+
+protected:
+   virtual ~ossimHttpPendingResponse();
+
+   mutable OpenThreads::Mutex      m_mutex;
+   OpenThreads::Block              m_block;
+   bool                            m_done;
+   ossimRefPtr<ossimHttpResponse>  m_response;
+   ossimString                     m_error;
+};
+
+/**
+ * @brief Http/1.1 client keeping idle keep-alive connections per host and port.
+ *
+ * A request takes an idle connection of its host or connects a new one, and gives it back
+ * after reading the whole response unless the server closes it. Connections idle longer than
+ * the idle time are closed instead of reused. A request failing on a reused connection before
+ * any answer (the server dropped it) is sent again on a new one; other failures of GET and HEAD
+ * requests, and 502, 503 and 504 answers to them, are retried with a doubling delay.
+ *
+ * Asynchronous requests run on a job queue of their own, so many can be in flight at once.
+ * Thread safe.
+ *
+ * Preferences (see ossim_preferences_template):
+ *   http_pool.enabled            Serve http:// urls, default true.
+ *   http_pool.connect_timeout    Seconds to connect, default 10.
+ *   http_pool.timeout            Seconds without data before a request fails, default 60.
+ *   http_pool.retries            Retries of failed GET and HEAD requests, default 2.
+ *   http_pool.max_idle_per_host  Idle connections kept per host, default 8.
+ *   http_pool.idle_seconds       Seconds an idle connection is reused for, default 30.
+ *   http_pool.async_threads      Threads of the asynchronous requests, default 4.
+ */
+class OSSIM_DLL ossimHttpConnectionPool
+{
+public:
+   static ossimHttpConnectionPool* instance();
+
+   /**
+    * @brief Sends a request and reads the response, retrying as above.
+    * @param method E.g. "GET".
+    * @param headers Header name and value pairs added to the request.
+    * @param response Receives the status line and headers in its header stream and the
+    * (de-chunked) body in its body stream.
+    * @param error Set if false is returned.
+    * @return true if a response was read, whatever its status code.
+    */
+   bool execute(const ossimString& method,
+                const ossimUrl& url,
+                const ossimKeywordlist& headers,
+                ossimHttpResponse& response,
+                ossimString& error);
+
+   /** @brief Queues execute() on a pool thread. */
+   ossimRefPtr<ossimHttpPendingResponse> executeAsync(const ossimString& method,
+                                                      const ossimUrl& url,
+                                                      const ossimKeywordlist& headers);
+
+   void setConnectTimeout(ossim_float64 seconds);
+   void setTimeout(ossim_float64 seconds);
+   void setRetries(ossim_uint32 retries);
+   void setMaxIdlePerHost(ossim_uint32 connections);
+   void setIdleSeconds(ossim_uint32 seconds);
+
+   /** @return false if http_pool.enabled is false. */
+   bool isEnabled() const;
+
+   /** @brief Closes all idle connections. */
+   void closeIdleConnections();
+
+   /** @return Connections opened so far, e.g. to check reuse. */
+   ossim_uint64 getNumberOfConnectionsOpened() const;
+
+protected:
+   ossimHttpConnectionPool();
+   ossimHttpConnectionPool(const ossimHttpConnectionPool&);
+   ~ossimHttpConnectionPool();
+
+   struct IdleConnection
+   {
+      ossim_int64 m_socket;
+      std::time_t m_since;
+   };
+
+   /**
+    * @brief Takes an idle connection to key, or connects a new one to host and port.
+    * @param reused Set if the connection was idle.
+    * @return false if no connection could be made.
+    */
+   bool acquire(const std::string& key, const ossimString& host, const ossimString& port,
+                ossim_int64& socket, bool& reused, ossimString& error);
+
+   /** Keeps socket for reuse if reusable and there is room, else closes it. */
+   void release(const std::string& key, ossim_int64 socket, bool reusable);
+
+   /** One attempt of execute() on one connection. */
+   bool executeOnce(const ossimString& method, const ossimUrl& url,
+                    const ossimKeywordlist& headers, ossimHttpResponse& response,
+                    bool& reused, bool& answered, ossimString& error);
+
+   mutable OpenThreads::Mutex                         m_mutex;
+   std::map<std::string, std::vector<IdleConnection> > m_idle;
+   ossim_float64                                      m_connectTimeout;
+   ossim_float64                                      m_timeout;
+   ossim_uint32                                       m_retries;
+   ossim_uint32                                       m_maxIdlePerHost;
+   ossim_uint32                                       m_idleSeconds;
+   bool                                               m_enabled;
+   ossim_uint64                                       m_connectionsOpened;
+   ossimRefPtr<ossimJobMultiThreadQueue>              m_queue;
+   static ossimHttpConnectionPool*                    theInstance;
+};
+
+/** @brief ossimHttpRequest sent through ossimHttpConnectionPool. */
+class OSSIM_DLL ossimPooledHttpRequest : public ossimHttpRequest
+{
+public:
+   ossimPooledHttpRequest();
+
+   /** @return The response, or null if none was had (see getLastError()). */
+   virtual ossimWebResponse* getResponse();
+
+   /** @brief Sends the request on a pool thread, returning at once. */
+   ossimRefPtr<ossimHttpPendingResponse> getResponseAsync();
+
+protected:
+   ossimString getMethodString() const;
+
+   TYPE_DATA;
+};
+
+/** @brief Creates ossimPooledHttpRequests for http:// urls unless http_pool.enabled is false. */
+class OSSIM_DLL ossimPooledHttpRequestFactory : public ossimWebRequestFactoryBase
+{
+public:
+   static ossimPooledHttpRequestFactory* instance();
+
+   virtual ossimWebRequest* create(const ossimUrl& url);
+
+   virtual ossimObject* createObject(const ossimString& typeName) const;
+   virtual ossimObject* createObject(const ossimKeywordlist& kwl, const char* prefix=0) const;
+   virtual void getTypeNameList(std::vector<ossimString>& typeList) const;
+
+protected:
+   ossimPooledHttpRequestFactory();
+   ossimPooledHttpRequestFactory(const ossimPooledHttpRequestFactory&);
+
+   static ossimPooledHttpRequestFactory* theInstance;
+};
+
+#endif /* #ifndef ossimHttpConnectionPool_HEADER */
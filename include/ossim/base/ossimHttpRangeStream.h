@@ -0,0 +1,196 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Input stream over http(s) range requests, so handlers opened on a url read only
+// the bytes they touch rather than the whole file.
+//
+// Classes:
+//   ossimHttpRangeCache         - Fixed size block cache of one url, shared by its streams.
+//   ossimHttpRangeStreamBuffer  - std::streambuf reading through the cache.
+//   ossimHttpRangeIFStream      - ossimIFStream on the buffer.
+//   ossimHttpRangeStreamFactory - Registered with ossimStreamFactoryRegistry for http:// and
+//                                 https:// names.
+//
+// The transport is the ossimHttpRequest of ossimWebRequestFactoryRegistry: for http:// the built
+// in keep-alive one (see ossimHttpConnectionPool.h), for https:// a plugin's (e.g. curl); with
+// none registered the factory returns no stream.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimHttpRangeStream_HEADER
+#define ossimHttpRangeStream_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimIoStream.h>
+#include <ossim/base/ossimReferenced.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimStreamFactoryBase.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimUrl.h>
+#include <OpenThreads/Condition>
+#include <OpenThreads/Mutex>
+#include <list>
+#include <map>
+#include <set>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+class ossimFilename;
+
+/**
+ * @brief Least recently used cache of the fixed size blocks of one url.
+ *
+ * Missing blocks of a read are grouped into runs of consecutive blocks, one range request per
+ * run, and the runs are fetched on up to getMaxConcurrentFetches() threads.  A block already
+ * being fetched for another reader is waited on rather than fetched twice.  Thread safe.
+ *
+ * Preferences (see ossim_preferences_template):
+ *   http_range_stream.block_size         Bytes per block, default 65536.
+ *   http_range_stream.cache_blocks       Blocks kept per url, default 512.
+ *   http_range_stream.concurrent_fetches Requests in flight per read, default 4.
+ */
+class OSSIM_DLL ossimHttpRangeCache : public ossimReferenced
+{
+public:
+   ossimHttpRangeCache(const ossimUrl& url);
+
+   /**
+    * @brief Fetches the first block, which also gives the size of the resource.
+    * @return true if the server answered with the data.
+    */
+   bool open();
+
+   /** @return Size in bytes of the resource, 0 if not open. */
+   ossim_uint64 getSize() const;
+
+   ossim_uint64 getBlockSize() const;
+
+   ossim_uint32 getMaxConcurrentFetches() const;
+
+   /**
+    * @brief Copies bytes [offset, offset+count) clipped to the size of the resource.
+    * @return Bytes copied; less than count at the end of the resource or on a failed request.
+    */
+   ossim_uint64 read(ossim_uint64 offset, char* buffer, ossim_uint64 count);
+
+   /**
+    * @brief Range request for bytes [begin, end) into data.
+    * @return true when the server returned exactly those bytes.
+    */
+   bool fetch(ossim_uint64 begin, ossim_uint64 end, std::vector<char>& data) const;
+
+protected:
+   virtual ~ossimHttpRangeCache();
+
+   struct Block
+   {
+      std::vector<char>                 m_data;
+      std::list<ossim_uint64>::iterator m_lru;
+   };
+
+   /**
+    * Range request for bytes [begin, end).  A 200 answer (range ignored) is cut down to the
+    * range.  total is set to the size of the resource.
+    */
+   bool request(ossim_uint64 begin, ossim_uint64 end, std::vector<char>& data,
+                ossim_uint64& total) const;
+
+   /** Adds or refreshes a block; call with m_mutex locked. */
+   void insertBlock(ossim_uint64 index, std::vector<char>& data);
+
+   /** Fetches and inserts one run of blocks [first, last], clearing their in flight marks. */
+   void fetchRun(const std::pair<ossim_uint64, ossim_uint64>& run);
+
+   /** fetchRun() on each run, on up to m_maxConcurrentFetches threads. */
+   void fetchRuns(const std::vector< std::pair<ossim_uint64, ossim_uint64> >& runs);
+
+   ossimUrl                         m_url;
+   ossim_uint64                     m_size;
+   ossim_uint64                     m_blockSize;
+   ossim_uint32                     m_maxBlocks;
+   ossim_uint32                     m_maxConcurrentFetches;
+   std::map<ossim_uint64, Block>    m_blocks;
+   std::list<ossim_uint64>          m_lru;      // Most recent at front.
+   std::set<ossim_uint64>           m_inFlight;
+   mutable OpenThreads::Mutex       m_mutex;
+   OpenThreads::Condition           m_fetched;
+
+   friend class ossimHttpRangeFetchThread;
+};
+
+/** @brief Seekable read only std::streambuf on an ossimHttpRangeCache. */
+class OSSIM_DLL ossimHttpRangeStreamBuffer : public std::streambuf
+{
+public:
+   ossimHttpRangeStreamBuffer(ossimHttpRangeCache* cache);
+
+protected:
+   virtual int_type underflow();
+   virtual std::streamsize xsgetn(char_type* s, std::streamsize n);
+   virtual std::streamsize showmanyc();
+   virtual pos_type seekoff(off_type offset, std::ios_base::seekdir dir,
+                            std::ios_base::openmode mode = std::ios_base::in);
+   virtual pos_type seekpos(pos_type pos,
+                            std::ios_base::openmode mode = std::ios_base::in);
+
+   /** @return File offset of gptr(). */
+   ossim_uint64 position() const;
+
+   /** Empties the get area and puts the position at pos. */
+   void setPosition(ossim_uint64 pos);
+
+   ossimRefPtr<ossimHttpRangeCache> m_cache;
+   std::vector<char>                m_buffer;
+   ossim_uint64                     m_bufferOffset; // File offset of eback().
+};
+
+/**
+ * @brief ossimIFStream reading a url through an ossimHttpRangeStreamBuffer.  The file buffer
+ * of the base class is never opened; use this is_open() rather than std::ifstream's.
+ */
+class OSSIM_DLL ossimHttpRangeIFStream : public ossimIFStream
+{
+public:
+   ossimHttpRangeIFStream(ossimHttpRangeCache* cache);
+   virtual ~ossimHttpRangeIFStream();
+
+   bool is_open() const;
+
+   /** @return Size in bytes of the resource. */
+   ossim_uint64 getSize() const;
+
+protected:
+   ossimRefPtr<ossimHttpRangeCache> m_cache;
+   ossimHttpRangeStreamBuffer       m_buffer;
+};
+
+/**
+ * @brief Stream factory for http:// and https:// names.  Streams on the same url share one
+ * ossimHttpRangeCache while any of them is alive.
+ */
+class OSSIM_DLL ossimHttpRangeStreamFactory : public ossimStreamFactoryBase
+{
+public:
+   static ossimHttpRangeStreamFactory* instance();
+   virtual ~ossimHttpRangeStreamFactory();
+
+   /** @return An ossimHttpRangeIFStream, or null if file is not a url or cannot be read. */
+   virtual ossimRefPtr<ossimIFStream> createNewIFStream(
+      const ossimFilename& file, std::ios_base::openmode openMode) const;
+
+   /** @return true if file starts with http:// or https://. */
+   static bool isUrl(const ossimString& file);
+
+protected:
+   ossimHttpRangeStreamFactory();
+   ossimHttpRangeStreamFactory(const ossimHttpRangeStreamFactory&);
+
+   mutable OpenThreads::Mutex m_mutex;
+   mutable std::map< std::string, ossimRefPtr<ossimHttpRangeCache> > m_caches;
+   static ossimHttpRangeStreamFactory* theInstance;
+};
+
+#endif /* #ifndef ossimHttpRangeStream_HEADER */
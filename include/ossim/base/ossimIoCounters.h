@@ -0,0 +1,56 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Read counters of a stream or image handler.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimIoCounters_HEADER
+#define ossimIoCounters_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimTimer.h>
+#include <OpenThreads/Mutex>
+
+//*************************************************************************************************
+//! Bytes read, read calls, seeks and time spent reading of one stream or image handler, for
+//! telling I/O bound runs apart and seeing the read amplification of a reader. Safe to update
+//! and read from several threads.
+//*************************************************************************************************
+class OSSIM_DLL ossimIoCounters
+{
+public:
+   struct OSSIM_DLL Values
+   {
+      Values();
+      Values& operator+=(const Values& rhs);
+
+      ossim_uint64 m_bytesRead;
+      ossim_uint64 m_reads;
+      ossim_uint64 m_seeks;
+      double       m_readSeconds;
+   };
+
+   ossimIoCounters();
+
+   //! Counts a read of bytes (none if negative) that took from begin to end.
+   void addRead(ossim_int64 bytes, ossimTimer::Timer_t begin, ossimTimer::Timer_t end);
+
+   void addSeek();
+
+   Values getValues() const;
+
+   void reset();
+
+private:
+   // Not copyable.
+   ossimIoCounters(const ossimIoCounters&);
+   const ossimIoCounters& operator=(const ossimIoCounters&);
+
+   mutable OpenThreads::Mutex m_mutex;
+   Values                     m_values;
+};
+
+#endif /* #ifndef ossimIoCounters_HEADER */
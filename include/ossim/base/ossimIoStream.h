@@ -15,6 +15,7 @@
 // ossimIMemoryStream
 // ossimOMemoryStream
 // ossimIOFStream
+// ossimCountingStreamBuf
 // ossimIFStream
 // ossimOFStream
 //
@@ -25,9 +26,11 @@
 
 #include <ossim/base/ossimConstants.h>
 #include <ossim/base/ossimStreamBase.h>
+#include <ossim/base/ossimIoCounters.h>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <vector>
 #include <ossim/base/ossimString.h>
 
 
@@ -139,6 +142,48 @@ public:
    virtual ~ossimIOFStream();
 };
 
+/**
+ * @brief Read only std::streambuf over another, counting the reads, seeks and read time.
+ * The target is read in chunks of its own buffer size, so the reads counted are those the
+ * target sees; larger requests go straight through.
+ */
+class OSSIM_DLL ossimCountingStreamBuf : public std::streambuf
+{
+public:
+   ossimCountingStreamBuf();
+
+   /** Reads through sb from now on; empties the get area. */
+   void setTarget(std::streambuf* sb);
+
+   std::streambuf* getTarget() const;
+
+   /** Empties the get area, e.g. when the target is reopened. */
+   void reset();
+
+   const ossimIoCounters& getCounters() const;
+
+protected:
+   virtual int_type underflow();
+   virtual std::streamsize xsgetn(char_type* s, std::streamsize n);
+   virtual std::streamsize showmanyc();
+   virtual pos_type seekoff(off_type offset, std::ios_base::seekdir dir,
+                            std::ios_base::openmode mode = std::ios_base::in);
+   virtual pos_type seekpos(pos_type pos,
+                            std::ios_base::openmode mode = std::ios_base::in);
+   virtual int sync();
+
+   /** Counted read of n bytes of the target into s. */
+   std::streamsize readTarget(char_type* s, std::streamsize n);
+
+   std::streambuf*   m_target;
+   std::vector<char> m_buffer;
+   ossimIoCounters   m_counters;
+};
+
+/**
+ * @brief Input file stream counting its reads: reads go through an ossimCountingStreamBuf on
+ * the file buffer, or on the buffer a derived stream passes to countIo().
+ */
 class OSSIM_DLL ossimIFStream : public ossimStreamBase, public std::basic_ifstream<char>
 {
 public:
@@ -149,6 +194,19 @@ public:
 
    virtual ~ossimIFStream();
 
+   virtual void open(const char* file,
+                     std::ios_base::openmode mode = std::ios_base::in);
+
+   virtual void close();
+
+   /** @return Bytes read, reads, seeks and read time of the stream buffer. */
+   const ossimIoCounters& getIoCounters() const;
+
+protected:
+   /** Reads through sb, counting; derived streams call this in place of init(). */
+   void countIo(std::streambuf* sb);
+
+   ossimCountingStreamBuf m_countingBuffer;
 };
 
 class OSSIM_DLL ossimOFStream : public ossimStreamBase, public std::basic_ofstream<char>
@@ -419,6 +419,29 @@ public:
    virtual bool parseStream(std::istream& is);
    virtual bool parseString(const std::string& inString);
 
+   /**
+    * @brief Parses keyword list text in memory, [begin, end).  This is what
+    * parseStream(), parseString() and addFile() parse through: whole lines are
+    * tokenized in place rather than a character at a time off a stream.
+    * @return true on success, false on a malformed list.
+    */
+   bool parseBuffer(const char* begin, const char* end);
+
+   /**
+    * @brief Range of the keys starting with prefix.  The map is sorted, so
+    * this is two lookups, not a scan of the whole map.
+    */
+   std::pair<KeywordMap::const_iterator, KeywordMap::const_iterator>
+      getPrefixRange(const std::string& prefix)const;
+
+   /**
+    * @brief Finds keys starting with prefix.
+    *
+    * Note: This does not clear vector passed to it.
+    */
+   void findAllKeysWithPrefix(std::vector<ossimString>& result,
+                              const std::string& prefix)const;
+
    /*!
     *  Will return a list of keys that contain the string passed in.
     *  Later we will need to allow a user to specify regular expresion
@@ -430,6 +453,9 @@ public:
    /**
     * @brief Finds keys that match regular expression.
     *
+    * Expressions anchored with '^' only look at the keys starting with the
+    * literal text after the '^', as do the other regular expression methods.
+    *
     * Note: This does not clear vector passed to it.
     *
     * @param result Initialized by this.
@@ -534,6 +560,16 @@ protected:
    KeywordlistParseState readKey(ossimString& sequence, std::istream& in)const;
    KeywordlistParseState readValue(ossimString& sequence, std::istream& in)const;
    KeywordlistParseState readKeyAndValuePair(ossimString& key, ossimString& value, std::istream& in)const;
+
+   /** Handles a "#" line, e.g. "#include <file>". */
+   void processPreprocDirective(const ossimString& line);
+
+   /**
+    * @return Range of the keys the regular expression can match: those with
+    * its literal prefix if anchored with '^', else the whole map.
+    */
+   std::pair<KeywordMap::const_iterator, KeywordMap::const_iterator>
+      getRegExpRange(const ossimString& regularExpression)const;
    
    // Method to see if keyword exists in list.
    KeywordMap::iterator getMapEntry(const std::string& key);
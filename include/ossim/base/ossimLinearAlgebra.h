@@ -0,0 +1,91 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description:
+//
+// Matrix operations behind NEWMAT types, done by LAPACK/BLAS when
+// OSSIM_HAS_LAPACK is set in ossimConfig.h and by newmat otherwise.
+//
+//*******************************************************************
+// $Id$
+
+#ifndef ossimLinearAlgebra_HEADER
+#define ossimLinearAlgebra_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/matrix/newmat.h>
+
+/**
+ * @brief Hot matrix operations of the model solvers (least squares, SVD,
+ * Cholesky, products), so call sites using NEWMAT operators and NEWMAT::SVD
+ * can move over one at a time.
+ *
+ * Arguments and results stay NEWMAT types; with LAPACK they are copied to
+ * and from column major buffers, which costs O(n^2) against the O(n^3) of
+ * the operation.  Both backends return the same results to rounding.
+ */
+class OSSIMDLLEXPORT ossimLinearAlgebra
+{
+public:
+
+   /** @return "lapack" or "newmat". */
+   static const char* getBackendName();
+
+   /** @brief result = a * b. */
+   static void multiply(const NEWMAT::Matrix& a,
+                        const NEWMAT::Matrix& b,
+                        NEWMAT::Matrix& result);
+
+   /** @brief result = a.t() * b, e.g. the normal matrix of a design matrix. */
+   static void transposeMultiply(const NEWMAT::Matrix& a,
+                                 const NEWMAT::Matrix& b,
+                                 NEWMAT::Matrix& result);
+
+   /**
+    * @brief Singular value decomposition a = u * d * v.t(), as NEWMAT::SVD
+    * with u and v wanted.  Singular values are in no particular order.
+    * @param a Matrix with at least as many rows as columns.
+    * @return false if it does not converge or a is wider than tall.
+    */
+   static bool svd(const NEWMAT::Matrix& a,
+                   NEWMAT::DiagonalMatrix& d,
+                   NEWMAT::Matrix& u,
+                   NEWMAT::Matrix& v);
+
+   /**
+    * @brief Pseudo inverse v * d^-1 * u.t() of a, singular values not above
+    * threshold taken as zero.
+    * @return Number of singular values kept, 0 if the SVD failed.
+    */
+   static ossim_uint32 pseudoInverse(const NEWMAT::Matrix& a,
+                                     double threshold,
+                                     NEWMAT::Matrix& result);
+
+   /**
+    * @brief Least squares solution x of a * x = b through pseudoInverse.
+    * @return Number of singular values kept, 0 if the SVD failed.
+    */
+   static ossim_uint32 solveLeastSquares(const NEWMAT::Matrix& a,
+                                         const NEWMAT::ColumnVector& b,
+                                         double threshold,
+                                         NEWMAT::ColumnVector& x);
+
+   /**
+    * @brief Cholesky factor l of a = l * l.t().
+    * @return false if a is not positive definite.
+    */
+   static bool cholesky(const NEWMAT::SymmetricMatrix& a,
+                        NEWMAT::LowerTriangularMatrix& l);
+
+   /**
+    * @brief Solves a * x = b for positive definite a through its Cholesky
+    * factor.
+    * @return false if a is not positive definite.
+    */
+   static bool solveSymmetric(const NEWMAT::SymmetricMatrix& a,
+                              const NEWMAT::ColumnVector& b,
+                              NEWMAT::ColumnVector& x);
+};
+
+#endif /* #ifndef ossimLinearAlgebra_HEADER */
@@ -0,0 +1,58 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Read only, shared memory mapping of a whole file.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimMemoryMappedFile_HEADER
+#define ossimMemoryMappedFile_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimReferenced.h>
+#include <ossim/base/ossimFilename.h>
+
+//*************************************************************************************************
+//! Maps a file read only and shared, so its pages live in the page cache and are shared by every
+//! handler and process mapping the same file instead of each holding a private copy.
+//!
+//! Opening is O(1); pages are read on first touch. Copies of a handler share the mapping by
+//! holding the same ossimRefPtr, and it is unmapped when the last reference goes.
+//*************************************************************************************************
+class OSSIM_DLL ossimMemoryMappedFile : public ossimReferenced
+{
+public:
+   ossimMemoryMappedFile();
+
+   //! Maps file; any previous mapping is released first.
+   //! @return true on success, false if the file can't be opened, is empty or mapping fails.
+   bool open(const ossimFilename& file);
+
+   void close();
+
+   bool isOpen() const { return (m_data != 0); }
+
+   //! @return Start of the mapping, null if not open.
+   const ossim_uint8* data() const { return m_data; }
+
+   //! @return Mapped size in bytes, the file size.
+   ossim_uint64 size() const { return m_size; }
+
+   const ossimFilename& getFilename() const { return m_filename; }
+
+protected:
+   virtual ~ossimMemoryMappedFile();
+
+   // Not copyable; share through ossimRefPtr.
+   ossimMemoryMappedFile(const ossimMemoryMappedFile&);
+   const ossimMemoryMappedFile& operator=(const ossimMemoryMappedFile&);
+
+   ossimFilename      m_filename;
+   const ossim_uint8* m_data;
+   ossim_uint64       m_size;
+   void*              m_mapping; //!< Windows file mapping handle.
+};
+
+#endif /* #ifndef ossimMemoryMappedFile_HEADER */
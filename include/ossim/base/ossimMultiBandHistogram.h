@@ -41,6 +41,13 @@ public:
 
    void create(ossim_int32 numberOfBands);
    void setBinCount(double binNumber, double count);
+
+   /*!
+    * Adds the counts of each band of histo, which must have the same bands
+    * and buckets (see ossimHistogram::AddCounts).  Returns false if not.
+    */
+   bool addCounts(const ossimMultiBandHistogram& histo);
+
    ossimRefPtr<ossimHistogram> getHistogram(ossim_int32 band);
    const ossimRefPtr<ossimHistogram> getHistogram(ossim_int32 band)const;
 
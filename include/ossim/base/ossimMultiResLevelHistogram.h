@@ -38,6 +38,13 @@ public:
    ossimRefPtr<ossimMultiResLevelHistogram> createAccumulationGreaterThanEqual()const;
 
    void setBinCount(double binNumber, double count);
+
+   /*!
+    * Adds the counts of each level of histo, which must have the same levels,
+    * bands and buckets.  Returns false if not.
+    */
+   bool addCounts(const ossimMultiResLevelHistogram& histo);
+
    /*!
     * Will append to the list the passed in histogram.
     */
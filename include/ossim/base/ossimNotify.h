@@ -71,6 +71,33 @@ OSSIMDLLEXPORT void ossimSetLogFilename(const ossimFilename& filename);
 OSSIMDLLEXPORT void ossimGetLogFilename(ossimFilename& logFile);
 
 
+/**
+ * @brief Enables asynchronous notification.  Off by default; also set by the preferences
+ * keyword "ossim.log.async: true".
+ *
+ * When on, ossimNotify() returns a stream buffered per thread.  Each line written to it, and
+ * any text flushed with std::flush or std::endl, becomes a record on a lock-free queue drained
+ * by one writer thread to the notify streams or log file, so a thread reporting never waits on
+ * another, or on the output.  The writer prints consecutive repeats of a message once followed
+ * by a count, applies ossimSetNotifyRateLimit(), and drains the queue on exit and, as far as it
+ * can, on a fatal signal.
+ */
+OSSIMDLLEXPORT void ossimSetNotifyAsync(bool flag);
+OSSIMDLLEXPORT bool ossimGetNotifyAsync();
+
+/**
+ * @brief Caps asynchronous notification at messagesPerSecond; the number dropped is reported
+ * once the next second starts.  0, the default, is no limit.  Also set by the preferences
+ * keyword "ossim.log.rate_limit".
+ */
+OSSIMDLLEXPORT void ossimSetNotifyRateLimit(ossim_uint32 messagesPerSecond);
+
+/**
+ * @brief Returns once the calling thread's buffered text and every message queued before the
+ * call are written.  Does nothing unless asynchronous.
+ */
+OSSIMDLLEXPORT void ossimFlushNotify();
+
 /**
  *
  */
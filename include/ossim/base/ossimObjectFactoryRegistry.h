@@ -24,24 +24,15 @@ public:
    virtual ~ossimObjectFactoryRegistry();
    static ossimObjectFactoryRegistry* instance();
    
-   virtual ossimObject* createObject(const ossimString& name)const
-   {
-      return createObjectFromRegistry(name);
-   }
+   virtual ossimObject* createObject(const ossimString& name)const;
    virtual ossimObject* createObject(const ossimKeywordlist& kwl,
-                                     const char* prefix=0)const
-   {
-      return createObjectFromRegistry(kwl, prefix);
-   }
+                                     const char* prefix=0)const;
    
    /*!
     * Returns a type list of all objects that can be instantiated
     * through the createObjectMethods above.
     */
-   virtual void getTypeNameList(std::vector<ossimString>& typeList)const
-   {
-      getAllTypeNamesFromRegistry(typeList);
-   }
+   virtual void getTypeNameList(std::vector<ossimString>& typeList)const;
 
    /*!
     * returns a list of objects that are of the passed in
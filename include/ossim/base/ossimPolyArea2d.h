@@ -66,7 +66,30 @@ public:
    ossimPolyArea2d operator -(const ossimPolyArea2d& rhs)const;
    const ossimPolyArea2d& operator -=(const ossimPolyArea2d& rhs);
    
+   /** Relation of a rectangle to the area, see classify. */
+   enum RectRelation
+   {
+      RECT_OUTSIDE  = 0, // No point in common.
+      RECT_INSIDE   = 1, // Covered by the area.
+      RECT_CROSSING = 2  // Partly covered, or undetermined.
+   };
+
+   /**
+    * Predicates on the same area are answered from a GEOS prepared
+    * geometry, built on the second call and dropped when the area changes,
+    * so the area's edge index is built once rather than per call.
+    */
    bool intersects(const ossimPolyArea2d& rhs)const;
+
+   /** @return true if rect has any point in common with the area. */
+   bool intersectsRect(const ossimDrect& rect)const;
+
+   /**
+    * @return Whether rect is outside, inside or crossing the edge of the
+    * area, e.g. to mask only the tiles crossing a cut polygon pixel by pixel.
+    */
+   RectRelation classify(const ossimDrect& rect)const;
+   RectRelation classify(const ossimIrect& rect)const;
    
    void add(const ossimPolyArea2d& rhs);
    bool getVisiblePolygons(vector<ossimPolygon>& polyList)const;
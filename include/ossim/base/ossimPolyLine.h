@@ -100,6 +100,19 @@ public:
       }
    
    void roundToIntegerBounds(bool compress=true);
+
+   /*!
+    * Removes the vertices closer than tolerance to the line through the
+    * vertices kept around them (Douglas-Peucker).  The end points are
+    * always kept.  Meant for geometry in pixels, to drop what cannot be
+    * seen at the output resolution.
+    */
+   void simplify(double tolerance);
+
+   /*!
+    * simplify() on a vertex list, also used for ossimPolygon.
+    */
+   static void simplify(vector<ossimDpt>& vertices, double tolerance);
    void clear()
       {
          theVertexList.clear();
@@ -93,6 +93,13 @@ public:
    
    void roundToIntegerBounds(bool compress=false);
 
+   /**
+    * Removes the vertices closer than tolerance to the outline through the
+    * vertices kept (see ossimPolyLine::simplify).  A polygon that would
+    * keep less than three vertices is left as is.
+    */
+   void simplify(double tolerance);
+
    void clear();
 
    void addPoint(const ossimDpt& pt);
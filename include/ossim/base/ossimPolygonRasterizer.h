@@ -0,0 +1,67 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+//*******************************************************************
+#ifndef ossimPolygonRasterizer_HEADER
+#define ossimPolygonRasterizer_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimIrect.h>
+#include <utility>
+#include <vector>
+
+class ossimPolygon;
+
+/**
+ * Scanline rasterization of polygons into the runs of pixels they cover,
+ * clipped to a rectangle such as a tile.  As with ossimActiveEdgeTable,
+ * vertices are rounded to pixels and each polygon is filled even-odd,
+ * edges included.  Edges are indexed by bands of rows, so rasterizing a
+ * tile costs the edges crossing its rows rather than every edge of the
+ * polygons, and no polygon is clipped to the tile.
+ */
+class OSSIMDLLEXPORT ossimPolygonRasterizer
+{
+public:
+   /** First and last x of a run of pixels, inclusive. */
+   typedef std::pair<ossim_int32, ossim_int32> Span;
+   typedef std::vector<Span> SpanList;
+
+   ossimPolygonRasterizer();
+
+   /** Indexes the edges of polygons, replacing those of previous calls. */
+   void setPolygons(const std::vector<ossimPolygon>& polygons);
+
+   void clear();
+
+   /**
+    * Sets spans[row - rect.ul().y], for each row of rect, to the union of
+    * the polygons on that row within rect, sorted and disjoint.
+    */
+   void getSpans(const ossimIrect& rect, std::vector<SpanList>& spans) const;
+
+private:
+   struct Edge
+   {
+      ossim_int32  theTopY;    // y1 < y2
+      ossim_int32  theBottomY;
+      ossim_int32  theTopX;
+      ossim_int32  theBottomX;
+      ossim_int32  thePolygonMaxY;
+      ossim_uint32 thePolygon;
+
+      bool operator<(const Edge& rhs) const { return (theTopY < rhs.theTopY); }
+   };
+
+   ossim_int32 getBand(ossim_int32 y) const;
+
+   std::vector<Edge>                       theEdges;
+
+   /** Indexes in theEdges of the edges crossing each band of rows. */
+   std::vector< std::vector<ossim_uint32> > theBands;
+   ossim_int32                              theMinY;
+   ossim_int32                              theMaxY;
+};
+
+#endif /* #ifndef ossimPolygonRasterizer_HEADER */
@@ -0,0 +1,65 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: File read (or written) at explicit offsets, shareable between threads.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimPositionalFile_HEADER
+#define ossimPositionalFile_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimFilename.h>
+
+//*************************************************************************************************
+//! File whose reads each carry their own offset (pread on POSIX, an overlapped offset on
+//! Windows), so there is no shared file position and any number of threads may read at once
+//! without a lock. Opened with openForUpdate(), disjoint ranges may be written the same way.
+//*************************************************************************************************
+class OSSIM_DLL ossimPositionalFile
+{
+public:
+   ossimPositionalFile();
+   ~ossimPositionalFile();
+
+   //! Opens file read only; any previous file is closed first. @return true on success.
+   bool open(const ossimFilename& file);
+
+   //! Opens an existing file for reading and writing, e.g. one being written through a stream
+   //! that is flushed first; any previous file is closed first. @return true on success.
+   bool openForUpdate(const ossimFilename& file);
+
+   void close();
+
+   bool isOpen() const;
+
+   //! Reads bytes at offset into buf. Safe to call from several threads at once.
+   //! @return true if all bytes were read, false on error or short read past the end.
+   bool read(ossim_uint64 offset, void* buf, ossim_uint32 bytes) const;
+
+   //! Writes bytes of buf at offset, extending the file if needed. Safe to call from several
+   //! threads at once on disjoint ranges. Does not change size().
+   //! @return true if all bytes were written.
+   bool write(ossim_uint64 offset, const void* buf, ossim_uint32 bytes) const;
+
+   //! @return File size in bytes at open.
+   ossim_uint64 size() const { return m_size; }
+
+private:
+   // Not copyable.
+   ossimPositionalFile(const ossimPositionalFile&);
+   const ossimPositionalFile& operator=(const ossimPositionalFile&);
+
+   bool open(const ossimFilename& file, bool update);
+
+#if defined(_WIN32)
+   void*        m_handle;
+#else
+   int          m_fd;
+#endif
+   ossim_uint64 m_size;
+};
+
+#endif /* #ifndef ossimPositionalFile_HEADER */
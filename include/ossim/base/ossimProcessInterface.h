@@ -65,6 +65,18 @@ public:
 
    void setCurrentMessage(const ossimString& message);
 
+   /**
+    * Work reported by the progress events of the following
+    * setPercentComplete calls, for throughput and ETA: the phase name, the
+    * work units (tiles) of the phase, and the pixels and image bytes written
+    * per unit (0 if not writing).  The units, pixels and bytes done are
+    * derived from the percent complete.  A phase of "" stops reporting.
+    */
+   void setProgressWork(const ossimString& phase,
+                        ossim_uint64 totalUnits,
+                        ossim_uint64 pixelsPerUnit=0,
+                        ossim_uint64 bytesPerUnit=0);
+
    /*!
     *  Called by friend operator<< function, derived classes should override
     *  if something different is desired.
@@ -75,10 +87,17 @@ public:
                                              const ossimProcessInterface& data);
    
 protected:
+   /** Sets the work of the event from setProgressWork and the percent complete. */
+   void initializeProgressWork(ossimProcessProgressEvent& event) const;
+
    double              thePercentComplete;
    ossimProcessStatus  theProcessStatus;
    ossimString         theMessage;
    bool                theEventFlag;
+   ossimString         theProgressPhase;
+   ossim_uint64        theProgressTotalUnits;
+   ossim_uint64        theProgressPixelsPerUnit;
+   ossim_uint64        theProgressBytesPerUnit;
 
 TYPE_DATA
 };
@@ -40,11 +40,42 @@ public:
    void setOutputMessageFlag(bool flag);
 
    bool getOutputMessageFlag() const;
+
+   /**
+    * Phase of the process, e.g. "write", "overviews", "histogram"; empty if
+    * the process does not report its work.
+    */
+   const ossimString& getPhase() const;
+
+   void setPhase(const ossimString& phase);
+
+   /** Work units, tiles for the writers and builders, done so far. */
+   ossim_uint64 getUnitsComplete() const;
+
+   /** Work units of the phase; 0 if the process does not report its work. */
+   ossim_uint64 getTotalUnits() const;
+
+   void setUnits(ossim_uint64 unitsComplete, ossim_uint64 totalUnits);
+
+   /** Pixels of the units done. */
+   ossim_uint64 getPixelsComplete() const;
+
+   void setPixelsComplete(ossim_uint64 pixels);
+
+   /** Image bytes of the units done, as handed to the writer; 0 if not writing. */
+   ossim_uint64 getBytesComplete() const;
+
+   void setBytesComplete(ossim_uint64 bytes);
       
 protected:
-   double      thePercentComplete;
-   ossimString theMessage;
-   bool        theOutputMessageFlag;
+   double       thePercentComplete;
+   ossimString  theMessage;
+   bool         theOutputMessageFlag;
+   ossimString  thePhase;
+   ossim_uint64 theUnitsComplete;
+   ossim_uint64 theTotalUnits;
+   ossim_uint64 thePixelsComplete;
+   ossim_uint64 theBytesComplete;
 
 TYPE_DATA
 };
@@ -16,10 +16,13 @@
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossim2dTo2dTransform.h>
+#include <OpenThreads/Atomic>
+#include <OpenThreads/Mutex>
 #include <vector>
 #include <iosfwd>
 
 class ossimQuadTreeWarpNode;
+class ossimQuadTreeWarpIndex;
 
 class OSSIMDLLEXPORT ossimQuadTreeWarpVertex
 {
@@ -140,6 +143,14 @@ public:
     * Will warp the passed in point and overwrite it
     */
    virtual void forward(ossimDpt& pt)const;
+
+   /*!
+    * Warps count points.  Same results as forward() on each point;
+    * output may be the same array as input.
+    */
+   virtual void forwardPoints(const ossimDpt* input,
+                              ossimDpt* output,
+                              ossim_uint32 count)const;
    
 //    void inverse(const ossimDpt& input,
 //                 ossimDpt&       output) const;
@@ -170,6 +181,8 @@ public:
    
    /*!
     * Will get the shift or delta value for the passed in pt.
+    * The leaf is looked up in a flattened index of the tree (see
+    * getIndex()) and gives the same node as findNode(pt).
     */
    void getShift(ossimDpt& result,
                  const ossimDpt& pt)const;
@@ -252,6 +265,24 @@ protected:
    ossimQuadTreeWarpNode*           theTree;
    std::vector<ossimQuadTreeWarpVertex*> theVertexList;
 
+   /*!
+    * Flattened copy of the leaves: their bounds and vertices in tree
+    * order, bucketed by a regular grid over the root.  Built on the first
+    * lookup after the tree changes shape; the vertex deltas are read
+    * through the vertices so setDelta() and friends need no rebuild.
+    */
+   mutable ossimQuadTreeWarpIndex*  theIndex;
+   mutable OpenThreads::Atomic      theIndexValidFlag;
+   mutable OpenThreads::Mutex       theIndexMutex;
+
+   const ossimQuadTreeWarpIndex* getIndex()const;
+
+   /*!
+    * Drops the flattened index.  Called by everything that adds or removes
+    * nodes.
+    */
+   void invalidateIndex();
+
    void getShift(ossimDpt& result,
                  const ossimQuadTreeWarpNode* node,
                  const ossimDpt& pt)const;
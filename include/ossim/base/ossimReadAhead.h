@@ -0,0 +1,53 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Asks the operating system to start reading parts of a file into its page cache
+// ahead of demand (posix_fadvise WILLNEED where available).
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimReadAhead_HEADER
+#define ossimReadAhead_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+
+class ossimFilename;
+
+/**
+ * @brief Read ahead hints for one file.
+ *
+ * Used by the image handlers to implement ossimImageHandler::prefetch.  The reads are done by
+ * the kernel, in the background, into the page cache shared with the handler's own streams; later
+ * reads of the range do not wait on the disk or network.  A no-op where the platform has no such
+ * hint or the file is not local (e.g. a stream from ossimStreamFactoryRegistry).
+ */
+class OSSIM_DLL ossimReadAhead
+{
+public:
+   ossimReadAhead();
+   ~ossimReadAhead();
+
+   /** @return true if file was opened for hints. */
+   bool open(const ossimFilename& file);
+
+   void close();
+
+   bool isOpen() const;
+
+   /**
+    * @brief Hints that bytes [offset, offset + length) of the file will be read soon.
+    * Returns without waiting for the read.
+    */
+   void willNeed(ossim_uint64 offset, ossim_uint64 length);
+
+private:
+   // Not copyable.
+   ossimReadAhead(const ossimReadAhead&);
+   const ossimReadAhead& operator=(const ossimReadAhead&);
+
+   int m_fd;
+};
+
+#endif /* #ifndef ossimReadAhead_HEADER */
@@ -5,6 +5,7 @@
 #ifndef ossimReferenced_HEADER
 #define ossimReferenced_HEADER
 #include <ossim/base/ossimConstants.h>
+#include <OpenThreads/Atomic>
 #include <OpenThreads/ScopedLock>
 #include <OpenThreads/Mutex>
 
@@ -12,12 +13,12 @@ class OSSIMDLLEXPORT ossimReferenced
 {
  public:
    ossimReferenced()
-   : theRefMutex(new OpenThreads::Mutex),
+   : theRefMutex(0),
      theRefCount(0)
       {}
    
    ossimReferenced(const ossimReferenced&)
-   : theRefMutex(new OpenThreads::Mutex),
+   : theRefMutex(0),
    theRefCount(0)
    {}
    inline ossimReferenced& operator = (const ossimReferenced&) { return *this; }
@@ -41,54 +42,38 @@ class OSSIMDLLEXPORT ossimReferenced
        as the later can lead to memory leaks.*/
    inline void unref_nodelete() const 
    { 
-      if (theRefMutex)
-      {
-         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(*theRefMutex); 
-         --theRefCount;
-      }
-      else
-      {
-         --theRefCount;
-      }
+      --theRefCount;
    }
    
    /*! return the number pointers currently referencing this object. */
-   inline int referenceCount() const { return theRefCount; }
+   inline int referenceCount() const { return (int)(unsigned)theRefCount; }
    
    
  protected:
    virtual ~ossimReferenced();
+
+   /*!
+    * Unused and always null.  The count is atomic; this only keeps the layout of derived
+    * classes, and the unlocked branch of code inlined from older headers, as they were.
+    */
    mutable OpenThreads::Mutex*     theRefMutex;
-   mutable int theRefCount;
+
+   /*!
+    * Atomic increments and decrements are full barriers, so writes made through one reference
+    * are visible to the thread whose unref() deletes the object.
+    */
+   mutable OpenThreads::Atomic     theRefCount;
 };
 
 inline void ossimReferenced::ref() const
 {
-   if (theRefMutex)
-   {
-      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(*theRefMutex); 
-      ++theRefCount;
-   }
-   else
-   {
-      ++theRefCount;
-   }
+   ++theRefCount;
 }
 
 inline void ossimReferenced::unref() const
 {
-   bool needDelete = false;
-   if (theRefMutex)
-   {
-      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(*theRefMutex); 
-      --theRefCount;
-      needDelete = theRefCount<=0;
-   }
-   else
-   {
-      --theRefCount;
-      needDelete = theRefCount<=0;
-   }
+   // Only the thread taking the count to zero (or below, as before) sees it there.
+   const bool needDelete = ( (int)(--theRefCount) <= 0 );
    
    if (needDelete)
    {
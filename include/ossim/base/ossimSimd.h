@@ -0,0 +1,62 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Runtime detection of the vector instruction sets available to the SIMD kernels.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimSimd_HEADER
+#define ossimSimd_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+
+//---
+// OSSIM_SIMD_X86 is defined when the compiler can emit SSE2/SSSE3/AVX2 code paths selected at
+// runtime (gcc/clang function target attributes). Other compilers and architectures use the scalar
+// kernels only, which are written branch-free so the compiler can auto-vectorize them (e.g. NEON).
+//---
+#if ( defined(__GNUC__) || defined(__clang__) ) && ( defined(__x86_64__) || defined(__i386__) )
+#  define OSSIM_SIMD_X86 1
+#  define OSSIM_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#  define OSSIM_SIMD_X86 0
+#  define OSSIM_SIMD_TARGET(isa)
+#endif
+
+namespace ossim
+{
+   /** @brief Vector instruction set levels, ordered from least to most capable. */
+   enum SimdLevel
+   {
+      SIMD_SCALAR = 0,
+      SIMD_SSE2   = 1,
+      SIMD_SSSE3  = 2,
+      SIMD_AVX2   = 3
+   };
+
+   /**
+    * @brief Gets the vector instruction set level used by the SIMD kernels.
+    *
+    * The level is detected from the cpu on first call. It may be lowered with the preferences
+    * keyword "simd_level" (scalar, sse2, ssse3, avx2) or with setSimdLevel(), e.g. to compare
+    * results or timing against the scalar code.
+    */
+   OSSIM_DLL SimdLevel getSimdLevel();
+
+   /**
+    * @brief Overrides the level used by the SIMD kernels. Requests above what the cpu supports
+    * are capped to the detected level.
+    */
+   OSSIM_DLL void setSimdLevel(SimdLevel level);
+
+   /** @return Level detected from the cpu, regardless of any override. */
+   OSSIM_DLL SimdLevel getCpuSimdLevel();
+
+   /** @return String for level, e.g. "avx2". */
+   OSSIM_DLL const char* simdLevelString(SimdLevel level);
+
+} // End: namespace ossim
+
+#endif /* #ifndef ossimSimd_HEADER */
@@ -15,19 +15,91 @@
 #include <ossim/base/ossimProcessListener.h>
 #include <ossim/base/ossimProcessProgressEvent.h>
 #include <ossim/base/ossimNotifyContext.h>
+#include <ossim/base/ossimTimer.h>
+#include <OpenThreads/Mutex>
+#include <iosfwd>
+#include <map>
+#include <string>
 
+/**
+ * Prints the progress of a process.
+ *
+ * When the events carry work (see ossimProcessInterface::setProgressWork),
+ * the percent is followed by the tiles/s, megapixels/s and MB/s of the phase,
+ * smoothed, and the time left, and a line sums up each phase when done.
+ *
+ * The JSON_LINES format prints a JSON object per line instead, for scripts:
+ *
+ *    {"phase":"write","percent":42.0,"tiles":420,"total_tiles":1000,...}
+ *
+ * Preferences keywords, read at the first event unless setOutputFormat()
+ * was called:
+ *    progress.format:        "json" for JSON_LINES (default text)
+ *    progress.json_interval: Least seconds between JSON lines (default 1)
+ */
 class OSSIM_DLL ossimStdOutProgress : public ossimProcessListener
 {
 public:
+   enum OutputFormat
+   {
+      TEXT       = 0,
+      JSON_LINES = 1
+   };
+
    ossimStdOutProgress(ossim_uint32 precision = 0, bool flushStream=false);
 
    virtual void processProgressEvent(ossimProcessProgressEvent& event);
-      
+
    virtual void setFlushStreamFlag(bool flag);
 
+   void setOutputFormat(OutputFormat format);
+
+   OutputFormat getOutputFormat() const;
+
+   /** Writes the time, units, pixels and bytes of each phase done so far. */
+   void printPhaseBreakdown(std::ostream& out) const;
+
 protected:
+   /** Totals of the phases done. */
+   struct PhaseTotals
+   {
+      PhaseTotals();
+      double       theSeconds;
+      ossim_uint64 theUnits;
+      ossim_uint64 thePixels;
+      ossim_uint64 theBytes;
+   };
+
+   void initializeOutputFormat();
+
+   /** Updates the phase, rate and ETA; @return true on a new phase. */
+   bool updateRate(const ossimProcessProgressEvent& event, ossimTimer::Timer_t now);
+
+   /** Adds the phase to the totals and writes its summary. */
+   void endPhase(const ossimProcessProgressEvent& event, ossimTimer::Timer_t now);
+
+   void writeText(const ossimProcessProgressEvent& event);
+   void writeJson(const ossimProcessProgressEvent& event, ossimTimer::Timer_t now,
+                  bool newPhaseFlag);
+
    ossim_uint32 thePrecision;
    bool         theFlushStreamFlag;
+
+   OutputFormat theOutputFormat;
+   bool         theOutputFormatSetFlag;
+   double       theJsonInterval;
+
+   mutable OpenThreads::Mutex theMutex;
+   std::string         thePhase;
+   ossim_uint64        theTotalUnits;
+   ossim_uint64        theLastUnits;
+   bool                thePhaseDoneFlag;
+   ossimTimer::Timer_t thePhaseStart;
+   ossimTimer::Timer_t theSampleTick;
+   ossim_uint64        theSampleUnits;
+   double              theUnitsPerSecond; //!< Smoothed rate, 0 until known.
+   ossimTimer::Timer_t theLastJsonTick;
+   std::map<std::string, PhaseTotals> thePhaseTotals;
 TYPE_DATA
 };
 
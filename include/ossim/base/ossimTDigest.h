@@ -0,0 +1,69 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+//*******************************************************************
+#ifndef ossimTDigest_HEADER
+#define ossimTDigest_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <vector>
+
+/**
+ * Approximate quantiles of a stream of values in bounded memory (Dunning's
+ * merging t-digest).  Values are buffered, then merged into weighted
+ * centroids kept small near the tails, so extreme quantiles are close to
+ * exact and the median within a fraction of a percent of rank.  Digests
+ * of parts of a stream merge into the digest of the whole.
+ */
+class OSSIMDLLEXPORT ossimTDigest
+{
+public:
+   /**
+    * @param compression Bounds the number of centroids to about
+    * pi/2 * compression; larger is more accurate.
+    */
+   ossimTDigest(ossim_float64 compression = 100.0);
+
+   /** Adds value, weight times.  NaNs are ignored. */
+   void add(ossim_float64 value, ossim_float64 weight = 1.0);
+
+   /** Adds the values of digest. */
+   void merge(const ossimTDigest& digest);
+
+   /**
+    * @return Value of quantile q, 0 to 1 (0.5 the median); nan if no value
+    * was added.
+    */
+   ossim_float64 quantile(ossim_float64 q) const;
+
+   /** @return Total weight added. */
+   ossim_float64 getCount() const;
+
+   ossim_float64 getMin() const;
+   ossim_float64 getMax() const;
+
+   void clear();
+
+private:
+   struct Centroid
+   {
+      Centroid(ossim_float64 mean = 0.0, ossim_float64 weight = 0.0)
+         : theMean(mean), theWeight(weight) {}
+      bool operator<(const Centroid& rhs) const { return theMean < rhs.theMean; }
+      ossim_float64 theMean;
+      ossim_float64 theWeight;
+   };
+
+   /** Merges the buffer into the centroids. */
+   void compress() const;
+
+   ossim_float64 theCompression;
+   ossim_float64 theTotalWeight;
+   ossim_float64 theMin;
+   ossim_float64 theMax;
+   mutable std::vector<Centroid> theCentroids;
+   mutable std::vector<Centroid> theBuffer;
+};
+
+#endif /* #ifndef ossimTDigest_HEADER */
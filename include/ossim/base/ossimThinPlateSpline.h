@@ -56,6 +56,9 @@ public:
       _nof_points = 0;
       _nof_vars = nof_vars;
       _max_nof_points = 0;
+      _grid_nx = _grid_ny = 0;
+      _grid_x0 = _grid_y0 = _grid_dx = _grid_dy = 0.0;
+      _grid_error = 0.0;
       rhs.resize(_nof_vars);
       coef.resize(_nof_vars);
       growPoints();
@@ -76,6 +79,7 @@ public:
       index.clear();
       rhs.clear();
       coef.clear();
+      _grid.clear();
    }
    
    int getNumberOfPoints()const
@@ -102,6 +106,7 @@ public:
       type = VIZ_GEOREF_SPLINE_ZERO_POINTS;
       _AA.clear();
       _Ainv.clear();
+      clearGrid();
       return _nof_points;
 	}
    
@@ -111,12 +116,42 @@ public:
    int getPoint( const double Px, const double Py, double *Pvars )const;
    bool getXy(int index, double& x, double& y)const;
    bool changePoint(int index, double x, double y, double* Pvars);
-   void reset(void) { _nof_points = 0; }
+   void reset(void) { _nof_points = 0; clearGrid(); }
    int solve(void);
+
+   /**
+    * Evaluates count points, vars holding _nof_vars values per point.
+    * @return Number of points evaluated.
+    */
+   int getPoints( int count, const double *Px, const double *Py, double *vars )const;
+
+   /**
+    * Precomputes the solved spline on a grid over the rectangle, so
+    * getPoint and getPoints interpolate bilinearly inside it instead of
+    * summing a term per control point.  The grid is halved from 16x16 cells
+    * until interpolating it is within maxError of the spline at the nodes
+    * the next halving adds.  Points outside the rectangle are evaluated in
+    * full.  Adding, changing or deleting points, or solving again, drops
+    * the grid.
+    * @return false, with no grid, if the spline is not fully solved or the
+    * bound needs more than maxNodes nodes.
+    */
+   bool buildGrid( double minX, double minY, double maxX, double maxY,
+                   double maxError, int maxNodes = 4194304 );
+
+   void clearGrid(void) { _grid.clear(); _grid_nx = _grid_ny = 0; _grid_error = 0.0; }
+
+   bool hasGrid(void)const { return !_grid.empty(); }
+
+   /** @return Largest error measured when the grid was built. */
+   double getGridError(void)const { return _grid_error; }
    
 private:	
    double baseFunc( const double x1, const double y1,
                     const double x2, const double y2 )const;
+
+   /** Sums the affine and radial terms of a fully solved spline. */
+   void evalFull( const double Px, const double Py, double *vars )const;
    
    vizGeorefInterType type;
    
@@ -140,6 +175,13 @@ private:
    std::vector<int> index; // [VIZ_GEOREF_SPLINE_MAX_POINTS];
 	
    std::vector<double> _AA, _Ainv;
+
+   // Precomputed spline, _nof_vars values per node, nodes by rows.
+   std::vector<double> _grid;
+   int _grid_nx, _grid_ny;
+   double _grid_x0, _grid_y0;
+   double _grid_dx, _grid_dy;
+   double _grid_error;
 };
 
 #endif
@@ -0,0 +1,133 @@
+#ifndef ossimTieGptColumnSet_HEADER
+#define ossimTieGptColumnSet_HEADER
+
+#include <iosfwd>
+#include <vector>
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/matrix/newmat.h>
+
+class ossimTieGpt;
+class ossimTieGptSet;
+
+/**
+ * compact storage class for large sets of geographic tie points
+ * + binary serialization
+ *
+ * same content as ossimTieGptSet (master ground points, slave image points,
+ * scores, paths and accuracies) but kept as one array per coordinate instead
+ * of one ossimTieGpt object per point, so millions of tie points cost 48 bytes
+ * each and no allocation per point.
+ *
+ * binary form (native byte order, files of the other order are rejected):
+ *   header : "OSSIMTPS", byte order mark, version, master path, slave path,
+ *            image covariance (lower half, 3 values), ground covariance (6)
+ *   chunks : point count n > 0, then n lat, n lon, n hgt, n image x,
+ *            n image y, n score
+ *   end    : point count 0
+ * chunks can be written and read one at a time, so tie points can be
+ * streamed through without holding the whole set.
+ *
+ * load() also reads the GML (XML) form of ossimTieGptSet.
+ */
+class OSSIMDLLEXPORT ossimTieGptColumnSet
+{
+public:
+   static const ossim_uint32 DEFAULT_CHUNK_SIZE;
+
+   ossimTieGptColumnSet();
+   explicit ossimTieGptColumnSet(const ossimTieGptSet& aSet);
+
+   /**
+    * conversions from/to the object per point set
+    */
+   void fromTieGptSet(const ossimTieGptSet& aSet);
+   void toTieGptSet(ossimTieGptSet& aSet)const;
+
+   inline ossim_uint32 size()const { return (ossim_uint32)theLat.size(); }
+   inline bool empty()const { return theLat.empty(); }
+
+   void reserve(ossim_uint32 numPoints);
+
+   /** removes the tie points, keeps paths and accuracies */
+   void clearTiePoints();
+
+   void addTiePoint(const ossimGpt& aGround, const ossimDpt& aTie, ossim_float64 aScore);
+   void addTiePoint(const ossimTieGpt& aTiePt);
+
+   /** appends count points of aSet from offset */
+   void append(const ossimTieGptColumnSet& aSet, ossim_uint32 offset=0,
+               ossim_uint32 count=0xFFFFFFFF);
+
+   void getTiePoint(ossim_uint32 i, ossimTieGpt& aTiePt)const;
+   inline ossimGpt getGroundPoint(ossim_uint32 i)const { return ossimGpt(theLat[i], theLon[i], theHgt[i]); }
+   inline ossimDpt getImagePoint(ossim_uint32 i)const  { return ossimDpt(theImageX[i], theImageY[i]); }
+   inline ossim_float64 getScore(ossim_uint32 i)const  { return theScore[i]; }
+
+   /**
+    * column access, size() values each
+    */
+   inline const std::vector<ossim_float64>& getLat()const    { return theLat; }
+   inline const std::vector<ossim_float64>& getLon()const    { return theLon; }
+   inline const std::vector<ossim_float64>& getHgt()const    { return theHgt; }
+   inline const std::vector<ossim_float64>& getImageX()const { return theImageX; }
+   inline const std::vector<ossim_float64>& getImageY()const { return theImageY; }
+   inline const std::vector<ossim_float64>& getScores()const { return theScore; }
+
+   void getSlaveMasterPoints(std::vector<ossimDpt>& imv, std::vector<ossimGpt>& gdv)const;
+
+   inline void  setMasterPath(const ossimString& aPath) { theMasterPath = aPath; }
+   inline const ossimString& getMasterPath()const       { return theMasterPath; }
+
+   inline void  setSlavePath(const ossimString& aPath) { theSlavePath = aPath; }
+   inline const ossimString& getSlavePath()const       { return theSlavePath; }
+
+   inline void  setImageCov(const NEWMAT::SymmetricMatrix& aCovMat) { theImageCov = aCovMat; }
+   inline const NEWMAT::SymmetricMatrix& getImageCov()const       { return theImageCov; }
+
+   inline void  setGroundCov(const NEWMAT::SymmetricMatrix& aCovMat) { theGroundCov = aCovMat; }
+   inline const NEWMAT::SymmetricMatrix& getGroundCov()const       { return theGroundCov; }
+
+   /**
+    * whole set binary file I/O
+    * load() takes either the binary form or a GML TiePointSet document
+    */
+   bool save(const ossimFilename& aFile)const;
+   bool load(const ossimFilename& aFile);
+
+   /** @return true if aFile starts with the binary magic number */
+   static bool isBinaryFile(const ossimFilename& aFile);
+
+   /**
+    * streaming write : writeHeader(), writeChunk() as often as needed, writeEnd()
+    */
+   bool writeHeader(std::ostream& os)const;
+   bool writeChunk(std::ostream& os, ossim_uint32 offset=0, ossim_uint32 count=0xFFFFFFFF)const;
+   static bool writeEnd(std::ostream& os);
+
+   /**
+    * streaming read : readHeader() sets paths and accuracies and clears the
+    * points, then each readChunk() replaces (or appends to) the points with
+    * the next chunk
+    * @return readChunk() is false at the end of the points or on error,
+    * check the stream state to tell them apart
+    */
+   bool readHeader(std::istream& is);
+   bool readChunk(std::istream& is, bool append=false);
+
+protected:
+   std::vector<ossim_float64> theLat;
+   std::vector<ossim_float64> theLon;
+   std::vector<ossim_float64> theHgt;
+   std::vector<ossim_float64> theImageX;
+   std::vector<ossim_float64> theImageY;
+   std::vector<ossim_float64> theScore;
+   ossimString                theMasterPath; //!full or relative path to master dataset
+   ossimString                theSlavePath;  //!full or relative path to slave dataset
+   NEWMAT::SymmetricMatrix    theImageCov;   //! image error covariance matrix
+   NEWMAT::SymmetricMatrix    theGroundCov;  //! ground error covariance matrix
+};
+
+#endif /* #ifndef ossimTieGptColumnSet_HEADER */
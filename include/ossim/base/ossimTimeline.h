@@ -0,0 +1,168 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Per-thread timeline of spans, exported in the Chrome trace format.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimTimeline_HEADER
+#define ossimTimeline_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimTimer.h>
+#include <OpenThreads/Mutex>
+#include <iosfwd>
+#include <set>
+#include <string>
+#include <vector>
+
+//*************************************************************************************************
+//! Opt-in recorder of what each thread was doing when, for looking at stalls, lock convoys and
+//! load imbalance in multi-threaded runs that aggregate timers cannot show.
+//!
+//! Code marks a span with a Span on the stack:
+//!
+//!    ossimTimeline::Span span("TIFFWriteTile", "writer");
+//!
+//! Spans are recorded in a ring buffer per thread, so the newest events are kept and the memory
+//! is bounded; nothing is locked on the way. When not recording a Span costs one flag check.
+//! Names and categories are kept as pointers: use string literals, or intern() other names once.
+//!
+//! The library records job runs (category "job"), handler reads and the wait for the handler
+//! lock of ossimImageHandlerMtAdaptor ("io", "lock"), ossimPositionalFile reads and writes
+//! ("io"), the getTile of each node instrumented by ossimChainProfiler ("getTile") and writer
+//! flushes ("writer").
+//!
+//! write() exports the Chrome trace JSON format ("X" complete events, microseconds), which
+//! chrome://tracing and Perfetto open. Call it after stop(), once the threads are idle.
+//!
+//! For sampling in production, setSampling() records only the spans beginning in a window of
+//! each period, e.g. 1 second every 60.
+//!
+//! Preferences keywords:
+//!    timeline.file:              Trace written by ossim-orthoigen and ossim-chipper
+//!    timeline.events_per_thread: Ring buffer size (default 65536)
+//!    timeline.sample_window:     Seconds recorded each period (default 0, all)
+//!    timeline.sample_period:     Seconds
+//*************************************************************************************************
+class OSSIM_DLL ossimTimeline
+{
+public:
+   //! Records the calling thread's span from construction to destruction.
+   class Span
+   {
+   public:
+      Span(const char* name, const char* category)
+         : m_name(0),
+           m_category(category),
+           m_begin(0)
+      {
+         ossimTimeline* timeline = ossimTimeline::instance();
+         if ( timeline->isRecording() )
+         {
+            m_begin = ossimTimer::instance()->tick();
+            if ( timeline->isSampled(m_begin) )
+            {
+               m_name = name;
+            }
+         }
+      }
+      ~Span()
+      {
+         if ( m_name )
+         {
+            ossimTimeline::instance()->record(m_name, m_category, m_begin,
+                                              ossimTimer::instance()->tick());
+         }
+      }
+   private:
+      Span(const Span&);
+      const Span& operator=(const Span&);
+
+      const char*         m_name;
+      const char*         m_category;
+      ossimTimer::Timer_t m_begin;
+   };
+
+   static ossimTimeline* instance();
+
+   //! Starts recording. Buffers of threads that recorded before keep their size.
+   //! @param eventsPerThread Ring buffer size, 0 for the preference or default.
+   void start(ossim_uint32 eventsPerThread = 0);
+
+   //! Stops recording; the events are kept until clear().
+   void stop();
+
+   bool isRecording() const { return m_recording; }
+
+   //! Records only the spans beginning in the first windowSeconds of every periodSeconds
+   //! from start(). 0 for either records all.
+   void setSampling(double windowSeconds, double periodSeconds);
+
+   //! @return true if a span beginning at tick is recorded under the sampling.
+   bool isSampled(ossimTimer::Timer_t tick) const
+   {
+      return !m_periodTicks ||
+         ( (ossim_uint64)(tick - m_startTick) % m_periodTicks < m_windowTicks );
+   }
+
+   //! Adds a span of the calling thread; Span does this.
+   void record(const char* name, const char* category,
+               ossimTimer::Timer_t begin, ossimTimer::Timer_t end);
+
+   //! Drops the events recorded. Not while threads record.
+   void clear();
+
+   //! Writes the events as Chrome trace JSON.
+   void write(std::ostream& out) const;
+   bool write(const ossimFilename& file) const;
+
+   //! @return A pointer to a copy of name that lives as long as the process.
+   const char* intern(const std::string& name);
+
+   //! Output file of the timeline.file preference, or an empty name if not set.
+   static ossimFilename getPreferenceFile();
+
+   //! Starts recording with the sampling of the timeline.* preferences.
+   void startFromPreferences();
+
+private:
+   struct Event
+   {
+      const char*         m_name;
+      const char*         m_category;
+      ossimTimer::Timer_t m_begin;
+      ossimTimer::Timer_t m_end;
+   };
+
+   //! Events of one thread; written only by it.
+   struct ThreadBuffer
+   {
+      std::vector<Event> m_events;
+      ossim_uint64       m_count; //!< Events recorded; the ring holds the last m_events.size().
+      ossim_uint32       m_tid;
+      bool               m_mainFlag;
+   };
+
+   ossimTimeline();
+   ossimTimeline(const ossimTimeline&);
+   const ossimTimeline& operator=(const ossimTimeline&);
+
+   ThreadBuffer* getThreadBuffer();
+
+   static ossimTimeline* m_instance;
+
+   mutable OpenThreads::Mutex m_mutex;
+   std::vector<ThreadBuffer*> m_buffers;
+   std::set<std::string>      m_names;
+   ossim_uint32               m_eventsPerThread;
+   ossimTimer::Timer_t        m_startTick;
+   ossim_uint64               m_windowTicks;
+   ossim_uint64               m_periodTicks;
+   volatile bool              m_recording;
+};
+
+#endif /* #ifndef ossimTimeline_HEADER */
@@ -18,10 +18,63 @@
 
 #include <ossim/base/ossimString.h>
 #include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimTimer.h>
 
 // Macro for use with trace...
 #define CLOG ossimNotify(ossimNotifyLevel_DEBUG) << MODULE << " (\"" __FILE__ "\", line " << __LINE__ << ") DEBUG: "
 
+//---
+// OSSIM_TRACE_LEVEL (from ossimConfig.h, cmake variable of the same name)
+// controls the hot path trace points below: 0 compiles them out, 1 (the
+// default except in Release builds) checks the trace flag at run time.
+// Plain "if (traceDebug())" blocks are unaffected.
+//---
+#ifndef OSSIM_TRACE_LEVEL
+#  define OSSIM_TRACE_LEVEL 1
+#endif
+
+#if defined(__GNUC__)
+#  define OSSIM_TRACE_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#  define OSSIM_TRACE_UNLIKELY(x) (x)
+#endif
+
+#define OSSIM_TRACE_CAT2(a, b) a##b
+#define OSSIM_TRACE_CAT(a, b) OSSIM_TRACE_CAT2(a, b)
+
+#if OSSIM_TRACE_LEVEL > 0
+
+/** True if trace, a static ossimTrace, is enabled. */
+#  define OSSIM_TRACE_ENABLED(trace) OSSIM_TRACE_UNLIKELY((trace)())
+
+/**
+ * Writes the stream expression args, e.g. MODULE << " rect = " << rect,
+ * to the debug stream if trace is enabled; args are not evaluated if not.
+ */
+#  define OSSIM_TRACE(trace, args)                                       \
+   do { if (OSSIM_TRACE_ENABLED(trace))                                  \
+      { ossimNotify(ossimNotifyLevel_DEBUG) << args << std::endl; } } while (0)
+
+/**
+ * Times the rest of the enclosing scope as an ossimTraceSpan named name
+ * (a string literal) if trace is enabled and a sink is installed.
+ */
+#  define OSSIM_TRACE_SPAN(trace, name)                                  \
+   ossimTraceSpan OSSIM_TRACE_CAT(ossimTraceSpan_, __LINE__)(trace, name)
+
+/** As OSSIM_TRACE_SPAN, with an integer argument, e.g. the res level. */
+#  define OSSIM_TRACE_SPAN_VALUE(trace, name, value)                     \
+   ossimTraceSpan OSSIM_TRACE_CAT(ossimTraceSpan_, __LINE__)(trace, name, value)
+
+#else
+
+#  define OSSIM_TRACE_ENABLED(trace) (false)
+#  define OSSIM_TRACE(trace, args) do { } while (0)
+#  define OSSIM_TRACE_SPAN(trace, name) do { } while (0)
+#  define OSSIM_TRACE_SPAN_VALUE(trace, name, value) do { } while (0)
+
+#endif /* #if OSSIM_TRACE_LEVEL > 0 */
+
 
 class OSSIMDLLEXPORT ossimTrace
 {
@@ -61,7 +114,88 @@ public:
 
 private:
    ossimString                theTraceName;
-   bool                       theEnabledFlag;
+
+   /** Volatile so threads polling it see ossimTraceManager's updates. */
+   volatile bool              theEnabledFlag;
+};
+
+class ossimTraceSpanSink;
+
+/** A completed ossimTraceSpan, as handed to the ossimTraceSpanSink. */
+struct ossimTraceSpanRecord
+{
+   /** Trace enabling the span. */
+   const ossimTrace*   theTrace;
+
+   /** Span name, a string literal. */
+   const char*         theName;
+
+   /** Optional argument of the span, 0 if none. */
+   ossim_int64         theValue;
+
+   /** ossimTimer ticks at construction and destruction of the span. */
+   ossimTimer::Timer_t theStartTick;
+   ossimTimer::Timer_t theEndTick;
+};
+
+/**
+ * Receives the spans of enabled traces, e.g. to export a timeline.  Called
+ * on the thread that ran the span, so the sink can tell threads apart and
+ * must be thread safe.
+ */
+class OSSIMDLLEXPORT ossimTraceSpanSink
+{
+public:
+   virtual ~ossimTraceSpanSink() {}
+   virtual void spanEnded(const ossimTraceSpanRecord& span) = 0;
+};
+
+/**
+ * Scoped timing of a block, recorded only if its trace is enabled and a
+ * sink is installed.  Otherwise the cost is the check of the trace flag.
+ * Use through the OSSIM_TRACE_SPAN macros:
+ *
+ * static ossimTrace traceSpan("ossimMyTileSource:span");
+ * ...
+ * OSSIM_TRACE_SPAN_VALUE(traceSpan, "ossimMyTileSource::getTile", resLevel);
+ */
+class OSSIMDLLEXPORT ossimTraceSpan
+{
+public:
+   ossimTraceSpan(const ossimTrace& trace, const char* name,
+                  ossim_int64 value = 0)
+      : theSink(0)
+   {
+      if ( OSSIM_TRACE_UNLIKELY(trace()) )
+      {
+         begin(trace, name, value);
+      }
+   }
+
+   ~ossimTraceSpan()
+   {
+      if ( theSink )
+      {
+         end();
+      }
+   }
+
+   /**
+    * Installs sink, 0 to stop recording.  The caller owns sink, which must
+    * outlive the spans in progress.
+    */
+   static void setSink(ossimTraceSpanSink* sink);
+   static ossimTraceSpanSink* getSink();
+
+private:
+   ossimTraceSpan(const ossimTraceSpan&);
+   const ossimTraceSpan& operator=(const ossimTraceSpan&);
+
+   void begin(const ossimTrace& trace, const char* name, ossim_int64 value);
+   void end();
+
+   ossimTraceSpanSink*  theSink;
+   ossimTraceSpanRecord theRecord;
 };
 
 #endif
@@ -41,6 +41,18 @@ public:
 protected:
    bool theSolValid;
 
+   // Eliminate the ground partition before solving; preference
+   // bundle_adjustment.reduced_solution, default true.
+   bool theReducedFlag;
+
+   /**
+    * @brief Solution with the ground partition folded into a reduced image
+    * parameter system, so N is never formed at full rank.
+    */
+   bool runReduced(ossimAdjSolutionAttributes* solAttributes,
+                   const std::vector<int>& NdIndex,
+                   int Nd_rank);
+
    // Internal solution methods
    bool solveSystem(double* d, double* c, double* delta, int jb);
    bool recurFwd(double* d, double* c, std::vector<double>& rc, std::vector<int>& nz, int jb);
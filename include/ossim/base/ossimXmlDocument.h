@@ -36,6 +36,21 @@ public:
    bool write(const ossimFilename& file);
    bool openFile(const ossimFilename& filename);
    bool read(std::istream& in);
+
+   /**
+    * Selective load: reads only the elements at the absolute paths xpaths,
+    * e.g. "/PAMDataset/Metadata/MDI" (a step may be "*"), with their whole
+    * subtrees, plus the tags and attributes of their ancestors, so
+    * findNodes on those paths finds what it would in the full document.
+    * Parses with ossimXmlStreamParser, skipping the rest without building
+    * nodes.  Comments are dropped rather than kept as "--" nodes.
+    *
+    * @param xpaths Paths to load; empty loads the whole document.
+    */
+   bool openFile(const ossimFilename& filename,
+                 const std::vector<ossimString>& xpaths);
+   bool read(std::istream& in, const std::vector<ossimString>& xpaths);
+
    /**
     * Appends any matching nodes to the list supplied (should be empty):
     */
@@ -58,6 +73,9 @@ private:
    ossimFilename              theFilename;
    bool                       theStrictCheckFlag;
    bool readHeader(std::istream& in);
+
+   /** Skips to the first '<', failing on binary data. */
+   bool skipToMarkup(std::istream& in);
 TYPE_DATA
 };
 
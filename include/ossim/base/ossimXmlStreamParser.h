@@ -0,0 +1,102 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description:
+//
+// Contains declaration of class ossimXmlStreamParser, an event driven
+// (SAX style) XML parser that builds no tree.
+//
+//*******************************************************************
+#ifndef ossimXmlStreamParser_HEADER
+#define ossimXmlStreamParser_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimString.h>
+#include <iosfwd>
+#include <utility>
+#include <vector>
+
+/**
+ * Receives the events of ossimXmlStreamParser::parse.  Each returns false
+ * to stop the parse.  The arguments are only valid during the call.
+ */
+class OSSIMDLLEXPORT ossimXmlStreamHandler
+{
+public:
+   /** Attribute name, value pairs in document order. */
+   typedef std::vector< std::pair<ossimString, ossimString> > AttributeList;
+
+   virtual ~ossimXmlStreamHandler();
+
+   /** Start tag, or empty element tag followed by endElement. */
+   virtual bool startElement(const ossimString& tag,
+                             const AttributeList& attributes);
+
+   /**
+    * Text of the current element with leading white space skipped, or the
+    * content of a CDATA section.  Not called for white space only text.
+    * As with ossimXmlNode, entities are not decoded.
+    */
+   virtual bool text(const ossimString& text, bool cdata);
+
+   virtual bool endElement(const ossimString& tag);
+};
+
+/**
+ * Parses an XML document into ossimXmlStreamHandler events, through a
+ * buffer rather than character by character, holding only the current tag,
+ * text and the stack of open tags.  The prolog (<?xml ...?>, <!DOCTYPE>),
+ * processing instructions and comments are skipped.  Parsing ends at the
+ * end of the root element; the stream may have been read past it.
+ */
+class OSSIMDLLEXPORT ossimXmlStreamParser
+{
+public:
+   ossimXmlStreamParser();
+
+   /**
+    * @return true if the root element was read to its end or the handler
+    * stopped the parse, false on malformed input.
+    */
+   bool parse(std::istream& in, ossimXmlStreamHandler& handler);
+
+   /** @return true if the last parse was stopped by the handler. */
+   bool wasStopped() const;
+
+   /** @return Bytes consumed by the last parse, e.g. to locate an error. */
+   ossim_uint64 getOffset() const;
+
+private:
+   int peek();
+   int get();
+   bool fill();
+
+   /** Skips up to and including terminator, e.g. "-->". */
+   bool skipPast(const char* terminator);
+
+   bool skipWhiteSpace();
+
+   /** Appends characters up to, not including, stop; false at the end. */
+   bool appendUntil(std::string& s, char stop);
+
+   bool readName(ossimString& name, bool attribute);
+   bool readAttributes(bool& emptyElement);
+   bool readText(ossimXmlStreamHandler& handler);
+
+   /** Comment, CDATA section, or declaration after "<!". */
+   bool readBang(ossimXmlStreamHandler& handler);
+
+   std::istream*           theStream;
+   std::vector<char>       theBuffer;
+   size_t                  thePos;
+   size_t                  theEnd;
+   ossim_uint64            theOffset;
+   bool                    theStoppedFlag;
+   ossimString             theTag;
+   ossimString             theText;
+   ossimXmlStreamHandler::AttributeList theAttributes;
+   std::vector<ossimString> theOpenTags;
+};
+
+#endif /* #ifndef ossimXmlStreamParser_HEADER */
@@ -24,6 +24,9 @@
 #include <fstream>
 
 #include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimMemoryMappedFile.h>
+#include <ossim/base/ossimPositionalFile.h>
+#include <ossim/base/ossimRefPtr.h>
 #include <ossim/base/ossimString.h>
 #include <ossim/elevation/ossimElevCellHandler.h>
 #include <OpenThreads/Mutex>
@@ -112,7 +115,7 @@ public:
 
    virtual ossimObject* dup () const
    {
-      return new ossimDtedHandler(this->getFilename(), (m_memoryMap.size() != 0));
+      return new ossimDtedHandler(this->getFilename(), m_memoryMap.valid());
    }
 
    virtual ~ossimDtedHandler();
@@ -176,11 +179,19 @@ protected:
    * read the height posts from the File
    * @param postData - post heights, status & weight
    * @param offset - file contents offset to start reading from
+   *
+   * Goes through m_file when open, one positional read per column and no
+   * lock, else through m_fileStr under m_fileStrMutex.
    */
    void readPostsFromFile(DtedHeight &postData, int offset);
 
    mutable OpenThreads::Mutex m_fileStrMutex;
+
+   /** Header parsing; post reads too if m_file could not be opened. */
    mutable std::ifstream m_fileStr;
+
+   /** Post reads of a cell that is not memory mapped. */
+   ossimPositionalFile m_file;
    
    ossim_int32      m_numLonLines;  // east-west dir
    ossim_int32      m_numLatPoints; // north-south
@@ -197,7 +208,8 @@ protected:
    bool m_swapBytesFlag;
 
    mutable OpenThreads::Mutex m_memoryMapMutex;
-   mutable std::vector<ossim_uint8> m_memoryMap;
+   /** @brief Mapped cell when opened with memoryMapFlag, null when read through m_fileStr. */
+   ossimRefPtr<ossimMemoryMappedFile> m_memoryMap;
    
    ossimDtedVol m_vol;
    ossimDtedHdr m_hdr;
@@ -226,7 +238,7 @@ inline ossim_sint16 ossimDtedHandler::convertSignedMagnitude(ossim_uint16& s) co
 
 inline bool ossimDtedHandler::isOpen()const
 {
-   if(!m_memoryMap.empty()) return true;
+   if(m_memoryMap.valid() || m_file.isOpen()) return true;
    
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_fileStrMutex);
    return (m_fileStr.is_open());
@@ -235,7 +247,8 @@ inline bool ossimDtedHandler::isOpen()const
 inline void ossimDtedHandler::close()
 {
    m_fileStr.close();
-   m_memoryMap.clear();
+   m_file.close();
+   m_memoryMap = 0;
 }
 
 #endif
@@ -51,6 +51,12 @@ public:
     */
    virtual ossimIpt getSizeOfElevCell() const = 0;
 
+   /**
+    * Approximate memory of the cell's posts for the cache statistics: the
+    * post count times two bytes, the post size of DTED and SRTM cells.
+    */
+   virtual ossim_uint64 getSizeInBytes() const;
+
    /**
     *  METHOD:  getPostValue
     *  Returns the value at a given grid point as a double.
@@ -22,15 +22,46 @@
 
 #include <vector>
 #include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimGrect.h>
+#include <ossim/base/ossimTimer.h>
 #include <ossim/base/ossimVisitor.h>
 #include <ossim/elevation/ossimElevSource.h>
 #include <ossim/elevation/ossimElevationDatabase.h>
+#include <ossim/elevation/ossimElevationCellDatabase.h>
 #include <OpenThreads/ReadWriteMutex>
+#include <OpenThreads/Atomic>
+
+class ossimElevCellHandler;
+class ossimJob;
+class ossimJobMultiThreadQueue;
 
 class OSSIM_DLL ossimElevManager : public ossimElevSource
 {
 public: 
    typedef std::vector<ossimRefPtr<ossimElevationDatabase> > ElevationDatabaseListType;
+
+   /**
+    * Height query counters, see setQueryStatisticsFlag().  Points count the
+    * single point calls and each point of the batch calls.  The seconds
+    * include the geoid; the DEM time is m_seconds - m_geoidSeconds, less
+    * what is spent outside the queries by databases called directly.
+    */
+   struct QueryStatistics
+   {
+      QueryStatistics();
+      QueryStatistics& operator+=(const QueryStatistics& rhs);
+
+      ossim_uint64 m_points;
+      ossim_uint64 m_coverageMisses;   //!< Points no database had a post for.
+      double       m_seconds;
+      ossim_uint64 m_geoidQueries;     //!< Points of the geoid lookups, fallbacks included.
+      double       m_geoidSeconds;
+      ossim_uint64 m_rays;             //!< intersectRay calls.
+      ossim_uint64 m_rayIterations;    //!< Their height lookups.
+      ossim_uint64 m_maxRayIterations;
+      ossim_uint64 m_rayFailures;      //!< Rays stopped at the iteration limit.
+   };
    
    class OSSIM_DLL ConnectionStringVisitor : public ossimVisitor
    {
@@ -56,6 +87,27 @@ public:
    
    virtual double getHeightAboveEllipsoid(const ossimGpt& gpt);
    virtual double getHeightAboveMSL(const ossimGpt& gpt);
+
+   /**
+    * Batch forms of getHeightAboveEllipsoid and getHeightAboveMSL.  heights[i]
+    * gets the same value the single point call would give for gpts[i].  Each
+    * database sees only the points the ones ahead of it left null, cells are
+    * looked up once per run of points falling in them and the geoid is
+    * queried once per pass rather than once per point.
+    */
+   void getHeightsAboveEllipsoid(const ossimGpt* gpts, double* heights, ossim_uint32 count);
+   void getHeightsAboveMSL(const ossimGpt* gpts, double* heights, ossim_uint32 count);
+
+   /**
+    * Regular grid forms.  Post (row, col) is at
+    * (origin.lat + row*spacing.y, origin.lon + col*spacing.x), spacing in
+    * decimal degrees, and goes to heights[row*width + col].
+    */
+   void getHeightsAboveEllipsoid(const ossimGpt& origin, const ossimDpt& spacing,
+                                 ossim_uint32 width, ossim_uint32 height, double* heights);
+   void getHeightsAboveMSL(const ossimGpt& origin, const ossimDpt& spacing,
+                           ossim_uint32 width, ossim_uint32 height, double* heights);
+
    virtual bool pointHasCoverage(const ossimGpt&) const;
 
    /**
@@ -144,6 +196,62 @@ public:
                            std::vector<ossimFilename>& cells,
                            ossim_uint32 maxNumberOfCells=0 );
 
+   /**
+    * Opens and warms the cells covering aoi from a background thread, so
+    * workers that later read them do not stall on cell opens mid tile.
+    * Returns at once.  The area is probed every probeSpacing degrees against
+    * the databases in priority order.  A prefetch opens at most a database's
+    * max open cells, so it never flushes cells it has just opened.  Areas no
+    * database covers are logged and kept for getPrefetchGaps.
+    */
+   void prefetch(const ossimGrect& aoi, double probeSpacing=0.25);
+
+   /** @return true while a prefetch is queued or running. */
+   bool isPrefetching() const;
+
+   /** Blocks until every queued prefetch has finished. */
+   void waitForPrefetch() const;
+
+   /** Areas without coverage found by the prefetches since the last clear(). */
+   void getPrefetchGaps(std::vector<ossimGrect>& gaps) const;
+
+   /** Lookups answered from a thread's last cell since the last resetCacheStatistics(). */
+   ossim_uint64 getLastCellHits() const;
+
+   /**
+    * Cell cache hits and misses of database idx, summed over the copies
+    * made for each thread.  @return false if it is not a cell database.
+    */
+   bool getCacheStatistics(ossim_uint32 idx, ossim_uint64& hits, ossim_uint64& misses) const;
+
+   /** As above with evictions, open cells and bytes, also summed over the copies. */
+   bool getCacheStatistics(ossim_uint32 idx,
+                           ossimElevationCellDatabase::CacheStatistics& stats) const;
+
+   /** One line per cell database with its getCacheStatistics(). */
+   void printCacheStatistics(std::ostream& out) const;
+
+   void resetCacheStatistics();
+
+   /**
+    * Turns the query counters on or off; off by default, as they cost two
+    * timer reads and a lock per query.  Set by the
+    * elevation_manager.query_statistics preference.
+    */
+   void setQueryStatisticsFlag(bool flag);
+   bool getQueryStatisticsFlag() const { return m_queryStatisticsFlag; }
+
+   /** Query counters summed over the threads since the last reset. */
+   void getQueryStatistics(QueryStatistics& stats) const;
+
+   void resetQueryStatistics();
+
+   /** One line with getQueryStatistics(), lookups per ray included. */
+   void printQueryStatistics(std::ostream& out) const;
+
+   /** Counts count geoid offsets looked up from begin to end; done by the databases. */
+   void addGeoidQueries(ossim_uint32 count, ossimTimer::Timer_t begin, ossimTimer::Timer_t end);
+
    void setUseGeoidIfNullFlag(bool flag) { m_useGeoidIfNullFlag = flag; }
    bool getUseGeoidIfNullFlag() const { return m_useGeoidIfNullFlag; }
    void setRoundRobinMaxSize(ossim_uint32 size);
@@ -172,6 +280,74 @@ protected:
    void loadStandardElevationPaths();
 
    ElevationDatabaseListType& getNextElevDbList() const; // for multithreading
+
+   virtual void addRayIntersection(ossim_uint32 iterations, bool converged);
+
+   /**
+    * Cell a thread last got a height from, when it came from the first
+    * database.  Consecutive lookups nearly always fall in the same cell, so
+    * checking its bounds first skips the database list and its mutex.
+    * Threads are spread over LAST_CELL_SLOTS entries; one that finds its
+    * entry busy goes the normal way.
+    */
+   struct LastCell
+   {
+      LastCell() : m_mutex(), m_generation(0), m_hits(0), m_database(0), m_handler(0) {}
+      OpenThreads::Mutex                  m_mutex;
+      ossim_uint32                        m_generation; //!< m_generation when filled.
+      ossim_uint32                        m_hits;       //!< Guarded by m_mutex.
+      ossimRefPtr<ossimElevationDatabase> m_database;
+      ossimRefPtr<ossimElevCellHandler>   m_handler;
+   };
+
+   enum
+   {
+      LAST_CELL_SLOTS = 64
+   };
+
+   /** Query counters of the threads hashed to one slot. */
+   struct QuerySlot
+   {
+      QuerySlot() : m_mutex(), m_stats() {}
+      OpenThreads::Mutex m_mutex;
+      QueryStatistics    m_stats; //!< Guarded by m_mutex.
+   };
+
+   /** Slot of the calling thread in m_lastCells and m_querySlots. */
+   static ossim_uint32 getThreadSlot();
+
+   LastCell& getLastCell() const;
+
+   /** Counts points queried from begin to end, coverageMisses of them null. */
+   void addQueries(ossim_uint32 points, ossim_uint32 coverageMisses,
+                   ossimTimer::Timer_t begin, ossimTimer::Timer_t end);
+
+   /**
+    * @return true and the height if gpt is in the calling thread's last cell
+    * and it has a post there.
+    */
+   bool getLastCellHeight(const ossimGpt& gpt, bool ellipsoidFlag, double& height);
+
+   /** Makes database's cell at gpt the calling thread's last cell. */
+   void setLastCell(ossimElevationDatabase* database, const ossimGpt& gpt);
+
+   /** Runs the database list over the points, leaving nan where none has a post. */
+   void getDatabaseHeights(const ossimGpt* gpts, double* heights, ossim_uint32 count,
+                           bool ellipsoidFlag);
+
+   class PrefetchJob;
+   friend class PrefetchJob;
+
+   /**
+    * Body of a prefetch job: probes aoi against databases, opening cells,
+    * and records the gaps.  Stops early if job is canceled.
+    */
+   void runPrefetch(ossimJob* job, ElevationDatabaseListType& databases,
+                    const ossimGrect& aoi, double probeSpacing);
+
+   /** Fills gpts with the posts of a regular grid. */
+   static void makeGrid(const ossimGpt& origin, const ossimDpt& spacing,
+                        ossim_uint32 width, ossim_uint32 height, std::vector<ossimGpt>& gpts);
    
    //static ossimElevManager* m_instance;
    mutable std::vector<ElevationDatabaseListType> m_dbRoundRobin;
@@ -184,6 +360,19 @@ protected:
    bool m_useStandardPaths;
    
    mutable ossim_uint32 m_currentDatabaseIdx;
+
+   /** Bumped whenever the database lists change, invalidating every LastCell. */
+   OpenThreads::Atomic m_generation;
+   mutable LastCell m_lastCells[LAST_CELL_SLOTS];
+
+   volatile bool     m_queryStatisticsFlag;
+   mutable QuerySlot m_querySlots[LAST_CELL_SLOTS];
+
+   /** Single thread running prefetch jobs, made on first prefetch(). */
+   ossimRefPtr<ossimJobMultiThreadQueue> m_prefetchQueue;
+   OpenThreads::Atomic                   m_prefetchesPending;
+   mutable OpenThreads::Mutex            m_prefetchMutex;
+   std::vector<ossimGrect>               m_prefetchGaps; //!< Guarded by m_prefetchMutex.
    
    /**
     * I have tried the readwrite lock interfaces but have found it unstable.  I am using the standard Mutex
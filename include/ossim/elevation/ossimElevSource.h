@@ -60,6 +60,19 @@ public:
     *  Returns true if good intersection found.
     */
    bool intersectRay(const ossimEcefRay& ray, ossimGpt& gpt, double defaultElevValue = 0.0);
+
+   /**
+    *  METHOD: intersectRayFromHeight()
+    *
+    *  intersectRay() with the first guess taken where the ray crosses
+    *  startHeight above the ellipsoid instead of at the ray origin. With the
+    *  height of a neighbouring solution it typically converges after one or
+    *  two lookups. A nan startHeight behaves as intersectRay().
+    */
+   bool intersectRayFromHeight(const ossimEcefRay& ray,
+                               double startHeight,
+                               ossimGpt& gpt,
+                               double defaultElevValue = 0.0);
    
    /**
     * Access methods for the bounding elevations:
@@ -161,6 +174,13 @@ protected:
    ossimElevSource();
    ossimElevSource(const ossimElevSource& src);
 
+   /**
+    * Called at the end of each intersectRay() with the height lookups it
+    * took; converged is false if it stopped at the iteration limit.  This
+    * implementation does nothing.
+    */
+   virtual void addRayIntersection(ossim_uint32 iterations, bool converged);
+
    /**
     * Data members:
     */
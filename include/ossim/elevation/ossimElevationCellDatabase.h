@@ -1,17 +1,19 @@
 #ifndef ossimElevationCellDatabase_HEADER
 #define ossimElevationCellDatabase_HEADER 1
 #include <ossim/elevation/ossimElevationDatabase.h>
+#include <OpenThreads/Atomic>
 
 class OSSIM_DLL ossimElevationCellDatabase : public ossimElevationDatabase
 {
 public:
    struct CellInfo : ossimReferenced
    {
-      CellInfo(ossim_uint64 id, ossimElevCellHandler* handler = 0)
+      CellInfo(ossim_uint64 id, ossimElevCellHandler* handler = 0, ossim_uint32 epoch = 0)
          :ossimReferenced(),
           m_id(id),
           m_handler(handler),
-          m_timestamp(0)
+          m_timestamp(0),
+          m_lastUsed(epoch)
       {
             m_timestamp = ossimTimer::instance()->tick();
       }
@@ -19,14 +21,16 @@ public:
          :ossimReferenced(src),
           m_id(src.m_id),
           m_handler(src.m_handler),
-          m_timestamp(src.m_timestamp)
+          m_timestamp(src.m_timestamp),
+          m_lastUsed(static_cast<unsigned>(src.m_lastUsed))
       {
       }
       CellInfo()
          :ossimReferenced(),
           m_id(0),
           m_handler(0),
-          m_timestamp(0)
+          m_timestamp(0),
+          m_lastUsed(0)
       {
       }
       const CellInfo& operator =(const CellInfo& src)
@@ -36,6 +40,7 @@ public:
             m_id = src.m_id;
             m_handler = src.m_handler;
             m_timestamp = src.m_timestamp;
+            m_lastUsed.exchange(static_cast<unsigned>(src.m_lastUsed));
          }
          return *this;
       }
@@ -43,6 +48,19 @@ public:
       {
          m_timestamp = ossimTimer::instance()->tick();
       }
+
+      /**
+       * Marks the cell used in the given cache epoch.  Only stores when the
+       * epoch moved on, so hits on a hot cell from many threads do not keep
+       * writing its cache line.
+       */
+      void touch(ossim_uint32 epoch)
+      {
+         if (static_cast<unsigned>(m_lastUsed) != epoch)
+         {
+            m_lastUsed.exchange(epoch);
+         }
+      }
       ossim_uint64 id()const
       {
          return m_id;
@@ -50,15 +68,52 @@ public:
       ossim_uint64                      m_id;
       ossimRefPtr<ossimElevCellHandler> m_handler;
       ossimTimer::Timer_t               m_timestamp;
+
+      /** Cache epoch of the last hit, see m_cacheEpoch. */
+      OpenThreads::Atomic               m_lastUsed;
    };
 
    typedef std::map<ossim_uint64, ossimRefPtr<CellInfo> > CellMap;
+
+   /**
+    * Cell cache counters, see getCacheStatistics().  Bytes are estimated with
+    * ossimElevCellHandler::getSizeInBytes().  Misses are either opens of a
+    * cell or coverage misses, points no cell file was found for.
+    */
+   struct CacheStatistics
+   {
+      CacheStatistics()
+         : m_hits(0), m_misses(0), m_opens(0), m_coverageMisses(0), m_openSeconds(0.0),
+           m_evictions(0), m_openCells(0), m_peakOpenCells(0), m_bytes(0), m_peakBytes(0) {}
+      CacheStatistics& operator+=(const CacheStatistics& rhs);
+
+      ossim_uint64 m_hits;
+      ossim_uint64 m_misses;
+      ossim_uint64 m_opens;
+      ossim_uint64 m_coverageMisses;
+      double       m_openSeconds;   //!< In createCell, opens and coverage misses.
+      ossim_uint64 m_evictions;
+      ossim_uint64 m_openCells;
+      ossim_uint64 m_peakOpenCells;
+      ossim_uint64 m_bytes;
+      ossim_uint64 m_peakBytes;
+   };
    
    ossimElevationCellDatabase()
       :ossimElevationDatabase(),
       m_minOpenCells(5),
       m_maxOpenCells(10),
-      m_memoryMapCellsFlag(false)
+      m_memoryMapCellsFlag(false),
+      m_cacheSnapshot(0),
+      m_cacheEpoch(0),
+      m_cacheMisses(0),
+      m_cacheOpens(0),
+      m_cacheCoverageMisses(0),
+      m_cacheOpenTicks(0),
+      m_cacheEvictions(0),
+      m_cacheBytes(0),
+      m_peakOpenCells(0),
+      m_peakCacheBytes(0)
    {
    }
    ossimElevationCellDatabase(const ossimElevationCellDatabase& src)
@@ -66,8 +121,19 @@ public:
       m_minOpenCells(src.m_minOpenCells),
       m_maxOpenCells(src.m_maxOpenCells),
       m_cacheMap(src.m_cacheMap),
-      m_memoryMapCellsFlag(src.m_memoryMapCellsFlag)
+      m_memoryMapCellsFlag(src.m_memoryMapCellsFlag),
+      m_cacheSnapshot(0),
+      m_cacheEpoch(static_cast<unsigned>(src.m_cacheEpoch)),
+      m_cacheMisses(0),
+      m_cacheOpens(0),
+      m_cacheCoverageMisses(0),
+      m_cacheOpenTicks(0),
+      m_cacheEvictions(0),
+      m_cacheBytes(0),
+      m_peakOpenCells(0),
+      m_peakCacheBytes(0)
    {
+      publishCacheSnapshot();
    }
 
    virtual bool loadState(const ossimKeywordlist& kwl, const char* prefix=0);
@@ -97,6 +163,24 @@ public:
 
    virtual void getOpenCellList(std::vector<ossimFilename>& list) const;
 
+   /**
+    * Cell cache lookups by getOrCreateCellHandler since construction or the
+    * last resetCacheStatistics(): hits found an open cell, misses had to
+    * open one (or found no cell file).  Counters are 32 bit and wrap.
+    */
+   ossim_uint64 getCacheHits() const;
+   ossim_uint64 getCacheMisses() const;
+
+   /**
+    * Hits and misses as above, the cell opens, coverage misses and time
+    * spent opening, the cells evicted to get back to the min open cells, and
+    * the open cells and their bytes now and at their peak.
+    */
+   void getCacheStatistics(CacheStatistics& stats) const;
+
+   /** Zeroes the counters and sets the peaks to the current values. */
+   void resetCacheStatistics();
+
    /**
     * @brief Gets a list of elevation cells needed to cover bounding box.
     * @param connectionString Typically elevation repository, e.g.:
@@ -122,9 +206,66 @@ public:
    }
    virtual ossimRefPtr<ossimElevCellHandler> getOrCreateCellHandler(const ossimGpt& gpt);
 
+   /**
+    * Batch lookups.  Points are matched against the cells already found for
+    * this call before going to the cell cache, so runs of points in one cell
+    * cost a single coverage test each, and the geoid is queried once for the
+    * whole set.
+    */
+   virtual void getHeightsAboveMSL(const ossimGpt* gpts,
+                                   double* heights,
+                                   ossim_uint32 count);
+   virtual void getHeightsAboveEllipsoid(const ossimGpt* gpts,
+                                         double* heights,
+                                         ossim_uint32 count);
+
    virtual std::ostream& print(std::ostream& out) const;
 
 protected:
+   /**
+    * Read only copy of m_cacheMap, sorted by id, that getOrCreateCellHandler
+    * searches without taking m_cacheMapMutex.  Replaced whole on every change
+    * to the cache; the old copy is kept until no reader can still hold it.
+    */
+   struct CellSnapshot
+   {
+      CellInfo* find(ossim_uint64 id);
+
+      std::vector<ossim_uint64>           m_ids;
+      std::vector<ossimRefPtr<CellInfo> > m_cells;
+   };
+
+   enum
+   {
+      READER_SLOTS = 32
+   };
+
+   /** Readers inside the snapshot, spread over slots by thread. */
+   struct ReaderSlot
+   {
+      OpenThreads::Atomic m_count;
+      OpenThreads::Atomic m_hits;  //!< Kept here so hits never share a line.
+      char                m_pad[64 - 2 * sizeof(OpenThreads::Atomic)]; // Own cache line.
+   };
+
+   virtual ~ossimElevationCellDatabase();
+
+   /**
+    * Rebuilds the snapshot from m_cacheMap and frees the retired ones no
+    * reader can see any more.  Also updates the cache byte count and peaks.
+    * Caller holds m_cacheMapMutex, except in the constructor.
+    */
+   void publishCacheSnapshot();
+
+   /** Counts a hit for databases keeping their own lookup, e.g. by coverage. */
+   void addCacheHit();
+
+   /**
+    * Counts a createCell from begin to end, an open if opened or else a
+    * coverage miss.  Caller holds m_cacheMapMutex.
+    */
+   void addCellOpen(bool opened, ossimTimer::Timer_t begin, ossimTimer::Timer_t end);
+
    virtual ossimRefPtr<ossimElevCellHandler> createCell(const ossimGpt& /* gpt */)
    {
       return 0;
@@ -137,32 +278,35 @@ protected:
          m_cacheMap.erase(iter);
       }
    }
-   void flushCacheToMinOpenCells()
-   {
-      // lets flush the cache from least recently used to recent.
-      //
-      CellMap sortedMap;
-      CellMap::iterator iter = m_cacheMap.begin();
-      
-      while(iter != m_cacheMap.end())
-      {
-         sortedMap.insert(std::make_pair(iter->second->m_timestamp, iter->second));
-         ++iter;
-      }
-      
-      iter = sortedMap.begin();
-      while((iter!=sortedMap.end())&&(m_cacheMap.size() > m_minOpenCells))
-      {
-         remove(iter->second->id());
-         ++iter;
-      }
-   }
+   /**
+    * Flushes the cache from least to most recently used.  Age is the cache
+    * epoch of the last hit, then the open (or updateTimestamp) time.
+    */
+   void flushCacheToMinOpenCells();
    
    ossim_uint32               m_minOpenCells;
    ossim_uint32               m_maxOpenCells;
    mutable OpenThreads::Mutex m_cacheMapMutex;
    CellMap                    m_cacheMap;
    ossim_uint32               m_memoryMapCellsFlag;
+
+   OpenThreads::AtomicPtr     m_cacheSnapshot;      //!< Current CellSnapshot.
+   std::vector<CellSnapshot*> m_retiredSnapshots;   //!< Guarded by m_cacheMapMutex.
+   ReaderSlot                 m_readers[READER_SLOTS];
+
+   /** Bumped on every cell open, so last use is only ordered between opens. */
+   OpenThreads::Atomic        m_cacheEpoch;
+
+   OpenThreads::Atomic        m_cacheMisses;
+
+   // Guarded by m_cacheMapMutex:
+   ossim_uint64               m_cacheOpens;
+   ossim_uint64               m_cacheCoverageMisses;
+   ossimTimer::Timer_t        m_cacheOpenTicks;
+   ossim_uint64               m_cacheEvictions;
+   ossim_uint64               m_cacheBytes;
+   ossim_uint64               m_peakOpenCells;
+   ossim_uint64               m_peakCacheBytes;
    
    TYPE_DATA;
 };
@@ -54,6 +54,19 @@ public:
       return m_geoid.get();
    }
    
+   /**
+    * Batch forms of getHeightAboveMSL and getHeightAboveEllipsoid.  Fills
+    * heights[i] for gpts[i], nan where there is no post.  The defaults loop
+    * over the single point calls; cell based databases override them to
+    * look each cell up once for all of its points.
+    */
+   virtual void getHeightsAboveMSL(const ossimGpt* gpts,
+                                   double* heights,
+                                   ossim_uint32 count);
+   virtual void getHeightsAboveEllipsoid(const ossimGpt* gpts,
+                                         double* heights,
+                                         ossim_uint32 count);
+   
    /**
     * Open a connection to a database.  In most cases this will be a pointer
     * to a directory like in a Dted directory reader.  
@@ -72,12 +85,22 @@ public:
    
    virtual std::ostream& print(std::ostream& out) const;
 
+   /**
+    * Geoid height at gpt, 0 where unknown; what getHeightAboveEllipsoid
+    * adds to the height above MSL.
+    */
+   virtual double getOffsetFromEllipsoid(const ossimGpt& gpt);
+
 protected:
    virtual ~ossimElevationDatabase()
    {
       m_geoid = 0;
    }
-   virtual double getOffsetFromEllipsoid(const ossimGpt& gpt);
+
+   /** Batch form of getOffsetFromEllipsoid; one geoid pass for all points. */
+   void getOffsetsFromEllipsoid(const ossimGpt* gpts,
+                                double* offsets,
+                                ossim_uint32 count);
 
    ossimString m_connectionString;
    ossimRefPtr<ossimGeoid>    m_geoid;
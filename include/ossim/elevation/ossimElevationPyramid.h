@@ -0,0 +1,120 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Persistent, memory mapped, multi resolution tiled elevation cache.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimElevationPyramid_HEADER
+#define ossimElevationPyramid_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimGrect.h>
+#include <ossim/base/ossimReferenced.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <vector>
+
+class ossimGpt;
+class ossimMemoryMappedFile;
+
+//*************************************************************************************************
+//! A region of heights above MSL sampled on a WGS84 lat/lon grid at several resolutions, kept in
+//! one file of fixed size float tiles that is mapped, not read, when opened.
+//!
+//! Level 0 has the spacing given to build(); each level after it doubles the spacing and starts
+//! on the same upper left post, so a level holds a quarter of the posts of the one before. Posts
+//! within a tile are stored north to south, west to east, and tiles in the same order. Null
+//! posts are nan.
+//!
+//! build() samples the posts through ossimElevManager, so the file can be made once from
+//! whatever elevation setup is loaded and reopened by later processes in O(1). Files are
+//! written in native byte order and refused on a machine of the other order.
+//*************************************************************************************************
+class OSSIM_DLL ossimElevationPyramid : public ossimReferenced
+{
+public:
+   ossimElevationPyramid();
+
+   //! Maps file. @return false if it is not a pyramid file or is truncated.
+   bool open(const ossimFilename& file);
+
+   void close();
+
+   bool isOpen() const { return !m_levels.empty(); }
+
+   //! @return true if file starts with the pyramid file signature.
+   static bool isPyramidFile(const ossimFilename& file);
+
+   //! Samples region from ossimElevManager::instance() and writes a pyramid to file.
+   //!
+   //! @param spacing Level 0 post spacing in decimal degrees.
+   //! @param levels Number of levels; stops early once a level fits in one post row or column.
+   //! @param tileSize Posts on a tile side, rounded up to a power of two.
+   //!
+   //! The manager's geoid fallback and elevation offset are turned off while sampling so the
+   //! cache holds only database heights.
+   static bool build(const ossimFilename& file,
+                     const ossimGrect& region,
+                     double spacing,
+                     ossim_uint32 levels,
+                     ossim_uint32 tileSize=256);
+
+   ossim_uint32 getNumberOfLevels() const { return (ossim_uint32)m_levels.size(); }
+
+   //! @return Post spacing of level in decimal degrees.
+   double getSpacing(ossim_uint32 level) const;
+
+   //! @return Post spacing of level in meters, latitude direction.
+   double getSpacingMeters(ossim_uint32 level) const;
+
+   //! @return Coarsest level whose spacing is no more than gsd meters; 0 for finer requests.
+   ossim_uint32 getLevel(double gsd) const;
+
+   //! @return Area covered by level 0 posts.
+   const ossimGrect& getBoundingRect() const { return m_rect; }
+
+   //! @return Bilinear height above MSL at gpt from level, nan off the grid or with no valid
+   //! neighbour post. Null neighbours are left out of the blend.
+   double getHeightAboveMSL(const ossimGpt& gpt, ossim_uint32 level) const;
+
+   const ossimFilename& getFilename() const { return m_filename; }
+
+protected:
+   virtual ~ossimElevationPyramid();
+
+   struct Level
+   {
+      ossim_uint32   m_rows;
+      ossim_uint32   m_cols;
+      ossim_uint32   m_tilesX;
+      double         m_spacing;
+      double         m_invSpacing;
+      const float*   m_posts;      //!< First tile, inside the mapping.
+   };
+
+   //! @return Post (row, col) of level.
+   inline float post(const Level& level, ossim_uint32 row, ossim_uint32 col) const;
+
+   ossimFilename                     m_filename;
+   ossimRefPtr<ossimMemoryMappedFile> m_map;
+   std::vector<Level>                m_levels;
+   ossim_uint32                      m_tileSize;
+   ossim_uint32                      m_tileShift; //!< log2(m_tileSize).
+   double                            m_ulLat;
+   double                            m_ulLon;
+   ossimGrect                        m_rect;
+};
+
+inline float ossimElevationPyramid::post(const Level& level, ossim_uint32 row,
+                                         ossim_uint32 col) const
+{
+   const ossim_uint32 mask = m_tileSize - 1;
+   const float* tile = level.m_posts + ( (size_t)((row >> m_tileShift) * level.m_tilesX +
+                                         (col >> m_tileShift)) << (2 * m_tileShift) );
+   return tile[((row & mask) << m_tileShift) + (col & mask)];
+}
+
+#endif /* #ifndef ossimElevationPyramid_HEADER */
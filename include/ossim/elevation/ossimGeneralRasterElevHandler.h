@@ -15,6 +15,9 @@
 #include <ossim/base/ossimIoStream.h>
 //#include <fstream>
 
+#include <ossim/base/ossimMemoryMappedFile.h>
+#include <ossim/base/ossimPositionalFile.h>
+#include <ossim/base/ossimRefPtr.h>
 #include <ossim/base/ossimString.h>
 #include <ossim/base/ossimDatum.h>
 #include <ossim/elevation/ossimElevCellHandler.h>
@@ -158,12 +161,18 @@ private:
    
    ossimGeneralRasterElevHandler::GeneralRasterInfo theGeneralRasterInfo;
    mutable OpenThreads::Mutex m_inputStreamMutex;
+
+   /** Post reads, under m_inputStreamMutex, only if m_file could not be opened. */
    std::ifstream m_inputStream;
 
+   /** Lock free positional post reads of a cell that is not memory mapped. */
+   ossimPositionalFile m_file;
+
    /** @brief true if stream is open. */
    bool          m_streamOpen;
    
-   std::vector<char> m_memoryMap;
+   /** @brief Mapped cell when opened with memoryMapFlag, null when read through m_inputStream. */
+   ossimRefPtr<ossimMemoryMappedFile> m_memoryMap;
 TYPE_DATA
 };
 
@@ -24,6 +24,7 @@
 #include <ossim/base/ossimRefPtr.h>
 #include <ossim/base/ossimRtti.h>
 #include <map>
+#include <vector>
 
 class ossimString;
 
@@ -87,6 +88,16 @@ public:
     * @return Height above MSL.
     */
    virtual double getHeightAboveEllipsoid(const ossimGpt&);
+
+   /**
+    * @brief Batch height above MSL.
+    *
+    * Goes point by point through getHeightAboveMSL so each lookup keeps
+    * m_meanSpacing in step with the cell it used.
+    */
+   virtual void getHeightsAboveMSL(const ossimGpt* gpts,
+                                   double* heights,
+                                   ossim_uint32 count);
    
    /**
     * Satisfies pure virtual ossimElevSource::pointHasCoverage
@@ -192,10 +203,31 @@ private:
 
    /**
     * @brief Initializes m_entryMap with all loadable files from
-    * m_connectionString.
+    * m_connectionString, then builds the spatial index.
     */
    void loadFileMap();
 
+   /**
+    * @brief Gets the bounds of every entry and fills m_index.
+    *
+    * Bounds come from the index file when the file's modification time and
+    * size match, otherwise the file is opened once.  Entries that cannot be
+    * opened are dropped.  The index file is rewritten if anything changed.
+    */
+   void buildIndex();
+
+   /** @brief Ids of the entries whose bounds may hold gpt. */
+   void getCandidates(const ossimGpt& gpt, std::vector<ossim_uint64>& ids) const;
+
+   /**
+    * @return Index file kept in the connection directory,
+    * <dir>/.ossim_image_elevation_index, or empty if not a directory.
+    */
+   ossimFilename getIndexFile() const;
+
+   /** Index grid cell, (row, col) of size m_indexCellSize degrees. */
+   typedef std::pair<ossim_int32, ossim_int32> IndexKey;
+
    /** Hidden from use copy constructor */
    ossimImageElevationDatabase(const ossimImageElevationDatabase& copy_this);
    
@@ -203,6 +235,13 @@ private:
    ossim_uint64       m_lastMapKey;
    ossim_uint64       m_lastAccessedId;
 
+   /** Uniform grid over the entry bounds: entry ids overlapping each cell. */
+   std::map<IndexKey, std::vector<ossim_uint64> > m_index;
+
+   /** Entries too large for the grid; always tested. */
+   std::vector<ossim_uint64> m_largeEntries;
+   ossim_float64      m_indexCellSize;
+
    TYPE_DATA 
 };
 
@@ -16,6 +16,9 @@
 #include <ossim/base/ossimIoStream.h>
 //#include <fstream>
 
+#include <ossim/base/ossimMemoryMappedFile.h>
+#include <ossim/base/ossimPositionalFile.h>
+#include <ossim/base/ossimRefPtr.h>
 #include <ossim/base/ossimString.h>
 #include <ossim/elevation/ossimElevCellHandler.h>
 #include <ossim/support_data/ossimSrtmSupportData.h>
@@ -76,7 +79,7 @@ public:
    virtual ossimObject* dup() const
    {
       ossimSrtmHandler* obj = new ossimSrtmHandler();
-      obj->open(theFilename, (m_memoryMap.size() != 0));
+      obj->open(theFilename, m_memoryMap.valid());
       return obj;
    }
 
@@ -85,8 +88,13 @@ protected:
    virtual ~ossimSrtmHandler();
    ossimSrtmSupportData m_supportData;
    mutable OpenThreads::Mutex m_fileStrMutex;
+
+   /** Post reads, under m_fileStrMutex, only if m_file could not be opened. */
    std::ifstream m_fileStr;
 
+   /** Lock free positional post reads of a cell that is not memory mapped. */
+   ossimPositionalFile m_file;
+
    /** @brief true if stream is open. */
    bool          m_streamOpen;
    
@@ -99,7 +107,8 @@ protected:
    ossimEndian*     m_swapper;
    ossimScalarType  m_scalarType;
    
-   mutable std::vector<ossim_int8> m_memoryMap;
+   /** @brief Mapped cell when opened with memoryMapFlag, null when read through m_fileStr. */
+   ossimRefPtr<ossimMemoryMappedFile> m_memoryMap;
    
    template <class T>
    double getHeightAboveMSLFileTemplate(T dummy, const ossimGpt& gpt);
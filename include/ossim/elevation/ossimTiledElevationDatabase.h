@@ -24,6 +24,7 @@
 #include <vector>
 
 class ossimDblGrid;
+class ossimElevationPyramid;
 class ossimFilename;
 class ossimFileWalker;
 class ossimImageData;
@@ -43,6 +44,11 @@ class ossimString;
  * of interest up front and want to bypass the ossimElevManager and grid the
  * elevation prior to processing for speed.  Can work on a file or a
  * directory of files.
+ *
+ * The connection string may instead name an ossimElevationPyramid file
+ * (type "elevation_pyramid" in a keyword list).  The pyramid is mapped on
+ * open, mapRegion is then not needed, and heights come from the level picked
+ * by setRequestedGsd (keyword "gsd", meters), full resolution by default.
  */
 class OSSIM_DLL ossimTiledElevationDatabase :
    public ossimElevationDatabase, public ossimFileProcessorInterface
@@ -73,6 +79,15 @@ public:
     */
    void mapRegion(const ossimGrect& region);
 
+   /**
+    * @brief Picks the coarsest pyramid level with a post spacing no more than
+    * gsd meters.  Does nothing unless opened on a pyramid file.
+    */
+   void setRequestedGsd(double gsd);
+
+   /** @return Pyramid level used for heights, 0 if not opened on a pyramid. */
+   ossim_uint32 getLevel() const;
+
    /**
     * @brief Get height above MSL for point.
     *
@@ -193,6 +208,13 @@ private:
     */
    void getBoundingRect(ossimRefPtr<ossimImageGeometry> geom, ossimGrect& boundingRect) const;
 
+   /**
+    * @brief Maps file if it is a pyramid and sets the ground rect and mean
+    * spacing from it.
+    * @return true if file was opened as a pyramid.
+    */
+   bool openPyramid(const ossimFilename& file);
+
    /** @brief Loads m_requestedRect into m_grid from m_entries. */
    void mapRegion();
 
@@ -216,6 +238,12 @@ private:
 
    ossimFileWalker* m_fileWalker;
 
+   /** Set when the connection string is a pyramid file. */
+   ossimRefPtr<ossimElevationPyramid> m_pyramid;
+
+   /** Pyramid level getHeightAboveMSL reads. */
+   ossim_uint32 m_level;
+
    TYPE_DATA 
 };
 
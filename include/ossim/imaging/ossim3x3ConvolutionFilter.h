@@ -72,24 +72,6 @@ protected:
    vector<double> theMinPixValue;
    vector<double> theMaxPixValue;   
    
-   /*!
-    * Convolve full means that the input data is full and has
-    * no null data.  We don't have to compare for nulls here
-    */
-   template<class T>
-   void convolveFull(T,
-                     ossimRefPtr<ossimImageData> inputData,
-                     ossimRefPtr<ossimImageData> outputData);
-   
-   /*!
-    * Convolve partial means that the input data is has some
-    * null data.  We will have to compare nulls
-    */
-   template<class T>
-   void convolvePartial(T,
-                        ossimRefPtr<ossimImageData> inputData,
-                        ossimRefPtr<ossimImageData> outputData);
-                       
 
 TYPE_DATA
 };
@@ -77,7 +77,17 @@ protected:
    double               theVerticalShear;
    ossimIrect           theBoundingRect;
 
+   /**
+    * The string rasterized whole, in the font's coordinates, so drawing it
+    * on each tile it crosses only copies.  Rasterized again on the next draw
+    * after any change to the string, font or its geometry.
+    */
+   mutable std::vector<ossim_uint8> theRaster;
+   mutable ossimIrect               theRasterRect;
+   mutable bool                     theRasterDirtyFlag;
+
    void setFontInfo()const;
+   void rasterizeString()const;
 TYPE_DATA   
 };
 
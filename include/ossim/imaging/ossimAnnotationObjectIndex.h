@@ -0,0 +1,68 @@
+//*******************************************************************
+//
+// License:  See LICENSE.txt file in the top level directory.
+//
+// Description:
+//
+// Contains declaration of class ossimAnnotationObjectIndex.
+//
+//*******************************************************************
+#ifndef ossimAnnotationObjectIndex_HEADER
+#define ossimAnnotationObjectIndex_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimDrect.h>
+#include <vector>
+
+/**
+ * Uniform grid over the bounding rectangles of annotation objects, in the
+ * image (view) space they are drawn in, so drawing a tile only visits the
+ * objects near it instead of every object of the source.
+ *
+ * Cells are about the size of the area per object, and never smaller than
+ * a tile.  Objects with no bounds (nans) or covering too many cells are
+ * kept aside and returned by every query.  Owners rebuild the index when
+ * their objects change or are transformed to a new view.
+ */
+class OSSIMDLLEXPORT ossimAnnotationObjectIndex
+{
+public:
+   ossimAnnotationObjectIndex();
+
+   /**
+    * Indexes rects, replacing the previous ones.  Below a handful of
+    * rects nothing is indexed and queries return every rect.
+    */
+   void build(const std::vector<ossimDrect>& rects);
+
+   void clear();
+
+   /** @return true if build() indexed its rects. */
+   bool isIndexed()const;
+
+   /** @return Number of rects given to the last build(). */
+   ossim_uint32 getNumberOfObjects()const;
+
+   /**
+    * Sets result to the indexes, in increasing order, of the rects that
+    * may intersect rect grown by a few pixels, the slack the objects take
+    * for line thickness and clipping, or to every index if not indexed.
+    * Callers still draw or test each.
+    */
+   void query(const ossimDrect& rect, std::vector<ossim_uint32>& result)const;
+
+private:
+   ossim_uint32                             theNumberOfObjects;
+   ossimDpt                                 theOrigin;
+   double                                   theCellSize; // 0 if not indexed.
+   ossim_int32                              theCols;
+   ossim_int32                              theRows;
+
+   /** Objects overlapping each cell, row major. */
+   std::vector< std::vector<ossim_uint32> > theCells;
+
+   /** Objects without bounds or too large for the grid; always returned. */
+   std::vector<ossim_uint32>                theUnindexed;
+};
+
+#endif /* #ifndef ossimAnnotationObjectIndex_HEADER */
@@ -27,6 +27,7 @@
 #include <ossim/base/ossimDrect.h>
 #include <ossim/imaging/ossimRgbImage.h>
 #include <ossim/imaging/ossimAnnotationObject.h>
+#include <ossim/imaging/ossimAnnotationObjectIndex.h>
 
 class ossimKeywordlist;
 
@@ -110,14 +111,32 @@ public:
    */
    void deleteAll();
    
+   /**
+    * Draws the objects whose bounds may intersect the tile, found with a
+    * grid index over the object bounds rebuilt on the first draw after
+    * objects are added, deleted or their bounds computed again.
+    */
    virtual void drawAnnotations(ossimRefPtr<ossimImageData> tile);
+
+   /**
+    * Rebuilds the object index on the next draw.  Called by the methods
+    * changing objects here; call it after moving objects of
+    * getObjectList() without computeBoundingRect().
+    */
+   void invalidateObjectIndex();
    
 protected:
    
    void allocate(const ossimIrect& rect);
    void destroy();
    
-   ossimAnnotationSource(const ossimAnnotationSource& rhs):ossimImageSourceFilter(rhs){}
+   ossimAnnotationSource(const ossimAnnotationSource& rhs)
+      :ossimImageSourceFilter(rhs),
+       theObjectIndexDirtyFlag(true)
+   {}
+
+   /** Rebuilds theObjectIndex from the object bounds if invalid. */
+   void updateObjectIndex();
 
    /*!
     * What is the size of the image.  This class
@@ -148,6 +167,10 @@ protected:
     */
    AnnotationObjectListType theAnnotationObjectList;   
 
+   ossimAnnotationObjectIndex theObjectIndex;
+   bool                       theObjectIndexDirtyFlag;
+   std::vector<ossim_uint32>  theDrawList; // Objects found for the tile drawn.
+
 TYPE_DATA
 };
 
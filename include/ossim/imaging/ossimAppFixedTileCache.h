@@ -14,10 +14,12 @@
 #define ossimAppFixedTileCache_HEADER
 #include <map>
 #include <list>
+#include <vector>
 #include <iostream>
 #include <ossim/base/ossimConstants.h>
 #include <ossim/base/ossimRefPtr.h>
 #include <ossim/base/ossimIrect.h>
+#include <OpenThreads/Mutex>
 #include <OpenThreads/ReadWriteMutex>
 
 class ossimFixedTileCache;
@@ -67,6 +69,44 @@ public:
    const ossimIpt& getTileSize(ossimAppFixedCacheId cacheId);
    
    virtual void setMaxCacheSize(ossim_uint32 cacheSize);
+   ossim_uint32 getMaxCacheSize()const;
+
+   /**
+    * Counters of one cache id or of the whole cache.  Hits and misses count
+    * getTile calls, evictions the tiles dropped to stay within the size
+    * budget.  Tiles and bytes are what is held now.  Peaks are kept per
+    * shard and summed, so they can be a little above the true peak.
+    */
+   struct Statistics
+   {
+      Statistics();
+      Statistics& operator+=(const Statistics& rhs);
+
+      ossim_uint64 theHits;
+      ossim_uint64 theMisses;
+      ossim_uint64 theEvictions;
+      ossim_uint64 theTiles;
+      ossim_uint64 theBytes;
+      ossim_uint64 thePeakBytes;
+   };
+
+   /**
+    * @return true and the counters of cacheId if it was ever created.
+    * Counters of a deleted cache are kept, with no tiles or bytes.
+    */
+   bool getStatistics(ossimAppFixedCacheId cacheId, Statistics& stats)const;
+
+   /** Counters of every cache id created, deleted ones included. */
+   void getStatistics(std::map<ossimAppFixedCacheId, Statistics>& stats)const;
+
+   /** Counters of the whole cache. */
+   void getTotalStatistics(Statistics& stats)const;
+
+   /** Zeroes the hit, miss and eviction counters and sets the peaks to the current sizes. */
+   void resetStatistics();
+
+   /** Writes the totals, then one line for each cache id with tiles or lookups. */
+   void printStatistics(std::ostream& out)const;
    
 protected:
 //    struct ossimAppFixedCacheTileInfo
@@ -88,14 +128,42 @@ protected:
 //    };
    
    ossimAppFixedTileCache();
-   
-   ossimFixedTileCache* getCache(ossimAppFixedCacheId cacheId);
 
-   void shrinkGlobalCacheSize(ossim_int32 byteCount);
-   void shrinkCacheSize(ossimAppFixedCacheId id,
-                        ossim_int32 byteCount);
-   void shrinkCacheSize(ossimFixedTileCache* cache,
-                        ossim_int32 byteCount);
+   /**
+    * One lock stripe of the cache.  Holds, for every registered cache id, the
+    * sub cache of the tiles that hash to this shard, plus the byte count and
+    * share of the global budget for the shard.
+    */
+   struct Shard
+   {
+      Shard();
+      ~Shard();
+
+      ossimFixedTileCache* getCache(ossimAppFixedCacheId cacheId);
+
+      /** Frees about byteCount bytes using the LRU order of the sub caches. */
+      void shrink(ossim_int32 byteCount);
+      void shrinkCache(ossimAppFixedCacheId cacheId,
+                       ossimFixedTileCache* cache,
+                       ossim_int32 byteCount);
+
+      mutable OpenThreads::Mutex theMutex;
+      std::map<ossimAppFixedCacheId, ossimRefPtr<ossimFixedTileCache> > theCacheMap;
+      ossim_uint32 theCurrentCacheSize;
+      ossim_uint32 theMaxCacheSize;
+      ossim_uint32 theMaxGlobalCacheSize;
+
+      /**
+       * Counters of the ids with a sub cache here, and of deleted ones.
+       * Tiles and bytes are filled in from the sub caches when queried.
+       */
+      std::map<ossimAppFixedCacheId, Statistics> theStatistics;
+      ossim_uint32 thePeakCacheSize;
+   };
+
+   /** @return Shard for a tile of cacheId at origin. */
+   Shard* getShard(ossimAppFixedCacheId cacheId, const ossimIpt& origin)const;
+
    void deleteAll();
    
    static ossimAppFixedTileCache *theInstance;
@@ -107,11 +175,17 @@ protected:
    ossimIpt                       theTileSize;
    ossim_uint32                   theMaxCacheSize;
    ossim_uint32                   theMaxGlobalCacheSize;
-   ossim_uint32                   theCurrentCacheSize;
 
-   std::map<ossimAppFixedCacheId, ossimFixedTileCache*> theAppCacheMap;
+   /**
+    * Tiles are spread over the shards by hashing (cache id, tile origin) so
+    * threads working on different tiles rarely take the same lock.  The
+    * global budget is enforced approximately: each shard evicts against an
+    * equal share of it.
+    */
+   std::vector<Shard*>            theShards;
 
-   OpenThreads::Mutex theMutex;
+   /** Guards the id counter, theTileSize and the budget settings. */
+   mutable OpenThreads::Mutex theMutex;
 };
 
 #endif
@@ -103,6 +103,10 @@ public:
     */
    virtual bool loadState(const ossimKeywordlist& kwl,
                           const char* prefix=NULL);
+
+   /** Copies the band list; see ossimImageSource::cloneSource. */
+   virtual ossimImageSource* cloneSource() const;
+
    /**
     *   Override base class so that a disableSource event does not
     *   reinitialize the object and enable itself.
@@ -16,6 +16,7 @@
 #include <ossim/base/ossimIpt.h>
 #include <ossim/base/ossimOutputSource.h>
 #include <ossim/imaging/ossimPixelFlipper.h>
+#include <OpenThreads/Mutex>
 #include <vector>
 
 class ossimFilename;
@@ -86,7 +87,8 @@ public:
    void setStartingResLevel(ossim_uint32 res_level) { m_startingResLevel = res_level; }
 
    //! Given a source's tile, derives the alpha mask and saves it in buffer for later writing to 
-   //! disk.
+   //! disk. Bogus pixels of the tile are flipped to null in place. Tiles of any R-levels may be
+   //! given from several threads at once as long as no two overlap.
    void generateMask(ossimRefPtr<ossimImageData> tile, ossim_uint32 rLevel);
 
    //! For imagery that already has overviews built, but with artifact edge pixels (such as JP2-
@@ -122,11 +124,16 @@ protected:
    //! size of the source image based on the original R0 image size.
    ossimIpt computeImageSize(ossim_uint32 rlevel, ossimImageData* tile) const;
 
+   //! Returns the buffer of the mask R-level, allocating it (and any below it) of the size given
+   //! if needed.
+   ossim_uint8* getMaskBuffer(ossim_uint32 mask_rlevel, const ossimIpt& size);
+
    ossimRefPtr<ossimPixelFlipper>  m_flipper;
    vector<ossim_uint8*>            m_buffers;
    vector<ossimIpt>                m_bufferSizes;
    ossim_uint32                    m_startingResLevel;
    ossimIpt                        m_imageSize; //!< Size of full res source image
+   OpenThreads::Mutex              m_mutex; //!< Guards buffer allocation and shared mask bytes
 };
 
 #endif
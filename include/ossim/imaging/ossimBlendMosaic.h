@@ -57,6 +57,13 @@ protected:
    virtual ~ossimBlendMosaic();
    vector<double>              theWeights;
    ossimRefPtr<ossimImageData> theNormResult;
+   std::vector<ossim_uint8>    theValidMask;
+
+   /**
+    * @return One entry per pixel of tile, zero where all its bands are null.  Valid until the
+    * next call.
+    */
+   const ossim_uint8* getValidMask(const ossimImageData* tile);
    /**
     * If our inputs have output of different scalar
     * types then we must normalize so we can blend
@@ -0,0 +1,52 @@
+//*******************************************************************
+//
+// License:  LGPL
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description: Reporting of the tile and elevation cache statistics.
+//
+//********************************************************************
+#ifndef ossimCacheStatistics_HEADER
+#define ossimCacheStatistics_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <iosfwd>
+#include <string>
+
+/**
+ * Reports the hits, misses, evictions and bytes of the process caches:
+ * ossimAppFixedTileCache per cache id, and the cell cache of each database
+ * of ossimElevManager.  print() and summary() also give the live and peak
+ * bytes of ossimImageDataAccounting, and print() the elevation query
+ * statistics when ossimElevManager counts them.
+ *
+ * startReporter() logs summary() at INFO level every few seconds from a
+ * background thread and, where SIGUSR1 exists, prints the full statistics
+ * when the process gets it:
+ *
+ *   kill -USR1 <pid>
+ *
+ * ossimInit starts it from the cache_statistics.* preferences.
+ */
+class OSSIMDLLEXPORT ossimCacheStatistics
+{
+public:
+   /** Full statistics, one line per cache. */
+   static void print(std::ostream& out);
+
+   /** One line totals of the tile cache and the elevation cells. */
+   static std::string summary();
+
+   /**
+    * Starts the reporter thread, or changes its settings if running.
+    * @param seconds Logs summary() this often; 0 for never.
+    * @param signalFlag Prints the statistics on SIGUSR1.
+    */
+   static void startReporter(double seconds, bool signalFlag);
+
+   /** Stops the reporter thread; done at exit. */
+   static void stopReporter();
+};
+
+#endif /* #ifndef ossimCacheStatistics_HEADER */
@@ -52,6 +52,12 @@ public:
    virtual bool saveState(ossimKeywordlist& kwl,
                           const char* prefix=0)const;
 
+   /**
+    * Copies the cache settings, not the cached tiles; see
+    * ossimImageSource::cloneSource.
+    */
+   virtual ossimImageSource* cloneSource() const;
+
    virtual ossimRefPtr<ossimProperty> getProperty(const ossimString& name)const;
    virtual void setProperty(ossimRefPtr<ossimProperty> property);
    virtual void getPropertyNames(std::vector<ossimString>& propertyNames)const;
@@ -0,0 +1,217 @@
+//*******************************************************************
+//
+// License:  LGPL
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description: Per-node getTile profiling of image source chains.
+//
+//********************************************************************
+#ifndef ossimChainProfiler_HEADER
+#define ossimChainProfiler_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimReferenced.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/imaging/ossimImageSourceFilter.h>
+#include <OpenThreads/Mutex>
+#include <map>
+#include <set>
+#include <vector>
+
+class ossimConnectableObject;
+class ossimFilename;
+class ossimImageChain;
+class ossimImageData;
+class ossimImageHandler;
+class ossimKeywordlist;
+class ossimChainProfilerProbe;
+
+namespace OpenThreads
+{
+   class Thread;
+}
+
+/**
+ * Opt-in profiling of the getTile calls of every node in an image source
+ * graph, e.g. handler, renderer, remapper, combiner, cast filter, so a slow
+ * ossim-orthoigen or ossim-chipper run shows where the time goes:
+ *
+ *   ossimRefPtr<ossimChainProfiler> profiler = new ossimChainProfiler();
+ *   profiler->instrument(writer.get());
+ *   writer->execute();
+ *   profiler->write(ossimFilename("profile.kwl"));
+ *
+ * instrument() puts an ossimChainProfilerProbe, a pass-through filter,
+ * after each image source of the graph: between the children of image
+ * chains with the chain's own insert calls, and on the input connections
+ * between other objects.  An input that does not accept the probe is left
+ * as is.  Probes are saved and loaded like any source, so the chains the
+ * multi-threaded sequencer clones keep them, and report to the same nodes.
+ *
+ * Each node records, per thread, the getTile calls, the inclusive time, the
+ * exclusive time (less the time in the nodes it called), the bytes of the
+ * tiles returned and the cache hits of caches reporting them through
+ * cacheHit().  Image handler nodes also report the bytes read, reads, seeks
+ * and read time of their files (ossimImageHandler::getIoCounters), and the
+ * read amplification: bytes read over bytes of the tiles returned.
+ */
+class OSSIMDLLEXPORT ossimChainProfiler : public ossimReferenced
+{
+public:
+   ossimChainProfiler();
+
+   /**
+    * Puts probes after the image sources root pulls from, and after those
+    * they pull from, and so on; root itself is not timed.  Makes this the
+    * profiler cacheHit() reports to and cloned probes join.
+    */
+   void instrument(ossimConnectableObject* root);
+
+   /**
+    * Timing of the calls to a getTile; used by the probes.  begin and end
+    * must pair on the calling thread.
+    */
+   void begin(ossim_uint32 node);
+   void end(ossim_uint32 node, const ossimImageData* tile);
+
+   /**
+    * Adds the I/O counters of handler to those of node; used by the probes,
+    * once per handler, so the handlers of cloned chains add up.  The
+    * handlers are kept until the profiler goes.
+    */
+   void addIoSource(ossim_uint32 node, ossimImageHandler* handler);
+
+   /** Number of nodes instrumented. */
+   ossim_uint32 getNumberOfNodes() const;
+
+   /**
+    * Saves the node tree with prefix, e.g. "chain_profile.": a node's
+    * inputs are nested under it as node0., node1., ..., each with its type,
+    * totals and per thread counts.
+    */
+   void saveState(ossimKeywordlist& kwl, const char* prefix=0) const;
+
+   /** Writes saveState(kwl, "chain_profile.") to file. */
+   bool write(const ossimFilename& file) const;
+
+   /**
+    * Counts a cache hit against the node being timed on this thread, if a
+    * profiler is active.  The cost is a pointer check otherwise.
+    */
+   static void cacheHit();
+
+   /** The profiler of the last instrument(), 0 if none. */
+   static ossimChainProfiler* getActive();
+
+   /**
+    * Output file of the profiling preference, chain_profile.file, or an
+    * empty name if not set.
+    */
+   static ossimFilename getPreferenceFile();
+
+protected:
+   virtual ~ossimChainProfiler();
+
+private:
+   /** Counts of one node on one thread. */
+   struct Counts
+   {
+      Counts()
+         : m_calls(0), m_inclusive(0), m_exclusive(0), m_bytes(0), m_cacheHits(0) {}
+      ossim_uint64        m_calls;
+      ossimTimer::Timer_t m_inclusive;
+      ossimTimer::Timer_t m_exclusive;
+      ossim_uint64        m_bytes;
+      ossim_uint64        m_cacheHits;
+   };
+
+   struct Node
+   {
+      ossimString         m_type;
+      ossimString         m_name;
+      ossim_int32         m_parent;
+      std::vector<Counts> m_threads; // By thread index.
+      std::vector< ossimRefPtr<ossimImageHandler> > m_ioSources;
+   };
+
+   /** A getTile in progress. */
+   struct Frame
+   {
+      ossim_uint32        m_node;
+      ossimTimer::Timer_t m_start;
+      ossimTimer::Timer_t m_children;
+   };
+
+   struct ThreadState
+   {
+      ossim_uint32       m_index;
+      std::vector<Frame> m_frames;
+   };
+
+   // Not copyable.
+   ossimChainProfiler(const ossimChainProfiler&);
+   const ossimChainProfiler& operator=(const ossimChainProfiler&);
+
+   void instrumentInputs(ossimConnectableObject* obj, ossim_int32 node);
+   void instrumentChain(ossimImageChain* chain, ossim_int32 node);
+   void addNode(ossimConnectableObject* source, ossim_int32 parent);
+
+   /** Called with m_mutex locked. */
+   ThreadState& getThreadState();
+   Counts& getCounts(ossim_uint32 node, ossim_uint32 thread);
+
+   void saveNode(ossimKeywordlist& kwl, const ossimString& prefix, ossim_uint32 node) const;
+
+   mutable OpenThreads::Mutex                   m_mutex;
+   std::vector<Node>                            m_nodes;
+   std::map<OpenThreads::Thread*, ThreadState>  m_threads;
+
+   // Used by instrument():
+   std::set<ossimConnectableObject*>                 m_visited;
+   std::map<ossimConnectableObject*, ossim_int32>    m_nodeOf;
+   std::map<ossimConnectableObject*, ossimChainProfilerProbe*> m_probeOf;
+
+   ossimTimer::Timer_t                          m_startTick;
+};
+
+/**
+ * Pass-through filter timing the getTile calls of its input for an
+ * ossimChainProfiler.  Without a profiler, e.g. loaded from a saved chain
+ * after the run, it only passes tiles through.  While ossimTimeline records,
+ * each getTile is also a span named after the input's class.
+ */
+class OSSIMDLLEXPORT ossimChainProfilerProbe : public ossimImageSourceFilter
+{
+public:
+   ossimChainProfilerProbe();
+   ossimChainProfilerProbe(ossimChainProfiler* profiler, ossim_uint32 node);
+
+   virtual ossimRefPtr<ossimImageData> getTile(const ossimIrect& tileRect,
+                                               ossim_uint32 resLevel=0);
+
+   ossim_int32 getNode() const;
+
+   virtual bool saveState(ossimKeywordlist& kwl, const char* prefix=0) const;
+
+   /** Joins the active profiler, if any, as the saved node. */
+   virtual bool loadState(const ossimKeywordlist& kwl, const char* prefix=0);
+
+protected:
+   virtual ~ossimChainProfilerProbe();
+
+   ossimRefPtr<ossimChainProfiler> m_profiler;
+   ossim_int32                     m_node;
+
+   /** Input class name for the ossimTimeline getTile spans, set on first use. */
+   const char*                     m_spanName;
+
+   /** Set once the input was given to ossimChainProfiler::addIoSource. */
+   bool                            m_ioSourceAdded;
+
+TYPE_DATA
+};
+
+#endif /* #ifndef ossimChainProfiler_HEADER */
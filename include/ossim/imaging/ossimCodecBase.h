@@ -59,6 +59,29 @@ public:
    virtual bool decode( const std::vector<ossim_uint8>& in,
                         ossimRefPtr<ossimImageData>& out ) const=0;
 
+   /**
+    * @brief Decode method on a buffer the caller owns.
+    *
+    * This default copies the buffer to a vector for the method above and
+    * only handles full resolution.
+    *
+    * @param in Input data to decode.
+    *
+    * @param size Number of bytes at in.
+    *
+    * @param out Output tile, as above.
+    *
+    * @param scale Output is 1/scale of the full resolution in each
+    * direction, rounded up.  Codecs that support it (jpeg: 1, 2, 4 or 8)
+    * reduce while decoding.
+    *
+    * @return true on success, false on failure or unsupported scale.
+    */
+   virtual bool decode( const ossim_uint8* in,
+                        ossim_uint64 size,
+                        ossimRefPtr<ossimImageData>& out,
+                        ossim_uint32 scale = 1 ) const;
+
 TYPE_DATA;
 
 };
@@ -21,6 +21,15 @@ using namespace std;
 class ossimTilePatch;
 class ossimDiscreteConvolutionKernel;
 
+/**
+ * Convolves its input with one or more kernels, applied in turn.
+ *
+ * Tiles without null pixels are convolved a row of output at a time from a double precision copy
+ * of the input band, with one vectorized multiply-add per kernel tap. Rank one kernels (e.g.
+ * Gaussian or box smoothing) larger than 3x3 are applied as a horizontal then a vertical 1D pass,
+ * which differs from the 2D sum only in floating point rounding. Tiles with nulls take the
+ * per-pixel path, which leaves nulls out of the sums.
+ */
 class OSSIM_DLL ossimConvolutionSource : public ossimImageSourceFilter
 {
 public:
@@ -56,14 +65,39 @@ protected:
    ossim_int32                 theMaxKernelWidth;
    ossim_int32                 theMaxKernelHeight;
    
+   /** Kernel coefficients prepared for the full tile path. */
+   struct ossimConvolutionTaps
+   {
+      std::vector<double> theTaps;    // Row ordered kernel.
+      std::vector<double> theRowTaps; // Horizontal factor if separable.
+      std::vector<double> theColTaps; // Vertical factor if separable.
+      double              theDivisor; // Sum of the kernel if averaging, else 0.
+      bool                theSeparableFlag;
+   };
+   
    std::vector<ossimDiscreteConvolutionKernel* > theConvolutionKernelList;
+   std::vector<ossimConvolutionTaps> theKernelTaps; // One per kernel of the list.
+   std::vector<double> thePatchBuffer; // Input band, as double.
+   std::vector<double> theRowBuffer;   // Horizontal pass of a separable kernel.
+   std::vector<double> theSumBuffer;   // One row of output.
    virtual void setKernelInformation();
    virtual void deleteConvolutionList();
 
+   /** Sets taps from kernel, factoring it if it is rank one. */
+   static void initTaps(const ossimDiscreteConvolutionKernel* kernel,
+                        ossimConvolutionTaps& taps);
+
    template<class T>
    void convolve(T dummyVariable,
                  ossimRefPtr<ossimImageData> inputTile,
                  ossimDiscreteConvolutionKernel* kernel);
+
+   /** convolve() for tiles without nulls. */
+   template<class T>
+   void convolveFull(T dummyVariable,
+                     const ossimImageData* inputTile,
+                     const ossimDiscreteConvolutionKernel* kernel,
+                     const ossimConvolutionTaps& taps);
    
 
 TYPE_DATA
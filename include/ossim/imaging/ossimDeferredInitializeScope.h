@@ -0,0 +1,66 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description:
+//
+// Scope in which image source re-initialization on events is collected
+// and run once, in input to output order, when the scope ends.
+//
+//*******************************************************************
+// $Id$
+
+#ifndef ossimDeferredInitializeScope_HEADER
+#define ossimDeferredInitializeScope_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+
+class ossimImageSource;
+
+/**
+ * @brief Batches the initialize() calls that connection, property and
+ * refresh events trigger (see ossimImageSource::requestInitialize).
+ *
+ * Building a chain or setting several properties fires an event per change,
+ * and each node re-initializes on every change upstream of it. Within a
+ * scope each requesting source is queued once instead; when the outermost
+ * scope of the thread ends, the queued sources are initialized once each,
+ * inputs before outputs.
+ *
+ * Usage:
+ * @code
+ * {
+ *    ossimDeferredInitializeScope scope;
+ *    chain->add(remapper);
+ *    chain->add(renderer);
+ *    renderer->setProperty(prop);
+ * } // Each source initialized once here.
+ * @endcode
+ *
+ * Scopes nest and apply to the thread that opened them. Sources queried
+ * inside a scope may not reflect the changes made in it yet.
+ */
+class OSSIMDLLEXPORT ossimDeferredInitializeScope
+{
+public:
+   ossimDeferredInitializeScope();
+
+   /** @brief Initializes the queued sources if this is the outermost scope. */
+   ~ossimDeferredInitializeScope();
+
+   /**
+    * @brief Queues source if a scope is open in this thread.
+    * @return true if queued, false if the caller should initialize now.
+    */
+   static bool defer(ossimImageSource* source);
+
+   /** @brief Drops source from the queues, e.g. when it is destroyed. */
+   static void cancel(ossimImageSource* source);
+
+private:
+   // Not copyable.
+   ossimDeferredInitializeScope(const ossimDeferredInitializeScope&);
+   const ossimDeferredInitializeScope& operator=(const ossimDeferredInitializeScope&);
+};
+
+#endif /* #ifndef ossimDeferredInitializeScope_HEADER */
@@ -0,0 +1,147 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description:
+//
+// Dense normalized cross correlation between two images in the same
+// image space, e.g. for displacement fields in change detection.
+//
+//*******************************************************************
+// $Id$
+
+#ifndef ossimDenseCorrelator_HEADER
+#define ossimDenseCorrelator_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimIpt.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimReferenced.h>
+#include <OpenThreads/Mutex>
+#include <vector>
+
+class ossimImageSource;
+
+/**
+ * @brief Matches a grid of master templates against a slave image by
+ * normalized cross correlation (NCC), giving the slave minus master
+ * displacement of each node to a fraction of a pixel.
+ *
+ * The nodes are split in tiles correlated in parallel on the job queue. Each
+ * tile reads its master and slave rectangles once, with a halo of the
+ * template radius (plus the search radius for the slave), so neighboring
+ * nodes share the reads. Window means and deviations of the slave come from
+ * running sums (integral images of I and I^2) in constant time per window;
+ * the template products are summed directly, or for templates of
+ * getFftTemplateRadius() and up through an FFT cross correlation of the whole
+ * search area.
+ *
+ * Both sources must be in the same image space, e.g. the slave through a
+ * chain resampling it to the master. Reads are serialized, as image sources
+ * are not thread safe; the correlation runs in parallel.
+ */
+class OSSIMDLLEXPORT ossimDenseCorrelator : public ossimReferenced
+{
+public:
+   ossimDenseCorrelator();
+
+   /** @brief Templates are 2*radius+1 pixels on a side. Default 7. */
+   void setTemplateRadius(ossim_uint32 radius);
+   ossim_uint32 getTemplateRadius() const;
+
+   /** @brief Displacements searched are within +-radius pixels. Default 8. */
+   void setSearchRadius(ossim_uint32 radius);
+   ossim_uint32 getSearchRadius() const;
+
+   /** @brief Pixels between grid nodes. Default 8. */
+   void setGridSpacing(ossim_uint32 spacing);
+   ossim_uint32 getGridSpacing() const;
+
+   /** @brief Nodes whose best correlation is below are left NaN. Default 0.7. */
+   void setMinCorrelation(ossim_float64 minCorrel);
+   ossim_float64 getMinCorrelation() const;
+
+   /**
+    * @brief Template radius from which the FFT path is used; 0 to always sum
+    * directly. Default 12.
+    */
+   void setFftTemplateRadius(ossim_uint32 radius);
+   ossim_uint32 getFftTemplateRadius() const;
+
+   /** @brief Nodes per tile side, the unit of work of a job. Default 16. */
+   void setTileNodes(ossim_uint32 nodes);
+
+   /** @brief Threads to use; 0 (default) for ossim::getNumberOfThreads(). */
+   void setNumberOfThreads(ossim_uint32 threads);
+
+   /**
+    * @brief Correlates the nodes region.ul() + (i, j) * spacing inside region.
+    * @param band Zero based band of both sources to use.
+    * @return false if the inputs are not usable.
+    */
+   bool correlate(ossimImageSource* master,
+                  ossimImageSource* slave,
+                  const ossimIrect& region,
+                  ossim_uint32 band=0);
+
+   /** @return Nodes across and down. */
+   const ossimIpt& getGridSize() const;
+
+   /** @return Image position of node (0, 0). */
+   const ossimIpt& getGridOrigin() const;
+
+   /**
+    * @brief Results of the last correlate(), row major by node: slave minus
+    * master displacement and peak correlation; NaN where there is no match.
+    */
+   const std::vector<ossim_float32>& getDx() const;
+   const std::vector<ossim_float32>& getDy() const;
+   const std::vector<ossim_float32>& getScore() const;
+
+   /**
+    * @brief Best match of one template over a search area, the per node
+    * step of correlate().
+    * @param tmpl (2*tr+1)^2 values, row major.
+    * @param search (2*(tr+sr)+1)^2 values, row major, centered as tmpl.
+    * NaN values (nulls) exclude the windows holding them.
+    * @param dx, dy Set to the displacement of the best match.
+    * @param score Set to its correlation.
+    * @return false if no window could be correlated.
+    */
+   static bool matchTemplate(const ossim_float32* tmpl,
+                             ossim_uint32 tr,
+                             const ossim_float32* search,
+                             ossim_uint32 sr,
+                             bool useFft,
+                             ossim_float64& dx,
+                             ossim_float64& dy,
+                             ossim_float64& score);
+
+   /** @brief Correlates tile (column, row) of tiles; used by the jobs. */
+   void correlateTile(ossim_uint32 tileX, ossim_uint32 tileY);
+
+protected:
+   virtual ~ossimDenseCorrelator();
+
+   ossim_uint32        m_templateRadius;
+   ossim_uint32        m_searchRadius;
+   ossim_uint32        m_gridSpacing;
+   ossim_float64       m_minCorrelation;
+   ossim_uint32        m_fftTemplateRadius;
+   ossim_uint32        m_tileNodes;
+   ossim_uint32        m_numberOfThreads;
+
+   // State of a correlate() call:
+   ossimImageSource*   m_master;
+   ossimImageSource*   m_slave;
+   ossim_uint32        m_band;
+   OpenThreads::Mutex  m_readMutex;
+
+   ossimIpt                    m_gridOrigin;
+   ossimIpt                    m_gridSize;
+   std::vector<ossim_float32>  m_dx;
+   std::vector<ossim_float32>  m_dy;
+   std::vector<ossim_float32>  m_score;
+};
+
+#endif /* #ifndef ossimDenseCorrelator_HEADER */
@@ -15,6 +15,7 @@
 #include <ossim/imaging/ossimCastTileSourceFilter.h>
 #include <ossim/base/ossimEquTokenizer.h>
 #include <stack>
+#include <vector>
 
 //class ossimCastTileSourceFilter;
 
@@ -166,6 +167,11 @@
  * normalized so that 1.0 = 90 deg from vertical, is computed with:
  * "acosd(band(in[0],2))/90"
  *
+ * The equation is compiled once, when first needed after it changes, into a program of
+ * stack instructions with the constant parts folded.  Tiles are then computed by running the
+ * program over reused pixel buffers, each input tile being fetched once.  Equations using
+ * assign_band, conv, blurr or shift are parsed again for every tile instead.
+ *
  * </pre>
  */
 class OSSIMDLLEXPORT ossimEquationCombiner : public ossimImageCombiner
@@ -182,6 +188,7 @@ public:
    virtual void setEquation(const ossimString& equ)
       {
          theEquation = equ;
+         theProgramDirty = true;
       }
    virtual ossimString getEquation()const
       {
@@ -246,6 +253,41 @@ protected:
       ossimEquDataType d;
    };
 
+   enum ossimEquInstructionCode
+   {
+      OSSIM_EQU_PUSH_CONSTANT = 0,
+      OSSIM_EQU_PUSH_INPUT    = 1,
+      OSSIM_EQU_BINARY_OP     = 2,
+      OSSIM_EQU_UNARY_OP      = 3,
+      OSSIM_EQU_SELECT_BAND   = 4,
+      OSSIM_EQU_CLAMP         = 5
+   };
+
+   /**
+    * Instruction of the compiled equation.  token is the OSSIM_EQU_TOKEN_* of the operator or
+    * function; value holds the constant, input index, band number or clamp range.
+    */
+   struct ossimEquInstruction
+   {
+      int    code;
+      int    token;
+      double value[2];
+   };
+
+   /**
+    * Value on the stack of the compiled equation.  Image pixels are band sequential and are
+    * either those of buffer or, until written, those of an input tile.
+    */
+   struct ossimEquRegister
+   {
+      int                   type;
+      double                doubleValue;
+      const double*         data;
+      std::vector<double>   buffer;
+      std::vector<double>   nullPix;
+      ossimDataObjectStatus status;
+   };
+
    virtual ~ossimEquationCombiner();
    
    
@@ -259,6 +301,13 @@ protected:
    mutable int                theCurrentId;
    mutable std::stack<ossimEquValue> theValueStack;
    ossim_uint32                     theCurrentResLevel;
+
+   std::vector<ossimEquInstruction> theProgram;
+   std::vector<ossim_uint32>        theProgramInputs;
+   std::vector<ossimEquRegister>    theRegisters;
+   std::vector<ossimEquRegister>    theInputs;
+   bool                             theProgramDirty;
+   bool                             theProgramValid;
    virtual void assignValue();
    virtual void clearStacks();
    virtual void clearArgList(vector<ossimEquValue>& argList);
@@ -271,6 +320,39 @@ protected:
                              bool popValueStack = true);
    
    virtual ossimRefPtr<ossimImageData> parseEquation();
+
+   /**
+    * Compiles theEquation into theProgram.  False, leaving tiles to parseEquation(), if the
+    * equation does not parse or uses assign_band, conv, blurr or shift.
+    */
+   virtual bool compileEquation();
+
+   /**
+    * Runs theProgram over the rectangle of theTile and assigns the result to theTile.
+    * False, with theTile untouched, if the tile must go through parseEquation().
+    */
+   virtual bool runProgram();
+
+   bool compileExpression();
+   bool compileRestOfExp();
+   bool compileTerm();
+   bool compileRestOfTerm();
+   bool compileFactor();
+   bool compileUnaryFactor();
+   bool compileStdFuncs();
+   bool compileArgList(ossim_uint32& argCount);
+   bool compileUnaryFunc(int token);
+   void emitInstruction(int code, int token, double v1 = 0.0, double v2 = 0.0);
+   void emitBinaryOp(int token);
+   void emitUnaryOp(int token);
+   bool isConstant(ossim_uint32 fromEnd) const;
+
+   void applyBinaryOp(int token, ossimEquRegister& v1, ossimEquRegister& v2, ossim_uint32 size);
+   void applyUnaryOp(int token, ossimEquRegister& v, ossim_uint32 size);
+   bool selectBand(ossimEquRegister& v, ossim_uint32 band, ossim_uint32 size);
+   void clampRegister(ossimEquRegister& v, double minValue, double maxValue, ossim_uint32 size);
+   double* getWritableBuffer(ossimEquRegister& v, ossim_uint32 size, bool keepPixels);
+   void assignRegister(const ossimEquRegister& v);
   
    virtual bool parseAssignBand();
    virtual bool parseExpression();
@@ -20,6 +20,7 @@
 #include <ossim/base/ossimRtti.h>
 
 class ossimAnnotationObject;
+class ossimGrect;
 class ossimString;
 
 class OSSIMDLLEXPORT ossimEsriShapeFileInterface
@@ -32,6 +33,26 @@ public:
     */
    virtual std::multimap<long, ossimAnnotationObject*> getFeatureTable() = 0;
 
+   /**
+    * Returns the features whose ground bounds intersect region, e.g. the
+    * footprint of the image a shape file cutline is applied to.  A NaN
+    * region returns all of them.
+    *
+    * This default filters getFeatureTable().  Readers that keep a spatial
+    * index (the .qix of a shape file, or one built on first read) should
+    * override it to only read the shapes of the index cells that intersect
+    * region.
+    */
+   virtual std::multimap<long, ossimAnnotationObject*> getFeatureTableInRegion(
+      const ossimGrect& region);
+
+   /**
+    * Computes the ground bounds of a polygon or multi polygon feature
+    * straight from its vertices.  Returns false for other features or
+    * features with no vertices.
+    */
+   static bool getGroundBounds(const ossimAnnotationObject* feature, ossimGrect& bounds);
+
    /**
     * Pure virtual setQuery method.
     *
@@ -12,6 +12,8 @@
 #ifndef ossimFeatherMosaic_HEADER
 #define ossimFeatherMosaic_HEADER
 #include <vector>
+#include <deque>
+#include <map>
 #include <iterator>
 
 #include <ossim/imaging/ossimImageMosaic.h>
@@ -20,6 +22,9 @@
 
 /**
  * Performs a spatial blend accross overlapping regions
+ *
+ * The weights of each input over a tile are computed in one pass and kept for the most
+ * recently requested tiles, so serving the same area again does not recompute them.
  */
 class OSSIMDLLEXPORT ossimFeatherMosaic : public ossimImageMosaic
 {
@@ -81,6 +86,38 @@ protected:
    
    virtual double computeWeight(long index,
                                 const ossimDpt& point)const;
+
+   /**
+    * Sets weights, row ordered, to computeWeight(index, p) for each point p of rect.
+    */
+   virtual void computeWeights(long index,
+                               const ossimIrect& rect,
+                               double* weights)const;
+
+   /**
+    * @return The weights of input index over rect, from the cache or computed and cached.
+    */
+   const double* getWeights(long index, const ossimIrect& rect);
+
+   /** Tile of an input in theWeightCache. */
+   struct ossimFeatherWeightKey
+   {
+      long        theIndex;
+      ossimIrect  theRect;
+
+      bool operator<(const ossimFeatherWeightKey& rhs)const
+      {
+         if(theIndex != rhs.theIndex) return theIndex < rhs.theIndex;
+         if(theRect.ul().y != rhs.theRect.ul().y) return theRect.ul().y < rhs.theRect.ul().y;
+         if(theRect.ul().x != rhs.theRect.ul().x) return theRect.ul().x < rhs.theRect.ul().x;
+         if(theRect.lr().y != rhs.theRect.lr().y) return theRect.lr().y < rhs.theRect.lr().y;
+         return theRect.lr().x < rhs.theRect.lr().x;
+      }
+   };
+
+   std::map<ossimFeatherWeightKey, std::vector<double> > theWeightCache;
+   std::deque<ossimFeatherWeightKey> theWeightCacheOrder; // Oldest first.
+   std::vector<double>               theMaskedWeights;
 TYPE_DATA
 };
 
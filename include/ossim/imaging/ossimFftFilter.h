@@ -12,9 +12,18 @@
 #ifndef ossimFftFilter_HEADER
 #define ossimFftFilter_HEADER
 #include <ossim/imaging/ossimImageSourceFilter.h>
+#include <vector>
 
 class ossimScalarRemapper;
+class ossimFftWorkspace;
 
+/**
+ * Forward FFT of each band to a real and an imaginary band, or inverse FFT of such band pairs.
+ *
+ * Built with FFTW3 (OSSIM_HAS_FFTW3), tiles are transformed in place as real data with plans
+ * made once per tile size and shared by all filters, and the bands of a tile are split among
+ * ossim::getNumberOfThreads() threads.  Otherwise the newmat FFT2 is used, one band at a time.
+ */
 class ossimFftFilter : public ossimImageSourceFilter
 {
 public:
@@ -63,6 +72,13 @@ protected:
    ossimRefPtr<ossimImageData> theTile;
    ossimFftFilterDirectionType theDirectionType;
    ossimRefPtr<ossimScalarRemapper>        theScalarRemapper;
+
+   /** Transform buffers, one per band thread, kept across tiles of the same size. */
+   std::vector<ossimFftWorkspace*> theWorkspaces;
+
+   /** @return Workspace index, created or resized for w x h tiles. */
+   ossimFftWorkspace* getWorkspace(ossim_uint32 index, ossim_uint32 w, ossim_uint32 h);
+   
    template <class T>
    void runFft(T dummy,
                ossimRefPtr<ossimImageData>& input,
@@ -127,6 +127,32 @@ private:
 			    const ossimDpt& deltaUl,
 			    const ossimDpt& deltaUr,
 			    const ossimDpt& outLength);
+
+  /**
+   * Separable path of resampleBilinearTile for axis aligned scale changes, i.e. when input x
+   * depends only on the output sample and input y only on the output line. Filters the input
+   * lines horizontally with per sample weights computed once for the tile, then combines them
+   * vertically with per line weights.  Gives the same result as the two dimensional kernel loop.
+   *
+   * @return false, writing nothing, if a kernel footprint leaves the input tile; the caller then
+   * uses the general loop.
+   */
+  template <class T>
+  bool resampleSeparableTile(const T* const* inputBuf,
+                             T* const* resultBuf,
+                             ossim_uint32 bands,
+                             ossim_uint32 inWidth,
+                             ossim_uint32 inHeight,
+                             ossim_uint32 resultWidth,
+                             ossim_uint32 resultHeight,
+                             ossim_uint32 resultStride,
+                             double initialx,
+                             double initialy,
+                             double deltaX,
+                             double deltaY,
+                             const ossim_float64* nullPix,
+                             const ossim_float64* minPix,
+                             const ossim_float64* maxPix);
   
    void computeTable();
    ossimString getFilterTypeAsString(ossimFilterResamplerType type)const;
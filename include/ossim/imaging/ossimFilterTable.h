@@ -56,6 +56,18 @@ public:
     */
    const double* getClosestWeights(const double& x, const double& y)const;
 
+   /**
+    * Inlined below.
+    *
+    * One dimensional factors of the table: getClosestWeights(x, y)[line*getWidth()+samp] is
+    * getClosestYWeights(y)[line]*getClosestXWeights(x)[samp].  Used by the separable
+    * resampling path.
+    *
+    * @return const double* to the getWidth() x weights (getHeight() y weights) closest to x (y).
+    */
+   const double* getClosestXWeights(const double& x)const;
+   const double* getClosestYWeights(const double& y)const;
+
 protected:
 
    /**
@@ -65,6 +77,8 @@ protected:
    void allocateWeights();
 
    double*      theWeights;
+   double*      theXWeights;
+   double*      theYWeights;
    ossim_uint32 theWidth;
    ossim_uint32 theHeight;
    ossim_uint32 theWidthHeight;
@@ -94,4 +108,20 @@ inline const double* ossimFilterTable::getClosestWeights(const double& x,
                       kernelSamp)*theWidthHeight];
 }
 
+inline const double* ossimFilterTable::getClosestXWeights(const double& x)const
+{
+   double intPartDummy;
+   ossim_int32 kernelSamp =
+      (ossim_int32)(theFilterSteps*fabs(modf(x, &intPartDummy)));
+   return &theXWeights[kernelSamp*theWidth];
+}
+
+inline const double* ossimFilterTable::getClosestYWeights(const double& y)const
+{
+   double intPartDummy;
+   ossim_int32 kernelLine =
+      (ossim_int32)(theFilterSteps*fabs(modf(y, &intPartDummy)));
+   return &theYWeights[kernelLine*theHeight];
+}
+
 #endif /* End of "#ifndef ossimFilterTable_HEADER" */
@@ -15,6 +15,7 @@
 #define ossimFixedTileCache_HEADER
 #include <map>
 #include <list>
+#include <vector>
 #include <ossim/base/ossimIpt.h>
 #include <ossim/base/ossimReferenced.h>
 #include <ossim/base/ossimRefPtr.h>
@@ -27,7 +28,11 @@ public:
    ossimFixedTileCacheInfo(ossimRefPtr<ossimImageData>& tile,
                            ossim_int32 tileId=-1)
       :theTile(tile),
-      theTileId(tileId)
+      theTileId(tileId),
+      theLruPrev(0),
+      theLruNext(0),
+      theHashNext(0),
+      theQueue(0)
       {
       }
    
@@ -58,11 +63,46 @@ public:
    
    ossimRefPtr<ossimImageData> theTile;
    ossim_int32 theTileId;
+
+   /** Intrusive links, owned by ossimFixedTileCache. */
+   ossimFixedTileCacheInfo* theLruPrev;
+   ossimFixedTileCacheInfo* theLruNext;
+   ossimFixedTileCacheInfo* theHashNext;
+
+   /** Replacement queue holding the tile; see ossimFixedTileCache::ReplacementPolicy. */
+   ossim_uint32 theQueue;
 };
 
+/**
+ * Tile cache for one image rectangle.
+ *
+ * Tiles are found through a hash table of intrusive nodes and ordered in
+ * doubly linked replacement queues, so lookups, touches and evictions are
+ * constant time regardless of the number of tiles held.
+ */
 class ossimFixedTileCache : public ossimReferenced
 {
 public:
+   /**
+    * Replacement policy used by deleteTile()/removeTile() with no arguments.
+    *
+    * LRU_POLICY:       Evicts the least recently used tile.
+    * TWO_QUEUE_POLICY: Simplified 2Q (segmented LRU). New tiles enter a
+    *                   probation queue and move to the main queue when hit
+    *                   again.  Evictions take from probation while it holds
+    *                   at least a quarter of the tiles, so a one pass scan
+    *                   (e.g. a full image write) does not flush the tiles
+    *                   an interactive view keeps reusing.
+    *
+    * The default comes from the preferences keyword "cache_policy"
+    * (lru|2q); lru if not set.
+    */
+   enum ReplacementPolicy
+   {
+      LRU_POLICY       = 0,
+      TWO_QUEUE_POLICY = 1
+   };
+
    ossimFixedTileCache();
    virtual void setRect(const ossimIrect& rect);
    virtual void setRect(const ossimIrect& rect,
@@ -100,7 +140,7 @@ public:
       }
    virtual ossim_uint32 getNumberOfTiles()const
       {
-         return (ossim_uint32)theTileMap.size();
+         return theNumberOfTiles;
       }
    virtual const ossimIpt& getTileSize()const
       {
@@ -122,6 +162,14 @@ public:
       {
          return theMaxCacheSize;
       }
+
+   /** Sets the replacement policy.  Tiles already cached are kept. */
+   void setReplacementPolicy(ReplacementPolicy policy);
+
+   ReplacementPolicy getReplacementPolicy()const
+      {
+         return thePolicy;
+      }
    
    virtual ossimIpt getTileOrigin(ossim_int32 tileId);
    virtual ossim_int32 computeId(const ossimIpt& tileOrigin)const;
@@ -136,9 +184,44 @@ protected:
    ossim_uint32 theTilesVertical;
    ossim_uint32 theCacheSize;
    ossim_uint32 theMaxCacheSize;
-   std::map<ossim_int32, ossimFixedTileCacheInfo> theTileMap;
-   std::list<ossim_int32> theLruQueue;
-   bool                   theUseLruFlag;
+   bool         theUseLruFlag;
+   ReplacementPolicy thePolicy;
+
+   /** Intrusive doubly linked replacement queue, least recently used at head. */
+   struct Queue
+   {
+      Queue() : theHead(0), theTail(0), theCount(0) {}
+      ossimFixedTileCacheInfo* theHead;
+      ossimFixedTileCacheInfo* theTail;
+      ossim_uint32             theCount;
+   };
+
+   enum
+   {
+      PROBATION_QUEUE = 0, //!< New tiles under TWO_QUEUE_POLICY.
+      MAIN_QUEUE      = 1, //!< All tiles under LRU_POLICY.
+      NUMBER_OF_QUEUES
+   };
+
+   /** Hash buckets, chained through theHashNext. Size is a power of two. */
+   std::vector<ossimFixedTileCacheInfo*> theHashTable;
+   ossim_uint32 theNumberOfTiles;
+   Queue        theQueues[NUMBER_OF_QUEUES];
+
+   ossimFixedTileCacheInfo* findNode(ossim_int32 id)const;
+   void insertNode(ossimFixedTileCacheInfo* node);
+   void unlinkNode(ossimFixedTileCacheInfo* node);
+   void growHashTable();
+   void pushBack(ossimFixedTileCacheInfo* node, ossim_uint32 queue);
+   void unlinkFromQueue(ossimFixedTileCacheInfo* node);
+
+   /** @return Next tile to evict per the policy, or 0 if empty. */
+   ossimFixedTileCacheInfo* victim()const;
+
+   /** Releases node and its tile.  @return The tile. */
+   ossimRefPtr<ossimImageData> eraseNode(ossimFixedTileCacheInfo* node);
+   void clearNodes();
+
    virtual void eraseFromLru(ossim_int32 id);
    void adjustLru(ossim_int32 id);
 };
@@ -20,6 +20,8 @@
 
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/base/ossimIoStream.h>
+#include <ossim/base/ossimMemoryMappedFile.h>
+#include <ossim/base/ossimReadAhead.h>
 #include <ossim/imaging/ossimGeneralRasterInfo.h>
 #include <vector>
   
@@ -56,6 +58,19 @@ public:
     * whatever.
     */
    virtual bool getTile(ossimImageData* result, ossim_uint32 resLevel=0);   
+
+   /**
+    * @brief Hints the os to read the lines covering rects.
+    * Overrides: ossimImageHandler::prefetch
+    */
+   virtual void prefetch(const std::vector<ossimIrect>& rects,
+                         ossim_uint32 resLevel=0);
+
+   /**
+    * @brief Adds the counts of the file streams; mapped reads are not seen.
+    * Overrides: ossimImageHandler::getIoCounters
+    */
+   virtual bool getIoCounters(ossimIoCounters::Values& values) const;
    
    /**
     *  Returns the number of bands in the image.
@@ -169,6 +184,26 @@ public:
    /** @brief Initializes bandList to the zero based order of output bands. */
    virtual void getOutputBandList(std::vector<ossim_uint32>& bandList) const;
 
+   /**
+    * @brief Enables memory mapped reads.
+    *
+    * When set, open() maps the image files read only and full res tiles are
+    * copied straight from the mapping into the output tile, a row at a time,
+    * with no seek and read and no intermediate buffer.  Files that can't be
+    * mapped (e.g. urls) are read through the streams as before.  Takes effect
+    * on the next open.  Default comes from the preferences keyword
+    * "general_raster.memory_map", false if not set.
+    */
+   void setMemoryMapFlag(bool flag);
+   bool getMemoryMapFlag() const;
+
+   /**
+    * @return true if the image files are mapped, as mapped reads touch no
+    * handler state.
+    * Overrides: ossimImageHandler::hasConcurrentReads
+    */
+   virtual bool hasConcurrentReads() const;
+
 protected:
    virtual ~ossimGeneralRasterTileSource();
    /**
@@ -180,6 +215,15 @@ protected:
    virtual bool fillBSQ(const ossimIpt& origin, const ossimIpt& size);
    virtual bool fillBsqMultiFile(const ossimIpt& origin, const ossimIpt& size);
 
+   /**
+    * @brief Copies clip_rect of the output bands from m_memoryMaps into
+    * result, swapping bytes if needed.  Const and bufferless so it may run on
+    * several threads at once.
+    * @return true on success, false if the files are shorter than the raster
+    * info says.
+    */
+   bool loadMappedTile(ossimImageData* result, const ossimIrect& clip_rect) const;
+
    virtual ossimKeywordlist getHdrInfo(ossimFilename hdrFile);
    virtual ossimKeywordlist getXmlInfo(ossimFilename xmlFile);
 
@@ -191,11 +235,14 @@ protected:
    ossimInterleaveType                      m_bufferInterleave;
    std::vector<ossimRefPtr<ossimIFStream> > m_fileStrList;
    // std::vector< std::ifstream* >            m_fileStrList;   
+   std::vector<ossimReadAhead*>             m_readAhead; // One per file, for prefetch.
    ossimGeneralRasterInfo                   m_rasterInfo;
    ossimIrect                               m_bufferRect;
    bool                                     m_swapBytesFlag;
    ossim_uint32                             m_bufferSizeInPixels;
    std::vector<ossim_uint32>                m_outputBandList;
+   bool                                     m_memoryMapFlag;
+   std::vector<ossimRefPtr<ossimMemoryMappedFile> > m_memoryMaps; // One per file, if mapped.
 
 private:
    
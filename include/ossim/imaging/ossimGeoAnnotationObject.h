@@ -32,6 +32,16 @@ public:
     */
    virtual void transform(ossimImageGeometry* projection)=0;
 
+   /**
+    * Tolerance, in pixels of the geometry transformed to, to which
+    * line and polygon objects simplify their projected outlines.  Being in
+    * pixels it follows the resolution of the view: at low zoom a long
+    * coastline comes down to the vertices that can be seen.  Set by the
+    * geo_annotation.simplify_tolerance preference, 0 for none.  Default
+    * 0.5.
+    */
+   static double getSimplifyTolerance();
+
    /**
     * Saves the current state of this object.
     */
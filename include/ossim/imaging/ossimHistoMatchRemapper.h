@@ -58,6 +58,14 @@ protected:
    vector<double> theInputMeanPerBand;
    vector<double> theInputSigmaPerBand;
 
+   /**
+    * Output of each 8 bit input value per band, built on first getTile
+    * from the means and sigmas; cleared when they are set.
+    */
+   vector< vector<ossim_uint8> > theLuts;
+
+   void buildLuts(ossim_uint32 numberOfBands);
+
    /**
     * transLean
     * @param vIn input value to be transformed
@@ -2,6 +2,7 @@
 #define ossimHistogramMatchFilter_HEADER
 #include <ossim/imaging/ossimImageSourceFilter.h>
 #include <ossim/imaging/ossimHistogramEqualization.h>
+#include <vector>
 
 /**
  * class ossimHistogramMatchFilter
@@ -19,6 +20,13 @@
  *
  * will be an equalized image without the target applied.
  *
+ * With both histograms set and integer input of at most 65536 values per
+ * band, the equalizers are replaced by a table per band, built once per
+ * res level from the input and target cumulative histograms of that level
+ * (level 0 if the histograms have fewer), mapping each input value to its
+ * matched output.  Tables are shared by all filters matching the same
+ * histogram files, e.g. the clones of a chain.
+ *
  * </pre>
  */ 
 class OSSIM_DLL ossimHistogramMatchFilter : public ossimImageSourceFilter
@@ -162,12 +170,24 @@ protected:
     * 
     */
    void autoLoadInputHistogram();
+
+   /**
+    * @return The tables of resLevel, built or taken from those shared on
+    * first use; NULL if the input or histograms do not allow them.
+    */
+   ossimRefPtr<ossimReferenced> getMatchLut(ossim_uint32 resLevel);
+
+   /** Drops the tables, e.g. when a histogram or the input changes. */
+   void clearMatchLuts();
    
    ossimRefPtr<ossimHistogramEqualization> theInputHistogramEqualizer;
    ossimRefPtr<ossimHistogramEqualization> theTargetHistogramEqualizer;
    ossimFilename theInputHistogramFilename;
    ossimFilename theTargetHistogramFilename;
    bool          theAutoLoadInputHistogramFlag;
+   ossimRefPtr<ossimImageData> theTile;
+   std::vector< ossimRefPtr<ossimReferenced> > theMatchLuts; // per res level
+   std::vector<bool> theMatchLutFlags; // true once tried
 TYPE_DATA   
 };
 #endif
@@ -34,6 +34,8 @@
 
 #include <ossim/imaging/ossimTableRemapper.h>
 #include <ossim/base/ossimMultiResLevelHistogram.h>
+#include <deque>
+#include <map>
 
 
 class OSSIMDLLEXPORT ossimHistogramRemapper : public ossimTableRemapper
@@ -409,6 +411,12 @@ public:
    
    ossimRefPtr<ossimMultiResLevelHistogram> getHistogram();
    ossimRefPtr<const ossimMultiResLevelHistogram> getHistogram()const;
+
+   /**
+    * @brief Shares the histogram of source, see
+    * ossimImageSource::shareReadOnlyState.
+    */
+   virtual void shareReadOnlyState(ossimImageSource* source);
    
    /**
     * Returns pointer to histogram for band and reduced res level.
@@ -560,6 +568,43 @@ private:
       T dummy,
       ossimRefPtr<ossimImageData>& inputTile);
 
+   /** Histogram clip values of a band and the clip points they were found from. */
+   struct ClipValues
+   {
+      const ossimHistogram* theHistogram;
+      ossim_float64 theNormalizedLowClipPoint;
+      ossim_float64 theNormalizedHighClipPoint;
+      ossim_float64 theMinClipValue;
+      ossim_float64 theMaxClipValue;
+   };
+
+   /** Linear stretch a lookup table was made for. */
+   struct StretchKey
+   {
+      bool operator<(const StretchKey& rhs) const;
+
+      ossimScalarType theScalarType;
+      ossim_float64   theMinClipValue;
+      ossim_float64   theMaxClipValue;
+      ossim_float64   theMinPix;
+      ossim_float64   theMaxPix;
+      ossim_float64   theNullPix;
+   };
+
+   /**
+    * Floor of the low and ceil of the high clip value of the band, walked from the histogram
+    * only when its clip points or histogram changed.
+    */
+   void getClipValues(ossim_uint32 band, const ossimHistogram* h,
+                      ossim_float64& minClipValue, ossim_float64& maxClipValue);
+
+   /**
+    * @return Table of the stretched value of every input value of an 8 or 16-bit type, null
+    * mapping to null, indexed by value - numeric_limits<T>::min().  Tables are kept for the
+    * last STRETCH_LUT_CACHE_SIZE stretches so switching between modes does not rebuild them.
+    */
+   template <class T> const T* getStretchLut(const StretchKey& key, ossim_float64 gain);
+
 
    StretchMode                   theStretchMode;
    bool                          theDirtyFlag;
@@ -577,6 +622,10 @@ private:
    bool theBypassFlag;
    bool theResetBandIndicesFlag;
 
+   vector<ClipValues>            theClipValues;
+   std::map<StretchKey, vector<ossim_uint8> > theStretchLuts;
+   std::deque<StretchKey>        theStretchLutOrder;
+
    TYPE_DATA
 };
 
@@ -199,6 +199,17 @@ public:
     */
    virtual bool loadState(const ossimKeywordlist& kwl,
                           const char* prefix=NULL);
+
+   /**
+    * Clones each child with its cloneSource and rewires the copies as the
+    * children are connected, without a keywordlist round trip. Inputs from
+    * outside the chain are left unconnected. Classes derived from this one
+    * that do not override it get the ossimImageSource implementation.
+    */
+   virtual ossimImageSource* cloneSource() const;
+
+   /** Same as cloneSource, falling back on the keywordlist copy. */
+   virtual ossimObject* dup() const;
    
    virtual void initialize();
    virtual void enableSource();
@@ -8,12 +8,16 @@
 // $Id: ossimImageCombiner.h 23108 2015-01-27 17:00:20Z okramer $
 #ifndef ossimImageCombiner_HEADER
 #define ossimImageCombiner_HEADER
+#include <list>
+#include <map>
 #include <vector>
 
 #include <ossim/imaging/ossimImageSource.h>
 #include <ossim/base/ossimConnectableObjectListener.h>
 #include <ossim/base/ossimPropertyEvent.h>
 
+class ossimImageHandler;
+
 /**
  * This will be a base for all combiners.  Combiners take N inputs and
  * will produce a single output.
@@ -88,6 +92,15 @@ public:
                                                    const ossimIrect& tileRect,
                                                    ossim_uint32 resLevel=0);
 
+   /**
+    * Same as getNextTile(returnedIdx, tileRect, resLevel) but skips the inputs not
+    * overlapping neededRect, the part of tileRect a mosaic has still to fill.
+    */
+   virtual ossimRefPtr<ossimImageData> getNextTile(ossim_uint32& returnedIdx,
+                                                   const ossimIrect& tileRect,
+                                                   const ossimIrect& neededRect,
+                                                   ossim_uint32 resLevel=0);
+
    
    virtual bool getNextTile(ossim_uint32& returnedIdx,
                             const ossim_uint32 startIdx,
@@ -102,6 +115,12 @@ public:
    virtual ossimRefPtr<ossimImageData> getNextNormTile(ossim_uint32& returnedIdx,
                                                        const ossimIrect& tileRect,
                                                        ossim_uint32 resLevel=0);
+
+   /** Normalized counterpart of getNextTile(returnedIdx, tileRect, neededRect, resLevel). */
+   virtual ossimRefPtr<ossimImageData> getNextNormTile(ossim_uint32& returnedIdx,
+                                                       const ossimIrect& tileRect,
+                                                       const ossimIrect& neededRect,
+                                                       ossim_uint32 resLevel=0);
    
 /*    virtual ossimRefPtr<ossimImageData> getNextNormTile(ossim_uint32& returnedIdx, */
 /*                                                        ossim_uint32 index, */
@@ -121,11 +140,53 @@ public:
    virtual void refreshEvent(ossimRefreshEvent& event);
    virtual bool hasDifferentInputs()const;
 
+   /**
+    * @brief Limits the number of input image handlers kept open.
+    *
+    * When set, the handler of each input chain is closed in least recently
+    * used order once more than count are open, and opened again the next
+    * time a tile is read from that input.  For mosaics of many files that
+    * would otherwise each hold a file descriptor and decoder state.  The
+    * current entry and output band list of a handler are restored when it
+    * is opened again.  Inputs with no or several image handlers are left
+    * alone.
+    *
+    * @param count Handlers to keep open, 0 (the default) for no limit.
+    */
+   void setMaxOpenHandlers(ossim_uint32 count);
+   ossim_uint32 getMaxOpenHandlers()const;
    
 protected:
    virtual ~ossimImageCombiner();   
    void precomputeBounds()const;
 
+   /**
+    * @brief Indices, in increasing order, of the inputs whose bounds may
+    * intersect rect at resLevel.
+    *
+    * Looked up in the grid index built by precomputeBounds(), so a tile
+    * only tests the inputs near it.  Callers still test the bounds.  The
+    * last lookup is kept, since a tile usually does several.
+    */
+   const std::vector<ossim_uint32>& getCandidateInputs(const ossimIrect& rect,
+                                                      ossim_uint32 resLevel)const;
+
+   /**
+    * Uniform grid over theFullResBounds: each cell is the size of an
+    * average input and lists the inputs overlapping it.
+    */
+   void buildBoundsIndex()const;
+
+   /**
+    * Opens the image handler of input index again if closed and closes the
+    * least recently used ones past theMaxOpenHandlers.  Does nothing with
+    * no limit set.
+    */
+   void openInputHandler(ossim_uint32 index)const;
+
+   /** Finds the image handler of each input for the open handler limit. */
+   void findInputHandlers()const;
+
    ossim_uint32                theLargestNumberOfInputBands;
    ossim_uint32                theInputToPassThrough;
    bool                        theHasDifferentInputs;
@@ -133,6 +194,22 @@ protected:
    mutable std::vector<ossimIrect>     theFullResBounds;
    mutable bool                theComputeFullResBoundsFlag;
    ossim_uint32                theCurrentIndex;
+
+   /** Index grid cell, (row, col) of size theBoundsIndexCellSize pixels. */
+   typedef std::pair<ossim_int32, ossim_int32> IndexKey;
+
+   mutable std::map<IndexKey, std::vector<ossim_uint32> > theBoundsIndex;
+   mutable std::vector<ossim_uint32> theLargeInputs; // Too large for the grid; always tested.
+   mutable ossim_int32               theBoundsIndexCellSize; // 0 if not indexed.
+   mutable ossimIrect                theCandidateRect;
+   mutable ossim_uint32              theCandidateResLevel;
+   mutable std::vector<ossim_uint32> theCandidates;
+
+   ossim_uint32                      theMaxOpenHandlers;
+   mutable std::vector< ossimRefPtr<ossimImageHandler> > theInputHandlers;
+   mutable std::vector<ossim_uint32> theInputEntries;
+   mutable std::vector< std::vector<ossim_uint32> > theInputBands;
+   mutable std::list<ossim_uint32>   theOpenHandlers; // Input indices, most recent at front.
    
 TYPE_DATA  
 };
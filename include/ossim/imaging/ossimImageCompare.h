@@ -0,0 +1,115 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description:
+//
+// Pixel by pixel comparison of two images, e.g. for regression tests
+// of processed outputs.
+//
+//*******************************************************************
+// $Id$
+
+#ifndef ossimImageCompare_HEADER
+#define ossimImageCompare_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimReferenced.h>
+#include <vector>
+
+/**
+ * @brief Compares the full resolution pixels of two images band by band,
+ * after any unpacking and decompression, so the formats may differ.
+ *
+ * Tiles are read and compared in parallel on the job queue. Each job reads
+ * through its own pair of image handlers unless both handlers serve
+ * concurrent reads (see ossimImageHandler::hasConcurrentReads). A band
+ * whose buffers are byte for byte equal is not looked at further; otherwise
+ * the differing samples, the range of b - a and the squared differences are
+ * accumulated (see ossim::diffStats). With setEqualityOnly the jobs stop at
+ * the first difference instead.
+ *
+ * Before decoding, two TIFFs of the same layout, sample format and
+ * compression are compared by their compressed tiles or strips. If every
+ * one matches the images are equal without decoding anything; if not, the
+ * pixels are compared as usual, since equal pixels may compress
+ * differently.
+ */
+class OSSIMDLLEXPORT ossimImageCompare : public ossimReferenced
+{
+public:
+   ossimImageCompare();
+
+   /** @brief Threads to use; 0 (default) for ossim::getNumberOfThreads(). */
+   void setNumberOfThreads(ossim_uint32 threads);
+
+   /**
+    * @brief Stop at the first difference; only isEqual() and
+    * getDifferentTile() are then meaningful. Default false.
+    */
+   void setEqualityOnly(bool flag);
+
+   /** @brief Try the compressed tile comparison first. Default true. */
+   void setRawCompare(bool flag);
+
+   /**
+    * @brief Compares image a to image b.
+    * @return false if either cannot be opened, or they differ in size,
+    * number of bands or scalar type, or a read failed; they are then not
+    * equal.
+    */
+   bool compare(const ossimFilename& a, const ossimFilename& b);
+
+   /** @return true if the last compare() found no difference. */
+   bool isEqual() const;
+
+   /** @return true if the last compare() was settled on compressed tiles. */
+   bool usedRawCompare() const;
+
+   /**
+    * @return Lowest index, in ossimImageSourceSequencer order, of the tiles
+    * found different, or -1 if none. With setEqualityOnly, tiles past the
+    * first difference found may not have been compared.
+    */
+   ossim_int64 getDifferentTile() const;
+
+   ossim_uint32 getNumberOfBands() const;
+
+   /** @return Samples compared per band. */
+   ossim_uint64 getNumberOfSamples() const;
+
+   /** @brief Per band results of the last compare(), b - a. */
+   ossim_uint64  getDifferentSamples(ossim_uint32 band) const;
+   ossim_float64 getMinDifference(ossim_uint32 band) const;
+   ossim_float64 getMaxDifference(ossim_uint32 band) const;
+   ossim_float64 getRmsDifference(ossim_uint32 band) const;
+
+   /** @brief Differences of one band, as accumulated by the jobs. */
+   struct BandStats
+   {
+      BandStats();
+      void merge(const BandStats& rhs);
+
+      ossim_uint64  m_differ;
+      ossim_float64 m_minDiff;
+      ossim_float64 m_maxDiff;
+      ossim_float64 m_sumSquares;
+   };
+
+protected:
+   virtual ~ossimImageCompare();
+
+   ossim_uint32            m_numberOfThreads;
+   bool                    m_equalityOnly;
+   bool                    m_rawCompare;
+
+   // Results of the last compare():
+   bool                    m_equal;
+   bool                    m_usedRawCompare;
+   ossim_int64             m_differentTile;
+   ossim_uint64            m_samples;
+   std::vector<BandStats>  m_bands;
+};
+
+#endif /* #ifndef ossimImageCompare_HEADER */
@@ -21,6 +21,7 @@
 #include <ossim/base/ossimIrect.h>
 #include <ossim/base/ossimIpt.h>
 #include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimReferenced.h>
 
 class ossimMultiBandHistogram;
 
@@ -122,11 +123,36 @@ public:
 
    /**
     * @brief assignment operator=
+    *
+    * Like the copy constructor, this shares the buffer of rhs until either
+    * tile writes to it; see isBufferShared().
     * @param rhs The data to assign from.
     * @param A reference to this object.
     */
    virtual const ossimImageData& operator=(const ossimImageData &rhs);
 
+   /**
+    * @return true if the buffer is shared with copies of this tile.
+    *
+    * Copies (copy constructor, operator=, assign, dup) reference the buffer of
+    * the source tile instead of copying it. The non-const getBuf() methods copy
+    * it on first use, so writes to a tile never show in the others, while
+    * const reads do not copy. As for validate(), a tile must not be copied
+    * while another thread uses it, and a pointer from getBuf() obtained before
+    * the tile was copied must not be written through afterwards.
+    */
+   bool isBufferShared() const;
+
+   /**
+    * @brief Puts the buffer in the shared form that copies reference.
+    *
+    * Copying does this on the source tile. A cache calls it on a tile it
+    * holds, under its lock, so the copies later made from several threads
+    * only change the reference count. Const as the content does not change.
+    * @return *this.
+    */
+   const ossimImageData& shareBuffer() const;
+
 
    /**
     * @return The width of the data object.
@@ -276,8 +302,43 @@ public:
    void setNull(const ossimIpt& pt, ossim_uint32 band);
    
    virtual bool   isValidBand(ossim_uint32 band) const;
+
+   /**
+    * @brief Scans the buffer and sets the status to OSSIM_EMPTY, OSSIM_PARTIAL or OSSIM_FULL.
+    *
+    * The result is cached; later calls return it without a scan until the data is changed
+    * through this class or a non-const buffer accessor.
+    *
+    * @return The status of the tile.
+    */
    virtual ossimDataObjectStatus validate() const;
 
+   /**
+    * @brief Sets the status for a tile whose content the caller already knows, e.g. a handler
+    * that just read a block with no null pixels, so validate() does not have to scan it.
+    *
+    * Only OSSIM_FULL and OSSIM_EMPTY are cached; other values are set as with
+    * setDataObjectStatus.
+    */
+   void setValidatedStatus(ossimDataObjectStatus status) const;
+
+   /**
+    * @brief Discards the status cached by validate().
+    *
+    * Needed only when writing through a buffer pointer obtained before the last validate()
+    * call, so the next validate() rescans.
+    */
+   void invalidateStatus() const;
+
+   /**
+    * @return true if the status is current with the buffer, as set by validate() or
+    * setValidatedStatus(), so a tile copied from this one may take it over.
+    */
+   bool isStatusCached() const;
+
+   /** @brief Sets the status.  This discards any status cached by validate(). */
+   virtual void setDataObjectStatus(ossimDataObjectStatus status) const;
+
    /**
     * Will take this tile and normalize it to a newly
     * allocated floating point tile.
@@ -1209,8 +1270,47 @@ protected:
     */
    mutable ossim_float64 m_percentFull;
 
+   /** true if status and m_percentFull are current with the buffer. See validate(). */
+   mutable bool m_statusCached;
+
+   /** @return Bytes in the buffer, whether owned or shared. */
+   ossim_uint32 getBufferSizeInBytes() const;
+
 private:
 
+   /** Buffer referenced by copies of a tile until one of them writes. */
+   class SharedBuffer : public ossimReferenced
+   {
+   public:
+      std::vector<ossim_uint8> m_buffer;
+   };
+
+   /**
+    * Makes m_dataBuffer the buffer again before a write. The shared buffer is
+    * taken back if this is its last reference, else copied, or only
+    * allocated when keepContents is false.
+    */
+   void unshareBuffer(bool keepContents);
+
+   /** References the buffer of rhs, dropping the one of this tile. */
+   void referenceBuffer(const ossimImageData& rhs);
+
+   /**
+    * Reports the change of the buffer size since the last call to
+    * ossimImageDataAccounting.  Called wherever m_dataBuffer may be allocated
+    * or freed.
+    */
+   void updateAccounting();
+
+   /** Buffer bytes last reported to ossimImageDataAccounting. */
+   ossim_uint64 m_accountedBytes;
+
+   /** ossimImageDataAccounting account charged with m_accountedBytes. */
+   ossim_uint32 m_account;
+
+   /** The buffer while shared, with m_dataBuffer empty; else null. */
+   mutable ossimRefPtr<SharedBuffer> m_sharedBuffer;
+
    
 TYPE_DATA
 };
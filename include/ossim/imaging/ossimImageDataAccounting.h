@@ -0,0 +1,92 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Accounting of the bytes held by ossimImageData buffers.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimImageDataAccounting_HEADER
+#define ossimImageDataAccounting_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <OpenThreads/Mutex>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+class ossimSource;
+
+//*************************************************************************************************
+//! Counts the live bytes of ossimImageData buffers, in total and per owner class, with their
+//! high-water marks.
+//!
+//! Every ossimImageData reports the size of its buffer here when it allocates, copies, resizes
+//! or frees it. The bytes are charged to the class of the tile's owner at the time of its first
+//! allocation (e.g. "ossimImageRenderer" for its tiles and temporary buffer), or to "unowned".
+//! Buffers held by ossimTilePool for reuse are not live; see ossimTilePool::getStatistics().
+//!
+//! An optional soft budget caps the bytes the sequencers let build up: while the live bytes are
+//! over it, ossimImageSourceSequencer's pipeline and ossimMultiThreadSequencer stop fetching
+//! ahead and keep a single tile in flight. Nothing ever fails for being over budget.
+//!
+//! Preferences keywords:
+//!    image_data.memory_budget:  Soft budget in megabytes (default 0, no budget)
+//*************************************************************************************************
+class OSSIM_DLL ossimImageDataAccounting
+{
+public:
+   //! Counters of one owner class, or of all. Peaks are since the last resetPeaks().
+   struct Statistics
+   {
+      Statistics();
+      ossim_uint64 m_liveBytes;   //!< Bytes of the buffers allocated now.
+      ossim_uint64 m_peakBytes;   //!< High-water mark of m_liveBytes.
+      ossim_uint64 m_buffers;     //!< Buffers allocated now.
+      ossim_uint64 m_allocations; //!< Buffers allocated or resized so far.
+   };
+
+   static ossimImageDataAccounting* instance();
+
+   //! @return Account of the owner's class for update(); 0 is the "unowned" account.
+   ossim_uint32 getAccount(const ossimSource* owner);
+
+   //! Moves a buffer of the account from oldBytes to newBytes, either of which may be 0.
+   void update(ossim_uint32 account, ossim_uint64 oldBytes, ossim_uint64 newBytes);
+
+   Statistics getStatistics() const;
+
+   //! Counters per owner class name.
+   void getStatistics(std::map<std::string, Statistics>& stats) const;
+
+   //! Sets the peaks to the current live bytes.
+   void resetPeaks();
+
+   //! Sets the soft budget in bytes, 0 for none.
+   void setBudget(ossim_uint64 bytes);
+   ossim_uint64 getBudget() const { return m_budget; }
+
+   //! @return true if there is a budget and the live bytes exceed it.
+   bool isOverBudget() const;
+
+   std::ostream& print(std::ostream& out) const;
+
+protected:
+   ossimImageDataAccounting();
+   ossimImageDataAccounting(const ossimImageDataAccounting&);
+   const ossimImageDataAccounting& operator=(const ossimImageDataAccounting&);
+
+   static ossimImageDataAccounting* m_instance;
+
+   mutable OpenThreads::Mutex          m_mutex;
+   Statistics                          m_total;
+   std::vector<Statistics>             m_accounts;
+   std::vector<std::string>            m_accountNames;
+   std::map<std::string, ossim_uint32> m_accountOfClass;
+   ossim_uint64                        m_budget;
+   volatile bool                       m_overBudget; //!< Kept by update() for lock-free checks.
+};
+
+#endif /* #ifndef ossimImageDataAccounting_HEADER */
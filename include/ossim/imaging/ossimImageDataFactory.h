@@ -24,6 +24,11 @@ class ossimImageSource;
 /*!
  * This factory should be called by all image source producers to allocate
  * an image tile.
+ *
+ * Note that tile buffers are recycled through ossimTilePool: the buffer of
+ * a tile whose last reference is released is reused by the next
+ * ossimImageData::initialize() of the same scalar type, band count and
+ * dimensions.
  */
 class OSSIM_DLL ossimImageDataFactory
 {
@@ -0,0 +1,548 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Vectorized pixel kernels for the ossimImageData load/unload and normalization
+// paths. Each kernel has SSE2/SSSE3/AVX2 code selected at runtime (see ossimSimd.h) and a scalar
+// fallback giving identical results.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimImageDataKernels_HEADER
+#define ossimImageDataKernels_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <cstring>
+
+namespace ossim
+{
+   //---
+   // Normalization:
+   //
+   // d[i] = 0                                         if s[i] == nullPix
+   //        OSSIM_DEFAULT_MIN_PIX_NORM_(FLOAT|DOUBLE)  if s[i] == minPix
+   //        (s[i] - minPix) / (maxPix - minPix)        otherwise
+   //
+   // Arithmetic is done in double precision, as in the original ossimImageData loops.
+   //---
+   OSSIM_DLL void normalize(const ossim_uint8* s, ossim_float32* d, ossim_uint32 count,
+                            ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix);
+   OSSIM_DLL void normalize(const ossim_uint16* s, ossim_float32* d, ossim_uint32 count,
+                            ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix);
+   OSSIM_DLL void normalize(const ossim_sint16* s, ossim_float32* d, ossim_uint32 count,
+                            ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix);
+   OSSIM_DLL void normalize(const ossim_float32* s, ossim_float32* d, ossim_uint32 count,
+                            ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix);
+   OSSIM_DLL void normalize(const ossim_uint8* s, ossim_float64* d, ossim_uint32 count,
+                            ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix);
+   OSSIM_DLL void normalize(const ossim_uint16* s, ossim_float64* d, ossim_uint32 count,
+                            ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix);
+   OSSIM_DLL void normalize(const ossim_sint16* s, ossim_float64* d, ossim_uint32 count,
+                            ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix);
+   OSSIM_DLL void normalize(const ossim_float32* s, ossim_float64* d, ossim_uint32 count,
+                            ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix);
+
+   /** @brief Scalar normalization for the remaining pixel types. */
+   template <class S, class D>
+   inline void normalize(const S* s, D* d, ossim_uint32 count,
+                         ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix)
+   {
+      const ossim_float64 RANGE = maxPix - minPix;
+      const D MIN_NORM = (sizeof(D) == sizeof(ossim_float32)) ?
+         (D)OSSIM_DEFAULT_MIN_PIX_NORM_FLOAT : (D)OSSIM_DEFAULT_MIN_PIX_NORM_DOUBLE;
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         const ossim_float64 p = s[i];
+         d[i] = (p == nullPix) ? (D)0 : ( (p == minPix) ? MIN_NORM : (D)((p - minPix) / RANGE) );
+      }
+   }
+
+   //---
+   // Unnormalization:
+   //
+   // d[i] = nullPix                                   if s[i] == 0
+   //        minPix + (maxPix - minPix) * s[i]          otherwise, capped at maxPix if clampFlag
+   //---
+   OSSIM_DLL void unnormalize(const ossim_float32* s, ossim_uint8* d, ossim_uint32 count,
+                              ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix,
+                              bool clampFlag);
+   OSSIM_DLL void unnormalize(const ossim_float32* s, ossim_uint16* d, ossim_uint32 count,
+                              ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix,
+                              bool clampFlag);
+   OSSIM_DLL void unnormalize(const ossim_float32* s, ossim_sint16* d, ossim_uint32 count,
+                              ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix,
+                              bool clampFlag);
+   OSSIM_DLL void unnormalize(const ossim_float32* s, ossim_float32* d, ossim_uint32 count,
+                              ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix,
+                              bool clampFlag);
+   OSSIM_DLL void unnormalize(const ossim_float64* s, ossim_uint8* d, ossim_uint32 count,
+                              ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix,
+                              bool clampFlag);
+   OSSIM_DLL void unnormalize(const ossim_float64* s, ossim_uint16* d, ossim_uint32 count,
+                              ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix,
+                              bool clampFlag);
+   OSSIM_DLL void unnormalize(const ossim_float64* s, ossim_sint16* d, ossim_uint32 count,
+                              ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix,
+                              bool clampFlag);
+   OSSIM_DLL void unnormalize(const ossim_float64* s, ossim_float32* d, ossim_uint32 count,
+                              ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix,
+                              bool clampFlag);
+
+   /** @brief Scalar unnormalization for the remaining pixel types. */
+   template <class S, class D>
+   inline void unnormalize(const S* s, D* d, ossim_uint32 count,
+                           ossim_float64 minPix, ossim_float64 maxPix, ossim_float64 nullPix,
+                           bool clampFlag)
+   {
+      const ossim_float64 RANGE = maxPix - minPix;
+      const D NP = (D)nullPix;
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         const ossim_float64 P = s[i];
+         ossim_float64 v = minPix + RANGE * P;
+         if ( clampFlag && (v > maxPix) ) v = maxPix;
+         d[i] = (P != 0.0) ? (D)v : NP;
+      }
+   }
+
+   //---
+   // Remapping between pixel types:
+   //
+   // n    = normalize(s[i]) with inMin, inMax, inNull, in double precision
+   // d[i] = outNull                                   if n == 0
+   //        outMin + (outMax - outMin) * n             otherwise, clamped to [outMin, outMax]
+   //
+   // The normalize then unnormalize round trip of ossimScalarRemapper in one pass without the
+   // intermediate buffer. Clamping only changes samples outside [inMin, inMax], which the
+   // round trip wrapped or saturated.
+   //---
+   OSSIM_DLL void remap(const ossim_uint8* s, ossim_uint8* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+   OSSIM_DLL void remap(const ossim_uint8* s, ossim_uint16* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+   OSSIM_DLL void remap(const ossim_uint8* s, ossim_sint16* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+   OSSIM_DLL void remap(const ossim_uint8* s, ossim_float32* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+   OSSIM_DLL void remap(const ossim_uint16* s, ossim_uint8* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+   OSSIM_DLL void remap(const ossim_uint16* s, ossim_uint16* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+   OSSIM_DLL void remap(const ossim_uint16* s, ossim_sint16* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+   OSSIM_DLL void remap(const ossim_uint16* s, ossim_float32* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+   OSSIM_DLL void remap(const ossim_sint16* s, ossim_uint8* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+   OSSIM_DLL void remap(const ossim_sint16* s, ossim_uint16* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+   OSSIM_DLL void remap(const ossim_sint16* s, ossim_sint16* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+   OSSIM_DLL void remap(const ossim_sint16* s, ossim_float32* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+   OSSIM_DLL void remap(const ossim_float32* s, ossim_uint8* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+   OSSIM_DLL void remap(const ossim_float32* s, ossim_uint16* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+   OSSIM_DLL void remap(const ossim_float32* s, ossim_sint16* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+   OSSIM_DLL void remap(const ossim_float32* s, ossim_float32* d, ossim_uint32 count,
+                        ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                        ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull);
+
+   /** @brief Scalar remapping for the remaining pixel types. */
+   template <class S, class D>
+   inline void remap(const S* s, D* d, ossim_uint32 count,
+                     ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                     ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull)
+   {
+      const ossim_float64 IN_RANGE  = inMax - inMin;
+      const ossim_float64 OUT_RANGE = outMax - outMin;
+      const D NP = (D)outNull;
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         const ossim_float64 p = s[i];
+         const ossim_float64 n = (p == inNull) ? 0.0 :
+            ( (p == inMin) ? OSSIM_DEFAULT_MIN_PIX_NORM_DOUBLE : (p - inMin) / IN_RANGE );
+         ossim_float64 v = outMin + OUT_RANGE * n;
+         if (v > outMax) v = outMax;
+         if (v < outMin) v = outMin;
+         d[i] = (n != 0.0) ? (D)v : NP;
+      }
+   }
+
+   //---
+   // Casting between pixel types:
+   //
+   // d[i] = outNull                                   if nullFlag && s[i] == inNull
+   //        s[i] clamped to [outMin, outMax]           otherwise
+   //
+   // As ossimCastTileSourceFilter; outMin, outMax and outNull are values of the output type,
+   // inNull a value of the input type.
+   //---
+   OSSIM_DLL void castClamp(const ossim_uint8* s, ossim_uint8* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+   OSSIM_DLL void castClamp(const ossim_uint8* s, ossim_uint16* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+   OSSIM_DLL void castClamp(const ossim_uint8* s, ossim_sint16* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+   OSSIM_DLL void castClamp(const ossim_uint8* s, ossim_float32* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+   OSSIM_DLL void castClamp(const ossim_uint16* s, ossim_uint8* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+   OSSIM_DLL void castClamp(const ossim_uint16* s, ossim_uint16* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+   OSSIM_DLL void castClamp(const ossim_uint16* s, ossim_sint16* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+   OSSIM_DLL void castClamp(const ossim_uint16* s, ossim_float32* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+   OSSIM_DLL void castClamp(const ossim_sint16* s, ossim_uint8* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+   OSSIM_DLL void castClamp(const ossim_sint16* s, ossim_uint16* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+   OSSIM_DLL void castClamp(const ossim_sint16* s, ossim_sint16* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+   OSSIM_DLL void castClamp(const ossim_sint16* s, ossim_float32* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+   OSSIM_DLL void castClamp(const ossim_float32* s, ossim_uint8* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+   OSSIM_DLL void castClamp(const ossim_float32* s, ossim_uint16* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+   OSSIM_DLL void castClamp(const ossim_float32* s, ossim_sint16* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+   OSSIM_DLL void castClamp(const ossim_float32* s, ossim_float32* d, ossim_uint32 count,
+                            ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                            ossim_float64 inNull, ossim_float64 outNull);
+
+   /** @brief Scalar cast for the remaining pixel types. */
+   template <class S, class D>
+   inline void castClamp(const S* s, D* d, ossim_uint32 count,
+                         ossim_float64 outMin, ossim_float64 outMax, bool nullFlag,
+                         ossim_float64 inNull, ossim_float64 outNull)
+   {
+      const D NP = (D)outNull;
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         if ( nullFlag && (s[i] == (S)inNull) )
+         {
+            d[i] = NP;
+         }
+         else
+         {
+            ossim_float64 v = s[i];
+            if (v < outMin) v = outMin;
+            if (v > outMax) v = outMax;
+            d[i] = (D)v;
+         }
+      }
+   }
+
+   //---
+   // Null counting:
+   //
+   // Returns the number of samples in s[0, count) equal to nullPix.  Used by
+   // ossimImageData::validate() to classify a tile in one pass over its buffer.  Float compares
+   // are ordered, so a NaN null value matches nothing, as with operator==.
+   //---
+   OSSIM_DLL ossim_uint32 countNull(const ossim_uint8* s, ossim_uint32 count,
+                                    ossim_uint8 nullPix);
+   OSSIM_DLL ossim_uint32 countNull(const ossim_uint16* s, ossim_uint32 count,
+                                    ossim_uint16 nullPix);
+   OSSIM_DLL ossim_uint32 countNull(const ossim_sint16* s, ossim_uint32 count,
+                                    ossim_sint16 nullPix);
+   OSSIM_DLL ossim_uint32 countNull(const ossim_float32* s, ossim_uint32 count,
+                                    ossim_float32 nullPix);
+
+   /** @brief Scalar null counting for the remaining pixel types. */
+   template <class T>
+   inline ossim_uint32 countNull(const T* s, ossim_uint32 count, T nullPix)
+   {
+      ossim_uint32 result = 0;
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         result += (s[i] == nullPix) ? 1 : 0;
+      }
+      return result;
+   }
+
+   //---
+   // Valid range, the loop of ossimImageData::computeMinMaxPix:
+   //
+   // for each s[i] != nullPix, in order:
+   //    if (s[i] < minPix) minPix = s[i];  else if (s[i] > maxPix) maxPix = s[i];
+   //
+   // A sample lowering minPix is not tried against maxPix. Once maxPix >= minPix that no longer
+   // matters, so from then on the vector code reduces blocks of samples in any order. Float NaNs
+   // change nothing; signed zeros compare equal and either may be kept.
+   //---
+   OSSIM_DLL void minMax(const ossim_uint8* s, ossim_uint32 count, ossim_uint8 nullPix,
+                         ossim_float64& minPix, ossim_float64& maxPix);
+   OSSIM_DLL void minMax(const ossim_uint16* s, ossim_uint32 count, ossim_uint16 nullPix,
+                         ossim_float64& minPix, ossim_float64& maxPix);
+   OSSIM_DLL void minMax(const ossim_sint16* s, ossim_uint32 count, ossim_sint16 nullPix,
+                         ossim_float64& minPix, ossim_float64& maxPix);
+   OSSIM_DLL void minMax(const ossim_float32* s, ossim_uint32 count, ossim_float32 nullPix,
+                         ossim_float64& minPix, ossim_float64& maxPix);
+
+   /** @brief Scalar valid range for the remaining pixel types. */
+   template <class T>
+   inline void minMax(const T* s, ossim_uint32 count, T nullPix,
+                      ossim_float64& minPix, ossim_float64& maxPix)
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         const T p = s[i];
+         if (p != nullPix)
+         {
+            if (p < minPix)
+            {
+               minPix = p;
+            }
+            else if (p > maxPix)
+            {
+               maxPix = p;
+            }
+         }
+      }
+   }
+
+   //---
+   // Null and valid range, the loop of ossimImageData::computeMinMaxNulPix:
+   //
+   // for each s[i] != skipPix, in order:
+   //    if (s[i] < nulPix) nulPix = s[i];
+   //    if ( (s[i] < minPix) && (s[i] > nulPix) ) minPix = s[i];  else if (s[i] > maxPix) ...
+   //
+   // As minMax, blocks are reduced in any order once nulPix <= minPix <= maxPix, except blocks
+   // holding a sample under nulPix, which are taken in order.
+   //---
+   OSSIM_DLL void minMaxNul(const ossim_uint8* s, ossim_uint32 count, ossim_uint8 skipPix,
+                            ossim_float64& minPix, ossim_float64& maxPix,
+                            ossim_float64& nulPix);
+   OSSIM_DLL void minMaxNul(const ossim_uint16* s, ossim_uint32 count, ossim_uint16 skipPix,
+                            ossim_float64& minPix, ossim_float64& maxPix,
+                            ossim_float64& nulPix);
+   OSSIM_DLL void minMaxNul(const ossim_sint16* s, ossim_uint32 count, ossim_sint16 skipPix,
+                            ossim_float64& minPix, ossim_float64& maxPix,
+                            ossim_float64& nulPix);
+   OSSIM_DLL void minMaxNul(const ossim_float32* s, ossim_uint32 count, ossim_float32 skipPix,
+                            ossim_float64& minPix, ossim_float64& maxPix,
+                            ossim_float64& nulPix);
+
+   /** @brief Scalar null and valid range for the remaining pixel types. */
+   template <class T>
+   inline void minMaxNul(const T* s, ossim_uint32 count, T skipPix,
+                         ossim_float64& minPix, ossim_float64& maxPix, ossim_float64& nulPix)
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         const T p = s[i];
+         if (p != skipPix)
+         {
+            // Null first as min depends on it.
+            if (p < nulPix)
+            {
+               nulPix = p;
+            }
+            if ( (p < minPix) && (p > nulPix) )
+            {
+               minPix = p;
+            }
+            else if (p > maxPix)
+            {
+               maxPix = p;
+            }
+         }
+      }
+   }
+
+   //---
+   // Unit bin counting:
+   //
+   // bins[s[i] - first] += 1            for each s[i] in [first, first + binCount)
+   //
+   // For a histogram of unit-width bins starting at first (see ossimHistogram::GetUnitBinRange).
+   // Up to 4096 bins (8 and 11 bit data) are counted in four interleaved banks, so runs of equal
+   // samples do not wait on one counter, and blocks that a vector min/max finds inside the range
+   // skip the per-sample range test. Wider ranges count each run of equal samples at once.
+   //---
+   OSSIM_DLL void countUnitBins(const ossim_uint8* s, ossim_uint32 count, ossim_int64 first,
+                                ossim_uint32 binCount, ossim_uint64* bins);
+   OSSIM_DLL void countUnitBins(const ossim_uint16* s, ossim_uint32 count, ossim_int64 first,
+                                ossim_uint32 binCount, ossim_uint64* bins);
+   OSSIM_DLL void countUnitBins(const ossim_sint16* s, ossim_uint32 count, ossim_int64 first,
+                                ossim_uint32 binCount, ossim_uint64* bins);
+
+   /** @brief Scalar unit bin counting for the remaining integer pixel types. */
+   template <class T>
+   inline void countUnitBins(const T* s, ossim_uint32 count, ossim_int64 first,
+                             ossim_uint32 binCount, ossim_uint64* bins)
+   {
+      const ossim_int64 LAST = first + binCount - 1;
+      ossim_uint32 i = 0;
+      while (i < count)
+      {
+         const T value = s[i];
+         ossim_uint32 end = i + 1;
+         while ( (end < count) && (s[end] == value) )
+         {
+            ++end;
+         }
+         if ( (value >= first) && (value <= LAST) )
+         {
+            bins[value - first] += end - i;
+         }
+         i = end;
+      }
+   }
+
+   //---
+   // Histogram bin indexes, as ossimHistogram::GetIndex:
+   //
+   // index[i] = (ossim_int32)((s[i] - vmin) / delta)  if vmin <= s[i] <= vmax and that is < bins
+   //            negative                              otherwise
+   //
+   // In single precision on every path. NaN samples are out of range.
+   //---
+   OSSIM_DLL void binIndex(const ossim_float32* s, ossim_uint32 count, ossim_float32 vmin,
+                           ossim_float32 vmax, ossim_float32 delta, ossim_int32 bins,
+                           ossim_int32* index);
+
+   //---
+   // Weighted accumulation:
+   //
+   // d[i] += weight * s[i]
+   //
+   // Inner loop of the separable resampler (see ossimFilterResampler), one call per kernel tap.
+   // The multiply and add are rounded separately (no fused multiply-add) on every path.
+   //---
+   OSSIM_DLL void addWeighted(const ossim_float64* s, ossim_float64* d, ossim_uint32 count,
+                              ossim_float64 weight);
+
+   //---
+   // Equal weight blend:
+   //
+   // d[i] = d[i]                   if valid && !valid[i]
+   //        s[i]                   if d[i] == nullPix
+   //        (d[i] + s[i]) / 2      otherwise, rounded toward zero
+   //
+   // This is (d*w + s*w)/(w + w) cast back to the pixel type, i.e. ossimBlendMosaic with equal
+   // weights, computed in the native type. valid may be null to blend every sample.
+   //---
+   OSSIM_DLL void blendEqual(const ossim_uint8* s, ossim_uint8* d, ossim_uint32 count,
+                             ossim_uint8 nullPix, const ossim_uint8* valid);
+   OSSIM_DLL void blendEqual(const ossim_uint16* s, ossim_uint16* d, ossim_uint32 count,
+                             ossim_uint16 nullPix, const ossim_uint8* valid);
+
+   /** @brief Scalar equal weight blend for the remaining integer pixel types. */
+   template <class T>
+   inline void blendEqual(const T* s, T* d, ossim_uint32 count, T nullPix,
+                          const ossim_uint8* valid)
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         if ( !valid || valid[i] )
+         {
+            d[i] = (d[i] != nullPix) ?
+               static_cast<T>( (static_cast<ossim_sint64>(d[i]) + s[i]) / 2 ) : s[i];
+         }
+      }
+   }
+
+   //---
+   // Difference statistics of two runs of samples, d = b[i] - a[i] taken exactly:
+   //
+   // for each i:  if (d != 0) ++differ;  minDiff = min(minDiff, d);  maxDiff = max(maxDiff, d);
+   //              sumSquares += d * d
+   //
+   // Float samples that are NaN on both sides are equal and left out of the range and sums; a
+   // NaN on one side counts as different only. Integer squares are summed exactly, so the vector
+   // and scalar code agree while sumSquares stays below 2^53.
+   //---
+   OSSIM_DLL void diffStats(const ossim_uint8* a, const ossim_uint8* b, ossim_uint32 count,
+                            ossim_uint64& differ, ossim_float64& minDiff,
+                            ossim_float64& maxDiff, ossim_float64& sumSquares);
+   OSSIM_DLL void diffStats(const ossim_uint16* a, const ossim_uint16* b, ossim_uint32 count,
+                            ossim_uint64& differ, ossim_float64& minDiff,
+                            ossim_float64& maxDiff, ossim_float64& sumSquares);
+   OSSIM_DLL void diffStats(const ossim_sint16* a, const ossim_sint16* b, ossim_uint32 count,
+                            ossim_uint64& differ, ossim_float64& minDiff,
+                            ossim_float64& maxDiff, ossim_float64& sumSquares);
+
+   /** @brief Scalar difference statistics for the remaining pixel types. */
+   template <class T>
+   inline void diffStats(const T* a, const T* b, ossim_uint32 count, ossim_uint64& differ,
+                         ossim_float64& minDiff, ossim_float64& maxDiff,
+                         ossim_float64& sumSquares)
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         const T A = a[i];
+         const T B = b[i];
+         if ( (A != B) && ( (A == A) || (B == B) ) ) // Not both NaN.
+         {
+            ++differ;
+         }
+         const ossim_float64 d = static_cast<ossim_float64>(B) - static_cast<ossim_float64>(A);
+         if (d == d)
+         {
+            if (d < minDiff)
+            {
+               minDiff = d;
+            }
+            if (d > maxDiff)
+            {
+               maxDiff = d;
+            }
+            sumSquares += d * d;
+         }
+      }
+   }
+
+   //---
+   // Interleave conversions for one line of pixels:
+   //
+   // bipToBands:  src holds count pixels of interleaved bands; band b is written to dest[b].
+   // bandsToBip:  src[b] holds count samples of band b; dest receives interleaved pixels.
+   //
+   // elementSize is the scalar size in bytes (1, 2, 4 or 8).
+   //---
+   OSSIM_DLL void bipToBands(const void* src, void* const* dest, ossim_uint32 elementSize,
+                             ossim_uint32 bands, ossim_uint32 count);
+   OSSIM_DLL void bandsToBip(const void* const* src, void* dest, ossim_uint32 elementSize,
+                             ossim_uint32 bands, ossim_uint32 count);
+
+} // End: namespace ossim
+
+#endif /* #ifndef ossimImageDataKernels_HEADER */
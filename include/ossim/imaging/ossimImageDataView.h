@@ -0,0 +1,167 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Typed view of an ossimImageData tile for inner loops, and a scalar type dispatch
+// that instantiates a kernel once per pixel type.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimImageDataView_HEADER
+#define ossimImageDataView_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimIpt.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <vector>
+
+namespace ossim
+{
+   /** @brief Strips const from a pixel type, for the null values of a const view. */
+   template <class T> struct ViewPixel           { typedef T type; };
+   template <class T> struct ViewPixel<const T>  { typedef T type; };
+}
+
+/**
+ * @brief Band pointers, strides and nulls of a tile as plain members, so that inner loops do
+ * not go through the virtual ossimImageData accessors.
+ *
+ * T is the pixel type, const for a read only view. With BANDS non-zero the band count is a
+ * compile time constant for loops over bands; the tile must then have that many bands, else the
+ * view is invalid.
+ *
+ * A read only view is made from a const tile so that a shared buffer is not copied (see
+ * ossimImageData::isBufferShared); a writable view calls getBuf() once. The view is valid until
+ * the tile is resized or reinitialized.
+ *
+ * @code
+ * const ossimImageData* in = inputTile.get();
+ * ossimImageDataView<const ossim_uint16> src(in);
+ * ossimImageDataView<ossim_uint16>       dst(outputTile.get());
+ * for (ossim_uint32 b = 0; b < src.getNumberOfBands(); ++b)
+ *    for (ossim_uint32 y = 0; y < src.m_height; ++y)
+ *    {
+ *       const ossim_uint16* s = src.line(b, y);
+ *       ...
+ *    }
+ * @endcode
+ */
+template <class T, ossim_uint32 BANDS = 0>
+class ossimImageDataView
+{
+public:
+   typedef typename ossim::ViewPixel<T>::type PixelType;
+
+   /** @brief Writable view; T may be const. */
+   explicit ossimImageDataView(ossimImageData* tile)
+   {
+      init(tile, tile ? static_cast<T*>(tile->getBuf()) : 0);
+   }
+
+   /** @brief Read only view; T must be const. */
+   explicit ossimImageDataView(const ossimImageData* tile)
+   {
+      init(tile, tile ? static_cast<T*>(tile->getBuf()) : 0);
+   }
+
+   /** @return false if the tile is null, has no buffer or not BANDS bands. */
+   bool valid() const { return m_base != 0; }
+
+   ossim_uint32 getNumberOfBands() const { return BANDS ? BANDS : m_bands; }
+
+   /** @brief First pixel of band. */
+   T* band(ossim_uint32 b) const { return m_base + b * m_bandStride; }
+
+   /** @brief First pixel of line y (tile relative) of band. */
+   T* line(ossim_uint32 b, ossim_uint32 y) const { return band(b) + y * m_lineStride; }
+
+   /** @brief Pixel at image point pt of band; pt must be inside the tile. */
+   T& pixel(ossim_uint32 b, const ossimIpt& pt) const
+   {
+      return band(b)[(pt.y - m_origin.y) * m_lineStride + (pt.x - m_origin.x)];
+   }
+
+   bool isNull(ossim_uint32 b, PixelType p) const { return p == m_null[b]; }
+
+   T*                      m_base;       //!< Band 0, pixel (0, 0); null if invalid.
+   ossim_uint32            m_bands;
+   ossim_uint32            m_width;
+   ossim_uint32            m_height;
+   ossim_uint32            m_lineStride; //!< Pixels from a line to the next.
+   ossim_uint32            m_bandStride; //!< Pixels from a band to the next.
+   ossimIpt                m_origin;     //!< Image point of pixel (0, 0).
+   std::vector<PixelType>  m_null;       //!< Null of each band, in T.
+
+private:
+   void init(const ossimImageData* tile, T* base)
+   {
+      m_base       = 0;
+      m_bands      = tile ? tile->getNumberOfBands() : 0;
+      m_width      = tile ? tile->getWidth() : 0;
+      m_height     = tile ? tile->getHeight() : 0;
+      m_lineStride = m_width;
+      m_bandStride = m_width * m_height;
+      m_origin     = tile ? tile->getOrigin() : ossimIpt(0, 0);
+      if ( base && ( (BANDS == 0) || (m_bands == BANDS) ) )
+      {
+         m_base = base;
+         m_null.resize(m_bands);
+         for (ossim_uint32 b = 0; b < m_bands; ++b)
+         {
+            m_null[b] = static_cast<PixelType>( tile->getNullPix(b) );
+         }
+      }
+   }
+};
+
+namespace ossim
+{
+   /**
+    * @brief Calls kernel(T(0)) with the pixel type T of scalar, as the dummy argument
+    * dispatches of ossimImageData do; kernel has a template <class T> void operator()(T).
+    *
+    * Each kernel is so instantiated once per pixel type, and the view and loops inside it are
+    * fully typed.
+    * @return false if scalar is unknown; the kernel is not called.
+    */
+   template <class Kernel>
+   bool dispatchScalarType(ossimScalarType scalar, Kernel& kernel)
+   {
+      switch (scalar)
+      {
+         case OSSIM_UINT8:
+            kernel(ossim_uint8(0));
+            return true;
+         case OSSIM_SINT8:
+            kernel(ossim_sint8(0));
+            return true;
+         case OSSIM_UINT16:
+         case OSSIM_USHORT11:
+            kernel(ossim_uint16(0));
+            return true;
+         case OSSIM_SINT16:
+            kernel(ossim_sint16(0));
+            return true;
+         case OSSIM_UINT32:
+            kernel(ossim_uint32(0));
+            return true;
+         case OSSIM_SINT32:
+            kernel(ossim_sint32(0));
+            return true;
+         case OSSIM_FLOAT32:
+         case OSSIM_NORMALIZED_FLOAT:
+            kernel(ossim_float32(0));
+            return true;
+         case OSSIM_FLOAT64:
+         case OSSIM_NORMALIZED_DOUBLE:
+            kernel(ossim_float64(0));
+            return true;
+         default:
+            break;
+      }
+      return false;
+   }
+}
+
+#endif /* #ifndef ossimImageDataView_HEADER */
@@ -432,6 +432,16 @@ public:
     * "area".
     */
    virtual void getPixelTypeString(ossimString& type) const;
+
+   /**
+    * @brief Sets the number of tiles computed ahead, on a thread of the
+    * sequencer's, while execute writes the previous ones (see
+    * ossimImageSourceSequencer::setPipelineTiles).  0 computes and writes in
+    * turn.  Default comes from the preferences keyword
+    * "writer.pipeline_tiles", 0 if not set.
+    */
+   void setPipelineTiles(ossim_uint32 count);
+   ossim_uint32 getPipelineTiles() const;
    
 protected:
 
@@ -492,6 +502,9 @@ protected:
 
    /** OSSIM_PIXEL_IS_POINT = 0, OSSIM_PIXEL_IS_AREA  = 1 */
    ossimPixelType             thePixelType;
+
+   /** Tiles computed ahead of the write, 0 for none. */
+   ossim_uint32               thePipelineTiles;
    
 TYPE_DATA
 };
@@ -22,6 +22,11 @@
  *   true  : any NODATA pixels in the convolution will Nullify the center pixel
  *   false : center pixel will be NODATA only if it was NODATA before 
  *     other NODATA pixels are processed as zero in the convolution calculation
+ * -Recursive selects a recursive (Young - van Vliet) gaussian for GaussStd >= 2.5:
+ *   cost per pixel does not depend on GaussStd, which suits large blurs. Each tile is
+ *   filtered from its input grown by 4*GaussStd on each side, in double precision;
+ *   the impulse response is within a few percent of the gaussian peak. Smaller
+ *   GaussStd use the kernel filters, which are cheap there (default false)
  */
 class OSSIM_DLL ossimImageGaussianFilter : public ossimImageSourceFilter
 {
@@ -37,6 +42,9 @@ public:
    inline bool isStrictNoData()const { return theStrictNoData; }
    void setStrictNoData(bool aStrict);
 
+   inline bool isRecursive()const { return theRecursiveFlag; }
+   void setRecursive(bool flag);
+
   /** 
    * inherited methods
    */
@@ -62,11 +70,38 @@ protected:
    void initializeProcesses();
    void updateKernels();
 
+   /** @return true if getTile() uses the recursive filter. */
+   bool useRecursive()const;
+
+   ossimRefPtr<ossimImageData> getRecursiveTile(const ossimIrect& tileRect,
+                                                ossim_uint32 resLevel);
+   
+   template <class T>
+   void recursiveFilter(T dummy, const ossimImageData* input);
+
+   /**
+    * Runs the recursive filter forward then backward along the lines of data, which holds
+    * numberOfLines lines of width samples, each sample filtered with the samples at the same
+    * position in the other lines.
+    */
+   void recursiveLines(double* data, long numberOfLines, long width)const;
+
   /**
    * parameters
    */
    ossim_float64 theGaussStd;
    bool          theStrictNoData;
+   bool          theRecursiveFlag;
+
+   /**
+    * recursive filter state
+    */
+   double theRecursiveB;      // gain
+   double theRecursiveA[3];   // feedback b1/b0, b2/b0, b3/b0
+   ossimRefPtr<ossimImageData> theTile;
+   std::vector<double>       theBuffer;
+   std::vector<double>       theTransposeBuffer;
+   std::vector<ossim_uint32> theNullCount;
 
   /**
    * subprocesses
@@ -133,6 +133,13 @@ public:
    //!
    void worldToRn(const ossimGpt& wpt, ossim_uint32 resolutionLevel, ossimDpt& rnPt) const;
 
+   //! rnToWorld and worldToRn for count points, through the batch localToWorld and
+   //! worldToLocal.
+   void rnToWorld(const ossimDpt* rnPts, ossim_uint32 resolutionLevel, ossimGpt* wpts,
+                  ossim_uint32 count) const;
+   void worldToRn(const ossimGpt* wpts, ossim_uint32 resolutionLevel, ossimDpt* rnPts,
+                  ossim_uint32 count) const;
+
    //! Exposes the 3D projection from image to world coordinates. The caller should verify that
    //! a valid projection exists before calling this method. Returns TRUE if a valid ground point
    //! is available in the ground_pt argument. This method depends on the existence of elevation
@@ -140,6 +147,17 @@ public:
    bool localToWorld(const ossimDpt& local_pt, ossimGpt& world_pt) const;
    bool localToWorld(const ossimDrect& local_rect, ossimGrect& world_rect) const;
 
+   //! localToWorld for count points through ossimProjection::lineSampleToWorlds, so sensor
+   //! models start each DEM intersection from the previous solution. Pass points in scanline
+   //! order for the best convergence.
+   bool localToWorld(const ossimDpt* local_pts, ossimGpt* world_pts, ossim_uint32 count) const;
+
+   //! localToWorld for a regular grid of local points. Point (row, col) is
+   //! (origin.x + col*step.x, origin.y + row*step.y) and goes to world_pts[row*width + col], so
+   //! the batch runs in scanline order.
+   bool localToWorld(const ossimDpt& origin, const ossimDpt& step,
+                     ossim_uint32 width, ossim_uint32 height, ossimGpt* world_pts) const;
+
    //! Exposes the 3D projection from image to world coordinates given a constant height above 
    //! ellipsoid. The caller should verify that a valid projection exists before calling this
    //! method. Returns TRUE if a valid ground point is available in the ground_pt argument.
@@ -151,12 +169,38 @@ public:
    bool worldToLocal(const ossimGpt& world_pt, ossimDpt& local_pt) const;
    bool worldToLocal(const ossimGrect& world_rect, ossimDrect& local_rect) const;
 
+   //! worldToLocal for count points, through ossimProjection::worldToLineSamples so projections
+   //! with a batch form (e.g. ossimRpcModel) evaluate them together. Missing heights are
+   //! looked up in one ossimElevManager call.
+   bool worldToLocal(const ossimGpt* world_pts, ossimDpt* local_pts, ossim_uint32 count) const;
+
+   //! worldToLocal for a regular grid of ground points on the datum and at the height of
+   //! origin. Point (row, col) is (origin.lat + row*spacing.y, origin.lon + col*spacing.x),
+   //! spacing in decimal degrees, and goes to local_pts[row*width + col].
+   bool worldToLocal(const ossimGpt& origin, const ossimDpt& spacing,
+                     ossim_uint32 width, ossim_uint32 height, ossimDpt* local_pts) const;
+
    //! Sets the transform to be used for local-to-full-image coordinate transformation
    void setTransform(ossim2dTo2dTransform* transform);
 
    //! Sets the projection to be used for local-to-world coordinate transformation
    void setProjection(ossimProjection* projection);
 
+   /**
+    * @brief Replaces an expensive rigorous projection by an ossimCoarseGridModel fitted to it.
+    *
+    * Does nothing unless the "image_geometry.coarse_grid.enabled" preference is true and the
+    * projection class is listed in "image_geometry.coarse_grid.models". The grid is built over
+    * the full image (the image size must be set) to within "image_geometry.coarse_grid.error"
+    * pixels, in parallel (see ossimCoarseGridModel::setBuildThreads). If
+    * "image_geometry.coarse_grid.directory" is set the grid is kept there, named by a hash of
+    * the model state, the elevation setup, the image size and the error, and reloaded instead
+    * of rebuilt on later opens.
+    *
+    * @return true if the projection was replaced.
+    */
+   bool applyCoarseGridApproximation();
+
    //! Access methods for transform (may be NULL pointer).
    const ossim2dTo2dTransform* getTransform() const { return m_transform.get(); }
    ossim2dTo2dTransform*       getTransform()       { return m_transform.get(); }
@@ -0,0 +1,68 @@
+//*******************************************************************
+//
+// License:  LGPL
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description: Store of image geometries shared by handlers and processes.
+//
+//********************************************************************
+#ifndef ossimImageGeometryCache_HEADER
+#define ossimImageGeometryCache_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimFilename.h>
+#include <OpenThreads/Mutex>
+
+class ossimImageGeometry;
+
+/**
+ * Directory of saved image geometries, so the geometry of an image built
+ * from its support data (nitf RPC/RSM tags, DIMAP or DigitalGlobe xml,
+ * GeoTIFF tie point grids...) is built once and then loaded by any handler
+ * or process opening the image again.
+ *
+ * A geometry is kept in a keyword list file named after the image path and
+ * entry, along with the size and modification time of the image.  A stale
+ * file is ignored and written again.
+ *
+ * Opt in: ossimImageGeometryRegistry uses it when the preference
+ * image_geometry.cache_directory is set, e.g.
+ *
+ *    image_geometry.cache_directory: $(HOME)/.ossim/geometry_cache
+ */
+class OSSIMDLLEXPORT ossimImageGeometryCache
+{
+public:
+   static ossimImageGeometryCache* instance();
+
+   /** @return true if a directory is set. */
+   bool isEnabled() const;
+
+   /**
+    * @brief Loads the geometry saved for entry of file.
+    * @param geom Initialized on success.
+    * @return true if a current geometry was found.
+    */
+   bool load(const ossimFilename& file, ossim_uint32 entry, ossimImageGeometry& geom) const;
+
+   /** @brief Saves geom for entry of file; failures are only traced. */
+   void save(const ossimFilename& file, ossim_uint32 entry,
+             const ossimImageGeometry& geom) const;
+
+   /** Sets the directory; empty turns the cache off. */
+   void setDirectory(const ossimFilename& dir);
+
+   ossimFilename getDirectory() const;
+
+protected:
+   ossimImageGeometryCache();
+
+   /** @return Geometry file for entry of file, in m_directory. */
+   ossimFilename getCacheFile(const ossimFilename& file, ossim_uint32 entry) const;
+
+   mutable OpenThreads::Mutex m_mutex;
+   ossimFilename              m_directory;
+};
+
+#endif /* #ifndef ossimImageGeometryCache_HEADER */
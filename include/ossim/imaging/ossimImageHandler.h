@@ -19,6 +19,7 @@
 #include <ossim/imaging/ossimImageSource.h>
 #include <ossim/base/ossimConstants.h>
 #include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimIoCounters.h>
 #include <ossim/base/ossimIrect.h>
 #include <ossim/base/ossimNBandLutDataObject.h>
 #include <ossim/base/ossimRefPtr.h>
@@ -97,6 +98,39 @@ public:
     */
    virtual bool hasOverviews() const;
 
+   /**
+    * @brief Indicates whether getTile(ossimImageData*, resLevel) may be called
+    * from several threads at once on this handler, each with its own tile.
+    * Used by ossimImageHandlerMtAdaptor to skip its lock.
+    * @return false by default.
+    */
+   virtual bool hasConcurrentReads() const;
+
+   /**
+    * @brief Hint that the tiles covering rects, in image space at resLevel,
+    * will be requested soon and in that order.  Called by the sequencers a
+    * few tiles ahead of getTile.
+    *
+    * Handlers that can start reading the data in the background (see
+    * ossimReadAhead).  Must not change the result of any getTile and must be
+    * safe to call while other threads are reading tiles.
+    *
+    * This implementation forwards to the overview for the levels it serves
+    * and otherwise does nothing.
+    */
+   virtual void prefetch(const std::vector<ossimIrect>& rects,
+                         ossim_uint32 resLevel=0);
+
+   /**
+    * @brief Adds the bytes read, reads, seeks and read time of the files of
+    * this handler to values, for comparing with the bytes of the tiles it
+    * returned.
+    *
+    * This implementation adds the counts of the overview, if any.
+    * @return true if anything was counted.
+    */
+   virtual bool getIoCounters(ossimIoCounters::Values& values) const;
+
    /**
     *  @return ossimFilename represents an external OSSIM overview filename.
     */
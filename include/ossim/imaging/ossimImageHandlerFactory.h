@@ -62,6 +62,14 @@ public:
     * name must be unique.
     */
    virtual void getTypeNameList(std::vector<ossimString>& typeList)const;
+   /**
+    * @return OPEN_SCORE_MAGIC for TIFF, JPEG and NITF headers, else the
+    * extension based score of the base class.
+    */
+   virtual OpenScore getOpenScore(const ossimFilename& file,
+                                  const char* header,
+                                  ossim_uint32 headerSize)const;
+
    virtual void getSupportedExtensions(ossimImageHandlerFactoryBase::UniqueStringList& extensionList)const;
    virtual void getImageHandlersBySuffix(ossimImageHandlerFactoryBase::ImageHandlerList& result, const ossimString& ext)const;
    virtual void getImageHandlersByMimeType(ossimImageHandlerFactoryBase::ImageHandlerList& result, const ossimString& mimeType)const;
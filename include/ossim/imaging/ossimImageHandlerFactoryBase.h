@@ -58,6 +58,18 @@ public:
    
    typedef UniqueList<ossimString> UniqueStringList;
    typedef std::vector<ossimRefPtr<ossimImageHandler> > ImageHandlerList;
+
+   /** How likely open(filename) is to succeed, see getOpenScore. */
+   enum OpenScore
+   {
+      OPEN_SCORE_NONE      = 0, // Cannot open; open is not called.
+      OPEN_SCORE_UNKNOWN   = 1, // May open; tried after the likely ones.
+      OPEN_SCORE_EXTENSION = 2, // Extension is supported.
+      OPEN_SCORE_MAGIC     = 3  // Header has a supported signature.
+   };
+
+   /** Bytes of the file header passed to getOpenScore, at most. */
+   static const ossim_uint32 OPEN_SCORE_HEADER_SIZE = 4096;
    
    virtual ossimImageHandler* open(const ossimFilename& fileName,
                                    bool openOverview=true)const = 0;
@@ -96,6 +108,26 @@ public:
    virtual ossimRefPtr<ossimImageHandler> openOverview(
       const ossimFilename& file ) const;
 
+   /**
+    * @brief Cheap test of whether open(file) may succeed, made by
+    * ossimImageHandlerRegistry::open before opening anything.  Must not open
+    * the file or create handlers.
+    *
+    * @param file File to be opened.
+    *
+    * @param header First bytes of file, null if it is not a regular file,
+    * e.g. a directory or a URL.
+    *
+    * @param headerSize Bytes in header, up to OPEN_SCORE_HEADER_SIZE.
+    *
+    * @return This default implementation returns OPEN_SCORE_EXTENSION if
+    * getSupportedExtensions has the extension of file, OPEN_SCORE_UNKNOWN
+    * otherwise.  Factories that can rule files out should override.
+    */
+   virtual OpenScore getOpenScore(const ossimFilename& file,
+                                  const char* header,
+                                  ossim_uint32 headerSize)const;
+
    virtual void getImageHandlersBySuffix(ImageHandlerList& result,
                                          const ossimString& ext)const;
 
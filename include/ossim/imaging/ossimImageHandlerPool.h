@@ -0,0 +1,122 @@
+//*******************************************************************
+//
+// License:  LGPL
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description: Pool of image handlers reused across chains.
+//
+//********************************************************************
+#ifndef ossimImageHandlerPool_HEADER
+#define ossimImageHandlerPool_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <OpenThreads/Mutex>
+#include <list>
+#include <vector>
+
+class ossimImageHandler;
+
+/**
+ * Image handlers kept open after their users let them go, so chains built
+ * again for the same files (e.g. per request in a tile server, or per input
+ * of a large mosaic) reuse them instead of opening and parsing the files
+ * again.
+ *
+ * Handlers are keyed by file, entry and open overview flag.  A handler is
+ * released by dropping its last reference outside the pool; there is no
+ * release call.  At most getMaxOpenHandlers() are open: past that the least
+ * recently acquired idle handler is closed, and opened again with its own
+ * open() on its next acquire, skipping the factory probing of the registry.
+ * Handlers in use are never closed, so the count can go over the cap while
+ * that many are held.
+ *
+ * Opt in: the pool is off, and acquire simply opens, unless the preference
+ * image_handler_pool.max_open_handlers is set, e.g.
+ *
+ *    image_handler_pool.max_open_handlers: 256
+ */
+class OSSIMDLLEXPORT ossimImageHandlerPool
+{
+public:
+   enum Mode
+   {
+      /** Handler no one else holds; the caller may read tiles from any thread. */
+      EXCLUSIVE = 0,
+      /**
+       * Handler possibly held by other SHARED users, e.g. for geometry and
+       * metadata.  Callers reading tiles from several threads must lock.
+       */
+      SHARED    = 1
+   };
+
+   static ossimImageHandlerPool* instance();
+
+   /** @return true if the pool keeps handlers, i.e. the cap is not 0. */
+   bool isEnabled() const;
+
+   /**
+    * @brief Handler for entry of file, with its current entry set and the
+    * output band list it had when first opened.
+    *
+    * Callers should not change the settings of a SHARED handler; those of
+    * an EXCLUSIVE one other than the entry and band list stay with the
+    * handler after it is released.
+    *
+    * @return Handler or null if file cannot be opened.
+    */
+   ossimRefPtr<ossimImageHandler> acquire(const ossimFilename& file,
+                                          ossim_uint32 entry=0,
+                                          bool openOverview=true,
+                                          Mode mode=EXCLUSIVE);
+
+   /** Sets the open handler cap; 0 turns the pool off and drops idle handlers. */
+   void setMaxOpenHandlers(ossim_uint32 count);
+
+   ossim_uint32 getMaxOpenHandlers() const;
+
+   /** @return Handlers in the pool that are open, in use or idle. */
+   ossim_uint32 getNumberOfOpenHandlers() const;
+
+   /** Drops the idle handlers of file, e.g. after it was written again. */
+   void remove(const ossimFilename& file);
+
+   /** Drops all idle handlers. */
+   void clear();
+
+protected:
+   ossimImageHandlerPool();
+
+   struct Slot
+   {
+      ossimFilename                  m_file;
+      ossim_uint32                   m_entry;
+      bool                           m_openOverview;
+      ossimRefPtr<ossimImageHandler> m_handler;
+      std::vector<ossim_uint32>      m_bands;     // Band list when first opened.
+      bool                           m_open;      // Kept here, as users may be reading.
+      bool                           m_exclusive; // Held EXCLUSIVE or being opened.
+      ossim_uint64                   m_lastUsed;
+   };
+
+   /** @return true if no one but the pool holds the handler of slot. */
+   static bool isIdle(const Slot& slot);
+
+   /** Sets the entry and band list of an idle handler handed out again. */
+   static void restore(Slot& slot);
+
+   /** Closes idle handlers past the cap, least recently used first; call locked. */
+   void trim();
+
+   /** Drops idle handlers of file, all if file is empty; call locked. */
+   void removeIdle(const ossimFilename& file);
+
+   mutable OpenThreads::Mutex m_mutex;
+   ossim_uint32               m_maxOpenHandlers;
+   ossim_uint64               m_clock;
+   std::list<Slot>            m_slots;
+};
+
+#endif /* #ifndef ossimImageHandlerPool_HEADER */
@@ -16,6 +16,7 @@
 #include <ossim/base/ossimObjectFactory.h>
 #include <ossim/base/ossimRtti.h>
 #include <ossim/imaging/ossimImageHandlerFactoryBase.h>
+#include <ossim/imaging/ossimImageHandlerPool.h>
 #include <ossim/base/ossimFactoryListInterface.h>
 #include <iosfwd>
 #include <vector>
@@ -45,6 +46,23 @@ public:
    virtual ossimImageHandler* open(const ossimFilename& fileName,
                                    bool trySuffixFirst=true,
                                    bool openOverview=true)const;
+
+   /**
+    * @brief Open through ossimImageHandlerPool, so a handler let go by
+    * another chain is reused instead of opening the file again.  Same as
+    * open followed by setCurrentEntry when the pool is off.
+    * @param fileName File to open.
+    * @param entry Entry to set.
+    * @param openOverview If true image handler will attempt to open overview.
+    * @param mode EXCLUSIVE for a handler no one else holds, SHARED for one
+    * other SHARED users may hold.
+    * @return Handler or null if cannot open.
+    */
+   ossimRefPtr<ossimImageHandler> openPooled(
+      const ossimFilename& fileName,
+      ossim_uint32 entry=0,
+      bool openOverview=true,
+      ossimImageHandlerPool::Mode mode=ossimImageHandlerPool::EXCLUSIVE)const;
    
    /**
     *  Given a keyword list return a pointer to an ImageHandler.  Returns
@@ -14,6 +14,11 @@
 #include <ossim/base/ossimConnectableObjectListener.h>
 #include <ossim/base/ossimObjectEvents.h>
 #include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimFilename.h>
+#include <vector>
+
+class ossimImageHandler;
+class ossimImageSourceSequencer;
 
 /*!
  * This source expects as input an ossimImageSource.
@@ -64,6 +69,38 @@ public:
 
    ossimHistogramMode getComputationMode()const;
    void setComputationMode(ossimHistogramMode mode);
+
+   /**
+    * Sets the number of threads reading and counting tiles in normal mode.
+    * Each thread fills its own histogram, added to the others once all
+    * tiles are read, so the result is that of a single thread.  Used only
+    * when the input is an image handler with concurrent reads (see
+    * ossimImageHandler::hasConcurrentReads).  0 is
+    * ossim::getNumberOfThreads(); the default, 1, reads in the calling
+    * thread.  Keyword "number_of_threads" in loadState.
+    */
+   void setNumberOfThreads(ossim_uint32 threads);
+   ossim_uint32 getNumberOfThreads()const;
+
+   /**
+    * Sets a file keeping the full resolution normal mode histogram of each
+    * block of 8 x 8 tiles, so that a later execute with an update rect
+    * recounts only the blocks it touches.  Used when computing a single
+    * res level.  An empty name, the default, keeps no blocks.
+    */
+   void setBlockHistogramFile(const ossimFilename& file);
+   const ossimFilename& getBlockHistogramFile()const;
+
+   /**
+    * Sets the region changed since the block file was written.  The next
+    * execute subtracts the old counts of the blocks intersecting it, adds
+    * their new counts and leaves the other blocks as read from the file.
+    * Falls back to counting all tiles if the block file is missing, was
+    * interrupted or is for another area, tile size or bins.  Cleared by
+    * the execute; a NaN rect counts all tiles.
+    */
+   void setUpdateRect(const ossimIrect& rect);
+   const ossimIrect& getUpdateRect()const;
 	
    virtual void propertyEvent(ossimPropertyEvent& event);
    
@@ -83,6 +120,36 @@ protected:
                           ossim_uint32 band)const;
    virtual void computeNormalModeHistogram();
    virtual void computeFastModeHistogram();
+
+   /**
+    * Counts the full resolution tiles of the sequencer's area of interest
+    * block by block into theHistogram, keeping the blocks in
+    * theBlockHistogramFile.
+    */
+   void computeBlockHistogram(ossimImageHandler* handler,
+                              ossimImageSourceSequencer* sequencer,
+                              ossim_uint32 numberOfThreads,
+                              ossim_uint32 numberOfBands,
+                              ossim_uint32 numberOfBins,
+                              ossim_float64 minValue,
+                              ossim_float64 maxValue);
+
+   /**
+    * Counts the tiles of tileIds, or of the sequencer's area of interest if
+    * NULL, at resLevel into histo on numberOfThreads threads reading from
+    * handler.
+    */
+   void computeTilesMt(ossimImageHandler* handler,
+                       ossimImageSourceSequencer* sequencer,
+                       const std::vector<ossim_int64>* tileIds,
+                       ossim_uint32 resLevel,
+                       ossimMultiBandHistogram* histo,
+                       ossim_uint32 numberOfThreads,
+                       ossim_uint32 numberOfBins,
+                       ossim_float64 minValue,
+                       ossim_float64 maxValue,
+                       double& tileCount,
+                       double totalTiles);
    
    /*!
     * Initialized to ossimNAN'S
@@ -100,6 +167,9 @@ protected:
    ossim_int32        theNumberOfBinsOverride;
    ossimHistogramMode theComputationMode;
    ossim_uint32       theNumberOfTilesToUseInFastMode;
+   ossim_uint32       theNumberOfThreads;
+   ossimFilename      theBlockHistogramFile;
+   ossimIrect         theUpdateRect;
 TYPE_DATA
 };
 
@@ -0,0 +1,141 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+//*******************************************************************
+#ifndef ossimImageMomentsSource_HEADER
+#define ossimImageMomentsSource_HEADER 1
+
+#include <ossim/base/ossimSource.h>
+#include <ossim/base/ossimTDigest.h>
+#include <vector>
+
+class ossimImageData;
+class ossimKeywordlist;
+
+/**
+ * Accumulates per band count, mean, variance, min, max and quantiles, and
+ * the covariance between bands, of the valid pixels of the tiles added.
+ * Each tile's moments are taken about its own mean, then merged into the
+ * totals (Chan et al.), so accumulators filled by different threads merge
+ * into the statistics of all their tiles.  The covariance is over the
+ * pixels valid in every band.  Quantiles of 8 and 16 bit integer data are
+ * exact, from a count of every value; those of other types are estimated
+ * by a t-digest.
+ */
+class OSSIMDLLEXPORT ossimImageMoments
+{
+public:
+   ossimImageMoments(ossim_uint32 numberOfBands = 0,
+                     ossim_float64 compression = 100.0);
+
+   /** Adds the valid pixels of tile's first getNumberOfBands bands. */
+   void addTile(const ossimImageData* tile);
+
+   /** Adds the pixels of moments, which must have as many bands. */
+   void merge(const ossimImageMoments& moments);
+
+   ossim_uint32 getNumberOfBands()const;
+
+   /** @return Number of valid pixels of band. */
+   ossim_float64 getCount(ossim_uint32 band)const;
+
+   /** @return Mean of band; nan if no valid pixel. */
+   ossim_float64 getMean(ossim_uint32 band)const;
+
+   /** @return Sample (n - 1) variance of band; nan if under two pixels. */
+   ossim_float64 getVariance(ossim_uint32 band)const;
+   ossim_float64 getStdDev(ossim_uint32 band)const;
+
+   ossim_float64 getMin(ossim_uint32 band)const;
+   ossim_float64 getMax(ossim_uint32 band)const;
+
+   /**
+    * @return Sample covariance of band1 and band2 over the pixels valid in
+    * all bands; nan if under two such pixels.
+    */
+   ossim_float64 getCovariance(ossim_uint32 band1, ossim_uint32 band2)const;
+
+   /** @return Number of pixels valid in all bands. */
+   ossim_float64 getCovarianceCount()const;
+
+   /**
+    * @return Value of quantile q, 0 to 1, of band, interpolated between
+    * ranks; nan if no valid pixel.
+    */
+   ossim_float64 getQuantile(ossim_uint32 band, ossim_float64 q)const;
+
+private:
+   template <class T> void addTileTemplate(const ossimImageData* tile, T dummy);
+
+   /** @return Value of rank index of the counts of band. */
+   ossim_float64 getCountedValue(ossim_uint32 band, ossim_float64 index)const;
+
+   ossim_uint32                 theNumberOfBands;
+   ossim_float64                theCompression;
+   std::vector<ossim_float64>   theCount;
+   std::vector<ossim_float64>   theMean;
+   std::vector<ossim_float64>   theM2;
+   std::vector<ossim_float64>   theMin;
+   std::vector<ossim_float64>   theMax;
+   ossim_float64                theCoCount;
+   std::vector<ossim_float64>   theCoMean;
+   std::vector<ossim_float64>   theCoMoment; // bands x bands, row major
+
+   /** Counts of each value, offset by theCountOffset, of 8/16 bit data. */
+   std::vector< std::vector<ossim_uint64> > theValueCounts;
+   ossim_int32                  theCountOffset;
+   std::vector<ossimTDigest>    theDigests;
+   std::vector<char>            theValidPixels;
+};
+
+/**
+ * Computes the ossimImageMoments of its input in a single pass over its
+ * tiles.  If the input is an image handler with concurrent reads (see
+ * ossimImageHandler::hasConcurrentReads), tiles are read and accumulated
+ * on several threads and the accumulators merged once all tiles are read.
+ */
+class OSSIMDLLEXPORT ossimImageMomentsSource : public ossimSource
+{
+public:
+   ossimImageMomentsSource();
+
+   virtual void computeStatistics();
+
+   virtual bool canConnectMyInputTo(ossim_int32 inputIndex,
+                                    const ossimConnectableObject* object)const;
+
+   /** @return The statistics of the last computeStatistics. */
+   const ossimImageMoments& getMoments()const;
+
+   /**
+    * Sets the number of threads, 0 being ossim::getNumberOfThreads().
+    * Default 1, the calling thread.
+    */
+   void setNumberOfThreads(ossim_uint32 threads);
+   ossim_uint32 getNumberOfThreads()const;
+
+   /** Reads the input at resLevel, 0 (full resolution) by default. */
+   void setResLevel(ossim_uint32 resLevel);
+   ossim_uint32 getResLevel()const;
+
+   /** Sets the t-digest compression (see ossimTDigest), default 200. */
+   void setCompression(ossim_float64 compression);
+   ossim_float64 getCompression()const;
+
+   /**
+    * Adds the statistics of each band under prefix, e.g.
+    * "band1.mean", "band1.percentile_50", and "covariance.band1.band2".
+    */
+   void saveStatistics(ossimKeywordlist& kwl, const char* prefix=0)const;
+
+protected:
+   virtual ~ossimImageMomentsSource();
+
+   ossimImageMoments theMoments;
+   ossim_uint32      theNumberOfThreads;
+   ossim_uint32      theResLevel;
+   ossim_float64     theCompression;
+};
+
+#endif /* #ifndef ossimImageMomentsSource_HEADER */
@@ -22,6 +22,10 @@ using namespace std;
  * just do a simple mosaic.  It just checks NULL pix values until it finds a
  * pixel that is not empty and copies it out to the output.  The list will
  * have same size tiles and have the same number of bands.
+ *
+ * Inputs are requested in priority order.  A per-pixel coverage map of the output tile
+ * tracks what is still null, so inputs missing the still-uncovered part are skipped and
+ * none are requested once every pixel is filled.
  */
 class OSSIMDLLEXPORT ossimImageMosaic : public ossimImageCombiner
 {
@@ -58,6 +62,17 @@ protected:
    
    ossimRefPtr<ossimImageData> theTile;
 
+   /** 1 for each pixel of theTile non-null in every band. */
+   std::vector<ossim_uint8> theCoverage;
+
+   /**
+    * Marks in theCoverage the pixels of neededRect now filled in every band, then shrinks
+    * neededRect to the bounds of the pixels still to fill.
+    * @return The number of pixels still to fill.
+    */
+   template <class T> ossim_uint32 updateCoverage(T, // dummy template variable not used
+                                                  ossimIrect& neededRect);
+
    template <class T> ossimRefPtr<ossimImageData> combine(
       T, // dummy template variable not used
       const ossimIrect& tileRect,
@@ -18,10 +18,13 @@
 #include <ossim/base/ossimPolyArea2d.h>
 #include <ossim/base/ossimViewInterface.h>
 #include <ossim/base/ossimRationalNumber.h>
+#include <map>
 
 class ossimImageData;
 class ossimDiscreteConvolutionKernel;
 class ossimFilterResampler;
+class ossimJob;
+class ossimJobMultiThreadQueue;
 
 class OSSIMDLLEXPORT ossimImageRenderer : public ossimImageSourceFilter,
                                           public ossimViewInterface
@@ -78,6 +81,10 @@ public:
    virtual bool loadState(const ossimKeywordlist& kwl,
                           const char* prefix=0);
 
+   //! Copies the settings and resampler filters; a projection transform is copied with its
+   //! image and view geometries shared, see ossimImageSource::cloneSource.
+   virtual ossimImageSource* cloneSource() const;
+
    void setImageViewTransform(ossimImageViewTransform* transform);
    ossimImageViewTransform* getImageViewTransform() { return m_ImageViewTransform.get(); }
 
@@ -85,6 +92,9 @@ public:
    //! This is only valid if the IVT is a projection type IVT (IVPT) 
    virtual ossimRefPtr<ossimImageGeometry> getImageGeometry();
 
+   //! Shares the image and view geometries of source, see ossimImageSource::shareReadOnlyState.
+   virtual void shareReadOnlyState(ossimImageSource* source);
+
    virtual bool setView(ossimObject* baseObject);
    ossimFilterResampler* getResampler() { return m_Resampler; }
    virtual ossimObject* getView();
@@ -112,6 +122,18 @@ public:
 
    void setMaxLevelsToCompute(ossim_uint32 maxLevels);
    ossim_uint32 getMaxLevelsToCompute()const;
+
+   /**
+    * @brief Sets the number of threads resampling the sub rectangles of one output tile.
+    *
+    * With more than one thread, getTile still walks the sub rectangles and reads their input
+    * on the calling thread, then resamples them concurrently into disjoint areas of the output
+    * tile.  This lowers the latency of single large requests, e.g. a chip, where a
+    * multi-threaded sequencer does not help.  Default is 1 (serial), or the preferences keyword
+    * "renderer.resample_threads"; also keyword "resample_threads" in loadState.
+    */
+   void setNumberOfResampleThreads(ossim_uint32 threads);
+   ossim_uint32 getNumberOfResampleThreads()const;
    
    void connectInputEvent(ossimConnectionEvent& event);
    void disconnectInputEvent(ossimConnectionEvent& event);
@@ -153,6 +175,57 @@ protected:
    virtual ~ossimImageRenderer();
 
 private:
+
+   /**
+    * View to image point cache used by the sub rect recursion in place of direct
+    * ossimImageViewTransform::viewToImage calls.
+    *
+    * The view is covered by square cells of 64, 32, 16 and 8 pixels.  A cell interpolates
+    * bilinearly between its corners when the exact transform at its edge mid points and center
+    * is within tolerance of the interpolated value; otherwise the point is looked up in the next
+    * finer cell, and points in cells that fail at 8 pixels go to the transform.  Cells are
+    * built lazily as tiles are requested and kept until the view or geometry changes (see
+    * initializeBoundingRects), so roaming or re-requesting tiles does not re-project the same
+    * corner points.
+    *
+    * The tolerance is in image pixels, scaled up for cells that minify, and comes from the
+    * preferences keyword "renderer.transform_grid_tolerance" (default 0.1, 0 disables the grid).
+    */
+   class ossimRendererTransformGrid
+   {
+   public:
+      ossimRendererTransformGrid();
+
+      /** @brief Drops all cells and sets the transform they are built from. */
+      void reset(ossimImageViewTransform* transform);
+
+      const ossimImageViewTransform* getTransform()const { return m_transform.get(); }
+
+      void viewToImage(const ossimDpt& viewPt, ossimDpt& imagePt)const;
+
+   private:
+      enum
+      {
+         LEVELS    = 4,
+         MAX_CELLS = 32768
+      };
+
+      struct Cell
+      {
+         ossimDpt m_ul;
+         ossimDpt m_ur;
+         ossimDpt m_lr;
+         ossimDpt m_ll;
+         bool     m_linear;
+      };
+
+      const Cell& getCell(ossim_uint32 level, ossim_int32 x, ossim_int32 y)const;
+
+      ossimRefPtr<ossimImageViewTransform> m_transform;
+      ossim_float64                        m_tolerance;
+      mutable std::map<ossim_int64, Cell>  m_cells[LEVELS];
+      mutable ossim_uint32                 m_cellCount;
+   };
    
    class ossimRendererSubRectInfo
    {
@@ -258,8 +331,12 @@ private:
 
       mutable ossimRefPtr<ossimImageViewTransform> m_transform;
       mutable const ossimPolyArea2d* m_viewBounds;
+      mutable const ossimRendererTransformGrid* m_grid;
 
     private:
+      /** @brief m_grid->viewToImage if set, m_transform->viewToImage if not. */
+      void viewToImage(const ossimDpt& viewPt, ossimDpt& imagePt)const;
+
       void splitHorizontal(std::vector<ossimRendererSubRectInfo>& result)const;
       void splitVertical(std::vector<ossimRendererSubRectInfo>& result)const;
       void splitAll(std::vector<ossimRendererSubRectInfo>& result)const;
@@ -272,6 +349,9 @@ private:
 
    void fillTile(ossimRefPtr<ossimImageData> outputData,
                  const ossimRendererSubRectInfo& rectInfo);
+
+   /** @brief Runs the resamples queued by fillTile on m_resampleQueue and waits for them. */
+   void flushResampleJobs();
                  
    ossimIrect getBoundingImageRect()const;
 
@@ -337,13 +417,20 @@ private:
    ossim_uint32             m_MaxLevelsToCompute;
 
    ossimPolyArea2d            m_viewArea;
+   ossimRendererTransformGrid m_transformGrid;
+
+   ossim_uint32                           m_resampleThreads;
+   bool                                   m_deferResamples;
+   std::vector< ossimRefPtr<ossimJob> >   m_resampleJobs;
+   ossimRefPtr<ossimJobMultiThreadQueue>  m_resampleQueue;
    
 TYPE_DATA
 };
 
 inline ossimImageRenderer::ossimRendererSubRectInfo::ossimRendererSubRectInfo(ossimImageViewTransform* transform)
 :m_transform(transform),
-m_viewBounds(0)
+m_viewBounds(0),
+m_grid(0)
 {
    m_Vul.makeNan();
    m_Vur.makeNan();
@@ -367,7 +454,8 @@ inline ossimImageRenderer::ossimRendererSubRectInfo::ossimRendererSubRectInfo(os
                          m_Vlr(vlr),
                          m_Vll(vll),
                          m_transform(transform),
-                         m_viewBounds(0)
+                         m_viewBounds(0),
+                         m_grid(0)
 {
    m_Iul.makeNan();
    m_Iur.makeNan();
@@ -221,6 +221,12 @@ public:
    virtual void saveImageGeometry(const ossimFilename& geometry_file) const;
    
    virtual void initialize()=0;
+
+   /**
+    * @brief For event handlers: calls initialize() now, or once at the end of
+    * the ossimDeferredInitializeScope open in this thread.
+    */
+   void requestInitialize();
    
    virtual ossimRefPtr<ossimProperty> getProperty(const ossimString& name)const;
    virtual void setProperty(ossimRefPtr<ossimProperty> property);
@@ -232,9 +238,39 @@ public:
     * This should be replaced by a getPhotoInterpretation().
     */
    virtual bool isIndexedData() const;
+
+   /**
+    * @brief Makes this object reference the read-only state of source instead
+    * of holding its own copy.
+    *
+    * source is an object of the same class loaded from the same state, e.g.
+    * the original of a chain cloned per thread (see ossimImageChainMtAdaptor).
+    * Geometries, histograms and the like are then shared; per object scratch
+    * data (tiles, buffers) is not.  Default implementation does nothing.
+    */
+   virtual void shareReadOnlyState(ossimImageSource* source);
+
+   /**
+    * @brief Makes a new, unconnected copy of this object with a new id, e.g.
+    * to replicate a chain per thread (see ossimImageChain::cloneSource).
+    *
+    * Overrides copy their settings directly and reference read-only state
+    * such as geometries. The default implementation goes through saveState,
+    * the object factories and loadState, then calls shareReadOnlyState(this)
+    * on the copy.
+    *
+    * @return The copy or 0 if none could be made.
+    */
+   virtual ossimImageSource* cloneSource() const;
    
 protected:
 
+   /**
+    * @brief Copies the settings held at this level (enable flag, description,
+    * input and output list sizes) to clone, for cloneSource overrides.
+    */
+   void copySourceSettings(ossimImageSource* clone) const;
+
    ossimImageSource (const ossimImageSource& rhs);
    const ossimImageSource& operator= (const ossimImageSource&);
 
@@ -9,6 +9,7 @@
 #ifndef ossimImageSourceFactoryRegistry_HEADER
 #define ossimImageSourceFactoryRegistry_HEADER
 #include <ossim/imaging/ossimImageSourceFactoryBase.h>
+#include <ossim/base/ossimFactoryTypeCache.h>
 
 class OSSIM_DLL ossimImageSourceFactoryRegistry : public ossimImageSourceFactoryBase
 {
@@ -31,6 +32,10 @@ protected:
    
    static ossimImageSourceFactoryRegistry* theInstance;
    std::vector<ossimImageSourceFactoryBase*> theFactoryList;
+
+   /** Factories by type name and by keyword list type, see ossimFactoryTypeCache. */
+   ossimFactoryTypeCache<ossimImageSourceFactoryBase> theTypeNameCache;
+   ossimFactoryTypeCache<ossimImageSourceFactoryBase> theStateTypeCache;
 TYPE_DATA
 };
 
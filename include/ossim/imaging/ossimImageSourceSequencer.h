@@ -15,6 +15,9 @@
 #include <ossim/imaging/ossimImageSource.h>
 #include <ossim/base/ossimIpt.h>
 #include <ossim/base/ossimConnectableObjectListener.h>
+#include <vector>
+
+class ossimImageHandler;
 
 
 class OSSIMDLLEXPORT ossimImageSourceSequencer
@@ -136,8 +139,59 @@ public:
    virtual double getNullPixelValue(ossim_uint32 band=0)const;
    virtual double getMinPixelValue(ossim_uint32 band=0)const;
    virtual double getMaxPixelValue(ossim_uint32 band=0)const;
+
+   /**
+    * @brief Sets the number of tiles getNextTile hints ahead to the image
+    * handlers (see ossimImageHandler::prefetch).  0 disables.  Default comes
+    * from the preferences keyword "sequencer.prefetch_tiles", 8 if not set.
+    */
+   void setPrefetchTiles(ossim_uint32 count);
+   ossim_uint32 getPrefetchTiles() const;
+
+   /**
+    * @brief Allows getNextTile to return tiles out of order when false, for
+    * callers that place each tile by its image rectangle (e.g. tiled writers).
+    * This sequencer always returns tiles in order; threaded sequencers use it
+    * to hand out tiles as they finish.  Takes effect at the next
+    * setToStartOfSequence.  Default is true.
+    */
+   void setOrderedOutput(bool flag);
+   bool getOrderedOutput() const;
+
+   /**
+    * @brief Sets the number of tiles getNextTile fetches ahead on a
+    * background thread, so that the caller (a writer encoding and writing
+    * the previous tiles) and the chain computing the next ones overlap.
+    * 0 (the default) fetches each tile in getNextTile.  While a sequence is
+    * pipelined the input must not be used from other threads, e.g. through
+    * getTile.  Threaded sequencers, which already fetch ahead, ignore it.
+    */
+   void setPipelineTiles(ossim_uint32 count);
+   ossim_uint32 getPipelineTiles() const;
    
 protected:
+   /**
+    * @brief Finds the image handlers of input to hint; called from
+    * initialize.  Only handlers in this sequencer's pixel space are kept,
+    * e.g. not those behind a renderer, one per file.
+    */
+   void findPrefetchHandlers(ossimImageSource* input);
+
+   /**
+    * @brief Hints the prefetch handlers that tiles [firstId, endId) come next.
+    * Tiles already hinted are skipped.  Hints go out in runs of at least
+    * half the range to keep the calls few.
+    */
+   void prefetchTiles(ossim_int64 firstId, ossim_int64 endId, ossim_uint32 resLevel);
+
+   /** @brief Background thread of a pipelined sequence. */
+   class Pipeline;
+   friend class Pipeline;
+
+   /** @brief Stops the pipeline thread if running; tiles queued are dropped. */
+   void stopPipeline();
+
+
    ossimImageSource*  theInputConnection;
    ossimRefPtr<ossimImageData> theBlankTile;
    /*!
@@ -159,6 +213,13 @@ protected:
    ossim_int64 theNumberOfTilesVertical;
    ossim_int64 theCurrentTileNumber;
 
+   ossim_uint32                    thePrefetchTiles;
+   ossim_int64                     thePrefetchEnd; // End of the tiles hinted so far.
+   std::vector<ossimImageHandler*> thePrefetchHandlers;
+   bool                            theOrderedOutputFlag;
+   ossim_uint32                    thePipelineTiles;
+   Pipeline*                       thePipeline;
+
    virtual void updateTileDimensions();
 
 TYPE_DATA
@@ -16,6 +16,40 @@ public:
    const std::vector<ossim_float64>& getMean()const;
    const std::vector<ossim_float64>& getMin()const;
    const std::vector<ossim_float64>& getMax()const;
+
+   /**
+    * Estimates the statistics from a fraction of the tiles, 1.0 (the
+    * default) reading them all.  Tiles are read in bit-reversed order of
+    * their index, so any number of them is spread evenly over the image.
+    * The min and max are those of the tiles read.
+    */
+   void setSampleFraction(ossim_float64 fraction);
+   ossim_float64 getSampleFraction()const;
+
+   /**
+    * Stops sampling once the standard error of every band's mean (see
+    * getMeanError) is at most maxError pixel units, at the sample fraction
+    * otherwise.  0, the default, reads the whole sample fraction.
+    */
+   void setMaxMeanError(ossim_float64 maxError);
+   ossim_float64 getMaxMeanError()const;
+
+   /**
+    * Reads the input at a reduced resolution, e.g. its coarsest overview,
+    * instead of full resolution (0, the default).
+    */
+   void setResLevel(ossim_uint32 resLevel);
+   ossim_uint32 getResLevel()const;
+
+   /**
+    * @return Standard error of each mean, estimated from the spread of the
+    * sampled tile means: 0 if all tiles were read, nan if fewer than two
+    * were.  About 95% of estimates fall within two standard errors.
+    */
+   const std::vector<ossim_float64>& getMeanError()const;
+
+   /** @return Fraction of the tiles read by the last computeStatistics. */
+   ossim_float64 getSampledFraction()const;
    
 protected:
    virtual ~ossimImageStatisticsSource();
@@ -27,6 +61,11 @@ protected:
    std::vector<ossim_float64> theMean;
    std::vector<ossim_float64> theMin;
    std::vector<ossim_float64> theMax;
+   std::vector<ossim_float64> theMeanError;
+   ossim_float64              theSampleFraction;
+   ossim_float64              theMaxMeanError;
+   ossim_uint32               theResLevel;
+   ossim_float64              theSampledFraction;
 };
 
 #endif
@@ -11,6 +11,10 @@
 #ifndef ossimJpegCodec_HEADER
 #define ossimJpegCodec_HEADER 1
 #include <ossim/imaging/ossimCodecBase.h>
+#include <OpenThreads/Mutex>
+#include <vector>
+
+class ossimJpegDecompressor;
 
 class OSSIM_DLL ossimJpegCodec : public ossimCodecBase
 {
@@ -58,6 +62,43 @@ public:
    virtual bool decode( const std::vector<ossim_uint8>& in,
                         ossimRefPtr<ossimImageData>& out ) const;
 
+   /**
+    * @brief Decode jpeg method on a buffer the caller owns.
+    *
+    * Decodes with a libjpeg decompressor kept by this codec for the next
+    * call (one per concurrent caller) and, for one band images, straight
+    * into out's buffer.  Cmyk is converted to rgb.
+    *
+    * @param in Input jpeg, a complete stream or an abbreviated one using
+    * the tables given to setTables().
+    *
+    * @param size Number of bytes at in.
+    *
+    * @param out Output tile.  If null it will be created; resized if not
+    * the output size.
+    *
+    * @param scale 1, 2, 4 or 8.  Decodes at 1/scale resolution using
+    * libjpeg's DCT scaling; the output is the full size divided by scale,
+    * rounded up.
+    *
+    * @return true on success, false on failure.
+    */
+   virtual bool decode( const ossim_uint8* in,
+                        ossim_uint64 size,
+                        ossimRefPtr<ossimImageData>& out,
+                        ossim_uint32 scale = 1 ) const;
+
+   /**
+    * @brief Sets the tables-only jpeg stream (e.g. a tiff JPEGTables tag)
+    * loaded by each decompressor before decoding abbreviated streams.  An
+    * empty stream clears it.  Not to be called during a decode.
+    *
+    * @param tables Tables-only stream.
+    *
+    * @param size Number of bytes at tables.
+    */
+   void setTables( const ossim_uint8* tables, ossim_uint64 size );
+
    /**
     * Ineterface to allow for specific properties to be set.
     *
@@ -110,6 +151,31 @@ protected:
     */
    bool decodeJpeg(const std::vector<ossim_uint8>& in,
                    ossimRefPtr<ossimImageData>& out ) const;
+
+   /**
+    * @brief Decodes a jpeg block of size bytes at 1/scale resolution.  The
+    * output bands are the jpeg's output components.
+    * @param colorSpace If not null set to the libjpeg out_color_space.
+    * @return true on success, false on error.
+    */
+   bool decodeJpeg(const ossim_uint8* in,
+                   ossim_uint64 size,
+                   ossim_uint32 scale,
+                   ossimRefPtr<ossimImageData>& out,
+                   ossim_int32* colorSpace ) const;
+
+   /**
+    * @brief Converts a four band cmykTile to a three band rgb out.
+    * @return true on success, false if cmyk is not four bands.
+    */
+   bool cmykToRgb(const ossimImageData* cmykTile,
+                  ossimRefPtr<ossimImageData>& out ) const;
+
+   /** @return An idle decompressor, created if none. */
+   ossimJpegDecompressor* acquireDecompressor() const;
+
+   /** @brief Returns a decompressor to the idle list. */
+   void releaseDecompressor(ossimJpegDecompressor* decompressor) const;
    
    /**
     * @brief For decoding color spaces other that mono and rgb.
@@ -127,6 +193,11 @@ protected:
    ossim_int32 getColorSpace( const std::vector<ossim_uint8>& in ) const;
    
    ossim_uint32 m_quality;
+
+   std::vector<ossim_uint8>                     m_tables;
+   ossim_uint32                                 m_tablesGeneration;
+   mutable OpenThreads::Mutex                   m_decompressorMutex;
+   mutable std::vector<ossimJpegDecompressor*>  m_decompressors; // Idle.
    TYPE_DATA;
 };
 
@@ -15,11 +15,16 @@
 
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimDrect.h>
+#include <ossim/base/ossimMemoryMappedFile.h>
 #include <ossim/base/ossimRefPtr.h>
 #include <ossim/base/ossimUnitConversionTool.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageGeometry.h>
 #include <ossim/projection/ossimProjection.h>
+#include <ossim/point_cloud/ossimPointCloudIndex.h>
+#include <utility>
+#include <vector>
 
 class ossimLasHdr;
 class ossimLasPointRecordInterface;
@@ -28,6 +33,12 @@ class ossimLasPointRecordInterface;
  * @class ossimLasReader
  *
  * OSSIM LAS LIDAR reader.
+ *
+ * Tiles are binned from the memory mapped point records listed for the tile by a point range
+ * index (ossimPointCloudIndex), built with one pass over the file on the first tile and saved
+ * beside it as <file>.xy.pci; records are decoded on ossim::getNumberOfThreads() threads. With
+ * the "point_cloud.spatial_index" preference false, or if the file cannot be mapped, each tile
+ * reads the whole file.
  */
 class ossimLasReader : public ossimImageHandler
 {
@@ -256,6 +267,29 @@ private:
       ossim_uint32  c; // count
    };
 
+   /** Tile geometry in projection space for binPoints(). */
+   struct TileBins
+   {
+      ossimDpt    m_ulProgPt; // Upper left of upper left pixel.
+      ossimDpt    m_scale;
+      ossimDrect  m_projRect;
+      ossim_int32 m_width;
+      ossim_int32 m_size;
+   };
+
+   /**
+    * @brief Maps the point data and loads or builds the point range index.
+    * @return true if tiles can be read through the index.
+    */
+   bool initIndex();
+
+   /** @brief Adds the points of records [begin, end) of the mapped file to bucket. */
+   void binPoints(ossim_uint64 begin, ossim_uint64 end, const TileBins& bins,
+                  std::vector<Bucket>& bucket) const;
+
+   /** @brief Fills bucket from the index chunks overlapping bins. */
+   void binIndexedPoints(const TileBins& bins, std::vector<Bucket>& bucket) const;
+
    bool init();
    
    void initValues(); // m_ul, m_lr, m_minZ
@@ -296,6 +330,12 @@ private:
    bool                         m_scan;  // Scan for bounds at open.
    ossimUnitType                m_units;
    ossimUnitConversionTool*     m_unitConverter;
+   ossimRefPtr<ossimMemoryMappedFile> m_map;
+   ossimRefPtr<ossimPointCloudIndex>  m_index;
+   bool                         m_indexInitialized;
+   ossim_float64                m_unitFactor; // Meters per unit of m_units.
+
+   friend class ossimLasTileThread;
 TYPE_DATA
 };
 
@@ -12,6 +12,7 @@
 #ifndef ossimMapCompositionSource_HEADER
 #define ossimMapCompositionSource_HEADER
 #include <ossim/imaging/ossimAnnotationSource.h>
+#include <ossim/imaging/ossimAppFixedTileCache.h>
 #include <ossim/base/ossimRgbVector.h>
 #include <ossim/base/ossimPolyArea2d.h>
 #include <ossim/font/ossimFont.h>
@@ -291,6 +292,15 @@ protected:
    
    ossimAnnotationSource::AnnotationObjectListType theFixedAnnotationList;
 
+   /*!
+    * The borders, with the fixed annotations drawn over them, rendered once
+    * in blocks of the application tile cache.  They do not change from tile
+    * to tile, so tiles only copy them.  Dropped on a new layout.
+    */
+   ossimAppFixedTileCache::ossimAppFixedCacheId theBorderCacheId;
+   ossimRgbVector                               theBorderCacheColor;
+   ossim_uint32                                 theBorderCacheBands;
+
    /*!
     * Override base classes drawAnnotations so we can layout
     * any fixed annotations first.
@@ -299,6 +309,20 @@ protected:
    
    virtual void computeBorderRects();
    virtual void drawBorders();
+
+   /*!
+    * Loads the border pixels of theTile from the border cache, rendering
+    * the blocks not cached.
+    */
+   void loadBorders();
+   void renderBorderBlock(ossimImageData* block);
+   void deleteBorderCache();
+
+   /*!
+    * True if rect is all border pixels, which loadBorders fills with the
+    * fixed annotations already drawn.
+    */
+   bool isWithinBorders(const ossimIrect& rect)const;
    virtual void addGridLabels();
    
    virtual void addGeographicTopGridLabels();
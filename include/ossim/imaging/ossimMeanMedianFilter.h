@@ -21,6 +21,10 @@
  * also specify a window size which the median or mean is computed and
  * the center pixel is replaced.
  *
+ * Integer data is filtered with the window slid along each row: means
+ * from running column sums, and for 8 and 16 bit data medians from a
+ * two level histogram updated by one window column per pixel.  Results
+ * are those of sorting and summing each window.
  */
 class OSSIM_DLL ossimMeanMedianFilter : public ossimImageSourceFilter
 {
@@ -123,6 +127,16 @@ protected:
    template <class T>
       void applyMedianNullCenterOnly(T dummyVariable,
                                      ossimRefPtr<ossimImageData>& inputData);
+
+   /** applyMean() for integer data. */
+   template <class T>
+      void applyRunningMean(T dummyVariable,
+                            ossimRefPtr<ossimImageData>& inputData);
+
+   /** applyMedian() for 8 and 16 bit integer data. */
+   template <class T>
+      void applyHistogramMedian(T dummyVariable,
+                                ossimRefPtr<ossimImageData>& inputData);
 TYPE_DATA
 };
 
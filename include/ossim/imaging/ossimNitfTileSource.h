@@ -18,12 +18,14 @@
 
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/imaging/ossimAppFixedTileCache.h>
+#include <ossim/base/ossimReadAhead.h>
 #include <ossim/support_data/ossimNitfFile.h>
 #include <ossim/support_data/ossimNitfFileHeader.h>
 #include <ossim/support_data/ossimNitfImageHeader.h>
 #include <fstream>
 
 struct jpeg_decompress_struct;
+class ossimJobMultiThreadQueue;
 
 class OSSIM_DLL ossimNitfTileSource : public ossimImageHandler
 {
@@ -88,6 +90,13 @@ public:
    virtual ossimRefPtr<ossimImageData> getTile(const  ossimIrect& tileRect,
                                                ossim_uint32 resLevel=0);
 
+   /**
+    * @brief Hints the os to read the nitf blocks covering rects.
+    * Overrides: ossimImageHandler::prefetch
+    */
+   virtual void prefetch(const std::vector<ossimIrect>& rects,
+                         ossim_uint32 resLevel=0);
+
     /**
      * @return Returns the number of bands in the image.
      * Satisfies pure virtual from ImageHandler class.
@@ -394,6 +403,46 @@ protected:
     */
    virtual bool loadBlock(ossim_uint32 x, ossim_uint32 y);
 
+   /**
+    * @return true if the blocks of the current entry can be read with
+    * readCompressedBlock() and uncompressed with uncompressBlock(), i.e.
+    * jpeg (C3), vq (C4, M4) or lut blocks.
+    */
+   bool hasConcurrentUncompress() const;
+
+   /**
+    * @brief Loads the blocks at origins into theTile, clipped to clipRect.
+    * The compressed blocks are read here, then uncompressed on
+    * m_uncompressThreads threads and added to the cache.
+    * @return true on success, false if any block failed.
+    */
+   bool loadBlocksConcurrently(const std::vector<ossimIpt>& origins,
+                               const ossimIrect& clipRect);
+
+   /**
+    * @brief Reads the compressed bytes of the block at x, y: the jpeg block
+    * (scanning for the jpeg block offsets first if needed), or each band of
+    * a vq or lut block, one after the other.
+    * @return true on success, false on error.
+    */
+   bool readCompressedBlock(ossim_uint32 x, ossim_uint32 y,
+                            std::vector<ossim_uint8>& buf);
+
+   /**
+    * @brief Uncompresses a block read by readCompressedBlock() into tile,
+    * then does what loadBlock() does after reading (see finishBlock()).
+    * Changes no data member so blocks can be uncompressed concurrently.
+    * @return true on success, false on error.
+    */
+   bool uncompressBlock(const std::vector<ossim_uint8>& buf,
+                        ossimImageData* tile);
+
+   /**
+    * @brief Unpacks bits, swaps bytes, maps transparent pixels to null and
+    * validates a loaded block.
+    */
+   void finishBlock(ossimImageData* tile) const;
+
    /**
     * @param x Horizontal upper left pixel position of the requested block.
     *
@@ -471,6 +520,14 @@ protected:
     */
    virtual bool uncompressJpegBlock(ossim_uint32 x, ossim_uint32 y);
 
+   /**
+    * @brief Uncompresses the jpeg block in buf into tile.  Changes no data
+    * member.
+    * @return true on success, false on error.
+    */
+   bool uncompressJpeg(const std::vector<ossim_uint8>& buf,
+                       ossimImageData* tile);
+
    /**
     * @brief Loads one of the default tables based on COMRAT value.
     *
@@ -512,6 +569,7 @@ protected:
    ossim_uint32                  theCurrentEntry;
    ossimIrect                    theImageRect;
    std::ifstream                 theFileStr;   
+   ossimReadAhead                theReadAhead; // For prefetch.
    std::vector<ossim_uint32>     theOutputBandList;
    ossimIpt                      theCacheSize;
    ossimInterleaveType           theCacheTileInterLeaveType;
@@ -536,6 +594,15 @@ protected:
    // prior to grabbing a block.
    //---
    bool m_jpegOffsetsDirty;
+
+   //---
+   // Threads uncompressing the blocks of one getTile when it needs more than
+   // one (preference nitf.uncompress_threads); 1 uncompresses in loadBlock.
+   //---
+   ossim_uint32 m_uncompressThreads;
+   ossimRefPtr<ossimJobMultiThreadQueue> m_uncompressQueue;
+
+   friend class ossimNitfUncompressJob;
    
 TYPE_DATA
 };
@@ -25,7 +25,9 @@
 #include <ossim/support_data/ossimNitfDataExtensionSegmentV2_1.h>
 #include <ossim/base/ossimIoStream.h>
 
+class ossimImageData;
 class ossimProjection;
+class ossimNitfImageDataMaskV2_1;
 
 class OSSIM_DLL ossimNitfWriter : public ossimNitfWriterBase
 {
@@ -152,6 +154,34 @@ protected:
     */
    virtual bool writeBlockBandSequential();
 
+   /**
+    * @brief Writes the blocks of the sequence starting with data on
+    * m_writeThreads threads, each block at its precomputed offset.
+    *
+    * Tiles are read in order on this thread, which also works out each
+    * block's offset (and for masked output whether it is written at all), so
+    * the file is the same as the one written serially.  Byte swapping and the
+    * positional writes are done by the threads.  On return m_outputStream is
+    * at the end of the image data.
+    *
+    * @param data First tile of the sequence.
+    * @param numberOfTiles Tiles in the sequence.
+    * @param blockLength Bytes of one block, all bands.
+    * @param bandSequential If true band b of tile i goes to
+    * i * blockLength / bands + b * bandOffset, else the whole tile goes to
+    * its block offset.
+    * @param bandOffset Bytes between bands when bandSequential.
+    * @param datamask If not null, all zero blocks are left out and marked in
+    * datamask.
+    * @return true on success, false on a read or write error or abort.
+    */
+   bool writeBlocksConcurrently(ossimImageData* data,
+                                ossim_uint64 numberOfTiles,
+                                ossim_uint64 blockLength,
+                                bool bandSequential,
+                                ossim_uint64 bandOffset,
+                                ossimNitfImageDataMaskV2_1* datamask);
+
    /** Currently disabled... */
    // virtual void addStandardTags();
 
@@ -162,6 +192,7 @@ protected:
    ossimRefPtr<ossimNitfTextHeaderV2_1>  m_textHeader;
    std::string                           m_textEntry;
    ossimIpt                              m_blockSize;
+   ossim_uint32                          m_writeThreads; // "nitf_writer.write_threads"
 
 TYPE_DATA 
 private:
@@ -37,6 +37,12 @@ public:
    virtual ossimRefPtr<ossimImageData> getNextTile(ossim_uint32& returnedIdx,
                                                    const ossimIrect& origin,
                                                    ossim_uint32 resLevel=0);
+
+   //! Same as above, skipping the inputs that miss neededRect.
+   virtual ossimRefPtr<ossimImageData> getNextTile(ossim_uint32& returnedIdx,
+                                                   const ossimIrect& origin,
+                                                   const ossimIrect& neededRect,
+                                                   ossim_uint32 resLevel=0);
    
    ossimIrect getRelativeRect(ossim_uint32 index,
                               ossim_uint32 resLevel = 0)const;
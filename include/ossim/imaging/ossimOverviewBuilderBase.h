@@ -22,6 +22,7 @@
 #include <ossim/base/ossimString.h>
 #include <ossim/imaging/ossimBitMaskWriter.h>
 #include <ossim/imaging/ossimMaskFilter.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
 #include <vector>
 
 class ossimImageFileWriter;
@@ -179,6 +180,48 @@ public:
    /** @return scan for min max flag. */
    bool getScanForMinMaxNull() const;
 
+   /** @brief One image entry of executeBatch. */
+   struct BatchTarget
+   {
+      BatchTarget();
+
+      /** Handler of this target alone; two targets cannot share one. */
+      ossimRefPtr<ossimImageHandler> m_handler;
+      ossim_uint32                   m_entry;
+      ossimFilename                  m_outputFile;
+
+      /** Overrides the builder's mode unless OSSIM_HISTO_MODE_UNKNOWN. */
+      ossimHistogramMode             m_histoMode;
+
+      /** Set by executeBatch: true if the target's overviews were built. */
+      bool                           m_status;
+   };
+
+   /**
+    * @brief Builds the overviews of several image entries, e.g. of a multi
+    * entry NITF or of a set of images, at once.
+    *
+    * Each target is built by a builder of this type and settings (see
+    * createBatchBuilder).  Targets run concurrently on
+    * overview_builder.batch_threads threads, largest first so that small
+    * ones fill in around the large ones, and no more at once than fit in
+    * overview_builder.batch_memory_budget megabytes (see estimateMemory).
+    * The budget holds over all batches running at once, e.g. of files built
+    * in parallel; a target too big for it runs alone.  Tile jobs of the builders (the
+    * single pass of ossimTiffOverviewBuilder) go on one queue of
+    * ossim::getNumberOfThreads() threads shared by the batch.
+    *
+    * @param targets Targets to build; m_status is set on each.
+    * @return true if all were built.
+    */
+   virtual bool executeBatch(std::vector<BatchTarget>& targets);
+
+   /**
+    * @brief Sets a queue for the builder's tile jobs, shared with other
+    * builders; null (default) for one of its own.
+    */
+   void setJobQueue(ossimJobMultiThreadQueue* queue);
+
 protected:
    /** virtual destructor */
    virtual ~ossimOverviewBuilderBase();
@@ -220,6 +263,22 @@ protected:
     * needed.
     */
    void initializeScanOptions();
+
+   /**
+    * @brief Estimate of the memory execute() holds for the current entry of
+    * ih, for the budget of executeBatch.
+    *
+    * This implementation allows for a few strips of tiles across the full
+    * resolution image.
+    */
+   virtual ossim_uint64 estimateMemory(const ossimImageHandler* ih) const;
+
+   /**
+    * @brief Creates a builder of this type with the same settings and
+    * properties, for one target of executeBatch.
+    * @return The builder, or null on error.
+    */
+   virtual ossimOverviewBuilderBase* createBatchBuilder() const;
    
    ossim_uint32 m_overviewStopDimension;
    ossimHistogramMode m_histoMode; 
@@ -232,6 +291,7 @@ protected:
    bool                            m_scanForMinMax;
    bool                            m_scanForMinMaxNull;
    bool                            m_scanFloatData;
+   ossimRefPtr<ossimJobMultiThreadQueue> m_jobQueue;
 
    /** for rtti stuff */
    TYPE_DATA
@@ -92,6 +92,21 @@ public:
     */
    void setHistogramMode(ossimHistogramMode mode);
 
+   /**
+    * @brief Turns on/off a histogram of every output (decimated) tile, so a
+    * builder chaining sequencers gets the histogram of each level as it is
+    * made.  Independent of the histogram mode, which applies to the input
+    * tiles.  Default=off.
+    * @param flag true turns on.
+    */
+   void setOutputHistogramFlag(bool flag);
+
+   /** @return The input tile histogram, null if the mode is UNKNOWN. */
+   ossimRefPtr<ossimMultiBandHistogram> getHistogram() const;
+
+   /** @return The output tile histogram, null if the flag is off. */
+   ossimRefPtr<ossimMultiBandHistogram> getOutputHistogram() const;
+
    /**
     * @brief Write histogram method.
     */
@@ -269,6 +284,10 @@ protected:
 
    ossimHistogramMode m_histoMode;
 
+   /** Histogram of the output tiles, made when m_outputHistoFlag is set. */
+   ossimRefPtr<ossimMultiBandHistogram> m_outputHistogram;
+   bool m_outputHistoFlag;
+
    /**
     * Used to determine which tiles to accumulate a histogram from.  If set to
     * 1 every tile is accumulated, 2 every other tile, 3 every 3rd tile, and
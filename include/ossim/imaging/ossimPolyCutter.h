@@ -13,6 +13,9 @@
 #define ossimPolyCutter_HEADER
 #include <ossim/imaging/ossimImageSourceFilter.h>
 #include <ossim/base/ossimPolygon.h>
+#include <ossim/base/ossimPolyArea2d.h>
+#include <ossim/base/ossimPolygonRasterizer.h>
+#include <ossim/base/ossimRefPtr.h>
 #include <ossim/imaging/ossimImageDataHelper.h>
 #include <vector>
 
@@ -86,6 +89,23 @@ protected:
    void allocate();
    void computeBoundingRect();
 
+   /**
+    * @return How tileRect relates to the union of polyList: inside any
+    * polygon, outside all of them, or crossing an edge.  The areas are kept
+    * until the polygons change, so their prepared geometry is reused from
+    * tile to tile.
+    */
+   ossimPolyArea2d::RectRelation classifyTile(const ossimIrect& tileRect,
+                                              const vector<ossimPolygon>& polyList);
+
+   /**
+    * Nulls the pixels of theTile inside (nullInside true) or outside the
+    * spans of theRasterizer, run by run.
+    */
+   void nullSpans(bool nullInside);
+
+   template <class T> void nullSpansTemplate(T dummy, bool nullInside);
+
    ossimRefPtr<ossimImageData> theTile;
 
    /*!
@@ -103,6 +123,12 @@ protected:
    ossimImageDataHelper theHelper;
    bool m_boundingOverwrite;
 
+   /** Polygons theAreas were built from; compared since the list is mutable. */
+   std::vector<ossimPolygon> theAreaPolygons;
+   std::vector< ossimRefPtr<ossimPolyArea2d> > theAreas;
+   ossimPolygonRasterizer      theRasterizer;
+   std::vector<ossimPolygonRasterizer::SpanList> theSpans;
+
 TYPE_DATA  
 };
 #endif /* #ifndef ossimPolyCutter_HEADER */
@@ -9,6 +9,7 @@
 #ifndef ossimRgbImage_HEADER
 #define ossimRgbImage_HEADER
 
+#include <cstring>
 #include <vector>
 
 #include <ossim/base/ossimReferenced.h>
@@ -323,6 +324,29 @@ public:
 protected:
    virtual ~ossimRgbImage();
 
+   /**
+    * Fills columns x1 through x2 of row y with the draw color.  Like
+    * fastPlotPixel, coordinates are relative to the upper left corner of
+    * the image data; unlike it, the span is clipped to the image.
+    */
+   inline void plotSpan(ossim_int32 x1, ossim_int32 x2, ossim_int32 y);
+
+   /** Same as plotSpan for rows y1 through y2 of column x, which must be in the image. */
+   inline void plotColumn(ossim_int32 x, ossim_int32 y1, ossim_int32 y2);
+
+   /**
+    * Draws the horizontal span x1 through x2 of row y, in image data
+    * coordinates, with the thickness drawLine gives it.  The polygon fills
+    * draw their rows with this.
+    */
+   void drawSpan(ossim_int32 x1, ossim_int32 x2, ossim_int32 y);
+
+   /**
+    * Rows, in image data coordinates, the polygon fills need to scan to draw
+    * to the image with the current thickness.
+    */
+   void getSpanRows(ossim_int32& minRow, ossim_int32& maxRow) const;
+
    /**
     * This object operates on the ossimImageData.  Note the
     * ossimImageData is a band separate so the bands follow sequentially:
@@ -392,6 +416,39 @@ inline void ossimRgbImage::slowPlotPixel(ossim_int32 x,
    }
 }
 
+inline void ossimRgbImage::plotSpan(ossim_int32 x1,
+                                    ossim_int32 x2,
+                                    ossim_int32 y)
+{
+   if((y > -1) && (y < theHeight))
+   {
+      if(x1 < 0) x1 = 0;
+      if(x2 >= theWidth) x2 = theWidth - 1;
+      if(x1 <= x2)
+      {
+         const ossim_int32 offset = theOffsets[y] + x1;
+         const size_t      count  = x2 - x1 + 1;
+         memset(theBands[0] + offset, theRed,   count);
+         memset(theBands[1] + offset, theGreen, count);
+         memset(theBands[2] + offset, theBlue,  count);
+      }
+   }
+}
+
+inline void ossimRgbImage::plotColumn(ossim_int32 x,
+                                      ossim_int32 y1,
+                                      ossim_int32 y2)
+{
+   if(y1 < 0) y1 = 0;
+   if(y2 >= theHeight) y2 = theHeight - 1;
+   for(ossim_int32 y = y1; y <= y2; ++y)
+   {
+      theBands[0][theOffsets[y]+x] = theRed;
+      theBands[1][theOffsets[y]+x] = theGreen;
+      theBands[2][theOffsets[y]+x] = theBlue;
+   }
+}
+
 inline void ossimRgbImage::fastPlotPixel(ossim_int32 x,
                                          ossim_int32 y,
                                          ossim_uint8 r,
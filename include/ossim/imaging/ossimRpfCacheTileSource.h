@@ -13,6 +13,7 @@
 #ifndef ossimRpfCacheTileSource_HEADER
 #define ossimRpfCacheTileSource_HEADER 1
 #include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimRpfSubframeCache.h>
 #include <ossim/support_data/ossimRpfFrameEntry.h>
 
 class ossimRpfToc;
@@ -378,11 +379,9 @@ protected:
    vector<ossimFrameEntryData> getIntersectingEntries(const ossimIrect& rect);
 
    /**
-    * This is a wrapper for the fill cib and fill cadrg.  It takes the frames
-    * involved that were found in the getIntersectingEntries and call the
-    * appropriate fill cib or fill cadrg on each frame entry data.  It will
-    * loop through making sure that the frame file exists before calling
-    * the associated fill routines.
+    * Fills the region from the subframes of the frames involved that were
+    * found in the getIntersectingEntries, through m_subframeCache, which
+    * uncompresses the ones it does not hold.
     *
     * @param tileRect Region to fill.
     * @param framesInvolved All intersecting frames used to render the region.
@@ -392,33 +391,9 @@ protected:
                  ossimImageData* tile);
 
    /**
-    * Will uncompress the CIB file using a VQ decompression algorithm.
-    *
-    * @param aFrame Frame that overlaps the requested tile rect.
-    * @param tileRect The region requested to render.
-    * @param frameEntryData The frame entry data.
-    */
-   void fillSubTileCib(const ossimRpfFrame& aFrame,
-                       const ossimIrect& tileRect,
-                       const ossimFrameEntryData& frameEntryData,
-                       ossimImageData* tile);
-   
-   /**
-    * Will uncompress the CADRG file using a VQ decompression algorithm.
-    *
-    * @param aFrame Frame that overlaps the requested tile rect.
-    * @param tileRect The region requested to render.
-    * @param frameEntryData The frame entry data.
-    */
-   void fillSubTileCadrg(const ossimRpfFrame& aFrame,
-                         const ossimIrect& tileRect,
-                         const ossimFrameEntryData& frameEntryData,
-                         ossimImageData* tile);
-   
-   /**
-    * Will allocate an internal buffer for the given product.  If the product is
-    * a CIB then it is a single band OSSIM_UCHAR buffer and if its a CADRG it
-    * is a 3 band OSSIM_UCHAR buffer.
+    * Will allocate the output tile for the given product.  If the product is
+    * a CIB then it is a single band OSSIM_UCHAR tile and if its a CADRG it
+    * is a 3 band OSSIM_UCHAR tile.
     */
    void allocateForProduct();
 
@@ -435,16 +410,6 @@ protected:
     */
    ossimIrect                  m_actualImageRect;
    
-   /**
-    * This is for storage of a single compressed buffer.
-    */
-   unsigned char*               m_compressedBuffer;
-
-   /**
-    * This is used as a buffer to uncompress the data to
-    */
-   unsigned char*               m_uncompressedBuffer;
-   
    /**
     * This will be computed based on the frames organized within
     * the directory.  The CibCadrg have fixed size frames of 1536x1536
@@ -480,7 +445,11 @@ protected:
     */
    ossimRpfCacheProductType     m_productType;
    
-   mutable ossimRpfFrame*       m_workFrame;
+   /**
+    * Uncompressed subframes of the entry, shared with the application tile
+    * cache.
+    */
+   ossimRpfSubframeCache        m_subframeCache;
 
 	// data to use in property retrieval
 
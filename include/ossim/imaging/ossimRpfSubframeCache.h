@@ -0,0 +1,99 @@
+//*******************************************************************
+//
+// License:  LGPL
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description: Cache of uncompressed RPF (CIB/CADRG) subframes.
+//
+//********************************************************************
+#ifndef ossimRpfSubframeCache_HEADER
+#define ossimRpfSubframeCache_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimIpt.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/imaging/ossimAppFixedTileCache.h>
+#include <vector>
+
+class ossimImageData;
+class ossimJobMultiThreadQueue;
+
+/**
+ * Uncompressed 256x256 subframes of the frames of one RPF entry, kept in
+ * the application tile cache so neighboring tiles, and the same tile asked
+ * again, do not reparse the frame file and uncompress the subframes they
+ * share.  Subframes are keyed by their position in the entry's image, which
+ * stands for the frame file and subframe.
+ *
+ * When a tile needs subframes of several frames that are not cached, the
+ * frames are parsed and uncompressed concurrently on rpf.decode_threads
+ * threads (preference, default 1).
+ *
+ * Used by ossimCibCadrgTileSource and ossimRpfCacheTileSource.
+ */
+class OSSIMDLLEXPORT ossimRpfSubframeCache
+{
+public:
+   /** A frame file and the image position of its upper left pixel. */
+   struct Frame
+   {
+      Frame() : m_file(), m_origin(0, 0) {}
+      Frame(const ossimFilename& file, const ossimIpt& origin)
+         : m_file(file), m_origin(origin) {}
+      ossimFilename m_file;
+      ossimIpt      m_origin;
+   };
+
+   /** Frames are 1536x1536, six subframes across. */
+   static const ossim_int32 FRAME_SIZE;
+   static const ossim_int32 SUBFRAME_SIZE;
+
+   ossimRpfSubframeCache();
+   ~ossimRpfSubframeCache();
+
+   /**
+    * Starts over for an entry of imageRect with bands bands, 1 for CIB and 3
+    * for CADRG, dropping the subframes of the previous entry.
+    */
+   void reset(const ossimIrect& imageRect, ossim_uint32 bands);
+
+   /** Drops the cached subframes. */
+   void clear();
+
+   /**
+    * Loads the subframes of frames that overlap tileRect into tile, from the
+    * cache or uncompressed from the frame files.  Missing subframes load as
+    * zeros.  Frames that cannot be parsed are skipped.
+    */
+   void fillTile(const ossimIrect& tileRect,
+                 const std::vector<Frame>& frames,
+                 ossimImageData* tile);
+
+   /**
+    * Parses frame and uncompresses its subframes at origins, image
+    * positions, into subframes.  Returns false, leaving subframes empty, if
+    * the frame cannot be parsed.  Used on the decode threads.
+    */
+   bool uncompressFrame(const Frame& frame,
+                        const std::vector<ossimIpt>& origins,
+                        std::vector< ossimRefPtr<ossimImageData> >& subframes) const;
+
+private:
+   // Not copyable.
+   ossimRpfSubframeCache(const ossimRpfSubframeCache&);
+   const ossimRpfSubframeCache& operator=(const ossimRpfSubframeCache&);
+
+   void addSubframes(const std::vector< ossimRefPtr<ossimImageData> >& subframes,
+                     ossimImageData* tile);
+
+   ossimIrect                                   m_imageRect;
+   ossim_uint32                                 m_bands;
+   ossimAppFixedTileCache::ossimAppFixedCacheId m_cacheId;
+   ossim_uint32                                 m_decodeThreads;
+   ossimRefPtr<ossimJobMultiThreadQueue>        m_decodeQueue;
+};
+
+#endif /* #ifndef ossimRpfSubframeCache_HEADER */
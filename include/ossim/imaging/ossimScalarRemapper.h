@@ -72,6 +72,9 @@ public:
    virtual bool loadState(const ossimKeywordlist& kwl,
                           const char* prefix=NULL);
 
+   /** Copies the output scalar type; see ossimImageSource::cloneSource. */
+   virtual ossimImageSource* cloneSource() const;
+
    /**
     *   Override base class so that a disableSource event does not
     *   reinitialize the object and enable itself.
@@ -167,6 +167,9 @@ public:
     * between res levels you should set this to true. default = true
     *
     * @return true on success, false on error.
+    *
+    * @note The handler comes from ossimImageHandlerPool, so with the pool on
+    * a chain built again for file reuses the handler of an earlier one.
     */
    bool addImageHandler(const ossimFilename& file,
                         bool openOverview=true);
@@ -0,0 +1,117 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Single pass terrain derivatives (slope, aspect, hillshade and plane normals) of an
+// elevation input.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimTerrainDerivativeSource_HEADER
+#define ossimTerrainDerivativeSource_HEADER 1
+
+#include <ossim/imaging/ossimImageSourceFilter.h>
+#include <ossim/imaging/ossimSlopeFilter.h>
+#include <vector>
+
+/**
+ * @brief Computes the 3x3 gradient of each post of an elevation input once per tile and outputs
+ * any combination of slope, aspect, hillshade and normal components as float bands.
+ *
+ * The gradient, null fallbacks and normals are those of ossimImageToPlaneNormalFilter, so the
+ * NORMAL_* bands can feed ossimBumpShadeTileSource and SLOPE matches ossimSlopeFilter. The input
+ * is read in its native type and differentiated in single precision, with SSE2/AVX2 code for
+ * posts whose four neighbours are all valid (see ossimSimd.h).
+ *
+ * Products:
+ *   SLOPE     - Angle from local vertical, represented per setSlopeType().
+ *   ASPECT    - Downslope direction in degrees clockwise from north, null where flat.
+ *   HILLSHADE - Cosine of the light incidence, 0 to 1. The light is set as for
+ *               ossimBumpShadeTileSource (azimuth clockwise from north, elevation above horizon).
+ *   NORMAL_X, NORMAL_Y, NORMAL_Z - Unit plane normal components.
+ *
+ * Keywords: products (e.g. "slope aspect hillshade", the default), slope_type, azimuth_angle,
+ * elevation_angle, smoothness_factor, track_scale_flag.
+ */
+class OSSIMDLLEXPORT ossimTerrainDerivativeSource : public ossimImageSourceFilter
+{
+public:
+   enum Product
+   {
+      SLOPE,
+      ASPECT,
+      HILLSHADE,
+      NORMAL_X,
+      NORMAL_Y,
+      NORMAL_Z
+   };
+
+   ossimTerrainDerivativeSource();
+   ossimTerrainDerivativeSource(ossimImageSource* inputSource);
+
+   virtual ossimRefPtr<ossimImageData> getTile(const ossimIrect& tileRect,
+                                               ossim_uint32 resLevel=0);
+
+   virtual void initialize();
+
+   virtual ossimScalarType getOutputScalarType() const { return OSSIM_FLOAT32; }
+   virtual ossim_uint32 getNumberOfOutputBands() const;
+   virtual void getOutputBandList(std::vector<ossim_uint32>& bandList) const;
+   virtual double getNullPixelValue(ossim_uint32 band=0) const;
+   virtual double getMinPixelValue(ossim_uint32 band=0) const;
+   virtual double getMaxPixelValue(ossim_uint32 band=0) const;
+
+   /** @brief Sets the output bands, in order. */
+   void setProducts(const std::vector<Product>& products);
+   const std::vector<Product>& getProducts() const { return m_products; }
+
+   void setSlopeType(ossimSlopeFilter::SlopeType t) { m_slopeType = t; }
+
+   /** @brief Light source for the HILLSHADE band, in degrees. */
+   void setLightSource(double azimuth, double elevation);
+
+   void setSmoothnessFactor(double factor) { m_smoothnessFactor = factor; }
+
+   /** @brief If true (default), the gradient is per meter, from the input geometry's GSD. */
+   void setTrackScaleFlag(bool flag) { m_trackScaleFlag = flag; }
+
+   virtual bool saveState(ossimKeywordlist& kwl, const char* prefix=0) const;
+   virtual bool loadState(const ossimKeywordlist& kwl, const char* prefix=0);
+
+   virtual ossimString getShortName() const;
+   virtual ossimString getLongName() const;
+
+   /** @return Product for name (case insensitive, e.g. "slope", "normal_x"), true if known. */
+   static bool getProduct(const ossimString& name, Product& product);
+   static ossimString getProductString(Product product);
+
+protected:
+   virtual ~ossimTerrainDerivativeSource();
+
+   /** Light direction in the normal's frame, as ossimBumpShadeTileSource::computeLightDirection. */
+   void computeLightDirection();
+
+   /** Input converted to float, NaN where null. */
+   void loadElevations(const ossimImageData* input);
+
+   /** Derivatives of the rows of m_elevations into m_tile. */
+   void computeProducts(double xScale, double yScale);
+
+   std::vector<Product>              m_products;
+   ossimSlopeFilter::SlopeType       m_slopeType;
+   double                            m_azimuth;
+   double                            m_elevation;
+   double                            m_lightDirection[3];
+   double                            m_smoothnessFactor;
+   bool                              m_trackScaleFlag;
+   double                            m_xScale;
+   double                            m_yScale;
+   ossimRefPtr<ossimImageData>       m_tile;
+   std::vector<ossim_float32>        m_elevations; // (tile + 1 post border), row major
+   ossim_int32                       m_elevationsWidth;
+
+   TYPE_DATA
+};
+
+#endif /* #ifndef ossimTerrainDerivativeSource_HEADER */
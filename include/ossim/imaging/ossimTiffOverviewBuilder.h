@@ -20,6 +20,7 @@
 
 #include <ossim/base/ossimConstants.h>
 #include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimMultiResLevelHistogram.h>
 
 #include <ossim/imaging/ossimOverviewBuilderBase.h>
 #include <ossim/imaging/ossimFilterResampler.h>
@@ -125,6 +126,29 @@ public:
     */
    void setCopyAllFlag(bool flag);
 
+   /**
+    * @brief Sets the single pass flag.
+    *
+    * If true, all reduced resolution sets are decimated from one read of the
+    * starting level instead of each being built from the one before it.  A
+    * row of output tiles per level is kept in memory; the first level is
+    * written as it is produced, the others are staged in "<output>.r<n>.tmp"
+    * files and copied in once the first is done.  Rows are split across
+    * ossim::getNumberOfThreads() threads, which also read when the input has
+    * concurrent reads (see ossimImageHandler::hasConcurrentReads).
+    *
+    * Ignored, with the level by level build used, under mpi and when a fast
+    * mode histogram or min/max scan is requested.  A bit mask is generated
+    * from the tiles of every level as they are made.  Default comes from the
+    * preferences keyword "overview_builder.single_pass", false if not set.
+    *
+    * @param flag The flag.
+    */
+   void setSinglePassFlag(bool flag);
+
+   /** @return The single pass flag. */
+   bool getSinglePassFlag() const;
+
    /** @return ossimObject* to this object. */
    virtual ossimObject* getObject();
 
@@ -235,6 +259,30 @@ private:
                 TIFF* tif,
                 ossim_uint32 resLevel,
                 bool firstResLevel);
+
+   /**
+    *  Write reduced resolution sets startResLevel through endResLevel - 1
+    *  in one pass over the last level of imageHandler.
+    *  @see setSinglePassFlag
+    */
+   bool writeRnSinglePass(ossimImageHandler* imageHandler,
+                          TIFF* tif,
+                          ossim_uint32 startResLevel,
+                          ossim_uint32 endResLevel);
+
+   /**
+    * @return true if m_singlePassFlag is set and nothing requested needs the
+    * level by level build.
+    */
+   bool buildSinglePass() const;
+
+   /**
+    *  Sets the tags of a reduced res set directory, with the geotiff tags on
+    *  the first level of an external overview.
+    */
+   bool setResLevelTags(TIFF* tif,
+                        const ossimIrect& outputRect,
+                        ossim_uint32 resLevel);
    
    /**
     *  Set the tiff tags for the appropriate resLevel.  Level zero is the
@@ -296,6 +344,15 @@ private:
    bool                                               m_copyAllFlag;
    bool                                               m_outputTileSizeSetFlag;
    bool                                               m_internalOverviewsFlag;
+   bool                                               m_singlePassFlag;
+
+   /**
+    * Histogram written to the .his once all levels are built.  In normal
+    * mode from r0 it holds a level per res level, each counted as the tiles
+    * are made, so r0 is read once for both overviews and histogram.
+    */
+   ossimRefPtr<ossimMultiResLevelHistogram>           m_histogram;
+   bool                                               m_histogramLevelsFlag;
 
 TYPE_DATA   
 };
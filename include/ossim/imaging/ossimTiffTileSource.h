@@ -20,6 +20,8 @@
 
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimReadAhead.h>
+#include <OpenThreads/Mutex>
 #include <tiffio.h>
 #include <vector>
 
@@ -195,6 +197,39 @@ public:
    void setApplyColorPaletteFlag(bool flag);
    bool getApplyColorPaletteFlag()const;
 
+   /**
+    * @brief Enables concurrent reads.
+    *
+    * When set, getTile(ossimImageData*, resLevel) may be called from several
+    * threads at once.  Tiled directories are decoded on a small pool of
+    * libtiff handles opened on the same file, one per reading thread up to
+    * ossim::getNumberOfThreads(); all other reads (strips, rgba, overviews)
+    * are serialized on the main handle.  Default comes from the preferences
+    * keyword "tiff.concurrent_reads", false if not set.
+    */
+   void setConcurrentReadFlag(bool flag);
+   bool getConcurrentReadFlag()const;
+
+   /**
+    * @return true if the concurrent read flag is set.
+    * Overrides: ossimImageHandler::hasConcurrentReads
+    */
+   virtual bool hasConcurrentReads() const;
+
+   /**
+    * @brief Hints the os to read the tiff tiles/strips covering rects.
+    * Overrides: ossimImageHandler::prefetch
+    */
+   virtual void prefetch(const std::vector<ossimIrect>& rects,
+                         ossim_uint32 resLevel=0);
+
+   /**
+    * @brief Adds the counts of the libtiff reads of every handle of the
+    * file, and those of the overview.
+    * Overrides: ossimImageHandler::getIoCounters
+    */
+   virtual bool getIoCounters(ossimIoCounters::Values& values) const;
+
    virtual void setProperty(ossimRefPtr<ossimProperty> property);
    virtual ossimRefPtr<ossimProperty> getProperty(const ossimString& name)const;
    virtual void getPropertyNames(std::vector<ossimString>& propertyNames)const;
@@ -220,6 +255,15 @@ public:
 #endif   
 protected:
    virtual ~ossimTiffTileSource();
+
+   /** @brief libtiff handle used to decode tiles outside of the main handle. */
+   struct ReadHandle
+   {
+      TIFF*                    tiff;
+      ossim_uint16             directory;
+      std::vector<ossim_uint8> buffer;
+   };
+
    /**
     *  Returns true if no errors initializing object.
     *
@@ -231,6 +275,17 @@ protected:
     */
    bool open();
 
+   /**
+    * @brief Opens a libtiff handle on theImageFile for reading.
+    *
+    * A url (see ossimHttpRangeStreamFactory::isUrl) is read through a stream from
+    * ossimStreamFactoryRegistry, so only the header and the tiles touched are fetched; a
+    * local file is opened by name.
+    *
+    * @return The handle or null; close with XTIFFClose.
+    */
+   TIFF* openTiffPtr() const;
+
    // Must be protected for derived ossimTerraSarTiffReader.
    TIFF* theTiffPtr; 
    
@@ -275,6 +330,41 @@ private:
 
    bool loadFromTile(const ossimIrect& clip_rect,
                      ossimImageData* result);
+
+   /**
+    * @brief Single handle getTile.  The body of getTile(ossimImageData*)
+    * before concurrent reads; uses theTiffPtr, theBuffer and theTile.
+    */
+   bool getTileFromMainHandle(ossimImageData* result, ossim_uint32 resLevel);
+
+   /**
+    * @brief Concurrent getTile for tiled directories not served by an
+    * overview.
+    * @param status Set to the result of the read if handled.
+    * @return true if handled; false if the caller must fall back to
+    * getTileFromMainHandle.
+    */
+   bool getTileFromReadHandle(ossimImageData* result,
+                              ossim_uint32 resLevel,
+                              bool& status);
+
+   /** @brief loadFromTile on a pooled handle. */
+   bool loadFromTile(ReadHandle* handle,
+                     const ossimIrect& clip_rect,
+                     ossimImageData* result) const;
+
+   /**
+    * @brief Gets a free pooled handle set to directory, opening one if the
+    * pool is not full.
+    * @return handle or 0 if none available.
+    */
+   ReadHandle* acquireReadHandle(ossim_uint16 directory);
+
+   /** @brief Puts handle back in the pool. */
+   void releaseReadHandle(ReadHandle* handle);
+
+   /** @brief Closes all pooled handles. */
+   void closeReadHandles();
    
    void setReadMethod();
    
@@ -357,6 +447,22 @@ private:
    ossim_uint32              theCurrentTiffRlevel;
    ossim_int32               theCompressionType;
    std::vector<ossim_uint32> theOutputBandList;
+
+   // Concurrent reads:
+   bool                      theConcurrentReadFlag;
+   std::vector<ReadHandle*>  theFreeReadHandles;
+   ossim_uint32              theReadHandleCount; // Open pooled handles, free or in use.
+   OpenThreads::Mutex        theReadHandleMutex; // Guards the two above.
+   OpenThreads::Mutex        theMainHandleMutex; // Serializes theTiffPtr reads.
+
+   // Prefetch, own handle so the main one does not change directory:
+   TIFF*                     thePrefetchTiffPtr;
+   ossim_uint16              thePrefetchDirectory;
+   ossimReadAhead            theReadAhead;
+   OpenThreads::Mutex        thePrefetchMutex;
+
+   // Reads and seeks of the libtiff client procs of all handles:
+   mutable ossimIoCounters   theIoCounters;
    
 TYPE_DATA
 };
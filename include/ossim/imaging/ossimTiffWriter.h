@@ -52,6 +52,13 @@ public:
     * tiff_strip_band_separate
     * tiff_tiled
     * tiff_tiled_band_separate
+    * tiff_tiled_cog
+    *
+    * tiff_tiled_cog is a cloud optimized geotiff: contiguous tiles with
+    * internal overviews, all IFDs at the front of the file behind a GDAL
+    * style structural metadata (ghost) area, and the tile data following,
+    * smallest overview first and full resolution last, each tile on a
+    * 16 byte boundary.
     *
     * @param imageTypeList stl::vector<ossimString> list to append to.
     */   
@@ -168,6 +175,14 @@ protected:
     */
    bool writeToTiles();
 
+   /**
+    *  writeToTiles() for deflate and eight bit jpeg output with
+    *  theCompressionThreads > 1.  Tiles are compressed on a pool of that
+    *  many threads and written raw, in order, from the calling thread.
+    *  @return true on success, false on error.
+    */
+   bool writeToTilesCompressed();
+
    /**
     *  Writes image data to a tiled tiff band separate format.
     *  @return true on success, false on error.
@@ -185,6 +200,15 @@ protected:
     *  @return true on success, false on error.
     */
    bool writeToStripsBandSep();
+
+   /**
+    *  Writes a cloud optimized geotiff.  Full resolution is written to
+    *  "<output>.tmp" as tiff_tiled, internal overviews are added with
+    *  ossimTiffOverviewBuilder, and the file is then rewritten to theFilename
+    *  with the IFDs first and the tile data after them.
+    *  @return true on success, false on error.
+    */
+   bool writeCogFile();
    
    /**
     *  Writes tiff tags from ossimMapProjectionInfo to tiff file.
@@ -226,6 +250,7 @@ protected:
    ossimFilename           theLutFilename;
    bool                    theForceBigTiffFlag;
    bool                    theBigTiffFlag;
+   ossim_uint32            theCompressionThreads;
    mutable ossimRefPtr<ossimNBandToIndexFilter> theNBandToIndexFilter;
 TYPE_DATA
 };
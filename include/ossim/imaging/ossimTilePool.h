@@ -0,0 +1,144 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Size-class pool of recycled tile buffers used by ossimImageData.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimTilePool_HEADER
+#define ossimTilePool_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <OpenThreads/Mutex>
+#include <iosfwd>
+#include <map>
+#include <vector>
+
+//*************************************************************************************************
+//! Recycles the data buffers of ossimImageData tiles.
+//!
+//! Buffers are keyed by scalar type, band count and tile dimensions. When the last reference to
+//! an ossimImageData is released its buffer is handed back to the pool, and the next
+//! ossimImageData::initialize() of a tile with the same size class picks it up instead of
+//! calling the allocator. This keeps multi-megabyte tile allocations out of malloc when many
+//! threads are producing tiles through ossimImageDataFactory.
+//!
+//! The pool is split into stripes, each with its own lock and free lists. A thread always goes
+//! to the stripe selected by its thread id first, so worker threads do not contend with each
+//! other; a stripe that has no buffer of the requested class falls back to the other stripes
+//! before giving up. The total number of bytes held is capped (approximately: each stripe is
+//! given an equal share of the cap).
+//!
+//! On NUMA machines (see ossimThreadAffinity) the stripes are split evenly between the nodes. A
+//! thread uses a stripe of the node it runs on and steals from remote nodes last, so buffers
+//! first touched on a node tend to stay there.
+//!
+//! Preferences keywords:
+//!    tile_pool.enabled:  true|false (default true)
+//!    tile_pool.size:     Maximum pool size in megabytes (default 64)
+//*************************************************************************************************
+class OSSIM_DLL ossimTilePool
+{
+public:
+   //! Counters for monitoring the pool. All values are totals since the last resetStatistics().
+   struct Statistics
+   {
+      Statistics();
+      ossim_uint64 m_hits;        //!< acquire() calls satisfied from the pool.
+      ossim_uint64 m_misses;      //!< acquire() calls that found nothing to recycle.
+      ossim_uint64 m_returns;     //!< Buffers accepted back into the pool.
+      ossim_uint64 m_rejects;     //!< Buffers freed because the pool was full or disabled.
+      ossim_uint64 m_bytesHeld;   //!< Bytes currently held in free lists.
+      ossim_uint64 m_buffersHeld; //!< Buffers currently held in free lists.
+   };
+
+   static ossimTilePool* instance();
+
+   //! Gets a buffer for the given size class. On success the recycled buffer is swapped into
+   //! buffer (whose previous contents are released to the allocator) and true is returned. The
+   //! buffer contents are undefined; callers are expected to blank the tile.
+   bool acquire(ossimScalarType scalar,
+                ossim_uint32 bands,
+                ossim_uint32 width,
+                ossim_uint32 height,
+                std::vector<ossim_uint8>& buffer);
+
+   //! Hands a buffer back to the pool. On acceptance buffer is left empty. If the pool is full,
+   //! disabled, or the buffer size does not match the size class, the buffer is left untouched
+   //! and false is returned.
+   bool release(ossimScalarType scalar,
+                ossim_uint32 bands,
+                ossim_uint32 width,
+                ossim_uint32 height,
+                std::vector<ossim_uint8>& buffer);
+
+   //! Frees all held buffers.
+   void clear();
+
+   void setEnabled(bool flag);
+   bool isEnabled() const { return m_enabled; }
+
+   //! Sets the maximum number of bytes held by the pool. Excess buffers are freed immediately.
+   void setMaxBytes(ossim_uint64 maxBytes);
+   ossim_uint64 getMaxBytes() const { return m_maxBytes; }
+
+   Statistics getStatistics() const;
+   void resetStatistics();
+
+   std::ostream& print(std::ostream& out) const;
+
+protected:
+   ossimTilePool();
+   ~ossimTilePool();
+   ossimTilePool(const ossimTilePool&);
+   const ossimTilePool& operator=(const ossimTilePool&);
+
+   struct Key
+   {
+      Key(ossimScalarType scalar, ossim_uint32 bands, ossim_uint32 width, ossim_uint32 height)
+         : m_scalar(scalar), m_bands(bands), m_width(width), m_height(height) {}
+      bool operator<(const Key& rhs) const;
+      ossimScalarType m_scalar;
+      ossim_uint32    m_bands;
+      ossim_uint32    m_width;
+      ossim_uint32    m_height;
+   };
+
+   typedef std::vector< std::vector<ossim_uint8>* > FreeList;
+   typedef std::map<Key, FreeList> FreeListMap;
+
+   //! One independently locked portion of the pool.
+   struct Stripe
+   {
+      Stripe();
+      ~Stripe();
+      bool pop(const Key& key, std::vector<ossim_uint8>& buffer);
+      void trim(ossim_uint64 maxBytes);
+      void clear();
+
+      mutable OpenThreads::Mutex m_mutex;
+      FreeListMap  m_freeLists;
+      ossim_uint64 m_bytesHeld;
+      ossim_uint64 m_buffersHeld;
+      ossim_uint64 m_hits;
+      ossim_uint64 m_misses;
+      ossim_uint64 m_returns;
+      ossim_uint64 m_rejects;
+   };
+
+   //! Stripe owned by the calling thread.
+   ossim_uint32 stripeIndex() const;
+
+   ossim_uint64 stripeBudget() const;
+
+   static ossimTilePool* m_instance;
+
+   std::vector<Stripe*> m_stripes;
+   ossim_uint32         m_numberOfNodes; //!< Stripe i belongs to node i % m_numberOfNodes.
+   bool                 m_enabled;
+   ossim_uint64         m_maxBytes;
+};
+
+#endif /* #ifndef ossimTilePool_HEADER */
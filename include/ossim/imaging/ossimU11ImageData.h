@@ -52,8 +52,6 @@ public:
    bool isNull(ossim_uint32 offset)const;
    void setNull(ossim_uint32 offset);
 
-   virtual ossimDataObjectStatus validate() const;
-
    /*!
     * will go to the band and offset and compute the
     * normalized float and return it back to the
@@ -58,8 +58,6 @@ public:
     */
    void fill(double value);
 
-   virtual ossimDataObjectStatus validate() const;
-
    /*!
     * will go to the band and offset and compute the
     * normalized float and return it back to the
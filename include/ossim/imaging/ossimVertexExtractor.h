@@ -86,6 +86,25 @@ public:
     */
    virtual bool execute();
 
+   /*!
+    *  Finds the edges on the coarsest power of two res level of the input
+    *  first, then rescans each finer level only within a few pixels of the
+    *  edges of the level above.  A line found null on the coarser level,
+    *  with the lines around it, is taken as null, so valid areas smaller
+    *  than a pixel of the coarsest level can be missed.  Default false.
+    */
+   void setCoarseToFineFlag(bool flag);
+   bool getCoarseToFineFlag() const;
+
+   /*!
+    *  Sets the number of threads scanning groups of lines in coarse to fine
+    *  mode, when the input is an image handler with concurrent reads (see
+    *  ossimImageHandler::hasConcurrentReads).  0 is
+    *  ossim::getNumberOfThreads(); default 1.
+    */
+   void setNumberOfThreads(ossim_uint32 threads);
+   ossim_uint32 getNumberOfThreads() const;
+
    virtual ossimObject* getObjectInterface() { return this; }
 
    virtual ossimListenerManager* getListenerManagerInterface()
@@ -119,6 +138,12 @@ protected:
     */
    bool scanForEdges();
 
+   /*!
+    *  Coarse to fine scanForEdges (see setCoarseToFineFlag).
+    *  Returns true on success, false on error.
+    */
+   bool scanForEdgesCoarseToFine();
+
    /*!
     *  Extracts the vertices of the source.  Uses "theLeftEdge" and
     *  "theRightEdge" data members.
@@ -147,6 +172,8 @@ protected:
    vector<ossimIpt> theVertice;
    ossim_int32*     theLeftEdge;
    ossim_int32*     theRightEdge;
+   bool             theCoarseToFineFlag;
+   ossim_uint32     theNumberOfThreads;
 
    //! Disallow copy constructor and operator=
    ossimVertexExtractor(const ossimVertexExtractor&) {}
@@ -15,6 +15,7 @@
 #include <ossim/base/ossimString.h>
 #include <ossim/base/ossimGeoPolygon.h>
 #include <ossim/imaging/ossimGeoAnnotationObject.h>
+#include <ossim/imaging/ossimAnnotationObjectIndex.h>
 #include <ossim/vec/ossimVpfCoverage.h>
 #include <ossim/base/ossimFontInformation.h>
 
@@ -153,6 +154,12 @@ public:
   void transform(ossimImageGeometry* proj);
   void buildFeature();
   void deleteAllObjects();
+
+  /**
+   * Draws the objects whose bounds may intersect the tile, found with a
+   * grid index over their projected bounds.  The index is rebuilt on the
+   * first draw after the objects are built, transformed or restyled.
+   */
   void drawAnnotations(ossimRgbImage* tile);
 
   bool saveState(ossimKeywordlist& kwl,
@@ -181,6 +188,10 @@ protected:
    
   std::vector<ossimRefPtr<ossimGeoAnnotationObject> > theAnnotationArray;
 
+  ossimAnnotationObjectIndex    theObjectIndex;
+  bool                          theObjectIndexDirtyFlag;
+  std::vector<ossim_uint32>     theDrawList;
+
   void buildTxtFeature(const ossimFilename& table,
                        const ossimString&   tableKey,
                        const ossimFilename& primitive,
@@ -52,6 +52,15 @@ protected:
    void initializeChain();
    bool writeToFile(ossimImageFileWriter* writer);
 
+   /**
+    * Writes the products of theTiling concurrently, each job on its own
+    * clone of the product chain and writer (igen.tiling.product_threads,
+    * capped by igen.tiling.memory_budget).
+    * @return false if this does not apply and the products should be written
+    * one after the other.
+    */
+   bool outputTiledProducts(ossimImageFileWriter* writer);
+
    ossimRefPtr<ossimConnectableContainer> theContainer;
    ossimRefPtr<ossimMapProjection>  theProductProjection;
    ossimRefPtr<ossimImageChain>  theProductChain;
@@ -60,11 +69,14 @@ protected:
    bool              theBuildThumbnailFlag;
    ossimIpt          theThumbnailSize;
    long              theNumberOfTilesToBuffer;
+   bool              theDynamicSchedulingFlag;
    ossimKeywordlist  theKwl;
    bool              theTilingEnabled;
    bool              theProgressFlag;
    bool              theStdoutFlag;
    ossim_uint32      theThreadCount;
+   ossim_uint32      theProductThreads;      // tiling products written at once
+   ossim_uint64      theProductMemoryBudget; // bytes for those; 0 for no cap
 
 };
 
@@ -92,6 +92,15 @@ protected:
    //! after its creation. This is in support of shared image handlers. Returns TRUE if successful.
    bool connectSharedHandlers(ossim_uint32 index);
 
+   //! Lets each object of the cloned chain (identified by index) reference the read-only state
+   //! of its counterpart in the original chain (see ossimImageSource::shareReadOnlyState). Must
+   //! be called before the clone's IDs are made unique.
+   void shareOriginalState(ossim_uint32 index);
+
+   //! Returns TRUE if every image handler in the original chain serves concurrent reads, in which
+   //! case sharing them costs no serialization (see ossimImageHandler::hasConcurrentReads).
+   bool handlersHaveConcurrentReads();
+
    //! This is the adaptee image chain.
    ossimRefPtr<ossimImageChain> m_adaptedChain;
 
@@ -42,6 +42,13 @@ public:
    //! Intercepts the getTile call intended for the adaptee and sets a mutex lock around the
    //! adaptee's getTile call.
    virtual bool getTile(ossimImageData* result, ossim_uint32 resLevel=0);
+
+   //! Forwards the prefetch hint to the adaptee. Hints do not read through the adaptee's
+   //! tile state so no lock is needed.
+   virtual void prefetch(const std::vector<ossimIrect>& rects, ossim_uint32 resLevel=0);
+
+   //! Returns the I/O counts of the adaptee.
+   virtual bool getIoCounters(ossimIoCounters::Values& values) const;
    
    //! Method to save the state of an object to a keyword list.
    //! Return true if ok or false on error.
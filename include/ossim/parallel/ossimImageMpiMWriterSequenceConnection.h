@@ -16,18 +16,30 @@
 // a recieve and does no processing itself.  The slave connection does
 // all the actual work and processing.
 //
+// Receives are non-blocking: the master keeps numberOfTilesToBuffer
+// receives posted per slave so slaves never stall on their sends while
+// the writer is busy with the tile last returned by getNextTile.
+//
+// With dynamic scheduling enabled slaves ask the master for batches of
+// tiles instead of taking every (numberOfProcessors-1)th tile, so ranks
+// that land on cheap tiles pick up more work.  Batches shrink as the
+// sequence nears its end.  The slaves must use the same mode.
+//
 //*******************************************************************
 //  $Id: ossimImageMpiMWriterSequenceConnection.h 9094 2006-06-13 19:12:40Z dburken $
 #ifndef ossimImageMpiMWriterSequenceConnection_HEADER
 #define ossimImageMpiMWriterSequenceConnection_HEADER
 #include <ossim/imaging/ossimImageSourceSequencer.h>
+#include <vector>
 class ossimImageData;
 class ossimImageMpiMWriterSequenceConnection : public ossimImageSourceSequencer
 {
 public:
-   ossimImageMpiMWriterSequenceConnection(ossimObject* owner=NULL);
+   ossimImageMpiMWriterSequenceConnection(ossimObject* owner=NULL,
+                                          long numberOfTilesToBuffer = 2);
    ossimImageMpiMWriterSequenceConnection(ossimImageSource* inputSource,
-                                          ossimObject* owner=NULL);
+                                          ossimObject* owner=NULL,
+                                          long numberOfTilesToBuffer = 2);
   virtual ~ossimImageMpiMWriterSequenceConnection();
 
    /*!
@@ -48,11 +60,77 @@ public:
     * Will allow you to get the next tile in the sequence.
     */
    virtual ossimRefPtr<ossimImageData> getNextTile(ossim_uint32 resLevel=0);
+
+   /**
+    * @brief Enables handing tiles out to slaves on demand.  Must match
+    * ossimImageMpiSWriterSequenceConnection::setDynamicScheduling on the
+    * slaves.  Default is false, tile i goes to rank i%(processors-1)+1.
+    */
+   void setDynamicScheduling(bool flag);
+   bool getDynamicScheduling()const;
+
 protected:
+   /**
+    * Posts a receive for tileNumber into its slot of theOutputTiles if the
+    * tile is in the sequence.
+    */
+   void postReceive(ossim_int64 tileNumber);
+
+   /** Cancels any receives still outstanding. */
+   void cancelReceives();
+
+   /** Sets up tile assignment on the first getNextTile of a sequence. */
+   void startScheduling();
+
+   /**
+    * Replies to the work request from rank with the next batch of tiles,
+    * or an empty batch once all tiles are handed out.
+    */
+   void serviceWorkRequest(int rank);
+
+   /** Answers the final request of every slave still asking for work. */
+   void finishScheduling();
+
+   /** @return Size of the next batch, shrinking with the tiles left. */
+   ossim_int64 getBatchSize()const;
+
+   /** @return Rank the tile is assigned to. */
+   int getTileOwner(ossim_int64 tileNumber)const;
+
+   void deleteOutputTiles();
+
    int theNumberOfProcessors;
    int theRank;
    bool theNeedToSendRequest;
-   ossimRefPtr<ossimImageData> theOutputTile;
+   int theNumberOfTilesToBuffer;
+
+   /** Ring of receive buffers, tile n is received into slot n % size. */
+   std::vector< ossimRefPtr<ossimImageData> > theOutputTiles;
+
+   /**
+    * MPI_Request per slot of theOutputTiles, followed by the one for the
+    * pending work request.  Kept opaque since mpi.h is only included by
+    * the .cpp.
+    */
+   void* theRequests;
+
+   /** Next tile number needing a receive posted. */
+   ossim_int64 theNextReceiveTile;
+
+   bool theDynamicSchedulingFlag;
+   bool theSchedulingStartedFlag;
+
+   /** Next tile to hand out; all tiles are assigned up front when static. */
+   ossim_int64 theNextAssignTile;
+
+   /** Rank of each tile when scheduling dynamically. */
+   std::vector<int> theTileOwner;
+
+   /** Slaves that have not yet been sent an empty batch. */
+   int theActiveSlaves;
+
+   /** Receive buffer for work requests, holds the requesting rank. */
+   int theWorkRequestRank;
 
 TYPE_DATA
 };
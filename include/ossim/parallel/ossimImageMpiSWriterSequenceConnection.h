@@ -37,11 +37,27 @@ public:
    virtual ossimRefPtr<ossimImageData> getNextTile(ossim_uint32 resLevel=0);
 
    virtual void slaveProcessTiles();
+
+   /**
+    * @brief Enables asking the master for batches of tiles instead of
+    * taking every (numberOfProcessors-1)th tile.  Must match
+    * ossimImageMpiMWriterSequenceConnection::setDynamicScheduling on the
+    * master.  Default is false.
+    */
+   void setDynamicScheduling(bool flag);
+   bool getDynamicScheduling()const;
    
 protected:
+   /**
+    * Asks the master for the next batch of tiles.
+    * @return true if a non empty batch was assigned.
+    */
+   bool requestTiles(ossim_int64& start, ossim_int64& end);
+
    int theNumberOfProcessors;
    int theRank;
    int theNumberOfTilesToBuffer;
+   bool theDynamicSchedulingFlag;
    
    ossimRefPtr<ossimImageData>* theOutputTile;
 
@@ -12,6 +12,7 @@
 #include <OpenThreads/ScopedLock>
 #include <ossim/base/ossimRefPtr.h>
 #include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTimer.h>
 #include <list>
 
 class ossimJob;
@@ -71,7 +72,14 @@ public:
       ossimJob_ALL = (ossimJob_READY|ossimJob_RUNNING|ossimJob_CANCEL|ossimJob_FINISHED)
    };
    
-   ossimJob() : m_state(ossimJob_READY),  m_priority(0.0) {}
+   ossimJob()
+      : m_state(ossimJob_READY),
+        m_priority(0.0),
+        m_queuedTick(0),
+        m_startedTick(0),
+        m_finishedTick(0),
+        m_workerId(-1)
+   {}
 
    virtual void start()=0;
    
@@ -84,6 +92,10 @@ public:
       }
    }
 
+   /**
+    * Higher priority jobs are taken first by ossimJobQueue, equal priorities
+    * in the order added.  Only read when the job is added to a queue.
+    */
    void setPriority(double value)
    {
       OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_jobMutex);
@@ -253,6 +265,38 @@ public:
    }
    ossimJobCallback* callback() {return m_callback.get();}
 
+   /**
+    * Records job as the one run by the calling thread; 0 clears it.  Called
+    * by the job queue threads around start().
+    * @return The job previously recorded for the thread.
+    */
+   static ossimJob* setCurrentJob(ossimJob* job);
+
+   /**
+    * @return true if the job run by the calling thread has been canceled.
+    * Long getTile paths poll this between input tiles to give up early on
+    * work nobody wants anymore.  Always false off the job queue threads.
+    */
+   static bool isCurrentJobCanceled();
+
+   /**
+    * Timing, stamped by the job queues and accumulated by ossimJobStatistics.
+    * markStarted records the OpenThreads id of the calling thread as the
+    * worker id.
+    */
+   void markQueued();
+   void markStarted();
+   void markFinished();
+
+   /** @return Seconds between being queued and started, 0 if either is unknown. */
+   double waitTime()const;
+
+   /** @return Seconds between being started and finished, 0 if either is unknown. */
+   double runTime()const;
+
+   /** @return Id of the thread that ran the job, -1 if not run. */
+   ossim_int32 workerId()const { return m_workerId; }
+
 protected:
    mutable OpenThreads::Mutex m_jobMutex;
    ossimString m_name;
@@ -260,6 +304,10 @@ protected:
    ossimString m_id;
    State       m_state;
    double      m_priority;
+   ossimTimer::Timer_t m_queuedTick;
+   ossimTimer::Timer_t m_startedTick;
+   ossimTimer::Timer_t m_finishedTick;
+   ossim_int32 m_workerId;
    ossimRefPtr<ossimJobCallback> m_callback;
 };
 
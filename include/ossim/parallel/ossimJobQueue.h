@@ -9,11 +9,15 @@
 #define ossimJobQueue_HEADER
 
 #include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobStatistics.h>
 #include <OpenThreads/Block>
 
 //*************************************************************************************************
 //! Class for maintaining an ordered list of jobs to be processed. As the jobs are completed and
-//! the product consumed, the jobs are removed from this list
+//! the product consumed, the jobs are removed from this list.
+//!
+//! Jobs are ordered by ossimJob::priority(), highest first, and in the order added among equal
+//! priorities. Canceled jobs are dropped by nextJob() without being run.
 //*************************************************************************************************
 class OSSIM_DLL ossimJobQueue : public ossimReferenced
 {
@@ -34,6 +38,12 @@ public:
    virtual ossimRefPtr<ossimJob> removeById(const ossimString& id);
    virtual void remove(const ossimJob* Job);
    virtual void removeStoppedJobs();
+
+   /**
+    * Removes the canceled jobs still waiting in the queue, marking them finished.  Lets a client
+    * that canceled many jobs free them right away instead of when they reach the front.
+    */
+   virtual void removeCanceledJobs();
    virtual void clear();
    virtual ossimRefPtr<ossimJob> nextJob(bool blockIfEmptyFlag=true);
    virtual void releaseBlock();
@@ -41,6 +51,9 @@ public:
    ossim_uint32 size();
    void setCallback(Callback* c);
    Callback* callback();
+
+   /** @return Wait and run times of the jobs of this queue, see ossimJobStatistics. */
+   ossimJobStatistics* getStatistics();
    
 protected:
    ossimJob::List::iterator findById(const ossimString& id);
@@ -53,6 +66,7 @@ protected:
    OpenThreads::Block m_block;
    ossimJob::List m_jobQueue;
    ossimRefPtr<Callback> m_callback;
+   ossimRefPtr<ossimJobStatistics> m_statistics;
 };
 
 #endif
@@ -0,0 +1,102 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Per job name wait and run time histograms for the job queues.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimJobStatistics_HEADER
+#define ossimJobStatistics_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimReferenced.h>
+#include <ossim/base/ossimString.h>
+#include <OpenThreads/Mutex>
+#include <iosfwd>
+#include <map>
+
+class ossimJob;
+class ossimKeywordlist;
+
+//*************************************************************************************************
+//! Accumulates the queue wait and run times of finished jobs, keyed by job name.
+//!
+//! ossimJobQueue and ossimJobWorkStealingQueue each keep one for their own jobs, and every job
+//! is also added to the process wide instance() that applications dump at the end of a run.
+//! Times go in power of two buckets of microseconds. Jobs without a name are counted under
+//! "unnamed".
+//!
+//! Collection is off unless the preferences keyword job_statistics.enabled is true, or
+//! setEnabled(true) is called; the queues then only stamp the jobs' ticks.
+//!
+//! saveState writes, per name:
+//!    <prefix><name>.count:           Jobs finished.
+//!    <prefix><name>.wait.mean_ms:    Mean time queued before a worker took the job.
+//!    <prefix><name>.wait.max_ms:
+//!    <prefix><name>.wait.histogram:  "<bucket upper bound in us>:<count> ..." non empty buckets.
+//!    <prefix><name>.run.mean_ms:     Mean time in ossimJob::start().
+//!    <prefix><name>.run.max_ms:
+//!    <prefix><name>.run.total_s:
+//!    <prefix><name>.run.histogram:
+//!    <prefix><name>.workers:         "<worker id>:<count> ..." jobs run by each thread.
+//*************************************************************************************************
+class OSSIM_DLL ossimJobStatistics : public ossimReferenced
+{
+public:
+   enum
+   {
+      NUMBER_OF_BUCKETS = 32 //!< Bucket i holds times below 2^(i+1) microseconds.
+   };
+
+   //! Time distribution of one phase (wait or run).
+   struct Histogram
+   {
+      Histogram();
+      void add(double seconds);
+      ossim_uint64 m_count;
+      double       m_total; //!< Seconds.
+      double       m_max;   //!< Seconds.
+      ossim_uint64 m_buckets[NUMBER_OF_BUCKETS];
+   };
+
+   //! Everything recorded for one job name.
+   struct Entry
+   {
+      Histogram m_wait;
+      Histogram m_run;
+      std::map<ossim_int32, ossim_uint64> m_workers;
+   };
+
+   ossimJobStatistics();
+
+   //! Process wide statistics, fed by every queue.
+   static ossimJobStatistics* instance();
+
+   //! @return true if the queues are collecting.
+   static bool isEnabled();
+   static void setEnabled(bool flag);
+
+   //! Adds the times of a finished job.
+   void record(const ossimJob* job);
+
+   //! Adds job to this and to instance(); does nothing if collection is off.
+   static void recordFinished(ossimJobStatistics* queueStatistics, const ossimJob* job);
+
+   void clear();
+
+   std::map<ossimString, Entry> getEntries() const;
+
+   bool saveState(ossimKeywordlist& kwl, const char* prefix=0) const;
+
+   std::ostream& print(std::ostream& out) const;
+
+protected:
+   virtual ~ossimJobStatistics();
+
+   mutable OpenThreads::Mutex   m_mutex;
+   std::map<ossimString, Entry> m_entries;
+};
+
+#endif /* #ifndef ossimJobStatistics_HEADER */
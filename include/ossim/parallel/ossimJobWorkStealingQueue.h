@@ -0,0 +1,99 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimJobWorkStealingQueue_HEADER
+#define ossimJobWorkStealingQueue_HEADER
+
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobStatistics.h>
+#include <OpenThreads/Atomic>
+#include <OpenThreads/Condition>
+#include <OpenThreads/Mutex>
+#include <deque>
+#include <vector>
+
+//*************************************************************************************************
+//! Runs ossimJobs on a fixed set of worker threads with one job deque per worker.
+//!
+//! Jobs added from a worker (e.g. by the finished() callback of the job it is running) go on that
+//! worker's own deque; jobs added from any other thread are dealt round robin across the deques.
+//! A worker runs its newest job first and, when its deque is empty, steals the oldest job of
+//! another worker. There is no global lock: each deque has its own mutex and the counters are
+//! atomic, so the queue itself does not serialize fine grained jobs on many core machines as the
+//! single list of ossimJobQueue does.
+//!
+//! Job states and callbacks are handled as by ossimJobThreadQueue, so any ossimJob runs as is.
+//*************************************************************************************************
+class OSSIM_DLL ossimJobWorkStealingQueue : public ossimReferenced
+{
+public:
+   //! @param nThreads Number of worker threads, 0 for ossim::getNumberOfThreads().
+   ossimJobWorkStealingQueue(ossim_uint32 nThreads=0);
+
+   //! Queues job to be run. Canceled jobs are marked finished and skipped.
+   void add(ossimJob* job);
+
+   //! Removes all jobs not yet started. Running jobs are not affected.
+   void clear();
+
+   //! Blocks until every job added has finished. Must not be called from a job.
+   void waitForCompletion();
+
+   //! @return true if any job added has not finished, queued or running.
+   bool hasJobsToProcess() const;
+
+   ossim_uint32 numberOfBusyThreads() const;
+   ossim_uint32 getNumberOfThreads() const;
+
+   //! @return Wait and run times of the jobs of this queue, see ossimJobStatistics.
+   ossimJobStatistics* getStatistics();
+
+protected:
+   //! Waits for the running jobs to finish, drops the others and stops the workers.
+   virtual ~ossimJobWorkStealingQueue();
+
+private:
+   class Worker;
+
+   struct JobDeque
+   {
+      OpenThreads::Mutex                  m_mutex;
+      std::deque< ossimRefPtr<ossimJob> > m_jobs;
+   };
+
+   //! Worker loop.
+   void run(ossim_uint32 index);
+
+   //! Newest job of the worker's own deque.
+   ossimRefPtr<ossimJob> popJob(ossim_uint32 index);
+
+   //! Oldest job of the first other deque that has one.
+   ossimRefPtr<ossimJob> stealJob(ossim_uint32 thief);
+
+   void runJob(ossimJob* job);
+
+   //! Called once a job is finished or dropped.
+   void jobDone();
+
+   //! @return Index of the calling worker or -1 if not called from a worker.
+   ossim_int32 currentWorker() const;
+
+   std::vector<JobDeque*>  m_deques;
+   std::vector<Worker*>    m_workers;
+   OpenThreads::Atomic     m_nextDeque;   //!< Round robin for adds from outside.
+   OpenThreads::Atomic     m_queued;      //!< Jobs in the deques.
+   OpenThreads::Atomic     m_outstanding; //!< Jobs added and not yet finished.
+   OpenThreads::Atomic     m_busy;        //!< Workers running a job.
+   OpenThreads::Atomic     m_sleepers;    //!< Workers waiting for work.
+   mutable OpenThreads::Mutex m_sleepMutex;
+   OpenThreads::Condition  m_workCondition;
+   OpenThreads::Condition  m_idleCondition;
+   volatile bool           m_doneFlag;
+   ossimRefPtr<ossimJobStatistics> m_statistics;
+};
+
+#endif
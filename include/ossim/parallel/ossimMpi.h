@@ -16,6 +16,14 @@
 class OSSIM_DLL ossimMpi
 {
 public:
+   /** Message tags used between the master and slave writer connections. */
+   enum MessageTag
+   {
+      TILE_TAG         = 0, ///< Tile data, slave to master.
+      WORK_REQUEST_TAG = 1, ///< Slave asks the master for a batch of tiles.
+      WORK_ASSIGN_TAG  = 2  ///< Master replies with { start, count }.
+   };
+
    static ossimMpi* instance();
 
    ossim_float64 getTime()const;
@@ -13,8 +13,9 @@
 #include <ossim/imaging/ossimImageSourceSequencer.h>
 #include <ossim/base/ossimIpt.h>
 #include <ossim/base/ossimConnectableObjectListener.h>
-#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <ossim/parallel/ossimJobWorkStealingQueue.h>
 #include <ossim/parallel/ossimImageChainMtAdaptor.h>
+#include <OpenThreads/Block>
 #include <OpenThreads/Thread>
 
 //*************************************************************************************************
@@ -46,6 +47,13 @@ public:
    //! Fetches the number of threads being used. Useful when this object decides the quantity.
    ossim_uint32 getNumberOfThreads() const { return m_numThreads; }
 
+   //! Sets the maximum number of tiles in flight: queued, being fetched, or fetched and waiting
+   //! for getNextTile(). Workers stop launching jobs (without blocking) once the window is full
+   //! and resume as the caller takes tiles. 0 (the default) uses 8 tiles per thread, or the
+   //! preferences keyword "sequencer.output_window" if set. Takes effect at the next
+   //! setToStartOfSequence(); never less than twice the number of threads.
+   void setOutputWindow(ossim_uint32 tiles);
+
    //! Accessed for performance logging.
    ossim_uint32 maxCacheSize() const { return m_maxCacheSize; }
 
@@ -63,8 +71,13 @@ public:
 
 protected:
 
-   // Associates a job with a tile ID for quick access to its tile data when finished:
-   typedef std::map<ossim_uint32 /*tile_ID*/, ossimRefPtr<ossimImageData> >  TileCache;
+   //---
+   // Finished tiles waiting for getNextTile(), one slot per tile of the output window. In ordered
+   // mode tile ID i goes in slot i % window (a tile is only launched once the tile a window
+   // before it was taken, so its slot is free). In unordered mode the ring is a FIFO of tiles in
+   // completion order.
+   //---
+   typedef std::vector< ossimRefPtr<ossimImageData> > TileRing;
 
    //! Private class representing a getTile job.
    class ossimGetTileJob : public ossimJob
@@ -74,7 +87,10 @@ protected:
          :  m_tileID(tile_id), 
             m_chainID(chain_id), 
             m_sequencer(sequencer),
-            t_launchNewJob(true) {}
+            t_launchNewJob(true)
+      {
+         setName("ossimMultiThreadSequencer.getTile");
+      }
 
       virtual void start();
 
@@ -100,35 +116,44 @@ protected:
       }
    };
 
-   //! Queues up the optimum amount of jobs given the availability of thread chains and space in
-   //! the output tile cache.
-   void initJobs();
-
    //! Access method to tile cache with scope lock to avoid multiple threads writing to
    //! the cache simultaneously. 
    //! NOTE: chain_id being passed only for debug. To be removed.
    void setTileInCache(ossim_uint32 tile_id, ossimImageData* tile, ossim_uint32 chain_id, double dt /*for debug*/);
 
-   //! Method to job queue with scope lock to avoid multiple threads modifying the queue
-   //! simultaneously.
+   //! Queues the next tile's job on chain_id if the output window has room, otherwise parks the
+   //! chain until getNextTile() frees a slot.
    void nextJob(ossim_uint32 chain_id);
 
+   //! Relaunches parked chains while the output window has room. Called after a tile is taken.
+   void launchIdleChains();
+
+   //! True if the job for tile m_nextTileID fits the output window and, over the ossimImageData
+   //! memory budget, is the tile the caller waits for. Call with m_cacheMutex locked.
+   bool windowHasRoom() const;
+
+   //! Queues the job for tile m_nextTileID on chain_id. Call with m_cacheMutex locked.
+   void launchJob(ossim_uint32 chain_id);
+
    //! For debug -- thread-safe console output
    void print(ostringstream& msg) const;
 
    ossimRefPtr<ossimImageChainMtAdaptor> m_inputChain; //!< Same as base class' theInputConnection
-   ossimRefPtr<ossimJobMultiThreadQueue> m_jobMtQueue;
+   ossimRefPtr<ossimJobWorkStealingQueue> m_jobMtQueue;
    ossim_uint32                          m_numThreads;
    ossimRefPtr<ossimGetTileCallback>     m_callback;
    ossim_uint32                          m_nextTileID; //!< ID of next tile to be threaded, different from base class' theCurrentTileNumber
-   TileCache                             m_tileCache;  //!< Saves tiles output by threaded jobs
-   ossim_uint32                          m_maxCacheSize;
+   TileRing                              m_tileRing;   //!< Saves tiles output by threaded jobs
+   ossim_uint32                          m_ringHead;   //!< Oldest tile in unordered mode
+   ossim_uint32                          m_ringCount;  //!< Tiles in the ring
+   std::vector<ossim_uint32>             m_idleChains; //!< Chains parked on a full window
+   bool                                  m_orderedFlag; //!< Output order of the current sequence
+   ossim_uint32                          m_maxCacheSize; //!< Output window, in tiles
    ossim_uint32                          m_maxTileCacheFactor;
+   ossim_uint32                          m_outputWindow; //!< Requested window, 0 for default
    mutable OpenThreads::Mutex            m_cacheMutex;   
-   mutable OpenThreads::Mutex            m_jobMutex;   
    ossim_uint32                          m_totalNumberOfTiles;
    OpenThreads::Block                    m_getTileBlock; //<! Blocks execution of main thread while waiting for tile to become available
-   OpenThreads::Block                    m_nextJobBlock; //<! Blocks execution of worker threads
 
    // FOR DEBUG:
    mutable OpenThreads::Mutex d_printMutex;
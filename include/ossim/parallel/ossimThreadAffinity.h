@@ -0,0 +1,70 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Cpu affinity and NUMA node placement of the job queue worker threads.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimThreadAffinity_HEADER
+#define ossimThreadAffinity_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <OpenThreads/Atomic>
+#include <vector>
+
+//*************************************************************************************************
+//! Hands out cpus to worker threads so they stay on one core, and one NUMA node, for their life.
+//!
+//! ossimJobMultiThreadQueue and ossimJobWorkStealingQueue give each new worker the cpu returned
+//! by nextWorkerCpu() before starting it. Pinned workers allocate (and first touch) their tiles
+//! on their own node, and ossimTilePool hands recycled buffers back to threads of the node they
+//! came from first.
+//!
+//! Cpus are taken from thread_affinity.cpus, or all cpus, ordered by NUMA node. The "compact"
+//! policy fills one node before the next so a small pool shares a single L3; "scatter" takes
+//! one cpu of each node in turn to use every memory controller. NUMA nodes are read from
+//! /sys/devices/system/node on Linux; elsewhere all cpus count as node 0.
+//!
+//! Preferences keywords:
+//!    thread_affinity:       none|compact|scatter (default none)
+//!    thread_affinity.cpus:  Cpu list, e.g. 0-7,16-23 (default all)
+//*************************************************************************************************
+class OSSIM_DLL ossimThreadAffinity
+{
+public:
+   static ossimThreadAffinity* instance();
+
+   //! @return true if worker threads are to be pinned.
+   bool isEnabled() const { return !m_cpus.empty(); }
+
+   //! @return Cpu for the next worker thread, rotating through the cpu list, or -1 when
+   //! affinity is off.
+   ossim_int32 nextWorkerCpu();
+
+   //! @return NUMA node of cpu, 0 if unknown.
+   ossim_uint32 getNode(ossim_int32 cpu) const;
+
+   ossim_uint32 getNumberOfNodes() const { return m_numberOfNodes; }
+
+   //! @return NUMA node the calling thread is running on, 0 if unknown.
+   ossim_uint32 getCurrentNode() const;
+
+protected:
+   ossimThreadAffinity();
+   ossimThreadAffinity(const ossimThreadAffinity&);
+   const ossimThreadAffinity& operator=(const ossimThreadAffinity&);
+
+   //! Fills m_cpuNodes from sysfs.
+   void readNodes(ossim_uint32 numberOfCpus);
+
+   static ossimThreadAffinity* m_instance;
+
+   std::vector<ossim_uint32> m_cpuNodes;    //!< Node of each cpu.
+   std::vector<ossim_int32>  m_cpus;        //!< Cpus in the order given to workers.
+   ossim_uint32              m_numberOfNodes;
+   OpenThreads::Atomic       m_nextWorker;
+};
+
+#endif /* #ifndef ossimThreadAffinity_HEADER */
@@ -1,11 +1,14 @@
 #ifndef ossimSharedPluginRegistry_HEADER
 #define ossimSharedPluginRegistry_HEADER
 #include <iostream>
+#include <map>
+#include <set>
 #include <vector>
 #include <ossim/plugin/ossimSharedObjectBridge.h>
 #include <ossim/base/ossimFilename.h>
 #include <ossim/base/ossimRefPtr.h>
 #include <ossim/plugin/ossimPluginLibrary.h>
+#include <OpenThreads/ReentrantMutex>
 
 class OSSIMDLLEXPORT ossimSharedPluginRegistry
 {
@@ -35,14 +38,87 @@ public:
    bool isLoaded(const ossimFilename& filename) const;
    
    void printAllPluginInformation(std::ostream& out);
+
+   /**
+    * Keywords of a plugin manifest, a keyword list beside the library named
+    * as the library with a "manifest" extension, e.g.
+    * libossim_gdal_plugin.manifest, telling what the plugin provides without
+    * loading it.  Values are space separated lists:
+    *
+    *    description: GDAL image reader and writer plugin
+    *    extensions:  ecw hdf img jp2 ntf sid tif tiff
+    *    projections: ossimGdalModel
+    *    utilities:   gdal-info
+    *    classes:     ossimGdalTileSource ossimGdalWriter
+    *
+    * extensions are the image files read or written, projections the
+    * projection and sensor model type names, utilities the ossimUtility
+    * names and classes any other type names its object factories create.
+    */
+   static const char* MANIFEST_DESCRIPTION_KW;
+   static const char* MANIFEST_EXTENSIONS_KW;
+   static const char* MANIFEST_PROJECTIONS_KW;
+   static const char* MANIFEST_UTILITIES_KW;
+   static const char* MANIFEST_CLASSES_KW;
+
+   /** @return The manifest file of plugin. */
+   static ossimFilename getManifestFilename(const ossimFilename& plugin);
+
+   /**
+    * Records the plugin for loading on first demand if it has a manifest,
+    * see MANIFEST_EXTENSIONS_KW.  The library is not opened.
+    *
+    * @return true if deferred now or before, false if it is already loaded
+    * or has no readable manifest, in which case registerPlugin should be
+    * used.
+    */
+   bool registerDeferredPlugin(const ossimFilename& filename,
+                               const ossimString& options="");
+
+   /**
+    * Loads the deferred plugins whose manifest lists value, compared without
+    * case, under keyword key.  Called by the factory registries before a
+    * lookup by name or extension.
+    *
+    * @return true if any plugin was loaded.
+    */
+   bool loadDeferredPlugins(const ossimString& key, const ossimString& value);
+
+   /**
+    * Loads all deferred plugins, e.g. before listing every supported type or
+    * after a lookup that no manifest answered failed.
+    *
+    * @return true if any plugin was loaded.
+    */
+   bool loadAllDeferredPlugins();
+
+   ossim_uint32 getNumberOfDeferredPlugins()const;
    
 protected:
    ossimSharedPluginRegistry();
    ossimSharedPluginRegistry(const ossimSharedPluginRegistry&){}
    void operator = (const ossimSharedPluginRegistry&){}
 
+   /** A plugin known from its manifest and not yet loaded. */
+   struct DeferredPlugin
+   {
+      ossimFilename theFilename;
+      ossimString   theOptions;
+      ossimString   theDescription;
+
+      /** Downcased values by manifest keyword. */
+      std::map<ossimString, std::set<ossimString> > theProvides;
+   };
+
+   /** Loads deferred plugins matching key and value, all if key is empty. */
+   bool loadDeferred(const ossimString& key, const ossimString& value);
+
    //static ossimSharedPluginRegistry* theInstance;   
    std::vector<ossimRefPtr<ossimPluginLibrary> > theLibraryList;
+   std::vector<DeferredPlugin> theDeferredList;
+
+   /** Reentrant: initializing a plugin may look up plugins itself. */
+   mutable OpenThreads::ReentrantMutex theMutex;
 };
 
 #endif
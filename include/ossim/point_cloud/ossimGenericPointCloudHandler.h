@@ -18,9 +18,25 @@
 
 using namespace std;
 
+/***************************************************************************************************
+ * Point cloud held in memory: either the points given to the constructor, or those of an ASCII
+ * point file (XYZ, CSV, etc.) read by open().
+ *
+ * Text lines hold numbers separated by blanks, commas or semicolons; lines without at least three
+ * numbers (headers, comments, point counts) are skipped. The columns are X (lon or easting),
+ * Y (lat or northing), Z, then by the number of columns of the first point line:
+ *
+ *    4: Intensity          6: Red Green Blue          7: Intensity Red Green Blue
+ *
+ * Other columns are ignored. The file is memory mapped and split on line boundaries into chunks
+ * parsed in parallel straight into column storage. Unless the "point_cloud.text_sidecar"
+ * preference is false, the columns are then saved to a binary sidecar (@see getSidecarFile) that
+ * later opens of the same file read instead of parsing.
+ **************************************************************************************************/
 class OSSIM_DLL ossimGenericPointCloudHandler : public ossimPointCloudHandler
 {
 public:
+   ossimGenericPointCloudHandler();
    ossimGenericPointCloudHandler(vector<ossimEcefPoint>& ecef_points);
    ossimGenericPointCloudHandler(vector<ossimGpt>& ground_points);
    virtual ~ossimGenericPointCloudHandler();
@@ -28,13 +44,35 @@ public:
    virtual void getFileBlock(ossim_uint32 offset,
                              ossimPointBlock& block,
                              ossim_uint32 maxNumPoints=0xFFFFFFFF)const;
+   virtual void getFileBlock(ossim_uint32 offset,
+                             ossimPointColumnBlock& block,
+                             ossim_uint32 maxNumPoints=0xFFFFFFFF)const;
    virtual ossim_uint32 getFieldCode() const;
+
+   /** Reads an ASCII point file, or its sidecar if current. */
    virtual bool open(const ossimFilename& pointsFile);
    virtual void close();
 
+   /** @return <file>.pcb */
+   static ossimFilename getSidecarFile(const ossimFilename& pointsFile);
+
 protected:
-   ossimGenericPointCloudHandler() {}
-   ossimPointBlock m_pointBlock;
+   /** Parses the text into m_points. False if no line has three numbers. */
+   bool parseText(const char* data, ossim_uint64 size);
+
+   /** Writes m_points to the sidecar, tagged with the size of the text file. */
+   bool saveSidecar(const ossimFilename& sidecar, ossim_int64 fileSize) const;
+
+   /** Reads m_points from the sidecar if it was made for a text file of fileSize bytes. */
+   bool loadSidecar(const ossimFilename& sidecar, ossim_int64 fileSize);
+
+   /** Sets the min/max records and the geometry from the points. */
+   void initBounds();
+
+   ossimPointColumnBlock m_points;
+   ossim_uint32 m_fieldCode;
+
+TYPE_DATA
 };
 
-#endif /* #ifndef ossimPdalReader_HEADER */
+#endif /* #ifndef ossimGenericPointCloudHandler_HEADER */
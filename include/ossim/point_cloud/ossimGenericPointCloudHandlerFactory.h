@@ -0,0 +1,40 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimGenericPointCloudHandlerFactory_HEADER
+#define ossimGenericPointCloudHandlerFactory_HEADER 1
+
+#include <ossim/point_cloud/ossimPointCloudHandlerFactory.h>
+
+/**
+ * Opens ASCII point files (*.xyz, *.txt, *.csv, *.pts) with ossimGenericPointCloudHandler.
+ * Registered by ossimPointCloudHandlerRegistry.
+ */
+class OSSIMDLLEXPORT ossimGenericPointCloudHandlerFactory : public ossimPointCloudHandlerFactory
+{
+public:
+   virtual ~ossimGenericPointCloudHandlerFactory();
+
+   static ossimGenericPointCloudHandlerFactory* instance();
+
+   virtual ossimPointCloudHandler* open(const ossimFilename& fileName) const;
+   virtual ossimPointCloudHandler* open(const ossimKeywordlist& kwl, const char* prefix = 0) const;
+
+   virtual ossimObject* createObject(const ossimString& typeName) const;
+
+   virtual void getTypeNameList(std::vector<ossimString>& typeList) const;
+
+   virtual void getSupportedExtensions(std::vector<ossimString>& extList) const;
+
+protected:
+   ossimGenericPointCloudHandlerFactory() {}
+   static ossimGenericPointCloudHandlerFactory* m_instance;
+
+TYPE_DATA
+};
+
+#endif /* #ifndef ossimGenericPointCloudHandlerFactory_HEADER */
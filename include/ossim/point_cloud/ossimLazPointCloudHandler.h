@@ -0,0 +1,104 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimLazPointCloudHandler_HEADER
+#define ossimLazPointCloudHandler_HEADER 1
+
+#include <ossim/point_cloud/ossimPointCloudHandler.h>
+#include <ossim/point_cloud/ossimPointColumnBlock.h>
+#include <ossim/support_data/ossimLasHdr.h>
+#include <OpenThreads/Mutex>
+#include <list>
+#include <map>
+#include <vector>
+
+class LASzip;
+
+/***************************************************************************************************
+ * Point cloud handler reading LASzip compressed LAS (*.laz) files, point formats 0 to 5, without
+ * decompressing them to disk.
+ *
+ * A LAZ file is compressed in independent chunks of points, and its chunk table gives the file
+ * offset of each, so any chunk can be decoded without the ones before it. This handler decodes
+ * whole chunks on demand: getFileBlock() decodes the chunks it spans that are not cached, on
+ * several threads, each with its own decoder, and keeps the most recently used chunks (the
+ * "point_cloud.laz_cache_chunks" preference, default 16) as column blocks. The spatial index is
+ * built on the same chunks, so getBlock() decodes only the chunks under its bounds.
+ *
+ * Positions are the scaled and offset LAS X, Y, Z. They are taken as geographic when the header
+ * bounds are inside lon/lat range, otherwise as map coordinates.
+ *
+ * Requires OSSIM built with LASzip (OSSIM_HAS_LASZIP); otherwise open() always fails.
+ **************************************************************************************************/
+class OSSIM_DLL ossimLazPointCloudHandler : public ossimPointCloudHandler
+{
+public:
+   ossimLazPointCloudHandler();
+   virtual ~ossimLazPointCloudHandler();
+
+   virtual bool open(const ossimFilename& lazFile);
+   virtual void close();
+
+   virtual ossim_uint32 getNumPoints() const;
+   virtual ossim_uint32 getFieldCode() const;
+
+   virtual void getFileBlock(ossim_uint32 offset,
+                             ossimPointBlock& block,
+                             ossim_uint32 maxNumPoints=0xFFFFFFFF) const;
+   virtual void getFileBlock(ossim_uint32 offset,
+                             ossimPointColumnBlock& block,
+                             ossim_uint32 maxNumPoints=0xFFFFFFFF) const;
+
+   /** @return The points per compressed chunk, so index chunks line up with LAZ chunks. */
+   virtual ossim_uint32 getIndexChunkSize() const;
+
+   /** Decodes chunk into block (cleared first). Used by the decoding threads. */
+   bool decodeChunk(ossim_uint32 chunk, ossimPointColumnBlock& block) const;
+
+protected:
+   /** One open stream and LASzip decoder; pooled so threads do not share one. */
+   class Decoder;
+
+   typedef std::vector< ossimRefPtr<ossimPointColumnBlock> > ChunkList;
+
+   /**
+    * Sets chunks to blocks [first, last], from the cache or else decoded in parallel, and caches
+    * the decoded ones.
+    */
+   void getChunks(ossim_uint32 first, ossim_uint32 last, ChunkList& chunks) const;
+
+   Decoder* acquireDecoder() const;
+   void releaseDecoder(Decoder* decoder) const;
+
+   /** Reads the LASzip VLR. Stream is just past the header. */
+   bool readLaszipVlr(std::istream& in);
+
+   /** Fills block from numRecords raw LAS point records, stride bytes apart. */
+   void decodeRecords(const ossim_uint8* records, ossim_uint32 stride, ossim_uint32 firstId,
+                      ossim_uint32 numRecords, ossimPointColumnBlock& block) const;
+
+   ossim_uint32 getNumChunks() const;
+
+   ossimLasHdr                    m_hdr;
+   LASzip*                        m_laszip;
+   ossim_uint32                   m_numPoints;
+   ossim_uint32                   m_chunkSize;
+   ossim_uint8                    m_pointFormat; // compression bits cleared
+   ossim_uint32                   m_fieldCode;
+
+   mutable std::vector<Decoder*>  m_decoders; // idle decoders
+   mutable OpenThreads::Mutex     m_decoderMutex;
+
+   ossim_uint32                   m_maxCachedChunks;
+   mutable std::map<ossim_uint32, ossimRefPtr<ossimPointColumnBlock> > m_chunkCache;
+   mutable std::list<ossim_uint32> m_lru; // cached chunk ids, most recent first
+   mutable OpenThreads::Mutex     m_cacheMutex;
+
+TYPE_DATA
+};
+
+#endif /* #ifndef ossimLazPointCloudHandler_HEADER */
@@ -0,0 +1,37 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimLazPointCloudHandlerFactory_HEADER
+#define ossimLazPointCloudHandlerFactory_HEADER 1
+
+#include <ossim/point_cloud/ossimPointCloudHandlerFactory.h>
+
+/** Opens *.laz files with ossimLazPointCloudHandler. Registered by ossimPointCloudHandlerRegistry. */
+class OSSIMDLLEXPORT ossimLazPointCloudHandlerFactory : public ossimPointCloudHandlerFactory
+{
+public:
+   virtual ~ossimLazPointCloudHandlerFactory();
+
+   static ossimLazPointCloudHandlerFactory* instance();
+
+   virtual ossimPointCloudHandler* open(const ossimFilename& fileName) const;
+   virtual ossimPointCloudHandler* open(const ossimKeywordlist& kwl, const char* prefix = 0) const;
+
+   virtual ossimObject* createObject(const ossimString& typeName) const;
+
+   virtual void getTypeNameList(std::vector<ossimString>& typeList) const;
+
+   virtual void getSupportedExtensions(std::vector<ossimString>& extList) const;
+
+protected:
+   ossimLazPointCloudHandlerFactory() {}
+   static ossimLazPointCloudHandlerFactory* m_instance;
+
+TYPE_DATA
+};
+
+#endif /* #ifndef ossimLazPointCloudHandlerFactory_HEADER */
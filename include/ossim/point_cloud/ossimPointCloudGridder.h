@@ -0,0 +1,156 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimPointCloudGridder_HEADER
+#define ossimPointCloudGridder_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageGeometry.h>
+#include <ossim/imaging/ossimImageSource.h>
+#include <ossim/point_cloud/ossimPointCloudHandler.h>
+#include <OpenThreads/Condition>
+#include <OpenThreads/Mutex>
+#include <map>
+#include <set>
+#include <vector>
+
+class ossimPointCloudGridderThread;
+
+/***************************************************************************************************
+ * Grids the heights of a point cloud into a single band float DEM in the pixel space of a map
+ * projected geometry. Each output tile is gridded on its own from the points of the tile plus a
+ * halo of getHalo() pixels around it (fetched with the handler's spatial index), so tiles are
+ * independent and are gridded on several threads:
+ *
+ *   MIN_Z, MAX_Z, MEAN_Z  lowest, highest or mean height of the points in each pixel
+ *   IDW                   inverse distance (squared) weighted mean of the nearest points, searched
+ *                         in growing rings of pixels out to the halo
+ *   TIN                   linear interpolation in a Delaunay triangulation of the pixel means;
+ *                         triangles with an edge longer than twice the halo are left null
+ *
+ * getTile() is thread-safe. Since writers request tiles in raster order, the gridder also grids
+ * the tiles after the latest request ahead of time on its threads; at most getTileBudget()
+ * tiles are gridded or waiting to be requested at once, which bounds its memory. Only R0 is
+ * produced.
+ **************************************************************************************************/
+class OSSIMDLLEXPORT ossimPointCloudGridder : public ossimImageSource
+{
+public:
+   enum Reducer { MIN_Z=0, MAX_Z, MEAN_Z, IDW, TIN };
+
+   ossimPointCloudGridder(ossimPointCloudHandler* pch=0, ossimImageGeometry* geom=0);
+
+   /** Sets the point cloud and output geometry, then initializes. */
+   void setInputs(ossimPointCloudHandler* pch, ossimImageGeometry* geom);
+
+   void setReducer(Reducer reducer) { m_reducer = reducer; }
+   Reducer getReducer() const { return m_reducer; }
+
+   /** Sets reducer from "min", "max", "mean", "idw" or "tin". Returns false if not one. */
+   bool setReducer(const ossimString& name);
+
+   /** Pixels of points around a tile used to grid it; 16 by default. */
+   void setHalo(ossim_uint32 pixels) { m_halo = pixels; }
+   ossim_uint32 getHalo() const { return m_halo; }
+
+   /** Tiles gridded or waiting to be fetched at once; 0 (default) is 4 per thread. */
+   void setTileBudget(ossim_uint32 tiles) { m_tileBudget = tiles; }
+   ossim_uint32 getTileBudget() const;
+
+   /** Gridding threads; 0 (default) is ossim::getNumberOfThreads(). 1 grids in getTile(). */
+   void setNumberOfThreads(ossim_uint32 threads) { m_numThreads = threads; }
+   ossim_uint32 getNumberOfThreads() const;
+
+   /** Computes the output rectangle from the point cloud bounds. Stops the read-ahead. */
+   virtual void initialize();
+
+   virtual ossimRefPtr<ossimImageData> getTile(const ossimIrect& rect, ossim_uint32 resLevel=0);
+   virtual bool getTile(ossimImageData* result, ossim_uint32 resLevel=0);
+
+   /** Grids the points under the tile's rectangle into it. */
+   bool gridTile(ossimImageData* tile) const;
+
+   virtual ossim_uint32 getNumberOfInputBands() const { return 1; }
+   virtual ossim_uint32 getNumberOfOutputBands() const { return 1; }
+   virtual ossimScalarType getOutputScalarType() const { return OSSIM_FLOAT32; }
+   virtual ossim_uint32 getNumberOfDecimationLevels() const { return 1; }
+   virtual ossimIrect getBoundingRect(ossim_uint32 resLevel=0) const;
+   virtual ossimRefPtr<ossimImageGeometry> getImageGeometry() { return m_geom; }
+   virtual double getNullPixelValue(ossim_uint32 band=0) const;
+   virtual double getMinPixelValue(ossim_uint32 band=0) const;
+   virtual double getMaxPixelValue(ossim_uint32 band=0) const;
+
+   virtual bool canConnectMyInputTo(ossim_int32, const ossimConnectableObject*) const
+   { return false; }
+
+protected:
+   friend class ossimPointCloudGridderThread;
+
+   virtual ~ossimPointCloudGridder();
+
+   ossimRefPtr<ossimImageData> newTile(const ossimIrect& rect) const;
+
+   /** Output rectangle of tile id, in raster order of the tile grid. */
+   ossimIrect getGridTileRect(ossim_int64 id) const;
+
+   /**
+    * Returns the gridded tile id, waiting for a thread gridding it or else gridding it here.
+    * A tile whose last pixel is in lastUse is dropped: a raster order reader is past it.
+    */
+   ossimRefPtr<ossimImageData> fetchGridTile(ossim_int64 id, bool lastUse);
+
+   /** Read-ahead thread loop: grids the next tiles while within budget. */
+   void runReadAhead();
+
+   void startThreads();
+   void stopThreads();
+
+   /** Fills tile; the points (x, y in pixels of the tile's halo rect) are sorted by pixel. */
+   void reduceBins(ossimImageData* tile, const ossimIrect& haloRect,
+                   const std::vector<ossim_uint32>& cellStart,
+                   const std::vector<ossim_float64>& x, const std::vector<ossim_float64>& y,
+                   const std::vector<ossim_float64>& z) const;
+   void interpolateIdw(ossimImageData* tile, const ossimIrect& haloRect,
+                       const std::vector<ossim_uint32>& cellStart,
+                       const std::vector<ossim_float64>& x, const std::vector<ossim_float64>& y,
+                       const std::vector<ossim_float64>& z) const;
+   void interpolateTin(ossimImageData* tile, const ossimIrect& haloRect,
+                       const std::vector<ossim_uint32>& cellStart,
+                       const std::vector<ossim_float64>& x, const std::vector<ossim_float64>& y,
+                       const std::vector<ossim_float64>& z) const;
+
+   ossimRefPtr<ossimPointCloudHandler> m_pch;
+   ossimRefPtr<ossimImageGeometry>     m_geom;
+   Reducer                             m_reducer;
+   ossim_uint32                        m_halo;
+   ossim_uint32                        m_tileBudget;
+   ossim_uint32                        m_numThreads;
+   ossimIrect                          m_imageRect;
+   ossimIpt                            m_tileSize;
+   ossim_int64                         m_tilesPerRow;
+   ossim_int64                         m_numTiles;
+   ossim_float64                       m_minHgt;
+   ossim_float64                       m_maxHgt;
+
+   mutable OpenThreads::Mutex          m_pchMutex; // point queries, the handler is not reentrant
+
+   // Read-ahead state, guarded by m_mutex:
+   OpenThreads::Mutex                  m_mutex;
+   OpenThreads::Condition              m_workReady;
+   OpenThreads::Condition              m_tileReady;
+   std::map<ossim_int64, ossimRefPtr<ossimImageData> > m_gridded;
+   std::set<ossim_int64>               m_inProgress;
+   ossim_int64                         m_nextId;
+   bool                                m_stopFlag;
+   std::vector<ossimPointCloudGridderThread*> m_threads;
+
+TYPE_DATA
+};
+
+#endif /* #ifndef ossimPointCloudGridder_HEADER */
@@ -15,8 +15,13 @@
 #include <ossim/base/ossimRefPtr.h>
 #include <ossim/point_cloud/ossimPointCloudSource.h>
 #include <ossim/point_cloud/ossimPointBlock.h>
+#include <ossim/point_cloud/ossimPointColumnBlock.h>
+#include <ossim/point_cloud/ossimPointCloudIndex.h>
+#include <ossim/point_cloud/ossimPointCloudPyramid.h>
+#include <ossim/point_cloud/ossimPointFilter.h>
 #include <ossim/base/ossimFilename.h>
 #include <ossim/point_cloud/ossimPointCloudGeometry.h>
+#include <OpenThreads/Mutex>
 #include <vector>
 
 
@@ -54,11 +59,22 @@ public:
                              ossimPointBlock& block,
                              ossim_uint32 maxNumPoints=0xFFFFFFFF) const = 0;
 
+   /**
+    * Column storage version of getFileBlock. The block is cleared and keeps its field code.
+    * Handlers should override this to fill the columns directly; the default reads an
+    * ossimPointBlock and copies it.
+    */
+   virtual void getFileBlock(ossim_uint32 offset,
+                             ossimPointColumnBlock& block,
+                             ossim_uint32 maxNumPoints=0xFFFFFFFF) const;
+
    /**
     * @see getFileBlock.
     */
    virtual void getNextFileBlock(ossimPointBlock& block,
                                  ossim_uint32 maxNumPoints=0xFFFFFFFF) const;
+   virtual void getNextFileBlock(ossimPointColumnBlock& block,
+                                 ossim_uint32 maxNumPoints=0xFFFFFFFF) const;
 
    virtual void rewind() const { m_currentPID = 0; }
 
@@ -67,9 +83,58 @@ public:
     * are NaN, then only the horizontal bounds are considered. Thread-safe version accepts data
     * block object from caller. The block object is cleared before points are pushed on the vector.
     * The block size will be non-zero if points were found.
+    *
+    * Only the chunks of the file listed by getSpatialIndex() for the bounds are read, or the
+    * whole file if there is no index. Points failing the point filter, if any, are left out.
     */
    virtual void getBlock(const ossimGrect& bounds, ossimPointBlock& block) const;
 
+   /**
+    * Column storage version of getBlock. The block keeps its field code, so a block with no
+    * fields gets the positions only.
+    */
+   virtual void getBlock(const ossimGrect& bounds, ossimPointColumnBlock& block) const;
+
+   /**
+    * Versions of getBlock for a product of gsd meters per pixel: the points come from the
+    * coarsest level of getPyramid() with a spacing no larger than gsd, or from the file when
+    * there is none.
+    */
+   void getBlock(const ossimGrect& bounds, ossimPointBlock& block, double gsd) const;
+   void getBlock(const ossimGrect& bounds, ossimPointColumnBlock& block, double gsd) const;
+
+   /**
+    * Returns the spatial index of the open file, loading its sidecar (@see
+    * ossimPointCloudIndex::getSidecarFile) or else building it with one pass over the points
+    * and saving the sidecar. Null if the "point_cloud.spatial_index" preference is false or the
+    * handler has no points.
+    */
+   const ossimPointCloudIndex* getSpatialIndex() const;
+
+   /**
+    * Points per chunk of a new spatial index: the "point_cloud.index_chunk_size" preference, else
+    * ossimPointCloudIndex::DEFAULT_CHUNK_SIZE. Handlers reading the file in fixed units override
+    * this to line the chunks up with them.
+    */
+   virtual ossim_uint32 getIndexChunkSize() const;
+
+   /**
+    * Returns the level of detail pyramid of the open file, loading its sidecar (@see
+    * ossimPointCloudPyramid::getSidecarFile) or else building it with one pass over the points
+    * and saving the sidecar. Its finest level has at most the "point_cloud.lod_max_points"
+    * preference points. Null if the "point_cloud.lod_pyramid" preference is false or the
+    * handler has no points.
+    */
+   const ossimPointCloudPyramid* getPyramid() const;
+
+   /**
+    * Sets the filter that the points of getBlock() must pass, e.g. an ossimPointFilterChain of
+    * class and return selections. Null (the default) for all points. File blocks are read with
+    * the fields the filter needs; blocks returned keep their own field code.
+    */
+   void setPointFilter(ossimPointFilter* filter);
+   const ossimPointFilter* getPointFilter() const { return m_pointFilter.get(); }
+
    virtual const ossimPointRecord*  getMinPoint() const { return m_minRecord.get(); }
    virtual const ossimPointRecord*  getMaxPoint() const { return m_maxRecord.get(); }
 
@@ -90,6 +155,13 @@ protected:
    ossimRefPtr<ossimPointRecord> m_minRecord;
    ossimRefPtr<ossimPointRecord>  m_maxRecord;
    mutable ossim_uint32 m_currentPID;
+   mutable ossimRefPtr<ossimPointCloudIndex> m_index;
+   mutable ossimFilename m_indexFile; // Point file m_index was made for.
+   mutable OpenThreads::Mutex m_indexMutex;
+   mutable ossimRefPtr<ossimPointCloudPyramid> m_pyramid;
+   mutable ossimFilename m_pyramidFile; // Point file m_pyramid was made for.
+   mutable OpenThreads::Mutex m_pyramidMutex;
+   ossimRefPtr<ossimPointFilter> m_pointFilter;
 
 TYPE_DATA
 };
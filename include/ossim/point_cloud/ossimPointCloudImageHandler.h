@@ -13,6 +13,7 @@
 #include <ossim/base/ossimConstants.h>
 #include <ossim/base/ossimString.h>
 #include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimAppFixedTileCache.h>
 #include <ossim/base/ossimIrect.h>
 #include <ossim/point_cloud/ossimPointCloudHandler.h>
 #include <vector>
@@ -30,6 +31,11 @@ class ossimPoinCloudHandler;
  *
  * For sensor systems providing additional renderable data items, a derived class will be required
  * to expose those components.
+ *
+ * Tiles are rasterized on tile-aligned origins and kept in ossimAppFixedTileCache, one cache per
+ * resolution level. Only R0 tiles bin points; a reduced resolution tile is decimated from the
+ * four tiles of the level above it. getTile() may be called from several threads: the point
+ * cloud handler is only locked while a tile queries its points.
  */
 class OSSIMDLLEXPORT ossimPointCloudImageHandler : public ossimImageHandler
 {
@@ -216,25 +222,33 @@ public:
 
 
 protected:
-   class PcrBucket
-   {
-   public:
-      PcrBucket() : m_bucket(0), m_numSamples(0) {}
-      PcrBucket(const ossim_float32* init_value, ossim_uint32 numBands);
-      PcrBucket(const ossim_float32& R, const ossim_float32& G, const ossim_float32& B);
-      PcrBucket(const ossim_float32& init_value);
-      ~PcrBucket();
-      ossim_float32* m_bucket;
-      int m_numSamples;
-   };
-
-   void initTile();
-
-   void addSample(std::map<ossim_int32, PcrBucket*>& accumulator,
-                  ossim_int32 index,
-                  const ossimPointRecord* sample);
-
-   void normalize(std::map<ossim_int32, PcrBucket*>& accumulator);
+   /** @return A new initialized tile of the output bands covering rect. */
+   ossimRefPtr<ossimImageData> newTile(const ossimIrect& rect) const;
+
+   /**
+    * Returns the tile of resLevel at the tile-aligned origin from the cache, rasterizing (R0, or
+    * a level with a matching level of detail) or decimating it first if not cached. Returns null
+    * on error.
+    */
+   ossimRefPtr<ossimImageData> getCachedTile(const ossimIpt& origin, ossim_uint32 resLevel);
+
+   /** @return true if resLevel > 0 is rasterized from a level of the point cloud's pyramid. */
+   bool hasLodLevel(ossim_uint32 resLevel);
+
+   /**
+    * Bins the points falling in the tile's rectangle into it. Above R0, the points are those of
+    * the pyramid level matching the GSD of resLevel.
+    */
+   bool rasterizeTile(ossimImageData* tile, ossim_uint32 resLevel=0);
+
+   /** Fills the tile of resLevel > 0 by reducing the 2x2 pixels of resLevel-1 under each pixel. */
+   bool decimateTile(ossimImageData* tile, ossim_uint32 resLevel);
+
+   /** @return The tile cache of resLevel, created on first use. */
+   ossimAppFixedTileCache::ossimAppFixedCacheId getCacheId(ossim_uint32 resLevel);
+
+   /** Drops the rasterized tiles, needed whenever the GSD or active component changes. */
+   void deleteCaches();
 
    ossim_uint32 componentToFieldCode() const;
 
@@ -243,8 +257,9 @@ protected:
    ossim_float32                m_minPixel;
    ossimDpt                     m_gsd;
    ossim_float64                m_gsdFactor;
-   ossimRefPtr<ossimImageData>  m_tile;
-   OpenThreads::Mutex           m_mutex;
+   OpenThreads::Mutex           m_mutex;    // guards m_cacheIds
+   OpenThreads::Mutex           m_pchMutex; // serializes point queries, m_pch is not reentrant
+   std::vector<ossimAppFixedTileCache::ossimAppFixedCacheId> m_cacheIds;
    Components                   m_activeComponent;
    std::vector<ossimString>     m_componentNames;
 
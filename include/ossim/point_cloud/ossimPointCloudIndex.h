@@ -0,0 +1,125 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimPointCloudIndex_HEADER
+#define ossimPointCloudIndex_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimGrect.h>
+#include <ossim/base/ossimReferenced.h>
+#include <utility>
+#include <vector>
+
+class ossimPointCloudHandler;
+
+/***************************************************************************************************
+ * Out of core spatial index of a point cloud file, mapping ground cells to the chunks (runs of
+ * getChunkSize() points in file order) holding points in them. The cells are the leaves of a
+ * quadtree over the bounds of the cloud, 2^levels on a side; each quadtree node keeps its point
+ * count so empty quadrants are skipped in one test when querying.
+ *
+ * The index is built with one pass of ossimPointCloudHandler::getFileBlock(), or by any reader
+ * feeding chunks of X/Y coordinates to beginBuild()/addChunk()/endBuild(), and can be saved to a
+ * sidecar, by default <file>.pci, so later opens of the same file do not rescan it. X is lon or
+ * easting, Y lat or northing; the bounds are kept in an ossimGrect either way.
+ **************************************************************************************************/
+class OSSIMDLLEXPORT ossimPointCloudIndex : public ossimReferenced
+{
+public:
+   static const ossim_uint32 DEFAULT_CHUNK_SIZE;
+   static const ossim_uint32 DEFAULT_LEVELS;
+
+   ossimPointCloudIndex();
+
+   /**
+    * Scans the handler's points from the start of the file.
+    * @param chunkSize Points per chunk, the unit read by a query.
+    * @param levels Quadtree depth; the leaf grid is 2^levels cells on a side (max 10).
+    * @return true if the handler had points.
+    */
+   bool build(const ossimPointCloudHandler& handler,
+              ossim_uint32 chunkSize=DEFAULT_CHUNK_SIZE,
+              ossim_uint32 levels=DEFAULT_LEVELS);
+
+   /**
+    * Starts an empty index over the box [minX, maxX] x [minY, maxY]; points outside are put in
+    * the nearest edge cell.
+    */
+   void beginBuild(double minX, double minY, double maxX, double maxY,
+                   ossim_uint32 chunkSize=DEFAULT_CHUNK_SIZE,
+                   ossim_uint32 levels=DEFAULT_LEVELS);
+
+   /** Indexes n points of chunk; NaN points are skipped. Chunks are added in ascending order. */
+   void addChunk(ossim_uint32 chunk, const ossim_float64* x, const ossim_float64* y,
+                 ossim_uint32 n);
+
+   /** Completes the index after numPoints points. */
+   void endBuild(ossim_uint32 numPoints);
+
+   /** Writes the index to file. */
+   bool save(const ossimFilename& file) const;
+
+   /**
+    * Reads an index from file.
+    * @param numPoints If non-zero, the index is rejected unless it was built on this many points.
+    * @param fileSize If non-zero, the index is rejected unless its point file was this size.
+    */
+   bool load(const ossimFilename& file, ossim_uint32 numPoints=0, ossim_int64 fileSize=0);
+
+   bool isValid() const { return (m_numPoints != 0); }
+
+   /**
+    * Returns the runs of chunks [first, last] that may hold points inside bounds, in file order,
+    * adjacent chunks merged. Heights of bounds are ignored.
+    */
+   void getChunkRuns(const ossimGrect& bounds,
+                     std::vector< std::pair<ossim_uint32, ossim_uint32> >& runs) const;
+
+   /** As above for the box [minX, maxX] x [minY, maxY]. */
+   void getChunkRuns(double minX, double minY, double maxX, double maxY,
+                     std::vector< std::pair<ossim_uint32, ossim_uint32> >& runs) const;
+
+   ossim_uint32 getChunkSize() const { return m_chunkSize; }
+   ossim_uint32 getNumPoints() const { return m_numPoints; }
+   ossim_uint32 getNumChunks() const;
+   const ossimGrect& getBounds() const { return m_bounds; }
+
+   /** Size of the point file the index was built on, set by the handler before saving. */
+   void setFileSize(ossim_int64 size) { m_fileSize = size; }
+
+   /** @return <file>.pci */
+   static ossimFilename getSidecarFile(const ossimFilename& pointFile);
+
+protected:
+   virtual ~ossimPointCloudIndex();
+
+   /** Leaf cell column and row of lon/lat, clamped to the grid. */
+   void getCell(double lon, double lat, ossim_uint32& col, ossim_uint32& row) const;
+
+   /** Sums the leaf counts up the quadtree. */
+   void buildQuadTree();
+
+   /** Appends the chunks of the leaves of node (level, col, row) inside [c0,c1]x[r0,r1]. */
+   void collectChunks(ossim_uint32 level, ossim_uint32 col, ossim_uint32 row,
+                      ossim_uint32 c0, ossim_uint32 c1, ossim_uint32 r0, ossim_uint32 r1,
+                      std::vector<ossim_uint32>& chunks) const;
+
+   ossim_uint32 m_numPoints;
+   ossim_uint32 m_chunkSize;
+   ossim_uint32 m_levels;
+   ossim_int64  m_fileSize;
+   ossimGrect   m_bounds;
+
+   /** Chunk ids of each leaf cell (row major), ascending. */
+   std::vector< std::vector<ossim_uint32> > m_cellChunks;
+
+   /** Point counts of the quadtree nodes, level by level from the root, row major in a level. */
+   std::vector< std::vector<ossim_uint32> > m_nodeCounts;
+};
+
+#endif /* #ifndef ossimPointCloudIndex_HEADER */
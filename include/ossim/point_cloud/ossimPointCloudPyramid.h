@@ -0,0 +1,120 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimPointCloudPyramid_HEADER
+#define ossimPointCloudPyramid_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimGrect.h>
+#include <ossim/base/ossimReferenced.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/point_cloud/ossimPointColumnBlock.h>
+#include <vector>
+
+class ossimPointCloudHandler;
+
+/***************************************************************************************************
+ * Level of detail pyramid of a point cloud: a hierarchy of subsets of its points for requests at
+ * coarse GSDs, which then read a few points per pixel instead of the whole cloud.
+ *
+ * Each level is a voxel thinning: space is cut into cubes of the level's spacing (meters) and
+ * only the first point of the file in each cube is kept. The spacing doubles from one level to
+ * the next, so a level has about a quarter of the points of the one below it on a surface, and
+ * each level is a subset of the finer one. The finest level is the first whose thinning keeps
+ * no more than the maxPoints given to build(), which bounds the memory of the pyramid; the
+ * points of every level are kept in memory, sorted by cell of a grid over the bounds for queries.
+ *
+ * The pyramid is built with one pass of ossimPointCloudHandler::getFileBlock() and can be saved
+ * to a sidecar next to the spatial index, by default <file>.pcp.
+ **************************************************************************************************/
+class OSSIMDLLEXPORT ossimPointCloudPyramid : public ossimReferenced
+{
+public:
+   static const ossim_uint32 DEFAULT_MAX_POINTS;
+
+   ossimPointCloudPyramid();
+
+   /**
+    * Thins the handler's points, all fields of the handler kept.
+    * @param maxPoints Most points in the finest level.
+    * @return true if the handler had points.
+    */
+   bool build(const ossimPointCloudHandler& handler,
+              ossim_uint32 maxPoints=DEFAULT_MAX_POINTS);
+
+   /** Writes the pyramid to file. */
+   bool save(const ossimFilename& file) const;
+
+   /**
+    * Reads a pyramid from file.
+    * @param numPoints If non-zero, the pyramid is rejected unless built on this many points.
+    * @param fileSize If non-zero, the pyramid is rejected unless its point file was this size.
+    */
+   bool load(const ossimFilename& file, ossim_uint32 numPoints=0, ossim_int64 fileSize=0);
+
+   bool isValid() const { return !m_levels.empty(); }
+
+   /** Levels, 0 the finest. */
+   ossim_uint32 getNumLevels() const { return (ossim_uint32) m_levels.size(); }
+
+   /** Voxel size of level in meters; about the spacing of its points. */
+   double getSpacing(ossim_uint32 level) const;
+
+   /** Points of level. */
+   ossim_uint32 getNumPoints(ossim_uint32 level) const;
+
+   /**
+    * Coarsest level with a spacing no larger than gsd meters, or -1 if the finest is coarser
+    * than gsd and the request needs the full cloud.
+    */
+   ossim_int32 getLevelForGsd(double gsd) const;
+
+   /**
+    * Appends the points of level inside bounds to block, the block's fields only. Heights of
+    * bounds are tested as in ossimPointCloudHandler::getBlock().
+    */
+   void getBlock(ossim_uint32 level, const ossimGrect& bounds, ossimPointColumnBlock& block) const;
+
+   /** Points of the cloud the pyramid was built on. */
+   ossim_uint32 getNumCloudPoints() const { return m_numPoints; }
+
+   /** Size of the point file the pyramid was built on, set by the handler before saving. */
+   void setFileSize(ossim_int64 size) { m_fileSize = size; }
+
+   /** @return <file>.pcp */
+   static ossimFilename getSidecarFile(const ossimFilename& pointFile);
+
+protected:
+   struct Level
+   {
+      double                              spacing;
+      ossimRefPtr<ossimPointColumnBlock>  points;
+      std::vector<ossim_uint32>           cellStart; // first point of each grid cell, + end
+   };
+
+   virtual ~ossimPointCloudPyramid();
+
+   /** Meters per unit of X and Y of the positions: lon/lat degrees or map units. */
+   ossimDpt getMetersPerUnit() const;
+
+   /** Sorts level's points by grid cell and sets its cell starts. */
+   void sortByCell(Level& level) const;
+
+   /** Grid cell column and row of x, y, clamped to the grid. */
+   void getCell(double x, double y, ossim_uint32& col, ossim_uint32& row) const;
+
+   ossim_uint32       m_numPoints;
+   ossim_int64        m_fileSize;
+   ossim_uint32       m_fieldCode;
+   ossimGrect         m_bounds;
+   double             m_minZ;
+   std::vector<Level> m_levels;
+};
+
+#endif /* #ifndef ossimPointCloudPyramid_HEADER */
@@ -28,6 +28,7 @@ public:
    ossimPointCloudUtilityFilter( ossimPointCloudUtil* pc_util);
    virtual ~ossimPointCloudUtilityFilter() {}
 
+   virtual ossimRefPtr<ossimImageData> getTile(const ossimIrect& rect, ossim_uint32 resLevel=0);
    virtual bool getTile(ossimImageData* result, ossim_uint32 resLevel=0);
    
    ossimScalarType getOutputScalarType() const { return OSSIM_FLOAT32; }
@@ -0,0 +1,158 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimPointColumnBlock_HEADER
+#define ossimPointColumnBlock_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimGrect.h>
+#include <ossim/base/ossimReferenced.h>
+#include <ossim/point_cloud/ossimPointRecord.h>
+#include <vector>
+
+class ossimPointBlock;
+
+/***************************************************************************************************
+ * Column (structure of arrays) storage of a block of points. Positions are three contiguous double
+ * arrays, X = lon (or easting), Y = lat (or northing), Z = height, in the same coordinate system
+ * as ossimPointRecord::getPosition(). Each field of the field code has its own array:
+ *
+ *   Intensity, Red, Green, Blue, Infrared  ossim_float32
+ *   ReturnNumber, NumberOfReturns,
+ *   Classification                         ossim_uint8
+ *   GpsTime                                ossim_float64
+ *
+ * All arrays live in one arena sized for capacity() points, so filling a block of N points makes
+ * no per point allocation. Use getPoint() or appendTo() to hand the points to code expecting
+ * ossimPointRecord objects.
+ **************************************************************************************************/
+class OSSIMDLLEXPORT ossimPointColumnBlock : public ossimReferenced
+{
+public:
+   ossimPointColumnBlock(ossim_uint32 fields=0, ossim_uint32 capacity=0);
+   ossimPointColumnBlock(const ossimPointColumnBlock& rhs);
+   virtual ~ossimPointColumnBlock();
+
+   const ossimPointColumnBlock& operator=(const ossimPointColumnBlock& rhs);
+
+   ossim_uint32 size() const { return m_size; }
+   ossim_uint32 capacity() const { return m_capacity; }
+   bool empty() const { return (m_size == 0); }
+
+   /** Returns OR'd mash-up of ossimPointRecord field codes stored */
+   ossim_uint32 getFieldCode() const { return m_fieldCode; }
+
+   /** Returns TRUE if ALL fields of the OR'd code are stored. */
+   bool hasFields(ossim_uint32 code) const { return ((m_fieldCode & code) == code); }
+
+   /** Sets the fields to be stored. Points in the block are deleted if the code changes. */
+   void setFieldCode(ossim_uint32 code);
+
+   /** Grows the arena to hold at least numPoints, keeping the points in the block. */
+   void reserve(ossim_uint32 numPoints);
+
+   /**
+    * Sets the number of points, growing the arena as needed. Added points have NaN positions and
+    * float fields, zero returns and ids.
+    */
+   void resize(ossim_uint32 numPoints);
+
+   /** Empties the block, keeping the arena. */
+   void clear() { m_size = 0; }
+
+   /** Adds a point with null fields to the tail. Returns its index. */
+   ossim_uint32 addPoint(const ossimGpt& position, ossim_uint32 pointId=0);
+
+   /** Adds a copy of the record's position, id and those of its fields that are stored. */
+   ossim_uint32 addPoint(const ossimPointRecord& record);
+
+   /**
+    * Column access. Pointers are to size() values and stay valid until the arena grows
+    * (reserve(), resize(), addPoint() past capacity()) or the field code changes.
+    */
+   ossim_float64*       getX()       { return m_x; }
+   const ossim_float64* getX() const { return m_x; }
+   ossim_float64*       getY()       { return m_y; }
+   const ossim_float64* getY() const { return m_y; }
+   ossim_float64*       getZ()       { return m_z; }
+   const ossim_float64* getZ() const { return m_z; }
+   ossim_uint32*        getPointIds()       { return m_ids; }
+   const ossim_uint32*  getPointIds() const { return m_ids; }
+
+   /** Intensity, Red, Green, Blue or Infrared column; null if not a stored float field. */
+   ossim_float32*       getFloatField(ossimPointRecord::FIELD_CODES field);
+   const ossim_float32* getFloatField(ossimPointRecord::FIELD_CODES field) const;
+
+   /** ReturnNumber, NumberOfReturns or Classification column; null if not stored. */
+   ossim_uint8*         getByteField(ossimPointRecord::FIELD_CODES field);
+   const ossim_uint8*   getByteField(ossimPointRecord::FIELD_CODES field) const;
+
+   /** GpsTime column; null if not stored. */
+   ossim_float64*       getGpsTime()       { return m_gpsTime; }
+   const ossim_float64* getGpsTime() const { return m_gpsTime; }
+
+   ossimGpt getPosition(ossim_uint32 i) const { return ossimGpt(m_y[i], m_x[i], m_z[i]); }
+
+   void setPosition(ossim_uint32 i, const ossimGpt& p) { m_x[i] = p.lon; m_y[i] = p.lat; m_z[i] = p.hgt; }
+
+   /** Field value of point i as float, as ossimPointRecord::getField(). NaN if not stored. */
+   ossim_float32 getField(ossim_uint32 i, ossimPointRecord::FIELD_CODES field) const;
+
+   /** Sets the field of point i if stored. */
+   void setField(ossim_uint32 i, ossimPointRecord::FIELD_CODES field, ossim_float32 value);
+
+   /** Sets record to point i: id, position and the stored fields. */
+   void getPoint(ossim_uint32 i, ossimPointRecord& record) const;
+
+   /** Appends count points from offset as new ossimPointRecord objects. */
+   void appendTo(ossimPointBlock& block, ossim_uint32 offset=0,
+                 ossim_uint32 count=0xFFFFFFFF) const;
+
+   /** Appends the points of the record block. */
+   void append(const ossimPointBlock& block);
+
+   /** Appends count points of rhs from offset. The field codes of the blocks need not match. */
+   void append(const ossimPointColumnBlock& rhs, ossim_uint32 offset=0,
+               ossim_uint32 count=0xFFFFFFFF);
+
+   /**
+    * Appends the points of rhs at the ascending indices of selection, as filled by
+    * ossimPointFilter. Runs of consecutive indices are copied as one range.
+    */
+   void append(const ossimPointColumnBlock& rhs, const std::vector<ossim_uint32>& selection);
+
+   /** Min/max of the positions. NaN if empty. */
+   void getBounds(ossimGrect& bounds) const;
+
+   /** Bytes per point of the arena for the field code. */
+   static ossim_uint32 getBytesPerPoint(ossim_uint32 fieldCode);
+
+protected:
+   /** Lays the columns of numPoints out in a new arena and copies the points over. */
+   void allocate(ossim_uint32 numPoints);
+
+   ossim_uint32                m_fieldCode;
+   ossim_uint32                m_size;
+   ossim_uint32                m_capacity;
+   std::vector<ossim_float64>  m_arena; // ossim_float64 elements keep every column 8 byte aligned.
+   ossim_float64*              m_x;
+   ossim_float64*              m_y;
+   ossim_float64*              m_z;
+   ossim_uint32*               m_ids;
+   ossim_float32*              m_intensity;
+   ossim_float32*              m_red;
+   ossim_float32*              m_green;
+   ossim_float32*              m_blue;
+   ossim_float32*              m_infrared;
+   ossim_uint8*                m_returnNumber;
+   ossim_uint8*                m_numberOfReturns;
+   ossim_uint8*                m_classification;
+   ossim_float64*              m_gpsTime;
+};
+
+#endif /* #ifndef ossimPointColumnBlock_HEADER */
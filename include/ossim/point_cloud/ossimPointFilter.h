@@ -0,0 +1,135 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimPointFilter_HEADER
+#define ossimPointFilter_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimGrect.h>
+#include <ossim/base/ossimReferenced.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/point_cloud/ossimPointColumnBlock.h>
+#include <vector>
+
+/***************************************************************************************************
+ * Batch test of the points of a column block. Rather than copying the points that pass, a filter
+ * narrows a selection: the ascending indices into the block of the points still kept. Filters
+ * compact the selection in place, so a chain of them run over a block costs no allocation and
+ * the points are copied once at the end with ossimPointColumnBlock::append(block, selection).
+ *
+ * ossimPointCloudHandler::setPointFilter() applies a filter to every getBlock().
+ **************************************************************************************************/
+class OSSIMDLLEXPORT ossimPointFilter : public ossimReferenced
+{
+public:
+   typedef std::vector<ossim_uint32> Selection;
+
+   /** Removes from selection the indices of the points of block failing the filter. */
+   virtual void filter(const ossimPointColumnBlock& block, Selection& selection) const = 0;
+
+   /** OR'd ossimPointRecord field codes the filter reads; blocks given to filter() need them. */
+   virtual ossim_uint32 getFieldCode() const { return 0; }
+
+   /** Sets selection to every point of block. */
+   static void selectAll(const ossimPointColumnBlock& block, Selection& selection);
+
+protected:
+   virtual ~ossimPointFilter() {}
+};
+
+/**
+ * Keeps the points of the ASPRS classes given (2 = ground, 6 = building, etc.). Blocks without
+ * the Classification field pass unchanged.
+ */
+class OSSIMDLLEXPORT ossimPointClassFilter : public ossimPointFilter
+{
+public:
+   /** Starts with no class kept. */
+   ossimPointClassFilter();
+
+   void addClass(ossim_uint8 classCode) { m_keep[classCode] = true; }
+   void removeClass(ossim_uint8 classCode) { m_keep[classCode] = false; }
+   bool isKept(ossim_uint8 classCode) const { return m_keep[classCode]; }
+
+   virtual void filter(const ossimPointColumnBlock& block, Selection& selection) const;
+   virtual ossim_uint32 getFieldCode() const { return ossimPointRecord::Classification; }
+
+protected:
+   bool m_keep[256];
+};
+
+/**
+ * Keeps the points of the return numbers given, and/or the last return of each pulse. The first
+ * return is number 1. Blocks without the ReturnNumber field pass unchanged.
+ */
+class OSSIMDLLEXPORT ossimPointReturnFilter : public ossimPointFilter
+{
+public:
+   /** Starts with no return kept. */
+   ossimPointReturnFilter();
+
+   /** Keeps returns of number n, 1 to 7. */
+   void addReturnNumber(ossim_uint8 n) { m_keep[n & 0x07] = true; }
+
+   /** Keeps the returns numbered as the NumberOfReturns of their pulse. */
+   void setKeepLast(bool keep) { m_keepLast = keep; }
+
+   virtual void filter(const ossimPointColumnBlock& block, Selection& selection) const;
+   virtual ossim_uint32 getFieldCode() const;
+
+protected:
+   bool m_keep[8];
+   bool m_keepLast;
+};
+
+/**
+ * Keeps the points inside the horizontal bounds, tested as ossimGrect::pointWithin() does in
+ * ossimPointCloudHandler::getBlock(). Use ossimPointZRangeFilter for heights.
+ */
+class OSSIMDLLEXPORT ossimPointBoundsFilter : public ossimPointFilter
+{
+public:
+   ossimPointBoundsFilter(const ossimGrect& bounds) : m_bounds(bounds) {}
+
+   void setBounds(const ossimGrect& bounds) { m_bounds = bounds; }
+   const ossimGrect& getBounds() const { return m_bounds; }
+
+   virtual void filter(const ossimPointColumnBlock& block, Selection& selection) const;
+
+protected:
+   ossimGrect m_bounds;
+};
+
+/** Keeps the points of height in [minZ, maxZ]. NaN heights fail. */
+class OSSIMDLLEXPORT ossimPointZRangeFilter : public ossimPointFilter
+{
+public:
+   ossimPointZRangeFilter(double minZ, double maxZ) : m_minZ(minZ), m_maxZ(maxZ) {}
+
+   virtual void filter(const ossimPointColumnBlock& block, Selection& selection) const;
+
+protected:
+   double m_minZ;
+   double m_maxZ;
+};
+
+/** Runs its filters in the order added, stopping once the selection is empty. */
+class OSSIMDLLEXPORT ossimPointFilterChain : public ossimPointFilter
+{
+public:
+   void addFilter(ossimPointFilter* filter) { if (filter) m_filters.push_back(filter); }
+   void clear() { m_filters.clear(); }
+   bool empty() const { return m_filters.empty(); }
+
+   virtual void filter(const ossimPointColumnBlock& block, Selection& selection) const;
+   virtual ossim_uint32 getFieldCode() const;
+
+protected:
+   std::vector< ossimRefPtr<ossimPointFilter> > m_filters;
+};
+
+#endif /* #ifndef ossimPointFilter_HEADER */
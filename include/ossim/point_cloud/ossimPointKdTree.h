@@ -0,0 +1,106 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimPointKdTree_HEADER
+#define ossimPointKdTree_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimReferenced.h>
+#include <vector>
+
+class ossimPointColumnBlock;
+
+/***************************************************************************************************
+ * In-memory 3D KD-tree over the positions of a point block, for closest point matching such as
+ * ICP alignment: build once over the target cloud, then query every iteration with the moved
+ * source points. Queries are const and may run concurrently; the batch form splits the query
+ * points over threads itself.
+ *
+ * The tree keeps its own copy of the coordinates in leaf order, so the block may change or go
+ * away after build(). Distances are Euclidean in the block's X/Y/Z, so clouds in lon/lat degrees
+ * with heights in meters should be projected first. Points with NaN positions are not indexed.
+ **************************************************************************************************/
+class OSSIMDLLEXPORT ossimPointKdTree : public ossimReferenced
+{
+public:
+   static const ossim_uint32 DEFAULT_LEAF_SIZE;
+
+   /** Index returned by the batch query for points with no neighbor within range. */
+   static const ossim_uint32 NO_MATCH = 0xFFFFFFFF;
+
+   ossimPointKdTree();
+
+   /** Builds the tree over the positions of points; query indices are into points. */
+   void build(const ossimPointColumnBlock& points, ossim_uint32 leafSize=DEFAULT_LEAF_SIZE);
+
+   /** Builds the tree over n positions given as columns. */
+   void build(const ossim_float64* x, const ossim_float64* y, const ossim_float64* z,
+              ossim_uint32 n, ossim_uint32 leafSize=DEFAULT_LEAF_SIZE);
+
+   bool isValid() const { return !m_nodes.empty(); }
+
+   /** Number of points indexed. */
+   ossim_uint32 size() const { return (ossim_uint32)m_ids.size(); }
+
+   /**
+    * Nearest indexed point to (x, y, z) closer than sqrt(maxDist2).
+    * @param index Set to the point's index in the block built on.
+    * @param dist2 Set to the squared distance to it.
+    * @return false if there is none.
+    */
+   bool findNearest(double x, double y, double z, ossim_uint32& index, double& dist2,
+                    double maxDist2=OSSIM_DEFAULT_MAX_PIX_DOUBLE) const;
+
+   /**
+    * Nearest neighbors of all query points, in parallel. indices and dist2 are sized to the query
+    * block; entries of points not searched or with no neighbor within maxDistance are NO_MATCH
+    * and NaN.
+    * @param selection If given, only the query points at these indices are searched, e.g. from
+    * getSubsample() or ossimPointFilter.
+    * @param numThreads Threads to use; 0 for ossim::getNumberOfThreads().
+    */
+   void findNearest(const ossimPointColumnBlock& queries,
+                    std::vector<ossim_uint32>& indices,
+                    std::vector<ossim_float64>& dist2,
+                    double maxDistance=OSSIM_DEFAULT_MAX_PIX_DOUBLE,
+                    const std::vector<ossim_uint32>* selection=0,
+                    ossim_uint32 numThreads=0) const;
+
+   /**
+    * Selection of every stride-th point of numPoints. A coarse to fine ICP schedule matches with
+    * a large stride in early iterations and lowers it as the alignment converges.
+    */
+   static void getSubsample(ossim_uint32 numPoints, ossim_uint32 stride,
+                            std::vector<ossim_uint32>& selection);
+
+protected:
+   virtual ~ossimPointKdTree();
+
+   /** Leaf when m_axis is 3; points are [m_begin, m_end) of the leaf ordered arrays. */
+   struct Node
+   {
+      ossim_float64 m_split;
+      ossim_uint32  m_begin;
+      ossim_uint32  m_end;
+      ossim_uint32  m_left;
+      ossim_uint32  m_right;
+      ossim_uint32  m_axis;
+   };
+
+   /** Splits order[begin, end) at the median of its widest axis; returns the node index. */
+   ossim_uint32 buildNode(std::vector<ossim_uint32>& order, ossim_uint32 begin, ossim_uint32 end,
+                          const ossim_float64* const xyz[3]);
+
+   ossim_uint32               m_leafSize;
+   std::vector<Node>          m_nodes;
+   std::vector<ossim_float64> m_x; // leaf order
+   std::vector<ossim_float64> m_y;
+   std::vector<ossim_float64> m_z;
+   std::vector<ossim_uint32>  m_ids; // block index of each leaf ordered point
+};
+
+#endif /* #ifndef ossimPointKdTree_HEADER */
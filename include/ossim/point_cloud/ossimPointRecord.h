@@ -35,7 +35,8 @@ public:
       Blue            = 0x0100, // float 32
       GpsTime         = 0x0200, // unsigned long Unix epoch (microsec from 01/01/1970)
       Infrared        = 0x0400, // float 32
-      All             = 0x0777
+      Classification  = 0x0800, // unsigned int 8, ASPRS class code (2 = ground, etc.)
+      All             = 0x0FF8
    };
 
    ossimPointRecord(ossim_uint32 fields_code=0);
@@ -81,7 +81,16 @@ public:
     *  subpixel accuracy (within .1 of a pixel).
     */
    static void setInterpolationError(double error=.1);
+   static double getInterpolationError();
    static void setMinGridSpacing(ossim_int32 minSpacing = 100);
+
+   /**
+    * Threads used by buildGrid to sample the grid nodes and check the interpolation error.
+    * Zero (the default) uses the "coarse_grid.build_threads" preference, else the number of
+    * processors. With one thread the build runs serially in the caller.
+    */
+   static void setBuildThreads(ossim_uint32 threads = 0);
+   static ossim_uint32 getBuildThreads();
    /**
     * METHOD: print()
     * Extends base-class implementation. Dumps contents of object to ostream.
@@ -175,6 +184,7 @@ protected:
 
    static double       theInterpolationError;
    static ossim_int32  theMinGridSpacing;
+   static ossim_uint32 theBuildThreads;
    ossimAdjustmentInfo theInitialAdjustment;
    bool                theHeightEnabledFlag;
    
@@ -82,7 +82,8 @@ protected:
    };
 
    //! Type for database record consists of EPSG code and serialized form of corresponding OSSIM 
-   //! projection (as a keywordlist)
+   //! projection (as a keywordlist). The CSV fields are only read (see loadCsvRecord) when the
+   //! projection is first asked for.
    class ProjDbRecord : public ossimReferenced
    {
    public:
@@ -91,12 +92,16 @@ protected:
             name(""), 
             datumValid(false), 
             csvFormat(NOT_ASSIGNED), 
+            fileIndex(0),
+            fileOffset(0),
             proj(0) {}
 
       ossim_uint32     code;
       ossimString      name;
       bool             datumValid; //!< FALSE if the datum code was not parsed and WGS84 defaulted
       RecordFormat     csvFormat;
+      ossim_uint32     fileIndex;  //!< Index of the Db file in m_dbFiles.
+      ossim_uint64     fileOffset; //!< Offset of the record line in the Db file.
       std::vector<ossimString>        csvRecord;
       ossimRefPtr<ossimMapProjection> proj;
    };
@@ -123,7 +128,22 @@ protected:
    //! Populates the database with contents of DB files as specified in ossim_preferences.
    void initialize() const;
 
+   //! Adds the code, name and line offset of each record of a Db file from its binary index,
+   //! if there is one and it is not older than the file. Returns false if there is none.
+   bool loadIndex(const ossimFilename& db_name, ossim_uint32 file_index) const;
+
+   //! Adds the records of a Db file by reading it through, then writes its binary index.
+   void loadCsvFile(const ossimFilename& db_name, ossim_uint32 file_index) const;
+
+   //! Reads the CSV fields of the record from its Db file if not already done.
+   //! Returns false if they could not be read.
+   bool loadCsvRecord(ProjDbRecord* record) const;
+
+   //! Binary index file of a Db file: <epsg_database_index_directory or Db file path>/<file>.idx
+   ossimFilename getIndexFile(const ossimFilename& db_name) const;
+
    mutable std::multimap<ossim_uint32, ossimRefPtr<ProjDbRecord> > m_projDatabase;
+   mutable std::vector<ossimFilename> m_dbFiles;
    mutable OpenThreads::Mutex m_mutex;
    //static ossimEpsgProjectionDatabase*  m_instance; //!< Singleton implementation
    
@@ -21,6 +21,20 @@ public:
 
    virtual ossimDpt forward(const ossimGpt &worldPoint)    const;
    virtual ossimGpt inverse(const ossimDpt &projectedPoint)const;
+
+   /** @brief Batch forms; see ossimMapProjection::forwardPoints(). */
+   virtual void forwardPoints(const ossimGpt* worldPoints,
+                              ossimDpt* eastingNorthings,
+                              ossim_uint32 count) const;
+   virtual void inversePoints(const ossimDpt* eastingNorthings,
+                              ossimGpt* worldPoints,
+                              ossim_uint32 count) const;
+   virtual void worldToLineSamples(const ossimGpt* worldPoints,
+                                   ossimDpt* lineSamples,
+                                   ossim_uint32 count) const;
+   virtual void lineSampleToWorlds(const ossimDpt* lineSamples,
+                                   ossimGpt* worldPoints,
+                                   ossim_uint32 count) const;
    virtual void update();
 
 	virtual bool loadState(const ossimKeywordlist& kwl, const char* prefix=0);
@@ -19,9 +19,13 @@
 #define ossimImageViewProjectionTransform_HEADER 1
 
 #include <ossim/projection/ossimImageViewTransform.h>
+#include <ossim/base/ossimImageGeometryEventListener.h>
 #include <ossim/imaging/ossimImageGeometry.h>
+#include <OpenThreads/Mutex>
+#include <map>
 
-class OSSIMDLLEXPORT ossimImageViewProjectionTransform : public ossimImageViewTransform
+class OSSIMDLLEXPORT ossimImageViewProjectionTransform : public ossimImageViewTransform,
+                                                         public ossimImageGeometryEventListener
 {
 public:
    ossimImageViewProjectionTransform(ossimImageGeometry* imageGeometry=0,
@@ -41,10 +45,10 @@ public:
    virtual bool isIdentity() const { return (m_imageGeometry == m_viewGeometry); }
 
    //! Assigns the geometry to use for output view. This object does NOT own the geometry.
-   void setViewGeometry(ossimImageGeometry* g) { m_viewGeometry = g; }   
+   void setViewGeometry(ossimImageGeometry* g) { m_viewGeometry = g; invalidateJacobianGrid(); }
 
    //! Assigns the geometry to use for input image. This object does NOT own the geometry.
-   void setImageGeometry(ossimImageGeometry* g) { m_imageGeometry = g; }  
+   void setImageGeometry(ossimImageGeometry* g) { m_imageGeometry = g; invalidateJacobianGrid(); }
 
    //! Workhorse of the object. Converts image-space to view-space.
    virtual void imageToView(const ossimDpt& imagePoint, ossimDpt& viewPoint) const;
@@ -52,6 +56,12 @@ public:
    //! Other workhorse of the object. Converts view-space to image-space.
    virtual void viewToImage(const ossimDpt& viewPoint, ossimDpt& imagePoint) const;
 
+   //! viewToImage for count points; the ground to image step goes through the batch
+   //! ossimImageGeometry::worldToLocal.
+   virtual void viewToImagePoints(const ossimDpt* viewPoints,
+                                  ossimDpt*       imagePoints,
+                                  ossim_uint32    count) const;
+
    //! Dumps contents to stream
    virtual std::ostream& print(std::ostream& out) const;
    
@@ -74,6 +84,37 @@ public:
 
    //! Gets the image bounding rect in view-space coordinates
    virtual ossimDrect getImageToViewBounds(const ossimDrect& imageRect)const;
+
+   /**
+    * @brief Local view to image Jacobian: the image-space steps dx and dy for one view pixel
+    * in x and in y at viewPoint.
+    *
+    * Interpolated from Jacobians taken by central differences at the nodes of a coarse view
+    * grid (JACOBIAN_GRID_SIZE pixels). Nodes are computed on first use and kept until either
+    * geometry changes (see invalidateJacobianGrid()).
+    * @return false where a node of the enclosing cell does not project.
+    */
+   bool getViewToImageJacobian(const ossimDpt& viewPoint, ossimDpt& dx, ossimDpt& dy) const;
+
+   /**
+    * @brief Image-space size of the bounding box of one view pixel, the largest over a
+    * lattice of points covering viewRect. This is the area a resampling filter must cover
+    * for that region. NaN if no point of the lattice has a Jacobian.
+    */
+   ossimDpt getViewToImageFootprint(const ossimDrect& viewRect) const;
+
+   //! Image to view scale from the inverse Jacobian at the center of imageRect, and view to
+   //! image scale as the mean Jacobian over the corners of viewRect. The base class forms are
+   //! used where the grid has no Jacobian.
+   virtual void getScaleChangeImageToView(ossimDpt& result, const ossimDrect& imageRect);
+   virtual void getScaleChangeViewToImage(ossimDpt& result, const ossimDrect& viewRect);
+
+   //! Drops the Jacobian grid. Called when a geometry is set; call it after changing one of
+   //! the geometries in place.
+   void invalidateJacobianGrid();
+
+   //! An ossimImageGeometryEvent also drops the Jacobian grid.
+   virtual void imageGeometryEvent(ossimImageGeometryEvent& event);
    
    //! After rewrite for incorporating ossimImageGeometry: No longer needed.  
    virtual bool loadState(const ossimKeywordlist& kwl, const char* prefix =0);
@@ -97,6 +138,24 @@ protected:
    
    ossimRefPtr<ossimImageGeometry> m_imageGeometry;
    ossimRefPtr<ossimImageGeometry> m_viewGeometry;
+
+   //! View pixels between the nodes of the Jacobian grid.
+   static const ossim_int32 JACOBIAN_GRID_SIZE = 128;
+
+   struct Jacobian
+   {
+      ossimDpt m_dx; //!< Image step for one view pixel in x.
+      ossimDpt m_dy; //!< Image step for one view pixel in y.
+      bool     m_valid;
+   };
+
+   //! Computes the missing nodes of the cell with upper left node (x, y) and returns the four
+   //! nodes in ul, ur, lr, ll order.
+   void getJacobianCell(ossim_int32 x, ossim_int32 y, Jacobian cell[4]) const;
+
+   //! Nodes keyed by (y << 32 | x) in grid units.
+   mutable std::map<ossim_int64, Jacobian> m_jacobians;
+   mutable OpenThreads::Mutex              m_jacobianMutex;
    
 TYPE_DATA
 };
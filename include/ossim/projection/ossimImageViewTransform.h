@@ -79,6 +79,14 @@ public:
   
   virtual void viewToImage(const ossimDpt& viewPoint,
                            ossimDpt&       imagePoint)const;
+
+  /*!
+   * viewToImage() for count points. The default loops; transforms that
+   * project through a sensor model override it to project in one batch.
+   */
+  virtual void viewToImagePoints(const ossimDpt* viewPoints,
+                                 ossimDpt*       imagePoints,
+                                 ossim_uint32    count)const;
   
   virtual std::ostream& print(std::ostream& out) const;
   
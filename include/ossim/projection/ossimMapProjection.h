@@ -49,6 +49,22 @@ public:
     */
    virtual ossimGpt inverse(const ossimDpt &projectedPoint)const = 0;
 
+   /**
+    * forward() for count points already on the projection datum. The default loops; projections
+    * with a cheaper batch form override it.
+    */
+   virtual void forwardPoints(const ossimGpt* worldPoints,
+                              ossimDpt* eastingNorthings,
+                              ossim_uint32 count) const;
+
+   /**
+    * inverse() for count points. The default loops; projections with a cheaper batch form
+    * override it.
+    */
+   virtual void inversePoints(const ossimDpt* eastingNorthings,
+                              ossimGpt* worldPoints,
+                              ossim_uint32 count) const;
+
    virtual ossimDpt worldToLineSample(const ossimGpt &worldPoint)const;
    virtual void     worldToLineSample(const ossimGpt &worldPoint,
                                       ossimDpt&       lineSample)const;
@@ -301,6 +317,25 @@ protected:
    //---
    void updateFromTransform();
 
+   /**
+    * worldToLineSamples() of a projected (easting, northing) map through forwardPoints(). Points
+    * on another datum are shifted a block at a time before the call, so forwardPoints() never
+    * compares datums. With a model transform this is the per point loop.
+    */
+   void forwardToLineSamples(const ossimGpt* worldPoints,
+                             ossimDpt* lineSamples,
+                             ossim_uint32 count) const;
+
+   /**
+    * lineSampleToWorlds() of a projected map through inversePoints(), with one elevation lookup
+    * for all points when theElevationLookupFlag is set. clampFlag clamps lat, lon to their
+    * ranges as lineSampleHeightToWorld() does. With a model transform this is the per point loop.
+    */
+   void inverseToWorlds(const ossimDpt* lineSamples,
+                        ossimGpt* worldPoints,
+                        ossim_uint32 count,
+                        bool clampFlag) const;
+
    /**
     * This method verifies that the projection parameters match the current
     * pcs code.  If not this will set the pcs code to 0.
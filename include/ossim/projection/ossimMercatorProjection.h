@@ -32,6 +32,20 @@ public:
 
    virtual ossimGpt inverse(const ossimDpt &eastingNorthing)const;
    virtual ossimDpt forward(const ossimGpt &latLon)const;
+
+   /** @brief Batch forms; see ossimMapProjection::forwardPoints(). */
+   virtual void forwardPoints(const ossimGpt* worldPoints,
+                              ossimDpt* eastingNorthings,
+                              ossim_uint32 count) const;
+   virtual void inversePoints(const ossimDpt* eastingNorthings,
+                              ossimGpt* worldPoints,
+                              ossim_uint32 count) const;
+   virtual void worldToLineSamples(const ossimGpt* worldPoints,
+                                   ossimDpt* lineSamples,
+                                   ossim_uint32 count) const;
+   virtual void lineSampleToWorlds(const ossimDpt* lineSamples,
+                                   ossimGpt* worldPoints,
+                                   ossim_uint32 count) const;
    virtual void update();   
    /*!
     * SetFalseEasting.  The value is in meters.
@@ -47,6 +47,11 @@ public:
    virtual void  worldToLineSample(const ossimGpt& world_point,
                                    ossimDpt&       image_point) const;
 
+   /** @brief Batch form of worldToLineSample(). */
+   virtual void worldToLineSamples(const ossimGpt* world_points,
+                                   ossimDpt*       image_points,
+                                   ossim_uint32    count) const;
+
    /**
     * @brief lineSampleHeightToWorld()
     * Backs out decimation of image_point (if needed) then calls:
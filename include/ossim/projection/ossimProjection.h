@@ -54,12 +54,30 @@ public:
    virtual void worldToLineSample(const ossimGpt& worldPoint,
                                   ossimDpt&       lineSampPt) const = 0;
 
+   /*!
+    * METHOD: worldToLineSamples()
+    * worldToLineSample() for count points. The default loops over
+    * worldToLineSample(); projections with a cheaper batch form override it.
+    */
+   virtual void worldToLineSamples(const ossimGpt* worldPoints,
+                                   ossimDpt*       lineSampPts,
+                                   ossim_uint32    count) const;
+
    /*!
     * METHOD: lineSampleToWorld()
     * Performs the inverse projection from line, sample to ground (world):
     */
    virtual void lineSampleToWorld(const ossimDpt& lineSampPt,
                                   ossimGpt&       worldPt) const = 0;
+
+   /*!
+    * METHOD: lineSampleToWorlds()
+    * lineSampleToWorld() for count points. The default loops; sensor models
+    * override it to carry each terrain solution over to the next point.
+    */
+   virtual void lineSampleToWorlds(const ossimDpt* lineSampPts,
+                                   ossimGpt*       worldPts,
+                                   ossim_uint32    count) const;
    
    /*!
     * METHOD: lineSampleHeightToWorld
@@ -30,10 +30,7 @@ public:
    
    ossimProjection* createProjection(const ossimFilename& filename,
                                      ossim_uint32 entryIdx)const;
-   ossimProjection* createProjection(const ossimString& name)const
-   {
-      return createNativeObjectFromRegistry(name);
-   }
+   ossimProjection* createProjection(const ossimString& name)const;
    ossimProjection* createProjection(const ossimKeywordlist& kwl,
                                      const char* prefix=NULL)const;
    
@@ -108,6 +108,18 @@ public:
     */
    virtual void  worldToLineSample(const ossimGpt& world_point,
                                    ossimDpt&       image_point) const;
+
+   /**
+    * @brief worldToLineSamples()
+    * Overrides base class implementation. The 20 monomials of each point are
+    * computed once and shared by the four polynomials, several points at a
+    * time with the SIMD level of ossim::getSimdLevel(). Results agree with
+    * worldToLineSample() to rounding.
+    */
+   virtual void worldToLineSamples(const ossimGpt* world_points,
+                                   ossimDpt*       image_points,
+                                   ossim_uint32    count) const;
+
    /**
     * @brief print()
     * Extends base-class implementation. Dumps contents of object to ostream.
@@ -224,6 +236,17 @@ protected:
 
    /** @brief virtual destructor */
    virtual ~ossimRpcModel();
+
+   /**
+    * @brief intersectTerrain()
+    * Overrides base class implementation. Given a start height (or with
+    * height hints on), solves h = DEM(lineSampleHeightToWorld(h)) by secant
+    * steps on the Newton inverse of the polynomials instead of marching the
+    * imaging ray; falls back to the ray if that does not converge.
+    */
+   virtual void intersectTerrain(const ossimDpt& image_point,
+                                 double          startHeight,
+                                 ossimGpt&       world_point) const;
    
    //***
    // Methods for computing RPC polynomial and its derivatives:
@@ -202,6 +202,27 @@ protected:
                                const std::vector<double>& y,
                                const std::vector<double>& z)const;
 
+   /**
+    * Sums the normal equations, m.t()*w*w*m and m.t()*w*w*f, one point at a
+    * time, without forming the design matrix m.
+    */
+   void accumulateNormals(NEWMAT::SymmetricMatrix& normals,
+                          NEWMAT::ColumnVector& constants,
+                          const NEWMAT::DiagonalMatrix& weights,
+                          const NEWMAT::ColumnVector& f,
+                          const std::vector<double>& x,
+                          const std::vector<double>& y,
+                          const std::vector<double>& z)const;
+
+   /**
+    * Fills the 39 terms of the equation (design matrix row) of one point.
+    */
+   static void setupEquation(double* equation,
+                             double f,
+                             double x,
+                             double y,
+                             double z);
+
    void setupWeightMatrix(NEWMAT::DiagonalMatrix& result, // holds the resulting weights
                           const NEWMAT::ColumnVector& coefficients,
                           const NEWMAT::ColumnVector& f,
@@ -34,6 +34,18 @@ public:
     */
    virtual void  worldToLineSample(const ossimGpt& world_point,
                                    ossimDpt&       image_point) const;
+
+   /**
+    * @brief worldToLineSamples()
+    * Overrides base class implementation. Runs of points in the same section
+    * share one coefficient table; the monomials of each point are formed once
+    * and shared by the four polynomials, several points at a time with the
+    * SIMD level of ossim::getSimdLevel(). Results agree with
+    * worldToLineSample() to rounding.
+    */
+   virtual void worldToLineSamples(const ossimGpt* world_points,
+                                   ossimDpt*       image_points,
+                                   ossim_uint32    count) const;
  
 
    /**
@@ -42,6 +54,19 @@ public:
     */
    virtual void  lineSampleToWorld(const ossimDpt& image_point,
                                    ossimGpt&       world_point) const;
+
+   /**
+    * @brief lineSampleToWorlds()
+    * Overrides base class implementation. Same imaging rays as
+    * lineSampleToWorld(), with the polynomials and their partials evaluated
+    * from one table of powers per iteration. Each DEM intersection starts
+    * from the height of the point before it, as in
+    * ossimSensorModel::lineSampleToWorlds().
+    */
+   virtual void lineSampleToWorlds(const ossimDpt* image_points,
+                                   ossimGpt*       world_points,
+                                   ossim_uint32    count) const;
+
    /**
     * @brief lineSampleHeightToWorld()
     * Overrides base class pure virtual. Height understood to be relative to
@@ -136,22 +161,22 @@ protected:
    double polynomial( const double& x, const double& y, const double& z,
                       const ossim_uint32& maxx, const ossim_uint32& maxy,
                       const ossim_uint32& maxz,
-                      std::vector<double> pcf ) const;
+                      const std::vector<double>& pcf ) const;
    
    double dPoly_dLat( const double& x, const double& y, const double& z,
                       const ossim_uint32& maxx, const ossim_uint32& maxy,
                       const ossim_uint32& maxz,
-                      std::vector<double> pcf) const;
+                      const std::vector<double>& pcf) const;
    
    double dPoly_dLon( const double& x, const double& y, const double& z,
                       const ossim_uint32& maxx, const ossim_uint32& maxy,
                       const ossim_uint32& maxz,
-                      std::vector<double> pcf ) const;
+                      const std::vector<double>& pcf ) const;
    
    double dPoly_dHgt( const double& x, const double& y, const double& z,
                       const ossim_uint32& maxx, const ossim_uint32& maxy,
                       const ossim_uint32& maxz,
-                      std::vector<double> pcf ) const;
+                      const std::vector<double>& pcf ) const;
 
    /**
     * @brief Performs sanity check on key/required rsm data.
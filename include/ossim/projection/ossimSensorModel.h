@@ -38,6 +38,7 @@
 #include <ossim/base/ossimPolygon.h>
 #include <ossim/base/ossimDrect.h>
 #include <ossim/base/ossimCommon.h> /* for ossim::nan() */
+#include <vector>
 #include <ossim/elevation/ossimElevSource.h>
 #include <ossim/base/ossimAdjustableParameterInterface.h>
 #include <ossim/matrix/newmat.h>
@@ -116,6 +117,16 @@ public:
    virtual void  worldToLineSample(const ossimGpt& world_point,
                                    ossimDpt&       image_point) const;
 
+   /*!
+    * METHOD: lineSampleToWorlds()
+    * Batch lineSampleToWorld(). Each terrain intersection starts from the
+    * height found for the point before it, so runs of neighbouring image
+    * points (e.g. a scanline) converge in one or two height lookups.
+    */
+   virtual void lineSampleToWorlds(const ossimDpt* image_points,
+                                   ossimGpt*       world_points,
+                                   ossim_uint32    count) const;
+
    /*!
     * METHOD: lineSampleHeightToWorld
     * This is the pure virtual that performs the actual work of projecting
@@ -247,6 +258,15 @@ public:
     */
    virtual ossimGpt getInverseDeriv(int parmIdx, const ossimDpt& ipos, double hdelta=1e-11);
 
+   /*!
+    * METHOD: hasAnalyticParameterDerivs()
+    * returns true when getForwardDeriv()/getInverseDeriv() are reimplemented
+    * with formal derivatives for parmIdx >= 0; buildNormalEquation() then calls
+    * them per tie point instead of using finite differences.
+    * Default is false.
+    */
+   virtual bool hasAnalyticParameterDerivs() const;
+
    /*!
     * METHOD: getObsCovMat()
     * @brief Gives 2X2 covariance matrix of observations
@@ -297,6 +317,28 @@ protected:
    virtual ossimGpt extrapolate (const ossimDpt& ip,
 				 const double& height=ossim::nan()) const;
 
+   /*!
+    * METHOD: intersectTerrain()
+    * lineSampleToWorld() with the DEM intersection started at startHeight
+    * above the ellipsoid (nan for no guess). This implementation intersects
+    * imagingRay() with ossimElevManager::intersectRayFromHeight().
+    */
+   virtual void intersectTerrain(const ossimDpt& image_point,
+                                 double          startHeight,
+                                 ossimGpt&       world_point) const;
+
+   /*!
+    * METHODS: getHeightHint(), setHeightHint()
+    * Converged heights kept per node of a coarse image grid when the
+    * preference sensor_model.coherent_intersection is on, used to start
+    * lineSampleToWorld() near its solution. Slots are shared by threads
+    * without a lock; a lost or stale hint only costs iterations.
+    * getHeightHint() returns nan when there is none.
+    */
+   double getHeightHint(const ossimDpt& image_point) const;
+   void   setHeightHint(const ossimDpt& image_point, double height) const;
+   bool   hasHeightHints() const { return !theHeightHints.empty(); }
+
    /*!
     * METHOD: buildNormalEquation
     * builds linearized system  (LMS equivalent)
@@ -308,7 +350,8 @@ protected:
     *
     * t: transposition operator
     * J = jacobian of transform relative to parameters p, transform can be forward() or inverse()
-    * jacobian is obtained via finite differences
+    * jacobian is obtained via finite differences (see computeJacobian()), or
+    * from getForwardDeriv()/getInverseDeriv() if hasAnalyticParameterDerivs()
     * residue can be image (2D) or ground residue(3D)
     *
     * TODO: use image/ground points covariance matrices
@@ -325,6 +368,21 @@ protected:
     */
    NEWMAT::ColumnVector getResidue(const ossimTieGptSet& tieSet);
 
+   /*!
+    * METHOD: computeJacobian()
+    * centered finite difference jacobian of forward() (useImageObs) or inverse()
+    * over all tie points, rows ordered as getResidue(), one column per
+    * adjustable parameter.
+    * A column sweeps all tie points with its parameter perturbed, so the model
+    * is updated twice per parameter rather than twice per parameter and tie
+    * point. Columns are computed in parallel, each job on its own copy of the
+    * model (see dup()); serially on this model when it cannot be copied.
+    */
+   void computeJacobian(const ossimTieGptSet& tieSet,
+                        bool useImageObs,
+                        double hdelta,
+                        NEWMAT::Matrix& jacobian);
+
    NEWMAT::ColumnVector solveLeastSquares(NEWMAT::SymmetricMatrix& A,  NEWMAT::ColumnVector& r)const;
 
    /*!
@@ -367,6 +425,9 @@ protected:
    
    mutable bool theExtrapolateImageFlag;
    mutable bool theExtrapolateGroundFlag;
+
+   /** Grid node key in the high 32 bits, float height bits in the low. */
+   mutable std::vector<ossim_uint64> theHeightHints;
    
 TYPE_DATA
 };
@@ -0,0 +1,65 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Batch transverse Mercator series shared by ossimUtmProjection and
+// ossimTransMercatorProjection. The series terms have SSE2/AVX2 code selected at runtime (see
+// ossimSimd.h) and a scalar fallback giving identical results.
+//
+//**************************************************************************************************
+//  $Id$
+#ifndef ossimTransMercatorKernels_HEADER
+#define ossimTransMercatorKernels_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+
+class ossimDpt;
+class ossimGpt;
+
+namespace ossim
+{
+   /**
+    * @brief Ellipsoid and projection constants of a transverse Mercator projection, as held by
+    * the TranMerc_* members of the projection classes.
+    */
+   struct TransMercatorParams
+   {
+      double a;              //!< Semi-major axis in meters.
+      double es;             //!< Eccentricity squared.
+      double ebs;            //!< Second eccentricity squared.
+      double ap;             //!< True meridional distance constants.
+      double bp;
+      double cp;
+      double dp;
+      double ep;
+      double originLat;      //!< Radians.
+      double originLon;      //!< Radians.
+      double falseEasting;
+      double falseNorthing;
+      double scaleFactor;
+   };
+
+   /**
+    * @brief Geodetic to easting, northing for count points, which must already be on the
+    * projection datum. Same series as Convert_Geodetic_To_Transverse_Mercator; results agree
+    * with it to rounding.
+    */
+   OSSIM_DLL void transMercatorForward(const TransMercatorParams& p,
+                                       const ossimGpt* worldPoints,
+                                       ossimDpt* eastingNorthings,
+                                       ossim_uint32 count);
+
+   /**
+    * @brief Easting, northing to geodetic for count points. Sets lat, lon (degrees) and a zero
+    * height; the datum is left to the caller. Same series as
+    * Convert_Transverse_Mercator_To_Geodetic; results agree with it to rounding.
+    */
+   OSSIM_DLL void transMercatorInverse(const TransMercatorParams& p,
+                                       const ossimDpt* eastingNorthings,
+                                       ossimGpt* worldPoints,
+                                       ossim_uint32 count);
+
+} // End: namespace ossim
+
+#endif /* #ifndef ossimTransMercatorKernels_HEADER */
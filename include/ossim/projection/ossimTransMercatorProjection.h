@@ -14,6 +14,7 @@
 #define ossimTransMercatorProjection_HEADER
 
 #include <ossim/projection/ossimMapProjection.h>
+#include <ossim/projection/ossimTransMercatorKernels.h>
 
 class OSSIMDLLEXPORT ossimTransMercatorProjection : public ossimMapProjection
 {
@@ -30,6 +31,20 @@ public:
    virtual ossimObject *dup()const{return new ossimTransMercatorProjection(*this);}
    virtual ossimGpt inverse(const ossimDpt &eastingNorthing)const;
    virtual ossimDpt forward(const ossimGpt &latLon)const;
+
+   /** @brief Batch forms; see ossimMapProjection::forwardPoints(). */
+   virtual void forwardPoints(const ossimGpt* worldPoints,
+                              ossimDpt* eastingNorthings,
+                              ossim_uint32 count) const;
+   virtual void inversePoints(const ossimDpt* eastingNorthings,
+                              ossimGpt* worldPoints,
+                              ossim_uint32 count) const;
+   virtual void worldToLineSamples(const ossimGpt* worldPoints,
+                                   ossimDpt* lineSamples,
+                                   ossim_uint32 count) const;
+   virtual void lineSampleToWorlds(const ossimDpt* lineSamples,
+                                   ossimGpt* worldPoints,
+                                   ossim_uint32 count) const;
    virtual void update();
    
    /*!
@@ -89,6 +104,9 @@ public:
 
 protected:
 
+   //! TranMerc_* constants for the batch series.
+   void getTransMercatorParams(ossim::TransMercatorParams& p) const;
+
    //_____________GEOTRANS_______________
    
    double TranMerc_a;              /* Semi-major axis of ellipsoid i meters */
@@ -12,6 +12,7 @@
 #ifndef ossimUtmProjection_HEADER
 #define ossimUtmProjection_HEADER
 #include <ossim/projection/ossimMapProjection.h>
+#include <ossim/projection/ossimTransMercatorKernels.h>
 
 class OSSIMDLLEXPORT ossimUtmProjection : public ossimMapProjection
 {
@@ -30,6 +31,20 @@ public:
 
    virtual ossimGpt inverse(const ossimDpt &eastingNorthing)const;
    virtual ossimDpt forward(const ossimGpt &latLon)const;
+
+   /** @brief Batch forms; see ossimMapProjection::forwardPoints(). */
+   virtual void forwardPoints(const ossimGpt* worldPoints,
+                              ossimDpt* eastingNorthings,
+                              ossim_uint32 count) const;
+   virtual void inversePoints(const ossimDpt* eastingNorthings,
+                              ossimGpt* worldPoints,
+                              ossim_uint32 count) const;
+   virtual void worldToLineSamples(const ossimGpt* worldPoints,
+                                   ossimDpt* lineSamples,
+                                   ossim_uint32 count) const;
+   virtual void lineSampleToWorlds(const ossimDpt* lineSamples,
+                                   ossimGpt* worldPoints,
+                                   ossim_uint32 count) const;
    virtual void update();
 
    /**
@@ -88,6 +103,9 @@ public:
    virtual bool operator==(const ossimProjection& projection) const;
 
 private:
+   //! theTranMerc_* constants for the batch series.
+   void getTransMercatorParams(ossim::TransMercatorParams& p) const;
+
    /*_____________GEOTRANS_______________*/
    
    /**
@@ -58,6 +58,17 @@ public:
     */
    virtual void lineSampleToWorld(const ossimDpt& lineSampPt,
                                       ossimGpt&       worldPt) const;
+
+   /*!
+    * Batch forms.  The client projection and the transforms each see the
+    * whole array, so a quad tree warp walks its leaf index once per batch.
+    */
+   virtual void worldToLineSamples(const ossimGpt* worldPoints,
+                                   ossimDpt*       lineSampPts,
+                                   ossim_uint32    count) const;
+   virtual void lineSampleToWorlds(const ossimDpt* lineSampPts,
+                                   ossimGpt*       worldPts,
+                                   ossim_uint32    count) const;
    
    /*!
     * Performs the inverse projection from line, sample to ground, bypassing
@@ -69,7 +69,7 @@ private:
     * @param wkt Well known tet string.
     * @return True on success, false on error.
     */
-   bool initializeProjection( const ossimXmlDocument xdoc,
+   bool initializeProjection( const ossimXmlDocument& xdoc,
                               const std::string& wkt,
                               ossimProjection* proj ) const;
 
@@ -13,12 +13,17 @@
 #ifndef ossimDemGrid_HEADER
 #define ossimDemGrid_HEADER
 
+#include <fstream>
 #include <iostream>
 #include <vector>
 
 #include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimMemoryMappedFile.h>
+#include <ossim/base/ossimRefPtr.h>
 #include <ossim/support_data/ossimDemHeader.h>
 #include <ossim/support_data/ossimDemProfile.h>
+#include <OpenThreads/Mutex>
 
 /*!
  *  class ossimDemGrid
@@ -51,6 +56,20 @@ public:
     */
    long read(std::istream& dem, bool incrementalRead = false);
 
+   /*!
+    *  Opens a DEM for reading by tile.  Only the header and the first
+    *  record of each profile are read here; the elevations of a profile
+    *  are decoded the first time getElevation asks for its column, so a
+    *  tile decodes just the profiles it covers.
+    *
+    *  With the preference "usgs_dem.binary_sidecar: true" the grid is
+    *  converted once to a float32 sidecar, file + ".ogrid", rebuilt when the
+    *  DEM changes, and later opens map the sidecar instead.
+    *
+    *  Returns true if successful.
+    */
+   bool open(const ossimFilename& file);
+
    // Accessors
    ossimDemHeader const& getHeader() const;
 
@@ -84,6 +103,14 @@ public:
 
 private:
 
+   // First record of a profile, for open().
+   struct ProfileInfo
+   {
+      std::streamoff _offset;           // File offset of the profile.
+      long           _startRow;         // Grid row of its last elevation.
+      ossim_int32    _numberElevations;
+   };
+
    ossim_float32   _missDataVal;
    ossimDemHeader  _header;
    long            _width;
@@ -94,9 +121,25 @@ private:
    std::vector<ossimDemProfile> _profiles;  // Used by fillUTM()
    double _northwest_x, _northwest_y;
 
+   // Members of a grid from open().
+   std::vector<ProfileInfo> _profileInfo;
+   mutable std::vector< std::vector<ossim_float32> > _columns; // Decoded profiles.
+   mutable std::ifstream _stream;
+   mutable OpenThreads::Mutex _mutex;
+   ossimRefPtr<ossimMemoryMappedFile> _sidecar;
+   const ossim_float32* _sidecarGrid;
+
    void setElevation(long x, long y, ossim_float32 val);
    long fillGeographic(std::istream& dem, bool incrementalRead);
    long fillUTM(std::istream& dem, bool incrementalRead);
+
+   /*!
+    *  Reads and decodes profile x into _columns[x]; call with _mutex locked.
+    */
+   bool loadProfile(long x) const;
+
+   bool openSidecar(const ossimFilename& sidecar, const ossimFilename& file);
+   bool writeSidecar(const ossimFilename& sidecar, const ossimFilename& file) const;
 };
 
 inline void ossimDemGrid::setElevation(long x, long y, ossim_float32 val)
@@ -16,6 +16,7 @@
 #ifndef ossimDemUtil_HEADER
 #define ossimDemUtil_HEADER
 
+#include <cctype>
 #include <cstring>
 #include <cstdlib>
 #include <string>
@@ -59,14 +60,38 @@ public:
     */
    static bool getRecord(std::istream& s, char* buf, long reclength = 1024);
 
+   /**
+    *  Skips a record as getRecord would read it.
+    *  Returns true if succesful. Returns false if EOF or error.
+    */
+   static bool skipRecord(std::istream& s, long reclength = 1024);
+
+   /**
+    *  atol of the field, converted in place.
+    */
    static long getLong(char* const strbuf, // string to extract long from
                        long const startpos,  // starting position of field
                        long const width)     // width of field
       {
-         char temp[1024];
-         strncpy(temp,strbuf+startpos,width);
-         temp[width] = '\0';
-         return atol(temp);
+         const char* p   = strbuf + startpos;
+         const char* end = p + width;
+         while ( (p < end) && *p && std::isspace(static_cast<unsigned char>(*p)) )
+         {
+            ++p;
+         }
+         bool negative = false;
+         if ( (p < end) && ( (*p == '-') || (*p == '+') ) )
+         {
+            negative = (*p == '-');
+            ++p;
+         }
+         long value = 0;
+         while ( (p < end) && (*p >= '0') && (*p <= '9') )
+         {
+            value = (value * 10) + (*p - '0');
+            ++p;
+         }
+         return negative ? -value : value;
       }
 
    static bool getDouble(std::string const& strbuf, // string to extract double from
@@ -74,6 +99,12 @@ public:
                          long const width,     // width of field
                          double& val);         // value extracted from field.
 
+   /**
+    *  Same as getDouble above, without copying the record to a string.
+    */
+   static bool getDouble(const char* strbuf, long const startpos, long const width,
+                         double& val);
+
 private:
 
    ossimDemUtil();
@@ -56,6 +56,12 @@ public:
     */
    virtual std::ostream& print(std::ostream& out) const;
 
+   /**
+    * @brief Header only summary, see ossimInfoBase::getImageSummary.
+    * Posts and the ul/ur/lr/ll corners from the user header label.
+    */
+   virtual bool getImageSummary(ossimKeywordlist& kwl, const std::string& prefix) const;
+
    /**
     * @brief Gets a property for name.
     * @param name Property name to get.
@@ -14,6 +14,7 @@
 #define ossimInfoBase_HEADER
 
 #include <iosfwd>
+#include <string>
 
 #include <ossim/base/ossimConstants.h>
 #include <ossim/base/ossimReferenced.h>
@@ -72,9 +73,33 @@ public:
     */
    virtual bool getKeywordlist(ossimKeywordlist& kwl)const;
 
+   /**
+    * @brief Header only summary of the file for catalog ingest.
+    *
+    * Adds number_entries and, per entry, image<n>.number_lines, number_samples and
+    * number_bands, plus whatever corner or tie point keys the header itself carries.  No pixel
+    * data is read and no projection is built.
+    *
+    * @param kwl The keyword list to add to.
+    * @param prefix Prefix for the keys, e.g. "file0.".
+    * @return true if the format has a summary, false if not (base class).
+    */
+   virtual bool getImageSummary(ossimKeywordlist& kwl, const std::string& prefix) const;
+
 protected:
    /** virtual destructor */
    virtual ~ossimInfoBase();
+
+   /**
+    * @brief Adds the image<entry>. number_lines, number_samples and number_bands keys of
+    * getImageSummary.
+    */
+   void addImageSummary(ossimKeywordlist& kwl,
+                        const std::string& prefix,
+                        ossim_uint32 entry,
+                        ossim_uint32 lines,
+                        ossim_uint32 samples,
+                        ossim_uint32 bands) const;
    
    bool theOverviewFlag; // If true overview information should be processed.
    
@@ -14,12 +14,14 @@
 
 #include <ossim/base/ossimConstants.h> /* for OSSIM_DLL macro */
 #include <OpenThreads/Mutex>
+#include <string>
 #include <vector>
 
 // Forward class declarations.
 class ossimInfoFactoryInterface;
 class ossimInfoBase;
 class ossimFilename;
+class ossimKeywordlist;
 
 class OSSIM_DLL ossimInfoFactoryRegistry
 {
@@ -63,6 +65,19 @@ public:
     * for memory.
     */
    ossimInfoBase* create(const ossimFilename& file) const;
+
+   /**
+    * @brief Header only summary of file, see ossimInfoBase::getImageSummary.  Overviews are
+    * not processed and no image handler is opened.
+    *
+    * @param file File to probe.
+    * @param kwl Keyword list to add to.
+    * @param prefix Prefix for the keys.
+    * @return true if an info object opened file and has a summary for it.
+    */
+   bool getImageSummary(const ossimFilename& file,
+                        ossimKeywordlist& kwl,
+                        const std::string& prefix) const;
    
 protected:
 
@@ -18,6 +18,7 @@
 #include <ossim/base/ossimFilename.h>
 
 class ossimEndian;
+class ossimJ2kTileIndex;
 
 /**
  * @brief TIFF info class.
@@ -52,6 +53,20 @@ public:
     */
    virtual std::ostream& print(std::ostream& out) const;
 
+   /**
+    * @brief Header only summary, see ossimInfoBase::getImageSummary.
+    * Sizes from the SIZ marker.
+    */
+   virtual bool getImageSummary(ossimKeywordlist& kwl, const std::string& prefix) const;
+
+   /**
+    * @brief Tile-part offsets of the codestream, for random tile access.
+    * Loaded from the index file of the image, or built and saved; see
+    * ossimJ2kTileIndex.
+    * @return true on success.
+    */
+   virtual bool getTileIndex(ossimJ2kTileIndex& index) const;
+
 protected:
 
    /** Initializes s reference.  Does byte swapping as needed. */
@@ -0,0 +1,124 @@
+//----------------------------------------------------------------------------
+//
+// License:  LGPL
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description: Offsets of the tile-parts of a JPEG 2000 codestream.
+//
+//----------------------------------------------------------------------------
+// $Id$
+#ifndef ossimJ2kTileIndex_HEADER
+#define ossimJ2kTileIndex_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimFilename.h>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+class ossimFileBlockCache;
+
+/**
+ * @brief Index of the tile-parts of a JPEG 2000 codestream, so decoders can
+ * seek straight to a tile instead of walking the start of tile (SOT) markers.
+ *
+ * Built from the tile-part lengths (TLM) markers of the main header when
+ * present.  Otherwise the SOT marker segments are read through an
+ * ossimFileBlockCache, so runs of small tile-parts cost a few large reads.
+ *
+ * The index is kept in a binary file next to the image (<file>.tpi),
+ * stamped with the image modification time and size, and loaded by later
+ * opens.  Preferences (see ossim_preferences_template):
+ *   j2k.tile_index            false to never write or read index files.
+ *   j2k.tile_index_directory  Directory for index files, e.g. for read only media.
+ */
+class OSSIM_DLL ossimJ2kTileIndex
+{
+public:
+
+   /** One tile-part; 16 bytes as kept in the index file. */
+   struct TilePart
+   {
+      /** File offset of the SOT marker. */
+      ossim_uint64 m_offset;
+
+      /** Psot, length from the SOT marker to the end of the tile-part data. */
+      ossim_uint32 m_length;
+
+      /** Isot, tile index in raster order. */
+      ossim_uint16 m_tile;
+
+      /** TPsot, tile-part index within the tile. */
+      ossim_uint8  m_part;
+
+      /** TNsot, tile-parts of the tile; 0 if not known, e.g. built from TLM. */
+      ossim_uint8  m_parts;
+   };
+
+   /** default constructor */
+   ossimJ2kTileIndex();
+
+   /**
+    * @brief Loads the index file of file, or builds the index and writes it.
+    * @param file Image file.
+    * @param codestreamOffset Offset of the SOC marker; 0 for a raw codestream,
+    * the jp2c box data for a JP2.
+    * @return true on success, false if the codestream could not be read.
+    */
+   bool open(const ossimFilename& file, ossim_uint64 codestreamOffset=0);
+
+   /** @brief Builds the index from the codestream; no index file is used. */
+   bool build(const ossimFilename& file, ossim_uint64 codestreamOffset=0);
+
+   /** @return true if the index was built from TLM markers. */
+   bool getTlmFlag() const;
+
+   /** @return All tile-parts, in codestream order. */
+   const std::vector<TilePart>& getTileParts() const;
+
+   /**
+    * @brief Tile-parts of tile, in codestream order.
+    * @return true if tile has any.
+    */
+   bool getTileParts(ossim_uint32 tile, std::vector<TilePart>& parts) const;
+
+   /** @return Highest tile index plus one. */
+   ossim_uint32 getNumberOfTiles() const;
+
+   /** @return Index file for file, empty if index files are turned off. */
+   static ossimFilename getIndexFile(const ossimFilename& file);
+
+   /**
+    * @brief print method that outputs a key/value type format adding prefix
+    * to keys.
+    * @param out String to output to.
+    * @param prefix This will be prepended to key.
+    * @return output stream.
+    */
+   std::ostream& print(std::ostream& out,
+                       const std::string& prefix=std::string()) const;
+
+private:
+
+   /**
+    * @brief Fills the index from the TLM marker segments of the main header.
+    * @param tlm Segments after Ltlm, keyed by Ztlm.
+    * @return false if they do not match the codestream.
+    */
+   bool buildFromTlm(ossimFileBlockCache* cache, ossim_uint64 firstSot,
+                     const std::map<ossim_uint8, std::string>& tlm);
+
+   /** Fills the index walking the SOT marker segments from firstSot. */
+   bool buildFromSot(ossimFileBlockCache* cache, ossim_uint64 firstSot);
+
+   bool load(const ossimFilename& indexFile, ossim_uint64 codestreamOffset);
+   void save(const ossimFilename& indexFile, ossim_uint64 codestreamOffset) const;
+
+   ossimFilename         m_file;
+   bool                  m_tlmFlag;
+   std::vector<TilePart> m_tileParts;
+};
+
+#endif /* End of "#ifndef ossimJ2kTileIndex_HEADER" */
@@ -118,6 +118,12 @@ public:
                                std::ifstream& str,
                                ossim_uint32& length ) const;
 
+   /**
+    * @brief Tile-part offsets of the contiguous codestream (jp2c) box.
+    * @return true on success.
+    */
+   virtual bool getTileIndex(ossimJ2kTileIndex& index) const;
+
 protected:
 
    /** @brief Print tbox type as string if known. */
@@ -23,6 +23,7 @@
 #include <ossim/base/ossimIrect.h>
 #include <ossim/support_data/ossimNitfFileHeader.h>
 
+class ossimFileBlockCache;
 class ossimNitfImageHeader;
 class ossimNitfSymbolHeader;
 class ossimNitfLabelHeader;
@@ -59,6 +60,11 @@ public:
    /*!
     *  Opens the nitf file and attempts to parse.
     *  Returns true on success, false on error.
+    *
+    *  The headers are read in large blocks kept in memory (see
+    *  ossimFileBlockCache) and parsed from them, so the file header and the
+    *  subheaders of a multi segment file take a few reads.  The getNew*
+    *  methods parse from the same blocks.
     */
    bool parseFile(const ossimFilename &file);
 
@@ -82,11 +88,21 @@ public:
    
    virtual bool saveState(ossimKeywordlist& kwl, const ossimString& prefix)const;
 
+   /**
+    * Frees the header blocks kept, e.g. once the subheaders needed are
+    * made.  Later getNew* calls read them again.
+    */
+   void releaseHeaderCache();
+
 protected:
    ossimNitfImageHeader* allocateImageHeader()const;
+
+   /** @return The header block cache, made if released. */
+   ossimFileBlockCache* getHeaderCache()const;
    
    ossimFilename                    theFilename;
    ossimRefPtr<ossimNitfFileHeader> theNitfFileHeader;
+   mutable ossimRefPtr<ossimFileBlockCache> theHeaderCache;
 };
 
 #endif
@@ -50,6 +50,12 @@ public:
     */
    virtual std::ostream& print(std::ostream& out) const;
 
+   /**
+    * @brief Header only summary, see ossimInfoBase::getImageSummary.
+    * Sizes of each image segment, with its icords and igeolo fields.
+    */
+   virtual bool getImageSummary(ossimKeywordlist& kwl, const std::string& prefix) const;
+
    virtual bool getKeywordlist(ossimKeywordlist& kwl)const;
    
 private:
@@ -13,16 +13,30 @@
 #define ossimNitfTagInformation_HEADER
 
 #include <ossim/base/ossimObject.h>
+#include <ossim/base/ossimReferenced.h>
 #include <ossim/support_data/ossimNitfRegisteredTag.h>
+#include <vector>
 
 class ossimString;
 
+/**
+ * Name, length and data of a NITF tagged record extension (TRE).
+ *
+ * parseStream() only records the offsets and keeps the data bytes; the
+ * registered tag is made from them by the first getTagData(), so opening a
+ * file with many TREs does not parse the ones nobody asks for.  Copies share
+ * the bytes and the registered tag.
+ */
 class OSSIMDLLEXPORT ossimNitfTagInformation : public ossimObject
 {
 public:
    ossimNitfTagInformation(ossimRefPtr<ossimNitfRegisteredTag> tagData = 0);
    virtual ~ossimNitfTagInformation();
    
+   /**
+    * Reads the tag name, length and data bytes.  The registered tag is
+    * not made until getTagData().
+    */
    virtual void parseStream(std::istream& in);
    virtual void writeStream(std::ostream& out);
 
@@ -48,9 +62,19 @@ public:
    virtual std::ostream& print(std::ostream& out)const;
    void clearFields();
    
+   /** Makes the registered tag from the bytes read on the first call. */
    ossimRefPtr<ossimNitfRegisteredTag> getTagData();
    const ossimRefPtr<ossimNitfRegisteredTag> getTagData()const;
    void setTagData(ossimRefPtr<ossimNitfRegisteredTag> tagData);
+
+   /**
+    * Gets the tag data bytes, without the name and length fields.  Does
+    * not make the registered tag if not made yet.
+    */
+   void getTagDataBytes(std::vector<char>& bytes)const;
+
+   /** @return true if the registered tag was made or set. */
+   bool isTagDataParsed()const;
    ossimString getTagType() const;
    void setTagType(const ossimString& tagType) const;
 
@@ -61,6 +85,19 @@ public:
    
 private:
 
+   /** Tag data shared by the copies: the bytes until parsed, then the tag. */
+   struct TagData : public ossimReferenced
+   {
+      TagData() : theBytes(), theTag(0), theParsedFlag(true) {}
+
+      std::vector<char>                   theBytes;
+      ossimRefPtr<ossimNitfRegisteredTag> theTag;
+      bool                                theParsedFlag;
+   };
+
+   /** Makes theTagData->theTag from theTagData->theBytes if not done. */
+   void parseTagData()const;
+
    /**
     * This is a 6 byte field
     */
@@ -91,9 +128,10 @@ private:
    ossim_uint64 theTagDataOffset;
 
    /**
-    * Used to hold the tag data.
+    * Used to hold the tag data.  Mutable as parsing it on access does
+    * not change the contents of the tag.
     */
-   ossimRefPtr<ossimNitfRegisteredTag> theTagData;
+   mutable ossimRefPtr<TagData> theTagData;
 };
 
 #endif
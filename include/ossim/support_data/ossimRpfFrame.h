@@ -72,6 +72,24 @@ public:
                            ossim_uint32 spectralGroup,
                            ossim_uint32 row,
                            ossim_uint32 col)const;
+
+   /**
+    * Uncompresses the VQ subframe at row, col, 256x256 pixels, into buffer,
+    * band separate, through the first color table: bands is 1 for grey (CIB)
+    * or 3 for rgb (CADRG).  The color table is expanded once per call so the
+    * pixel loop only indexes arrays.
+    *
+    * @param compressedBuffer Work space for the compressed subframe,
+    * (64*64*12)/8 bytes.
+    *
+    * @return false if the subframe is missing or the frame has no compression
+    * section or color table, leaving buffer untouched.
+    */
+   bool uncompressSubFrame(ossim_uint8* buffer,
+                           ossim_uint32 bands,
+                           ossim_uint32 row,
+                           ossim_uint32 col,
+                           ossim_uint8* compressedBuffer)const;
    
    const ossimRpfCompressionSection* getCompressionSection()const
    {
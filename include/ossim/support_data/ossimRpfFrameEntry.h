@@ -46,6 +46,14 @@ public:
    
    void setEntry(const ossimFilename& rootDirectory,
                  const ossimFilename& pathToFrameFileFromRoot);
+
+   /**
+    * @brief Sets a path already resolved, e.g. from an a.toc index, without
+    * checking the file system for it.
+    */
+   void setEntry(const ossimFilename& rootDirectory,
+                 const ossimFilename& pathToFrameFileFromRoot,
+                 bool exists);
    
    const ossimFilename& getFullPath() const;
    const ossimString&   getRootDirectory() const;
@@ -38,6 +38,17 @@ public:
 
    /**
     * @brief Parses a.toc file.
+    *
+    * Unless keepFileHeader is set, the entries and frames are loaded from a
+    * binary index of the a.toc (<file>.idx) when it is current, skipping the
+    * nitf and rpf table parsing and the file checks of every frame.  Else
+    * the index is written after the parse.
+    *
+    * Preferences:
+    *   rpf.toc_index           Use and write the index, default true.
+    *   rpf.toc_index_directory Directory for the indexes instead of next to
+    *                           the a.toc, e.g. for read only media.
+    *
     * @param fileName File to parse.
     * @param keepFileHeader If true the ossimNitfFileHeader will be kept.
     * @return ossimErrorCodes::OSSIM_OK on success, ossimErrorCodes::OSSIM_ERROR on error.
@@ -151,6 +162,21 @@ private:
    void buildTocEntryList(ossimRpfHeader* rpfHeader);
    void allocateTocEntryList(ossim_uint32 numberOfEntries);
 
+   /** @return Index of the a.toc or empty if indexes are turned off. */
+   ossimFilename getIndexFile() const;
+
+   /**
+    * @brief Loads the rpf header and the entries from the index of m_filename.
+    * @return true on success, false if the index is missing or not current.
+    */
+   bool loadIndex();
+
+   /**
+    * @brief Writes the index of m_filename for the entries built.
+    * @param rpfHeaderOffset Offset of the rpf header in the a.toc.
+    */
+   void writeIndex(ossim_uint64 rpfHeaderOffset) const;
+
    /** @brief Walks through frames to find the first entry that exists... */
    void getFirstEntry(const ossimRpfTocEntry* rpfTocEntry,
                       ossimRpfFrameEntry& frameEntry) const;
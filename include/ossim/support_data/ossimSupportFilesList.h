@@ -11,13 +11,22 @@
 #ifndef ossimSupportFilesList_HEADER
 #define ossimSupportFilesList_HEADER
 
+#include <map>
+#include <set>
+#include <string>
 #include <vector>
 #include <ossim/base/ossimFilename.h>
+#include <OpenThreads/Mutex>
 
 class ossimKeywordlist;
 
 //*************************************************************************************************
 //! Singleton class for logging all support data files opened during a session.
+//!
+//! Also answers the probes for support files (.ovr, .geom, .omd...) made when images are
+//! opened.  Within a batch (beginBatch to endBatch) each directory is read once and exists()
+//! answers from that listing, so opening many images in one directory costs one directory read
+//! instead of a stat per probe.  Files written during a batch must be passed to refresh().
 //*************************************************************************************************
 class OSSIMDLLEXPORT ossimSupportFilesList
 {
@@ -33,11 +42,34 @@ public:
    //! Clears the list to ready for new accumulation:
    void clear() { m_list.clear(); }
 
+   //! Starts a batch; batches nest, and the listings are kept until the outermost endBatch.
+   void beginBatch();
+   void endBatch();
+
+   //! @return true if f exists; from the listing of its directory within a batch.
+   bool exists(const ossimFilename& f);
+
+   //! Updates the listing holding f, after f was written or removed during a batch.
+   void refresh(const ossimFilename& f);
+
 private:
-   ossimSupportFilesList()  { }
+   ossimSupportFilesList() : m_list(), m_batchCount(0), m_listings(), m_mutex() { }
    ~ossimSupportFilesList() { m_instance=0; }
 
+   //! Names in a directory; m_listed is false if it could not be read.
+   struct Listing
+   {
+      bool                  m_listed;
+      std::set<std::string> m_names;
+   };
+
+   //! @return Listing of the directory of f, read if needed; call with m_mutex locked.
+   Listing& getListing(const ossimFilename& f, std::string& name);
+
    std::vector<ossimFilename>       m_list;
+   ossim_uint32                     m_batchCount;
+   std::map<std::string, Listing>   m_listings;
+   OpenThreads::Mutex               m_mutex;
    static ossimSupportFilesList*    m_instance;
 };
 
@@ -226,6 +226,13 @@ public:
     */
    virtual std::ostream& print(std::ostream& out) const;
 
+   /**
+    * @brief Header only summary, see ossimInfoBase::getImageSummary.
+    * Sizes from the first directory (all directories if the overview flag is set), with
+    * the model_tie_point and model_pixel_scale tags when present.
+    */
+   virtual bool getImageSummary(ossimKeywordlist& kwl, const std::string& prefix) const;
+
    /**
     * @brief Print method.
     * 
@@ -405,6 +412,41 @@ private:
     * Eats the value field.  Either 4 or 8 bytes depending on the version.
     */
    void eatValue(std::istream& str, ossim_uint16 version) const;
+
+   /** A directory entry; its value is at theValueOffset in the values read. */
+   struct IfdEntry
+   {
+      ossim_uint16 theTag;
+      ossim_uint16 theType;
+      ossim_uint64 theCount;
+      ossim_uint64 theArraySizeInBytes;
+      ossim_uint64 theValueOffset;
+      bool         theLoadedFlag; //!< false for unhandled types and skipped values.
+   };
+
+   /**
+    * Reads the image file directory at ifdOffset from startPosition: one
+    * read for the entries and the next directory offset, and one per cluster
+    * of out of line values, instead of reads and seeks per tag.  Values are put
+    * 8 byte aligned in values and swapped to the system byte order.  Strip
+    * and tile offsets and byte counts are skipped, see isValueSkipped().
+    *
+    * @param nextOffset Initialized to the offset of the next directory, 0
+    * if none.
+    * @return true if the entries were read.
+    */
+   bool readIfd(std::istream& str, std::streampos startPosition, std::streamoff ifdOffset,
+                ossim_uint16 version,
+                std::vector<IfdEntry>& entries, std::vector<ossim_uint8>& values,
+                std::streamoff& nextOffset) const;
+
+   /** @return true if the value of tag is not needed for the print. */
+   bool isValueSkipped(ossim_uint16 tag) const;
+
+   /** @return Value at p.  Does byte swapping as needed. */
+   ossim_uint16 getBufferShort(const ossim_uint8* p) const;
+   ossim_uint32 getBufferLong(const ossim_uint8* p) const;
+   ossim_uint64 getBufferLongLong(const ossim_uint8* p) const;
    
    void swapBytes(ossim_uint8* v, ossim_uint16 type, ossim_uint64 count) const;
    
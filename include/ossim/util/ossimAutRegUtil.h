@@ -135,6 +135,17 @@ private:
     */
    bool populateObsSet();
 
+   /**
+    * @brief Drops the image points of control image img to the ground,
+    * on a job queue of the "threads" option threads.
+    * @param img Image index.
+    * @param imgPts Image points.
+    * @param worldPts Initialized to the ground points.
+    */
+   void dropControlPoints(int img,
+                          const std::vector<ossimDpt>& imgPts,
+                          std::vector<ossimGpt>& worldPts) const;
+
 
    /** @return true if key is set to true; false, if not. */
    bool keyIsTrue(ossimRefPtr<ossimKeywordlist> kwl, const std::string& key ) const;
@@ -16,6 +16,7 @@
 #include <ossim/base/ossimReferenced.h>
 #include <ossim/base/ossimRefPtr.h>
 #include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimKeywordlist.h>
 #include <vector>
 #include <fstream>
 
@@ -27,7 +28,6 @@ class ossimGpt;
 class ossimImageFileWriter;
 class ossimImageGeometry;
 class ossimIrect;
-class ossimKeywordlist;
 class ossimTilingRect;
 
 class OSSIM_DLL ossimBatchTest : public ossimReferenced
@@ -54,6 +54,16 @@ public:
    ossim_uint8 execute();
 
 private:
+   //! Resources used by the test commands of one test.
+   struct Performance
+   {
+      Performance() : m_wallTime(0.0), m_cpuTime(0.0), m_peakRss(0) {}
+
+      double       m_wallTime; //!< Seconds.
+      double       m_cpuTime;  //!< User plus system seconds of the commands.
+      ossim_uint64 m_peakRss;  //!< Largest resident set of a command in KB, 0 if unknown.
+   };
+
    //! Writes template test config file, either exhaustive long form for flexibility, or simple
    //! short-form for easier test creation.
    void writeTemplate(const ossimFilename& templateFile, bool long_form);
@@ -80,7 +90,16 @@ private:
                                const ossimKeywordlist& kwl,
                                const ossimString& testName,
                                bool logTime,
-                               const ossimFilename& tempFile=ossimFilename(""));
+                               const ossimFilename& tempFile=ossimFilename(""),
+                               Performance* perf=0);
+
+   //! Compares the resources used by the test commands against the test's baselines, or records
+   //! them as the new baselines when --record-baselines is given.
+   //! @return TEST_FAILED if any measure exceeds its baseline by more than the tolerance.
+   ossim_uint8 checkPerformance(const ossimString& prefix,
+                                const ossimKeywordlist& kwl,
+                                const ossimString& testName,
+                                const Performance& perf);
 
    //! Modifies the config's KWL to explicitly declare implied keywords.
    void preprocessKwl(const std::vector<std::string>& testList,
@@ -136,11 +155,16 @@ private:
    std::vector<std::string> m_preprocessTestList;
    std::vector<std::string> m_runTestList;
 
-   bool          m_templateModeActive;
-   ossimFilename m_configFileName;
-   ossimFilename m_outDir;
-   ossimFilename m_expDir;
-   std::ofstream m_logStr;
+   bool             m_templateModeActive;
+   ossimFilename    m_configFileName;
+   ossimFilename    m_outDir;
+   ossimFilename    m_expDir;
+   std::ofstream    m_logStr;
+
+   bool             m_recordBaselines;
+   double           m_perfTolerance; //!< From the command line, negative if not given.
+   ossimFilename    m_baselineFile;
+   ossimKeywordlist m_baselines;
 };
 
 #endif /* #ifndef ossimBatchTest_HEADER */
@@ -0,0 +1,96 @@
+//----------------------------------------------------------------------------
+//
+// File: ossimChipperServer.h
+// 
+// License:  LGPL
+// 
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description:
+// 
+// Long running chipper: keeps the handlers and chains of ossimChipperUtil
+// set up across requests to the same inputs and operation.
+// 
+//----------------------------------------------------------------------------
+// $Id$
+
+#ifndef ossimChipperServer_HEADER
+#define ossimChipperServer_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimReferenced.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/util/ossimChipperUtil.h>
+
+#include <iosfwd>
+#include <map>
+#include <string>
+
+class ossimKeywordlist;
+
+/**
+ * @brief Serves ossimChipperUtil requests from a stream, e.g. a pipe.
+ *
+ * A request is a chipper options keyword list, the same keywords as an
+ * --options file, ended by a line "end".  A line "quit" ends serve().
+ * Each request is answered with:
+ *
+ *   status: ok | error
+ *   setup: new | reused
+ *   output_file: <file>    (status ok)
+ *   message: <text>        (status error)
+ *   end
+ *
+ * Requests whose keys other than ossimChipperUtil::isRequestKey() (cut,
+ * output and writer options) match an earlier request reuse its chipper,
+ * with the image handlers, chains and their caches opened for it.  Up to
+ * getMaxSetups() chippers are kept; the least recently used goes first.
+ * The preferences keyword "chipper_server.max_setups" sets the default
+ * of 8.
+ *
+ * Requests are done one at a time on the serving thread.
+ */
+class OSSIM_DLL ossimChipperServer : public ossimReferenced
+{
+public:
+   ossimChipperServer();
+
+   /**
+    * @brief Answers requests read from in on out until the end of in or a
+    * "quit" line.
+    */
+   void serve( std::istream& in, std::ostream& out );
+
+   /**
+    * @brief Does one request.
+    * @param request Chipper options.
+    * @param message Initialized by this with the output file, or the error.
+    * @param reused Set to true if an earlier request's setup was used.
+    * @return true on success.
+    */
+   bool process( const ossimKeywordlist& request, std::string& message, bool& reused );
+
+   void setMaxSetups( ossim_uint32 count );
+   ossim_uint32 getMaxSetups() const;
+
+   /** @return Number of chippers set up. */
+   ossim_uint32 getNumberOfSetups() const;
+
+protected:
+   virtual ~ossimChipperServer();
+
+   /** @return The keys and values of request that make up the chains. */
+   static std::string getSetupKey( const ossimKeywordlist& request );
+
+   struct Setup
+   {
+      ossimRefPtr<ossimChipperUtil> m_chipper;
+      ossim_uint64                  m_lastUsed;
+   };
+
+   std::map<std::string, Setup> m_setups;
+   ossim_uint32                 m_maxSetups;
+   ossim_uint64                 m_requestCount;
+};
+
+#endif /* #ifndef ossimChipperServer_HEADER */
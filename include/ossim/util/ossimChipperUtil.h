@@ -32,6 +32,7 @@
 
 // Forward class declarations:
 class ossimArgumentParser;
+class ossimChainProfiler;
 class ossimDpt;
 class ossimFilename;
 class ossimGeoPolygon;
@@ -117,6 +118,25 @@ public:
     */
    void execute();
 
+   /**
+    * @brief Writes a product for another request to the same inputs and
+    * operation, reusing the handlers and chains of the last initialize().
+    *
+    * kwl replaces the options; only its area of interest and output options,
+    * see isRequestKey(), may differ from those initialize() had.  Used by
+    * ossimChipperServer.
+    *
+    * @note Throws ossimException on error.
+    */
+   void executeRequest( const ossimKeywordlist& kwl );
+
+   /**
+    * @return true if key is a per request option: the cut (area of interest)
+    * keys, the output file, the writer and its properties, tile size and
+    * thumbnail options.  All other keys make up the chains.
+    */
+   static bool isRequestKey( const std::string& key );
+
    void abort();
 
    /**
@@ -166,6 +186,19 @@ private:
 
    void setOptionsToChain( ossimIrect& aoi, const ossimKeywordlist& kwl );
 
+   /**
+    * @brief Gets the area of interest of source into aoi and sizes the output
+    * geometry to it, scaling for a thumbnail if asked for.
+    */
+   void initializeAreaOfInterest( ossimImageSource* source, ossimIrect& aoi );
+
+   /**
+    * @brief Writes aoi of source through a cutter to a new m_writer.
+    * @param progress Print percent complete if true.
+    * @note Throws ossimException on error.
+    */
+   void writeChip( ossimImageSource* source, const ossimIrect& aoi, bool progress );
+
    /**
     * @brief Initializes a color relief chain.
     * @return Ref pointer to image chain.
@@ -797,6 +830,9 @@ private:
    */
     ossimRefPtr<ossimImageSource> m_source;
 
+   /** Profiler of the --profile option, set for execute(). */
+   ossimRefPtr<ossimChainProfiler> m_profiler;
+
 };
 
 #endif /* #ifndef ossimChipperUtil_HEADER */
@@ -21,6 +21,7 @@
 #include <ossim/parallel/ossimJob.h>
 #include <ossim/parallel/ossimJobMultiThreadQueue.h>
 #include <OpenThreads/Mutex>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -41,6 +42,11 @@ class ossimFileProcessorInterface;
  * fw->initializeDefaultFilterList();
  * fw->setFileProcessor( this ); 
  * fw->walk(f);
+ *
+ * With setNumberOfWalkThreads(n > 1) and the wait on dir flag off, directories are listed by
+ * jobs on their own thread pool, each queuing its sub directories as new jobs, so the
+ * metadata latency of network file systems overlaps.  The number of files queued for
+ * processing is bounded by setMaxQueuedFiles(); listing waits while the file queue is full.
  */
 class OSSIM_DLL ossimFileWalker
 {
@@ -143,6 +149,21 @@ public:
 
    /** @brief Sets the max number of threads(jobs) to run at one time. */
    void setNumberOfThreads(ossim_uint32 nThreads);
+
+   /**
+    * @brief Sets the number of threads listing directories.
+    *
+    * Defaulted to 1 (directories walked on the calling thread). Ignored, i.e. walked
+    * serially, when the wait on dir flag is set since setRecurseFlag applies to the directory
+    * being walked.
+    */
+   void setNumberOfWalkThreads(ossim_uint32 nThreads);
+
+   /**
+    * @brief Sets the max number of files waiting in the processing queue. Defaulted to 4096.
+    * 0 for no limit.
+    */
+   void setMaxQueuedFiles(ossim_uint32 maxFiles);
    
 private:
 
@@ -170,6 +191,21 @@ private:
       
    }; // End: class ossimFileWalkerJob
 
+   /** @brief Private ossimJob class listing one directory for a concurrent walk. */
+   class ossimFileWalkerDirJob : public ossimJob
+   {
+   public:
+      ossimFileWalkerDirJob(ossimFileWalker* walker, const ossimFilename& dir);
+
+      /** Calls ossimFileWalker::listDir. */
+      virtual void start();
+
+   private:
+      ossimFileWalker* m_walker;
+      ossimFilename    m_dir;
+
+   }; // End: class ossimFileWalkerDirJob
+
    /** @brief Private ossimJobCallback class. */
    class ossimFileWalkerJobCallback : public ossimJobCallback
    {
@@ -187,6 +223,30 @@ private:
     * call to itself.  Individual files are processed in a job queue...
     */
    void walkDir(const ossimFilename& dir);
+
+   /**
+    * @brief Walks dir with directory listing jobs on m_dirQueue. Returns when all directories
+    * under dir are listed.
+    */
+   void walkDirConcurrent(const ossimFilename& dir);
+
+   /** @brief Walks dir concurrently or serially per the walk threads and wait on dir flag. */
+   void walkDirectory(const ossimFilename& dir);
+
+   /** @brief Adds a directory listing job for dir. */
+   void queueDir(const ossimFilename& dir);
+
+   /**
+    * @brief Queues the files of dir for processing and its sub directories for listing.
+    * Called from the directory jobs.
+    */
+   void listDir(const ossimFilename& dir);
+
+   /** @brief Adds a file processing job for file, waiting for room in the queue first. */
+   void queueFile(const ossimFilename& file);
+
+   /** @brief Copies m_filteredExtensions into the m_filteredExtensionSet lookup. */
+   void updateFilteredExtensionSet();
    
    /**
     * @brief Convenience method for file walker code to check file to see is
@@ -213,6 +273,11 @@ private:
    ossimFileProcessorInterface*          m_fileProcessor;
    ossimRefPtr<ossimJobMultiThreadQueue> m_jobQueue;
    std::vector<std::string>              m_filteredExtensions;
+   std::set<std::string>                 m_filteredExtensionSet;
+   ossimRefPtr<ossimJobMultiThreadQueue> m_dirQueue;
+   ossim_uint32                          m_walkThreads;
+   ossim_uint32                          m_maxQueuedFiles;
+   ossim_uint32                          m_pendingDirs;
    bool                                  m_recurseFlag;
    bool                                  m_waitOnDirFlag;
    bool                                  m_abortFlag;
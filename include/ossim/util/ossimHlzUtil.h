@@ -75,6 +75,12 @@ protected:
    void setProductGSD(const double& meters_per_pixel);
    bool computeHLZ();
 
+   /**
+    * Bins the points of all point clouds over the AOI into m_pcRaster, once, so that level-2
+    * tests read the raster instead of querying the clouds per patch.
+    */
+   void rasterizePointClouds();
+
    double m_slopeThreshold; // (degrees)
    double m_roughnessThreshold; // peak deviation from plane (meters)
    double m_hlzMinRadius; // meters
@@ -87,8 +93,10 @@ protected:
    ossim_uint8 m_marginalLzValue;
    ossim_uint8 m_goodLzValue;
    bool m_useLsFitMethod;
+   bool m_useIntegralImages; // ls-fit from summed-area tables
    ossimRefPtr<ossimImageSource> m_combinedElevSource;
    std::vector< ossimRefPtr<ossimPointCloudHandler> > m_pcSources;
+   std::vector<ossim_uint8> m_pcRaster; // over m_aoiViewRect, PC_POINTS | PC_OBSTRUCTION bits
    std::vector<MaskSource> m_maskSources;
 
    // For debugging:
@@ -136,6 +144,37 @@ protected:
       virtual bool level1Test();
    };
 
+   /**
+    * Least-squares fit of all the patches whose origin lies in a tile, from summed-area tables
+    * of z, x*z, y*z and z^2 over the tile, so each plane and its RMS deviation take O(1). The
+    * peak deviation is then checked only on patches passing the slope and RMS tests.
+    */
+   class IntegralPatchProcessorJob : public PatchProcessorJob
+   {
+   public:
+      IntegralPatchProcessorJob(ossimHlzUtil* hlzUtil, const ossimIrect& origins,
+                                ossim_int32 step);
+
+      virtual void start();
+      virtual bool level1Test();
+
+   private:
+      struct Sums
+      {
+         double n, z, xz, yz, zz;
+      };
+
+      /** Sums over posts [x0, x1) x [y0, y1) of the tile region, upper bounds exclusive. */
+      Sums getSums(ossim_int32 x0, ossim_int32 y0, ossim_int32 x1, ossim_int32 y1) const;
+
+      ossimIrect m_origins;
+      ossim_int32 m_step;
+      ossimIpt m_regionUL;
+      ossim_int32 m_tableWidth; // region width + 1
+      double m_zRef; // subtracted from z, keeps the sums small
+      std::vector<Sums> m_table;
+   };
+
 };
 
 #endif
@@ -24,6 +24,7 @@
 #include <ossim/base/ossimRefPtr.h>
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/imaging/ossimOverviewBuilderBase.h>
+#include <OpenThreads/Condition>
 #include <OpenThreads/Mutex>
 #include <ostream>
 #include <vector>
@@ -215,6 +216,42 @@ public:
    /** @return true if CREATE_HISTOGRAM_R0_KW is found and set to true. */
    bool createHistogramR0() const;
 
+   /**
+    * @brief Sets the histogram blocks flag keyword HISTOGRAM_BLOCKS_KW used by
+    * processFile method.
+    *
+    * @param flag If true the full histogram keeps the counts of each block
+    * of tiles in a .hbk file for later updates.  Turns on histogram building.
+    */
+   void setHistogramBlocksFlag( bool flag );
+
+   /** @return true if HISTOGRAM_BLOCKS_KW is found and set to true. */
+   bool histogramBlocks() const;
+
+   /**
+    * @brief Sets compute statistics flag keyword COMPUTE_STATISTICS_KW used
+    * by processFile method.
+    *
+    * @param flag If true the statistics of each entry (see
+    * ossimImageMomentsSource) are written to a .stats file.
+    */
+   void setComputeStatisticsFlag( bool flag );
+
+   /** @return true if COMPUTE_STATISTICS_KW is found and set to true. */
+   bool computeStatistics() const;
+
+   /**
+    * @brief Sets key UPDATE_HISTOGRAM_KW, turning on histogram blocks.
+    *
+    * @param rect "ulx,uly,lrx,lry" full resolution region changed since the
+    * .hbk file was written.  The histogram is then rewritten recounting only
+    * the blocks touching it.
+    */
+   void setUpdateHistogramRect( const std::string& rect );
+
+   /** @return UPDATE_HISTOGRAM_KW rect, NaN if not set. */
+   ossimIrect getUpdateHistogramRect() const;
+
    /** @return true if any of the histogram options are set. */
    bool hasHistogramOption() const;
 
@@ -352,6 +389,18 @@ public:
    void setNumberOfThreads( ossim_uint32 threads );
    void setNumberOfThreads( const std::string& threads );
 
+   /**
+    * @brief Sets the number of files the file jobs may be opening at the
+    * same time.
+    *
+    * Opens are serialized by default as not every reader is thread safe on
+    * open.  On network storage opening is most of the time spent on a small
+    * file, so allowing several keeps the threads busy.
+    *
+    * @param opens Defaults to 1 if CONCURRENT_OPENS_KW is not found.
+    */
+   void setConcurrentOpens( ossim_uint32 opens );
+
    /** @return The list of filtered out files. */
    const std::vector<std::string>& getFilteredImages() const;
 
@@ -398,6 +447,28 @@ private:
                        bool useEntryIndex,
                        bool& consumedHistogramOptions);
 
+   /**
+    * @brief Creates the overviews of all entries through one
+    * ossimOverviewBuilderBase::executeBatch, each entry on a handler of its
+    * own, so entries are built in parallel.
+    */
+   void createOverviewBatch(ossimRefPtr<ossimImageHandler>& ih,
+                            ossimRefPtr<ossimOverviewBuilderBase>& ob,
+                            const std::vector<ossim_uint32>& entryList,
+                            bool& consumedHistogramOptions);
+
+   /**
+    * @brief Output file and histogram mode of the current entry of ih,
+    * removing overviews to rebuild.
+    * @return false if the entry has the required overviews.
+    */
+   bool prepareOverview(ossimRefPtr<ossimImageHandler>& ih,
+                        ossimRefPtr<ossimOverviewBuilderBase>& ob,
+                        bool useEntryIndex,
+                        ossimFilename& outputFile,
+                        ossimHistogramMode& histoMode,
+                        bool& consumedHistogramOptions);
+
    /** @return true if entry has required overviews. */
    bool hasRequiredOverview( ossimRefPtr<ossimImageHandler>& ih,
                              ossimRefPtr<ossimOverviewBuilderBase>& ob );
@@ -411,6 +482,8 @@ private:
                        ossim_uint32 entry,
                        bool useEntryIndex);
 
+   void computeStatistics(ossimRefPtr<ossimImageHandler>& ih);
+
    void computeMinMax(ossimRefPtr<ossimImageHandler>& ih);
 
    void computeMinMax(ossimRefPtr<ossimImageHandler>& ih,
@@ -442,6 +515,12 @@ private:
     */
    ossim_uint32 getNumberOfThreads() const;
 
+   /**
+    * @return Files that may be opened at the same time.  Defaults to 1 if
+    * CONCURRENT_OPENS_KW is not found.
+    */
+   ossim_uint32 getConcurrentOpens() const;
+
    /** @return the next writer prop index. */
    ossim_uint32 getNextWriterPropIndex() const;
 
@@ -494,6 +573,11 @@ private:
    ossimFileWalker*   m_fileWalker;
    OpenThreads::Mutex m_mutex;
 
+   /** Bounds the opens in progress to getConcurrentOpens(). */
+   OpenThreads::Mutex     m_openMutex;
+   OpenThreads::Condition m_openCondition;
+   ossim_uint32           m_opensInProgress;
+
    ossim_int32 m_errorStatus;
 
    /** Hold images we never want to process. */
@@ -159,6 +159,27 @@ public:
                   bool dnoFlag,
                   ossimKeywordlist& kwl) const;
 
+   /**
+    * @brief Header only summary of file from ossimInfoFactoryRegistry: entries, sizes, bands
+    * and any corners in the header.  No image handler is opened, no pixels are read and no
+    * projection is made.
+    * @param file Image to probe.
+    * @param kwl Initialized by this method.
+    * @param prefix Prefix for the keys, e.g. "file0.".
+    * @return true if the file's format has a summary.
+    */
+   bool probeImage(const ossimFilename& file,
+                   ossimKeywordlist& kwl,
+                   const std::string& prefix) const;
+
+   /**
+    * @brief probeImage on each file listed in listFile, one per line ("-" reads standard
+    * input).  Each result is written as soon as it is made, with prefix file<n>., to the
+    * output file if set, else standard out.
+    * @return Number of files probed.
+    */
+   ossim_uint32 probeImages(const ossimFilename& listFile) const;
+
    /**
     * @brief Prints factories.
     * @param keywordListFlag If true the result of a saveState will be output
@@ -182,6 +203,15 @@ public:
     */
    void getImagePalette(ossimKeywordlist& kwl);
 
+   /**
+    * @brief Populates keyword list with the statistics of each band and
+    * the covariance between bands (see ossimImageMomentsSource::saveStatistics).
+    * This requires open image.
+    *
+    * @param kwl Keyword list to populate.
+    */
+   void getImageStatistics(ossimKeywordlist& kwl);
+
    /**
     * @brief Populates keyword list with general image information.
     *
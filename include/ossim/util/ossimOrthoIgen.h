@@ -122,6 +122,8 @@ protected:
    ossimFilename theCombinerTemplate;
    ossimFilename theAnnotationTemplate;
    ossimFilename theWriterTemplate;
+   ossimFilename theProfileFilename; //!< Chain profile output, see ossimChainProfiler.
+   ossimFilename theTimelineFilename; //!< Chrome trace output, see ossimTimeline.
    ossimFilename theSupplementaryDirectory;
    ossimString   theSlaveBuffers;
    OriginType    theCutOriginType;
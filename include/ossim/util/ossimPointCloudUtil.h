@@ -18,6 +18,7 @@
 #include <ossim/base/ossimIrect.h>
 #include <ossim/base/ossimArgumentParser.h>
 #include <ossim/imaging/ossimImageGeometry.h>
+#include <ossim/point_cloud/ossimPointCloudGridder.h>
 #include <ossim/point_cloud/ossimPointCloudHandler.h>
 #include <ossim/point_cloud/ossimPointCloudUtilityFilter.h>
 
@@ -65,11 +66,22 @@ protected:
    bool loadPC();
    bool loadDem();
 
+   /** Creates a gridder on the PC with the reducer, halo, budget and threads options. */
+   ossimRefPtr<ossimPointCloudGridder> newGridder(ossimPointCloudGridder::Reducer reducer);
+
    enum Operation { HIGHEST_DEM, LOWEST_DEM, HIGHEST_LOWEST } m_operation;
    ossimRefPtr<ossimImageGeometry> m_prodGeom;
    ossimRefPtr<ossimPointCloudHandler> m_pcHandler;
    ossimRefPtr<ossimPointCloudImageHandler> m_pciHandler;
    ossimRefPtr<ossimPointCloudUtilityFilter> m_pcuFilter;
+   ossimRefPtr<ossimPointCloudGridder> m_gridder; // --reducer DEM, written as is
+   ossimRefPtr<ossimPointCloudGridder> m_highest;
+   ossimRefPtr<ossimPointCloudGridder> m_lowest;
+   ossimRefPtr<ossimPointFilterChain> m_pointFilter; // --classes, --returns, --z-range
+   ossimString m_reducer;
+   ossim_uint32 m_halo;
+   ossim_uint32 m_tileBudget;
+   ossim_uint32 m_numThreads;
    double m_gsd;
    ossimFilename m_lutFile;
    ossimFilename m_prodFile;
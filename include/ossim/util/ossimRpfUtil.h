@@ -18,9 +18,11 @@
 
 #include <ossim/base/ossimReferenced.h>
 #include <ossim/imaging/ossimImageGeometry.h> 
+#include <vector>
 
 class ossimFilename;
 class ossimGpt;
+class ossimRpfFrame;
 class ossimRpfToc;
 class ossimRpfTocEntry;
 
@@ -28,14 +30,20 @@ class OSSIM_DLL ossimRpfUtil : public ossimReferenced
 {
 public:
 
-   /** @brief default constructor */
+   /**
+    * @brief default constructor
+    *
+    * Reads the rpf.util_threads preference, the number of threads frame
+    * headers are parsed and dot rpf files written on.  Default 1.
+    */
    ossimRpfUtil();
 
 
    /**
     * @brief Write dot rpf file(s) to output directory from a.toc file.
     *
-    * This creates a dot rpf file for each entry.
+    * This creates a dot rpf file for each entry.  Entries are written
+    * concurrently when rpf.util_threads is more than 1.
     *
     * @param aDotFile The a.toc file.
     *
@@ -51,6 +59,25 @@ public:
                          const ossimFilename& outputDir,
                          ossim_uint32 entry);
 
+   /**
+    * @brief Parses the headers of frame files.
+    *
+    * files[i] is parsed into frames[i], which is null if it could not be
+    * parsed.  Files are parsed concurrently on rpf.util_threads threads.
+    * Each thread has one frame file open at a time, so no more files than
+    * threads are ever open however many are given.
+    *
+    * @param files Full paths of the frame files.
+    *
+    * @param frames Initialized to the parsed frames.
+    *
+    * @param minimalParse If true, only the headers, attributes and replace
+    * update table are parsed.  See ossimRpfFrame::parseFile.
+    */
+   void parseFrames( const std::vector<ossimFilename>& files,
+                     std::vector< ossimRefPtr<ossimRpfFrame> >& frames,
+                     bool minimalParse=true ) const;
+
 protected:
 
    /**
@@ -79,6 +106,9 @@ private:
    void getDotRfpFilenameForEntry(const ossimFilename& outputDir,
                                   ossim_uint32 entry,
                                   ossimFilename& outFile) const;
+
+   /** @brief Threads from the rpf.util_threads preference. */
+   ossim_uint32 m_threads;
    
 }; // Matches: class ossimRpfUtil
 
@@ -12,6 +12,7 @@
 #include <ossim/base/ossimRefPtr.h>
 #include <ossim/base/ossimProcessInterface.h>
 #include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimDpt.h>
 #include <ossim/base/ossimIpt.h>
 #include <ossim/base/ossimIrect.h>
 #include <ossim/base/ossimGrect.h>
@@ -25,7 +26,9 @@
 #include <ossim/parallel/ossimJob.h>
 #include <ossim/parallel/ossimJobMultiThreadQueue.h>
 #include <ossim/point_cloud/ossimPointCloudHandler.h>
+#include <OpenThreads/Mutex>
 #include <OpenThreads/ReadWriteMutex>
+#include <utility>
 #include <vector>
 
 /*!
@@ -56,6 +59,53 @@ protected:
    void initLandsat8();
    void computeKMeans();
 
+   /**
+    * Edge of the pixel grid crossed by a shoreline, as twice its midpoint: (2x+1, 2y) between
+    * pixels (x,y) and (x+1,y), (2x, 2y+1) between (x,y) and (x,y+1).
+    */
+   typedef std::pair<ossim_int32, ossim_int32> EdgeKey;
+
+   /** Shoreline traced in one tile, in view coordinates. Open ones end on the tile seams. */
+   struct Polyline
+   {
+      std::vector<ossimDpt> m_points;
+      EdgeKey m_first;
+      EdgeKey m_last;
+      bool m_closed;
+   };
+
+   /** Classifies and traces the cells of one tile of the AOI. */
+   class TileJob : public ossimJob
+   {
+   public:
+      TileJob(ossimShorelineUtil* util, const ossimIrect& cells) : m_util(util), m_cells(cells) {}
+      virtual void start();
+   private:
+      ossimShorelineUtil* m_util;
+      ossimIrect m_cells;
+   };
+
+   /**
+    * Tiled vector output: the index, threshold and smoothing are computed per tile (with a halo
+    * for the smoothing) on a job queue, the water boundary of each tile is traced with marching
+    * squares, and the pieces are joined across the tile seams before writing GeoJSON.
+    */
+   bool executeTiled();
+
+   /**
+    * @brief Class values over rect (water, marginal or land; smoothed if requested), land outside
+    * the AOI.  Row major, rect.width() wide.
+    */
+   void getClassValues(const ossimIrect& rect, std::vector<ossim_float32>& values);
+
+   /** Traces the cells with upper left pixels in cells; appends to m_polylines. */
+   void traceTile(const ossimIrect& cells);
+
+   /** Joins the open polylines end to end. */
+   void stitchPolylines();
+
+   void writeGeoJson(std::ostream& out) const;
+
    /** @brief Hidden from use copy constructor. */
    ossimShorelineUtil( const ossimShorelineUtil& obj );
 
@@ -77,6 +127,11 @@ protected:
    double m_smoothing;
    bool m_doEdgeDetect;
    ossimFilename m_vectorFilename;
+   ossim_uint32 m_tileSize; // 0 = whole AOI through the potrace plugin
+   ossim_uint32 m_numThreads;
+   std::vector<Polyline> m_polylines;
+   OpenThreads::Mutex m_polylineMutex;
+   OpenThreads::Mutex m_readMutex; // Input chains are not thread safe.
 
    //ossimRefPtr<ossimHistogramWriter> m_histoWriter;
 };
@@ -12,7 +12,8 @@
 #include <ossim/projection/ossimMapProjection.h>
 #include <ossim/imaging/ossimMemoryImageSource.h>
 #include <ossim/parallel/ossimJob.h>
-#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <ossim/parallel/ossimJobWorkStealingQueue.h>
+#include <OpenThreads/Mutex>
 #include <OpenThreads/ReadWriteMutex>
 
 /*!
@@ -24,6 +25,9 @@ class OSSIMDLLEXPORT ossimViewshedUtil : public ossimChipProcUtil
    friend class SectorProcessorJob;
    friend class RadialProcessorJob;
    friend class RadialProcessor;
+   friend class XDrawSectorJob;
+   friend class HeightRowsJob;
+   friend class ObserverProcessorJob;
 
 public:
    ossimViewshedUtil();
@@ -86,6 +90,45 @@ protected:
    bool optimizeFOV();
    bool computeViewshed(); // assigns m_outBuffer with single-band viewshed image
 
+   /**
+    * XDraw engine: sweeps one 45 deg sector ring by ring outward from the observer. Each cell's
+    * horizon slope is interpolated from the two cells of the previous ring that straddle its
+    * line of sight, so every DEM post is read once, in one batch call per ring. Also latches
+    * the sector's radial elevations for the horizon profile.
+    */
+   void doXDrawSector(ossim_uint32 sector);
+
+   /**
+    * doXDrawSector() for any observer, painting buffer. radials may be null if the horizon is
+    * not wanted.
+    */
+   void doXDrawSector(ossim_uint32 sector, const ossimDpt& obsVpt, double obsHgt,
+                      ossimImageData* buffer, Radial* radials);
+
+   /**
+    * Heights above ellipsoid of the n view points start + k*dir, from m_heights when loaded,
+    * else from m_geom. NaN where unknown.
+    */
+   void getHeights(const ossimDpt& start, const ossimIpt& dir, ossim_uint32 n,
+                   std::vector<double>& heights) const;
+
+   /**
+    * Batch mode, with an observers file: loads the heights under all the observers' visibility
+    * squares once, runs the observers as jobs with the xdraw engine and writes either a count
+    * of the observers seeing each pixel or one output per observer.
+    */
+   bool executeBatch();
+
+   /** Reads m_observerFile into m_observers. */
+   void loadObservers();
+
+   /** Fills m_heights over m_heightsRect, by blocks of rows on the job queue. */
+   void loadHeights();
+   void loadHeightRows(ossim_int32 firstRow, ossim_uint32 numRows);
+
+   /** Computes the viewshed of observer index into m_batchBuffers or m_outBuffer counts. */
+   void doObserver(ossim_uint32 index);
+
    ossimGpt  m_observerGpt;
    ossimDpt  m_observerVpt;
    double m_obsHgtAbvTer; // meters above the terrain
@@ -101,14 +144,26 @@ protected:
    ossim_uint8 m_overlayValue;
    ossim_int32 m_reticleSize;
    bool m_simulation;
-   ossimRefPtr<ossimJobMultiThreadQueue> m_jobMtQueue;
+   ossimRefPtr<ossimJobWorkStealingQueue> m_jobMtQueue;
    ossim_uint32 m_numThreads;
    double m_startFov;
    double m_stopFov;
    bool m_threadBySector;
+   bool m_useXDraw; // "--engine xdraw", else radials
    ossimFilename m_horizonFile;
    std::map<double, double> m_horizonMap;
 
+   // Batch mode:
+   ossimFilename m_observerFile;
+   std::vector<ossimGpt> m_observers;
+   std::vector<ossimDpt> m_observerVpts; // snapped to whole pixels
+   std::vector<double> m_observerHgts; // height above ellipsoid of the eye
+   bool m_countVisibility; // false for one output per observer
+   ossimIrect m_heightsRect;
+   std::vector<float> m_heights;
+   std::vector< ossimRefPtr<ossimImageData> > m_batchBuffers;
+   OpenThreads::Mutex m_batchMutex;
+
    // For debugging:
    double d_accumT;
    OpenThreads::Mutex d_mutex;
@@ -155,6 +210,52 @@ private:
    ossim_uint32 m_numRadials;
 };
 
+/** Runs ossimViewshedUtil::doXDrawSector() for one sector. */
+class XDrawSectorJob : public ossimJob
+{
+   friend class ossimViewshedUtil;
+
+private:
+   XDrawSectorJob(ossimViewshedUtil* vs_util, ossim_uint32 sector)
+   : m_vsUtil (vs_util), m_sector (sector) {}
+
+   virtual void start();
+
+   ossimViewshedUtil* m_vsUtil;
+   ossim_uint32 m_sector;
+};
+
+/** Loads a block of rows of ossimViewshedUtil::m_heights. */
+class HeightRowsJob : public ossimJob
+{
+   friend class ossimViewshedUtil;
+
+private:
+   HeightRowsJob(ossimViewshedUtil* vs_util, ossim_int32 first_row, ossim_uint32 num_rows)
+   : m_vsUtil (vs_util), m_firstRow (first_row), m_numRows (num_rows) {}
+
+   virtual void start();
+
+   ossimViewshedUtil* m_vsUtil;
+   ossim_int32 m_firstRow;
+   ossim_uint32 m_numRows;
+};
+
+/** Runs ossimViewshedUtil::doObserver() for one observer of a batch. */
+class ObserverProcessorJob : public ossimJob
+{
+   friend class ossimViewshedUtil;
+
+private:
+   ObserverProcessorJob(ossimViewshedUtil* vs_util, ossim_uint32 index)
+   : m_vsUtil (vs_util), m_index (index) {}
+
+   virtual void start();
+
+   ossimViewshedUtil* m_vsUtil;
+   ossim_uint32 m_index;
+};
+
 /**
  * This class provides a common entry point for both SectorProcessorJob and RadialProcessorJob for
  * processing a single radial. Eventually, SectorProcessorJob can likely go away (invoked with the
@@ -17,6 +17,9 @@
 #include <ossim/base/ossimString.h>
 #include <ossim/base/ossimErrorContext.h>
 #include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimMemoryMappedFile.h>
+#include <ossim/base/ossimRefPtr.h>
 #include <ossim/vec/vpf.h>
 
 class OSSIM_DLL ossimVpfTable
@@ -73,7 +76,60 @@ public:
    ossimString getColumnValueAsString(const ossimString& columnName);
    ossim_int32 getColumnPosition(const ossimString& columnName)const;
 
+   /*!
+    * Typed access that bypasses the vpfutil row reader: the table is memory
+    * mapped and the offset of every row, variable length rows included, is
+    * indexed once on first use.  Rows are one based as for read_row.
+    *
+    * Integer values are those of I, S and, by id, K columns; floating point
+    * values those of I, S, F and R columns, with VPF nulls as nan.  Only the
+    * first element of a row is taken.  Coordinates are the x, y of C, Z, B
+    * and Y columns.
+    *
+    * The methods return false if the column has another type or the table
+    * can not be mapped, e.g. it is not on a local file system.
+    */
+   bool getColumnValues(long columnNumber, std::vector<ossim_int32>& values)const;
+   bool getColumnValues(long columnNumber, std::vector<ossim_float64>& values)const;
+   bool getColumnValue(ossim_int32 rowNumber, long columnNumber, ossim_int32& value)const;
+
+   /*!
+    * Gets the coordinates of all rows, those of row r (one based) being
+    * points[rowStarts[r-1]] up to points[rowStarts[r]].
+    */
+   bool getCoordinates(long columnNumber,
+                       std::vector<ossimDpt>& points,
+                       std::vector<ossim_uint32>& rowStarts)const;
+   bool getCoordinates(ossim_int32 rowNumber,
+                       long columnNumber,
+                       std::vector<ossimDpt>& points)const;
+
 protected:
+   /*!
+    * Maps the table and indexes its rows on first call.
+    * @return true if the table is mapped.
+    */
+   bool mapTable()const;
+
+   /*!
+    * @return Start of the elements of a column in a row of the mapped table,
+    * with their count, or null if out of range.
+    */
+   const ossim_uint8* getFieldData(ossim_int32 rowNumber,
+                                   long columnNumber,
+                                   ossim_int32& count)const;
+
+   /*!
+    * Moves data past the field of column columnNumber starting there,
+    * getting the start and count of its elements.
+    * @return false if the field has an unknown type or runs past end.
+    */
+   bool skipField(const ossim_uint8*& data,
+                  const ossim_uint8* end,
+                  long columnNumber,
+                  const ossim_uint8*& elements,
+                  ossim_int32& count)const;
+
    /*!
     * this structure is in vpf_util/vpftable.h file.
     * it holds all the access information to the table.
@@ -84,6 +140,16 @@ protected:
     * Will hold the complete path and name to this table.
     */
    ossimFilename   theTableName;
+
+   mutable ossimRefPtr<ossimMemoryMappedFile> theMappedFile;
+
+   /*!
+    * Offsets of the rows in theMappedFile, row r at theRowOffsets[r-1], and
+    * the end of the last row.
+    */
+   mutable std::vector<ossim_uint64> theRowOffsets;
+   mutable bool                      theMapAttemptedFlag;
+   mutable bool                      theSwapFlag;
 };
 
 #endif
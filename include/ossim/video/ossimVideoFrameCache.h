@@ -0,0 +1,114 @@
+//*************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// DESCRIPTION: Decoded frame cache with read ahead for video frame sources.
+//
+//*************************************************************************************************
+#ifndef ossimVideoFrameCache_HEADER
+#define ossimVideoFrameCache_HEADER
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimReferenced.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageGeometry.h>
+#include <ossim/video/ossimVideoImageSource.h>
+#include <OpenThreads/Condition>
+#include <OpenThreads/Mutex>
+#include <map>
+#include <set>
+
+class ossimVideoFrameCacheThread;
+
+//*************************************************************************************************
+//  CLASS DESCRIPTION:
+//! Keeps decoded frames of a video frame source, with the image geometry of each, and decodes
+//! the frames ahead of the last one requested on a background thread, in the direction play
+//! is going. Meant for stepping or scrubbing through video at a steady rate:
+//!
+//!    ossimRefPtr<ossimVideoFrameCache> cache = new ossimVideoFrameCache(frameSource.get());
+//!    for (ossim_uint32 i = 0; i < n; ++i)
+//!       process(cache->getFrame(i), cache->getFrameGeometry(i));
+//!
+//! The frame source (a plugin's ossimVideoImageSource, connected to its video) is not thread
+//! safe: once given to the cache it must only be used through it. Frames farthest from the
+//! last request are dropped past the capacity. Returned frames are shared with the cache and must
+//! not be modified; they stay valid after being dropped.
+//*************************************************************************************************
+class OSSIMDLLEXPORT ossimVideoFrameCache : public ossimReferenced
+{
+public:
+   //! @param frameSource  Decoder of the frames.
+   //! @param capacity     Number of decoded frames kept.
+   //! @param framesAhead  Frames decoded ahead on the background thread; 0 for none.
+   ossimVideoFrameCache(ossimVideoImageSource* frameSource,
+                        ossim_uint32 capacity = 32,
+                        ossim_uint32 framesAhead = 8);
+
+   //! Returns frame frameNumber (count from start of video), decoding it if not cached, or
+   //! NULL if it could not be decoded. Sets the play position and direction for the read ahead.
+   ossimRefPtr<ossimImageData> getFrame(ossim_uint32 frameNumber);
+
+   //! Returns the image geometry of frame frameNumber, cached with the frame.
+   ossimRefPtr<ossimImageGeometry> getFrameGeometry(ossim_uint32 frameNumber);
+
+   //! Changes the read ahead depth, capped to the capacity. 0 stops the background thread.
+   void setFramesAhead(ossim_uint32 framesAhead);
+   ossim_uint32 getFramesAhead() const;
+
+   //! Drops all decoded frames, e.g. after the source is seeked or reopened.
+   void clear();
+
+   //! Number of frames presently decoded, for diagnostics.
+   ossim_uint32 getNumberOfCachedFrames() const;
+
+   //! Loop of the background thread.
+   void runReadAhead();
+
+protected:
+   virtual ~ossimVideoFrameCache();
+
+   struct Frame
+   {
+      ossimRefPtr<ossimImageData>     m_tile;
+      ossimRefPtr<ossimImageGeometry> m_geometry;
+   };
+
+   //! Returns the cached or newly decoded frame.
+   Frame fetch(ossim_uint32 frameNumber);
+
+   //! Decodes a frame; serialized on m_decoderMutex. Called with m_mutex unlocked.
+   bool decode(ossim_uint32 frameNumber, Frame& frame);
+
+   //! Next frame for the read ahead to decode, or false if none. Called with m_mutex locked.
+   bool nextFrameToRead(ossim_uint32& frameNumber) const;
+
+   //! Drops the frames farthest from m_position past m_capacity. Called with m_mutex locked.
+   void trim();
+
+   ossim_uint32 getNumberOfFrames() const;
+
+   void startThread();
+   void stopThread();
+
+   ossimRefPtr<ossimVideoImageSource>  m_frameSource;
+   ossim_uint32                        m_capacity;
+   ossim_uint32                        m_framesAhead;
+
+   OpenThreads::Mutex                  m_decoderMutex;
+
+   // Shared with the read ahead, guarded by m_mutex:
+   mutable OpenThreads::Mutex          m_mutex;
+   OpenThreads::Condition              m_workReady;
+   OpenThreads::Condition              m_frameReady;
+   std::map<ossim_uint32, Frame>       m_frames;
+   std::set<ossim_uint32>              m_inProgress;
+   ossim_uint32                        m_position;  //!< last frame requested
+   ossim_int32                         m_direction; //!< +1 playing forward, -1 backward
+   bool                                m_stopFlag;
+   ossimVideoFrameCacheThread*         m_thread;
+};
+
+#endif
@@ -236,6 +236,30 @@ void ossim2dTo2dTransform::inverse(ossimDpt&  modify_this) const
    modify_this = output;
 }
 
+void ossim2dTo2dTransform::forwardPoints(const ossimDpt* input,
+                                         ossimDpt*       output,
+                                         ossim_uint32    count) const
+{
+   ossimDpt pt;
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      forward(input[i], pt);
+      output[i] = pt;
+   }
+}
+
+void ossim2dTo2dTransform::inversePoints(const ossimDpt* input,
+                                         ossimDpt*       output,
+                                         ossim_uint32    count) const
+{
+   ossimDpt pt;
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      inverse(input[i], pt);
+      output[i] = pt;
+   }
+}
+
 ossimDpt ossim2dTo2dTransform::getOrigin()const
 {
    return ossimDpt(0,0);
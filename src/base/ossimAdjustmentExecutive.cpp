@@ -700,7 +700,7 @@ printParameterCorrectionSummary(std::ostream& out) const
       out<<setw(12)<<theSolAttributes->theTotalCorrections(pc);
       out<<setw(12)<<theSolAttributes->theLastCorrections(pc);
       out<<setw(12)<<theParInitialStdDev[pc-1];
-      out<<setw(12)<<sqrt(theSolAttributes->theFullCovMatrix(pc,pc));
+      out<<setw(12)<<sqrt(theSolAttributes->propagatedVariance(pc));
    }
    out<<endl;
 
@@ -742,7 +742,7 @@ printObservationCorrectionSummary(std::ostream& out) const
          out<<setw(12)<<theSolAttributes->theTotalCorrections(idx)*factor;
          out<<setw(12)<<theSolAttributes->theLastCorrections(idx)*factor;
          out<<setw(12)<<theObsInitialStdDev[obs*3+k]*factor;
-         out<<setw(12)<<sqrt(theSolAttributes->theFullCovMatrix(idx,idx))*factor;
+         out<<setw(12)<<sqrt(theSolAttributes->propagatedVariance(idx))*factor;
          out<<endl<<"                       ";
       }
    }
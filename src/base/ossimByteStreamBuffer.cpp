@@ -1,10 +1,17 @@
 #include <ossim/base/ossimByteStreamBuffer.h>
+#include <algorithm>
 #include <cstring> /* for memcpy */
+#include <ostream>
 
 ossimByteStreamBuffer::ossimByteStreamBuffer()
    :m_buffer(0),
     m_bufferSize(0),
-    m_sharedBuffer(false)
+    m_sharedBuffer(false),
+    m_segmentSize(0),
+    m_segments(),
+    m_dataSize(0),
+    m_getSegment(0),
+    m_putSegment(0)
 {
    setBuf(m_buffer, m_bufferSize, m_sharedBuffer);
 }
@@ -14,7 +21,12 @@ ossimByteStreamBuffer::ossimByteStreamBuffer(char_type* buf,
                                              bool shared)
    :m_buffer(0),
     m_bufferSize(0),
-    m_sharedBuffer(false)    
+    m_sharedBuffer(false),
+    m_segmentSize(0),
+    m_segments(),
+    m_dataSize(0),
+    m_getSegment(0),
+    m_putSegment(0)
 {
    setBuf(buf, bufSize, shared);
 }
@@ -22,8 +34,28 @@ ossimByteStreamBuffer::ossimByteStreamBuffer(char_type* buf,
 ossimByteStreamBuffer::ossimByteStreamBuffer(const ossimByteStreamBuffer& src)
    :m_buffer(0),
     m_bufferSize(0),
-    m_sharedBuffer(false)    
+    m_sharedBuffer(false),
+    m_segmentSize(0),
+    m_segments(),
+    m_dataSize(0),
+    m_getSegment(0),
+    m_putSegment(0)
 {
+   if(src.m_segmentSize)
+   {
+      // Own copy of each segment, at the same positions.
+      m_segmentSize = src.m_segmentSize;
+      m_dataSize    = src.dataSize();
+      for(ossim_uint32 idx = 0; idx < src.m_segments.size(); ++idx)
+      {
+         m_segments.push_back(new char_type[m_segmentSize]);
+         std::memcpy(m_segments[idx], src.m_segments[idx], m_segmentSize);
+      }
+      setPutPosition(src.putPosition());
+      setGetPosition(src.getPosition());
+      return;
+   }
+
    setBuf(src.m_buffer, src.m_bufferSize, src.m_sharedBuffer);
    
    if(src.m_buffer&&src.m_bufferSize)
@@ -58,6 +90,10 @@ std::streambuf* ossimByteStreamBuffer::setBuf(char* buf, std::streamsize bufSize
    deleteBuffer();
    setp(0,0);
    setg(0,0,0);
+   if(buf)
+   {
+      m_segmentSize = 0;
+   }
    char_type* tempBuf = buf;
    if(!shared&&bufSize&&buf)
    {
@@ -82,6 +118,17 @@ int ossimByteStreamBuffer::overflow( int c)
    {
       return EOF;
    }
+   else if(m_segmentSize)
+   {
+      if(c == EOF)
+      {
+         return 0;
+      }
+      // The put area is full (or not set yet): move on to the segment of the next byte.
+      setPutPosition(putPosition());
+      *pptr() = (char_type)c;
+      pbump(1);
+   }
    else
    {            
       ossim_uint32 oldSize = m_bufferSize;
@@ -93,14 +140,110 @@ int ossimByteStreamBuffer::overflow( int c)
    return c;
 }
 
-ossimByteStreamBuffer::char_type* ossimByteStreamBuffer::buffer(){return m_buffer;}
-const ossimByteStreamBuffer::char_type* ossimByteStreamBuffer::buffer()const{return m_buffer;}
+void ossimByteStreamBuffer::setSegmentSize(ossim_uint64 bytes)
+{
+   if(bytes == m_segmentSize)
+   {
+      return;
+   }
+   if(m_segmentSize)
+   {
+      gatherSegments();
+   }
+   if(bytes)
+   {
+      // Split the contiguous buffer into segments.
+      const ossim_uint64 SIZE = m_bufferSize;
+      const ossim_uint64 GET  = m_buffer ? (gptr()-eback()) : 0;
+      const ossim_uint64 PUT  = m_buffer ? (pptr()-pbase()) : 0;
+      std::vector<char_type*> segments;
+      for(ossim_uint64 offset = 0; offset < SIZE; offset += bytes)
+      {
+         segments.push_back(new char_type[bytes]);
+         std::memcpy(segments.back(), m_buffer + offset, std::min(bytes, SIZE - offset));
+      }
+      deleteBuffer();
+      setp(0,0);
+      setg(0,0,0);
+      m_segmentSize = bytes;
+      m_segments.swap(segments);
+      m_dataSize = SIZE;
+      setPutPosition(PUT);
+      setGetPosition(GET);
+   }
+}
+
+ossim_uint64 ossimByteStreamBuffer::getSegmentSize()const
+{
+   return m_segmentSize;
+}
+
+ossim_uint32 ossimByteStreamBuffer::getNumberOfSegments()const
+{
+   if(m_segmentSize)
+   {
+      return static_cast<ossim_uint32>((dataSize() + m_segmentSize - 1) / m_segmentSize);
+   }
+   return (m_buffer && m_bufferSize) ? 1 : 0;
+}
+
+const ossimByteStreamBuffer::char_type* ossimByteStreamBuffer::getSegment(
+   ossim_uint32 index, ossim_uint64& size)const
+{
+   size = 0;
+   if(index >= getNumberOfSegments())
+   {
+      return 0;
+   }
+   if(m_segmentSize)
+   {
+      size = std::min(m_segmentSize, dataSize() - index*m_segmentSize);
+      return m_segments[index];
+   }
+   size = m_bufferSize;
+   return m_buffer;
+}
+
+bool ossimByteStreamBuffer::writeSegments(std::ostream& out)const
+{
+   const ossim_uint32 COUNT = getNumberOfSegments();
+   for(ossim_uint32 idx = 0; (idx < COUNT) && out.good(); ++idx)
+   {
+      ossim_uint64 size = 0;
+      const char_type* segment = getSegment(idx, size);
+      out.write(segment, size);
+   }
+   return out.good();
+}
+
+ossimByteStreamBuffer::char_type* ossimByteStreamBuffer::buffer()
+{
+   if(m_segmentSize)
+   {
+      gatherSegments();
+   }
+   return m_buffer;
+}
+
+const ossimByteStreamBuffer::char_type* ossimByteStreamBuffer::buffer()const
+{
+   if(m_segmentSize)
+   {
+      // Logically const; the data does not change.
+      const_cast<ossimByteStreamBuffer*>(this)->gatherSegments();
+   }
+   return m_buffer;
+}
 
 /**
  * The buffer is no longer managed by this stream buffer and is removed.
  */
 ossimByteStreamBuffer::char_type* ossimByteStreamBuffer::takeBuffer()
 {
+   if(m_segmentSize)
+   {
+      gatherSegments();
+   }
    char_type* result = m_buffer;
    setp(0,0);
    setg(0,0,0);
@@ -110,11 +253,47 @@ ossimByteStreamBuffer::char_type* ossimByteStreamBuffer::takeBuffer()
    return result;
 }
 
-ossim_uint64 ossimByteStreamBuffer::bufferSize()const{return m_bufferSize;}
+ossim_uint64 ossimByteStreamBuffer::bufferSize()const
+{
+   return m_segmentSize ? dataSize() : m_bufferSize;
+}
+
+ossimByteStreamBuffer::int_type ossimByteStreamBuffer::underflow()
+{
+   if(m_segmentSize)
+   {
+      // End of the get area: data may have been written since, or it is in the next segment.
+      m_dataSize = dataSize();
+      const ossim_uint64 POS = getPosition();
+      if(POS < m_dataSize)
+      {
+         setGetPosition(POS);
+         return traits_type::to_int_type(*gptr());
+      }
+   }
+   return traits_type::eof();
+}
 
 
 ossimByteStreamBuffer::int_type ossimByteStreamBuffer::pbackfail(int_type __c )
 {
+   if(m_segmentSize)
+   {
+      const ossim_uint64 POS = getPosition();
+      if(POS == 0)
+      {
+         return traits_type::eof();
+      }
+      m_dataSize = dataSize();
+      setGetPosition(POS - 1);
+      if(__c != traits_type::eof())
+      {
+         *gptr() = static_cast<char_type>(__c);
+         return __c;
+      }
+      return traits_type::not_eof(__c);
+   }
+
    int_type result = __c;
    ossim_int64 delta = gptr()-eback();
    if(delta!=0)
@@ -142,6 +321,27 @@ ossimByteStreamBuffer::pos_type ossimByteStreamBuffer::seekoff(off_type offset,
       //
       return result;
    }
+   if(m_segmentSize)
+   {
+      ossim_int64 base = 0;
+      if(dir == std::ios_base::cur)
+      {
+         base = (__mode & std::ios_base::in) ? getPosition() : putPosition();
+         if(offset == 0)
+         {
+            return pos_type(base); // tellg/tellp, also at the end.
+         }
+      }
+      else if(dir == std::ios_base::end)
+      {
+         base = dataSize();
+      }
+      if(base + offset < 0)
+      {
+         return result;
+      }
+      return seekpos(pos_type(base + offset), __mode);
+   }
    switch(dir)
    {
       case std::ios_base::beg:
@@ -232,6 +432,29 @@ ossimByteStreamBuffer::pos_type ossimByteStreamBuffer::seekoff(off_type offset,
 ossimByteStreamBuffer::pos_type ossimByteStreamBuffer::seekpos(pos_type pos, std::ios_base::openmode __mode)
 {
    pos_type result = pos_type(off_type(-1));
+
+   if(m_segmentSize)
+   {
+      if(pos >= 0)
+      {
+         const ossim_uint64 POS = static_cast<ossim_uint64>(off_type(pos));
+         if(__mode & std::ios_base::in)
+         {
+            m_dataSize = dataSize();
+            if(POS < m_dataSize)
+            {
+               setGetPosition(POS);
+               result = pos;
+            }
+         }
+         else if(__mode & std::ios_base::out)
+         {
+            setPutPosition(POS);
+            result = pos;
+         }
+      }
+      return result;
+   }
     
    if(__mode & std::ios_base::in)
    {
@@ -272,6 +495,11 @@ ossimByteStreamBuffer::pos_type ossimByteStreamBuffer::seekpos(pos_type pos, std
 
 std::streamsize ossimByteStreamBuffer::xsgetn(char_type* __s, std::streamsize __n)
 {
+   if(m_segmentSize)
+   {
+      // Get area at a time, underflow() moving across segments.
+      return std::basic_streambuf<char, std::char_traits<char> >::xsgetn(__s, __n);
+   }
    ossim_uint64 bytesLeftToRead = egptr()-gptr();
    ossim_uint64 bytesToRead = __n;
     
@@ -289,6 +517,11 @@ std::streamsize ossimByteStreamBuffer::xsgetn(char_type* __s, std::streamsize __
 
 std::streamsize ossimByteStreamBuffer::xsputn(const char_type* __s, std::streamsize __n)
 {
+   if(m_segmentSize)
+   {
+      // Put area at a time, overflow() starting the next segment.
+      return std::basic_streambuf<char, std::char_traits<char> >::xsputn(__s, __n);
+   }
    ossim_int64 bytesLeftToWrite = epptr()-pptr();
    ossim_int64 bytesToWrite = __n;
    if(__n > bytesLeftToWrite)
@@ -319,6 +552,15 @@ void ossimByteStreamBuffer::deleteBuffer()
    }
    m_buffer = 0;
    m_bufferSize=0;
+
+   for(ossim_uint32 idx = 0; idx < m_segments.size(); ++idx)
+   {
+      delete [] m_segments[idx];
+   }
+   m_segments.clear();
+   m_dataSize   = 0;
+   m_getSegment = 0;
+   m_putSegment = 0;
 }
 void ossimByteStreamBuffer::extendBuffer(ossim_uint64 bytes)
 {
@@ -353,3 +595,76 @@ void ossimByteStreamBuffer::extendBuffer(ossim_uint64 bytes)
    setg(m_buffer, m_buffer+relativeInCur, m_buffer + m_bufferSize);
    pbump(pbumpOffset); // reallign to the current location
 }
+
+ossim_uint64 ossimByteStreamBuffer::dataSize()const
+{
+   ossim_uint64 result = m_dataSize;
+   if(pbase())
+   {
+      result = std::max(result, putPosition());
+   }
+   return result;
+}
+
+ossim_uint64 ossimByteStreamBuffer::getPosition()const
+{
+   return m_getSegment*m_segmentSize + (eback() ? (gptr()-eback()) : 0);
+}
+
+ossim_uint64 ossimByteStreamBuffer::putPosition()const
+{
+   return m_putSegment*m_segmentSize + (pbase() ? (pptr()-pbase()) : 0);
+}
+
+void ossimByteStreamBuffer::setGetPosition(ossim_uint64 pos)
+{
+   m_getSegment = pos / m_segmentSize;
+   const ossim_uint64 START = m_getSegment*m_segmentSize;
+   if((m_getSegment < m_segments.size()) && (START < m_dataSize))
+   {
+      char_type* segment = m_segments[m_getSegment];
+      setg(segment, segment + (pos - START),
+           segment + std::min(m_segmentSize, m_dataSize - START));
+   }
+   else
+   {
+      // Past the data, at a segment boundary; underflow() sets it up once written.
+      setg(0,0,0);
+   }
+}
+
+void ossimByteStreamBuffer::setPutPosition(ossim_uint64 pos)
+{
+   // Keep what was written in the current put area.
+   m_dataSize = dataSize();
+
+   m_putSegment = pos / m_segmentSize;
+   while(m_segments.size() <= m_putSegment)
+   {
+      m_segments.push_back(new char_type[m_segmentSize]);
+   }
+   char_type* segment = m_segments[m_putSegment];
+   setp(segment, segment + m_segmentSize);
+   pbump(static_cast<int>(pos - m_putSegment*m_segmentSize));
+}
+
+void ossimByteStreamBuffer::gatherSegments()
+{
+   const ossim_uint64 SIZE = dataSize();
+   const ossim_uint64 GET  = std::min(getPosition(), SIZE);
+   const ossim_uint64 PUT  = std::min(putPosition(), SIZE);
+   char_type* buf = SIZE ? new char_type[SIZE] : 0;
+   for(ossim_uint64 offset = 0; offset < SIZE; offset += m_segmentSize)
+   {
+      std::memcpy(buf + offset, m_segments[offset / m_segmentSize],
+                  std::min(m_segmentSize, SIZE - offset));
+   }
+   deleteBuffer();
+   m_segmentSize  = 0;
+   m_buffer       = buf;
+   m_bufferSize   = SIZE;
+   m_sharedBuffer = false;
+   setp(m_buffer, m_buffer + m_bufferSize);
+   setg(m_buffer, m_buffer + GET, m_buffer + m_bufferSize);
+   pbump(static_cast<int>(PUT));
+}
@@ -19,6 +19,7 @@
 #include <ossim/base/ossimNotify.h>
 #include <ossim/base/ossimTrace.h>
 
+#include <algorithm>
 #include <climits>
 #include <cstring>
 #include <iostream>
@@ -41,6 +42,8 @@ static const int   MAX_LENGTH_DESCR = 80;
 ossimDblGrid::ossimDblGrid()
 :
 theGridData       (0),
+theFloatData      (0),
+theFloatStorageFlag (false),
 theSize           (0, 0),
 theOrigin         (0.0, 0.0),
 theSpacing        (0.0, 0.0),
@@ -60,6 +63,8 @@ theDomainType     (CONTINUOUS)
 ossimDblGrid::ossimDblGrid(const ossimDblGrid&  source)
 :
 theGridData   (0),
+theFloatData  (0),
+theFloatStorageFlag (false),
 theMinValue   (OSSIM_DEFAULT_MIN_PIX_DOUBLE),
 theMaxValue   (OSSIM_DEFAULT_MAX_PIX_DOUBLE),
 theExtrapIsEnabled (true),
@@ -91,6 +96,8 @@ ossimDblGrid::ossimDblGrid(const ossimIpt&  size,
                            double           null_value)
                            :
 theGridData   (0),
+theFloatData  (0),
+theFloatStorageFlag (false),
 theMinValue   (OSSIM_DEFAULT_MIN_PIX_DOUBLE),
 theMaxValue   (OSSIM_DEFAULT_MAX_PIX_DOUBLE),
 theExtrapIsEnabled (true),
@@ -113,6 +120,8 @@ ossimDblGrid::ossimDblGrid(const ossimDrect&  rect,
                            double             null_value)
                            :
 theGridData   (0),
+theFloatData  (0),
+theFloatStorageFlag (false),
 theMinValue   (OSSIM_DEFAULT_MIN_PIX_DOUBLE),
 theMaxValue   (OSSIM_DEFAULT_MAX_PIX_DOUBLE),
 theExtrapIsEnabled (true),
@@ -135,11 +144,7 @@ theDomainType (CONTINUOUS)
 //*****************************************************************************
 ossimDblGrid::~ossimDblGrid()
 {
-   if(theGridData)
-   {
-      delete [] theGridData;
-      theGridData = NULL;
-   }
+   deleteData();
 }
 
 //*****************************************************************************
@@ -159,11 +164,7 @@ void ossimDblGrid::initialize(const ossimIpt&  size,
    //***
    // Delete any existing grid:
    //***
-   if (theGridData)
-   {
-      delete [] theGridData;
-      theGridData = 0;
-   }
+   deleteData();
 
    //***
    // Initialize data members:
@@ -179,14 +180,8 @@ void ossimDblGrid::initialize(const ossimIpt&  size,
    /*!
    * Allocate mem for the grid, and initialize:
    */
-   ossim_uint32 buflen = theSize.x * theSize.y;
-   if(buflen > 0)
-   {
-      theGridData = new double [buflen];
+   allocate();
 
-      for (ossim_uint32 i=0; i<buflen; i++)
-         theGridData[i] = theNullValue;
-   }   
    if (traceExec())  ossimNotify(ossimNotifyLevel_WARN) << MODULE << " returning...\n";
 
    return;
@@ -217,12 +212,69 @@ void ossimDblGrid::initialize(const ossimDrect&  uv_rect,
 //**************************************************************************************************
 void ossimDblGrid::deallocate()
 {
-   if(theGridData)
+   deleteData();
+   theSize = ossimIpt(0,0); 
+}
+
+//**************************************************************************************************
+void ossimDblGrid::allocate()
+{
+   ossim_uint32 buflen = theSize.x * theSize.y;
+   if(buflen > 0)
+   {
+      if (theFloatStorageFlag)
+      {
+         theFloatData = new float [buflen];
+         std::fill(theFloatData, theFloatData + buflen, (float) theNullValue);
+      }
+      else
+      {
+         theGridData = new double [buflen];
+         std::fill(theGridData, theGridData + buflen, theNullValue);
+      }
+   }
+}
+
+//**************************************************************************************************
+void ossimDblGrid::deleteData()
+{
+   if (theGridData)
    {
       delete [] theGridData;
       theGridData = 0;
    }
-   theSize = ossimIpt(0,0); 
+   if (theFloatData)
+   {
+      delete [] theFloatData;
+      theFloatData = 0;
+   }
+}
+
+//**************************************************************************************************
+void ossimDblGrid::setFloatStorage(bool flag)
+{
+   if (flag == theFloatStorageFlag)
+      return;
+
+   ossim_uint32 buflen = theSize.x * theSize.y;
+   if (flag && theGridData)
+   {
+      theFloatData = new float [buflen];
+      for (ossim_uint32 i=0; i<buflen; i++)
+         theFloatData[i] = (float) theGridData[i];
+      delete [] theGridData;
+      theGridData = 0;
+   }
+   else if (!flag && theFloatData)
+   {
+      theGridData = new double [buflen];
+      for (ossim_uint32 i=0; i<buflen; i++)
+         theGridData[i] = (theFloatData[i] == (float) theNullValue) ?
+                          theNullValue : (double) theFloatData[i];
+      delete [] theFloatData;
+      theFloatData = 0;
+   }
+   theFloatStorageFlag = flag;
 }
 
 /*!****************************************************************************
@@ -233,7 +285,7 @@ void ossimDblGrid::deallocate()
 *****************************************************************************/
 void ossimDblGrid::setNode (int x, int y, const double& input) 
 {
-   if(!theGridData) return;
+   if(!hasData()) return;
 
    // Insure the value passed in is allowed:
    double value = input;
@@ -241,7 +293,7 @@ void ossimDblGrid::setNode (int x, int y, const double& input)
 
    if ((x>=0)&&(x<theSize.x)&&(y>=0)&&(y<theSize.y))
    {
-      theGridData[index(x, y)] = value;
+      setNodeValue(index(x, y), value);
 
       if (value != theNullValue)
       {
@@ -268,7 +320,7 @@ void ossimDblGrid::setNode (int x, int y, const double& input)
 void ossimDblGrid::setNearestNode (const ossimDpt& uv_point,
                                    const double&   input) 
 {
-   if(!theGridData) return;
+   if(!hasData()) return;
    
    // Insure the value passed in is allowed:
    double value = input;
@@ -302,11 +354,11 @@ void ossimDblGrid::setNearestNode (const ossimDpt& uv_point,
 *****************************************************************************/
 double ossimDblGrid::getNode (int x, int y) const
 {
-   if(!theGridData) return theNullValue;
+   if(!hasData()) return theNullValue;
    if ((x>=0)&&(x<theSize.x)&&(y>=0)&&(y<theSize.y))
    {
       ossim_uint32 i = index(x, y);
-      double val = theGridData[i];
+      double val = nodeValue(i);
       return val;
    }
    return theNullValue;
@@ -321,7 +373,7 @@ double ossimDblGrid::getNode (int x, int y) const
 *****************************************************************************/
 double ossimDblGrid::operator() (const double& u, const double& v) const
 {
-   if(!theGridData) return theNullValue;
+   if(!hasData()) return theNullValue;
 
    double xi = (u - theOrigin.u)/theSpacing.x;
    double yi = (v - theOrigin.v)/theSpacing.y;
@@ -340,7 +392,7 @@ double ossimDblGrid::operator() (const double& u, const double& v) const
 //*************************************************************************************************
 double ossimDblGrid::interpolate(double xi, double yi) const
 {
-   if(!theGridData) 
+   if(!hasData()) 
       return theNullValue;
 
    // Establish the grid cell origin indices:
@@ -357,6 +409,24 @@ double ossimDblGrid::interpolate(double xi, double yi) const
    double w10 = wx1 * wy0;
    double w11 = wx1 * wy1;
 
+   // Extract the four data points:
+   double p00, p01, p10, p11;
+   if (!loadCell(x0, y0, p00, p01, p10, p11))
+      return ossim::nan();
+
+   // Perform interpolation:
+   double value = (p00*w00 + p01*w01 + p10*w10 + p11*w11) / (w00 + w01 + w10 + w11);
+   constrain(value);
+
+   return value;
+}
+
+//*************************************************************************************************
+//! Loads the four nodes of cell (x0, y0). Edge nodes are repeated past the last row and column.
+//*************************************************************************************************
+bool ossimDblGrid::loadCell(int x0, int y0,
+                            double& p00, double& p01, double& p10, double& p11) const
+{
    // Establish grid indices for 4 surrounding points:
    int index00  = theSize.x*y0 + x0;
    int index10 = index00;
@@ -365,19 +435,17 @@ double ossimDblGrid::interpolate(double xi, double yi) const
 
    if (x0 < (theSize.x-1)) index10 = index00 + 1;
    if (y0 < (theSize.y-1)) index01 = index00 + theSize.x;
-   if (y0 < (theSize.y-1)) index01 = index00 + theSize.x;
    if (x0 < (theSize.x-1)) index11 = index01 + 1;
 
    // Safety check:
    int max_idx = theSize.x * theSize.y;
    if ((index00 > max_idx) || (index10 > max_idx) || (index11 > max_idx) || (index01 > max_idx))
-      return ossim::nan();
+      return false;
 
-   // Extract the four data points:
-   double p00 = theGridData[index00];
-   double p01 = theGridData[index01];
-   double p10 = theGridData[index10];
-   double p11 = theGridData[index11];
+   p00 = nodeValue(index00);
+   p01 = nodeValue(index01);
+   p10 = nodeValue(index10);
+   p11 = nodeValue(index11);
 
    // Consider the numerical domain to catch any wrap condition:
    if (theDomainType >= WRAP_180)
@@ -402,11 +470,88 @@ double ossimDblGrid::interpolate(double xi, double yi) const
          p11 += 360.0;
    }
 
-   // Perform interpolation:
-   double value = (p00*w00 + p01*w01 + p10*w10 + p11*w11) / (w00 + w01 + w10 + w11);
-   constrain(value);
+   return true;
+}
 
-   return value;
+/*!****************************************************************************
+* METHOD: ossimDblGrid::values()
+*
+*  Batch form of operator().
+*  
+*****************************************************************************/
+void ossimDblGrid::values(int count, const double* u, const double* v, double* result) const
+{
+   for (int i=0; i<count; ++i)
+      result[i] = (*this)(u[i], v[i]);
+}
+
+/*!****************************************************************************
+* METHOD: ossimDblGrid::valuesAlongLine()
+*
+*  Values at start + i*step. Consecutive points in the same cell reuse the
+*  cell's nodes, so the per point work is the weighted sum alone.
+*  
+*****************************************************************************/
+void ossimDblGrid::valuesAlongLine(const ossimDpt& start,
+                                   const ossimDpt& step,
+                                   int count,
+                                   double* result) const
+{
+   if (!hasData())
+   {
+      std::fill(result, result + count, theNullValue);
+      return;
+   }
+
+   const double X_MAX = (double)theSize.x - 1.0;
+   const double Y_MAX = (double)theSize.y - 1.0;
+   const double X0 = (start.u - theOrigin.u)/theSpacing.x;
+   const double Y0 = (start.v - theOrigin.v)/theSpacing.y;
+   const double DX = step.u/theSpacing.x;
+   const double DY = step.v/theSpacing.y;
+
+   int cellX = -1;
+   int cellY = -1;
+   bool cellValid = false;
+   double p00 = 0.0, p01 = 0.0, p10 = 0.0, p11 = 0.0;
+
+   for (int i=0; i<count; ++i)
+   {
+      double xi = X0 + i*DX;
+      double yi = Y0 + i*DY;
+
+      if ((xi < 0.0) || (xi > X_MAX) || (yi < 0.0) || (yi > Y_MAX))
+      {
+         result[i] = theExtrapIsEnabled ? extrapolate(xi, yi) : theNullValue;
+         continue;
+      }
+
+      int x0 = (int) xi;
+      int y0 = (int) yi;
+      if ((x0 != cellX) || (y0 != cellY))
+      {
+         cellX = x0;
+         cellY = y0;
+         cellValid = loadCell(x0, y0, p00, p01, p10, p11);
+      }
+      if (!cellValid)
+      {
+         result[i] = ossim::nan();
+         continue;
+      }
+
+      double wx1 = xi - x0;
+      double wy1 = yi - y0;
+      double wx0 = 1.0 - wx1;
+      double wy0 = 1.0 - wy1;
+      double w00 = wx0 * wy0;
+      double w01 = wx0 * wy1;
+      double w10 = wx1 * wy0;
+      double w11 = wx1 * wy1;
+      double value = (p00*w00 + p01*w01 + p10*w10 + p11*w11) / (w00 + w01 + w10 + w11);
+      constrain(value);
+      result[i] = value;
+   }
 }
 
 //**************************************************************************************************
@@ -417,7 +562,7 @@ double ossimDblGrid::interpolate(double xi, double yi) const
 //**************************************************************************************************
 double ossimDblGrid::extrapolate(double x, double y) const
 {
-   if(!theGridData) 
+   if(!hasData()) 
       return theNullValue;
 
 
@@ -525,11 +670,7 @@ const ossimDblGrid& ossimDblGrid::operator = (const ossimDblGrid& source)
 {
    if(&source == this) return *this;
 
-   if (theGridData)
-   {
-      delete [] theGridData;
-      theGridData = 0;
-   }
+   deleteData();
 
    //***
    // Assign data members:
@@ -545,19 +686,21 @@ const ossimDblGrid& ossimDblGrid::operator = (const ossimDblGrid& source)
    theMeanIsComputed = source.theMeanIsComputed;
    theDomainType     = source.theDomainType;
    theExtrapIsEnabled = source.theExtrapIsEnabled;
+   theFloatStorageFlag = source.theFloatStorageFlag;
 
    //***
    // Allocate mem for the grid, and initialize:
    //***
    int buflen = theSize.x * theSize.y;
-   if(buflen>0)
+   if (source.theGridData && (buflen > 0))
    {
       theGridData = new double [buflen];
-
-      for (int i=0; i<buflen; i++)
-      {
-         theGridData[i] = source.theGridData[i];
-      }
+      std::copy(source.theGridData, source.theGridData + buflen, theGridData);
+   }
+   else if (source.theFloatData && (buflen > 0))
+   {
+      theFloatData = new float [buflen];
+      std::copy(source.theFloatData, source.theFloatData + buflen, theFloatData);
    }
 
    return *this;
@@ -605,7 +748,7 @@ double  ossimDblGrid::meanStdDev()
 void ossimDblGrid::computeMean()
 {
    static const char MODULE[] = "ossimDblGrid::meanStdDev()";
-   if(!theGridData) return;
+   if(!hasData()) return;
    if (traceExec())  ossimNotify(ossimNotifyLevel_DEBUG) << "entering...\n";
 
    if (!theMeanIsComputed)
@@ -618,9 +761,10 @@ void ossimDblGrid::computeMean()
       */
       for (int i=0; i<(theSize.x*theSize.y); i++)
       {
-         if (theGridData[i] != theNullValue)
+         double node = nodeValue(i);
+         if (node != theNullValue)
          {
-            accum += theGridData[i];
+            accum += node;
             num_samples += 1.0;
          }
       }
@@ -633,9 +777,10 @@ void ossimDblGrid::computeMean()
       double diff;
       for (int i=0; i<(theSize.x*theSize.y); i++)
       {
-         if (theGridData[i] != theNullValue)
+         double node = nodeValue(i);
+         if (node != theNullValue)
          {
-            diff = theMeanValue - theGridData[i];
+            diff = theMeanValue - node;
             accum += diff*diff;
          }
       }
@@ -703,14 +848,14 @@ bool ossimDblGrid::save(ostream& os, const char* descr) const
       << theSpacing.v << "  "
       << theNullValue << "\n";
 
-   if(theGridData)
+   if(hasData())
    {
       //***
       // Loop to write grid points:
       //***
       int max_index = theSize.x*theSize.y;
       for (int i=0; i<max_index; i++)
-         os << theGridData[i] << "  ";
+         os << nodeValue(i) << "  ";
    }
    os << "\n";
 
@@ -778,9 +923,11 @@ bool ossimDblGrid::load(istream& is)
    // Loop to read grid points:
    //***
    int max_index = theSize.x*theSize.y;
+   double node;
    for (int i=0; i<max_index; i++)
    {
-      is >> theGridData[i];
+      is >> node;
+      setNodeValue(i, node);
    }
 
    if (traceExec())  ossimNotify(ossimNotifyLevel_DEBUG) << MODULE << " returning...\n";
@@ -899,7 +1046,7 @@ void ossimDblGrid::interpolateNullValuedNodes(const double& decay_rate)
 {
    static const char MODULE[] = "ossimDblGrid::interpolateNullValuedNodes()";
    if (traceExec())  ossimNotify(ossimNotifyLevel_DEBUG) << MODULE << " entering...\n";
-   if(!theGridData) return;
+   if(!hasData()) return;
 
    //***
    // Allocate buffer to store resampled nodes:
@@ -939,7 +1086,7 @@ void ossimDblGrid::interpolateNullValuedNodes(const double& decay_rate)
          // Only resample those nodes that contain NULL:
          //***
          node_idx = index(x, y);
-         node_value = theGridData[node_idx];
+         node_value = nodeValue(node_idx);
          if (node_value != theNullValue)
          {
             //***
@@ -1062,7 +1209,7 @@ void ossimDblGrid::interpolateNullValuedNodes(const double& decay_rate)
    // Now copy the resampled grid back into the original buffer:
    //***
    for (node_idx=0; node_idx<buf_size; node_idx++)
-      theGridData[node_idx] = resampled_grid[node_idx];
+      setNodeValue(node_idx, resampled_grid[node_idx]);
 
    if (traceExec())  ossimNotify(ossimNotifyLevel_DEBUG) << MODULE << " returning...\n";
    return;
@@ -1080,7 +1227,7 @@ void ossimDblGrid::filter(int size_x, int size_y, double* kernel)
 {
    static const char MODULE[] = "ossimDblGrid::filter()";
    if (traceExec())  ossimNotify(ossimNotifyLevel_DEBUG) << MODULE << "entering...\n";
-   if(!theGridData) return;
+   if(!hasData()) return;
 
    int      rx      = (size_x - 1)/2;     // kernel radii
    int      ry      = (size_y - 1)/2;     
@@ -1114,9 +1261,10 @@ void ossimDblGrid::filter(int size_x, int size_y, double* kernel)
          {
             for (int kx=-rx; kx<=rx; kx++)
             {
-               node_value = theGridData[index(x+kx, y+ky)];
+               node_value = nodeValue(index(x+kx, y+ky));
                kernel_value = kernel[knl_ctr + ky*size_x + kx];
-               resample_grid.theGridData[resample_node_idx] += kernel_value*node_value;
+               resample_grid.setNodeValue(resample_node_idx,
+                  resample_grid.nodeValue(resample_node_idx) + kernel_value*node_value);
             }
          }
       }
@@ -1129,7 +1277,7 @@ void ossimDblGrid::filter(int size_x, int size_y, double* kernel)
    {
       for (int x=0; x<theSize.x; x++)
       {
-         theGridData[index(x, y)] = resample_grid(x, y); // automatically extrapolates if necessary
+         setNodeValue(index(x, y), resample_grid(x, y)); // automatically extrapolates if necessary
       }
    }
 
@@ -1146,14 +1294,14 @@ void ossimDblGrid::filter(int size_x, int size_y, double* kernel)
 //*****************************************************************************
 void ossimDblGrid::fill(double fill_value)
 {
-   if (!theGridData)
+   if (!hasData())
    {
       return;
    }
 
    int size = theSize.x * theSize.y;
    for (int i=0; i<size; i++)
-      theGridData[i] = fill_value;
+      setNodeValue(i, fill_value);
 
    return;
 }
@@ -1209,7 +1357,7 @@ ostream& operator<<(ostream& os, const ossimDblGrid& grid)
       << "\n  theMeanIsComputed: " << grid.theMeanIsComputed
       << "\n";
 
-   if(grid.theGridData)
+   if(grid.hasData())
    {
 
       for (int y=0; y<grid.theSize.y; y++)
@@ -0,0 +1,307 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Input stream reading a local file in large blocks kept in memory.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/base/ossimFileBlockCache.h>
+#include <ossim/base/ossimIoStream.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <OpenThreads/ScopedLock>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+   const ossim_uint64 DEFAULT_BLOCK_SIZE = 65536;
+   const ossim_uint32 DEFAULT_MAX_BLOCKS = 64;
+
+   ossim_uint64 preference(const char* key, ossim_uint64 defaultValue)
+   {
+      const char* lookup = ossimPreferences::instance()->findPreference(key);
+      if ( lookup )
+      {
+         ossim_uint64 value = ossimString(lookup).toUInt64();
+         if ( value )
+         {
+            return value;
+         }
+      }
+      return defaultValue;
+   }
+}
+
+ossimFileBlockCache::ossimFileBlockCache(const ossimFilename& file)
+   : ossimReferenced(),
+     m_file(file),
+     m_size(file.exists() ? static_cast<ossim_uint64>(file.fileSize()) : 0),
+     m_blockSize(preference("file_block_cache.block_size", DEFAULT_BLOCK_SIZE)),
+     m_maxBlocks(static_cast<ossim_uint32>(
+                    preference("file_block_cache.max_blocks", DEFAULT_MAX_BLOCKS))),
+     m_fileReads(0),
+     m_blocks(),
+     m_lru(),
+     m_mutex()
+{
+}
+
+ossimFileBlockCache::~ossimFileBlockCache()
+{
+}
+
+ossim_uint64 ossimFileBlockCache::getSize() const
+{
+   return m_size;
+}
+
+ossim_uint64 ossimFileBlockCache::getBlockSize() const
+{
+   return m_blockSize;
+}
+
+ossim_uint64 ossimFileBlockCache::getNumberOfFileReads() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   return m_fileReads;
+}
+
+void ossimFileBlockCache::clear()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   m_blocks.clear();
+   m_lru.clear();
+}
+
+ossim_uint64 ossimFileBlockCache::read(ossim_uint64 offset, char* buffer, ossim_uint64 count)
+{
+   if ( (offset >= m_size) || !count )
+   {
+      return 0;
+   }
+   count = std::min(count, m_size - offset);
+
+   const ossim_uint64 FIRST = offset / m_blockSize;
+   const ossim_uint64 LAST  = (offset + count - 1) / m_blockSize;
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+
+   // Read the missing blocks, one read per run of consecutive blocks.  Runs are capped at the
+   // cache size so a run is not evicted by its own tail.
+   ossim_uint64 runStart = 0;
+   bool inRun = false;
+   for (ossim_uint64 b = FIRST; b <= LAST + 1; ++b)
+   {
+      const bool MISSING = (b <= LAST) && (m_blocks.find(b) == m_blocks.end());
+      if ( MISSING && !inRun )
+      {
+         runStart = b;
+         inRun = true;
+      }
+      if ( inRun && ( !MISSING || (b - runStart + 1 >= m_maxBlocks) ) )
+      {
+         const ossim_uint64 RUN_LAST = MISSING ? b : b - 1;
+         readRun(runStart, RUN_LAST);
+         inRun = false;
+      }
+   }
+
+   ossim_uint64 copied = 0;
+   for (ossim_uint64 b = FIRST; b <= LAST; ++b)
+   {
+      const ossim_uint64 BEGIN = b * m_blockSize;
+      const ossim_uint64 LO    = std::max(offset, BEGIN);
+      const ossim_uint64 HI    = std::min(offset + count, BEGIN + m_blockSize);
+
+      std::map<ossim_uint64, Block>::iterator i = m_blocks.find(b);
+      if ( (i == m_blocks.end()) && readRun(b, b) )
+      {
+         i = m_blocks.find(b); // Evicted by a long read; read it again.
+      }
+      if ( (i == m_blocks.end()) || (i->second.m_data.size() < HI - BEGIN) )
+      {
+         break; // Failed read.
+      }
+      std::memcpy(buffer + (LO - offset), &i->second.m_data[LO - BEGIN], HI - LO);
+      m_lru.splice(m_lru.begin(), m_lru, i->second.m_lru);
+      copied += HI - LO;
+   }
+
+   return copied;
+}
+
+bool ossimFileBlockCache::readRun(ossim_uint64 first, ossim_uint64 last)
+{
+   const ossim_uint64 BEGIN = first * m_blockSize;
+   const ossim_uint64 END   = std::min( (last + 1) * m_blockSize, m_size );
+   if ( BEGIN >= END )
+   {
+      return false;
+   }
+
+   std::ifstream in(m_file.c_str(), std::ios::in|std::ios::binary);
+   if ( !in )
+   {
+      return false;
+   }
+   std::vector<char> data(static_cast<std::size_t>(END - BEGIN));
+   ossimIFStream64::seekg64(in, static_cast<std::streamoff>(BEGIN), std::ios::beg);
+   in.read(&data.front(), static_cast<std::streamsize>(data.size()));
+   const ossim_uint64 READ = static_cast<ossim_uint64>(in.gcount());
+   ++m_fileReads;
+
+   for (ossim_uint64 b = first; b <= last; ++b)
+   {
+      const ossim_uint64 LO = b * m_blockSize - BEGIN;
+      if ( LO >= READ )
+      {
+         break;
+      }
+      const ossim_uint64 HI = std::min(LO + m_blockSize, READ);
+
+      std::map<ossim_uint64, Block>::iterator i = m_blocks.find(b);
+      if ( i == m_blocks.end() )
+      {
+         i = m_blocks.insert( std::make_pair(b, Block()) ).first;
+         m_lru.push_front(b);
+         i->second.m_lru = m_lru.begin();
+      }
+      else
+      {
+         m_lru.splice(m_lru.begin(), m_lru, i->second.m_lru);
+      }
+      i->second.m_data.assign(data.begin() + LO, data.begin() + HI);
+   }
+
+   while ( m_blocks.size() > m_maxBlocks )
+   {
+      m_blocks.erase(m_lru.back());
+      m_lru.pop_back();
+   }
+   return READ > 0;
+}
+
+ossimFileBlockStreamBuffer::ossimFileBlockStreamBuffer(ossimFileBlockCache* cache)
+   : std::streambuf(),
+     m_cache(cache),
+     m_buffer(),
+     m_bufferOffset(0)
+{
+   setg(0, 0, 0);
+}
+
+ossimFileBlockStreamBuffer::int_type ossimFileBlockStreamBuffer::underflow()
+{
+   const ossim_uint64 POS = position();
+   if ( !m_cache.valid() || (POS >= m_cache->getSize()) )
+   {
+      return traits_type::eof();
+   }
+
+   const ossim_uint64 BLOCK_SIZE = m_cache->getBlockSize();
+   const ossim_uint64 BEGIN = POS - (POS % BLOCK_SIZE);
+   m_buffer.resize(BLOCK_SIZE);
+   const ossim_uint64 COUNT = m_cache->read(BEGIN, &m_buffer.front(),
+                                            std::min(BLOCK_SIZE, m_cache->getSize() - BEGIN));
+   if ( COUNT <= POS - BEGIN )
+   {
+      setPosition(POS);
+      return traits_type::eof();
+   }
+
+   char* base = &m_buffer.front();
+   setg(base, base + (POS - BEGIN), base + COUNT);
+   m_bufferOffset = BEGIN;
+   return traits_type::to_int_type(*gptr());
+}
+
+std::streamsize ossimFileBlockStreamBuffer::xsgetn(char_type* s, std::streamsize n)
+{
+   if ( n <= 0 )
+   {
+      return 0;
+   }
+
+   const std::streamsize AVAILABLE = egptr() - gptr();
+   if ( n <= AVAILABLE )
+   {
+      std::memcpy(s, gptr(), n);
+      gbump(static_cast<int>(n));
+      return n;
+   }
+
+   // Past the get area; read the rest straight from the cache.
+   if ( AVAILABLE > 0 )
+   {
+      std::memcpy(s, gptr(), AVAILABLE);
+   }
+   const ossim_uint64 POS = position() + AVAILABLE;
+   const ossim_uint64 COUNT = m_cache.valid() ?
+      m_cache->read(POS, s + AVAILABLE, static_cast<ossim_uint64>(n - AVAILABLE)) : 0;
+   setPosition(POS + COUNT);
+   return AVAILABLE + static_cast<std::streamsize>(COUNT);
+}
+
+std::streamsize ossimFileBlockStreamBuffer::showmanyc()
+{
+   const ossim_uint64 POS = position();
+   if ( !m_cache.valid() || (POS >= m_cache->getSize()) )
+   {
+      return -1;
+   }
+   return static_cast<std::streamsize>(m_cache->getSize() - POS);
+}
+
+ossimFileBlockStreamBuffer::pos_type ossimFileBlockStreamBuffer::seekoff(
+   off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode mode)
+{
+   const off_type SIZE = m_cache.valid() ? static_cast<off_type>(m_cache->getSize()) : 0;
+   off_type pos = offset;
+   if ( dir == std::ios_base::cur )
+   {
+      pos += static_cast<off_type>(position());
+   }
+   else if ( dir == std::ios_base::end )
+   {
+      pos += SIZE;
+   }
+
+   if ( !(mode & std::ios_base::in) || (pos < 0) || (pos > SIZE) )
+   {
+      return pos_type(off_type(-1));
+   }
+
+   const ossim_uint64 TARGET = static_cast<ossim_uint64>(pos);
+   if ( eback() && (TARGET >= m_bufferOffset) &&
+        (TARGET <= m_bufferOffset + static_cast<ossim_uint64>(egptr() - eback())) )
+   {
+      setg(eback(), eback() + (TARGET - m_bufferOffset), egptr());
+   }
+   else
+   {
+      setPosition(TARGET);
+   }
+   return pos_type(pos);
+}
+
+ossimFileBlockStreamBuffer::pos_type ossimFileBlockStreamBuffer::seekpos(
+   pos_type pos, std::ios_base::openmode mode)
+{
+   return seekoff(off_type(pos), std::ios_base::beg, mode);
+}
+
+ossim_uint64 ossimFileBlockStreamBuffer::position() const
+{
+   return m_bufferOffset + static_cast<ossim_uint64>(gptr() - eback());
+}
+
+void ossimFileBlockStreamBuffer::setPosition(ossim_uint64 pos)
+{
+   setg(0, 0, 0);
+   m_bufferOffset = pos;
+}
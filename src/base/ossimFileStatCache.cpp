@@ -0,0 +1,293 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description:
+//
+// Contains definition of class ossimFileStatCache.
+//
+//*******************************************************************
+
+#include <ossim/base/ossimFileStatCache.h>
+#include <ossim/base/ossimFilename.h>
+#include <algorithm>
+#include <cctype>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <dirent.h>
+#  include <pthread.h>
+#endif
+
+namespace
+{
+#if defined(_WIN32)
+   __declspec(thread) ossimFileStatCache* theThreadCache = 0;
+
+   ossimFileStatCache* getThreadCache()
+   {
+      return theThreadCache;
+   }
+
+   void setThreadCache(ossimFileStatCache* cache)
+   {
+      theThreadCache = cache;
+   }
+#else
+   pthread_key_t  theThreadCacheKey;
+   pthread_once_t theThreadCacheOnce = PTHREAD_ONCE_INIT;
+
+   void createThreadCacheKey()
+   {
+      pthread_key_create(&theThreadCacheKey, 0);
+   }
+
+   ossimFileStatCache* getThreadCache()
+   {
+      pthread_once(&theThreadCacheOnce, createThreadCacheKey);
+      return static_cast<ossimFileStatCache*>(pthread_getspecific(theThreadCacheKey));
+   }
+
+   void setThreadCache(ossimFileStatCache* cache)
+   {
+      pthread_once(&theThreadCacheOnce, createThreadCacheKey);
+      pthread_setspecific(theThreadCacheKey, cache);
+   }
+#endif
+
+   inline bool isSeparator(char c)
+   {
+#if defined(_WIN32)
+      return (c == '/') || (c == '\\');
+#else
+      return (c == '/');
+#endif
+   }
+
+   /** Name as compared to directory entries: folded where case is not significant. */
+   std::string entryName(const std::string& name)
+   {
+#if defined(_WIN32) || defined(__APPLE__)
+      std::string result = name;
+      for (std::string::iterator i = result.begin(); i != result.end(); ++i)
+      {
+         *i = (char)std::tolower((unsigned char)*i);
+      }
+      return result;
+#else
+      return name;
+#endif
+   }
+
+   /** Path without trailing separators, split into directory and name. */
+   std::string normalize(const ossimFilename& path, std::string& dir, std::string& name)
+   {
+      std::string result = path.string();
+      while ( (result.size() > 1) && isSeparator(result[result.size() - 1]) &&
+              (result[result.size() - 2] != ':') )
+      {
+         result.erase(result.size() - 1);
+      }
+
+      std::string::size_type pos = result.size();
+      while ( (pos > 0) && !isSeparator(result[pos - 1]) )
+      {
+         --pos;
+      }
+      if ( pos == 0 )
+      {
+         dir  = ".";
+         name = result;
+      }
+      else
+      {
+         dir  = (pos == 1) ? result.substr(0, 1) : result.substr(0, pos - 1);
+         name = result.substr(pos);
+      }
+      return result;
+   }
+}
+
+ossimFileStatCache::Stat::Stat()
+   : theExistsFlag(false),
+     theDirFlag(false),
+     theFileFlag(false),
+     theSize(0),
+     theAccessTime(0),
+     theModifyTime(0),
+     theChangeTime(0)
+{
+}
+
+ossimFileStatCache::Listing::Listing()
+   : theLookupCount(0),
+     theListedFlag(false),
+     theNames()
+{
+}
+
+ossimFileStatCache::ossimFileStatCache()
+   : theActive(getThreadCache()),
+     theStats(),
+     theListings(),
+     theSystemCallCount(0)
+{
+   if ( !theActive )
+   {
+      theActive = this;
+      setThreadCache(this);
+   }
+}
+
+ossimFileStatCache::~ossimFileStatCache()
+{
+   if ( theActive == this )
+   {
+      setThreadCache(0);
+   }
+}
+
+ossimFileStatCache* ossimFileStatCache::current()
+{
+   return getThreadCache();
+}
+
+bool ossimFileStatCache::getStat(const ossimFilename& path, Stat& stat)
+{
+   if ( theActive != this )
+   {
+      return theActive->getStat(path, stat);
+   }
+
+   std::string dir;
+   std::string name;
+   const std::string KEY = normalize(path, dir, name);
+
+   std::map<std::string, Stat>::const_iterator i = theStats.find(KEY);
+   if ( i != theStats.end() )
+   {
+      stat = i->second;
+      return stat.theExistsFlag;
+   }
+
+   //---
+   // The second lookup in a directory lists it, so names missing from it,
+   // the common case when probing for support files, need no stat.
+   //---
+   bool listed = false;
+   if ( name.size() && (name != ".") && (name != "..") )
+   {
+      Listing& listing = theListings[dir];
+      if ( ++listing.theLookupCount == 2 )
+      {
+         listDirectory(dir, listing);
+      }
+      if ( listing.theListedFlag &&
+           (listing.theNames.find(entryName(name)) == listing.theNames.end()) )
+      {
+         stat = Stat();
+         listed = true;
+      }
+   }
+   if ( !listed )
+   {
+      statPath(KEY, stat);
+   }
+
+   theStats[KEY] = stat;
+   return stat.theExistsFlag;
+}
+
+void ossimFileStatCache::invalidate(const ossimFilename& path)
+{
+   if ( theActive != this )
+   {
+      theActive->invalidate(path);
+      return;
+   }
+
+   std::string dir;
+   std::string name;
+   theStats.erase(normalize(path, dir, name));
+   theStats.erase(dir);
+   theListings.erase(dir);
+}
+
+void ossimFileStatCache::clear()
+{
+   if ( theActive != this )
+   {
+      theActive->clear();
+      return;
+   }
+   theStats.clear();
+   theListings.clear();
+}
+
+ossim_uint64 ossimFileStatCache::getSystemCallCount() const
+{
+   return theActive->theSystemCallCount;
+}
+
+bool ossimFileStatCache::statPath(const std::string& path, Stat& stat)
+{
+   ++theSystemCallCount;
+   stat = Stat();
+#if defined(_WIN32)
+   struct _stat sbuf;
+   if ( _stat(path.c_str(), &sbuf) == 0 )
+   {
+      stat.theDirFlag  = ((sbuf.st_mode & _S_IFDIR) != 0);
+      stat.theFileFlag = ((sbuf.st_mode & _S_IFREG) != 0);
+#else
+   struct stat sbuf;
+   if ( ::stat(path.c_str(), &sbuf) == 0 )
+   {
+      stat.theDirFlag  = S_ISDIR(sbuf.st_mode);
+      stat.theFileFlag = S_ISREG(sbuf.st_mode);
+#endif
+      stat.theExistsFlag = true;
+      stat.theSize       = (ossim_int64)sbuf.st_size;
+      stat.theAccessTime = (ossim_int64)sbuf.st_atime;
+      stat.theModifyTime = (ossim_int64)sbuf.st_mtime;
+      stat.theChangeTime = (ossim_int64)sbuf.st_ctime;
+   }
+   return stat.theExistsFlag;
+}
+
+bool ossimFileStatCache::listDirectory(const std::string& dir, Listing& listing)
+{
+   ++theSystemCallCount;
+   listing.theNames.clear();
+   listing.theListedFlag = false;
+#if defined(_WIN32)
+   WIN32_FIND_DATAA data;
+   HANDLE handle = FindFirstFileA((dir + "\\*").c_str(), &data);
+   if ( handle != INVALID_HANDLE_VALUE )
+   {
+      do
+      {
+         listing.theNames.insert(entryName(data.cFileName));
+      } while ( FindNextFileA(handle, &data) );
+      FindClose(handle);
+      listing.theListedFlag = true;
+   }
+#else
+   DIR* dp = opendir(dir.c_str());
+   if ( dp )
+   {
+      struct dirent* entry = readdir(dp);
+      while ( entry )
+      {
+         listing.theNames.insert(entryName(entry->d_name));
+         entry = readdir(dp);
+      }
+      closedir(dp);
+      listing.theListedFlag = true;
+   }
+#endif
+   return listing.theListedFlag;
+}
@@ -47,6 +47,7 @@ using namespace std;
 #endif
 
 #include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimFileStatCache.h>
 #include <ossim/base/ossimRegExp.h>
 #include <ossim/base/ossimCommon.h>
 #include <ossim/base/ossimConstants.h>
@@ -58,6 +59,28 @@ const char ossimFilename::thePathSeparator = '\\';
 const char ossimFilename::thePathSeparator = '/';
 #endif
 
+namespace
+{
+   /** Drops path from the thread's ossimFileStatCache, if any. */
+   void invalidateStat(const ossimFilename& path)
+   {
+      ossimFileStatCache* cache = ossimFileStatCache::current();
+      if ( cache )
+      {
+         cache->invalidate(path);
+      }
+   }
+
+   void clearStats()
+   {
+      ossimFileStatCache* cache = ossimFileStatCache::current();
+      if ( cache )
+      {
+         cache->clear();
+      }
+   }
+}
+
 
 /**
  * This was taken from Wx widgets for performing touch and access date stamps.
@@ -300,6 +323,7 @@ bool ossimFilename::setTimes(ossimLocalTm* accessTime,
                              ossimLocalTm* /* createTime */ )const
 #endif
 {
+   invalidateStat(expand());
 #if defined(_WIN32)
    if(isDir())
    {
@@ -357,6 +381,29 @@ bool ossimFilename::getTimes(ossimLocalTm *accessTime,
                              ossimLocalTm *modTime,
                              ossimLocalTm *createTime) const
 {
+   ossimFileStatCache* cache = ossimFileStatCache::current();
+   if ( cache )
+   {
+      ossimFileStatCache::Stat stat;
+      if ( !cache->getStat(expand(), stat) )
+      {
+         return false;
+      }
+      if ( accessTime )
+      {
+         *accessTime = ossimLocalTm((time_t)stat.theAccessTime);
+      }
+      if ( modTime )
+      {
+         *modTime = ossimLocalTm((time_t)stat.theModifyTime);
+      }
+      if ( createTime )
+      {
+         *createTime = ossimLocalTm((time_t)stat.theChangeTime);
+      }
+      return true;
+   }
+
    if(!expand().exists()) return false;
    
 #if defined(_WIN32)
@@ -432,6 +479,7 @@ bool ossimFilename::getTimes(ossimLocalTm *accessTime,
 
 bool ossimFilename::touch()const
 {
+   invalidateStat(expand());
 #if defined( _WIN32 )
    ossimDate now;
 
@@ -596,6 +644,13 @@ ossimFilename ossimFilename::expand() const
 
 bool ossimFilename::exists() const
 {
+   ossimFileStatCache* cache = ossimFileStatCache::current();
+   if ( cache )
+   {
+      ossimFileStatCache::Stat stat;
+      return cache->getStat(*this, stat);
+   }
+
    bool result = false;
 #if defined(_WIN32)
    result = (_access(c_str(), ossimFilename::OSSIM_EXIST) == 0);
@@ -607,6 +662,14 @@ bool ossimFilename::exists() const
 
 bool ossimFilename::isFile() const
 {
+   ossimFileStatCache* cache = ossimFileStatCache::current();
+   if ( cache )
+   {
+      ossimFileStatCache::Stat stat;
+      cache->getStat(*this, stat);
+      return stat.theFileFlag;
+   }
+
 #if defined(_WIN32)
 
    struct _stat sbuf;
@@ -627,6 +690,14 @@ bool ossimFilename::isDir() const
    {
       return false;
    }
+
+   ossimFileStatCache* cache = ossimFileStatCache::current();
+   if ( cache )
+   {
+      ossimFileStatCache::Stat stat;
+      cache->getStat(*this, stat);
+      return stat.theDirFlag;
+   }
    
    ossimFilename temp = c_str();
    const char& lastChar = temp[temp.size()-1];
@@ -981,6 +1052,16 @@ ossimFilename ossimFilename::dirCat(const ossimFilename& file) const
 
 ossim_int64 ossimFilename::fileSize() const
 {
+   ossimFileStatCache* cache = ossimFileStatCache::current();
+   if ( cache )
+   {
+      ossimFileStatCache::Stat stat;
+      if ( cache->getStat(*this, stat) )
+      {
+         return stat.theSize;
+      }
+   }
+
    struct stat sbuf;
 
 #ifndef __BORLANDC__
@@ -1015,6 +1096,8 @@ bool ossimFilename::createDirectory( bool recurseFlag,
 
    if ( empty() ) return false;
 
+   clearStats();
+
    if(recurseFlag)
    {
       ossimString tempString = this->expand().c_str();
@@ -1096,6 +1179,7 @@ bool ossimFilename::createDirectory( bool recurseFlag,
 bool ossimFilename::remove(const ossimFilename& pathname)
 {
    bool result = true;
+   invalidateStat(pathname);
 
 #if defined(__VISUALC__)  || defined(__BORLANDC__) || defined(__WATCOMC__) || \
    defined(__GNUWIN32__) || defined(_MSC_VER)
@@ -1153,6 +1237,7 @@ bool ossimFilename::wildcardRemove(const ossimFilename& pathname)
    }
    ossim_uint32 idx = 0;
    bool result = true;
+   clearStats();
    for(idx = 0; idx < fileListToRemove.size(); ++idx)
    {
 #if defined(__VISUALC__)  || defined(__BORLANDC__) || defined(__WATCOMC__) || \
@@ -1190,6 +1275,8 @@ bool ossimFilename::rename(const ossimFilename& destFile, bool overwriteDestinat
       destFile.remove();
    }
    ::rename(this->c_str(), destFile.c_str());
+   invalidateStat(*this);
+   invalidateStat(destFile);
    
    return true;
 }
@@ -1207,6 +1294,7 @@ bool ossimFilename::wildcardRemove()const
 bool ossimFilename::copyFileTo(const ossimFilename& outputFile) const
 {
    bool result = false;
+   clearStats(); // outputFile may be a directory to copy into.
    
    std::ifstream is(this->c_str(), std::ios::in|std::ios::binary);
    if ( is.good() )
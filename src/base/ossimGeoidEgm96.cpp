@@ -65,6 +65,8 @@ bool ossimGeoidEgm96::open(const ossimFilename& grid_file,
       ossimNotify(ossimNotifyLevel_DEBUG) << MODULE << " Entered...\n";
    }
 
+   theGrid = 0;
+
    if(theGeoidHeightBuffer.size() != NumbGeoidElevs)
    {
       theGeoidHeightBuffer.resize(NumbGeoidElevs);
@@ -163,12 +165,20 @@ bool ossimGeoidEgm96::open(const ossimFilename& grid_file,
       ossimNotify(ossimNotifyLevel_DEBUG)
          << "Opened geoid grid:  " << grid.c_str() << std::endl;
    }
+
+   // Optional precomputed lookup grid at the file's 15 minute spacing:
+   theGrid = ossimGeoidGrid::create(*this, 1.0 / ScaleFactor);
    
    return true;
 }
 
 double ossimGeoidEgm96::offsetFromEllipsoid(const ossimGpt& gpt)
 {
+   if (theGrid.valid())
+   {
+      return theGrid->height(gpt);
+   }
+   
    double offset = ossim::nan();
    ossimGpt savedGpt = gpt;
    if(ossimDatumFactory::instance()->wgs84())
@@ -288,6 +298,20 @@ double ossimGeoidEgm96::offsetFromEllipsoid(const ossimGpt& gpt)
    return offset;
 }
 
+void ossimGeoidEgm96::offsetsFromEllipsoid(const ossimGpt* gpts,
+                                           double* offsets,
+                                           ossim_uint32 count)
+{
+   if (theGrid.valid())
+   {
+      theGrid->heights(gpts, offsets, count);
+   }
+   else
+   {
+      ossimGeoid::offsetsFromEllipsoid(gpts, offsets, count);
+   }
+}
+
 double ossimGeoidEgm96::geoidToEllipsoidHeight(double lat,
                                                double lon,
                                                double geoidHeight)
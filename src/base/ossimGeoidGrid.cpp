@@ -0,0 +1,236 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Global float32 lat/lon grid of geoid heights with a bilinear lookup.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/base/ossimGeoidGrid.h>
+#include <ossim/base/ossimDatumFactory.h>
+#include <ossim/base/ossimEndian.h>
+#include <ossim/base/ossimGeoid.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTrace.h>
+#include <cstring>
+#include <fstream>
+
+static ossimTrace traceDebug("ossimGeoidGrid:debug");
+
+static const char MAGIC[8] = { 'O', 'S', 'S', 'I', 'M', 'G', 'G', '1' };
+
+// Written as 1 in the writer's byte order; reads back as 0x01000000 when swapped.
+static const ossim_uint32 BYTE_ORDER_MARK = 1;
+
+// Posts in a grid, to refuse absurd spacings (about 1 GB, 1 arc minute).
+static const double MAX_POSTS = 240000000.0;
+
+// Spacing rounded so 180 degrees is a whole number of posts.
+static ossim_uint32 postsPerHalfTurn(double spacing)
+{
+   ossim_int32 n = ossim::round<ossim_int32>(180.0 / spacing);
+   return (n < 1) ? 1 : (ossim_uint32)n;
+}
+
+ossimGeoidGrid::ossimGeoidGrid()
+   : m_rows(0),
+     m_cols(0),
+     m_spacing(0.0),
+     m_invSpacing(0.0),
+     m_posts(),
+     m_wgs84(ossimDatumFactory::instance()->wgs84())
+{
+}
+
+ossimGeoidGrid::~ossimGeoidGrid()
+{
+}
+
+void ossimGeoidGrid::allocate(double spacing)
+{
+   ossim_uint32 perHalfTurn = postsPerHalfTurn(spacing);
+   m_spacing    = 180.0 / perHalfTurn;
+   m_invSpacing = perHalfTurn / 180.0;
+   m_rows       = perHalfTurn + 1;
+   m_cols       = 2 * perHalfTurn + 1;
+   m_posts.assign((size_t)m_rows * m_cols, 0.0f);
+}
+
+bool ossimGeoidGrid::build(ossimGeoid& geoid, double spacing)
+{
+   m_posts.clear();
+   if ( !(spacing > 0.0) || ((180.0 / spacing + 1.0) * (360.0 / spacing + 1.0) > MAX_POSTS) )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimGeoidGrid::build WARN: Spacing out of range: " << spacing << std::endl;
+      return false;
+   }
+   allocate(spacing);
+
+   ossimGpt gpt;
+   for (ossim_uint32 row = 0; row < m_rows; ++row)
+   {
+      gpt.lat = 90.0 - row * m_spacing;
+      float* p = &m_posts[(size_t)row * m_cols];
+      for (ossim_uint32 col = 0; col < m_cols - 1; ++col)
+      {
+         gpt.lon = -180.0 + col * m_spacing;
+         p[col] = (float)geoid.offsetFromEllipsoid(gpt);
+      }
+      p[m_cols - 1] = p[0]; // 180 east is 180 west.
+   }
+
+   if (traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimGeoidGrid::build " << geoid.getShortName() << " spacing " << m_spacing
+         << " posts " << m_rows << "x" << m_cols << std::endl;
+   }
+   return true;
+}
+
+bool ossimGeoidGrid::load(const ossimFilename& file)
+{
+   m_posts.clear();
+   std::ifstream in(file.c_str(), std::ios::in | std::ios::binary);
+   if (!in)
+   {
+      return false;
+   }
+
+   char magic[8];
+   ossim_uint32 mark = 0;
+   ossim_uint32 rows = 0;
+   ossim_uint32 cols = 0;
+   ossim_float64 spacing = 0.0;
+   in.read(magic, 8);
+   in.read((char*)&mark, sizeof(mark));
+   in.read((char*)&rows, sizeof(rows));
+   in.read((char*)&cols, sizeof(cols));
+   in.read((char*)&spacing, sizeof(spacing));
+   if ( in.fail() || (memcmp(magic, MAGIC, 8) != 0) )
+   {
+      return false;
+   }
+
+   ossimEndian oe;
+   bool swapFlag = (mark != BYTE_ORDER_MARK);
+   if (swapFlag)
+   {
+      oe.swap(mark);
+      oe.swap(rows);
+      oe.swap(cols);
+      oe.swap(spacing);
+   }
+   if ( (mark != BYTE_ORDER_MARK) || !(spacing > 0.0) ||
+        ((180.0 / spacing + 1.0) * (360.0 / spacing + 1.0) > MAX_POSTS) )
+   {
+      return false;
+   }
+
+   allocate(spacing);
+   if ( (rows != m_rows) || (cols != m_cols) )
+   {
+      m_posts.clear();
+      return false;
+   }
+
+   in.read((char*)&m_posts.front(), m_posts.size() * sizeof(float));
+   if (in.fail())
+   {
+      m_posts.clear();
+      return false;
+   }
+   if (swapFlag)
+   {
+      oe.swap(&m_posts.front(), (ossim_uint32)m_posts.size());
+   }
+   return true;
+}
+
+bool ossimGeoidGrid::save(const ossimFilename& file) const
+{
+   if (!isValid())
+   {
+      return false;
+   }
+   std::ofstream out(file.c_str(), std::ios::out | std::ios::binary);
+   if (!out)
+   {
+      return false;
+   }
+   ossim_float64 spacing = m_spacing;
+   out.write(MAGIC, 8);
+   out.write((const char*)&BYTE_ORDER_MARK, sizeof(BYTE_ORDER_MARK));
+   out.write((const char*)&m_rows, sizeof(m_rows));
+   out.write((const char*)&m_cols, sizeof(m_cols));
+   out.write((const char*)&spacing, sizeof(spacing));
+   out.write((const char*)&m_posts.front(), m_posts.size() * sizeof(float));
+   return !out.fail();
+}
+
+double ossimGeoidGrid::heightShifted(const ossimGpt& gpt) const
+{
+   ossimGpt wgs84Gpt = gpt;
+   wgs84Gpt.changeDatum(m_wgs84);
+   return height(wgs84Gpt.lat, wgs84Gpt.lon);
+}
+
+void ossimGeoidGrid::heights(const ossimGpt* gpts, double* offsets, ossim_uint32 count) const
+{
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      offsets[i] = height(gpts[i]);
+   }
+}
+
+ossimRefPtr<ossimGeoidGrid> ossimGeoidGrid::create(ossimGeoid& geoid, double defaultSpacing)
+{
+   ossimRefPtr<ossimGeoidGrid> grid = 0;
+
+   const char* lookup = ossimPreferences::instance()->findPreference("geoid_manager.grid.enabled");
+   if ( !lookup || !ossimString(lookup).toBool() )
+   {
+      return grid;
+   }
+
+   double spacing = defaultSpacing;
+   lookup = ossimPreferences::instance()->findPreference("geoid_manager.grid.spacing");
+   if (lookup)
+   {
+      spacing = ossimString(lookup).toDouble();
+   }
+
+   ossimFilename file;
+   lookup = ossimPreferences::instance()->findPreference("geoid_manager.grid.directory");
+   if ( lookup && geoid.getShortName().size() )
+   {
+      file = ossimFilename(lookup).dirCat(geoid.getShortName() + ".grid");
+   }
+
+   grid = new ossimGeoidGrid();
+   if ( file.size() && file.exists() )
+   {
+      // A prebuilt grid is only used if it has the spacing asked for.
+      if ( grid->load(file) && (spacing > 0.0) &&
+           (postsPerHalfTurn(grid->m_spacing) == postsPerHalfTurn(spacing)) )
+      {
+         return grid;
+      }
+   }
+
+   if ( !grid->build(geoid, spacing) )
+   {
+      grid = 0;
+   }
+   else if ( file.size() && !grid->save(file) )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimGeoidGrid::create WARN: Could not write " << file << std::endl;
+   }
+   return grid;
+}
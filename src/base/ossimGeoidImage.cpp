@@ -32,7 +32,8 @@ ossimGeoidImage::ossimGeoidImage()
      m_geoidTypeName(),
      m_memoryMapFlag(false),
      m_enabledFlag(true),
-     m_imageRect()
+     m_imageRect(),
+     m_grid(0)
 {
 }
 
@@ -41,6 +42,7 @@ ossimGeoidImage::~ossimGeoidImage()
    m_geom = 0;
    m_handler = 0;
    m_cacheTile = 0;
+   m_grid = 0;
 }
 
 bool ossimGeoidImage::open( const ossimFilename& file, ossimByteOrder /* byteOrder */ )
@@ -49,6 +51,7 @@ bool ossimGeoidImage::open( const ossimFilename& file, ossimByteOrder /* byteOrd
    
    m_geom = 0;
    m_cacheTile = 0;
+   m_grid = 0;
    if ( m_handler.valid() )
    {
       m_handler->close();
@@ -121,7 +124,16 @@ bool ossimGeoidImage::open( const ossimFilename& file, ossimByteOrder /* byteOrd
       }
    }
    
-   return ( m_geom.valid() && (m_handler.valid() || (m_memoryMapFlag && m_cacheTile.valid()) ));
+   bool result = ( m_geom.valid() &&
+                   (m_handler.valid() || (m_memoryMapFlag && m_cacheTile.valid()) ) );
+   if ( result )
+   {
+      // Optional precomputed lookup grid, by default at the image's post spacing:
+      ossimDpt dpp = m_geom->getDegreesPerPixel();
+      double spacing = dpp.hasNans() ? (1.0 / 60.0) : ossim::max(dpp.x, dpp.y);
+      m_grid = ossimGeoidGrid::create( *this, spacing );
+   }
+   return result;
 }
 
 ossimString ossimGeoidImage::getShortName() const
@@ -219,7 +231,11 @@ double ossimGeoidImage::offsetFromEllipsoid( const ossimGpt& gpt )
 {
    double offset = ossim::nan();
 
-   if ( m_enabledFlag )
+   if ( m_enabledFlag && m_grid.valid() )
+   {
+      offset = m_grid->height( gpt );
+   }
+   else if ( m_enabledFlag )
    {
       if ( m_geom.valid() &&
            ( m_handler.valid() ||
@@ -267,6 +283,20 @@ double ossimGeoidImage::offsetFromEllipsoid( const ossimGpt& gpt )
    return offset;
 }
 
+void ossimGeoidImage::offsetsFromEllipsoid( const ossimGpt* gpts,
+                                            double* offsets,
+                                            ossim_uint32 count )
+{
+   if ( m_enabledFlag && m_grid.valid() )
+   {
+      m_grid->heights( gpts, offsets, count );
+   }
+   else
+   {
+      ossimGeoid::offsetsFromEllipsoid( gpts, offsets, count );
+   }
+}
+
 template <class T>
 double ossimGeoidImage::offsetFromEllipsoidTemplate(T /* dummy */,
                                                     const ossimGpt& gpt)
@@ -316,6 +316,58 @@ double ossimGeoidManager::offsetFromEllipsoid(const ossimGpt& gpt)
    return offset;
 }
 
+void ossimGeoidManager::offsetsFromEllipsoid(const ossimGpt* gpts,
+                                             double* offsets,
+                                             ossim_uint32 count)
+{
+   std::vector<ossim_uint32> pending;
+   std::vector<ossimGpt>     pts;
+   std::vector<double>       values;
+   
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      offsets[i] = ossim::nan();
+   }
+   
+   std::vector<ossimRefPtr<ossimGeoid> >::iterator geoid = theGeoidList.begin();
+   if (geoid != theGeoidList.end())
+   {
+      // The first geoid sees every point.
+      (*geoid)->offsetsFromEllipsoid(gpts, offsets, count);
+      ++geoid;
+   }
+   
+   while (geoid != theGeoidList.end())
+   {
+      pending.clear();
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         if (ossim::isnan(offsets[i]))
+         {
+            pending.push_back(i);
+         }
+      }
+      if (pending.empty())
+      {
+         break;
+      }
+      
+      pts.resize(pending.size());
+      values.resize(pending.size());
+      for (ossim_uint32 i = 0; i < pending.size(); ++i)
+      {
+         pts[i] = gpts[pending[i]];
+      }
+      (*geoid)->offsetsFromEllipsoid(&pts.front(), &values.front(),
+                                     static_cast<ossim_uint32>(pending.size()));
+      for (ossim_uint32 i = 0; i < pending.size(); ++i)
+      {
+         offsets[pending[i]] = values[i];
+      }
+      ++geoid;
+   }
+}
+
 ossimGeoid* ossimGeoidManager::findGeoidByShortName(const ossimString& shortName, bool caseSensitive)
 {
    ossim_uint32 idx=0;
@@ -31,9 +31,17 @@
 #if OSSIM_HAS_LIBZ
 #include <zlib.h>
 
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <OpenThreads/Block>
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 #include <cstring>  // for memcpy
+#include <deque>
+#include <map>
+#include <vector>
 
 
 // --------------------------------------
@@ -268,14 +276,14 @@ ossimGzStreamBuf::pos_type ossimGzStreamBuf::seekoff(off_type t,
 ossimIgzStream::ossimIgzStream()
    : ossimIFStream()
 {
-   init(&buf);
+   countIo(&buf);
 }
 
 ossimIgzStream::ossimIgzStream( const char* name,
                                 std::ios_base::openmode mode )
    : ossimIFStream()
 {
-   init(&buf);
+   countIo(&buf);
    open(name, mode);
 }
 
@@ -292,6 +300,7 @@ ossimGzStreamBuf* ossimIgzStream::rdbuf()
 void ossimIgzStream::open( const char* name,
                            std::ios_base::openmode mode )
 {
+   m_countingBuffer.reset();
    if ( ! buf.open( name, mode))
    {
       clear( rdstate() | std::ios::badbit);
@@ -300,6 +309,7 @@ void ossimIgzStream::open( const char* name,
 
 void ossimIgzStream::close()
 {
+   m_countingBuffer.reset();
    if ( buf.is_open())
    {
       if ( !buf.close())
@@ -374,4 +384,728 @@ bool ossimOgzStream::isCompressed()const
 
 // ============================================================================
 // EOF //
+// --------------------------------------
+// class ossimGzBlockStreamBuf:
+// --------------------------------------
+
+namespace
+{
+   // Member header: gzip id, deflate, FEXTRA, no time, unknown os, then
+   // XLEN 8 and the "OB" subfield with the four byte size of the member.
+   const ossim_uint32 BLOCK_HEADER_SIZE  = 20;
+   const ossim_uint32 BLOCK_TRAILER_SIZE = 8;
+
+   void putUint16(unsigned char* p, ossim_uint32 v)
+   {
+      p[0] = static_cast<unsigned char>(v & 0xff);
+      p[1] = static_cast<unsigned char>((v >> 8) & 0xff);
+   }
+
+   void putUint32(unsigned char* p, ossim_uint32 v)
+   {
+      putUint16(p, v & 0xffff);
+      putUint16(p + 2, v >> 16);
+   }
+
+   ossim_uint32 getUint16(const unsigned char* p)
+   {
+      return p[0] | (static_cast<ossim_uint32>(p[1]) << 8);
+   }
+
+   ossim_uint32 getUint32(const unsigned char* p)
+   {
+      return getUint16(p) | (getUint16(p + 2) << 16);
+   }
+
+   /**
+    * Reads the header of the member at offset.
+    * @return Size of the member from its "OB" subfield, 0 if it has none.
+    */
+   ossim_uint32 readMemberSize(std::istream& in, ossim_uint64 offset)
+   {
+      unsigned char header[12];
+      in.clear();
+      in.seekg(static_cast<std::streamoff>(offset));
+      in.read(reinterpret_cast<char*>(header), 12);
+      if ( (in.gcount() != 12) || (header[0] != 0x1f) || (header[1] != 0x8b) ||
+           (header[2] != Z_DEFLATED) || !(header[3] & 0x04) )
+      {
+         return 0;
+      }
+      std::vector<unsigned char> extra(getUint16(header + 10));
+      if ( extra.size() )
+      {
+         in.read(reinterpret_cast<char*>(&extra.front()), extra.size());
+         if ( static_cast<size_t>(in.gcount()) != extra.size() )
+         {
+            return 0;
+         }
+      }
+      for (size_t i = 0; i + 4 <= extra.size(); i += 4 + getUint16(&extra[i + 2]))
+      {
+         if ( (extra[i] == 'O') && (extra[i + 1] == 'B') && (getUint16(&extra[i + 2]) == 4) &&
+              (i + 8 <= extra.size()) )
+         {
+            return getUint32(&extra[i + 4]);
+         }
+      }
+      return 0;
+   }
+
+   /**
+    * Deflates one block into a whole gzip member, or inflates one member
+    * back into its block, which also checks its crc.
+    */
+   class ossimGzBlockJob : public ossimJob
+   {
+   public:
+      ossimGzBlockJob(bool compress, std::vector<char>& input, ossim_uint32 outputSize)
+         : m_compress(compress),
+           m_outputSize(outputSize),
+           m_status(false)
+      {
+         m_input.swap(input);
+         m_done.reset();
+         setName(compress ? "ossimGzBlockStreamBuf.deflate" : "ossimGzBlockStreamBuf.inflate");
+      }
+
+      virtual void start()
+      {
+         m_status = m_compress ? deflateBlock() : inflateBlock();
+         std::vector<char>().swap(m_input);
+         m_done.release();
+      }
+
+      void wait()
+      {
+         m_done.block();
+      }
+
+      bool getStatus()const
+      {
+         return m_status;
+      }
+
+      std::vector<char>& getOutput()
+      {
+         return m_output;
+      }
+
+   private:
+      bool deflateBlock()
+      {
+         z_stream zs;
+         memset(&zs, 0, sizeof(zs));
+         if ( deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                           Z_DEFAULT_STRATEGY) != Z_OK )
+         {
+            return false;
+         }
+         const ossim_uint32 BOUND = deflateBound(&zs, m_input.size());
+         m_output.resize(BLOCK_HEADER_SIZE + BOUND + BLOCK_TRAILER_SIZE);
+         unsigned char* out = reinterpret_cast<unsigned char*>(&m_output.front());
+         zs.next_in   = m_input.size() ? reinterpret_cast<Bytef*>(&m_input.front()) : 0;
+         zs.avail_in  = m_input.size();
+         zs.next_out  = out + BLOCK_HEADER_SIZE;
+         zs.avail_out = BOUND;
+         int rc = deflate(&zs, Z_FINISH);
+         const ossim_uint32 DEFLATED = zs.total_out;
+         deflateEnd(&zs);
+         if ( rc != Z_STREAM_END )
+         {
+            return false;
+         }
+
+         const ossim_uint32 SIZE = BLOCK_HEADER_SIZE + DEFLATED + BLOCK_TRAILER_SIZE;
+         memset(out, 0, BLOCK_HEADER_SIZE);
+         out[0] = 0x1f;
+         out[1] = 0x8b;
+         out[2] = Z_DEFLATED;
+         out[3] = 0x04; // FEXTRA
+         out[9] = 0xff; // OS unknown
+         putUint16(out + 10, 8);
+         out[12] = 'O';
+         out[13] = 'B';
+         putUint16(out + 14, 4);
+         putUint32(out + 16, SIZE);
+
+         uLong crc = crc32(0L, Z_NULL, 0);
+         if ( m_input.size() )
+         {
+            crc = crc32(crc, reinterpret_cast<const Bytef*>(&m_input.front()), m_input.size());
+         }
+         putUint32(out + BLOCK_HEADER_SIZE + DEFLATED, crc);
+         putUint32(out + BLOCK_HEADER_SIZE + DEFLATED + 4, m_input.size());
+         m_output.resize(SIZE);
+         return true;
+      }
+
+      bool inflateBlock()
+      {
+         z_stream zs;
+         memset(&zs, 0, sizeof(zs));
+         if ( inflateInit2(&zs, MAX_WBITS + 16) != Z_OK )
+         {
+            return false;
+         }
+         m_output.resize(m_outputSize);
+         zs.next_in   = reinterpret_cast<Bytef*>(&m_input.front());
+         zs.avail_in  = m_input.size();
+         zs.next_out  = m_outputSize ? reinterpret_cast<Bytef*>(&m_output.front()) : 0;
+         zs.avail_out = m_outputSize;
+         int rc = inflate(&zs, Z_FINISH);
+         const bool STATUS = (rc == Z_STREAM_END) && (zs.total_out == m_outputSize);
+         inflateEnd(&zs);
+         return STATUS;
+      }
+
+      bool               m_compress;
+      ossim_uint32       m_outputSize;
+      std::vector<char>  m_input;
+      std::vector<char>  m_output;
+      bool               m_status;
+      OpenThreads::Block m_done;
+   };
+
+   struct ossimGzBlockIndex
+   {
+      ossim_uint64 m_offset; // File offset of the member.
+      ossim_uint32 m_size;   // Bytes of the member.
+      ossim_uint64 m_start;  // Uncompressed offset of the block.
+      ossim_uint32 m_length; // Uncompressed bytes of the block.
+   };
+
+   bool operator<(ossim_uint64 pos, const ossimGzBlockIndex& block)
+   {
+      return pos < block.m_start;
+   }
+}
+
+struct ossimGzBlockStreamBuf::PrivateData
+{
+   std::fstream                                          file;
+   ossim_uint32                                          blockSize;
+   ossim_uint32                                          threads;
+   ossimRefPtr<ossimJobMultiThreadQueue>                 queue;
+   bool                                                  error;
+
+   // Writing:
+   std::vector<char>                                     putBuffer;
+   std::deque< ossimRefPtr<ossimGzBlockJob> >            pending;
+   ossim_uint64                                          written; // Uncompressed.
+
+   // Reading:
+   std::vector<ossimGzBlockIndex>                        index;
+   ossim_uint64                                          size;
+   std::map<ossim_uint64, ossimRefPtr<ossimGzBlockJob> > blocks;
+   ossim_uint64                                          current;  // Block in the get area.
+   ossim_uint64                                          position; // With no get area.
+};
+
+ossimGzBlockStreamBuf::ossimGzBlockStreamBuf()
+   : prvtData(new PrivateData()),
+     opened(false),
+     mode(0)
+{
+   prvtData->blockSize = 1 << 20;
+   prvtData->threads   = 1;
+   prvtData->error     = false;
+   prvtData->written   = 0;
+   prvtData->size      = 0;
+   prvtData->current   = 0;
+   prvtData->position  = 0;
+
+   const char* lookup = ossimPreferences::instance()->findPreference("gzip.block_threads");
+   if (lookup)
+   {
+      prvtData->threads = ossimString(lookup).toUInt32();
+   }
+}
+
+ossimGzBlockStreamBuf::~ossimGzBlockStreamBuf()
+{
+   close();
+   if(prvtData)
+   {
+      delete prvtData;
+      prvtData = 0;
+   }
+}
+
+bool ossimGzBlockStreamBuf::is_open() const
+{
+   return opened;
+}
+
+ossimGzBlockStreamBuf* ossimGzBlockStreamBuf::open( const char* name, int open_mode)
+{
+   if ( is_open() || ((open_mode & std::ios::in) && (open_mode & std::ios::out)) ||
+        (open_mode & std::ios::ate) || (open_mode & std::ios::app) )
+   {
+      return (ossimGzBlockStreamBuf*)0;
+   }
+   mode = open_mode;
+   prvtData->error = false;
+   if ( mode & std::ios::out )
+   {
+      prvtData->file.open(name, std::ios::out|std::ios::binary|std::ios::trunc);
+      if ( !prvtData->file.is_open() )
+      {
+         return (ossimGzBlockStreamBuf*)0;
+      }
+      prvtData->putBuffer.resize(std::max<ossim_uint32>(prvtData->blockSize, 1));
+      prvtData->written = 0;
+      setp(&prvtData->putBuffer.front(),
+           &prvtData->putBuffer.front() + prvtData->putBuffer.size());
+   }
+   else if ( mode & std::ios::in )
+   {
+      prvtData->file.open(name, std::ios::in|std::ios::binary);
+      if ( !prvtData->file.is_open() )
+      {
+         return (ossimGzBlockStreamBuf*)0;
+      }
+
+      // Hop from member to member to index the blocks.
+      prvtData->file.seekg(0, std::ios::end);
+      const ossim_uint64 FILE_SIZE = prvtData->file.tellg();
+      prvtData->index.clear();
+      prvtData->size = 0;
+      ossim_uint64 offset = 0;
+      while ( offset < FILE_SIZE )
+      {
+         ossimGzBlockIndex block;
+         block.m_offset = offset;
+         block.m_size   = readMemberSize(prvtData->file, offset);
+         block.m_start  = prvtData->size;
+         unsigned char isize[4];
+         if ( (block.m_size < BLOCK_HEADER_SIZE + BLOCK_TRAILER_SIZE) ||
+              (offset + block.m_size > FILE_SIZE) ||
+              !prvtData->file.seekg(offset + block.m_size - 4).
+              read(reinterpret_cast<char*>(isize), 4) )
+         {
+            prvtData->file.close();
+            prvtData->index.clear();
+            return (ossimGzBlockStreamBuf*)0;
+         }
+         block.m_length = getUint32(isize);
+         prvtData->index.push_back(block);
+         prvtData->size += block.m_length;
+         offset += block.m_size;
+      }
+      prvtData->file.clear();
+      prvtData->current  = prvtData->index.size();
+      prvtData->position = 0;
+      setg(0, 0, 0);
+   }
+   else
+   {
+      return (ossimGzBlockStreamBuf*)0;
+   }
+   if ( prvtData->threads > 1 )
+   {
+      prvtData->queue = new ossimJobMultiThreadQueue(0, prvtData->threads);
+   }
+   opened = true;
+   return this;
+}
+
+ossimGzBlockStreamBuf* ossimGzBlockStreamBuf::close()
+{
+   if ( !is_open() )
+   {
+      return (ossimGzBlockStreamBuf*)0;
+   }
+   if ( mode & std::ios::out )
+   {
+      sync();
+      setp(0, 0);
+      std::vector<char>().swap(prvtData->putBuffer);
+   }
+   else
+   {
+      // Jobs in flight own their data; they finish on their own.
+      prvtData->blocks.clear();
+      prvtData->index.clear();
+      setg(0, 0, 0);
+   }
+   prvtData->queue = 0;
+   prvtData->file.close();
+   opened = false;
+   return prvtData->error ? (ossimGzBlockStreamBuf*)0 : this;
+}
+
+void ossimGzBlockStreamBuf::setBlockSize(ossim_uint32 bytes)
+{
+   if ( !is_open() && bytes )
+   {
+      prvtData->blockSize = bytes;
+   }
+}
+
+ossim_uint32 ossimGzBlockStreamBuf::getBlockSize()const
+{
+   return prvtData->blockSize;
+}
+
+void ossimGzBlockStreamBuf::setThreads(ossim_uint32 threads)
+{
+   if ( !is_open() )
+   {
+      prvtData->threads = threads;
+   }
+}
+
+ossim_uint32 ossimGzBlockStreamBuf::getThreads()const
+{
+   return prvtData->threads;
+}
+
+ossim_uint64 ossimGzBlockStreamBuf::getSize()const
+{
+   return prvtData->size;
+}
+
+bool ossimGzBlockStreamBuf::isBlockGzip(const char* name)
+{
+   std::ifstream in(name, std::ios::in|std::ios::binary);
+   return in.is_open() && (readMemberSize(in, 0) != 0);
+}
+
+bool ossimGzBlockStreamBuf::queueBlock()
+{
+   const ossim_uint32 COUNT = pptr() - pbase();
+   if ( COUNT )
+   {
+      // The job takes the put area; a fresh one replaces it.
+      std::vector<char> input;
+      input.swap(prvtData->putBuffer);
+      input.resize(COUNT);
+      ossimRefPtr<ossimGzBlockJob> job = new ossimGzBlockJob(true, input, 0);
+      prvtData->pending.push_back(job);
+      if ( prvtData->queue.valid() )
+      {
+         prvtData->queue->getJobQueue()->add(job.get(), false);
+      }
+      else
+      {
+         job->start();
+      }
+      prvtData->written += COUNT;
+      prvtData->putBuffer.resize(prvtData->blockSize);
+      setp(&prvtData->putBuffer.front(),
+           &prvtData->putBuffer.front() + prvtData->putBuffer.size());
+
+      // Keep up to two blocks per thread in flight.
+      while ( prvtData->pending.size() > 2 * std::max<ossim_uint32>(prvtData->threads, 1) - 1 )
+      {
+         writeOldestBlock();
+      }
+   }
+   return !prvtData->error;
+}
+
+bool ossimGzBlockStreamBuf::writeOldestBlock()
+{
+   ossimRefPtr<ossimGzBlockJob> job = prvtData->pending.front();
+   prvtData->pending.pop_front();
+   job->wait();
+   const std::vector<char>& member = job->getOutput();
+   if ( !job->getStatus() ||
+        !prvtData->file.write(&member.front(), member.size()) )
+   {
+      prvtData->error = true;
+   }
+   return !prvtData->error;
+}
+
+int ossimGzBlockStreamBuf::overflow( int c)
+{
+   if ( !(mode & std::ios::out) || !opened || !queueBlock() )
+   {
+      return EOF;
+   }
+   if ( c != EOF )
+   {
+      *pptr() = c;
+      pbump(1);
+   }
+   return (c == EOF) ? 0 : c;
+}
+
+int ossimGzBlockStreamBuf::sync()
+{
+   if ( !(mode & std::ios::out) || !opened )
+   {
+      return 0;
+   }
+   queueBlock();
+   while ( prvtData->pending.size() )
+   {
+      writeOldestBlock();
+   }
+   prvtData->file.flush();
+   return prvtData->error ? -1 : 0;
+}
+
+void ossimGzBlockStreamBuf::loadBlocks(ossim_uint64 block)
+{
+   const ossim_uint64 AHEAD = std::max<ossim_uint32>(prvtData->threads, 1);
+   const ossim_uint64 LAST  = std::min<ossim_uint64>(block + AHEAD, prvtData->index.size());
+
+   // Drop blocks behind block or beyond the read ahead window.
+   std::map<ossim_uint64, ossimRefPtr<ossimGzBlockJob> >::iterator i = prvtData->blocks.begin();
+   while ( i != prvtData->blocks.end() )
+   {
+      if ( (i->first < block) || (i->first >= LAST) )
+      {
+         prvtData->blocks.erase(i++);
+      }
+      else
+      {
+         ++i;
+      }
+   }
+
+   for (ossim_uint64 b = block; b < LAST; ++b)
+   {
+      if ( prvtData->blocks.find(b) != prvtData->blocks.end() )
+      {
+         continue;
+      }
+      const ossimGzBlockIndex& index = prvtData->index[b];
+      std::vector<char> member(index.m_size);
+      prvtData->file.clear();
+      prvtData->file.seekg(index.m_offset);
+      prvtData->file.read(&member.front(), member.size());
+      if ( static_cast<ossim_uint64>(prvtData->file.gcount()) != index.m_size )
+      {
+         member.clear();
+      }
+      ossimRefPtr<ossimGzBlockJob> job = new ossimGzBlockJob(false, member, index.m_length);
+      prvtData->blocks[b] = job;
+      if ( prvtData->queue.valid() && (b != block) )
+      {
+         prvtData->queue->getJobQueue()->add(job.get(), false);
+      }
+      else
+      {
+         job->start();
+      }
+   }
+}
+
+ossim_uint64 ossimGzBlockStreamBuf::getPosition()const
+{
+   if ( eback() )
+   {
+      return prvtData->index[prvtData->current].m_start + (gptr() - eback());
+   }
+   return prvtData->position;
+}
+
+int ossimGzBlockStreamBuf::underflow()
+{
+   if ( gptr() && ( gptr() < egptr()) )
+   {
+      return * reinterpret_cast<unsigned char *>( gptr());
+   }
+   if ( !(mode & std::ios::in) || !opened || prvtData->error )
+   {
+      return EOF;
+   }
+
+   const ossim_uint64 POS = getPosition();
+   std::vector<ossimGzBlockIndex>::const_iterator i =
+      std::upper_bound(prvtData->index.begin(), prvtData->index.end(), POS);
+   if ( (i == prvtData->index.begin()) || (POS >= prvtData->size) )
+   {
+      return EOF;
+   }
+   const ossim_uint64 BLOCK = (i - prvtData->index.begin()) - 1;
+
+   // loadBlocks() may drop the block of the get area.
+   setg(0, 0, 0);
+   prvtData->position = POS;
+   loadBlocks(BLOCK);
+   ossimRefPtr<ossimGzBlockJob> job = prvtData->blocks[BLOCK];
+   job->wait();
+   if ( !job->getStatus() )
+   {
+      prvtData->error = true;
+      return EOF;
+   }
+   std::vector<char>& data = job->getOutput();
+   const ossimGzBlockIndex& index = prvtData->index[BLOCK];
+   prvtData->current = BLOCK;
+   setg(&data.front(), &data.front() + (POS - index.m_start), &data.front() + data.size());
+   return * reinterpret_cast<unsigned char *>( gptr());
+}
+
+ossimGzBlockStreamBuf::pos_type ossimGzBlockStreamBuf::seekoff(off_type t,
+                                                               std::ios_base::seekdir dir,
+                                                               std::ios_base::openmode omode)
+{
+   if ( !opened )
+   {
+      return pos_type(off_type(-1));
+   }
+   if ( mode & std::ios::out )
+   {
+      // Only tellp().
+      if ( (dir == std::ios::cur) && (t == 0) )
+      {
+         return pos_type(prvtData->written + (pptr() - pbase()));
+      }
+      return pos_type(off_type(-1));
+   }
+
+   off_type base = 0;
+   if ( dir == std::ios::cur )
+   {
+      base = getPosition();
+   }
+   else if ( dir == std::ios::end )
+   {
+      base = prvtData->size;
+   }
+   return seekpos(pos_type(base + t), omode);
+}
+
+ossimGzBlockStreamBuf::pos_type ossimGzBlockStreamBuf::seekpos(pos_type pos,
+                                                               std::ios_base::openmode /* omode */)
+{
+   const off_type POS = pos;
+   if ( !opened || !(mode & std::ios::in) || (POS < 0) ||
+        (static_cast<ossim_uint64>(POS) > prvtData->size) )
+   {
+      return pos_type(off_type(-1));
+   }
+
+   // Stay in the get area if it holds pos.
+   if ( eback() )
+   {
+      const ossimGzBlockIndex& index = prvtData->index[prvtData->current];
+      if ( (static_cast<ossim_uint64>(POS) >= index.m_start) &&
+           (static_cast<ossim_uint64>(POS) < index.m_start + index.m_length) )
+      {
+         setg(eback(), eback() + (POS - index.m_start), egptr());
+         return pos;
+      }
+   }
+   setg(0, 0, 0);
+   prvtData->position = POS;
+   return pos;
+}
+
+ossimIgzBlockStream::ossimIgzBlockStream()
+   : ossimIFStream()
+{
+   countIo(&buf);
+}
+
+ossimIgzBlockStream::ossimIgzBlockStream( const char* name,
+                                          std::ios_base::openmode mode )
+   : ossimIFStream()
+{
+   countIo(&buf);
+   open(name, mode);
+}
+
+ossimIgzBlockStream::~ossimIgzBlockStream()
+{
+   buf.close();
+}
+
+ossimGzBlockStreamBuf* ossimIgzBlockStream::rdbuf()
+{
+   return &buf;
+}
+
+void ossimIgzBlockStream::open( const char* name,
+                                std::ios_base::openmode mode )
+{
+   m_countingBuffer.reset();
+   if ( ! buf.open( name, mode))
+   {
+      clear( rdstate() | std::ios::badbit);
+   }
+}
+
+void ossimIgzBlockStream::close()
+{
+   m_countingBuffer.reset();
+   if ( buf.is_open())
+   {
+      if ( !buf.close())
+      {
+         clear( rdstate() | std::ios::badbit);
+      }
+   }
+}
+
+bool ossimIgzBlockStream::is_open()const
+{
+   return buf.is_open();
+}
+
+bool ossimIgzBlockStream::isCompressed()const
+{
+   return true;
+}
+
+ossimOgzBlockStream::ossimOgzBlockStream()
+   : ossimOFStream()
+{
+   init(&buf);
+}
+
+ossimOgzBlockStream::ossimOgzBlockStream( const char* name,
+                                          std::ios_base::openmode mode )
+   : ossimOFStream()
+{
+   init(&buf);
+   open(name, mode);
+}
+
+ossimOgzBlockStream::~ossimOgzBlockStream()
+{
+   buf.close();
+}
+
+ossimGzBlockStreamBuf* ossimOgzBlockStream::rdbuf()
+{
+   return &buf;
+}
+
+void ossimOgzBlockStream::open( const char* name,
+                                std::ios_base::openmode mode )
+{
+   if ( ! buf.open( name, mode))
+   {
+      clear( rdstate() | std::ios::badbit);
+   }
+}
+
+void ossimOgzBlockStream::close()
+{
+   if ( buf.is_open())
+   {
+      if ( !buf.close())
+      {
+         clear( rdstate() | std::ios::badbit);
+      }
+   }
+}
+
+bool ossimOgzBlockStream::is_open()const
+{
+   return buf.is_open();
+}
+
+bool ossimOgzBlockStream::isCompressed()const
+{
+   return true;
+}
+
 #endif // OSSIM_HAS_LIBZ
@@ -24,6 +24,7 @@
 #include <ossim/base/ossimDpt.h>
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
@@ -53,7 +54,10 @@ ossimHistogram::ossimHistogram()
    vmin(0),
    vmax(0),
    mean(0.0),
-   standard_dev(0.0)
+   standard_dev(0.0),
+   intCounts(NULL),
+   countsStale(false),
+   fractionalCounts(false)
 {
    vals[0] = 0.0;
    counts[0] = 0.0;
@@ -69,7 +73,10 @@ ossimHistogram::ossimHistogram(int xres, float val1, float val2)
    vmin(0),
    vmax(0),
    mean(0.0),
-   standard_dev(0.0)
+   standard_dev(0.0),
+   intCounts(NULL),
+   countsStale(false),
+   fractionalCounts(false)
 {
    vmax = MAX(val1, val2);
    vmin = MIN(val1, val2);
@@ -124,7 +131,10 @@ ossimHistogram::ossimHistogram(float* uvals, float* ucounts, int xres)
    vmin(0),
    vmax(0),
    mean(0.0),
-   standard_dev(0.0)
+   standard_dev(0.0),
+   intCounts(NULL),
+   countsStale(false),
+   fractionalCounts(false)
 {
    if ( ( xres >= 2 ) && uvals && ucounts )
    {
@@ -140,6 +150,10 @@ ossimHistogram::ossimHistogram(float* uvals, float* ucounts, int xres)
 //-----------------------------------------------------------
 // -- Copy constructor
 ossimHistogram::ossimHistogram(const ossimHistogram& his)
+   :
+   intCounts(NULL),
+   countsStale(false),
+   fractionalCounts(false)
 {
 
    int i = 0;
@@ -172,6 +186,11 @@ ossimHistogram::ossimHistogram(const ossimHistogram& his)
       vals[i] = his_vals[i];
       counts[i] = his_counts[i];
    }
+   if (his.intCounts)
+   {
+      intCounts = new ossim_uint64[num];
+      memcpy(intCounts, his.intCounts, num*sizeof(ossim_uint64));
+   }
    vmax = his.GetMaxVal();
    vmin = his.GetMinVal();
    delta = his.GetBucketSize();
@@ -185,6 +204,10 @@ ossimHistogram::ossimHistogram(const ossimHistogram& his)
 // -- Resample a histogram
 
 ossimHistogram::ossimHistogram(const ossimHistogram* his, float width)
+   :
+   intCounts(NULL),
+   countsStale(false),
+   fractionalCounts(false)
 {
 
    stats_consistent =0;
@@ -436,6 +459,7 @@ ossimHistogram* ossimHistogram::Scale(float scale_factor)
 
 //    float lowvalue = vals[0];
    float highvalue = vals[num-1];
+   syncCounts();
 
 // Construct a new histogram
 
@@ -873,7 +897,10 @@ float ossimHistogram::GetCount(float pixelval)const
    if (index < 0)
       return -1;
    else
+   {
+      syncCounts();
       return counts[index];
+   }
 }
 
 
@@ -882,6 +909,7 @@ float ossimHistogram::GetMinVal()const
 {
    register int i=0;
 
+   syncCounts();
    while (i<num-1 && !counts[i])
       i++;
 
@@ -895,6 +923,7 @@ float ossimHistogram::GetMaxVal()const
 {
    register int i=num-1;
 
+   syncCounts();
    while (i>0 && !counts[i])
       i--;
 
@@ -910,6 +939,7 @@ float ossimHistogram::GetMaxCount()const
    register int i=0;
    float max;
    max = 0.0;
+   syncCounts();
    for (i=0; i < num; i++)
       if (counts[i] > max)
          max = counts[i];
@@ -927,8 +957,15 @@ float ossimHistogram::SetCount(float pixelval, float count)
 
    if (index < 0)
       return -1;
+   else if (intCounts && (count >= 0.0) && (count == floor(count)))
+   {
+      intCounts[index] = (ossim_uint64)count;
+      countsStale = true;
+      return count;
+   }
    else
    {
+      releaseIntCounts();
       counts[index] = count;
       return count;
    }
@@ -942,8 +979,133 @@ void ossimHistogram::UpCount(float pixelval)
    int idx = GetIndex(pixelval);
    if (idx >= 0)  // Originally (index > 0)
    {
-      counts[idx] += 1.0;
+      // Counts exactly, past the 2^24 a float bin holds, unless set to fractions:
+      ossim_uint64* bins = GetIntCounts();
+      if (bins)
+      {
+         ++bins[idx];
+      }
+      else
+      {
+         counts[idx] += 1.0;
+      }
+   }
+}
+
+ossim_uint64* ossimHistogram::GetIntCounts()
+{
+   if (!intCounts && !fractionalCounts && counts && (num > 0))
+   {
+      for (int i = 0; i < num; ++i)
+      {
+         if ( (counts[i] < 0.0) || (counts[i] != floor(counts[i])) )
+         {
+            // Not rescanned until the float counts are written again:
+            fractionalCounts = true;
+            return NULL;
+         }
+      }
+      intCounts = new ossim_uint64[num];
+      for (int i = 0; i < num; ++i)
+      {
+         intCounts[i] = (ossim_uint64)counts[i];
+      }
+   }
+
+   // The caller may write to the counts:
+   if (intCounts)
+   {
+      stats_consistent = 0;
+      countsStale = true;
    }
+   return intCounts;
+}
+
+void ossimHistogram::refreshCounts()const
+{
+   if (intCounts)
+   {
+      for (int i = 0; i < num; ++i)
+      {
+         counts[i] = (float)intCounts[i];
+      }
+   }
+   countsStale = false;
+}
+
+void ossimHistogram::releaseIntCounts()
+{
+   if (intCounts)
+   {
+      syncCounts();
+      delete [] intCounts;
+      intCounts = NULL;
+   }
+   fractionalCounts = false;
+}
+
+bool ossimHistogram::GetUnitBinRange(ossim_int64& first, ossim_int64& last)const
+{
+   // Matches GetIndex(): (v - vmin)/1 is exact for whole numbers of this range.
+   if ( (num < 1) || (delta != 1.0) || (vmin != floor(vmin)) ||
+        (vmin < -2147483648.0) || (vmax > 2147483647.0) )
+   {
+      return false;
+   }
+   first = (ossim_int64)vmin;
+   last  = ossim::min((ossim_int64)floor(vmax), first + num - 1);
+   return true;
+}
+
+bool ossimHistogram::AddCounts(const ossimHistogram& his)
+{
+   if (his.GetRes() != num)
+   {
+      return false;
+   }
+   stats_consistent = 0;
+
+   ossim_uint64* bins = his.intCounts ? GetIntCounts() : NULL;
+   if (bins)
+   {
+      for (int i = 0; i < num; ++i)
+      {
+         bins[i] += his.intCounts[i];
+      }
+   }
+   else
+   {
+      // Float counts, or integer counts plus float ones:
+      const float* hisCounts = his.GetCounts();
+      bins = intCounts ? GetIntCounts() : NULL;
+      if (bins)
+      {
+         for (int i = 0; i < num; ++i)
+         {
+            if ( (hisCounts[i] < 0.0) || (hisCounts[i] != floor(hisCounts[i])) )
+            {
+               bins = NULL;
+               break;
+            }
+         }
+      }
+      if (bins)
+      {
+         for (int i = 0; i < num; ++i)
+         {
+            bins[i] += (ossim_uint64)hisCounts[i];
+         }
+      }
+      else
+      {
+         float* floatCounts = GetCounts();
+         for (int i = 0; i < num; ++i)
+         {
+            floatCounts[i] += hisCounts[i];
+         }
+      }
+   }
+   return true;
 }
 
 float ossimHistogram::ComputeArea(float low, float high)const
@@ -972,6 +1134,7 @@ float ossimHistogram::ComputeArea(float low, float high)const
       register int i=indexlow;
       float sum = 0.0;
 
+      syncCounts();
       while (i<=indexhigh)
       {
          sum+= counts[i];
@@ -1015,6 +1178,7 @@ float ossimHistogram::getLowFractionFromValue(float val) const
    int cutoff_bucket = GetValIndex(val);
    float partial_sum = 0.0;
    float total_sum   = 0.0;
+   syncCounts();
    
    for(int i = 0; i < total_buckets; ++i)
    {
@@ -1041,6 +1205,7 @@ float ossimHistogram::getHighFractionFromValue(float val) const
    int cutoff_bucket = GetValIndex(val);
    float partial_sum = 0.0;
    float total_sum   = 0.0;
+   syncCounts();
    
    for(int i = (total_buckets-1); i >= 0; --i)
    {
@@ -1151,6 +1316,7 @@ void ossimHistogram::Dump(char *dumpfile)const
    }
    int i = 0;
 
+   syncCounts();
    for(i = 0; i < num; i++)
       fprintf(dumpfp, "%f %f\n", vals[i], counts[i]);
   
@@ -1211,6 +1377,13 @@ void ossimHistogram::deleteAll()
       delete []counts;
       counts = NULL;
    }  
+   if (intCounts)
+   {
+      delete []intCounts;
+      intCounts = NULL;
+   }
+   countsStale = false;
+   fractionalCounts = false;
 }
 
 ossimHistogram::~ossimHistogram()
@@ -1387,6 +1560,7 @@ bool ossimHistogram::saveState(ossimKeywordlist& kwl,
    ossimString binArrayList = "(";
    bool firstValue = true;
 
+   syncCounts();
    for(ossim_int32 index = 0; index < num; ++index)
    {
       if(fabs(counts[index]) > FLT_EPSILON)
@@ -1400,7 +1574,10 @@ bool ossimHistogram::saveState(ossimKeywordlist& kwl,
          {
             firstValue = false;
          }
-         binArrayList += "("+ossimString::toString(index)+","+ossimString::toString(counts[index])+")";
+         // Integer counts are written in full rather than to float precision:
+         binArrayList += "("+ossimString::toString(index)+","+
+            (intCounts ? ossimString::toString(intCounts[index]) :
+                         ossimString::toString(counts[index]))+")";
      }
    }
 
@@ -1470,13 +1647,28 @@ bool ossimHistogram::loadState(const ossimKeywordlist& kwl,
             ossim::toVector(result, binsString);
             if(!result.empty())
             {
+               // Whole counts, as saved from integer counts, are kept exact:
                ossim_uint32 idx = 0;
+               bool wholeCounts = true;
+               for(idx = 0; wholeCounts && (idx < result.size()); ++idx)
+               {
+                  wholeCounts = (result[idx].y >= 0.0) &&
+                                (result[idx].y == floor(result[idx].y));
+               }
+               ossim_uint64* exactPtr = wholeCounts ? GetIntCounts() : 0;
                for(idx = 0; idx < result.size();++idx)
                {
                   ossim_uint32 binIdx = static_cast<ossim_uint32>(result[idx].x);
                   if(binIdx < bins)
                   {
-                     countsPtr[binIdx] = result[idx].y;
+                     if(exactPtr)
+                     {
+                        exactPtr[binIdx] = static_cast<ossim_uint64>(result[idx].y);
+                     }
+                     else
+                     {
+                        countsPtr[binIdx] = result[idx].y;
+                     }
                   }
                }
             }
@@ -1600,6 +1792,7 @@ bool ossimHistogram::saveState(ossimRefPtr<ossimXmlNode> xmlNode)const
    ossim_int32 idx = 0;
    if(num > 0)
    {
+      syncCounts();
       for(idx = 0; idx < num;++idx)
       {
          out << ossimString::toString(counts[idx], 8) << " ";
@@ -0,0 +1,983 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Keep-alive http transport.  See ossimHttpConnectionPool.h.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/base/ossimHttpConnectionPool.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimTrace.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <ossim/parallel/ossimJobQueue.h>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#ifdef _WIN32
+#  include <winsock2.h>
+#  include <ws2tcpip.h>
+#else
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <netdb.h>
+#  include <netinet/in.h>
+#  include <netinet/tcp.h>
+#  include <poll.h>
+#  include <sys/socket.h>
+#  include <sys/types.h>
+#  include <unistd.h>
+#endif
+
+static ossimTrace traceDebug("ossimHttpConnectionPool:debug");
+
+RTTI_DEF1(ossimPooledHttpRequest, "ossimPooledHttpRequest", ossimHttpRequest);
+
+ossimHttpConnectionPool* ossimHttpConnectionPool::theInstance = 0;
+ossimPooledHttpRequestFactory* ossimPooledHttpRequestFactory::theInstance = 0;
+
+namespace
+{
+   const ossim_float64 DEFAULT_CONNECT_TIMEOUT   = 10.0;
+   const ossim_float64 DEFAULT_TIMEOUT           = 60.0;
+   const ossim_uint32  DEFAULT_RETRIES           = 2;
+   const ossim_uint32  DEFAULT_MAX_IDLE_PER_HOST = 8;
+   const ossim_uint32  DEFAULT_IDLE_SECONDS      = 30;
+   const ossim_uint32  DEFAULT_ASYNC_THREADS     = 4;
+
+   // First retry delay, doubled for each further retry.
+   const ossim_uint32  RETRY_DELAY_MS            = 100;
+
+#ifdef _WIN32
+   typedef SOCKET SocketHandle;
+   const SocketHandle NO_SOCKET = INVALID_SOCKET;
+
+   void closeSocket(SocketHandle s)
+   {
+      closesocket(s);
+   }
+
+   bool setNonBlocking(SocketHandle s, bool flag)
+   {
+      u_long mode = flag ? 1 : 0;
+      return ( ioctlsocket(s, FIONBIO, &mode) == 0 );
+   }
+
+   bool connectPending()
+   {
+      return ( WSAGetLastError() == WSAEWOULDBLOCK );
+   }
+
+   bool interrupted()
+   {
+      return ( WSAGetLastError() == WSAEINTR );
+   }
+#else
+   typedef int SocketHandle;
+   const SocketHandle NO_SOCKET = -1;
+
+   void closeSocket(SocketHandle s)
+   {
+      ::close(s);
+   }
+
+   bool setNonBlocking(SocketHandle s, bool flag)
+   {
+      int flags = fcntl(s, F_GETFL, 0);
+      if ( flags < 0 )
+      {
+         return false;
+      }
+      flags = flag ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+      return ( fcntl(s, F_SETFL, flags) == 0 );
+   }
+
+   bool connectPending()
+   {
+      return ( errno == EINPROGRESS );
+   }
+
+   bool interrupted()
+   {
+      return ( errno == EINTR );
+   }
+#endif
+
+   // A peer closing the connection must not raise SIGPIPE in the application.
+#ifdef MSG_NOSIGNAL
+   const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+   const int SEND_FLAGS = 0;
+#endif
+
+   ossim_float64 preference(const char* key, ossim_float64 defaultValue)
+   {
+      const char* lookup = ossimPreferences::instance()->findPreference(key);
+      if ( lookup )
+      {
+         ossim_float64 value = ossimString(lookup).toFloat64();
+         if ( value >= 0.0 )
+         {
+            return value;
+         }
+      }
+      return defaultValue;
+   }
+
+   /** Waits for s to be readable, or writable; false on timeout or error. */
+   bool waitSocket(SocketHandle s, bool write, ossim_float64 seconds)
+   {
+#ifdef _WIN32
+      fd_set set;
+      FD_ZERO(&set);
+      FD_SET(s, &set);
+      fd_set errors; // A failed connect is only signaled here.
+      FD_ZERO(&errors);
+      FD_SET(s, &errors);
+      timeval tv;
+      tv.tv_sec  = static_cast<long>(seconds);
+      tv.tv_usec = static_cast<long>( (seconds - tv.tv_sec) * 1000000.0 );
+      return ( select(0, write ? 0 : &set, write ? &set : 0, &errors, &tv) > 0 );
+#else
+      pollfd p;
+      p.fd      = s;
+      p.events  = write ? POLLOUT : POLLIN;
+      p.revents = 0;
+      const int MS = static_cast<int>(seconds * 1000.0);
+      int n;
+      do
+      {
+         n = poll(&p, 1, MS);
+      } while ( (n < 0) && interrupted() );
+      return ( n > 0 );
+#endif
+   }
+
+   /** Connects to the first address of host that answers within timeout. */
+   SocketHandle connectTo(const ossimString& host, const ossimString& port,
+                          ossim_float64 timeout, ossimString& error)
+   {
+      addrinfo hints;
+      memset(&hints, 0, sizeof(hints));
+      hints.ai_family   = AF_UNSPEC;
+      hints.ai_socktype = SOCK_STREAM;
+
+      addrinfo* addresses = 0;
+      if ( getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0 )
+      {
+         error = "Cannot resolve host " + host;
+         return NO_SOCKET;
+      }
+
+      SocketHandle result = NO_SOCKET;
+      for ( addrinfo* a = addresses; a && (result == NO_SOCKET); a = a->ai_next )
+      {
+         SocketHandle s = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+         if ( s == NO_SOCKET )
+         {
+            continue;
+         }
+
+         // Non-blocking only while connecting, so the connect timeout holds:
+         bool connected = false;
+         if ( setNonBlocking(s, true) )
+         {
+            if ( connect(s, a->ai_addr, static_cast<socklen_t>(a->ai_addrlen)) == 0 )
+            {
+               connected = true;
+            }
+            else if ( connectPending() && waitSocket(s, true, timeout) )
+            {
+               int soError = 0;
+               socklen_t length = sizeof(soError);
+               connected = ( getsockopt(s, SOL_SOCKET, SO_ERROR,
+                                        reinterpret_cast<char*>(&soError), &length) == 0 ) &&
+                  ( soError == 0 );
+            }
+         }
+
+         if ( connected && setNonBlocking(s, false) )
+         {
+            // Requests are written whole; do not hold them back.
+            int one = 1;
+            setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&one),
+                       sizeof(one));
+#ifdef SO_NOSIGPIPE
+            setsockopt(s, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+            result = s;
+         }
+         else
+         {
+            closeSocket(s);
+         }
+      }
+      freeaddrinfo(addresses);
+
+      if ( result == NO_SOCKET )
+      {
+         error = "Cannot connect to " + host + ":" + port;
+      }
+      return result;
+   }
+
+   bool sendAll(SocketHandle s, const std::string& data, ossim_float64 timeout)
+   {
+      std::string::size_type sent = 0;
+      while ( sent < data.size() )
+      {
+         if ( !waitSocket(s, true, timeout) )
+         {
+            return false;
+         }
+         int n = send(s, data.data() + sent, static_cast<int>(data.size() - sent), SEND_FLAGS);
+         if ( n <= 0 )
+         {
+            if ( (n < 0) && interrupted() )
+            {
+               continue;
+            }
+            return false;
+         }
+         sent += n;
+      }
+      return true;
+   }
+
+   /**
+    * An idle keep-alive connection has nothing to read; if it has, the server closed it (or
+    * sent something unasked for) and it cannot be used.
+    */
+   bool isIdleAlive(SocketHandle s)
+   {
+      return !waitSocket(s, false, 0.0);
+   }
+
+   /** Buffered reads of a response, each waiting at most timeout for data. */
+   class SocketReader
+   {
+   public:
+      SocketReader(SocketHandle s, ossim_float64 timeout)
+         : m_socket(s),
+           m_timeout(timeout),
+           m_buffer(),
+           m_pos(0),
+           m_eof(false)
+      {
+      }
+
+      /** Reads a line without its line end; false on error or end of stream. */
+      bool readLine(std::string& line)
+      {
+         while ( true )
+         {
+            std::string::size_type end = m_buffer.find('\n', m_pos);
+            if ( end != std::string::npos )
+            {
+               line.assign(m_buffer, m_pos, end - m_pos);
+               m_pos = end + 1;
+               if ( !line.empty() && (line[line.size() - 1] == '\r') )
+               {
+                  line.resize(line.size() - 1);
+               }
+               return true;
+            }
+            if ( !fill() )
+            {
+               return false;
+            }
+         }
+      }
+
+      /** Copies count bytes to out. */
+      bool read(std::ostream& out, ossim_uint64 count)
+      {
+         while ( count )
+         {
+            if ( (m_pos == m_buffer.size()) && !fill() )
+            {
+               return false;
+            }
+            const std::string::size_type N = static_cast<std::string::size_type>(
+               std::min<ossim_uint64>(count, m_buffer.size() - m_pos) );
+            out.write(m_buffer.data() + m_pos, N);
+            m_pos += N;
+            count -= N;
+         }
+         return true;
+      }
+
+      /** Copies all up to the end of stream to out. */
+      bool readToEnd(std::ostream& out)
+      {
+         do
+         {
+            out.write(m_buffer.data() + m_pos, m_buffer.size() - m_pos);
+            m_pos = m_buffer.size();
+         } while ( fill() );
+         return m_eof;
+      }
+
+      /** @return true if bytes past the response were received. */
+      bool hasUnread() const
+      {
+         return ( m_pos < m_buffer.size() );
+      }
+
+   private:
+      bool fill()
+      {
+         m_buffer.erase(0, m_pos);
+         m_pos = 0;
+         if ( m_eof || !waitSocket(m_socket, false, m_timeout) )
+         {
+            return false;
+         }
+         char chunk[16384];
+         int n;
+         do
+         {
+            n = recv(m_socket, chunk, sizeof(chunk), 0);
+         } while ( (n < 0) && interrupted() );
+         if ( n <= 0 )
+         {
+            m_eof = ( n == 0 );
+            return false;
+         }
+         m_buffer.append(chunk, n);
+         return true;
+      }
+
+      SocketHandle           m_socket;
+      ossim_float64          m_timeout;
+      std::string            m_buffer;
+      std::string::size_type m_pos;
+      bool                   m_eof;
+   };
+
+   /** Reads a chunked body, and the trailers after it, into out. */
+   bool readChunked(SocketReader& reader, std::ostream& out)
+   {
+      std::string line;
+      while ( reader.readLine(line) )
+      {
+         // <hex size>[;extensions]
+         std::istringstream in( line.substr(0, line.find(';')) );
+         ossim_uint64 size = 0;
+         if ( !(in >> std::hex >> size) )
+         {
+            return false;
+         }
+         if ( size == 0 )
+         {
+            while ( reader.readLine(line) )
+            {
+               if ( line.empty() )
+               {
+                  return true;
+               }
+            }
+            return false;
+         }
+         if ( !reader.read(out, size) || !reader.readLine(line) )
+         {
+            return false;
+         }
+      }
+      return false;
+   }
+
+   bool retryStatus(ossim_uint32 code)
+   {
+      return ( (code == 502) || (code == 503) || (code == 504) );
+   }
+
+   /** Runs one asynchronous request. */
+   class ossimHttpRequestJob : public ossimJob
+   {
+   public:
+      ossimHttpRequestJob(const ossimString& method,
+                          const ossimUrl& url,
+                          const ossimKeywordlist& headers,
+                          ossimHttpPendingResponse* pending)
+         : m_method(method),
+           m_url(url),
+           m_headers(headers),
+           m_pending(pending)
+      {
+         setName("ossimHttpConnectionPool.request");
+      }
+      virtual void start()
+      {
+         ossimRefPtr<ossimHttpResponse> response = new ossimHttpResponse();
+         ossimString error;
+         if ( !ossimHttpConnectionPool::instance()->execute(m_method, m_url, m_headers,
+                                                            *response, error) )
+         {
+            response = 0;
+         }
+         m_pending->finish(response.get(), error);
+      }
+   private:
+      ossimString                           m_method;
+      ossimUrl                              m_url;
+      ossimKeywordlist                      m_headers;
+      ossimRefPtr<ossimHttpPendingResponse> m_pending;
+   };
+}
+
+ossimHttpPendingResponse::ossimHttpPendingResponse()
+   : ossimReferenced(),
+     m_mutex(),
+     m_block(),
+     m_done(false),
+     m_response(0),
+     m_error()
+{
+}
+
+ossimHttpPendingResponse::~ossimHttpPendingResponse()
+{
+}
+
+bool ossimHttpPendingResponse::isDone() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   return m_done;
+}
+
+ossimHttpResponse* ossimHttpPendingResponse::wait()
+{
+   m_block.block();
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   return m_response.get();
+}
+
+ossimString ossimHttpPendingResponse::getLastError() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   return m_error;
+}
+
+void ossimHttpPendingResponse::finish(ossimHttpResponse* response, const ossimString& error)
+{
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      m_response = response;
+      m_error    = error;
+      m_done     = true;
+   }
+   m_block.release();
+}
+
+ossimHttpConnectionPool::ossimHttpConnectionPool()
+   : m_mutex(),
+     m_idle(),
+     m_connectTimeout( preference("http_pool.connect_timeout", DEFAULT_CONNECT_TIMEOUT) ),
+     m_timeout( preference("http_pool.timeout", DEFAULT_TIMEOUT) ),
+     m_retries( static_cast<ossim_uint32>(preference("http_pool.retries", DEFAULT_RETRIES)) ),
+     m_maxIdlePerHost( static_cast<ossim_uint32>(
+                          preference("http_pool.max_idle_per_host", DEFAULT_MAX_IDLE_PER_HOST)) ),
+     m_idleSeconds( static_cast<ossim_uint32>(
+                       preference("http_pool.idle_seconds", DEFAULT_IDLE_SECONDS)) ),
+     m_enabled(true),
+     m_connectionsOpened(0),
+     m_queue(0)
+{
+   const char* lookup = ossimPreferences::instance()->findPreference("http_pool.enabled");
+   if ( lookup )
+   {
+      m_enabled = ossimString(lookup).toBool();
+   }
+
+#ifdef _WIN32
+   WSADATA data;
+   WSAStartup(MAKEWORD(2, 2), &data);
+#endif
+}
+
+ossimHttpConnectionPool::~ossimHttpConnectionPool()
+{
+   closeIdleConnections();
+}
+
+ossimHttpConnectionPool* ossimHttpConnectionPool::instance()
+{
+   if(!theInstance)
+   {
+      theInstance = new ossimHttpConnectionPool();
+   }
+
+   return theInstance;
+}
+
+void ossimHttpConnectionPool::setConnectTimeout(ossim_float64 seconds)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   m_connectTimeout = seconds;
+}
+
+void ossimHttpConnectionPool::setTimeout(ossim_float64 seconds)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   m_timeout = seconds;
+}
+
+void ossimHttpConnectionPool::setRetries(ossim_uint32 retries)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   m_retries = retries;
+}
+
+void ossimHttpConnectionPool::setMaxIdlePerHost(ossim_uint32 connections)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   m_maxIdlePerHost = connections;
+}
+
+void ossimHttpConnectionPool::setIdleSeconds(ossim_uint32 seconds)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   m_idleSeconds = seconds;
+}
+
+bool ossimHttpConnectionPool::isEnabled() const
+{
+   return m_enabled;
+}
+
+ossim_uint64 ossimHttpConnectionPool::getNumberOfConnectionsOpened() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   return m_connectionsOpened;
+}
+
+void ossimHttpConnectionPool::closeIdleConnections()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   std::map<std::string, std::vector<IdleConnection> >::const_iterator i = m_idle.begin();
+   for ( ; i != m_idle.end(); ++i )
+   {
+      for ( std::vector<IdleConnection>::const_iterator c = i->second.begin();
+            c != i->second.end(); ++c )
+      {
+         closeSocket( static_cast<SocketHandle>(c->m_socket) );
+      }
+   }
+   m_idle.clear();
+}
+
+bool ossimHttpConnectionPool::acquire(const std::string& key,
+                                      const ossimString& host,
+                                      const ossimString& port,
+                                      ossim_int64& socket,
+                                      bool& reused,
+                                      ossimString& error)
+{
+   ossim_float64 connectTimeout;
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      connectTimeout = m_connectTimeout;
+
+      // Most recently used first; older ones are the likeliest to have been dropped.
+      std::map<std::string, std::vector<IdleConnection> >::iterator i = m_idle.find(key);
+      const std::time_t NOW = std::time(0);
+      while ( (i != m_idle.end()) && !i->second.empty() )
+      {
+         IdleConnection connection = i->second.back();
+         i->second.pop_back();
+         const SocketHandle S = static_cast<SocketHandle>(connection.m_socket);
+         if ( (NOW - connection.m_since <= static_cast<std::time_t>(m_idleSeconds)) &&
+              isIdleAlive(S) )
+         {
+            socket = connection.m_socket;
+            reused = true;
+            return true;
+         }
+         closeSocket(S);
+      }
+   }
+
+   SocketHandle s = connectTo(host, port, connectTimeout, error);
+   if ( s == NO_SOCKET )
+   {
+      return false;
+   }
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   ++m_connectionsOpened;
+   socket = static_cast<ossim_int64>(s);
+   reused = false;
+   return true;
+}
+
+void ossimHttpConnectionPool::release(const std::string& key, ossim_int64 socket, bool reusable)
+{
+   if ( reusable )
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      std::vector<IdleConnection>& idle = m_idle[key];
+      if ( idle.size() < m_maxIdlePerHost )
+      {
+         IdleConnection connection;
+         connection.m_socket = socket;
+         connection.m_since  = std::time(0);
+         idle.push_back(connection);
+         return;
+      }
+   }
+   closeSocket( static_cast<SocketHandle>(socket) );
+}
+
+bool ossimHttpConnectionPool::executeOnce(const ossimString& method,
+                                          const ossimUrl& url,
+                                          const ossimKeywordlist& headers,
+                                          ossimHttpResponse& response,
+                                          bool& reused,
+                                          bool& answered,
+                                          ossimString& error)
+{
+   reused   = false;
+   answered = false;
+
+   const ossimString HOST = url.getIp();
+   const ossimString PORT = url.getPort().empty() ? ossimString("80") : url.getPort();
+   const std::string KEY  = HOST.string() + ":" + PORT.string();
+
+   std::ostringstream request;
+   request << method << " /" << url.getPath();
+   if ( !url.getParams().empty() )
+   {
+      request << "?" << url.getParams();
+   }
+   request << " HTTP/1.1\r\nHost: " << HOST;
+   if ( PORT != "80" )
+   {
+      request << ":" << PORT;
+   }
+   request << "\r\n";
+   bool userAgent = false;
+   const ossimKeywordlist::KeywordMap& MAP = headers.getMap();
+   for ( ossimKeywordlist::KeywordMap::const_iterator i = MAP.begin(); i != MAP.end(); ++i )
+   {
+      const ossimString NAME = ossimString::downcase(i->first);
+      if ( (NAME == "host") || (NAME == "connection") )
+      {
+         continue;
+      }
+      userAgent = userAgent || ( NAME == "user-agent" );
+      request << i->first << ": " << i->second << "\r\n";
+   }
+   if ( !userAgent )
+   {
+      request << "User-Agent: ossim\r\n";
+   }
+   if ( method == "POST" )
+   {
+      request << "Content-Length: 0\r\n";
+   }
+   request << "Connection: keep-alive\r\n\r\n";
+
+   ossim_float64 timeout;
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      timeout = m_timeout;
+   }
+
+   ossim_int64 handle = 0;
+   if ( !acquire(KEY, HOST, PORT, handle, reused, error) )
+   {
+      return false;
+   }
+   const SocketHandle S = static_cast<SocketHandle>(handle);
+
+   if ( !sendAll(S, request.str(), timeout) )
+   {
+      closeSocket(S);
+      error = "Cannot send request to " + KEY;
+      return false;
+   }
+
+   //---
+   // Status line and headers; interim 1xx responses are skipped.  Headers go to the header
+   // stream as lines of "Name: value", as convertHeaderStreamToKeywordlist reads them.
+   //---
+   SocketReader reader(S, timeout);
+   std::string statusLine;
+   std::string headerText;
+   ossim_uint32 code = 0;
+   ossim_int64 contentLength = -1;
+   bool chunked   = false;
+   bool keepAlive = true;
+   do
+   {
+      if ( !reader.readLine(statusLine) )
+      {
+         closeSocket(S);
+         error = "No response from " + KEY;
+         return false;
+      }
+      answered = true;
+
+      // HTTP/1.x <code> <reason>
+      std::istringstream in(statusLine);
+      std::string version;
+      in >> version >> code;
+      keepAlive = ( version != "HTTP/1.0" );
+
+      headerText.clear();
+      contentLength = -1;
+      chunked = false;
+      std::string line;
+      while ( true )
+      {
+         if ( !reader.readLine(line) )
+         {
+            closeSocket(S);
+            error = "Incomplete response headers from " + KEY;
+            return false;
+         }
+         if ( line.empty() )
+         {
+            break;
+         }
+         headerText += line;
+         headerText += "\n";
+
+         std::string::size_type colon = line.find(':');
+         if ( colon == std::string::npos )
+         {
+            continue;
+         }
+         const ossimString NAME  = ossimString::downcase( ossimString(line.substr(0, colon)) );
+         const ossimString VALUE =
+            ossimString::downcase( ossimString(line.substr(colon + 1)).trim() );
+         if ( NAME == "content-length" )
+         {
+            contentLength = static_cast<ossim_int64>( VALUE.toUInt64() );
+         }
+         else if ( NAME == "transfer-encoding" )
+         {
+            chunked = VALUE.contains("chunked");
+         }
+         else if ( NAME == "connection" )
+         {
+            if ( VALUE.contains("close") )
+            {
+               keepAlive = false;
+            }
+            else if ( VALUE.contains("keep-alive") )
+            {
+               keepAlive = true;
+            }
+         }
+      }
+   } while ( (code >= 100) && (code < 200) );
+
+   response.clear();
+   response.headerStream() << statusLine << "\n" << headerText;
+
+   bool complete = true;
+   if ( (method == "HEAD") || (code == 204) || (code == 304) )
+   {
+      // No body.
+   }
+   else if ( chunked )
+   {
+      complete = readChunked(reader, response.bodyStream());
+   }
+   else if ( contentLength >= 0 )
+   {
+      complete = reader.read(response.bodyStream(), static_cast<ossim_uint64>(contentLength));
+   }
+   else
+   {
+      // Body delimited by the server closing the connection.
+      complete  = reader.readToEnd(response.bodyStream());
+      keepAlive = false;
+   }
+
+   release(KEY, handle, complete && keepAlive && !reader.hasUnread());
+
+   if ( !complete )
+   {
+      error = "Incomplete response body from " + KEY;
+      return false;
+   }
+   response.convertHeaderStreamToKeywordlist();
+   return true;
+}
+
+bool ossimHttpConnectionPool::execute(const ossimString& method,
+                                      const ossimUrl& url,
+                                      const ossimKeywordlist& headers,
+                                      ossimHttpResponse& response,
+                                      ossimString& error)
+{
+   error.clear();
+
+   // Only requests that can be sent twice without harm are retried once answered.
+   const bool IDEMPOTENT = ( (method == "GET") || (method == "HEAD") );
+   ossim_uint32 retries;
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      retries = m_retries;
+   }
+
+   ossim_uint32 attempt = 0;
+   ossim_uint32 delay   = RETRY_DELAY_MS;
+   while ( true )
+   {
+      bool reused   = false;
+      bool answered = false;
+      if ( executeOnce(method, url, headers, response, reused, answered, error) )
+      {
+         if ( !IDEMPOTENT || !retryStatus( response.getStatusCode() ) || (attempt >= retries) )
+         {
+            return true;
+         }
+         error = response.statusLine();
+      }
+      else if ( reused && !answered )
+      {
+         // The server dropped the idle connection; not counted as a retry.
+         continue;
+      }
+      else if ( (!IDEMPOTENT && answered) || (attempt >= retries) )
+      {
+         break;
+      }
+
+      if (traceDebug())
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << "ossimHttpConnectionPool::execute DEBUG:"
+            << "\nRetrying " << method << " " << url.toString() << " after: " << error
+            << std::endl;
+      }
+      OpenThreads::Thread::microSleep(delay * 1000);
+      delay *= 2;
+      ++attempt;
+   }
+
+   if (traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimHttpConnectionPool::execute DEBUG:"
+         << "\n" << method << " " << url.toString() << " failed: " << error << std::endl;
+   }
+   return false;
+}
+
+ossimRefPtr<ossimHttpPendingResponse> ossimHttpConnectionPool::executeAsync(
+   const ossimString& method,
+   const ossimUrl& url,
+   const ossimKeywordlist& headers)
+{
+   ossimRefPtr<ossimHttpPendingResponse> pending = new ossimHttpPendingResponse();
+   ossimRefPtr<ossimJob> job = new ossimHttpRequestJob(method, url, headers, pending.get());
+
+   ossimRefPtr<ossimJobMultiThreadQueue> queue;
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      if ( !m_queue.valid() )
+      {
+         const ossim_uint32 THREADS = std::max<ossim_uint32>(
+            1, static_cast<ossim_uint32>(
+               preference("http_pool.async_threads", DEFAULT_ASYNC_THREADS)) );
+         m_queue = new ossimJobMultiThreadQueue(0, THREADS);
+      }
+      queue = m_queue;
+   }
+   queue->getJobQueue()->add(job.get(), false);
+
+   return pending;
+}
+
+ossimPooledHttpRequest::ossimPooledHttpRequest()
+   : ossimHttpRequest()
+{
+}
+
+ossimString ossimPooledHttpRequest::getMethodString() const
+{
+   return ( m_methodType == HTTP_METHOD_POST ) ? ossimString("POST") : ossimString("GET");
+}
+
+ossimWebResponse* ossimPooledHttpRequest::getResponse()
+{
+   m_lastError.clear();
+   ossimRefPtr<ossimHttpResponse> response = new ossimHttpResponse();
+   if ( !ossimHttpConnectionPool::instance()->execute(getMethodString(), m_url, m_headerOptions,
+                                                      *response, m_lastError) )
+   {
+      return 0;
+   }
+   return response.release();
+}
+
+ossimRefPtr<ossimHttpPendingResponse> ossimPooledHttpRequest::getResponseAsync()
+{
+   return ossimHttpConnectionPool::instance()->executeAsync(getMethodString(), m_url,
+                                                            m_headerOptions);
+}
+
+ossimPooledHttpRequestFactory::ossimPooledHttpRequestFactory()
+   : ossimWebRequestFactoryBase()
+{
+}
+
+ossimPooledHttpRequestFactory* ossimPooledHttpRequestFactory::instance()
+{
+   if(!theInstance)
+   {
+      theInstance = new ossimPooledHttpRequestFactory();
+   }
+
+   return theInstance;
+}
+
+ossimWebRequest* ossimPooledHttpRequestFactory::create(const ossimUrl& url)
+{
+   ossimPooledHttpRequest* result = 0;
+   if ( (ossimString::downcase(url.getProtocol()) == "http") &&
+        ossimHttpConnectionPool::instance()->isEnabled() )
+   {
+      result = new ossimPooledHttpRequest();
+      result->set(url, ossimKeywordlist());
+   }
+   return result;
+}
+
+ossimObject* ossimPooledHttpRequestFactory::createObject(const ossimString& typeName) const
+{
+   if ( typeName == STATIC_TYPE_NAME(ossimPooledHttpRequest) )
+   {
+      return new ossimPooledHttpRequest();
+   }
+   return 0;
+}
+
+ossimObject* ossimPooledHttpRequestFactory::createObject(const ossimKeywordlist& kwl,
+                                                         const char* prefix) const
+{
+   ossimObject* result = createObject( ossimString(kwl.find(prefix, "type")) );
+   if ( result )
+   {
+      result->loadState(kwl, prefix);
+   }
+   return result;
+}
+
+void ossimPooledHttpRequestFactory::getTypeNameList(std::vector<ossimString>& typeList) const
+{
+   typeList.push_back( STATIC_TYPE_NAME(ossimPooledHttpRequest) );
+}
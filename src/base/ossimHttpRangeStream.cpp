@@ -0,0 +1,588 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Input stream over http(s) range requests.  See ossimHttpRangeStream.h.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/base/ossimHttpRangeStream.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimHttpRequest.h>
+#include <ossim/base/ossimHttpResponse.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimTrace.h>
+#include <ossim/base/ossimWebRequestFactoryRegistry.h>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+static ossimTrace traceDebug("ossimHttpRangeStream:debug");
+
+namespace
+{
+   const ossim_uint64 DEFAULT_BLOCK_SIZE           = 65536;
+   const ossim_uint32 DEFAULT_CACHE_BLOCKS         = 512;
+   const ossim_uint32 DEFAULT_CONCURRENT_FETCHES   = 4;
+
+   // Longest run of blocks asked for in one request, so big reads still spread over threads.
+   const ossim_uint64 MAX_RUN_BLOCKS = 16;
+
+   ossim_uint64 preference(const char* key, ossim_uint64 defaultValue)
+   {
+      const char* lookup = ossimPreferences::instance()->findPreference(key);
+      if ( lookup )
+      {
+         ossim_uint64 value = ossimString(lookup).toUInt64();
+         if ( value )
+         {
+            return value;
+         }
+      }
+      return defaultValue;
+   }
+}
+
+/** Fetches every stride'th run of a read. */
+class ossimHttpRangeFetchThread : public OpenThreads::Thread
+{
+public:
+   ossimHttpRangeFetchThread(ossimHttpRangeCache* cache,
+                             const std::vector< std::pair<ossim_uint64, ossim_uint64> >& runs,
+                             ossim_uint64 first,
+                             ossim_uint64 stride)
+      : OpenThreads::Thread(),
+        m_cache(cache),
+        m_runs(runs),
+        m_first(first),
+        m_stride(stride)
+   {
+   }
+   virtual void run()
+   {
+      for (ossim_uint64 i = m_first; i < m_runs.size(); i += m_stride)
+      {
+         m_cache->fetchRun(m_runs[i]);
+      }
+   }
+private:
+   ossimHttpRangeCache*                                         m_cache;
+   const std::vector< std::pair<ossim_uint64, ossim_uint64> >& m_runs;
+   ossim_uint64                                                 m_first;
+   ossim_uint64                                                 m_stride;
+};
+
+ossimHttpRangeCache::ossimHttpRangeCache(const ossimUrl& url)
+   : ossimReferenced(),
+     m_url(url),
+     m_size(0),
+     m_blockSize(preference("http_range_stream.block_size", DEFAULT_BLOCK_SIZE)),
+     m_maxBlocks(static_cast<ossim_uint32>(
+                    preference("http_range_stream.cache_blocks", DEFAULT_CACHE_BLOCKS))),
+     m_maxConcurrentFetches(static_cast<ossim_uint32>(
+                               preference("http_range_stream.concurrent_fetches",
+                                          DEFAULT_CONCURRENT_FETCHES))),
+     m_blocks(),
+     m_lru(),
+     m_inFlight(),
+     m_mutex(),
+     m_fetched()
+{
+}
+
+ossimHttpRangeCache::~ossimHttpRangeCache()
+{
+}
+
+bool ossimHttpRangeCache::open()
+{
+   std::vector<char> data;
+   ossim_uint64 total = 0;
+   if ( !request(0, m_blockSize, data, total) || !total )
+   {
+      return false;
+   }
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   m_size = total;
+   insertBlock(0, data);
+   return true;
+}
+
+ossim_uint64 ossimHttpRangeCache::getSize() const
+{
+   return m_size;
+}
+
+ossim_uint64 ossimHttpRangeCache::getBlockSize() const
+{
+   return m_blockSize;
+}
+
+ossim_uint32 ossimHttpRangeCache::getMaxConcurrentFetches() const
+{
+   return m_maxConcurrentFetches;
+}
+
+ossim_uint64 ossimHttpRangeCache::read(ossim_uint64 offset, char* buffer, ossim_uint64 count)
+{
+   if ( (offset >= m_size) || !count )
+   {
+      return 0;
+   }
+   count = std::min(count, m_size - offset);
+
+   const ossim_uint64 FIRST = offset / m_blockSize;
+   const ossim_uint64 LAST  = (offset + count - 1) / m_blockSize;
+
+   // Claim the blocks nobody has or is fetching, as runs of consecutive blocks.
+   std::vector< std::pair<ossim_uint64, ossim_uint64> > runs;
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      for (ossim_uint64 b = FIRST; b <= LAST; ++b)
+      {
+         if ( (m_blocks.find(b) != m_blocks.end()) || (m_inFlight.find(b) != m_inFlight.end()) )
+         {
+            continue;
+         }
+         m_inFlight.insert(b);
+         if ( runs.size() && (runs.back().second + 1 == b) &&
+              (b - runs.back().first < MAX_RUN_BLOCKS) )
+         {
+            runs.back().second = b;
+         }
+         else
+         {
+            runs.push_back(std::make_pair(b, b));
+         }
+      }
+   }
+
+   fetchRuns(runs);
+
+   ossim_uint64 copied = 0;
+   for (ossim_uint64 b = FIRST; b <= LAST; ++b)
+   {
+      const ossim_uint64 BEGIN = b * m_blockSize;
+      const ossim_uint64 LO    = std::max(offset, BEGIN);
+      const ossim_uint64 HI    = std::min(offset + count, BEGIN + m_blockSize);
+
+      bool found = false;
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         std::map<ossim_uint64, Block>::iterator i = m_blocks.find(b);
+         while ( (i == m_blocks.end()) && (m_inFlight.find(b) != m_inFlight.end()) )
+         {
+            m_fetched.wait(&m_mutex); // Another reader is fetching it.
+            i = m_blocks.find(b);
+         }
+         if ( (i != m_blocks.end()) && (i->second.m_data.size() >= HI - BEGIN) )
+         {
+            std::memcpy(buffer + (LO - offset), &i->second.m_data[LO - BEGIN], HI - LO);
+            m_lru.splice(m_lru.begin(), m_lru, i->second.m_lru);
+            found = true;
+         }
+      }
+
+      if ( !found )
+      {
+         // Failed, or evicted before we got to it.
+         std::vector<char> data;
+         if ( !fetch(BEGIN, std::min(BEGIN + m_blockSize, m_size), data) )
+         {
+            break;
+         }
+         std::memcpy(buffer + (LO - offset), &data[LO - BEGIN], HI - LO);
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         insertBlock(b, data);
+      }
+      copied += HI - LO;
+   }
+
+   return copied;
+}
+
+bool ossimHttpRangeCache::fetch(ossim_uint64 begin,
+                                ossim_uint64 end,
+                                std::vector<char>& data) const
+{
+   ossim_uint64 total = 0;
+   return request(begin, end, data, total) && (data.size() == end - begin);
+}
+
+bool ossimHttpRangeCache::request(ossim_uint64 begin,
+                                  ossim_uint64 end,
+                                  std::vector<char>& data,
+                                  ossim_uint64& total) const
+{
+   data.clear();
+   total = 0;
+
+   ossimRefPtr<ossimHttpRequest> request =
+      ossimWebRequestFactoryRegistry::instance()->createHttp(m_url);
+   if ( !request.valid() || (end <= begin) )
+   {
+      return false;
+   }
+
+   std::ostringstream range;
+   range << "bytes=" << begin << "-" << (end - 1);
+   ossimKeywordlist headers;
+   headers.add("Range", range.str().c_str());
+   request->set(m_url, headers);
+
+   ossimRefPtr<ossimWebResponse> response = request->getResponse();
+   ossimHttpResponse* httpResponse = dynamic_cast<ossimHttpResponse*>(response.get());
+   if ( !httpResponse )
+   {
+      return false;
+   }
+   httpResponse->convertHeaderStreamToKeywordlist();
+   response->copyAllDataFromInputStream(data);
+
+   bool status = false;
+   if ( httpResponse->getStatusCode() == 206 )
+   {
+      // Content-Range: bytes <first>-<last>/<total>
+      ossimString contentRange = httpResponse->headerKwl().find("Content-Range");
+      if ( contentRange.empty() )
+      {
+         contentRange = httpResponse->headerKwl().find("content-range");
+      }
+      std::string::size_type slash = contentRange.string().find('/');
+      if ( slash != std::string::npos )
+      {
+         total  = ossimString(contentRange.string().substr(slash + 1)).trim().toUInt64();
+         status = total && (data.size() == std::min(end, total) - begin);
+      }
+   }
+   else if ( httpResponse->getStatusCode() == 200 )
+   {
+      // Range ignored; keep our part of the whole body.
+      total  = data.size();
+      status = (begin < total);
+      if ( status )
+      {
+         std::vector<char>(data.begin() + begin,
+                           data.begin() + std::min(end, total)).swap(data);
+      }
+   }
+
+   if ( !status )
+   {
+      data.clear();
+      if (traceDebug())
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << "ossimHttpRangeCache::request DEBUG:"
+            << "\nRequest of " << range.str() << " from " << m_url.toString()
+            << " failed: " << httpResponse->statusLine() << std::endl;
+      }
+   }
+   return status;
+}
+
+void ossimHttpRangeCache::insertBlock(ossim_uint64 index, std::vector<char>& data)
+{
+   Block& block = m_blocks[index];
+   if ( block.m_data.empty() )
+   {
+      m_lru.push_front(index);
+   }
+   else
+   {
+      m_lru.splice(m_lru.begin(), m_lru, block.m_lru);
+   }
+   block.m_lru = m_lru.begin();
+   block.m_data.swap(data);
+
+   while ( m_blocks.size() > std::max<ossim_uint32>(m_maxBlocks, 1) )
+   {
+      m_blocks.erase(m_lru.back());
+      m_lru.pop_back();
+   }
+}
+
+void ossimHttpRangeCache::fetchRun(const std::pair<ossim_uint64, ossim_uint64>& run)
+{
+   const ossim_uint64 BEGIN = run.first * m_blockSize;
+   const ossim_uint64 END   = std::min((run.second + 1) * m_blockSize, m_size);
+   std::vector<char> data;
+   const bool STATUS = fetch(BEGIN, END, data);
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   for (ossim_uint64 b = run.first; b <= run.second; ++b)
+   {
+      if ( STATUS )
+      {
+         const ossim_uint64 LO = b * m_blockSize - BEGIN;
+         const ossim_uint64 HI = std::min(LO + m_blockSize, END - BEGIN);
+         std::vector<char> block(data.begin() + LO, data.begin() + HI);
+         insertBlock(b, block);
+      }
+      m_inFlight.erase(b);
+   }
+   m_fetched.broadcast();
+}
+
+void ossimHttpRangeCache::fetchRuns(
+   const std::vector< std::pair<ossim_uint64, ossim_uint64> >& runs)
+{
+   const ossim_uint64 THREADS = std::min<ossim_uint64>(runs.size(), m_maxConcurrentFetches);
+   if ( THREADS <= 1 )
+   {
+      for (ossim_uint64 i = 0; i < runs.size(); ++i)
+      {
+         fetchRun(runs[i]);
+      }
+      return;
+   }
+
+   // The calling thread takes the first share.
+   std::vector<ossimHttpRangeFetchThread*> threads;
+   for (ossim_uint64 i = 1; i < THREADS; ++i)
+   {
+      threads.push_back(new ossimHttpRangeFetchThread(this, runs, i, THREADS));
+      threads.back()->start();
+   }
+   ossimHttpRangeFetchThread(this, runs, 0, THREADS).run();
+   for (ossim_uint64 i = 0; i < threads.size(); ++i)
+   {
+      threads[i]->join();
+      delete threads[i];
+   }
+}
+
+ossimHttpRangeStreamBuffer::ossimHttpRangeStreamBuffer(ossimHttpRangeCache* cache)
+   : std::streambuf(),
+     m_cache(cache),
+     m_buffer(),
+     m_bufferOffset(0)
+{
+   setg(0, 0, 0);
+}
+
+ossimHttpRangeStreamBuffer::int_type ossimHttpRangeStreamBuffer::underflow()
+{
+   const ossim_uint64 POS = position();
+   if ( !m_cache.valid() || (POS >= m_cache->getSize()) )
+   {
+      return traits_type::eof();
+   }
+
+   const ossim_uint64 BLOCK_SIZE = m_cache->getBlockSize();
+   const ossim_uint64 BEGIN = POS - (POS % BLOCK_SIZE);
+   m_buffer.resize(BLOCK_SIZE);
+   const ossim_uint64 COUNT = m_cache->read(BEGIN, &m_buffer.front(),
+                                            std::min(BLOCK_SIZE, m_cache->getSize() - BEGIN));
+   if ( COUNT <= POS - BEGIN )
+   {
+      setPosition(POS);
+      return traits_type::eof();
+   }
+
+   char* base = &m_buffer.front();
+   setg(base, base + (POS - BEGIN), base + COUNT);
+   m_bufferOffset = BEGIN;
+   return traits_type::to_int_type(*gptr());
+}
+
+std::streamsize ossimHttpRangeStreamBuffer::xsgetn(char_type* s, std::streamsize n)
+{
+   if ( n <= 0 )
+   {
+      return 0;
+   }
+
+   const std::streamsize AVAILABLE = egptr() - gptr();
+   if ( n <= AVAILABLE )
+   {
+      std::memcpy(s, gptr(), n);
+      gbump(static_cast<int>(n));
+      return n;
+   }
+
+   // Past the get area; read the rest straight from the cache, its runs fetched concurrently.
+   if ( AVAILABLE > 0 )
+   {
+      std::memcpy(s, gptr(), AVAILABLE);
+   }
+   const ossim_uint64 POS = position() + AVAILABLE;
+   const ossim_uint64 COUNT = m_cache.valid() ?
+      m_cache->read(POS, s + AVAILABLE, static_cast<ossim_uint64>(n - AVAILABLE)) : 0;
+   setPosition(POS + COUNT);
+   return AVAILABLE + static_cast<std::streamsize>(COUNT);
+}
+
+std::streamsize ossimHttpRangeStreamBuffer::showmanyc()
+{
+   const ossim_uint64 POS = position();
+   if ( !m_cache.valid() || (POS >= m_cache->getSize()) )
+   {
+      return -1;
+   }
+   return static_cast<std::streamsize>(m_cache->getSize() - POS);
+}
+
+ossimHttpRangeStreamBuffer::pos_type ossimHttpRangeStreamBuffer::seekoff(
+   off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode mode)
+{
+   const off_type SIZE = m_cache.valid() ? static_cast<off_type>(m_cache->getSize()) : 0;
+   off_type pos = offset;
+   if ( dir == std::ios_base::cur )
+   {
+      pos += static_cast<off_type>(position());
+   }
+   else if ( dir == std::ios_base::end )
+   {
+      pos += SIZE;
+   }
+
+   if ( !(mode & std::ios_base::in) || (pos < 0) || (pos > SIZE) )
+   {
+      return pos_type(off_type(-1));
+   }
+
+   const ossim_uint64 TARGET = static_cast<ossim_uint64>(pos);
+   if ( eback() && (TARGET >= m_bufferOffset) &&
+        (TARGET <= m_bufferOffset + static_cast<ossim_uint64>(egptr() - eback())) )
+   {
+      setg(eback(), eback() + (TARGET - m_bufferOffset), egptr());
+   }
+   else
+   {
+      setPosition(TARGET);
+   }
+   return pos_type(pos);
+}
+
+ossimHttpRangeStreamBuffer::pos_type ossimHttpRangeStreamBuffer::seekpos(
+   pos_type pos, std::ios_base::openmode mode)
+{
+   return seekoff(off_type(pos), std::ios_base::beg, mode);
+}
+
+ossim_uint64 ossimHttpRangeStreamBuffer::position() const
+{
+   return m_bufferOffset + static_cast<ossim_uint64>(gptr() - eback());
+}
+
+void ossimHttpRangeStreamBuffer::setPosition(ossim_uint64 pos)
+{
+   setg(0, 0, 0);
+   m_bufferOffset = pos;
+}
+
+ossimHttpRangeIFStream::ossimHttpRangeIFStream(ossimHttpRangeCache* cache)
+   : ossimIFStream(),
+     m_cache(cache),
+     m_buffer(cache)
+{
+   countIo(&m_buffer);
+}
+
+ossimHttpRangeIFStream::~ossimHttpRangeIFStream()
+{
+}
+
+bool ossimHttpRangeIFStream::is_open() const
+{
+   return m_cache.valid() && m_cache->getSize();
+}
+
+ossim_uint64 ossimHttpRangeIFStream::getSize() const
+{
+   return m_cache.valid() ? m_cache->getSize() : 0;
+}
+
+ossimHttpRangeStreamFactory* ossimHttpRangeStreamFactory::theInstance = 0;
+
+ossimHttpRangeStreamFactory::ossimHttpRangeStreamFactory()
+   : ossimStreamFactoryBase(),
+     m_mutex(),
+     m_caches()
+{
+}
+
+ossimHttpRangeStreamFactory::ossimHttpRangeStreamFactory(const ossimHttpRangeStreamFactory&)
+   : ossimStreamFactoryBase(),
+     m_mutex(),
+     m_caches()
+{
+}
+
+ossimHttpRangeStreamFactory::~ossimHttpRangeStreamFactory()
+{
+}
+
+ossimHttpRangeStreamFactory* ossimHttpRangeStreamFactory::instance()
+{
+   if(!theInstance)
+   {
+      theInstance = new ossimHttpRangeStreamFactory();
+   }
+
+   return theInstance;
+}
+
+bool ossimHttpRangeStreamFactory::isUrl(const ossimString& file)
+{
+   const ossimString LOWER = ossimString::downcase(file.before(":"));
+   return ( ((LOWER == "http") || (LOWER == "https")) && file.contains("://") );
+}
+
+ossimRefPtr<ossimIFStream> ossimHttpRangeStreamFactory::createNewIFStream(
+   const ossimFilename& file,
+   std::ios_base::openmode /* openMode */) const
+{
+   ossimRefPtr<ossimIFStream> result = 0;
+   if ( !isUrl(file) )
+   {
+      return result;
+   }
+
+   ossimRefPtr<ossimHttpRangeCache> cache = 0;
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+
+      // Drop caches no stream holds any more.
+      std::map< std::string, ossimRefPtr<ossimHttpRangeCache> >::iterator i = m_caches.begin();
+      while ( i != m_caches.end() )
+      {
+         if ( i->second->referenceCount() == 1 )
+         {
+            m_caches.erase(i++);
+         }
+         else
+         {
+            ++i;
+         }
+      }
+
+      i = m_caches.find(file.string());
+      if ( i != m_caches.end() )
+      {
+         cache = i->second;
+      }
+   }
+
+   if ( !cache.valid() )
+   {
+      cache = new ossimHttpRangeCache(ossimUrl(file));
+      if ( !cache->open() )
+      {
+         return result;
+      }
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      m_caches[file.string()] = cache;
+   }
+
+   result = new ossimHttpRangeIFStream(cache.get());
+   return result;
+}
@@ -0,0 +1,68 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Read counters of a stream or image handler.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/base/ossimIoCounters.h>
+#include <OpenThreads/ScopedLock>
+
+ossimIoCounters::Values::Values()
+   : m_bytesRead(0),
+     m_reads(0),
+     m_seeks(0),
+     m_readSeconds(0.0)
+{
+}
+
+ossimIoCounters::Values& ossimIoCounters::Values::operator+=(const Values& rhs)
+{
+   m_bytesRead   += rhs.m_bytesRead;
+   m_reads       += rhs.m_reads;
+   m_seeks       += rhs.m_seeks;
+   m_readSeconds += rhs.m_readSeconds;
+   return *this;
+}
+
+ossimIoCounters::ossimIoCounters()
+   : m_mutex(),
+     m_values()
+{
+}
+
+void ossimIoCounters::addRead(ossim_int64 bytes,
+                              ossimTimer::Timer_t begin,
+                              ossimTimer::Timer_t end)
+{
+   const double SECONDS = ossimTimer::instance()->delta_s(begin, end);
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   ++m_values.m_reads;
+   if (bytes > 0)
+   {
+      m_values.m_bytesRead += (ossim_uint64)bytes;
+   }
+   m_values.m_readSeconds += SECONDS;
+}
+
+void ossimIoCounters::addSeek()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   ++m_values.m_seeks;
+}
+
+ossimIoCounters::Values ossimIoCounters::getValues() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   return m_values;
+}
+
+void ossimIoCounters::reset()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   m_values = Values();
+}
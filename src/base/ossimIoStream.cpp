@@ -15,12 +15,14 @@
 // ossimIMemoryStream
 // ossimOMemoryStream
 // ossimIOFStream
+// ossimCountingStreamBuf
 // ossimIFStream
 // ossimOFStream
 //
 //*******************************************************************
 //  $Id: ossimIoStream.cpp 23002 2014-11-24 17:11:17Z dburken $
 #include <ossim/base/ossimIoStream.h>
+#include <algorithm>
 /*
 ossimIStream::ossimIStream()
    : ossimStreamBase(),
@@ -211,21 +213,192 @@ ossimIOFStream::~ossimIOFStream()
 {
 }
 
+static const std::streamsize COUNTING_BUFFER_SIZE = 8192;
+
+ossimCountingStreamBuf::ossimCountingStreamBuf()
+   : std::streambuf(),
+     m_target(0),
+     m_buffer(COUNTING_BUFFER_SIZE),
+     m_counters()
+{
+   setg(0, 0, 0);
+}
+
+void ossimCountingStreamBuf::setTarget(std::streambuf* sb)
+{
+   m_target = sb;
+   setg(0, 0, 0);
+}
+
+std::streambuf* ossimCountingStreamBuf::getTarget() const
+{
+   return m_target;
+}
+
+void ossimCountingStreamBuf::reset()
+{
+   setg(0, 0, 0);
+}
+
+const ossimIoCounters& ossimCountingStreamBuf::getCounters() const
+{
+   return m_counters;
+}
+
+std::streamsize ossimCountingStreamBuf::readTarget(char_type* s, std::streamsize n)
+{
+   const ossimTimer::Timer_t BEGIN = ossimTimer::instance()->tick();
+   const std::streamsize RESULT = m_target->sgetn(s, n);
+   m_counters.addRead(RESULT, BEGIN, ossimTimer::instance()->tick());
+   return RESULT;
+}
+
+ossimCountingStreamBuf::int_type ossimCountingStreamBuf::underflow()
+{
+   if ( gptr() < egptr() )
+   {
+      return traits_type::to_int_type(*gptr());
+   }
+   if ( !m_target )
+   {
+      return traits_type::eof();
+   }
+   const std::streamsize N = readTarget(&m_buffer.front(), (std::streamsize)m_buffer.size());
+   if ( N <= 0 )
+   {
+      setg(0, 0, 0);
+      return traits_type::eof();
+   }
+   setg(&m_buffer.front(), &m_buffer.front(), &m_buffer.front() + N);
+   return traits_type::to_int_type(*gptr());
+}
+
+std::streamsize ossimCountingStreamBuf::xsgetn(char_type* s, std::streamsize n)
+{
+   std::streamsize result = 0;
+   while ( result < n )
+   {
+      std::streamsize available = egptr() - gptr();
+      if ( available > 0 )
+      {
+         const std::streamsize N = std::min(available, n - result);
+         traits_type::copy(s + result, gptr(), (size_t)N);
+         gbump((int)N);
+         result += N;
+      }
+      else if ( m_target && ( (n - result) >= (std::streamsize)m_buffer.size() ) )
+      {
+         // Large request: skip the copy through the buffer.
+         const std::streamsize N = readTarget(s + result, n - result);
+         if ( N <= 0 )
+         {
+            break;
+         }
+         result += N;
+      }
+      else if ( traits_type::eq_int_type(underflow(), traits_type::eof()) )
+      {
+         break;
+      }
+   }
+   return result;
+}
+
+std::streamsize ossimCountingStreamBuf::showmanyc()
+{
+   return m_target ? m_target->in_avail() : -1;
+}
+
+ossimCountingStreamBuf::pos_type ossimCountingStreamBuf::seekoff(
+   off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode mode)
+{
+   if ( !m_target )
+   {
+      return pos_type(off_type(-1));
+   }
+   const off_type BUFFERED = egptr() - gptr();
+   if ( (dir == std::ios_base::cur) && (offset == 0) )
+   {
+      // tellg: not a seek.
+      pos_type pos = m_target->pubseekoff(0, dir, mode);
+      if ( pos != pos_type(off_type(-1)) )
+      {
+         pos -= BUFFERED;
+      }
+      return pos;
+   }
+   if ( dir == std::ios_base::cur )
+   {
+      offset -= BUFFERED;
+   }
+   setg(0, 0, 0);
+   m_counters.addSeek();
+   return m_target->pubseekoff(offset, dir, mode);
+}
+
+ossimCountingStreamBuf::pos_type ossimCountingStreamBuf::seekpos(
+   pos_type pos, std::ios_base::openmode mode)
+{
+   if ( !m_target )
+   {
+      return pos_type(off_type(-1));
+   }
+   setg(0, 0, 0);
+   m_counters.addSeek();
+   return m_target->pubseekpos(pos, mode);
+}
+
+int ossimCountingStreamBuf::sync()
+{
+   return m_target ? m_target->pubsync() : -1;
+}
+
 ossimIFStream::ossimIFStream()
    : ossimStreamBase(),
-     std::basic_ifstream<char>()
+     std::basic_ifstream<char>(),
+     m_countingBuffer()
 {
+   countIo(std::basic_ifstream<char>::rdbuf());
 }
+
 ossimIFStream::ossimIFStream(const char* file, std::ios_base::openmode mode)
    : ossimStreamBase(),
-     std::basic_ifstream<char>(file, mode)
+     std::basic_ifstream<char>(file, mode),
+     m_countingBuffer()
 {
+   countIo(std::basic_ifstream<char>::rdbuf());
 }
 
 ossimIFStream::~ossimIFStream()
 {
 }
 
+void ossimIFStream::open(const char* file, std::ios_base::openmode mode)
+{
+   m_countingBuffer.reset();
+   std::basic_ifstream<char>::open(file, mode);
+}
+
+void ossimIFStream::close()
+{
+   m_countingBuffer.reset();
+   std::basic_ifstream<char>::close();
+}
+
+const ossimIoCounters& ossimIFStream::getIoCounters() const
+{
+   return m_countingBuffer.getCounters();
+}
+
+void ossimIFStream::countIo(std::streambuf* sb)
+{
+   // rdbuf(sb) clears the state, e.g. the failbit of a failed open.
+   const std::ios_base::iostate STATE = rdstate();
+   m_countingBuffer.setTarget(sb);
+   std::basic_ios<char>::rdbuf(&m_countingBuffer);
+   clear(STATE);
+}
+
 ossimOFStream::ossimOFStream()
    : ossimStreamBase(),
      std::basic_ofstream<char>()
@@ -16,7 +16,9 @@
 
 #include <algorithm>
 #include <fstream>
+#include <cstring>
 #include <list>
+#include <set>
 #include <sstream>
 #include <utility>
 
@@ -744,9 +746,7 @@ bool ossimKeywordlist::parseStream(std::istream& is, bool /* ignoreBinaryChars *
 
 bool ossimKeywordlist::parseString(const std::string& inString)
 {
-   std::istringstream in(inString);
-   
-   return parseStream(in);
+   return parseBuffer(inString.data(), inString.data() + inString.size());
 }
 
 bool ossimKeywordlist::isValidKeywordlistCharacter(ossim_uint8 c)const
@@ -823,38 +823,42 @@ ossimKeywordlist::readPreprocDirective(std::istream& in)
       if (status)
          break;
 
-      ossimString directive = sequence.before(" ");
-
-      // Check for external KWL include file:
-      if (directive == "#include")
-      {
-         ossimFilename includeFile = sequence.after(" ");
-         if (includeFile.empty())
-            break; // ignore bogus preproc line
-         includeFile.trim("\"");
-         includeFile.expandEnvironmentVariable();
-
-         // The filename can be either relative to the current file being parsed or absolute:
-         if (includeFile[0] != '/')
-            includeFile = m_currentlyParsing.path() + "/" + includeFile;
-
-         // Save the current path in case the new one contains it's own include directive!
-         ossimFilename savedCurrentPath = m_currentlyParsing;
-         addFile(includeFile); // Quietly ignore any errors loading external KWL.
-         m_currentlyParsing = savedCurrentPath;
-      }
-
-//      else if (directive == "#add_new_directive_here")
-//      {
-//         process directive
-//      }
-
+      processPreprocDirective(sequence);
       status = KeywordlistParseState_OK;
       break;
    }
    return status;
 }
 
+void ossimKeywordlist::processPreprocDirective(const ossimString& line)
+{
+   ossimString directive = line.before(" ");
+
+   // Check for external KWL include file:
+   if (directive == "#include")
+   {
+      ossimFilename includeFile = line.after(" ");
+      if (includeFile.empty())
+         return; // ignore bogus preproc line
+      includeFile.trim("\"");
+      includeFile.expandEnvironmentVariable();
+
+      // The filename can be either relative to the current file being parsed or absolute:
+      if (includeFile[0] != '/')
+         includeFile = m_currentlyParsing.path() + "/" + includeFile;
+
+      // Save the current path in case the new one contains it's own include directive!
+      ossimFilename savedCurrentPath = m_currentlyParsing;
+      addFile(includeFile); // Quietly ignore any errors loading external KWL.
+      m_currentlyParsing = savedCurrentPath;
+   }
+
+//   else if (directive == "#add_new_directive_here")
+//   {
+//      process directive
+//   }
+}
+
 ossimKeywordlist::KeywordlistParseState ossimKeywordlist::readKey(ossimString& sequence, std::istream& in)const
 {
    KeywordlistParseState result = KeywordlistParseState_FAIL;
@@ -1012,70 +1016,273 @@ ossimKeywordlist::KeywordlistParseState ossimKeywordlist::readKeyAndValuePair(os
                                                                  static_cast<int>(valueState)) );
 }
 
+namespace
+{
+   inline bool isKeywordlistCharacter(char c)
+   {
+      return ((c >= 0x20) && (c <= 0x7e)) || (c == '\n') || (c == '\r') || (c == '\t');
+   }
+
+   inline bool isLineBreak(char c)
+   {
+      return (c == '\n') || (c == '\r');
+   }
+
+   /**
+    * Reads a value as ossimKeywordlist::readValue() does: leading blanks
+    * skipped, up to the end of the line, or across lines between triple quotes.
+    * @return false on a character not allowed in a keyword list.
+    */
+   bool readBufferValue(const char*& p, const char* end, std::string& value)
+   {
+      value.clear();
+      while ( (p != end) && ((*p == ' ') || (*p == '\t')) )
+      {
+         ++p;
+      }
+      if ( (p != end) && isLineBreak(*p) )
+      {
+         ++p;
+         return true;
+      }
+
+      const char* begin = p;
+      int quoteCount = 0;
+      while ( p != end )
+      {
+         const char c = *p++;
+         if ( !isKeywordlistCharacter(c) )
+         {
+            return false;
+         }
+         if ( isLineBreak(c) && !quoteCount )
+         {
+            value.assign(begin, p - 1);
+            return true;
+         }
+         const std::ptrdiff_t SIZE = p - begin;
+         if ( SIZE > 2 )
+         {
+            //---
+            // Leading triple quotes start skipping line breaks, preserving
+            // paragraph style strings, up to the trailing ones.
+            //---
+            if ( quoteCount < 1 )
+            {
+               if ( (SIZE == 3) && !strncmp(begin, "\"\"\"", 3) )
+               {
+                  ++quoteCount;
+               }
+            }
+            else if ( !strncmp(p - 3, "\"\"\"", 3) )
+            {
+               ++quoteCount;
+            }
+         }
+         if ( quoteCount > 1 )
+         {
+            //---
+            // Some tiff writers, e.g. Space Imaging, use four quotes; strip
+            // all quotes from each end.
+            //---
+            value.assign(begin, p);
+            std::string::size_type startPos = value.find_first_not_of('"');
+            std::string::size_type stopPos  = value.find_last_not_of('"');
+            if ( ( startPos != std::string::npos ) && (stopPos != std::string::npos) )
+            {
+               value = value.substr( startPos, stopPos-startPos+1 );
+            }
+            return true;
+         }
+      }
+      value.assign(begin, p);
+      return true;
+   }
+}
+
 bool ossimKeywordlist::parseStream(std::istream& is)
 {
    if (!is) // Check stream state.
    {
       return false;
    }
-   ossimString key;
-   ossimString value;
-   ossimString sequence;
-   KeywordlistParseState state = KeywordlistParseState_OK;
-   while(!is.eof() && !is.bad())
+
+   //---
+   // Read it all at once, stopping after the first character not allowed in a
+   // keyword list: parsing fails there, so e.g. a binary file passed in by
+   // mistake is not read to the end.
+   //---
+   std::string buffer;
+   char chunk[65536];
+   bool binary = false;
+   while ( !binary && is.read(chunk, sizeof(chunk)).gcount() )
    {
-      skipWhitespace(is);
-      if(is.eof() || is.bad())
-         return true; // we skipped to end so valid keyword list
+      const char* end = chunk + is.gcount();
+      const char* c = chunk;
+      while ( (c != end) && isKeywordlistCharacter(*c) )
+      {
+         ++c;
+      }
+      binary = (c != end);
+      buffer.append(chunk, (binary ? c + 1 : end) - chunk);
+   }
+   return parseBuffer(buffer.data(), buffer.data() + buffer.size());
+}
 
-      state = readPreprocDirective(is);
-      if(state & KeywordlistParseState_BAD_STREAM)
-         return false;
+bool ossimKeywordlist::parseBuffer(const char* begin, const char* end)
+{
+   const char* p = begin;
+   std::string value;
+   while ( true )
+   {
+      while ( (p != end) && ((*p == ' ') || (*p == '\t') || isLineBreak(*p)) )
+      {
+         ++p;
+      }
+      if ( p == end )
+      {
+         return true; // we skipped to end so valid keyword list
+      }
 
-      // if we failed a preprocessor directive parse then try comment parse.
-      if(state == KeywordlistParseState_FAIL)
+      if ( *p == '#' )
       {
-         state = readComments(sequence, is);
-         if(state & KeywordlistParseState_BAD_STREAM)
+         if ( !readBufferValue(p, end, value) )
+         {
             return false;
+         }
+         processPreprocDirective(value);
+         continue;
       }
 
-      // if we failed a comment parse then try key value parse.
-      if(state == KeywordlistParseState_FAIL)
+      if ( (*p == '/') && (p + 1 != end) && (p[1] == '/') )
       {
-         key = sequence; // just in case there is a 1 token look ahead residual for a single slash test.
-         ossimKeywordlist::KeywordlistParseState testKeyValueState = readKeyAndValuePair(key, value, is);
-         if(testKeyValueState == KeywordlistParseState_OK)
+         // Comment to the end of the line.
+         for (p += 2; p != end; )
          {
-            key = key.trim();
-            if(key.empty())
-               return true;
+            const char c = *p++;
+            if ( !isKeywordlistCharacter(c) )
+            {
+               return false;
+            }
+            if ( isLineBreak(c) )
+            {
+               break;
+            }
+         }
+         continue;
+      }
 
-            if ( m_expandEnvVars == true )
-               value = value.expandEnvironmentVariable();
-            m_map.insert(std::make_pair(key.string(), value.string()));
+      // Key up to the delimiter.
+      const char* keyBegin = p;
+      const char* keyEnd   = 0;
+      if ( (*p == '/') && (m_delimiter == '/') )
+      {
+         keyEnd = p++; // Lone slash taken as the delimiter.
+      }
+      while ( !keyEnd )
+      {
+         if ( p == end )
+         {
+            return false; // we never found a delimeter so we are mal formed
          }
-         else if(testKeyValueState & KeywordlistParseState_BAD_STREAM)
+         const char c = *p++;
+         if ( !isKeywordlistCharacter(c) )
          {
             return false;
          }
-#if 0
-         // Commented out to allow an invalid line in keyword list without
-         // erroring out, effectively skipping bad line. drb - 01 Sep. 2001
-         else
+         if ( isLineBreak(c) )
          {
-            return false;
+            //---
+            // Hit end of line with no delimiter.  Allowed on last line only,
+            // where it ends the list.
+            //---
+            return (p == end);
+         }
+         if ( c == m_delimiter )
+         {
+            keyEnd = p - 1;
          }
-#endif
       }
-      else if(state & KeywordlistParseState_BAD_STREAM)
+
+      if ( !readBufferValue(p, end, value) )
       {
          return false;
       }
-      sequence = key = value = "";
-   }   
-   
-   return true;
+      ossimString key(keyBegin, keyEnd);
+      key.trim();
+      if ( key.empty() )
+      {
+         return true;
+      }
+      if ( m_expandEnvVars == true )
+      {
+         value = ossimString(value).expandEnvironmentVariable().string();
+      }
+      m_map.insert(std::make_pair(key.string(), value));
+   }
+}
+
+std::pair<ossimKeywordlist::KeywordMap::const_iterator,
+          ossimKeywordlist::KeywordMap::const_iterator>
+ossimKeywordlist::getPrefixRange(const std::string& prefix)const
+{
+   KeywordMap::const_iterator first = m_map.lower_bound(prefix);
+
+   // Keys with the prefix sort before the prefix with its last character
+   // bumped up.
+   std::string next = prefix;
+   while ( next.size() && (static_cast<unsigned char>(next[next.size() - 1]) == 0xff) )
+   {
+      next.erase(next.size() - 1);
+   }
+   if ( next.empty() )
+   {
+      return std::make_pair(first, m_map.end());
+   }
+   ++next[next.size() - 1];
+   return std::make_pair(first, m_map.lower_bound(next));
+}
+
+void ossimKeywordlist::findAllKeysWithPrefix(std::vector<ossimString>& result,
+                                             const std::string& prefix)const
+{
+   std::pair<KeywordMap::const_iterator, KeywordMap::const_iterator> range =
+      getPrefixRange(prefix);
+   for(KeywordMap::const_iterator i = range.first; i != range.second; ++i)
+   {
+      result.push_back((*i).first);
+   }
+}
+
+std::pair<ossimKeywordlist::KeywordMap::const_iterator,
+          ossimKeywordlist::KeywordMap::const_iterator>
+ossimKeywordlist::getRegExpRange(const ossimString& regularExpression)const
+{
+   //---
+   // Literal text after a leading '^', e.g. "object" of "^(object1.object[0-9]+.)",
+   // up to the first special character.  Alternatives ('|') may match
+   // anything, as may a last literal character made optional.
+   //---
+   const std::string& re = regularExpression.string();
+   if ( re.empty() || (re[0] != '^') || (re.find('|') != std::string::npos) )
+   {
+      return std::make_pair(m_map.begin(), m_map.end());
+   }
+   std::string::size_type start = re.find_first_not_of('(', 1);
+   if ( start == std::string::npos )
+   {
+      return std::make_pair(m_map.begin(), m_map.end());
+   }
+   std::string::size_type stop = re.find_first_of(".[]()*+?\\$^{}", start);
+   if ( stop == std::string::npos )
+   {
+      stop = re.size();
+   }
+   else if ( (stop > start) && ((re[stop] == '*') || (re[stop] == '?') || (re[stop] == '{')) )
+   {
+      --stop;
+   }
+   return getPrefixRange(re.substr(start, stop - start));
 }
 
 std::vector<ossimString> ossimKeywordlist::findAllKeysThatContains(const ossimString &searchString)const
@@ -1100,7 +1307,9 @@ void ossimKeywordlist::findAllKeysThatMatch( std::vector<ossimString>& result,
    KeywordMap::const_iterator i;
    ossimRegExp regExp;
    regExp.compile(regularExpression.c_str());
-   for(i = m_map.begin(); i != m_map.end(); ++i)
+   std::pair<KeywordMap::const_iterator, KeywordMap::const_iterator> range =
+      getRegExpRange(regularExpression);
+   for(i = range.first; i != range.second; ++i)
    {
       if(regExp.find( (*i).first.c_str()))
       {
@@ -1116,7 +1325,9 @@ ossim_uint32  ossimKeywordlist::getNumberOfKeysThatMatch(
    KeywordMap::const_iterator i;
    ossimRegExp regExp;
    regExp.compile(regularExpression.c_str());
-   for(i = m_map.begin(); i != m_map.end(); ++i)
+   std::pair<KeywordMap::const_iterator, KeywordMap::const_iterator> range =
+      getRegExpRange(regularExpression);
+   for(i = range.first; i != range.second; ++i)
    {
       if(regExp.find( (*i).first.c_str()))
       {
@@ -1135,7 +1346,9 @@ void ossimKeywordlist::extractKeysThatMatch(ossimKeywordlist& kwl,
    
    regExp.compile(regularExpression.c_str());
    
-   for(i = m_map.begin(); i != m_map.end(); ++i)
+   std::pair<KeywordMap::const_iterator, KeywordMap::const_iterator> range =
+      getRegExpRange(regularExpression);
+   for(i = range.first; i != range.second; ++i)
    {
       if(regExp.find( (*i).first.c_str()))
       {
@@ -1152,7 +1365,9 @@ void ossimKeywordlist::removeKeysThatMatch(const ossimString &regularExpression)
    
    regExp.compile(regularExpression.c_str());
    
-   for(i = m_map.begin(); i != m_map.end(); ++i)
+   std::pair<KeywordMap::const_iterator, KeywordMap::const_iterator> range =
+      getRegExpRange(regularExpression);
+   for(i = range.first; i != range.second; ++i)
    {
       if(regExp.find( (*i).first.c_str()))
       {
@@ -1177,17 +1392,26 @@ void ossimKeywordlist::getSubstringKeyList(std::vector<ossimString>& result,
 {
    KeywordMap::const_iterator i;
    ossimRegExp regExp;
+
+   // Substrings already in result, for skipping duplicates without a search.
+   std::set<std::string> found;
+   for(ossim_uint32 r = 0; r < result.size(); ++r)
+   {
+      found.insert(result[r].string());
+   }
    
    regExp.compile(regularExpression.c_str());
    
-   for(i = m_map.begin(); i != m_map.end(); ++i)
+   std::pair<KeywordMap::const_iterator, KeywordMap::const_iterator> range =
+      getRegExpRange(regularExpression);
+   for(i = range.first; i != range.second; ++i)
    {
       if(regExp.find( (*i).first.c_str()))
       {
          ossimString value = ossimString((*i).first.begin()+regExp.start(),
                                          (*i).first.begin()+regExp.start()+regExp.end());
          
-         if(std::find(result.begin(), result.end(), value) == result.end())
+         if(found.insert(value.string()).second)
          {
             result.push_back(value);
          }
@@ -0,0 +1,313 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description:
+//
+// Matrix operations behind NEWMAT types, done by LAPACK/BLAS when
+// available and by newmat otherwise.
+//
+//*******************************************************************
+// $Id$
+
+#include <ossim/base/ossimLinearAlgebra.h>
+#include <ossim/ossimConfig.h>
+#include <ossim/matrix/newmatap.h>
+#include <algorithm>
+#include <vector>
+
+#if OSSIM_HAS_LAPACK
+// Fortran interfaces; not all LAPACK installs ship lapacke/cblas headers.
+extern "C"
+{
+   void dgemm_(const char* transa, const char* transb,
+               const int* m, const int* n, const int* k,
+               const double* alpha, const double* a, const int* lda,
+               const double* b, const int* ldb,
+               const double* beta, double* c, const int* ldc);
+
+   void dgesvd_(const char* jobu, const char* jobvt,
+                const int* m, const int* n, double* a, const int* lda,
+                double* s, double* u, const int* ldu, double* vt, const int* ldvt,
+                double* work, const int* lwork, int* info);
+
+   void dpotrf_(const char* uplo, const int* n, double* a, const int* lda, int* info);
+
+   void dpotrs_(const char* uplo, const int* n, const int* nrhs,
+                const double* a, const int* lda, double* b, const int* ldb, int* info);
+}
+
+namespace
+{
+   // NEWMAT::Matrix keeps rows contiguous; read as column major it is the
+   // transpose, which the product routines use instead of copying.
+   void toColumnMajor(const NEWMAT::SymmetricMatrix& a, std::vector<double>& buf)
+   {
+      const int N = a.Nrows();
+      buf.resize(N*N);
+      for (int j = 1; j <= N; ++j)
+      {
+         for (int i = 1; i <= N; ++i)
+         {
+            buf[(i-1) + (j-1)*N] = a(i, j);
+         }
+      }
+   }
+
+   bool factor(const NEWMAT::SymmetricMatrix& a, std::vector<double>& buf)
+   {
+      const int N = a.Nrows();
+      int info = 0;
+      toColumnMajor(a, buf);
+      dpotrf_("L", &N, &buf.front(), &N, &info);
+      return info == 0;
+   }
+}
+#endif /* #if OSSIM_HAS_LAPACK */
+
+const char* ossimLinearAlgebra::getBackendName()
+{
+#if OSSIM_HAS_LAPACK
+   return "lapack";
+#else
+   return "newmat";
+#endif
+}
+
+void ossimLinearAlgebra::multiply(const NEWMAT::Matrix& a,
+                                  const NEWMAT::Matrix& b,
+                                  NEWMAT::Matrix& result)
+{
+#if OSSIM_HAS_LAPACK
+   const int M = a.Nrows();
+   const int K = a.Ncols();
+   const int N = b.Ncols();
+   if ( M && N && K && (b.Nrows() == K) )
+   {
+      // Row major result' = b' * a'.
+      const double ONE  = 1.0;
+      const double ZERO = 0.0;
+      result.ReSize(M, N);
+      dgemm_("N", "N", &N, &M, &K, &ONE, b.Store(), &N, a.Store(), &K,
+             &ZERO, result.Store(), &N);
+      return;
+   }
+#endif
+   result = a * b;
+}
+
+void ossimLinearAlgebra::transposeMultiply(const NEWMAT::Matrix& a,
+                                           const NEWMAT::Matrix& b,
+                                           NEWMAT::Matrix& result)
+{
+#if OSSIM_HAS_LAPACK
+   const int M = a.Nrows();
+   const int K = a.Ncols();
+   const int N = b.Ncols();
+   if ( M && N && K && (b.Nrows() == M) )
+   {
+      // Row major result' = b' * a.
+      const double ONE  = 1.0;
+      const double ZERO = 0.0;
+      result.ReSize(K, N);
+      dgemm_("N", "T", &N, &K, &M, &ONE, b.Store(), &N, a.Store(), &K,
+             &ZERO, result.Store(), &N);
+      return;
+   }
+#endif
+   result = a.t() * b;
+}
+
+bool ossimLinearAlgebra::svd(const NEWMAT::Matrix& a,
+                             NEWMAT::DiagonalMatrix& d,
+                             NEWMAT::Matrix& u,
+                             NEWMAT::Matrix& v)
+{
+   const int M = a.Nrows();
+   const int N = a.Ncols();
+   if ( (M < N) || !N )
+   {
+      return false;
+   }
+
+#if OSSIM_HAS_LAPACK
+   // The row major buffer of a is a' (N x M) column major.  With
+   // a' = v * d * u', the left vectors returned are v and the right ones u'.
+   std::vector<double> buf(a.Store(), a.Store() + M*N);
+   std::vector<double> s(N);
+   std::vector<double> lv(N*N);  // v, column major
+   std::vector<double> rvt(N*M); // u', column major N x M, i.e. u row major
+   int info  = 0;
+   int lwork = -1;
+   double query = 0.0;
+   dgesvd_("S", "S", &N, &M, &buf.front(), &N, &s.front(), &lv.front(), &N,
+           &rvt.front(), &N, &query, &lwork, &info);
+   lwork = static_cast<int>(query);
+   std::vector<double> work(lwork > 0 ? lwork : 1);
+   dgesvd_("S", "S", &N, &M, &buf.front(), &N, &s.front(), &lv.front(), &N,
+           &rvt.front(), &N, &work.front(), &lwork, &info);
+   if ( info != 0 )
+   {
+      return false;
+   }
+
+   d.ReSize(N);
+   u.ReSize(M, N);
+   v.ReSize(N, N);
+   for (int i = 0; i < N; ++i)
+   {
+      d.element(i) = s[i];
+   }
+   std::copy(rvt.begin(), rvt.end(), u.Store());
+   for (int i = 0; i < N; ++i)
+   {
+      for (int j = 0; j < N; ++j)
+      {
+         v.element(i, j) = lv[i + j*N];
+      }
+   }
+   return true;
+#else
+   try
+   {
+      NEWMAT::SVD(a, d, u, v, true, true);
+   }
+   catch (const RBD_COMMON::BaseException&)
+   {
+      return false;
+   }
+   return true;
+#endif
+}
+
+ossim_uint32 ossimLinearAlgebra::pseudoInverse(const NEWMAT::Matrix& a,
+                                               double threshold,
+                                               NEWMAT::Matrix& result)
+{
+   NEWMAT::DiagonalMatrix d;
+   NEWMAT::Matrix u;
+   NEWMAT::Matrix v;
+   if ( !svd(a, d, u, v) )
+   {
+      return 0;
+   }
+
+   ossim_uint32 rank = 0;
+   for (int i = 0; i < d.Ncols(); ++i)
+   {
+      if ( d[i] > threshold )
+      {
+         d[i] = 1.0/d[i];
+         ++rank;
+      }
+      else
+      {
+         d[i] = 0.0;
+      }
+   }
+
+   NEWMAT::Matrix vd = v * d;
+   NEWMAT::Matrix ut = u.t();
+   multiply(vd, ut, result);
+   return rank;
+}
+
+ossim_uint32 ossimLinearAlgebra::solveLeastSquares(const NEWMAT::Matrix& a,
+                                                   const NEWMAT::ColumnVector& b,
+                                                   double threshold,
+                                                   NEWMAT::ColumnVector& x)
+{
+   NEWMAT::DiagonalMatrix d;
+   NEWMAT::Matrix u;
+   NEWMAT::Matrix v;
+   if ( !svd(a, d, u, v) || (b.Nrows() != a.Nrows()) )
+   {
+      return 0;
+   }
+
+   // x = v * d^-1 * (u' * b), without forming the pseudo inverse.
+   NEWMAT::Matrix utb;
+   transposeMultiply(u, b, utb);
+   ossim_uint32 rank = 0;
+   for (int i = 0; i < d.Ncols(); ++i)
+   {
+      if ( d[i] > threshold )
+      {
+         utb[i][0] /= d[i];
+         ++rank;
+      }
+      else
+      {
+         utb[i][0] = 0.0;
+      }
+   }
+   NEWMAT::Matrix result;
+   multiply(v, utb, result);
+   x = result;
+   return rank;
+}
+
+bool ossimLinearAlgebra::cholesky(const NEWMAT::SymmetricMatrix& a,
+                                  NEWMAT::LowerTriangularMatrix& l)
+{
+#if OSSIM_HAS_LAPACK
+   std::vector<double> buf;
+   if ( !a.Nrows() || !factor(a, buf) )
+   {
+      return false;
+   }
+   const int N = a.Nrows();
+   l.ReSize(N);
+   for (int i = 0; i < N; ++i)
+   {
+      for (int j = 0; j <= i; ++j)
+      {
+         l.element(i, j) = buf[i + j*N];
+      }
+   }
+   return true;
+#else
+   try
+   {
+      l = NEWMAT::Cholesky(a);
+   }
+   catch (const RBD_COMMON::BaseException&)
+   {
+      return false;
+   }
+   return true;
+#endif
+}
+
+bool ossimLinearAlgebra::solveSymmetric(const NEWMAT::SymmetricMatrix& a,
+                                        const NEWMAT::ColumnVector& b,
+                                        NEWMAT::ColumnVector& x)
+{
+   if ( b.Nrows() != a.Nrows() )
+   {
+      return false;
+   }
+
+#if OSSIM_HAS_LAPACK
+   std::vector<double> buf;
+   if ( !a.Nrows() || !factor(a, buf) )
+   {
+      return false;
+   }
+   const int N = a.Nrows();
+   const int NRHS = 1;
+   int info = 0;
+   x = b;
+   dpotrs_("L", &N, &NRHS, &buf.front(), &N, x.Store(), &N, &info);
+   return info == 0;
+#else
+   NEWMAT::LowerTriangularMatrix l;
+   if ( !cholesky(a, l) )
+   {
+      return false;
+   }
+   NEWMAT::ColumnVector y = l.i() * b;
+   x = l.t().i() * y;
+   return true;
+#endif
+}
@@ -0,0 +1,115 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Read only, shared memory mapping of a whole file.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/base/ossimMemoryMappedFile.h>
+#include <ossim/base/ossimNotify.h>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+ossimMemoryMappedFile::ossimMemoryMappedFile()
+   : m_filename(),
+     m_data(0),
+     m_size(0),
+     m_mapping(0)
+{
+}
+
+ossimMemoryMappedFile::~ossimMemoryMappedFile()
+{
+   close();
+}
+
+bool ossimMemoryMappedFile::open(const ossimFilename& file)
+{
+   close();
+   
+#if defined(_WIN32)
+   HANDLE fileHandle = CreateFile(file.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+   if (fileHandle == INVALID_HANDLE_VALUE)
+   {
+      return false;
+   }
+   LARGE_INTEGER fileSize;
+   if ( GetFileSizeEx(fileHandle, &fileSize) && (fileSize.QuadPart > 0) )
+   {
+      HANDLE mapping = CreateFileMapping(fileHandle, 0, PAGE_READONLY, 0, 0, 0);
+      if (mapping)
+      {
+         void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+         if (view)
+         {
+            m_data    = static_cast<const ossim_uint8*>(view);
+            m_size    = static_cast<ossim_uint64>(fileSize.QuadPart);
+            m_mapping = mapping;
+         }
+         else
+         {
+            CloseHandle(mapping);
+         }
+      }
+   }
+   // The mapping keeps the file open.
+   CloseHandle(fileHandle);
+#else
+   int fd = ::open(file.c_str(), O_RDONLY);
+   if (fd < 0)
+   {
+      return false;
+   }
+   struct stat st;
+   if ( (fstat(fd, &st) == 0) && (st.st_size > 0) )
+   {
+      void* view = mmap(0, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+      if (view != MAP_FAILED)
+      {
+         m_data = static_cast<const ossim_uint8*>(view);
+         m_size = static_cast<ossim_uint64>(st.st_size);
+      }
+   }
+   // The mapping keeps the file open.
+   ::close(fd);
+#endif
+
+   if (m_data)
+   {
+      m_filename = file;
+   }
+   else
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimMemoryMappedFile::open WARNING: Cannot map file: " << file << std::endl;
+   }
+   return (m_data != 0);
+}
+
+void ossimMemoryMappedFile::close()
+{
+   if (m_data)
+   {
+#if defined(_WIN32)
+      UnmapViewOfFile(m_data);
+      CloseHandle(static_cast<HANDLE>(m_mapping));
+#else
+      munmap(const_cast<ossim_uint8*>(m_data), static_cast<size_t>(m_size));
+#endif
+   }
+   m_data    = 0;
+   m_size    = 0;
+   m_mapping = 0;
+   m_filename.clear();
+}
@@ -189,6 +189,24 @@ void ossimMultiBandHistogram::setBinCount(double binNumber, double count)
    }   
 }
 
+bool ossimMultiBandHistogram::addCounts(const ossimMultiBandHistogram& histo)
+{
+   if(histo.theHistogramList.size() != theHistogramList.size())
+   {
+      return false;
+   }
+
+   bool result = true;
+   for(ossim_uint32 idx = 0; idx < theHistogramList.size(); ++idx)
+   {
+      if(theHistogramList[idx].valid() && histo.theHistogramList[idx].valid())
+      {
+         result &= theHistogramList[idx]->AddCounts(*histo.theHistogramList[idx]);
+      }
+   }
+   return result;
+}
+
 ossimRefPtr<ossimMultiBandHistogram> ossimMultiBandHistogram::createAccumulationLessThanEqual()const
 {
    ossimRefPtr<ossimMultiBandHistogram> result = NULL;
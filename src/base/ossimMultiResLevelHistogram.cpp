@@ -198,6 +198,24 @@ const ossimRefPtr<ossimHistogram> ossimMultiResLevelHistogram::getHistogram(ossi
    return (ossimHistogram*)0;
 }
 
+bool ossimMultiResLevelHistogram::addCounts(const ossimMultiResLevelHistogram& histo)
+{
+   if(histo.theHistogramList.size() != theHistogramList.size())
+   {
+      return false;
+   }
+
+   bool result = true;
+   for(ossim_uint32 idx = 0; idx < theHistogramList.size(); ++idx)
+   {
+      if(theHistogramList[idx].valid() && histo.theHistogramList[idx].valid())
+      {
+         result &= theHistogramList[idx]->addCounts(*histo.theHistogramList[idx]);
+      }
+   }
+   return result;
+}
+
 ossim_uint32 ossimMultiResLevelHistogram::getNumberOfResLevels()const
 {
    return (ossim_uint32)theHistogramList.size();
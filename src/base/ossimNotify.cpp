@@ -9,15 +9,28 @@
 //*******************************************************************
 //  $Id: ossimNotify.cpp 23467 2015-08-14 13:59:09Z gpotts $
 
+#include <algorithm>
 #include <iostream>
+#include <csignal>
 #include <cstdio>
 #include <cstdarg>
+#include <cstdlib>
+#include <ctime>
+#include <sstream>
 #include <stack>
 #include <cstddef>
+#include <string>
+#include <vector>
 
 #include <ossim/base/ossimNotify.h>
+#include <OpenThreads/Atomic>
 #include <OpenThreads/Mutex>
 #include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+
+#if !defined(_WIN32)
+#  include <pthread.h>
+#endif
 
 static std::ostream* theOssimFatalStream  = &std::cerr;
 static std::ostream* theOssimWarnStream   = &std::cerr;
@@ -27,7 +40,10 @@ static std::ostream* theOssimDebugStream  = &std::cout;
 static std::ostream* theOssimAlwaysStream = &std::cout;
 
 static OpenThreads::Mutex theMutex;
-static ossimNotifyFlags theNotifyFlags     = ossimNotifyFlags_ALL;
+static OpenThreads::Mutex theAsyncMutex;
+
+// Set under theMutex, read without it by ossimNotify().
+static OpenThreads::Atomic theNotifyFlags(ossimNotifyFlags_ALL);
 std::stack<ossimNotifyFlags> theNotifyFlagsStack;
 
 template <class charT, class traits = std::char_traits<charT> >
@@ -162,46 +178,9 @@ private:
 static ossimNullStream    theOssimNullStream;
 static ossimLogFileStream theLogFileStream;
 
-void ossimSetDefaultNotifyHandlers()
+/** Stream of whichLevel; the caller holds theMutex, or has no other choice. */
+static std::ostream* notifyStream(ossimNotifyLevel whichLevel)
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   theOssimFatalStream  = &std::cerr;
-   theOssimWarnStream   = &std::cout;
-   theOssimInfoStream   = &std::cout;
-   theOssimNoticeStream = &std::cout;
-   theOssimDebugStream  = &std::cout;
-   theOssimAlwaysStream = &std::cout;
-}
-
-void ossimSetNotifyStream(std::ostream* outputStream,
-                          ossimNotifyFlags whichLevelsToRedirect)
-{
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   if(whichLevelsToRedirect&ossimNotifyFlags_FATAL)
-   {
-      theOssimFatalStream = outputStream;
-   }
-   if(whichLevelsToRedirect&ossimNotifyFlags_WARN)
-   {
-      theOssimWarnStream = outputStream;
-   }
-   if(whichLevelsToRedirect&ossimNotifyFlags_INFO)
-   {
-      theOssimInfoStream = outputStream;
-   }
-   if(whichLevelsToRedirect&ossimNotifyFlags_NOTICE)
-   {
-      theOssimNoticeStream = outputStream;
-   }
-   if(whichLevelsToRedirect&ossimNotifyFlags_DEBUG)
-   {
-      theOssimDebugStream = outputStream;
-   }
-}
-
-std::ostream* ossimGetNotifyStream(ossimNotifyLevel whichLevel)
-{
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
    std::ostream* notifyStream = &theOssimNullStream;
 
    switch(whichLevel)
@@ -240,72 +219,574 @@ std::ostream* ossimGetNotifyStream(ossimNotifyLevel whichLevel)
    return notifyStream;
 }
 
-OSSIMDLLEXPORT std::ostream& ossimNotify(ossimNotifyLevel level)
+//---
+// Asynchronous notification (see ossimSetNotifyAsync).  Threads reporting only append to their
+// own buffer and push finished records on theNotifyQueue; the writer thread alone touches the
+// output streams.
+//---
+namespace
 {
-   if(ossimIsReportingEnabled())
+   struct ossimNotifyRecord
    {
-      theMutex.lock();
-      if(theLogFileStream.getLogFilename() != "")
+      ossimNotifyRecord* theNext;
+      ossimNotifyLevel   theLevel;
+      std::string        theText;
+   };
+
+   /**
+    * Multiple producer, single consumer queue.  Producers push on a stack with a compare and
+    * swap; the consumer swaps out the whole stack and reverses it.  No thread ever blocks.
+    */
+   class ossimNotifyQueue
+   {
+   public:
+      ossimNotifyQueue() : theHead(0) {}
+
+      void push(ossimNotifyRecord* record)
       {
-         theMutex.unlock();
-         return theLogFileStream;
+         void* head = 0;
+         do
+         {
+            head = theHead.get();
+            record->theNext = static_cast<ossimNotifyRecord*>(head);
+         } while ( !theHead.assign(record, head) );
       }
-      else
+
+      /** @return The records pushed since the last call, oldest first, or 0 if none. */
+      ossimNotifyRecord* takeAll()
       {
-         bool reportMessageFlag = false;
-         switch(level)
+         void* head = 0;
+         do
          {
-            case ossimNotifyLevel_ALWAYS:
+            head = theHead.get();
+         } while ( head && !theHead.assign(0, head) );
+
+         ossimNotifyRecord* oldest = 0;
+         ossimNotifyRecord* record = static_cast<ossimNotifyRecord*>(head);
+         while (record)
+         {
+            ossimNotifyRecord* next = record->theNext;
+            record->theNext = oldest;
+            oldest = record;
+            record = next;
+         }
+         return oldest;
+      }
+
+   private:
+      OpenThreads::AtomicPtr theHead;
+   };
+
+   ossimNotifyQueue    theNotifyQueue;
+   OpenThreads::Atomic theAsyncFlag(0);
+   OpenThreads::Atomic theLogFileFlag(0);
+   OpenThreads::Atomic theRateLimit(0);
+   OpenThreads::Atomic theFlushRequests(0);
+   OpenThreads::Atomic theFlushesDone(0);
+
+   /** Per thread line buffer; finished lines, and text flushed, are pushed as one record. */
+   class ossimNotifyThreadBuffer : public std::streambuf
+   {
+   public:
+      ossimNotifyThreadBuffer() : theLevel(ossimNotifyLevel_WARN), theText() {}
+
+      void setLevel(ossimNotifyLevel level)
+      {
+         if ( (level != theLevel) && !theText.empty() )
+         {
+            push(theText.size());
+         }
+         theLevel = level;
+      }
+
+   protected:
+      virtual int overflow(int c)
+      {
+         if ( !traits_type::eq_int_type(c, traits_type::eof()) )
+         {
+            theText += (char)c;
+            if ( c == '\n' )
             {
-               reportMessageFlag = true;
-               break;
+               push(theText.size());
             }
-            case ossimNotifyLevel_FATAL:
+         }
+         return traits_type::not_eof(c);
+      }
+
+      virtual std::streamsize xsputn(const char* pChar, std::streamsize n)
+      {
+         theText.append(pChar, (std::string::size_type)n);
+         const std::string::size_type LAST = theText.rfind('\n');
+         if ( LAST != std::string::npos )
+         {
+            push(LAST + 1);
+         }
+         return n;
+      }
+
+      virtual int sync()
+      {
+         if ( !theText.empty() )
+         {
+            push(theText.size());
+         }
+         return 0;
+      }
+
+   private:
+      /** Pushes the first size characters. */
+      void push(std::string::size_type size)
+      {
+         ossimNotifyRecord* record = new ossimNotifyRecord;
+         record->theNext  = 0;
+         record->theLevel = theLevel;
+         record->theText  = theText.substr(0, size);
+         theText.erase(0, size);
+         theNotifyQueue.push(record);
+      }
+
+      ossimNotifyLevel theLevel;
+      std::string      theText;
+   };
+
+   class ossimNotifyThreadStream : public std::ostream
+   {
+   public:
+      ossimNotifyThreadStream() : std::ostream(&theBuffer) {}
+      virtual ~ossimNotifyThreadStream()
+      {
+         theBuffer.pubsync();
+      }
+      void setLevel(ossimNotifyLevel level)
+      {
+         theBuffer.setLevel(level);
+      }
+
+   private:
+      ossimNotifyThreadBuffer theBuffer;
+      // Copy & assignment are undefined in iostreams
+      ossimNotifyThreadStream(const ossimNotifyThreadStream&);
+      ossimNotifyThreadStream & operator=(const ossimNotifyThreadStream&);
+   };
+
+#if defined(_WIN32)
+   // Streams of threads that end are not reclaimed.
+   __declspec(thread) ossimNotifyThreadStream* theThreadStream = 0;
+
+   ossimNotifyThreadStream& getThreadStream()
+   {
+      if ( !theThreadStream )
+      {
+         theThreadStream = new ossimNotifyThreadStream;
+      }
+      return *theThreadStream;
+   }
+#else
+   pthread_key_t  theThreadStreamKey;
+   pthread_once_t theThreadStreamOnce = PTHREAD_ONCE_INIT;
+
+   void deleteThreadStream(void* stream)
+   {
+      // Pushes what the thread left unflushed.
+      delete static_cast<ossimNotifyThreadStream*>(stream);
+   }
+
+   void createThreadStreamKey()
+   {
+      pthread_key_create(&theThreadStreamKey, deleteThreadStream);
+   }
+
+   ossimNotifyThreadStream& getThreadStream()
+   {
+      pthread_once(&theThreadStreamOnce, createThreadStreamKey);
+      void* stream = pthread_getspecific(theThreadStreamKey);
+      if ( !stream )
+      {
+         stream = new ossimNotifyThreadStream;
+         pthread_setspecific(theThreadStreamKey, stream);
+      }
+      return *static_cast<ossimNotifyThreadStream*>(stream);
+   }
+#endif
+
+   bool isLevelReported(ossimNotifyLevel level, unsigned flags)
+   {
+      switch(level)
+      {
+         case ossimNotifyLevel_ALWAYS: return true;
+         case ossimNotifyLevel_FATAL:  return (flags&ossimNotifyFlags_FATAL)  != 0;
+         case ossimNotifyLevel_WARN:   return (flags&ossimNotifyFlags_WARN)   != 0;
+         case ossimNotifyLevel_INFO:   return (flags&ossimNotifyFlags_INFO)   != 0;
+         case ossimNotifyLevel_NOTICE: return (flags&ossimNotifyFlags_NOTICE) != 0;
+         case ossimNotifyLevel_DEBUG:  return (flags&ossimNotifyFlags_DEBUG)  != 0;
+      }
+      return false;
+   }
+
+   /** Drains theNotifyQueue to the notify streams, until stopped. */
+   class ossimNotifyWriter : public OpenThreads::Thread
+   {
+   public:
+      ossimNotifyWriter()
+         : theDoneFlag(0),
+           theLastLevel(ossimNotifyLevel_WARN),
+           theLastText(),
+           theRepeats(0),
+           theRepeatTime(0),
+           theWindow(0),
+           theWindowCount(0),
+           theDropped(0),
+           theTouched()
+      {}
+
+      virtual void run()
+      {
+         while ( !(unsigned)theDoneFlag )
+         {
+            const unsigned REQUEST = theFlushRequests;
+            const bool WROTE = drain();
+            const std::time_t NOW = std::time(0);
+            if ( theRepeats && (NOW != theRepeatTime) )
             {
-               if(theNotifyFlags&ossimNotifyFlags_FATAL)
-               {
-                  reportMessageFlag = true;
-               }
-               break;
+               endRepeats();
             }
-            case ossimNotifyLevel_WARN:
+            endWindow(NOW);
+            if ( REQUEST != (unsigned)theFlushesDone )
             {
-               if(theNotifyFlags&ossimNotifyFlags_WARN)
-               {
-                  reportMessageFlag = true;
-               }
-               break;
+               endRepeats();
+               flushStreams();
+               theFlushesDone.exchange(REQUEST);
             }
-            case ossimNotifyLevel_INFO:
+            else if ( !WROTE )
             {
-               if(theNotifyFlags&ossimNotifyFlags_INFO)
-               {
-                  reportMessageFlag = true;
-               }
-               break;
+               flushStreams();
+               OpenThreads::Thread::microSleep(2000);
             }
-            case ossimNotifyLevel_NOTICE:
+         }
+         drain();
+         endRepeats();
+         endWindow(std::time(0) + 1);
+         flushStreams();
+      }
+
+      void stop()
+      {
+         theDoneFlag.exchange(1);
+         join();
+      }
+
+   private:
+      /** @return true if anything was queued. */
+      bool drain()
+      {
+         ossimNotifyRecord* record = theNotifyQueue.takeAll();
+         const bool RESULT = (record != 0);
+         while (record)
+         {
+            write(*record);
+            ossimNotifyRecord* next = record->theNext;
+            delete record;
+            record = next;
+         }
+         return RESULT;
+      }
+
+      void write(const ossimNotifyRecord& record)
+      {
+         if ( (record.theLevel == theLastLevel) && (record.theText == theLastText) )
+         {
+            ++theRepeats;
+            return;
+         }
+         endRepeats();
+         theLastLevel  = record.theLevel;
+         theLastText   = record.theText;
+         theRepeatTime = std::time(0);
+
+         const unsigned LIMIT = theRateLimit;
+         if ( LIMIT )
+         {
+            endWindow(theRepeatTime);
+            if ( theWindowCount >= LIMIT )
             {
-               if(theNotifyFlags&ossimNotifyFlags_NOTICE)
-               {
-                  reportMessageFlag = true;
-               }
-               break;
+               ++theDropped;
+               return;
             }
-            case ossimNotifyLevel_DEBUG:
+            ++theWindowCount;
+         }
+         output(record.theLevel, record.theText);
+      }
+
+      void endRepeats()
+      {
+         if ( theRepeats )
+         {
+            std::ostringstream out;
+            out << "(last message repeated " << theRepeats << " times)\n";
+            output(theLastLevel, out.str());
+            theRepeats = 0;
+         }
+         theLastText.clear();
+      }
+
+      /** Starts the rate limit second of now, reporting what the last one dropped. */
+      void endWindow(std::time_t now)
+      {
+         if ( now != theWindow )
+         {
+            if ( theDropped )
+            {
+               std::ostringstream out;
+               out << "ossimNotify: " << theDropped
+                   << " messages dropped over the rate limit of " << (unsigned)theRateLimit
+                   << " per second\n";
+               output(ossimNotifyLevel_WARN, out.str());
+            }
+            theWindow      = now;
+            theWindowCount = 0;
+            theDropped     = 0;
+         }
+      }
+
+      void output(ossimNotifyLevel level, const std::string& text)
+      {
+         std::ostream* out = 0;
+         if ( (unsigned)theLogFileFlag )
+         {
+            out = &theLogFileStream;
+         }
+         else
+         {
+            out = ossimGetNotifyStream(level);
+         }
+         if ( out )
+         {
+            out->write(text.data(), (std::streamsize)text.size());
+            if ( std::find(theTouched.begin(), theTouched.end(), out) == theTouched.end() )
             {
-               if(theNotifyFlags&ossimNotifyFlags_DEBUG)
-               {
-                  reportMessageFlag = true;
-               }
-               break;
+               theTouched.push_back(out);
             }
          }
-         if(reportMessageFlag)
+      }
+
+      void flushStreams()
+      {
+         for (std::vector<std::ostream*>::iterator i = theTouched.begin();
+              i != theTouched.end(); ++i)
          {
-            theMutex.unlock();
-            return *ossimGetNotifyStream(level);
+            (*i)->flush();
          }
+         theTouched.clear();
+      }
+
+      OpenThreads::Atomic         theDoneFlag;
+      ossimNotifyLevel            theLastLevel;
+      std::string                 theLastText;
+      ossim_uint32                theRepeats;
+      std::time_t                 theRepeatTime;
+      std::time_t                 theWindow;
+      unsigned                    theWindowCount;
+      ossim_uint32                theDropped;
+      std::vector<std::ostream*>  theTouched;
+   };
+
+   ossimNotifyWriter* theNotifyWriter = 0;
+
+   //---
+   // Fatal signals write what is queued before the previous handler runs.  Best effort: the
+   // streams are not async-signal-safe, and what the writer thread already took is lost.
+   //---
+   typedef void (*ossimSignalHandler)(int);
+
+   const int FATAL_SIGNALS[] =
+   {
+      SIGSEGV, SIGABRT, SIGFPE, SIGILL
+#if defined(SIGBUS)
+      , SIGBUS
+#endif
+   };
+   const int FATAL_SIGNAL_COUNT = (int)(sizeof(FATAL_SIGNALS)/sizeof(FATAL_SIGNALS[0]));
+   ossimSignalHandler thePreviousHandlers[sizeof(FATAL_SIGNALS)/sizeof(FATAL_SIGNALS[0])];
+
+   void restoreSignalHandlers()
+   {
+      for (int i = 0; i < FATAL_SIGNAL_COUNT; ++i)
+      {
+         ossimSignalHandler previous = thePreviousHandlers[i];
+         std::signal(FATAL_SIGNALS[i],
+                     ((previous == SIG_ERR) || (previous == SIG_IGN)) ? SIG_DFL : previous);
+      }
+   }
+
+   void ossimNotifyFatalSignal(int sig)
+   {
+      restoreSignalHandlers();
+      ossimNotifyRecord* record = theNotifyQueue.takeAll();
+      while (record)
+      {
+         // Unlocked: the thread that crashed may hold theMutex.
+         std::ostream* out = (unsigned)theLogFileFlag ?
+            static_cast<std::ostream*>(&theLogFileStream) : notifyStream(record->theLevel);
+         if ( out )
+         {
+            out->write(record->theText.data(), (std::streamsize)record->theText.size());
+            out->flush();
+         }
+         record = record->theNext;
+      }
+      std::raise(sig);
+   }
+
+   void installSignalHandlers()
+   {
+      for (int i = 0; i < FATAL_SIGNAL_COUNT; ++i)
+      {
+         thePreviousHandlers[i] = std::signal(FATAL_SIGNALS[i], ossimNotifyFatalSignal);
+      }
+   }
+
+   void stopNotifyWriter()
+   {
+      ossimSetNotifyAsync(false);
+   }
+
+} // End: anonymous namespace
+
+void ossimSetNotifyAsync(bool flag)
+{
+   static bool atExitFlag = false;
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theAsyncMutex);
+   if ( flag && !theNotifyWriter )
+   {
+      if ( !atExitFlag )
+      {
+         // Drains the queue on a normal exit.
+         std::atexit(stopNotifyWriter);
+         atExitFlag = true;
+      }
+      theNotifyWriter = new ossimNotifyWriter;
+      theNotifyWriter->start();
+      installSignalHandlers();
+      theAsyncFlag.exchange(1);
+   }
+   else if ( !flag && theNotifyWriter )
+   {
+      // Text buffered by other threads and not yet flushed is printed if they report again.
+      theAsyncFlag.exchange(0);
+      getThreadStream().flush();
+      theNotifyWriter->stop();
+      delete theNotifyWriter;
+      theNotifyWriter = 0;
+      restoreSignalHandlers();
+
+      // Anything pushed while stopping:
+      ossimNotifyRecord* record = theNotifyQueue.takeAll();
+      while (record)
+      {
+         ossimNotify(record->theLevel) << record->theText;
+         ossimNotifyRecord* next = record->theNext;
+         delete record;
+         record = next;
+      }
+   }
+}
+
+bool ossimGetNotifyAsync()
+{
+   return (unsigned)theAsyncFlag != 0;
+}
+
+void ossimSetNotifyRateLimit(ossim_uint32 messagesPerSecond)
+{
+   theRateLimit.exchange(messagesPerSecond);
+}
+
+void ossimFlushNotify()
+{
+   if ( (unsigned)theAsyncFlag )
+   {
+      getThreadStream().flush();
+
+      // The writer reads the request before draining, so this thread's records are in its
+      // next drain.
+      const unsigned REQUEST = ++theFlushRequests;
+      while ( (unsigned)theAsyncFlag && ((int)(REQUEST - (unsigned)theFlushesDone) > 0) )
+      {
+         OpenThreads::Thread::microSleep(500);
+      }
+   }
+}
+
+void ossimSetDefaultNotifyHandlers()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+   theOssimFatalStream  = &std::cerr;
+   theOssimWarnStream   = &std::cout;
+   theOssimInfoStream   = &std::cout;
+   theOssimNoticeStream = &std::cout;
+   theOssimDebugStream  = &std::cout;
+   theOssimAlwaysStream = &std::cout;
+}
+
+void ossimSetNotifyStream(std::ostream* outputStream,
+                          ossimNotifyFlags whichLevelsToRedirect)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+   if(whichLevelsToRedirect&ossimNotifyFlags_FATAL)
+   {
+      theOssimFatalStream = outputStream;
+   }
+   if(whichLevelsToRedirect&ossimNotifyFlags_WARN)
+   {
+      theOssimWarnStream = outputStream;
+   }
+   if(whichLevelsToRedirect&ossimNotifyFlags_INFO)
+   {
+      theOssimInfoStream = outputStream;
+   }
+   if(whichLevelsToRedirect&ossimNotifyFlags_NOTICE)
+   {
+      theOssimNoticeStream = outputStream;
+   }
+   if(whichLevelsToRedirect&ossimNotifyFlags_DEBUG)
+   {
+      theOssimDebugStream = outputStream;
+   }
+}
+
+std::ostream* ossimGetNotifyStream(ossimNotifyLevel whichLevel)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+   return notifyStream(whichLevel);
+}
+
+OSSIMDLLEXPORT std::ostream& ossimNotify(ossimNotifyLevel level)
+{
+   const unsigned FLAGS = theNotifyFlags;
+   if(FLAGS != ossimNotifyFlags_NONE)
+   {
+      if((unsigned)theAsyncFlag)
+      {
+         // The log file, when set, takes every level, as below; the writer thread routes.
+         if((unsigned)theLogFileFlag || isLevelReported(level, FLAGS))
+         {
+            ossimNotifyThreadStream& stream = getThreadStream();
+            stream.setLevel(level);
+            return stream;
+         }
+         return theOssimNullStream;
+      }
+
+      theMutex.lock();
+      if(theLogFileStream.getLogFilename() != "")
+      {
+         theMutex.unlock();
+         return theLogFileStream;
+      }
+      else if(isLevelReported(level, FLAGS))
+      {
+         theMutex.unlock();
+         return *ossimGetNotifyStream(level);
       }
 
       theMutex.unlock();
@@ -319,6 +800,7 @@ void ossimSetLogFilename(const ossimFilename& filename)
 {
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
    theLogFileStream.setLogFilename(filename);
+   theLogFileFlag.exchange( (filename != "") ? 1 : 0 );
 }
 
 /*
@@ -351,26 +833,25 @@ ossimString ossimErrorV(const char *fmt, va_list args )
 void ossimEnableNotify(ossimNotifyFlags flags)
 {
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   theNotifyFlags = (ossimNotifyFlags)(theNotifyFlags | flags);
+   theNotifyFlags.exchange(theNotifyFlags | flags);
 }
 
 void ossimDisableNotify(ossimNotifyFlags flags)
 {
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   theNotifyFlags = (ossimNotifyFlags)((ossimNotifyFlags_ALL^flags)&
-                                       theNotifyFlags);
+   theNotifyFlags.exchange((ossimNotifyFlags_ALL^flags)&theNotifyFlags);
 }
 
 void ossimSetNotifyFlag(ossimNotifyFlags notifyFlags)
 {
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   theNotifyFlags = notifyFlags;
+   theNotifyFlags.exchange(notifyFlags);
 }
 
 void ossimPushNotifyFlags()
 {
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   theNotifyFlagsStack.push(theNotifyFlags);
+   theNotifyFlagsStack.push((ossimNotifyFlags)(unsigned)theNotifyFlags);
 }
 
 void ossimPopNotifyFlags()
@@ -380,29 +861,27 @@ void ossimPopNotifyFlags()
    {
       return;
    }
-   theNotifyFlags = theNotifyFlagsStack.top();
+   theNotifyFlags.exchange(theNotifyFlagsStack.top());
    theNotifyFlagsStack.pop();
 }
 
 ossimNotifyFlags ossimGetNotifyFlags()
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   return theNotifyFlags;
+   return (ossimNotifyFlags)(unsigned)theNotifyFlags;
 }
 
 
 
 bool ossimIsReportingEnabled()
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   return  (theNotifyFlags != ossimNotifyFlags_NONE);
+   return  ((unsigned)theNotifyFlags != ossimNotifyFlags_NONE);
 }
 
 
 void ossimNotify(ossimString msg,
                  ossimNotifyLevel notifyLevel)
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+   // Not under theMutex: ossimNotify(notifyLevel) takes it.
    ossimNotify(notifyLevel) << msg << "\n";
 }
 
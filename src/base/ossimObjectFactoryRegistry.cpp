@@ -16,8 +16,22 @@ RTTI_DEF1(ossimObjectFactoryRegistry, "ossimObjectFactoryRegistry", ossimObject)
 #include <ossim/base/ossimBaseObjectFactory.h>
 #include <ossim/base/ossimString.h>
 #include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimKeywordNames.h>
+#include <ossim/plugin/ossimSharedPluginRegistry.h>
 using namespace std;
 
+namespace
+{
+   /** Loads the deferred plugins that create typeName, see ossimSharedPluginRegistry. */
+   void loadDeferredPlugins(const ossimString& typeName)
+   {
+      ossimSharedPluginRegistry* plugins = ossimSharedPluginRegistry::instance();
+      plugins->loadDeferredPlugins(ossimSharedPluginRegistry::MANIFEST_CLASSES_KW, typeName);
+      plugins->loadDeferredPlugins(ossimSharedPluginRegistry::MANIFEST_PROJECTIONS_KW, typeName);
+   }
+}
+
 
 ossimObjectFactoryRegistry::ossimObjectFactoryRegistry()
 {
@@ -137,6 +151,25 @@ ossimObjectFactory* ossimObjectFactoryRegistry::findFactory(ossimObjectFactory*
 }
 #endif
 
+ossimObject* ossimObjectFactoryRegistry::createObject(const ossimString& name)const
+{
+   loadDeferredPlugins(name);
+   return createObjectFromRegistry(name);
+}
+
+ossimObject* ossimObjectFactoryRegistry::createObject(const ossimKeywordlist& kwl,
+                                                      const char* prefix)const
+{
+   loadDeferredPlugins(ossimString(kwl.find(prefix, ossimKeywordNames::TYPE_KW)));
+   return createObjectFromRegistry(kwl, prefix);
+}
+
+void ossimObjectFactoryRegistry::getTypeNameList(std::vector<ossimString>& typeList)const
+{
+   ossimSharedPluginRegistry::instance()->loadAllDeferredPlugins();
+   getAllTypeNamesFromRegistry(typeList);
+}
+
 void ossimObjectFactoryRegistry::getTypeNameList(std::vector<ossimString>& typeList,
                                                  const ossimString& baseType)const
 {
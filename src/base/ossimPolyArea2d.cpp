@@ -12,6 +12,7 @@
 #include <ossim/base/ossimString.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/Envelope.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/LinearRing.h>
 #include <geos/opBuffer.h>
@@ -19,11 +20,15 @@
 #include <geos/geom/Polygon.h>
 #include <geos/geom/MultiPolygon.h>
 #include <geos/geom/PrecisionModel.h>
+#include <geos/geom/prep/PreparedGeometry.h>
+#include <geos/geom/prep/PreparedGeometryFactory.h>
 #include <geos/io/WKTReader.h>
 #include <geos/io/WKTWriter.h>
 #include <geos/util/GEOSException.h>
 #include <geos/operation/valid/IsValidOp.h>
 #include <geos/opBuffer.h>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
 #include <cstdlib>
 #include <exception>
 #include <vector>
@@ -52,18 +57,34 @@ public:
    OssimPolyArea2dPrivate(GeometryPtr geom=0);
    ~OssimPolyArea2dPrivate();
    
-   void deleteGeometry() { if(m_geometry) { delete m_geometry; m_geometry = 0; }}
+   typedef const geos::geom::prep::PreparedGeometry* ConstPreparedPtr;
+
+   void deleteGeometry() { deletePrepared(); if(m_geometry) { delete m_geometry; m_geometry = 0; }}
+   void deletePrepared();
+
+   /**
+    * @return The prepared geometry, or 0 on the first predicate since the
+    * geometry was set, so areas tested once are not indexed.  Call with
+    * m_preparedMutex locked: the prepared geometry indexes itself lazily.
+    */
+   ConstPreparedPtr prepared();
    void setGeometry(const ossimPolygon& polygon, const vector<ossimPolygon>& holes = vector<ossimPolygon>());
    void setGeometry(GeometryPtr geom){deleteGeometry();m_geometry=geom;}
    geos::geom::GeometryFactory* geomFactory(){{return m_globalFactory.valid()?m_globalFactory->m_geomFactory:0;}}
    GeometryPtr m_geometry;
+   ConstPreparedPtr m_prepared;
+   ossim_uint32 m_predicateCount;
+   OpenThreads::Mutex m_preparedMutex;
    static ossimRefPtr<ossimGeometryFactoryWrapper> m_globalFactory; 
 };
 
 ossimRefPtr<ossimGeometryFactoryWrapper> OssimPolyArea2dPrivate::m_globalFactory;
 
 OssimPolyArea2dPrivate::OssimPolyArea2dPrivate(GeometryPtr geom)
-:m_geometry(geom)
+:m_geometry(geom),
+ m_prepared(0),
+ m_predicateCount(0),
+ m_preparedMutex()
 {
    static OpenThreads::Mutex globalFactoryMutex;
    
@@ -81,6 +102,35 @@ OssimPolyArea2dPrivate::~OssimPolyArea2dPrivate()
    deleteGeometry();
 }
 
+void OssimPolyArea2dPrivate::deletePrepared()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_preparedMutex);
+   if(m_prepared)
+   {
+      geos::geom::prep::PreparedGeometryFactory::destroy(m_prepared);
+      m_prepared = 0;
+   }
+   m_predicateCount = 0;
+}
+
+OssimPolyArea2dPrivate::ConstPreparedPtr OssimPolyArea2dPrivate::prepared()
+{
+   if(!m_prepared && m_geometry && (++m_predicateCount > 1))
+   {
+      try
+      {
+         m_prepared = geos::geom::prep::PreparedGeometryFactory::prepare(m_geometry);
+      }
+      catch(const std::exception& e)
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << "OssimPolyArea2dPrivate::prepared: " << e.what() << std::endl;
+         m_prepared = 0;
+      }
+   }
+   return m_prepared;
+}
+
 void OssimPolyArea2dPrivate::setGeometry(
    const ossimPolygon& exteriorRing, const vector<ossimPolygon>& interiorRings)
 {
@@ -402,7 +452,72 @@ bool ossimPolyArea2d::intersects(const ossimPolyArea2d& rhs)const
 
    if(m_privateData->m_geometry&&rhs.m_privateData->m_geometry)
    {
-      result = m_privateData->m_geometry->intersects(rhs.m_privateData->m_geometry); 
+      try
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_privateData->m_preparedMutex);
+         OssimPolyArea2dPrivate::ConstPreparedPtr prep = m_privateData->prepared();
+         result = prep ? prep->intersects(rhs.m_privateData->m_geometry) :
+            m_privateData->m_geometry->intersects(rhs.m_privateData->m_geometry);
+      }
+      catch(const std::exception& e)
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "ossimPolyArea2d::intersects: " << e.what() << std::endl;
+      }
+   }
+
+   return result;
+}
+
+bool ossimPolyArea2d::intersectsRect(const ossimDrect& rect)const
+{
+   return (classify(rect) != RECT_OUTSIDE);
+}
+
+ossimPolyArea2d::RectRelation ossimPolyArea2d::classify(const ossimIrect& rect)const
+{
+   return classify(ossimDrect(rect));
+}
+
+ossimPolyArea2d::RectRelation ossimPolyArea2d::classify(const ossimDrect& rect)const
+{
+   if(isEmpty() || rect.hasNans())
+   {
+      return RECT_OUTSIDE;
+   }
+
+   const geos::geom::Envelope rectEnvelope(rect.ul().x, rect.lr().x,
+                                           rect.ul().y, rect.lr().y);
+   if(!m_privateData->m_geometry->getEnvelopeInternal()->intersects(rectEnvelope))
+   {
+      return RECT_OUTSIDE;
+   }
+
+   RectRelation result = RECT_CROSSING;
+   try // GEOS code throws exceptions...
+   {
+      std::auto_ptr<geos::geom::Geometry> rectGeom(
+         m_privateData->geomFactory()->toGeometry(&rectEnvelope));
+
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_privateData->m_preparedMutex);
+      OssimPolyArea2dPrivate::ConstPreparedPtr prep = m_privateData->prepared();
+      if(prep ? prep->covers(rectGeom.get()) :
+         m_privateData->m_geometry->covers(rectGeom.get()))
+      {
+         result = RECT_INSIDE;
+      }
+      else if(!(prep ? prep->intersects(rectGeom.get()) :
+                m_privateData->m_geometry->intersects(rectGeom.get())))
+      {
+         result = RECT_OUTSIDE;
+      }
+   }
+   catch(const std::exception& e)
+   {
+      // Undetermined, so the caller tests pixel by pixel.
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimPolyArea2d::classify: " << e.what() << std::endl;
+      result = RECT_CROSSING;
    }
 
    return result;
@@ -669,8 +784,12 @@ bool ossimPolyArea2d::isPointWithin(double x, double y)const
    {
       geos::geom::Coordinate c(x,y);
       geos::geom::Geometry* geom = m_privateData->geomFactory()->createPoint(c);
-  
-      result = m_privateData->m_geometry->intersects(geom);
+
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_privateData->m_preparedMutex);
+         OssimPolyArea2dPrivate::ConstPreparedPtr prep = m_privateData->prepared();
+         result = prep ? prep->intersects(geom) : m_privateData->m_geometry->intersects(geom);
+      }
 
       delete geom;
    }
@@ -145,6 +145,87 @@ void ossimPolyLine::roundToIntegerBounds(bool compress)
     }
 }
 
+void ossimPolyLine::simplify(double tolerance)
+{
+   simplify(theVertexList, tolerance);
+   theCurrentVertex = 0;
+}
+
+void ossimPolyLine::simplify(vector<ossimDpt>& vertices, double tolerance)
+{
+   const ossim_uint32 N = (ossim_uint32)vertices.size();
+   if ( (N < 3) || !(tolerance > 0.0) )
+   {
+      return;
+   }
+
+   const double TOLERANCE_SQUARED = tolerance*tolerance;
+   vector<bool> keep(N, false);
+   keep[0]     = true;
+   keep[N - 1] = true;
+
+   // Ranges (first, last) still to split, instead of recursing on long lines:
+   vector< std::pair<ossim_uint32, ossim_uint32> > ranges;
+   ranges.push_back(std::make_pair((ossim_uint32)0, N - 1));
+   while ( ranges.size() )
+   {
+      const ossim_uint32 FIRST = ranges.back().first;
+      const ossim_uint32 LAST  = ranges.back().second;
+      ranges.pop_back();
+
+      const ossimDpt& a = vertices[FIRST];
+      const double DX = vertices[LAST].x - a.x;
+      const double DY = vertices[LAST].y - a.y;
+      const double LENGTH_SQUARED = DX*DX + DY*DY;
+
+      double maxDistance = 0.0;
+      ossim_uint32 farthest = FIRST;
+      for (ossim_uint32 i = FIRST + 1; i < LAST; ++i)
+      {
+         const double PX = vertices[i].x - a.x;
+         const double PY = vertices[i].y - a.y;
+         double distance;
+         if ( LENGTH_SQUARED > 0.0 )
+         {
+            const double CROSS = PX*DY - PY*DX;
+            distance = CROSS*CROSS/LENGTH_SQUARED;
+         }
+         else
+         {
+            distance = PX*PX + PY*PY; // Ends coincide, e.g. a closed ring.
+         }
+         if ( distance > maxDistance )
+         {
+            maxDistance = distance;
+            farthest = i;
+         }
+      }
+
+      if ( maxDistance > TOLERANCE_SQUARED )
+      {
+         keep[farthest] = true;
+         if ( farthest - FIRST > 1 )
+         {
+            ranges.push_back(std::make_pair(FIRST, farthest));
+         }
+         if ( LAST - farthest > 1 )
+         {
+            ranges.push_back(std::make_pair(farthest, LAST));
+         }
+      }
+   }
+
+   ossim_uint32 kept = 0;
+   for (ossim_uint32 i = 0; i < N; ++i)
+   {
+      if ( keep[i] )
+      {
+         vertices[kept++] = vertices[i];
+      }
+   }
+   vertices.resize(kept);
+}
+
 bool ossimPolyLine::hasNans()const
 {
    int upper = (int)theVertexList.size();
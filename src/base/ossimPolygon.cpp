@@ -18,6 +18,7 @@
 #include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimPolyArea2d.h>
+#include <ossim/base/ossimPolyLine.h>
 #include <ossim/base/ossimString.h>
 #include <algorithm>
 #include <iterator>
@@ -194,6 +195,17 @@ void ossimPolygon::roundToIntegerBounds(bool compress)
    }
 }
 
+void ossimPolygon::simplify(double tolerance)
+{
+   vector<ossimDpt> vertices = theVertexList;
+   ossimPolyLine::simplify(vertices, tolerance);
+   if ( (vertices.size() >= 3) && (vertices.size() < theVertexList.size()) )
+   {
+      theVertexList.swap(vertices);
+      theCurrentVertex = 0;
+   }
+}
+
 ossimDpt ossimPolygon::midPoint()const
 {
    int upper = (int)theVertexList.size();
@@ -0,0 +1,234 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+//*******************************************************************
+
+#include <ossim/base/ossimPolygonRasterizer.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimPolygon.h>
+#include <algorithm>
+
+namespace
+{
+   /** Rows per band of the edge index. */
+   const ossim_int32 BAND_HEIGHT = 64;
+
+   /** Polygon and x of an edge crossing a row, sorted by polygon then x. */
+   typedef std::pair<ossim_uint32, ossim_int32> Crossing;
+}
+
+ossimPolygonRasterizer::ossimPolygonRasterizer()
+   : theEdges(),
+     theBands(),
+     theMinY(0),
+     theMaxY(-1)
+{
+}
+
+void ossimPolygonRasterizer::clear()
+{
+   theEdges.clear();
+   theBands.clear();
+   theMinY = 0;
+   theMaxY = -1;
+}
+
+ossim_int32 ossimPolygonRasterizer::getBand(ossim_int32 y) const
+{
+   return (y - theMinY)/BAND_HEIGHT;
+}
+
+void ossimPolygonRasterizer::setPolygons(const std::vector<ossimPolygon>& polygons)
+{
+   clear();
+
+   std::vector<ossimIpt> pts;
+   for (ossim_uint32 polyIndex = 0; polyIndex < polygons.size(); ++polyIndex)
+   {
+      const ossimPolygon& polygon = polygons[polyIndex];
+      const ossim_uint32 N = polygon.getVertexCount();
+      if ( N < 3 )
+      {
+         continue;
+      }
+
+      pts.resize(N);
+      ossim_int32 polygonMaxY = 0;
+      for (ossim_uint32 i = 0; i < N; ++i)
+      {
+         pts[i].x = ossim::round<ossim_int32>(polygon[i].x);
+         pts[i].y = ossim::round<ossim_int32>(polygon[i].y);
+         polygonMaxY = (i == 0) ? pts[i].y : ossim::max(polygonMaxY, pts[i].y);
+      }
+
+      for (ossim_uint32 i = 0; i < N; ++i)
+      {
+         const ossimIpt& p1 = pts[(i == 0) ? (N - 1) : (i - 1)];
+         const ossimIpt& p2 = pts[i];
+         if ( p1.y == p2.y )
+         {
+            continue; // Horizontal edges cross no row.
+         }
+         Edge edge;
+         const bool DOWN = (p1.y < p2.y);
+         edge.theTopY        = DOWN ? p1.y : p2.y;
+         edge.theTopX        = DOWN ? p1.x : p2.x;
+         edge.theBottomY     = DOWN ? p2.y : p1.y;
+         edge.theBottomX     = DOWN ? p2.x : p1.x;
+         edge.thePolygonMaxY = polygonMaxY;
+         edge.thePolygon     = polyIndex;
+         if ( theEdges.empty() )
+         {
+            theMinY = edge.theTopY;
+            theMaxY = edge.theBottomY;
+         }
+         else
+         {
+            theMinY = ossim::min(theMinY, edge.theTopY);
+            theMaxY = ossim::max(theMaxY, edge.theBottomY);
+         }
+         theEdges.push_back(edge);
+      }
+   }
+
+   if ( theEdges.size() )
+   {
+      theBands.resize(getBand(theMaxY) + 1);
+      for (ossim_uint32 i = 0; i < theEdges.size(); ++i)
+      {
+         const ossim_int32 LAST = getBand(theEdges[i].theBottomY);
+         for (ossim_int32 band = getBand(theEdges[i].theTopY); band <= LAST; ++band)
+         {
+            theBands[band].push_back(i);
+         }
+      }
+   }
+}
+
+void ossimPolygonRasterizer::getSpans(const ossimIrect& rect,
+                                      std::vector<SpanList>& spans) const
+{
+   const ossim_int32 ROWS = (ossim_int32)rect.height();
+   spans.resize(ROWS);
+   for (ossim_int32 row = 0; row < ROWS; ++row)
+   {
+      spans[row].clear();
+   }
+
+   const ossim_int32 MIN_X = rect.ul().x;
+   const ossim_int32 MAX_X = rect.lr().x;
+   const ossim_int32 START_Y = ossim::max(rect.ul().y, theMinY);
+   const ossim_int32 END_Y   = ossim::min(rect.lr().y, theMaxY);
+   if ( theEdges.empty() || (START_Y > END_Y) )
+   {
+      return;
+   }
+
+   //---
+   // Edges crossing the rows of rect, each taken from the first of its bands
+   // in range.  Edges right of rect are dropped: their crossings only end
+   // runs that rect clips anyway.
+   //---
+   std::vector<Edge> candidates;
+   const ossim_int32 FIRST_BAND = getBand(START_Y);
+   const ossim_int32 LAST_BAND  = getBand(END_Y);
+   for (ossim_int32 band = FIRST_BAND; band <= LAST_BAND; ++band)
+   {
+      const std::vector<ossim_uint32>& edges = theBands[band];
+      for (ossim_uint32 i = 0; i < edges.size(); ++i)
+      {
+         const Edge& edge = theEdges[edges[i]];
+         if ( ( (band == FIRST_BAND) || (getBand(edge.theTopY) == band) ) &&
+              (edge.theBottomY >= START_Y) && (edge.theTopY <= END_Y) &&
+              (ossim::min(edge.theTopX, edge.theBottomX) <= MAX_X) )
+         {
+            candidates.push_back(edge);
+         }
+      }
+   }
+   std::sort(candidates.begin(), candidates.end());
+
+   std::vector<Edge> active;
+   std::vector<Crossing> crossings;
+   SpanList rowSpans;
+   size_t next = 0;
+   for (ossim_int32 y = START_Y; y <= END_Y; ++y)
+   {
+      while ( (next < candidates.size()) && (candidates[next].theTopY <= y) )
+      {
+         active.push_back(candidates[next++]);
+      }
+
+      crossings.clear();
+      for (size_t i = 0; i < active.size(); )
+      {
+         const Edge& edge = active[i];
+         if ( edge.theBottomY < y )
+         {
+            active[i] = active.back();
+            active.pop_back();
+            continue;
+         }
+
+         //---
+         // Each vertex counts once: edges are half open, [top, bottom),
+         // except on the polygon's last row, which closes it.
+         //---
+         if ( (y < edge.theBottomY) ||
+              ( (y == edge.thePolygonMaxY) && (y > edge.theTopY) ) )
+         {
+            const ossim_int64 DX = edge.theBottomX - edge.theTopX;
+            const ossim_int64 DY = edge.theBottomY - edge.theTopY;
+            crossings.push_back(
+               Crossing(edge.thePolygon,
+                        (ossim_int32)((y - edge.theTopY)*DX/DY + edge.theTopX)));
+         }
+         ++i;
+      }
+      if ( crossings.empty() )
+      {
+         continue;
+      }
+      std::sort(crossings.begin(), crossings.end());
+
+      // Pairs of crossings of a polygon bound its runs, even-odd:
+      rowSpans.clear();
+      for (size_t i = 0; i < crossings.size(); )
+      {
+         ossim_int32 start = crossings[i].second;
+         ossim_int32 end   = MAX_X; // Closing crossing right of rect.
+         if ( (i + 1 < crossings.size()) &&
+              (crossings[i + 1].first == crossings[i].first) )
+         {
+            end = crossings[i + 1].second;
+            i += 2;
+         }
+         else
+         {
+            ++i;
+         }
+         start = ossim::max(start, MIN_X);
+         end   = ossim::min(end, MAX_X);
+         if ( start <= end )
+         {
+            rowSpans.push_back(Span(start, end));
+         }
+      }
+
+      // Union of the polygons' runs:
+      std::sort(rowSpans.begin(), rowSpans.end());
+      SpanList& result = spans[y - rect.ul().y];
+      for (size_t i = 0; i < rowSpans.size(); ++i)
+      {
+         if ( result.size() && (rowSpans[i].first <= result.back().second + 1) )
+         {
+            result.back().second = ossim::max(result.back().second, rowSpans[i].second);
+         }
+         else
+         {
+            result.push_back(rowSpans[i]);
+         }
+      }
+   }
+}
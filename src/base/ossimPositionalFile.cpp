@@ -0,0 +1,199 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: File read (or written) at explicit offsets, shareable between threads.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/base/ossimPositionalFile.h>
+#include <ossim/base/ossimTimeline.h>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <errno.h>
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+ossimPositionalFile::ossimPositionalFile()
+   :
+#if defined(_WIN32)
+   m_handle(0),
+#else
+   m_fd(-1),
+#endif
+   m_size(0)
+{
+}
+
+ossimPositionalFile::~ossimPositionalFile()
+{
+   close();
+}
+
+bool ossimPositionalFile::open(const ossimFilename& file)
+{
+   return open(file, false);
+}
+
+bool ossimPositionalFile::openForUpdate(const ossimFilename& file)
+{
+   return open(file, true);
+}
+
+bool ossimPositionalFile::open(const ossimFilename& file, bool update)
+{
+   close();
+
+#if defined(_WIN32)
+   // Writers share with the stream the file was created through.
+   HANDLE fileHandle = CreateFile(file.c_str(),
+                                  update ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+                                  update ? (FILE_SHARE_READ | FILE_SHARE_WRITE) : FILE_SHARE_READ,
+                                  0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+   if (fileHandle == INVALID_HANDLE_VALUE)
+   {
+      return false;
+   }
+   LARGE_INTEGER fileSize;
+   if ( !GetFileSizeEx(fileHandle, &fileSize) )
+   {
+      CloseHandle(fileHandle);
+      return false;
+   }
+   m_handle = fileHandle;
+   m_size   = static_cast<ossim_uint64>(fileSize.QuadPart);
+#else
+   int fd = ::open(file.c_str(), update ? O_RDWR : O_RDONLY);
+   if (fd < 0)
+   {
+      return false;
+   }
+   struct stat st;
+   if (fstat(fd, &st) != 0)
+   {
+      ::close(fd);
+      return false;
+   }
+   m_fd   = fd;
+   m_size = static_cast<ossim_uint64>(st.st_size);
+#endif
+   return true;
+}
+
+void ossimPositionalFile::close()
+{
+#if defined(_WIN32)
+   if (m_handle)
+   {
+      CloseHandle(static_cast<HANDLE>(m_handle));
+      m_handle = 0;
+   }
+#else
+   if (m_fd >= 0)
+   {
+      ::close(m_fd);
+      m_fd = -1;
+   }
+#endif
+   m_size = 0;
+}
+
+bool ossimPositionalFile::isOpen() const
+{
+#if defined(_WIN32)
+   return (m_handle != 0);
+#else
+   return (m_fd >= 0);
+#endif
+}
+
+bool ossimPositionalFile::read(ossim_uint64 offset, void* buf, ossim_uint32 bytes) const
+{
+   ossimTimeline::Span span("ossimPositionalFile::read", "io");
+   if ( !isOpen() || (offset + bytes > m_size) )
+   {
+      return false;
+   }
+   char* dest = static_cast<char*>(buf);
+   while (bytes)
+   {
+#if defined(_WIN32)
+      // The offset in the OVERLAPPED is used instead of the handle's file pointer.
+      OVERLAPPED overlapped;
+      ZeroMemory(&overlapped, sizeof(overlapped));
+      overlapped.Offset     = static_cast<DWORD>(offset & 0xffffffff);
+      overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+      DWORD count = 0;
+      if ( !ReadFile(static_cast<HANDLE>(m_handle), dest, bytes, &count, &overlapped) || !count )
+      {
+         return false;
+      }
+#else
+      ssize_t count = pread(m_fd, dest, bytes, static_cast<off_t>(offset));
+      if (count < 0)
+      {
+         if (errno == EINTR)
+         {
+            continue;
+         }
+         return false;
+      }
+      if (count == 0)
+      {
+         return false;
+      }
+#endif
+      dest   += count;
+      offset += count;
+      bytes  -= static_cast<ossim_uint32>(count);
+   }
+   return true;
+}
+
+bool ossimPositionalFile::write(ossim_uint64 offset, const void* buf, ossim_uint32 bytes) const
+{
+   ossimTimeline::Span span("ossimPositionalFile::write", "io");
+   if ( !isOpen() )
+   {
+      return false;
+   }
+   const char* src = static_cast<const char*>(buf);
+   while (bytes)
+   {
+#if defined(_WIN32)
+      OVERLAPPED overlapped;
+      ZeroMemory(&overlapped, sizeof(overlapped));
+      overlapped.Offset     = static_cast<DWORD>(offset & 0xffffffff);
+      overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+      DWORD count = 0;
+      if ( !WriteFile(static_cast<HANDLE>(m_handle), src, bytes, &count, &overlapped) || !count )
+      {
+         return false;
+      }
+#else
+      ssize_t count = pwrite(m_fd, src, bytes, static_cast<off_t>(offset));
+      if (count < 0)
+      {
+         if (errno == EINTR)
+         {
+            continue;
+         }
+         return false;
+      }
+      if (count == 0)
+      {
+         return false;
+      }
+#endif
+      src    += count;
+      offset += count;
+      bytes  -= static_cast<ossim_uint32>(count);
+   }
+   return true;
+}
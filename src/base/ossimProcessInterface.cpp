@@ -21,7 +21,11 @@ ossimProcessInterface::ossimProcessInterface()
    :thePercentComplete(0.0),
     theProcessStatus(PROCESS_STATUS_NOT_EXECUTING),
     theMessage(""),
-    theEventFlag(true)
+    theEventFlag(true),
+    theProgressPhase(),
+    theProgressTotalUnits(0),
+    theProgressPixelsPerUnit(0),
+    theProgressBytesPerUnit(0)
 {
 }
 
@@ -84,6 +88,7 @@ void ossimProcessInterface::setPercentComplete(double percentComplete)
                                       thePercentComplete,
                                       theMessage,
                                       false);
+      initializeProgressWork(event);
       manager->fireEvent(event);
    }
 }
@@ -114,10 +119,44 @@ void ossimProcessInterface::setCurrentMessage(const ossimString& message)
                                       thePercentComplete,
                                       theMessage,
                                       true);
+      initializeProgressWork(event);
       manager->fireEvent(event);
    }   
 }
 
+void ossimProcessInterface::setProgressWork(const ossimString& phase,
+                                            ossim_uint64 totalUnits,
+                                            ossim_uint64 pixelsPerUnit,
+                                            ossim_uint64 bytesPerUnit)
+{
+   theProgressPhase         = phase;
+   theProgressTotalUnits    = phase.empty() ? 0 : totalUnits;
+   theProgressPixelsPerUnit = pixelsPerUnit;
+   theProgressBytesPerUnit  = bytesPerUnit;
+}
+
+void ossimProcessInterface::initializeProgressWork(ossimProcessProgressEvent& event) const
+{
+   if ( theProgressTotalUnits )
+   {
+      double percent = thePercentComplete;
+      if ( percent < 0.0 )
+      {
+         percent = 0.0;
+      }
+      else if ( percent > 100.0 )
+      {
+         percent = 100.0;
+      }
+      const ossim_uint64 UNITS =
+         (ossim_uint64)(percent * 0.01 * (double)theProgressTotalUnits + 0.5);
+      event.setPhase(theProgressPhase);
+      event.setUnits(UNITS, theProgressTotalUnits);
+      event.setPixelsComplete(UNITS * theProgressPixelsPerUnit);
+      event.setBytesComplete(UNITS * theProgressBytesPerUnit);
+   }
+}
+
 std::ostream& ossimProcessInterface::print(std::ostream& out) const
 {
    out << "process status: ";
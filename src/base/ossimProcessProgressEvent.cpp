@@ -23,7 +23,12 @@ ossimProcessProgressEvent::ossimProcessProgressEvent(ossimObject* owner,
       ossimEvent(owner, OSSIM_EVENT_PROCESS_PROGRESS_ID),
       thePercentComplete(percentComplete),
       theMessage(message),
-      theOutputMessageFlag(outputMessageFlag)
+      theOutputMessageFlag(outputMessageFlag),
+      thePhase(),
+      theUnitsComplete(0),
+      theTotalUnits(0),
+      thePixelsComplete(0),
+      theBytesComplete(0)
 {
 }
 
@@ -66,3 +71,49 @@ bool ossimProcessProgressEvent::getOutputMessageFlag() const
 {
    return theOutputMessageFlag;
 }
+
+const ossimString& ossimProcessProgressEvent::getPhase() const
+{
+   return thePhase;
+}
+
+void ossimProcessProgressEvent::setPhase(const ossimString& phase)
+{
+   thePhase = phase;
+}
+
+ossim_uint64 ossimProcessProgressEvent::getUnitsComplete() const
+{
+   return theUnitsComplete;
+}
+
+ossim_uint64 ossimProcessProgressEvent::getTotalUnits() const
+{
+   return theTotalUnits;
+}
+
+void ossimProcessProgressEvent::setUnits(ossim_uint64 unitsComplete, ossim_uint64 totalUnits)
+{
+   theUnitsComplete = unitsComplete;
+   theTotalUnits    = totalUnits;
+}
+
+ossim_uint64 ossimProcessProgressEvent::getPixelsComplete() const
+{
+   return thePixelsComplete;
+}
+
+void ossimProcessProgressEvent::setPixelsComplete(ossim_uint64 pixels)
+{
+   thePixelsComplete = pixels;
+}
+
+ossim_uint64 ossimProcessProgressEvent::getBytesComplete() const
+{
+   return theBytesComplete;
+}
+
+void ossimProcessProgressEvent::setBytesComplete(ossim_uint64 bytes)
+{
+   theBytesComplete = bytes;
+}
@@ -10,17 +10,284 @@
 
 #include <ossim/base/ossimQuadTreeWarp.h>
 #include <algorithm>
+#include <cmath>
 #include <stack>
 #include <iostream>
 
 #include <ossim/base/ossimTrace.h>
 #include <ossim/base/ossimNotifyContext.h>
+#include <OpenThreads/ScopedLock>
 
 static ossimTrace traceExec  ("ossimQuadTreeWarp:exec");
 static ossimTrace traceDebug ("ossimQuadTreeWarp:debug");
 
 RTTI_DEF1(ossimQuadTreeWarp, "ossimQuadTreeWarp", ossim2dTo2dTransform);
 
+//---
+// Flattened leaves of an ossimQuadTreeWarp.  The leaves are kept in the
+// order findNode() visits them, and each grid cell lists the leaves that
+// touch it in that same order, so the first leaf of a cell holding a point
+// is the node findNode() returns.  Bounds are stored as the comparisons
+// ossimDrect::pointWithin() makes for the rect's orientation.
+//---
+class ossimQuadTreeWarpIndex
+{
+public:
+   struct Leaf
+   {
+      double minX;
+      double maxX;
+      double minY;
+      double maxY;
+
+      // Bilinear terms of ossimQuadTreeWarp::getShift(result, node, pt).
+      double ulX;
+      double ulY;
+      double width;  // ur.x - ul.x
+      double height; // ll.y - ul.y
+
+      const ossimQuadTreeWarpVertex* ul;
+      const ossimQuadTreeWarpVertex* ur;
+      const ossimQuadTreeWarpVertex* lr;
+      const ossimQuadTreeWarpVertex* ll;
+   };
+
+   ossimQuadTreeWarpIndex(const ossimQuadTreeWarpNode* root);
+
+   /**
+    * @return Index into theLeaves of the leaf findNode(pt) returns, or -1.
+    * hint is a leaf returned for a previous point; it is taken when pt is
+    * strictly inside it, where no other leaf can hold pt.
+    */
+   ossim_int32 findLeaf(const ossimDpt& pt, ossim_int32 hint=-1)const;
+
+   void getShift(ossimDpt& result, ossim_int32 leaf, const ossimDpt& pt)const;
+
+   std::vector<Leaf> theLeaves;
+
+private:
+   void addLeaves(const ossimQuadTreeWarpNode* node);
+   void setBounds(const ossimDrect& rect,
+                  double& minX, double& maxX,
+                  double& minY, double& maxY)const;
+   ossim_int32 cellX(double x)const;
+   ossim_int32 cellY(double y)const;
+
+   double theMinX;
+   double theMaxX;
+   double theMinY;
+   double theMaxY;
+   double theCellsPerX;
+   double theCellsPerY;
+   ossim_int32 theCellsX;
+   ossim_int32 theCellsY;
+
+   // Leaves of cell c are theCellLeaves[theCellStart[c]..theCellStart[c+1]).
+   std::vector<ossim_uint32> theCellStart;
+   std::vector<ossim_uint32> theCellLeaves;
+};
+
+ossimQuadTreeWarpIndex::ossimQuadTreeWarpIndex(const ossimQuadTreeWarpNode* root)
+   :theMinX(0.0),
+    theMaxX(0.0),
+    theMinY(0.0),
+    theMaxY(0.0),
+    theCellsPerX(0.0),
+    theCellsPerY(0.0),
+    theCellsX(1),
+    theCellsY(1)
+{
+   if(!root||root->theBoundingRect.hasNans())
+   {
+      return;
+   }
+   setBounds(root->theBoundingRect, theMinX, theMaxX, theMinY, theMaxY);
+   addLeaves(root);
+
+   // About four leaves per cell for a balanced tree.
+   ossim_int32 side = (ossim_int32)std::ceil(std::sqrt((double)theLeaves.size())*0.5)*2;
+   side = std::max(1, std::min(side, 512));
+   if(theMaxX > theMinX)
+   {
+      theCellsX    = side;
+      theCellsPerX = side/(theMaxX - theMinX);
+   }
+   if(theMaxY > theMinY)
+   {
+      theCellsY    = side;
+      theCellsPerY = side/(theMaxY - theMinY);
+   }
+
+   const ossim_uint32 CELLS = theCellsX*theCellsY;
+   std::vector<ossim_uint32> counts(CELLS+1, 0);
+   ossim_uint32 i;
+   ossim_int32 x;
+   ossim_int32 y;
+   for(i = 0; i < theLeaves.size(); ++i)
+   {
+      const Leaf& leaf = theLeaves[i];
+      if(leaf.minX <= leaf.maxX && leaf.minY <= leaf.maxY) // false for nans
+      {
+         for(y = cellY(leaf.minY); y <= cellY(leaf.maxY); ++y)
+         {
+            for(x = cellX(leaf.minX); x <= cellX(leaf.maxX); ++x)
+            {
+               ++counts[y*theCellsX + x + 1];
+            }
+         }
+      }
+   }
+   for(i = 1; i <= CELLS; ++i)
+   {
+      counts[i] += counts[i-1];
+   }
+   theCellStart = counts;
+   theCellLeaves.resize(counts[CELLS]);
+   for(i = 0; i < theLeaves.size(); ++i)
+   {
+      const Leaf& leaf = theLeaves[i];
+      if(leaf.minX <= leaf.maxX && leaf.minY <= leaf.maxY)
+      {
+         for(y = cellY(leaf.minY); y <= cellY(leaf.maxY); ++y)
+         {
+            for(x = cellX(leaf.minX); x <= cellX(leaf.maxX); ++x)
+            {
+               theCellLeaves[counts[y*theCellsX + x]++] = i;
+            }
+         }
+      }
+   }
+}
+
+void ossimQuadTreeWarpIndex::addLeaves(const ossimQuadTreeWarpNode* node)
+{
+   if(!node->isLeaf())
+   {
+      for(ossim_uint32 i = 0; i < node->theChildren.size(); ++i)
+      {
+         addLeaves(node->theChildren[i]);
+      }
+      return;
+   }
+
+   Leaf leaf;
+   setBounds(node->theBoundingRect, leaf.minX, leaf.maxX, leaf.minY, leaf.maxY);
+   leaf.ulX    = node->theBoundingRect.ul().x;
+   leaf.ulY    = node->theBoundingRect.ul().y;
+   leaf.width  = node->theBoundingRect.ur().x - leaf.ulX;
+   leaf.height = node->theBoundingRect.ll().y - leaf.ulY;
+   if(node->hasValidVertices())
+   {
+      leaf.ul = node->theUlVertex;
+      leaf.ur = node->theUrVertex;
+      leaf.lr = node->theLrVertex;
+      leaf.ll = node->theLlVertex;
+   }
+   else
+   {
+      leaf.ul = leaf.ur = leaf.lr = leaf.ll = 0;
+   }
+   theLeaves.push_back(leaf);
+}
+
+void ossimQuadTreeWarpIndex::setBounds(const ossimDrect& rect,
+                                       double& minX, double& maxX,
+                                       double& minY, double& maxY)const
+{
+   minX = rect.ul().x;
+   maxX = rect.ur().x;
+   if(rect.orientationMode() == OSSIM_LEFT_HANDED)
+   {
+      minY = rect.ul().y;
+      maxY = rect.ll().y;
+   }
+   else
+   {
+      minY = rect.ll().y;
+      maxY = rect.ul().y;
+   }
+}
+
+inline ossim_int32 ossimQuadTreeWarpIndex::cellX(double x)const
+{
+   // Monotonic in x, so a point of a leaf falls in one of the leaf's cells.
+   ossim_int32 c = (ossim_int32)((x - theMinX)*theCellsPerX);
+   return (c < 0) ? 0 : ((c >= theCellsX) ? theCellsX-1 : c);
+}
+
+inline ossim_int32 ossimQuadTreeWarpIndex::cellY(double y)const
+{
+   ossim_int32 c = (ossim_int32)((y - theMinY)*theCellsPerY);
+   return (c < 0) ? 0 : ((c >= theCellsY) ? theCellsY-1 : c);
+}
+
+ossim_int32 ossimQuadTreeWarpIndex::findLeaf(const ossimDpt& pt, ossim_int32 hint)const
+{
+   // Same root test as findNode(pt); also rejects nans.
+   if(theLeaves.empty()||
+      !((pt.x >= theMinX) && (pt.x <= theMaxX) &&
+        (pt.y >= theMinY) && (pt.y <= theMaxY)))
+   {
+      return -1;
+   }
+
+   if(hint >= 0)
+   {
+      const Leaf& leaf = theLeaves[hint];
+      if((pt.x > leaf.minX) && (pt.x < leaf.maxX) &&
+         (pt.y > leaf.minY) && (pt.y < leaf.maxY))
+      {
+         return hint;
+      }
+   }
+
+   const ossim_uint32 CELL = cellY(pt.y)*theCellsX + cellX(pt.x);
+   for(ossim_uint32 i = theCellStart[CELL]; i < theCellStart[CELL+1]; ++i)
+   {
+      const Leaf& leaf = theLeaves[theCellLeaves[i]];
+      if((pt.x >= leaf.minX) && (pt.x <= leaf.maxX) &&
+         (pt.y >= leaf.minY) && (pt.y <= leaf.maxY))
+      {
+         return (ossim_int32)theCellLeaves[i];
+      }
+   }
+   return -1;
+}
+
+inline void ossimQuadTreeWarpIndex::getShift(ossimDpt& result,
+                                             ossim_int32 leafIndex,
+                                             const ossimDpt& pt)const
+{
+   result.x = 0.0;
+   result.y = 0.0;
+
+   if(leafIndex < 0)
+   {
+      return;
+   }
+
+   const Leaf& leaf = theLeaves[leafIndex];
+   if(leaf.ul)
+   {
+      const ossimDpt& ulShift = leaf.ul->getDelta();
+      const ossimDpt& urShift = leaf.ur->getDelta();
+      const ossimDpt& lrShift = leaf.lr->getDelta();
+      const ossimDpt& llShift = leaf.ll->getDelta();
+
+      double horizontalPercent = fabs((pt.x-leaf.ulX))/leaf.width;
+      double verticalPercent   = fabs((pt.y-leaf.ulY))/leaf.height;
+
+      ossimDpt upper = ulShift + (urShift - ulShift)*horizontalPercent;
+      ossimDpt lower = llShift + (lrShift - llShift)*horizontalPercent;
+
+      result = upper + (lower - upper)*verticalPercent;
+   }
+   else
+   {
+      ossimNotify(ossimNotifyLevel_WARN) << "WARNING: ossimQuadTreeWarp::getShift, " << "Node does not have valid vertices in ossimQuadTreeWarp::getShift\n";
+   }
+}
+
 ossimQuadTreeWarpVertex::ossimQuadTreeWarpVertex(
    const ossimDpt& position, const ossimDpt& delta)
    :thePosition(position),
@@ -303,7 +570,10 @@ bool ossimQuadTreeWarpNode::loadState(const ossimKeywordlist& kwl,
 
 
 ossimQuadTreeWarp::ossimQuadTreeWarp()
-   :theTree(NULL)
+   :theWarpEnabledFlag(true),
+    theTree(NULL),
+    theIndex(NULL),
+    theIndexValidFlag(0)
 {
 }
 
@@ -312,7 +582,10 @@ ossimQuadTreeWarp::ossimQuadTreeWarp(const ossimDrect& boundingRect,
                                      const ossimDpt& urShift,
                                      const ossimDpt& lrShift,
                                      const ossimDpt& llShift)
-   :theTree(NULL)
+   :theWarpEnabledFlag(true),
+    theTree(NULL),
+    theIndex(NULL),
+    theIndexValidFlag(0)
 {
    create(boundingRect, ulShift, urShift, lrShift, llShift);
 }
@@ -320,7 +593,9 @@ ossimQuadTreeWarp::ossimQuadTreeWarp(const ossimDrect& boundingRect,
 ossimQuadTreeWarp::ossimQuadTreeWarp(const ossimQuadTreeWarp& rhs)
    :ossim2dTo2dTransform(),
     theWarpEnabledFlag(true),
-    theTree(NULL)
+    theTree(NULL),
+    theIndex(NULL),
+    theIndexValidFlag(0)
 {
    ossimKeywordlist kwl;
    
@@ -543,6 +818,8 @@ ossimQuadTreeWarpVertex* ossimQuadTreeWarp::getVertex(const ossimDpt& position)
 
 void ossimQuadTreeWarp::clear()
 {
+   invalidateIndex();
+
    if(theTree)
    {     
       recursiveDelete(theTree);
@@ -588,12 +865,65 @@ void ossimQuadTreeWarp::forward(ossimDpt& pt)const
    }
 }
 
+void ossimQuadTreeWarp::forwardPoints(const ossimDpt* input,
+                                      ossimDpt* output,
+                                      ossim_uint32 count)const
+{
+   if(!theWarpEnabledFlag)
+   {
+      if(output != input)
+      {
+         std::copy(input, input+count, output);
+      }
+      return;
+   }
+
+   const ossimQuadTreeWarpIndex* index = getIndex();
+   ossim_int32 leaf = -1;
+   ossimDpt shift;
+   for(ossim_uint32 i = 0; i < count; ++i)
+   {
+      // Neighbouring points are mostly in the same leaf.
+      ossim_int32 found = index->findLeaf(input[i], leaf);
+      index->getShift(shift, found, input[i]);
+      if(found >= 0)
+      {
+         leaf = found;
+      }
+      output[i] = input[i] + shift;
+   }
+}
+
 void ossimQuadTreeWarp::getShift(ossimDpt& result,
                                  const ossimDpt& pt)const
 {
-   getShift(result,
-            findNode(pt),
-            pt);
+   const ossimQuadTreeWarpIndex* index = getIndex();
+   index->getShift(result,
+                   index->findLeaf(pt),
+                   pt);
+}
+
+const ossimQuadTreeWarpIndex* ossimQuadTreeWarp::getIndex()const
+{
+   if(!theIndexValidFlag)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theIndexMutex);
+      if(!theIndexValidFlag)
+      {
+         delete theIndex;
+         theIndex = new ossimQuadTreeWarpIndex(theTree);
+         theIndexValidFlag.exchange(1);
+      }
+   }
+   return theIndex;
+}
+
+void ossimQuadTreeWarp::invalidateIndex()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theIndexMutex);
+   theIndexValidFlag.exchange(0);
+   delete theIndex;
+   theIndex = NULL;
 }
 
 void ossimQuadTreeWarp::split(const ossimDpt& point,
@@ -715,6 +1045,8 @@ void ossimQuadTreeWarp::split(ossimQuadTreeWarpNode* node,
             node->removeVertex(node->theUrVertex);
             node->removeVertex(node->theLrVertex);
             node->removeVertex(node->theLlVertex);
+
+            invalidateIndex();
          }         
       }
    }
@@ -912,6 +1244,7 @@ void ossimQuadTreeWarp::pruneTree(ossimQuadTreeWarpNode* node)
       ossimQuadTreeWarpVertex* llV = getVertex(node->theBoundingRect.ll());
       
       recursivePruneTree(node);
+      invalidateIndex();
 
       if(ulV&&urV&&lrV&&llV)
       {
@@ -0,0 +1,69 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Asks the operating system to start reading parts of a file into its page cache
+// ahead of demand (posix_fadvise WILLNEED where available).
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/base/ossimReadAhead.h>
+#include <ossim/base/ossimFilename.h>
+
+#if !defined(_WIN32)
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+ossimReadAhead::ossimReadAhead()
+   : m_fd(-1)
+{
+}
+
+ossimReadAhead::~ossimReadAhead()
+{
+   close();
+}
+
+bool ossimReadAhead::open(const ossimFilename& file)
+{
+   close();
+#if defined(POSIX_FADV_WILLNEED) || defined(F_RDADVISE)
+   m_fd = ::open(file.c_str(), O_RDONLY);
+#endif
+   return (m_fd >= 0);
+}
+
+void ossimReadAhead::close()
+{
+#if !defined(_WIN32)
+   if ( m_fd >= 0 )
+   {
+      ::close(m_fd);
+   }
+#endif
+   m_fd = -1;
+}
+
+bool ossimReadAhead::isOpen() const
+{
+   return (m_fd >= 0);
+}
+
+void ossimReadAhead::willNeed(ossim_uint64 offset, ossim_uint64 length)
+{
+   if ( (m_fd >= 0) && length )
+   {
+#if defined(POSIX_FADV_WILLNEED)
+      posix_fadvise(m_fd, (off_t)offset, (off_t)length, POSIX_FADV_WILLNEED);
+#elif defined(F_RDADVISE)
+      // Darwin:
+      struct radvisory ra;
+      ra.ra_offset = (off_t)offset;
+      ra.ra_count  = (int)( (length < 0x7fffffff) ? length : 0x7fffffff );
+      fcntl(m_fd, F_RDADVISE, &ra);
+#endif
+   }
+}
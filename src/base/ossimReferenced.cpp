@@ -5,15 +5,10 @@
 
 ossimReferenced::~ossimReferenced()
 {
-   if(theRefMutex)
-   {
-      delete theRefMutex;
-      theRefMutex = 0;
-   }
-   if (theRefCount>0)
+   if (referenceCount()>0)
    {
       ossimNotify(ossimNotifyLevel_WARN)<<"Warning: deleting still referenced object "<<this<<std::endl;
-      ossimNotify(ossimNotifyLevel_WARN)<<"         the final reference count was "<<theRefCount
+      ossimNotify(ossimNotifyLevel_WARN)<<"         the final reference count was "<<referenceCount()
                                         <<", memory corruption possible."<<std::endl;
    }
 }
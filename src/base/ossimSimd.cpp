@@ -0,0 +1,84 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Runtime detection of the vector instruction sets available to the SIMD kernels.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/base/ossimSimd.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+
+static int simdLevelOverride = -1;
+
+static ossim::SimdLevel detectSimdLevel()
+{
+   ossim::SimdLevel result = ossim::SIMD_SCALAR;
+#if OSSIM_SIMD_X86
+   __builtin_cpu_init();
+   if ( __builtin_cpu_supports("sse2") )
+   {
+      result = ossim::SIMD_SSE2;
+      if ( __builtin_cpu_supports("ssse3") )
+      {
+         result = ossim::SIMD_SSSE3;
+         if ( __builtin_cpu_supports("avx2") )
+         {
+            result = ossim::SIMD_AVX2;
+         }
+      }
+   }
+#endif
+   return result;
+}
+
+ossim::SimdLevel ossim::getCpuSimdLevel()
+{
+   static const ossim::SimdLevel LEVEL = detectSimdLevel();
+   return LEVEL;
+}
+
+ossim::SimdLevel ossim::getSimdLevel()
+{
+   if ( simdLevelOverride < 0 )
+   {
+      ossim::SimdLevel level = getCpuSimdLevel();
+      const char* lookup = ossimPreferences::instance()->findPreference("simd_level");
+      if ( lookup )
+      {
+         ossimString s = ossimString(lookup).downcase().trim();
+         ossim::SimdLevel requested = level;
+         if ( s == "scalar" )     requested = ossim::SIMD_SCALAR;
+         else if ( s == "sse2" )  requested = ossim::SIMD_SSE2;
+         else if ( s == "ssse3" ) requested = ossim::SIMD_SSSE3;
+         else if ( s == "avx2" )  requested = ossim::SIMD_AVX2;
+         if ( requested < level )
+         {
+            level = requested;
+         }
+      }
+      simdLevelOverride = (int)level;
+   }
+   return (ossim::SimdLevel)simdLevelOverride;
+}
+
+void ossim::setSimdLevel(ossim::SimdLevel level)
+{
+   ossim::SimdLevel cpuLevel = getCpuSimdLevel();
+   simdLevelOverride = (int)( (level < cpuLevel) ? level : cpuLevel );
+}
+
+const char* ossim::simdLevelString(ossim::SimdLevel level)
+{
+   switch (level)
+   {
+      case ossim::SIMD_SSE2:  return "sse2";
+      case ossim::SIMD_SSSE3: return "ssse3";
+      case ossim::SIMD_AVX2:  return "avx2";
+      case ossim::SIMD_SCALAR:
+      default:                return "scalar";
+   }
+}
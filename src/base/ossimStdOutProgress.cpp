@@ -11,41 +11,298 @@
 // $Id: ossimStdOutProgress.cpp 9094 2006-06-13 19:12:40Z dburken $
 
 #include <iomanip>
+#include <sstream>
 #include <ossim/base/ossimStdOutProgress.h>
+#include <ossim/base/ossimPreferences.h>
+#include <OpenThreads/ScopedLock>
 
 RTTI_DEF1(ossimStdOutProgress, "ossimStdOutProgress", ossimProcessListener);
 
 ossimStdOutProgress theStdOutProgress;
 
+namespace
+{
+   // Smoothing of the rate, and the least seconds between its samples.
+   const double RATE_ALPHA          = 0.3;
+   const double RATE_SAMPLE_SECONDS = 0.5;
+   const double BYTES_PER_MB        = 1024.0 * 1024.0;
+
+   void writeJsonString(std::ostream& out, const std::string& s)
+   {
+      out << '"';
+      for (std::string::size_type i = 0; i < s.size(); ++i)
+      {
+         const unsigned char c = (unsigned char)s[i];
+         if ( (c == '"') || (c == '\\') )
+         {
+            out << '\\' << (char)c;
+         }
+         else if ( c < 0x20 )
+         {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c
+                << std::dec << std::setfill(' ');
+         }
+         else
+         {
+            out << (char)c;
+         }
+      }
+      out << '"';
+   }
+
+   // h:mm:ss
+   void writeDuration(std::ostream& out, double seconds)
+   {
+      ossim_uint64 s = (ossim_uint64)(seconds + 0.5);
+      out << s / 3600 << ":" << std::setfill('0')
+          << std::setw(2) << (s / 60) % 60 << ":"
+          << std::setw(2) << s % 60 << std::setfill(' ');
+   }
+}
+
+ossimStdOutProgress::PhaseTotals::PhaseTotals()
+   : theSeconds(0.0),
+     theUnits(0),
+     thePixels(0),
+     theBytes(0)
+{
+}
+
 ossimStdOutProgress::ossimStdOutProgress(ossim_uint32 precision,
                                          bool flushStream)
    :
       ossimProcessListener(),
       thePrecision(precision),
-      theFlushStreamFlag(flushStream)
+      theFlushStreamFlag(flushStream),
+      theOutputFormat(TEXT),
+      theOutputFormatSetFlag(false),
+      theJsonInterval(1.0),
+      theMutex(),
+      thePhase(),
+      theTotalUnits(0),
+      theLastUnits(0),
+      thePhaseDoneFlag(false),
+      thePhaseStart(0),
+      theSampleTick(0),
+      theSampleUnits(0),
+      theUnitsPerSecond(0.0),
+      theLastJsonTick(0),
+      thePhaseTotals()
 {
 }
 
 void ossimStdOutProgress::processProgressEvent(ossimProcessProgressEvent& event)
 {
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+
+   if ( !theOutputFormatSetFlag )
+   {
+      // theStdOutProgress is built before the preferences are loaded.
+      initializeOutputFormat();
+   }
+
    if (event.getOutputMessageFlag())
    {
       ossimString s;
       event.getMessage(s);
       if (!s.empty())
       {
-		  ossimNotify(ossimNotifyLevel_NOTICE) << s.c_str() << std::endl;
+         if ( theOutputFormat == JSON_LINES )
+         {
+            std::ostringstream out;
+            out << "{\"message\":";
+            writeJsonString(out, s.string());
+            out << "}";
+            ossimNotify(ossimNotifyLevel_NOTICE) << out.str() << std::endl;
+         }
+         else
+         {
+            ossimNotify(ossimNotifyLevel_NOTICE) << s.c_str() << std::endl;
+         }
       }
       return; // Don't output percentage on a message update.
    }
 
-   
+   const ossimTimer::Timer_t NOW = ossimTimer::instance()->tick();
+   const bool NEW_PHASE = updateRate(event, NOW);
+
+   if ( theOutputFormat == JSON_LINES )
+   {
+      writeJson(event, NOW, NEW_PHASE);
+   }
+   else
+   {
+      writeText(event);
+   }
+
+   if ( event.getTotalUnits() && !thePhaseDoneFlag &&
+        (event.getUnitsComplete() >= event.getTotalUnits()) )
+   {
+      endPhase(event, NOW);
+   }
+}
+
+void ossimStdOutProgress::setFlushStreamFlag(bool flag)
+{
+   theFlushStreamFlag = flag;
+}
+
+void ossimStdOutProgress::setOutputFormat(OutputFormat format)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+   theOutputFormat = format;
+   theOutputFormatSetFlag = true;
+}
+
+ossimStdOutProgress::OutputFormat ossimStdOutProgress::getOutputFormat() const
+{
+   return theOutputFormat;
+}
+
+void ossimStdOutProgress::printPhaseBreakdown(std::ostream& out) const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+   std::map<std::string, PhaseTotals>::const_iterator i = thePhaseTotals.begin();
+   while ( i != thePhaseTotals.end() )
+   {
+      const PhaseTotals& t = i->second;
+      out << i->first << ": seconds=" << std::fixed << std::setprecision(3) << t.theSeconds
+          << " tiles=" << t.theUnits
+          << " pixels=" << t.thePixels
+          << " bytes=" << t.theBytes << "\n";
+      ++i;
+   }
+}
+
+void ossimStdOutProgress::initializeOutputFormat()
+{
+   ossimPreferences* prefs = ossimPreferences::instance();
+   const char* lookup = prefs->findPreference("progress.format");
+   if ( lookup )
+   {
+      theOutputFormat = ossimString(lookup).downcase().contains("json") ? JSON_LINES : TEXT;
+   }
+   lookup = prefs->findPreference("progress.json_interval");
+   if ( lookup )
+   {
+      theJsonInterval = ossimString(lookup).toDouble();
+   }
+   theOutputFormatSetFlag = true;
+}
+
+bool ossimStdOutProgress::updateRate(const ossimProcessProgressEvent& event,
+                                     ossimTimer::Timer_t now)
+{
+   if ( !event.getTotalUnits() )
+   {
+      return false;
+   }
+
+   const ossim_uint64 UNITS = event.getUnitsComplete();
+   const bool NEW_PHASE = ( (event.getPhase().string() != thePhase) ||
+                            (event.getTotalUnits() != theTotalUnits) ||
+                            (UNITS < theLastUnits) );
+   if ( NEW_PHASE )
+   {
+      thePhase          = event.getPhase().string();
+      theTotalUnits     = event.getTotalUnits();
+      thePhaseDoneFlag  = false;
+      thePhaseStart     = now;
+      theSampleTick     = now;
+      theSampleUnits    = UNITS;
+      theUnitsPerSecond = 0.0;
+   }
+   else
+   {
+      const double SECONDS = ossimTimer::instance()->delta_s(theSampleTick, now);
+      if ( (SECONDS >= RATE_SAMPLE_SECONDS) && (UNITS > theSampleUnits) )
+      {
+         const double RATE = (UNITS - theSampleUnits) / SECONDS;
+         theUnitsPerSecond = (theUnitsPerSecond > 0.0) ?
+            RATE_ALPHA * RATE + (1.0 - RATE_ALPHA) * theUnitsPerSecond : RATE;
+         theSampleTick  = now;
+         theSampleUnits = UNITS;
+      }
+   }
+   theLastUnits = UNITS;
+   return NEW_PHASE;
+}
+
+void ossimStdOutProgress::endPhase(const ossimProcessProgressEvent& event,
+                                   ossimTimer::Timer_t now)
+{
+   thePhaseDoneFlag = true;
+
+   const double SECONDS = ossimTimer::instance()->delta_s(thePhaseStart, now);
+   PhaseTotals& totals = thePhaseTotals[thePhase];
+   totals.theSeconds += SECONDS;
+   totals.theUnits   += event.getUnitsComplete();
+   totals.thePixels  += event.getPixelsComplete();
+   totals.theBytes   += event.getBytesComplete();
+
+   const double PER_SECOND = (SECONDS > 0.0) ? 1.0 / SECONDS : 0.0;
+   std::ostringstream out;
+   out << std::fixed << std::setprecision(1);
+   if ( theOutputFormat == JSON_LINES )
+   {
+      out << "{\"phase\":";
+      writeJsonString(out, thePhase);
+      out << ",\"done\":true,\"tiles\":" << event.getUnitsComplete()
+          << ",\"elapsed_seconds\":" << SECONDS
+          << ",\"tiles_per_second\":" << event.getUnitsComplete() * PER_SECOND
+          << ",\"megapixels_per_second\":"
+          << event.getPixelsComplete() * PER_SECOND * 1.0e-6;
+      if ( event.getBytesComplete() )
+      {
+         out << ",\"mb_per_second\":"
+             << event.getBytesComplete() * PER_SECOND / BYTES_PER_MB;
+      }
+      out << "}";
+   }
+   else
+   {
+      out << thePhase << ": " << event.getUnitsComplete() << " tiles in ";
+      writeDuration(out, SECONDS);
+      out << ", " << event.getUnitsComplete() * PER_SECOND << " tiles/s, "
+          << event.getPixelsComplete() * PER_SECOND * 1.0e-6 << " Mpix/s";
+      if ( event.getBytesComplete() )
+      {
+         out << ", " << event.getBytesComplete() * PER_SECOND / BYTES_PER_MB << " MB/s";
+      }
+   }
+   ossimNotify(ossimNotifyLevel_NOTICE) << out.str() << std::endl;
+}
+
+void ossimStdOutProgress::writeText(const ossimProcessProgressEvent& event)
+{
    double p = event.getPercentComplete();
+
+   std::ostringstream work;
+   if ( event.getTotalUnits() && (event.getUnitsComplete() < event.getTotalUnits()) &&
+        (theUnitsPerSecond > 0.0) )
+   {
+      const double PIXELS_PER_UNIT = event.getUnitsComplete() ?
+         (double)event.getPixelsComplete() / event.getUnitsComplete() : 0.0;
+      const double BYTES_PER_UNIT = event.getUnitsComplete() ?
+         (double)event.getBytesComplete() / event.getUnitsComplete() : 0.0;
+      work << std::fixed << std::setprecision(1)
+           << " " << theUnitsPerSecond << " tiles/s "
+           << theUnitsPerSecond * PIXELS_PER_UNIT * 1.0e-6 << " Mpix/s";
+      if ( BYTES_PER_UNIT > 0.0 )
+      {
+         work << " " << theUnitsPerSecond * BYTES_PER_UNIT / BYTES_PER_MB << " MB/s";
+      }
+      work << " ETA ";
+      writeDuration(work, (event.getTotalUnits() - event.getUnitsComplete()) /
+                    theUnitsPerSecond);
+      work << " [" << thePhase << "]   ";
+   }
+
    ossimNotify(ossimNotifyLevel_NOTICE)
 	   << std::setiosflags(std::ios::fixed)
       << std::setprecision(thePrecision)
-      << p << "%\r";
-   
+      << p << "%" << work.str() << "\r";
+
    if(theFlushStreamFlag)
    {
       (p != 100.0) ?
@@ -54,8 +311,55 @@ void ossimStdOutProgress::processProgressEvent(ossimProcessProgressEvent& event)
    }
 }
 
-void ossimStdOutProgress::setFlushStreamFlag(bool flag)
+void ossimStdOutProgress::writeJson(const ossimProcessProgressEvent& event,
+                                    ossimTimer::Timer_t now,
+                                    bool newPhaseFlag)
 {
-   theFlushStreamFlag = flag;
-}
+   const double p = event.getPercentComplete();
+   if ( !newPhaseFlag && (p < 100.0) && theLastJsonTick &&
+        (ossimTimer::instance()->delta_s(theLastJsonTick, now) < theJsonInterval) )
+   {
+      return;
+   }
+   if ( thePhaseDoneFlag )
+   {
+      return; // Duplicate of the last event of the phase.
+   }
+   theLastJsonTick = now;
 
+   std::ostringstream out;
+   out << std::fixed << std::setprecision(1) << "{";
+   if ( event.getTotalUnits() )
+   {
+      out << "\"phase\":";
+      writeJsonString(out, thePhase);
+      out << ",";
+   }
+   out << "\"percent\":" << p;
+   if ( event.getTotalUnits() )
+   {
+      out << ",\"tiles\":" << event.getUnitsComplete()
+          << ",\"total_tiles\":" << event.getTotalUnits()
+          << ",\"elapsed_seconds\":"
+          << ossimTimer::instance()->delta_s(thePhaseStart, now);
+      if ( theUnitsPerSecond > 0.0 )
+      {
+         const double PIXELS_PER_UNIT = event.getUnitsComplete() ?
+            (double)event.getPixelsComplete() / event.getUnitsComplete() : 0.0;
+         const double BYTES_PER_UNIT = event.getUnitsComplete() ?
+            (double)event.getBytesComplete() / event.getUnitsComplete() : 0.0;
+         out << ",\"tiles_per_second\":" << theUnitsPerSecond
+             << ",\"megapixels_per_second\":"
+             << theUnitsPerSecond * PIXELS_PER_UNIT * 1.0e-6;
+         if ( BYTES_PER_UNIT > 0.0 )
+         {
+            out << ",\"mb_per_second\":"
+                << theUnitsPerSecond * BYTES_PER_UNIT / BYTES_PER_MB;
+         }
+         out << ",\"eta_seconds\":"
+             << (event.getTotalUnits() - event.getUnitsComplete()) / theUnitsPerSecond;
+      }
+   }
+   out << "}";
+   ossimNotify(ossimNotifyLevel_NOTICE) << out.str() << std::endl;
+}
@@ -79,7 +79,21 @@ ossimRefPtr<ossimIFStream> ossimStreamFactory::createNewIFStream(
    if((buf[0] == 0x1F) &&
       (buf[1] == 0x8B))
    {
-      result = new ossimIgzStream(copyFile.c_str(), openMode);
+      // Block gzip files get the indexed, seekable stream.
+      if ( ossimGzBlockStreamBuf::isBlockGzip(copyFile.c_str()) )
+      {
+         ossimIgzBlockStream* blockStream =
+            new ossimIgzBlockStream(copyFile.c_str(), openMode);
+         result = blockStream;
+         if ( !blockStream->is_open() )
+         {
+            result = 0;
+         }
+      }
+      if ( !result.valid() )
+      {
+         result = new ossimIgzStream(copyFile.c_str(), openMode);
+      }
    }
 #endif
    return result;
@@ -9,6 +9,7 @@
 //
 #include <ossim/base/ossimStreamFactoryRegistry.h>
 #include <ossim/base/ossimStreamFactory.h>
+#include <ossim/base/ossimHttpRangeStream.h>
 #include <ossim/base/ossimIoStream.h>
 #include <ossim/base/ossimFilename.h>
 
@@ -31,6 +32,7 @@ ossimStreamFactoryRegistry* ossimStreamFactoryRegistry::instance()
    {
       theInstance = new ossimStreamFactoryRegistry();
       theInstance->registerFactory(ossimStreamFactory::instance());
+      theInstance->registerFactory(ossimHttpRangeStreamFactory::instance());
    }
 
    return theInstance;
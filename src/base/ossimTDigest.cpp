@@ -0,0 +1,175 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+//*******************************************************************
+
+#include <ossim/base/ossimTDigest.h>
+#include <ossim/base/ossimCommon.h>
+#include <algorithm>
+#include <cmath>
+
+ossimTDigest::ossimTDigest(ossim_float64 compression)
+   : theCompression(ossim::max(compression, 10.0)),
+     theTotalWeight(0.0),
+     theMin(ossim::nan()),
+     theMax(ossim::nan()),
+     theCentroids(),
+     theBuffer()
+{
+}
+
+void ossimTDigest::add(ossim_float64 value, ossim_float64 weight)
+{
+   if ( ossim::isnan(value) || !(weight > 0.0) )
+   {
+      return;
+   }
+   if ( theTotalWeight == 0.0 )
+   {
+      theMin = value;
+      theMax = value;
+   }
+   else if ( value < theMin )
+   {
+      theMin = value;
+   }
+   else if ( value > theMax )
+   {
+      theMax = value;
+   }
+   theTotalWeight += weight;
+   theBuffer.push_back(Centroid(value, weight));
+   if ( theBuffer.size() >= (size_t)(10.0*theCompression) )
+   {
+      compress();
+   }
+}
+
+void ossimTDigest::merge(const ossimTDigest& digest)
+{
+   digest.compress();
+   for (size_t i = 0; i < digest.theCentroids.size(); ++i)
+   {
+      add(digest.theCentroids[i].theMean, digest.theCentroids[i].theWeight);
+   }
+   if ( digest.theTotalWeight > 0.0 )
+   {
+      // The centroid means are within the extremes, which are kept exact:
+      theMin = ossim::min(theMin, digest.theMin);
+      theMax = ossim::max(theMax, digest.theMax);
+   }
+}
+
+void ossimTDigest::compress() const
+{
+   if ( theBuffer.empty() )
+   {
+      return;
+   }
+   theBuffer.insert(theBuffer.end(), theCentroids.begin(), theCentroids.end());
+   std::sort(theBuffer.begin(), theBuffer.end());
+   theCentroids.clear();
+
+   //---
+   // Merges neighbors while the centroid stays within one unit of the scale
+   // function k(q) = compression/(2 pi) * asin(2q - 1), small at the tails.
+   //---
+   const ossim_float64 scale = theCompression/TWO_PI;
+   Centroid current = theBuffer[0];
+   ossim_float64 weightSoFar = 0.0;
+   ossim_float64 qLimit =
+      (std::sin((scale*std::asin(-1.0) + 1.0)/scale) + 1.0)/2.0;
+   for (size_t i = 1; i < theBuffer.size(); ++i)
+   {
+      const Centroid& next = theBuffer[i];
+      const ossim_float64 proposed = current.theWeight + next.theWeight;
+      if ( (weightSoFar + proposed)/theTotalWeight <= qLimit )
+      {
+         current.theMean  += (next.theMean - current.theMean)*next.theWeight/proposed;
+         current.theWeight = proposed;
+      }
+      else
+      {
+         weightSoFar += current.theWeight;
+         theCentroids.push_back(current);
+         current = next;
+         const ossim_float64 q0 = ossim::min(weightSoFar/theTotalWeight, 1.0);
+         const ossim_float64 k = scale*std::asin(2.0*q0 - 1.0) + 1.0;
+         qLimit = (k/scale >= M_PI/2.0) ? 1.0 : (std::sin(k/scale) + 1.0)/2.0;
+      }
+   }
+   theCentroids.push_back(current);
+   theBuffer.clear();
+}
+
+ossim_float64 ossimTDigest::quantile(ossim_float64 q) const
+{
+   compress();
+   if ( theCentroids.empty() )
+   {
+      return ossim::nan();
+   }
+   if ( (q <= 0.0) || (theCentroids.size() == 1) )
+   {
+      return (q <= 0.0) ? theMin : theCentroids[0].theMean;
+   }
+   if ( q >= 1.0 )
+   {
+      return theMax;
+   }
+
+   //---
+   // Each centroid's mean is taken at the middle of its weight; ranks
+   // between two middles interpolate, and those beyond the first or last
+   // middle interpolate toward the exact min or max.
+   //---
+   const ossim_float64 index = q*theTotalWeight;
+   const Centroid& first = theCentroids.front();
+   if ( index < first.theWeight/2.0 )
+   {
+      return theMin + (first.theMean - theMin)*index/(first.theWeight/2.0);
+   }
+   ossim_float64 cumulative = 0.0;
+   for (size_t i = 0; i + 1 < theCentroids.size(); ++i)
+   {
+      const Centroid& left  = theCentroids[i];
+      const Centroid& right = theCentroids[i+1];
+      const ossim_float64 leftMid  = cumulative + left.theWeight/2.0;
+      const ossim_float64 rightMid = cumulative + left.theWeight + right.theWeight/2.0;
+      if ( index < rightMid )
+      {
+         return left.theMean +
+            (right.theMean - left.theMean)*(index - leftMid)/(rightMid - leftMid);
+      }
+      cumulative += left.theWeight;
+   }
+   const Centroid& last = theCentroids.back();
+   const ossim_float64 lastMid = theTotalWeight - last.theWeight/2.0;
+   return last.theMean +
+      (theMax - last.theMean)*(index - lastMid)/(theTotalWeight - lastMid);
+}
+
+ossim_float64 ossimTDigest::getCount() const
+{
+   return theTotalWeight;
+}
+
+ossim_float64 ossimTDigest::getMin() const
+{
+   return theMin;
+}
+
+ossim_float64 ossimTDigest::getMax() const
+{
+   return theMax;
+}
+
+void ossimTDigest::clear()
+{
+   theTotalWeight = 0.0;
+   theMin = ossim::nan();
+   theMax = ossim::nan();
+   theCentroids.clear();
+   theBuffer.clear();
+}
@@ -77,6 +77,7 @@ void ossimThinPlateSpline::growPoints()
 int ossimThinPlateSpline::addPoint( const double Px, const double Py, const double *Pvars )
 {
    type = VIZ_GEOREF_SPLINE_POINT_WAS_ADDED;
+   clearGrid();
    int i;
    
    if( _nof_points == _max_nof_points )
@@ -97,6 +98,7 @@ bool ossimThinPlateSpline::changePoint(int index, double Px, double Py, double*
    if ( index < _nof_points )
    {
       int i = index;
+      clearGrid();
       x[i] = Px;
       y[i] = Py;
       for ( int j = 0; j < _nof_vars; j++ )
@@ -127,6 +129,7 @@ bool ossimThinPlateSpline::getXy(int index, double& outX, double& outY)const
 
 int ossimThinPlateSpline::deletePoint(const double Px, const double Py )
 {
+   clearGrid();
    for ( int i = 0; i < _nof_points; i++ )
    {
       if ( ( ossim::abs(Px - x[i]) <= _tx ) && ( ossim::abs(Py - y[i]) <= _ty ) )
@@ -150,6 +153,8 @@ int ossimThinPlateSpline::solve(void)
 {
    int r, c, v;
    int p;
+
+   clearGrid();
 	
    //	No points at all
    if ( _nof_points < 1 )
@@ -309,7 +314,7 @@ int ossimThinPlateSpline::solve(void)
 int ossimThinPlateSpline::getPoint( const double Px, const double Py, double *vars )const
 {
 	int v, r;
-	double tmp, Pu;
+	double Pu;
 	double fact;
 	int leftP=0, rightP=0, found = 0;
 	
@@ -357,15 +362,31 @@ int ossimThinPlateSpline::getPoint( const double Px, const double Py, double *va
             fact * rhs[v][rightP+3];
          break;
       case VIZ_GEOREF_SPLINE_FULL :
-         for ( v = 0; v < _nof_vars; v++ )
-            vars[v] = coef[v][0] + coef[v][1] * Px + coef[v][2] * Py;
-         
-         for ( r = 0; r < _nof_points; r++ )
+         if ( !_grid.empty() )
          {
-            tmp = baseFunc( Px, Py, x[r], y[r] );
-            for ( v= 0; v < _nof_vars; v++ )
-               vars[v] += coef[v][r+3] * tmp;
+            // Bilinear in the precomputed grid, when inside it.
+            double gx = ( Px - _grid_x0 ) / _grid_dx;
+            double gy = ( Py - _grid_y0 ) / _grid_dy;
+            if ( gx >= 0.0 && gy >= 0.0 && gx <= _grid_nx - 1 && gy <= _grid_ny - 1 )
+            {
+               int c0 = ossim::min( (int)gx, _grid_nx - 2 );
+               int r0 = ossim::min( (int)gy, _grid_ny - 2 );
+               double fx = gx - c0;
+               double fy = gy - r0;
+               const double* n00 = &_grid[ ( r0 * _grid_nx + c0 ) * _nof_vars ];
+               const double* n01 = n00 + _nof_vars;
+               const double* n10 = n00 + _grid_nx * _nof_vars;
+               const double* n11 = n10 + _nof_vars;
+               for ( v = 0; v < _nof_vars; v++ )
+               {
+                  double top    = n00[v] + fx * ( n01[v] - n00[v] );
+                  double bottom = n10[v] + fx * ( n11[v] - n10[v] );
+                  vars[v] = top + fy * ( bottom - top );
+               }
+               break;
+            }
          }
+         evalFull( Px, Py, vars );
          break;
       case VIZ_GEOREF_SPLINE_POINT_WAS_ADDED :
          fprintf(stderr, " A point was added after the last solve\n");
@@ -388,6 +409,120 @@ int ossimThinPlateSpline::getPoint( const double Px, const double Py, double *va
 	return(1);
 }
 
+int ossimThinPlateSpline::getPoints( int count, const double *Px, const double *Py,
+                                     double *vars )const
+{
+   int evaluated = 0;
+   for ( int i = 0; i < count; i++ )
+   {
+      evaluated += getPoint( Px[i], Py[i], vars + i * _nof_vars ) ? 1 : 0;
+   }
+   return evaluated;
+}
+
+void ossimThinPlateSpline::evalFull( const double Px, const double Py, double *vars )const
+{
+   int v, r;
+   double tmp;
+
+   for ( v = 0; v < _nof_vars; v++ )
+      vars[v] = coef[v][0] + coef[v][1] * Px + coef[v][2] * Py;
+
+   for ( r = 0; r < _nof_points; r++ )
+   {
+      tmp = baseFunc( Px, Py, x[r], y[r] );
+      for ( v= 0; v < _nof_vars; v++ )
+         vars[v] += coef[v][r+3] * tmp;
+   }
+}
+
+bool ossimThinPlateSpline::buildGrid( double minX, double minY, double maxX, double maxY,
+                                      double maxError, int maxNodes )
+{
+   clearGrid();
+   if ( type != VIZ_GEOREF_SPLINE_FULL || !( maxX > minX ) || !( maxY > minY ) )
+      return false;
+
+   const int NV = _nof_vars;
+
+   // Start with 16x16 cells, every node from the spline.
+   int nx = 17;
+   int ny = 17;
+   double dx = ( maxX - minX ) / ( nx - 1 );
+   double dy = ( maxY - minY ) / ( ny - 1 );
+   std::vector<double> grid( nx * ny * NV );
+   for ( int r = 0; r < ny; r++ )
+      for ( int c = 0; c < nx; c++ )
+         evalFull( minX + c * dx, minY + r * dy, &grid[ ( r * nx + c ) * NV ] );
+
+   // Halve the cells.  The new nodes are the edge midpoints and centres of
+   // the old cells, so comparing the spline there with the old bilinear
+   // interpolation measures the old grid's error; the finer grid, whose
+   // error is lower still, is kept once that is within maxError.
+   std::vector<double> fine;
+   std::vector<double> interp( NV );
+   while ( true )
+   {
+      const int FNX = 2 * nx - 1;
+      const int FNY = 2 * ny - 1;
+      if ( (double)FNX * FNY > maxNodes )
+         return false;
+
+      fine.resize( FNX * FNY * NV );
+      const double FDX = dx / 2.0;
+      const double FDY = dy / 2.0;
+      double error = 0.0;
+      for ( int r = 0; r < FNY; r++ )
+      {
+         for ( int c = 0; c < FNX; c++ )
+         {
+            double* node = &fine[ ( r * FNX + c ) * NV ];
+            const int R0 = r / 2;
+            const int C0 = c / 2;
+            const double* old = &grid[ ( R0 * nx + C0 ) * NV ];
+            if ( !( r & 1 ) && !( c & 1 ) )
+            {
+               for ( int v = 0; v < NV; v++ )
+                  node[v] = old[v];
+               continue;
+            }
+
+            evalFull( minX + c * FDX, minY + r * FDY, node );
+
+            for ( int v = 0; v < NV; v++ )
+            {
+               if ( ( r & 1 ) && ( c & 1 ) )
+                  interp[v] = 0.25 * ( old[v] + old[v+NV] + old[v+nx*NV] + old[v+nx*NV+NV] );
+               else if ( c & 1 )
+                  interp[v] = 0.5 * ( old[v] + old[v+NV] );
+               else
+                  interp[v] = 0.5 * ( old[v] + old[v+nx*NV] );
+               error = ossim::max( error, ossim::abs( node[v] - interp[v] ) );
+            }
+         }
+      }
+
+      grid.swap( fine );
+      nx = FNX;
+      ny = FNY;
+      dx = FDX;
+      dy = FDY;
+
+      if ( error <= maxError )
+      {
+         _grid.swap( grid );
+         _grid_nx = nx;
+         _grid_ny = ny;
+         _grid_x0 = minX;
+         _grid_y0 = minY;
+         _grid_dx = dx;
+         _grid_dy = dy;
+         _grid_error = error;
+         return true;
+      }
+   }
+}
+
 double ossimThinPlateSpline::baseFunc( const double x1, const double y1,
                                     const double x2, const double y2 )const
 {
@@ -0,0 +1,364 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <ossim/base/ossimTieGptColumnSet.h>
+#include <ossim/base/ossimTieGptSet.h>
+#include <ossim/base/ossimTieGpt.h>
+#include <ossim/base/ossimXmlDocument.h>
+#include <ossim/base/ossimNotifyContext.h>
+
+const ossim_uint32 ossimTieGptColumnSet::DEFAULT_CHUNK_SIZE = 65536;
+
+static const char         MAGIC[] = "OSSIMTPS";
+static const ossim_uint32 VERSION = 1;
+static const ossim_uint32 BYTE_ORDER_MARK = 0x01020304;
+static const ossim_uint32 MAX_PATH_LENGTH = 65536;
+static const ossim_uint32 MAX_CHUNK_SIZE = 1 << 28; // sanity bound on a chunk read
+
+namespace
+{
+   template <class T> void writeValue(std::ostream& out, const T& value)
+   {
+      out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+   }
+
+   template <class T> bool readValue(std::istream& in, T& value)
+   {
+      in.read(reinterpret_cast<char*>(&value), sizeof(T));
+      return in.good();
+   }
+
+   void writeString(std::ostream& out, const ossimString& s)
+   {
+      writeValue(out, (ossim_uint32) s.size());
+      out.write(s.c_str(), s.size());
+   }
+
+   bool readString(std::istream& in, ossimString& s)
+   {
+      ossim_uint32 n;
+      if (!readValue(in, n) || (n > MAX_PATH_LENGTH))
+         return false;
+      std::string buf(n, '\0');
+      if (n)
+         in.read(&buf[0], n);
+      s = buf;
+      return !in.fail();
+   }
+
+   // lower half, row by row, as ossimTieGptSet::symMatrixToText(); zeros if not dim x dim
+   void writeCov(std::ostream& out, const NEWMAT::SymmetricMatrix& cov, int dim)
+   {
+      for (int i=1;i<=dim;++i)
+      {
+         for (int j=1;j<=i;++j)
+         {
+            writeValue(out, (cov.Nrows() == dim) ? (ossim_float64) cov(i,j) : 0.0);
+         }
+      }
+   }
+
+   bool readCov(std::istream& in, NEWMAT::SymmetricMatrix& cov, int dim)
+   {
+      cov.ReSize(dim);
+      for (int i=1;i<=dim;++i)
+      {
+         for (int j=1;j<=i;++j)
+         {
+            ossim_float64 v;
+            if (!readValue(in, v))
+               return false;
+            cov(i,j) = v;
+         }
+      }
+      return true;
+   }
+
+   void writeColumn(std::ostream& out, const std::vector<ossim_float64>& column,
+                    ossim_uint32 offset, ossim_uint32 count)
+   {
+      out.write(reinterpret_cast<const char*>(&column[offset]), count*sizeof(ossim_float64));
+   }
+
+   bool readColumn(std::istream& in, std::vector<ossim_float64>& column,
+                   ossim_uint32 offset, ossim_uint32 count)
+   {
+      column.resize(offset + count);
+      in.read(reinterpret_cast<char*>(&column[offset]), count*sizeof(ossim_float64));
+      return !in.fail();
+   }
+}
+
+ossimTieGptColumnSet::ossimTieGptColumnSet()
+   :
+   theImageCov(2),
+   theGroundCov(3)
+{
+   theImageCov  = 0.0;
+   theGroundCov = 0.0;
+}
+
+ossimTieGptColumnSet::ossimTieGptColumnSet(const ossimTieGptSet& aSet)
+{
+   fromTieGptSet(aSet);
+}
+
+void
+ossimTieGptColumnSet::fromTieGptSet(const ossimTieGptSet& aSet)
+{
+   theMasterPath = aSet.getMasterPath();
+   theSlavePath  = aSet.getSlavePath();
+   theImageCov   = aSet.getImageCov();
+   theGroundCov  = aSet.getGroundCov();
+
+   clearTiePoints();
+   const std::vector<ossimRefPtr<ossimTieGpt> >& ties = aSet.getTiePoints();
+   reserve((ossim_uint32)ties.size());
+   for (std::vector<ossimRefPtr<ossimTieGpt> >::const_iterator it = ties.begin(); it != ties.end(); ++it)
+   {
+      addTiePoint(*(*it));
+   }
+}
+
+void
+ossimTieGptColumnSet::toTieGptSet(ossimTieGptSet& aSet)const
+{
+   aSet.setMasterPath(theMasterPath);
+   aSet.setSlavePath(theSlavePath);
+   aSet.setImageCov(theImageCov);
+   aSet.setGroundCov(theGroundCov);
+
+   aSet.clearTiePoints();
+   aSet.refTiePoints().reserve(size());
+   for (ossim_uint32 i=0; i<size(); ++i)
+   {
+      aSet.addTiePoint(new ossimTieGpt(getGroundPoint(i), getImagePoint(i), theScore[i]));
+   }
+}
+
+void
+ossimTieGptColumnSet::reserve(ossim_uint32 numPoints)
+{
+   theLat.reserve(numPoints);
+   theLon.reserve(numPoints);
+   theHgt.reserve(numPoints);
+   theImageX.reserve(numPoints);
+   theImageY.reserve(numPoints);
+   theScore.reserve(numPoints);
+}
+
+void
+ossimTieGptColumnSet::clearTiePoints()
+{
+   theLat.clear();
+   theLon.clear();
+   theHgt.clear();
+   theImageX.clear();
+   theImageY.clear();
+   theScore.clear();
+}
+
+void
+ossimTieGptColumnSet::addTiePoint(const ossimGpt& aGround, const ossimDpt& aTie, ossim_float64 aScore)
+{
+   theLat.push_back(aGround.lat);
+   theLon.push_back(aGround.lon);
+   theHgt.push_back(aGround.hgt);
+   theImageX.push_back(aTie.x);
+   theImageY.push_back(aTie.y);
+   theScore.push_back(aScore);
+}
+
+void
+ossimTieGptColumnSet::addTiePoint(const ossimTieGpt& aTiePt)
+{
+   addTiePoint(aTiePt.getGroundPoint(), aTiePt.getImagePoint(), aTiePt.getScore());
+}
+
+void
+ossimTieGptColumnSet::append(const ossimTieGptColumnSet& aSet, ossim_uint32 offset, ossim_uint32 count)
+{
+   if (offset >= aSet.size())
+      return;
+   const ossim_uint32 last = offset + std::min(count, aSet.size() - offset);
+   theLat.insert(theLat.end(), aSet.theLat.begin() + offset, aSet.theLat.begin() + last);
+   theLon.insert(theLon.end(), aSet.theLon.begin() + offset, aSet.theLon.begin() + last);
+   theHgt.insert(theHgt.end(), aSet.theHgt.begin() + offset, aSet.theHgt.begin() + last);
+   theImageX.insert(theImageX.end(), aSet.theImageX.begin() + offset, aSet.theImageX.begin() + last);
+   theImageY.insert(theImageY.end(), aSet.theImageY.begin() + offset, aSet.theImageY.begin() + last);
+   theScore.insert(theScore.end(), aSet.theScore.begin() + offset, aSet.theScore.begin() + last);
+}
+
+void
+ossimTieGptColumnSet::getTiePoint(ossim_uint32 i, ossimTieGpt& aTiePt)const
+{
+   aTiePt.setGroundPoint(getGroundPoint(i));
+   aTiePt.setImagePoint(getImagePoint(i));
+   aTiePt.setScore(theScore[i]);
+}
+
+void
+ossimTieGptColumnSet::getSlaveMasterPoints(std::vector<ossimDpt>& imv, std::vector<ossimGpt>& gdv)const
+{
+   imv.resize(size());
+   gdv.resize(size());
+   for (ossim_uint32 i=0; i<size(); ++i)
+   {
+      imv[i] = getImagePoint(i);
+      gdv[i] = getGroundPoint(i);
+   }
+}
+
+bool
+ossimTieGptColumnSet::save(const ossimFilename& aFile)const
+{
+   std::ofstream out(aFile.c_str(), std::ios::out | std::ios::binary);
+   if (!out || !writeHeader(out))
+      return false;
+
+   for (ossim_uint32 offset=0; offset<size(); offset+=DEFAULT_CHUNK_SIZE)
+   {
+      if (!writeChunk(out, offset, DEFAULT_CHUNK_SIZE))
+         return false;
+   }
+   return writeEnd(out);
+}
+
+bool
+ossimTieGptColumnSet::load(const ossimFilename& aFile)
+{
+   if (isBinaryFile(aFile))
+   {
+      std::ifstream in(aFile.c_str(), std::ios::in | std::ios::binary);
+      if (!readHeader(in))
+         return false;
+      while (readChunk(in, true)) {}
+      return !in.fail();
+   }
+
+   // GML form written from ossimTieGptSet::exportAsGmlNode()
+   ossimXmlDocument doc;
+   if (!doc.openFile(aFile))
+      return false;
+   ossimRefPtr<ossimXmlNode> root = doc.getRoot();
+   if (!root.valid() || (root->getTag() != ossimTieGptSet::TIEPTSET_TAG))
+   {
+      ossimNotify(ossimNotifyLevel_WARN) << "WARNING: ossimTieGptColumnSet::load no "
+                                         << ossimTieGptSet::TIEPTSET_TAG << " in " << aFile << "\n";
+      return false;
+   }
+   ossimTieGptSet gmlSet;
+   if (!gmlSet.importFromGmlNode(root))
+      return false;
+   fromTieGptSet(gmlSet);
+   return true;
+}
+
+bool
+ossimTieGptColumnSet::isBinaryFile(const ossimFilename& aFile)
+{
+   std::ifstream in(aFile.c_str(), std::ios::in | std::ios::binary);
+   char magic[8];
+   in.read(magic, 8);
+   return in.good() && (memcmp(magic, MAGIC, 8) == 0);
+}
+
+bool
+ossimTieGptColumnSet::writeHeader(std::ostream& os)const
+{
+   os.write(MAGIC, 8);
+   writeValue(os, BYTE_ORDER_MARK);
+   writeValue(os, VERSION);
+   writeString(os, theMasterPath);
+   writeString(os, theSlavePath);
+   writeCov(os, theImageCov, 2);
+   writeCov(os, theGroundCov, 3);
+   return os.good();
+}
+
+bool
+ossimTieGptColumnSet::writeChunk(std::ostream& os, ossim_uint32 offset, ossim_uint32 count)const
+{
+   if (offset >= size())
+      return os.good(); // nothing to write; a count of 0 would end the points
+   count = std::min(std::min(count, size() - offset), MAX_CHUNK_SIZE);
+
+   writeValue(os, count);
+   writeColumn(os, theLat, offset, count);
+   writeColumn(os, theLon, offset, count);
+   writeColumn(os, theHgt, offset, count);
+   writeColumn(os, theImageX, offset, count);
+   writeColumn(os, theImageY, offset, count);
+   writeColumn(os, theScore, offset, count);
+   return os.good();
+}
+
+bool
+ossimTieGptColumnSet::writeEnd(std::ostream& os)
+{
+   writeValue(os, (ossim_uint32) 0);
+   os.flush();
+   return os.good();
+}
+
+bool
+ossimTieGptColumnSet::readHeader(std::istream& is)
+{
+   clearTiePoints();
+
+   char magic[8];
+   ossim_uint32 mark, version;
+   is.read(magic, 8);
+   if (!is.good() || (memcmp(magic, MAGIC, 8) != 0) ||
+       !readValue(is, mark) || (mark != BYTE_ORDER_MARK) ||
+       !readValue(is, version) || (version != VERSION) ||
+       !readString(is, theMasterPath) || !readString(is, theSlavePath) ||
+       !readCov(is, theImageCov, 2) || !readCov(is, theGroundCov, 3))
+   {
+      is.setstate(std::ios::failbit);
+      return false;
+   }
+   return true;
+}
+
+bool
+ossimTieGptColumnSet::readChunk(std::istream& is, bool append)
+{
+   if (!append)
+      clearTiePoints();
+
+   ossim_uint32 count;
+   if (!readValue(is, count))
+   {
+      is.setstate(std::ios::failbit);
+      return false;
+   }
+   if (count == 0)
+      return false; // end of the points
+   if (count > MAX_CHUNK_SIZE)
+   {
+      is.setstate(std::ios::failbit);
+      return false;
+   }
+
+   const ossim_uint32 offset = size();
+   if (!readColumn(is, theLat, offset, count) ||
+       !readColumn(is, theLon, offset, count) ||
+       !readColumn(is, theHgt, offset, count) ||
+       !readColumn(is, theImageX, offset, count) ||
+       !readColumn(is, theImageY, offset, count) ||
+       !readColumn(is, theScore, offset, count))
+   {
+      // keep the columns the same length
+      theLat.resize(offset);
+      theLon.resize(offset);
+      theHgt.resize(offset);
+      theImageX.resize(offset);
+      theImageY.resize(offset);
+      theScore.resize(offset);
+      return false;
+   }
+   return true;
+}
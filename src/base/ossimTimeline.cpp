@@ -0,0 +1,284 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Per-thread timeline of spans, exported in the Chrome trace format.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/base/ossimTimeline.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#if !defined(_WIN32)
+#  include <pthread.h>
+#endif
+
+static const ossim_uint32 DEFAULT_EVENTS_PER_THREAD = 65536;
+
+ossimTimeline* ossimTimeline::m_instance = 0;
+
+namespace
+{
+   // The calling thread's buffer, see ossimTimeline::getThreadBuffer().
+#if defined(_WIN32)
+   __declspec(thread) void* theThreadBuffer = 0;
+
+   void* getThreadPointer()
+   {
+      return theThreadBuffer;
+   }
+
+   void setThreadPointer(void* buffer)
+   {
+      theThreadBuffer = buffer;
+   }
+#else
+   pthread_key_t  theThreadBufferKey;
+   pthread_once_t theThreadBufferOnce = PTHREAD_ONCE_INIT;
+
+   void createThreadBufferKey()
+   {
+      pthread_key_create(&theThreadBufferKey, 0);
+   }
+
+   void* getThreadPointer()
+   {
+      pthread_once(&theThreadBufferOnce, createThreadBufferKey);
+      return pthread_getspecific(theThreadBufferKey);
+   }
+
+   void setThreadPointer(void* buffer)
+   {
+      pthread_once(&theThreadBufferOnce, createThreadBufferKey);
+      pthread_setspecific(theThreadBufferKey, buffer);
+   }
+#endif
+
+   //! Writes s as a JSON string.
+   void writeJsonString(std::ostream& out, const char* s)
+   {
+      out << '"';
+      for ( ; s && *s; ++s)
+      {
+         const unsigned char c = (unsigned char)*s;
+         if ( (c == '"') || (c == '\\') )
+         {
+            out << '\\' << (char)c;
+         }
+         else if ( c < 0x20 )
+         {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c
+                << std::dec << std::setfill(' ');
+         }
+         else
+         {
+            out << (char)c;
+         }
+      }
+      out << '"';
+   }
+}
+
+ossimTimeline* ossimTimeline::instance()
+{
+   static OpenThreads::Mutex instanceMutex;
+   if (!m_instance)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(instanceMutex);
+      if (!m_instance)
+      {
+         m_instance = new ossimTimeline();
+      }
+   }
+   return m_instance;
+}
+
+ossimTimeline::ossimTimeline()
+   : m_mutex(),
+     m_buffers(),
+     m_names(),
+     m_eventsPerThread(DEFAULT_EVENTS_PER_THREAD),
+     m_startTick(0),
+     m_windowTicks(0),
+     m_periodTicks(0),
+     m_recording(false)
+{
+}
+
+void ossimTimeline::start(ossim_uint32 eventsPerThread)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   if (eventsPerThread)
+   {
+      m_eventsPerThread = eventsPerThread;
+   }
+   else
+   {
+      const char* lookup =
+         ossimPreferences::instance()->findPreference("timeline.events_per_thread");
+      if (lookup && ossimString(lookup).toUInt32())
+      {
+         m_eventsPerThread = ossimString(lookup).toUInt32();
+      }
+   }
+   if (!m_recording)
+   {
+      m_startTick = ossimTimer::instance()->tick();
+      m_recording = true;
+   }
+}
+
+void ossimTimeline::stop()
+{
+   m_recording = false;
+}
+
+void ossimTimeline::setSampling(double windowSeconds, double periodSeconds)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   const double SECS_PER_TICK = ossimTimer::instance()->getSecondsPerTick();
+   if ( (windowSeconds > 0.0) && (periodSeconds > windowSeconds) && (SECS_PER_TICK > 0.0) )
+   {
+      m_windowTicks = (ossim_uint64)(windowSeconds / SECS_PER_TICK);
+      m_periodTicks = (ossim_uint64)(periodSeconds / SECS_PER_TICK);
+   }
+   else
+   {
+      m_windowTicks = 0;
+      m_periodTicks = 0;
+   }
+}
+
+void ossimTimeline::startFromPreferences()
+{
+   ossimPreferences* prefs = ossimPreferences::instance();
+   const char* window = prefs->findPreference("timeline.sample_window");
+   const char* period = prefs->findPreference("timeline.sample_period");
+   if (window && period)
+   {
+      setSampling(ossimString(window).toDouble(), ossimString(period).toDouble());
+   }
+   start();
+}
+
+ossimTimeline::ThreadBuffer* ossimTimeline::getThreadBuffer()
+{
+   ThreadBuffer* buffer = static_cast<ThreadBuffer*>(getThreadPointer());
+   if (!buffer)
+   {
+      // Kept for the life of the process: the events outlive the thread.
+      buffer = new ThreadBuffer();
+      buffer->m_count    = 0;
+      buffer->m_mainFlag = (OpenThreads::Thread::CurrentThread() == 0);
+
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      buffer->m_events.resize(m_eventsPerThread);
+      buffer->m_tid = (ossim_uint32)m_buffers.size() + 1;
+      m_buffers.push_back(buffer);
+      setThreadPointer(buffer);
+   }
+   return buffer;
+}
+
+void ossimTimeline::record(const char* name, const char* category,
+                           ossimTimer::Timer_t begin, ossimTimer::Timer_t end)
+{
+   ThreadBuffer* buffer = getThreadBuffer();
+   Event& event = buffer->m_events[buffer->m_count % buffer->m_events.size()];
+   event.m_name     = name;
+   event.m_category = category;
+   event.m_begin    = begin;
+   event.m_end      = end;
+   ++buffer->m_count;
+}
+
+void ossimTimeline::clear()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   for (ossim_uint32 i = 0; i < m_buffers.size(); ++i)
+   {
+      m_buffers[i]->m_count = 0;
+   }
+}
+
+void ossimTimeline::write(std::ostream& out) const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   const ossimTimer* timer = ossimTimer::instance();
+   ossim_uint64 dropped = 0;
+
+   out << "{\"traceEvents\":[";
+   bool first = true;
+   for (ossim_uint32 i = 0; i < m_buffers.size(); ++i)
+   {
+      const ThreadBuffer& buffer = *m_buffers[i];
+      const ossim_uint64 SIZE = buffer.m_events.size();
+      const ossim_uint64 COUNT = (buffer.m_count < SIZE) ? buffer.m_count : SIZE;
+      dropped += buffer.m_count - COUNT;
+
+      out << (first ? "\n" : ",\n")
+          << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.m_tid
+          << ",\"args\":{\"name\":\"";
+      if (buffer.m_mainFlag)
+      {
+         out << "main";
+      }
+      else
+      {
+         out << "thread " << buffer.m_tid;
+      }
+      out << "\"}}";
+      first = false;
+
+      // Oldest first:
+      for (ossim_uint64 n = buffer.m_count - COUNT; n < buffer.m_count; ++n)
+      {
+         const Event& event = buffer.m_events[n % SIZE];
+         if (event.m_begin < m_startTick)
+         {
+            continue; // Recorded before the last start().
+         }
+         out << ",\n{\"name\":";
+         writeJsonString(out, event.m_name);
+         out << ",\"cat\":";
+         writeJsonString(out, event.m_category);
+         out << std::fixed << std::setprecision(3)
+             << ",\"ph\":\"X\",\"ts\":" << timer->delta_u(m_startTick, event.m_begin)
+             << ",\"dur\":" << timer->delta_u(event.m_begin, event.m_end)
+             << ",\"pid\":1,\"tid\":" << buffer.m_tid << "}";
+      }
+   }
+   out << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":\""
+       << dropped << "\"}}\n";
+}
+
+bool ossimTimeline::write(const ossimFilename& file) const
+{
+   std::ofstream out(file.c_str());
+   if (!out.good())
+   {
+      return false;
+   }
+   write(out);
+   return out.good();
+}
+
+const char* ossimTimeline::intern(const std::string& name)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   return m_names.insert(name).first->c_str();
+}
+
+ossimFilename ossimTimeline::getPreferenceFile()
+{
+   const char* lookup = ossimPreferences::instance()->findPreference("timeline.file");
+   return lookup ? ossimFilename(lookup) : ossimFilename();
+}
@@ -21,6 +21,13 @@
 #include <ossim/base/ossimTrace.h>
 #include <ossim/base/ossimTraceManager.h>
 #include <ossim/base/ossimCommon.h>
+#include <OpenThreads/Atomic>
+
+namespace
+{
+   OpenThreads::AtomicPtr theSpanSink;
+}
+
 //*****************************************************************************
 //  CONSTRUCTOR: ossimTrace
 //  
@@ -38,3 +45,39 @@ ossimTrace::~ossimTrace()
    ossimTraceManager::instance()->removeTrace(this);
 }
 
+
+void ossimTraceSpan::setSink(ossimTraceSpanSink* sink)
+{
+   // Starts the timer now rather than racing to on the first span:
+   ossimTimer::instance();
+   void* old = theSpanSink.get();
+   while ( !theSpanSink.assign(sink, old) )
+   {
+      old = theSpanSink.get();
+   }
+}
+
+ossimTraceSpanSink* ossimTraceSpan::getSink()
+{
+   return static_cast<ossimTraceSpanSink*>(theSpanSink.get());
+}
+
+void ossimTraceSpan::begin(const ossimTrace& trace, const char* name,
+                           ossim_int64 value)
+{
+   theSink = getSink();
+   if ( theSink )
+   {
+      theRecord.theTrace     = &trace;
+      theRecord.theName      = name;
+      theRecord.theValue     = value;
+      theRecord.theEndTick   = 0;
+      theRecord.theStartTick = ossimTimer::instance()->tick();
+   }
+}
+
+void ossimTraceSpan::end()
+{
+   theRecord.theEndTick = ossimTimer::instance()->tick();
+   theSink->spanEnded(theRecord);
+}
@@ -13,6 +13,7 @@
 #include <ossim/base/ossimString.h>
 #include <ossim/base/ossimTrace.h>
 #include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimPreferences.h>
 
 #include <iostream>
 #include <iomanip>
@@ -28,7 +29,16 @@ static ossimTrace traceExec(ossimString("ossimWLSBundleSolution:exec"));
 //  
 //*****************************************************************************
 ossimWLSBundleSolution::ossimWLSBundleSolution()
+   :
+   theSolValid(false),
+   theReducedFlag(true)
 {
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("bundle_adjustment.reduced_solution");
+   if (lookup)
+   {
+      theReducedFlag = ossimString(lookup).toBool();
+   }
 }
 
 
@@ -96,6 +106,11 @@ bool ossimWLSBundleSolution::run(ossimAdjSolutionAttributes* solAttributes)
       ossimNotify(ossimNotifyLevel_DEBUG)<<std::endl;
    }
 
+   if (theReducedFlag)
+   {
+      return runReduced(solAttributes, NdIndex, Nd_rank);
+   }
+
 
    // NORMAL EQUATION ARRAYS
    NEWMAT::UpperTriangularMatrix N(Nrank);//coefficient matrix
@@ -287,6 +302,7 @@ bool ossimWLSBundleSolution::run(ossimAdjSolutionAttributes* solAttributes)
       if (recurBack(Nl.Store()-1, Nrank))
       {
          solAttributes->theFullCovMatrix = Nl.t();
+         solAttributes->theObjectPtPropCov.CleanUp();
       }
       else
       {
@@ -298,6 +314,244 @@ bool ossimWLSBundleSolution::run(ossimAdjSolutionAttributes* solAttributes)
 }
 
 
+//*****************************************************************************
+//  METHOD: ossimWLSBundleSolution::runReduced()
+//  
+//  Execute solution with the ground partition eliminated first.
+//
+//  The ground partition of N is block diagonal (3X3 per object point), so
+//  it is folded into the image partition point by point:
+//
+//     S  = Nd - sum(Nb * Ndd^-1 * Nb(t))
+//     Cs = Cd - sum(Nb * Ndd^-1 * Cdd)
+//
+//  leaving a reduced system of Nd_rank, solved with the same recursive
+//  routines as the full system; these skip zero elements, so images sharing
+//  no points cost nothing.  Ground corrections are then recovered per point:
+//
+//     Ddd = Ndd^-1 * (Cdd - Nb(t) * Dd)
+//
+//  Only the image partition and the 3X3 ground diagonal blocks of the
+//  a posteriori covariance are formed.
+//  
+//*****************************************************************************
+bool ossimWLSBundleSolution::runReduced(ossimAdjSolutionAttributes* solAttributes,
+                                        const std::vector<int>& NdIndex,
+                                        int Nd_rank)
+{
+   int numObs    = solAttributes->numObjObs();
+   int numImages = solAttributes->numImages();
+   int Nrank     = Nd_rank + numObs*3;
+
+   // REDUCED NORMAL EQUATION ARRAYS
+   NEWMAT::SymmetricMatrix S(Nd_rank);    // reduced coefficient matrix
+   NEWMAT::ColumnVector Cs(Nd_rank);      // reduced constant vector
+   NEWMAT::ColumnVector Dd(Nd_rank);      // image partition solution
+   NEWMAT::ColumnVector D(Nrank);         // full solution vector
+
+   // IMAGE PARTITION ARRAYS (for image having "p" parameters)
+   NEWMAT::Matrix Bd;                     // [B-dot] matrix            (2Xp)
+   NEWMAT::Matrix Bdt_w;                  // [B-dot(t) * w] matrix     (2Xp)
+   NEWMAT::ColumnVector eps(2);           // image pt residual matrix  (2X1)
+   NEWMAT::Matrix w(2,2);                 // image pt weight matrix    (2X2)
+
+   // GROUND PARTITION ARRAYS
+   NEWMAT::Matrix Bdd(2,3);               // [B-dbl-dot] matrix        (2X3)
+   NEWMAT::Matrix Bddt_w(2,3);            // [B-dbl-dot(t) * w] matrix (2X3)
+   NEWMAT::SymmetricMatrix Ndd(3);        // [N-dbl-dot] matrix        (3X3)
+   NEWMAT::ColumnVector Cdd(3);           // [C-dbl_dot] matrix        (3X1)
+   NEWMAT::SymmetricMatrix NddInv(3);     // [N-dbl-dot]^-1            (3X3)
+
+   // Kept per point for the ground corrections and covariance
+   NEWMAT::Matrix NddInvStack(numObs*3,3);
+   NEWMAT::ColumnVector CddStack(numObs*3);
+   std::vector<NEWMAT::Matrix> NbStack;   // [N-bar] per measurement   (pX3)
+   std::vector<int> NbIdx;                // image partition index per measurement
+   std::vector<int> NbBeg(numObs+1);      // first measurement per point
+   NbStack.reserve(solAttributes->theNumMeasurements);
+   NbIdx.reserve(solAttributes->theNumMeasurements);
+
+   // initialize image partition with weights
+   S = 0.0;
+   Cs = 0.0;
+
+   for (int img=0; img<numImages; img++)
+   {
+      int size = solAttributes->theImgNumparXref[img];
+      int rcBeg = NdIndex[img];
+      int rcEnd = rcBeg+size-1;
+
+      NEWMAT::Matrix Wd(size,size);
+      Wd = solAttributes->theAdjParCov.SubMatrix(rcBeg,rcEnd,rcBeg,rcEnd).i();
+
+      NEWMAT::ColumnVector Ed(size);
+      Ed = solAttributes->theTotalCorrections.Rows(rcBeg,rcEnd);
+
+      S.SymSubMatrix(rcBeg,rcEnd) << Wd;
+      Cs.Rows(rcBeg,rcEnd) = Wd * Ed;
+   }
+
+   //*******************
+   // object point loop 
+   //*******************
+   int cMeas = 1;
+   int cImgIdx = 1;
+   int cObjIdx = 1;
+
+   for (int obs=0; obs<numObs; obs++)
+   {
+      // Initialize Ndd & Cdd with weight matrix
+      int idx = obs*3 + 1;
+      NEWMAT::Matrix Wdd = solAttributes->theObjectPtCov.Rows(idx,idx+2).i();
+      Ndd << Wdd;
+
+      NEWMAT::ColumnVector Edd(3);
+      Edd = solAttributes->theTotalCorrections.Rows(Nd_rank+idx, Nd_rank+idx+2);
+      Cdd = Wdd * Edd;
+
+      int nMeasOnObs = (int) solAttributes->theObjImgXref.count(obs);
+      ObjImgMapIter_t currImg = solAttributes->theObjImgXref.equal_range(obs).first;
+      NbBeg[obs] = (int) NbStack.size();
+
+      for (int meas=0; meas<nMeasOnObs; meas++)
+      {
+         Bdd = solAttributes->theObjPartials.Rows(cObjIdx,cObjIdx+2).t();
+         cObjIdx += 3;
+
+         int cNumPar = solAttributes->theImgNumparXref[currImg->second];
+         Bd = solAttributes->theParPartials.Rows(cImgIdx,cImgIdx+cNumPar-1).t();
+         int NdIdx = NdIndex[currImg->second];
+
+         eps = solAttributes->theMeasResiduals.Row(cMeas).t();
+
+         int start = (cMeas-1)*2 + 1;
+         w = solAttributes->theImagePtCov.Rows(start,start+1).i();
+         Bdt_w << Bd.t() * w;
+         Bddt_w << Bdd.t() * w;
+
+         // SUM N-dot & C-dot into the image partition
+         NEWMAT::Matrix Nd = Bdt_w * Bd;
+         for (int r=1; r<=cNumPar; ++r)
+            for (int c=r; c<=cNumPar; ++c)
+               S(NdIdx+r-1, NdIdx+c-1) += Nd(r,c);
+         Cs.Rows(NdIdx,NdIdx+cNumPar-1) += Bdt_w * eps;
+
+         // SUM N-dd & C-dd
+         NEWMAT::Matrix NddMeas = Bddt_w * Bdd;
+         for (int r=1; r<=3; ++r)
+            for (int c=r; c<=3; ++c)
+               Ndd(r,c) += NddMeas(r,c);
+         Cdd += Bddt_w * eps;
+
+         // N-bar for PT "obs" & IMAGE "meas"
+         NbStack.push_back(Bdt_w * Bdd);
+         NbIdx.push_back(NdIdx);
+
+         cImgIdx += cNumPar;
+         cMeas++;
+         currImg++;
+      }
+
+      NddInv << Ndd.i();
+      NddInvStack.Rows(idx,idx+2) = NddInv;
+      CddStack.Rows(idx,idx+2) = Cdd;
+
+      //*****************************************
+      // fold point into the reduced system 
+      //*****************************************
+      int beg = NbBeg[obs];
+      int end = (int) NbStack.size();
+      for (int k=beg; k<end; ++k)
+      {
+         NEWMAT::Matrix NbNddInv = NbStack[k] * NddInv;
+         int kIdx = NbIdx[k];
+         int kNum = NbStack[k].Nrows();
+         Cs.Rows(kIdx,kIdx+kNum-1) -= NbNddInv * Cdd;
+
+         for (int l=beg; l<end; ++l)
+         {
+            int lIdx = NbIdx[l];
+            if (lIdx < kIdx)
+               continue;
+            NEWMAT::Matrix Skl = NbNddInv * NbStack[l].t();
+            int lNum = NbStack[l].Nrows();
+            for (int r=1; r<=kNum; ++r)
+               for (int c=(lIdx==kIdx ? r : 1); c<=lNum; ++c)
+                  S(kIdx+r-1, lIdx+c-1) -= Skl(r,c);
+         }
+      }
+   }
+   NbBeg[numObs] = (int) NbStack.size();
+
+
+   //*******************************
+   // solve reduced equation system 
+   //   Note: SymmetricMatrix stores the lower triangle by rows,
+   //         the folded layout solveSystem uses (1-based)
+   //*******************************
+   if (!solveSystem(S.Store()-1, Cs.Store()-1, Dd.Store()-1, Nd_rank) ||
+       !recurBack(S.Store()-1, Nd_rank))
+   {
+      theSolValid = false;
+      return theSolValid;
+   }
+
+   // S now holds the image partition covariance
+   D.Rows(1,Nd_rank) = Dd;
+   solAttributes->theObjectPtPropCov.ReSize(numObs*3,3);
+
+   for (int obs=0; obs<numObs; obs++)
+   {
+      int idx = obs*3 + 1;
+      NEWMAT::Matrix NddInvObs = NddInvStack.Rows(idx,idx+2);
+
+      // ground corrections
+      NEWMAT::ColumnVector CddObs = CddStack.Rows(idx,idx+2);
+      NEWMAT::Matrix G(3,3);
+      G = 0.0;
+      for (int k=NbBeg[obs]; k<NbBeg[obs+1]; ++k)
+      {
+         int kIdx = NbIdx[k];
+         int kNum = NbStack[k].Nrows();
+         CddObs -= NbStack[k].t() * Dd.Rows(kIdx,kIdx+kNum-1);
+
+         // Nb(t) * Q * Nb over the images of the point
+         for (int l=NbBeg[obs]; l<NbBeg[obs+1]; ++l)
+         {
+            int lIdx = NbIdx[l];
+            int lNum = NbStack[l].Nrows();
+            NEWMAT::Matrix Qkl = S.SubMatrix(kIdx,kIdx+kNum-1,lIdx,lIdx+lNum-1);
+            G += NbStack[k].t() * Qkl * NbStack[l];
+         }
+      }
+      D.Rows(Nd_rank+idx,Nd_rank+idx+2) = NddInvObs * CddObs;
+
+      // ground covariance:  Ndd^-1 + Ndd^-1 * Nb(t) * Q * Nb * Ndd^-1
+      solAttributes->theObjectPtPropCov.Rows(idx,idx+2) =
+         NddInvObs + NddInvObs * G * NddInvObs;
+   }
+
+   //******************
+   // load corrections 
+   //******************
+   solAttributes->theLastCorrections = -D;
+   solAttributes->theTotalCorrections -= D;
+
+   solAttributes->theFullCovMatrix.ReSize(Nd_rank);
+   solAttributes->theFullCovMatrix << S;
+
+   if (traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         <<"\nossimWLSBundleSolution::runReduced: solved "<<Nd_rank
+         <<" image parameters for "<<numObs<<" points"<<std::endl;
+   }
+
+   theSolValid = true;
+   return theSolValid;
+}
+
+
 //*****************************************************************************
 // method: recursive forward solution
 //
@@ -1,11 +1,15 @@
 #include <ossim/base/ossimWebRequestFactoryRegistry.h>
 #include <ossim/base/ossimHttpRequest.h>
+#include <ossim/base/ossimHttpConnectionPool.h>
 
 ossimWebRequestFactoryRegistry* ossimWebRequestFactoryRegistry::m_instance = 0;
 
 ossimWebRequestFactoryRegistry::ossimWebRequestFactoryRegistry()
 {
    m_instance = this;
+
+   // Built in http:// transport; plugins registered later serve the rest (e.g. https://).
+   registerFactory(ossimPooledHttpRequestFactory::instance());
 }
 
 ossimWebRequestFactoryRegistry* ossimWebRequestFactoryRegistry::instance()
@@ -20,6 +20,7 @@
 #include <ossim/base/ossimRegExp.h>
 #include <ossim/base/ossimNotifyContext.h>
 #include <ossim/base/ossimKeywordNames.h>
+#include <ossim/base/ossimXmlStreamParser.h>
 #include <stack>
 #include <iostream>
 #include <fstream>
@@ -45,6 +46,144 @@ static std::istream& xmlskipws(std::istream& in)
 static const int BUFFER_MAX_LEN = 1000;
 static const ossimString XPATH_DELIM ("/");
 
+namespace
+{
+   //---
+   // Builds the nodes of the elements at, under, or on the way to the
+   // requested paths.  Each open element keeps the paths it is still on the
+   // way to; elements on the way to none are skipped with their subtree.
+   //---
+   class ossimXmlSelectiveBuilder : public ossimXmlStreamHandler
+   {
+   public:
+      ossimXmlSelectiveBuilder(const std::vector<ossimString>& xpaths)
+         : theSteps(),
+           theLevels(),
+           theRoot(0)
+      {
+         for (size_t i = 0; i < xpaths.size(); ++i)
+         {
+            std::vector<ossimString> steps;
+            xpaths[i].split(steps, XPATH_DELIM, true);
+            if ( steps.size() && xpaths[i].size() &&
+                 (xpaths[i][static_cast<std::string::size_type>(0)] == '/') )
+            {
+               theSteps.push_back(steps);
+            }
+            else if (traceDebug())
+            {
+               ossimNotify(ossimNotifyLevel_DEBUG)
+                  << "ossimXmlDocument::read: ignoring path <" << xpaths[i]
+                  << ">, only absolute XPaths are supported." << std::endl;
+            }
+         }
+      }
+
+      virtual bool startElement(const ossimString& tag,
+                                const AttributeList& attributes)
+      {
+         const size_t DEPTH = theLevels.size();
+         theLevels.push_back(Level());
+         Level& level = theLevels.back();
+         Level* parent = DEPTH ? &theLevels[DEPTH-1] : 0;
+
+         if ( parent && parent->theMatchedFlag )
+         {
+            level.theMatchedFlag = true;
+         }
+         else if ( !parent && theSteps.empty() )
+         {
+            level.theMatchedFlag = true; // No paths, load everything.
+         }
+         else if ( !parent || parent->theNode.valid() )
+         {
+            const size_t COUNT = parent ? parent->theCandidates.size() : theSteps.size();
+            for (size_t i = 0; (i < COUNT) && !level.theMatchedFlag; ++i)
+            {
+               const ossim_uint32 CANDIDATE = parent ? parent->theCandidates[i] : (ossim_uint32)i;
+               const std::vector<ossimString>& steps = theSteps[CANDIDATE];
+               if ( (steps[DEPTH] == tag) || (steps[DEPTH] == "*") )
+               {
+                  if ( steps.size() == DEPTH + 1 )
+                  {
+                     level.theMatchedFlag = true;
+                  }
+                  else
+                  {
+                     level.theCandidates.push_back(CANDIDATE);
+                  }
+               }
+            }
+         }
+
+         // The root is kept regardless so findNodes can check its tag.
+         if ( level.theMatchedFlag || level.theCandidates.size() || !parent )
+         {
+            level.theNode = new ossimXmlNode();
+            level.theNode->setTag(tag);
+            for (size_t i = 0; i < attributes.size(); ++i)
+            {
+               level.theNode->addAttribute(attributes[i].first, attributes[i].second);
+            }
+            if ( parent )
+            {
+               parent->theNode->addChildNode(level.theNode);
+            }
+            else
+            {
+               theRoot = level.theNode;
+            }
+         }
+         return true;
+      }
+
+      virtual bool text(const ossimString& text, bool cdata)
+      {
+         Level& level = theLevels.back();
+         if ( level.theMatchedFlag )
+         {
+            if ( level.theNode->getText().empty() )
+            {
+               level.theNode->setText(text);
+            }
+            else
+            {
+               level.theNode->setText(level.theNode->getText() + text);
+            }
+            if ( cdata )
+            {
+               level.theNode->setCDataFlag(true);
+            }
+         }
+         return true;
+      }
+
+      virtual bool endElement(const ossimString& /* tag */)
+      {
+         theLevels.pop_back();
+         return true;
+      }
+
+      ossimRefPtr<ossimXmlNode> getRoot() const
+      {
+         return theRoot;
+      }
+
+   private:
+      struct Level
+      {
+         Level() : theNode(0), theMatchedFlag(false), theCandidates() {}
+         ossimRefPtr<ossimXmlNode>  theNode;
+         bool                       theMatchedFlag;
+         std::vector<ossim_uint32>  theCandidates;
+      };
+
+      std::vector< std::vector<ossimString> > theSteps;
+      std::vector<Level>                      theLevels;
+      ossimRefPtr<ossimXmlNode>               theRoot;
+   };
+}
+
 RTTI_DEF1(ossimXmlDocument, "ossimXmlDocument", ossimObject)
 ossimXmlDocument::ossimXmlDocument(const ossimFilename& xmlFileName)
    :
@@ -118,24 +257,63 @@ bool ossimXmlDocument::openFile(const ossimFilename& filename)
    return read(xml_stream);
 }
 
+bool ossimXmlDocument::openFile(const ossimFilename& filename,
+                                const std::vector<ossimString>& xpaths)
+{
+   theFilename = filename;
+   if(theFilename == "")
+   {
+      return false;
+   }
+
+   ifstream xml_stream (filename.c_str(), ios::binary);
+   if (!xml_stream)
+   {
+      if (traceDebug())
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << "DEBUG: ossimXmlDocument::openFile\n"
+            << "encountered opening file <" << filename << "> for "
+            << "reading. Aborting..." << endl;
+      }
+      return false;
+   }
+
+   return read(xml_stream, xpaths);
+}
+
+bool ossimXmlDocument::read(std::istream& in,
+                            const std::vector<ossimString>& xpaths)
+{
+   theRootNode = 0;
+   if ( !skipToMarkup(in) )
+   {
+      return false;
+   }
+
+   // The parser skips the prolog itself; readHeader would consume the root's '<'.
+   theXmlHeader = "<?xml version='1.0'?>";
+   ossimXmlSelectiveBuilder builder(xpaths);
+   ossimXmlStreamParser parser;
+   if ( parser.parse(in, builder) && builder.getRoot().valid() )
+   {
+      theRootNode = builder.getRoot();
+      setErrorStatus(ossimErrorCodes::OSSIM_OK);
+      return true;
+   }
+   setErrorStatus();
+   return false;
+}
+
 bool ossimXmlDocument::read(std::istream& in)
 {
 //   char buffer[BUFFER_MAX_LEN];
 //   streampos file_pos;
 //   bool readingHeader = true;
    bool startTagCharacterFound = false;
-   char c = in.peek();
-
-   // Initially we will do our own skipping to make sure we ar not binary.
-   while(!in.bad() && (c != '<') && (c >= 0x20) && (c <= 0x7e))
-   {
-      in.ignore(1);
-      c = in.peek();
-   }
 
-   if (in.bad() || (c!='<'))
+   if ( !skipToMarkup(in) )
    {
-      setErrorStatus();
       return false;
    }
    startTagCharacterFound = true;
@@ -169,6 +347,25 @@ bool ossimXmlDocument::read(std::istream& in)
    return (getErrorStatus()==ossimErrorCodes::OSSIM_OK);
 }
 
+bool ossimXmlDocument::skipToMarkup(std::istream& in)
+{
+   char c = in.peek();
+
+   // Initially we will do our own skipping to make sure we ar not binary.
+   while(!in.bad() && (c != '<') && (c >= 0x20) && (c <= 0x7e))
+   {
+      in.ignore(1);
+      c = in.peek();
+   }
+
+   if (in.bad() || (c!='<'))
+   {
+      setErrorStatus();
+      return false;
+   }
+   return true;
+}
+
 void ossimXmlDocument::findNodes(const ossimString& arg_xpath,
                             vector<ossimRefPtr<ossimXmlNode> >& result) const
 {
@@ -0,0 +1,386 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description:
+//
+// Contains definition of class ossimXmlStreamParser.
+//
+//*******************************************************************
+
+#include <ossim/base/ossimXmlStreamParser.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimTrace.h>
+#include <cstring>
+#include <istream>
+
+static ossimTrace traceDebug("ossimXmlStreamParser:debug");
+
+namespace
+{
+   const size_t BUFFER_SIZE = 65536;
+
+   inline bool isXmlSpace(int c)
+   {
+      return (c >= 0) && (c <= 0x20);
+   }
+}
+
+ossimXmlStreamHandler::~ossimXmlStreamHandler()
+{
+}
+
+bool ossimXmlStreamHandler::startElement(const ossimString& /* tag */,
+                                         const AttributeList& /* attributes */)
+{
+   return true;
+}
+
+bool ossimXmlStreamHandler::text(const ossimString& /* text */, bool /* cdata */)
+{
+   return true;
+}
+
+bool ossimXmlStreamHandler::endElement(const ossimString& /* tag */)
+{
+   return true;
+}
+
+ossimXmlStreamParser::ossimXmlStreamParser()
+   : theStream(0),
+     theBuffer(BUFFER_SIZE),
+     thePos(0),
+     theEnd(0),
+     theOffset(0),
+     theStoppedFlag(false),
+     theTag(),
+     theText(),
+     theAttributes(),
+     theOpenTags()
+{
+}
+
+bool ossimXmlStreamParser::wasStopped() const
+{
+   return theStoppedFlag;
+}
+
+ossim_uint64 ossimXmlStreamParser::getOffset() const
+{
+   return theOffset;
+}
+
+bool ossimXmlStreamParser::fill()
+{
+   thePos = 0;
+   theEnd = 0;
+   if ( theStream && theStream->good() )
+   {
+      theStream->read(&theBuffer.front(), (std::streamsize)theBuffer.size());
+      theEnd = (size_t)theStream->gcount();
+   }
+   return (theEnd > 0);
+}
+
+inline int ossimXmlStreamParser::peek()
+{
+   if ( (thePos == theEnd) && !fill() )
+   {
+      return -1;
+   }
+   return (unsigned char)theBuffer[thePos];
+}
+
+inline int ossimXmlStreamParser::get()
+{
+   int c = peek();
+   if ( c >= 0 )
+   {
+      ++thePos;
+      ++theOffset;
+   }
+   return c;
+}
+
+bool ossimXmlStreamParser::skipPast(const char* terminator)
+{
+   //---
+   // Compares the last characters read to the terminator, so runs such as
+   // "--->" are found.
+   //---
+   const size_t LENGTH = std::strlen(terminator);
+   char last[4] = { 0, 0, 0, 0 };
+   size_t count = 0;
+   int c = get();
+   while ( c >= 0 )
+   {
+      if ( LENGTH > 1 )
+      {
+         std::memmove(last, last + 1, LENGTH - 1);
+      }
+      last[LENGTH - 1] = (char)c;
+      if ( (++count >= LENGTH) && (std::memcmp(last, terminator, LENGTH) == 0) )
+      {
+         return true;
+      }
+      c = get();
+   }
+   return false;
+}
+
+bool ossimXmlStreamParser::skipWhiteSpace()
+{
+   int c = peek();
+   while ( isXmlSpace(c) )
+   {
+      get();
+      c = peek();
+   }
+   return (c >= 0);
+}
+
+bool ossimXmlStreamParser::appendUntil(std::string& s, char stop)
+{
+   while ( (thePos < theEnd) || fill() )
+   {
+      const char* start = &theBuffer[thePos];
+      const char* found =
+         static_cast<const char*>(std::memchr(start, stop, theEnd - thePos));
+      const size_t COUNT = found ? (size_t)(found - start) : (theEnd - thePos);
+      s.append(start, COUNT);
+      thePos    += COUNT;
+      theOffset += COUNT;
+      if ( found )
+      {
+         return true;
+      }
+   }
+   return false;
+}
+
+bool ossimXmlStreamParser::readName(ossimString& name, bool attribute)
+{
+   std::string& s = name.string();
+   s.clear();
+   int c = peek();
+   while ( (c >= 0) && !isXmlSpace(c) && (c != '<') && (c != '>') &&
+           (c != '/') && !(attribute && (c == '=')) )
+   {
+      s += (char)c;
+      get();
+      c = peek();
+   }
+   return !s.empty();
+}
+
+bool ossimXmlStreamParser::readAttributes(bool& emptyElement)
+{
+   theAttributes.clear();
+   emptyElement = false;
+   while ( skipWhiteSpace() )
+   {
+      int c = peek();
+      if ( c == '>' )
+      {
+         get();
+         return true;
+      }
+      if ( c == '/' )
+      {
+         get();
+         emptyElement = true;
+         return (get() == '>');
+      }
+
+      theAttributes.push_back(std::make_pair(ossimString(), ossimString()));
+      std::pair<ossimString, ossimString>& attribute = theAttributes.back();
+      if ( !readName(attribute.first, true) || !skipWhiteSpace() ||
+           (get() != '=') || !skipWhiteSpace() )
+      {
+         return false;
+      }
+      const int QUOTE = get();
+      if ( (QUOTE != '"') && (QUOTE != '\'') )
+      {
+         return false;
+      }
+      if ( !appendUntil(attribute.second.string(), (char)QUOTE) )
+      {
+         return false;
+      }
+      get(); // Closing quote.
+   }
+   return false;
+}
+
+bool ossimXmlStreamParser::readText(ossimXmlStreamHandler& handler)
+{
+   theText.clear();
+   skipWhiteSpace();
+   const bool FOUND = appendUntil(theText.string(), '<');
+   if ( theText.size() && theOpenTags.size() && !handler.text(theText, false) )
+   {
+      theStoppedFlag = true;
+      return false;
+   }
+   return FOUND;
+}
+
+bool ossimXmlStreamParser::readBang(ossimXmlStreamHandler& handler)
+{
+   // At "<!":
+   int c = get();
+   if ( c == '-' ) // "<!--" comment
+   {
+      return (get() == '-') && skipPast("-->");
+   }
+   if ( c == '[' ) // "<![CDATA[" section
+   {
+      const char* CDATA = "CDATA[";
+      for (const char* p = CDATA; *p; ++p)
+      {
+         if ( get() != *p )
+         {
+            return false;
+         }
+      }
+      std::string& text = theText.string();
+      text.clear();
+      while ( appendUntil(text, '>') )
+      {
+         get();
+         const size_t SIZE = text.size();
+         if ( (SIZE >= 2) && (text[SIZE-1] == ']') && (text[SIZE-2] == ']') )
+         {
+            text.erase(SIZE - 2);
+            if ( theOpenTags.size() && !handler.text(theText, true) )
+            {
+               theStoppedFlag = true;
+               return false;
+            }
+            return true;
+         }
+         text += '>';
+      }
+      return false;
+   }
+
+   // Declaration, e.g. <!DOCTYPE ...>, possibly with nested <...>:
+   int depth = 1;
+   while ( (depth > 0) && (c >= 0) )
+   {
+      if ( c == '<' )
+      {
+         ++depth;
+      }
+      else if ( c == '>' )
+      {
+         --depth;
+      }
+      if ( depth > 0 )
+      {
+         c = get();
+      }
+   }
+   return (depth == 0);
+}
+
+bool ossimXmlStreamParser::parse(std::istream& in, ossimXmlStreamHandler& handler)
+{
+   theStream = &in;
+   thePos = 0;
+   theEnd = 0;
+   theOffset = 0;
+   theStoppedFlag = false;
+   theOpenTags.clear();
+
+   bool result = false;
+   bool started = false;
+   int c = peek();
+   while ( (c >= 0) && !theStoppedFlag )
+   {
+      if ( c != '<' )
+      {
+         if ( !started )
+         {
+            get(); // Skip anything ahead of the root, e.g. a byte order mark.
+         }
+         else if ( !readText(handler) )
+         {
+            break;
+         }
+      }
+      else
+      {
+         get();
+         c = peek();
+         if ( c == '?' ) // Processing instruction or <?xml ...?>
+         {
+            if ( !skipPast("?>") )
+            {
+               break;
+            }
+         }
+         else if ( c == '!' )
+         {
+            get();
+            if ( !readBang(handler) )
+            {
+               break;
+            }
+         }
+         else if ( c == '/' ) // End tag
+         {
+            get();
+            if ( !readName(theTag, false) || !skipWhiteSpace() || (get() != '>') ||
+                 theOpenTags.empty() || (theOpenTags.back() != theTag) )
+            {
+               break;
+            }
+            theOpenTags.pop_back();
+            if ( !handler.endElement(theTag) )
+            {
+               theStoppedFlag = true;
+            }
+            else if ( theOpenTags.empty() )
+            {
+               result = true;
+               break;
+            }
+         }
+         else // Start tag
+         {
+            bool emptyElement = false;
+            if ( !readName(theTag, false) || !readAttributes(emptyElement) )
+            {
+               break;
+            }
+            started = true;
+            if ( !handler.startElement(theTag, theAttributes) ||
+                 (emptyElement && !handler.endElement(theTag)) )
+            {
+               theStoppedFlag = true;
+            }
+            else if ( !emptyElement )
+            {
+               theOpenTags.push_back(theTag);
+            }
+            else if ( theOpenTags.empty() )
+            {
+               result = true;
+               break;
+            }
+         }
+      }
+      c = peek();
+   }
+
+   theStream = 0;
+   if ( !result && !theStoppedFlag && traceDebug() )
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimXmlStreamParser::parse: malformed XML near byte "
+         << theOffset << std::endl;
+   }
+   return (result || theStoppedFlag);
+}
@@ -36,6 +36,7 @@ ossimDtedHandler::ossimDtedHandler(const ossimFilename& dted_file, bool memoryMa
    :
       ossimElevCellHandler(dted_file),
       m_fileStr(),
+      m_file(),
       m_numLonLines(0),
       m_numLatPoints(0),
       m_dtedRecordSizeInBytes(0),
@@ -114,13 +115,13 @@ bool ossimDtedHandler::getAccuracyInfo(ossimElevationAccuracyInfo& info,
 
 double ossimDtedHandler::getHeightAboveMSL(const ossimGpt& gpt)
 {
-   if(m_fileStr.is_open())
+   if(m_memoryMap.valid())
    {
-      return getHeightAboveMSL(gpt, true);
+      return getHeightAboveMSL(gpt, false);
    }
-   else if(m_memoryMap.size())
+   else if(isOpen())
    {
-      return getHeightAboveMSL(gpt, false);
+      return getHeightAboveMSL(gpt, true);
    }
    
    return ossim::nan();
@@ -173,10 +174,20 @@ bool ossimDtedHandler::open(const ossimFilename& file, bool memoryMapFlag)
    }
    if(memoryMapFlag)
    {
-      m_fileStr.seekg(0);
-      m_fileStr.clear();
-      m_memoryMap.resize(theFilename.fileSize());
-      m_fileStr.read((char*)(&m_memoryMap.front()), (std::streamsize)m_memoryMap.size());
+      // Falls back to reading through the stream if the cell can't be mapped.
+      m_memoryMap = new ossimMemoryMappedFile();
+      if(m_memoryMap->open(theFilename))
+      {
+         m_fileStr.close();
+      }
+      else
+      {
+         m_memoryMap = 0;
+      }
+   }
+   if(!m_memoryMap.valid() && m_file.open(theFilename))
+   {
+      // Posts are read positionally from here on, without m_fileStrMutex.
       m_fileStr.close();
    }
    
@@ -288,7 +299,11 @@ double ossimDtedHandler::getHeightAboveMSL(const ossimGpt& gpt, bool readFromFil
    }
    else
    {
-     ossim_uint8* buf = &m_memoryMap.front();
+     if ( (ossim_uint64)(offset + m_dtedRecordSizeInBytes + 2*POST_SIZE) > m_memoryMap->size() )
+     {
+        return ossim::nan(); // Truncated cell.
+     }
+     const ossim_uint8* buf = m_memoryMap->data();
      {
        ossim_uint16 us;
 
@@ -329,6 +344,26 @@ double ossimDtedHandler::getHeightAboveMSL(const ossimGpt& gpt, bool readFromFil
 
 void ossimDtedHandler::readPostsFromFile( DtedHeight &postData, int offset)
 {
+  if ( m_file.isOpen() )
+  {
+    // The two posts of a column are adjacent in its record.
+    int postCount = 0;
+    for ( int column = 0; column < NUM_POSTS_PER_BLOCK ; ++column )
+    {
+      ossim_uint16 us[NUM_POSTS_PER_BLOCK];
+      if ( m_file.read( offset, us, sizeof(us) ) )
+      {
+        for ( int row = 0; row < NUM_POSTS_PER_BLOCK ; ++row )
+        {
+          postData.m_posts[postCount+row].m_height = convertSignedMagnitude( us[row] );
+          postData.m_posts[postCount+row].m_status = true;
+        }
+      }
+      postCount += NUM_POSTS_PER_BLOCK;
+      offset += m_dtedRecordSizeInBytes;
+    }
+    return;
+  }
 
   OpenThreads::ScopedLock <OpenThreads::Mutex> lock( m_fileStrMutex );
   ossim_sint16 ss;
@@ -389,13 +424,32 @@ double ossimDtedHandler::getPostValue(const ossimIpt& gridPt) const
       m_offsetToFirstDataRecord + gridPt.x * m_dtedRecordSizeInBytes +
       gridPt.y * 2 + DATA_RECORD_OFFSET_TO_POST;
    
-   // Put the file pointer at the start of the first elevation post.
-   m_fileStr.seekg(offset, std::ios::beg);
+   ossim_uint16 us = 0;
+   if (m_memoryMap.valid())
+   {
+      if ( (ossim_uint64)(offset + POST_SIZE) > m_memoryMap->size() )
+      {
+         return ossim::nan();
+      }
+      memcpy(&us, m_memoryMap->data() + offset, POST_SIZE);
+   }
+   else if (m_file.isOpen())
+   {
+      if ( !m_file.read(offset, &us, POST_SIZE) )
+      {
+         return ossim::nan();
+      }
+   }
+   else
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_fileStrMutex);
 
-   ossim_uint16 us;
+      // Put the file pointer at the start of the first elevation post.
+      m_fileStr.seekg(offset, std::ios::beg);
 
-   // Get the post.
-   m_fileStr.read((char*)&us, POST_SIZE);
+      // Get the post.
+      m_fileStr.read((char*)&us, POST_SIZE);
+   }
    
    return double(convertSignedMagnitude(us));
 }
@@ -435,7 +489,7 @@ void ossimDtedHandler::gatherStatistics()
       theMinHeightAboveMSL = atoi(min_str);
       theMaxHeightAboveMSL = atoi(max_str);
    }
-   else if (theComputeStatsFlag&&!m_memoryMap.size())  // Scan the cell and gather the statistics...
+   else if (theComputeStatsFlag&&!m_memoryMap.valid())  // Scan the cell and gather the statistics...
    {
       if(traceDebug())
       {
@@ -73,6 +73,12 @@ double ossimElevCellHandler::getMeanSpacingMeters() const
    return theMeanSpacing;
 }
 
+ossim_uint64 ossimElevCellHandler::getSizeInBytes() const
+{
+   ossimIpt size = getSizeOfElevCell();
+   return (size.x > 0 && size.y > 0) ? (ossim_uint64)size.x * size.y * sizeof(ossim_sint16) : 0;
+}
+
 bool ossimElevCellHandler::getAccuracyInfo(ossimElevationAccuracyInfo& info,
                                            const ossimGpt& /* gpt*/ ) const
 {
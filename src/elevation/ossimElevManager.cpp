@@ -28,8 +28,14 @@
 #include <ossim/base/ossimTrace.h>
 #include <ossim/base/ossimGeoidManager.h>
 #include <ossim/elevation/ossimElevationDatabaseRegistry.h>
+#include <OpenThreads/Thread>
 #include <ossim/base/ossimKeywordNames.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <ossim/parallel/ossimJobQueue.h>
 #include <algorithm>
+#include <cmath>
+#include <set>
 
 //ossimElevManager* ossimElevManager::m_instance = 0;
 static ossimTrace traceDebug("ossimElevManager:debug");
@@ -84,6 +90,12 @@ ossimElevManager::ossimElevManager()
     m_useGeoidIfNullFlag(false),
     m_useStandardPaths(false),
     m_currentDatabaseIdx(0),
+    m_generation(1),
+    m_queryStatisticsFlag(false),
+    m_prefetchQueue(0),
+    m_prefetchesPending(0),
+    m_prefetchMutex(),
+    m_prefetchGaps(),
     m_mutex()
 {
    //---
@@ -98,6 +110,36 @@ ossimElevManager::~ossimElevManager()
    clear();
 }
 
+// Runs one prefetch() on the prefetch queue's thread.
+class ossimElevManager::PrefetchJob : public ossimJob
+{
+public:
+   PrefetchJob(ossimElevManager* manager,
+               const ossimElevManager::ElevationDatabaseListType& databases,
+               const ossimGrect& aoi,
+               double probeSpacing)
+      : ossimJob(),
+        m_manager(manager),
+        m_databases(databases),
+        m_aoi(aoi),
+        m_probeSpacing(probeSpacing)
+   {
+   }
+
+   virtual void start()
+   {
+      m_manager->runPrefetch(this, m_databases, m_aoi, m_probeSpacing);
+      m_databases.clear();
+      --m_manager->m_prefetchesPending;
+   }
+
+private:
+   ossimElevManager*                           m_manager;
+   ossimElevManager::ElevationDatabaseListType m_databases;
+   ossimGrect                                  m_aoi;
+   double                                      m_probeSpacing;
+};
+
 double ossimElevManager::getHeightAboveEllipsoid(const ossimGpt& gpt)
 {
    double result = ossim::nan();
@@ -105,13 +147,22 @@ double ossimElevManager::getHeightAboveEllipsoid(const ossimGpt& gpt)
    if (!isSourceEnabled())
       return result;
 
-   ElevationDatabaseListType& elevDbList = getNextElevDbList();
-   for (ossim_uint32 idx = 0; (idx < elevDbList.size()) && ossim::isnan(result); ++idx)
+   const bool STATS = m_queryStatisticsFlag;
+   const ossimTimer::Timer_t BEGIN = STATS ? ossimTimer::instance()->tick() : 0;
+
+   if (!getLastCellHeight(gpt, true, result))
    {
-      result = elevDbList[idx]->getHeightAboveEllipsoid(gpt);
+      ElevationDatabaseListType& elevDbList = getNextElevDbList();
+      for (ossim_uint32 idx = 0; (idx < elevDbList.size()) && ossim::isnan(result); ++idx)
+      {
+         result = elevDbList[idx]->getHeightAboveEllipsoid(gpt);
+         if ((idx == 0) && !ossim::isnan(result))
+            setLastCell(elevDbList[0].get(), gpt);
+      }
    }
 
-   if (ossim::isnan(result))
+   const bool COVERED = !ossim::isnan(result);
+   if (!COVERED)
    {
       // No elevation value was returned from the database, so try next best alternatives depending
       // on ossim_preferences settings. Priority goes to default ellipsoid height if available:
@@ -121,7 +172,10 @@ double ossimElevManager::getHeightAboveEllipsoid(const ossimGpt& gpt)
       }
       else if (m_useGeoidIfNullFlag)
       {
+         const ossimTimer::Timer_t GEOID_BEGIN = STATS ? ossimTimer::instance()->tick() : 0;
          result = ossimGeoidManager::instance()->offsetFromEllipsoid(gpt);
+         if (STATS)
+            addGeoidQueries(1, GEOID_BEGIN, ossimTimer::instance()->tick());
       }
    }
 
@@ -130,6 +184,9 @@ double ossimElevManager::getHeightAboveEllipsoid(const ossimGpt& gpt)
    if (!ossim::isnan(m_elevationOffset) && !ossim::isnan(result))
       result += m_elevationOffset;
 
+   if (STATS)
+      addQueries(1, COVERED ? 0 : 1, BEGIN, ossimTimer::instance()->tick());
+
    return result;
 }
 
@@ -140,13 +197,22 @@ double ossimElevManager::getHeightAboveMSL(const ossimGpt& gpt)
    if (!isSourceEnabled())
       return result;
 
-   ElevationDatabaseListType& elevDbList = getNextElevDbList();
-   for (ossim_uint32 idx = 0; (idx < elevDbList.size()) && ossim::isnan(result); ++idx)
+   const bool STATS = m_queryStatisticsFlag;
+   const ossimTimer::Timer_t BEGIN = STATS ? ossimTimer::instance()->tick() : 0;
+
+   if (!getLastCellHeight(gpt, false, result))
    {
-      result = elevDbList[idx]->getHeightAboveMSL(gpt);
+      ElevationDatabaseListType& elevDbList = getNextElevDbList();
+      for (ossim_uint32 idx = 0; (idx < elevDbList.size()) && ossim::isnan(result); ++idx)
+      {
+         result = elevDbList[idx]->getHeightAboveMSL(gpt);
+         if ((idx == 0) && !ossim::isnan(result))
+            setLastCell(elevDbList[0].get(), gpt);
+      }
    }
 
-   if (ossim::isnan(result) && m_useGeoidIfNullFlag)
+   const bool COVERED = !ossim::isnan(result);
+   if (!COVERED && m_useGeoidIfNullFlag)
    {
       // No elevation value was returned from the database, so try next best alternatives depending
       // on ossim_preferences settings. First default to height at MSL itself:
@@ -155,7 +221,10 @@ double ossimElevManager::getHeightAboveMSL(const ossimGpt& gpt)
       {
          // Use the default height above ellipsoid corrected for best guess of MSL above ellipsoid
          // (i.e., the geoid):
+         const ossimTimer::Timer_t GEOID_BEGIN = STATS ? ossimTimer::instance()->tick() : 0;
          double dh = ossimGeoidManager::instance()->offsetFromEllipsoid(gpt);
+         if (STATS)
+            addGeoidQueries(1, GEOID_BEGIN, ossimTimer::instance()->tick());
          if (!ossim::isnan(dh))
             result = m_defaultHeightAboveEllipsoid - dh;
       }
@@ -165,9 +234,284 @@ double ossimElevManager::getHeightAboveMSL(const ossimGpt& gpt)
    if (!ossim::isnan(result) && (!ossim::isnan(m_elevationOffset)))
       result += m_elevationOffset;
 
+   if (STATS)
+      addQueries(1, COVERED ? 0 : 1, BEGIN, ossimTimer::instance()->tick());
+
+   return result;
+}
+
+ossim_uint32 ossimElevManager::getThreadSlot()
+{
+   // Threads not created through OpenThreads (e.g. the main thread) all share slot 0.
+   ossim_uint64 id = (ossim_uint64)(size_t)OpenThreads::Thread::CurrentThread();
+   id ^= (id >> 17);
+   id *= 0x9E3779B97F4A7C15ULL;
+   return (ossim_uint32)((id >> 32) % LAST_CELL_SLOTS);
+}
+
+ossimElevManager::LastCell& ossimElevManager::getLastCell() const
+{
+   return m_lastCells[getThreadSlot()];
+}
+
+bool ossimElevManager::getLastCellHeight(const ossimGpt& gpt, bool ellipsoidFlag, double& height)
+{
+   LastCell& cell = getLastCell();
+   if (cell.m_mutex.trylock() != 0)
+      return false; // Another thread on this slot.
+
+   bool result = false;
+   if ( cell.m_handler.valid() &&
+        (cell.m_generation == static_cast<unsigned>(m_generation)) &&
+        cell.m_database->isSourceEnabled() &&
+        cell.m_handler->pointHasCoverage(gpt) )
+   {
+      height = cell.m_handler->getHeightAboveMSL(gpt);
+      if (!ossim::isnan(height))
+      {
+         if (ellipsoidFlag)
+            height += cell.m_database->getOffsetFromEllipsoid(gpt);
+         ++cell.m_hits;
+         result = true;
+      }
+   }
+   cell.m_mutex.unlock();
    return result;
 }
 
+void ossimElevManager::setLastCell(ossimElevationDatabase* database, const ossimGpt& gpt)
+{
+   ossimElevationCellDatabase* cellDb = dynamic_cast<ossimElevationCellDatabase*>(database);
+   if (!cellDb)
+      return;
+
+   ossimRefPtr<ossimElevCellHandler> handler = cellDb->getOrCreateCellHandler(gpt);
+   if (!handler.valid())
+      return;
+
+   LastCell& cell = getLastCell();
+   if (cell.m_mutex.trylock() == 0)
+   {
+      cell.m_generation = m_generation;
+      cell.m_database = database;
+      cell.m_handler = handler;
+      cell.m_mutex.unlock();
+   }
+}
+
+void ossimElevManager::getDatabaseHeights(const ossimGpt* gpts,
+                                          double* heights,
+                                          ossim_uint32 count,
+                                          bool ellipsoidFlag)
+{
+   for (ossim_uint32 i = 0; i < count; ++i)
+      heights[i] = ossim::nan();
+
+   if (!isSourceEnabled() || !count)
+      return;
+
+   ElevationDatabaseListType& elevDbList = getNextElevDbList();
+   if (elevDbList.empty())
+      return;
+
+   // The first database sees every point, the rest only what is still null:
+   if (ellipsoidFlag)
+      elevDbList[0]->getHeightsAboveEllipsoid(gpts, heights, count);
+   else
+      elevDbList[0]->getHeightsAboveMSL(gpts, heights, count);
+
+   std::vector<ossim_uint32> pending;
+   std::vector<ossimGpt> pts;
+   std::vector<double> values;
+   for (ossim_uint32 idx = 1; idx < elevDbList.size(); ++idx)
+   {
+      pending.clear();
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         if (ossim::isnan(heights[i]))
+            pending.push_back(i);
+      }
+      if (pending.empty())
+         break;
+
+      ossim_uint32 n = (ossim_uint32) pending.size();
+      pts.resize(n);
+      values.resize(n);
+      for (ossim_uint32 i = 0; i < n; ++i)
+         pts[i] = gpts[pending[i]];
+
+      if (ellipsoidFlag)
+         elevDbList[idx]->getHeightsAboveEllipsoid(&pts.front(), &values.front(), n);
+      else
+         elevDbList[idx]->getHeightsAboveMSL(&pts.front(), &values.front(), n);
+
+      for (ossim_uint32 i = 0; i < n; ++i)
+         heights[pending[i]] = values[i];
+   }
+}
+
+void ossimElevManager::getHeightsAboveEllipsoid(const ossimGpt* gpts,
+                                                double* heights,
+                                                ossim_uint32 count)
+{
+   const bool STATS = m_queryStatisticsFlag;
+   const ossimTimer::Timer_t BEGIN = STATS ? ossimTimer::instance()->tick() : 0;
+
+   getDatabaseHeights(gpts, heights, count, true);
+   if (!isSourceEnabled())
+      return;
+
+   // Same fallbacks as the single point call, with one geoid pass for all nulls:
+   ossim_uint32 nulls = 0;
+   std::vector<ossim_uint32> pending;
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      if (ossim::isnan(heights[i]))
+      {
+         ++nulls;
+         if (!ossim::isnan(m_defaultHeightAboveEllipsoid))
+            heights[i] = m_defaultHeightAboveEllipsoid;
+         else if (m_useGeoidIfNullFlag)
+            pending.push_back(i);
+      }
+   }
+   if (!pending.empty())
+   {
+      ossim_uint32 n = (ossim_uint32) pending.size();
+      std::vector<ossimGpt> pts(n);
+      std::vector<double> offsets(n);
+      for (ossim_uint32 i = 0; i < n; ++i)
+         pts[i] = gpts[pending[i]];
+      const ossimTimer::Timer_t GEOID_BEGIN = STATS ? ossimTimer::instance()->tick() : 0;
+      ossimGeoidManager::instance()->offsetsFromEllipsoid(&pts.front(), &offsets.front(), n);
+      if (STATS)
+         addGeoidQueries(n, GEOID_BEGIN, ossimTimer::instance()->tick());
+      for (ossim_uint32 i = 0; i < n; ++i)
+         heights[pending[i]] = offsets[i];
+   }
+
+   if (!ossim::isnan(m_elevationOffset))
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         if (!ossim::isnan(heights[i]))
+            heights[i] += m_elevationOffset;
+      }
+   }
+
+   if (STATS)
+      addQueries(count, nulls, BEGIN, ossimTimer::instance()->tick());
+}
+
+void ossimElevManager::getHeightsAboveMSL(const ossimGpt* gpts,
+                                          double* heights,
+                                          ossim_uint32 count)
+{
+   const bool STATS = m_queryStatisticsFlag;
+   const ossimTimer::Timer_t BEGIN = STATS ? ossimTimer::instance()->tick() : 0;
+
+   getDatabaseHeights(gpts, heights, count, false);
+   if (!isSourceEnabled())
+      return;
+
+   ossim_uint32 nulls = 0;
+   if (STATS)
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         if (ossim::isnan(heights[i]))
+            ++nulls;
+      }
+   }
+
+   if (m_useGeoidIfNullFlag)
+   {
+      std::vector<ossim_uint32> pending;
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         if (ossim::isnan(heights[i]))
+         {
+            heights[i] = 0.0; // MSL
+            pending.push_back(i);
+         }
+      }
+      if (!pending.empty() && !ossim::isnan(m_defaultHeightAboveEllipsoid))
+      {
+         ossim_uint32 n = (ossim_uint32) pending.size();
+         std::vector<ossimGpt> pts(n);
+         std::vector<double> offsets(n);
+         for (ossim_uint32 i = 0; i < n; ++i)
+            pts[i] = gpts[pending[i]];
+         const ossimTimer::Timer_t GEOID_BEGIN = STATS ? ossimTimer::instance()->tick() : 0;
+         ossimGeoidManager::instance()->offsetsFromEllipsoid(&pts.front(), &offsets.front(), n);
+         if (STATS)
+            addGeoidQueries(n, GEOID_BEGIN, ossimTimer::instance()->tick());
+         for (ossim_uint32 i = 0; i < n; ++i)
+         {
+            if (!ossim::isnan(offsets[i]))
+               heights[pending[i]] = m_defaultHeightAboveEllipsoid - offsets[i];
+         }
+      }
+   }
+
+   if (!ossim::isnan(m_elevationOffset))
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         if (!ossim::isnan(heights[i]))
+            heights[i] += m_elevationOffset;
+      }
+   }
+
+   if (STATS)
+      addQueries(count, nulls, BEGIN, ossimTimer::instance()->tick());
+}
+
+void ossimElevManager::makeGrid(const ossimGpt& origin,
+                                const ossimDpt& spacing,
+                                ossim_uint32 width,
+                                ossim_uint32 height,
+                                std::vector<ossimGpt>& gpts)
+{
+   gpts.resize(width*height);
+   ossimGpt gpt(origin);
+   for (ossim_uint32 row = 0; row < height; ++row)
+   {
+      gpt.lat = origin.lat + row*spacing.y;
+      for (ossim_uint32 col = 0; col < width; ++col)
+      {
+         gpt.lon = origin.lon + col*spacing.x;
+         gpts[row*width + col] = gpt;
+      }
+   }
+}
+
+void ossimElevManager::getHeightsAboveEllipsoid(const ossimGpt& origin,
+                                                const ossimDpt& spacing,
+                                                ossim_uint32 width,
+                                                ossim_uint32 height,
+                                                double* heights)
+{
+   if (!width || !height)
+      return;
+   std::vector<ossimGpt> gpts;
+   makeGrid(origin, spacing, width, height, gpts);
+   getHeightsAboveEllipsoid(&gpts.front(), heights, width*height);
+}
+
+void ossimElevManager::getHeightsAboveMSL(const ossimGpt& origin,
+                                          const ossimDpt& spacing,
+                                          ossim_uint32 width,
+                                          ossim_uint32 height,
+                                          double* heights)
+{
+   if (!width || !height)
+      return;
+   std::vector<ossimGpt> gpts;
+   makeGrid(origin, spacing, width, height, gpts);
+   getHeightsAboveMSL(&gpts.front(), heights, width*height);
+}
+
 void ossimElevManager::loadStandardElevationPaths()
 {
    if (!m_useStandardPaths)
@@ -346,8 +690,164 @@ void ossimElevManager::getCellsForBounds( const ossimGrect& bbox,
    getCellsForBounds(bbox.lr().lat, bbox.ul().lon, bbox.ul().lat, bbox.lr().lon, cells, maxCells);
 }
 
+void ossimElevManager::prefetch(const ossimGrect& aoi, double probeSpacing)
+{
+   if ( aoi.isLonLatNan() || !(probeSpacing > 0.0) || m_dbRoundRobin.empty() ||
+        m_dbRoundRobin[0].empty() )
+   {
+      return;
+   }
+
+   // The job keeps its own list so databases added or cleared meanwhile do not matter.
+   ossimRefPtr<ossimJob> job = new PrefetchJob(this, m_dbRoundRobin[0], aoi, probeSpacing);
+   job->setName("ossimElevManager::prefetch");
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_prefetchMutex);
+      if (!m_prefetchQueue.valid())
+      {
+         m_prefetchQueue = new ossimJobMultiThreadQueue(new ossimJobQueue(), 1);
+      }
+      ++m_prefetchesPending;
+      m_prefetchQueue->getJobQueue()->add(job.get());
+   }
+}
+
+bool ossimElevManager::isPrefetching() const
+{
+   return (static_cast<unsigned>(m_prefetchesPending) != 0);
+}
+
+void ossimElevManager::waitForPrefetch() const
+{
+   while ( isPrefetching() )
+   {
+      OpenThreads::Thread::microSleep(1000);
+   }
+}
+
+void ossimElevManager::getPrefetchGaps(std::vector<ossimGrect>& gaps) const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_prefetchMutex);
+   gaps = m_prefetchGaps;
+}
+
+void ossimElevManager::runPrefetch(ossimJob* job,
+                                   ElevationDatabaseListType& databases,
+                                   const ossimGrect& aoi,
+                                   double probeSpacing)
+{
+   const double north = aoi.ul().lat;
+   const double west  = aoi.ul().lon;
+   const double south = aoi.lr().lat;
+   const double east  = aoi.lr().lon;
+   const ossim_uint32 rows = std::max(1, (int)std::ceil((north - south) / probeSpacing));
+   const ossim_uint32 cols = std::max(1, (int)std::ceil((east - west) / probeSpacing));
+
+   // Cells opened per cell database, to stay under its max open cells.
+   std::vector< std::set<ossim_uint64> > opened(databases.size());
+   bool limited = false;
+   std::vector<ossimGrect> gaps;
+
+   for (ossim_uint32 row = 0; (row < rows) && !job->isCanceled(); ++row)
+   {
+      const double top    = north - row * probeSpacing;
+      const double bottom = std::max(south, top - probeSpacing);
+      ossim_int32 gapStart = -1;
+
+      // One past the last column closes a gap running to the east edge.
+      for (ossim_uint32 col = 0; col <= cols; ++col)
+      {
+         bool covered = true;
+         if (col < cols)
+         {
+            const double left  = west + col * probeSpacing;
+            const double right = std::min(east, left + probeSpacing);
+            const ossimGpt gpt((top + bottom) * 0.5, (left + right) * 0.5);
+
+            covered = false;
+            for (ossim_uint32 idx = 0; (idx < databases.size()) && !covered; ++idx)
+            {
+               ossimElevationDatabase* db = databases[idx].get();
+               if (!db || !db->pointHasCoverage(gpt))
+                  continue;
+               covered = true;
+
+               ossimElevationCellDatabase* cellDb = dynamic_cast<ossimElevationCellDatabase*>(db);
+               if (cellDb)
+               {
+                  ossim_uint64 id = cellDb->createId(gpt);
+                  if (opened[idx].find(id) != opened[idx].end())
+                     continue;
+                  if (cellDb->getMaxOpenCells() && (opened[idx].size() >= cellDb->getMaxOpenCells()))
+                  {
+                     limited = true;
+                     continue;
+                  }
+                  opened[idx].insert(id);
+               }
+
+               // A first lookup opens the cell and reads its posts around gpt.
+               db->getHeightAboveMSL(gpt);
+            }
+         }
+
+         if (!covered && (gapStart < 0))
+         {
+            gapStart = (ossim_int32)col;
+         }
+         else if (covered && (gapStart >= 0))
+         {
+            gaps.push_back(ossimGrect(ossimGpt(top, west + gapStart * probeSpacing),
+                                      ossimGpt(bottom, std::min(east, west + col * probeSpacing))));
+            gapStart = -1;
+         }
+      }
+   }
+
+   if (limited)
+   {
+      ossimNotify(ossimNotifyLevel_NOTICE)
+         << "ossimElevManager::prefetch NOTICE: Stopped opening cells at max_open_cells for "
+         << aoi << "\n";
+   }
+   if (!gaps.empty())
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimElevManager::prefetch WARN: No elevation coverage for " << gaps.size()
+         << " area(s) of " << aoi << ":\n";
+      for (ossim_uint32 i = 0; i < gaps.size(); ++i)
+      {
+         ossimNotify(ossimNotifyLevel_WARN) << "   " << gaps[i] << "\n";
+      }
+   }
+   if (traceDebug())
+   {
+      ossim_uint64 cells = 0;
+      for (ossim_uint32 i = 0; i < opened.size(); ++i)
+         cells += opened[i].size();
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimElevManager::prefetch: " << aoi << " cells warmed: " << cells
+         << " gaps: " << gaps.size() << std::endl;
+   }
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_prefetchMutex);
+   m_prefetchGaps.insert(m_prefetchGaps.end(), gaps.begin(), gaps.end());
+}
+
 void ossimElevManager::clear()
 {
+   ++m_generation;
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_prefetchMutex);
+      m_prefetchGaps.clear();
+   }
+   for (ossim_uint32 slot = 0; slot < LAST_CELL_SLOTS; ++slot)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_lastCells[slot].m_mutex);
+      m_lastCells[slot].m_database = 0;
+      m_lastCells[slot].m_handler = 0;
+   }
+
    std::vector<ElevationDatabaseListType>::iterator i = m_dbRoundRobin.begin();
    while ( i != m_dbRoundRobin.end() )
    {
@@ -356,6 +856,227 @@ void ossimElevManager::clear()
    }
 }
 
+ossim_uint64 ossimElevManager::getLastCellHits() const
+{
+   ossim_uint64 hits = 0;
+   for (ossim_uint32 slot = 0; slot < LAST_CELL_SLOTS; ++slot)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_lastCells[slot].m_mutex);
+      hits += m_lastCells[slot].m_hits;
+   }
+   return hits;
+}
+
+bool ossimElevManager::getCacheStatistics(ossim_uint32 idx,
+                                          ossim_uint64& hits,
+                                          ossim_uint64& misses) const
+{
+   hits = 0;
+   misses = 0;
+   bool result = false;
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   std::vector<ElevationDatabaseListType>::const_iterator rri = m_dbRoundRobin.begin();
+   while ( rri != m_dbRoundRobin.end() )
+   {
+      if (idx < rri->size())
+      {
+         const ossimElevationCellDatabase* cellDb =
+            dynamic_cast<const ossimElevationCellDatabase*>((*rri)[idx].get());
+         if (cellDb)
+         {
+            hits += cellDb->getCacheHits();
+            misses += cellDb->getCacheMisses();
+            result = true;
+         }
+      }
+      ++rri;
+   }
+   return result;
+}
+
+bool ossimElevManager::getCacheStatistics(ossim_uint32 idx,
+                                          ossimElevationCellDatabase::CacheStatistics& stats) const
+{
+   stats = ossimElevationCellDatabase::CacheStatistics();
+   bool result = false;
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   std::vector<ElevationDatabaseListType>::const_iterator rri = m_dbRoundRobin.begin();
+   while ( rri != m_dbRoundRobin.end() )
+   {
+      if (idx < rri->size())
+      {
+         const ossimElevationCellDatabase* cellDb =
+            dynamic_cast<const ossimElevationCellDatabase*>((*rri)[idx].get());
+         if (cellDb)
+         {
+            ossimElevationCellDatabase::CacheStatistics copyStats;
+            cellDb->getCacheStatistics(copyStats);
+            stats += copyStats;
+            result = true;
+         }
+      }
+      ++rri;
+   }
+   return result;
+}
+
+void ossimElevManager::printCacheStatistics(std::ostream& out) const
+{
+   out << "ossimElevManager: last_cell_hits=" << getLastCellHits() << "\n";
+   for (ossim_uint32 idx = 0; idx < getNumberOfElevationDatabases(); ++idx)
+   {
+      ossimElevationCellDatabase::CacheStatistics stats;
+      if (getCacheStatistics(idx, stats))
+      {
+         ossim_uint64 lookups = stats.m_hits + stats.m_misses;
+         out << "   database=" << idx
+             << " " << getElevationDatabase(idx)->getConnectionString()
+             << " open_cells=" << stats.m_openCells
+             << " peak_open_cells=" << stats.m_peakOpenCells
+             << " bytes=" << stats.m_bytes
+             << " peak_bytes=" << stats.m_peakBytes
+             << " hits=" << stats.m_hits
+             << " misses=" << stats.m_misses
+             << " hit_rate=" << (lookups ? (double)stats.m_hits / lookups : 0.0)
+             << " opens=" << stats.m_opens
+             << " coverage_misses=" << stats.m_coverageMisses
+             << " open_seconds=" << stats.m_openSeconds
+             << " evictions=" << stats.m_evictions << "\n";
+      }
+   }
+}
+
+void ossimElevManager::resetCacheStatistics()
+{
+   for (ossim_uint32 slot = 0; slot < LAST_CELL_SLOTS; ++slot)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_lastCells[slot].m_mutex);
+      m_lastCells[slot].m_hits = 0;
+   }
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   std::vector<ElevationDatabaseListType>::iterator rri = m_dbRoundRobin.begin();
+   while ( rri != m_dbRoundRobin.end() )
+   {
+      ElevationDatabaseListType::iterator iter = rri->begin();
+      while ( iter != rri->end() )
+      {
+         ossimElevationCellDatabase* cellDb = dynamic_cast<ossimElevationCellDatabase*>(iter->get());
+         if (cellDb)
+         {
+            cellDb->resetCacheStatistics();
+         }
+         ++iter;
+      }
+      ++rri;
+   }
+}
+
+ossimElevManager::QueryStatistics::QueryStatistics()
+   : m_points(0),
+     m_coverageMisses(0),
+     m_seconds(0.0),
+     m_geoidQueries(0),
+     m_geoidSeconds(0.0),
+     m_rays(0),
+     m_rayIterations(0),
+     m_maxRayIterations(0),
+     m_rayFailures(0)
+{
+}
+
+ossimElevManager::QueryStatistics&
+ossimElevManager::QueryStatistics::operator+=(const QueryStatistics& rhs)
+{
+   m_points           += rhs.m_points;
+   m_coverageMisses   += rhs.m_coverageMisses;
+   m_seconds          += rhs.m_seconds;
+   m_geoidQueries     += rhs.m_geoidQueries;
+   m_geoidSeconds     += rhs.m_geoidSeconds;
+   m_rays             += rhs.m_rays;
+   m_rayIterations    += rhs.m_rayIterations;
+   m_maxRayIterations  = std::max(m_maxRayIterations, rhs.m_maxRayIterations);
+   m_rayFailures      += rhs.m_rayFailures;
+   return *this;
+}
+
+void ossimElevManager::setQueryStatisticsFlag(bool flag)
+{
+   m_queryStatisticsFlag = flag;
+}
+
+void ossimElevManager::addQueries(ossim_uint32 points,
+                                  ossim_uint32 coverageMisses,
+                                  ossimTimer::Timer_t begin,
+                                  ossimTimer::Timer_t end)
+{
+   QuerySlot& slot = m_querySlots[getThreadSlot()];
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(slot.m_mutex);
+   slot.m_stats.m_points         += points;
+   slot.m_stats.m_coverageMisses += coverageMisses;
+   slot.m_stats.m_seconds        += ossimTimer::instance()->delta_s(begin, end);
+}
+
+void ossimElevManager::addGeoidQueries(ossim_uint32 count,
+                                       ossimTimer::Timer_t begin,
+                                       ossimTimer::Timer_t end)
+{
+   QuerySlot& slot = m_querySlots[getThreadSlot()];
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(slot.m_mutex);
+   slot.m_stats.m_geoidQueries += count;
+   slot.m_stats.m_geoidSeconds += ossimTimer::instance()->delta_s(begin, end);
+}
+
+void ossimElevManager::addRayIntersection(ossim_uint32 iterations, bool converged)
+{
+   if (!m_queryStatisticsFlag)
+      return;
+
+   QuerySlot& slot = m_querySlots[getThreadSlot()];
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(slot.m_mutex);
+   ++slot.m_stats.m_rays;
+   slot.m_stats.m_rayIterations += iterations;
+   slot.m_stats.m_maxRayIterations =
+      std::max<ossim_uint64>(slot.m_stats.m_maxRayIterations, iterations);
+   if (!converged)
+      ++slot.m_stats.m_rayFailures;
+}
+
+void ossimElevManager::getQueryStatistics(QueryStatistics& stats) const
+{
+   stats = QueryStatistics();
+   for (ossim_uint32 slot = 0; slot < LAST_CELL_SLOTS; ++slot)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_querySlots[slot].m_mutex);
+      stats += m_querySlots[slot].m_stats;
+   }
+}
+
+void ossimElevManager::resetQueryStatistics()
+{
+   for (ossim_uint32 slot = 0; slot < LAST_CELL_SLOTS; ++slot)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_querySlots[slot].m_mutex);
+      m_querySlots[slot].m_stats = QueryStatistics();
+   }
+}
+
+void ossimElevManager::printQueryStatistics(std::ostream& out) const
+{
+   QueryStatistics stats;
+   getQueryStatistics(stats);
+   out << "ossimElevManager: points=" << stats.m_points
+       << " coverage_misses=" << stats.m_coverageMisses
+       << " seconds=" << stats.m_seconds
+       << " geoid_queries=" << stats.m_geoidQueries
+       << " geoid_seconds=" << stats.m_geoidSeconds
+       << " rays=" << stats.m_rays
+       << " lookups_per_ray="
+       << (stats.m_rays ? (double)stats.m_rayIterations / stats.m_rays : 0.0)
+       << " max_ray_lookups=" << stats.m_maxRayIterations
+       << " ray_failures=" << stats.m_rayFailures << "\n";
+}
+
 void ossimElevManager::accept(ossimVisitor& visitor)
 {
    std::vector<ElevationDatabaseListType>::iterator rri = m_dbRoundRobin.begin();
@@ -445,6 +1166,9 @@ bool ossimElevManager::loadState(const ossimKeywordlist& kwl, const char* prefix
 
    kwl.getBoolKeywordValue(m_useGeoidIfNullFlag, "use_geoid_if_null", copyPrefix.chars());
    kwl.getBoolKeywordValue(m_useStandardPaths, "use_standard_elev_paths", copyPrefix.chars());
+   bool queryStatisticsFlag = m_queryStatisticsFlag;
+   if (kwl.getBoolKeywordValue(queryStatisticsFlag, "query_statistics", copyPrefix.chars()))
+      setQueryStatisticsFlag(queryStatisticsFlag);
 
    if(!elevationOffset.empty())
       m_elevationOffset = elevationOffset.toDouble();
@@ -549,6 +1273,8 @@ bool ossimElevManager::loadState(const ossimKeywordlist& kwl, const char* prefix
 
 void ossimElevManager::setRoundRobinMaxSize(ossim_uint32 new_size)
 {
+   ++m_generation;
+
    m_maxRoundRobinSize = new_size;
 
 #ifdef DYNAMICALLY_ALLOCATE_ROUND_ROBIN
@@ -608,6 +1334,8 @@ void ossimElevManager::addDatabase(ossimElevationDatabase* database, bool set_as
    std::vector<ElevationDatabaseListType>::iterator rri = m_dbRoundRobin.begin();
    if (std::find(rri->begin(), rri->end(), database) == rri->end())
    {
+      ++m_generation;
+
       if (set_as_first)
          rri->insert(rri->begin(), database);
       else
@@ -120,6 +120,14 @@ double ossimElevSource::getHeightAboveEllipsoid(const ossimGpt& /* argGpt */)
 //
 //*****************************************************************************
 bool ossimElevSource::intersectRay(const ossimEcefRay& ray, ossimGpt& gpt, double defaultElevValue)
+{
+   return intersectRayFromHeight(ray, ossim::nan(), gpt, defaultElevValue);
+}
+
+bool ossimElevSource::intersectRayFromHeight(const ossimEcefRay& ray,
+                                             double startHeight,
+                                             ossimGpt& gpt,
+                                             double defaultElevValue)
 {
    if (traceExec())  ossimNotify(ossimNotifyLevel_DEBUG) << "DEBUG ossimElevSource::intersectRay: entering..." << std::endl;
 
@@ -155,6 +163,15 @@ bool ossimElevSource::intersectRay(const ossimEcefRay& ray, ossimGpt& gpt, doubl
 
 //    std::cout << "nadir pt = " << nadirGpt << std::endl;
    
+   //***
+   // Warm start: begin where the ray crosses the given height instead.
+   //***
+   if ( !ossim::isnan(startHeight) &&
+        ellipsoid->nearestIntersection(ray, startHeight, new_intersect_pt) )
+   {
+      prev_intersect_pt = new_intersect_pt;
+   }
+   
    gpt = ossimGpt(prev_intersect_pt, datum);
 
    //
@@ -204,6 +221,8 @@ bool ossimElevSource::intersectRay(const ossimEcefRay& ray, ossimGpt& gpt, doubl
 
    } while ((!done) && (iteration_count < MAX_NUM_ITERATIONS));
 
+   addRayIntersection(iteration_count, done);
+
    if (iteration_count == MAX_NUM_ITERATIONS)
    {
       if(traceDebug())
@@ -217,6 +236,10 @@ bool ossimElevSource::intersectRay(const ossimEcefRay& ray, ossimGpt& gpt, doubl
    return intersected;
 }
 
+void ossimElevSource::addRayIntersection(ossim_uint32 /* iterations */, bool /* converged */)
+{
+}
+
 double ossimElevSource::getMinHeightAboveMSL() const
 {
    return theMinHeightAboveMSL;
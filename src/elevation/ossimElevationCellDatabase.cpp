@@ -1,7 +1,106 @@
 #include <ossim/elevation/ossimElevationCellDatabase.h>
+#include <OpenThreads/Thread>
+#include <algorithm>
 
 RTTI_DEF1(ossimElevationCellDatabase, "ossimElevationCellDatabase", ossimElevationDatabase);
 
+// Slot of the calling thread in m_readers.  Threads not started by OpenThreads (main) share 0.
+static ossim_uint32 readerSlot(ossim_uint32 slots)
+{
+   ossim_uint64 thread = (ossim_uint64) OpenThreads::Thread::CurrentThread();
+   return (ossim_uint32) ((thread >> 6) % slots);
+}
+
+ossimElevationCellDatabase::CellInfo*
+ossimElevationCellDatabase::CellSnapshot::find(ossim_uint64 id)
+{
+   std::vector<ossim_uint64>::const_iterator iter =
+      std::lower_bound(m_ids.begin(), m_ids.end(), id);
+   if((iter != m_ids.end()) && (*iter == id))
+   {
+      return m_cells[iter - m_ids.begin()].get();
+   }
+   return 0;
+}
+
+ossimElevationCellDatabase::~ossimElevationCellDatabase()
+{
+   delete (CellSnapshot*) m_cacheSnapshot.get();
+   for(ossim_uint32 i = 0; i < m_retiredSnapshots.size(); ++i)
+   {
+      delete m_retiredSnapshots[i];
+   }
+   m_retiredSnapshots.clear();
+}
+
+void ossimElevationCellDatabase::publishCacheSnapshot()
+{
+   CellSnapshot* snapshot = new CellSnapshot();
+   snapshot->m_ids.reserve(m_cacheMap.size());
+   snapshot->m_cells.reserve(m_cacheMap.size());
+   ossim_uint64 bytes = 0;
+   CellMap::const_iterator iter = m_cacheMap.begin();
+   while(iter != m_cacheMap.end())
+   {
+      snapshot->m_ids.push_back(iter->first);
+      snapshot->m_cells.push_back(iter->second);
+      if(iter->second->m_handler.valid())
+      {
+         bytes += iter->second->m_handler->getSizeInBytes();
+      }
+      ++iter;
+   }
+   m_cacheBytes = bytes;
+   m_peakCacheBytes = std::max(m_peakCacheBytes, bytes);
+   m_peakOpenCells = std::max<ossim_uint64>(m_peakOpenCells, m_cacheMap.size());
+
+   CellSnapshot* old = (CellSnapshot*) m_cacheSnapshot.get();
+   m_cacheSnapshot.assign(snapshot, old);
+   if(old)
+   {
+      m_retiredSnapshots.push_back(old);
+   }
+
+   // A reader that got in before the swap keeps its slot non zero until it is
+   // done; any that got in after sees the new snapshot.  So once every slot
+   // reads zero nothing can hold a retired one.
+   for(ossim_uint32 i = 0; i < READER_SLOTS; ++i)
+   {
+      if(static_cast<unsigned>(m_readers[i].m_count) != 0)
+      {
+         return;
+      }
+   }
+   for(ossim_uint32 i = 0; i < m_retiredSnapshots.size(); ++i)
+   {
+      delete m_retiredSnapshots[i];
+   }
+   m_retiredSnapshots.clear();
+}
+
+void ossimElevationCellDatabase::flushCacheToMinOpenCells()
+{
+   std::vector<std::pair<std::pair<ossim_uint32, ossimTimer::Timer_t>, ossim_uint64> > age;
+   age.reserve(m_cacheMap.size());
+   CellMap::iterator iter = m_cacheMap.begin();
+   while(iter != m_cacheMap.end())
+   {
+      age.push_back(std::make_pair(
+                       std::make_pair(static_cast<ossim_uint32>(iter->second->m_lastUsed),
+                                      iter->second->m_timestamp),
+                       iter->first));
+      ++iter;
+   }
+   std::sort(age.begin(), age.end());
+   
+   for(ossim_uint32 i = 0; (i < age.size()) && (m_cacheMap.size() > m_minOpenCells); ++i)
+   {
+      CellMap::size_type before = m_cacheMap.size();
+      remove(age[i].second);
+      m_cacheEvictions += (before - m_cacheMap.size());
+   }
+}
+
 void ossimElevationCellDatabase::getOpenCellList(std::vector<ossimFilename>& list) const
 {
    CellMap::const_iterator iter = m_cacheMap.begin();
@@ -14,6 +113,90 @@ void ossimElevationCellDatabase::getOpenCellList(std::vector<ossimFilename>& lis
 
 }
 
+ossim_uint64 ossimElevationCellDatabase::getCacheHits() const
+{
+   ossim_uint64 hits = 0;
+   for(ossim_uint32 i = 0; i < READER_SLOTS; ++i)
+   {
+      hits += static_cast<unsigned>(m_readers[i].m_hits);
+   }
+   return hits;
+}
+
+ossim_uint64 ossimElevationCellDatabase::getCacheMisses() const
+{
+   return static_cast<unsigned>(m_cacheMisses);
+}
+
+ossimElevationCellDatabase::CacheStatistics&
+ossimElevationCellDatabase::CacheStatistics::operator+=(const CacheStatistics& rhs)
+{
+   m_hits          += rhs.m_hits;
+   m_misses        += rhs.m_misses;
+   m_opens         += rhs.m_opens;
+   m_coverageMisses += rhs.m_coverageMisses;
+   m_openSeconds   += rhs.m_openSeconds;
+   m_evictions     += rhs.m_evictions;
+   m_openCells     += rhs.m_openCells;
+   m_peakOpenCells += rhs.m_peakOpenCells;
+   m_bytes         += rhs.m_bytes;
+   m_peakBytes     += rhs.m_peakBytes;
+   return *this;
+}
+
+void ossimElevationCellDatabase::getCacheStatistics(CacheStatistics& stats) const
+{
+   stats.m_hits   = getCacheHits();
+   stats.m_misses = getCacheMisses();
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_cacheMapMutex);
+   stats.m_opens          = m_cacheOpens;
+   stats.m_coverageMisses = m_cacheCoverageMisses;
+   stats.m_openSeconds    = m_cacheOpenTicks * ossimTimer::instance()->getSecondsPerTick();
+   stats.m_evictions     = m_cacheEvictions;
+   stats.m_openCells     = m_cacheMap.size();
+   stats.m_peakOpenCells = m_peakOpenCells;
+   stats.m_bytes         = m_cacheBytes;
+   stats.m_peakBytes     = m_peakCacheBytes;
+}
+
+void ossimElevationCellDatabase::resetCacheStatistics()
+{
+   for(ossim_uint32 i = 0; i < READER_SLOTS; ++i)
+   {
+      m_readers[i].m_hits.exchange(0);
+   }
+   m_cacheMisses.exchange(0);
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_cacheMapMutex);
+   m_cacheOpens          = 0;
+   m_cacheCoverageMisses = 0;
+   m_cacheOpenTicks      = 0;
+   m_cacheEvictions = 0;
+   m_peakOpenCells  = m_cacheMap.size();
+   m_peakCacheBytes = m_cacheBytes;
+}
+
+void ossimElevationCellDatabase::addCacheHit()
+{
+   ++m_readers[readerSlot(READER_SLOTS)].m_hits;
+}
+
+void ossimElevationCellDatabase::addCellOpen(bool opened,
+                                             ossimTimer::Timer_t begin,
+                                             ossimTimer::Timer_t end)
+{
+   m_cacheOpenTicks += end - begin;
+   if(opened)
+   {
+      ++m_cacheOpens;
+   }
+   else
+   {
+      ++m_cacheCoverageMisses;
+   }
+}
+
 void ossimElevationCellDatabase::getCellsForBounds( const ossim_float64& minLat,
                                                     const ossim_float64& minLon,
                                                     const ossim_float64& maxLat,
@@ -94,36 +277,137 @@ ossimRefPtr<ossimElevCellHandler> ossimElevationCellDatabase::getOrCreateCellHan
   ossim_uint64 id = createId(gpt);
   
   {
-    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_cacheMapMutex);
-    CellMap::iterator iter = m_cacheMap.find(id);
-    if(iter != m_cacheMap.end())
+    // Hit path: no lock, the snapshot is only ever replaced.
+    ReaderSlot& slot = m_readers[readerSlot(READER_SLOTS)];
+    ++slot.m_count;
+    CellSnapshot* snapshot = (CellSnapshot*) m_cacheSnapshot.get();
+    CellInfo* cell = snapshot ? snapshot->find(id) : 0;
+    if(cell)
     {
-      iter->second->updateTimestamp();
-      result = iter->second->m_handler.get();
-      
-      return result.get();
+      cell->touch(static_cast<unsigned>(m_cacheEpoch));
+      result = cell->m_handler.get();
+    }
+    --slot.m_count;
+    if(result.valid())
+    {
+      ++slot.m_hits;
+      return result;
     }
   }
   
+  ++m_cacheMisses;
+  const ossimTimer::Timer_t begin = ossimTimer::instance()->tick();
   result = createCell(gpt);
+  const ossimTimer::Timer_t end = ossimTimer::instance()->tick();
   
   {
     OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_cacheMapMutex);
+    addCellOpen(result.valid(), begin, end);
     if(result.valid())
     {
-      m_cacheMap.insert(std::make_pair(id, new CellInfo(id, result.get())));
+      CellMap::iterator iter = m_cacheMap.find(id);
+      if(iter != m_cacheMap.end())
+      {
+        // Another thread opened it first; use theirs.
+        result = iter->second->m_handler.get();
+        return result;
+      }
+      
+      m_cacheMap.insert(std::make_pair(id, new CellInfo(id, result.get(), ++m_cacheEpoch)));
 
       // Check the map size and purge cells if needed.
       if(m_cacheMap.size() > m_maxOpenCells)
       {
          flushCacheToMinOpenCells();
       }
+      publishCacheSnapshot();
     }
   }
 
   return result;
 }
 
+void ossimElevationCellDatabase::getHeightsAboveMSL(const ossimGpt* gpts,
+                                                    double* heights,
+                                                    ossim_uint32 count)
+{
+   if(!isSourceEnabled())
+   {
+      for(ossim_uint32 i = 0; i < count; ++i)
+      {
+         heights[i] = ossim::nan();
+      }
+      return;
+   }
+
+   // Cells used so far, most recent first.
+   std::vector<ossimRefPtr<ossimElevCellHandler> > handlers;
+   
+   for(ossim_uint32 i = 0; i < count; ++i)
+   {
+      const ossimGpt& gpt = gpts[i];
+      ossimRefPtr<ossimElevCellHandler> handler = 0;
+      
+      std::vector<ossimRefPtr<ossimElevCellHandler> >::iterator iter = handlers.begin();
+      while(iter != handlers.end())
+      {
+         if((*iter)->pointHasCoverage(gpt))
+         {
+            handler = *iter;
+            if(iter != handlers.begin())
+            {
+               handlers.erase(iter);
+               handlers.insert(handlers.begin(), handler);
+            }
+            break;
+         }
+         ++iter;
+      }
+      
+      if(!handler.valid())
+      {
+         handler = getOrCreateCellHandler(gpt);
+         if(handler.valid())
+         {
+            handlers.insert(handlers.begin(), handler);
+         }
+      }
+      
+      heights[i] = handler.valid() ? handler->getHeightAboveMSL(gpt) : ossim::nan();
+   }
+}
+
+void ossimElevationCellDatabase::getHeightsAboveEllipsoid(const ossimGpt* gpts,
+                                                          double* heights,
+                                                          ossim_uint32 count)
+{
+   getHeightsAboveMSL(gpts, heights, count);
+
+   // Only look up the geoid where there is a post.
+   std::vector<ossim_uint32> index;
+   std::vector<ossimGpt>     pts;
+   for(ossim_uint32 i = 0; i < count; ++i)
+   {
+      if(!ossim::isnan(heights[i]))
+      {
+         index.push_back(i);
+         pts.push_back(gpts[i]);
+      }
+   }
+   if(index.empty())
+   {
+      return;
+   }
+   
+   std::vector<double> offsets(index.size());
+   getOffsetsFromEllipsoid(&pts.front(), &offsets.front(),
+                           static_cast<ossim_uint32>(index.size()));
+   for(ossim_uint32 i = 0; i < index.size(); ++i)
+   {
+      heights[index[i]] += offsets[i];
+   }
+}
+
 bool ossimElevationCellDatabase::loadState(const ossimKeywordlist& kwl, const char* prefix)
 {
    ossimString minOpenCells = kwl.find(prefix, "min_open_cells");
@@ -1,9 +1,14 @@
 #include <ossim/elevation/ossimElevationDatabase.h>
+#include <ossim/elevation/ossimElevManager.h>
 
 RTTI_DEF1(ossimElevationDatabase, "ossimElevationDatabase", ossimObject);
 
 double ossimElevationDatabase::getOffsetFromEllipsoid(const ossimGpt& gpt)
 {
+   ossimElevManager* manager = ossimElevManager::instance();
+   const bool STATS = manager->getQueryStatisticsFlag();
+   const ossimTimer::Timer_t BEGIN = STATS ? ossimTimer::instance()->tick() : 0;
+
    double result = 0.0;
    if(m_geoid.valid())
    {
@@ -13,6 +18,11 @@ double ossimElevationDatabase::getOffsetFromEllipsoid(const ossimGpt& gpt)
    {
       result = ossimGeoidManager::instance()->offsetFromEllipsoid(gpt);
    }
+
+   if(STATS)
+   {
+      manager->addGeoidQueries(1, BEGIN, ossimTimer::instance()->tick());
+   }
    
    if(ossim::isnan(result))
    {
@@ -22,6 +32,57 @@ double ossimElevationDatabase::getOffsetFromEllipsoid(const ossimGpt& gpt)
    return result;
 }
 
+void ossimElevationDatabase::getOffsetsFromEllipsoid(const ossimGpt* gpts,
+                                                     double* offsets,
+                                                     ossim_uint32 count)
+{
+   ossimElevManager* manager = ossimElevManager::instance();
+   const bool STATS = manager->getQueryStatisticsFlag();
+   const ossimTimer::Timer_t BEGIN = STATS ? ossimTimer::instance()->tick() : 0;
+
+   if(m_geoid.valid())
+   {
+      m_geoid->offsetsFromEllipsoid(gpts, offsets, count);
+   }
+   else 
+   {
+      ossimGeoidManager::instance()->offsetsFromEllipsoid(gpts, offsets, count);
+   }
+
+   if(STATS)
+   {
+      manager->addGeoidQueries(count, BEGIN, ossimTimer::instance()->tick());
+   }
+   
+   for(ossim_uint32 i = 0; i < count; ++i)
+   {
+      if(ossim::isnan(offsets[i]))
+      {
+         offsets[i] = 0.0;
+      }
+   }
+}
+
+void ossimElevationDatabase::getHeightsAboveMSL(const ossimGpt* gpts,
+                                                double* heights,
+                                                ossim_uint32 count)
+{
+   for(ossim_uint32 i = 0; i < count; ++i)
+   {
+      heights[i] = getHeightAboveMSL(gpts[i]);
+   }
+}
+
+void ossimElevationDatabase::getHeightsAboveEllipsoid(const ossimGpt* gpts,
+                                                      double* heights,
+                                                      ossim_uint32 count)
+{
+   for(ossim_uint32 i = 0; i < count; ++i)
+   {
+      heights[i] = getHeightAboveEllipsoid(gpts[i]);
+   }
+}
+
 bool ossimElevationDatabase::loadState(const ossimKeywordlist& kwl, const char* prefix)
 {
    m_connectionString = kwl.find(prefix, "connection_string");
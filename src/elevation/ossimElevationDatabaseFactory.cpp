@@ -4,6 +4,8 @@
 #include <ossim/elevation/ossimSrtmElevationDatabase.h>
 #include <ossim/elevation/ossimGeneralRasterElevationDatabase.h>
 #include <ossim/elevation/ossimImageElevationDatabase.h>
+#include <ossim/elevation/ossimTiledElevationDatabase.h>
+#include <ossim/elevation/ossimElevationPyramid.h>
 #include <ossim/base/ossimKeywordNames.h>
 
 ossimElevationDatabaseFactory* ossimElevationDatabaseFactory::m_instance = 0;
@@ -46,6 +48,11 @@ ossimElevationDatabase* ossimElevationDatabaseFactory::createDatabase(const ossi
    {
       return new ossimImageElevationDatabase();
    }
+   else if( (typeName == STATIC_TYPE_NAME(ossimTiledElevationDatabase)) ||
+            (typeName == "elevation_pyramid"))
+   {
+      return new ossimTiledElevationDatabase();
+   }
    
    return 0;
 }
@@ -90,6 +97,12 @@ ossimElevationDatabase* ossimElevationDatabaseFactory::open(const ossimString& c
       // This method will only open individual image files for use as dems. It will not utilize the
       // file walker to search over directories:
       ossimFilename filename (connectionString);
+      if (filename.isFile() && ossimElevationPyramid::isPyramidFile(filename))
+      {
+         result = new ossimTiledElevationDatabase;
+         if (result->open(connectionString))
+            break;
+      }
       if (filename.isFile())
       {
          result = new ossimImageElevationDatabase;
@@ -109,4 +122,5 @@ void ossimElevationDatabaseFactory::getTypeNameList(std::vector<ossimString>& ty
    typeList.push_back(STATIC_TYPE_NAME(ossimSrtmElevationDatabase));
    typeList.push_back(STATIC_TYPE_NAME(ossimGeneralRasterElevationDatabase));
    typeList.push_back(STATIC_TYPE_NAME(ossimImageElevationDatabase));
+   typeList.push_back(STATIC_TYPE_NAME(ossimTiledElevationDatabase));
 }
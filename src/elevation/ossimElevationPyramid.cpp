@@ -0,0 +1,371 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Persistent, memory mapped, multi resolution tiled elevation cache.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/elevation/ossimElevationPyramid.h>
+#include <ossim/elevation/ossimElevManager.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimMemoryMappedFile.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimTrace.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+static ossimTrace traceDebug("ossimElevationPyramid:debug");
+
+static const char MAGIC[8] = { 'O', 'S', 'S', 'I', 'M', 'E', 'P', '1' };
+
+// Written as 1 in the writer's byte order.
+static const ossim_uint32 BYTE_ORDER_MARK = 1;
+
+// magic, mark, tile size, levels, pad, ul lat, ul lon, level 0 spacing.
+static const ossim_uint32 HEADER_SIZE = 8 + 4 * 4 + 3 * 8;
+
+// rows, cols, offset of the first tile.
+static const ossim_uint32 LEVEL_RECORD_SIZE = 4 + 4 + 8;
+
+static const ossim_uint32 MAX_LEVELS = 32;
+static const ossim_uint32 MAX_TILE_SIZE = 4096;
+
+// Tiles start on a page boundary.
+static const ossim_uint64 DATA_ALIGNMENT = 4096;
+
+// Level 0 posts, to refuse absurd regions or spacings.
+static const double MAX_POSTS = 4.0e9;
+
+static ossim_uint32 tilesAcross(ossim_uint32 posts, ossim_uint32 tileSize)
+{
+   return (posts + tileSize - 1) / tileSize;
+}
+
+ossimElevationPyramid::ossimElevationPyramid()
+   : m_filename(),
+     m_map(0),
+     m_levels(),
+     m_tileSize(0),
+     m_tileShift(0),
+     m_ulLat(0.0),
+     m_ulLon(0.0),
+     m_rect()
+{
+   m_rect.makeNan();
+}
+
+ossimElevationPyramid::~ossimElevationPyramid()
+{
+   close();
+}
+
+void ossimElevationPyramid::close()
+{
+   m_levels.clear();
+   m_map = 0;
+   m_filename.clear();
+   m_rect.makeNan();
+}
+
+bool ossimElevationPyramid::isPyramidFile(const ossimFilename& file)
+{
+   std::ifstream in(file.c_str(), std::ios::in | std::ios::binary);
+   char magic[8];
+   in.read(magic, 8);
+   return ( !in.fail() && (memcmp(magic, MAGIC, 8) == 0) );
+}
+
+bool ossimElevationPyramid::open(const ossimFilename& file)
+{
+   static const char M[] = "ossimElevationPyramid::open";
+   close();
+
+   ossimRefPtr<ossimMemoryMappedFile> map = new ossimMemoryMappedFile();
+   if ( !map->open(file) || (map->size() < HEADER_SIZE) ||
+        (memcmp(map->data(), MAGIC, 8) != 0) )
+   {
+      return false;
+   }
+
+   const ossim_uint8* buf = map->data();
+   ossim_uint32 mark = 0;
+   ossim_uint32 tileSize = 0;
+   ossim_uint32 levels = 0;
+   ossim_float64 header[3];
+   memcpy(&mark, buf + 8, 4);
+   memcpy(&tileSize, buf + 12, 4);
+   memcpy(&levels, buf + 16, 4);
+   memcpy(header, buf + 24, 3 * 8);
+
+   if (mark != BYTE_ORDER_MARK)
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << M << " WARN: " << file << " was written on a machine of the other byte order.\n";
+      return false;
+   }
+   if ( !tileSize || (tileSize > MAX_TILE_SIZE) || (tileSize & (tileSize - 1)) ||
+        !levels || (levels > MAX_LEVELS) || !(header[2] > 0.0) ||
+        (map->size() < (ossim_uint64)HEADER_SIZE + levels * LEVEL_RECORD_SIZE) )
+   {
+      ossimNotify(ossimNotifyLevel_WARN) << M << " WARN: Bad header in " << file << "\n";
+      return false;
+   }
+
+   m_tileSize  = tileSize;
+   m_tileShift = 0;
+   while ( (1u << m_tileShift) < m_tileSize )
+   {
+      ++m_tileShift;
+   }
+   m_ulLat = header[0];
+   m_ulLon = header[1];
+
+   const ossim_uint64 tileBytes = (ossim_uint64)m_tileSize * m_tileSize * sizeof(float);
+   for (ossim_uint32 i = 0; i < levels; ++i)
+   {
+      ossim_uint32 rows = 0;
+      ossim_uint32 cols = 0;
+      ossim_uint64 offset = 0;
+      const ossim_uint8* record = buf + HEADER_SIZE + i * LEVEL_RECORD_SIZE;
+      memcpy(&rows, record, 4);
+      memcpy(&cols, record + 4, 4);
+      memcpy(&offset, record + 8, 8);
+
+      Level level;
+      level.m_rows       = rows;
+      level.m_cols       = cols;
+      level.m_tilesX     = tilesAcross(cols, m_tileSize);
+      level.m_spacing    = header[2] * (double)((ossim_uint64)1 << i);
+      level.m_invSpacing = 1.0 / level.m_spacing;
+      ossim_uint64 bytes = tileBytes * level.m_tilesX * tilesAcross(rows, m_tileSize);
+      if ( (rows < 2) || (cols < 2) || (offset % sizeof(float)) ||
+           (offset + bytes > map->size()) )
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << M << " WARN: Level " << i << " is bad or truncated in " << file << "\n";
+         m_levels.clear();
+         return false;
+      }
+      level.m_posts = (const float*)(buf + offset);
+      m_levels.push_back(level);
+   }
+
+   m_map = map;
+   m_filename = file;
+   m_rect = ossimGrect(ossimGpt(m_ulLat, m_ulLon, 0.0),
+                       ossimGpt(m_ulLat - (m_levels[0].m_rows - 1) * m_levels[0].m_spacing,
+                                m_ulLon + (m_levels[0].m_cols - 1) * m_levels[0].m_spacing,
+                                0.0));
+   if (traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << M << " " << file << "\nlevels: " << levels << "\ntile size: " << m_tileSize
+         << "\nrect: " << m_rect << std::endl;
+   }
+   return true;
+}
+
+bool ossimElevationPyramid::build(const ossimFilename& file,
+                                  const ossimGrect& region,
+                                  double spacing,
+                                  ossim_uint32 levels,
+                                  ossim_uint32 tileSize)
+{
+   static const char M[] = "ossimElevationPyramid::build";
+   if ( region.isLonLatNan() || !(spacing > 0.0) || !levels )
+   {
+      ossimNotify(ossimNotifyLevel_WARN) << M << " WARN: Bad region or spacing.\n";
+      return false;
+   }
+
+   ossim_uint32 tile = 2;
+   while ( (tile < tileSize) && (tile < MAX_TILE_SIZE) )
+   {
+      tile <<= 1;
+   }
+
+   const double ulLat = region.ul().lat;
+   const double ulLon = region.ul().lon;
+   const double rows0 = std::ceil((ulLat - region.lr().lat) / spacing) + 1.0;
+   const double cols0 = std::ceil((region.lr().lon - ulLon) / spacing) + 1.0;
+   if ( (rows0 < 2.0) || (cols0 < 2.0) || (rows0 * cols0 > MAX_POSTS) )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << M << " WARN: Region " << region << " at spacing " << spacing << " is out of range.\n";
+      return false;
+   }
+
+   // Level sizes; every level keeps the upper left post.
+   std::vector<ossim_uint32> rows;
+   std::vector<ossim_uint32> cols;
+   for (ossim_uint32 i = 0; (i < levels) && (i < MAX_LEVELS); ++i)
+   {
+      if ( i && ((rows.back() <= 2) || (cols.back() <= 2)) )
+      {
+         break;
+      }
+      const ossim_uint32 step = 1u << i;
+      rows.push_back(((ossim_uint32)rows0 - 1 + step - 1) / step + 1);
+      cols.push_back(((ossim_uint32)cols0 - 1 + step - 1) / step + 1);
+   }
+
+   std::ofstream out(file.c_str(), std::ios::out | std::ios::binary);
+   if (!out)
+   {
+      ossimNotify(ossimNotifyLevel_WARN) << M << " WARN: Could not open " << file << "\n";
+      return false;
+   }
+
+   const ossim_uint64 tileBytes = (ossim_uint64)tile * tile * sizeof(float);
+   ossim_uint32 numberOfLevels = (ossim_uint32)rows.size();
+   ossim_uint32 pad = 0;
+   ossim_float64 header[3] = { ulLat, ulLon, spacing };
+   out.write(MAGIC, 8);
+   out.write((const char*)&BYTE_ORDER_MARK, 4);
+   out.write((const char*)&tile, 4);
+   out.write((const char*)&numberOfLevels, 4);
+   out.write((const char*)&pad, 4);
+   out.write((const char*)header, 3 * 8);
+
+   ossim_uint64 offset = HEADER_SIZE + numberOfLevels * LEVEL_RECORD_SIZE;
+   offset = (offset + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+   const ossim_uint64 dataStart = offset;
+   for (ossim_uint32 i = 0; i < numberOfLevels; ++i)
+   {
+      out.write((const char*)&rows[i], 4);
+      out.write((const char*)&cols[i], 4);
+      out.write((const char*)&offset, 8);
+      offset += tileBytes * tilesAcross(rows[i], tile) * tilesAcross(cols[i], tile);
+   }
+   std::vector<char> zeros((size_t)(dataStart - HEADER_SIZE - numberOfLevels * LEVEL_RECORD_SIZE),
+                           0);
+   if ( !zeros.empty() )
+   {
+      out.write(&zeros.front(), zeros.size());
+   }
+
+   // Sample with database heights only.
+   ossimElevManager* mgr = ossimElevManager::instance();
+   const bool useGeoidIfNull = mgr->getUseGeoidIfNullFlag();
+   const double elevationOffset = mgr->getElevationOffset();
+   mgr->setUseGeoidIfNullFlag(false);
+   mgr->setElevationOffset(ossim::nan());
+
+   std::vector<double> heights((size_t)tile * tile);
+   std::vector<float> posts((size_t)tile * tile);
+   for (ossim_uint32 i = 0; (i < numberOfLevels) && out.good(); ++i)
+   {
+      const double s = spacing * (double)(1u << i);
+      const ossim_uint32 tilesX = tilesAcross(cols[i], tile);
+      const ossim_uint32 tilesY = tilesAcross(rows[i], tile);
+      for (ossim_uint32 ty = 0; (ty < tilesY) && out.good(); ++ty)
+      {
+         const ossim_uint32 h = std::min(tile, rows[i] - ty * tile);
+         for (ossim_uint32 tx = 0; tx < tilesX; ++tx)
+         {
+            const ossim_uint32 w = std::min(tile, cols[i] - tx * tile);
+            ossimGpt origin(ulLat - ty * tile * s, ulLon + tx * tile * s, 0.0);
+            mgr->getHeightsAboveMSL(origin, ossimDpt(s, -s), w, h, &heights.front());
+
+            std::fill(posts.begin(), posts.end(), (float)ossim::nan());
+            for (ossim_uint32 r = 0; r < h; ++r)
+            {
+               for (ossim_uint32 c = 0; c < w; ++c)
+               {
+                  posts[r * tile + c] = (float)heights[r * w + c];
+               }
+            }
+            out.write((const char*)&posts.front(), tileBytes);
+         }
+      }
+
+      if (traceDebug())
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << M << " level " << i << " spacing " << s << " posts " << rows[i] << "x" << cols[i]
+            << std::endl;
+      }
+   }
+
+   mgr->setUseGeoidIfNullFlag(useGeoidIfNull);
+   mgr->setElevationOffset(elevationOffset);
+
+   if (out.fail())
+   {
+      ossimNotify(ossimNotifyLevel_WARN) << M << " WARN: Write failed for " << file << "\n";
+      return false;
+   }
+   return true;
+}
+
+double ossimElevationPyramid::getSpacing(ossim_uint32 level) const
+{
+   if (level < m_levels.size())
+   {
+      return m_levels[level].m_spacing;
+   }
+   return ossim::nan();
+}
+
+double ossimElevationPyramid::getSpacingMeters(ossim_uint32 level) const
+{
+   return getSpacing(level) * ossimGpt().metersPerDegree().y;
+}
+
+ossim_uint32 ossimElevationPyramid::getLevel(double gsd) const
+{
+   if ( !ossim::isnan(gsd) )
+   {
+      for (ossim_uint32 i = (ossim_uint32)m_levels.size(); i > 1; --i)
+      {
+         if (getSpacingMeters(i - 1) <= gsd)
+         {
+            return i - 1;
+         }
+      }
+   }
+   return 0;
+}
+
+double ossimElevationPyramid::getHeightAboveMSL(const ossimGpt& gpt, ossim_uint32 level) const
+{
+   if ( m_levels.empty() || gpt.isLatNan() || gpt.isLonNan() )
+   {
+      return ossim::nan();
+   }
+   const Level& l = m_levels[ std::min(level, (ossim_uint32)m_levels.size() - 1) ];
+
+   const double xi = (gpt.lon - m_ulLon) * l.m_invSpacing;
+   const double yi = (m_ulLat - gpt.lat) * l.m_invSpacing;
+   if ( (xi < 0.0) || (yi < 0.0) || (xi > l.m_cols - 1) || (yi > l.m_rows - 1) )
+   {
+      return ossim::nan();
+   }
+   const ossim_uint32 x0 = std::min((ossim_uint32)xi, l.m_cols - 2);
+   const ossim_uint32 y0 = std::min((ossim_uint32)yi, l.m_rows - 2);
+   const double wx1 = xi - x0;
+   const double wy1 = yi - y0;
+
+   const float p[4] = { post(l, y0, x0),     post(l, y0, x0 + 1),
+                        post(l, y0 + 1, x0), post(l, y0 + 1, x0 + 1) };
+   const double w[4] = { (1.0 - wx1) * (1.0 - wy1), wx1 * (1.0 - wy1),
+                         (1.0 - wx1) * wy1,         wx1 * wy1 };
+   double sumWeights = 0.0;
+   double sumPosts = 0.0;
+   for (ossim_uint32 i = 0; i < 4; ++i)
+   {
+      if ( !ossim::isnan(p[i]) )
+      {
+         sumWeights += w[i];
+         sumPosts += w[i] * p[i];
+      }
+   }
+   return (sumWeights > 0.0) ? (sumPosts / sumWeights) : ossim::nan();
+}
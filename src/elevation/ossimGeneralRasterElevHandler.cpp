@@ -32,6 +32,10 @@ ossimGeneralRasterElevHandler::ossimGeneralRasterElevHandler(const ossimGeneralR
     m_streamOpen(false), // ????
     m_memoryMap(src.m_memoryMap)
 {
+   if(!m_memoryMap.valid() && src.isOpen())
+   {
+      m_streamOpen = m_file.open(theGeneralRasterInfo.theFilename);
+   }
 }
 
 ossimGeneralRasterElevHandler::ossimGeneralRasterElevHandler(const ossimGeneralRasterElevHandler::GeneralRasterInfo& generalRasterInfo)
@@ -54,7 +58,7 @@ double ossimGeneralRasterElevHandler::getHeightAboveMSL(const ossimGpt& gpt)
 {
    ossim_float64 result = theGeneralRasterInfo.theNullHeightValue;
 
-   if(m_memoryMap.empty())
+   if(!m_memoryMap.valid())
    {
       switch(theGeneralRasterInfo.theScalarType)
       {
@@ -205,7 +209,7 @@ double ossimGeneralRasterElevHandler::getPostValue(const ossimIpt& /* gridPt */)
 
 bool ossimGeneralRasterElevHandler::isOpen()const
 {
-   if(!m_memoryMap.empty()) return true;
+   if(m_memoryMap.valid() || m_file.isOpen()) return true;
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_inputStreamMutex);
 
    //---
@@ -223,21 +227,29 @@ bool ossimGeneralRasterElevHandler::open(const ossimFilename& file, bool memoryM
 
    if(memoryMapFlag)
    {
-      if(!m_inputStream.bad())
+      // Falls back to reading through the stream if the cell can't be mapped.
+      m_memoryMap = new ossimMemoryMappedFile();
+      if(m_memoryMap->open(theGeneralRasterInfo.theFilename))
       {
-         m_memoryMap.resize(theGeneralRasterInfo.theFilename.fileSize());
-         if(!m_memoryMap.empty())
-         {
-           m_inputStream.read((char*)(&m_memoryMap.front()), (streamsize)m_memoryMap.size());
-         }
+         m_inputStream.close();
       }
+      else
+      {
+         m_memoryMap = 0;
+      }
+   }
+   if(!m_memoryMap.valid() && m_file.open(theGeneralRasterInfo.theFilename))
+   {
+      // Posts are read positionally from here on, without m_inputStreamMutex.
       m_inputStream.close();
+      m_streamOpen = true;
+      return true;
    }
 
    // Capture the stream state for non-const is_open on old compiler.
    m_streamOpen = m_inputStream.is_open();
    
-   return m_streamOpen;
+   return isOpen();
 }
 
 /**
@@ -246,7 +258,8 @@ bool ossimGeneralRasterElevHandler::open(const ossimFilename& file, bool memoryM
 void ossimGeneralRasterElevHandler::close()
 {
    m_inputStream.close();
-   m_memoryMap.clear();
+   m_file.close();
+   m_memoryMap = 0;
    m_streamOpen = false;
 }
 
@@ -488,6 +501,16 @@ double ossimGeneralRasterElevHandler::getHeightAboveMSLFileTemplate(
    
    std::streampos offset = y0*bytesPerLine + x0*sizeof(T);
    
+   if(m_file.isOpen())
+   {
+      // Each pair is adjacent on its line: one read per line, no lock.
+      if( !m_file.read((ossim_uint64)offset, p, 2*sizeof(T)) ||
+          !m_file.read((ossim_uint64)offset + bytesPerLine, p+2, 2*sizeof(T)) )
+      {
+         return ossim::nan();
+      }
+   }
+   else
    {
       OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_inputStreamMutex);
       if(m_inputStream.fail())
@@ -616,10 +639,15 @@ double ossimGeneralRasterElevHandler::getHeightAboveMSLMemoryTemplate(
    ossim_uint64 offset = y0*bytesPerLine + x0*sizeof(T);
    ossim_uint64 offset2 = offset+bytesPerLine;
    
-   T v00 = *(reinterpret_cast<T*> (&m_memoryMap[offset]));
-   T v01 = *(reinterpret_cast<T*> (&m_memoryMap[offset + sizeof(T)]));
-   T v10 = *(reinterpret_cast<T*> (&m_memoryMap[offset2]));
-   T v11 = *(reinterpret_cast<T*> (&m_memoryMap[offset2 + sizeof(T)]));
+   if (offset2 + 2*sizeof(T) > m_memoryMap->size())
+   {
+      return ossim::nan(); // Truncated cell.
+   }
+   const ossim_uint8* buf = m_memoryMap->data();
+   T v00 = *(reinterpret_cast<const T*> (buf + offset));
+   T v01 = *(reinterpret_cast<const T*> (buf + offset + sizeof(T)));
+   T v10 = *(reinterpret_cast<const T*> (buf + offset2));
+   T v11 = *(reinterpret_cast<const T*> (buf + offset2 + sizeof(T)));
    if(endian.getSystemEndianType() != info.theByteOrder)
    {
       endian.swap(v00);
@@ -14,15 +14,52 @@
 // $Id$
 
 #include <ossim/elevation/ossimImageElevationDatabase.h>
+#include <ossim/base/ossimCommon.h>
 #include <ossim/base/ossimDpt.h>
 #include <ossim/base/ossimString.h>
 #include <ossim/base/ossimTrace.h>
 #include <ossim/elevation/ossimImageElevationHandler.h>
 #include <ossim/util/ossimFileWalker.h>
+#include <ossim/base/ossimDate.h>
 #include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 
 static ossimTrace traceDebug(ossimString("ossimImageElevationDatabase:debug"));
 
+static const char INDEX_FILE[]   = ".ossim_image_elevation_index";
+static const char INDEX_HEADER[] = "ossim_image_elevation_index 1";
+
+// An entry covering more grid cells than this goes to m_largeEntries.
+static const ossim_int64 MAX_INDEX_CELLS_PER_ENTRY = 64;
+
+// Modification time and size, to tell if an index file record is stale.
+static bool getFileStamp(const ossimFilename& file, ossim_int64& modTime, ossim_int64& size)
+{
+   ossimLocalTm t;
+   if ( !file.getTimes(0, &t, 0) )
+   {
+      return false;
+   }
+   modTime = (ossim_int64)(time_t)t;
+   size    = file.fileSize();
+   return true;
+}
+
+namespace
+{
+   struct IndexRecord
+   {
+      ossim_int64   m_modTime;
+      ossim_int64   m_size;
+      ossim_float64 m_ulLat;
+      ossim_float64 m_ulLon;
+      ossim_float64 m_lrLat;
+      ossim_float64 m_lrLon;
+   };
+}
+
 RTTI_DEF1(ossimImageElevationDatabase, "ossimImageElevationDatabase", ossimElevationCellDatabase);
 
 ossimImageElevationDatabase::ossimImageElevationDatabase()
@@ -31,7 +68,10 @@ ossimImageElevationDatabase::ossimImageElevationDatabase()
    ossimFileProcessorInterface(),
    m_entryMap(),
    m_lastMapKey(0),
-   m_lastAccessedId(0)
+   m_lastAccessedId(0),
+   m_index(),
+   m_largeEntries(),
+   m_indexCellSize(0.0)
 {
 }
 
@@ -85,6 +125,9 @@ void ossimImageElevationDatabase::close()
    m_meanSpacing = 0.0;
    m_geoid = 0;
    m_connectionString.clear();
+   m_index.clear();
+   m_largeEntries.clear();
+   m_indexCellSize = 0.0;
 }
 
 double ossimImageElevationDatabase::getHeightAboveMSL(const ossimGpt& gpt)
@@ -115,6 +158,13 @@ double ossimImageElevationDatabase::getHeightAboveEllipsoid(const ossimGpt& gpt)
    return h;
 }
 
+void ossimImageElevationDatabase::getHeightsAboveMSL(const ossimGpt* gpts,
+                                                     double* heights,
+                                                     ossim_uint32 count)
+{
+   ossimElevationDatabase::getHeightsAboveMSL(gpts, heights, count);
+}
+
 ossimRefPtr<ossimElevCellHandler> ossimImageElevationDatabase::createCell(
    const ossimGpt& gpt)
 {
@@ -123,9 +173,19 @@ ossimRefPtr<ossimElevCellHandler> ossimImageElevationDatabase::createCell(
    // Need to disable elevation while loading the DEM image to prevent recursion:
    disableSource();
 
-   std::map<ossim_uint64, ossimImageElevationFileEntry>::iterator i = m_entryMap.begin();
-   while ( i != m_entryMap.end() )
+   // Only the entries the index says may hold the point:
+   std::vector<ossim_uint64> candidates;
+   getCandidates(gpt, candidates);
+
+   std::vector<ossim_uint64>::const_iterator c = candidates.begin();
+   for ( ; c != candidates.end(); ++c )
    {
+      std::map<ossim_uint64, ossimImageElevationFileEntry>::iterator i = m_entryMap.find(*c);
+      if ( i == m_entryMap.end() )
+      {
+         continue; // Dropped since the index was built.
+      }
+      
       if ( (*i).second.m_loadedFlag == false )
       {
          // not loaded
@@ -144,14 +204,9 @@ ossimRefPtr<ossimElevCellHandler> ossimImageElevationDatabase::createCell(
                   << "ossimImageElevationDatabase::createCell WARN:\nCould not open: "
                   << (*i).second.m_file << "\nRemoving file from map!" << std::endl;
 
-               // Get a copy of the iterator to delet.
-               std::map<ossim_uint64, ossimImageElevationFileEntry>::iterator badIter = i;
-               
-               ++i; // Go to next image.
-
                // Must put lock around erase.
                m_cacheMapMutex.lock();
-               m_entryMap.erase(badIter);
+               m_entryMap.erase(i);
                m_cacheMapMutex.unlock();
                
                continue; // Skip the rest of this loop.
@@ -190,8 +245,6 @@ ossimRefPtr<ossimElevCellHandler> ossimImageElevationDatabase::createCell(
             h = 0;
          }
       }
-
-      ++i;
    }
    
    enableSource();
@@ -252,15 +305,22 @@ ossimRefPtr<ossimElevCellHandler> ossimImageElevationDatabase::getOrCreateCellHa
    }
    m_cacheMapMutex.unlock();
   
-   if ( result.valid() == false )
+   if ( result.valid() )
+   {
+      addCacheHit();
+   }
+   else
    {
       // Not in m_cacheMap.  Create a new cell for point if we have coverage.
+      ++m_cacheMisses;
+      const ossimTimer::Timer_t begin = ossimTimer::instance()->tick();
       result = createCell(gpt);
+      const ossimTimer::Timer_t end = ossimTimer::instance()->tick();
 
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_cacheMapMutex);
+      addCellOpen(result.valid(), begin, end);
       if(result.valid())
       {
-         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_cacheMapMutex);
-
          //---
          // Add the cell to map.
          // NOTE: ossimImageElevationDatabase::createCell sets m_lastAccessedId to that of
@@ -276,6 +336,9 @@ ossimRefPtr<ossimElevCellHandler> ossimImageElevationDatabase::getOrCreateCellHa
          {
             flushCacheToMinOpenCells();
          }
+
+         // Not searched here, but keeps the base snapshot from holding evicted cells.
+         publishCacheSnapshot();
       }
    }
 
@@ -294,15 +357,17 @@ bool ossimImageElevationDatabase::pointHasCoverage(const ossimGpt& gpt) const
    // ossimImageGeometry of the image.
    //---
    bool result = false;
-   std::map<ossim_uint64, ossimImageElevationFileEntry>::const_iterator i = m_entryMap.begin();
-   while ( i != m_entryMap.end() )
+   std::vector<ossim_uint64> candidates;
+   getCandidates(gpt, candidates);
+   std::vector<ossim_uint64>::const_iterator c = candidates.begin();
+   for ( ; c != candidates.end(); ++c )
    {
-      if ( (*i).second.m_rect.pointWithin(gpt) )
+      std::map<ossim_uint64, ossimImageElevationFileEntry>::const_iterator i = m_entryMap.find(*c);
+      if ( (i != m_entryMap.end()) && (*i).second.m_rect.pointWithin(gpt) )
       {
          result = true;
          break;
       }
-      ++i;
    }
    return result;
 }
@@ -395,8 +460,10 @@ void ossimImageElevationDatabase::processFile(const ossimFilename& file)
          << M << " entered...\n" << "file: " << file << "\n";
    }
 
-   // Add the file.
+   // Add the file.  The walker calls this from its job threads.
+   m_cacheMapMutex.lock();
    m_entryMap.insert( std::make_pair(m_lastMapKey++, ossimImageElevationFileEntry(file)) );
+   m_cacheMapMutex.unlock();
 
    if(traceDebug())
    {
@@ -416,6 +483,9 @@ void ossimImageElevationDatabase::loadFileMap()
 
       // This links the file walker back to our "processFile" method.
       fw->setFileProcessor( this );
+
+      // List the directories of large (network mounted) elevation trees concurrently:
+      fw->setNumberOfWalkThreads( ossim::getNumberOfThreads() );
       
       ossimFilename f = m_connectionString;
 
@@ -424,7 +494,205 @@ void ossimImageElevationDatabase::loadFileMap()
       
       delete fw;
       fw = 0;
+
+      buildIndex();
+   }
+}
+
+ossimFilename ossimImageElevationDatabase::getIndexFile() const
+{
+   ossimFilename dir = m_connectionString;
+   if ( dir.size() && dir.isDir() )
+   {
+      return dir.dirCat(INDEX_FILE);
+   }
+   return ossimFilename();
+}
+
+void ossimImageElevationDatabase::buildIndex()
+{
+   static const char M[] = "ossimImageElevationDatabase::buildIndex";
+
+   m_index.clear();
+   m_largeEntries.clear();
+   m_indexCellSize = 0.0;
+
+   // Bounds saved by the last run:
+   std::map<std::string, IndexRecord> saved;
+   ossimFilename indexFile = getIndexFile();
+   if ( indexFile.size() )
+   {
+      std::ifstream in(indexFile.c_str());
+      std::string line;
+      if ( in && std::getline(in, line) && (line == INDEX_HEADER) )
+      {
+         while ( std::getline(in, line) )
+         {
+            std::istringstream is(line);
+            IndexRecord r;
+            std::string file;
+            is >> r.m_modTime >> r.m_size >> r.m_ulLat >> r.m_ulLon >> r.m_lrLat >> r.m_lrLon;
+            is.get(); // Separator; the file name is the rest of the line.
+            std::getline(is, file);
+            if ( !is.fail() && file.size() )
+            {
+               saved[file] = r;
+            }
+         }
+      }
+   }
+
+   std::map<std::string, IndexRecord> current;
+   ossim_uint32 opened = 0;
+   
+   // Need to disable elevation while loading the DEM images to prevent recursion:
+   bool enabled = isSourceEnabled();
+   if ( enabled )
+   {
+      disableSource();
+   }
+
+   std::map<ossim_uint64, ossimImageElevationFileEntry>::iterator i = m_entryMap.begin();
+   while ( i != m_entryMap.end() )
+   {
+      ossimImageElevationFileEntry& entry = (*i).second;
+      IndexRecord r;
+      bool stamped = getFileStamp(entry.m_file, r.m_modTime, r.m_size);
+      
+      if ( entry.m_rect.isLonLatNan() )
+      {
+         std::map<std::string, IndexRecord>::const_iterator s = saved.find(entry.m_file.string());
+         if ( stamped && (s != saved.end()) &&
+              ((*s).second.m_modTime == r.m_modTime) && ((*s).second.m_size == r.m_size) )
+         {
+            entry.m_rect = ossimGrect((*s).second.m_ulLat, (*s).second.m_ulLon,
+                                      (*s).second.m_lrLat, (*s).second.m_lrLon);
+         }
+         else
+         {
+            ossimRefPtr<ossimImageElevationHandler> h = new ossimImageElevationHandler();
+            if ( h->open(entry.m_file) )
+            {
+               entry.m_rect = h->getBoundingGndRect();
+               ++opened;
+            }
+         }
+      }
+
+      if ( entry.m_rect.isLonLatNan() )
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << M << " WARN:\nCould not open: " << entry.m_file
+            << "\nRemoving file from map!" << std::endl;
+         m_entryMap.erase(i++);
+         continue;
+      }
+      
+      if ( stamped )
+      {
+         r.m_ulLat = entry.m_rect.ul().lat;
+         r.m_ulLon = entry.m_rect.ul().lon;
+         r.m_lrLat = entry.m_rect.lr().lat;
+         r.m_lrLon = entry.m_rect.lr().lon;
+         current[entry.m_file.string()] = r;
+      }
+      m_indexCellSize += ossim::max(entry.m_rect.height(), entry.m_rect.width());
+      ++i;
+   }
+
+   if ( enabled )
+   {
+      enableSource();
+   }
+
+   if ( indexFile.size() && ( opened || (current.size() != saved.size()) ) )
+   {
+      std::ofstream out(indexFile.c_str());
+      if ( out )
+      {
+         out << INDEX_HEADER << "\n" << std::setprecision(17);
+         std::map<std::string, IndexRecord>::const_iterator r = current.begin();
+         while ( r != current.end() )
+         {
+            out << (*r).second.m_modTime << " " << (*r).second.m_size << " "
+                << (*r).second.m_ulLat << " " << (*r).second.m_ulLon << " "
+                << (*r).second.m_lrLat << " " << (*r).second.m_lrLon << " "
+                << (*r).first << "\n";
+            ++r;
+         }
+      }
+      else if ( traceDebug() )
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << M << " could not write " << indexFile << "\n";
+      }
+   }
+
+   if ( m_entryMap.empty() )
+   {
+      m_indexCellSize = 0.0;
+      return;
+   }
+
+   // Grid cells the size of an average entry, so most entries land in four or fewer.
+   m_indexCellSize /= m_entryMap.size();
+   if ( !(m_indexCellSize > 0.0) )
+   {
+      m_indexCellSize = 1.0;
+   }
+   for ( i = m_entryMap.begin(); i != m_entryMap.end(); ++i )
+   {
+      const ossimGrect& rect = (*i).second.m_rect;
+      ossim_int32 r0 = (ossim_int32)std::floor(rect.lr().lat / m_indexCellSize);
+      ossim_int32 r1 = (ossim_int32)std::floor(rect.ul().lat / m_indexCellSize);
+      ossim_int32 c0 = (ossim_int32)std::floor(rect.ul().lon / m_indexCellSize);
+      ossim_int32 c1 = (ossim_int32)std::floor(rect.lr().lon / m_indexCellSize);
+      if ( (ossim_int64)(r1 - r0 + 1) * (c1 - c0 + 1) > MAX_INDEX_CELLS_PER_ENTRY )
+      {
+         m_largeEntries.push_back((*i).first);
+         continue;
+      }
+      for ( ossim_int32 row = r0; row <= r1; ++row )
+      {
+         for ( ossim_int32 col = c0; col <= c1; ++col )
+         {
+            m_index[IndexKey(row, col)].push_back((*i).first);
+         }
+      }
+   }
+
+   if ( traceDebug() )
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << M << " entries: " << m_entryMap.size() << " opened: " << opened
+         << " grid cells: " << m_index.size() << " cell size: " << m_indexCellSize
+         << " large entries: " << m_largeEntries.size() << "\n";
+   }
+}
+
+void ossimImageElevationDatabase::getCandidates(const ossimGpt& gpt,
+                                                std::vector<ossim_uint64>& ids) const
+{
+   ids.clear();
+   if ( !(m_indexCellSize > 0.0) )
+   {
+      // No index; every entry.
+      std::map<ossim_uint64, ossimImageElevationFileEntry>::const_iterator i = m_entryMap.begin();
+      for ( ; i != m_entryMap.end(); ++i )
+      {
+         ids.push_back((*i).first);
+      }
+      return;
+   }
+   
+   IndexKey key( (ossim_int32)std::floor(gpt.lat / m_indexCellSize),
+                 (ossim_int32)std::floor(gpt.lon / m_indexCellSize) );
+   std::map<IndexKey, std::vector<ossim_uint64> >::const_iterator cell = m_index.find(key);
+   if ( cell != m_index.end() )
+   {
+      ids = (*cell).second;
    }
+   ids.insert(ids.end(), m_largeEntries.begin(), m_largeEntries.end());
 }
 
 // Hidden from use:
@@ -434,6 +702,9 @@ ossimImageElevationDatabase::ossimImageElevationDatabase(const ossimImageElevati
    m_entryMap = copy.m_entryMap;
    m_lastMapKey = copy.m_lastMapKey;
    m_lastAccessedId = copy.m_lastAccessedId;
+   m_index = copy.m_index;
+   m_largeEntries = copy.m_largeEntries;
+   m_indexCellSize = copy.m_indexCellSize;
 }
 
 // Private container class:
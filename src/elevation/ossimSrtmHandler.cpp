@@ -54,7 +54,7 @@ ossimSrtmHandler::~ossimSrtmHandler()
 double ossimSrtmHandler::getHeightAboveMSL(const ossimGpt& gpt)
 {
    if(!isOpen()) return ossim::nan();
-   if(!m_memoryMap.empty())
+   if(m_memoryMap.valid())
    {
       switch(m_scalarType)
       {
@@ -137,6 +137,16 @@ double ossimSrtmHandler::getHeightAboveMSLFileTemplate(T /* dummy */, const ossi
    //---
    std::streampos offset = y0 * m_srtmRecordSizeInBytes + x0 * sizeof(T);
 
+   if (m_file.isOpen())
+   {
+      // Each pair is adjacent on its line: one read per line, no lock.
+      if ( !m_file.read((ossim_uint64)offset, p, 2*sizeof(T)) ||
+           !m_file.read((ossim_uint64)offset + m_srtmRecordSizeInBytes, p+2, 2*sizeof(T)) )
+      {
+         return ossim::nan();
+      }
+   }
+   else
    {
       OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_fileStrMutex);
 
@@ -270,10 +280,15 @@ double ossimSrtmHandler::getHeightAboveMSLMemoryTemplate(T /* dummy */,
    // Grab the four points from the srtm cell needed.
    ossim_uint64 offset = y0 * m_srtmRecordSizeInBytes + x0 * sizeof(T);
    ossim_uint64 offset2 =offset+m_srtmRecordSizeInBytes;
-   T v00 = *(reinterpret_cast<T*> (&m_memoryMap[offset]));
-   T v01 = *(reinterpret_cast<T*> (&m_memoryMap[offset + sizeof(T)]));
-   T v10 = *(reinterpret_cast<T*> (&m_memoryMap[offset2]));
-   T v11 = *(reinterpret_cast<T*> (&m_memoryMap[offset2 + sizeof(T)]));
+   if (offset2 + 2*sizeof(T) > m_memoryMap->size())
+   {
+      return ossim::nan(); // Truncated cell.
+   }
+   const ossim_uint8* buf = m_memoryMap->data();
+   T v00 = *(reinterpret_cast<const T*> (buf + offset));
+   T v01 = *(reinterpret_cast<const T*> (buf + offset + sizeof(T)));
+   T v10 = *(reinterpret_cast<const T*> (buf + offset2));
+   T v11 = *(reinterpret_cast<const T*> (buf + offset2 + sizeof(T)));
    if (m_swapper)
    {
       m_swapper->swap(v00);
@@ -395,16 +410,19 @@ m_swapper(src.m_swapper?new ossimEndian:0),
 m_scalarType(src.m_scalarType),
 m_memoryMap(src.m_memoryMap)
 {
-   if(m_memoryMap.empty()&&src.isOpen())
+   if(!m_memoryMap.valid()&&src.isOpen())
    {
-      m_fileStr.open(src.getFilename().c_str(),
-                     std::ios::binary|std::ios::in);
+      if(!m_file.open(src.getFilename()))
+      {
+         m_fileStr.open(src.getFilename().c_str(),
+                        std::ios::binary|std::ios::in);
+      }
    }
 }
 
 bool ossimSrtmHandler::isOpen()const
 {
-   if(!m_memoryMap.empty()) return true;
+   if(m_memoryMap.valid()) return true;
    
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_fileStrMutex);
    return m_streamOpen;
@@ -457,8 +475,20 @@ bool ossimSrtmHandler::open(const ossimFilename& file, bool memoryMapFlag)
    
    if(memoryMapFlag)
    {
-      m_memoryMap.resize(theFilename.fileSize());
-      m_fileStr.read((char*)&m_memoryMap.front(), (streamsize)m_memoryMap.size());
+      // Falls back to reading through the stream if the cell can't be mapped.
+      m_memoryMap = new ossimMemoryMappedFile();
+      if(m_memoryMap->open(theFilename))
+      {
+         m_fileStr.close();
+      }
+      else
+      {
+         m_memoryMap = 0;
+      }
+   }
+   if(!m_memoryMap.valid() && m_file.open(theFilename))
+   {
+      // Posts are read positionally from here on, without m_fileStrMutex.
       m_fileStr.close();
    }
    m_streamOpen = true;
@@ -492,6 +522,7 @@ bool ossimSrtmHandler::open(const ossimFilename& file, bool memoryMapFlag)
 void ossimSrtmHandler::close()
 {
    m_fileStr.close();
-   m_memoryMap.clear();
+   m_file.close();
+   m_memoryMap = 0;
    m_streamOpen = false;
 }
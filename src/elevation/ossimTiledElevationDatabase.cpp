@@ -14,6 +14,7 @@
 // $Id$
 
 #include <ossim/elevation/ossimTiledElevationDatabase.h>
+#include <ossim/elevation/ossimElevationPyramid.h>
 #include <ossim/base/ossimDblGrid.h>
 #include <ossim/base/ossimDirectory.h>
 #include <ossim/base/ossimDpt.h>
@@ -44,7 +45,9 @@ ossimTiledElevationDatabase::ossimTiledElevationDatabase()
    m_referenceProj(0),
    m_requestedRect(),
    m_entryListRect(),
-   m_fileWalker(0)
+   m_fileWalker(0),
+   m_pyramid(0),
+   m_level(0)
 {
    m_requestedRect.makeNan();
    m_entryListRect.makeNan();
@@ -90,6 +93,7 @@ bool ossimTiledElevationDatabase::open(const ossimString& connectionString)
    if ( connectionString.size() )
    {
       m_connectionString = connectionString.c_str();
+      openPyramid( ossimFilename(m_connectionString) );
       result = true;
    }
 
@@ -115,6 +119,8 @@ void ossimTiledElevationDatabase::close()
       delete m_grid;
       m_grid = 0;
    }
+   m_pyramid = 0;
+   m_level = 0;
    m_meanSpacing = 0.0;
    m_geoid = 0;
    m_connectionString.clear();
@@ -129,7 +135,17 @@ void ossimTiledElevationDatabase::mapRegion(const ossimGrect& region)
          << M << " entered...\n" << "region: " << region << "\n";
    }
    
-   if ( m_connectionString.size() )
+   if ( m_pyramid.valid() )
+   {
+      // Whole pyramid is mapped already.
+      if ( traceDebug() && !theGroundRect.completely_within(region) &&
+           !region.completely_within(theGroundRect) )
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << M << " region not covered by pyramid: " << theGroundRect << "\n";
+      }
+   }
+   else if ( m_connectionString.size() )
    {
       // Wrap in try catch block as excptions can be thrown under the hood.
       try
@@ -330,8 +346,46 @@ void ossimTiledElevationDatabase::initializeReferenceProjection()
    }
 }
 
+bool ossimTiledElevationDatabase::openPyramid(const ossimFilename& file)
+{
+   m_pyramid = 0;
+   m_level = 0;
+   if ( file.isFile() && ossimElevationPyramid::isPyramidFile(file) )
+   {
+      m_pyramid = new ossimElevationPyramid();
+      if ( m_pyramid->open(file) )
+      {
+         theGroundRect = m_pyramid->getBoundingRect();
+         m_meanSpacing = m_pyramid->getSpacingMeters(0);
+      }
+      else
+      {
+         m_pyramid = 0;
+      }
+   }
+   return m_pyramid.valid();
+}
+
+void ossimTiledElevationDatabase::setRequestedGsd(double gsd)
+{
+   if ( m_pyramid.valid() )
+   {
+      m_level = m_pyramid->getLevel(gsd);
+      m_meanSpacing = m_pyramid->getSpacingMeters(m_level);
+   }
+}
+
+ossim_uint32 ossimTiledElevationDatabase::getLevel() const
+{
+   return m_level;
+}
+
 double ossimTiledElevationDatabase::getHeightAboveMSL(const ossimGpt& gpt)
 {
+   if ( m_pyramid.valid() )
+   {
+      return m_pyramid->getHeightAboveMSL(gpt, m_level);
+   }
    if ( m_grid )
    {
       return (*m_grid)(gpt.lon, gpt.lat);
@@ -375,6 +429,19 @@ bool ossimTiledElevationDatabase::loadState(const ossimKeywordlist& kwl, const c
       {
          result = ossimElevationDatabase::loadState(kwl, prefix);
       }
+      else if ( type == "elevation_pyramid" )
+      {
+         result = ossimElevationDatabase::loadState(kwl, prefix) &&
+            openPyramid( ossimFilename(m_connectionString) );
+         if ( result )
+         {
+            lookup = kwl.find(prefix, "gsd");
+            if ( lookup )
+            {
+               setRequestedGsd( ossimString(lookup).toDouble() );
+            }
+         }
+      }
    }
 
    if(traceDebug())
@@ -387,7 +454,13 @@ bool ossimTiledElevationDatabase::loadState(const ossimKeywordlist& kwl, const c
 
 bool ossimTiledElevationDatabase::saveState(ossimKeywordlist& kwl, const char* prefix) const
 {
-   return ossimElevationDatabase::saveState(kwl, prefix);
+   bool result = ossimElevationDatabase::saveState(kwl, prefix);
+   if ( m_pyramid.valid() )
+   {
+      kwl.add(prefix, "type", "elevation_pyramid", true);
+      kwl.add(prefix, "gsd", m_pyramid->getSpacingMeters(m_level), true);
+   }
+   return result;
 }
 
 // Private method:
@@ -14,10 +14,84 @@
 #include <ossim/imaging/ossim3x3ConvolutionFilter.h>
 #include <ossim/base/ossimIrect.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageDataView.h>
 #include <ossim/base/ossimMatrixProperty.h>
 
 RTTI_DEF1(ossim3x3ConvolutionFilter, "ossim3x3ConvolutionFilter", ossimImageSourceFilter);
 
+namespace
+{
+   //---
+   // Convolves the output tile from an input tile with a one pixel margin.
+   // Sums are clamped to the band min and max; with m_full false, pixels whose
+   // 3x3 window holds an input null are set to the output null.
+   //---
+   struct Convolve3x3
+   {
+      const ossimImageData* m_input;
+      ossimImageData*       m_output;
+      const double        (*m_kernel)[3];
+      bool                  m_full;
+      std::vector<double>   m_minPix;
+      std::vector<double>   m_maxPix;
+      std::vector<double>   m_nullPix;
+
+      template <class T> void operator()(T)
+      {
+         ossimImageDataView<const T> src(m_input);
+         ossimImageDataView<T>       dst(m_output);
+         if ( !src.valid() || !dst.valid() )
+         {
+            return;
+         }
+         const ossim_int32 IW = (ossim_int32)src.m_lineStride;
+         const ossim_int32 DX = dst.m_origin.x - src.m_origin.x;
+         const ossim_int32 DY = dst.m_origin.y - src.m_origin.y;
+         const double K00 = m_kernel[0][0], K01 = m_kernel[0][1], K02 = m_kernel[0][2];
+         const double K10 = m_kernel[1][0], K11 = m_kernel[1][1], K12 = m_kernel[1][2];
+         const double K20 = m_kernel[2][0], K21 = m_kernel[2][1], K22 = m_kernel[2][2];
+
+         for (ossim_uint32 band = 0; band < dst.getNumberOfBands(); ++band)
+         {
+            const T MAX_PIX   = static_cast<T>(m_maxPix[band]);
+            const T MIN_PIX   = static_cast<T>(m_minPix[band]);
+            const T NULL_PIX  = src.m_null[band];
+            const T O_NULL    = static_cast<T>(m_nullPix[band]);
+            
+            for (ossim_uint32 y = 0; y < dst.m_height; ++y)
+            {
+               // Center of the window of output pixel (0, y):
+               const T* c = src.band(band) + (DY + (ossim_int32)y) * IW + DX;
+               const T* u = c - IW;
+               const T* l = c + IW;
+               T* d = dst.line(band, y);
+
+               for (ossim_uint32 x = 0; x < dst.m_width; ++x)
+               {
+                  const double sum = K00*(double)u[x-1] + K01*(double)u[x] + K02*(double)u[x+1] +
+                                     K10*(double)c[x-1] + K11*(double)c[x] + K12*(double)c[x+1] +
+                                     K20*(double)l[x-1] + K21*(double)l[x] + K22*(double)l[x+1];
+                  const T v = (sum > MAX_PIX) ? MAX_PIX :
+                     ( (sum < MIN_PIX) ? MIN_PIX : static_cast<T>(sum) );
+                  if ( m_full )
+                  {
+                     d[x] = v;
+                  }
+                  else
+                  {
+                     const bool hasNull =
+                        (u[x-1] == NULL_PIX) | (u[x] == NULL_PIX) | (u[x+1] == NULL_PIX) |
+                        (c[x-1] == NULL_PIX) | (c[x] == NULL_PIX) | (c[x+1] == NULL_PIX) |
+                        (l[x-1] == NULL_PIX) | (l[x] == NULL_PIX) | (l[x+1] == NULL_PIX);
+                     d[x] = hasNull ? O_NULL : v;
+                  }
+               }
+            }
+         }
+      }
+   };
+}
+
 ossim3x3ConvolutionFilter::ossim3x3ConvolutionFilter(ossimObject* owner)
    :ossimImageSourceFilter(owner),
     theTile(NULL),
@@ -89,265 +163,33 @@ ossimRefPtr<ossimImageData> ossim3x3ConvolutionFilter::getTile(
 
    theTile->setImageRectangle(tileRect);
    theTile->makeBlank();
-   
-   switch(data->getScalarType())
-   {
-      case OSSIM_UCHAR:
-      {
-         if(data->getDataObjectStatus() == OSSIM_FULL)
-         {
-            convolveFull(static_cast<ossim_uint8>(0), data, theTile);
-         }
-         else
-         {
-            convolvePartial(static_cast<ossim_uint8>(0), data, theTile);
-         }
-         break;
-      }
-      case OSSIM_FLOAT: 
-      case OSSIM_NORMALIZED_FLOAT:
-      {
-         if(data->getDataObjectStatus() == OSSIM_FULL)
-         {
-            convolveFull(static_cast<float>(0), data, theTile);
-         }
-         else
-         {
-            convolvePartial(static_cast<float>(0), data, theTile);
-         }
-         break;
-      }
-      case OSSIM_USHORT16:
-      case OSSIM_USHORT11:
-      {
-         if(data->getDataObjectStatus() == OSSIM_FULL)
-         {
-            convolveFull(static_cast<ossim_uint16>(0), data, theTile);
-         }
-         else
-         {
-            convolvePartial(static_cast<ossim_uint16>(0), data, theTile);
-         }
-         break;
-      }
-      case OSSIM_SSHORT16:
-      {
-         if(data->getDataObjectStatus() == OSSIM_FULL)
-         {
-            convolveFull(static_cast<ossim_sint16>(0), data, theTile);
-         }
-         else
-         {
-            convolvePartial(static_cast<ossim_sint16>(0), data, theTile);
-         }
-         break;
-      }
-      case OSSIM_DOUBLE:
-      case OSSIM_NORMALIZED_DOUBLE:
-      {
-         if(data->getDataObjectStatus() == OSSIM_FULL)
-         {
-            convolveFull(static_cast<double>(0), data, theTile);
-      }
-      else
-      {
-         convolvePartial(static_cast<double>(0), data, theTile);
-      }
-         break;
-      }
-      default:
-      {
-         ossimNotify(ossimNotifyLevel_WARN)
-            << "ossim3x3ConvolutionFilter::getTile WARNING:\n"
-            << "Scalar type = " << theTile->getScalarType()
-            << " Not supported by ossim3x3ConvolutionFilter" << endl;
-         break;
-      }
-   }
-   theTile->validate();
-   
-   return theTile;
-}
-
 
-template<class T> void ossim3x3ConvolutionFilter::convolvePartial(
-   T,
-   ossimRefPtr<ossimImageData> inputData,
-   ossimRefPtr<ossimImageData> outputData)
-{
-   // let's set up some temporary variables so we don't
-   // have to call the functions in loops.  Iknow that compilers
-   // typically optimize this out but if we are in debug mode 
-   // with no optimization it will still run fast
-   //
-   double sum = 0.0;
-   ossim_int32 inputW          = (ossim_int32)inputData->getWidth();
-   ossim_int32 outputW         = (ossim_int32)outputData->getWidth();
-   ossim_int32 outputH         = (ossim_int32)outputData->getHeight();
-   ossim_int32 numberOfBands   = (ossim_int32)inputData->getNumberOfBands();
-   ossimIpt outputOrigin  = outputData->getOrigin();
-   ossimIpt inputOrigin   = inputData->getOrigin();
-   
-   ossim_int32 startInputOffset = std::abs(outputOrigin.y - inputOrigin.y)*
-      inputW + std::abs(outputOrigin.x - inputOrigin.x);
-   ossim_int32 ulKernelStart    = -inputW - 1;
-   ossim_int32 leftKernelStart  = -1;
-   ossim_int32 llKernelStart    = inputW  - 1;
-   
-   T* ulKernelStartBuf    = NULL;
-   T* leftKernelStartBuf  = NULL;
-   T* llKernelStartBuf    = NULL;
-   
-   for(ossim_int32 band = 0; band < numberOfBands; ++band)
+   // Per band values out of the loops; the kernel reads the tiles through typed views.
+   const ossim_uint32 BANDS = theTile->getNumberOfBands();
+   Convolve3x3 convolve;
+   convolve.m_input  = data.get();
+   convolve.m_output = theTile.get();
+   convolve.m_kernel = theKernel;
+   convolve.m_full   = (data->getDataObjectStatus() == OSSIM_FULL);
+   convolve.m_minPix.resize(BANDS);
+   convolve.m_maxPix.resize(BANDS);
+   convolve.m_nullPix.resize(BANDS);
+   for (ossim_uint32 band = 0; band < BANDS; ++band)
    {
-      T* inputBuf  = static_cast<T*>(inputData->getBuf(band))+startInputOffset;
-      T* outputBuf = static_cast<T*>(outputData->getBuf(band));
-      T maxPix     = static_cast<T>(getMaxPixelValue(band));
-      T minPix     = static_cast<T>(getMinPixelValue(band));      
-      T nullPix    = static_cast<T>(inputData->getNullPix(band));
-      T oNullPix   = static_cast<T>(getNullPixelValue(band));
-      
-      if(inputBuf&&outputBuf)
-      {
-         for(ossim_int32 row = 0; row < outputW; ++row)
-         {
-            ossim_int32 rowOffset    = inputW*row;
-            ulKernelStartBuf   = inputBuf + (rowOffset + ulKernelStart);
-            leftKernelStartBuf = inputBuf + (rowOffset + leftKernelStart);
-            llKernelStartBuf   = inputBuf + (rowOffset + llKernelStart);
-            for(ossim_int32 col = 0; col < outputH; ++col)
-            {
-
-               if((ulKernelStartBuf[0]   != nullPix)&&
-                  (ulKernelStartBuf[1]   != nullPix)&&
-                  (ulKernelStartBuf[2]   != nullPix)&&
-                  (leftKernelStartBuf[0] != nullPix)&&
-                  (leftKernelStartBuf[1] != nullPix)&&
-                  (leftKernelStartBuf[2] != nullPix)&&
-                  (llKernelStartBuf[0]   != nullPix)&&
-                  (llKernelStartBuf[1]   != nullPix)&&
-                  (llKernelStartBuf[2]   != nullPix))
-               {
-                  sum = theKernel[0][0]*(double)ulKernelStartBuf[0] +
-                        theKernel[0][1]*(double)ulKernelStartBuf[1] +
-                        theKernel[0][2]*(double)ulKernelStartBuf[2] +
-                        theKernel[1][0]*(double)leftKernelStartBuf[0] +
-                        theKernel[1][1]*(double)leftKernelStartBuf[1] +
-                        theKernel[1][2]*(double)leftKernelStartBuf[2] +
-                        theKernel[2][0]*(double)llKernelStartBuf[0] +
-                        theKernel[2][1]*(double)llKernelStartBuf[1] +
-                        theKernel[2][2]*(double)llKernelStartBuf[2];
-                  
-                  if(sum > maxPix)
-                  {
-                     *outputBuf = maxPix;
-                  }
-                  else if(sum < minPix)
-                  {
-                     *outputBuf = minPix;
-                  }
-                  else
-                  {
-                     *outputBuf = static_cast<T>(sum);
-                  }
-               }
-               else {
-                  *outputBuf = oNullPix;
-               }
-               //
-               // Need to implement the convolution here
-               //
-               
-               ++ulKernelStartBuf;
-               ++leftKernelStartBuf;
-               ++llKernelStartBuf;
-               ++outputBuf;
-            }
-         }
-      }
+      convolve.m_minPix[band]  = getMinPixelValue(band);
+      convolve.m_maxPix[band]  = getMaxPixelValue(band);
+      convolve.m_nullPix[band] = getNullPixelValue(band);
    }
-}
-
-template<class T> void ossim3x3ConvolutionFilter::convolveFull(
-   T,
-   ossimRefPtr<ossimImageData> inputData,
-   ossimRefPtr<ossimImageData> outputData)
-{
-   // let's set up some temporary variables so we don't
-   // have to call the functions in loops.  Iknow that compilers
-   // typically optimize this out but if we are in debug mode 
-   // with no optimization it will still run fast
-   //
-   double sum = 0.0;
-   ossim_int32 inputW = static_cast<ossim_int32>(inputData->getWidth());
-   ossim_uint32 outputW       = outputData->getWidth();
-   ossim_uint32 outputH       = outputData->getHeight();
-   ossim_uint32 numberOfBands = inputData->getNumberOfBands();
-   ossimIpt outputOrigin = outputData->getOrigin();
-   ossimIpt inputOrigin  = inputData->getOrigin();
-   
-   ossim_int32 startInputOffset = std::abs(outputOrigin.y - inputOrigin.y)*
-      inputW + std::abs(outputOrigin.x - inputOrigin.x);
-   ossim_int32 ulKernelStart    = -inputW - 1;
-   ossim_int32 leftKernelStart  = -1;
-   ossim_int32 llKernelStart    = inputW  - 1;
-   
-   T* ulKernelStartBuf   = NULL;
-   T* leftKernelStartBuf = NULL;
-   T* llKernelStartBuf   = NULL;
-   
-   for(ossim_uint32 band = 0; band < numberOfBands; ++band)
+   if ( !ossim::dispatchScalarType(data->getScalarType(), convolve) )
    {
-      T* inputBuf  = static_cast<T*>(inputData->getBuf(band))+startInputOffset;
-      T* outputBuf = static_cast<T*>(outputData->getBuf(band));
-      T maxPix     = static_cast<T>(getMaxPixelValue(band));
-      T minPix     = static_cast<T>(getMinPixelValue(band));
-      
-      if(inputBuf&&outputBuf)
-      {
-         for(ossim_uint32 row = 0; row < outputW; ++row)
-         {
-            ossim_int32 rowOffset    = inputW*row;
-            ulKernelStartBuf   = inputBuf + (rowOffset + ulKernelStart);
-            leftKernelStartBuf = inputBuf + (rowOffset + leftKernelStart);
-            llKernelStartBuf   = inputBuf + (rowOffset + llKernelStart);
-            for(ossim_uint32 col = 0; col < outputH; ++col)
-            {
-               sum = theKernel[0][0]*(double)ulKernelStartBuf[0] +
-                     theKernel[0][1]*(double)ulKernelStartBuf[1] +
-                     theKernel[0][2]*(double)ulKernelStartBuf[2] +
-                     theKernel[1][0]*(double)leftKernelStartBuf[0] +
-                     theKernel[1][1]*(double)leftKernelStartBuf[1] +
-                     theKernel[1][2]*(double)leftKernelStartBuf[2] +
-                     theKernel[2][0]*(double)llKernelStartBuf[0] +
-                     theKernel[2][1]*(double)llKernelStartBuf[1] +
-                     theKernel[2][2]*(double)llKernelStartBuf[2];
-               
-               if(sum > maxPix)
-               {
-                  *outputBuf = maxPix;
-               }
-               else if(sum < minPix)
-               {
-                  *outputBuf = minPix;
-               }
-               else
-               {
-                  *outputBuf = static_cast<T>(sum);
-               }
-               //
-               // Need to implement the convolution here.
-               //
-
-               
-               ++ulKernelStartBuf;
-               ++leftKernelStartBuf;
-               ++llKernelStartBuf;
-               ++outputBuf;
-            }
-         }
-      }
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossim3x3ConvolutionFilter::getTile WARNING:\n"
+         << "Scalar type = " << theTile->getScalarType()
+         << " Not supported by ossim3x3ConvolutionFilter" << endl;
    }
+   theTile->validate();
+   
+   return theTile;
 }
 
 void ossim3x3ConvolutionFilter::initialize()
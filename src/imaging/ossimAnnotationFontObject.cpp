@@ -22,7 +22,10 @@ ossimAnnotationFontObject::ossimAnnotationFontObject()
     theHorizontalScale(0.0),
     theVerticalScale(0.0),
     theHorizontalShear(0.0),
-    theVerticalShear(0.0)
+    theVerticalShear(0.0),
+    theRaster(),
+    theRasterRect(),
+    theRasterDirtyFlag(true)
 {
    setFontInfo();
    theBoundingRect.makeNan();
@@ -45,7 +48,10 @@ ossimAnnotationFontObject::ossimAnnotationFontObject(const ossimIpt& upperLeft,
     theHorizontalScale(scale.x),
     theVerticalScale(scale.y),
     theHorizontalShear(shear.x),
-    theVerticalShear(shear.y)
+    theVerticalShear(shear.y),
+    theRaster(),
+    theRasterRect(),
+    theRasterDirtyFlag(true)
 {
    setFontInfo();
    thePosition = upperLeft;
@@ -70,7 +76,10 @@ ossimAnnotationFontObject::ossimAnnotationFontObject(const ossimAnnotationFontOb
     theVerticalScale(rhs.theVerticalScale),
     theHorizontalShear(rhs.theHorizontalShear),
     theVerticalShear(rhs.theVerticalShear),
-    theBoundingRect(rhs.theBoundingRect)
+    theBoundingRect(rhs.theBoundingRect),
+    theRaster(),
+    theRasterRect(),
+    theRasterDirtyFlag(true)
 {
    theFont = rhs.theFont;
    setFontInfo();
@@ -112,22 +121,22 @@ void ossimAnnotationFontObject::draw(ossimRgbImage& anImage)const
       
       if(boundingRect.intersects(destRect))
       {
-         setFontInfo();
- 
-         ossimIrect fontBufferRect;
-         ossimIrect boundingFontBox;
-         
-         theFont->setClippingBox(destRect);
-         theFont->getBoundingBox(boundingFontBox);
-
-         const ossim_uint8* srcBuf = theFont->rasterize();
-         if (!srcBuf)
+         if(theRasterDirtyFlag)
+         {
+            rasterizeString();
+         }
+         if(theRaster.empty() || !boundingRect.intersects(theRasterRect))
          {
             return;
          }
-         
-         theFont->getBufferRect(fontBufferRect);
+         const ossim_uint8* srcBuf = &theRaster.front();
+         const ossimIrect& fontBufferRect = theRasterRect;
          ossimIrect clipRect = boundingRect.clipToRect(fontBufferRect);
+         if(!clipRect.intersects(destRect))
+         {
+            return;
+         }
+         clipRect = clipRect.clipToRect(destRect);
          
          long clipHeight = clipRect.height();
          long clipWidth  = clipRect.width();
@@ -231,6 +240,7 @@ bool ossimAnnotationFontObject::isPointWithin(const ossimDpt& imagePoint)const
 void ossimAnnotationFontObject::setFont(ossimFont* font)
 {
     theFont = font;
+    theRasterDirtyFlag = true;
 
    if(!theFont)
    {
@@ -267,9 +277,31 @@ void ossimAnnotationFontObject::setFontInfo()const
    }
 }
 
+void ossimAnnotationFontObject::rasterizeString()const
+{
+   theRaster.clear();
+   theRasterRect.makeNan();
+   theRasterDirtyFlag = false;
+   if(!theFont.valid())
+   {
+      return;
+   }
+
+   // The font is shared with other objects, so set it up for this string.
+   setFontInfo();
+   theFont->setClippingBox();
+   const ossim_uint8* buf = theFont->rasterize();
+   if(buf)
+   {
+      theFont->getBufferRect(theRasterRect);
+      theRaster.assign(buf, buf + theRasterRect.width()*theRasterRect.height());
+   }
+}
+
 void ossimAnnotationFontObject::setString(const ossimString& s)
 {
    theString = s;
+   theRasterDirtyFlag = true;
 }
 
 ossimString ossimAnnotationFontObject::getString()const
@@ -295,6 +327,7 @@ bool ossimAnnotationFontObject::intersects(const ossimDrect& rect)const
 void ossimAnnotationFontObject::setPointSize(const ossimIpt& size)
 {
    thePixelSize = size;
+   theRasterDirtyFlag = true;
    setFontInfo();
    if (theFont.valid())
    {
@@ -307,6 +340,7 @@ void ossimAnnotationFontObject::setPointSize(const ossimIpt& size)
 void ossimAnnotationFontObject::setRotation(double rotation)
 {
    theRotation = rotation;
+   theRasterDirtyFlag = true;
    setFontInfo();
    if (theFont.valid())
    {
@@ -320,6 +354,7 @@ void ossimAnnotationFontObject::setScale(const ossimDpt& scale)
 {
    theHorizontalScale = scale.x;
    theVerticalScale   = scale.y;
+   theRasterDirtyFlag = true;
    setFontInfo();
    if (theFont.valid())
    {
@@ -333,6 +368,7 @@ void ossimAnnotationFontObject::setShear(const ossimDpt& shear)
 {
    theHorizontalShear = shear.x;
    theVerticalShear   = shear.y;
+   theRasterDirtyFlag = true;
    setFontInfo();
    if (theFont.valid())
    {
@@ -350,6 +386,7 @@ void ossimAnnotationFontObject::setGeometryInformation(const ossimFontInformatio
    theVerticalScale   = info.theScale.y;
    theHorizontalShear = info.theShear.x;
    theVerticalShear   = info.theShear.y;
+   theRasterDirtyFlag = true;
    
    setFontInfo();
    if (theFont.valid())
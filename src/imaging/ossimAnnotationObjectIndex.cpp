@@ -0,0 +1,169 @@
+//*******************************************************************
+//
+// License:  See LICENSE.txt file in the top level directory.
+//
+// Description:
+//
+// Contains definition of class ossimAnnotationObjectIndex.
+//
+//*******************************************************************
+
+#include <ossim/imaging/ossimAnnotationObjectIndex.h>
+#include <ossim/base/ossimCommon.h>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+   /** Fewer objects than this are all visited without the grid. */
+   const ossim_uint32 MIN_INDEXED_OBJECTS = 32;
+
+   /** Smallest cell, in pixels: about a tile. */
+   const double MIN_CELL_SIZE = 256.0;
+
+   /** An object covering more cells than this goes to theUnindexed. */
+   const ossim_int64 MAX_CELLS_PER_OBJECT = 64;
+
+   /**
+    * Pixels queries are grown by.  The objects clip their drawing to the
+    * tile grown by 10 pixels and draw thick lines past their bounds.
+    */
+   const double QUERY_MARGIN = 16.0;
+}
+
+ossimAnnotationObjectIndex::ossimAnnotationObjectIndex()
+   : theNumberOfObjects(0),
+     theOrigin(0.0, 0.0),
+     theCellSize(0.0),
+     theCols(0),
+     theRows(0),
+     theCells(),
+     theUnindexed()
+{
+}
+
+void ossimAnnotationObjectIndex::clear()
+{
+   theNumberOfObjects = 0;
+   theOrigin = ossimDpt(0.0, 0.0);
+   theCellSize = 0.0;
+   theCols = 0;
+   theRows = 0;
+   theCells.clear();
+   theUnindexed.clear();
+}
+
+bool ossimAnnotationObjectIndex::isIndexed()const
+{
+   return (theCellSize > 0.0);
+}
+
+ossim_uint32 ossimAnnotationObjectIndex::getNumberOfObjects()const
+{
+   return theNumberOfObjects;
+}
+
+void ossimAnnotationObjectIndex::build(const std::vector<ossimDrect>& rects)
+{
+   clear();
+   theNumberOfObjects = (ossim_uint32)rects.size();
+   if ( theNumberOfObjects < MIN_INDEXED_OBJECTS )
+   {
+      return;
+   }
+
+   ossimDrect bounds;
+   bounds.makeNan();
+   ossim_uint32 idx;
+   for (idx = 0; idx < theNumberOfObjects; ++idx)
+   {
+      if ( !rects[idx].hasNans() )
+      {
+         bounds = bounds.hasNans() ? rects[idx] : bounds.combine(rects[idx]);
+      }
+   }
+   if ( bounds.hasNans() )
+   {
+      return;
+   }
+
+   // About one cell per object over the bounds of all of them:
+   const double WIDTH  = bounds.lr().x - bounds.ul().x + 1.0;
+   const double HEIGHT = bounds.lr().y - bounds.ul().y + 1.0;
+   const double CELL_SIZE = ossim::max(MIN_CELL_SIZE,
+                                       std::sqrt(WIDTH*HEIGHT/theNumberOfObjects));
+   theOrigin = bounds.ul();
+   theCols = (ossim_int32)std::ceil(WIDTH/CELL_SIZE);
+   theRows = (ossim_int32)std::ceil(HEIGHT/CELL_SIZE);
+   theCellSize = CELL_SIZE;
+   theCells.resize(theCols*theRows);
+
+   for (idx = 0; idx < theNumberOfObjects; ++idx)
+   {
+      const ossimDrect& rect = rects[idx];
+      if ( rect.hasNans() )
+      {
+         theUnindexed.push_back(idx);
+         continue;
+      }
+      const ossim_int32 C0 = (ossim_int32)((rect.ul().x - theOrigin.x)/theCellSize);
+      const ossim_int32 C1 = (ossim_int32)((rect.lr().x - theOrigin.x)/theCellSize);
+      const ossim_int32 R0 = (ossim_int32)((rect.ul().y - theOrigin.y)/theCellSize);
+      const ossim_int32 R1 = (ossim_int32)((rect.lr().y - theOrigin.y)/theCellSize);
+      if ( (ossim_int64)(C1 - C0 + 1)*(R1 - R0 + 1) > MAX_CELLS_PER_OBJECT )
+      {
+         theUnindexed.push_back(idx);
+         continue;
+      }
+      for (ossim_int32 row = ossim::max(R0, 0); row <= ossim::min(R1, theRows - 1); ++row)
+      {
+         for (ossim_int32 col = ossim::max(C0, 0); col <= ossim::min(C1, theCols - 1); ++col)
+         {
+            theCells[row*theCols + col].push_back(idx);
+         }
+      }
+   }
+}
+
+void ossimAnnotationObjectIndex::query(const ossimDrect& rect,
+                                       std::vector<ossim_uint32>& result)const
+{
+   result.clear();
+   if ( !isIndexed() || rect.hasNans() )
+   {
+      result.resize(theNumberOfObjects);
+      for (ossim_uint32 idx = 0; idx < theNumberOfObjects; ++idx)
+      {
+         result[idx] = idx;
+      }
+      return;
+   }
+
+   result = theUnindexed;
+
+   const double MIN_X = rect.ul().x - QUERY_MARGIN - theOrigin.x;
+   const double MAX_X = rect.lr().x + QUERY_MARGIN - theOrigin.x;
+   const double MIN_Y = rect.ul().y - QUERY_MARGIN - theOrigin.y;
+   const double MAX_Y = rect.lr().y + QUERY_MARGIN - theOrigin.y;
+   const double GRID_WIDTH  = theCols*theCellSize;
+   const double GRID_HEIGHT = theRows*theCellSize;
+   if ( (MAX_X >= 0.0) && (MIN_X < GRID_WIDTH) && (MAX_Y >= 0.0) && (MIN_Y < GRID_HEIGHT) )
+   {
+      const ossim_int32 C0 = ossim::max((ossim_int32)(MIN_X/theCellSize), 0);
+      const ossim_int32 C1 = ossim::min((ossim_int32)(MAX_X/theCellSize), theCols - 1);
+      const ossim_int32 R0 = ossim::max((ossim_int32)(MIN_Y/theCellSize), 0);
+      const ossim_int32 R1 = ossim::min((ossim_int32)(MAX_Y/theCellSize), theRows - 1);
+      for (ossim_int32 row = R0; row <= R1; ++row)
+      {
+         for (ossim_int32 col = C0; col <= C1; ++col)
+         {
+            const std::vector<ossim_uint32>& cell = theCells[row*theCols + col];
+            result.insert(result.end(), cell.begin(), cell.end());
+         }
+      }
+   }
+
+   // Objects span cells; keep each once, in drawing order:
+   std::sort(result.begin(), result.end());
+   result.erase(std::unique(result.begin(), result.end()), result.end());
+}
@@ -24,7 +24,10 @@ ossimAnnotationSource::ossimAnnotationSource(ossimImageSource* inputSource)
       theNumberOfBands(1),
       theImage(0),
       theTile(0),
-      theAnnotationObjectList()
+      theAnnotationObjectList(),
+      theObjectIndex(),
+      theObjectIndexDirtyFlag(true),
+      theDrawList()
 {
    theRectangle.makeNan();
 }
@@ -215,6 +218,7 @@ bool ossimAnnotationSource::addObject(ossimAnnotationObject* anObject)
    if(anObject)
    {
       theAnnotationObjectList.push_back(anObject);
+      invalidateObjectIndex();
       return true;
    }
 
@@ -232,6 +236,7 @@ bool ossimAnnotationSource::deleteObject(ossimAnnotationObject* anObject)
          if(*current == anObject)
          {
             theAnnotationObjectList.erase(current);
+            invalidateObjectIndex();
             return true;
          }
          ++current;
@@ -316,6 +321,7 @@ bool ossimAnnotationSource::loadState(const ossimKeywordlist& kwl,
 void ossimAnnotationSource::computeBoundingRect()
 {   
    theRectangle.makeNan();
+   invalidateObjectIndex();
 
    if(theAnnotationObjectList.size()>0)
    {
@@ -401,6 +407,7 @@ void ossimAnnotationSource::deleteAll()
    AnnotationObjectListType::iterator obj;
 
    theAnnotationObjectList.clear();
+   invalidateObjectIndex();
 }
 
 void ossimAnnotationSource::drawAnnotations(ossimRefPtr<ossimImageData> tile)
@@ -409,19 +416,48 @@ void ossimAnnotationSource::drawAnnotations(ossimRefPtr<ossimImageData> tile)
 
    if(theImage->getImageData().valid())
    {
-      AnnotationObjectListType::iterator object =
-         theAnnotationObjectList.begin();
-      while(object != theAnnotationObjectList.end())
+      updateObjectIndex();
+      theObjectIndex.query(theImage->getImageData()->getImageRectangle(), theDrawList);
+      for(ossim_uint32 idx = 0; idx < theDrawList.size(); ++idx)
       {
-         if((*object).valid())
+         const ossimRefPtr<ossimAnnotationObject>& object =
+            theAnnotationObjectList[theDrawList[idx]];
+         if(object.valid())
          {
-            (*object)->draw(*theImage);
+            object->draw(*theImage);
          }
-         ++object;
       }      
    }
 }
 
+void ossimAnnotationSource::invalidateObjectIndex()
+{
+   theObjectIndexDirtyFlag = true;
+}
+
+void ossimAnnotationSource::updateObjectIndex()
+{
+   // The list is public through getObjectList(); a size change also counts.
+   if(theObjectIndexDirtyFlag ||
+      (theObjectIndex.getNumberOfObjects() != theAnnotationObjectList.size()))
+   {
+      std::vector<ossimDrect> rects(theAnnotationObjectList.size());
+      for(ossim_uint32 idx = 0; idx < rects.size(); ++idx)
+      {
+         if(theAnnotationObjectList[idx].valid())
+         {
+            theAnnotationObjectList[idx]->getBoundingRect(rects[idx]);
+         }
+         else
+         {
+            rects[idx].makeNan();
+         }
+      }
+      theObjectIndex.build(rects);
+      theObjectIndexDirtyFlag = false;
+   }
+}
+
 const ossimAnnotationSource::AnnotationObjectListType&
 ossimAnnotationSource::getObjectList()const
 {
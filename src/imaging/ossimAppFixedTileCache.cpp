@@ -17,6 +17,7 @@
 #include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossimCommon.h>
 #include <ossim/base/ossimTrace.h>
+#include <ossim/imaging/ossimImageData.h>
 #include <OpenThreads/ScopedLock>
 
 ossimAppFixedTileCache* ossimAppFixedTileCache::theInstance = 0;
@@ -24,20 +25,39 @@ ossimAppFixedTileCache::ossimAppFixedCacheId ossimAppFixedTileCache::theUniqueAp
 const ossim_uint32 ossimAppFixedTileCache::DEFAULT_SIZE = 1024*1024*80;
 
 static const ossimTrace traceDebug("ossimAppFixedTileCache:debug");
+
+// Shard count bounds.  Actual count follows the number of threads.
+static const ossim_uint32 MIN_SHARDS = 4;
+static const ossim_uint32 MAX_SHARDS = 64;
+
 std::ostream& operator <<(std::ostream& out, const ossimAppFixedTileCache& rhs)
 {
-   std::map<ossimAppFixedTileCache::ossimAppFixedCacheId, ossimFixedTileCache*>::const_iterator iter = rhs.theAppCacheMap.begin();
+   // Sum the sub caches of each id over all shards.
+   std::map<ossimAppFixedTileCache::ossimAppFixedCacheId, ossim_uint32> sizes;
+   for(ossim_uint32 i = 0; i < rhs.theShards.size(); ++i)
+   {
+      const ossimAppFixedTileCache::Shard* shard = rhs.theShards[i];
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+      std::map<ossimAppFixedTileCache::ossimAppFixedCacheId, ossimRefPtr<ossimFixedTileCache> >::const_iterator iter = shard->theCacheMap.begin();
+      while(iter != shard->theCacheMap.end())
+      {
+         sizes[(*iter).first] += (*iter).second->getCacheSize();
+         ++iter;
+      }
+   }
 
-   if(iter == rhs.theAppCacheMap.end())
+   std::map<ossimAppFixedTileCache::ossimAppFixedCacheId, ossim_uint32>::const_iterator iter = sizes.begin();
+
+   if(iter == sizes.end())
    {
       ossimNotify(ossimNotifyLevel_NOTICE)
          << "***** APP CACHE EMPTY *****" << endl;
    }
    else
    {
-      while(iter != rhs.theAppCacheMap.end())
+      while(iter != sizes.end())
       {
-         out << "Cache id = "<< (*iter).first << " size = " << (*iter).second->getCacheSize() << endl;
+         out << "Cache id = "<< (*iter).first << " size = " << (*iter).second << endl;
          ++iter;
       }
    }
@@ -45,6 +65,114 @@ std::ostream& operator <<(std::ostream& out, const ossimAppFixedTileCache& rhs)
    return out;
 }
 
+ossimAppFixedTileCache::Shard::Shard()
+   : theMutex(),
+     theCacheMap(),
+     theCurrentCacheSize(0),
+     theMaxCacheSize(0),
+     theMaxGlobalCacheSize(0),
+     theStatistics(),
+     thePeakCacheSize(0)
+{
+}
+
+ossimAppFixedTileCache::Shard::~Shard()
+{
+   theCacheMap.clear();
+}
+
+ossimFixedTileCache* ossimAppFixedTileCache::Shard::getCache(
+   ossimAppFixedCacheId cacheId)
+{
+   std::map<ossimAppFixedCacheId, ossimRefPtr<ossimFixedTileCache> >::iterator
+      currentIter = theCacheMap.find(cacheId);
+   ossimFixedTileCache* result = 0;
+   
+   if(currentIter != theCacheMap.end())
+   {
+      result = (*currentIter).second.get();
+   }
+
+   return result;
+}
+
+void ossimAppFixedTileCache::Shard::shrink(ossim_int32 byteCount)
+{
+   if(static_cast<ossim_uint32>(byteCount) >= theCurrentCacheSize)
+   {
+      std::map<ossimAppFixedCacheId, ossimRefPtr<ossimFixedTileCache> >::iterator iter = theCacheMap.begin();
+      while(iter != theCacheMap.end())
+      {
+         theStatistics[(*iter).first].theEvictions += (*iter).second->getNumberOfTiles();
+         (*iter).second->flush();
+         ++iter;
+      }
+      theCurrentCacheSize = 0;
+   }
+   else
+   {
+      // Take the least recently used tile of each sub cache in turn.
+      while(byteCount > 0)
+      {
+         ossim_uint32 freed = 0;
+         std::map<ossimAppFixedCacheId, ossimRefPtr<ossimFixedTileCache> >::iterator iter = theCacheMap.begin();
+         while( (iter != theCacheMap.end())&&(byteCount>0))
+         {
+            ossim_uint32 before = (*iter).second->getCacheSize();
+            ossim_uint32 tiles = (*iter).second->getNumberOfTiles();
+            (*iter).second->deleteTile();
+            ossim_uint32 delta = (before - (*iter).second->getCacheSize());
+            theStatistics[(*iter).first].theEvictions += (tiles - (*iter).second->getNumberOfTiles());
+            byteCount -= delta;
+            theCurrentCacheSize -= delta;
+            freed += delta;
+            ++iter;
+         }
+         if(!freed)
+         {
+            break; // Nothing left to evict.
+         }
+      }
+   }
+}
+
+void ossimAppFixedTileCache::Shard::shrinkCache(ossimAppFixedCacheId cacheId,
+                                                ossimFixedTileCache* cache,
+                                                ossim_int32 byteCount)
+{
+   if(cache)
+   {
+      Statistics& stats = theStatistics[cacheId];
+      ossim_int32 cacheSize = cache->getCacheSize();
+      if(cacheSize <= byteCount)
+      {
+         theCurrentCacheSize -= cacheSize;
+         stats.theEvictions += cache->getNumberOfTiles();
+         cache->flush();
+      }
+      else
+      {
+         while(byteCount > 0)
+         {
+            ossim_uint32 before = cache->getCacheSize();
+            ossim_uint32 tiles = cache->getNumberOfTiles();
+            cache->deleteTile();
+            ossim_uint32 after = cache->getCacheSize();
+            ossim_uint32 delta = std::abs((int)(before - after));
+            stats.theEvictions += (tiles - cache->getNumberOfTiles());
+            if(delta)
+            {
+               byteCount -= delta;
+               theCurrentCacheSize -= (delta);
+            }
+            else
+            {
+               byteCount = 0;
+            }
+         }
+      }
+   }
+}
 
 ossimAppFixedTileCache::ossimAppFixedTileCache()
 {
@@ -54,7 +182,14 @@ ossimAppFixedTileCache::ossimAppFixedTileCache()
    }
    theInstance = this;
    theTileSize = ossimIpt(64, 64);
-   theCurrentCacheSize = 0;
+
+   ossim_uint32 shards = ossim::getNumberOfThreads();
+   if (shards < MIN_SHARDS) shards = MIN_SHARDS;
+   if (shards > MAX_SHARDS) shards = MAX_SHARDS;
+   for (ossim_uint32 i = 0; i < shards; ++i)
+   {
+      theShards.push_back(new Shard());
+   }
 
    // ossim::defaultTileSize(theTileSize);
    
@@ -89,7 +224,8 @@ ossimAppFixedTileCache::ossimAppFixedTileCache()
    {
       ossimNotify(ossimNotifyLevel_DEBUG)
          << "DEBUG: cache tile size = " << theTileSize << std::endl
-         << "Cache size = " << cacheSize << " bytes" << std::endl;
+         << "Cache size = " << cacheSize << " bytes" << std::endl
+         << "Cache shards = " << theShards.size() << std::endl;
    }
 
    if(traceDebug())
@@ -102,6 +238,11 @@ ossimAppFixedTileCache::ossimAppFixedTileCache()
 ossimAppFixedTileCache::~ossimAppFixedTileCache()
 {
    deleteAll();
+   for (ossim_uint32 i = 0; i < theShards.size(); ++i)
+   {
+      delete theShards[i];
+   }
+   theShards.clear();
 }
 
 ossimAppFixedTileCache *ossimAppFixedTileCache::instance(ossim_uint32  maxSize)
@@ -123,29 +264,42 @@ void ossimAppFixedTileCache::setMaxCacheSize(ossim_uint32 cacheSize)
    theMaxGlobalCacheSize = cacheSize;
    theMaxCacheSize = cacheSize;
    //   theMaxCacheSize      = (ossim_uint32)(theMaxGlobalCacheSize*.2);
+
+   const ossim_uint32 SHARDS = (ossim_uint32)theShards.size();
+   for (ossim_uint32 i = 0; i < SHARDS; ++i)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> shardLock(theShards[i]->theMutex);
+      theShards[i]->theMaxGlobalCacheSize = theMaxGlobalCacheSize / SHARDS;
+      theShards[i]->theMaxCacheSize       = theMaxCacheSize / SHARDS;
+   }
 }
 
 void ossimAppFixedTileCache::flush()
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   std::map<ossimAppFixedCacheId, ossimFixedTileCache*>::iterator currentIter = theAppCacheMap.begin();
-   
-   while(currentIter != theAppCacheMap.end())
+   for (ossim_uint32 i = 0; i < theShards.size(); ++i)
    {
-      (*currentIter).second->flush();
-      ++currentIter;
+      Shard* shard = theShards[i];
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+      std::map<ossimAppFixedCacheId, ossimRefPtr<ossimFixedTileCache> >::iterator currentIter = shard->theCacheMap.begin();
+      while(currentIter != shard->theCacheMap.end())
+      {
+         (*currentIter).second->flush();
+         ++currentIter;
+      }
+      shard->theCurrentCacheSize = 0;
    }
-   theCurrentCacheSize = 0;
 }
 
 void ossimAppFixedTileCache::flush(ossimAppFixedCacheId cacheId)
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   ossimFixedTileCache* cache = getCache(cacheId);
+   for (ossim_uint32 i = 0; i < theShards.size(); ++i)
    {
+      Shard* shard = theShards[i];
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+      ossimFixedTileCache* cache = shard->getCache(cacheId);
       if(cache)
       {
-         theCurrentCacheSize -= cache->getCacheSize();
+         shard->theCurrentCacheSize -= cache->getCacheSize();
          cache->flush();
       }
    }
@@ -153,16 +307,21 @@ void ossimAppFixedTileCache::flush(ossimAppFixedCacheId cacheId)
 
 void ossimAppFixedTileCache::deleteCache(ossimAppFixedCacheId cacheId)
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   ossimRefPtr<ossimFixedTileCache> cache = getCache(cacheId);
+   for (ossim_uint32 i = 0; i < theShards.size(); ++i)
    {
-      std::map<ossimAppFixedCacheId, ossimFixedTileCache*>::iterator iter = theAppCacheMap.find(cacheId);
-      
-      if(cache.valid())
+      Shard* shard = theShards[i];
+      ossimRefPtr<ossimFixedTileCache> cache = 0;
       {
-         theAppCacheMap.erase(iter);
-         theCurrentCacheSize -= cache->getCacheSize();
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+         std::map<ossimAppFixedCacheId, ossimRefPtr<ossimFixedTileCache> >::iterator iter = shard->theCacheMap.find(cacheId);
+         if(iter != shard->theCacheMap.end())
+         {
+            cache = (*iter).second;
+            shard->theCurrentCacheSize -= cache->getCacheSize();
+            shard->theCacheMap.erase(iter);
+         }
       }
+      // Tiles are released here, outside of the shard lock.
       cache = 0;
    }
 }
@@ -170,38 +329,45 @@ void ossimAppFixedTileCache::deleteCache(ossimAppFixedCacheId cacheId)
 ossimAppFixedTileCache::ossimAppFixedCacheId ossimAppFixedTileCache::newTileCache(const ossimIrect& tileBoundaryRect,
                                                                                   const ossimIpt& tileSize)
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   ossimAppFixedCacheId result = -1; 
-   ossimFixedTileCache* newCache = new ossimFixedTileCache;
-   if(tileSize.x == 0 ||
-      tileSize.y == 0)
-   {
-      // newCache->setRect(tileBoundaryRect, theTileSize);
-      newCache->setRect(tileBoundaryRect,
-                        newCache->getTileSize());
-   }
-   else
+   ossimAppFixedCacheId result = newTileCache();
+   for (ossim_uint32 i = 0; i < theShards.size(); ++i)
    {
-      newCache->setRect(tileBoundaryRect, tileSize);
+      Shard* shard = theShards[i];
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+      ossimFixedTileCache* newCache = shard->getCache(result);
+      if(tileSize.x == 0 ||
+         tileSize.y == 0)
+      {
+         // newCache->setRect(tileBoundaryRect, theTileSize);
+         newCache->setRect(tileBoundaryRect,
+                           newCache->getTileSize());
+      }
+      else
+      {
+         newCache->setRect(tileBoundaryRect, tileSize);
+      }
    }
-   result = theUniqueAppIdCounter;
-   theAppCacheMap.insert(std::make_pair(result, newCache));
-   ++theUniqueAppIdCounter;
    
    return result;
 }
 
 ossimAppFixedTileCache::ossimAppFixedCacheId ossimAppFixedTileCache::newTileCache()
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
    ossimAppFixedCacheId result = -1;
-   ossimFixedTileCache* newCache = new ossimFixedTileCache;
-   
    {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
       result = theUniqueAppIdCounter;
-      theAppCacheMap.insert(std::make_pair(result, newCache));
       ++theUniqueAppIdCounter;
    }
+
+   // One sub cache per shard, all sharing the same rect and tile size.
+   for (ossim_uint32 i = 0; i < theShards.size(); ++i)
+   {
+      Shard* shard = theShards[i];
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+      shard->theCacheMap.insert(std::make_pair(result, ossimRefPtr<ossimFixedTileCache>(new ossimFixedTileCache)));
+      shard->theStatistics[result] = Statistics();
+   }
    
    return result;
    
@@ -210,30 +376,44 @@ ossimAppFixedTileCache::ossimAppFixedCacheId ossimAppFixedTileCache::newTileCach
 void ossimAppFixedTileCache::setRect(ossimAppFixedCacheId cacheId,
                                      const ossimIrect& boundaryTileRect)
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   ossimFixedTileCache* cache = getCache(cacheId);
-   if(cache)
+   for (ossim_uint32 i = 0; i < theShards.size(); ++i)
    {
-      
-      ossim_uint32 cacheSize = cache->getCacheSize();
-      // cache->setRect(boundaryTileRect, theTileSize);
-      cache->setRect(boundaryTileRect,
-                     cache->getTileSize());      
-      theCurrentCacheSize += (cache->getCacheSize() - cacheSize);
+      Shard* shard = theShards[i];
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+      ossimFixedTileCache* cache = shard->getCache(cacheId);
+      if(cache)
+      {
+         ossim_uint32 cacheSize = cache->getCacheSize();
+         // cache->setRect(boundaryTileRect, theTileSize);
+         cache->setRect(boundaryTileRect,
+                        cache->getTileSize());      
+         shard->theCurrentCacheSize += (cache->getCacheSize() - cacheSize);
+      }
    }
 }
 
 void ossimAppFixedTileCache::setTileSize(ossimAppFixedCacheId cacheId,
                                          const ossimIpt& tileSize)
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   ossimFixedTileCache* cache = getCache(cacheId);
-   if(cache)
+   bool found = false;
+   for (ossim_uint32 i = 0; i < theShards.size(); ++i)
    {
-      ossim_uint32 cacheSize = cache->getCacheSize();
-      cache->setRect(cache->getTileBoundaryRect(), tileSize);
-      theCurrentCacheSize += (cache->getCacheSize() - cacheSize);
-      theTileSize = cache->getTileSize();
+      Shard* shard = theShards[i];
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+      ossimFixedTileCache* cache = shard->getCache(cacheId);
+      if(cache)
+      {
+         ossim_uint32 cacheSize = cache->getCacheSize();
+         cache->setRect(cache->getTileBoundaryRect(), tileSize);
+         shard->theCurrentCacheSize += (cache->getCacheSize() - cacheSize);
+         found = true;
+      }
+   }
+   if(found)
+   {
+      // Taken after the shard locks are released; setMaxCacheSize nests them the other way.
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+      theTileSize = tileSize;
    }
 }
 
@@ -241,12 +421,22 @@ ossimRefPtr<ossimImageData> ossimAppFixedTileCache::getTile(
    ossimAppFixedCacheId cacheId,
    const ossimIpt& origin)
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
    ossimRefPtr<ossimImageData> result = 0;
-   ossimFixedTileCache* cache = getCache(cacheId);
+   Shard* shard = getShard(cacheId, origin);
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+   ossimFixedTileCache* cache = shard->getCache(cacheId);
    if(cache)
    {
       result = cache->getTile(origin);
+      Statistics& stats = shard->theStatistics[cacheId];
+      if(result.valid())
+      {
+         ++stats.theHits;
+      }
+      else
+      {
+         ++stats.theMisses;
+      }
    }
 
    return result;
@@ -258,61 +448,76 @@ ossimRefPtr<ossimImageData> ossimAppFixedTileCache::addTile(
                                                             ossimRefPtr<ossimImageData> data,
                                                             bool duplicateData)
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
    ossimRefPtr<ossimImageData> result = 0;
-   ossimFixedTileCache *aCache = this->getCache(cacheId);
+   if(!data.valid())
+   {
+      return result;
+   }
+   Shard* shard = getShard(cacheId, data->getOrigin());
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+   ossimFixedTileCache *aCache = shard->getCache(cacheId);
    if(!aCache)
    {         
       return result;
    }
    ossim_uint32 dataSize = data->getDataSizeInBytes();
 
-   if( (theCurrentCacheSize+dataSize) > theMaxGlobalCacheSize)
+   if( (shard->theCurrentCacheSize+dataSize) > shard->theMaxGlobalCacheSize)
    {
-      shrinkGlobalCacheSize((ossim_int32)(theMaxGlobalCacheSize*0.1));
+      shard->shrink((ossim_int32)(shard->theMaxGlobalCacheSize*0.1));
    }
 
    ossim_uint32 cacheSize = 0;
    {
       cacheSize = aCache->getCacheSize();
    }
-   if(cacheSize > theMaxCacheSize)
+   if(cacheSize > shard->theMaxCacheSize)
    {
 //       shrinkCacheSize(aCache,
 //                       (ossim_int32)(aCache->getCacheSize()*.1));
-      shrinkCacheSize(aCache,
-                      (ossim_int32)(1024*1024));
+      shard->shrinkCache(cacheId,
+                         aCache,
+                         (ossim_int32)(1024*1024/theShards.size()));
    }
    {
       cacheSize = aCache->getCacheSize();
       result    = aCache->addTile(data, duplicateData);
    
-      theCurrentCacheSize += (aCache->getCacheSize() - cacheSize);
+      shard->theCurrentCacheSize += (aCache->getCacheSize() - cacheSize);
    }
+
+   Statistics& stats = shard->theStatistics[cacheId];
+   stats.thePeakBytes = std::max<ossim_uint64>(stats.thePeakBytes, aCache->getCacheSize());
+   shard->thePeakCacheSize = std::max(shard->thePeakCacheSize, shard->theCurrentCacheSize);
    
    return result;
 }
 
 void ossimAppFixedTileCache::deleteAll()
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   theCurrentCacheSize = 0;
-   theAppCacheMap.clear();
+   for (ossim_uint32 i = 0; i < theShards.size(); ++i)
+   {
+      Shard* shard = theShards[i];
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+      shard->theCurrentCacheSize = 0;
+      shard->theCacheMap.clear();
+   }
 }
 
 ossimRefPtr<ossimImageData> ossimAppFixedTileCache::removeTile(
    ossimAppFixedCacheId cacheId,
    const ossimIpt& origin)
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
    ossimRefPtr<ossimImageData> result = 0;
+   Shard* shard = getShard(cacheId, origin);
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
    
-   ossimFixedTileCache* cache = getCache(cacheId);
+   ossimFixedTileCache* cache = shard->getCache(cacheId);
    if(cache)
    {
       ossim_uint32 cacheSize = cache->getCacheSize();
       result = cache->removeTile(origin);
-      theCurrentCacheSize += (cache->getCacheSize() - cacheSize);
+      shard->theCurrentCacheSize += (cache->getCacheSize() - cacheSize);
    }
 
    return result;
@@ -321,110 +526,198 @@ ossimRefPtr<ossimImageData> ossimAppFixedTileCache::removeTile(
 void ossimAppFixedTileCache::deleteTile(ossimAppFixedCacheId cacheId,
                                         const ossimIpt& origin)
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   ossimFixedTileCache* cache = getCache(cacheId);
+   Shard* shard = getShard(cacheId, origin);
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+   ossimFixedTileCache* cache = shard->getCache(cacheId);
    if(cache)
    {
       ossim_uint32 cacheSize = cache->getCacheSize();
       cache->deleteTile(origin);
-      theCurrentCacheSize += (cache->getCacheSize() - cacheSize);
+      shard->theCurrentCacheSize += (cache->getCacheSize() - cacheSize);
    }
 }
 
-ossimFixedTileCache* ossimAppFixedTileCache::getCache(
-   ossimAppFixedCacheId cacheId)
-{   
-   std::map<ossimAppFixedCacheId, ossimFixedTileCache*>::const_iterator
-      currentIter = theAppCacheMap.find(cacheId);
-   ossimFixedTileCache* result = 0;
-   
-   if(currentIter != theAppCacheMap.end())
+ossimAppFixedTileCache::Shard* ossimAppFixedTileCache::getShard(
+   ossimAppFixedCacheId cacheId, const ossimIpt& origin)const
+{
+   // Tile origins are multiples of the tile size so mix the bits well before taking the modulus.
+   ossim_uint32 h = (ossim_uint32)origin.x * 73856093u;
+   h ^= (ossim_uint32)origin.y * 19349663u;
+   h ^= (ossim_uint32)cacheId * 83492791u;
+   h ^= (h >> 16);
+   h *= 0x45d9f3bu;
+   h ^= (h >> 16);
+   return theShards[h % theShards.size()];
+}
+
+const ossimIpt& ossimAppFixedTileCache::getTileSize(ossimAppFixedCacheId cacheId)
+{
+   // Sub caches of an id share a tile size; ask the first shard.
+   Shard* shard = theShards[0];
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+   ossimFixedTileCache* cache = shard->getCache(cacheId);
+   if(cache)
    {
-      result = (*currentIter).second;
+      return cache->getTileSize();
    }
+   return theTileSize;
+}
 
-   return result;
+ossim_uint32 ossimAppFixedTileCache::getMaxCacheSize()const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+   return theMaxGlobalCacheSize;
 }
 
-void ossimAppFixedTileCache::shrinkGlobalCacheSize(ossim_int32 byteCount)
+ossimAppFixedTileCache::Statistics::Statistics()
+   : theHits(0),
+     theMisses(0),
+     theEvictions(0),
+     theTiles(0),
+     theBytes(0),
+     thePeakBytes(0)
 {
-   if(static_cast<ossim_uint32>(byteCount) >= theCurrentCacheSize)
-   {
-      flush();
-   }
-   else
+}
+
+ossimAppFixedTileCache::Statistics& ossimAppFixedTileCache::Statistics::operator+=(
+   const Statistics& rhs)
+{
+   theHits      += rhs.theHits;
+   theMisses    += rhs.theMisses;
+   theEvictions += rhs.theEvictions;
+   theTiles     += rhs.theTiles;
+   theBytes     += rhs.theBytes;
+   thePeakBytes += rhs.thePeakBytes;
+   return *this;
+}
+
+bool ossimAppFixedTileCache::getStatistics(ossimAppFixedCacheId cacheId,
+                                           Statistics& stats)const
+{
+   bool result = false;
+   stats = Statistics();
+   for (ossim_uint32 i = 0; i < theShards.size(); ++i)
    {
-      while(byteCount > 0)
+      const Shard* shard = theShards[i];
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+      std::map<ossimAppFixedCacheId, Statistics>::const_iterator iter =
+         shard->theStatistics.find(cacheId);
+      if(iter != shard->theStatistics.end())
       {
-         std::map<ossimAppFixedCacheId, ossimFixedTileCache*>::iterator iter = theAppCacheMap.begin();
-         while( (iter != theAppCacheMap.end())&&(byteCount>0))
+         stats += (*iter).second;
+         std::map<ossimAppFixedCacheId, ossimRefPtr<ossimFixedTileCache> >::const_iterator
+            cacheIter = shard->theCacheMap.find(cacheId);
+         if(cacheIter != shard->theCacheMap.end())
          {
-            ossimFixedTileCache* cache = getCache((*iter).first);
-            if(cache)
-            {
-               ossim_uint32 before = cache->getCacheSize();
-               cache->deleteTile();
-               ossim_uint32 after = cache->getCacheSize();
-               ossim_uint32 delta = (before - after);
-               byteCount -= delta;
-               theCurrentCacheSize -= (delta);
-            }
-            ++iter;
+            stats.theTiles += (*cacheIter).second->getNumberOfTiles();
+            stats.theBytes += (*cacheIter).second->getCacheSize();
          }
+         result = true;
       }
    }
+   return result;
 }
 
-void ossimAppFixedTileCache::shrinkCacheSize(ossimAppFixedCacheId id,
-                                             ossim_int32 byteCount)
+void ossimAppFixedTileCache::getStatistics(
+   std::map<ossimAppFixedCacheId, Statistics>& stats)const
 {
-   ossimFixedTileCache* cache = getCache(id);
-
-   if(cache)
+   stats.clear();
+   for (ossim_uint32 i = 0; i < theShards.size(); ++i)
    {
-      shrinkCacheSize(cache, byteCount);
+      const Shard* shard = theShards[i];
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+      std::map<ossimAppFixedCacheId, Statistics>::const_iterator iter = shard->theStatistics.begin();
+      while(iter != shard->theStatistics.end())
+      {
+         Statistics& idStats = stats[(*iter).first];
+         idStats += (*iter).second;
+         std::map<ossimAppFixedCacheId, ossimRefPtr<ossimFixedTileCache> >::const_iterator
+            cacheIter = shard->theCacheMap.find((*iter).first);
+         if(cacheIter != shard->theCacheMap.end())
+         {
+            idStats.theTiles += (*cacheIter).second->getNumberOfTiles();
+            idStats.theBytes += (*cacheIter).second->getCacheSize();
+         }
+         ++iter;
+      }
    }
 }
 
-void ossimAppFixedTileCache::shrinkCacheSize(ossimFixedTileCache* cache,
-                                             ossim_int32 byteCount)
+void ossimAppFixedTileCache::getTotalStatistics(Statistics& stats)const
 {
-   if(cache)
+   stats = Statistics();
+   for (ossim_uint32 i = 0; i < theShards.size(); ++i)
    {
-      ossim_int32 cacheSize = cache->getCacheSize();
-      if(cacheSize <= byteCount)
+      const Shard* shard = theShards[i];
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+      std::map<ossimAppFixedCacheId, Statistics>::const_iterator iter = shard->theStatistics.begin();
+      while(iter != shard->theStatistics.end())
       {
-         cache->flush();
+         stats.theHits      += (*iter).second.theHits;
+         stats.theMisses    += (*iter).second.theMisses;
+         stats.theEvictions += (*iter).second.theEvictions;
+         ++iter;
       }
-      else
+      std::map<ossimAppFixedCacheId, ossimRefPtr<ossimFixedTileCache> >::const_iterator
+         cacheIter = shard->theCacheMap.begin();
+      while(cacheIter != shard->theCacheMap.end())
       {
-         while(byteCount > 0)
-         {
-            ossim_uint32 before = cache->getCacheSize();
-            cache->deleteTile();
-            ossim_uint32 after = cache->getCacheSize();
-            ossim_uint32 delta = std::abs((int)(before - after));
-            if(delta)
-            {
-               byteCount -= delta;
-               theCurrentCacheSize -= (delta);
-            }
-            else
-            {
-               byteCount = 0;
-            }
-         }
+         stats.theTiles += (*cacheIter).second->getNumberOfTiles();
+         ++cacheIter;
       }
+      stats.theBytes     += shard->theCurrentCacheSize;
+      stats.thePeakBytes += shard->thePeakCacheSize;
    }
 }
 
-const ossimIpt& ossimAppFixedTileCache::getTileSize(ossimAppFixedCacheId cacheId)
+void ossimAppFixedTileCache::resetStatistics()
 {
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   ossimFixedTileCache* cache = getCache(cacheId);
-   if(cache)
+   for (ossim_uint32 i = 0; i < theShards.size(); ++i)
    {
-      return cache->getTileSize();
+      Shard* shard = theShards[i];
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard->theMutex);
+      std::map<ossimAppFixedCacheId, Statistics>::iterator iter = shard->theStatistics.begin();
+      while(iter != shard->theStatistics.end())
+      {
+         ossimFixedTileCache* cache = shard->getCache((*iter).first);
+         (*iter).second = Statistics();
+         (*iter).second.thePeakBytes = cache ? cache->getCacheSize() : 0;
+         ++iter;
+      }
+      shard->thePeakCacheSize = shard->theCurrentCacheSize;
+   }
+}
+
+void ossimAppFixedTileCache::printStatistics(std::ostream& out)const
+{
+   Statistics total;
+   getTotalStatistics(total);
+   const ossim_uint64 LOOKUPS = total.theHits + total.theMisses;
+   out << "ossimAppFixedTileCache: max_bytes=" << getMaxCacheSize()
+       << " bytes=" << total.theBytes
+       << " peak_bytes=" << total.thePeakBytes
+       << " tiles=" << total.theTiles
+       << " hits=" << total.theHits
+       << " misses=" << total.theMisses
+       << " hit_rate=" << (LOOKUPS ? (double)total.theHits / LOOKUPS : 0.0)
+       << " evictions=" << total.theEvictions << "\n";
+
+   std::map<ossimAppFixedCacheId, Statistics> stats;
+   getStatistics(stats);
+   std::map<ossimAppFixedCacheId, Statistics>::const_iterator iter = stats.begin();
+   while(iter != stats.end())
+   {
+      const Statistics& s = (*iter).second;
+      if(s.theTiles || s.theHits || s.theMisses)
+      {
+         out << "   cache_id=" << (*iter).first
+             << " bytes=" << s.theBytes
+             << " peak_bytes=" << s.thePeakBytes
+             << " tiles=" << s.theTiles
+             << " hits=" << s.theHits
+             << " misses=" << s.theMisses
+             << " evictions=" << s.theEvictions << "\n";
+      }
+      ++iter;
    }
-   return theTileSize;
 }
@@ -68,16 +68,9 @@ ossimRefPtr<ossimImageData> ossimBandMergeSource::getTile(const ossimIrect& tile
       {
          theTile->initialize();
       }
-      else
-      {
-         theTile->makeBlank();
-      }
-   }
-   else
-   {
-      theTile->makeBlank();
    }
 
+   // No makeBlank: getTile(ossimImageData*) writes every band.
    theTile->setOrigin(tileRect.ul());
    getTile(theTile.get(), resLevel);
 
@@ -95,11 +88,17 @@ bool ossimBandMergeSource::getTile(ossimImageData* tile, ossim_uint32 resLevel)
       return getNextTile(layerIdx, 0, tile, resLevel);
    }
 
-   tile->makeBlank();
    ossim_uint32 currentBand = 0;
    ossim_uint32 maxBands = tile->getNumberOfBands();
    ossim_uint32 inputIdx = 0;
    ossimRefPtr<ossimImageData> currentTile;
+
+   //---
+   // Each band is written once, copied or filled with null. Status of the merge
+   // when every band is known to be FULL (or EMPTY) from its input's validate():
+   //---
+   bool allFull  = (maxBands > 0);
+   bool allEmpty = true;
    for(inputIdx = 0; inputIdx < getNumberOfInputs(); ++inputIdx)
    {
       ossimImageSource* input = PTR_CAST(ossimImageSource, getInput(inputIdx));
@@ -121,29 +120,55 @@ bool ossimBandMergeSource::getTile(ossimImageData* tile, ossim_uint32 resLevel)
          currentTile = 0;
       }
 
-      if(currentTile.valid()&&(currentTile->getBuf()))
+      // Const access so reading the input does not drop its cached status.
+      const ossimImageData* src = currentTile.get();
+      if(src&&(src->getBuf()))
       {
+         const ossimDataObjectStatus status = src->getDataObjectStatus();
+         const bool hasData = (status != OSSIM_NULL) && (status != OSSIM_EMPTY) &&
+            (src->getSizePerBandInBytes() == tile->getSizePerBandInBytes());
+         
          for(ossim_uint32 band = 0; (band < maxInputBands) && (currentBand < maxBands); ++band)
          {
-            //std::cout << "Actual Band, BAND == " << currentBand << ", " << band << "\n";
-            // clear the band with the actual NULL
-            tile->fill(currentBand, tile->getNullPix(band));
-
-            if(currentTile.valid())
+            if(hasData)
             {
-               if((currentTile->getDataObjectStatus() != OSSIM_NULL) &&
-                  (currentTile->getDataObjectStatus() != OSSIM_EMPTY))
-               {
-                  memmove(tile->getBuf(currentBand),
-                          currentTile->getBuf(band),
-                          currentTile->getSizePerBandInBytes());
-               }
+               memcpy(tile->getBuf(currentBand),
+                      src->getBuf(band),
+                      src->getSizePerBandInBytes());
+               allFull = allFull && (status == OSSIM_FULL) && src->isStatusCached() &&
+                  (src->getNullPix(band) == tile->getNullPix(currentBand));
+               allEmpty = false;
+            }
+            else
+            {
+               // clear the band with the actual NULL
+               tile->fill(currentBand, tile->getNullPix(currentBand));
+               allFull = false;
             }
             ++currentBand;
          }
       }
    }
-   tile->validate();
+
+   // Bands no input reached.
+   for(; currentBand < maxBands; ++currentBand)
+   {
+      tile->fill(currentBand, tile->getNullPix(currentBand));
+      allFull = false;
+   }
+
+   if(allFull)
+   {
+      tile->setValidatedStatus(OSSIM_FULL);
+   }
+   else if(allEmpty && maxBands)
+   {
+      tile->setValidatedStatus(OSSIM_EMPTY);
+   }
+   else
+   {
+      tile->validate();
+   }
    return true;
 }
 
@@ -106,12 +106,29 @@ ossimRefPtr<ossimImageData> ossimBandSelector::getTile(
    }
 
    // Copy selected bands to our tile.
+   const ossimImageData* input = t.get();
+   bool sameNulls = true;
    for (ossim_uint32 i=0; i<theOutputBandList.size(); i++)
    {
-      theTile->assignBand(t.get(), theOutputBandList[i], i);
+      theTile->assignBand(input, theOutputBandList[i], i);
+      sameNulls = sameNulls &&
+         ( theTile->getNullPix(i) == input->getNullPix(theOutputBandList[i]) );
+   }
+
+   //---
+   // Any subset of the bands of a tile with no null samples has none either, so
+   // take over a FULL status the input validated rather than rescanning.
+   //---
+   if ( sameNulls && input->isStatusCached() &&
+        (input->getDataObjectStatus() == OSSIM_FULL) &&
+        (input->getSizePerBandInBytes() == theTile->getSizePerBandInBytes()) )
+   {
+      theTile->setValidatedStatus(OSSIM_FULL);
+   }
+   else
+   {
+      theTile->validate();
    }
-   
-   theTile->validate();
 
    return theTile;
 }
@@ -462,6 +479,15 @@ bool ossimBandSelector::loadState(const ossimKeywordlist& kwl,
    return result;
 }
 
+ossimImageSource* ossimBandSelector::cloneSource() const
+{
+   ossimBandSelector* result = new ossimBandSelector;
+   copySourceSettings(result);
+   result->theOutputBandList   = theOutputBandList;
+   result->theDelayLoadRgbFlag = theDelayLoadRgbFlag;
+   return result;
+}
+
 void ossimBandSelector::checkPassThrough()
 {
    thePassThroughFlag = ((theInputConnection == 0)||!outputBandsWithinInputRange());
@@ -19,6 +19,71 @@
 #include <ossim/base/ossimVisitor.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageHandler.h>
+#include <OpenThreads/ScopedLock>
+#include <algorithm>
+
+namespace
+{
+   //! Sets valid[i] to 1 for the count pixels from offset with any band not null, to 0 for the
+   //! null ones, as ossimImageData::isNull tests them. Plain compares for the compiler to
+   //! vectorize.
+   template <class T>
+   void flagValidPixels(const ossimImageData* tile, ossim_uint32 offset, ossim_uint32 count,
+                        ossim_uint8* valid)
+   {
+      std::fill(valid, valid+count, 0);
+      for (ossim_uint32 band=0; band<tile->getNumberOfBands(); ++band)
+      {
+         const T* buf = static_cast<const T*>(tile->getBuf(band)) + offset;
+         const T null_pix = static_cast<T>(tile->getNullPix(band));
+         for (ossim_uint32 i=0; i<count; ++i)
+            valid[i] |= (ossim_uint8)(buf[i] != null_pix);
+      }
+   }
+
+   void flagValidPixels(const ossimImageData* tile, ossim_uint32 offset, ossim_uint32 count,
+                        ossim_uint8* valid)
+   {
+      if (!tile->getBuf())
+      {
+         std::fill(valid, valid+count, 0);
+         return;
+      }
+      switch (tile->getScalarType())
+      {
+      case OSSIM_UINT8:
+         flagValidPixels<ossim_uint8>(tile, offset, count, valid);
+         break;
+      case OSSIM_SINT8:
+         flagValidPixels<ossim_sint8>(tile, offset, count, valid);
+         break;
+      case OSSIM_UINT16:
+      case OSSIM_USHORT11:
+         flagValidPixels<ossim_uint16>(tile, offset, count, valid);
+         break;
+      case OSSIM_SINT16:
+         flagValidPixels<ossim_sint16>(tile, offset, count, valid);
+         break;
+      case OSSIM_UINT32:
+         flagValidPixels<ossim_uint32>(tile, offset, count, valid);
+         break;
+      case OSSIM_SINT32:
+         flagValidPixels<ossim_sint32>(tile, offset, count, valid);
+         break;
+      case OSSIM_FLOAT32:
+      case OSSIM_NORMALIZED_FLOAT:
+         flagValidPixels<ossim_float32>(tile, offset, count, valid);
+         break;
+      case OSSIM_NORMALIZED_DOUBLE:
+      case OSSIM_FLOAT64:
+         flagValidPixels<ossim_float64>(tile, offset, count, valid);
+         break;
+      default:
+         std::fill(valid, valid+count, 0);
+         break;
+      }
+   }
+}
 
 const char* ossimBitMaskWriter::MASK_FILE_MAGIC_NUMBER = "OSSIM_BIT_MASK";
 const char* ossimBitMaskWriter::BM_STARTING_RLEVEL_KW = "starting_rlevel";
@@ -104,17 +169,18 @@ void ossimBitMaskWriter::setBogusPixelRange(double min, double max)
 //*************************************************************************************************
 void ossimBitMaskWriter::generateMask(ossimRefPtr<ossimImageData> tile, ossim_uint32 rLevel)
 {
-   static const ossim_uint8 MASK_BITS_0[] = {0x7F, 0xBF, 0xDF, 0xEF, 0xF7, 0xFB, 0xFD, 0xFE};
-   static const ossim_uint8 MASK_BITS_1[] = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
-
    // We don't start doing anything until starting res or higher requested:
-   ossim_uint32 mask_rlevel = rLevel - m_startingResLevel;
-   if (!tile.valid())
+   if (!tile.valid() || (rLevel < m_startingResLevel))
       return;
+   ossim_uint32 mask_rlevel = rLevel - m_startingResLevel;
 
    // We should have had this done by now, but just in case:
    if (!m_flipper.valid())
-      initializeFlipper();
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      if (!m_flipper.valid())
+         initializeFlipper();
+   }
 
    // The flipper is used to identify null pixels since it has more sophisticated filtering 
    // than available from the tile object:
@@ -153,67 +219,81 @@ void ossimBitMaskWriter::generateMask(ossimRefPtr<ossimImageData> tile, ossim_ui
 
    ossimIpt image_size = computeImageSize(rLevel, tile.get());
    ossim_uint32 num_mask_cols = (image_size.x+7)/8; // size of mask buffer after compression
-   ossim_uint32 num_mask_rows = image_size.y;
-   ossim_uint8* maskbuf = 0;
+   ossim_uint8* maskbuf = getMaskBuffer(mask_rlevel, ossimIpt(num_mask_cols, image_size.y));
 
-   // Check if mask buffer for this R-level has already been allocated:
-   if (m_buffers.size() <= mask_rlevel)
-   {
-      ossim_uint32 size_of_maskbuf = num_mask_rows * num_mask_cols;
-      maskbuf = new ossim_uint8[size_of_maskbuf];
-      memset(maskbuf, 0, size_of_maskbuf);
-      m_buffers.push_back(maskbuf);
-      m_bufferSizes.push_back(ossimIpt(num_mask_cols, num_mask_rows));
-   }
-   else
-      maskbuf = m_buffers[mask_rlevel];
-
-   ossim_uint32 mask_index=0, tile_index=0, start_bit=0;
    ossimIrect tile_rect (tile->getImageRectangle());
    ossimIpt ul (tile_rect.ul());
    ossimIpt lr (tile_rect.lr());
+   ossim_int32 tile_width = (ossim_int32) tile->getWidth();
 
-   // Scan each pixel in the source tile and decide on mask value:
-   for (int y=ul.y; (y<=lr.y)&&(y<image_size.y); y++)
+   // Tile columns within the image:
+   ossim_int32 x_begin = std::max(ul.x, 0);
+   ossim_int32 x_end   = std::min(lr.x + 1, image_size.x);
+   if (x_end <= x_begin)
+      return;
+   vector<ossim_uint8> valid (x_end - x_begin);
+
+   // Flag the valid pixels of each row of the tile, then pack them 8 to a mask byte:
+   for (int y=std::max(ul.y, 0); (y<=lr.y)&&(y<image_size.y); y++)
    {
-      mask_index = y*num_mask_cols + ul.x/8;
-      start_bit = ul.x % 8; // may not start on even mask byte boundary
+      flagValidPixels(tile.get(), (y-ul.y)*tile_width + (x_begin-ul.x), x_end-x_begin, &valid[0]);
+      ossim_uint8* maskrow = maskbuf + y*num_mask_cols;
 
-      for (int x=ul.x; (x<=lr.x); /* incremented in bit loop below */ )         
+      for (int x=x_begin; x<x_end; /* incremented by the bits packed */ )
       {
-         if ( x < image_size.x )
-         {
-            // Process 8 samples and pack resultant mask into one byte:
-            maskbuf[mask_index] = 0;
-            for (ossim_uint32 mask_bit=start_bit; mask_bit<8; ++mask_bit)
-            {
-               // Decide whether to mask depending on pixel flipper outputting a NULL pixel. 
-               // if (tile->isNull(tile_index++))
-               if (tile->isNull(tile_index++))                  
-                  maskbuf[mask_index] &=  MASK_BITS_0[mask_bit];
-               else
-                  maskbuf[mask_index] |= MASK_BITS_1[mask_bit];
-               
-               // Advance the pixel column and check for end of image rect:
-               ++x;
-               if ((x >= image_size.x) || (x > lr.x))
-                  break;
-            }
-            ++mask_index; // advance the mask buffer index 1 after processing 8 tile samples
-            start_bit = 0;
-         }
+         // May not start or end on an even mask byte boundary:
+         ossim_int32 start_bit = x % 8;
+         ossim_int32 num_bits = std::min(8 - start_bit, x_end - x);
+         const ossim_uint8* v = &valid[x - x_begin];
+         ossim_uint8 bits = 0;
+         for (ossim_int32 b=0; b<num_bits; ++b)
+            bits |= (ossim_uint8)(v[b] << (7 - start_bit - b));
+
+         if (num_bits == 8)
+            maskrow[x/8] = bits;
          else
          {
-            ++x;
-            
-            ++tile_index;
+            // The rest of the byte may belong to a neighboring tile:
+            ossim_uint8 covered = (ossim_uint8)((0xFF >> start_bit) & (0xFF << (8-start_bit-num_bits)));
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+            maskrow[x/8] = (maskrow[x/8] & ~covered) | bits;
          }
+         x += num_bits;
       }
    } // Finished looping over all pixels in input tile
 
    return;
 }
 
+//*************************************************************************************************
+// Returns the buffer of the mask R-level, allocating the missing levels up to it.
+//*************************************************************************************************
+ossim_uint8* ossimBitMaskWriter::getMaskBuffer(ossim_uint32 mask_rlevel, const ossimIpt& size)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   while (m_buffers.size() <= mask_rlevel)
+   {
+      // Levels allocated ahead of their tiles get the size of a decimation of the one below:
+      ossimIpt level_size (size);
+      if (m_buffers.size() < mask_rlevel)
+      {
+         level_size = m_imageSize;
+         for (ossim_uint32 r=0; r<m_startingResLevel+m_buffers.size(); r++)
+         {
+            level_size.x = (level_size.x + 1) / 2;
+            level_size.y = (level_size.y + 1) / 2;
+         }
+         level_size.x = (level_size.x + 7) / 8;
+      }
+      ossim_uint32 size_of_maskbuf = level_size.x * level_size.y;
+      ossim_uint8* maskbuf = new ossim_uint8[size_of_maskbuf];
+      memset(maskbuf, 0, size_of_maskbuf);
+      m_buffers.push_back(maskbuf);
+      m_bufferSizes.push_back(level_size);
+   }
+   return m_buffers[mask_rlevel];
+}
+
 //*************************************************************************************************
 //! Writes the mask file to path specified. Returns TRUE if successful.
 //*************************************************************************************************
@@ -11,9 +11,61 @@
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageDataKernels.h>
+#include <cmath>
+#include <limits>
 
 RTTI_DEF1(ossimBlendMosaic, "ossimBlendMosaic", ossimImageMosaic)
 
+namespace
+{
+   //---
+   // True if w is a power of two, so for integer samples of up to 32 bits every step of the
+   // equal weight blend, (d*w + s*w)/(w + w), is exact and equals (d + s)/2.
+   //---
+   bool isExactWeight(double w)
+   {
+      int exponent = 0;
+      const double mantissa = std::frexp(w, &exponent);
+      return ( (std::fabs(mantissa) == 0.5) && (exponent > -900) && (exponent < 900) );
+   }
+
+   //---
+   // Blends one band of src into dest:
+   // dest = (dest*previousWeight + src*currentWeight)/(previousWeight + currentWeight), or src
+   // where dest is null.  Pixels with a zero valid entry are left alone.
+   //---
+   template <class T>
+   void blendBand(const T* src, T* dest, ossim_uint32 size, T nullPix,
+                  double previousWeight, double currentWeight, const ossim_uint8* valid)
+   {
+      if ( std::numeric_limits<T>::is_integer && (previousWeight == currentWeight) &&
+           isExactWeight(previousWeight) )
+      {
+         // Equal weights, i.e. the default, in the pixel type.
+         ossim::blendEqual(src, dest, size, nullPix, valid);
+         return;
+      }
+
+      const double sumOfWeights = previousWeight + currentWeight;
+      for(ossim_uint32 offset = 0; offset < size; ++offset)
+      {
+         if(!valid || valid[offset])
+         {
+            if(dest[offset] != nullPix)
+            {
+               dest[offset] = static_cast<T>((dest[offset]*previousWeight +
+                                              src[offset]*currentWeight)/sumOfWeights);
+            }
+            else
+            {
+               dest[offset] = src[offset];
+            }
+         }
+      }
+   }
+}
+
 ossimBlendMosaic::ossimBlendMosaic()
    : ossimImageMosaic(),
      theNormResult(NULL)
@@ -221,8 +273,6 @@ template <class T> ossimRefPtr<ossimImageData> ossimBlendMosaic::combine(
   double previousWeight = 1.0;
   // double sumOfWeights   = 1;
   long offset = 0;
-  long row    = 0;
-  long col    = 0;
   ossim_uint32 layerIdx = 0;
   currentImageData = getNextTile(layerIdx, 0, tileRect, resLevel);
   
@@ -270,54 +320,16 @@ template <class T> ossimRefPtr<ossimImageData> ossimBlendMosaic::combine(
 	     srcBands[band]  = srcBands[minNumberOfBands - 1];
 	   }
 
- 	 if(currentStatus == OSSIM_PARTIAL)
+         const ossim_uint32 size = (ossim_uint32)(w*h);
+         const ossim_uint8* valid = 0;
+         if(currentStatus == OSSIM_PARTIAL)
          {
-            for(row = 0; row < h; ++row)
-            {
-               for(col = 0; col < w; ++col)
-               {
-                  if(!currentImageData->isNull(offset))
-                  {
-                     for(band = 0; band < theLargestNumberOfInputBands; ++band)
-                     {
-                        if(destBands[band][offset] != nullPix[band])
-                        {
-//                            destBands[band][offset] = static_cast<T>((destBands[band][offset]*(1.0-currentWeight) +  
-//                                                                      srcBands[band][offset]*currentWeight));
-                           destBands[band][offset] = static_cast<T>((destBands[band][offset]*previousWeight + 
-                                                                     srcBands[band][offset]*currentWeight)/(previousWeight+currentWeight));
-                        }
-                        else
-                        {
-                           destBands[band][offset] = srcBands[band][offset];
-                        }
-                     }	 
-                  }
-                  ++offset;
-               }
-            }
+            valid = getValidMask(currentImageData.get());
          }
-	 else
+         for(band = 0; band < theLargestNumberOfInputBands; ++band)
          {
-            for(row = 0; row < h; ++row)
-            {
-               for(col = 0; col < w; ++col)
-               {
-                  for(band = 0; band < theLargestNumberOfInputBands; ++band)
-                  {			
-                     if(destBands[band][offset] != nullPix[band])
-                     {
-                        destBands[band][offset] = static_cast<T>((destBands[band][offset]*previousWeight+ 
-                                                                  srcBands[band][offset]*currentWeight)/(previousWeight + currentWeight));
-                     }
-                     else
-                     {
-                        destBands[band][offset] = srcBands[band][offset];
-                     }
-                  }
-                  ++offset;
-               }
-            }
+            blendBand(srcBands[band], destBands[band], size, nullPix[band],
+                      previousWeight, currentWeight, valid);
          }
        }
       currentImageData = getNextTile(layerIdx, tileRect, resLevel);
@@ -340,8 +352,6 @@ template <class T> ossimRefPtr<ossimImageData> ossimBlendMosaic::combineNorm(
    double previousWeight = 1.0;
    // double sumOfWeights   = 1;
    long offset = 0;
-   long row    = 0;
-   long col    = 0;
    ossim_uint32 layerIdx = 0;
    currentImageData = getNextNormTile(layerIdx, 0, tileRect, resLevel);
   
@@ -388,52 +398,16 @@ template <class T> ossimRefPtr<ossimImageData> ossimBlendMosaic::combineNorm(
             srcBands[band]  = srcBands[minNumberOfBands - 1];
          }
         
+         const ossim_uint32 size = (ossim_uint32)(w*h);
+         const ossim_uint8* valid = 0;
          if(currentStatus == OSSIM_PARTIAL)
          {
-            for(row = 0; row < h; ++row)
-            {
-               for(col = 0; col < w; ++col)
-               {
-                  if(!currentImageData->isNull(offset))
-                  {
-                     for(band = 0; band < theLargestNumberOfInputBands; ++band)
-                     {
-                        if(destBands[band][offset] != nullPix[band])
-                        {
-                           destBands[band][offset] = static_cast<float>((destBands[band][offset]*previousWeight + 
-                                                                         srcBands[band][offset]*currentWeight)/(previousWeight+currentWeight));
-                        }
-                        else
-                        {
-                           destBands[band][offset] = srcBands[band][offset];
-                        }
-                     }	 
-                  }
-                  ++offset;
-               }
-            }
+            valid = getValidMask(currentImageData.get());
          }
-         else
+         for(band = 0; band < theLargestNumberOfInputBands; ++band)
          {
-            for(row = 0; row < h; ++row)
-            {
-               for(col = 0; col < w; ++col)
-               {
-                  for(band = 0; band < theLargestNumberOfInputBands; ++band)
-                  {			
-                     if(destBands[band][offset] != nullPix[band])
-                     {
-                        destBands[band][offset] = static_cast<float>((destBands[band][offset]*previousWeight+ 
-                                                                      srcBands[band][offset]*currentWeight)/(previousWeight + currentWeight));
-                     }
-                     else
-                     {
-                        destBands[band][offset] = srcBands[band][offset];
-                     }
-                  }
-                  ++offset;
-               }
-            }
+            blendBand(srcBands[band], destBands[band], size, nullPix[band],
+                      previousWeight, currentWeight, valid);
          }
       }
       currentImageData = getNextNormTile(layerIdx, tileRect, resLevel);
@@ -449,6 +423,17 @@ template <class T> ossimRefPtr<ossimImageData> ossimBlendMosaic::combineNorm(
    return theTile;   
 }
 
+const ossim_uint8* ossimBlendMosaic::getValidMask(const ossimImageData* tile)
+{
+   const ossim_uint32 size = tile->getSizePerBand();
+   theValidMask.resize(size);
+   for(ossim_uint32 offset = 0; offset < size; ++offset)
+   {
+      theValidMask[offset] = tile->isNull(offset) ? 0 : 1;
+   }
+   return &theValidMask.front();
+}
+
 bool ossimBlendMosaic::saveState(ossimKeywordlist& kwl,
                                  const char* prefix)const
 {
@@ -104,6 +104,29 @@ bool ossimBumpShadeTileSource::getTile(ossimImageData* tile, ossim_uint32 resLev
    normalData->setImageRectangle(tileRect);
 
    normalSource->getTile(normalData.get(), resLevel);
+
+   // Float normals, e.g. the NORMAL_* bands of ossimTerrainDerivativeSource:
+   if ( (normalData->getScalarType() == OSSIM_FLOAT32) && (normalData->getNumberOfBands() == 3) &&
+        normalData->getBuf() )
+   {
+      ossimRefPtr<ossimImageData> d = new ossimImageData(0, OSSIM_DOUBLE, 3,
+                                                         tile->getWidth(), tile->getHeight());
+      d->setImageRectangle(tileRect);
+      d->initialize();
+      const ossim_uint32 count = d->getSizePerBand();
+      for (ossim_uint32 band = 0; band < 3; ++band)
+      {
+         const ossim_float32* s = static_cast<const ossim_float32*>(normalData->getBuf(band));
+         ossim_float64* t = static_cast<ossim_float64*>(d->getBuf(band));
+         const ossim_float32 sNp = (ossim_float32) normalData->getNullPix(band);
+         const ossim_float64 tNp = d->getNullPix(band);
+         for (ossim_uint32 i = 0; i < count; ++i)
+            t[i] = (s[i] == sNp) ? tNp : s[i];
+      }
+      d->setDataObjectStatus(normalData->getDataObjectStatus());
+      normalData = d;
+   }
+
    ossimDataObjectStatus status = normalData->getDataObjectStatus();
    if ((status == OSSIM_NULL) || (status == OSSIM_EMPTY) ||
        (normalData->getNumberOfBands() != 3) ||
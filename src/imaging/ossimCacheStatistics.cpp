@@ -0,0 +1,187 @@
+//*******************************************************************
+//
+// License:  LGPL
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description: Reporting of the tile and elevation cache statistics.
+//
+//********************************************************************
+
+#include <ossim/imaging/ossimCacheStatistics.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/elevation/ossimElevManager.h>
+#include <ossim/imaging/ossimAppFixedTileCache.h>
+#include <ossim/imaging/ossimImageDataAccounting.h>
+#include <OpenThreads/Atomic>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+   volatile std::sig_atomic_t theSignalFlag = 0;
+
+#ifdef SIGUSR1
+   extern "C" void ossimCacheStatisticsSignal(int)
+   {
+      theSignalFlag = 1;
+   }
+#endif
+
+   class ossimCacheStatisticsReporter : public OpenThreads::Thread
+   {
+   public:
+      ossimCacheStatisticsReporter()
+         : theDoneFlag(0),
+           theMilliseconds(0)
+      {}
+
+      void setInterval(double seconds)
+      {
+         theMilliseconds.exchange( (seconds > 0.0) ? (unsigned)(seconds * 1000.0) : 0 );
+      }
+
+      virtual void run()
+      {
+         ossimTimer::Timer_t last = ossimTimer::instance()->tick();
+         while ( !(unsigned)theDoneFlag )
+         {
+            OpenThreads::Thread::microSleep(100000);
+            if ( theSignalFlag )
+            {
+               theSignalFlag = 0;
+               std::ostringstream out;
+               ossimCacheStatistics::print(out);
+               ossimNotify(ossimNotifyLevel_INFO) << out.str() << std::flush;
+            }
+            const unsigned MS = theMilliseconds;
+            if ( MS )
+            {
+               ossimTimer::Timer_t now = ossimTimer::instance()->tick();
+               if ( ossimTimer::instance()->delta_m(last, now) >= MS )
+               {
+                  ossimNotify(ossimNotifyLevel_INFO)
+                     << ossimCacheStatistics::summary() << std::endl;
+                  last = now;
+               }
+            }
+         }
+      }
+
+      void stop()
+      {
+         theDoneFlag.exchange(1);
+         join();
+      }
+
+   private:
+      OpenThreads::Atomic theDoneFlag;
+      OpenThreads::Atomic theMilliseconds;
+   };
+
+   OpenThreads::Mutex theReporterMutex;
+   ossimCacheStatisticsReporter* theReporter = 0;
+
+   extern "C" void stopCacheStatisticsReporter()
+   {
+      ossimCacheStatistics::stopReporter();
+   }
+}
+
+void ossimCacheStatistics::print(std::ostream& out)
+{
+   ossimAppFixedTileCache::instance()->printStatistics(out);
+   ossimElevManager::instance()->printCacheStatistics(out);
+   if ( ossimElevManager::instance()->getQueryStatisticsFlag() )
+   {
+      ossimElevManager::instance()->printQueryStatistics(out);
+   }
+   ossimImageDataAccounting::instance()->print(out);
+}
+
+std::string ossimCacheStatistics::summary()
+{
+   ossimAppFixedTileCache::Statistics tiles;
+   ossimAppFixedTileCache::instance()->getTotalStatistics(tiles);
+
+   ossimElevationCellDatabase::CacheStatistics cells;
+   ossimElevManager* elevMgr = ossimElevManager::instance();
+   for (ossim_uint32 idx = 0; idx < elevMgr->getNumberOfElevationDatabases(); ++idx)
+   {
+      ossimElevationCellDatabase::CacheStatistics stats;
+      if ( elevMgr->getCacheStatistics(idx, stats) )
+      {
+         cells += stats;
+      }
+   }
+
+   ossimImageDataAccounting::Statistics buffers =
+      ossimImageDataAccounting::instance()->getStatistics();
+
+   std::ostringstream out;
+   out << "cache statistics: tile_bytes=" << tiles.theBytes
+       << " tile_peak_bytes=" << tiles.thePeakBytes
+       << " tile_hits=" << tiles.theHits
+       << " tile_misses=" << tiles.theMisses
+       << " tile_evictions=" << tiles.theEvictions
+       << " elev_cells=" << cells.m_openCells
+       << " elev_bytes=" << cells.m_bytes
+       << " elev_hits=" << cells.m_hits
+       << " elev_misses=" << cells.m_misses
+       << " elev_evictions=" << cells.m_evictions
+       << " image_data_bytes=" << buffers.m_liveBytes
+       << " image_data_peak_bytes=" << buffers.m_peakBytes;
+   return out.str();
+}
+
+void ossimCacheStatistics::startReporter(double seconds, bool signalFlag)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theReporterMutex);
+   if ( !theReporter )
+   {
+      static bool atExitFlag = false;
+      if ( !atExitFlag )
+      {
+         std::atexit(stopCacheStatisticsReporter);
+         atExitFlag = true;
+      }
+      theReporter = new ossimCacheStatisticsReporter;
+      theReporter->setInterval(seconds);
+      theReporter->start();
+   }
+   else
+   {
+      theReporter->setInterval(seconds);
+   }
+
+#ifdef SIGUSR1
+   std::signal(SIGUSR1, signalFlag ? ossimCacheStatisticsSignal : SIG_DFL);
+#else
+   if ( signalFlag )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimCacheStatistics::startReporter: No SIGUSR1 on this platform."
+         << std::endl;
+   }
+#endif
+}
+
+void ossimCacheStatistics::stopReporter()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theReporterMutex);
+   if ( theReporter )
+   {
+#ifdef SIGUSR1
+      std::signal(SIGUSR1, SIG_DFL);
+#endif
+      theReporter->stop();
+      delete theReporter;
+      theReporter = 0;
+   }
+}
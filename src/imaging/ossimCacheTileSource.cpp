@@ -15,6 +15,7 @@
 #include <ossim/base/ossimStringProperty.h>
 #include <ossim/base/ossimBooleanProperty.h>
 #include <ossim/imaging/ossimCacheTileSource.h>
+#include <ossim/imaging/ossimChainProfiler.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
 #include <ossim/base/ossimKeywordNames.h>
@@ -138,7 +139,11 @@ ossimRefPtr<ossimImageData> ossimCacheTileSource::fillTile(
             tempTile = ossimAppFixedTileCache::instance()->getTile(cacheId,
                                                                    origin);
          }
-         if(!tempTile.valid())
+         if(tempTile.valid())
+         {
+            ossimChainProfiler::cacheHit();
+         }
+         else
          {
             tempTile = theInputConnection->getTile(tileRect, resLevel);
             
@@ -163,8 +168,18 @@ ossimRefPtr<ossimImageData> ossimCacheTileSource::fillTile(
             if((tempTile->getDataObjectStatus() != OSSIM_NULL)&&
                (tempTile->getDataObjectStatus() != OSSIM_EMPTY))
             {
-               theTile->setDataObjectStatus(tempTile->getDataObjectStatus());
-               theTile->loadTile(tempTile.get());
+               if ( (tempTile->getScalarType() == theTile->getScalarType()) &&
+                    (tempTile->getNumberOfBands() == theTile->getNumberOfBands()) &&
+                    (tempTile->getImageRectangle() == tileRect) )
+               {
+                  // Same layout: reference the cached buffer, copied only if written.
+                  theTile->assign(tempTile.get());
+               }
+               else
+               {
+                  theTile->setDataObjectStatus(tempTile->getDataObjectStatus());
+                  theTile->loadTile(tempTile.get());
+               }
             }
          }
          fireProgressEvent(100.0);
@@ -198,7 +213,11 @@ ossimRefPtr<ossimImageData> ossimCacheTileSource::fillTile(
                {
                   tempTile = 0;
                }
-               if(!tempTile.valid())
+               if(tempTile.valid())
+               {
+                  ossimChainProfiler::cacheHit();
+               }
+               else
                {
                   ossimIrect rect(origin.x,
                                   origin.y,
@@ -226,7 +245,9 @@ ossimRefPtr<ossimImageData> ossimCacheTileSource::fillTile(
                
                if(tempTile.valid())
                {
-                  if(tempTile->getBuf()&&
+                  // Const access, a cached tile may be shared with our callers' tiles.
+                  const ossimImageData* cachedTile = tempTile.get();
+                  if(cachedTile->getBuf()&&
                      (tempTile->getDataObjectStatus()!=OSSIM_EMPTY))
                   {
                      theTile->loadTile(tempTile.get());
@@ -310,6 +331,17 @@ bool ossimCacheTileSource::saveState(ossimKeywordlist& kwl,
    return ossimImageSourceFilter::saveState(kwl, prefix);
 }
 
+ossimImageSource* ossimCacheTileSource::cloneSource() const
+{
+   ossimCacheTileSource* result = new ossimCacheTileSource;
+   copySourceSettings(result);
+   result->theFixedTileSize        = theFixedTileSize;
+   result->theCachingEnabled       = theCachingEnabled;
+   result->theEventProgressFlag    = theEventProgressFlag;
+   result->theUseInputTileSizeFlag = theUseInputTileSizeFlag;
+   return result;
+}
+
 ossimRefPtr<ossimProperty> ossimCacheTileSource::getProperty(
    const ossimString& name)const
 {
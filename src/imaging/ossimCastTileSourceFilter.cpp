@@ -12,6 +12,7 @@
 #include <ossim/imaging/ossimCastTileSourceFilter.h>
 #include <ossim/imaging/ossimU8ImageData.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageDataKernels.h>
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimScalarTypeLut.h>
 #include <ossim/base/ossimStringProperty.h>
@@ -570,47 +571,19 @@ void ossimCastTileSourceFilter::castInputToOutput(inType *inBuffer[],
                                                   ossim_uint32   numberOfBands)
 {
    ossim_uint32 size = theTile->getWidth()*theTile->getHeight();
-   if(!inPartialFlag)
+   for(ossim_uint32 band = 0; band < numberOfBands; ++band)
    {
-      for(ossim_uint32 band = 0; band < numberOfBands; ++band)
-      {
-         outType outMin = static_cast<outType>(theTile->getMinPix(band));
-         outType outMax = static_cast<outType>(theTile->getMaxPix(band));
-         
-         for(ossim_uint32 offset = 0; offset < size; ++offset)
-         {
-            double temp = inBuffer[band][offset];
-            if(temp < outMin) temp = outMin;
-            if(temp > outMax) temp = outMax;
-            outBuffer[band][offset] = static_cast<outType>(temp);
-         }
-      }
-   }
-   else
-   {
-      for(ossim_uint32 band = 0; band < numberOfBands; ++band)
-      {
-         inType np      = static_cast<inType>(nullInPix[band]);
-	     outType outNp  = static_cast<outType>(nullOutPix[band]);
-         outType outMin = static_cast<outType>(theTile->getMinPix(band));
-         outType outMax = static_cast<outType>(theTile->getMaxPix(band));
-         
-         for(ossim_uint32 offset = 0; offset < size; ++offset)
-         {
-            if(inBuffer[band][offset] != np)
-            {
-               double temp = inBuffer[band][offset];
-               if(temp < outMin) temp = outMin;
-               if(temp > outMax) temp = outMax;
-               outBuffer[band][offset] = static_cast<outType>(temp);
-            }
-	    else
-	    {
-		outBuffer[band][offset] = static_cast<outType>(outNp);
-		
-	    }
-         }
-      }
+      // Clamp to the output type's min/max; nulls only need mapping in partial tiles.
+      const outType outMin = static_cast<outType>(theTile->getMinPix(band));
+      const outType outMax = static_cast<outType>(theTile->getMaxPix(band));
+      ossim::castClamp(static_cast<const inType*>(inBuffer[band]),
+                       outBuffer[band],
+                       size,
+                       static_cast<ossim_float64>(outMin),
+                       static_cast<ossim_float64>(outMax),
+                       inPartialFlag,
+                       nullInPix[band],
+                       nullOutPix[band]);
    }
 }
 
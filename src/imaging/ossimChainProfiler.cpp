@@ -0,0 +1,473 @@
+//*******************************************************************
+//
+// License:  LGPL
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description: Per-node getTile profiling of image source chains.
+//
+//********************************************************************
+
+#include <ossim/imaging/ossimChainProfiler.h>
+#include <ossim/base/ossimConnectableObject.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimTimeline.h>
+#include <ossim/imaging/ossimImageChain.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageHandler.h>
+#include <OpenThreads/Atomic>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+
+RTTI_DEF1(ossimChainProfilerProbe, "ossimChainProfilerProbe", ossimImageSourceFilter);
+
+namespace
+{
+   /** The profiler of the last instrument(). */
+   OpenThreads::AtomicPtr theActiveProfiler;
+
+   const char PROFILE_NODE_KW[] = "profile_node";
+}
+
+ossimChainProfiler::ossimChainProfiler()
+   : m_mutex(),
+     m_nodes(),
+     m_threads(),
+     m_visited(),
+     m_nodeOf(),
+     m_probeOf(),
+     m_startTick(0)
+{
+}
+
+ossimChainProfiler::~ossimChainProfiler()
+{
+   theActiveProfiler.assign(0, this);
+}
+
+void ossimChainProfiler::instrument(ossimConnectableObject* root)
+{
+   if ( !root )
+   {
+      return;
+   }
+   if ( m_nodes.empty() )
+   {
+      m_startTick = ossimTimer::instance()->tick();
+   }
+
+   void* old = theActiveProfiler.get();
+   while ( !theActiveProfiler.assign(this, old) )
+   {
+      old = theActiveProfiler.get();
+   }
+
+   std::map<ossimConnectableObject*, ossim_int32>::const_iterator i = m_nodeOf.find(root);
+   instrumentInputs( root, (i != m_nodeOf.end()) ? i->second : -1 );
+}
+
+void ossimChainProfiler::instrumentInputs(ossimConnectableObject* obj, ossim_int32 node)
+{
+   if ( !obj || !m_visited.insert(obj).second )
+   {
+      return;
+   }
+
+   ossimImageChain* chain = dynamic_cast<ossimImageChain*>(obj);
+   if ( chain )
+   {
+      instrumentChain(chain, node);
+      return;
+   }
+
+   const ossim_uint32 INPUTS = obj->getNumberOfInputs();
+   for (ossim_uint32 idx = 0; idx < INPUTS; ++idx)
+   {
+      ossimConnectableObject* input = obj->getInput(idx);
+      if ( !input || !dynamic_cast<ossimImageSource*>(input) ||
+           dynamic_cast<ossimChainProfilerProbe*>(input) )
+      {
+         continue;
+      }
+
+      // An input feeding several objects gets one probe.
+      std::map<ossimConnectableObject*, ossimChainProfilerProbe*>::iterator i =
+         m_probeOf.find(input);
+      ossimRefPtr<ossimChainProfilerProbe> probe =
+         (i != m_probeOf.end()) ? i->second : 0;
+      const bool CREATED = !probe.valid();
+      if ( CREATED )
+      {
+         probe = new ossimChainProfilerProbe(this, (ossim_uint32)m_nodes.size());
+      }
+      if ( !obj->canConnectMyInputTo(idx, probe.get()) )
+      {
+         instrumentInputs(input, node);
+         continue;
+      }
+      if ( CREATED )
+      {
+         addNode(input, node);
+         probe->connectMyInputTo(0, input);
+         m_probeOf[input] = probe.get();
+      }
+      obj->connectMyInputTo(idx, probe.get());
+
+      instrumentInputs(input, probe->getNode());
+   }
+}
+
+void ossimChainProfiler::instrumentChain(ossimImageChain* chain, ossim_int32 node)
+{
+   // The list changes as the probes go in.
+   ossimConnectableObject::ConnectableObjectList children = chain->imageChainList();
+
+   // Children are in reverse order: each pulls from the next.
+   ossim_int32 parent = node;
+   ossim_uint32 idx;
+   for (idx = 0; idx < children.size(); ++idx)
+   {
+      ossimConnectableObject* child = children[idx].get();
+      if ( !dynamic_cast<ossimImageSource*>(child) ||
+           dynamic_cast<ossimChainProfilerProbe*>(child) )
+      {
+         continue;
+      }
+      ossimRefPtr<ossimChainProfilerProbe> probe =
+         new ossimChainProfilerProbe(this, (ossim_uint32)m_nodes.size());
+      const bool ADDED = (idx == 0) ? chain->add(probe.get()) :
+         chain->insertRight(probe.get(), child);
+      if ( ADDED )
+      {
+         addNode(child, parent);
+         m_probeOf[child] = probe.get();
+         parent = probe->getNode();
+      }
+   }
+
+   for (idx = 0; idx < children.size(); ++idx)
+   {
+      ossimConnectableObject* child = children[idx].get();
+      std::map<ossimConnectableObject*, ossim_int32>::const_iterator i = m_nodeOf.find(child);
+      instrumentInputs( child, (i != m_nodeOf.end()) ? i->second : node );
+   }
+}
+
+void ossimChainProfiler::addNode(ossimConnectableObject* source, ossim_int32 parent)
+{
+   Node record;
+   record.m_type = source->getClassName();
+   const ossimImageHandler* handler = dynamic_cast<const ossimImageHandler*>(source);
+   if ( handler )
+   {
+      record.m_name = handler->getFilename();
+   }
+   record.m_parent = parent;
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   m_nodeOf[source] = (ossim_int32)m_nodes.size();
+   m_nodes.push_back(record);
+}
+
+void ossimChainProfiler::begin(ossim_uint32 node)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   Frame frame;
+   frame.m_node = node;
+   frame.m_children = 0;
+   frame.m_start = ossimTimer::instance()->tick();
+   getThreadState().m_frames.push_back(frame);
+}
+
+void ossimChainProfiler::end(ossim_uint32 node, const ossimImageData* tile)
+{
+   const ossimTimer::Timer_t END = ossimTimer::instance()->tick();
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   ThreadState& state = getThreadState();
+   if ( state.m_frames.empty() || (state.m_frames.back().m_node != node) )
+   {
+      return;
+   }
+   const Frame FRAME = state.m_frames.back();
+   state.m_frames.pop_back();
+
+   const ossimTimer::Timer_t INCLUSIVE = (END > FRAME.m_start) ? (END - FRAME.m_start) : 0;
+   Counts& counts = getCounts(node, state.m_index);
+   ++counts.m_calls;
+   counts.m_inclusive += INCLUSIVE;
+   counts.m_exclusive += (INCLUSIVE > FRAME.m_children) ? (INCLUSIVE - FRAME.m_children) : 0;
+   if ( tile && tile->getBuf() )
+   {
+      counts.m_bytes += tile->getSizeInBytes();
+   }
+
+   if ( !state.m_frames.empty() )
+   {
+      state.m_frames.back().m_children += INCLUSIVE;
+   }
+}
+
+void ossimChainProfiler::addIoSource(ossim_uint32 node, ossimImageHandler* handler)
+{
+   if ( handler )
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      if ( node < m_nodes.size() )
+      {
+         m_nodes[node].m_ioSources.push_back(handler);
+      }
+   }
+}
+
+ossim_uint32 ossimChainProfiler::getNumberOfNodes() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   return (ossim_uint32)m_nodes.size();
+}
+
+void ossimChainProfiler::cacheHit()
+{
+   ossimChainProfiler* profiler = getActive();
+   if ( profiler )
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(profiler->m_mutex);
+      ThreadState& state = profiler->getThreadState();
+      if ( !state.m_frames.empty() )
+      {
+         ++profiler->getCounts(state.m_frames.back().m_node, state.m_index).m_cacheHits;
+      }
+   }
+}
+
+ossimChainProfiler* ossimChainProfiler::getActive()
+{
+   return static_cast<ossimChainProfiler*>(theActiveProfiler.get());
+}
+
+ossimFilename ossimChainProfiler::getPreferenceFile()
+{
+   const char* lookup = ossimPreferences::instance()->findPreference("chain_profile.file");
+   return lookup ? ossimFilename(lookup) : ossimFilename();
+}
+
+ossimChainProfiler::ThreadState& ossimChainProfiler::getThreadState()
+{
+   OpenThreads::Thread* thread = OpenThreads::Thread::CurrentThread();
+   std::map<OpenThreads::Thread*, ThreadState>::iterator i = m_threads.find(thread);
+   if ( i == m_threads.end() )
+   {
+      ThreadState state;
+      state.m_index = (ossim_uint32)m_threads.size();
+      i = m_threads.insert(std::make_pair(thread, state)).first;
+   }
+   return i->second;
+}
+
+ossimChainProfiler::Counts& ossimChainProfiler::getCounts(ossim_uint32 node, ossim_uint32 thread)
+{
+   std::vector<Counts>& threads = m_nodes[node].m_threads;
+   if ( thread >= threads.size() )
+   {
+      threads.resize(thread + 1);
+   }
+   return threads[thread];
+}
+
+void ossimChainProfiler::saveState(ossimKeywordlist& kwl, const char* prefix) const
+{
+   const ossimString PREFIX = prefix ? prefix : "";
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   kwl.add( PREFIX.c_str(), "elapsed_seconds",
+            ossimTimer::instance()->delta_s(m_startTick, ossimTimer::instance()->tick()) );
+   kwl.add( PREFIX.c_str(), "threads", (ossim_uint32)m_threads.size() );
+   kwl.add( PREFIX.c_str(), "nodes", (ossim_uint32)m_nodes.size() );
+
+   ossim_uint32 root = 0;
+   for (ossim_uint32 node = 0; node < m_nodes.size(); ++node)
+   {
+      if ( m_nodes[node].m_parent < 0 )
+      {
+         saveNode( kwl, PREFIX + "node" + ossimString::toString(root) + ".", node );
+         ++root;
+      }
+   }
+}
+
+void ossimChainProfiler::saveNode(ossimKeywordlist& kwl,
+                                  const ossimString& prefix,
+                                  ossim_uint32 node) const
+{
+   const Node& record = m_nodes[node];
+   const ossimTimer* timer = ossimTimer::instance();
+
+   kwl.add( prefix.c_str(), "type", record.m_type.c_str() );
+   if ( record.m_name.size() )
+   {
+      kwl.add( prefix.c_str(), "name", record.m_name.c_str() );
+   }
+
+   Counts total;
+   ossim_uint32 thread;
+   for (thread = 0; thread < record.m_threads.size(); ++thread)
+   {
+      const Counts& counts = record.m_threads[thread];
+      total.m_calls     += counts.m_calls;
+      total.m_inclusive += counts.m_inclusive;
+      total.m_exclusive += counts.m_exclusive;
+      total.m_bytes     += counts.m_bytes;
+      total.m_cacheHits += counts.m_cacheHits;
+   }
+   kwl.add( prefix.c_str(), "calls", total.m_calls );
+   kwl.add( prefix.c_str(), "inclusive_seconds", timer->delta_s(0, total.m_inclusive) );
+   kwl.add( prefix.c_str(), "exclusive_seconds", timer->delta_s(0, total.m_exclusive) );
+   kwl.add( prefix.c_str(), "bytes", total.m_bytes );
+   kwl.add( prefix.c_str(), "cache_hits", total.m_cacheHits );
+
+   if ( record.m_ioSources.size() )
+   {
+      ossimIoCounters::Values io;
+      for (ossim_uint32 idx = 0; idx < record.m_ioSources.size(); ++idx)
+      {
+         record.m_ioSources[idx]->getIoCounters(io);
+      }
+      kwl.add( prefix.c_str(), "io_bytes_read", io.m_bytesRead );
+      kwl.add( prefix.c_str(), "io_reads", io.m_reads );
+      kwl.add( prefix.c_str(), "io_seeks", io.m_seeks );
+      kwl.add( prefix.c_str(), "io_read_seconds", io.m_readSeconds );
+      if ( total.m_bytes )
+      {
+         kwl.add( prefix.c_str(), "read_amplification",
+                  (ossim_float64)io.m_bytesRead / (ossim_float64)total.m_bytes );
+      }
+   }
+
+   for (thread = 0; thread < record.m_threads.size(); ++thread)
+   {
+      const Counts& counts = record.m_threads[thread];
+      if ( counts.m_calls )
+      {
+         const ossimString THREAD = prefix + "thread" + ossimString::toString(thread) + ".";
+         kwl.add( THREAD.c_str(), "calls", counts.m_calls );
+         kwl.add( THREAD.c_str(), "inclusive_seconds", timer->delta_s(0, counts.m_inclusive) );
+         kwl.add( THREAD.c_str(), "exclusive_seconds", timer->delta_s(0, counts.m_exclusive) );
+         kwl.add( THREAD.c_str(), "bytes", counts.m_bytes );
+         kwl.add( THREAD.c_str(), "cache_hits", counts.m_cacheHits );
+      }
+   }
+
+   // The nodes it pulls from.
+   ossim_uint32 input = 0;
+   for (ossim_uint32 idx = 0; idx < m_nodes.size(); ++idx)
+   {
+      if ( m_nodes[idx].m_parent == (ossim_int32)node )
+      {
+         saveNode( kwl, prefix + "node" + ossimString::toString(input) + ".", idx );
+         ++input;
+      }
+   }
+}
+
+bool ossimChainProfiler::write(const ossimFilename& file) const
+{
+   ossimKeywordlist kwl;
+   saveState(kwl, "chain_profile.");
+   return kwl.write( file.c_str() );
+}
+
+ossimChainProfilerProbe::ossimChainProfilerProbe()
+   : ossimImageSourceFilter(),
+     m_profiler(0),
+     m_node(-1),
+     m_spanName(0),
+     m_ioSourceAdded(false)
+{
+}
+
+ossimChainProfilerProbe::ossimChainProfilerProbe(ossimChainProfiler* profiler,
+                                                 ossim_uint32 node)
+   : ossimImageSourceFilter(),
+     m_profiler(profiler),
+     m_node((ossim_int32)node),
+     m_spanName(0),
+     m_ioSourceAdded(false)
+{
+}
+
+ossimChainProfilerProbe::~ossimChainProfilerProbe()
+{
+}
+
+ossimRefPtr<ossimImageData> ossimChainProfilerProbe::getTile(const ossimIrect& tileRect,
+                                                             ossim_uint32 resLevel)
+{
+   ossimRefPtr<ossimImageData> result = 0;
+   if ( theInputConnection )
+   {
+      ossimTimeline* timeline = ossimTimeline::instance();
+      if ( timeline->isRecording() && !m_spanName )
+      {
+         m_spanName = timeline->intern(theInputConnection->getClassName().string());
+      }
+      ossimTimeline::Span span(m_spanName, "getTile");
+
+      if ( m_profiler.valid() && (m_node >= 0) )
+      {
+         if ( !m_ioSourceAdded )
+         {
+            m_profiler->addIoSource( (ossim_uint32)m_node,
+                                     dynamic_cast<ossimImageHandler*>(theInputConnection) );
+            m_ioSourceAdded = true;
+         }
+         m_profiler->begin(m_node);
+         try
+         {
+            result = theInputConnection->getTile(tileRect, resLevel);
+         }
+         catch (...)
+         {
+            m_profiler->end(m_node, 0);
+            throw;
+         }
+         m_profiler->end(m_node, result.get());
+      }
+      else
+      {
+         result = theInputConnection->getTile(tileRect, resLevel);
+      }
+   }
+   return result;
+}
+
+ossim_int32 ossimChainProfilerProbe::getNode() const
+{
+   return m_node;
+}
+
+bool ossimChainProfilerProbe::saveState(ossimKeywordlist& kwl, const char* prefix) const
+{
+   kwl.add(prefix, PROFILE_NODE_KW, m_node, true);
+   return ossimImageSourceFilter::saveState(kwl, prefix);
+}
+
+bool ossimChainProfilerProbe::loadState(const ossimKeywordlist& kwl, const char* prefix)
+{
+   m_profiler = 0;
+   m_node = -1;
+   m_ioSourceAdded = false;
+   const char* lookup = kwl.find(prefix, PROFILE_NODE_KW);
+   if ( lookup )
+   {
+      m_node = ossimString(lookup).toInt32();
+      ossimChainProfiler* profiler = ossimChainProfiler::getActive();
+      if ( profiler && (m_node >= 0) &&
+           ((ossim_uint32)m_node < profiler->getNumberOfNodes()) )
+      {
+         m_profiler = profiler;
+      }
+   }
+   return ossimImageSourceFilter::loadState(kwl, prefix);
+}
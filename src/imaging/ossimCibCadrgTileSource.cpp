@@ -50,8 +50,6 @@ const ossim_uint32 ossimCibCadrgTileSource::CIBCADRG_FRAME_HEIGHT = 1536;
 
 ossimCibCadrgTileSource::ossimCibCadrgTileSource()
    :ossimImageHandler(),
-    theCompressedBuffer(0),
-    theUncompressedBuffer(0),
     theNumberOfLines(0),
     theNumberOfSamples(0),
     theTile(0),
@@ -60,6 +58,7 @@ ossimCibCadrgTileSource::ossimCibCadrgTileSource()
     theEntryNumberToRender(1),
     theTileSize(128, 128),
     theProductType(OSSIM_PRODUCT_TYPE_UNKNOWN),
+    theSubframeCache(),
     theSkipEmptyCheck(false)
 {
    if (traceDebug())
@@ -71,35 +70,10 @@ ossimCibCadrgTileSource::ossimCibCadrgTileSource()
          << "OSSIM_ID:  " << OSSIM_ID << "\n";
 #endif      
    }
-   theWorkFrame = new ossimRpfFrame;
-   
-   // a CADRG and CIBis a 64*64*12 bit buffer and must divide by 8 to
-   // convert to bytes
-   theCompressedBuffer   = new ossim_uint8[(64*64*12)/8];
-
-   // whether CIB or CADRG we will alocate the buffer
-   // to the larger of the 2 (CADRG is 3 bands)
-   theUncompressedBuffer = new ossim_uint8[256*256*3];
-                           
 }
 
 ossimCibCadrgTileSource::~ossimCibCadrgTileSource()
 {
-   if(theCompressedBuffer)
-   {
-      delete [] theCompressedBuffer;
-      theCompressedBuffer = 0;
-   }
-   if(theUncompressedBuffer)
-   {
-      delete [] theUncompressedBuffer;
-      theUncompressedBuffer = 0;
-   }
-   if(theWorkFrame)
-   {
-      delete theWorkFrame;
-      theWorkFrame = 0;
-   }
    close();
 }
 
@@ -496,6 +470,9 @@ bool ossimCibCadrgTileSource::setEntryToRender(ossim_uint32 index)
             }
             
             populateLut();
+
+            // Subframes are cached by image position, for this entry only.
+            theSubframeCache.reset(getImageRectangle(), getNumberOfOutputBands());
             
             return true;
          }
@@ -705,312 +682,16 @@ void ossimCibCadrgTileSource::fillTile(
    const vector<ossimFrameEntryData>& framesInvolved,
    ossimImageData* tile)
 {
-   ossim_uint32 idx = 0;
-   for(idx = 0;
-       idx < framesInvolved.size();
-       ++idx)
+   // the actual pixel of a frame will be 1536*row and 1536 *col.
+   std::vector<ossimRpfSubframeCache::Frame> frames;
+   for(ossim_uint32 idx = 0; idx < framesInvolved.size(); ++idx)
    {
-
-      if(theWorkFrame->parseFile(framesInvolved[idx].theFrameEntry.getFullPath())
-         == ossimErrorCodes::OSSIM_OK)
-      {
-         // we will fill a subtile.  We pass in which frame it is and the position of the frame.
-         // the actual pixel will be 1536*row and 1536 *col.
-         if(theProductType == OSSIM_PRODUCT_TYPE_CIB)
-         {
-            fillSubTileCib(*theWorkFrame,
-                           tileRect,
-                           framesInvolved[idx],
-                           tile);
-         }
-         else
-         {
-            fillSubTileCadrg(*theWorkFrame,
-                             tileRect,
-                             framesInvolved[idx],
-                             tile);
-         }
-      }
+      frames.push_back(ossimRpfSubframeCache::Frame(
+                          framesInvolved[idx].theFrameEntry.getFullPath(),
+                          ossimIpt(framesInvolved[idx].thePixelCol,
+                                   framesInvolved[idx].thePixelRow)));
    }
-}
-
-void ossimCibCadrgTileSource::fillSubTileCadrg(
-   const ossimRpfFrame&  aFrame,
-   const ossimIrect& tileRect,
-   const ossimFrameEntryData& frameEntryData,
-   ossimImageData* tile)
-{
-   // first let's grab the absolute position of the frame rectangle in pixel space
-   ossimIrect frameRect(frameEntryData.thePixelCol,
-                        frameEntryData.thePixelRow,
-                        frameEntryData.thePixelCol + CIBCADRG_FRAME_WIDTH  - 1,
-                        frameEntryData.thePixelRow + CIBCADRG_FRAME_HEIGHT - 1);
-
-   
-   // now clip it to the tile
-   ossimIrect clipRect = tileRect.clipToRect(frameRect);
-   
-   const ossimRpfCompressionSection* compressionSection = aFrame.getCompressionSection();
-   
-   if(!compressionSection)
-   {
-      return;
-   }
-
-   const vector<ossimRpfColorGrayscaleTable>& colorTable =
-      aFrame.getColorGrayscaleTable();
-
-   // ESH 03/2009 -- Partial fix for ticket #646.
-   // Crash fix on reading RPFs: Make sure the colorTable vector 
-   // has entries before trying to make use of them. 
-   int numTables = (int)colorTable.size();
-   if ( numTables <= 0 )
-   {
-      return;
-   }
-
-   ossim_uint8 *tempRows[3];
-   
-   tempRows[0] = theUncompressedBuffer;
-   tempRows[1] = (theUncompressedBuffer + 256*256);
-   tempRows[2] = (tempRows[1] + 256*256);
-   
-   // find the shift to 0,0
-   ossimIpt tempDelta(clipRect.ul().x - frameEntryData.thePixelCol,
-                      clipRect.ul().y - frameEntryData.thePixelRow);
-   
-   
-   // In order to compute the subframe we will need the corner offsets of
-   // the upper left of the frame and the upper left of the clip rect.  The
-   // clip rect should be completely within the frame.  This just translates the value
-   // to make the upper left of the frame be 0,0.
-   //
-   ossimIrect offsetRect(tempDelta.x,
-                         tempDelta.y,
-                         tempDelta.x + clipRect.width()-1,
-                         tempDelta.y + clipRect.height()-1);
-   
-   // each subframe is 64x64.  We will actually use 256x256 since
-   // we will be uncompressing them.  Note CADRG is a 256x256 tile
-   // compressed to 64x64x12 bit data
-   //
-    ossimIrect subFrameRect(offsetRect.ul().x/256,
-                            offsetRect.ul().y/256,
-                            (offsetRect.lr().x)/256,
-                            (offsetRect.lr().y)/256);
-   
-   ossim_uint32 readPtr  = 0;
-
-   ossim_int32 row = 0;
-   ossim_int32 col = 0;
-   ossim_uint32 i = 0;
-   ossim_uint32 j = 0;
-   ossim_int32 upperY = subFrameRect.lr().y;
-   ossim_int32 upperX = subFrameRect.lr().x;
-   ossim_int32 lowerY = subFrameRect.ul().y;
-   ossim_int32 lowerX = subFrameRect.ul().x; 
-   for(row = lowerY; row <= upperY; ++row)
-   {
-      for(col = lowerX; col <= upperX; ++col)
-      {
-         readPtr = 0;
-         if(aFrame.fillSubFrameBuffer(theCompressedBuffer, 0, row, col))
-         {
-            for (i = 0; i < 256; i += 4)
-            {
-               for (j = 0; j < 256; j += 8)
-               {
-                  ossim_uint16 firstByte  = theCompressedBuffer[readPtr++] & 0xff;
-                  ossim_uint16 secondByte = theCompressedBuffer[readPtr++] & 0xff;
-                  ossim_uint16 thirdByte  = theCompressedBuffer[readPtr++] & 0xff;
-                  
-                  //because dealing with half-bytes is hard, we
-                  //uncompress two 4x4 tiles at the same time. (a
-                  //4x4 tile compressed is 12 bits )
-                  // this little code was grabbed from openmap software.
-                  
-                  /* Get first 12-bit value as index into VQ table */
-                  // I think we need to swap
-                  ossim_uint16 val1 = (firstByte << 4) | (secondByte >> 4);
-                  
-                  /* Get second 12-bit value as index into VQ table*/
-                  ossim_uint16 val2 = ((secondByte & 0x000F) << 8) | thirdByte;
-                  
-                  for (ossim_uint32 t = 0; t < 4; ++t)
-                  {
-                     for (ossim_uint32 e = 0; e < 4; ++e)
-                     {
-                        ossim_uint16 tableVal1 = compressionSection->getTable()[t].theData[val1*4 + e] & 0xff;
-                        ossim_uint16 tableVal2 = compressionSection->getTable()[t].theData[val2*4 + e] & 0xff;
-
-                        ossim_uint32 pixindex = ((i+t)*256) +
-                                                 (j + e);
-                        const ossim_uint8* color1 = colorTable[0].getStartOfData(tableVal1);
-                        const ossim_uint8* color2 = colorTable[0].getStartOfData(tableVal2);
-                        
-                        
-                        tempRows[0][pixindex] = color1[0];
-                        tempRows[1][pixindex] = color1[1];
-                        tempRows[2][pixindex] = color1[2];
-                        
-                        tempRows[0][pixindex+4] = color2[0];
-                        tempRows[1][pixindex+4] = color2[1];
-                        tempRows[2][pixindex+4] = color2[2];
-                     } //for e
-                  } //for t
-               }  /* for j */
-            } //for i
-         }
-         else
-         {
-            memset(theUncompressedBuffer, 0, 256*256*3);
-         }
-         ossim_int32 tempCol = col*256;
-         ossim_int32 tempRow = row*256;
-         ossimIrect subRectToFill(frameRect.ul().x + tempCol,
-                                  frameRect.ul().y + tempRow,
-                                  frameRect.ul().x + tempCol + 255,
-                                  frameRect.ul().y + tempRow + 255);
-         tile->loadTile(theUncompressedBuffer,
-                        subRectToFill,
-                        OSSIM_BSQ);
-      }
-   }
-}
-
-void ossimCibCadrgTileSource::fillSubTileCib(
-   const ossimRpfFrame&  aFrame,
-   const ossimIrect& tileRect,
-   const ossimFrameEntryData& frameEntryData,
-   ossimImageData* tile)
-{
-   // first let's grab the absolute position of the frame rectangle in pixel
-   // space
-   ossimIrect frameRect(frameEntryData.thePixelCol,
-                        frameEntryData.thePixelRow,
-                        frameEntryData.thePixelCol + CIBCADRG_FRAME_WIDTH  - 1,
-                        frameEntryData.thePixelRow + CIBCADRG_FRAME_HEIGHT - 1);
-
-   
-   // now clip it to the tile
-   ossimIrect clipRect = tileRect.clipToRect(frameRect);
-
-   const ossimRpfCompressionSection* compressionSection = aFrame.getCompressionSection();
-   
-   if(!compressionSection)
-   {
-      return;
-   }
-
-   const vector<ossimRpfColorGrayscaleTable>& colorTable =
-      aFrame.getColorGrayscaleTable();
-
-   // ESH 03/2009 -- Partial fix for ticket #646.
-   // Crash fix on reading RPFs: Make sure the colorTable vector 
-   // has entries before trying to make use of them. 
-   int numTables = (int)colorTable.size();
-   if ( numTables <= 0 )
-   {
-      return;
-   }
-
-   // check to see if it does overlap.  If it doesn't then the width and height
-   // will be a single point
-   {
-      ossim_uint8 *tempRow;
-
-      tempRow = theUncompressedBuffer;
-      
-      // find the shift to 0,0
-      ossimIpt tempDelta(clipRect.ul().x - frameEntryData.thePixelCol,
-                         clipRect.ul().y - frameEntryData.thePixelRow);
-      
-      // In order to compute the subframe we will need the corner offsets of
-      // the upper left of the frame and the upper left of the clip rect.  The
-      // clip rect should be completely within the frame.  This just translates the value
-      // to make the upper left of the frame be 0,0.
-      //
-      ossimIrect offsetRect(tempDelta.x,
-                            tempDelta.y,
-                            tempDelta.x + clipRect.width()-1,
-                            tempDelta.y + clipRect.height()-1);
-
-      // each subframe is 64x64.  We will actually use 256x256 since
-      // we will be uncompressing them.  Note CADRG is a 256x256 tile
-      // compressed to 64x64x12 bit data
-      //
-      ossimIrect subFrameRect(offsetRect.ul().x/256,
-                              offsetRect.ul().y/256,
-                              (offsetRect.lr().x)/256,
-                              (offsetRect.lr().y)/256);
-
-      ossim_int32 row = 0;
-      ossim_int32 col = 0;
-      ossim_uint32 i = 0;
-      ossim_uint32 j = 0;
-      ossim_uint32 readPtr = 0;
-      for(row = subFrameRect.ul().y; row <= subFrameRect.lr().y; ++row)
-      {
-         for(col = subFrameRect.ul().x; col <= subFrameRect.lr().x; ++col)
-         {
-            readPtr = 0;
-            if(aFrame.fillSubFrameBuffer(theCompressedBuffer, 0, row, col))
-            {
-               for (i = 0; i < 256; i += 4)
-               {
-                  for (j = 0; j < 256; j += 8)
-                  {
-                     ossim_uint16 firstByte  = theCompressedBuffer[readPtr++] & 0xff;
-                     ossim_uint16 secondByte = theCompressedBuffer[readPtr++] & 0xff;
-                     ossim_uint16 thirdByte  = theCompressedBuffer[readPtr++] & 0xff;
-                     
-                     //because dealing with half-bytes is hard, we
-                     //uncompress two 4x4 tiles at the same time. (a
-                     //4x4 tile compressed is 12 bits )
-                     // this little code was grabbed from openmap software.
-                     
-                     /* Get first 12-bit value as index into VQ table */
-                     // I think we need to swap
-                     ossim_uint16 val1 = (firstByte << 4) | (secondByte >> 4);
-                     
-                     /* Get second 12-bit value as index into VQ table*/
-                     ossim_uint16 val2 = ((secondByte & 0x000F) << 8) | thirdByte;
-
-                     for (ossim_uint32 t = 0; t < 4; ++t)
-                     {
-                        for (ossim_uint32 e = 0; e < 4; ++e)
-                        {
-                           ossim_uint16 tableVal1 = compressionSection->getTable()[t].theData[val1*4 + e] & 0xff;
-                           ossim_uint16 tableVal2 = compressionSection->getTable()[t].theData[val2*4 + e] & 0xff;
-
-                           ossim_uint32 pixindex = ((i+t)*256) + (j + e);
-                           const ossim_uint8* color1 = colorTable[0].getStartOfData(tableVal1);
-                           const ossim_uint8* color2 = colorTable[0].getStartOfData(tableVal2);
-
-                           
-                           tempRow[pixindex]      = color1[0];
-                           tempRow[pixindex + 4]  = color2[0];
-                        } //for e
-                     } //for t
-                  }  /* for j */
-               } //for i
-            }
-            else
-            {
-               memset(theUncompressedBuffer, 0, 256*256);
-            }
-            ossim_int32 tCol = col*256;
-            ossim_int32 tRow = row*256;
-            ossimIrect subRectToFill(frameRect.ul().x + tCol,
-                                     frameRect.ul().y + tRow,
-                                     frameRect.ul().x + tCol + 255,
-                                     frameRect.ul().y + tRow + 255);
-            tile->loadTile(theUncompressedBuffer,
-                           subRectToFill,
-                           OSSIM_BSQ);
-         }
-      }
-   }  
+   theSubframeCache.fillTile(tileRect, frames, tile);
 }
 
 void ossimCibCadrgTileSource::allocateForProduct()
@@ -1019,29 +700,6 @@ void ossimCibCadrgTileSource::allocateForProduct()
    {
       return;
    }
-   if(theUncompressedBuffer)
-   {
-      delete [] theUncompressedBuffer;
-      theUncompressedBuffer = 0;
-   }
-   if(theCompressedBuffer)
-   {
-      delete [] theCompressedBuffer;
-      theCompressedBuffer = 0;
-   }
-   
-   // a CADRG and CIBis a 64*64*12 bit buffer and must divide by 8 to
-   // convert to bytes
-   theCompressedBuffer   = new ossim_uint8[(64*64*12)/8];
-   if(theProductType == OSSIM_PRODUCT_TYPE_CIB)
-   {
-      theUncompressedBuffer = new ossim_uint8[256*256];
-   }
-   else
-   {
-      theUncompressedBuffer = new ossim_uint8[256*256*3];
-   }
-   
    theTile = ossimImageDataFactory::instance()->create(this, this);
    theTile->initialize();
 }
@@ -1070,6 +728,7 @@ const ossimRpfTocEntry* ossimCibCadrgTileSource::findFirstFrame()
 void ossimCibCadrgTileSource::deleteAll()
 {
    theOverview = 0;
+   theSubframeCache.clear();
    if(theTableOfContents)
    {
       delete theTableOfContents;
@@ -1,3 +1,16 @@
 #include <ossim/imaging/ossimCodecBase.h>
 
-RTTI_DEF2(ossimCodecBase, "ossimCodecBase", ossimObject, ossimPropertyInterface);
\ No newline at end of file
+RTTI_DEF2(ossimCodecBase, "ossimCodecBase", ossimObject, ossimPropertyInterface);
+
+bool ossimCodecBase::decode( const ossim_uint8* in,
+                             ossim_uint64 size,
+                             ossimRefPtr<ossimImageData>& out,
+                             ossim_uint32 scale ) const
+{
+   if ( !in || !size || (scale != 1) )
+   {
+      return false;
+   }
+   std::vector<ossim_uint8> buf(in, in + size);
+   return decode( buf, out );
+}
\ No newline at end of file
@@ -13,8 +13,11 @@
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimDiscreteConvolutionKernel.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageDataKernels.h>
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimKeyword.h>
+#include <algorithm>
+#include <cmath>
 
 static const ossimKeyword NUMBER_OF_MATRICES = ossimKeyword("number_of_matrices", "");
 static const ossimKeyword NUMBER_OF_ROWS = ossimKeyword("rows", "");
@@ -274,6 +277,18 @@ void ossimConvolutionSource::convolve(T /* dummyVariable */,
                        startOrigin.y - inputTile->getOrigin().y);
 
    ossimDataObjectStatus status = inputTile->getDataObjectStatus();
+   if(status == OSSIM_FULL)
+   {
+      for(ossim_uint32 idx = 0; idx < theConvolutionKernelList.size(); ++idx)
+      {
+         if((theConvolutionKernelList[idx] == kernel) && (idx < theKernelTaps.size()))
+         {
+            convolveFull(static_cast<T>(0), inputTile.get(), kernel, theKernelTaps[idx]);
+            return;
+         }
+      }
+   }
+   
    // let's setup some variables that we will need to do the
    // convolution algorithm.
    //
@@ -368,6 +383,179 @@ void ossimConvolutionSource::convolve(T /* dummyVariable */,
    }
 }
 
+template <class T>
+void ossimConvolutionSource::convolveFull(T /* dummyVariable */,
+                                          const ossimImageData* inputTile,
+                                          const ossimDiscreteConvolutionKernel* kernel,
+                                          const ossimConvolutionTaps& taps)
+{
+   //---
+   // Each output row is summed tap by tap over the whole row, in the order
+   // ossimDiscreteConvolutionKernel::convolveSubImage sums a pixel, so the direct path gives its
+   // results.  There are no nulls to leave out.
+   //---
+   const ossimIpt startDelta(theTile->getOrigin().x - inputTile->getOrigin().x,
+                             theTile->getOrigin().y - inputTile->getOrigin().y);
+   const long tileHeight  = theTile->getHeight();
+   const long tileWidth   = theTile->getWidth();
+   const long outputBands = theTile->getNumberOfBands();
+   const long kernelWidth  = kernel->getWidth();
+   const long kernelHeight = kernel->getHeight();
+   const long patchWidth   = inputTile->getWidth();
+   const long patchSize    = patchWidth*inputTile->getHeight();
+   
+   // Patch offset of the top left tap for the first output pixel.
+   const long topLeft = patchWidth*(startDelta.y - kernelHeight/2) + startDelta.x - kernelWidth/2;
+   
+   const double minPix = ossim::defaultMin(getOutputScalarType());
+   const double maxPix = ossim::defaultMax(getOutputScalarType());
+
+   thePatchBuffer.resize(patchSize);
+   theSumBuffer.resize(tileWidth);
+   if(taps.theSeparableFlag)
+   {
+      theRowBuffer.resize(tileWidth*(tileHeight + kernelHeight - 1));
+   }
+   double* patch = &thePatchBuffer.front();
+   double* sum   = &theSumBuffer.front();
+   
+   for(long b = 0; b < outputBands; ++b)
+   {
+      const T* buf = (const T*)inputTile->getBuf(b);
+      T* outBuf    = (T*)theTile->getBuf(b);
+      for(long i = 0; i < patchSize; ++i)
+      {
+         patch[i] = buf[i];
+      }
+
+      if(taps.theSeparableFlag)
+      {
+         // Horizontal pass over every input row an output row needs.
+         for(long row = 0; row < tileHeight + kernelHeight - 1; ++row)
+         {
+            double* rowOut = &theRowBuffer[row*tileWidth];
+            const double* rowIn = patch + topLeft + row*patchWidth;
+            std::fill(rowOut, rowOut + tileWidth, 0.0);
+            for(long col = 0; col < kernelWidth; ++col)
+            {
+               ossim::addWeighted(rowIn + col, rowOut, tileWidth, taps.theRowTaps[col]);
+            }
+         }
+      }
+      
+      for(long y = 0; y < tileHeight; ++y)
+      {
+         std::fill(sum, sum + tileWidth, 0.0);
+         if(taps.theSeparableFlag)
+         {
+            for(long row = 0; row < kernelHeight; ++row)
+            {
+               ossim::addWeighted(&theRowBuffer[(y + row)*tileWidth], sum, tileWidth,
+                                  taps.theColTaps[row]);
+            }
+         }
+         else
+         {
+            const double* tap = &taps.theTaps.front();
+            for(long row = 0; row < kernelHeight; ++row)
+            {
+               const double* rowIn = patch + topLeft + (y + row)*patchWidth;
+               for(long col = 0; col < kernelWidth; ++col)
+               {
+                  ossim::addWeighted(rowIn + col, sum, tileWidth, *tap);
+                  ++tap;
+               }
+            }
+         }
+
+         T* out = outBuf + y*tileWidth;
+         for(long x = 0; x < tileWidth; ++x)
+         {
+            double convolveResult = sum[x];
+            if(taps.theDivisor > 0)
+            {
+               convolveResult /= taps.theDivisor;
+            }
+            convolveResult = convolveResult < minPix? (T)minPix:convolveResult;
+            convolveResult = convolveResult > maxPix?(T)maxPix:convolveResult;
+            out[x] = (T)convolveResult;
+         }
+      }
+   }
+}
+
+void ossimConvolutionSource::initTaps(const ossimDiscreteConvolutionKernel* kernel,
+                                      ossimConvolutionTaps& taps)
+{
+   const NEWMAT::Matrix& k = kernel->getKernel();
+   const long w = kernel->getWidth();
+   const long h = kernel->getHeight();
+   
+   taps.theTaps.resize(w*h);
+   taps.theRowTaps.clear();
+   taps.theColTaps.clear();
+   taps.theDivisor = 0.0;
+   taps.theSeparableFlag = false;
+
+   // Largest coefficient, to factor around.
+   long maxRow = 0;
+   long maxCol = 0;
+   double maxValue = 0.0;
+   for(long row = 0; row < h; ++row)
+   {
+      for(long col = 0; col < w; ++col)
+      {
+         const double v = k[row][col];
+         taps.theTaps[row*w + col] = v;
+         if(kernel->getComputeWeightedAverageFlag())
+         {
+            taps.theDivisor += v;
+         }
+         if(std::fabs(v) > maxValue)
+         {
+            maxValue = std::fabs(v);
+            maxRow = row;
+            maxCol = col;
+         }
+      }
+   }
+
+   // Two 1D passes only pay off past 3x3.
+   if((maxValue == 0.0) || (w < 2) || (h < 2) || (w*h <= 2*(w + h)))
+   {
+      return;
+   }
+
+   //---
+   // Rank one if k[row][col] == colTaps[row]*rowTaps[col], with
+   // colTaps = column maxCol and rowTaps = row maxRow scaled to 1 at maxCol.
+   //---
+   taps.theColTaps.resize(h);
+   taps.theRowTaps.resize(w);
+   for(long row = 0; row < h; ++row)
+   {
+      taps.theColTaps[row] = k[row][maxCol];
+   }
+   for(long col = 0; col < w; ++col)
+   {
+      taps.theRowTaps[col] = k[maxRow][col]/k[maxRow][maxCol];
+   }
+   const double tolerance = maxValue*1.0e-12;
+   for(long row = 0; row < h; ++row)
+   {
+      for(long col = 0; col < w; ++col)
+      {
+         if(std::fabs(k[row][col] - taps.theColTaps[row]*taps.theRowTaps[col]) > tolerance)
+         {
+            taps.theColTaps.clear();
+            taps.theRowTaps.clear();
+            return;
+         }
+      }
+   }
+   taps.theSeparableFlag = true;
+}
+
 void ossimConvolutionSource::initialize()
 {
    ossimImageSourceFilter::initialize();
@@ -504,6 +692,12 @@ void ossimConvolutionSource::setKernelInformation()
          theMaxKernelHeight = theMaxKernelHeight < h?h:theMaxKernelHeight;
       }
    }
+
+   theKernelTaps.resize(theConvolutionKernelList.size());
+   for(index = 0; index < theConvolutionKernelList.size(); ++index)
+   {
+      initTaps(theConvolutionKernelList[index], theKernelTaps[index]);
+   }
 }
 
 void ossimConvolutionSource::deleteConvolutionList()
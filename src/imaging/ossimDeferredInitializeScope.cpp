@@ -0,0 +1,162 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description:
+//
+// Scope in which image source re-initialization on events is collected
+// and run once, in input to output order, when the scope ends.
+//
+//*******************************************************************
+// $Id$
+
+#include <ossim/imaging/ossimDeferredInitializeScope.h>
+#include <ossim/imaging/ossimImageSource.h>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace
+{
+   /** Open scopes and queued sources of a thread. */
+   struct ossimDeferredInitializeState
+   {
+      ossimDeferredInitializeState() : m_depth(0), m_pending(), m_queued() {}
+
+      ossim_uint32                     m_depth;
+      std::vector<ossimImageSource*>   m_pending; // in request order
+      std::set<ossimImageSource*>      m_queued;
+   };
+
+   typedef std::map<const OpenThreads::Thread*, ossimDeferredInitializeState> StateMap;
+
+   OpenThreads::Mutex& stateMutex()
+   {
+      static OpenThreads::Mutex mutex;
+      return mutex;
+   }
+
+   StateMap& states()
+   {
+      static StateMap stateMap;
+      return stateMap;
+   }
+
+   //---
+   // Longest path from obj to a source with no inputs; memo holds the
+   // objects seen, entered as 0 first so a cycle cannot recurse forever.
+   //---
+   ossim_uint32 upstreamDepth(ossimConnectableObject* obj,
+                              std::map<ossimConnectableObject*, ossim_uint32>& memo)
+   {
+      std::map<ossimConnectableObject*, ossim_uint32>::const_iterator found = memo.find(obj);
+      if ( found != memo.end() )
+      {
+         return found->second;
+      }
+      memo[obj] = 0;
+
+      ossim_uint32 depth = 0;
+      const ossim_uint32 INPUTS = obj->getNumberOfInputs();
+      for ( ossim_uint32 i = 0; i < INPUTS; ++i )
+      {
+         ossimConnectableObject* input = obj->getInput(i);
+         if ( input )
+         {
+            depth = std::max( depth, upstreamDepth(input, memo) + 1 );
+         }
+      }
+      memo[obj] = depth;
+      return depth;
+   }
+
+   class DepthLess
+   {
+   public:
+      DepthLess(const std::map<ossimImageSource*, ossim_uint32>& depths) : m_depths(depths) {}
+      bool operator()(ossimImageSource* a, ossimImageSource* b) const
+      {
+         return m_depths.find(a)->second < m_depths.find(b)->second;
+      }
+   private:
+      const std::map<ossimImageSource*, ossim_uint32>& m_depths;
+   };
+}
+
+ossimDeferredInitializeScope::ossimDeferredInitializeScope()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock( stateMutex() );
+   ++states()[ OpenThreads::Thread::CurrentThread() ].m_depth;
+}
+
+ossimDeferredInitializeScope::~ossimDeferredInitializeScope()
+{
+   std::vector<ossimImageSource*> pending;
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock( stateMutex() );
+      StateMap::iterator state = states().find( OpenThreads::Thread::CurrentThread() );
+      if ( (state == states().end()) || (--state->second.m_depth > 0) )
+      {
+         return;
+      }
+      pending.swap( state->second.m_pending );
+      states().erase( state );
+   }
+
+   // Inputs first, so each source initializes against initialized inputs:
+   std::map<ossimConnectableObject*, ossim_uint32> memo;
+   std::map<ossimImageSource*, ossim_uint32> depths;
+   for ( std::vector<ossimImageSource*>::const_iterator i = pending.begin();
+         i != pending.end(); ++i )
+   {
+      depths[*i] = upstreamDepth( *i, memo );
+   }
+   std::stable_sort( pending.begin(), pending.end(), DepthLess(depths) );
+
+   // Events these fire are no longer deferred.
+   for ( std::vector<ossimImageSource*>::const_iterator i = pending.begin();
+         i != pending.end(); ++i )
+   {
+      (*i)->initialize();
+   }
+}
+
+bool ossimDeferredInitializeScope::defer(ossimImageSource* source)
+{
+   if ( !source )
+   {
+      return false;
+   }
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock( stateMutex() );
+   if ( states().empty() )
+   {
+      return false;
+   }
+   StateMap::iterator state = states().find( OpenThreads::Thread::CurrentThread() );
+   if ( state == states().end() )
+   {
+      return false;
+   }
+   if ( state->second.m_queued.insert(source).second )
+   {
+      state->second.m_pending.push_back( source );
+   }
+   return true;
+}
+
+void ossimDeferredInitializeScope::cancel(ossimImageSource* source)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock( stateMutex() );
+   for ( StateMap::iterator state = states().begin(); state != states().end(); ++state )
+   {
+      if ( state->second.m_queued.erase(source) )
+      {
+         std::vector<ossimImageSource*>& pending = state->second.m_pending;
+         pending.erase( std::remove(pending.begin(), pending.end(), source), pending.end() );
+      }
+   }
+}
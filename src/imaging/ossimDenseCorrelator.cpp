@@ -0,0 +1,705 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description:
+//
+// Dense normalized cross correlation between two images in the same
+// image space.
+//
+//*******************************************************************
+// $Id$
+
+#include <ossim/imaging/ossimDenseCorrelator.h>
+#include <ossim/imaging/ossimImageSource.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <OpenThreads/Block>
+#include <OpenThreads/ScopedLock>
+#include <cmath>
+#include <complex>
+
+namespace
+{
+   typedef std::complex<double> Complex;
+
+   // Windows with less variance than this are flat and not correlated.
+   const double MIN_VARIANCE = 1.0e-12;
+
+   //---
+   // In place radix-2 FFT of n (a power of two) values spaced stride apart.
+   // The inverse is not scaled by 1/n. Own code rather than newmat's FFT,
+   // whose tracer stack is global and so not safe to use from the jobs.
+   //---
+   void fft(Complex* a, ossim_uint32 n, ossim_uint32 stride, bool inverse)
+   {
+      for ( ossim_uint32 i = 1, j = 0; i < n; ++i )
+      {
+         ossim_uint32 bit = n >> 1;
+         for ( ; j & bit; bit >>= 1 )
+         {
+            j ^= bit;
+         }
+         j ^= bit;
+         if ( i < j )
+         {
+            std::swap( a[i*stride], a[j*stride] );
+         }
+      }
+      for ( ossim_uint32 len = 2; len <= n; len <<= 1 )
+      {
+         const double ANGLE = (inverse ? 2.0 : -2.0) * M_PI / len;
+         const Complex W_LEN( std::cos(ANGLE), std::sin(ANGLE) );
+         for ( ossim_uint32 i = 0; i < n; i += len )
+         {
+            Complex w(1.0, 0.0);
+            for ( ossim_uint32 k = 0; k < len / 2; ++k )
+            {
+               Complex& u = a[(i + k)*stride];
+               Complex& v = a[(i + k + len/2)*stride];
+               const Complex T = v * w;
+               v = u - T;
+               u += T;
+               w *= W_LEN;
+            }
+         }
+      }
+   }
+
+   /** 2D FFT of an n x n row major array. */
+   void fft2(std::vector<Complex>& a, ossim_uint32 n, bool inverse)
+   {
+      for ( ossim_uint32 r = 0; r < n; ++r )
+      {
+         fft( &a[r*n], n, 1, inverse );
+      }
+      for ( ossim_uint32 c = 0; c < n; ++c )
+      {
+         fft( &a[c], n, n, inverse );
+      }
+   }
+
+   //---
+   // Running sums of a search area: value, value squared and nulls above and
+   // left of each position, (width + 1) per row. The pointers are at the
+   // search area's upper left, possibly inside the sums of a larger tile.
+   //---
+   struct ossimDenseCorrelatorSums
+   {
+      const double* m_sum;
+      const double* m_sum2;
+      const double* m_nulls;
+      ossim_uint32  m_stride;
+
+      double window(const double* s, ossim_uint32 x, ossim_uint32 y, ossim_uint32 size) const
+      {
+         const double* top    = s + y*m_stride + x;
+         const double* bottom = top + size*m_stride;
+         return bottom[size] - bottom[0] - top[size] + top[0];
+      }
+   };
+
+   /** Fills the sums of a w x h buffer; NaN values count as nulls and zero. */
+   void buildSums(const ossim_float32* buf, ossim_uint32 w, ossim_uint32 h,
+                  std::vector<double>& sum, std::vector<double>& sum2,
+                  std::vector<double>& nulls)
+   {
+      const ossim_uint32 STRIDE = w + 1;
+      sum.assign( STRIDE*(h + 1), 0.0 );
+      sum2.assign( STRIDE*(h + 1), 0.0 );
+      nulls.assign( STRIDE*(h + 1), 0.0 );
+      for ( ossim_uint32 y = 0; y < h; ++y )
+      {
+         double rowSum   = 0.0;
+         double rowSum2  = 0.0;
+         double rowNulls = 0.0;
+         const ossim_uint32 ABOVE = y*STRIDE;
+         const ossim_uint32 HERE  = ABOVE + STRIDE;
+         for ( ossim_uint32 x = 0; x < w; ++x )
+         {
+            const double V = buf[y*w + x];
+            if ( ossim::isnan(V) )
+            {
+               rowNulls += 1.0;
+            }
+            else
+            {
+               rowSum  += V;
+               rowSum2 += V*V;
+            }
+            sum[HERE + x + 1]   = sum[ABOVE + x + 1]   + rowSum;
+            sum2[HERE + x + 1]  = sum2[ABOVE + x + 1]  + rowSum2;
+            nulls[HERE + x + 1] = nulls[ABOVE + x + 1] + rowNulls;
+         }
+      }
+   }
+
+   /** Sub pixel offset of a peak from its neighbors, in [-0.5, 0.5]. */
+   double peakOffset(double left, double center, double right)
+   {
+      double offset = 0.0;
+      if ( !ossim::isnan(left) && !ossim::isnan(right) )
+      {
+         const double DEN = left - 2.0*center + right;
+         if ( DEN < 0.0 )
+         {
+            offset = ossim::max( -0.5, ossim::min( 0.5, 0.5*(left - right)/DEN ) );
+         }
+      }
+      return offset;
+   }
+
+   //---
+   // The per node match. search (NaN for nulls) is searchStride values per
+   // row; sums are the running sums of the same area.
+   //---
+   bool matchNode(const ossim_float32* tmpl,
+                  ossim_uint32 tr,
+                  const ossim_float32* search,
+                  ossim_uint32 searchStride,
+                  const ossimDenseCorrelatorSums& sums,
+                  ossim_uint32 sr,
+                  bool useFft,
+                  ossim_float64& dx,
+                  ossim_float64& dy,
+                  ossim_float64& score)
+   {
+      const ossim_uint32 T = 2*tr + 1;
+      const ossim_uint32 S = 2*(tr + sr) + 1;
+      const ossim_uint32 C = 2*sr + 1;
+      const double N = T*T;
+
+      // Zero mean template:
+      double mean = 0.0;
+      for ( ossim_uint32 i = 0; i < T*T; ++i )
+      {
+         if ( ossim::isnan(tmpl[i]) )
+         {
+            return false;
+         }
+         mean += tmpl[i];
+      }
+      mean /= N;
+      std::vector<double> t(T*T);
+      double tNorm = 0.0;
+      for ( ossim_uint32 i = 0; i < T*T; ++i )
+      {
+         t[i] = tmpl[i] - mean;
+         tNorm += t[i]*t[i];
+      }
+      if ( tNorm < MIN_VARIANCE*N )
+      {
+         return false;
+      }
+
+      //---
+      // cross[c] = sum(t * window at c). As t has zero mean the window mean
+      // drops out, and the NCC is cross / sqrt(tNorm * window variance * N).
+      //---
+      std::vector<double> cross(C*C, 0.0);
+      if ( useFft )
+      {
+         ossim_uint32 P = 1;
+         while ( P < S )
+         {
+            P <<= 1;
+         }
+         std::vector<Complex> fs(P*P, Complex(0.0, 0.0));
+         std::vector<Complex> ft(P*P, Complex(0.0, 0.0));
+         for ( ossim_uint32 y = 0; y < S; ++y )
+         {
+            for ( ossim_uint32 x = 0; x < S; ++x )
+            {
+               const double V = search[y*searchStride + x];
+               fs[y*P + x] = Complex( ossim::isnan(V) ? 0.0 : V, 0.0 );
+            }
+         }
+         for ( ossim_uint32 y = 0; y < T; ++y )
+         {
+            for ( ossim_uint32 x = 0; x < T; ++x )
+            {
+               ft[y*P + x] = Complex( t[y*T + x], 0.0 );
+            }
+         }
+         fft2( fs, P, false );
+         fft2( ft, P, false );
+         for ( ossim_uint32 i = 0; i < P*P; ++i )
+         {
+            fs[i] *= std::conj( ft[i] );
+         }
+         fft2( fs, P, true );
+
+         // Shifts c < C and template offsets < T stay inside S <= P, so the
+         // circular correlation does not wrap.
+         const double SCALE = 1.0 / (double)(P*P);
+         for ( ossim_uint32 cy = 0; cy < C; ++cy )
+         {
+            for ( ossim_uint32 cx = 0; cx < C; ++cx )
+            {
+               cross[cy*C + cx] = fs[cy*P + cx].real() * SCALE;
+            }
+         }
+      }
+      else
+      {
+         for ( ossim_uint32 cy = 0; cy < C; ++cy )
+         {
+            for ( ossim_uint32 cx = 0; cx < C; ++cx )
+            {
+               double acc = 0.0;
+               for ( ossim_uint32 v = 0; v < T; ++v )
+               {
+                  const ossim_float32* row = search + (cy + v)*searchStride + cx;
+                  const double* tRow = &t[v*T];
+                  for ( ossim_uint32 u = 0; u < T; ++u )
+                  {
+                     acc += tRow[u] * row[u]; // NaN windows are dropped below
+                  }
+               }
+               cross[cy*C + cx] = acc;
+            }
+         }
+      }
+
+      // Normalize with the window statistics from the running sums:
+      std::vector<double> ncc(C*C, ossim::nan());
+      ossim_uint32 best = C*C;
+      for ( ossim_uint32 cy = 0; cy < C; ++cy )
+      {
+         for ( ossim_uint32 cx = 0; cx < C; ++cx )
+         {
+            if ( sums.window(sums.m_nulls, cx, cy, T) > 0.5 )
+            {
+               continue;
+            }
+            const double SUM  = sums.window(sums.m_sum, cx, cy, T);
+            const double SUM2 = sums.window(sums.m_sum2, cx, cy, T);
+            const double VAR  = SUM2 - SUM*SUM/N;
+            if ( VAR < MIN_VARIANCE*N )
+            {
+               continue;
+            }
+            const ossim_uint32 I = cy*C + cx;
+            ncc[I] = cross[I] / std::sqrt( tNorm * VAR );
+            if ( (best == C*C) || (ncc[I] > ncc[best]) )
+            {
+               best = I;
+            }
+         }
+      }
+      if ( best == C*C )
+      {
+         return false;
+      }
+
+      const ossim_uint32 BX = best % C;
+      const ossim_uint32 BY = best / C;
+      const double NAN_VALUE = ossim::nan();
+      dx = (double)BX - (double)sr + peakOffset( BX ? ncc[best - 1] : NAN_VALUE, ncc[best],
+                                                 (BX + 1 < C) ? ncc[best + 1] : NAN_VALUE );
+      dy = (double)BY - (double)sr + peakOffset( BY ? ncc[best - C] : NAN_VALUE, ncc[best],
+                                                 (BY + 1 < C) ? ncc[best + C] : NAN_VALUE );
+      score = ncc[best];
+      return true;
+   }
+
+   /** Copies band of rect from source to buf, NaN for nulls. */
+   void readBand(ossimImageSource* source, const ossimIrect& rect, ossim_uint32 band,
+                 std::vector<ossim_float32>& buf)
+   {
+      const ossim_uint32 W = rect.width();
+      const ossim_uint32 H = rect.height();
+      buf.assign( W*H, ossim::nan() );
+
+      ossimRefPtr<ossimImageData> tile = source->getTile(rect);
+      if ( !tile.valid() || !tile->getBuf() || (band >= tile->getNumberOfBands()) ||
+           (tile->getDataObjectStatus() == OSSIM_NULL) ||
+           (tile->getDataObjectStatus() == OSSIM_EMPTY) )
+      {
+         return;
+      }
+      const ossimIrect TILE_RECT = tile->getImageRectangle();
+      const ossim_uint32 TILE_W = TILE_RECT.width();
+      for ( ossim_uint32 y = 0; y < H; ++y )
+      {
+         const ossim_int32 TY = rect.ul().y + (ossim_int32)y - TILE_RECT.ul().y;
+         if ( (TY < 0) || (TY >= (ossim_int32)TILE_RECT.height()) )
+         {
+            continue;
+         }
+         for ( ossim_uint32 x = 0; x < W; ++x )
+         {
+            const ossim_int32 TX = rect.ul().x + (ossim_int32)x - TILE_RECT.ul().x;
+            if ( (TX < 0) || (TX >= (ossim_int32)TILE_W) )
+            {
+               continue;
+            }
+            const ossim_uint32 OFFSET = TY*TILE_W + TX;
+            if ( !tile->isNull(OFFSET, band) )
+            {
+               buf[y*W + x] = (ossim_float32)tile->getPix(OFFSET, band);
+            }
+         }
+      }
+   }
+
+   //---
+   // Hands out tiles of nodes to the jobs and releases the caller once the
+   // last job is done.
+   //---
+   class ossimDenseCorrelatorBatch : public ossimReferenced
+   {
+   public:
+      ossimDenseCorrelatorBatch(ossim_uint32 items, ossim_uint32 jobs)
+         : m_next(0),
+           m_items(items),
+           m_jobs(jobs)
+      {
+         if(m_jobs)
+         {
+            m_block.reset();
+         }
+         else
+         {
+            m_block.release();
+         }
+      }
+      bool next(ossim_uint32& item)
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if ( m_next >= m_items )
+         {
+            return false;
+         }
+         item = m_next++;
+         return true;
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_jobs && (--m_jobs == 0))
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+   private:
+      OpenThreads::Mutex m_mutex;
+      OpenThreads::Block m_block;
+      ossim_uint32       m_next;
+      ossim_uint32       m_items;
+      ossim_uint32       m_jobs;
+   };
+
+   /** Correlates tiles until the batch runs out. */
+   class ossimDenseCorrelatorJob : public ossimJob
+   {
+   public:
+      ossimDenseCorrelatorJob(ossimDenseCorrelator* correlator,
+                              ossim_uint32 tilesAcross,
+                              ossimDenseCorrelatorBatch* batch)
+         : m_correlator(correlator),
+           m_tilesAcross(tilesAcross),
+           m_batch(batch)
+      {
+         setName("ossimDenseCorrelator.tile");
+      }
+      virtual void start()
+      {
+         ossim_uint32 tile;
+         while ( m_batch->next(tile) )
+         {
+            m_correlator->correlateTile( tile % m_tilesAcross, tile / m_tilesAcross );
+         }
+         m_batch->done();
+      }
+   private:
+      ossimDenseCorrelator*                  m_correlator;
+      ossim_uint32                           m_tilesAcross;
+      ossimRefPtr<ossimDenseCorrelatorBatch> m_batch;
+   };
+}
+
+ossimDenseCorrelator::ossimDenseCorrelator()
+   : m_templateRadius(7),
+     m_searchRadius(8),
+     m_gridSpacing(8),
+     m_minCorrelation(0.7),
+     m_fftTemplateRadius(12),
+     m_tileNodes(16),
+     m_numberOfThreads(0),
+     m_master(0),
+     m_slave(0),
+     m_band(0),
+     m_readMutex(),
+     m_gridOrigin(0, 0),
+     m_gridSize(0, 0),
+     m_dx(),
+     m_dy(),
+     m_score()
+{
+}
+
+ossimDenseCorrelator::~ossimDenseCorrelator()
+{
+}
+
+void ossimDenseCorrelator::setTemplateRadius(ossim_uint32 radius)
+{
+   m_templateRadius = ossim::max<ossim_uint32>(radius, 1);
+}
+
+ossim_uint32 ossimDenseCorrelator::getTemplateRadius() const
+{
+   return m_templateRadius;
+}
+
+void ossimDenseCorrelator::setSearchRadius(ossim_uint32 radius)
+{
+   m_searchRadius = radius;
+}
+
+ossim_uint32 ossimDenseCorrelator::getSearchRadius() const
+{
+   return m_searchRadius;
+}
+
+void ossimDenseCorrelator::setGridSpacing(ossim_uint32 spacing)
+{
+   m_gridSpacing = ossim::max<ossim_uint32>(spacing, 1);
+}
+
+ossim_uint32 ossimDenseCorrelator::getGridSpacing() const
+{
+   return m_gridSpacing;
+}
+
+void ossimDenseCorrelator::setMinCorrelation(ossim_float64 minCorrel)
+{
+   m_minCorrelation = minCorrel;
+}
+
+ossim_float64 ossimDenseCorrelator::getMinCorrelation() const
+{
+   return m_minCorrelation;
+}
+
+void ossimDenseCorrelator::setFftTemplateRadius(ossim_uint32 radius)
+{
+   m_fftTemplateRadius = radius;
+}
+
+ossim_uint32 ossimDenseCorrelator::getFftTemplateRadius() const
+{
+   return m_fftTemplateRadius;
+}
+
+void ossimDenseCorrelator::setTileNodes(ossim_uint32 nodes)
+{
+   m_tileNodes = ossim::max<ossim_uint32>(nodes, 1);
+}
+
+void ossimDenseCorrelator::setNumberOfThreads(ossim_uint32 threads)
+{
+   m_numberOfThreads = threads;
+}
+
+const ossimIpt& ossimDenseCorrelator::getGridSize() const
+{
+   return m_gridSize;
+}
+
+const ossimIpt& ossimDenseCorrelator::getGridOrigin() const
+{
+   return m_gridOrigin;
+}
+
+const std::vector<ossim_float32>& ossimDenseCorrelator::getDx() const
+{
+   return m_dx;
+}
+
+const std::vector<ossim_float32>& ossimDenseCorrelator::getDy() const
+{
+   return m_dy;
+}
+
+const std::vector<ossim_float32>& ossimDenseCorrelator::getScore() const
+{
+   return m_score;
+}
+
+bool ossimDenseCorrelator::correlate(ossimImageSource* master,
+                                     ossimImageSource* slave,
+                                     const ossimIrect& region,
+                                     ossim_uint32 band)
+{
+   m_gridSize = ossimIpt(0, 0);
+   m_dx.clear();
+   m_dy.clear();
+   m_score.clear();
+
+   if ( !master || !slave || region.hasNans() )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimDenseCorrelator::correlate WARNING: missing input or region.\n";
+      return false;
+   }
+   if ( (band >= master->getNumberOfOutputBands()) || (band >= slave->getNumberOfOutputBands()) )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimDenseCorrelator::correlate WARNING: band " << band
+         << " is not in both inputs.\n";
+      return false;
+   }
+
+   m_master = master;
+   m_slave  = slave;
+   m_band   = band;
+   m_gridOrigin = region.ul();
+   m_gridSize.x = (region.width()  - 1) / m_gridSpacing + 1;
+   m_gridSize.y = (region.height() - 1) / m_gridSpacing + 1;
+
+   const ossim_uint32 NODES = m_gridSize.x * m_gridSize.y;
+   m_dx.assign( NODES, ossim::nan() );
+   m_dy.assign( NODES, ossim::nan() );
+   m_score.assign( NODES, ossim::nan() );
+
+   const ossim_uint32 TILES_X = (m_gridSize.x + m_tileNodes - 1) / m_tileNodes;
+   const ossim_uint32 TILES_Y = (m_gridSize.y + m_tileNodes - 1) / m_tileNodes;
+   const ossim_uint32 TILES = TILES_X * TILES_Y;
+   const ossim_uint32 THREADS = m_numberOfThreads ? m_numberOfThreads :
+                                ossim::getNumberOfThreads();
+   const ossim_uint32 JOBS = ossim::max<ossim_uint32>(
+      1, ossim::min<ossim_uint32>( THREADS, TILES ) );
+
+   ossimRefPtr<ossimDenseCorrelatorBatch> batch = new ossimDenseCorrelatorBatch(TILES, JOBS);
+   std::vector< ossimRefPtr<ossimDenseCorrelatorJob> > jobs;
+   for ( ossim_uint32 i = 0; i < JOBS; ++i )
+   {
+      jobs.push_back( new ossimDenseCorrelatorJob( this, TILES_X, batch.get() ) );
+   }
+   if ( JOBS == 1 )
+   {
+      jobs[0]->start();
+   }
+   else
+   {
+      ossimRefPtr<ossimJobMultiThreadQueue> queue = new ossimJobMultiThreadQueue(0, JOBS);
+      for ( ossim_uint32 i = 0; i < JOBS; ++i )
+      {
+         queue->getJobQueue()->add(jobs[i].get(), false);
+      }
+      batch->wait();
+   }
+
+   m_master = 0;
+   m_slave  = 0;
+   return true;
+}
+
+void ossimDenseCorrelator::correlateTile(ossim_uint32 tileX, ossim_uint32 tileY)
+{
+   const ossim_uint32 I0 = tileX * m_tileNodes;
+   const ossim_uint32 J0 = tileY * m_tileNodes;
+   const ossim_uint32 I1 = ossim::min<ossim_uint32>( I0 + m_tileNodes, m_gridSize.x );
+   const ossim_uint32 J1 = ossim::min<ossim_uint32>( J0 + m_tileNodes, m_gridSize.y );
+   if ( (I0 >= I1) || (J0 >= J1) )
+   {
+      return;
+   }
+
+   const ossim_int32 TR = (ossim_int32)m_templateRadius;
+   const ossim_int32 HALO = (ossim_int32)(m_templateRadius + m_searchRadius);
+   const ossimIpt FIRST( m_gridOrigin.x + I0*m_gridSpacing, m_gridOrigin.y + J0*m_gridSpacing );
+   const ossimIpt LAST( m_gridOrigin.x + (I1 - 1)*m_gridSpacing,
+                        m_gridOrigin.y + (J1 - 1)*m_gridSpacing );
+   const ossimIrect MASTER_RECT( FIRST.x - TR, FIRST.y - TR, LAST.x + TR, LAST.y + TR );
+   const ossimIrect SLAVE_RECT( FIRST.x - HALO, FIRST.y - HALO, LAST.x + HALO, LAST.y + HALO );
+
+   std::vector<ossim_float32> masterBuf;
+   std::vector<ossim_float32> slaveBuf;
+   {
+      // Sources and their tiles are not thread safe; copy under the lock.
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_readMutex);
+      readBand( m_master, MASTER_RECT, m_band, masterBuf );
+      readBand( m_slave, SLAVE_RECT, m_band, slaveBuf );
+   }
+
+   const ossim_uint32 MW = MASTER_RECT.width();
+   const ossim_uint32 SW = SLAVE_RECT.width();
+   std::vector<double> sum;
+   std::vector<double> sum2;
+   std::vector<double> nulls;
+   buildSums( &slaveBuf.front(), SW, SLAVE_RECT.height(), sum, sum2, nulls );
+
+   const ossim_uint32 T = 2*m_templateRadius + 1;
+   const bool USE_FFT = m_fftTemplateRadius && (m_templateRadius >= m_fftTemplateRadius);
+   std::vector<ossim_float32> tmpl(T*T);
+
+   for ( ossim_uint32 j = J0; j < J1; ++j )
+   {
+      for ( ossim_uint32 i = I0; i < I1; ++i )
+      {
+         // Node's template and search area corners within the tile buffers:
+         const ossim_uint32 X = (i - I0)*m_gridSpacing;
+         const ossim_uint32 Y = (j - J0)*m_gridSpacing;
+         for ( ossim_uint32 v = 0; v < T; ++v )
+         {
+            std::copy( &masterBuf[(Y + v)*MW + X], &masterBuf[(Y + v)*MW + X] + T, &tmpl[v*T] );
+         }
+
+         ossimDenseCorrelatorSums sums;
+         sums.m_stride = SW + 1;
+         sums.m_sum    = &sum[Y*sums.m_stride + X];
+         sums.m_sum2   = &sum2[Y*sums.m_stride + X];
+         sums.m_nulls  = &nulls[Y*sums.m_stride + X];
+
+         ossim_float64 dx;
+         ossim_float64 dy;
+         ossim_float64 score;
+         if ( matchNode( &tmpl.front(), m_templateRadius, &slaveBuf[Y*SW + X], SW, sums,
+                         m_searchRadius, USE_FFT, dx, dy, score ) &&
+              (score >= m_minCorrelation) )
+         {
+            const ossim_uint32 NODE = j*m_gridSize.x + i;
+            m_dx[NODE]    = (ossim_float32)dx;
+            m_dy[NODE]    = (ossim_float32)dy;
+            m_score[NODE] = (ossim_float32)score;
+         }
+      }
+   }
+}
+
+bool ossimDenseCorrelator::matchTemplate(const ossim_float32* tmpl,
+                                         ossim_uint32 tr,
+                                         const ossim_float32* search,
+                                         ossim_uint32 sr,
+                                         bool useFft,
+                                         ossim_float64& dx,
+                                         ossim_float64& dy,
+                                         ossim_float64& score)
+{
+   if ( !tmpl || !search || !tr )
+   {
+      return false;
+   }
+   const ossim_uint32 S = 2*(tr + sr) + 1;
+   std::vector<double> sum;
+   std::vector<double> sum2;
+   std::vector<double> nulls;
+   buildSums( search, S, S, sum, sum2, nulls );
+
+   ossimDenseCorrelatorSums sums;
+   sums.m_sum    = &sum.front();
+   sums.m_sum2   = &sum2.front();
+   sums.m_nulls  = &nulls.front();
+   sums.m_stride = S + 1;
+   return matchNode( tmpl, tr, search, S, sums, sr, useFft, dx, dy, score );
+}
@@ -10,13 +10,16 @@
 //*************************************************************************
 // $Id: ossimEquationCombiner.cpp 23407 2015-07-06 15:59:23Z okramer $
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <sstream>
 using namespace std;
 
 #include <ossim/imaging/ossimEquationCombiner.h>
 #include <ossim/imaging/ossimCastTileSourceFilter.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageDataKernels.h>
 #include <ossim/imaging/ossimConvolutionSource.h>
 #include <ossim/imaging/ossimSubImageTileSource.h>
 #include <ossim/base/ossimStringProperty.h>
@@ -375,6 +378,189 @@ public:
       }
 };
 
+namespace
+{
+   /** Copies the second operand: combines an empty image with another. */
+   class ossimBinaryOpSecond : public ossimEquationCombiner::ossimBinaryOp
+   {
+   public:
+      virtual double apply(double /* v1 */, double v2)const
+         {
+            return v2;
+         }
+   };
+
+   //---
+   // One band of a binary operation of the compiled equation.  a (b) is null when the first
+   // (second) operand is the constant ca (cb).  With testA (testB) set, pixels where a (b)
+   // is null keep the value of the image operand, a when both are images.
+   //---
+   struct ossimEquBinaryBand
+   {
+      double*       out;
+      const double* a;
+      const double* b;
+      double        ca;
+      double        cb;
+      bool          testA;
+      bool          testB;
+      double        npA;
+      double        npB;
+   };
+
+   // Op::apply is called qualified so the op classes inline into the pixel loops.
+   template <class Op>
+   void binaryBand(const Op& op, const ossimEquBinaryBand& p, ossim_uint32 size)
+   {
+      double* out = p.out;
+      if(p.a && p.b)
+      {
+         const double* a = p.a;
+         const double* b = p.b;
+         if(!p.testA && !p.testB)
+         {
+            for(ossim_uint32 i = 0; i < size; ++i)
+            {
+               out[i] = op.Op::apply(a[i], b[i]);
+            }
+         }
+         else
+         {
+            for(ossim_uint32 i = 0; i < size; ++i)
+            {
+               if((!p.testA || (a[i] != p.npA)) && (!p.testB || (b[i] != p.npB)))
+               {
+                  out[i] = op.Op::apply(a[i], b[i]);
+               }
+               else
+               {
+                  out[i] = a[i];
+               }
+            }
+         }
+      }
+      else if(p.a)
+      {
+         const double* a = p.a;
+         const double  c = p.cb;
+         if(!p.testA)
+         {
+            for(ossim_uint32 i = 0; i < size; ++i)
+            {
+               out[i] = op.Op::apply(a[i], c);
+            }
+         }
+         else
+         {
+            for(ossim_uint32 i = 0; i < size; ++i)
+            {
+               out[i] = (a[i] != p.npA) ? op.Op::apply(a[i], c) : a[i];
+            }
+         }
+      }
+      else if(p.b)
+      {
+         const double* b = p.b;
+         const double  c = p.ca;
+         if(!p.testB)
+         {
+            for(ossim_uint32 i = 0; i < size; ++i)
+            {
+               out[i] = op.Op::apply(c, b[i]);
+            }
+         }
+         else
+         {
+            for(ossim_uint32 i = 0; i < size; ++i)
+            {
+               out[i] = (b[i] != p.npB) ? op.Op::apply(c, b[i]) : b[i];
+            }
+         }
+      }
+      else
+      {
+         *out = op.Op::apply(p.ca, p.cb);
+      }
+   }
+
+   bool applyBinaryBand(int token, const ossimEquBinaryBand& p, ossim_uint32 size)
+   {
+      switch(token)
+      {
+         case OSSIM_EQU_TOKEN_PLUS:            binaryBand(ossimBinaryOpAdd(), p, size); break;
+         case OSSIM_EQU_TOKEN_MINUS:           binaryBand(ossimBinaryOpSub(), p, size); break;
+         case OSSIM_EQU_TOKEN_MULT:            binaryBand(ossimBinaryOpMul(), p, size); break;
+         case OSSIM_EQU_TOKEN_DIV:             binaryBand(ossimBinaryOpDiv(), p, size); break;
+         case OSSIM_EQU_TOKEN_MOD:             binaryBand(ossimBinaryOpMod(), p, size); break;
+         case OSSIM_EQU_TOKEN_POWER:           binaryBand(ossimBinaryOpPow(), p, size); break;
+         case OSSIM_EQU_TOKEN_XOR:             binaryBand(ossimBinaryOpXor(), p, size); break;
+         case OSSIM_EQU_TOKEN_AMPERSAND:       binaryBand(ossimBinaryOpAnd(), p, size); break;
+         case OSSIM_EQU_TOKEN_OR_BAR:          binaryBand(ossimBinaryOpOr(), p, size); break;
+         case OSSIM_EQU_TOKEN_MIN:             binaryBand(ossimBinaryOpMin(), p, size); break;
+         case OSSIM_EQU_TOKEN_MAX:             binaryBand(ossimBinaryOpMax(), p, size); break;
+         case OSSIM_EQU_TOKEN_BEQUAL:          binaryBand(ossimBinaryOpEqual(), p, size); break;
+         case OSSIM_EQU_TOKEN_BGREATER:        binaryBand(ossimBinaryOpGreater(), p, size); break;
+         case OSSIM_EQU_TOKEN_BGREATEROREQUAL: binaryBand(ossimBinaryOpGreaterOrEqual(), p, size); break;
+         case OSSIM_EQU_TOKEN_BLESS:           binaryBand(ossimBinaryOpLess(), p, size); break;
+         case OSSIM_EQU_TOKEN_BLESSOREQUAL:    binaryBand(ossimBinaryOpLessOrEqual(), p, size); break;
+         case OSSIM_EQU_TOKEN_BDIFFERENT:      binaryBand(ossimBinaryOpDifferent(), p, size); break;
+         default: return false;
+      }
+      return true;
+   }
+
+   // With test set, pixels equal to np keep their value.
+   template <class Op>
+   void unaryBand(const Op& op, double* out, const double* in, ossim_uint32 size,
+                  bool test, double np)
+   {
+      if(!test)
+      {
+         for(ossim_uint32 i = 0; i < size; ++i)
+         {
+            out[i] = op.Op::apply(in[i]);
+         }
+      }
+      else
+      {
+         for(ossim_uint32 i = 0; i < size; ++i)
+         {
+            out[i] = (in[i] != np) ? op.Op::apply(in[i]) : in[i];
+         }
+      }
+   }
+
+   bool applyUnaryBand(int token, double* out, const double* in, ossim_uint32 size,
+                       bool test, double np)
+   {
+      switch(token)
+      {
+         case OSSIM_EQU_TOKEN_MINUS: unaryBand(ossimUnaryOpNeg(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_TILDE: unaryBand(ossimUnaryOpOnesComplement(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_ABS:   unaryBand(ossimUnaryOpAbs(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_SIN:   unaryBand(ossimUnaryOpSin(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_SIND:  unaryBand(ossimUnaryOpSind(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_ASIN:  unaryBand(ossimUnaryOpASin(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_ASIND: unaryBand(ossimUnaryOpASind(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_COS:   unaryBand(ossimUnaryOpCos(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_COSD:  unaryBand(ossimUnaryOpCosd(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_ACOS:  unaryBand(ossimUnaryOpACos(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_ACOSD: unaryBand(ossimUnaryOpACosd(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_TAN:   unaryBand(ossimUnaryOpTan(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_TAND:  unaryBand(ossimUnaryOpTand(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_ATAN:  unaryBand(ossimUnaryOpATan(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_ATAND: unaryBand(ossimUnaryOpATand(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_LOG:   unaryBand(ossimUnaryOpLog(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_LOG10: unaryBand(ossimUnaryOpLog10(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_SQRT:  unaryBand(ossimUnaryOpSqrt(), out, in, size, test, np); break;
+         case OSSIM_EQU_TOKEN_EXP:   unaryBand(ossimUnaryOpExp(), out, in, size, test, np); break;
+         default: return false;
+      }
+      return true;
+   }
+}
+
+
 
 ossimEquationCombiner::ossimEquationCombiner()
    :ossimImageCombiner(),
@@ -385,7 +571,9 @@ ossimEquationCombiner::ossimEquationCombiner()
     theCastFilter(NULL),
     theCastOutputFilter(NULL),
     theCurrentId(0),
-    theCurrentResLevel(0)
+    theCurrentResLevel(0),
+    theProgramDirty(true),
+    theProgramValid(false)
 {
    theLexer      = new ossimEquTokenizer;
    theCastFilter = new ossimCastTileSourceFilter;
@@ -401,7 +589,9 @@ ossimEquationCombiner::ossimEquationCombiner(ossimConnectableObject::Connectable
     theCastFilter(NULL),
     theCastOutputFilter(NULL),
     theCurrentId(0),
-    theCurrentResLevel(0)
+    theCurrentResLevel(0),
+    theProgramDirty(true),
+    theProgramValid(false)
 {
    theLexer      = new ossimEquTokenizer;
    theCastFilter = new ossimCastTileSourceFilter;
@@ -525,8 +715,22 @@ ossimRefPtr<ossimImageData> ossimEquationCombiner::getTile(
          theTile->makeBlank();
       }
       theCurrentResLevel = resLevel;
-      
-      ossimRefPtr<ossimImageData> outputTile =  parseEquation();
+
+      if(theProgramDirty)
+      {
+         compileEquation();
+      }
+
+      ossimRefPtr<ossimImageData> outputTile;
+      if(theProgramValid && runProgram())
+      {
+         theTile->validate();
+         outputTile = theTile;
+      }
+      else
+      {
+         outputTile = parseEquation();
+      }
 
       if(theCastOutputFilter.valid())
       {
@@ -583,6 +787,7 @@ void ossimEquationCombiner::setProperty(ossimRefPtr<ossimProperty> property)
    if(property->getName() == "Equation")
    {
       theEquation = property->valueToString();
+      theProgramDirty = true;
    }
    else if(property->getName() == "Output scalar type")
    {
@@ -654,6 +859,8 @@ void ossimEquationCombiner::initialize()
    {
       theCastOutputFilter->initialize();
    }
+
+   compileEquation();
 }
 
 void ossimEquationCombiner::assignValue()
@@ -2844,6 +3051,796 @@ ossimRefPtr<ossimImageData> ossimEquationCombiner::parseEquation()
    return theTile;
 }    
 
+bool ossimEquationCombiner::compileEquation()
+{
+   theProgramDirty = false;
+   theProgramValid = false;
+   theProgram.clear();
+   theProgramInputs.clear();
+
+   if(theEquation == "")
+   {
+      return false;
+   }
+
+   istringstream inS(theEquation.c_str());
+   theLexer->switch_streams(&inS, &ossimNotify(ossimNotifyLevel_WARN));
+
+   theCurrentId = theLexer->yylex();
+
+   // A single expression must take every token; anything else is left to parseEquation().
+   if(!compileExpression() || theCurrentId)
+   {
+      theProgram.clear();
+      theProgramInputs.clear();
+      return false;
+   }
+
+   ossim_uint32 depth    = 0;
+   ossim_uint32 maxDepth = 0;
+   for(ossim_uint32 i = 0; i < theProgram.size(); ++i)
+   {
+      const int code = theProgram[i].code;
+      if((code == OSSIM_EQU_PUSH_CONSTANT) || (code == OSSIM_EQU_PUSH_INPUT))
+      {
+         ++depth;
+         maxDepth = std::max(maxDepth, depth);
+      }
+      else if(code == OSSIM_EQU_BINARY_OP)
+      {
+         --depth;
+      }
+   }
+   theRegisters.resize(maxDepth);
+   theInputs.resize(theProgramInputs.size());
+   theProgramValid = true;
+
+   return true;
+}
+
+bool ossimEquationCombiner::compileExpression()
+{
+   return compileTerm() && compileRestOfExp();
+}
+
+bool ossimEquationCombiner::compileRestOfExp()
+{
+   while((theCurrentId == OSSIM_EQU_TOKEN_PLUS) ||
+         (theCurrentId == OSSIM_EQU_TOKEN_MINUS))
+   {
+      const int token = theCurrentId;
+      theCurrentId = theLexer->yylex();
+      if(!compileTerm())
+      {
+         return false;
+      }
+      emitBinaryOp(token);
+   }
+   return true;
+}
+
+bool ossimEquationCombiner::compileTerm()
+{
+   return compileFactor() && compileRestOfTerm();
+}
+
+bool ossimEquationCombiner::compileRestOfTerm()
+{
+   bool done = false;
+   while(!done)
+   {
+      const int token = theCurrentId;
+      switch(token)
+      {
+         case OSSIM_EQU_TOKEN_MULT:
+         case OSSIM_EQU_TOKEN_DIV:
+         case OSSIM_EQU_TOKEN_XOR:
+         case OSSIM_EQU_TOKEN_AMPERSAND:
+         case OSSIM_EQU_TOKEN_OR_BAR:
+         case OSSIM_EQU_TOKEN_MOD:
+         case OSSIM_EQU_TOKEN_POWER:
+         case OSSIM_EQU_TOKEN_BEQUAL:
+         case OSSIM_EQU_TOKEN_BGREATER:
+         case OSSIM_EQU_TOKEN_BGREATEROREQUAL:
+         case OSSIM_EQU_TOKEN_BLESS:
+         case OSSIM_EQU_TOKEN_BLESSOREQUAL:
+         case OSSIM_EQU_TOKEN_BDIFFERENT:
+         {
+            theCurrentId = theLexer->yylex();
+            if(!compileFactor())
+            {
+               return false;
+            }
+            emitBinaryOp(token);
+            break;
+         }
+         default:
+         {
+            done = true;
+         }
+      }
+   }
+   return true;
+}
+
+bool ossimEquationCombiner::compileFactor()
+{
+   switch(theCurrentId)
+   {
+      case OSSIM_EQU_TOKEN_CONSTANT:
+      {
+         emitInstruction(OSSIM_EQU_PUSH_CONSTANT, 0, atof(theLexer->YYText()));
+         theCurrentId = theLexer->yylex();
+         return true;
+      }
+      case OSSIM_EQU_TOKEN_PI:
+      {
+         emitInstruction(OSSIM_EQU_PUSH_CONSTANT, 0, M_PI);
+         theCurrentId = theLexer->yylex();
+         return true;
+      }
+      case OSSIM_EQU_TOKEN_IMAGE_VARIABLE:
+      {
+         theCurrentId = theLexer->yylex();
+         if(theCurrentId != OSSIM_EQU_TOKEN_LEFT_ARRAY_BRACKET)
+         {
+            return false;
+         }
+         theCurrentId = theLexer->yylex();
+         if(!compileExpression() || !isConstant(0) ||
+            (theCurrentId != OSSIM_EQU_TOKEN_RIGHT_ARRAY_BRACKET))
+         {
+            return false;
+         }
+         theCurrentId = theLexer->yylex();
+
+         // The input is fetched once per tile, however often the equation refers to it.
+         ossimEquInstruction& instruction = theProgram.back();
+         const ossim_uint32 index = (ossim_uint32)instruction.value[0];
+         ossim_uint32 slot = 0;
+         while((slot < theProgramInputs.size()) && (theProgramInputs[slot] != index))
+         {
+            ++slot;
+         }
+         if(slot == theProgramInputs.size())
+         {
+            theProgramInputs.push_back(index);
+         }
+         instruction.code  = OSSIM_EQU_PUSH_INPUT;
+         instruction.token = (int)slot;
+         return true;
+      }
+      case OSSIM_EQU_TOKEN_LEFT_PAREN:
+      {
+         theCurrentId = theLexer->yylex();
+         if(!compileExpression() || (theCurrentId != OSSIM_EQU_TOKEN_RIGHT_PAREN))
+         {
+            return false;
+         }
+         theCurrentId = theLexer->yylex();
+         return true;
+      }
+      case OSSIM_EQU_TOKEN_MINUS:
+      case OSSIM_EQU_TOKEN_TILDE:
+      {
+         return compileUnaryFactor();
+      }
+   }
+
+   return compileStdFuncs();
+}
+
+bool ossimEquationCombiner::compileUnaryFactor()
+{
+   const int token = theCurrentId;
+   theCurrentId = theLexer->yylex();
+   if(!compileFactor())
+   {
+      return false;
+   }
+   emitUnaryOp(token);
+   return true;
+}
+
+bool ossimEquationCombiner::compileStdFuncs()
+{
+   const int token = theCurrentId;
+
+   switch(token)
+   {
+      case OSSIM_EQU_TOKEN_CLAMP:
+      {
+         // clamp(image, min, max)
+         theCurrentId = theLexer->yylex();
+         ossim_uint32 argCount = 0;
+         if(!compileArgList(argCount) || (argCount != 3) ||
+            !isConstant(0) || !isConstant(1) || isConstant(2))
+         {
+            return false;
+         }
+         double maxValue = theProgram.back().value[0];
+         theProgram.pop_back();
+         double minValue = theProgram.back().value[0];
+         theProgram.pop_back();
+         if(minValue > maxValue)
+         {
+            std::swap(minValue, maxValue);
+         }
+         emitInstruction(OSSIM_EQU_CLAMP, token, minValue, maxValue);
+         return true;
+      }
+      case OSSIM_EQU_TOKEN_BAND:
+      {
+         // band(image, number)
+         theCurrentId = theLexer->yylex();
+         ossim_uint32 argCount = 0;
+         if(!compileArgList(argCount) || (argCount != 2) || !isConstant(0) || isConstant(1))
+         {
+            return false;
+         }
+         const double band = theProgram.back().value[0];
+         theProgram.pop_back();
+         emitInstruction(OSSIM_EQU_SELECT_BAND, token, band);
+         return true;
+      }
+      case OSSIM_EQU_TOKEN_MAX:
+      case OSSIM_EQU_TOKEN_MIN:
+      {
+         theCurrentId = theLexer->yylex();
+         if(theCurrentId != OSSIM_EQU_TOKEN_LEFT_PAREN)
+         {
+            return false;
+         }
+         theCurrentId = theLexer->yylex();
+
+         ossim_uint32 argCount = 0;
+         bool done = false;
+         while(!done)
+         {
+            if(!compileExpression())
+            {
+               return false;
+            }
+            ++argCount;
+            if(theCurrentId == OSSIM_EQU_TOKEN_RIGHT_PAREN)
+            {
+               theCurrentId = theLexer->yylex();
+               done = true;
+            }
+            else if(theCurrentId == OSSIM_EQU_TOKEN_COMMA)
+            {
+               theCurrentId = theLexer->yylex();
+            }
+            else
+            {
+               return false;
+            }
+         }
+         if(argCount < 2)
+         {
+            return false;
+         }
+
+         // Folded from the last argument as parseStdFuncs() does: min(a, min(b, c)).
+         for(ossim_uint32 i = 1; i < argCount; ++i)
+         {
+            emitBinaryOp(token);
+         }
+         return true;
+      }
+      case OSSIM_EQU_TOKEN_ABS:
+      case OSSIM_EQU_TOKEN_SIN:
+      case OSSIM_EQU_TOKEN_SIND:
+      case OSSIM_EQU_TOKEN_ASIN:
+      case OSSIM_EQU_TOKEN_ASIND:
+      case OSSIM_EQU_TOKEN_COS:
+      case OSSIM_EQU_TOKEN_COSD:
+      case OSSIM_EQU_TOKEN_ACOS:
+      case OSSIM_EQU_TOKEN_ACOSD:
+      case OSSIM_EQU_TOKEN_TAN:
+      case OSSIM_EQU_TOKEN_TAND:
+      case OSSIM_EQU_TOKEN_ATAN:
+      case OSSIM_EQU_TOKEN_ATAND:
+      case OSSIM_EQU_TOKEN_LOG:
+      case OSSIM_EQU_TOKEN_LOG10:
+      case OSSIM_EQU_TOKEN_SQRT:
+      case OSSIM_EQU_TOKEN_EXP:
+      {
+         return compileUnaryFunc(token);
+      }
+   }
+
+   // assign_band, conv, blurr and shift are only run by parseEquation().
+   return false;
+}
+
+bool ossimEquationCombiner::compileUnaryFunc(int token)
+{
+   theCurrentId = theLexer->yylex();
+   if(theCurrentId != OSSIM_EQU_TOKEN_LEFT_PAREN)
+   {
+      return false;
+   }
+   theCurrentId = theLexer->yylex();
+   if(!compileExpression() || (theCurrentId != OSSIM_EQU_TOKEN_RIGHT_PAREN))
+   {
+      return false;
+   }
+   theCurrentId = theLexer->yylex();
+   emitUnaryOp(token);
+   return true;
+}
+
+bool ossimEquationCombiner::compileArgList(ossim_uint32& argCount)
+{
+   if(theCurrentId != OSSIM_EQU_TOKEN_LEFT_PAREN)
+   {
+      return false;
+   }
+   theCurrentId = theLexer->yylex();
+   do
+   {
+      if(!compileExpression())
+      {
+         return false;
+      }
+      ++argCount;
+      if(theCurrentId == OSSIM_EQU_TOKEN_COMMA)
+      {
+         theCurrentId = theLexer->yylex();
+      }
+      else if(theCurrentId != OSSIM_EQU_TOKEN_RIGHT_PAREN)
+      {
+         return false;
+      }
+   }while(theCurrentId != OSSIM_EQU_TOKEN_RIGHT_PAREN);
+
+   theCurrentId = theLexer->yylex(); // skip past right parenthesis
+   return true;
+}
+
+void ossimEquationCombiner::emitInstruction(int code, int token, double v1, double v2)
+{
+   ossimEquInstruction instruction;
+   instruction.code     = code;
+   instruction.token    = token;
+   instruction.value[0] = v1;
+   instruction.value[1] = v2;
+   theProgram.push_back(instruction);
+}
+
+void ossimEquationCombiner::emitBinaryOp(int token)
+{
+   //---
+   // A constant operand is a single push, so two constants on top of the stack are the last
+   // two instructions and are folded into one.
+   //---
+   if(isConstant(0) && isConstant(1))
+   {
+      double result = 0.0;
+      ossimEquBinaryBand p;
+      p.out   = &result;
+      p.a     = 0;
+      p.b     = 0;
+      p.ca    = theProgram[theProgram.size()-2].value[0];
+      p.cb    = theProgram.back().value[0];
+      p.testA = false;
+      p.testB = false;
+      p.npA   = 0.0;
+      p.npB   = 0.0;
+      applyBinaryBand(token, p, 1);
+      theProgram.pop_back();
+      theProgram.back().value[0] = result;
+   }
+   else
+   {
+      emitInstruction(OSSIM_EQU_BINARY_OP, token);
+   }
+}
+
+void ossimEquationCombiner::emitUnaryOp(int token)
+{
+   if(isConstant(0))
+   {
+      double& value = theProgram.back().value[0];
+      applyUnaryBand(token, &value, &value, 1, false, 0.0);
+   }
+   else
+   {
+      emitInstruction(OSSIM_EQU_UNARY_OP, token);
+   }
+}
+
+bool ossimEquationCombiner::isConstant(ossim_uint32 fromEnd) const
+{
+   return (fromEnd < theProgram.size()) &&
+      (theProgram[theProgram.size()-1-fromEnd].code == OSSIM_EQU_PUSH_CONSTANT);
+}
+
+bool ossimEquationCombiner::runProgram()
+{
+   const ossim_uint32 size = theTile->getWidth()*theTile->getHeight();
+
+   //---
+   // Fetch each input once.  The cast filter reuses its tile, so inputs are copied, but for a
+   // single input whose pixels are used in place.
+   //---
+   ossimRefPtr<ossimImageData> heldTile;
+   for(ossim_uint32 slot = 0; slot < theProgramInputs.size(); ++slot)
+   {
+      ossimRefPtr<ossimImageData> data = getImageData(theProgramInputs[slot]);
+      const ossimImageData* tile = data.get();
+      if(!tile || !tile->getBuf() || !tile->getNumberOfBands() ||
+         (tile->getWidth()*tile->getHeight() != size))
+      {
+         return false;
+      }
+
+      ossimEquRegister& input = theInputs[slot];
+      const ossim_uint32 bands = tile->getNumberOfBands();
+      input.type   = OSSIM_EQU_IMAGE_DATA_TYPE;
+      input.status = tile->getDataObjectStatus();
+      input.nullPix.resize(bands);
+      for(ossim_uint32 band = 0; band < bands; ++band)
+      {
+         input.nullPix[band] = tile->getNullPix(band);
+      }
+      if(theProgramInputs.size() == 1)
+      {
+         heldTile   = data;
+         input.data = static_cast<const double*>(tile->getBuf());
+      }
+      else
+      {
+         input.buffer.resize(bands*size);
+         for(ossim_uint32 band = 0; band < bands; ++band)
+         {
+            const double* buf = static_cast<const double*>(tile->getBuf(band));
+            std::copy(buf, buf + size, input.buffer.begin() + band*size);
+         }
+         input.data = &input.buffer.front();
+      }
+   }
+
+   ossim_uint32 top = 0;
+   for(ossim_uint32 i = 0; i < theProgram.size(); ++i)
+   {
+      const ossimEquInstruction& instruction = theProgram[i];
+      switch(instruction.code)
+      {
+         case OSSIM_EQU_PUSH_CONSTANT:
+         {
+            ossimEquRegister& v = theRegisters[top++];
+            v.type        = OSSIM_EQU_DOUBLE_TYPE;
+            v.doubleValue = instruction.value[0];
+            break;
+         }
+         case OSSIM_EQU_PUSH_INPUT:
+         {
+            ossimEquRegister& v = theRegisters[top++];
+            const ossimEquRegister& input = theInputs[instruction.token];
+            v.type    = OSSIM_EQU_IMAGE_DATA_TYPE;
+            v.data    = input.data;
+            v.nullPix = input.nullPix;
+            v.status  = input.status;
+            break;
+         }
+         case OSSIM_EQU_BINARY_OP:
+         {
+            applyBinaryOp(instruction.token, theRegisters[top-2], theRegisters[top-1], size);
+            --top;
+            break;
+         }
+         case OSSIM_EQU_UNARY_OP:
+         {
+            applyUnaryOp(instruction.token, theRegisters[top-1], size);
+            break;
+         }
+         case OSSIM_EQU_SELECT_BAND:
+         {
+            if(!selectBand(theRegisters[top-1], (ossim_uint32)instruction.value[0], size))
+            {
+               return false;
+            }
+            break;
+         }
+         case OSSIM_EQU_CLAMP:
+         {
+            clampRegister(theRegisters[top-1], instruction.value[0], instruction.value[1], size);
+            break;
+         }
+      }
+   }
+
+   assignRegister(theRegisters[0]);
+
+   return true;
+}
+
+double* ossimEquationCombiner::getWritableBuffer(ossimEquRegister& v,
+                                                 ossim_uint32 size,
+                                                 bool keepPixels)
+{
+   if(!v.buffer.empty() && (v.data == &v.buffer.front()))
+   {
+      return &v.buffer.front();
+   }
+
+   // Still the pixels of an input: sized once, then reused from tile to tile.
+   const ossim_uint32 count = (ossim_uint32)v.nullPix.size()*size;
+   if(v.buffer.size() < count)
+   {
+      v.buffer.resize(count);
+   }
+   if(keepPixels)
+   {
+      std::copy(v.data, v.data + count, v.buffer.begin());
+   }
+   return &v.buffer.front();
+}
+
+void ossimEquationCombiner::applyBinaryOp(int token,
+                                          ossimEquRegister& v1,
+                                          ossimEquRegister& v2,
+                                          ossim_uint32 size)
+{
+   // Null handling follows applyOp(); the result is left in v1.
+   ossimEquBinaryBand p;
+   p.out   = 0;
+   p.a     = 0;
+   p.b     = 0;
+   p.ca    = v1.doubleValue;
+   p.cb    = v2.doubleValue;
+   p.testA = false;
+   p.testB = false;
+   p.npA   = 0.0;
+   p.npB   = 0.0;
+
+   if(v1.type == OSSIM_EQU_DOUBLE_TYPE)
+   {
+      if(v2.type == OSSIM_EQU_DOUBLE_TYPE)
+      {
+         double result = 0.0;
+         p.out = &result;
+         applyBinaryBand(token, p, 1);
+         v1.doubleValue = result;
+         return;
+      }
+
+      if((v2.status == OSSIM_FULL) || (v2.status == OSSIM_PARTIAL))
+      {
+         const double* in  = v2.data;
+         double*       out = getWritableBuffer(v2, size, false);
+         p.testB = (v2.status == OSSIM_PARTIAL);
+         for(ossim_uint32 band = 0; band < v2.nullPix.size(); ++band)
+         {
+            p.out = out + band*size;
+            p.b   = in + band*size;
+            p.npB = v2.nullPix[band];
+            applyBinaryBand(token, p, size);
+         }
+         v2.data = out;
+      }
+
+      // The image is the result.  Vectors swap their storage, so data stays valid.
+      std::swap(v1.type, v2.type);
+      std::swap(v1.data, v2.data);
+      std::swap(v1.status, v2.status);
+      v1.buffer.swap(v2.buffer);
+      v1.nullPix.swap(v2.nullPix);
+      return;
+   }
+
+   if(v2.type == OSSIM_EQU_DOUBLE_TYPE)
+   {
+      if((v1.status == OSSIM_FULL) || (v1.status == OSSIM_PARTIAL))
+      {
+         const double* in  = v1.data;
+         double*       out = getWritableBuffer(v1, size, false);
+         p.testA = (v1.status == OSSIM_PARTIAL);
+         for(ossim_uint32 band = 0; band < v1.nullPix.size(); ++band)
+         {
+            p.out = out + band*size;
+            p.a   = in + band*size;
+            p.npA = v1.nullPix[band];
+            applyBinaryBand(token, p, size);
+         }
+         v1.data = out;
+      }
+      return;
+   }
+
+   const ossimDataObjectStatus status1 = v1.status;
+   const ossimDataObjectStatus status2 = v2.status;
+   const bool valid1 = (status1 == OSSIM_FULL) || (status1 == OSSIM_PARTIAL);
+   const bool valid2 = (status2 == OSSIM_FULL) || (status2 == OSSIM_PARTIAL);
+   const bool copy   = (status1 == OSSIM_EMPTY);
+
+   const ossim_uint32 bands1 = (ossim_uint32)v1.nullPix.size();
+   const ossim_uint32 bands2 = (ossim_uint32)v2.nullPix.size();
+
+   if(((copy || valid1) && valid2) && bands1 && bands2)
+   {
+      //---
+      // As in applyOp(), a v2 with fewer bands gives its last band to every band of v1, and
+      // a v1 with fewer bands has every band of v2 combined in turn into its last band.
+      //---
+      const bool    toLastBand = (bands1 < bands2);
+      const double* in  = v1.data;
+      double*       out = getWritableBuffer(v1, size, toLastBand);
+      if(toLastBand)
+      {
+         in = out;
+      }
+      p.testA = (status1 == OSSIM_PARTIAL);
+      p.testB = (status2 == OSSIM_PARTIAL);
+
+      const ossim_uint32 maxBands = std::max(bands1, bands2);
+      for(ossim_uint32 band = 0; band < maxBands; ++band)
+      {
+         const ossim_uint32 b1 = toLastBand ? bands1-1 : band;
+         const ossim_uint32 b2 = (bands2 < bands1) ? bands2-1 : band;
+         p.out = out + b1*size;
+         p.a   = in + b1*size;
+         p.b   = v2.data + b2*size;
+         p.npA = v1.nullPix[b1];
+         p.npB = v2.nullPix[b2];
+         if(copy)
+         {
+            binaryBand(ossimBinaryOpSecond(), p, size);
+         }
+         else
+         {
+            applyBinaryBand(token, p, size);
+         }
+      }
+      v1.data = out;
+   }
+
+   if(copy)
+   {
+      v1.status = status2;
+   }
+}
+
+void ossimEquationCombiner::applyUnaryOp(int token, ossimEquRegister& v, ossim_uint32 size)
+{
+   if(v.type == OSSIM_EQU_DOUBLE_TYPE)
+   {
+      applyUnaryBand(token, &v.doubleValue, &v.doubleValue, 1, false, 0.0);
+   }
+   else if((v.status == OSSIM_FULL) || (v.status == OSSIM_PARTIAL))
+   {
+      const bool    partial = (v.status == OSSIM_PARTIAL);
+      const double* in      = v.data;
+      double*       out     = getWritableBuffer(v, size, false);
+      for(ossim_uint32 band = 0; band < v.nullPix.size(); ++band)
+      {
+         applyUnaryBand(token, out + band*size, in + band*size, size, partial, v.nullPix[band]);
+      }
+      v.data = out;
+   }
+}
+
+bool ossimEquationCombiner::selectBand(ossimEquRegister& v, ossim_uint32 band, ossim_uint32 size)
+{
+   // As band(): the band past the last one is an empty image, beyond that an error.
+   const ossim_uint32 bands = (ossim_uint32)v.nullPix.size();
+   if((v.type != OSSIM_EQU_IMAGE_DATA_TYPE) || (band > bands))
+   {
+      return false;
+   }
+
+   const double np = (band < bands) ? v.nullPix[band] : ossim::defaultNull(OSSIM_FLOAT64);
+   const double* in = v.data + band*size;
+   if(v.buffer.size() < size)
+   {
+      v.buffer.resize(size);
+   }
+   double* out = &v.buffer.front();
+
+   if(band < bands)
+   {
+      if(in != out)
+      {
+         memmove(out, in, size*sizeof(double));
+      }
+      const ossim_uint32 nulls = ossim::countNull(static_cast<const double*>(out), size, np);
+      v.status = (nulls == size) ? OSSIM_EMPTY : (nulls ? OSSIM_PARTIAL : OSSIM_FULL);
+   }
+   else
+   {
+      std::fill(out, out + size, np);
+      v.status = OSSIM_EMPTY;
+   }
+   v.data = out;
+   v.nullPix.assign(1, np);
+
+   return true;
+}
+
+void ossimEquationCombiner::clampRegister(ossimEquRegister& v,
+                                          double minValue,
+                                          double maxValue,
+                                          ossim_uint32 size)
+{
+   if((v.type != OSSIM_EQU_IMAGE_DATA_TYPE) ||
+      ((v.status != OSSIM_FULL) && (v.status != OSSIM_PARTIAL)))
+   {
+      return;
+   }
+
+   const bool    partial = (v.status == OSSIM_PARTIAL);
+   const double* in      = v.data;
+   double*       out     = getWritableBuffer(v, size, false);
+   for(ossim_uint32 band = 0; band < v.nullPix.size(); ++band)
+   {
+      const double* inBuf  = in + band*size;
+      double*       outBuf = out + band*size;
+      const double  np     = v.nullPix[band];
+      for(ossim_uint32 offset = 0; offset < size; ++offset)
+      {
+         double p = inBuf[offset];
+         if(!partial || (p != np))
+         {
+            if(p < minValue) p = minValue;
+            else if(p > maxValue) p = maxValue;
+         }
+         outBuf[offset] = p;
+      }
+   }
+   v.data = out;
+}
+
+void ossimEquationCombiner::assignRegister(const ossimEquRegister& v)
+{
+   // Same as assignValue(): extra output bands repeat the last band of the result.
+   if(v.type == OSSIM_EQU_DOUBLE_TYPE)
+   {
+      double* buf = static_cast<double*>(theTile->getBuf());
+      if(buf)
+      {
+         std::fill(buf, buf + theTile->getSize(), v.doubleValue);
+      }
+      return;
+   }
+   if((v.status != OSSIM_FULL) && (v.status != OSSIM_PARTIAL))
+   {
+      return;
+   }
+
+   const bool         partial  = (v.status == OSSIM_PARTIAL);
+   const ossim_uint32 size     = theTile->getWidth()*theTile->getHeight();
+   const ossim_uint32 bands    = (ossim_uint32)v.nullPix.size();
+   const ossim_uint32 maxBands = theTile->getNumberOfBands();
+   const ossim_uint32 minBands = std::min(maxBands, bands);
+
+   for(ossim_uint32 band = 0; band < maxBands; ++band)
+   {
+      double* outBuf = static_cast<double*>(theTile->getBuf(band));
+      if(!outBuf)
+      {
+         continue;
+      }
+      const double* inBuf = v.data + ((band < minBands) ? band : minBands-1)*size;
+      if(partial)
+      {
+         const double np = (band < bands) ? v.nullPix[band] : ossim::defaultNull(OSSIM_FLOAT64);
+         for(ossim_uint32 offset = 0; offset < size; ++offset)
+         {
+            if(inBuf[offset] != np)
+            {
+               outBuf[offset] = inBuf[offset];
+            }
+         }
+      }
+      else
+      {
+         std::copy(inBuf, inBuf + size, outBuf);
+      }
+   }
+}
+
 bool ossimEquationCombiner::applyClamp(ossimImageData* &result,
                                        const vector<ossimEquValue>& argList)
 {
@@ -3563,6 +4560,7 @@ bool ossimEquationCombiner::loadState(const ossimKeywordlist& kwl,
    if(equ)
    {
       theEquation = equ;
+      theProgramDirty = true;
    }
 
    if(scalar)
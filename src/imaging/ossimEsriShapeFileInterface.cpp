@@ -1,3 +1,106 @@
 #include <ossim/imaging/ossimEsriShapeFileInterface.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimGeoPolygon.h>
+#include <ossim/base/ossimGrect.h>
+#include <ossim/imaging/ossimGeoAnnotationMultiPolyObject.h>
+#include <ossim/imaging/ossimGeoAnnotationPolyObject.h>
 
-RTTI_DEF(ossimEsriShapeFileInterface, "ossimEsriShapeFileInterface");
\ No newline at end of file
+RTTI_DEF(ossimEsriShapeFileInterface, "ossimEsriShapeFileInterface");
+
+namespace
+{
+   /** Grows the lat/lon bounds by the vertices; found is set by the first. */
+   void addVertices(const std::vector<ossimGpt>& vertices, bool& found,
+                    double& minLat, double& maxLat, double& minLon, double& maxLon)
+   {
+      std::vector<ossimGpt>::const_iterator i = vertices.begin();
+      while (i != vertices.end())
+      {
+         if ( !(*i).isLatNan() && !(*i).isLonNan() )
+         {
+            if (!found)
+            {
+               minLat = maxLat = (*i).lat;
+               minLon = maxLon = (*i).lon;
+               found = true;
+            }
+            else
+            {
+               minLat = ossim::min(minLat, (*i).lat);
+               maxLat = ossim::max(maxLat, (*i).lat);
+               minLon = ossim::min(minLon, (*i).lon);
+               maxLon = ossim::max(maxLon, (*i).lon);
+            }
+         }
+         ++i;
+      }
+   }
+}
+
+std::multimap<long, ossimAnnotationObject*>
+ossimEsriShapeFileInterface::getFeatureTableInRegion(const ossimGrect& region)
+{
+   std::multimap<long, ossimAnnotationObject*> features = getFeatureTable();
+   if (region.isLonLatNan())
+   {
+      return features;
+   }
+
+   std::multimap<long, ossimAnnotationObject*>::iterator it = features.begin();
+   while (it != features.end())
+   {
+      //---
+      // Features of unknown bounds are kept.  The table does not own the
+      // features, so the ones dropped are not deleted.
+      //---
+      ossimGrect bounds;
+      if ( getGroundBounds(it->second, bounds) && !bounds.intersects(region) )
+      {
+         features.erase(it++);
+      }
+      else
+      {
+         ++it;
+      }
+   }
+   return features;
+}
+
+bool ossimEsriShapeFileInterface::getGroundBounds(const ossimAnnotationObject* feature,
+                                                  ossimGrect& bounds)
+{
+   bool found = false;
+   double minLat = 0.0;
+   double maxLat = 0.0;
+   double minLon = 0.0;
+   double maxLon = 0.0;
+
+   const ossimGeoAnnotationPolyObject* poly =
+      PTR_CAST(ossimGeoAnnotationPolyObject, feature);
+   if (poly)
+   {
+      addVertices(poly->getPolygon(), found, minLat, maxLat, minLon, maxLon);
+   }
+   else
+   {
+      const ossimGeoAnnotationMultiPolyObject* multiPoly =
+         PTR_CAST(ossimGeoAnnotationMultiPolyObject, feature);
+      if (!multiPoly)
+      {
+         return false;
+      }
+      const std::vector<ossimGeoPolygon>& polygons = multiPoly->getMultiPolygon();
+      for (ossim_uint32 i = 0; i < polygons.size(); ++i)
+      {
+         // Holes are inside their polygon, so do not grow the bounds.
+         addVertices(polygons[i].getVertexList(), found, minLat, maxLat, minLon, maxLon);
+      }
+   }
+
+   if (!found)
+   {
+      return false;
+   }
+   bounds = ossimGrect(maxLat, minLon, minLat, maxLon);
+   return true;
+}
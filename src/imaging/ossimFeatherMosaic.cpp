@@ -150,12 +150,9 @@ template <class T> ossimRefPtr<ossimImageData> ossimFeatherMosaic::combine(
    ossim_uint32 band;
    long upperBound = theTile->getWidth()*theTile->getHeight();
    long offset = 0;
-   long row    = 0;
-   long col    = 0;
    long numberOfTilesProcessed = 0;
    float *sumBand       = static_cast<float*>(theAlphaSum->getBuf());
    float         *bandRes = NULL;
-   ossimIpt point;
    
    theAlphaSum->fill(0.0);
    theResult->fill(0.0);
@@ -208,7 +205,6 @@ template <class T> ossimRefPtr<ossimImageData> ossimFeatherMosaic::combine(
    while(currentImageData.valid())
    {
       ossimDataObjectStatus currentStatus     = currentImageData->getDataObjectStatus();
-      point = currentImageData->getOrigin();
       long h = (long)currentImageData->getHeight();
       long w = (long)currentImageData->getWidth();
       if( (currentStatus != OSSIM_EMPTY) &&
@@ -227,52 +223,52 @@ template <class T> ossimRefPtr<ossimImageData> ossimFeatherMosaic::combine(
          {
             srcBands[band]  = srcBands[minNumberOfBands - 1];
          }
-          if(currentStatus == OSSIM_PARTIAL)
-          {
-            for(row = 0; row < h; ++row)
+         //---
+         // Weights of null pixels are zeroed so every band is then accumulated in one
+         // straight pass.
+         //---
+         const long tileSize = w*h;
+         const double* weights = getWeights(layerIdx, currentImageData->getImageRectangle());
+         if(currentStatus == OSSIM_PARTIAL)
+         {
+            theMaskedWeights.assign(weights, weights + tileSize);
+            for(offset = 0; offset < tileSize; ++offset)
             {
-               for(col = 0; col < w; ++col)
+               if(currentImageData->isNull(offset))
                {
-                  if(!currentImageData->isNull(offset))
-                  {
-                     double weight = computeWeight(layerIdx,
-                                                   ossimDpt(point.x+col,
-                                                            point.y+row));
-                     
-                     for(band = 0; band < theLargestNumberOfInputBands; ++band)
-                     {
-                        bandRes = static_cast<float*>(theResult->getBuf(band));
-                        bandRes[offset] += (srcBands[band][offset]*weight);
-                     }
-                     sumBand[offset] += weight;
-                  }
-                  ++offset;
+                  theMaskedWeights[offset] = 0.0;
                }
             }
+            weights = &theMaskedWeights.front();
          }
-         else
+
+         for(band = 0; band < theLargestNumberOfInputBands; ++band)
          {
-            offset = 0;
-            
-            for(row = 0; row < h; ++row)
+            bandRes = static_cast<float*>(theResult->getBuf(band));
+            const T* srcBand = srcBands[band];
+            if(currentStatus == OSSIM_PARTIAL)
             {
-               for(col = 0; col < w; ++col)
+               // Null values may be NaN, which a zero weight would not cancel.
+               for(offset = 0; offset < tileSize; ++offset)
                {
-                     double weight = computeWeight(layerIdx,
-                                                   ossimDpt(point.x+col,
-                                                            point.y+row));
-                     
-                     for(band = 0; band < theLargestNumberOfInputBands; ++band)
-                     {
-                        bandRes     = static_cast<float*>(theResult->getBuf(band));
-                        
-                        bandRes[offset] += (srcBands[band][offset]*weight);
-                     }
-                     sumBand[offset] += weight;
-                     ++offset;
+                  if(weights[offset] != 0.0)
+                  {
+                     bandRes[offset] += (srcBand[offset]*weights[offset]);
+                  }
+               }
+            }
+            else
+            {
+               for(offset = 0; offset < tileSize; ++offset)
+               {
+                  bandRes[offset] += (srcBand[offset]*weights[offset]);
                }
             }
          }
+         for(offset = 0; offset < tileSize; ++offset)
+         {
+            sumBand[offset] += weights[offset];
+         }
       }
       currentImageData = getNextTile(layerIdx, tileRect, resLevel);
    }
@@ -283,13 +279,13 @@ template <class T> ossimRefPtr<ossimImageData> ossimFeatherMosaic::combine(
       const double* minPix = theTile->getMinPix();
       const double* maxPix = theTile->getMaxPix();
       const double* nullPix= theTile->getNullPix();
-      for(offset = 0; offset < upperBound;++offset)
+      for(band = 0; band < theTile->getNumberOfBands();++band)
       {
-         for(band = 0; band < theTile->getNumberOfBands();++band)
+         T* destBand         = static_cast<T*>(theTile->getBuf(band));
+         float* weightedBand = static_cast<float*>(theResult->getBuf(band));
+         
+         for(offset = 0; offset < upperBound;++offset)
          {
-            T* destBand      = static_cast<T*>(theTile->getBuf(band));
-            float* weightedBand = static_cast<float*>(theResult->getBuf(band));
-
             // this should be ok to test 0.0 instead of
             // FLT_EPSILON range for 0 since we set it.
             if(sumBand[offset] != 0.0)
@@ -343,10 +339,70 @@ double ossimFeatherMosaic::computeWeight(long index,
    return result;
 }
 
+void ossimFeatherMosaic::computeWeights(long index,
+                                        const ossimIrect& rect,
+                                        double* weights)const
+{
+   // computeWeight() over rect, with the row terms taken out of the inner loop.
+   const ossimFeatherInputInformation& info = theInputFeatherInformation[index];
+   const ossim_int32 x0 = rect.ul().x;
+   const ossim_int32 w  = (ossim_int32)rect.width();
+   const ossim_int32 h  = (ossim_int32)rect.height();
+   
+   for(ossim_int32 row = 0; row < h; ++row)
+   {
+      const double dy    = (double)(rect.ul().y + row) - info.theCenter.y;
+      const double term1 = dy*info.theAxis1.y;
+      const double term2 = dy*info.theAxis2.y;
+      for(ossim_int32 col = 0; col < w; ++col)
+      {
+         const double dx = (double)(x0 + col) - info.theCenter.x;
+         const double length1 = fabs(dx*info.theAxis1.x + term1)/info.theAxis1Length;
+         const double length2 = fabs(dx*info.theAxis2.x + term2)/info.theAxis2Length;
+         double result = 1.0 - ((length1 > length2) ? length1 : length2);
+         if(result < 0) result = 0;
+         weights[col] = result;
+      }
+      weights += w;
+   }
+}
+
+const double* ossimFeatherMosaic::getWeights(long index, const ossimIrect& rect)
+{
+   // Enough for the tiles around a viewer or a few writer rows of a handful of inputs.
+   static const ossim_uint32 WEIGHT_CACHE_SIZE = 64;
+
+   ossimFeatherWeightKey key;
+   key.theIndex = index;
+   key.theRect  = rect;
+
+   std::map<ossimFeatherWeightKey, std::vector<double> >::iterator i = theWeightCache.find(key);
+   if(i != theWeightCache.end())
+   {
+      return &i->second.front();
+   }
+
+   if(theWeightCacheOrder.size() >= WEIGHT_CACHE_SIZE)
+   {
+      theWeightCache.erase(theWeightCacheOrder.front());
+      theWeightCacheOrder.pop_front();
+   }
+   std::vector<double>& weights = theWeightCache[key];
+   weights.resize(rect.width()*rect.height());
+   computeWeights(index, rect, &weights.front());
+   theWeightCacheOrder.push_back(key);
+   
+   return &weights.front();
+}
+
 void ossimFeatherMosaic::initialize()
 {
    ossimImageMosaic::initialize();
 
+   // The input geometry may have changed.
+   theWeightCache.clear();
+   theWeightCacheOrder.clear();
+
    allocate();
    if(theTile.valid())
    {
@@ -16,9 +16,259 @@
 #include <ossim/matrix/newmatap.h>
 #include <ossim/imaging/ossimScalarRemapper.h>
 #include <ossim/base/ossimStringProperty.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/ossimConfig.h>
+
+#if OSSIM_HAS_FFTW3
+#  include <fftw3.h>
+#  include <OpenThreads/Mutex>
+#  include <OpenThreads/ScopedLock>
+#  include <OpenThreads/Thread>
+#  include <map>
+#endif
 
 RTTI_DEF1(ossimFftFilter, "ossimFftFilter", ossimImageSourceFilter);
 
+//---
+// Buffers of one band transform of a w x h tile.  With FFTW3, a single array of h rows of
+// w/2+1 complex, holding the real rows (padded to 2*(w/2+1) doubles) before an in-place
+// real-to-complex transform and the half spectrum after it; the inverse runs the other way.
+//---
+class ossimFftWorkspace
+{
+public:
+   ossimFftWorkspace(ossim_uint32 w, ossim_uint32 h);
+   ~ossimFftWorkspace();
+
+   ossim_uint32 theWidth;
+   ossim_uint32 theHeight;
+#if OSSIM_HAS_FFTW3
+   fftw_complex* theBuffer;
+   fftw_plan     theForwardPlan;
+   fftw_plan     theInversePlan;
+#else
+   NEWMAT::Matrix theRealIn;
+   NEWMAT::Matrix theImgIn;
+   NEWMAT::Matrix theRealOut;
+   NEWMAT::Matrix theImgOut;
+#endif
+};
+
+#if OSSIM_HAS_FFTW3
+namespace
+{
+   // Below this many pixels a tile is transformed on the calling thread only:
+   const ossim_uint32 MIN_THREAD_PIXELS = 64*64;
+
+   struct ossimFftPlans
+   {
+      fftw_plan theForward;
+      fftw_plan theInverse;
+   };
+   typedef std::map<std::pair<ossim_uint32, ossim_uint32>, ossimFftPlans> ossimFftPlanMap;
+
+   //---
+   // FFTW planning is not thread safe, executing a plan on new arrays is.  Plans are made once
+   // per tile size for all filters and kept for the life of the process.
+   //---
+   OpenThreads::Mutex thePlanMutex;
+   ossimFftPlanMap    thePlans;
+
+   ossimFftPlans getPlans(ossim_uint32 w, ossim_uint32 h)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(thePlanMutex);
+      const std::pair<ossim_uint32, ossim_uint32> size(w, h);
+      ossimFftPlanMap::const_iterator i = thePlans.find(size);
+      if(i != thePlans.end())
+      {
+         return i->second;
+      }
+
+      // FFTW_MEASURE overwrites the arrays it plans on:
+      fftw_complex* buffer = (fftw_complex*)fftw_malloc(sizeof(fftw_complex)*h*(w/2 + 1));
+      ossimFftPlans plans;
+      plans.theForward = fftw_plan_dft_r2c_2d(h, w, (double*)buffer, buffer, FFTW_MEASURE);
+      plans.theInverse = fftw_plan_dft_c2r_2d(h, w, buffer, (double*)buffer, FFTW_MEASURE);
+      fftw_free(buffer);
+      thePlans[size] = plans;
+      return plans;
+   }
+
+   //---
+   // Spectrum of a real band, nulls taken as zero.  The r2c transform gives columns 0 to w/2,
+   // the others are the conjugates of the mirrored bins: X(y,x) = conj(X(-y,-x)).
+   //---
+   template <class T>
+   void forwardBand(ossimFftWorkspace& workspace, const T* in, T nullPix,
+                    ossim_float64* realPart, ossim_float64* imgPart)
+   {
+      const ossim_uint32 w  = workspace.theWidth;
+      const ossim_uint32 h  = workspace.theHeight;
+      const ossim_uint32 cw = w/2 + 1;
+      double* rows = (double*)workspace.theBuffer;
+      for(ossim_uint32 y = 0; y < h; ++y)
+      {
+         double* row = rows + 2*cw*y;
+         for(ossim_uint32 x = 0; x < w; ++x, ++in)
+         {
+            row[x] = ((double)(*in) != nullPix) ? (double)(*in) : 0.0;
+         }
+      }
+      
+      fftw_execute_dft_r2c(workspace.theForwardPlan, rows, workspace.theBuffer);
+
+      for(ossim_uint32 y = 0; y < h; ++y)
+      {
+         const fftw_complex* row    = workspace.theBuffer + cw*y;
+         const fftw_complex* mirror = workspace.theBuffer + cw*((h - y)%h);
+         ossim_uint32 x = 0;
+         for(; x < cw; ++x)
+         {
+            realPart[x] = row[x][0];
+            imgPart[x]  = row[x][1];
+         }
+         for(; x < w; ++x)
+         {
+            realPart[x] =  mirror[w - x][0];
+            imgPart[x]  = -mirror[w - x][1];
+         }
+         realPart += w;
+         imgPart  += w;
+      }
+   }
+
+   //---
+   // Real part of the inverse of a full spectrum, clamped to [0, 1].  That real part is the
+   // inverse of the Hermitian half (Z(y,x) + conj(Z(-y,-x)))/2, which the c2r transform takes.
+   //---
+   template <class T>
+   void inverseBand(ossimFftWorkspace& workspace, const T* realPart, const T* imgPart,
+                    ossim_float64* out)
+   {
+      const ossim_uint32 w  = workspace.theWidth;
+      const ossim_uint32 h  = workspace.theHeight;
+      const ossim_uint32 cw = w/2 + 1;
+      for(ossim_uint32 y = 0; y < h; ++y)
+      {
+         const ossim_uint32 my = (h - y)%h;
+         const T* re  = realPart + w*y;
+         const T* im  = imgPart  + w*y;
+         const T* mre = realPart + w*my;
+         const T* mim = imgPart  + w*my;
+         fftw_complex* row = workspace.theBuffer + cw*y;
+         for(ossim_uint32 x = 0; x < cw; ++x)
+         {
+            const ossim_uint32 mx = (w - x)%w;
+            row[x][0] = 0.5*((double)re[x] + (double)mre[mx]);
+            row[x][1] = 0.5*((double)im[x] - (double)mim[mx]);
+         }
+      }
+
+      double* rows = (double*)workspace.theBuffer;
+      fftw_execute_dft_c2r(workspace.theInversePlan, workspace.theBuffer, rows);
+
+      const double scale = 1.0/((double)w*(double)h);
+      for(ossim_uint32 y = 0; y < h; ++y)
+      {
+         const double* row = rows + 2*cw*y;
+         for(ossim_uint32 x = 0; x < w; ++x, ++out)
+         {
+            *out = ossim::clamp(row[x]*scale, 0.0, 1.0);
+         }
+      }
+   }
+
+   /** Transforms bands first, first+step, ... of a tile with its own workspace. */
+   template <class T>
+   class ossimFftBandThread : public OpenThreads::Thread
+   {
+   public:
+      ossimFftBandThread(ossimFftWorkspace* workspace,
+                         ossimImageData* input,
+                         ossimImageData* output,
+                         bool forward,
+                         ossim_uint32 first,
+                         ossim_uint32 step)
+         : OpenThreads::Thread(),
+           theWorkspace(workspace),
+           theInput(input),
+           theOutput(output),
+           theForwardFlag(forward),
+           theFirst(first),
+           theStep(step)
+      {}
+
+      virtual void run()
+      {
+         if(theForwardFlag)
+         {
+            const ossim_uint32 bands = theInput->getNumberOfBands();
+            for(ossim_uint32 band = theFirst; band < bands; band += theStep)
+            {
+               const T* in = (const T*)theInput->getBuf(band);
+               ossim_float64* re = (ossim_float64*)theOutput->getBuf(2*band);
+               ossim_float64* im = (ossim_float64*)theOutput->getBuf(2*band + 1);
+               if(in && re && im)
+               {
+                  forwardBand(*theWorkspace, in, (T)theInput->getNullPix(band), re, im);
+               }
+            }
+         }
+         else
+         {
+            const ossim_uint32 bands = theInput->getNumberOfBands()/2;
+            for(ossim_uint32 band = theFirst; band < bands; band += theStep)
+            {
+               const T* re = (const T*)theInput->getBuf(2*band);
+               const T* im = (const T*)theInput->getBuf(2*band + 1);
+               ossim_float64* out = (ossim_float64*)theOutput->getBuf(band);
+               if(re && im && out)
+               {
+                  inverseBand(*theWorkspace, re, im, out);
+               }
+            }
+         }
+      }
+
+   private:
+      ossimFftWorkspace* theWorkspace;
+      ossimImageData*    theInput;
+      ossimImageData*    theOutput;
+      bool               theForwardFlag;
+      ossim_uint32       theFirst;
+      ossim_uint32       theStep;
+   };
+}
+#endif
+
+ossimFftWorkspace::ossimFftWorkspace(ossim_uint32 w, ossim_uint32 h)
+   : theWidth(w),
+     theHeight(h)
+#if OSSIM_HAS_FFTW3
+   ,
+     theBuffer((fftw_complex*)fftw_malloc(sizeof(fftw_complex)*h*(w/2 + 1)))
+{
+   const ossimFftPlans plans = getPlans(w, h);
+   theForwardPlan = plans.theForward;
+   theInversePlan = plans.theInverse;
+}
+#else
+   ,
+     theRealIn(h, w),
+     theImgIn(h, w),
+     theRealOut(h, w),
+     theImgOut(h, w)
+{
+}
+#endif
+
+ossimFftWorkspace::~ossimFftWorkspace()
+{
+#if OSSIM_HAS_FFTW3
+   fftw_free(theBuffer);
+#endif
+}
+
 ossimFftFilter::ossimFftFilter(ossimObject* owner)
    :ossimImageSourceFilter(owner),
     theTile(0),
@@ -54,6 +304,31 @@ ossimFftFilter::~ossimFftFilter()
       theScalarRemapper->disconnect();
       theScalarRemapper = 0;
    }
+   for(ossim_uint32 i = 0; i < theWorkspaces.size(); ++i)
+   {
+      delete theWorkspaces[i];
+   }
+}
+
+ossimFftWorkspace* ossimFftFilter::getWorkspace(ossim_uint32 index,
+                                                ossim_uint32 w,
+                                                ossim_uint32 h)
+{
+   if(index >= theWorkspaces.size())
+   {
+      theWorkspaces.resize(index + 1, 0);
+   }
+   ossimFftWorkspace*& workspace = theWorkspaces[index];
+   if(workspace && ((workspace->theWidth != w) || (workspace->theHeight != h)))
+   {
+      delete workspace;
+      workspace = 0;
+   }
+   if(!workspace)
+   {
+      workspace = new ossimFftWorkspace(w, h);
+   }
+   return workspace;
 }
 
 ossimRefPtr<ossimImageData> ossimFftFilter::getTile(const ossimIrect& rect,
@@ -307,22 +582,44 @@ void ossimFftFilter::runFft(T /* dummy */,
                             ossimRefPtr<ossimImageData>& input,
                             ossimRefPtr<ossimImageData>& output)
 {
-   // T*             inputBand  = 0;
-
-   NEWMAT::Matrix* realIn = new NEWMAT::Matrix(input->getHeight(),
-                                               input->getWidth());
-   NEWMAT::Matrix* imgIn = new NEWMAT::Matrix(input->getHeight(),
-                                              input->getWidth());
-   NEWMAT::Matrix* realOut = new NEWMAT::Matrix(input->getHeight(),
-                                                input->getWidth());
-   NEWMAT::Matrix* imgOut = new NEWMAT::Matrix(input->getHeight(),
-                                               input->getWidth());
-   ossim_uint32 bandIdx = 0;
    ossim_uint32 w = input->getWidth();
    ossim_uint32 h = input->getHeight();
+   const bool forward = (theDirectionType == ossimFftFilterDirectionType_FORWARD);
+   
+#if OSSIM_HAS_FFTW3
+   // Forward transforms a band, inverse a real/imaginary band pair:
+   const ossim_uint32 bandCount = forward ? input->getNumberOfBands() :
+                                            input->getNumberOfBands()/2;
+   ossim_uint32 threadCount = ossim::min(ossim::getNumberOfThreads(), bandCount);
+   if((threadCount < 1) || (w*h < MIN_THREAD_PIXELS))
+   {
+      threadCount = 1;
+   }
+
+   std::vector<ossimFftBandThread<T>*> threads;
+   for(ossim_uint32 t = 1; t < threadCount; ++t)
+   {
+      threads.push_back(new ossimFftBandThread<T>(getWorkspace(t, w, h), input.get(),
+                                                  output.get(), forward, t, threadCount));
+      threads.back()->start();
+   }
+   ossimFftBandThread<T>(getWorkspace(0, w, h), input.get(), output.get(),
+                         forward, 0, threadCount).run();
+   for(ossim_uint32 t = 0; t < threads.size(); ++t)
+   {
+      threads[t]->join();
+      delete threads[t];
+   }
+#else
+   ossimFftWorkspace* workspace = getWorkspace(0, w, h);
+   NEWMAT::Matrix& realIn  = workspace->theRealIn;
+   NEWMAT::Matrix& imgIn   = workspace->theImgIn;
+   NEWMAT::Matrix& realOut = workspace->theRealOut;
+   NEWMAT::Matrix& imgOut  = workspace->theImgOut;
+   ossim_uint32 bandIdx = 0;
    ossim_uint32 x = 0;
    ossim_uint32 y = 0;
-   if(theDirectionType == ossimFftFilterDirectionType_FORWARD)
+   if(forward)
    {
       ossim_uint32 bands = input->getNumberOfBands();
       for(bandIdx = 0; bandIdx < bands; ++bandIdx)
@@ -331,9 +628,9 @@ void ossimFftFilter::runFft(T /* dummy */,
          ossim_float64* bandImg  = 0;
          fillMatrixForward((T*)input->getBuf(bandIdx),
                            (T)input->getNullPix(bandIdx),
-                           *realIn,
-                           *imgIn);
-         NEWMAT::FFT2(*realIn, *imgIn, *realOut, *imgOut);
+                           realIn,
+                           imgIn);
+         NEWMAT::FFT2(realIn, imgIn, realOut, imgOut);
          bandReal = (ossim_float64*)output->getBuf(2*bandIdx);
          bandImg  = (ossim_float64*)output->getBuf(2*bandIdx + 1);
          if(bandReal&&bandImg)
@@ -342,8 +639,8 @@ void ossimFftFilter::runFft(T /* dummy */,
             {
                for(x = 0; x < w; ++x)
                {
-                  *bandReal = (ossim_float64)((*realOut)[y][x]);
-                  *bandImg  = (ossim_float64)((*imgOut)[y][x]);
+                  *bandReal = (ossim_float64)(realOut[y][x]);
+                  *bandImg  = (ossim_float64)(imgOut[y][x]);
                   ++bandReal;
                   ++bandImg;
                }
@@ -355,7 +652,7 @@ void ossimFftFilter::runFft(T /* dummy */,
    {
       ossim_float64* bandReal = 0;
       ossim_uint32 bands = input->getNumberOfBands();
-      for(bandIdx = 0; bandIdx < bands; bandIdx+=2)
+      for(bandIdx = 0; bandIdx + 1 < bands; bandIdx+=2)
       {
          bandReal = (ossim_float64*)output->getBuf(bandIdx/2);
          if(input->getBuf(bandIdx)&&
@@ -363,18 +660,18 @@ void ossimFftFilter::runFft(T /* dummy */,
          {
             fillMatrixInverse((T*)input->getBuf(bandIdx),
                               (T*)input->getBuf(bandIdx+1),
-                              *realIn,
-                              *imgIn);
-            NEWMAT::FFT2I(*realIn, *imgIn, *realOut, *imgOut);
+                              realIn,
+                              imgIn);
+            NEWMAT::FFT2I(realIn, imgIn, realOut, imgOut);
             for(y = 0; y < h; ++y)
             {
                for(x = 0; x < w; ++x)
                {
-                  *bandReal = (ossim_float64)((*realOut)[y][x]);
+                  *bandReal = (ossim_float64)(realOut[y][x]);
                   if(*bandReal > 1.0)
                   {
                      *bandReal = 1.0;
-               }
+                  }
                   if(*bandReal < 0.0)
                   {
                      *bandReal = 0.0;
@@ -385,11 +682,7 @@ void ossimFftFilter::runFft(T /* dummy */,
          }
       }
    }
-   
-   delete realIn;
-   delete imgIn;
-   delete realOut;
-   delete imgOut;
+#endif
 }
 
 template <class T>
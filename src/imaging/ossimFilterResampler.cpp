@@ -22,6 +22,7 @@
 #include <ossim/base/ossimDpt.h>
 #include <ossim/base/ossimDrect.h>
 #include <ossim/imaging/ossimFilterTable.h>
+#include <ossim/imaging/ossimImageDataKernels.h>
 ossimFilterResampler::ossimFilterResampler()
    :theMinifyFilter(new ossimNearestNeighborFilter()),
     theMagnifyFilter(new ossimNearestNeighborFilter()),
@@ -420,6 +421,18 @@ template <class T> void ossimFilterResampler::resampleBilinearTile(
       } // End of loop in y direction.
       
    }
+   else if ( (fabs(deltaUl.x)*resultRectH <= FLT_EPSILON) &&
+             (fabs(deltaUr.x)*resultRectH <= FLT_EPSILON) &&
+             (fabs(terminaly-initialy) <= FLT_EPSILON) &&
+             (fabs(deltaUr.y-deltaUl.y)*resultRectH <= FLT_EPSILON) &&
+             resampleSeparableTile(inputBuf, resultBuf, BANDS, inWidth, inBandSize/inWidth,
+                                   resultRectW, resultRectH, outputRectW,
+                                   initialx, initialy,
+                                   (terminalx-initialx) * stepSizeWidth, deltaUl.y,
+                                   NULL_PIX, MIN_PIX, MAX_PIX) )
+   {
+      // USING A SEPARABLE KERNEL (axis aligned scale change).
+   }
    else
    {
       // USING A KERNEL
@@ -554,6 +567,161 @@ template <class T> void ossimFilterResampler::resampleBilinearTile(
    delete [] inputBuf;
 }
 
+template <class T> bool ossimFilterResampler::resampleSeparableTile(
+   const T* const* inputBuf,
+   T* const* resultBuf,
+   ossim_uint32 bands,
+   ossim_uint32 inWidth,
+   ossim_uint32 inHeight,
+   ossim_uint32 resultWidth,
+   ossim_uint32 resultHeight,
+   ossim_uint32 resultStride,
+   double initialx,
+   double initialy,
+   double deltaX,
+   double deltaY,
+   const ossim_float64* nullPix,
+   const ossim_float64* minPix,
+   const ossim_float64* maxPix)
+{
+   const ossim_uint32 KW = theFilterTable.getWidth();
+   const ossim_uint32 KH = theFilterTable.getHeight();
+   const double HALF_W   = theFilterTable.getXSupport();
+   const double HALF_H   = theFilterTable.getYSupport();
+   ossim_uint32 i, k, band;
+
+   //---
+   // Kernel start, weights and center for every output sample and line.  Positions are
+   // accumulated exactly as the two dimensional loop does.
+   //---
+   std::vector<ossim_int32>   colStart(resultWidth);
+   std::vector<ossim_int32>   colCenter(resultWidth);
+   std::vector<const double*> colWeights(resultWidth);
+   double point = initialx;
+   for (i = 0; i < resultWidth; ++i)
+   {
+      colStart[i]   = ossim::round<int>(point - HALF_W + .5);
+      colCenter[i]  = ossim::round<int>(point);
+      colWeights[i] = theFilterTable.getClosestXWeights(point);
+      if ( (colStart[i] < 0) || (colStart[i] + (ossim_int32)KW > (ossim_int32)inWidth) )
+      {
+         return false;
+      }
+      point += deltaX;
+   }
+
+   std::vector<ossim_int32>   rowStart(resultHeight);
+   std::vector<ossim_int32>   rowCenter(resultHeight);
+   std::vector<const double*> rowWeights(resultHeight);
+   point = initialy;
+   for (i = 0; i < resultHeight; ++i)
+   {
+      rowStart[i]   = ossim::round<int>(point - HALF_H + .5);
+      rowCenter[i]  = ossim::round<int>(point);
+      rowWeights[i] = theFilterTable.getClosestYWeights(point);
+      if ( (rowStart[i] < 0) || (rowStart[i] + (ossim_int32)KH > (ossim_int32)inHeight) )
+      {
+         return false;
+      }
+      point += deltaY;
+   }
+
+   //---
+   // Horizontally filtered input lines, pixel and density sums per band, held in a ring of KH
+   // slots.  Input line r lives in slot r % KH so the KH consecutive lines of one kernel never
+   // collide, and lines shared by neighboring output lines are filtered once.
+   //---
+   const ossim_uint32 SLOT_SIZE = 2*resultWidth;
+   std::vector<ossim_float64> lines(KH*bands*SLOT_SIZE);
+   std::vector<ossim_int32>   slotLine(KH, -1);
+   std::vector<ossim_float64> sums(SLOT_SIZE*bands);
+
+   for (ossim_uint32 resultY = 0; resultY < resultHeight; ++resultY)
+   {
+      const double* yWeights = rowWeights[resultY];
+
+      // Fill the slots this line needs.
+      for (k = 0; k < KH; ++k)
+      {
+         const ossim_int32 LINE = rowStart[resultY] + (ossim_int32)k;
+         const ossim_uint32 SLOT = (ossim_uint32)LINE % KH;
+         if ( slotLine[SLOT] == LINE )
+         {
+            continue;
+         }
+         slotLine[SLOT] = LINE;
+         for (band = 0; band < bands; ++band)
+         {
+            const T* in = inputBuf[band] + LINE*inWidth;
+            const ossim_float64 NP = nullPix[band];
+            ossim_float64* pixels  = &lines[(SLOT*bands + band)*SLOT_SIZE];
+            ossim_float64* density = pixels + resultWidth;
+            for (i = 0; i < resultWidth; ++i)
+            {
+               const T* s = in + colStart[i];
+               const double* w = colWeights[i];
+               ossim_float64 p = 0.0;
+               ossim_float64 d = 0.0;
+               for (ossim_uint32 ix = 0; ix < KW; ++ix)
+               {
+                  if ( s[ix] != NP )
+                  {
+                     d += w[ix];
+                     p += s[ix]*w[ix];
+                  }
+               }
+               pixels[i]  = p;
+               density[i] = d;
+            }
+         }
+      }
+
+      // Vertical pass.
+      memset(&sums[0], '\0', sizeof(ossim_float64)*sums.size());
+      for (band = 0; band < bands; ++band)
+      {
+         ossim_float64* acc = &sums[band*SLOT_SIZE];
+         for (k = 0; k < KH; ++k)
+         {
+            const ossim_uint32 SLOT = (ossim_uint32)(rowStart[resultY] + (ossim_int32)k) % KH;
+            ossim::addWeighted(&lines[(SLOT*bands + band)*SLOT_SIZE], acc, SLOT_SIZE,
+                               yWeights[k]);
+         }
+      }
+
+      // Assign, nulling samples whose center pixel is null in every band.
+      const ossim_uint32 CENTER_LINE = rowCenter[resultY]*inWidth;
+      for (i = 0; i < resultWidth; ++i)
+      {
+         const ossim_uint32 CENTER = CENTER_LINE + colCenter[i];
+         ossim_uint32 nullCount = 0;
+         for (band = 0; band < bands; ++band)
+         {
+            if ( inputBuf[band][CENTER] == static_cast<T>(nullPix[band]) )
+            {
+               ++nullCount;
+            }
+         }
+         for (band = 0; band < bands; ++band)
+         {
+            ossim_float64 v = nullPix[band];
+            if ( nullCount != bands )
+            {
+               const ossim_float64 DENSITY = sums[band*SLOT_SIZE + resultWidth + i];
+               if ( DENSITY > FLT_EPSILON )
+               {
+                  v = sums[band*SLOT_SIZE + i]/DENSITY;
+               }
+               v = (v>=minPix[band]?(v<maxPix[band]?v:maxPix[band]):minPix[band]);
+            }
+            resultBuf[band][resultY*resultStride + i] = static_cast<T>(v);
+         }
+      }
+   }
+
+   return true;
+}
+
 ossimString ossimFilterResampler::getFilterTypeAsString(ossimFilterResamplerType type)const
 {
    switch(type)
@@ -14,6 +14,8 @@
 
 ossimFilterTable::ossimFilterTable()
    :theWeights(0),
+    theXWeights(0),
+    theYWeights(0),
     theWidth(0),
     theHeight(0),
     theWidthHeight(0),
@@ -31,6 +33,16 @@ ossimFilterTable::~ossimFilterTable()
       delete [] theWeights;
       theWeights = 0;
    }
+   if(theXWeights)
+   {
+      delete [] theXWeights;
+      theXWeights = 0;
+   }
+   if(theYWeights)
+   {
+      delete [] theYWeights;
+      theYWeights = 0;
+   }
 }
 
 void ossimFilterTable::buildTable(ossim_uint32  filterSteps,
@@ -104,6 +116,25 @@ void ossimFilterTable::buildTable(ossim_uint32  filterSteps,
           }
         }
      }
+
+   // One dimensional factors of the table above, for separable resampling.
+   if(theXWeights && theYWeights)
+   {
+      ossim_uint32 xIdx = 0;
+      ossim_uint32 yIdx = 0;
+      for (ossim_uint32 step = 0; step < filterSteps; ++step)
+      {
+         double d = step / (double)(filterSteps);
+         for(kernelH=left; kernelH<=right;++kernelH)
+         {
+            theXWeights[xIdx++] = xFilter.filter(kernelH - d, xFilter.getSupport());
+         }
+         for (kernelV=top; kernelV<=bottom; ++kernelV)
+         {
+            theYWeights[yIdx++] = yFilter.filter(kernelV - d, yFilter.getSupport());
+         }
+      }
+   }
 }
 
 ossim_uint32 ossimFilterTable::getWidthByHeight()const
@@ -139,10 +170,23 @@ void ossimFilterTable::allocateWeights()
       theWeights = 0;
    }
 
+   if(theXWeights)
+   {
+      delete [] theXWeights;
+      theXWeights = 0;
+   }
+   if(theYWeights)
+   {
+      delete [] theYWeights;
+      theYWeights = 0;
+   }
+
    ossim_uint32 size = (theWidthHeight*(theFilterSteps*theFilterSteps));
 
    if(size)
    {
       theWeights = new double[size];
+      theXWeights = new double[theWidth*theFilterSteps];
+      theYWeights = new double[theHeight*theFilterSteps];
    }
 }
\ No newline at end of file
@@ -9,8 +9,12 @@
 //***********************************
 // $Id: ossimFixedTileCache.cpp 16276 2010-01-06 01:54:47Z gpotts $
 #include <ossim/imaging/ossimFixedTileCache.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
 #include <algorithm>
 
+static const ossim_uint32 INITIAL_HASH_SIZE = 64;
+
 ossimFixedTileCache::ossimFixedTileCache()
    : theTileBoundaryRect(),
      theTileSize(),
@@ -19,12 +23,23 @@ ossimFixedTileCache::ossimFixedTileCache()
      theTilesVertical(0),
      theCacheSize(0),
      theMaxCacheSize(0),
-     theTileMap(),
-     theLruQueue(),
-     theUseLruFlag(true)
+     theUseLruFlag(true),
+     thePolicy(LRU_POLICY),
+     theHashTable(INITIAL_HASH_SIZE, (ossimFixedTileCacheInfo*)0),
+     theNumberOfTiles(0)
 {
    ossim::defaultTileSize(theTileSize);
 
+   const char* lookup = ossimPreferences::instance()->findPreference("cache_policy");
+   if (lookup)
+   {
+      ossimString policy = ossimString(lookup).downcase().trim();
+      if (policy == "2q")
+      {
+         thePolicy = TWO_QUEUE_POLICY;
+      }
+   }
+
    ossimIrect tempRect;
    tempRect.makeNan();
 
@@ -75,19 +90,19 @@ void ossimFixedTileCache::setRect(const ossimIrect& rect,
 void ossimFixedTileCache::keepTilesWithinRect(const ossimIrect& rect)
 {
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   std::map<ossim_int32, ossimFixedTileCacheInfo>::iterator tileIter = theTileMap.begin();
-
-   while(tileIter != theTileMap.end())
+   for (ossim_uint32 q = 0; q < NUMBER_OF_QUEUES; ++q)
    {
-      ossimIrect tileRect = (*tileIter).second.theTile->getImageRectangle();
-      if(!tileRect.intersects(rect))
+      ossimFixedTileCacheInfo* node = theQueues[q].theHead;
+      while(node)
       {
-         eraseFromLru(computeId((*tileIter).second.theTile->getOrigin()));
-         theCacheSize -= (*tileIter).second.theTile->getDataSizeInBytes();
-         (*tileIter).second.theTile = NULL;
-         theTileMap.erase(tileIter);
+         ossimFixedTileCacheInfo* next = node->theLruNext;
+         if(!node->theTile.valid() ||
+            !node->theTile->getImageRectangle().intersects(rect))
+         {
+            eraseNode(node);
+         }
+         node = next;
       }
-      ++tileIter;
    }
 }
 
@@ -111,10 +126,7 @@ ossimRefPtr<ossimImageData> ossimFixedTileCache::addTile(ossimRefPtr<ossimImageD
       return result;
    }
    
-   std::map<ossim_int32, ossimFixedTileCacheInfo>::iterator tileIter =
-      theTileMap.find(id);
-
-   if(tileIter==theTileMap.end())
+   if(!findNode(id))
    {
       if(duplicateData)
       {
@@ -124,14 +136,12 @@ ossimRefPtr<ossimImageData> ossimFixedTileCache::addTile(ossimRefPtr<ossimImageD
       {
          result = imageData;
       }
-      ossimFixedTileCacheInfo cacheInfo(result, id);
+      result->shareBuffer(); // Tiles handed out are copied from without a lock.
+      ossimFixedTileCacheInfo* node = new ossimFixedTileCacheInfo(result, id);
        
       theCacheSize += imageData->getDataSizeInBytes();
-      theTileMap.insert(make_pair(id, cacheInfo));
-      if(theUseLruFlag)
-      {
-         theLruQueue.push_back(id);
-      }
+      insertNode(node);
+      pushBack(node, (thePolicy == TWO_QUEUE_POLICY) ? PROBATION_QUEUE : MAIN_QUEUE);
    }
    
    return result;
@@ -142,11 +152,10 @@ ossimRefPtr<ossimImageData> ossimFixedTileCache::getTile(ossim_int32 id)
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
    ossimRefPtr<ossimImageData> result = NULL;
 
-   std::map<ossim_int32, ossimFixedTileCacheInfo>::iterator tileIter =
-      theTileMap.find(id);
-   if(tileIter!=theTileMap.end())
+   ossimFixedTileCacheInfo* node = findNode(id);
+   if(node)
    {
-      result = (*tileIter).second.theTile;
+      result = node->theTile;
       adjustLru(id);
    }
 
@@ -195,18 +204,11 @@ ossim_int32 ossimFixedTileCache::computeId(const ossimIpt& tileOrigin)const
 
 void ossimFixedTileCache::deleteTile(ossim_int32 tileId)
 {
-   std::map<ossim_int32, ossimFixedTileCacheInfo>::iterator tileIter =
-      theTileMap.find(tileId);
-
-   if(tileIter != theTileMap.end())
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+   ossimFixedTileCacheInfo* node = findNode(tileId);
+   if(node)
    {
-      if((*tileIter).second.theTile.valid())
-      {
-         theCacheSize -= (*tileIter).second.theTile->getDataSizeInBytes();
-         (*tileIter).second.theTile = NULL;
-      }
-      theTileMap.erase(tileIter);
-      eraseFromLru(tileId);
+      eraseNode(node);
    }
 }
 
@@ -215,18 +217,10 @@ ossimRefPtr<ossimImageData> ossimFixedTileCache::removeTile(ossim_int32 tileId)
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
    ossimRefPtr<ossimImageData> result = NULL;
    
-   std::map<ossim_int32, ossimFixedTileCacheInfo>::iterator tileIter =
-      theTileMap.find(tileId);
-
-   if(tileIter != theTileMap.end())
+   ossimFixedTileCacheInfo* node = findNode(tileId);
+   if(node)
    {
-      theCacheSize -= (*tileIter).second.theTile->getDataSizeInBytes();
-      if((*tileIter).second.theTile.valid())
-      {
-         result =  (*tileIter).second.theTile;
-      }
-      theTileMap.erase(tileIter);
-      eraseFromLru(tileId);
+      result = eraseNode(node);
    }
    
    return result;
@@ -235,19 +229,7 @@ ossimRefPtr<ossimImageData> ossimFixedTileCache::removeTile(ossim_int32 tileId)
 void ossimFixedTileCache::flush()
 {
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
-   std::map<ossim_int32, ossimFixedTileCacheInfo>::iterator tileIter =
-      theTileMap.begin();
-
-   while(tileIter != theTileMap.end())
-   {
-      if( (*tileIter).second.theTile.valid())
-      {
-         (*tileIter).second.theTile = 0;
-      }
-      ++tileIter;
-   }
-   theLruQueue.clear();
-   theTileMap.clear();
+   clearNodes();
    theCacheSize = 0;
 }
 
@@ -256,9 +238,10 @@ void ossimFixedTileCache::deleteTile()
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
    if(theUseLruFlag)
    {
-      if(theLruQueue.begin() != theLruQueue.end())
+      ossimFixedTileCacheInfo* node = victim();
+      if(node)
       {
-         deleteTile(*(theLruQueue.begin()));
+         eraseNode(node);
       }
    }
 }
@@ -268,44 +251,216 @@ ossimRefPtr<ossimImageData> ossimFixedTileCache::removeTile()
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
    if(theUseLruFlag)
    {
-      if(theLruQueue.begin() != theLruQueue.end())
+      ossimFixedTileCacheInfo* node = victim();
+      if(node)
       {
-         return removeTile(*(theLruQueue.begin()));
+         return eraseNode(node);
       }
    }
 
    return NULL;
 }
 
+void ossimFixedTileCache::setReplacementPolicy(ReplacementPolicy policy)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+   if(policy != thePolicy)
+   {
+      thePolicy = policy;
+      if(thePolicy == LRU_POLICY)
+      {
+         // Merge into the main queue, probation tiles first as they are the colder ones.
+         ossimFixedTileCacheInfo* node = theQueues[MAIN_QUEUE].theHead;
+         while(node)
+         {
+            ossimFixedTileCacheInfo* next = node->theLruNext;
+            unlinkFromQueue(node);
+            pushBack(node, PROBATION_QUEUE);
+            node = next;
+         }
+         std::swap(theQueues[PROBATION_QUEUE], theQueues[MAIN_QUEUE]);
+         for(node = theQueues[MAIN_QUEUE].theHead; node; node = node->theLruNext)
+         {
+            node->theQueue = MAIN_QUEUE;
+         }
+      }
+   }
+}
+
 void ossimFixedTileCache::adjustLru(ossim_int32 id)
 {
    if(theUseLruFlag)
    {
-      std::list<ossim_int32>::iterator iter = std::find(theLruQueue.begin(), theLruQueue.end(), id);
-      
-      if(iter != theLruQueue.end())
+      ossimFixedTileCacheInfo* node = findNode(id);
+      if(node)
       {
-         ossim_int32 value = *iter;
-         theLruQueue.erase(iter);
-         theLruQueue.push_back(value);
+         // A hit promotes a probation tile to the main queue.
+         unlinkFromQueue(node);
+         pushBack(node, MAIN_QUEUE);
       }
    }
 }
 
 void ossimFixedTileCache::eraseFromLru(ossim_int32 id)
 {
-   if(theUseLruFlag)
+   ossimFixedTileCacheInfo* node = findNode(id);
+   if(node)
+   {
+      unlinkFromQueue(node);
+   }
+}
+
+ossimFixedTileCacheInfo* ossimFixedTileCache::findNode(ossim_int32 id)const
+{
+   ossimFixedTileCacheInfo* node =
+      theHashTable[static_cast<ossim_uint32>(id) & (theHashTable.size()-1)];
+   while(node && (node->theTileId != id))
+   {
+      node = node->theHashNext;
+   }
+   return node;
+}
+
+void ossimFixedTileCache::insertNode(ossimFixedTileCacheInfo* node)
+{
+   if(theNumberOfTiles >= theHashTable.size())
+   {
+      growHashTable();
+   }
+   // Ids are dense row major tile indexes so the low bits make a good hash.
+   ossimFixedTileCacheInfo*& bucket =
+      theHashTable[static_cast<ossim_uint32>(node->theTileId) & (theHashTable.size()-1)];
+   node->theHashNext = bucket;
+   bucket = node;
+   ++theNumberOfTiles;
+}
+
+void ossimFixedTileCache::unlinkNode(ossimFixedTileCacheInfo* node)
+{
+   ossimFixedTileCacheInfo** link =
+      &theHashTable[static_cast<ossim_uint32>(node->theTileId) & (theHashTable.size()-1)];
+   while(*link && (*link != node))
    {
-      
-      std::list<ossim_int32>::iterator iter = std::find(theLruQueue.begin(), theLruQueue.end(), id);
-      
-      if(iter != theLruQueue.end())
+      link = &((*link)->theHashNext);
+   }
+   if(*link)
+   {
+      *link = node->theHashNext;
+      node->theHashNext = 0;
+      --theNumberOfTiles;
+   }
+}
+
+void ossimFixedTileCache::growHashTable()
+{
+   std::vector<ossimFixedTileCacheInfo*> table(theHashTable.size()*2,
+                                               (ossimFixedTileCacheInfo*)0);
+   const ossim_uint32 MASK = (ossim_uint32)table.size() - 1;
+   for(ossim_uint32 i = 0; i < theHashTable.size(); ++i)
+   {
+      ossimFixedTileCacheInfo* node = theHashTable[i];
+      while(node)
       {
-         theLruQueue.erase(iter);
+         ossimFixedTileCacheInfo* next = node->theHashNext;
+         ossimFixedTileCacheInfo*& bucket = table[static_cast<ossim_uint32>(node->theTileId) & MASK];
+         node->theHashNext = bucket;
+         bucket = node;
+         node = next;
       }
    }
+   theHashTable.swap(table);
+}
+
+void ossimFixedTileCache::pushBack(ossimFixedTileCacheInfo* node, ossim_uint32 queue)
+{
+   Queue& q = theQueues[queue];
+   node->theQueue   = queue;
+   node->theLruPrev = q.theTail;
+   node->theLruNext = 0;
+   if(q.theTail)
+   {
+      q.theTail->theLruNext = node;
+   }
+   else
+   {
+      q.theHead = node;
+   }
+   q.theTail = node;
+   ++q.theCount;
+}
+
+void ossimFixedTileCache::unlinkFromQueue(ossimFixedTileCacheInfo* node)
+{
+   Queue& q = theQueues[node->theQueue];
+   if(node->theLruPrev)
+   {
+      node->theLruPrev->theLruNext = node->theLruNext;
+   }
+   else if(q.theHead == node)
+   {
+      q.theHead = node->theLruNext;
+   }
+   else
+   {
+      return; // Not linked.
+   }
+   if(node->theLruNext)
+   {
+      node->theLruNext->theLruPrev = node->theLruPrev;
+   }
+   else
+   {
+      q.theTail = node->theLruPrev;
+   }
+   node->theLruPrev = 0;
+   node->theLruNext = 0;
+   --q.theCount;
+}
+
+ossimFixedTileCacheInfo* ossimFixedTileCache::victim()const
+{
+   const Queue& probation = theQueues[PROBATION_QUEUE];
+   const Queue& main      = theQueues[MAIN_QUEUE];
+   if(probation.theHead &&
+      ( !main.theHead || (probation.theCount*4 >= theNumberOfTiles) ) )
+   {
+      return probation.theHead;
+   }
+   return main.theHead ? main.theHead : probation.theHead;
 }
 
+ossimRefPtr<ossimImageData> ossimFixedTileCache::eraseNode(ossimFixedTileCacheInfo* node)
+{
+   ossimRefPtr<ossimImageData> result = node->theTile;
+   if(result.valid())
+   {
+      theCacheSize -= result->getDataSizeInBytes();
+   }
+   unlinkFromQueue(node);
+   unlinkNode(node);
+   delete node;
+   return result;
+}
+
+void ossimFixedTileCache::clearNodes()
+{
+   for(ossim_uint32 i = 0; i < theHashTable.size(); ++i)
+   {
+      ossimFixedTileCacheInfo* node = theHashTable[i];
+      while(node)
+      {
+         ossimFixedTileCacheInfo* next = node->theHashNext;
+         delete node;
+         node = next;
+      }
+      theHashTable[i] = 0;
+   }
+   for(ossim_uint32 q = 0; q < NUMBER_OF_QUEUES; ++q)
+   {
+      theQueues[q] = Queue();
+   }
+   theNumberOfTiles = 0;
+}
 
 void ossimFixedTileCache::setTileSize(const ossimIpt& tileSize)
 {
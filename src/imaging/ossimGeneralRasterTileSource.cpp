@@ -23,6 +23,7 @@
 #include <ossim/base/ossimIrect.h>
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimKeywordNames.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossimScalarTypeLut.h>
 #include <ossim/base/ossimStreamFactoryRegistry.h>
 #include <ossim/base/ossimTrace.h>
@@ -37,6 +38,7 @@ RTTI_DEF1_INST(ossimGeneralRasterTileSource,
                ossimImageHandler)
 
 static ossimTrace traceDebug("ossimGeneralRasterTileSource:debug");
+static ossimTrace traceSpan("ossimGeneralRasterTileSource:span");
 
 // For interleave type enum to string conversions.
 static const ossimInterleaveTypeLut ILUT;
@@ -52,12 +54,21 @@ ossimGeneralRasterTileSource::ossimGeneralRasterTileSource()
       m_lineBuffer(0),
       m_bufferInterleave(OSSIM_BIL),
       m_fileStrList(0),
+      m_readAhead(0),
       m_rasterInfo(),
       m_bufferRect(0, 0, 0, 0),
       m_swapBytesFlag(false),
       m_bufferSizeInPixels(0),
-      m_outputBandList(0)
-{}
+      m_outputBandList(0),
+      m_memoryMapFlag(false),
+      m_memoryMaps(0)
+{
+   const char* lookup = ossimPreferences::instance()->findPreference("general_raster.memory_map");
+   if ( lookup )
+   {
+      m_memoryMapFlag = ossimString(lookup).toBool();
+   }
+}
 
 ossimGeneralRasterTileSource::~ossimGeneralRasterTileSource()
 {
@@ -92,6 +103,7 @@ ossimRefPtr<ossimImageData> ossimGeneralRasterTileSource::getTile(
 bool ossimGeneralRasterTileSource::getTile(ossimImageData* result,
                                            ossim_uint32 resLevel)
 {
+   OSSIM_TRACE_SPAN_VALUE(traceSpan, "ossimGeneralRasterTileSource::getTile", resLevel);
    bool status = false;
    
    //---
@@ -149,46 +161,66 @@ bool ossimGeneralRasterTileSource::getTile(ossimImageData* result,
 
             ossimIrect clip_rect = tile_rect.clipToRect(image_rect);
 
-            if ( ! tile_rect.completely_within(m_bufferRect) )
+            if ( m_memoryMaps.size() )
             {
-               // A new buffer must be loaded.
+               // Straight from the mapping, no buffer.
                if ( !tile_rect.completely_within(clip_rect) )
                {
-                  //---
-                  // Start with a blank tile since the whole tile buffer will
-                  // not be
-                  // filled.
-                  //---
                   result->makeBlank();
                }
-
-               // Reallocate the buffer if needed.
-               if ( m_bufferSizeInPixels != result->getSize() )
-               {
-                  allocateBuffer( result );
-               }
-
-               ossimIpt size(static_cast<ossim_int32>(result->getWidth()),
-                             static_cast<ossim_int32>(result->getHeight()));
-
-               if( !fillBuffer(clip_rect.ul(), size) )
+               if ( !loadMappedTile(result, clip_rect) )
                {
                   ossimNotify(ossimNotifyLevel_WARN)
-                     << "Error from fill buffer..."
+                     << "Error from load mapped tile..."
                      << std::endl;
-                  //---
-                  // Error in filling buffer.
-                  //---
                   setErrorStatus();
                   status = false;
                }
+               result->validate();
             }
+            else
+            {
+               if ( ! tile_rect.completely_within(m_bufferRect) )
+               {
+                  // A new buffer must be loaded.
+                  if ( !tile_rect.completely_within(clip_rect) )
+                  {
+                     //---
+                     // Start with a blank tile since the whole tile buffer will
+                     // not be
+                     // filled.
+                     //---
+                     result->makeBlank();
+                  }
+
+                  // Reallocate the buffer if needed.
+                  if ( m_bufferSizeInPixels != result->getSize() )
+                  {
+                     allocateBuffer( result );
+                  }
+
+                  ossimIpt size(static_cast<ossim_int32>(result->getWidth()),
+                                static_cast<ossim_int32>(result->getHeight()));
+
+                  if( !fillBuffer(clip_rect.ul(), size) )
+                  {
+                     ossimNotify(ossimNotifyLevel_WARN)
+                        << "Error from fill buffer..."
+                        << std::endl;
+                     //---
+                     // Error in filling buffer.
+                     //---
+                     setErrorStatus();
+                     status = false;
+                  }
+               }
             
-            result->loadTile(m_buffer,
-                             m_bufferRect,
-                             clip_rect,
-                             m_bufferInterleave);
-            result->validate();
+               result->loadTile(m_buffer,
+                                m_bufferRect,
+                                clip_rect,
+                                m_bufferInterleave);
+               result->validate();
+            }
 
             // Set the rectangle back.
             result->setImageRectangle(tile_rect);
@@ -203,6 +235,85 @@ bool ossimGeneralRasterTileSource::getTile(ossimImageData* result,
    return status;
 }
 
+void ossimGeneralRasterTileSource::prefetch(const std::vector<ossimIrect>& rects,
+                                            ossim_uint32 resLevel)
+{
+   if ( resLevel )
+   {
+      // Reduced res levels come from the overview.
+      ossimImageHandler::prefetch(rects, resLevel);
+      return;
+   }
+
+   if ( m_readAhead.empty() )
+   {
+      return;
+   }
+
+   const ossimIrect IMAGE_RECT            = m_rasterInfo.imageRect();
+   const std::streamoff FIRST             = m_rasterInfo.offsetToFirstValidSample();
+   const std::streamoff BYTES_PER_LINE    = m_rasterInfo.bytesPerRawLine();
+   const ossimInterleaveType INTERLEAVE   = m_rasterInfo.interleaveType();
+
+   std::vector<ossimIrect>::const_iterator r = rects.begin();
+   while ( r != rects.end() )
+   {
+      if ( (*r).intersects(IMAGE_RECT) )
+      {
+         // Whole lines; partial lines would save little on contiguous data.
+         ossimIrect clip_rect = (*r).clipToRect(IMAGE_RECT);
+         const std::streamoff Y0    = clip_rect.ul().y;
+         const std::streamoff LINES = clip_rect.height();
+
+         switch ( INTERLEAVE )
+         {
+            case OSSIM_BIP:
+            {
+               m_readAhead[0]->willNeed(FIRST + Y0 * BYTES_PER_LINE, LINES * BYTES_PER_LINE);
+               break;
+            }
+            case OSSIM_BIL:
+            {
+               const std::streamoff LINE_OFFSET = BYTES_PER_LINE * m_rasterInfo.numberOfBands();
+               m_readAhead[0]->willNeed(FIRST + Y0 * LINE_OFFSET, LINES * LINE_OFFSET);
+               break;
+            }
+            case OSSIM_BSQ:
+            {
+               const std::streamoff BAND_OFFSET = BYTES_PER_LINE * m_rasterInfo.rawLines();
+               std::vector<ossim_uint32>::const_iterator b = m_outputBandList.begin();
+               while ( b != m_outputBandList.end() )
+               {
+                  m_readAhead[0]->willNeed(FIRST + (*b) * BAND_OFFSET + Y0 * BYTES_PER_LINE,
+                                           LINES * BYTES_PER_LINE);
+                  ++b;
+               }
+               break;
+            }
+            case OSSIM_BSQ_MULTI_FILE:
+            {
+               std::vector<ossim_uint32>::const_iterator b = m_outputBandList.begin();
+               while ( b != m_outputBandList.end() )
+               {
+                  if ( (*b) < m_readAhead.size() )
+                  {
+                     m_readAhead[*b]->willNeed(FIRST + Y0 * BYTES_PER_LINE,
+                                               LINES * BYTES_PER_LINE);
+                  }
+                  ++b;
+               }
+               break;
+            }
+            default:
+            {
+               break;
+            }
+         }
+      }
+      ++r;
+   }
+}
+
 bool ossimGeneralRasterTileSource::fillBuffer(const ossimIpt& origin, const ossimIpt& size)
 {
 
@@ -632,6 +743,107 @@ bool ossimGeneralRasterTileSource::fillBsqMultiFile(const ossimIpt& origin, cons
    return true;
 }
 
+bool ossimGeneralRasterTileSource::loadMappedTile(ossimImageData* result,
+                                                  const ossimIrect& clip_rect) const
+{
+   const ossimIrect TILE_RECT             = result->getImageRectangle();
+   const ossim_uint32 TILE_WIDTH          = result->getWidth();
+   const ossim_uint32 WIDTH               = clip_rect.width();
+   const ossim_uint32 HEIGHT              = clip_rect.height();
+   const ossim_uint64 BYTES_PER_PIXEL     = m_rasterInfo.bytesPerPixel();
+   const ossim_uint64 INPUT_BANDS         = m_rasterInfo.numberOfBands();
+   const ossim_uint64 BYTES_PER_LINE      = m_rasterInfo.bytesPerRawLine();
+   const ossim_uint64 FIRST               = m_rasterInfo.offsetToFirstValidSample();
+   const ossimInterleaveType INTERLEAVE   = m_rasterInfo.interleaveType();
+   const ossim_uint64 X0                  = clip_rect.ul().x;
+   const ossim_uint64 Y0                  = clip_rect.ul().y;
+   const ossim_uint32 OUTPUT_BANDS        = static_cast<ossim_uint32>( m_outputBandList.size() );
+
+   // Distance between lines and between samples of one band, and the file offset of the first.
+   ossim_uint64 lineStride   = BYTES_PER_LINE;
+   ossim_uint64 sampleStride = BYTES_PER_PIXEL;
+   if ( INTERLEAVE == OSSIM_BIL )
+   {
+      lineStride = BYTES_PER_LINE * INPUT_BANDS;
+   }
+   else if ( INTERLEAVE == OSSIM_BIP )
+   {
+      sampleStride = BYTES_PER_PIXEL * INPUT_BANDS;
+   }
+
+   ossimEndian oe;
+   for ( ossim_uint32 band = 0; band < OUTPUT_BANDS; ++band )
+   {
+      const ossim_uint64 INPUT_BAND = m_outputBandList[band];
+      const ossimMemoryMappedFile* map = m_memoryMaps[0].get();
+      ossim_uint64 offset = FIRST + Y0 * lineStride + X0 * sampleStride;
+      switch ( INTERLEAVE )
+      {
+         case OSSIM_BIP:
+         {
+            offset += INPUT_BAND * BYTES_PER_PIXEL;
+            break;
+         }
+         case OSSIM_BIL:
+         {
+            offset += INPUT_BAND * BYTES_PER_LINE;
+            break;
+         }
+         case OSSIM_BSQ:
+         {
+            offset += INPUT_BAND * BYTES_PER_LINE * m_rasterInfo.rawLines();
+            break;
+         }
+         case OSSIM_BSQ_MULTI_FILE:
+         {
+            if ( INPUT_BAND >= m_memoryMaps.size() )
+            {
+               return false;
+            }
+            map = m_memoryMaps[INPUT_BAND].get();
+            break;
+         }
+         default:
+         {
+            return false;
+         }
+      }
+
+      const ossim_uint64 LAST = offset + (HEIGHT - 1) * lineStride +
+         (WIDTH - 1) * sampleStride + BYTES_PER_PIXEL;
+      if ( LAST > map->size() )
+      {
+         return false;
+      }
+
+      const ossim_uint8* s = map->data() + offset;
+      ossim_uint8* d = static_cast<ossim_uint8*>( result->getBuf(band) ) +
+         ( (clip_rect.ul().y - TILE_RECT.ul().y) * TILE_WIDTH +
+           (clip_rect.ul().x - TILE_RECT.ul().x) ) * BYTES_PER_PIXEL;
+      for ( ossim_uint32 line = 0; line < HEIGHT; ++line )
+      {
+         if ( sampleStride == BYTES_PER_PIXEL )
+         {
+            memcpy( d, s, WIDTH * BYTES_PER_PIXEL );
+         }
+         else
+         {
+            for ( ossim_uint32 sample = 0; sample < WIDTH; ++sample )
+            {
+               memcpy( d + sample * BYTES_PER_PIXEL, s + sample * sampleStride, BYTES_PER_PIXEL );
+            }
+         }
+         if ( m_swapBytesFlag )
+         {
+            oe.swap(m_rasterInfo.getImageMetaData().getScalarType(), d, WIDTH);
+         }
+         s += lineStride;
+         d += TILE_WIDTH * BYTES_PER_PIXEL;
+      }
+   }
+   return true;
+}
+
 //*******************************************************************
 // Public method:
 //*******************************************************************
@@ -924,6 +1136,26 @@ bool ossimGeneralRasterTileSource::initializeHandler()
       // Check the file size (removed).
 
       m_fileStrList.push_back(is); // Add it to the list...
+
+      // Read ahead hints for prefetch; not an error if not supported.
+      ossimReadAhead* ra = new ossimReadAhead();
+      ra->open(f);
+      m_readAhead.push_back(ra);
+
+      if ( m_memoryMapFlag )
+      {
+         ossimRefPtr<ossimMemoryMappedFile> map = new ossimMemoryMappedFile();
+         if ( map->open(f) )
+         {
+            m_memoryMaps.push_back(map);
+         }
+      }
+   }
+
+   if ( m_memoryMaps.size() != aList.size() )
+   {
+      // All or nothing; the streams are used if any file could not be mapped.
+      m_memoryMaps.clear();
    }
 
    if ((aList.size()==1) && theImageFile.empty())
@@ -1012,6 +1244,43 @@ void ossimGeneralRasterTileSource::close()
       ++is;
    }
    m_fileStrList.clear();
+
+   for (ossim_uint32 i = 0; i < m_readAhead.size(); ++i)
+   {
+      delete m_readAhead[i];
+   }
+   m_readAhead.clear();
+
+   m_memoryMaps.clear();
+}
+
+void ossimGeneralRasterTileSource::setMemoryMapFlag(bool flag)
+{
+   m_memoryMapFlag = flag;
+}
+
+bool ossimGeneralRasterTileSource::getMemoryMapFlag() const
+{
+   return m_memoryMapFlag;
+}
+
+bool ossimGeneralRasterTileSource::hasConcurrentReads() const
+{
+   return ( m_memoryMaps.size() != 0 );
+}
+
+bool ossimGeneralRasterTileSource::getIoCounters(ossimIoCounters::Values& values) const
+{
+   bool result = ossimImageHandler::getIoCounters(values);
+   for (ossim_uint32 i = 0; i < m_fileStrList.size(); ++i)
+   {
+      if ( m_fileStrList[i].valid() )
+      {
+         values += m_fileStrList[i]->getIoCounters().getValues();
+         result = true;
+      }
+   }
+   return result;
 }
 
 ossim_uint32 ossimGeneralRasterTileSource::getImageTileWidth() const
@@ -72,10 +72,10 @@ void ossimGeoAnnotationMultiEllipseObject::transform(
 {
    const std::vector<ossimGpt>::size_type BOUNDS = thePointList.size();
    theProjectedObject->resize((ossim_uint32)BOUNDS);
-   for(std::vector<ossimGpt>::size_type i = 0; i < BOUNDS; ++i)
+   if(BOUNDS)
    {
-      projection->worldToLocal(thePointList[(int)i], (*theProjectedObject)[(int)i]);
-      
+      // One batch; the projected points are contiguous.
+      projection->worldToLocal(&thePointList[0], &(*theProjectedObject)[0], (ossim_uint32)BOUNDS);
    }
    computeBoundingRect();
 }
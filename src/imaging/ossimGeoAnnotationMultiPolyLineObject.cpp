@@ -99,26 +99,46 @@ void ossimGeoAnnotationMultiPolyLineObject::transform(ossimImageGeometry* projec
    std::vector<ossimPolyLine>& multiPolyLine =
       theProjectedPolyLineObject->getMultiPolyLine();
    ossimGpt tempPoint(0,0, ossim::nan(), theDatum);
+   const double TOLERANCE = getSimplifyTolerance();
+
+   //---
+   // Project the vertices of all the lines in one batch, through one
+   // contiguous array, rather than a point at a time.
+   //---
+   std::vector<ossim_uint32> starts(theMultiPolyLine.size() + 1, 0);
+   std::vector<ossimPolyLine>::size_type polyI;
+   for(polyI = 0; polyI < theMultiPolyLine.size(); ++polyI)
+   {
+      starts[polyI + 1] = starts[polyI] + theMultiPolyLine[polyI].getNumberOfVertices();
+   }
+   std::vector<ossimGpt> groundPts(starts.back(), tempPoint);
+   for(polyI = 0; polyI < theMultiPolyLine.size(); ++polyI)
+   {
+      const std::vector<ossimDpt>& vertices = theMultiPolyLine[polyI].getVertexList();
+      for(ossim_uint32 pointI = 0; pointI < vertices.size(); ++pointI)
+      {
+         groundPts[starts[polyI] + pointI].latd(vertices[pointI].lat);
+         groundPts[starts[polyI] + pointI].lond(vertices[pointI].lon);
+      }
+   }
+   std::vector<ossimDpt> localPts(groundPts.size());
+   if(groundPts.size())
+   {
+      projection->worldToLocal(&groundPts[0], &localPts[0], (ossim_uint32)groundPts.size());
+   }
    
-   for(std::vector<ossimPolyLine>::size_type polyI = 0;
-       polyI < theMultiPolyLine.size();
-       ++polyI)
+   for(polyI = 0; polyI < theMultiPolyLine.size(); ++polyI)
    {
-      ossimPolyLine polyLine;
-      
-      ossim_uint32 numberOfVertices =
-         theMultiPolyLine[polyI].getNumberOfVertices();
-      for(ossim_uint32 pointI = 0; pointI < numberOfVertices; ++pointI)
+      std::vector<ossimDpt>& vertices = multiPolyLine[polyI].getVertexList();
+      vertices.reserve(starts[polyI + 1] - starts[polyI]);
+      for(ossim_uint32 pointI = starts[polyI]; pointI < starts[polyI + 1]; ++pointI)
       {
-         tempPoint.latd(theMultiPolyLine[polyI][pointI].lat);
-         tempPoint.lond(theMultiPolyLine[polyI][pointI].lon);
-         ossimDpt temp;
-         projection->worldToLocal(tempPoint, temp);
-         if(!temp.hasNans())
+         if(!localPts[pointI].hasNans())
          {
-	    multiPolyLine[polyI].addPoint(temp);
+	    vertices.push_back(localPts[pointI]);
          }
       }
+      multiPolyLine[polyI].simplify(TOLERANCE);
       multiPolyLine[polyI].roundToIntegerBounds(true);
    }
 }
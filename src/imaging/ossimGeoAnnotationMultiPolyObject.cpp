@@ -93,23 +93,42 @@ void ossimGeoAnnotationMultiPolyObject::transform(ossimImageGeometry* projection
       return;
    }
 
-   ossimDpt temp;
-   std::vector<ossimPolygon> visiblePolygons;
+   //---
+   // Project the vertices of all the polygons in one batch, through one
+   // contiguous array, rather than a point at a time.
+   //---
+   std::vector<ossimGpt> groundPts;
+   std::vector<ossim_uint32> starts(theMultiPolygon.size() + 1, 0);
+   ossim_uint32 polyI;
+   for(polyI = 0; polyI < theMultiPolygon.size(); ++polyI)
+   {
+      starts[polyI + 1] = starts[polyI] + theMultiPolygon[polyI].size();
+   }
+   groundPts.reserve(starts.back());
+   for(polyI = 0; polyI < theMultiPolygon.size(); ++polyI)
+   {
+      const std::vector<ossimGpt>& vertices = theMultiPolygon[polyI].getVertexList();
+      groundPts.insert(groundPts.end(), vertices.begin(), vertices.end());
+   }
+   std::vector<ossimDpt> localPts(groundPts.size());
+   if(groundPts.size())
+   {
+      projection->worldToLocal(&groundPts[0], &localPts[0], (ossim_uint32)groundPts.size());
+   }
+
    ossimPolygon polygon;
-   for(ossim_uint32 polyI = 0; polyI < theMultiPolygon.size(); ++polyI)
+   const double TOLERANCE = getSimplifyTolerance();
+   for(polyI = 0; polyI < theMultiPolygon.size(); ++polyI)
    {
       polygon.clear();
-      for(ossim_uint32 pointI = 0;
-          pointI < theMultiPolygon[polyI].size();
-          ++pointI)
+      for(ossim_uint32 pointI = starts[polyI]; pointI < starts[polyI + 1]; ++pointI)
       {
-         projection->worldToLocal(theMultiPolygon[polyI][pointI],
-                                  temp);
-         if(!temp.hasNans())
+         if(!localPts[pointI].hasNans())
          {
-            polygon.addPoint(temp);
+            polygon.addPoint(localPts[pointI]);
          }
       }
+      polygon.simplify(TOLERANCE);
       theProjectedPolyObject->addPolygon(polyI, polygon);
    }
    
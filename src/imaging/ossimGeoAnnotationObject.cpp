@@ -9,6 +9,8 @@
 // $Id: ossimGeoAnnotationObject.cpp 9094 2006-06-13 19:12:40Z dburken $
 
 #include <ossim/imaging/ossimGeoAnnotationObject.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
 
 RTTI_DEF1(ossimGeoAnnotationObject,
           "ossimGeoAnnotationObject",
@@ -33,6 +35,23 @@ ossimGeoAnnotationObject::~ossimGeoAnnotationObject()
 {
 }
 
+double ossimGeoAnnotationObject::getSimplifyTolerance()
+{
+   static double tolerance = -1.0;
+   if(tolerance < 0.0)
+   {
+      double value = 0.5;
+      const char* lookup =
+         ossimPreferences::instance()->findPreference("geo_annotation.simplify_tolerance");
+      if(lookup)
+      {
+         value = ossimString(lookup).toFloat64();
+      }
+      tolerance = (value > 0.0) ? value : 0.0;
+   }
+   return tolerance;
+}
+
 bool ossimGeoAnnotationObject::saveState(ossimKeywordlist& kwl,
                                          const char* prefix) const
 {
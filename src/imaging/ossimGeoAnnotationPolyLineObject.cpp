@@ -95,9 +95,10 @@ void ossimGeoAnnotationPolyLineObject::transform(ossimImageGeometry* projection)
       
       const std::vector<ossimGpt>::size_type BOUNDS = thePolygon.size();
       
-      for(std::vector<ossimGpt>::size_type index=0; index < BOUNDS; ++index)
+      if(BOUNDS && (poly.size() >= BOUNDS))
       {
-         projection->worldToLocal(thePolygon[index], poly[index]);
+         // One batch; the projected vertices are contiguous.
+         projection->worldToLocal(&thePolygon[0], &poly[0], (ossim_uint32)BOUNDS);
       }
       
       // update the bounding rect
@@ -113,9 +113,10 @@ void ossimGeoAnnotationPolyObject::transform(ossimImageGeometry* projection)
    ossimPolygon& poly = theProjectedPolyObject->getPolygon();
    const std::vector<ossimGpt>::size_type BOUNDS = thePolygon.size();
    
-   for(std::vector<ossimGpt>::size_type index=0; index < BOUNDS; ++index)
+   if(BOUNDS && (poly.getVertexCount() >= BOUNDS))
    {
-      projection->worldToLocal(thePolygon[(int)index], poly[(int)index]);
+      // One batch; the projected vertices are contiguous.
+      projection->worldToLocal(&thePolygon[0], &poly[0], (ossim_uint32)BOUNDS);
    }
 
    // update the bounding rect
@@ -63,8 +63,21 @@ bool ossimGeoAnnotationSource::addObject(ossimAnnotationObject* anObject)
       ossimAnnotationSource::addObject(objectToAdd);
       if(m_geometry.valid())
       {
+         //---
+         // Only the new object is transformed and added to the bounds, so
+         // loading or editing large overlays stays linear.
+         //---
          objectToAdd->transform(m_geometry.get());
-         computeBoundingRect();
+         ossimDrect rect;
+         objectToAdd->getBoundingRect(rect);
+         if(theRectangle.hasNans())
+         {
+            theRectangle = rect;
+         }
+         else if(!rect.hasNans())
+         {
+            theRectangle = theRectangle.combine(rect);
+         }
       }
       return true;
    }
@@ -121,6 +134,7 @@ void ossimGeoAnnotationSource::computeBoundingRect()
 //   static const char *MODULE = "ossimAnnotationSource::computeBoundingRect";
    
    theRectangle.makeNan();
+   invalidateObjectIndex();
 
    if(theAnnotationObjectList.size()>0)
    {
@@ -65,41 +65,22 @@ ossimRefPtr<ossimImageData> ossimHistoMatchRemapper::getTile(
    ossim_uint32 numberOfBands = (ossim_uint32)theInputMeanPerBand.size();
 
    numberOfBands = numberOfBands>tile->getNumberOfBands()?tile->getNumberOfBands():numberOfBands;
-   double result = 0;
    if(isSourceEnabled())
    {
       long offsetBound = (long)(tile->getWidth()*tile->getHeight());
       if(tile->getScalarType() == OSSIM_UCHAR)
       {
+         if(theLuts.size() < numberOfBands)
+         {
+            buildLuts(numberOfBands);
+         }
          for(ossim_uint32 band = 0; band < numberOfBands; ++band)
          {
             unsigned char* buf = static_cast<unsigned char*>(tile->getBuf(band));
+            const ossim_uint8* lut = &theLuts[band].front();
             for(long offset=0; offset < offsetBound;++offset)
             {
-               // if the input has no deviation we will just
-               // do a shift to the target mean
-               if(fabs(theInputSigmaPerBand[band]) < FLT_EPSILON)
-               {
-                  result = transLean(buf[offset],
-                                     theInputMeanPerBand[band],
-                                     theTargetMeanPerBand[band],
-                                     0,
-                                     255);
-               }
-               else
-               {
-                  result = transLeanStretch(buf[offset],
-                                            theInputMeanPerBand[band],
-                                            theInputSigmaPerBand[band],
-                                            theTargetMeanPerBand[band],
-                                            theTargetSigmaPerBand[band],
-                                            0,
-                                            255);
-               }
-               result = ((result>255)?255:result);
-               result = ((result<0)?0:result);
-               
-               buf[offset] = (unsigned char)result;
+               buf[offset] = lut[buf[offset]];
             }
          }
       }
@@ -108,6 +89,43 @@ ossimRefPtr<ossimImageData> ossimHistoMatchRemapper::getTile(
    return tile;
 }
 
+void ossimHistoMatchRemapper::buildLuts(ossim_uint32 numberOfBands)
+{
+   double result = 0;
+   theLuts.resize(numberOfBands);
+   for(ossim_uint32 band = 0; band < numberOfBands; ++band)
+   {
+      theLuts[band].resize(256);
+      for(ossim_uint32 value = 0; value < 256; ++value)
+      {
+         // if the input has no deviation we will just
+         // do a shift to the target mean
+         if(fabs(theInputSigmaPerBand[band]) < FLT_EPSILON)
+         {
+            result = transLean(value,
+                               theInputMeanPerBand[band],
+                               theTargetMeanPerBand[band],
+                               0,
+                               255);
+         }
+         else
+         {
+            result = transLeanStretch(value,
+                                      theInputMeanPerBand[band],
+                                      theInputSigmaPerBand[band],
+                                      theTargetMeanPerBand[band],
+                                      theTargetSigmaPerBand[band],
+                                      0,
+                                      255);
+         }
+         result = ((result>255)?255:result);
+         result = ((result<0)?0:result);
+
+         theLuts[band][value] = (ossim_uint8)result;
+      }
+   }
+}
+
 void ossimHistoMatchRemapper::initialize()
 {
    if(!theInputConnection)
@@ -142,21 +160,25 @@ const vector<double>& ossimHistoMatchRemapper::getTargetSigmaValues()const
 void ossimHistoMatchRemapper::setInputMeanValues(const vector<double>& newValues)
 {
    theInputMeanPerBand = newValues;
+   theLuts.clear();
 }
 
 void ossimHistoMatchRemapper::setInputSigmaValues(const vector<double>& newValues)
 {
    theInputSigmaPerBand = newValues;
+   theLuts.clear();
 }
 
 void ossimHistoMatchRemapper::setTargetMeanValues(const vector<double>& newValues)
 {
    theTargetMeanPerBand = newValues;
+   theLuts.clear();
 }
 
 void ossimHistoMatchRemapper::setTargetSigmaValues(const vector<double>& newValues)
 {
    theTargetSigmaPerBand = newValues;
+   theLuts.clear();
 }
 
 double  ossimHistoMatchRemapper::transLean   // returns vOut
@@ -233,6 +255,7 @@ bool ossimHistoMatchRemapper::loadState(const ossimKeywordlist& kwl,
    theTargetSigmaPerBand.clear();
    theInputMeanPerBand.clear();
    theInputSigmaPerBand.clear();
+   theLuts.clear();
    ossim_uint32 result = kwl.getNumberOfSubstringKeys(ossimString(prefix) + "target_mean[0-9]");
    ossim_uint32 numberOfMatches=0;
    ossim_uint32 index=0;
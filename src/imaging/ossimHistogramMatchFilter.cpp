@@ -4,11 +4,190 @@
 #include <ossim/base/ossimVisitor.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/base/ossimHistogram.h>
+#include <ossim/base/ossimMultiBandHistogram.h>
+#include <ossim/base/ossimMultiResLevelHistogram.h>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <sstream>
+
+namespace
+{
+   // Largest number of input values a band table may hold.
+   const ossim_int64 MAX_LUT_SIZE = 65536;
+
+   /** Matched output of every input value from first, per band. */
+   template <class T> class ossimHistogramMatchLut : public ossimReferenced
+   {
+   public:
+      void apply(ossimImageData* tile) const
+      {
+         const ossim_uint32 bands = ossim::min(tile->getNumberOfBands(),
+                                               (ossim_uint32)theTables.size());
+         const ossim_uint32 size = tile->getWidth()*tile->getHeight();
+         const bool full = (tile->getDataObjectStatus() == OSSIM_FULL);
+         for (ossim_uint32 band = 0; band < bands; ++band)
+         {
+            T* buf = static_cast<T*>(tile->getBuf(band));
+            const T* table = &theTables[band].front();
+            const T first = theFirst[band];
+            const T last  = theLast[band];
+            const T nullPix = (T)tile->getNullPix(band);
+            for (ossim_uint32 i = 0; i < size; ++i)
+            {
+               if ( full || (buf[i] != nullPix) )
+               {
+                  // Values outside the input range take the end entries:
+                  const T v = (buf[i] < first) ? first : ((buf[i] > last) ? last : buf[i]);
+                  buf[i] = table[(ossim_int64)v - (ossim_int64)first];
+               }
+            }
+         }
+      }
+
+      std::vector<T> theFirst;
+      std::vector<T> theLast;
+      std::vector< std::vector<T> > theTables;
+   };
+
+   /** @return Cumulative fraction of histo's counts up to each bin; empty if no count. */
+   std::vector<ossim_float64> cumulativeFractions(const ossimHistogram* histo)
+   {
+      std::vector<ossim_float64> result;
+      const float* counts = histo->GetCounts();
+      const int bins = histo->GetRes();
+      if ( counts && (bins > 0) )
+      {
+         result.resize(bins);
+         ossim_float64 total = 0.0;
+         for (int i = 0; i < bins; ++i)
+         {
+            total += counts[i];
+            result[i] = total;
+         }
+         if ( total > 0.0 )
+         {
+            for (int i = 0; i < bins; ++i)
+            {
+               result[i] /= total;
+            }
+         }
+         else
+         {
+            result.clear();
+         }
+      }
+      return result;
+   }
+
+   /**
+    * Maps each value of [first, last] to the target value of the same
+    * cumulative fraction, the input taken at the middle of its bin's
+    * counts and the target bins interpolated linearly.
+    */
+   template <class T>
+   bool buildBandTable(const ossimHistogram* input, const ossimHistogram* target,
+                       T first, T last, std::vector<T>& table)
+   {
+      const std::vector<ossim_float64> inCdf  = cumulativeFractions(input);
+      const std::vector<ossim_float64> outCdf = cumulativeFractions(target);
+      if ( inCdf.empty() || outCdf.empty() )
+      {
+         return false;
+      }
+      const ossim_float64 outMin   = target->GetRangeMin();
+      const ossim_float64 outDelta = target->GetBucketSize();
+      table.resize((size_t)((ossim_int64)last - (ossim_int64)first + 1));
+      for (ossim_int64 v = first; v <= (ossim_int64)last; ++v)
+      {
+         ossim_float64 p = 0.0;
+         const int idx = input->GetIndex((float)v);
+         if ( idx >= 0 )
+         {
+            const ossim_float64 below = idx ? inCdf[idx - 1] : 0.0;
+            p = (below + inCdf[idx])/2.0;
+         }
+         else if ( v > input->GetRangeMin() )
+         {
+            p = 1.0;
+         }
+
+         // First target bin reaching p, skipping empty bins when p is 0:
+         std::vector<ossim_float64>::const_iterator bin = (p > 0.0) ?
+            std::lower_bound(outCdf.begin(), outCdf.end(), p) :
+            std::upper_bound(outCdf.begin(), outCdf.end(), 0.0);
+         if ( bin == outCdf.end() )
+         {
+            --bin;
+         }
+         const size_t j = bin - outCdf.begin();
+         const ossim_float64 below = j ? outCdf[j - 1] : 0.0;
+         ossim_float64 t = (outCdf[j] > below) ? (p - below)/(outCdf[j] - below) : 0.0;
+         t = ossim::max(0.0, ossim::min(t, 0.999999));
+         const ossim_float64 value = std::floor(outMin + (j + t)*outDelta);
+         table[(size_t)(v - (ossim_int64)first)] =
+            (value < first) ? first : ((value > last) ? last : (T)value);
+      }
+      return true;
+   }
+
+   template <class T>
+   ossimRefPtr<ossimReferenced> buildLut(T /* dummy */,
+                                         ossimImageSource* input,
+                                         const std::vector<ossim_uint32>& bandList,
+                                         const ossimMultiBandHistogram* inputHisto,
+                                         const ossimMultiBandHistogram* targetHisto)
+   {
+      ossimRefPtr< ossimHistogramMatchLut<T> > lut = new ossimHistogramMatchLut<T>;
+      const ossim_uint32 bands = input->getNumberOfOutputBands();
+      for (ossim_uint32 band = 0; band < bands; ++band)
+      {
+         const ossim_uint32 histoBand = (band < bandList.size()) ? bandList[band] : band;
+         if ( (histoBand >= inputHisto->getNumberOfBands()) ||
+              (histoBand >= targetHisto->getNumberOfBands()) )
+         {
+            return 0;
+         }
+         const ossimRefPtr<ossimHistogram> in  = inputHisto->getHistogram(histoBand);
+         const ossimRefPtr<ossimHistogram> out = targetHisto->getHistogram(histoBand);
+         const ossim_float64 minPix = input->getMinPixelValue(band);
+         const ossim_float64 maxPix = input->getMaxPixelValue(band);
+         if ( !in.valid() || !out.valid() || !(minPix <= maxPix) ||
+              (minPix < std::numeric_limits<T>::min()) ||
+              (maxPix > std::numeric_limits<T>::max()) ||
+              ((maxPix - minPix) >= MAX_LUT_SIZE) )
+         {
+            return 0;
+         }
+         lut->theFirst.push_back((T)minPix);
+         lut->theLast.push_back((T)maxPix);
+         lut->theTables.push_back(std::vector<T>());
+         if ( !buildBandTable(in.get(), out.get(), (T)minPix, (T)maxPix,
+                              lut->theTables.back()) )
+         {
+            return 0;
+         }
+      }
+      return lut.get();
+   }
+
+   // Tables shared by the filters matching the same histograms:
+   OpenThreads::Mutex theSharedLutMutex;
+   std::map< std::string, ossimRefPtr<ossimReferenced> > theSharedLuts;
+}
 
 RTTI_DEF1(ossimHistogramMatchFilter, "ossimHistogramMatchFilter", ossimImageSourceFilter);
 ossimHistogramMatchFilter::ossimHistogramMatchFilter()
    :ossimImageSourceFilter(),
-    theAutoLoadInputHistogramFlag(false)
+    theAutoLoadInputHistogramFlag(false),
+    theTile(0),
+    theMatchLuts(),
+    theMatchLutFlags()
 {
    theInputHistogramEqualizer = new ossimHistogramEqualization;
    theTargetHistogramEqualizer = new ossimHistogramEqualization;
@@ -23,7 +202,53 @@ ossimRefPtr<ossimImageData> ossimHistogramMatchFilter::getTile(const ossimIrect&
 {
    if(isSourceEnabled())
    {
-      return theTargetHistogramEqualizer->getTile(tileRect, resLevel);
+      ossimRefPtr<ossimReferenced> lut = getMatchLut(resLevel);
+      if ( !lut.valid() )
+      {
+         return theTargetHistogramEqualizer->getTile(tileRect, resLevel);
+      }
+      ossimRefPtr<ossimImageData> inputTile = theInputConnection->getTile(tileRect, resLevel);
+      if ( !inputTile.valid() ||
+           (inputTile->getDataObjectStatus() == OSSIM_NULL) ||
+           (inputTile->getDataObjectStatus() == OSSIM_EMPTY) )
+      {
+         return inputTile;
+      }
+      if ( !theTile.valid() )
+      {
+         theTile = ossimImageDataFactory::instance()->create(this, this);
+         theTile->initialize();
+      }
+      theTile->setImageRectangleAndBands(inputTile->getImageRectangle(),
+                                         inputTile->getNumberOfBands());
+      theTile->loadTile(inputTile.get());
+      theTile->setDataObjectStatus(inputTile->getDataObjectStatus());
+      switch(theTile->getScalarType())
+      {
+         case OSSIM_UINT8:
+            static_cast< ossimHistogramMatchLut<ossim_uint8>* >(lut.get())->apply(theTile.get());
+            break;
+         case OSSIM_SINT8:
+            static_cast< ossimHistogramMatchLut<ossim_sint8>* >(lut.get())->apply(theTile.get());
+            break;
+         case OSSIM_USHORT11:
+         case OSSIM_UINT16:
+            static_cast< ossimHistogramMatchLut<ossim_uint16>* >(lut.get())->apply(theTile.get());
+            break;
+         case OSSIM_SINT16:
+            static_cast< ossimHistogramMatchLut<ossim_sint16>* >(lut.get())->apply(theTile.get());
+            break;
+         case OSSIM_UINT32:
+            static_cast< ossimHistogramMatchLut<ossim_uint32>* >(lut.get())->apply(theTile.get());
+            break;
+         case OSSIM_SINT32:
+            static_cast< ossimHistogramMatchLut<ossim_sint32>* >(lut.get())->apply(theTile.get());
+            break;
+         default:
+            break;
+      }
+      theTile->validate();
+      return theTile;
    }
    if(theAutoLoadInputHistogramFlag&&
       (theInputHistogramFilename==""))
@@ -44,6 +269,7 @@ void ossimHistogramMatchFilter::setInputHistogram(const ossimFilename& inputHist
    theInputHistogramFilename = inputHistogram;
    theInputHistogramEqualizer->setHistogram(inputHistogram);
    theInputHistogramEqualizer->initialize();
+   clearMatchLuts();
 }
 
 void ossimHistogramMatchFilter::setTargetHistogram(const ossimFilename& targetHistogram)
@@ -51,6 +277,7 @@ void ossimHistogramMatchFilter::setTargetHistogram(const ossimFilename& targetHi
    theTargetHistogramFilename = targetHistogram;
    theTargetHistogramEqualizer->setHistogram(targetHistogram);
    theTargetHistogramEqualizer->initialize();
+   clearMatchLuts();
 }
 
 void ossimHistogramMatchFilter::connectInputEvent(ossimConnectionEvent& event)
@@ -68,6 +295,7 @@ void ossimHistogramMatchFilter::connectInputEvent(ossimConnectionEvent& event)
       theInputHistogramEqualizer->initialize();
       theTargetHistogramEqualizer->initialize();
    }
+   clearMatchLuts();
 }
 
 void ossimHistogramMatchFilter::disconnectInputEvent(ossimConnectionEvent& event)
@@ -85,6 +313,7 @@ void ossimHistogramMatchFilter::disconnectInputEvent(ossimConnectionEvent& event
       theInputHistogramEqualizer->initialize();
       theTargetHistogramEqualizer->initialize();
    }
+   clearMatchLuts();
 }
 
 void ossimHistogramMatchFilter::initialize()
@@ -100,6 +329,8 @@ void ossimHistogramMatchFilter::initialize()
 
    theInputHistogramEqualizer->initialize();
    theTargetHistogramEqualizer->initialize();
+   clearMatchLuts();
+   theTile = 0;
 }
 
 void ossimHistogramMatchFilter::setProperty(ossimRefPtr<ossimProperty> property)
@@ -256,3 +487,106 @@ void ossimHistogramMatchFilter::autoLoadInputHistogram()
       }
    }
 }
+
+ossimRefPtr<ossimReferenced> ossimHistogramMatchFilter::getMatchLut(ossim_uint32 resLevel)
+{
+   if ( resLevel >= theMatchLutFlags.size() )
+   {
+      theMatchLuts.resize(resLevel + 1);
+      theMatchLutFlags.resize(resLevel + 1, false);
+   }
+   if ( theMatchLutFlags[resLevel] )
+   {
+      return theMatchLuts[resLevel];
+   }
+   theMatchLutFlags[resLevel] = true;
+
+   ossimRefPtr<ossimMultiResLevelHistogram> inputHisto =
+      theInputHistogramEqualizer->getHistogram();
+   ossimRefPtr<ossimMultiResLevelHistogram> targetHisto =
+      theTargetHistogramEqualizer->getHistogram();
+   if ( !theInputConnection || !inputHisto.valid() || !targetHisto.valid() ||
+        !inputHisto->getNumberOfResLevels() || !targetHisto->getNumberOfResLevels() )
+   {
+      return 0;
+   }
+
+   // Overview levels match their own histograms when the files have them:
+   const ossim_uint32 level = ( (resLevel < inputHisto->getNumberOfResLevels()) &&
+                                (resLevel < targetHisto->getNumberOfResLevels()) ) ? resLevel : 0;
+   std::vector<ossim_uint32> bandList;
+   theInputConnection->getOutputBandList(bandList);
+   const ossimScalarType scalar = theInputConnection->getOutputScalarType();
+
+   std::ostringstream key;
+   key << theInputHistogramEqualizer->getHistogramFilename() << "|"
+       << theInputHistogramEqualizer->getHistogramFilename().fileSize() << "|"
+       << theTargetHistogramEqualizer->getHistogramFilename() << "|"
+       << theTargetHistogramEqualizer->getHistogramFilename().fileSize() << "|"
+       << scalar << "|" << level;
+   for (ossim_uint32 band = 0; band < theInputConnection->getNumberOfOutputBands(); ++band)
+   {
+      key << "|" << ((band < bandList.size()) ? bandList[band] : band)
+          << ":" << theInputConnection->getMinPixelValue(band)
+          << ":" << theInputConnection->getMaxPixelValue(band);
+   }
+
+   // Histograms set in memory, without a file, are not shared:
+   const bool shared = ( (theInputHistogramEqualizer->getHistogramFilename() != "") &&
+                         (theTargetHistogramEqualizer->getHistogramFilename() != "") );
+   if ( shared )
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theSharedLutMutex);
+      std::map< std::string, ossimRefPtr<ossimReferenced> >::const_iterator i =
+         theSharedLuts.find(key.str());
+      if ( i != theSharedLuts.end() )
+      {
+         theMatchLuts[resLevel] = i->second;
+         return theMatchLuts[resLevel];
+      }
+   }
+
+   const ossimMultiBandHistogram* in  = inputHisto->getMultiBandHistogram(level).get();
+   const ossimMultiBandHistogram* out = targetHisto->getMultiBandHistogram(level).get();
+   ossimRefPtr<ossimReferenced> lut;
+   if ( in && out )
+   {
+      switch(scalar)
+      {
+         case OSSIM_UINT8:
+            lut = buildLut((ossim_uint8)0, theInputConnection, bandList, in, out);
+            break;
+         case OSSIM_SINT8:
+            lut = buildLut((ossim_sint8)0, theInputConnection, bandList, in, out);
+            break;
+         case OSSIM_USHORT11:
+         case OSSIM_UINT16:
+            lut = buildLut((ossim_uint16)0, theInputConnection, bandList, in, out);
+            break;
+         case OSSIM_SINT16:
+            lut = buildLut((ossim_sint16)0, theInputConnection, bandList, in, out);
+            break;
+         case OSSIM_UINT32:
+            lut = buildLut((ossim_uint32)0, theInputConnection, bandList, in, out);
+            break;
+         case OSSIM_SINT32:
+            lut = buildLut((ossim_sint32)0, theInputConnection, bandList, in, out);
+            break;
+         default:
+            break;
+      }
+   }
+   if ( lut.valid() && shared )
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theSharedLutMutex);
+      theSharedLuts[key.str()] = lut;
+   }
+   theMatchLuts[resLevel] = lut;
+   return lut;
+}
+
+void ossimHistogramMatchFilter::clearMatchLuts()
+{
+   theMatchLuts.clear();
+   theMatchLutFlags.clear();
+}
@@ -24,6 +24,7 @@
 #include <ossim/imaging/ossimImageData.h>
 #include <cstdlib>
 #include <iomanip>
+#include <limits>
 
 RTTI_DEF1(ossimHistogramRemapper, "ossimHistogramRemapper", ossimTableRemapper)
 
@@ -44,6 +45,62 @@ static const char MAX_OUTPUT_VALUE_KW[] = "max_output_value";
 static const char STRETCH_MODE_KW[] = "stretch_mode";
 static const char HISTOGRAM_FILENAME_KW[] = "histogram_filename";
 
+// Stretch lookup tables kept:
+static const ossim_uint32 STRETCH_LUT_CACHE_SIZE = 16;
+
+namespace
+{
+   //---
+   // Stretch lookup table size and index of a value, for the types a table is made for.
+   //---
+   template <class T> struct ossimStretchLutIndex
+   {
+      enum { SIZE = 0 };
+      static ossim_uint32 index(T) { return 0; }
+   };
+   template <> struct ossimStretchLutIndex<ossim_uint8>
+   {
+      enum { SIZE = 256 };
+      static ossim_uint32 index(ossim_uint8 v) { return v; }
+   };
+   template <> struct ossimStretchLutIndex<ossim_uint16>
+   {
+      enum { SIZE = 65536 };
+      static ossim_uint32 index(ossim_uint16 v) { return v; }
+   };
+   template <> struct ossimStretchLutIndex<ossim_sint16>
+   {
+      enum { SIZE = 65536 };
+      static ossim_uint32 index(ossim_sint16 v) { return (ossim_uint32)(v + 32768); }
+   };
+
+   /** Linear stretch of a non-null input value, as applyLinearStretch does it. */
+   template <class T>
+   inline T stretchValue(ossim_float64 p,
+                         ossim_float64 minClipValue,
+                         ossim_float64 maxClipValue,
+                         ossim_float64 gain,
+                         T minPix,
+                         T maxPix)
+   {
+      if (p < minClipValue)
+      {
+         p = minPix;
+      }
+      else if (p > maxClipValue)
+      {
+         p = maxPix;
+      }
+      else
+      {
+         p = ((p - minClipValue) * gain) + minPix;
+      }
+      
+      // Final range check:
+      return static_cast<T>( p >= minPix ? ( p <= maxPix ? p : maxPix ) : minPix );
+   }
+}
+
 #ifdef OSSIM_ID_ENABLED
 static const char OSSIM_ID[] = "$Id: ossimHistogramRemapper.cpp 23182 2015-03-09 14:30:52Z okramer $";
 #endif
@@ -166,6 +223,7 @@ void ossimHistogramRemapper::setHistogram(ossimRefPtr<ossimMultiResLevelHistogra
    // Note: initializeClips before setNullCount since it relies on clips.
    initializeClips();
    theTable.clear();
+   theClipValues.clear();
    theDirtyFlag = true;
 }
 
@@ -343,12 +401,9 @@ template <class T> void ossimHistogramRemapper::applyLinearStretch(
       const T MIN_PIX  = static_cast<T>(theMinOutputValue[band]);
       const T MAX_PIX  = static_cast<T>(theMaxOutputValue[band]);
 
-      ossim_float64 min_clip_value =
-         h->LowClipVal(theNormalizedLowClipPoint[band]);
-      ossim_float64 max_clip_value =
-         h->HighClipVal(1.0-theNormalizedHighClipPoint[band]);
-      min_clip_value = floor(min_clip_value);
-      max_clip_value = ceil(max_clip_value);
+      ossim_float64 min_clip_value = 0.0;
+      ossim_float64 max_clip_value = 0.0;
+      getClipValues(band, h.get(), min_clip_value, max_clip_value);
       //ossim_float64 gain = (MAX_PIX-MIN_PIX+1)/(max_clip_value-min_clip_value);
       ossim_float64 gain = (MAX_PIX-MIN_PIX+1)/(max_clip_value-min_clip_value);
       // ossim_float64 distMin = fabs(min_clip_value - MIN_PIX);
@@ -358,31 +413,35 @@ template <class T> void ossimHistogramRemapper::applyLinearStretch(
       const ossim_uint32 PPB   = inputTile->getSizePerBand(); // pixels per band
 
       ossim_uint32 idx = 0;
-      for(idx = 0; idx < PPB;++idx)
+      if ( ossimStretchLutIndex<T>::SIZE > 0 )
       {
-         if ( bandPtr[idx] != NULL_PIX )
+         // Every value of the type has its entry, null included:
+         StretchKey key;
+         key.theScalarType   = theOutputScalarType;
+         key.theMinClipValue = min_clip_value;
+         key.theMaxClipValue = max_clip_value;
+         key.theMinPix       = MIN_PIX;
+         key.theMaxPix       = MAX_PIX;
+         key.theNullPix      = NULL_PIX;
+         const T* lut = getStretchLut<T>(key, gain);
+         for(idx = 0; idx < PPB;++idx)
          {
-            ossim_float64 p = bandPtr[idx];
-            if (p < min_clip_value)
-            {
-               p = MIN_PIX;
-            }
-            else if (p > max_clip_value)
+            outputPtr[idx] = lut[ossimStretchLutIndex<T>::index(bandPtr[idx])];
+         }
+      }
+      else
+      {
+         for(idx = 0; idx < PPB;++idx)
+         {
+            if ( bandPtr[idx] != NULL_PIX )
             {
-               p = MAX_PIX;
+               outputPtr[idx] = stretchValue<T>(bandPtr[idx], min_clip_value, max_clip_value,
+                                                gain, MIN_PIX, MAX_PIX);
             }
             else
             {
-               p = ((p - min_clip_value) * gain) + MIN_PIX;// - 1.0;
+               outputPtr[idx] = NULL_PIX;
             }
-
-            // Final range check:
-            outputPtr[idx] =
-               static_cast<T>( p >= MIN_PIX ? ( p <= MAX_PIX ? p : MAX_PIX ) : MIN_PIX );
-         }
-         else
-         {
-            outputPtr[idx] = NULL_PIX;
          }
       }
 
@@ -390,6 +449,91 @@ template <class T> void ossimHistogramRemapper::applyLinearStretch(
 
 }
 
+bool ossimHistogramRemapper::StretchKey::operator<(const StretchKey& rhs) const
+{
+   if (theScalarType != rhs.theScalarType)
+      return theScalarType < rhs.theScalarType;
+   if (theMinClipValue != rhs.theMinClipValue)
+      return theMinClipValue < rhs.theMinClipValue;
+   if (theMaxClipValue != rhs.theMaxClipValue)
+      return theMaxClipValue < rhs.theMaxClipValue;
+   if (theMinPix != rhs.theMinPix)
+      return theMinPix < rhs.theMinPix;
+   if (theMaxPix != rhs.theMaxPix)
+      return theMaxPix < rhs.theMaxPix;
+   return theNullPix < rhs.theNullPix;
+}
+
+void ossimHistogramRemapper::getClipValues(ossim_uint32 band,
+                                           const ossimHistogram* h,
+                                           ossim_float64& minClipValue,
+                                           ossim_float64& maxClipValue)
+{
+   if (band >= theClipValues.size())
+   {
+      ClipValues unset;
+      unset.theHistogram = 0;
+      unset.theNormalizedLowClipPoint  = 0.0;
+      unset.theNormalizedHighClipPoint = 0.0;
+      unset.theMinClipValue = 0.0;
+      unset.theMaxClipValue = 0.0;
+      theClipValues.resize(band + 1, unset);
+   }
+
+   ClipValues& clips = theClipValues[band];
+   if ( (clips.theHistogram != h) ||
+        (clips.theNormalizedLowClipPoint  != theNormalizedLowClipPoint[band]) ||
+        (clips.theNormalizedHighClipPoint != theNormalizedHighClipPoint[band]) )
+   {
+      clips.theHistogram = h;
+      clips.theNormalizedLowClipPoint  = theNormalizedLowClipPoint[band];
+      clips.theNormalizedHighClipPoint = theNormalizedHighClipPoint[band];
+      clips.theMinClipValue = floor(h->LowClipVal(theNormalizedLowClipPoint[band]));
+      clips.theMaxClipValue = ceil(h->HighClipVal(1.0-theNormalizedHighClipPoint[band]));
+   }
+   minClipValue = clips.theMinClipValue;
+   maxClipValue = clips.theMaxClipValue;
+}
+
+template <class T> const T* ossimHistogramRemapper::getStretchLut(const StretchKey& key,
+                                                                  ossim_float64 gain)
+{
+   if ( ossimStretchLutIndex<T>::SIZE == 0 )
+   {
+      return 0;
+   }
+   
+   std::map<StretchKey, vector<ossim_uint8> >::const_iterator i = theStretchLuts.find(key);
+   if (i != theStretchLuts.end())
+   {
+      return reinterpret_cast<const T*>(&i->second.front());
+   }
+
+   if (theStretchLutOrder.size() >= STRETCH_LUT_CACHE_SIZE)
+   {
+      theStretchLuts.erase(theStretchLutOrder.front());
+      theStretchLutOrder.pop_front();
+   }
+   theStretchLutOrder.push_back(key);
+   
+   const T NULL_PIX = static_cast<T>(key.theNullPix);
+   const T MIN_PIX  = static_cast<T>(key.theMinPix);
+   const T MAX_PIX  = static_cast<T>(key.theMaxPix);
+   
+   vector<ossim_uint8>& bytes = theStretchLuts[key];
+   bytes.resize( ossimStretchLutIndex<T>::SIZE * sizeof(T) );
+   T* lut = reinterpret_cast<T*>(&bytes.front());
+   const ossim_int32 MIN_VALUE = std::numeric_limits<T>::min();
+   for (ossim_int32 value = MIN_VALUE; value < MIN_VALUE + ossimStretchLutIndex<T>::SIZE; ++value)
+   {
+      const T p = static_cast<T>(value);
+      lut[ossimStretchLutIndex<T>::index(p)] =
+         (p != NULL_PIX) ? stretchValue<T>(p, key.theMinClipValue, key.theMaxClipValue,
+                                           gain, MIN_PIX, MAX_PIX) : NULL_PIX;
+   }
+   return lut;
+}
+
 void ossimHistogramRemapper::setLowNormalizedClipPoint(const ossim_float64& clip)
 {
    const ossim_uint32 BANDS = getNumberOfInputBands();
@@ -1946,6 +2090,19 @@ void ossimHistogramRemapper::verifyEnabled()
    }
 }
 
+void ossimHistogramRemapper::shareReadOnlyState(ossimImageSource* source)
+{
+   //---
+   // The histogram only feeds the remap table build, which reads it. Drop the copy loaded from
+   // the state and reference the original's. The table itself stays per object.
+   //---
+   ossimHistogramRemapper* original = PTR_CAST(ossimHistogramRemapper, source);
+   if ( original && (original != this) && original->theHistogram.valid() )
+   {
+      theHistogram = original->theHistogram;
+   }
+}
+
 ossimRefPtr<ossimMultiResLevelHistogram> ossimHistogramRemapper::getHistogram()
 {
    return ossimRefPtr<ossimMultiResLevelHistogram>(theHistogram.get());
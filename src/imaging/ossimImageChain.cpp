@@ -11,6 +11,7 @@
 // $Id: ossimImageChain.cpp 21850 2012-10-21 20:09:55Z dburken $
 
 #include <ossim/imaging/ossimImageChain.h>
+#include <ossim/imaging/ossimDeferredInitializeScope.h>
 #include <ossim/base/ossimCommon.h>
 #include <ossim/base/ossimConnectableContainer.h>
 #include <ossim/base/ossimDrect.h>
@@ -1476,6 +1477,9 @@ bool ossimImageChain::loadState(const ossimKeywordlist& kwl,
    
    theLoadStateFlag = true;
    bool result = true;
+
+   // Each add and connect fires events; initialize every source once at the end:
+   ossimDeferredInitializeScope deferInitialize;
    
    map<ossimId, vector<ossimId> > idMapping;
    result = addAllSources(idMapping, kwl, prefix);
@@ -1494,6 +1498,94 @@ bool ossimImageChain::loadState(const ossimKeywordlist& kwl,
 }
 
 
+ossimImageSource* ossimImageChain::cloneSource() const
+{
+   // Derived chains hold more state than the children:
+   if ( getClassName() != "ossimImageChain" )
+   {
+      return ossimImageSource::cloneSource();
+   }
+
+   const ossimConnectableObject::ConnectableObjectList& children = imageChainList();
+   const ossim_uint32 N = (ossim_uint32)children.size();
+   std::vector< ossimRefPtr<ossimConnectableObject> > clones(N);
+   std::map<const ossimConnectableObject*, ossim_uint32> childIndex;
+   for ( ossim_uint32 idx = 0; idx < N; ++idx )
+   {
+      const ossimConnectableObject* child = children[idx].get();
+      if ( !child )
+      {
+         return 0;
+      }
+      const ossimImageSource* source = dynamic_cast<const ossimImageSource*>( child );
+      if ( source )
+      {
+         clones[idx] = source->cloneSource();
+      }
+      else
+      {
+         clones[idx] = dynamic_cast<ossimConnectableObject*>( child->dup() );
+      }
+      if ( !clones[idx].valid() )
+      {
+         if (traceDebug())
+         {
+            ossimNotify(ossimNotifyLevel_DEBUG)
+               << "ossimImageChain::cloneSource: could not clone "
+               << child->getClassName() << std::endl;
+         }
+         return 0;
+      }
+      childIndex.insert( std::make_pair( child, idx ) );
+   }
+
+   ossimDeferredInitializeScope deferInitialize;
+   ossimRefPtr<ossimImageChain> result = new ossimImageChain;
+   copySourceSettings( result.get() );
+
+   // add() puts each in front, connected to the previous head:
+   for ( ossim_int32 idx = (ossim_int32)N - 1; idx >= 0; --idx )
+   {
+      result->add( clones[idx].get() );
+   }
+
+   // Then connect every input as the originals are in one pass, which also
+   // covers children with several inputs:
+   for ( ossim_uint32 idx = 0; idx < N; ++idx )
+   {
+      const ossimConnectableObject* child = children[idx].get();
+      const ossim_uint32 INPUTS = child->getNumberOfInputs();
+      for ( ossim_uint32 in = 0; in < INPUTS; ++in )
+      {
+         std::map<const ossimConnectableObject*, ossim_uint32>::const_iterator input =
+            childIndex.find( child->getInput(in) );
+         if ( input != childIndex.end() )
+         {
+            if ( clones[idx]->getInput(in) != clones[input->second].get() )
+            {
+               clones[idx]->connectMyInputTo( (ossim_int32)in, clones[input->second].get() );
+            }
+         }
+         else if ( clones[idx]->getInput(in) )
+         {
+            clones[idx]->disconnectMyInput( (ossim_int32)in );
+         }
+      }
+   }
+
+   return result.release();
+}
+
+ossimObject* ossimImageChain::dup() const
+{
+   ossimObject* result = cloneSource();
+   if ( !result )
+   {
+      result = ossimImageSource::dup();
+   }
+   return result;
+}
+
 void ossimImageChain::initialize()
 {
    static const char* MODULE = "ossimImageChain::initialize()";
@@ -1671,7 +1763,7 @@ void ossimImageChain::connectInputEvent(ossimConnectionEvent& event)
 //            theInputObjectList = imageChainList()[0]->getInputList();
          }
       }
-      initialize();
+      requestInitialize();
    }
 }
 
@@ -10,10 +10,21 @@
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimIrect.h>
 #include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/base/ossimTrace.h>
+#include <ossim/base/ossimVisitor.h>
+#include <ossim/parallel/ossimJob.h>
+#include <algorithm>
+#include <cmath>
 
 using namespace std;
 
+// Fewer inputs than this are all tested without the grid index.
+static const ossim_uint32 MIN_INDEXED_INPUTS = 8;
+
+// An input covering more grid cells than this goes to theLargeInputs.
+static const ossim_int64 MAX_INDEX_CELLS_PER_INPUT = 64;
+
 RTTI_DEF2(ossimImageCombiner, "ossimImageCombiner", ossimImageSource, ossimConnectableObjectListener)
 static ossimTrace traceDebug ("ossimImageCombiner:debug");
 
@@ -27,7 +38,18 @@ ossimImageCombiner::ossimImageCombiner()
     theInputToPassThrough(0),
     theHasDifferentInputs(false),
     theNormTile(NULL),
-    theCurrentIndex(0)
+    theCurrentIndex(0),
+    theBoundsIndex(),
+    theLargeInputs(),
+    theBoundsIndexCellSize(0),
+    theCandidateRect(),
+    theCandidateResLevel(0),
+    theCandidates(),
+    theMaxOpenHandlers(0),
+    theInputHandlers(),
+    theInputEntries(),
+    theInputBands(),
+    theOpenHandlers()
 {
 	theComputeFullResBoundsFlag = true;
    // until something is set we will just set the blank tile
@@ -48,7 +70,18 @@ ossimImageCombiner::ossimImageCombiner(ossimObject* owner,
     theInputToPassThrough(0),
     theHasDifferentInputs(false),
     theNormTile(NULL),
-    theCurrentIndex(0)
+    theCurrentIndex(0),
+    theBoundsIndex(),
+    theLargeInputs(),
+    theBoundsIndexCellSize(0),
+    theCandidateRect(),
+    theCandidateResLevel(0),
+    theCandidates(),
+    theMaxOpenHandlers(0),
+    theInputHandlers(),
+    theInputEntries(),
+    theInputBands(),
+    theOpenHandlers()
 {
    addListener((ossimConnectableObjectListener*)this);
    theComputeFullResBoundsFlag = true;
@@ -64,7 +97,18 @@ ossimImageCombiner::ossimImageCombiner(ossimConnectableObject::ConnectableObject
                      theInputToPassThrough(0),
                      theHasDifferentInputs(false),
                      theNormTile(NULL),
-                     theCurrentIndex(0)
+                     theCurrentIndex(0),
+                     theBoundsIndex(),
+                     theLargeInputs(),
+                     theBoundsIndexCellSize(0),
+                     theCandidateRect(),
+                     theCandidateResLevel(0),
+                     theCandidates(),
+                     theMaxOpenHandlers(0),
+                     theInputHandlers(),
+                     theInputEntries(),
+                     theInputBands(),
+                     theOpenHandlers()
 {
 	theComputeFullResBoundsFlag = true;
    for(ossim_uint32 index = 0; index < inputSources.size(); ++index)
@@ -380,12 +424,26 @@ ossimRefPtr<ossimImageData> ossimImageCombiner::getNextTile(ossim_uint32& return
 ossimRefPtr<ossimImageData> ossimImageCombiner::getNextTile(ossim_uint32& returnedIdx,
                                                             const ossimIrect& tileRect,
                                                             ossim_uint32 resLevel)
+{
+   return getNextTile(returnedIdx, tileRect, tileRect, resLevel);
+}
+
+ossimRefPtr<ossimImageData> ossimImageCombiner::getNextTile(ossim_uint32& returnedIdx,
+                                                            const ossimIrect& tileRect,
+                                                            const ossimIrect& neededRect,
+                                                            ossim_uint32 resLevel)
 {
    ossim_uint32 size = getNumberOfInputs();
    if ( theCurrentIndex >= size)
    {
       return 0;
    }
+
+   // Stop layering if the job we are run for was canceled.
+   if ( ossimJob::isCurrentJobCanceled() )
+   {
+      return 0;
+   }
    
    if(theComputeFullResBoundsFlag)
    {
@@ -399,8 +457,16 @@ ossimRefPtr<ossimImageData> ossimImageCombiner::getNextTile(ossim_uint32& return
    double scale = 1.0/std::pow(2.0, (double)resLevel);
    ossimDpt scalar(scale, scale);
 
-   while( (theCurrentIndex<size) && !result)
+   // Only the inputs the index says may overlap the tile, from theCurrentIndex on:
+   const std::vector<ossim_uint32>& candidates = getCandidateInputs(tileRect, resLevel);
+   std::vector<ossim_uint32>::const_iterator candidate =
+      std::lower_bound(candidates.begin(), candidates.end(), theCurrentIndex);
+   
+   while( (candidate != candidates.end()) && !result)
    {
+      theCurrentIndex = *candidate;
+      ++candidate;
+      
       ossimIrect rect = theFullResBounds[theCurrentIndex];
       if(!rect.hasNans())
       {
@@ -408,8 +474,9 @@ ossimRefPtr<ossimImageData> ossimImageCombiner::getNextTile(ossim_uint32& return
          temp = PTR_CAST(ossimImageSource,
                          getInput(theCurrentIndex));
          
-         if(rect.intersects(tileRect)&&temp)
+         if(rect.intersects(neededRect)&&temp)
          {
+            openInputHandler(theCurrentIndex);
             result = temp->getTile(tileRect, resLevel);
             status = (result.valid() ?
                       result->getDataObjectStatus():OSSIM_NULL);
@@ -434,6 +501,10 @@ ossimRefPtr<ossimImageData> ossimImageCombiner::getNextTile(ossim_uint32& return
       // Go to next source.
       ++theCurrentIndex;
    }
+   if(!result)
+   {
+      theCurrentIndex = size;
+   }
    returnedIdx = theCurrentIndex;
    if(result.valid())
    {
@@ -454,6 +525,8 @@ bool ossimImageCombiner::getNextTile(ossim_uint32& returnedIdx,
 
    ossim_uint32 size = getNumberOfInputs();
    theCurrentIndex = startIdx;
+   if ( ossimJob::isCurrentJobCanceled() )
+      return false;
 
    if(theComputeFullResBoundsFlag)
       precomputeBounds();
@@ -464,8 +537,16 @@ bool ossimImageCombiner::getNextTile(ossim_uint32& returnedIdx,
    double scale = 1.0/std::pow(2.0, (double)resLevel);
    ossimDpt scalar(scale, scale);
 
-   while( (theCurrentIndex<size))
+   const ossimIrect tileRect = tile->getImageRectangle();
+   const std::vector<ossim_uint32>& candidates = getCandidateInputs(tileRect, resLevel);
+   std::vector<ossim_uint32>::const_iterator candidate =
+      std::lower_bound(candidates.begin(), candidates.end(), theCurrentIndex);
+   
+   while( (candidate != candidates.end()) )
    {
+      theCurrentIndex = *candidate;
+      ++candidate;
+      
       ossimIrect rect = theFullResBounds[theCurrentIndex];
       if(!rect.hasNans())
       {
@@ -473,8 +554,9 @@ bool ossimImageCombiner::getNextTile(ossim_uint32& returnedIdx,
          temp = PTR_CAST(ossimImageSource,
                          getInput(theCurrentIndex));
 
-         if(rect.intersects(tile->getImageRectangle()) && temp)
+         if(rect.intersects(tileRect) && temp)
          {
+            openInputHandler(theCurrentIndex);
             temp->getTile(tile, resLevel);
             status = tile->getDataObjectStatus();
             if((status != OSSIM_NULL) && (status != OSSIM_EMPTY))
@@ -483,9 +565,10 @@ bool ossimImageCombiner::getNextTile(ossim_uint32& returnedIdx,
             }
          }
       }
-
-      // Go to next source.
-      ++theCurrentIndex;
+   }
+   if((status == OSSIM_NULL) || (status == OSSIM_EMPTY))
+   {
+      theCurrentIndex = size;
    }
 
    returnedIdx = theCurrentIndex;
@@ -536,6 +619,14 @@ ossimRefPtr<ossimImageData> ossimImageCombiner::getNextNormTile(ossim_uint32& re
 ossimRefPtr<ossimImageData> ossimImageCombiner::getNextNormTile(ossim_uint32& returnedIdx,
                                                                 const ossimIrect& tileRect,
                                                                 ossim_uint32 resLevel)
+{
+   return getNextNormTile(returnedIdx, tileRect, tileRect, resLevel);
+}
+
+ossimRefPtr<ossimImageData> ossimImageCombiner::getNextNormTile(ossim_uint32& returnedIdx,
+                                                                const ossimIrect& tileRect,
+                                                                const ossimIrect& neededRect,
+                                                                ossim_uint32 resLevel)
 {
    ossim_uint32 size = getNumberOfInputs();
 
@@ -551,7 +642,7 @@ ossimRefPtr<ossimImageData> ossimImageCombiner::getNextNormTile(ossim_uint32& re
       theNormTile->initialize();
    }
 
-   ossimRefPtr<ossimImageData> result = getNextTile(returnedIdx, tileRect, resLevel);
+   ossimRefPtr<ossimImageData> result = getNextTile(returnedIdx, tileRect, neededRect, resLevel);
 
    if(result.valid())
    {
@@ -576,9 +667,10 @@ ossim_uint32 ossimImageCombiner::getNumberOfOverlappingImages(const ossimIrect&
    double scale = 1.0/std::pow(2.0, (double)resLevel);
    ossimDpt scalar(scale, scale);
    ossim_uint32 result = 0;
-   ossim_uint32 maxIndex = getNumberOfInputs();
-   for(ossim_uint32 inputIndex = 0; inputIndex < maxIndex; ++inputIndex)
+   const std::vector<ossim_uint32>& candidates = getCandidateInputs(rect, resLevel);
+   for(ossim_uint32 i = 0; i < candidates.size(); ++i)
    {
+      const ossim_uint32 inputIndex = candidates[i];
       if(!theFullResBounds[inputIndex].hasNans())
       {
          ossimIrect boundingRect = theFullResBounds[inputIndex] * scalar;
@@ -603,10 +695,11 @@ void ossimImageCombiner::getOverlappingImages(std::vector<ossim_uint32>& result,
    double scale = 1.0/std::pow(2.0, (double)resLevel);
    ossimDpt scalar(scale, scale);
    
-   ossim_uint32 inputIndex;
    ossimIrect boundingRect;
-   for(inputIndex = 0; inputIndex < getNumberOfInputs(); ++inputIndex)
+   const std::vector<ossim_uint32>& candidates = getCandidateInputs(rect, resLevel);
+   for(ossim_uint32 i = 0; i < candidates.size(); ++i)
    {
+      const ossim_uint32 inputIndex = candidates[i];
       if(!theFullResBounds[inputIndex].hasNans())
       {
          boundingRect = theFullResBounds[inputIndex]*scalar;
@@ -620,22 +713,22 @@ void ossimImageCombiner::getOverlappingImages(std::vector<ossim_uint32>& result,
 
 void ossimImageCombiner::connectInputEvent(ossimConnectionEvent& /* event */)
 {
-   initialize();
+   requestInitialize();
 }
 
 void ossimImageCombiner::disconnectInputEvent(ossimConnectionEvent& /* event */)
 { 
-   initialize();
+   requestInitialize();
 }
 
 void ossimImageCombiner::propertyEvent(ossimPropertyEvent& /* event */)
 {
-   initialize();
+   requestInitialize();
 }
 
 void ossimImageCombiner::refreshEvent(ossimRefreshEvent& /* event */)
 {
-   initialize();
+   requestInitialize();
 }
 
 bool ossimImageCombiner::hasDifferentInputs()const
@@ -667,11 +760,16 @@ void ossimImageCombiner::precomputeBounds()const
       {
          theFullResBounds.resize(inputSize);
       }
+      if(theMaxOpenHandlers && (theInputHandlers.size() != inputSize))
+      {
+         findInputHandlers();
+      }
       for(ossim_uint32 inputIndex = 0; inputIndex < inputSize; ++inputIndex)
       {
          tempInterface = PTR_CAST(ossimImageSource, getInput(inputIndex));
          if(tempInterface)
          {
+            openInputHandler(inputIndex);
             theFullResBounds[inputIndex] = tempInterface->getBoundingRect();
          }
          else
@@ -685,4 +783,241 @@ void ossimImageCombiner::precomputeBounds()const
    {
       theFullResBounds.clear();
    }
+   buildBoundsIndex();
+}
+
+void ossimImageCombiner::buildBoundsIndex()const
+{
+   theBoundsIndex.clear();
+   theLargeInputs.clear();
+   theBoundsIndexCellSize = 0;
+   theCandidateRect.makeNan();
+   theCandidates.clear();
+
+   const ossim_uint32 inputSize = (ossim_uint32)theFullResBounds.size();
+   if(inputSize < MIN_INDEXED_INPUTS)
+   {
+      return;
+   }
+
+   // Cells the size of an average input:
+   ossim_float64 sum = 0.0;
+   ossim_uint32 count = 0;
+   ossim_uint32 inputIndex;
+   for(inputIndex = 0; inputIndex < inputSize; ++inputIndex)
+   {
+      const ossimIrect& rect = theFullResBounds[inputIndex];
+      if(!rect.hasNans())
+      {
+         sum += std::max(rect.width(), rect.height());
+         ++count;
+      }
+   }
+   if(!count)
+   {
+      return;
+   }
+   theBoundsIndexCellSize = std::max((ossim_int32)(sum / count), (ossim_int32)1);
+   const ossim_float64 cellSize = theBoundsIndexCellSize;
+
+   for(inputIndex = 0; inputIndex < inputSize; ++inputIndex)
+   {
+      const ossimIrect& rect = theFullResBounds[inputIndex];
+      if(rect.hasNans())
+      {
+         continue;
+      }
+      ossim_int32 r0 = (ossim_int32)std::floor(rect.ul().y / cellSize);
+      ossim_int32 r1 = (ossim_int32)std::floor(rect.lr().y / cellSize);
+      ossim_int32 c0 = (ossim_int32)std::floor(rect.ul().x / cellSize);
+      ossim_int32 c1 = (ossim_int32)std::floor(rect.lr().x / cellSize);
+      if((ossim_int64)(r1 - r0 + 1) * (c1 - c0 + 1) > MAX_INDEX_CELLS_PER_INPUT)
+      {
+         theLargeInputs.push_back(inputIndex);
+         continue;
+      }
+      for(ossim_int32 r = r0; r <= r1; ++r)
+      {
+         for(ossim_int32 c = c0; c <= c1; ++c)
+         {
+            theBoundsIndex[IndexKey(r, c)].push_back(inputIndex);
+         }
+      }
+   }
+}
+
+const std::vector<ossim_uint32>& ossimImageCombiner::getCandidateInputs(
+   const ossimIrect& rect, ossim_uint32 resLevel)const
+{
+   if(theComputeFullResBoundsFlag)
+   {
+      precomputeBounds();
+   }
+   if(!theCandidateRect.hasNans() && (resLevel == theCandidateResLevel) &&
+      (rect == theCandidateRect))
+   {
+      return theCandidates;
+   }
+   
+   theCandidates.clear();
+   theCandidateRect = rect;
+   theCandidateResLevel = resLevel;
+   
+   const ossim_uint32 inputSize = (ossim_uint32)theFullResBounds.size();
+   if(!theBoundsIndexCellSize || rect.hasNans())
+   {
+      // Not indexed, every input is a candidate.
+      theCandidates.resize(inputSize);
+      for(ossim_uint32 inputIndex = 0; inputIndex < inputSize; ++inputIndex)
+      {
+         theCandidates[inputIndex] = inputIndex;
+      }
+      if(rect.hasNans())
+      {
+         theCandidateRect.makeNan();
+      }
+      return theCandidates;
+   }
+
+   // Full res rect, a pixel of resLevel larger all around for the rounding of bounds * scale:
+   const ossim_float64 scale = std::pow(2.0, (double)resLevel);
+   const ossim_float64 cellSize = theBoundsIndexCellSize;
+   ossim_int32 r0 = (ossim_int32)std::floor((rect.ul().y - 1) * scale / cellSize);
+   ossim_int32 r1 = (ossim_int32)std::floor((rect.lr().y + 1) * scale / cellSize);
+   ossim_int32 c0 = (ossim_int32)std::floor((rect.ul().x - 1) * scale / cellSize);
+   ossim_int32 c1 = (ossim_int32)std::floor((rect.lr().x + 1) * scale / cellSize);
+
+   theCandidates = theLargeInputs;
+   if((ossim_int64)(r1 - r0 + 1) * (c1 - c0 + 1) < (ossim_int64)theBoundsIndex.size())
+   {
+      for(ossim_int32 r = r0; r <= r1; ++r)
+      {
+         for(ossim_int32 c = c0; c <= c1; ++c)
+         {
+            std::map<IndexKey, std::vector<ossim_uint32> >::const_iterator i =
+               theBoundsIndex.find(IndexKey(r, c));
+            if(i != theBoundsIndex.end())
+            {
+               theCandidates.insert(theCandidates.end(), (*i).second.begin(), (*i).second.end());
+            }
+         }
+      }
+   }
+   else
+   {
+      // Rect covers most of the grid (e.g. a reduced res level), walk the cells instead.
+      std::map<IndexKey, std::vector<ossim_uint32> >::const_iterator i = theBoundsIndex.begin();
+      for( ; i != theBoundsIndex.end(); ++i)
+      {
+         const IndexKey& key = (*i).first;
+         if((key.first >= r0) && (key.first <= r1) && (key.second >= c0) && (key.second <= c1))
+         {
+            theCandidates.insert(theCandidates.end(), (*i).second.begin(), (*i).second.end());
+         }
+      }
+   }
+   std::sort(theCandidates.begin(), theCandidates.end());
+   theCandidates.erase(std::unique(theCandidates.begin(), theCandidates.end()),
+                       theCandidates.end());
+   return theCandidates;
+}
+
+void ossimImageCombiner::setMaxOpenHandlers(ossim_uint32 count)
+{
+   theMaxOpenHandlers = count;
+   theInputHandlers.clear();
+   theInputEntries.clear();
+   theInputBands.clear();
+   theOpenHandlers.clear();
+   if(theMaxOpenHandlers)
+   {
+      findInputHandlers();
+
+      // Close all but the first count open ones now:
+      for(ossim_uint32 inputIndex = (ossim_uint32)theInputHandlers.size(); inputIndex > 0; --inputIndex)
+      {
+         if(theInputHandlers[inputIndex - 1].valid() && theInputHandlers[inputIndex - 1]->isOpen())
+         {
+            openInputHandler(inputIndex - 1);
+         }
+      }
+   }
+}
+
+ossim_uint32 ossimImageCombiner::getMaxOpenHandlers()const
+{
+   return theMaxOpenHandlers;
+}
+
+void ossimImageCombiner::findInputHandlers()const
+{
+   const ossim_uint32 inputSize = getNumberOfInputs();
+   theInputHandlers.assign(inputSize, ossimRefPtr<ossimImageHandler>());
+   theInputEntries.assign(inputSize, 0);
+   theInputBands.assign(inputSize, std::vector<ossim_uint32>());
+   theOpenHandlers.clear();
+   
+   for(ossim_uint32 inputIndex = 0; inputIndex < inputSize; ++inputIndex)
+   {
+      ossimConnectableObject* input =
+         const_cast<ossimImageCombiner*>(this)->getInput(inputIndex);
+      if(input)
+      {
+         ossimTypeNameVisitor visitor(ossimString("ossimImageHandler"),
+                                      false,
+                                      ossimVisitor::VISIT_CHILDREN|ossimVisitor::VISIT_INPUTS);
+         input->accept(visitor);
+
+         // Only a chain on one handler can be closed and opened again as a whole.
+         if(visitor.getObjects().size() == 1)
+         {
+            theInputHandlers[inputIndex] = visitor.getObjectAs<ossimImageHandler>(0);
+         }
+      }
+   }
+}
+
+void ossimImageCombiner::openInputHandler(ossim_uint32 index)const
+{
+   if(!theMaxOpenHandlers || (index >= theInputHandlers.size()) ||
+      !theInputHandlers[index].valid())
+   {
+      return;
+   }
+
+   ossimImageHandler* handler = theInputHandlers[index].get();
+   if(!handler->isOpen())
+   {
+      if(handler->open())
+      {
+         if(handler->getCurrentEntry() != theInputEntries[index])
+         {
+            handler->setCurrentEntry(theInputEntries[index]);
+         }
+         if(theInputBands[index].size() && handler->isBandSelector())
+         {
+            handler->setOutputBandList(theInputBands[index]);
+         }
+      }
+   }
+
+   theOpenHandlers.remove(index);
+   theOpenHandlers.push_front(index);
+   
+   while(theOpenHandlers.size() > theMaxOpenHandlers)
+   {
+      const ossim_uint32 lruIndex = theOpenHandlers.back();
+      theOpenHandlers.pop_back();
+      ossimImageHandler* lru = theInputHandlers[lruIndex].get();
+      if(lru->isOpen())
+      {
+         theInputEntries[lruIndex] = lru->getCurrentEntry();
+         theInputBands[lruIndex].clear();
+         if(lru->isBandSelector())
+         {
+            lru->getOutputBandList(theInputBands[lruIndex]);
+         }
+         lru->close();
+      }
+   }
 }
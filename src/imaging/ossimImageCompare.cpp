@@ -0,0 +1,649 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description:
+//
+// Pixel by pixel comparison of two images, e.g. for regression tests
+// of processed outputs.
+//
+//*******************************************************************
+// $Id$
+
+#include <ossim/imaging/ossimImageCompare.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageDataKernels.h>
+#include <ossim/imaging/ossimImageDataView.h>
+#include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimImageHandlerRegistry.h>
+#include <ossim/imaging/ossimImageSourceSequencer.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <OpenThreads/Block>
+#include <OpenThreads/ScopedLock>
+#include <tiffio.h>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace
+{
+   /** @return true if file starts as a classic or big TIFF. */
+   bool isTiff(const ossimFilename& file)
+   {
+      char magic[4] = { 0, 0, 0, 0 };
+      std::ifstream str(file.c_str(), std::ios::in | std::ios::binary);
+      str.read(magic, 4);
+      return str.good() &&
+         ( ( (magic[0] == 'I') && (magic[1] == 'I') && (magic[3] == 0) &&
+             ( (magic[2] == 42) || (magic[2] == 43) ) ) ||
+           ( (magic[0] == 'M') && (magic[1] == 'M') && (magic[2] == 0) &&
+             ( (magic[3] == 42) || (magic[3] == 43) ) ) );
+   }
+
+   /** @return true if tag is unset in both or set to the same value. */
+   bool sameUInt16Tag(TIFF* a, TIFF* b, ttag_t tag)
+   {
+      uint16 va = 0;
+      uint16 vb = 0;
+      const int SET_A = TIFFGetField(a, tag, &va);
+      const int SET_B = TIFFGetField(b, tag, &vb);
+      return (SET_A == SET_B) && (va == vb);
+   }
+
+   bool sameUInt32Tag(TIFF* a, TIFF* b, ttag_t tag)
+   {
+      uint32 va = 0;
+      uint32 vb = 0;
+      const int SET_A = TIFFGetField(a, tag, &va);
+      const int SET_B = TIFFGetField(b, tag, &vb);
+      return (SET_A == SET_B) && (va == vb);
+   }
+
+   /** @return true if the tables of JPEG compressed data match. */
+   bool sameJpegTables(TIFF* a, TIFF* b)
+   {
+      uint32 countA = 0;
+      uint32 countB = 0;
+      void* tablesA = 0;
+      void* tablesB = 0;
+      TIFFGetField(a, TIFFTAG_JPEGTABLES, &countA, &tablesA);
+      TIFFGetField(b, TIFFTAG_JPEGTABLES, &countB, &tablesB);
+      return (countA == countB) &&
+         ( !countA || ( tablesA && tablesB && !memcmp(tablesA, tablesB, countA) ) );
+   }
+
+   //---
+   // Compares the compressed tiles or strips of the first directories of a
+   // and b, byte counts first, as those are known without reading.
+   // @return true if both are TIFFs of the same layout and every tile or
+   // strip matches, i.e. the pixels are equal.
+   //---
+   bool rawTiffEqual(const ossimFilename& fileA, const ossimFilename& fileB)
+   {
+      if ( !isTiff(fileA) || !isTiff(fileB) )
+      {
+         return false;
+      }
+      TIFF* a = TIFFOpen(fileA.c_str(), "r");
+      TIFF* b = a ? TIFFOpen(fileB.c_str(), "r") : 0;
+      bool result = false;
+      if ( a && b )
+      {
+         const bool TILED = TIFFIsTiled(a);
+         uint16 compression = 0;
+         uint16 photometric = 0;
+         TIFFGetFieldDefaulted(a, TIFFTAG_COMPRESSION, &compression);
+         TIFFGetFieldDefaulted(a, TIFFTAG_PHOTOMETRIC, &photometric);
+
+         // Palette colors are not compared; leave those to the pixels.
+         result = ( TILED == (TIFFIsTiled(b) != 0) ) &&
+            ( photometric != PHOTOMETRIC_PALETTE ) &&
+            sameUInt32Tag(a, b, TIFFTAG_IMAGEWIDTH) &&
+            sameUInt32Tag(a, b, TIFFTAG_IMAGELENGTH) &&
+            sameUInt32Tag(a, b, TIFFTAG_TILEWIDTH) &&
+            sameUInt32Tag(a, b, TIFFTAG_TILELENGTH) &&
+            sameUInt32Tag(a, b, TIFFTAG_ROWSPERSTRIP) &&
+            sameUInt16Tag(a, b, TIFFTAG_SAMPLESPERPIXEL) &&
+            sameUInt16Tag(a, b, TIFFTAG_BITSPERSAMPLE) &&
+            sameUInt16Tag(a, b, TIFFTAG_SAMPLEFORMAT) &&
+            sameUInt16Tag(a, b, TIFFTAG_PLANARCONFIG) &&
+            sameUInt16Tag(a, b, TIFFTAG_PHOTOMETRIC) &&
+            sameUInt16Tag(a, b, TIFFTAG_COMPRESSION) &&
+            sameUInt16Tag(a, b, TIFFTAG_PREDICTOR) &&
+            sameUInt16Tag(a, b, TIFFTAG_FILLORDER) &&
+            ( (compression != COMPRESSION_JPEG) || sameJpegTables(a, b) );
+
+         toff_t* countsA = 0;
+         toff_t* countsB = 0;
+         const ossim_uint32 CHUNKS = TILED ? TIFFNumberOfTiles(a) : TIFFNumberOfStrips(a);
+         if ( result )
+         {
+            const ttag_t TAG = TILED ? TIFFTAG_TILEBYTECOUNTS : TIFFTAG_STRIPBYTECOUNTS;
+            result = TIFFGetField(a, TAG, &countsA) && TIFFGetField(b, TAG, &countsB) &&
+               countsA && countsB &&
+               ( CHUNKS == (TILED ? TIFFNumberOfTiles(b) : TIFFNumberOfStrips(b)) );
+         }
+         for ( ossim_uint32 i = 0; result && (i < CHUNKS); ++i )
+         {
+            result = (countsA[i] == countsB[i]);
+         }
+
+         std::vector<ossim_uint8> bufA;
+         std::vector<ossim_uint8> bufB;
+         for ( ossim_uint32 i = 0; result && (i < CHUNKS); ++i )
+         {
+            const tsize_t SIZE = static_cast<tsize_t>(countsA[i]);
+            if ( !SIZE )
+            {
+               continue;
+            }
+            bufA.resize(SIZE);
+            bufB.resize(SIZE);
+            const tsize_t READ_A = TILED ? TIFFReadRawTile(a, i, &bufA.front(), SIZE) :
+               TIFFReadRawStrip(a, i, &bufA.front(), SIZE);
+            const tsize_t READ_B = TILED ? TIFFReadRawTile(b, i, &bufB.front(), SIZE) :
+               TIFFReadRawStrip(b, i, &bufB.front(), SIZE);
+            result = (READ_A == SIZE) && (READ_B == SIZE) &&
+               !memcmp(&bufA.front(), &bufB.front(), SIZE);
+         }
+      }
+      if ( b )
+      {
+         TIFFClose(b);
+      }
+      if ( a )
+      {
+         TIFFClose(a);
+      }
+      return result;
+   }
+
+   bool isFloatScalar(ossimScalarType scalar)
+   {
+      return (scalar == OSSIM_FLOAT32) || (scalar == OSSIM_FLOAT64) ||
+         (scalar == OSSIM_NORMALIZED_FLOAT) || (scalar == OSSIM_NORMALIZED_DOUBLE);
+   }
+
+   /** Adds the differences of one band of a tile to stats. */
+   class ossimImageCompareKernel
+   {
+   public:
+      ossimImageCompareKernel(const void* a, const void* b, ossim_uint32 count,
+                              ossimImageCompare::BandStats& stats)
+         : m_a(a),
+           m_b(b),
+           m_count(count),
+           m_stats(stats)
+      {
+      }
+      template <class T> void operator()(T /* dummy */)
+      {
+         ossim::diffStats( static_cast<const T*>(m_a), static_cast<const T*>(m_b), m_count,
+                           m_stats.m_differ, m_stats.m_minDiff, m_stats.m_maxDiff,
+                           m_stats.m_sumSquares );
+      }
+   private:
+      const void*                   m_a;
+      const void*                   m_b;
+      ossim_uint32                  m_count;
+      ossimImageCompare::BandStats& m_stats;
+   };
+
+   //---
+   // Hands out tiles to the jobs, stops them on a read failure or, if only
+   // equality matters, on the first difference, and releases the caller
+   // once the last job is done.
+   //---
+   class ossimImageCompareBatch : public ossimReferenced
+   {
+   public:
+      ossimImageCompareBatch(ossimImageSourceSequencer* sequencer,
+                             ossim_uint32 jobs,
+                             bool equalityOnly)
+         : m_sequencer(sequencer),
+           m_next(0),
+           m_tiles(sequencer->getNumberOfTiles()),
+           m_jobs(jobs),
+           m_equalityOnly(equalityOnly),
+           m_stop(false),
+           m_failed(false),
+           m_differentTile(-1)
+      {
+         if(m_jobs)
+         {
+            m_block.reset();
+         }
+         else
+         {
+            m_block.release();
+         }
+      }
+      bool next(ossim_int64& tile, ossimIrect& rect)
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if ( m_stop || (m_next >= m_tiles) )
+         {
+            return false;
+         }
+         tile = m_next++;
+         m_sequencer->getTileRect(tile, rect);
+         return true;
+      }
+      void different(ossim_int64 tile)
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if ( (m_differentTile < 0) || (tile < m_differentTile) )
+         {
+            m_differentTile = tile;
+         }
+         if ( m_equalityOnly )
+         {
+            m_stop = true;
+         }
+      }
+      void fail()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         m_failed = true;
+         m_stop   = true;
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_jobs && (--m_jobs == 0))
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+      bool failed() const { return m_failed; }
+      ossim_int64 getDifferentTile() const { return m_differentTile; }
+   private:
+      OpenThreads::Mutex         m_mutex;
+      OpenThreads::Block         m_block;
+      ossimImageSourceSequencer* m_sequencer;
+      ossim_int64                m_next;
+      ossim_int64                m_tiles;
+      ossim_uint32               m_jobs;
+      bool                       m_equalityOnly;
+      bool                       m_stop;
+      bool                       m_failed;
+      ossim_int64                m_differentTile;
+   };
+
+   /** Compares tiles until the batch runs out, into stats of its own. */
+   class ossimImageCompareJob : public ossimJob
+   {
+   public:
+      ossimImageCompareJob(ossimImageHandler* a,
+                           ossimImageHandler* b,
+                           bool sharedFlag,
+                           bool equalityOnly,
+                           ossimImageCompareBatch* batch)
+         : m_a(a),
+           m_b(b),
+           m_sharedFlag(sharedFlag),
+           m_equalityOnly(equalityOnly),
+           m_imageRect(a->getImageRectangle(0)),
+           m_tileA(0),
+           m_tileB(0),
+           m_batch(batch),
+           m_stats(a->getNumberOfOutputBands()),
+           m_samples(0)
+      {
+         setName("ossimImageCompare.tile");
+         if ( m_sharedFlag )
+         {
+            // Shared handlers are read into tiles of our own:
+            m_tileA = ossimImageDataFactory::instance()->create(0, m_a.get());
+            m_tileB = ossimImageDataFactory::instance()->create(0, m_b.get());
+         }
+      }
+      virtual void start()
+      {
+         ossim_int64 tile;
+         ossimIrect rect;
+         while ( m_batch->next(tile, rect) )
+         {
+            const int RESULT = compareTile( rect.clipToRect(m_imageRect) );
+            if ( RESULT < 0 )
+            {
+               m_batch->fail();
+            }
+            else if ( RESULT > 0 )
+            {
+               m_batch->different(tile);
+            }
+         }
+         m_batch->done();
+      }
+      const std::vector<ossimImageCompare::BandStats>& getStats() const { return m_stats; }
+      ossim_uint64 getNumberOfSamples() const { return m_samples; }
+   private:
+      ossimRefPtr<ossimImageData> read(ossimImageHandler* handler,
+                                       ossimRefPtr<ossimImageData>& own,
+                                       const ossimIrect& rect)
+      {
+         ossimRefPtr<ossimImageData> result = 0;
+         if ( m_sharedFlag )
+         {
+            own->setImageRectangle(rect);
+            if ( handler->getTile(own.get(), 0) )
+            {
+               result = own;
+            }
+         }
+         else
+         {
+            result = handler->getTile(rect, 0);
+         }
+
+         // Tiles may come back empty without a buffer; those compare as nulls.
+         if ( result.valid() && !result->getBuf() )
+         {
+            result = static_cast<ossimImageData*>( result->dup() );
+            result->initialize();
+         }
+         return result;
+      }
+
+      /** @return -1 if a read failed, 1 if different, else 0. */
+      int compareTile(const ossimIrect& rect)
+      {
+         ossimRefPtr<ossimImageData> a = read(m_a.get(), m_tileA, rect);
+         ossimRefPtr<ossimImageData> b = read(m_b.get(), m_tileB, rect);
+         if ( !a.valid() || !b.valid() || !a->getBuf() || !b->getBuf() ||
+              (a->getImageRectangle() != b->getImageRectangle()) ||
+              (a->getScalarType() != b->getScalarType()) ||
+              (a->getNumberOfBands() < m_stats.size()) ||
+              (b->getNumberOfBands() < m_stats.size()) )
+         {
+            return -1;
+         }
+
+         // Read only access, so no shared buffer is copied:
+         const ossimImageData* ta = a.get();
+         const ossimImageData* tb = b.get();
+         const ossim_uint32 COUNT = ta->getSizePerBand();
+         const ossim_uint32 BYTES = ta->getSizePerBandInBytes();
+         m_samples += COUNT;
+
+         bool different = false;
+         for ( ossim_uint32 band = 0; band < m_stats.size(); ++band )
+         {
+            const void* bufA = ta->getBuf(band);
+            const void* bufB = tb->getBuf(band);
+            ossimImageCompare::BandStats& stats = m_stats[band];
+            if ( !memcmp(bufA, bufB, BYTES) )
+            {
+               // All differences 0:
+               stats.m_minDiff = ossim::min<ossim_float64>(stats.m_minDiff, 0.0);
+               stats.m_maxDiff = ossim::max<ossim_float64>(stats.m_maxDiff, 0.0);
+               continue;
+            }
+            if ( m_equalityOnly && !isFloatScalar(ta->getScalarType()) )
+            {
+               return 1;
+            }
+
+            // Bytes differ; float samples may still be equal, e.g. NaN nulls of other bits.
+            const ossim_uint64 DIFFER = stats.m_differ;
+            ossimImageCompareKernel kernel(bufA, bufB, COUNT, stats);
+            if ( !ossim::dispatchScalarType(ta->getScalarType(), kernel) )
+            {
+               return -1;
+            }
+            if ( stats.m_differ != DIFFER )
+            {
+               if ( m_equalityOnly )
+               {
+                  return 1;
+               }
+               different = true;
+            }
+         }
+         return different ? 1 : 0;
+      }
+
+      ossimRefPtr<ossimImageHandler>           m_a;
+      ossimRefPtr<ossimImageHandler>           m_b;
+      bool                                     m_sharedFlag;
+      bool                                     m_equalityOnly;
+      ossimIrect                               m_imageRect;
+      ossimRefPtr<ossimImageData>              m_tileA;
+      ossimRefPtr<ossimImageData>              m_tileB;
+      ossimRefPtr<ossimImageCompareBatch>      m_batch;
+      std::vector<ossimImageCompare::BandStats> m_stats;
+      ossim_uint64                             m_samples;
+   };
+}
+
+ossimImageCompare::BandStats::BandStats()
+   : m_differ(0),
+     m_minDiff(std::numeric_limits<ossim_float64>::max()),
+     m_maxDiff(-std::numeric_limits<ossim_float64>::max()),
+     m_sumSquares(0.0)
+{
+}
+
+void ossimImageCompare::BandStats::merge(const BandStats& rhs)
+{
+   m_differ     += rhs.m_differ;
+   m_minDiff     = ossim::min<ossim_float64>(m_minDiff, rhs.m_minDiff);
+   m_maxDiff     = ossim::max<ossim_float64>(m_maxDiff, rhs.m_maxDiff);
+   m_sumSquares += rhs.m_sumSquares;
+}
+
+ossimImageCompare::ossimImageCompare()
+   : m_numberOfThreads(0),
+     m_equalityOnly(false),
+     m_rawCompare(true),
+     m_equal(false),
+     m_usedRawCompare(false),
+     m_differentTile(-1),
+     m_samples(0),
+     m_bands()
+{
+}
+
+ossimImageCompare::~ossimImageCompare()
+{
+}
+
+void ossimImageCompare::setNumberOfThreads(ossim_uint32 threads)
+{
+   m_numberOfThreads = threads;
+}
+
+void ossimImageCompare::setEqualityOnly(bool flag)
+{
+   m_equalityOnly = flag;
+}
+
+void ossimImageCompare::setRawCompare(bool flag)
+{
+   m_rawCompare = flag;
+}
+
+bool ossimImageCompare::compare(const ossimFilename& fileA, const ossimFilename& fileB)
+{
+   m_equal          = false;
+   m_usedRawCompare = false;
+   m_differentTile  = -1;
+   m_samples        = 0;
+   m_bands.clear();
+
+   ossimImageHandlerRegistry* registry = ossimImageHandlerRegistry::instance();
+   std::vector< ossimRefPtr<ossimImageHandler> > handlersA;
+   std::vector< ossimRefPtr<ossimImageHandler> > handlersB;
+   handlersA.push_back( registry->open(fileA) );
+   handlersB.push_back( registry->open(fileB) );
+   if ( !handlersA[0].valid() || !handlersB[0].valid() )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimImageCompare::compare WARNING: Could not open <"
+         << (handlersA[0].valid() ? fileB : fileA) << ">." << std::endl;
+      return false;
+   }
+
+   ossimImageHandler* a = handlersA[0].get();
+   ossimImageHandler* b = handlersB[0].get();
+   const ossim_uint32 BANDS = a->getNumberOfOutputBands();
+   if ( (a->getImageRectangle(0) != b->getImageRectangle(0)) ||
+        (BANDS != b->getNumberOfOutputBands()) ||
+        (a->getOutputScalarType() != b->getOutputScalarType()) )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimImageCompare::compare WARNING: The images differ in size, bands or "
+         << "scalar type." << std::endl;
+      return false;
+   }
+
+   m_bands.resize(BANDS);
+   m_samples = static_cast<ossim_uint64>( a->getImageRectangle(0).area() );
+
+   if ( m_rawCompare && rawTiffEqual(fileA, fileB) )
+   {
+      for ( ossim_uint32 band = 0; band < BANDS; ++band )
+      {
+         m_bands[band].m_minDiff = 0.0;
+         m_bands[band].m_maxDiff = 0.0;
+      }
+      m_equal          = true;
+      m_usedRawCompare = true;
+      return true;
+   }
+
+   ossimRefPtr<ossimImageSourceSequencer> sequencer = new ossimImageSourceSequencer(a);
+   sequencer->setToStartOfSequence();
+   const ossim_uint32 THREADS = m_numberOfThreads ? m_numberOfThreads :
+                                ossim::getNumberOfThreads();
+   const ossim_uint32 JOBS = static_cast<ossim_uint32>( ossim::max<ossim_int64>(
+      1, ossim::min<ossim_int64>( THREADS, sequencer->getNumberOfTiles() ) ) );
+
+   //---
+   // Handlers that serve concurrent reads are shared; otherwise each job
+   // opens its own pair, here, as the factories are not thread safe.
+   //---
+   const bool SHARED = (JOBS > 1) && a->hasConcurrentReads() && b->hasConcurrentReads();
+   while ( !SHARED && (handlersA.size() < JOBS) )
+   {
+      ossimRefPtr<ossimImageHandler> ha = registry->open(fileA);
+      ossimRefPtr<ossimImageHandler> hb = registry->open(fileB);
+      if ( !ha.valid() || !hb.valid() )
+      {
+         break;
+      }
+      handlersA.push_back(ha);
+      handlersB.push_back(hb);
+   }
+   const ossim_uint32 PAIRS = static_cast<ossim_uint32>(handlersA.size());
+   const ossim_uint32 USED_JOBS = SHARED ? JOBS : PAIRS;
+
+   ossimRefPtr<ossimImageCompareBatch> batch =
+      new ossimImageCompareBatch(sequencer.get(), USED_JOBS, m_equalityOnly);
+   std::vector< ossimRefPtr<ossimImageCompareJob> > jobs;
+   for ( ossim_uint32 i = 0; i < USED_JOBS; ++i )
+   {
+      const ossim_uint32 PAIR = SHARED ? 0 : i;
+      jobs.push_back( new ossimImageCompareJob( handlersA[PAIR].get(), handlersB[PAIR].get(),
+                                                SHARED, m_equalityOnly, batch.get() ) );
+   }
+   if ( USED_JOBS == 1 )
+   {
+      jobs[0]->start();
+   }
+   else
+   {
+      ossimRefPtr<ossimJobMultiThreadQueue> queue = new ossimJobMultiThreadQueue(0, USED_JOBS);
+      for ( ossim_uint32 i = 0; i < USED_JOBS; ++i )
+      {
+         queue->getJobQueue()->add(jobs[i].get(), false);
+      }
+      batch->wait();
+   }
+
+   m_samples = 0;
+   for ( ossim_uint32 i = 0; i < USED_JOBS; ++i )
+   {
+      m_samples += jobs[i]->getNumberOfSamples();
+      for ( ossim_uint32 band = 0; band < BANDS; ++band )
+      {
+         m_bands[band].merge( jobs[i]->getStats()[band] );
+      }
+   }
+   m_differentTile = batch->getDifferentTile();
+   m_equal = !batch->failed() && (m_differentTile < 0);
+
+   sequencer->disconnect();
+   for ( ossim_uint32 i = 0; i < PAIRS; ++i )
+   {
+      handlersA[i]->close();
+      handlersB[i]->close();
+   }
+
+   if ( batch->failed() )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimImageCompare::compare WARNING: A tile could not be read." << std::endl;
+      return false;
+   }
+   return true;
+}
+
+bool ossimImageCompare::isEqual() const
+{
+   return m_equal;
+}
+
+bool ossimImageCompare::usedRawCompare() const
+{
+   return m_usedRawCompare;
+}
+
+ossim_int64 ossimImageCompare::getDifferentTile() const
+{
+   return m_differentTile;
+}
+
+ossim_uint32 ossimImageCompare::getNumberOfBands() const
+{
+   return static_cast<ossim_uint32>( m_bands.size() );
+}
+
+ossim_uint64 ossimImageCompare::getNumberOfSamples() const
+{
+   return m_samples;
+}
+
+ossim_uint64 ossimImageCompare::getDifferentSamples(ossim_uint32 band) const
+{
+   return (band < m_bands.size()) ? m_bands[band].m_differ : 0;
+}
+
+ossim_float64 ossimImageCompare::getMinDifference(ossim_uint32 band) const
+{
+   return ( (band < m_bands.size()) && (m_bands[band].m_minDiff <= m_bands[band].m_maxDiff) ) ?
+      m_bands[band].m_minDiff : ossim::nan();
+}
+
+ossim_float64 ossimImageCompare::getMaxDifference(ossim_uint32 band) const
+{
+   return ( (band < m_bands.size()) && (m_bands[band].m_minDiff <= m_bands[band].m_maxDiff) ) ?
+      m_bands[band].m_maxDiff : ossim::nan();
+}
+
+ossim_float64 ossimImageCompare::getRmsDifference(ossim_uint32 band) const
+{
+   return ( (band < m_bands.size()) && m_samples ) ?
+      std::sqrt( m_bands[band].m_sumSquares / static_cast<ossim_float64>(m_samples) ) :
+      ossim::nan();
+}
@@ -22,7 +22,11 @@
 #include <ossim/base/ossimScalarTypeLut.h>
 //#include <ossim/base/ossimSource.h>
 #include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTrace.h>
 #include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageDataAccounting.h>
+#include <ossim/imaging/ossimImageDataKernels.h>
+#include <ossim/imaging/ossimTilePool.h>
 #include <algorithm>
 #include <cstring>
 #include <fstream>
@@ -33,6 +37,8 @@
 
 RTTI_DEF1(ossimImageData, "ossimImageData", ossimRectilinearDataObject)
 
+static ossimTrace traceSpan("ossimImageData:span");
+
 ossimImageData::ossimImageData()
    : ossimRectilinearDataObject(2,            // 2d
                                 0,         // owner
@@ -43,7 +49,10 @@ ossimImageData::ossimImageData()
      m_maxPixelValue(0),
      m_alpha(0),
      m_origin(0, 0),
-     m_indexedFlag(false)
+     m_indexedFlag(false),
+     m_statusCached(false),
+     m_accountedBytes(0),
+     m_account(0)
 {
    ossimIpt tileSize;
    ossim::defaultTileSize(tileSize);
@@ -64,7 +73,10 @@ ossimImageData::ossimImageData(ossimSource*    owner,
      m_maxPixelValue(0),
      m_alpha(0),
      m_origin(0, 0),
-     m_indexedFlag(false)
+     m_indexedFlag(false),
+     m_statusCached(false),
+     m_accountedBytes(0),
+     m_account(0)
 {
    ossimIpt tileSize;
    ossim::defaultTileSize(tileSize);
@@ -89,7 +101,10 @@ ossimImageData::ossimImageData(ossimSource* owner,
      m_alpha(0),
      m_origin(0, 0),
      m_indexedFlag(false),
-     m_percentFull(0)
+     m_percentFull(0),
+     m_statusCached(false),
+     m_accountedBytes(0),
+     m_account(0)
 {   
    m_spatialExtents[0] = width;
    m_spatialExtents[1] = height;
@@ -97,15 +112,20 @@ ossimImageData::ossimImageData(ossimSource* owner,
 }
 
 ossimImageData::ossimImageData(const ossimImageData &rhs)
-   : ossimRectilinearDataObject(rhs),
+   : ossimRectilinearDataObject(rhs.shareBuffer()), // copies an empty m_dataBuffer
      m_nullPixelValue(rhs.m_nullPixelValue),
      m_minPixelValue(rhs.m_minPixelValue),
      m_maxPixelValue(rhs.m_maxPixelValue),
      m_alpha(rhs.m_alpha),
      m_origin(rhs.m_origin),
      m_indexedFlag(rhs.m_indexedFlag),
-     m_percentFull(0)
+     m_percentFull(rhs.m_percentFull),
+     m_statusCached(rhs.m_statusCached), // same buffer and nulls
+     m_accountedBytes(0),
+     m_account(0),
+     m_sharedBuffer(rhs.m_sharedBuffer)
 {
+   updateAccounting();
 }
 
 const ossimImageData& ossimImageData::operator=(const ossimImageData& rhs)
@@ -113,6 +133,7 @@ const ossimImageData& ossimImageData::operator=(const ossimImageData& rhs)
    if (this != &rhs)
    {
       // ossimRectilinearDataObject initialization:
+      referenceBuffer(rhs);
       ossimRectilinearDataObject::operator=(rhs);
       
       // ossimImageData (this) members:
@@ -122,12 +143,112 @@ const ossimImageData& ossimImageData::operator=(const ossimImageData& rhs)
       m_alpha          = rhs.m_alpha;
       m_origin         = rhs.m_origin;
       m_indexedFlag    = rhs.m_indexedFlag;
+      m_statusCached   = false;
+      updateAccounting();
    }
    return *this;
 }
 
 ossimImageData::~ossimImageData()
 {
+   if ( m_accountedBytes )
+   {
+      ossimImageDataAccounting::instance()->update(m_account, m_accountedBytes, 0);
+   }
+
+   // The last reference to a shared buffer takes it back, for the pool:
+   if ( m_sharedBuffer.valid() && (m_sharedBuffer->referenceCount() == 1) )
+   {
+      m_dataBuffer.swap( m_sharedBuffer->m_buffer );
+   }
+   m_sharedBuffer = 0;
+
+   // Hand the buffer back for reuse by the next tile of the same size class:
+   if ( m_dataBuffer.size() && (m_spatialExtents.size() > 1) )
+   {
+      ossimTilePool::instance()->release(m_scalarType,
+                                         m_numberOfDataComponents,
+                                         m_spatialExtents[0],
+                                         m_spatialExtents[1],
+                                         m_dataBuffer);
+   }
+}
+
+bool ossimImageData::isBufferShared() const
+{
+   return m_sharedBuffer.valid();
+}
+
+ossim_uint32 ossimImageData::getBufferSizeInBytes() const
+{
+   return static_cast<ossim_uint32>( m_sharedBuffer.valid() ?
+                                     m_sharedBuffer->m_buffer.size() : m_dataBuffer.size() );
+}
+
+const ossimImageData& ossimImageData::shareBuffer() const
+{
+   if ( !m_sharedBuffer.valid() && m_dataBuffer.size() )
+   {
+      m_sharedBuffer = new SharedBuffer();
+      m_sharedBuffer->m_buffer.swap( const_cast< std::vector<ossim_uint8>& >(m_dataBuffer) );
+   }
+   return *this;
+}
+
+void ossimImageData::unshareBuffer(bool keepContents)
+{
+   if ( m_sharedBuffer.valid() )
+   {
+      if ( m_sharedBuffer->referenceCount() == 1 )
+      {
+         m_dataBuffer.swap( m_sharedBuffer->m_buffer ); // Copies are gone, take it back.
+      }
+      else if ( keepContents )
+      {
+         m_dataBuffer = m_sharedBuffer->m_buffer;
+      }
+      else
+      {
+         m_dataBuffer.resize( m_sharedBuffer->m_buffer.size() );
+      }
+      m_sharedBuffer = 0;
+   }
+}
+
+void ossimImageData::referenceBuffer(const ossimImageData& rhs)
+{
+   rhs.shareBuffer();
+   if ( m_sharedBuffer != rhs.m_sharedBuffer )
+   {
+      // Our own buffer is no longer needed; recycle it if we are its owner.
+      if ( m_dataBuffer.size() && (m_spatialExtents.size() > 1) )
+      {
+         ossimTilePool::instance()->release(m_scalarType,
+                                            m_numberOfDataComponents,
+                                            m_spatialExtents[0],
+                                            m_spatialExtents[1],
+                                            m_dataBuffer);
+      }
+      m_dataBuffer.clear();
+      m_sharedBuffer = rhs.m_sharedBuffer;
+   }
+}
+
+void ossimImageData::updateAccounting()
+{
+   // Copies sharing a buffer are charged for it as for the copy they replace.
+   const ossim_uint64 BYTES = getBufferSizeInBytes();
+   if ( BYTES != m_accountedBytes )
+   {
+      ossimImageDataAccounting* accounting = ossimImageDataAccounting::instance();
+      if ( !m_accountedBytes )
+      {
+         // Charge a new buffer to whoever owns the tile now:
+         m_account = accounting->getAccount(theOwner);
+      }
+      accounting->update(m_account, m_accountedBytes, BYTES);
+      m_accountedBytes = BYTES;
+   }
 }
 
 bool ossimImageData::isValidBand(ossim_uint32 band) const
@@ -175,15 +296,30 @@ ossim_uint8* ossimImageData::getAlphaBuf()
 
 const void* ossimImageData::getBuf() const
 {
-   if (m_dataBuffer.size() > 0)
+   const std::vector<ossim_uint8>& buffer =
+      m_sharedBuffer.valid() ? m_sharedBuffer->m_buffer : m_dataBuffer;
+   if (buffer.size() > 0)
    {
-      return static_cast<const void*>(&m_dataBuffer.front());
+      return static_cast<const void*>(&buffer.front());
    }
    return 0;
 }
 
 void* ossimImageData::getBuf()
 {
+   //---
+   // Caller may write through the pointer so the cached status can no longer be trusted.
+   // Only written when set, so threads filling disjoint parts of one tile after it was
+   // invalidated do not race on the flag.
+   //---
+   if (m_statusCached)
+   {
+      m_statusCached = false;
+   }
+
+   // Copy on write:
+   unshareBuffer(true);
+   
    if (m_dataBuffer.size() > 0)
    {
       return static_cast<void*>(&m_dataBuffer.front());
@@ -808,6 +944,104 @@ template <class T> ossim_float64 ossimImageData::computeMeanSquaredError(
 }
 
 
+namespace
+{
+   //---
+   // Adds the pixels of buffer to the 256 bins of histo indexed by pixel value. Counting into
+   // four interleaved sub-histograms keeps runs of equal pixels from waiting on the previous
+   // increment of the same bin. The totals go in the exact integer counts of the histogram,
+   // or its float counts if set to fractions.
+   //---
+   void countByteBins(const ossim_uint8* buffer, ossim_uint32 size, ossimHistogram* histo)
+   {
+      ossim_uint32 sub[4][256];
+      memset(sub, 0, sizeof(sub));
+
+      ossim_uint32 i = 0;
+      for(; i + 4 <= size; i += 4)
+      {
+         ++sub[0][buffer[i]];
+         ++sub[1][buffer[i+1]];
+         ++sub[2][buffer[i+2]];
+         ++sub[3][buffer[i+3]];
+      }
+      for(; i < size; ++i)
+      {
+         ++sub[0][buffer[i]];
+      }
+      ossim_uint64* exactBins = histo->GetIntCounts();
+      float* bins = exactBins ? 0 : histo->GetCounts();
+      for(ossim_uint32 bin = 0; bin < 256; ++bin)
+      {
+         const ossim_uint32 total = sub[0][bin] + sub[1][bin] + sub[2][bin] + sub[3][bin];
+         if(exactBins)
+         {
+            exactBins[bin] += total;
+         }
+         else
+         {
+            bins[bin] += (float)total;
+         }
+      }
+   }
+
+   //---
+   // Adds integer pixels to the exact counts of a histogram of unit-width bins (see
+   // ossimHistogram::GetUnitBinRange), indexing them directly (see ossim::countUnitBins).
+   // Returns false, leaving the pixels to UpCount(), for other histograms.
+   //---
+   template <class T>
+   bool countUnitBins(const T* buffer, ossim_uint32 size, ossimHistogram* histo)
+   {
+      ossim_int64 first = 0;
+      ossim_int64 last  = 0;
+      if ( !histo->GetUnitBinRange(first, last) )
+      {
+         return false;
+      }
+      ossim_uint64* bins = histo->GetIntCounts();
+      if ( !bins )
+      {
+         return false;
+      }
+      if ( last >= first )
+      {
+         ossim::countUnitBins(buffer, size, first, (ossim_uint32)(last - first + 1), bins);
+      }
+      return true;
+   }
+
+   //---
+   // Adds float pixels to the exact counts of histo, with the bin indexes of
+   // ossimHistogram::GetIndex computed a chunk at a time (see ossim::binIndex). Returns false,
+   // leaving the pixels to UpCount(), if the histogram holds fractional counts.
+   //---
+   bool countFloatBins(const ossim_float32* buffer, ossim_uint32 size, ossimHistogram* histo)
+   {
+      ossim_uint64* bins = histo->GetIntCounts();
+      if ( !bins )
+      {
+         return false;
+      }
+      const ossim_uint32 CHUNK = 1024;
+      ossim_int32 index[CHUNK];
+      for(ossim_uint32 i = 0; i < size; i += CHUNK)
+      {
+         const ossim_uint32 N = ossim::min(CHUNK, size - i);
+         ossim::binIndex(buffer + i, N, histo->GetRangeMin(), histo->GetRangeMax(),
+                         histo->GetBucketSize(), histo->GetRes(), index);
+         for(ossim_uint32 j = 0; j < N; ++j)
+         {
+            if ( index[j] >= 0 )
+            {
+               ++bins[index[j]];
+            }
+         }
+      }
+      return true;
+   }
+}
+
 //******************************************************************
 //
 // NOTE: I was checking for null and not adding it to the histogram.
@@ -837,18 +1071,14 @@ void ossimImageData::populateHistogram(ossimRefPtr<ossimMultiBandHistogram> hist
             ossimRefPtr<ossimHistogram> currentHisto = histo->getHistogram(band);
             if(currentHisto.valid())
             {
-               float* histoBins = currentHisto->GetCounts();
                int binCount = currentHisto->GetRes();
                ossim_uint8* buffer = (ossim_uint8*)getBuf(band);
                ossim_uint32 upperBound = getWidth()*getHeight();
                if ( binCount == 256 )
                {
-                  for(ossim_uint32 offset = 0; offset < upperBound; ++offset)
-                  {
-                     ++histoBins[ buffer[offset] ];
-                  }
+                  countByteBins(buffer, upperBound, currentHisto.get());
                }
-               else
+               else if ( !countUnitBins(buffer, upperBound, currentHisto.get()) )
                {
                  for(ossim_uint32 offset = 0; offset < upperBound; ++offset)
                   {
@@ -870,9 +1100,12 @@ void ossimImageData::populateHistogram(ossimRefPtr<ossimMultiBandHistogram> hist
              if(currentHisto.valid())
              {
                 ossim_uint32 upperBound = getWidth()*getHeight();
-                for(ossim_uint32 offset = 0; offset < upperBound; ++offset)
+                if ( !countUnitBins(buffer, upperBound, currentHisto.get()) )
                 {
-                  currentHisto->UpCount((float)buffer[offset]);
+                   for(ossim_uint32 offset = 0; offset < upperBound; ++offset)
+                   {
+                      currentHisto->UpCount((float)buffer[offset]);
+                   }
                 }
              }
          }
@@ -888,9 +1121,12 @@ void ossimImageData::populateHistogram(ossimRefPtr<ossimMultiBandHistogram> hist
             if(currentHisto.valid())
             {
                ossim_uint32 upperBound = getWidth()*getHeight();
-               for(ossim_uint32 offset = 0; offset < upperBound; ++offset)
+               if ( !countUnitBins(buffer, upperBound, currentHisto.get()) )
                {
-                  currentHisto->UpCount((float)buffer[offset]);
+                  for(ossim_uint32 offset = 0; offset < upperBound; ++offset)
+                  {
+                     currentHisto->UpCount((float)buffer[offset]);
+                  }
                }
             }
          }
@@ -962,9 +1198,12 @@ void ossimImageData::populateHistogram(ossimRefPtr<ossimMultiBandHistogram> hist
             if(currentHisto.valid())
             {
                ossim_uint32 upperBound = getWidth()*getHeight();
-               for(ossim_uint32 offset = 0; offset < upperBound; ++offset)
+               if ( !countFloatBins(buffer, upperBound, currentHisto.get()) )
                {
-                  currentHisto->UpCount((float)buffer[offset]);
+                  for(ossim_uint32 offset = 0; offset < upperBound; ++offset)
+                  {
+                     currentHisto->UpCount((float)buffer[offset]);
+                  }
                }
             }
          }
@@ -1094,6 +1333,12 @@ template <class T> ossim_float64 ossimImageData::computeAverageBandValue(
 
 ossimDataObjectStatus ossimImageData::validate() const
 {
+   if (m_statusCached)
+   {
+      return getDataObjectStatus(); // Buffer unchanged since last validate.
+   }
+   OSSIM_TRACE_SPAN(traceSpan, "ossimImageData::validate");
+   
    switch (getScalarType())
    {
       case OSSIM_UINT8:
@@ -1148,27 +1393,40 @@ ossimDataObjectStatus ossimImageData::validate() const
 template <class T>
 ossimDataObjectStatus ossimImageData::validate(T /* dummyTemplate */ ) const
 {
-   if (m_dataBuffer.size() == 0)
+   if (getBufferSizeInBytes() == 0)
    {
       setDataObjectStatus(OSSIM_NULL);
       m_percentFull = 0;
       return OSSIM_NULL;
    }
 
-   ossim_uint32       count           = 0;
    const ossim_uint32 SIZE            = getSize();
    const ossim_uint32 BOUNDS          = getSizePerBand();
    const ossim_uint32 NUMBER_OF_BANDS = getNumberOfBands();
+   ossim_uint32       count           = SIZE;
+
+   // Bands are contiguous so when they share a null value scan the buffer in one pass.
+   bool commonNull = true;
+   for(ossim_uint32 band = 1; band < NUMBER_OF_BANDS; ++band)
+   {
+      if ( static_cast<T>(m_nullPixelValue[band]) != static_cast<T>(m_nullPixelValue[0]) )
+      {
+         commonNull = false;
+         break;
+      }
+   }
    
-   for(ossim_uint32 band = 0; band < NUMBER_OF_BANDS; ++band)
+   if ( commonNull )
    {
-      const T NP = static_cast<T>(m_nullPixelValue[band]);
-      const T* p = static_cast<const T*>(getBuf(band));
-      
-      for (ossim_uint32 i = 0; i < BOUNDS; ++i)
+      count -= ossim::countNull(static_cast<const T*>(getBuf()), SIZE,
+                               static_cast<T>(m_nullPixelValue[0]));
+   }
+   else
+   {
+      for(ossim_uint32 band = 0; band < NUMBER_OF_BANDS; ++band)
       {
-         // check if the band is null
-         if (p[i] != NP) ++count;         
+         count -= ossim::countNull(static_cast<const T*>(getBuf(band)), BOUNDS,
+                                  static_cast<T>(m_nullPixelValue[band]));
       }
    }
 
@@ -1187,16 +1445,45 @@ ossimDataObjectStatus ossimImageData::validate(T /* dummyTemplate */ ) const
       setDataObjectStatus(OSSIM_PARTIAL);
       m_percentFull = 100.0 * count / SIZE;
    }
+   m_statusCached = true;
    return getDataObjectStatus();
 }
 
+void ossimImageData::setValidatedStatus(ossimDataObjectStatus status) const
+{
+   setDataObjectStatus(status);
+   if (getBufferSizeInBytes() && ( (status == OSSIM_FULL) || (status == OSSIM_EMPTY) ) )
+   {
+      m_percentFull  = (status == OSSIM_FULL) ? 100 : 0;
+      m_statusCached = true;
+   }
+}
+
+void ossimImageData::invalidateStatus() const
+{
+   m_statusCached = false;
+}
+
+bool ossimImageData::isStatusCached() const
+{
+   return m_statusCached;
+}
+
+void ossimImageData::setDataObjectStatus(ossimDataObjectStatus status) const
+{
+   ossimRectilinearDataObject::setDataObjectStatus(status);
+   m_statusCached = false;
+}
+
 void ossimImageData::makeBlank()
 {
-   if ( (m_dataBuffer.size() == 0) || (getDataObjectStatus() == OSSIM_EMPTY) )
+   if ( (getBufferSizeInBytes() == 0) || (getDataObjectStatus() == OSSIM_EMPTY) )
    {
       return; // nothing to do...
    }
 
+   unshareBuffer(false); // All overwritten, no need to copy.
+
    switch (getScalarType())
    {
       case OSSIM_UINT8:
@@ -1284,13 +1571,27 @@ template <class T> void ossimImageData::makeBlank(T /* dummyTemplate */ )
       }
    }
    
-   setDataObjectStatus(OSSIM_EMPTY);
+   setValidatedStatus(OSSIM_EMPTY);
 }
 
 void ossimImageData::initialize()
 {
+   m_statusCached = false;
+   unshareBuffer(false); // Blanked below.
+   
+   // Try to recycle a buffer from the tile pool before going to the allocator:
+   if ( m_dataBuffer.empty() && (m_spatialExtents.size() > 1) )
+   {
+      ossimTilePool::instance()->acquire(m_scalarType,
+                                         m_numberOfDataComponents,
+                                         m_spatialExtents[0],
+                                         m_spatialExtents[1],
+                                         m_dataBuffer);
+   }
+   
    // let the base class allocate a buffer
    ossimRectilinearDataObject::initialize();
+   updateAccounting();
    
    if (m_dataBuffer.size() > 0)
    {
@@ -1361,7 +1662,7 @@ bool ossimImageData::isWithin(ossim_int32 x, ossim_int32 y)
 
 void ossimImageData::setValue(ossim_int32 x, ossim_int32 y, ossim_float64 color)
 {
-   if(m_dataBuffer.size() > 0 && isWithin(x, y))
+   if(getBufferSizeInBytes() > 0 && isWithin(x, y))
    {
       ossim_uint32 band=0;
 
@@ -2397,6 +2698,7 @@ void ossimImageData::setNullPix(ossim_float64 null_pix)
    {
       return;
    }
+   m_statusCached = false;
    m_nullPixelValue.resize(m_numberOfDataComponents);
    for(ossim_uint32 band = 0; band < m_numberOfDataComponents; ++band)
    {
@@ -2410,6 +2712,7 @@ void ossimImageData::setNullPix(ossim_float64 null_pix, ossim_uint32 band)
    {
       return;
    }
+   m_statusCached = false;
    if (m_nullPixelValue.size() != m_numberOfDataComponents)
    {
       initializeNullDefault();
@@ -2424,6 +2727,7 @@ void ossimImageData::setNullPix(const ossim_float64* nullPixArray,
    {
       return;
    }
+   m_statusCached = false;
 
    if (m_nullPixelValue.size() != m_numberOfDataComponents)
    {
@@ -2539,10 +2843,13 @@ void ossimImageData::setNumberOfBands(ossim_uint32 bands,
    ossim_uint32 b  = getNumberOfBands();
    if(bands && (b != bands))
    {
+      m_statusCached = false;
       setNumberOfDataComponents(bands);
       if(reallocate)
       {
+         unshareBuffer(true);
          ossimRectilinearDataObject::initialize();
+         updateAccounting();
       }
       
       ossim_uint32 minBands = ossim::min(b, bands);
@@ -2640,7 +2947,11 @@ void ossimImageData::assign(const ossimDataObject* data)
 void ossimImageData::assign(const ossimImageData* data)
 {
    ossimSource* tmp_owner = getOwner();
-   
+
+   if (data && (this != data))
+   {
+      referenceBuffer(*data);
+   }
    ossimRectilinearDataObject::assign(data);
 
    //***
@@ -2648,6 +2959,7 @@ void ossimImageData::assign(const ossimImageData* data)
    // set it back.
    //***
    setOwner(tmp_owner);
+   updateAccounting();
 
    if(this != data)
    {
@@ -2672,12 +2984,9 @@ void ossimImageData::assign(const ossimImageData* data)
          initializeDefaults();
       }
 
-      ossim_uint32 source_size = data->getSizeInBytes();
-      const void*  s = data->getBuf();
-      void*        d = getBuf();
-      if (s && d)
-         memcpy(d, s, source_size);
-
+      // The buffer is now referenced from data, so is a status it validated.
+      m_statusCached = data->m_statusCached;
+      m_percentFull  = data->m_percentFull;
    }
 }
 
@@ -2939,10 +3248,7 @@ template <class T> void ossimImageData::loadBandTemplate(T, // dummy template va
   
    for (ossim_uint32 line = 0; line < clipHeight; ++line)
    {
-      for (ossim_uint32 sample = 0; sample < clipWidth; ++sample)
-      {
-         d[sample] = s[sample];
-      }
+      memcpy(d, s, clipWidth * sizeof(T));
 
       s += s_width;
       d += d_width;
@@ -2951,6 +3257,7 @@ template <class T> void ossimImageData::loadBandTemplate(T, // dummy template va
 
 void ossimImageData::loadTile(const ossimImageData* src)
 {
+   OSSIM_TRACE_SPAN(traceSpan, "ossimImageData::loadTile");
    if (!src)
    {
       ossimNotify(ossimNotifyLevel_WARN)
@@ -2995,6 +3302,14 @@ void ossimImageData::loadTile(const ossimImageData* src)
                src->getImageRectangle(),
                OSSIM_BSQ);
       setNullPix(src->getNullPix(), src->getNumberOfBands());
+
+      // Same rectangle, type and nulls: a status the source validated still holds here.
+      if ( src->m_statusCached && (src->getImageRectangle() == getImageRectangle()) )
+      {
+         setDataObjectStatus(src->getDataObjectStatus());
+         m_percentFull  = src->m_percentFull;
+         m_statusCached = true;
+      }
    }
    else // do a slow generic normalize to unnormalize copy
    {
@@ -3690,25 +4005,7 @@ void ossimImageData::computeMinMaxPix(T /* dummyValue */,
       if(bandBuffer)
       {
          const T NP   = static_cast<T>(getNullPix(band));
-         ossim_float64 currentMin = minBands[band];
-         ossim_float64 currentMax = maxBands[band];
-         for(ossim_uint32 offset = 0; offset < SPB; ++offset)
-         {
-            T p = bandBuffer[offset];
-            if(p != NP)
-            {
-               if(p < currentMin)
-               {
-                  currentMin = p;
-               }
-               else if(p > currentMax)
-               {
-                  currentMax = p;
-               }
-            }
-         }
-         minBands[band] = currentMin;
-         maxBands[band] = currentMax;
+         ossim::minMax(bandBuffer, SPB, NP, minBands[band], maxBands[band]);
       }
    }
 }
@@ -3835,45 +4132,20 @@ void ossimImageData::computeMinMaxNulPix(T /* dummyValue */,
       const T* bandBuffer = (const T*)getBuf(band);
       if(bandBuffer)
       {
-         ossim_float64 currentMin = minBands[band];
-         ossim_float64 currentMax = maxBands[band];
-         ossim_float64 currentNul = nulBands[band];
-         for(ossim_uint32 offset = 0; offset < SPB; ++offset)
-         {
-            T p = bandBuffer[offset];
-
-            // Since we are scanning for nulls this is making an assumption that the default
-            // null is incorrect and should be ignored in this scan as it could have been
-            // introduced by a make blank on a partial tile so ignore it.
-            // NOTE (OLK 03/2015): It is a bad idea to ignore pixels with default nulls, as it may
-            // be the actual null value being used. By ignoring it, a new null will be latched
-            // corresponding to actual, non-null, minimum value. Unfortunately, when tiles are
-            // initialized, they are filled with default nulls since (with float-data), the
-            // null (if any exists) is not yet known -- effectively creating two null pixel values.
-            // The recommendation (if you're looking at this code, then you're probably having the
-            // problem that your nulls aren't being recognized), is to turn off the flag in your
-            // ossim prefs file with: overview_builder.scan_for_min_max_null_if_float: false
-            // (or just delete that line)
-            if ( p != DEFAULT_NULL )
-            {
-               // Must do null first as min depends on null.
-               if ( p < currentNul )
-               {
-                  currentNul = p;
-               }
-               if( ( p < currentMin ) && ( p > currentNul ) )
-               {
-                  currentMin = p;
-               }
-               else if( p > currentMax )
-               {
-                  currentMax = p;
-               }
-            }
-         }
-         minBands[band] = currentMin;
-         maxBands[band] = currentMax;
-         nulBands[band] = currentNul;
+         // Since we are scanning for nulls this is making an assumption that the default
+         // null is incorrect and should be ignored in this scan as it could have been
+         // introduced by a make blank on a partial tile so ignore it.
+         // NOTE (OLK 03/2015): It is a bad idea to ignore pixels with default nulls, as it may
+         // be the actual null value being used. By ignoring it, a new null will be latched
+         // corresponding to actual, non-null, minimum value. Unfortunately, when tiles are
+         // initialized, they are filled with default nulls since (with float-data), the
+         // null (if any exists) is not yet known -- effectively creating two null pixel values.
+         // The recommendation (if you're looking at this code, then you're probably having the
+         // problem that your nulls aren't being recognized), is to turn off the flag in your
+         // ossim prefs file with: overview_builder.scan_for_min_max_null_if_float: false
+         // (or just delete that line)
+         ossim::minMaxNul(bandBuffer, SPB, DEFAULT_NULL,
+                          minBands[band], maxBands[band], nulBands[band]);
       }
    }
 }
@@ -3969,15 +4241,8 @@ void ossimImageData::loadTileFromBipTemplate(T, // dummy template variable
    
    for (ossim_uint32 line = 0; line < clipHeight; ++line)
    {
-      ossim_uint32 j = 0;
-      for (ossim_uint32 sample = 0; sample < clipWidth; ++sample)
-      {
-         for (band=0; band<num_bands; band++)
-         {
-            d[band][sample] = s[j+band];
-         }
-         j += num_bands;
-      }
+      ossim::bipToBands(s, reinterpret_cast<void* const*>(d), sizeof(T),
+                        num_bands, clipWidth);
       
       s += s_width;
       for (band=0; band<num_bands; band++)
@@ -4933,17 +5198,10 @@ ossimImageData::unloadTileToBipTemplate(T, // dummy template variable
          s[band] += src_offset;
       }
       
-      ossim_int32 j;
       for (ossim_int32 line=0; line<output_clip_height; ++line)
       {
-         j = 0;
-         for (ossim_int32 samp=0; samp<output_clip_width; ++samp, j+=num_bands)
-         {
-            for (band=0; band<num_bands; ++band)
-            {
-               d[j+band] = s[band][samp];
-            }
-         }
+         ossim::bandsToBip(reinterpret_cast<const void* const*>(s), d, sizeof(T),
+                           num_bands, output_clip_width);
          
          // increment to next line...
          d += buf_width;
@@ -5820,33 +6078,10 @@ void ossimImageData::copyTileToNormalizedBuffer(T /* dummyTemplate */,
    
    for(ossim_uint32 band = 0; band < BANDS; ++band)
    {
-      const ossim_float64 MIN_PIX = getMinPix(band);
-      const ossim_float64 MAX_PIX = getMaxPix(band);
-      const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-      const ossim_float64 NP      = getNullPix(band);
-
       const T* s = (T*)getBuf(band);  // source
       ossim_float64* d = (ossim_float64*)(buf + (band*SIZE));  // destination
-      
-      for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-      {
-         ossim_float64 p = s[offset];
-         if(p != NP)
-         {
-            if( p == MIN_PIX)
-            {
-               d[offset] = OSSIM_DEFAULT_MIN_PIX_NORM_DOUBLE;
-            }
-            else
-            {
-               d[offset] = (p-MIN_PIX)/RANGE;
-            }
-         }
-         else
-         {
-            d[offset] = 0.0;
-         }
-      }
+
+      ossim::normalize(s, d, SIZE, getMinPix(band), getMaxPix(band), getNullPix(band));
    }   
 }
 
@@ -5859,33 +6094,10 @@ void ossimImageData::copyTileToNormalizedBuffer(T /* dummyTemplate */,
    
    for(ossim_uint32 band = 0; band < BANDS; ++band)
    {
-      const ossim_float64 MIN_PIX = getMinPix(band);
-      const ossim_float64 MAX_PIX = getMaxPix(band);
-      const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-      const ossim_float64 NP      = getNullPix(band);
-      
       const T* s = (T*)getBuf(band);  // source
       ossim_float32* d = (ossim_float32*)(buf + (band*SIZE));  // destination
-      
-      for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-      {
-         ossim_float64 p = s[offset];
-         if(p != NP)
-         {
-            if( p == MIN_PIX)
-            {
-               d[offset] = OSSIM_DEFAULT_MIN_PIX_NORM_FLOAT;
-            }
-            else
-            {
-               d[offset] = (p-MIN_PIX)/RANGE;
-            }
-         }
-         else
-         {
-            d[offset] = 0.0;
-         }
-      }
+
+      ossim::normalize(s, d, SIZE, getMinPix(band), getMaxPix(band), getNullPix(band));
    }   
 }
 
@@ -5894,34 +6106,10 @@ void ossimImageData::copyTileToNormalizedBuffer(T /* dummyTemplate */,
                                                 ossim_uint32 band,
                                                 ossim_float64* buf) const
 {
-   const ossim_uint32  SIZE    = getSizePerBand();
-   const ossim_float64 MIN_PIX = getMinPix(band);
-   const ossim_float64 MAX_PIX = getMaxPix(band);
-   const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-   const ossim_float64 NP      = getNullPix(band);
-   
    const T* s = (T*)getBuf(band);  // source
-   ossim_float64* d = (ossim_float64*)(buf);  // destination
-   
-   for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-   {
-         ossim_float64 p = s[offset];
-         if(p != NP)
-         {
-            if( p == MIN_PIX)
-            {
-               d[offset] = OSSIM_DEFAULT_MIN_PIX_NORM_DOUBLE;
-            }
-            else
-            {
-               d[offset] = (p-MIN_PIX)/RANGE;
-            }
-         }
-         else
-         {
-            d[offset] = 0.0;
-         }
-   }   
+
+   ossim::normalize(s, buf, getSizePerBand(),
+                    getMinPix(band), getMaxPix(band), getNullPix(band));
 }
 
 template <class T>
@@ -5929,34 +6117,10 @@ void ossimImageData::copyTileToNormalizedBuffer(T /* dummyTemplate */,
                                                 ossim_uint32 band,
                                                 ossim_float32* buf) const
 {
-   const ossim_uint32  SIZE    = getSizePerBand();
-   const ossim_float64 MIN_PIX = getMinPix(band);
-   const ossim_float64 MAX_PIX = getMaxPix(band);
-   const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-   const ossim_float64 NP      = getNullPix(band);
-   
    const T* s = (T*)getBuf(band);  // source
-   ossim_float32* d     = (ossim_float32*)(buf);  // destination
-   
-   for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-   {
-      ossim_float64 p = s[offset];
-      if(p != NP)
-      {
-         if( p == MIN_PIX)
-         {
-            d[offset] = OSSIM_DEFAULT_MIN_PIX_NORM_FLOAT;
-         }
-         else
-         {
-            d[offset] = (p-MIN_PIX)/RANGE;
-         }
-      }
-      else
-      {
-         d[offset] = 0.0;
-      }
-   }   
+
+   ossim::normalize(s, buf, getSizePerBand(),
+                    getMinPix(band), getMaxPix(band), getNullPix(band));
 }
 
 template <class T>
@@ -5968,26 +6132,12 @@ void ossimImageData::copyNormalizedBufferToTile(T /* dummyTemplate */,
    
    for(ossim_uint32 band = 0; band < BANDS; ++band)
    {
-      const ossim_float64 MIN_PIX = getMinPix(band);
-      const ossim_float64 MAX_PIX = getMaxPix(band);
-      const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-      const T NP                  = (T)getNullPix(band);
-      
       ossim_float64* s = buf + (band*SIZE); // source
       T* d   = (T*)getBuf(band); // destination
-      
-      for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-      {
-         const ossim_float64 P = s[offset];
-         if(P != 0.0)
-         {
-            d[offset] = (T)(MIN_PIX + RANGE*P);
-         }
-         else
-         {
-            d[offset] = NP;
-         }
-      }
+
+      // Note: This path has never capped at the max pixel value.
+      ossim::unnormalize(s, d, SIZE, getMinPix(band), getMaxPix(band), getNullPix(band),
+                         false);
    }
 }
 
@@ -6000,28 +6150,11 @@ void ossimImageData::copyNormalizedBufferToTile(T /* dummyTemplate */,
    
    for(ossim_uint32 band = 0; band < BANDS; ++band)
    {
-      const ossim_float64 MIN_PIX = getMinPix(band);
-      const ossim_float64 MAX_PIX = getMaxPix(band);
-      const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-      const T             NP      = (T)getNullPix(band);
-      
       ossim_float32* s = buf + (band*SIZE); // source
       T* d   = (T*)getBuf(band); // destination
-      
-      for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-      {
-         const ossim_float64 P = s[offset];
-         if(P != 0.0)
-         {
-	   ossim_float64 test = MIN_PIX + RANGE*P;
-	   if(test > MAX_PIX) test = MAX_PIX;
-	   d[offset] = (T)test;
-         }
-         else
-         {
-            d[offset] = NP;
-         }
-      }
+
+      ossim::unnormalize(s, d, SIZE, getMinPix(band), getMaxPix(band), getNullPix(band),
+                         true);
    }
 }
 
@@ -6030,29 +6163,10 @@ void ossimImageData::copyNormalizedBufferToTile(T /* dummyTemplate */,
                                                 ossim_uint32 band,
                                                 ossim_float64* buf)
 {
-   const ossim_uint32  SIZE    = getSizePerBand();
-   const ossim_float64 MIN_PIX = getMinPix(band);
-   const ossim_float64 MAX_PIX = getMaxPix(band);
-   const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-   const T             NP      = (T)getNullPix(band);
-   
-   ossim_float64* s = buf; // source
-   T* d   = (T*)getBuf(band); // destination
-   
-   for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-   {
-      const ossim_float64 P = s[offset];
-      if(P != 0.0)
-      {
-	   ossim_float64 test = MIN_PIX + RANGE*P;
-	   if(test > MAX_PIX) test = MAX_PIX;
-	   d[offset] = (T)test;
-      }
-      else
-      {
-         d[offset] = NP;
-      }
-   }
+   T* d = (T*)getBuf(band); // destination
+
+   ossim::unnormalize(buf, d, getSizePerBand(),
+                      getMinPix(band), getMaxPix(band), getNullPix(band), true);
 }
 
 template <class T>
@@ -6060,29 +6174,10 @@ void ossimImageData::copyNormalizedBufferToTile(T /* dummyTemplate */,
                                                 ossim_uint32 band,
                                                 ossim_float32* buf)
 {
-   const ossim_uint32 SIZE     = getSizePerBand();
-   const ossim_float64 MIN_PIX = getMinPix(band);
-   const ossim_float64 MAX_PIX = getMaxPix(band);
-   const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-   const T NP                  = (T)getNullPix(band);
-   
-   ossim_float32* s = buf; // source
-   T* d   = (T*)getBuf(band); // destination
-   
-   for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-   {
-      const ossim_float64 P = s[offset];
-      if(P != 0.0)
-      {
-	   ossim_float64 test = MIN_PIX + RANGE*P;
-	   if(test > MAX_PIX) test = MAX_PIX;
-	   d[offset] = (T)test;
-      }
-      else
-      {
-         d[offset] = NP;
-      }
-   }
+   T* d = (T*)getBuf(band); // destination
+
+   ossim::unnormalize(buf, d, getSizePerBand(),
+                      getMinPix(band), getMaxPix(band), getNullPix(band), true);
 }
 
 void ossimImageData::copyTileBandToNormalizedBuffer(ossim_uint32 band,
@@ -7043,16 +7138,19 @@ void ossimImageData::getWidthHeight(ossim_uint32& w, ossim_uint32& h)
 
 void ossimImageData::setWidth(ossim_uint32 width)
 {
+   if (m_spatialExtents[0] != width) m_statusCached = false;
    m_spatialExtents[0] = width;
 }
 
 void ossimImageData::setHeight(ossim_uint32 height)
 {
+   if (m_spatialExtents[1] != height) m_statusCached = false;
    m_spatialExtents[1] = height;
 }
 
 void ossimImageData::setWidthHeight(ossim_uint32 w, ossim_uint32 h)
 {
+   if ( (m_spatialExtents[0] != w) || (m_spatialExtents[1] != h) ) m_statusCached = false;
    m_spatialExtents[0] = w;
    m_spatialExtents[1] = h;
 }
@@ -7234,6 +7332,12 @@ bool ossimImageData::getIndexedFlag() const
 bool ossimImageData::saveState(ossimKeywordlist& kwl, const char* prefix)const
 {
    bool result = ossimRectilinearDataObject::saveState(kwl, prefix);
+   if (m_sharedBuffer.valid())
+   {
+      ossimString byteEncoded; // The base saved the empty m_dataBuffer.
+      ossim::toSimpleStringList(byteEncoded, m_sharedBuffer->m_buffer);
+      kwl.add(prefix, "data_buffer", byteEncoded, true);
+   }
    ossimString null_pixels;
    ossimString min_pixels;
    ossimString max_pixels;
@@ -7256,7 +7360,10 @@ bool ossimImageData::saveState(ossimKeywordlist& kwl, const char* prefix)const
 
 bool ossimImageData::loadState(const ossimKeywordlist& kwl, const char* prefix)
 {
+   m_sharedBuffer = 0;
    bool result = ossimRectilinearDataObject::loadState(kwl, prefix);
+   m_statusCached = false;
+   updateAccounting();
    m_spatialExtents.resize(2);
    if(result)
    {
@@ -0,0 +1,176 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Accounting of the bytes held by ossimImageData buffers.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/imaging/ossimImageDataAccounting.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimSource.h>
+#include <ossim/base/ossimString.h>
+#include <OpenThreads/ScopedLock>
+#include <iostream>
+
+ossimImageDataAccounting* ossimImageDataAccounting::m_instance = 0;
+
+ossimImageDataAccounting::Statistics::Statistics()
+   : m_liveBytes(0),
+     m_peakBytes(0),
+     m_buffers(0),
+     m_allocations(0)
+{
+}
+
+ossimImageDataAccounting* ossimImageDataAccounting::instance()
+{
+   static OpenThreads::Mutex instanceMutex;
+   if (!m_instance)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(instanceMutex);
+      if (!m_instance)
+      {
+         m_instance = new ossimImageDataAccounting();
+      }
+   }
+   return m_instance;
+}
+
+ossimImageDataAccounting::ossimImageDataAccounting()
+   : m_mutex(),
+     m_total(),
+     m_accounts(1),
+     m_accountNames(1, std::string("unowned")),
+     m_accountOfClass(),
+     m_budget(0),
+     m_overBudget(false)
+{
+   const char* lookup = ossimPreferences::instance()->findPreference("image_data.memory_budget");
+   if (lookup)
+   {
+      m_budget = ossimString(lookup).toUInt64() * 1024 * 1024;
+   }
+}
+
+ossim_uint32 ossimImageDataAccounting::getAccount(const ossimSource* owner)
+{
+   if (!owner)
+   {
+      return 0;
+   }
+   const std::string name = owner->getClassName().string();
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   std::map<std::string, ossim_uint32>::const_iterator i = m_accountOfClass.find(name);
+   if (i != m_accountOfClass.end())
+   {
+      return i->second;
+   }
+   const ossim_uint32 account = (ossim_uint32)m_accounts.size();
+   m_accounts.push_back(Statistics());
+   m_accountNames.push_back(name);
+   m_accountOfClass.insert(std::make_pair(name, account));
+   return account;
+}
+
+void ossimImageDataAccounting::update(ossim_uint32 account,
+                                      ossim_uint64 oldBytes,
+                                      ossim_uint64 newBytes)
+{
+   if (oldBytes == newBytes)
+   {
+      return;
+   }
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   Statistics* stats[2] = { &m_total, &m_accounts[account < m_accounts.size() ? account : 0] };
+   for (ossim_uint32 i = 0; i < 2; ++i)
+   {
+      Statistics& s = *stats[i];
+      s.m_liveBytes = s.m_liveBytes + newBytes - oldBytes;
+      if (newBytes)
+      {
+         ++s.m_allocations;
+         if (!oldBytes) ++s.m_buffers;
+      }
+      else
+      {
+         --s.m_buffers;
+      }
+      if (s.m_liveBytes > s.m_peakBytes)
+      {
+         s.m_peakBytes = s.m_liveBytes;
+      }
+   }
+   m_overBudget = m_budget && (m_total.m_liveBytes > m_budget);
+}
+
+ossimImageDataAccounting::Statistics ossimImageDataAccounting::getStatistics() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   return m_total;
+}
+
+void ossimImageDataAccounting::getStatistics(std::map<std::string, Statistics>& stats) const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   stats.clear();
+   for (ossim_uint32 i = 0; i < m_accounts.size(); ++i)
+   {
+      stats[m_accountNames[i]] = m_accounts[i];
+   }
+}
+
+void ossimImageDataAccounting::resetPeaks()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   m_total.m_peakBytes = m_total.m_liveBytes;
+   for (ossim_uint32 i = 0; i < m_accounts.size(); ++i)
+   {
+      m_accounts[i].m_peakBytes = m_accounts[i].m_liveBytes;
+   }
+}
+
+void ossimImageDataAccounting::setBudget(ossim_uint64 bytes)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   m_budget = bytes;
+   m_overBudget = m_budget && (m_total.m_liveBytes > m_budget);
+}
+
+bool ossimImageDataAccounting::isOverBudget() const
+{
+   return m_overBudget;
+}
+
+std::ostream& ossimImageDataAccounting::print(std::ostream& out) const
+{
+   std::map<std::string, Statistics> accounts;
+   getStatistics(accounts);
+   Statistics total = getStatistics();
+
+   out << "ossimImageDataAccounting:"
+       << "\nbudget:      " << m_budget
+       << "\nlive_bytes:  " << total.m_liveBytes
+       << "\npeak_bytes:  " << total.m_peakBytes
+       << "\nbuffers:     " << total.m_buffers
+       << "\nallocations: " << total.m_allocations;
+   std::map<std::string, Statistics>::const_iterator i = accounts.begin();
+   while (i != accounts.end())
+   {
+      if (i->second.m_allocations)
+      {
+         out << "\n   " << i->first
+             << ": live_bytes=" << i->second.m_liveBytes
+             << " peak_bytes=" << i->second.m_peakBytes
+             << " buffers=" << i->second.m_buffers
+             << " allocations=" << i->second.m_allocations;
+      }
+      ++i;
+   }
+   out << std::endl;
+   return out;
+}
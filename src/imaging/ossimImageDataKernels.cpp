@@ -0,0 +1,2254 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Vectorized pixel kernels for the ossimImageData load/unload and normalization
+// paths.
+//
+// All vector paths convert samples to double precision and perform the same operations, in the
+// same order, as the scalar code so results are bit for bit identical.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/imaging/ossimImageDataKernels.h>
+#include <ossim/base/ossimSimd.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#if OSSIM_SIMD_X86
+#  include <immintrin.h>
+#endif
+
+namespace
+{
+   template <class T> inline T lowestValue()
+   {
+      return std::numeric_limits<T>::is_integer ?
+         std::numeric_limits<T>::min() : -std::numeric_limits<T>::infinity();
+   }
+
+   template <class T> inline T highestValue()
+   {
+      return std::numeric_limits<T>::is_integer ?
+         std::numeric_limits<T>::max() : std::numeric_limits<T>::infinity();
+   }
+
+   //---
+   // Scalar interleave helpers.  Band-outer loops so each destination is written contiguously.
+   //---
+   template <class T>
+   void bipToBandsScalar(const T* src, void* const* dest, ossim_uint32 bands,
+                         ossim_uint32 count)
+   {
+      for (ossim_uint32 band = 0; band < bands; ++band)
+      {
+         const T* s = src + band;
+         T* d = static_cast<T*>(dest[band]);
+         for (ossim_uint32 i = 0; i < count; ++i)
+         {
+            d[i] = s[i*bands];
+         }
+      }
+   }
+
+   template <class T>
+   void bandsToBipScalar(const void* const* src, T* dest, ossim_uint32 bands,
+                         ossim_uint32 count)
+   {
+      for (ossim_uint32 band = 0; band < bands; ++band)
+      {
+         const T* s = static_cast<const T*>(src[band]);
+         T* d = dest + band;
+         for (ossim_uint32 i = 0; i < count; ++i)
+         {
+            d[i*bands] = s[i];
+         }
+      }
+   }
+
+   void bipToBandsScalar(const void* src, void* const* dest, ossim_uint32 elementSize,
+                         ossim_uint32 bands, ossim_uint32 count, ossim_uint32 start)
+   {
+      void* d[256];
+      for (ossim_uint32 band = 0; band < bands; ++band)
+      {
+         d[band] = static_cast<ossim_uint8*>(dest[band]) + start*elementSize;
+      }
+      const void* s = static_cast<const ossim_uint8*>(src) + start*elementSize*bands;
+      count -= start;
+      switch (elementSize)
+      {
+         case 1: bipToBandsScalar(static_cast<const ossim_uint8*>(s),  d, bands, count); break;
+         case 2: bipToBandsScalar(static_cast<const ossim_uint16*>(s), d, bands, count); break;
+         case 4: bipToBandsScalar(static_cast<const ossim_uint32*>(s), d, bands, count); break;
+         case 8: bipToBandsScalar(static_cast<const ossim_uint64*>(s), d, bands, count); break;
+         default:
+         {
+            const ossim_uint8* sb = static_cast<const ossim_uint8*>(s);
+            for (ossim_uint32 i = 0; i < count; ++i)
+            {
+               for (ossim_uint32 band = 0; band < bands; ++band)
+               {
+                  memcpy(static_cast<ossim_uint8*>(d[band]) + i*elementSize,
+                         sb + (i*bands + band)*elementSize, elementSize);
+               }
+            }
+         }
+      }
+   }
+
+   void bandsToBipScalar(const void* const* src, void* dest, ossim_uint32 elementSize,
+                         ossim_uint32 bands, ossim_uint32 count, ossim_uint32 start)
+   {
+      const void* s[256];
+      for (ossim_uint32 band = 0; band < bands; ++band)
+      {
+         s[band] = static_cast<const ossim_uint8*>(src[band]) + start*elementSize;
+      }
+      void* d = static_cast<ossim_uint8*>(dest) + start*elementSize*bands;
+      count -= start;
+      switch (elementSize)
+      {
+         case 1: bandsToBipScalar(s, static_cast<ossim_uint8*>(d),  bands, count); break;
+         case 2: bandsToBipScalar(s, static_cast<ossim_uint16*>(d), bands, count); break;
+         case 4: bandsToBipScalar(s, static_cast<ossim_uint32*>(d), bands, count); break;
+         case 8: bandsToBipScalar(s, static_cast<ossim_uint64*>(d), bands, count); break;
+         default:
+         {
+            ossim_uint8* db = static_cast<ossim_uint8*>(d);
+            for (ossim_uint32 i = 0; i < count; ++i)
+            {
+               for (ossim_uint32 band = 0; band < bands; ++band)
+               {
+                  memcpy(db + (i*bands + band)*elementSize,
+                         static_cast<const ossim_uint8*>(s[band]) + i*elementSize, elementSize);
+               }
+            }
+         }
+      }
+   }
+
+#if OSSIM_SIMD_X86
+
+   //---
+   // SSE2: 4 samples per iteration, processed as two pairs of doubles.
+   //---
+   OSSIM_SIMD_TARGET("sse2")
+   inline void load4(const ossim_uint8* s, __m128d& lo, __m128d& hi)
+   {
+      int v;
+      memcpy(&v, s, 4);
+      const __m128i ZERO = _mm_setzero_si128();
+      __m128i x = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v), ZERO), ZERO);
+      lo = _mm_cvtepi32_pd(x);
+      hi = _mm_cvtepi32_pd(_mm_shuffle_epi32(x, 0xEE));
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline void load4(const ossim_uint16* s, __m128d& lo, __m128d& hi)
+   {
+      __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s));
+      x = _mm_unpacklo_epi16(x, _mm_setzero_si128());
+      lo = _mm_cvtepi32_pd(x);
+      hi = _mm_cvtepi32_pd(_mm_shuffle_epi32(x, 0xEE));
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline void load4(const ossim_sint16* s, __m128d& lo, __m128d& hi)
+   {
+      __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s));
+      x = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+      lo = _mm_cvtepi32_pd(x);
+      hi = _mm_cvtepi32_pd(_mm_shuffle_epi32(x, 0xEE));
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline void load4(const ossim_float32* s, __m128d& lo, __m128d& hi)
+   {
+      __m128 v = _mm_loadu_ps(s);
+      lo = _mm_cvtps_pd(v);
+      hi = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline void load4(const ossim_float64* s, __m128d& lo, __m128d& hi)
+   {
+      lo = _mm_loadu_pd(s);
+      hi = _mm_loadu_pd(s + 2);
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline void store4(ossim_float64* d, __m128d lo, __m128d hi)
+   {
+      _mm_storeu_pd(d, lo);
+      _mm_storeu_pd(d + 2, hi);
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline void store4(ossim_float32* d, __m128d lo, __m128d hi)
+   {
+      _mm_storeu_ps(d, _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi)));
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline __m128i toInt4(__m128d lo, __m128d hi)
+   {
+      return _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline void store4(ossim_uint8* d, __m128d lo, __m128d hi)
+   {
+      __m128i x = _mm_packs_epi32(toInt4(lo, hi), _mm_setzero_si128());
+      int v = _mm_cvtsi128_si32(_mm_packus_epi16(x, x));
+      memcpy(d, &v, 4);
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline void store4(ossim_sint16* d, __m128d lo, __m128d hi)
+   {
+      __m128i x = _mm_packs_epi32(toInt4(lo, hi), _mm_setzero_si128());
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(d), x);
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline void store4(ossim_uint16* d, __m128d lo, __m128d hi)
+   {
+      // No unsigned 32->16 pack before SSE4.1; bias into signed range and back.
+      __m128i x = _mm_sub_epi32(toInt4(lo, hi), _mm_set1_epi32(32768));
+      x = _mm_packs_epi32(x, _mm_setzero_si128());
+      x = _mm_xor_si128(x, _mm_set1_epi16((short)0x8000));
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(d), x);
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline __m128d select(__m128d mask, __m128d a, __m128d b)
+   {
+      return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline __m128d normalize2(__m128d p, __m128d MIN, __m128d RANGE, __m128d NP, __m128d MIN_NORM)
+   {
+      __m128d v = _mm_div_pd(_mm_sub_pd(p, MIN), RANGE);
+      v = select(_mm_cmpeq_pd(p, MIN), MIN_NORM, v);
+      return _mm_andnot_pd(_mm_cmpeq_pd(p, NP), v); // null -> 0
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline __m128d unnormalize2(__m128d p, __m128d MIN, __m128d MAX, __m128d RANGE, __m128d NP,
+                               bool clampFlag)
+   {
+      __m128d v = _mm_add_pd(MIN, _mm_mul_pd(RANGE, p));
+      if (clampFlag)
+      {
+         v = select(_mm_cmpgt_pd(v, MAX), MAX, v);
+      }
+      return select(_mm_cmpeq_pd(p, _mm_setzero_pd()), NP, v);
+   }
+
+   template <class S, class D>
+   OSSIM_SIMD_TARGET("sse2")
+   void normalizeSse2(const S* s, D* d, ossim_uint32 count, ossim_float64 minPix,
+                      ossim_float64 maxPix, ossim_float64 nullPix, ossim_float64 minNorm)
+   {
+      const __m128d MIN      = _mm_set1_pd(minPix);
+      const __m128d RANGE    = _mm_set1_pd(maxPix - minPix);
+      const __m128d NP       = _mm_set1_pd(nullPix);
+      const __m128d MIN_NORM = _mm_set1_pd(minNorm);
+      ossim_uint32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         __m128d lo, hi;
+         load4(s + i, lo, hi);
+         store4(d + i, normalize2(lo, MIN, RANGE, NP, MIN_NORM),
+                normalize2(hi, MIN, RANGE, NP, MIN_NORM));
+      }
+      ossim::normalize<S, D>(s + i, d + i, count - i, minPix, maxPix, nullPix);
+   }
+
+   template <class S, class D>
+   OSSIM_SIMD_TARGET("sse2")
+   void unnormalizeSse2(const S* s, D* d, ossim_uint32 count, ossim_float64 minPix,
+                        ossim_float64 maxPix, ossim_float64 nullPix, bool clampFlag)
+   {
+      const __m128d MIN   = _mm_set1_pd(minPix);
+      const __m128d MAX   = _mm_set1_pd(maxPix);
+      const __m128d RANGE = _mm_set1_pd(maxPix - minPix);
+      const __m128d NP    = _mm_set1_pd(nullPix);
+      ossim_uint32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         __m128d lo, hi;
+         load4(s + i, lo, hi);
+         store4(d + i, unnormalize2(lo, MIN, MAX, RANGE, NP, clampFlag),
+                unnormalize2(hi, MIN, MAX, RANGE, NP, clampFlag));
+      }
+      ossim::unnormalize<S, D>(s + i, d + i, count - i, minPix, maxPix, nullPix, clampFlag);
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline __m128d clamp2(__m128d v, __m128d MIN, __m128d MAX)
+   {
+      v = select(_mm_cmpgt_pd(v, MAX), MAX, v);
+      return select(_mm_cmplt_pd(v, MIN), MIN, v);
+   }
+
+   template <class S, class D>
+   OSSIM_SIMD_TARGET("sse2")
+   void remapSse2(const S* s, D* d, ossim_uint32 count,
+                  ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                  ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull)
+   {
+      const __m128d IN_MIN    = _mm_set1_pd(inMin);
+      const __m128d IN_RANGE  = _mm_set1_pd(inMax - inMin);
+      const __m128d IN_NP     = _mm_set1_pd(inNull);
+      const __m128d MIN_NORM  = _mm_set1_pd(OSSIM_DEFAULT_MIN_PIX_NORM_DOUBLE);
+      const __m128d OUT_MIN   = _mm_set1_pd(outMin);
+      const __m128d OUT_MAX   = _mm_set1_pd(outMax);
+      const __m128d OUT_RANGE = _mm_set1_pd(outMax - outMin);
+      const __m128d OUT_NP    = _mm_set1_pd(outNull);
+      const __m128d ZERO      = _mm_setzero_pd();
+      ossim_uint32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         __m128d lo, hi;
+         load4(s + i, lo, hi);
+         lo = normalize2(lo, IN_MIN, IN_RANGE, IN_NP, MIN_NORM);
+         hi = normalize2(hi, IN_MIN, IN_RANGE, IN_NP, MIN_NORM);
+         __m128d vlo = clamp2(_mm_add_pd(OUT_MIN, _mm_mul_pd(OUT_RANGE, lo)), OUT_MIN, OUT_MAX);
+         __m128d vhi = clamp2(_mm_add_pd(OUT_MIN, _mm_mul_pd(OUT_RANGE, hi)), OUT_MIN, OUT_MAX);
+         store4(d + i, select(_mm_cmpeq_pd(lo, ZERO), OUT_NP, vlo),
+                select(_mm_cmpeq_pd(hi, ZERO), OUT_NP, vhi));
+      }
+      ossim::remap<S, D>(s + i, d + i, count - i, inMin, inMax, inNull, outMin, outMax, outNull);
+   }
+
+   template <class S, class D>
+   OSSIM_SIMD_TARGET("sse2")
+   void castClampSse2(const S* s, D* d, ossim_uint32 count, ossim_float64 outMin,
+                      ossim_float64 outMax, bool nullFlag, ossim_float64 inNull,
+                      ossim_float64 outNull)
+   {
+      const __m128d OUT_MIN = _mm_set1_pd(outMin);
+      const __m128d OUT_MAX = _mm_set1_pd(outMax);
+      const __m128d IN_NP   = _mm_set1_pd((ossim_float64)(S)inNull);
+      const __m128d OUT_NP  = _mm_set1_pd((ossim_float64)(D)outNull);
+      ossim_uint32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         __m128d lo, hi;
+         load4(s + i, lo, hi);
+         __m128d vlo = clamp2(lo, OUT_MIN, OUT_MAX);
+         __m128d vhi = clamp2(hi, OUT_MIN, OUT_MAX);
+         if (nullFlag)
+         {
+            vlo = select(_mm_cmpeq_pd(lo, IN_NP), OUT_NP, vlo);
+            vhi = select(_mm_cmpeq_pd(hi, IN_NP), OUT_NP, vhi);
+         }
+         store4(d + i, vlo, vhi);
+      }
+      ossim::castClamp<S, D>(s + i, d + i, count - i, outMin, outMax, nullFlag, inNull, outNull);
+   }
+
+   //---
+   // AVX2: 8 samples per iteration, processed as two quads of doubles.
+   //---
+   OSSIM_SIMD_TARGET("avx2")
+   inline void load8(const ossim_uint8* s, __m256d& lo, __m256d& hi)
+   {
+      __m256i x = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(s)));
+      lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(x));
+      hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(x, 1));
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline void load8(const ossim_uint16* s, __m256d& lo, __m256d& hi)
+   {
+      __m256i x = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+      lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(x));
+      hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(x, 1));
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline void load8(const ossim_sint16* s, __m256d& lo, __m256d& hi)
+   {
+      __m256i x = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+      lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(x));
+      hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(x, 1));
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline void load8(const ossim_float32* s, __m256d& lo, __m256d& hi)
+   {
+      __m256 v = _mm256_loadu_ps(s);
+      lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+      hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline void load8(const ossim_float64* s, __m256d& lo, __m256d& hi)
+   {
+      lo = _mm256_loadu_pd(s);
+      hi = _mm256_loadu_pd(s + 4);
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline void store8(ossim_float64* d, __m256d lo, __m256d hi)
+   {
+      _mm256_storeu_pd(d, lo);
+      _mm256_storeu_pd(d + 4, hi);
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline void store8(ossim_float32* d, __m256d lo, __m256d hi)
+   {
+      _mm_storeu_ps(d, _mm256_cvtpd_ps(lo));
+      _mm_storeu_ps(d + 4, _mm256_cvtpd_ps(hi));
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline void store8(ossim_uint8* d, __m256d lo, __m256d hi)
+   {
+      __m128i x = _mm_packs_epi32(_mm256_cvttpd_epi32(lo), _mm256_cvttpd_epi32(hi));
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(d), _mm_packus_epi16(x, x));
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline void store8(ossim_sint16* d, __m256d lo, __m256d hi)
+   {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(d),
+                       _mm_packs_epi32(_mm256_cvttpd_epi32(lo), _mm256_cvttpd_epi32(hi)));
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline void store8(ossim_uint16* d, __m256d lo, __m256d hi)
+   {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(d),
+                       _mm_packus_epi32(_mm256_cvttpd_epi32(lo), _mm256_cvttpd_epi32(hi)));
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline __m256d normalize4(__m256d p, __m256d MIN, __m256d RANGE, __m256d NP, __m256d MIN_NORM)
+   {
+      __m256d v = _mm256_div_pd(_mm256_sub_pd(p, MIN), RANGE);
+      v = _mm256_blendv_pd(v, MIN_NORM, _mm256_cmp_pd(p, MIN, _CMP_EQ_OQ));
+      return _mm256_andnot_pd(_mm256_cmp_pd(p, NP, _CMP_EQ_OQ), v); // null -> 0
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline __m256d unnormalize4(__m256d p, __m256d MIN, __m256d MAX, __m256d RANGE, __m256d NP,
+                               bool clampFlag)
+   {
+      __m256d v = _mm256_add_pd(MIN, _mm256_mul_pd(RANGE, p));
+      if (clampFlag)
+      {
+         v = _mm256_blendv_pd(v, MAX, _mm256_cmp_pd(v, MAX, _CMP_GT_OQ));
+      }
+      return _mm256_blendv_pd(v, NP, _mm256_cmp_pd(p, _mm256_setzero_pd(), _CMP_EQ_OQ));
+   }
+
+   template <class S, class D>
+   OSSIM_SIMD_TARGET("avx2")
+   void normalizeAvx2(const S* s, D* d, ossim_uint32 count, ossim_float64 minPix,
+                      ossim_float64 maxPix, ossim_float64 nullPix, ossim_float64 minNorm)
+   {
+      const __m256d MIN      = _mm256_set1_pd(minPix);
+      const __m256d RANGE    = _mm256_set1_pd(maxPix - minPix);
+      const __m256d NP       = _mm256_set1_pd(nullPix);
+      const __m256d MIN_NORM = _mm256_set1_pd(minNorm);
+      ossim_uint32 i = 0;
+      for (; i + 8 <= count; i += 8)
+      {
+         __m256d lo, hi;
+         load8(s + i, lo, hi);
+         store8(d + i, normalize4(lo, MIN, RANGE, NP, MIN_NORM),
+                normalize4(hi, MIN, RANGE, NP, MIN_NORM));
+      }
+      ossim::normalize<S, D>(s + i, d + i, count - i, minPix, maxPix, nullPix);
+   }
+
+   template <class S, class D>
+   OSSIM_SIMD_TARGET("avx2")
+   void unnormalizeAvx2(const S* s, D* d, ossim_uint32 count, ossim_float64 minPix,
+                        ossim_float64 maxPix, ossim_float64 nullPix, bool clampFlag)
+   {
+      const __m256d MIN   = _mm256_set1_pd(minPix);
+      const __m256d MAX   = _mm256_set1_pd(maxPix);
+      const __m256d RANGE = _mm256_set1_pd(maxPix - minPix);
+      const __m256d NP    = _mm256_set1_pd(nullPix);
+      ossim_uint32 i = 0;
+      for (; i + 8 <= count; i += 8)
+      {
+         __m256d lo, hi;
+         load8(s + i, lo, hi);
+         store8(d + i, unnormalize4(lo, MIN, MAX, RANGE, NP, clampFlag),
+                unnormalize4(hi, MIN, MAX, RANGE, NP, clampFlag));
+      }
+      ossim::unnormalize<S, D>(s + i, d + i, count - i, minPix, maxPix, nullPix, clampFlag);
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline __m256d clamp4(__m256d v, __m256d MIN, __m256d MAX)
+   {
+      v = _mm256_blendv_pd(v, MAX, _mm256_cmp_pd(v, MAX, _CMP_GT_OQ));
+      return _mm256_blendv_pd(v, MIN, _mm256_cmp_pd(v, MIN, _CMP_LT_OQ));
+   }
+
+   template <class S, class D>
+   OSSIM_SIMD_TARGET("avx2")
+   void remapAvx2(const S* s, D* d, ossim_uint32 count,
+                  ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                  ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull)
+   {
+      const __m256d IN_MIN    = _mm256_set1_pd(inMin);
+      const __m256d IN_RANGE  = _mm256_set1_pd(inMax - inMin);
+      const __m256d IN_NP     = _mm256_set1_pd(inNull);
+      const __m256d MIN_NORM  = _mm256_set1_pd(OSSIM_DEFAULT_MIN_PIX_NORM_DOUBLE);
+      const __m256d OUT_MIN   = _mm256_set1_pd(outMin);
+      const __m256d OUT_MAX   = _mm256_set1_pd(outMax);
+      const __m256d OUT_RANGE = _mm256_set1_pd(outMax - outMin);
+      const __m256d OUT_NP    = _mm256_set1_pd(outNull);
+      const __m256d ZERO      = _mm256_setzero_pd();
+      ossim_uint32 i = 0;
+      for (; i + 8 <= count; i += 8)
+      {
+         __m256d lo, hi;
+         load8(s + i, lo, hi);
+         lo = normalize4(lo, IN_MIN, IN_RANGE, IN_NP, MIN_NORM);
+         hi = normalize4(hi, IN_MIN, IN_RANGE, IN_NP, MIN_NORM);
+         __m256d vlo = clamp4(_mm256_add_pd(OUT_MIN, _mm256_mul_pd(OUT_RANGE, lo)),
+                              OUT_MIN, OUT_MAX);
+         __m256d vhi = clamp4(_mm256_add_pd(OUT_MIN, _mm256_mul_pd(OUT_RANGE, hi)),
+                              OUT_MIN, OUT_MAX);
+         store8(d + i, _mm256_blendv_pd(vlo, OUT_NP, _mm256_cmp_pd(lo, ZERO, _CMP_EQ_OQ)),
+                _mm256_blendv_pd(vhi, OUT_NP, _mm256_cmp_pd(hi, ZERO, _CMP_EQ_OQ)));
+      }
+      ossim::remap<S, D>(s + i, d + i, count - i, inMin, inMax, inNull, outMin, outMax, outNull);
+   }
+
+   template <class S, class D>
+   OSSIM_SIMD_TARGET("avx2")
+   void castClampAvx2(const S* s, D* d, ossim_uint32 count, ossim_float64 outMin,
+                      ossim_float64 outMax, bool nullFlag, ossim_float64 inNull,
+                      ossim_float64 outNull)
+   {
+      const __m256d OUT_MIN = _mm256_set1_pd(outMin);
+      const __m256d OUT_MAX = _mm256_set1_pd(outMax);
+      const __m256d IN_NP   = _mm256_set1_pd((ossim_float64)(S)inNull);
+      const __m256d OUT_NP  = _mm256_set1_pd((ossim_float64)(D)outNull);
+      ossim_uint32 i = 0;
+      for (; i + 8 <= count; i += 8)
+      {
+         __m256d lo, hi;
+         load8(s + i, lo, hi);
+         __m256d vlo = clamp4(lo, OUT_MIN, OUT_MAX);
+         __m256d vhi = clamp4(hi, OUT_MIN, OUT_MAX);
+         if (nullFlag)
+         {
+            vlo = _mm256_blendv_pd(vlo, OUT_NP, _mm256_cmp_pd(lo, IN_NP, _CMP_EQ_OQ));
+            vhi = _mm256_blendv_pd(vhi, OUT_NP, _mm256_cmp_pd(hi, IN_NP, _CMP_EQ_OQ));
+         }
+         store8(d + i, vlo, vhi);
+      }
+      ossim::castClamp<S, D>(s + i, d + i, count - i, outMin, outMax, nullFlag, inNull, outNull);
+   }
+
+   //---
+   // SSSE3 interleave conversions for 1, 2 and 4 byte samples with 2, 3 or 4 bands. A chunk is
+   // 16 bytes per band; each output register is the OR of one byte shuffle per input register.
+   //---
+   class ShuffleMasks
+   {
+   public:
+      ShuffleMasks()
+      {
+         for (ossim_uint32 e = 0; e < 3; ++e)
+         {
+            const ossim_uint32 size = 1 << e;
+            for (ossim_uint32 bands = 2; bands <= 4; ++bands)
+            {
+               for (ossim_uint32 a = 0; a < bands; ++a)
+               {
+                  for (ossim_uint32 b = 0; b < bands; ++b)
+                  {
+                     for (ossim_uint32 i = 0; i < 16; ++i)
+                     {
+                        // Deinterleave: output band a, byte i, taken from input register b.
+                        ossim_uint32 g = ((i/size)*bands + a)*size + i%size;
+                        m_toBands[e][bands-2][a][b][i] = (g/16 == b) ? (ossim_int8)(g%16) : -128;
+
+                        // Interleave: output register a, byte i, taken from band b.
+                        g = a*16 + i;
+                        const ossim_uint32 element = g / size;
+                        m_toBip[e][bands-2][a][b][i] = (element%bands == b) ?
+                           (ossim_int8)((element/bands)*size + g%size) : -128;
+                     }
+                  }
+               }
+            }
+         }
+      }
+      ossim_int8 m_toBands[3][3][4][4][16];
+      ossim_int8 m_toBip[3][3][4][4][16];
+   };
+
+   const ShuffleMasks& shuffleMasks()
+   {
+      static const ShuffleMasks MASKS;
+      return MASKS;
+   }
+
+   inline ossim_uint32 sizeIndex(ossim_uint32 elementSize)
+   {
+      return (elementSize == 1) ? 0 : ( (elementSize == 2) ? 1 : 2 );
+   }
+
+   OSSIM_SIMD_TARGET("ssse3")
+   ossim_uint32 bipToBandsSsse3(const void* src, void* const* dest, ossim_uint32 elementSize,
+                                ossim_uint32 bands, ossim_uint32 count)
+   {
+      const ossim_uint32 e = sizeIndex(elementSize);
+      const ossim_uint32 perChunk = 16 / elementSize;
+      const ossim_uint32 chunks = count / perChunk;
+      const ossim_int8 (*masks)[4][16] = shuffleMasks().m_toBands[e][bands-2];
+
+      __m128i m[4][4];
+      for (ossim_uint32 a = 0; a < bands; ++a)
+         for (ossim_uint32 b = 0; b < bands; ++b)
+            m[a][b] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks[a][b]));
+
+      const __m128i* s = static_cast<const __m128i*>(src);
+      for (ossim_uint32 c = 0; c < chunks; ++c)
+      {
+         __m128i in[4];
+         for (ossim_uint32 b = 0; b < bands; ++b)
+         {
+            in[b] = _mm_loadu_si128(s++);
+         }
+         for (ossim_uint32 a = 0; a < bands; ++a)
+         {
+            __m128i out = _mm_shuffle_epi8(in[0], m[a][0]);
+            for (ossim_uint32 b = 1; b < bands; ++b)
+            {
+               out = _mm_or_si128(out, _mm_shuffle_epi8(in[b], m[a][b]));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest[a]) + c, out);
+         }
+      }
+      return chunks * perChunk;
+   }
+
+   OSSIM_SIMD_TARGET("ssse3")
+   ossim_uint32 bandsToBipSsse3(const void* const* src, void* dest, ossim_uint32 elementSize,
+                                ossim_uint32 bands, ossim_uint32 count)
+   {
+      const ossim_uint32 e = sizeIndex(elementSize);
+      const ossim_uint32 perChunk = 16 / elementSize;
+      const ossim_uint32 chunks = count / perChunk;
+      const ossim_int8 (*masks)[4][16] = shuffleMasks().m_toBip[e][bands-2];
+
+      __m128i m[4][4];
+      for (ossim_uint32 a = 0; a < bands; ++a)
+         for (ossim_uint32 b = 0; b < bands; ++b)
+            m[a][b] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks[a][b]));
+
+      __m128i* d = static_cast<__m128i*>(dest);
+      for (ossim_uint32 c = 0; c < chunks; ++c)
+      {
+         __m128i in[4];
+         for (ossim_uint32 b = 0; b < bands; ++b)
+         {
+            in[b] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src[b]) + c);
+         }
+         for (ossim_uint32 a = 0; a < bands; ++a)
+         {
+            __m128i out = _mm_shuffle_epi8(in[0], m[a][0]);
+            for (ossim_uint32 b = 1; b < bands; ++b)
+            {
+               out = _mm_or_si128(out, _mm_shuffle_epi8(in[b], m[a][b]));
+            }
+            _mm_storeu_si128(d++, out);
+         }
+      }
+      return chunks * perChunk;
+   }
+
+   //---
+   // Null sample counting.  Each helper returns an 8 bit lane compare mask (0xff == null) for
+   // 16 (SSE2) or 32 (AVX2) samples, so every type shares the same byte counting loop.
+   //---
+   OSSIM_SIMD_TARGET("sse2")
+   inline __m128i nullMask16(const ossim_uint8* s, __m128i np)
+   {
+      return _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s)), np);
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline __m128i nullMask16(const ossim_uint16* s, __m128i np)
+   {
+      const __m128i* p = reinterpret_cast<const __m128i*>(s);
+      return _mm_packs_epi16(_mm_cmpeq_epi16(_mm_loadu_si128(p), np),
+                             _mm_cmpeq_epi16(_mm_loadu_si128(p + 1), np));
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline __m128i nullMask16(const ossim_float32* s, __m128i np)
+   {
+      const __m128 NP = _mm_castsi128_ps(np);
+      const __m128i M0 = _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(s), NP));
+      const __m128i M1 = _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(s + 4), NP));
+      const __m128i M2 = _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(s + 8), NP));
+      const __m128i M3 = _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(s + 12), NP));
+      return _mm_packs_epi16(_mm_packs_epi32(M0, M1), _mm_packs_epi32(M2, M3));
+   }
+
+   // Null value broadcasts, as raw bits, for the compare helpers.
+   OSSIM_SIMD_TARGET("sse2")
+   inline __m128i nullVec128(ossim_uint8 v)   { return _mm_set1_epi8((char)v); }
+   OSSIM_SIMD_TARGET("sse2")
+   inline __m128i nullVec128(ossim_uint16 v)  { return _mm_set1_epi16((short)v); }
+   OSSIM_SIMD_TARGET("sse2")
+   inline __m128i nullVec128(ossim_float32 v) { return _mm_castps_si128(_mm_set1_ps(v)); }
+   OSSIM_SIMD_TARGET("avx2")
+   inline __m256i nullVec256(ossim_uint8 v)   { return _mm256_set1_epi8((char)v); }
+   OSSIM_SIMD_TARGET("avx2")
+   inline __m256i nullVec256(ossim_uint16 v)  { return _mm256_set1_epi16((short)v); }
+   OSSIM_SIMD_TARGET("avx2")
+   inline __m256i nullVec256(ossim_float32 v) { return _mm256_castps_si256(_mm256_set1_ps(v)); }
+
+   template <class T>
+   OSSIM_SIMD_TARGET("sse2")
+   ossim_uint32 countNullSse2(const T* s, ossim_uint32 count, T nullPix, ossim_uint32& done)
+   {
+      const __m128i np = nullVec128(nullPix);
+      const __m128i ZERO = _mm_setzero_si128();
+      __m128i total = ZERO;
+      ossim_uint32 i = 0;
+      while (i + 16 <= count)
+      {
+         // Byte counters hold at most 255 before they are summed into the 64 bit totals.
+         __m128i acc = ZERO;
+         for (ossim_uint32 n = 0; (n < 255) && (i + 16 <= count); ++n, i += 16)
+         {
+            acc = _mm_sub_epi8(acc, nullMask16(s + i, np));
+         }
+         total = _mm_add_epi64(total, _mm_sad_epu8(acc, ZERO));
+      }
+      done = i;
+      ossim_uint64 t[2];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(t), total);
+      return static_cast<ossim_uint32>(t[0] + t[1]);
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline __m256i nullMask32(const ossim_uint8* s, __m256i np)
+   {
+      return _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)), np);
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline __m256i nullMask32(const ossim_uint16* s, __m256i np)
+   {
+      // Pack order is per 128 bit lane; it does not matter for counting.
+      const __m256i* p = reinterpret_cast<const __m256i*>(s);
+      return _mm256_packs_epi16(_mm256_cmpeq_epi16(_mm256_loadu_si256(p), np),
+                                _mm256_cmpeq_epi16(_mm256_loadu_si256(p + 1), np));
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline __m256i nullMask32(const ossim_float32* s, __m256i np)
+   {
+      const __m256 NP = _mm256_castsi256_ps(np);
+      const __m256i M0 = _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(s), NP, _CMP_EQ_OQ));
+      const __m256i M1 =
+         _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(s + 8), NP, _CMP_EQ_OQ));
+      const __m256i M2 =
+         _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(s + 16), NP, _CMP_EQ_OQ));
+      const __m256i M3 =
+         _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(s + 24), NP, _CMP_EQ_OQ));
+      return _mm256_packs_epi16(_mm256_packs_epi32(M0, M1), _mm256_packs_epi32(M2, M3));
+   }
+
+   template <class T>
+   OSSIM_SIMD_TARGET("avx2")
+   ossim_uint32 countNullAvx2(const T* s, ossim_uint32 count, T nullPix, ossim_uint32& done)
+   {
+      const __m256i np = nullVec256(nullPix);
+      const __m256i ZERO = _mm256_setzero_si256();
+      __m256i total = ZERO;
+      ossim_uint32 i = 0;
+      while (i + 32 <= count)
+      {
+         __m256i acc = ZERO;
+         for (ossim_uint32 n = 0; (n < 255) && (i + 32 <= count); ++n, i += 32)
+         {
+            acc = _mm256_sub_epi8(acc, nullMask32(s + i, np));
+         }
+         total = _mm256_add_epi64(total, _mm256_sad_epu8(acc, ZERO));
+      }
+      done = i;
+      ossim_uint64 t[4];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(t), total);
+      return static_cast<ossim_uint32>(t[0] + t[1] + t[2] + t[3]);
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   ossim_uint32 addWeightedSse2(const ossim_float64* s, ossim_float64* d, ossim_uint32 count,
+                                ossim_float64 weight)
+   {
+      const __m128d W = _mm_set1_pd(weight);
+      ossim_uint32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         _mm_storeu_pd(d + i,
+                       _mm_add_pd(_mm_loadu_pd(d + i), _mm_mul_pd(W, _mm_loadu_pd(s + i))));
+         _mm_storeu_pd(d + i + 2,
+                       _mm_add_pd(_mm_loadu_pd(d + i + 2), _mm_mul_pd(W, _mm_loadu_pd(s + i + 2))));
+      }
+      return i;
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   ossim_uint32 addWeightedAvx2(const ossim_float64* s, ossim_float64* d, ossim_uint32 count,
+                                ossim_float64 weight)
+   {
+      const __m256d W = _mm256_set1_pd(weight);
+      ossim_uint32 i = 0;
+      for (; i + 8 <= count; i += 8)
+      {
+         _mm256_storeu_pd(d + i, _mm256_add_pd(_mm256_loadu_pd(d + i),
+                                               _mm256_mul_pd(W, _mm256_loadu_pd(s + i))));
+         _mm256_storeu_pd(d + i + 4, _mm256_add_pd(_mm256_loadu_pd(d + i + 4),
+                                                   _mm256_mul_pd(W, _mm256_loadu_pd(s + i + 4))));
+      }
+      return i;
+   }
+
+   //---
+   // Equal weight blend. The average is taken as (d & s) + ((d ^ s) >> 1), which is exact and
+   // rounds down, as the scalar code does for unsigned types, without widening.
+   //---
+   OSSIM_SIMD_TARGET("sse2")
+   inline __m128i blendSelect(__m128i mask, __m128i a, __m128i b)
+   {
+      return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   ossim_uint32 blendEqualSse2(const ossim_uint8* s, ossim_uint8* d, ossim_uint32 count,
+                               ossim_uint8 nullPix, const ossim_uint8* valid)
+   {
+      const __m128i NP   = _mm_set1_epi8((char)nullPix);
+      const __m128i LOW7 = _mm_set1_epi8(0x7f);
+      const __m128i ZERO = _mm_setzero_si128();
+      ossim_uint32 i = 0;
+      for (; i + 16 <= count; i += 16)
+      {
+         const __m128i D = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+         const __m128i S = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+         const __m128i AVG = _mm_add_epi8(
+            _mm_and_si128(D, S), _mm_and_si128(_mm_srli_epi16(_mm_xor_si128(D, S), 1), LOW7));
+         __m128i r = blendSelect(_mm_cmpeq_epi8(D, NP), S, AVG);
+         if (valid)
+         {
+            const __m128i SKIP = _mm_cmpeq_epi8(
+               _mm_loadu_si128(reinterpret_cast<const __m128i*>(valid + i)), ZERO);
+            r = blendSelect(SKIP, D, r);
+         }
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), r);
+      }
+      return i;
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   ossim_uint32 blendEqualSse2(const ossim_uint16* s, ossim_uint16* d, ossim_uint32 count,
+                               ossim_uint16 nullPix, const ossim_uint8* valid)
+   {
+      const __m128i NP   = _mm_set1_epi16((short)nullPix);
+      const __m128i ZERO = _mm_setzero_si128();
+      ossim_uint32 i = 0;
+      for (; i + 8 <= count; i += 8)
+      {
+         const __m128i D = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+         const __m128i S = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+         const __m128i AVG =
+            _mm_add_epi16(_mm_and_si128(D, S), _mm_srli_epi16(_mm_xor_si128(D, S), 1));
+         __m128i r = blendSelect(_mm_cmpeq_epi16(D, NP), S, AVG);
+         if (valid)
+         {
+            const __m128i V = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(valid + i));
+            r = blendSelect(_mm_cmpeq_epi16(_mm_unpacklo_epi8(V, V), ZERO), D, r);
+         }
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), r);
+      }
+      return i;
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   ossim_uint32 blendEqualAvx2(const ossim_uint8* s, ossim_uint8* d, ossim_uint32 count,
+                               ossim_uint8 nullPix, const ossim_uint8* valid)
+   {
+      const __m256i NP   = _mm256_set1_epi8((char)nullPix);
+      const __m256i LOW7 = _mm256_set1_epi8(0x7f);
+      const __m256i ZERO = _mm256_setzero_si256();
+      ossim_uint32 i = 0;
+      for (; i + 32 <= count; i += 32)
+      {
+         const __m256i D = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i));
+         const __m256i S = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+         const __m256i AVG = _mm256_add_epi8(
+            _mm256_and_si256(D, S),
+            _mm256_and_si256(_mm256_srli_epi16(_mm256_xor_si256(D, S), 1), LOW7));
+         __m256i r = _mm256_blendv_epi8(AVG, S, _mm256_cmpeq_epi8(D, NP));
+         if (valid)
+         {
+            const __m256i SKIP = _mm256_cmpeq_epi8(
+               _mm256_loadu_si256(reinterpret_cast<const __m256i*>(valid + i)), ZERO);
+            r = _mm256_blendv_epi8(r, D, SKIP);
+         }
+         _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), r);
+      }
+      return i;
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   ossim_uint32 blendEqualAvx2(const ossim_uint16* s, ossim_uint16* d, ossim_uint32 count,
+                               ossim_uint16 nullPix, const ossim_uint8* valid)
+   {
+      const __m256i NP   = _mm256_set1_epi16((short)nullPix);
+      const __m256i ZERO = _mm256_setzero_si256();
+      ossim_uint32 i = 0;
+      for (; i + 16 <= count; i += 16)
+      {
+         const __m256i D = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i));
+         const __m256i S = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+         const __m256i AVG =
+            _mm256_add_epi16(_mm256_and_si256(D, S), _mm256_srli_epi16(_mm256_xor_si256(D, S), 1));
+         __m256i r = _mm256_blendv_epi8(AVG, S, _mm256_cmpeq_epi16(D, NP));
+         if (valid)
+         {
+            const __m256i V = _mm256_cvtepu8_epi16(
+               _mm_loadu_si128(reinterpret_cast<const __m128i*>(valid + i)));
+            r = _mm256_blendv_epi8(r, D, _mm256_cmpeq_epi16(V, ZERO));
+         }
+         _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), r);
+      }
+      return i;
+   }
+
+   //---
+   // Lane operations for the min/max block reductions. Masks are all ones in the lanes taken.
+   // SSE2 has no unsigned 16 bit min/max nor unsigned compares, so those flip the sign bit and
+   // use the signed instructions.
+   //---
+   struct MinMaxSse2U8
+   {
+      typedef ossim_uint8 T;
+      typedef __m128i V;
+      enum { LANES = 16 };
+      OSSIM_SIMD_TARGET("sse2")
+      static V load(const T* s) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)); }
+      OSSIM_SIMD_TARGET("sse2")
+      static void store(T* d, V v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(d), v); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V set1(T v) { return _mm_set1_epi8((char)v); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V eq(V a, V b) { return _mm_cmpeq_epi8(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V gt(V a, V b)
+      {
+         const V SIGN = _mm_set1_epi8((char)0x80);
+         return _mm_cmpgt_epi8(_mm_xor_si128(a, SIGN), _mm_xor_si128(b, SIGN));
+      }
+      OSSIM_SIMD_TARGET("sse2")
+      static V ordered(V a) { return _mm_cmpeq_epi8(a, a); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V min(V a, V b) { return _mm_min_epu8(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V max(V a, V b) { return _mm_max_epu8(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V select(V m, V a, V b) { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V maskAnd(V a, V b) { return _mm_and_si128(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V maskAndNot(V a, V b) { return _mm_andnot_si128(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V maskOr(V a, V b) { return _mm_or_si128(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V zero() { return _mm_setzero_si128(); }
+      OSSIM_SIMD_TARGET("sse2")
+      static bool any(V m) { return _mm_movemask_epi8(m) != 0; }
+   };
+
+   struct MinMaxSse2S16
+   {
+      typedef ossim_sint16 T;
+      typedef __m128i V;
+      enum { LANES = 8 };
+      OSSIM_SIMD_TARGET("sse2")
+      static V load(const T* s) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)); }
+      OSSIM_SIMD_TARGET("sse2")
+      static void store(T* d, V v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(d), v); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V set1(T v) { return _mm_set1_epi16(v); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V eq(V a, V b) { return _mm_cmpeq_epi16(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V gt(V a, V b) { return _mm_cmpgt_epi16(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V ordered(V a) { return _mm_cmpeq_epi16(a, a); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V min(V a, V b) { return _mm_min_epi16(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V max(V a, V b) { return _mm_max_epi16(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V select(V m, V a, V b) { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V maskAnd(V a, V b) { return _mm_and_si128(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V maskAndNot(V a, V b) { return _mm_andnot_si128(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V maskOr(V a, V b) { return _mm_or_si128(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V zero() { return _mm_setzero_si128(); }
+      OSSIM_SIMD_TARGET("sse2")
+      static bool any(V m) { return _mm_movemask_epi8(m) != 0; }
+   };
+
+   struct MinMaxSse2U16 : public MinMaxSse2S16
+   {
+      typedef ossim_uint16 T;
+      OSSIM_SIMD_TARGET("sse2")
+      static V load(const T* s) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)); }
+      OSSIM_SIMD_TARGET("sse2")
+      static void store(T* d, V v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(d), v); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V set1(T v) { return _mm_set1_epi16((short)v); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V gt(V a, V b)
+      {
+         const V SIGN = _mm_set1_epi16((short)0x8000);
+         return _mm_cmpgt_epi16(_mm_xor_si128(a, SIGN), _mm_xor_si128(b, SIGN));
+      }
+      OSSIM_SIMD_TARGET("sse2")
+      static V min(V a, V b)
+      {
+         const V SIGN = _mm_set1_epi16((short)0x8000);
+         return _mm_xor_si128(
+            _mm_min_epi16(_mm_xor_si128(a, SIGN), _mm_xor_si128(b, SIGN)), SIGN);
+      }
+      OSSIM_SIMD_TARGET("sse2")
+      static V max(V a, V b)
+      {
+         const V SIGN = _mm_set1_epi16((short)0x8000);
+         return _mm_xor_si128(
+            _mm_max_epi16(_mm_xor_si128(a, SIGN), _mm_xor_si128(b, SIGN)), SIGN);
+      }
+   };
+
+   struct MinMaxSse2F32
+   {
+      typedef ossim_float32 T;
+      typedef __m128 V;
+      enum { LANES = 4 };
+      OSSIM_SIMD_TARGET("sse2")
+      static V load(const T* s) { return _mm_loadu_ps(s); }
+      OSSIM_SIMD_TARGET("sse2")
+      static void store(T* d, V v) { _mm_storeu_ps(d, v); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V set1(T v) { return _mm_set1_ps(v); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V eq(V a, V b) { return _mm_cmpeq_ps(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V gt(V a, V b) { return _mm_cmpgt_ps(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V ordered(V a) { return _mm_cmpord_ps(a, a); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V min(V a, V b) { return _mm_min_ps(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V max(V a, V b) { return _mm_max_ps(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V select(V m, V a, V b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V maskAnd(V a, V b) { return _mm_and_ps(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V maskAndNot(V a, V b) { return _mm_andnot_ps(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V maskOr(V a, V b) { return _mm_or_ps(a, b); }
+      OSSIM_SIMD_TARGET("sse2")
+      static V zero() { return _mm_setzero_ps(); }
+      OSSIM_SIMD_TARGET("sse2")
+      static bool any(V m) { return _mm_movemask_ps(m) != 0; }
+   };
+
+   struct MinMaxAvx2U8
+   {
+      typedef ossim_uint8 T;
+      typedef __m256i V;
+      enum { LANES = 32 };
+      OSSIM_SIMD_TARGET("avx2")
+      static V load(const T* s) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)); }
+      OSSIM_SIMD_TARGET("avx2")
+      static void store(T* d, V v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), v); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V set1(T v) { return _mm256_set1_epi8((char)v); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V eq(V a, V b) { return _mm256_cmpeq_epi8(a, b); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V gt(V a, V b)
+      {
+         const V SIGN = _mm256_set1_epi8((char)0x80);
+         return _mm256_cmpgt_epi8(_mm256_xor_si256(a, SIGN), _mm256_xor_si256(b, SIGN));
+      }
+      OSSIM_SIMD_TARGET("avx2")
+      static V ordered(V a) { return _mm256_cmpeq_epi8(a, a); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V min(V a, V b) { return _mm256_min_epu8(a, b); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V max(V a, V b) { return _mm256_max_epu8(a, b); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V select(V m, V a, V b) { return _mm256_blendv_epi8(b, a, m); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V maskAnd(V a, V b) { return _mm256_and_si256(a, b); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V maskAndNot(V a, V b) { return _mm256_andnot_si256(a, b); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V maskOr(V a, V b) { return _mm256_or_si256(a, b); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V zero() { return _mm256_setzero_si256(); }
+      OSSIM_SIMD_TARGET("avx2")
+      static bool any(V m) { return _mm256_movemask_epi8(m) != 0; }
+   };
+
+   struct MinMaxAvx2S16 : public MinMaxAvx2U8
+   {
+      typedef ossim_sint16 T;
+      enum { LANES = 16 };
+      OSSIM_SIMD_TARGET("avx2")
+      static V load(const T* s) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)); }
+      OSSIM_SIMD_TARGET("avx2")
+      static void store(T* d, V v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), v); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V set1(T v) { return _mm256_set1_epi16(v); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V eq(V a, V b) { return _mm256_cmpeq_epi16(a, b); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V gt(V a, V b) { return _mm256_cmpgt_epi16(a, b); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V min(V a, V b) { return _mm256_min_epi16(a, b); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V max(V a, V b) { return _mm256_max_epi16(a, b); }
+   };
+
+   struct MinMaxAvx2U16 : public MinMaxAvx2S16
+   {
+      typedef ossim_uint16 T;
+      OSSIM_SIMD_TARGET("avx2")
+      static V load(const T* s) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)); }
+      OSSIM_SIMD_TARGET("avx2")
+      static void store(T* d, V v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), v); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V set1(T v) { return _mm256_set1_epi16((short)v); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V gt(V a, V b)
+      {
+         const V SIGN = _mm256_set1_epi16((short)0x8000);
+         return _mm256_cmpgt_epi16(_mm256_xor_si256(a, SIGN), _mm256_xor_si256(b, SIGN));
+      }
+      OSSIM_SIMD_TARGET("avx2")
+      static V min(V a, V b) { return _mm256_min_epu16(a, b); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V max(V a, V b) { return _mm256_max_epu16(a, b); }
+   };
+
+   struct MinMaxAvx2F32
+   {
+      typedef ossim_float32 T;
+      typedef __m256 V;
+      enum { LANES = 8 };
+      OSSIM_SIMD_TARGET("avx2")
+      static V load(const T* s) { return _mm256_loadu_ps(s); }
+      OSSIM_SIMD_TARGET("avx2")
+      static void store(T* d, V v) { _mm256_storeu_ps(d, v); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V set1(T v) { return _mm256_set1_ps(v); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V eq(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V gt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V ordered(V a) { return _mm256_cmp_ps(a, a, _CMP_ORD_Q); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V min(V a, V b) { return _mm256_min_ps(a, b); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V max(V a, V b) { return _mm256_max_ps(a, b); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V select(V m, V a, V b) { return _mm256_blendv_ps(b, a, m); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V maskAnd(V a, V b) { return _mm256_and_ps(a, b); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V maskAndNot(V a, V b) { return _mm256_andnot_ps(a, b); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V maskOr(V a, V b) { return _mm256_or_ps(a, b); }
+      OSSIM_SIMD_TARGET("avx2")
+      static V zero() { return _mm256_setzero_ps(); }
+      OSSIM_SIMD_TARGET("avx2")
+      static bool any(V m) { return _mm256_movemask_ps(m) != 0; }
+   };
+
+   template <class T> struct MinMaxOps;
+   template <> struct MinMaxOps<ossim_uint8>
+   { typedef MinMaxSse2U8  Sse2; typedef MinMaxAvx2U8  Avx2; };
+   template <> struct MinMaxOps<ossim_uint16>
+   { typedef MinMaxSse2U16 Sse2; typedef MinMaxAvx2U16 Avx2; };
+   template <> struct MinMaxOps<ossim_sint16>
+   { typedef MinMaxSse2S16 Sse2; typedef MinMaxAvx2S16 Avx2; };
+   template <> struct MinMaxOps<ossim_float32>
+   { typedef MinMaxSse2F32 Sse2; typedef MinMaxAvx2F32 Avx2; };
+
+   //---
+   // Min and max of the samples of s[0, count) (count a multiple of the lanes) other than
+   // skipPix if skipFlag, above floorPix if floorFlag, and not NaN. Returns false, leaving lo
+   // and hi meaningless, if there is no such sample.
+   //---
+   template <class OPS>
+   OSSIM_SIMD_TARGET("sse2")
+   bool minMaxBlockSse2(const typename OPS::T* s, ossim_uint32 count,
+                        bool skipFlag, typename OPS::T skipPix,
+                        bool floorFlag, typename OPS::T floorPix,
+                        typename OPS::T& lo, typename OPS::T& hi)
+   {
+      typedef typename OPS::T T;
+      typedef typename OPS::V V;
+      const V SKIP    = OPS::set1(skipPix);
+      const V FLOOR   = OPS::set1(floorPix);
+      const V HIGHEST = OPS::set1(highestValue<T>());
+      const V LOWEST  = OPS::set1(lowestValue<T>());
+      V loAcc  = HIGHEST;
+      V hiAcc  = LOWEST;
+      V anyAcc = OPS::zero();
+      for (ossim_uint32 i = 0; i + OPS::LANES <= count; i += OPS::LANES)
+      {
+         const V P = OPS::load(s + i);
+         V m = OPS::ordered(P);
+         if (skipFlag)
+         {
+            m = OPS::maskAndNot(OPS::eq(P, SKIP), m);
+         }
+         if (floorFlag)
+         {
+            m = OPS::maskAnd(m, OPS::gt(P, FLOOR));
+         }
+         loAcc  = OPS::min(loAcc, OPS::select(m, P, HIGHEST));
+         hiAcc  = OPS::max(hiAcc, OPS::select(m, P, LOWEST));
+         anyAcc = OPS::maskOr(anyAcc, m);
+      }
+      T l[OPS::LANES];
+      T h[OPS::LANES];
+      OPS::store(l, loAcc);
+      OPS::store(h, hiAcc);
+      lo = l[0];
+      hi = h[0];
+      for (ossim_uint32 k = 1; k < OPS::LANES; ++k)
+      {
+         if (l[k] < lo) lo = l[k];
+         if (h[k] > hi) hi = h[k];
+      }
+      return OPS::any(anyAcc);
+   }
+
+   template <class OPS>
+   OSSIM_SIMD_TARGET("avx2")
+   bool minMaxBlockAvx2(const typename OPS::T* s, ossim_uint32 count,
+                        bool skipFlag, typename OPS::T skipPix,
+                        bool floorFlag, typename OPS::T floorPix,
+                        typename OPS::T& lo, typename OPS::T& hi)
+   {
+      typedef typename OPS::T T;
+      typedef typename OPS::V V;
+      const V SKIP    = OPS::set1(skipPix);
+      const V FLOOR   = OPS::set1(floorPix);
+      const V HIGHEST = OPS::set1(highestValue<T>());
+      const V LOWEST  = OPS::set1(lowestValue<T>());
+      V loAcc  = HIGHEST;
+      V hiAcc  = LOWEST;
+      V anyAcc = OPS::zero();
+      for (ossim_uint32 i = 0; i + OPS::LANES <= count; i += OPS::LANES)
+      {
+         const V P = OPS::load(s + i);
+         V m = OPS::ordered(P);
+         if (skipFlag)
+         {
+            m = OPS::maskAndNot(OPS::eq(P, SKIP), m);
+         }
+         if (floorFlag)
+         {
+            m = OPS::maskAnd(m, OPS::gt(P, FLOOR));
+         }
+         loAcc  = OPS::min(loAcc, OPS::select(m, P, HIGHEST));
+         hiAcc  = OPS::max(hiAcc, OPS::select(m, P, LOWEST));
+         anyAcc = OPS::maskOr(anyAcc, m);
+      }
+      T l[OPS::LANES];
+      T h[OPS::LANES];
+      OPS::store(l, loAcc);
+      OPS::store(h, hiAcc);
+      lo = l[0];
+      hi = h[0];
+      for (ossim_uint32 k = 1; k < OPS::LANES; ++k)
+      {
+         if (l[k] < lo) lo = l[k];
+         if (h[k] > hi) hi = h[k];
+      }
+      return OPS::any(anyAcc);
+   }
+
+   template <class T>
+   inline bool minMaxBlock(ossim::SimdLevel level, const T* s, ossim_uint32 count,
+                           bool skipFlag, T skipPix, bool floorFlag, T floorPix, T& lo, T& hi)
+   {
+      return (level >= ossim::SIMD_AVX2) ?
+         minMaxBlockAvx2<typename MinMaxOps<T>::Avx2>(s, count, skipFlag, skipPix,
+                                                      floorFlag, floorPix, lo, hi) :
+         minMaxBlockSse2<typename MinMaxOps<T>::Sse2>(s, count, skipFlag, skipPix,
+                                                      floorFlag, floorPix, lo, hi);
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   ossim_uint32 binIndexSse2(const ossim_float32* s, ossim_uint32 count, ossim_float32 vmin,
+                             ossim_float32 vmax, ossim_float32 delta, ossim_int32 bins,
+                             ossim_int32* index)
+   {
+      const __m128  VMIN  = _mm_set1_ps(vmin);
+      const __m128  VMAX  = _mm_set1_ps(vmax);
+      const __m128  DELTA = _mm_set1_ps(delta);
+      const __m128i BINS  = _mm_set1_epi32(bins);
+      const __m128i NONE  = _mm_set1_epi32(-1);
+      ossim_uint32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         const __m128 P = _mm_loadu_ps(s + i);
+         const __m128i IN_RANGE =
+            _mm_castps_si128(_mm_and_ps(_mm_cmpge_ps(P, VMIN), _mm_cmple_ps(P, VMAX)));
+         const __m128i IDX = _mm_cvttps_epi32(_mm_div_ps(_mm_sub_ps(P, VMIN), DELTA));
+         const __m128i OK  = _mm_and_si128(IN_RANGE, _mm_cmpgt_epi32(BINS, IDX));
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(index + i),
+                          _mm_or_si128(_mm_and_si128(OK, IDX), _mm_andnot_si128(OK, NONE)));
+      }
+      return i;
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   ossim_uint32 binIndexAvx2(const ossim_float32* s, ossim_uint32 count, ossim_float32 vmin,
+                             ossim_float32 vmax, ossim_float32 delta, ossim_int32 bins,
+                             ossim_int32* index)
+   {
+      const __m256  VMIN  = _mm256_set1_ps(vmin);
+      const __m256  VMAX  = _mm256_set1_ps(vmax);
+      const __m256  DELTA = _mm256_set1_ps(delta);
+      const __m256i BINS  = _mm256_set1_epi32(bins);
+      const __m256i NONE  = _mm256_set1_epi32(-1);
+      ossim_uint32 i = 0;
+      for (; i + 8 <= count; i += 8)
+      {
+         const __m256 P = _mm256_loadu_ps(s + i);
+         const __m256i IN_RANGE = _mm256_castps_si256(
+            _mm256_and_ps(_mm256_cmp_ps(P, VMIN, _CMP_GE_OQ), _mm256_cmp_ps(P, VMAX, _CMP_LE_OQ)));
+         const __m256i IDX = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_sub_ps(P, VMIN), DELTA));
+         const __m256i OK  = _mm256_and_si256(IN_RANGE, _mm256_cmpgt_epi32(BINS, IDX));
+         _mm256_storeu_si256(reinterpret_cast<__m256i*>(index + i),
+                             _mm256_blendv_epi8(NONE, IDX, OK));
+      }
+      return i;
+   }
+
+   //---
+   // Difference statistics. p = b - a and n = a - b saturated at zero give |b - a| as p | n.
+   // Over a block, max(b - a) is max(p) if any p is positive, else -min(n); min(b - a) is
+   // -max(n) if any n is positive, else min(p). Counts and squares are summed exactly.
+   //---
+   struct DiffRange
+   {
+      ossim_uint32 m_maxP;
+      ossim_uint32 m_minP;
+      ossim_uint32 m_maxN;
+      ossim_uint32 m_minN;
+   };
+
+   inline void addDiffRange(const DiffRange& r, ossim_float64& minDiff, ossim_float64& maxDiff)
+   {
+      const ossim_float64 HI = r.m_maxP ? ossim_float64(r.m_maxP) : -ossim_float64(r.m_minN);
+      const ossim_float64 LO = r.m_maxN ? -ossim_float64(r.m_maxN) : ossim_float64(r.m_minP);
+      if (LO < minDiff)
+      {
+         minDiff = LO;
+      }
+      if (HI > maxDiff)
+      {
+         maxDiff = HI;
+      }
+   }
+
+   template <class T, ossim_uint32 N>
+   inline void reduceDiffRange(const T (&maxP)[N], const T (&minP)[N],
+                               const T (&maxN)[N], const T (&minN)[N], T bias, DiffRange& r)
+   {
+      r.m_maxP = r.m_maxN = 0;
+      r.m_minP = r.m_minN = std::numeric_limits<T>::max();
+      for (ossim_uint32 i = 0; i < N; ++i)
+      {
+         r.m_maxP = std::max<ossim_uint32>(r.m_maxP, static_cast<T>(maxP[i] ^ bias));
+         r.m_minP = std::min<ossim_uint32>(r.m_minP, static_cast<T>(minP[i] ^ bias));
+         r.m_maxN = std::max<ossim_uint32>(r.m_maxN, static_cast<T>(maxN[i] ^ bias));
+         r.m_minN = std::min<ossim_uint32>(r.m_minN, static_cast<T>(minN[i] ^ bias));
+      }
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline ossim_uint64 sum64(__m128i v)
+   {
+      ossim_uint64 t[2];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(t), v);
+      return t[0] + t[1];
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   inline __m128i widenAdd32(__m128i total, __m128i v)
+   {
+      const __m128i ZERO = _mm_setzero_si128();
+      return _mm_add_epi64(total, _mm_add_epi64(_mm_unpacklo_epi32(v, ZERO),
+                                                _mm_unpackhi_epi32(v, ZERO)));
+   }
+
+   OSSIM_SIMD_TARGET("sse2")
+   ossim_uint32 diffStatsSse2(const ossim_uint8* a, const ossim_uint8* b, ossim_uint32 count,
+                              ossim_uint16 /* bias */, ossim_uint64& equal,
+                              ossim_uint64& squares, DiffRange& range)
+   {
+      const __m128i ZERO = _mm_setzero_si128();
+      __m128i maxP = ZERO;
+      __m128i maxN = ZERO;
+      __m128i minP = _mm_set1_epi8(-1);
+      __m128i minN = minP;
+      __m128i eq = ZERO;
+      __m128i sq = ZERO;
+      ossim_uint32 i = 0;
+      while (i + 16 <= count)
+      {
+         // Byte counters hold at most 255; 32 bit square sums at most 255 * 4 * 255^2.
+         __m128i acc = ZERO;
+         __m128i sq32 = ZERO;
+         for (ossim_uint32 n = 0; (n < 255) && (i + 16 <= count); ++n, i += 16)
+         {
+            const __m128i A = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            const __m128i B = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            const __m128i P = _mm_subs_epu8(B, A);
+            const __m128i N = _mm_subs_epu8(A, B);
+            maxP = _mm_max_epu8(maxP, P);
+            minP = _mm_min_epu8(minP, P);
+            maxN = _mm_max_epu8(maxN, N);
+            minN = _mm_min_epu8(minN, N);
+            const __m128i D = _mm_or_si128(P, N);
+            acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(D, ZERO));
+            const __m128i LO = _mm_unpacklo_epi8(D, ZERO);
+            const __m128i HI = _mm_unpackhi_epi8(D, ZERO);
+            sq32 = _mm_add_epi32(sq32, _mm_add_epi32(_mm_madd_epi16(LO, LO),
+                                                     _mm_madd_epi16(HI, HI)));
+         }
+         eq = _mm_add_epi64(eq, _mm_sad_epu8(acc, ZERO));
+         sq = widenAdd32(sq, sq32);
+      }
+      if (i)
+      {
+         ossim_uint8 v[4][16];
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(v[0]), maxP);
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(v[1]), minP);
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(v[2]), maxN);
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(v[3]), minN);
+         reduceDiffRange<ossim_uint8, 16>(v[0], v[1], v[2], v[3], 0, range);
+         equal   = sum64(eq);
+         squares = sum64(sq);
+      }
+      return i;
+   }
+
+   //---
+   // 16 bit samples; bias 0x8000 maps signed samples to unsigned ones in the same order, and the
+   // unsigned range is tracked on biased values as SSE2 only has signed 16 bit min/max.
+   //---
+   OSSIM_SIMD_TARGET("sse2")
+   ossim_uint32 diffStatsSse2(const ossim_uint16* a, const ossim_uint16* b, ossim_uint32 count,
+                              ossim_uint16 bias, ossim_uint64& equal, ossim_uint64& squares,
+                              DiffRange& range)
+   {
+      const __m128i ZERO = _mm_setzero_si128();
+      const __m128i ONES = _mm_set1_epi16(1);
+      const __m128i BIAS = _mm_set1_epi16((short)bias);
+      const __m128i FLIP = _mm_set1_epi16((short)0x8000);
+      __m128i maxP = FLIP; // biased 0
+      __m128i maxN = FLIP;
+      __m128i minP = _mm_set1_epi16(0x7fff); // biased 0xffff
+      __m128i minN = minP;
+      __m128i eq = ZERO;
+      __m128i sq = ZERO;
+      ossim_uint32 i = 0;
+      while (i + 8 <= count)
+      {
+         __m128i acc = ZERO;
+         for (ossim_uint32 n = 0; (n < 255) && (i + 8 <= count); ++n, i += 8)
+         {
+            const __m128i A = _mm_xor_si128(
+               _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), BIAS);
+            const __m128i B = _mm_xor_si128(
+               _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)), BIAS);
+            const __m128i P = _mm_subs_epu16(B, A);
+            const __m128i N = _mm_subs_epu16(A, B);
+            const __m128i PF = _mm_xor_si128(P, FLIP);
+            const __m128i NF = _mm_xor_si128(N, FLIP);
+            maxP = _mm_max_epi16(maxP, PF);
+            minP = _mm_min_epi16(minP, PF);
+            maxN = _mm_max_epi16(maxN, NF);
+            minN = _mm_min_epi16(minN, NF);
+            const __m128i D = _mm_or_si128(P, N);
+            acc = _mm_sub_epi16(acc, _mm_cmpeq_epi16(D, ZERO));
+            const __m128i LO = _mm_mullo_epi16(D, D);
+            const __m128i HI = _mm_mulhi_epu16(D, D);
+            sq = widenAdd32(sq, _mm_unpacklo_epi16(LO, HI));
+            sq = widenAdd32(sq, _mm_unpackhi_epi16(LO, HI));
+         }
+         eq = widenAdd32(eq, _mm_madd_epi16(acc, ONES));
+      }
+      if (i)
+      {
+         ossim_uint16 v[4][8];
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(v[0]), maxP);
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(v[1]), minP);
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(v[2]), maxN);
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(v[3]), minN);
+         reduceDiffRange<ossim_uint16, 8>(v[0], v[1], v[2], v[3], 0x8000, range);
+         equal   = sum64(eq);
+         squares = sum64(sq);
+      }
+      return i;
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline ossim_uint64 sum64(__m256i v)
+   {
+      ossim_uint64 t[4];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(t), v);
+      return t[0] + t[1] + t[2] + t[3];
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   inline __m256i widenAdd32(__m256i total, __m256i v)
+   {
+      // Unpacks within 128 bit lanes; the order does not matter for sums.
+      const __m256i ZERO = _mm256_setzero_si256();
+      return _mm256_add_epi64(total, _mm256_add_epi64(_mm256_unpacklo_epi32(v, ZERO),
+                                                      _mm256_unpackhi_epi32(v, ZERO)));
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   ossim_uint32 diffStatsAvx2(const ossim_uint8* a, const ossim_uint8* b, ossim_uint32 count,
+                              ossim_uint16 /* bias */, ossim_uint64& equal,
+                              ossim_uint64& squares, DiffRange& range)
+   {
+      const __m256i ZERO = _mm256_setzero_si256();
+      __m256i maxP = ZERO;
+      __m256i maxN = ZERO;
+      __m256i minP = _mm256_set1_epi8(-1);
+      __m256i minN = minP;
+      __m256i eq = ZERO;
+      __m256i sq = ZERO;
+      ossim_uint32 i = 0;
+      while (i + 32 <= count)
+      {
+         __m256i acc = ZERO;
+         __m256i sq32 = ZERO;
+         for (ossim_uint32 n = 0; (n < 255) && (i + 32 <= count); ++n, i += 32)
+         {
+            const __m256i A = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            const __m256i B = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            const __m256i P = _mm256_subs_epu8(B, A);
+            const __m256i N = _mm256_subs_epu8(A, B);
+            maxP = _mm256_max_epu8(maxP, P);
+            minP = _mm256_min_epu8(minP, P);
+            maxN = _mm256_max_epu8(maxN, N);
+            minN = _mm256_min_epu8(minN, N);
+            const __m256i D = _mm256_or_si256(P, N);
+            acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(D, ZERO));
+            const __m256i LO = _mm256_unpacklo_epi8(D, ZERO);
+            const __m256i HI = _mm256_unpackhi_epi8(D, ZERO);
+            sq32 = _mm256_add_epi32(sq32, _mm256_add_epi32(_mm256_madd_epi16(LO, LO),
+                                                           _mm256_madd_epi16(HI, HI)));
+         }
+         eq = _mm256_add_epi64(eq, _mm256_sad_epu8(acc, ZERO));
+         sq = widenAdd32(sq, sq32);
+      }
+      if (i)
+      {
+         ossim_uint8 v[4][32];
+         _mm256_storeu_si256(reinterpret_cast<__m256i*>(v[0]), maxP);
+         _mm256_storeu_si256(reinterpret_cast<__m256i*>(v[1]), minP);
+         _mm256_storeu_si256(reinterpret_cast<__m256i*>(v[2]), maxN);
+         _mm256_storeu_si256(reinterpret_cast<__m256i*>(v[3]), minN);
+         reduceDiffRange<ossim_uint8, 32>(v[0], v[1], v[2], v[3], 0, range);
+         equal   = sum64(eq);
+         squares = sum64(sq);
+      }
+      return i;
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   ossim_uint32 diffStatsAvx2(const ossim_uint16* a, const ossim_uint16* b, ossim_uint32 count,
+                              ossim_uint16 bias, ossim_uint64& equal, ossim_uint64& squares,
+                              DiffRange& range)
+   {
+      const __m256i ZERO = _mm256_setzero_si256();
+      const __m256i ONES = _mm256_set1_epi16(1);
+      const __m256i BIAS = _mm256_set1_epi16((short)bias);
+      __m256i maxP = ZERO;
+      __m256i maxN = ZERO;
+      __m256i minP = _mm256_set1_epi16(-1);
+      __m256i minN = minP;
+      __m256i eq = ZERO;
+      __m256i sq = ZERO;
+      ossim_uint32 i = 0;
+      while (i + 16 <= count)
+      {
+         __m256i acc = ZERO;
+         for (ossim_uint32 n = 0; (n < 255) && (i + 16 <= count); ++n, i += 16)
+         {
+            const __m256i A = _mm256_xor_si256(
+               _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)), BIAS);
+            const __m256i B = _mm256_xor_si256(
+               _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)), BIAS);
+            const __m256i P = _mm256_subs_epu16(B, A);
+            const __m256i N = _mm256_subs_epu16(A, B);
+            maxP = _mm256_max_epu16(maxP, P);
+            minP = _mm256_min_epu16(minP, P);
+            maxN = _mm256_max_epu16(maxN, N);
+            minN = _mm256_min_epu16(minN, N);
+            const __m256i D = _mm256_or_si256(P, N);
+            acc = _mm256_sub_epi16(acc, _mm256_cmpeq_epi16(D, ZERO));
+            const __m256i LO = _mm256_mullo_epi16(D, D);
+            const __m256i HI = _mm256_mulhi_epu16(D, D);
+            sq = widenAdd32(sq, _mm256_unpacklo_epi16(LO, HI));
+            sq = widenAdd32(sq, _mm256_unpackhi_epi16(LO, HI));
+         }
+         eq = widenAdd32(eq, _mm256_madd_epi16(acc, ONES));
+      }
+      if (i)
+      {
+         ossim_uint16 v[4][16];
+         _mm256_storeu_si256(reinterpret_cast<__m256i*>(v[0]), maxP);
+         _mm256_storeu_si256(reinterpret_cast<__m256i*>(v[1]), minP);
+         _mm256_storeu_si256(reinterpret_cast<__m256i*>(v[2]), maxN);
+         _mm256_storeu_si256(reinterpret_cast<__m256i*>(v[3]), minN);
+         reduceDiffRange<ossim_uint16, 16>(v[0], v[1], v[2], v[3], 0, range);
+         equal   = sum64(eq);
+         squares = sum64(sq);
+      }
+      return i;
+   }
+
+#endif /* #if OSSIM_SIMD_X86 */
+
+   template <class T>
+   inline void blendEqualDispatch(const T* s, T* d, ossim_uint32 count, T nullPix,
+                                  const ossim_uint8* valid)
+   {
+      ossim_uint32 done = 0;
+#if OSSIM_SIMD_X86
+      const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+      if (LEVEL >= ossim::SIMD_AVX2)
+      {
+         done = blendEqualAvx2(s, d, count, nullPix, valid);
+      }
+      else if (LEVEL >= ossim::SIMD_SSE2)
+      {
+         done = blendEqualSse2(s, d, count, nullPix, valid);
+      }
+#endif
+      ossim::blendEqual<T>(s + done, d + done, count - done, nullPix, valid ? valid + done : 0);
+   }
+
+   template <class S, class D>
+   inline void normalizeDispatch(const S* s, D* d, ossim_uint32 count, ossim_float64 minPix,
+                                 ossim_float64 maxPix, ossim_float64 nullPix)
+   {
+#if OSSIM_SIMD_X86
+      const ossim_float64 MIN_NORM = (sizeof(D) == sizeof(ossim_float32)) ?
+         (ossim_float64)OSSIM_DEFAULT_MIN_PIX_NORM_FLOAT : OSSIM_DEFAULT_MIN_PIX_NORM_DOUBLE;
+      const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+      if (LEVEL >= ossim::SIMD_AVX2)
+      {
+         normalizeAvx2(s, d, count, minPix, maxPix, nullPix, MIN_NORM);
+         return;
+      }
+      if (LEVEL >= ossim::SIMD_SSE2)
+      {
+         normalizeSse2(s, d, count, minPix, maxPix, nullPix, MIN_NORM);
+         return;
+      }
+#endif
+      ossim::normalize<S, D>(s, d, count, minPix, maxPix, nullPix);
+   }
+
+   template <class S, class D>
+   inline void unnormalizeDispatch(const S* s, D* d, ossim_uint32 count, ossim_float64 minPix,
+                                   ossim_float64 maxPix, ossim_float64 nullPix, bool clampFlag)
+   {
+#if OSSIM_SIMD_X86
+      const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+      if (LEVEL >= ossim::SIMD_AVX2)
+      {
+         unnormalizeAvx2(s, d, count, minPix, maxPix, nullPix, clampFlag);
+         return;
+      }
+      if (LEVEL >= ossim::SIMD_SSE2)
+      {
+         unnormalizeSse2(s, d, count, minPix, maxPix, nullPix, clampFlag);
+         return;
+      }
+#endif
+      ossim::unnormalize<S, D>(s, d, count, minPix, maxPix, nullPix, clampFlag);
+   }
+
+   template <class T>
+   inline ossim_uint32 countNullDispatch(const T* s, ossim_uint32 count, T nullPix)
+   {
+      ossim_uint32 result = 0;
+      ossim_uint32 done   = 0;
+#if OSSIM_SIMD_X86
+      const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+      if (LEVEL >= ossim::SIMD_AVX2)
+      {
+         result = countNullAvx2(s, count, nullPix, done);
+      }
+      else if (LEVEL >= ossim::SIMD_SSE2)
+      {
+         result = countNullSse2(s, count, nullPix, done);
+      }
+#endif
+      return result + ossim::countNull<T>(s + done, count - done, nullPix);
+   }
+
+   template <class S, class D>
+   inline void remapDispatch(const S* s, D* d, ossim_uint32 count,
+                             ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,
+                             ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull)
+   {
+#if OSSIM_SIMD_X86
+      const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+      if (LEVEL >= ossim::SIMD_AVX2)
+      {
+         remapAvx2(s, d, count, inMin, inMax, inNull, outMin, outMax, outNull);
+         return;
+      }
+      if (LEVEL >= ossim::SIMD_SSE2)
+      {
+         remapSse2(s, d, count, inMin, inMax, inNull, outMin, outMax, outNull);
+         return;
+      }
+#endif
+      ossim::remap<S, D>(s, d, count, inMin, inMax, inNull, outMin, outMax, outNull);
+   }
+
+   template <class S, class D>
+   inline void castClampDispatch(const S* s, D* d, ossim_uint32 count, ossim_float64 outMin,
+                                 ossim_float64 outMax, bool nullFlag, ossim_float64 inNull,
+                                 ossim_float64 outNull)
+   {
+#if OSSIM_SIMD_X86
+      const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+      if (LEVEL >= ossim::SIMD_AVX2)
+      {
+         castClampAvx2(s, d, count, outMin, outMax, nullFlag, inNull, outNull);
+         return;
+      }
+      if (LEVEL >= ossim::SIMD_SSE2)
+      {
+         castClampSse2(s, d, count, outMin, outMax, nullFlag, inNull, outNull);
+         return;
+      }
+#endif
+      ossim::castClamp<S, D>(s, d, count, outMin, outMax, nullFlag, inNull, outNull);
+   }
+
+   template <class T>
+   inline void minMaxScalar(const T* s, ossim_uint32 count, T skipPix, ossim_float64& minPix,
+                            ossim_float64& maxPix, ossim_float64* nulPix)
+   {
+      if (nulPix)
+      {
+         ossim::minMaxNul<T>(s, count, skipPix, minPix, maxPix, *nulPix);
+      }
+      else
+      {
+         ossim::minMax<T>(s, count, skipPix, minPix, maxPix);
+      }
+   }
+
+   //---
+   // minMax, or minMaxNul if nulPix. Blocks are reduced out of order only where the header
+   // shows that gives the result of the in order loop; the rest goes to the scalar loop.
+   //---
+   template <class T>
+   void minMaxDispatch(const T* s, ossim_uint32 count, T skipPix, ossim_float64& minPix,
+                       ossim_float64& maxPix, ossim_float64* nulPix)
+   {
+      ossim_uint32 i = 0;
+#if OSSIM_SIMD_X86
+      const ossim_uint32 BLOCK = 512;
+      const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+      if (LEVEL >= ossim::SIMD_SSE2)
+      {
+         for (; count - i >= BLOCK; i += BLOCK)
+         {
+            const T* p = s + i;
+            if ( (maxPix >= minPix) && ( !nulPix || (minPix >= *nulPix) ) )
+            {
+               T lo;
+               T hi;
+               if ( !minMaxBlock(LEVEL, p, BLOCK, true, skipPix, false, skipPix, lo, hi) )
+               {
+                  continue; // Nothing but skipped samples.
+               }
+               if ( !nulPix || (lo > *nulPix) )
+               {
+                  if (lo < minPix) minPix = lo;
+                  if (hi > maxPix) maxPix = hi;
+                  continue;
+               }
+               if (lo == *nulPix)
+               {
+                  // Samples at the null are not min candidates.
+                  T above;
+                  T unused;
+                  if ( minMaxBlock(LEVEL, p, BLOCK, true, skipPix, true, lo, above, unused) &&
+                       (above < minPix) )
+                  {
+                     minPix = above;
+                  }
+                  if (hi > maxPix) maxPix = hi;
+                  continue;
+               }
+            }
+
+            // Range not yet ordered, or the null drops in this block:
+            minMaxScalar(p, BLOCK, skipPix, minPix, maxPix, nulPix);
+         }
+      }
+#endif
+      minMaxScalar(s + i, count - i, skipPix, minPix, maxPix, nulPix);
+   }
+
+   template <class T>
+   void countUnitBinsDispatch(const T* s, ossim_uint32 count, ossim_int64 first,
+                              ossim_uint32 binCount, ossim_uint64* bins)
+   {
+      const ossim_uint32 BANK_LIMIT = 4096;
+      const ossim_uint32 BLOCK      = 256;
+      if ( (binCount == 0) || (binCount > BANK_LIMIT) )
+      {
+         ossim::countUnitBins<T>(s, count, first, binCount, bins);
+         return;
+      }
+
+      const ossim_int64 LAST = first + binCount - 1;
+      std::vector<ossim_uint32> banks(4*binCount, 0);
+      ossim_uint32* b0 = &banks[0];
+      ossim_uint32* b1 = b0 + binCount;
+      ossim_uint32* b2 = b1 + binCount;
+      ossim_uint32* b3 = b2 + binCount;
+
+      // E.g. 8 bit data in 256 bins: every value is counted.
+      const bool ALL_IN_RANGE = (first <= (ossim_int64)lowestValue<T>()) &&
+                                (LAST  >= (ossim_int64)highestValue<T>());
+#if OSSIM_SIMD_X86
+      const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+#endif
+      ossim_uint32 i = 0;
+      while (i < count)
+      {
+         const ossim_uint32 N = ( (count - i) < BLOCK ) ? (count - i) : BLOCK;
+         const T* p = s + i;
+         bool inRange = ALL_IN_RANGE;
+#if OSSIM_SIMD_X86
+         if ( !inRange && (N == BLOCK) && (LEVEL >= ossim::SIMD_SSE2) )
+         {
+            T lo;
+            T hi;
+            minMaxBlock(LEVEL, p, BLOCK, false, T(0), false, T(0), lo, hi);
+            inRange = (lo >= first) && (hi <= LAST);
+         }
+#endif
+         if (inRange)
+         {
+            ossim_uint32 j = 0;
+            for (; j + 4 <= N; j += 4)
+            {
+               ++b0[p[j]   - first];
+               ++b1[p[j+1] - first];
+               ++b2[p[j+2] - first];
+               ++b3[p[j+3] - first];
+            }
+            for (; j < N; ++j)
+            {
+               ++b0[p[j] - first];
+            }
+         }
+         else
+         {
+            for (ossim_uint32 j = 0; j < N; ++j)
+            {
+               if ( (p[j] >= first) && (p[j] <= LAST) )
+               {
+                  ++b0[p[j] - first];
+               }
+            }
+         }
+         i += N;
+      }
+
+      for (ossim_uint32 bin = 0; bin < binCount; ++bin)
+      {
+         bins[bin] += (ossim_uint64)b0[bin] + b1[bin] + b2[bin] + b3[bin];
+      }
+   }
+
+   //---
+   // S is the sample type and U its unsigned type of the same size; signed samples are biased
+   // to unsigned ones for the vector code.
+   //---
+   template <class S, class U>
+   inline void diffStatsDispatch(const S* a, const S* b, ossim_uint32 count,
+                                 ossim_uint64& differ, ossim_float64& minDiff,
+                                 ossim_float64& maxDiff, ossim_float64& sumSquares)
+   {
+      ossim_uint32 done = 0;
+#if OSSIM_SIMD_X86
+      const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+      const ossim_uint16 BIAS = std::numeric_limits<S>::is_signed ? 0x8000 : 0;
+      const U* ua = reinterpret_cast<const U*>(a);
+      const U* ub = reinterpret_cast<const U*>(b);
+      ossim_uint64 equal   = 0;
+      ossim_uint64 squares = 0;
+      DiffRange    range;
+      if (LEVEL >= ossim::SIMD_AVX2)
+      {
+         done = diffStatsAvx2(ua, ub, count, BIAS, equal, squares, range);
+      }
+      else if (LEVEL >= ossim::SIMD_SSE2)
+      {
+         done = diffStatsSse2(ua, ub, count, BIAS, equal, squares, range);
+      }
+      if (done)
+      {
+         differ     += done - equal;
+         sumSquares += static_cast<ossim_float64>(squares);
+         addDiffRange(range, minDiff, maxDiff);
+      }
+#endif
+      ossim::diffStats<S>(a + done, b + done, count - done, differ, minDiff, maxDiff, sumSquares);
+   }
+
+} // End: anonymous namespace
+
+#define OSSIM_NORMALIZE_IMPL(S, D)                                                     \
+void ossim::normalize(const S* s, D* d, ossim_uint32 count, ossim_float64 minPix,      \
+                      ossim_float64 maxPix, ossim_float64 nullPix)                     \
+{                                                                                      \
+   normalizeDispatch(s, d, count, minPix, maxPix, nullPix);                            \
+}
+
+#define OSSIM_UNNORMALIZE_IMPL(S, D)                                                   \
+void ossim::unnormalize(const S* s, D* d, ossim_uint32 count, ossim_float64 minPix,    \
+                        ossim_float64 maxPix, ossim_float64 nullPix, bool clampFlag)   \
+{                                                                                      \
+   unnormalizeDispatch(s, d, count, minPix, maxPix, nullPix, clampFlag);               \
+}
+
+OSSIM_NORMALIZE_IMPL(ossim_uint8,   ossim_float32)
+OSSIM_NORMALIZE_IMPL(ossim_uint16,  ossim_float32)
+OSSIM_NORMALIZE_IMPL(ossim_sint16,  ossim_float32)
+OSSIM_NORMALIZE_IMPL(ossim_float32, ossim_float32)
+OSSIM_NORMALIZE_IMPL(ossim_uint8,   ossim_float64)
+OSSIM_NORMALIZE_IMPL(ossim_uint16,  ossim_float64)
+OSSIM_NORMALIZE_IMPL(ossim_sint16,  ossim_float64)
+OSSIM_NORMALIZE_IMPL(ossim_float32, ossim_float64)
+
+OSSIM_UNNORMALIZE_IMPL(ossim_float32, ossim_uint8)
+OSSIM_UNNORMALIZE_IMPL(ossim_float32, ossim_uint16)
+OSSIM_UNNORMALIZE_IMPL(ossim_float32, ossim_sint16)
+OSSIM_UNNORMALIZE_IMPL(ossim_float32, ossim_float32)
+OSSIM_UNNORMALIZE_IMPL(ossim_float64, ossim_uint8)
+OSSIM_UNNORMALIZE_IMPL(ossim_float64, ossim_uint16)
+OSSIM_UNNORMALIZE_IMPL(ossim_float64, ossim_sint16)
+OSSIM_UNNORMALIZE_IMPL(ossim_float64, ossim_float32)
+
+#undef OSSIM_NORMALIZE_IMPL
+#undef OSSIM_UNNORMALIZE_IMPL
+
+#define OSSIM_REMAP_IMPL(S, D)                                                         \
+void ossim::remap(const S* s, D* d, ossim_uint32 count,                                \
+                  ossim_float64 inMin, ossim_float64 inMax, ossim_float64 inNull,      \
+                  ossim_float64 outMin, ossim_float64 outMax, ossim_float64 outNull)   \
+{                                                                                      \
+   remapDispatch(s, d, count, inMin, inMax, inNull, outMin, outMax, outNull);          \
+}
+
+#define OSSIM_CAST_CLAMP_IMPL(S, D)                                                    \
+void ossim::castClamp(const S* s, D* d, ossim_uint32 count, ossim_float64 outMin,      \
+                      ossim_float64 outMax, bool nullFlag, ossim_float64 inNull,       \
+                      ossim_float64 outNull)                                           \
+{                                                                                      \
+   castClampDispatch(s, d, count, outMin, outMax, nullFlag, inNull, outNull);          \
+}
+
+OSSIM_REMAP_IMPL(ossim_uint8,   ossim_uint8)
+OSSIM_REMAP_IMPL(ossim_uint8,   ossim_uint16)
+OSSIM_REMAP_IMPL(ossim_uint8,   ossim_sint16)
+OSSIM_REMAP_IMPL(ossim_uint8,   ossim_float32)
+OSSIM_REMAP_IMPL(ossim_uint16,  ossim_uint8)
+OSSIM_REMAP_IMPL(ossim_uint16,  ossim_uint16)
+OSSIM_REMAP_IMPL(ossim_uint16,  ossim_sint16)
+OSSIM_REMAP_IMPL(ossim_uint16,  ossim_float32)
+OSSIM_REMAP_IMPL(ossim_sint16,  ossim_uint8)
+OSSIM_REMAP_IMPL(ossim_sint16,  ossim_uint16)
+OSSIM_REMAP_IMPL(ossim_sint16,  ossim_sint16)
+OSSIM_REMAP_IMPL(ossim_sint16,  ossim_float32)
+OSSIM_REMAP_IMPL(ossim_float32, ossim_uint8)
+OSSIM_REMAP_IMPL(ossim_float32, ossim_uint16)
+OSSIM_REMAP_IMPL(ossim_float32, ossim_sint16)
+OSSIM_REMAP_IMPL(ossim_float32, ossim_float32)
+
+OSSIM_CAST_CLAMP_IMPL(ossim_uint8,   ossim_uint8)
+OSSIM_CAST_CLAMP_IMPL(ossim_uint8,   ossim_uint16)
+OSSIM_CAST_CLAMP_IMPL(ossim_uint8,   ossim_sint16)
+OSSIM_CAST_CLAMP_IMPL(ossim_uint8,   ossim_float32)
+OSSIM_CAST_CLAMP_IMPL(ossim_uint16,  ossim_uint8)
+OSSIM_CAST_CLAMP_IMPL(ossim_uint16,  ossim_uint16)
+OSSIM_CAST_CLAMP_IMPL(ossim_uint16,  ossim_sint16)
+OSSIM_CAST_CLAMP_IMPL(ossim_uint16,  ossim_float32)
+OSSIM_CAST_CLAMP_IMPL(ossim_sint16,  ossim_uint8)
+OSSIM_CAST_CLAMP_IMPL(ossim_sint16,  ossim_uint16)
+OSSIM_CAST_CLAMP_IMPL(ossim_sint16,  ossim_sint16)
+OSSIM_CAST_CLAMP_IMPL(ossim_sint16,  ossim_float32)
+OSSIM_CAST_CLAMP_IMPL(ossim_float32, ossim_uint8)
+OSSIM_CAST_CLAMP_IMPL(ossim_float32, ossim_uint16)
+OSSIM_CAST_CLAMP_IMPL(ossim_float32, ossim_sint16)
+OSSIM_CAST_CLAMP_IMPL(ossim_float32, ossim_float32)
+
+#undef OSSIM_REMAP_IMPL
+#undef OSSIM_CAST_CLAMP_IMPL
+
+ossim_uint32 ossim::countNull(const ossim_uint8* s, ossim_uint32 count, ossim_uint8 nullPix)
+{
+   return countNullDispatch(s, count, nullPix);
+}
+
+ossim_uint32 ossim::countNull(const ossim_uint16* s, ossim_uint32 count, ossim_uint16 nullPix)
+{
+   return countNullDispatch(s, count, nullPix);
+}
+
+ossim_uint32 ossim::countNull(const ossim_sint16* s, ossim_uint32 count, ossim_sint16 nullPix)
+{
+   // Equality is bitwise for 16 bit integers so the unsigned kernel serves both.
+   return countNullDispatch(reinterpret_cast<const ossim_uint16*>(s), count,
+                            static_cast<ossim_uint16>(nullPix));
+}
+
+ossim_uint32 ossim::countNull(const ossim_float32* s, ossim_uint32 count, ossim_float32 nullPix)
+{
+   return countNullDispatch(s, count, nullPix);
+}
+
+#define OSSIM_MIN_MAX_IMPL(T)                                                          \
+void ossim::minMax(const T* s, ossim_uint32 count, T nullPix, ossim_float64& minPix,    \
+                   ossim_float64& maxPix)                                               \
+{                                                                                      \
+   minMaxDispatch(s, count, nullPix, minPix, maxPix, 0);                                \
+}                                                                                      \
+void ossim::minMaxNul(const T* s, ossim_uint32 count, T skipPix, ossim_float64& minPix, \
+                      ossim_float64& maxPix, ossim_float64& nulPix)                     \
+{                                                                                      \
+   minMaxDispatch(s, count, skipPix, minPix, maxPix, &nulPix);                          \
+}
+
+OSSIM_MIN_MAX_IMPL(ossim_uint8)
+OSSIM_MIN_MAX_IMPL(ossim_uint16)
+OSSIM_MIN_MAX_IMPL(ossim_sint16)
+OSSIM_MIN_MAX_IMPL(ossim_float32)
+
+#undef OSSIM_MIN_MAX_IMPL
+
+void ossim::countUnitBins(const ossim_uint8* s, ossim_uint32 count, ossim_int64 first,
+                          ossim_uint32 binCount, ossim_uint64* bins)
+{
+   countUnitBinsDispatch(s, count, first, binCount, bins);
+}
+
+void ossim::countUnitBins(const ossim_uint16* s, ossim_uint32 count, ossim_int64 first,
+                          ossim_uint32 binCount, ossim_uint64* bins)
+{
+   countUnitBinsDispatch(s, count, first, binCount, bins);
+}
+
+void ossim::countUnitBins(const ossim_sint16* s, ossim_uint32 count, ossim_int64 first,
+                          ossim_uint32 binCount, ossim_uint64* bins)
+{
+   countUnitBinsDispatch(s, count, first, binCount, bins);
+}
+
+void ossim::binIndex(const ossim_float32* s, ossim_uint32 count, ossim_float32 vmin,
+                     ossim_float32 vmax, ossim_float32 delta, ossim_int32 bins,
+                     ossim_int32* index)
+{
+   ossim_uint32 i = 0;
+#if OSSIM_SIMD_X86 && defined(__SSE2_MATH__)
+   // Only where scalar float math is SSE too, so the quotients round alike (not x87).
+   const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+   if (bins > 0)
+   {
+      if (LEVEL >= ossim::SIMD_AVX2)
+      {
+         i = binIndexAvx2(s, count, vmin, vmax, delta, bins, index);
+      }
+      else if (LEVEL >= ossim::SIMD_SSE2)
+      {
+         i = binIndexSse2(s, count, vmin, vmax, delta, bins, index);
+      }
+   }
+#endif
+   for (; i < count; ++i)
+   {
+      const ossim_float32 p = s[i];
+      if ( (bins > 0) && (p >= vmin) && (p <= vmax) )
+      {
+         const ossim_int32 idx = (ossim_int32)((p - vmin) / delta);
+         index[i] = (idx < bins) ? idx : -1;
+      }
+      else
+      {
+         index[i] = -1;
+      }
+   }
+}
+
+void ossim::addWeighted(const ossim_float64* s, ossim_float64* d, ossim_uint32 count,
+                        ossim_float64 weight)
+{
+   ossim_uint32 i = 0;
+#if OSSIM_SIMD_X86
+   const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+   if (LEVEL >= ossim::SIMD_AVX2)
+   {
+      i = addWeightedAvx2(s, d, count, weight);
+   }
+   else if (LEVEL >= ossim::SIMD_SSE2)
+   {
+      i = addWeightedSse2(s, d, count, weight);
+   }
+#endif
+   for (; i < count; ++i)
+   {
+      d[i] += weight * s[i];
+   }
+}
+
+void ossim::blendEqual(const ossim_uint8* s, ossim_uint8* d, ossim_uint32 count,
+                       ossim_uint8 nullPix, const ossim_uint8* valid)
+{
+   blendEqualDispatch(s, d, count, nullPix, valid);
+}
+
+void ossim::blendEqual(const ossim_uint16* s, ossim_uint16* d, ossim_uint32 count,
+                       ossim_uint16 nullPix, const ossim_uint8* valid)
+{
+   blendEqualDispatch(s, d, count, nullPix, valid);
+}
+
+void ossim::bipToBands(const void* src, void* const* dest, ossim_uint32 elementSize,
+                       ossim_uint32 bands, ossim_uint32 count)
+{
+   if ( !src || !dest || !bands || !count || (bands > 256) )
+   {
+      return;
+   }
+   if (bands == 1)
+   {
+      memcpy(dest[0], src, count*elementSize);
+      return;
+   }
+
+   ossim_uint32 done = 0;
+#if OSSIM_SIMD_X86
+   if ( (bands <= 4) && (elementSize <= 4) && (elementSize != 3) &&
+        (ossim::getSimdLevel() >= ossim::SIMD_SSSE3) )
+   {
+      done = bipToBandsSsse3(src, dest, elementSize, bands, count);
+   }
+#endif
+   if (done < count)
+   {
+      bipToBandsScalar(src, dest, elementSize, bands, count, done);
+   }
+}
+
+void ossim::bandsToBip(const void* const* src, void* dest, ossim_uint32 elementSize,
+                       ossim_uint32 bands, ossim_uint32 count)
+{
+   if ( !src || !dest || !bands || !count || (bands > 256) )
+   {
+      return;
+   }
+   if (bands == 1)
+   {
+      memcpy(dest, src[0], count*elementSize);
+      return;
+   }
+
+   ossim_uint32 done = 0;
+#if OSSIM_SIMD_X86
+   if ( (bands <= 4) && (elementSize <= 4) && (elementSize != 3) &&
+        (ossim::getSimdLevel() >= ossim::SIMD_SSSE3) )
+   {
+      done = bandsToBipSsse3(src, dest, elementSize, bands, count);
+   }
+#endif
+   if (done < count)
+   {
+      bandsToBipScalar(src, dest, elementSize, bands, count, done);
+   }
+}
+
+void ossim::diffStats(const ossim_uint8* a, const ossim_uint8* b, ossim_uint32 count,
+                      ossim_uint64& differ, ossim_float64& minDiff, ossim_float64& maxDiff,
+                      ossim_float64& sumSquares)
+{
+   diffStatsDispatch<ossim_uint8, ossim_uint8>(a, b, count, differ, minDiff, maxDiff, sumSquares);
+}
+
+void ossim::diffStats(const ossim_uint16* a, const ossim_uint16* b, ossim_uint32 count,
+                      ossim_uint64& differ, ossim_float64& minDiff, ossim_float64& maxDiff,
+                      ossim_float64& sumSquares)
+{
+   diffStatsDispatch<ossim_uint16, ossim_uint16>(a, b, count, differ, minDiff, maxDiff,
+                                                 sumSquares);
+}
+
+void ossim::diffStats(const ossim_sint16* a, const ossim_sint16* b, ossim_uint32 count,
+                      ossim_uint64& differ, ossim_float64& minDiff, ossim_float64& maxDiff,
+                      ossim_float64& sumSquares)
+{
+   diffStatsDispatch<ossim_sint16, ossim_uint16>(a, b, count, differ, minDiff, maxDiff,
+                                                 sumSquares);
+}
@@ -22,6 +22,7 @@
 #include <ossim/base/ossimHistogram.h>
 #include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimErrorContext.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossimImageTypeLut.h>
 #include <ossim/base/ossimIoStream.h>
 #include <ossim/base/ossimUnitTypeLut.h>
@@ -92,8 +93,15 @@ ossimImageFileWriter::ossimImageFileWriter(const ossimFilename& file,
      theWriteWorldFileFlag(false),
      theAutoCreateDirectoryFlag(true),
      theLinearUnits(OSSIM_UNIT_UNKNOWN),
-     thePixelType(OSSIM_PIXEL_IS_POINT)
+     thePixelType(OSSIM_PIXEL_IS_POINT),
+     thePipelineTiles(0)
 {
+   const char* lookup = ossimPreferences::instance()->findPreference("writer.pipeline_tiles");
+   if (lookup)
+   {
+      thePipelineTiles = ossimString(lookup).toUInt32();
+   }
+
    if (traceDebug())
    {
       ossimNotify(ossimNotifyLevel_DEBUG)
@@ -1094,7 +1102,27 @@ bool ossimImageFileWriter::execute()
    bool result    = true;
    if (theWriteImageFlag)
    {
+      //---
+      // Pipelined: the sequencer computes the next tiles on a thread of its own while
+      // writeFile encodes and writes the previous ones.
+      //---
+      const ossim_uint32 savedPipelineTiles = theInputConnection->getPipelineTiles();
+      if (thePipelineTiles)
+      {
+         theInputConnection->setPipelineTiles(thePipelineTiles);
+      }
+
+      // Work of the progress events: tiles, pixels and bytes handed to the writer.
+      const ossimIpt TILE_SIZE = theInputConnection->getTileSize();
+      const ossim_uint64 TILE_PIXELS = (ossim_uint64)TILE_SIZE.x * TILE_SIZE.y;
+      setProgressWork("write",
+                      (ossim_uint64)theInputConnection->getNumberOfTiles(),
+                      TILE_PIXELS,
+                      TILE_PIXELS * theInputConnection->getNumberOfOutputBands() *
+                      ossim::scalarSizeInBytes(theInputConnection->getOutputScalarType()));
       wroteFile = writeFile();
+      setProgressWork("", 0);
+      theInputConnection->setPipelineTiles(savedPipelineTiles);
    }
   
    /*
@@ -1205,6 +1233,7 @@ void ossimImageFileWriter::setPercentComplete(double percentComplete)
 {
    ossimProcessInterface::setPercentComplete(percentComplete);
    ossimProcessProgressEvent event(this, percentComplete);
+   initializeProgressWork(event);
    fireEvent(event);
 }
 
@@ -1554,6 +1583,16 @@ void ossimImageFileWriter::setPixelType(const ossimString& type)
    }
 }
 
+void ossimImageFileWriter::setPipelineTiles(ossim_uint32 count)
+{
+   thePipelineTiles = count;
+}
+
+ossim_uint32 ossimImageFileWriter::getPipelineTiles() const
+{
+   return thePipelineTiles;
+}
+
 ossimPixelType ossimImageFileWriter::getPixelType() const
 {
    return thePixelType;
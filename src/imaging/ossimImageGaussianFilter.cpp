@@ -10,6 +10,8 @@
 #include <ossim/base/ossimNumericProperty.h>
 #include <ossim/base/ossimBooleanProperty.h>
 #include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
+#include <algorithm>
 #include <cmath>
 
 RTTI_DEF1(ossimImageGaussianFilter, "ossimImageGaussianFilter", ossimImageSourceFilter);
@@ -19,12 +21,18 @@ RTTI_DEF1(ossimImageGaussianFilter, "ossimImageGaussianFilter", ossimImageSource
  */
 static const char* PROPERTYNAME_GAUSSSTD     = "GaussStd";
 static const char* PROPERTYNAME_STRICTNODATA = "StrictNoData";
+static const char* PROPERTYNAME_RECURSIVE    = "Recursive";
 
 ossimImageGaussianFilter::ossimImageGaussianFilter()
    : ossimImageSourceFilter(),
      theGaussStd(0.5),
-     theStrictNoData(true)
+     theStrictNoData(true),
+     theRecursiveFlag(false),
+     theRecursiveB(1.0),
+     theTile(0)
 {
+   theRecursiveA[0] = theRecursiveA[1] = theRecursiveA[2] = 0.0;
+
    // ingredients: 
    // 2x  ConvolutionFilter1D
    theHF=new ossimConvolutionFilter1D();
@@ -73,6 +81,13 @@ void ossimImageGaussianFilter::setProperty(ossimRefPtr<ossimProperty> property)
       {
          setStrictNoData(booleanProperty->getBoolean());
       }
+   } else if (property->getName() == PROPERTYNAME_RECURSIVE) {
+      ossimBooleanProperty* booleanProperty = PTR_CAST(ossimBooleanProperty,
+                                                     property.get());
+      if(booleanProperty)
+      {
+         setRecursive(booleanProperty->getBoolean());
+      }
    } else {
       ossimImageSourceFilter::setProperty(property);
    }
@@ -88,6 +103,10 @@ ossimRefPtr<ossimProperty> ossimImageGaussianFilter::getProperty(const ossimStri
       ossimBooleanProperty* property = new ossimBooleanProperty(name,isStrictNoData());
       property->setCacheRefreshBit();
       return property;
+   } else if (name == PROPERTYNAME_RECURSIVE) {
+      ossimBooleanProperty* property = new ossimBooleanProperty(name,isRecursive());
+      property->setCacheRefreshBit();
+      return property;
    }
    return ossimImageSourceFilter::getProperty(name);
 }
@@ -97,6 +116,7 @@ void ossimImageGaussianFilter::getPropertyNames(std::vector<ossimString>& proper
    ossimImageSourceFilter::getPropertyNames(propertyNames);
    propertyNames.push_back(PROPERTYNAME_GAUSSSTD);
    propertyNames.push_back(PROPERTYNAME_STRICTNODATA);
+   propertyNames.push_back(PROPERTYNAME_RECURSIVE);
 }
 
 bool ossimImageGaussianFilter::saveState(ossimKeywordlist& kwl,
@@ -110,6 +130,10 @@ bool ossimImageGaussianFilter::saveState(ossimKeywordlist& kwl,
            PROPERTYNAME_STRICTNODATA,
            isStrictNoData()?"true":"false", //use string instead of boolean
            true);
+   kwl.add(prefix,
+           PROPERTYNAME_RECURSIVE,
+           isRecursive()?"true":"false",
+           true);
    
    return ossimImageSourceFilter::saveState(kwl, prefix);
 }
@@ -132,6 +156,9 @@ bool ossimImageGaussianFilter::loadState(const ossimKeywordlist& kwl,
    } else {
       cerr<<"ossimConvolutionFilter1D : warning no "<<PROPERTYNAME_STRICTNODATA<<" in state"<<endl;
    }
+   // Optional, states saved before it existed use the kernel filters.
+   const char* rec = kwl.find(prefix, PROPERTYNAME_RECURSIVE);
+   setRecursive(rec ? ossimString(rec).toBool() : false);
    return ossimImageSourceFilter::loadState(kwl, prefix);
 }
 
@@ -148,11 +175,17 @@ void ossimImageGaussianFilter::setStrictNoData(bool aStrict)
    theVF->setStrictNoData(aStrict);
 }
 
+void ossimImageGaussianFilter::setRecursive(bool flag)
+{
+   theRecursiveFlag = flag;
+}
+
 void
 ossimImageGaussianFilter::initialize()
 {
    ossimImageSourceFilter::initialize();
    initializeProcesses();
+   theTile = 0;
 }
 
 ossimRefPtr<ossimImageData>
@@ -160,6 +193,10 @@ ossimImageGaussianFilter::getTile(const ossimIrect &tileRect,ossim_uint32 resLev
 {
     if(isSourceEnabled())
     {
+       if(useRecursive())
+       {
+          return getRecursiveTile(tileRect, resLevel);
+       }
        return theVF->getTile(tileRect, resLevel);
     }
     if(theInputConnection)
@@ -242,4 +279,281 @@ ossimImageGaussianFilter::updateKernels()
    theVF->setKernel(newk);
    theHF->setCenterOffset(halfw);
    theVF->setCenterOffset(halfw);
+
+   //---
+   // Recursive filter coefficients, from I.T. Young and L.J. van Vliet, "Recursive
+   // implementation of the Gaussian filter", Signal Processing 44 (1995).  Valid for
+   // sigma >= 0.5.
+   //---
+   if(getGaussStd() >= 0.5)
+   {
+      const ossim_float64 sigma = getGaussStd();
+      const ossim_float64 q = (sigma >= 2.5) ? (0.98711*sigma - 0.96330) :
+         (3.97156 - 4.14554*std::sqrt(1.0 - 0.26891*sigma));
+      const ossim_float64 q2 = q*q;
+      const ossim_float64 q3 = q2*q;
+      const ossim_float64 b0 = 1.57825 + 2.44413*q + 1.4281*q2 + 0.422205*q3;
+      theRecursiveA[0] = (2.44413*q + 2.85619*q2 + 1.26661*q3)/b0;
+      theRecursiveA[1] = -(1.4281*q2 + 1.26661*q3)/b0;
+      theRecursiveA[2] = (0.422205*q3)/b0;
+      theRecursiveB    = 1.0 - (theRecursiveA[0] + theRecursiveA[1] + theRecursiveA[2]);
+   }
+}
+
+bool ossimImageGaussianFilter::useRecursive()const
+{
+   // Below 2.5 the recursive approximation degrades and the kernels are short anyway.
+   return (theRecursiveFlag && (getGaussStd() >= 2.5));
+}
+
+ossimRefPtr<ossimImageData> ossimImageGaussianFilter::getRecursiveTile(
+   const ossimIrect& tileRect, ossim_uint32 resLevel)
+{
+   if(!theInputConnection)
+   {
+      return 0;
+   }
+
+   // Enough input that the tile edges do not see the edges of the request.
+   const ossim_int32 halo = (ossim_int32)std::ceil(4.0*getGaussStd());
+   const ossimIrect inputRect(tileRect.ul().x - halo,
+                              tileRect.ul().y - halo,
+                              tileRect.lr().x + halo,
+                              tileRect.lr().y + halo);
+   ossimRefPtr<ossimImageData> input = theInputConnection->getTile(inputRect, resLevel);
+   if(!input.valid())
+   {
+      return input;
+   }
+
+   if(!theTile.valid())
+   {
+      theTile = ossimImageDataFactory::instance()->create(this, this);
+      theTile->initialize();
+   }
+   theTile->setImageRectangle(tileRect);
+   theTile->makeBlank();
+
+   if( !input->getBuf() ||
+       (input->getDataObjectStatus() == OSSIM_NULL) ||
+       (input->getDataObjectStatus() == OSSIM_EMPTY) ||
+       (input->getImageRectangle() != inputRect) )
+   {
+      return theTile;
+   }
+   
+   switch(input->getScalarType())
+   {
+      case OSSIM_UCHAR:
+      {
+         recursiveFilter(static_cast<ossim_uint8>(0), input.get());
+         break;
+      }
+      case OSSIM_FLOAT: 
+      case OSSIM_NORMALIZED_FLOAT:
+      {
+         recursiveFilter(static_cast<float>(0), input.get());
+         break;
+      }
+      case OSSIM_USHORT16:
+      case OSSIM_USHORT11:
+      {
+         recursiveFilter(static_cast<ossim_uint16>(0), input.get());
+         break;
+      }
+      case OSSIM_SSHORT16:
+      {
+         recursiveFilter(static_cast<ossim_sint16>(0), input.get());
+         break;
+      }
+      case OSSIM_DOUBLE:
+      case OSSIM_NORMALIZED_DOUBLE:
+      {
+         recursiveFilter(static_cast<double>(0), input.get());
+         break;
+      }
+      default:
+      {
+         return theVF->getTile(tileRect, resLevel);
+      }
+   }
+   theTile->validate();
+   
+   return theTile;
+}
+
+template <class T>
+void ossimImageGaussianFilter::recursiveFilter(T, const ossimImageData* input)
+{
+   const long inW  = (long)input->getWidth();
+   const long inH  = (long)input->getHeight();
+   const long outW = (long)theTile->getWidth();
+   const long outH = (long)theTile->getHeight();
+   const long dx   = theTile->getOrigin().x - input->getOrigin().x;
+   const long dy   = theTile->getOrigin().y - input->getOrigin().y;
+   const bool checkNulls = (input->getDataObjectStatus() != OSSIM_FULL);
+   const bool strict     = checkNulls && theStrictNoData;
+
+   // Window of the kernel filters, for StrictNoData.
+   const long halfw = (long)std::floor(getGaussStd() * 2.5 + 0.5);
+
+   theBuffer.resize(inW*inH);
+   theTransposeBuffer.resize(inW*outH);
+   if(strict)
+   {
+      theNullCount.resize(inH*outW + outH*outW);
+   }
+   double* buf = &theBuffer.front();
+   double* tr  = &theTransposeBuffer.front();
+   
+   for(ossim_uint32 band = 0; band < theTile->getNumberOfBands(); ++band)
+   {
+      const T* inBuf  = static_cast<const T*>(input->getBuf(band));
+      T* outBuf       = static_cast<T*>(theTile->getBuf(band));
+      const T nullPix  = static_cast<T>(input->getNullPix(band));
+      const T oNullPix = static_cast<T>(theTile->getNullPix(band));
+      const double minPix = theTile->getMinPix(band);
+      const double maxPix = theTile->getMaxPix(band);
+      if(!inBuf || !outBuf)
+      {
+         continue;
+      }
+
+      // NODATA pixels are processed as zero.
+      for(long i = 0; i < inW*inH; ++i)
+      {
+         buf[i] = (checkNulls && (inBuf[i] == nullPix)) ? 0.0 : (double)inBuf[i];
+      }
+
+      // Vertical pass, then the horizontal one over the rows of the tile, transposed so both
+      // run across lines.
+      recursiveLines(buf, inH, inW);
+      for(long y = 0; y < outH; ++y)
+      {
+         const double* row = buf + (dy + y)*inW;
+         for(long x = 0; x < inW; ++x)
+         {
+            tr[x*outH + y] = row[x];
+         }
+      }
+      recursiveLines(tr, inW, outH);
+
+      //---
+      // StrictNoData: count the NODATA pixels of each (2*halfw+1)^2 window, as a horizontal
+      // then a vertical running count.
+      //---
+      const ossim_uint32* windowNulls = 0;
+      if(strict)
+      {
+         ossim_uint32* rowCount = &theNullCount.front();
+         for(long r = 0; r < inH; ++r)
+         {
+            const T* inRow = inBuf + r*inW;
+            ossim_uint32* countRow = rowCount + r*outW;
+            long lo = dx - halfw;
+            long hi = dx + halfw;
+            ossim_uint32 count = 0;
+            for(long c = std::max(lo, 0L); c <= std::min(hi, inW - 1); ++c)
+            {
+               count += (inRow[c] == nullPix) ? 1 : 0;
+            }
+            for(long x = 0; x < outW; ++x)
+            {
+               countRow[x] = count;
+               if((lo >= 0) && (lo < inW)) count -= (inRow[lo] == nullPix) ? 1 : 0;
+               ++lo;
+               ++hi;
+               if((hi >= 0) && (hi < inW)) count += (inRow[hi] == nullPix) ? 1 : 0;
+            }
+         }
+         ossim_uint32* tileCount = rowCount + inH*outW;
+         for(long x = 0; x < outW; ++x)
+         {
+            long lo = dy - halfw;
+            long hi = dy + halfw;
+            ossim_uint32 count = 0;
+            for(long r = std::max(lo, 0L); r <= std::min(hi, inH - 1); ++r)
+            {
+               count += rowCount[r*outW + x];
+            }
+            for(long y = 0; y < outH; ++y)
+            {
+               tileCount[y*outW + x] = count;
+               if((lo >= 0) && (lo < inH)) count -= rowCount[lo*outW + x];
+               ++lo;
+               ++hi;
+               if((hi >= 0) && (hi < inH)) count += rowCount[hi*outW + x];
+            }
+         }
+         windowNulls = tileCount;
+      }
+      
+      for(long y = 0; y < outH; ++y)
+      {
+         const T* center = inBuf + (dy + y)*inW + dx;
+         T* out = outBuf + y*outW;
+         for(long x = 0; x < outW; ++x)
+         {
+            if( checkNulls && ( (center[x] == nullPix) ||
+                                (windowNulls && windowNulls[y*outW + x]) ) )
+            {
+               out[x] = oNullPix;
+            }
+            else
+            {
+               const double sum = tr[(dx + x)*outH + y];
+               if(sum > maxPix)
+               {
+                  out[x] = static_cast<T>(maxPix);
+               }
+               else if(sum < minPix)
+               {
+                  out[x] = static_cast<T>(minPix);
+               }
+               else
+               {
+                  out[x] = static_cast<T>(sum);
+               }
+            }
+         }
+      }
+   }
+}
+
+void ossimImageGaussianFilter::recursiveLines(double* data,
+                                              long numberOfLines,
+                                              long width)const
+{
+   //---
+   // Samples before the first line and after the last are taken equal to it, which leaves
+   // those lines unchanged by each pass.
+   //---
+   const double B  = theRecursiveB;
+   const double a1 = theRecursiveA[0];
+   const double a2 = theRecursiveA[1];
+   const double a3 = theRecursiveA[2];
+   const long last = numberOfLines - 1;
+   
+   for(long i = 1; i <= last; ++i)
+   {
+      double* d = data + i*width;
+      const double* p1 = data + (i - 1)*width;
+      const double* p2 = data + ((i >= 2) ? i - 2 : 0)*width;
+      const double* p3 = data + ((i >= 3) ? i - 3 : 0)*width;
+      for(long x = 0; x < width; ++x)
+      {
+         d[x] = B*d[x] + a1*p1[x] + a2*p2[x] + a3*p3[x];
+      }
+   }
+   for(long i = last - 1; i >= 0; --i)
+   {
+      double* d = data + i*width;
+      const double* p1 = data + (i + 1)*width;
+      const double* p2 = data + std::min(i + 2, last)*width;
+      const double* p3 = data + std::min(i + 3, last)*width;
+      for(long x = 0; x < width; ++x)
+      {
+         d[x] = B*d[x] + a1*p1[x] + a2*p2[x] + a3*p3[x];
+      }
+   }
 }
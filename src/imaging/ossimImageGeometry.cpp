@@ -14,16 +14,24 @@
 #include <ossim/imaging/ossimImageGeometry.h>
 #include <ossim/base/ossimCommon.h>
 #include <ossim/base/ossimDrect.h>
+#include <ossim/base/ossimErrorCodes.h>
 #include <ossim/base/ossimIrect.h>
 #include <ossim/base/ossimGrect.h>
 #include <ossim/base/ossimKeywordNames.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossim2dTo2dTransformRegistry.h>
 #include <ossim/elevation/ossimElevManager.h>
 #include <ossim/projection/ossimProjection.h>
+#include <ossim/projection/ossimCoarseGridModel.h>
 #include <ossim/projection/ossimEquDistCylProjection.h>
 #include <ossim/projection/ossimProjectionFactoryRegistry.h>
 #include <ossim/imaging/ossimImageHandlerRegistry.h>
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <vector>
 
 RTTI_DEF1(ossimImageGeometry, "ossimImageGeometry", ossimObject);
 
@@ -171,6 +179,43 @@ void ossimImageGeometry::worldToRn(const ossimGpt& wpt,
    rnToRn(localPt, m_targetRrds, resolutionLevel, rnPt);
 }
 
+void ossimImageGeometry::rnToWorld(const ossimDpt* rnPts,
+                                   ossim_uint32 resolutionLevel,
+                                   ossimGpt* wpts,
+                                   ossim_uint32 count) const
+{
+   if (resolutionLevel == m_targetRrds)
+   {
+      localToWorld(rnPts, wpts, count);
+      return;
+   }
+   std::vector<ossimDpt> localPts(count);
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      rnToRn(rnPts[i], resolutionLevel, m_targetRrds, localPts[i]);
+   }
+   if (count)
+   {
+      localToWorld(&localPts[0], wpts, count);
+   }
+}
+
+void ossimImageGeometry::worldToRn(const ossimGpt* wpts,
+                                   ossim_uint32 resolutionLevel,
+                                   ossimDpt* rnPts,
+                                   ossim_uint32 count) const
+{
+   worldToLocal(wpts, rnPts, count);
+   if (resolutionLevel != m_targetRrds)
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         ossimDpt localPt = rnPts[i];
+         rnToRn(localPt, m_targetRrds, resolutionLevel, rnPts[i]);
+      }
+   }
+}
+
 //**************************************************************************************************
 //! Exposes the 3D projection from image to world coordinates. The caller should verify that
 //! a valid projection exists before calling this method. Returns TRUE if a valid ground point
@@ -199,13 +244,68 @@ bool ossimImageGeometry::localToWorld(const ossimDpt& local_pt, ossimGpt& world_
    return true;
 }
 
+bool ossimImageGeometry::localToWorld(const ossimDpt* local_pts,
+                                      ossimGpt* world_pts,
+                                      ossim_uint32 count) const
+{
+   if (!m_projection.valid())
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         world_pts[i].makeNan();
+      }
+      return false;
+   }
+
+   std::vector<ossimDpt> full_image_pts(count);
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      rnToFull(local_pts[i], m_targetRrds, full_image_pts[i]);
+   }
+   if (count)
+   {
+      m_projection->lineSampleToWorlds(&full_image_pts[0], world_pts, count);
+   }
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      world_pts[i].wrap();
+   }
+   return true;
+}
+
+bool ossimImageGeometry::localToWorld(const ossimDpt& origin,
+                                      const ossimDpt& step,
+                                      ossim_uint32 width,
+                                      ossim_uint32 height,
+                                      ossimGpt* world_pts) const
+{
+   const ossim_uint32 COUNT = width * height;
+   std::vector<ossimDpt> local_pts(COUNT);
+   ossim_uint32 i = 0;
+   for (ossim_uint32 row = 0; row < height; ++row)
+   {
+      const double y = origin.y + row * step.y;
+      for (ossim_uint32 col = 0; col < width; ++col)
+      {
+         local_pts[i].x = origin.x + col * step.x;
+         local_pts[i].y = y;
+         ++i;
+      }
+   }
+   if (!COUNT)
+   {
+      return m_projection.valid();
+   }
+   return localToWorld(&local_pts[0], world_pts, COUNT);
+}
+
 bool ossimImageGeometry::localToWorld(const ossimDrect& local_rect, ossimGrect& world_rect) const
 {
-   ossimGpt gp1, gp2, gp3, gp4;
-   if (  localToWorld(local_rect.ul(), gp1) && localToWorld(local_rect.ur(), gp2) &&
-         localToWorld(local_rect.lr(), gp3) && localToWorld(local_rect.ll(), gp4))
+   const ossimDpt corners[4] = { local_rect.ul(), local_rect.ur(), local_rect.lr(), local_rect.ll() };
+   ossimGpt gp[4];
+   if ( localToWorld(corners, gp, 4) )
    {
-      world_rect = ossimGrect(gp1, gp2, gp3, gp4);
+      world_rect = ossimGrect(gp[0], gp[1], gp[2], gp[3]);
       return true;
    }
    return false;
@@ -299,13 +399,93 @@ bool ossimImageGeometry::worldToLocal(const ossimGpt& world_pt, ossimDpt& local_
    
 } // End: ossimImageGeometry::worldToLocal(const ossimGpt&, ossimDpt&)
 
+bool ossimImageGeometry::worldToLocal(const ossimGpt* world_pts,
+                                      ossimDpt* local_pts,
+                                      ossim_uint32 count) const
+{
+   if ( !m_projection.valid() )
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         local_pts[i].makeNan();
+      }
+      return false;
+   }
+
+   std::vector<ossimGpt> copyPts;
+   const ossimGpt* gpts = world_pts;
+   if ( isAffectedByElevation() )
+   {
+      std::vector<ossim_uint32> missing;
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         if ( world_pts[i].isHgtNan() )
+         {
+            missing.push_back(i);
+         }
+      }
+      if ( missing.size() )
+      {
+         copyPts.assign(world_pts, world_pts + count);
+         std::vector<ossimGpt> lookups(missing.size());
+         std::vector<double> heights(missing.size());
+         for (ossim_uint32 i = 0; i < missing.size(); ++i)
+         {
+            lookups[i] = world_pts[missing[i]];
+         }
+         ossimElevManager::instance()->getHeightsAboveEllipsoid(&lookups[0], &heights[0],
+                                                                (ossim_uint32)missing.size());
+         for (ossim_uint32 i = 0; i < missing.size(); ++i)
+         {
+            copyPts[missing[i]].hgt = heights[i];
+         }
+         gpts = &copyPts[0];
+      }
+   }
+
+   // Perform projection from world coordinates to full-image space, then to local space:
+   m_projection->worldToLineSamples(gpts, local_pts, count);
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      ossimDpt full_image_pt = local_pts[i];
+      fullToRn(full_image_pt, m_targetRrds, local_pts[i]);
+   }
+   return true;
+}
+
+bool ossimImageGeometry::worldToLocal(const ossimGpt& origin,
+                                      const ossimDpt& spacing,
+                                      ossim_uint32 width,
+                                      ossim_uint32 height,
+                                      ossimDpt* local_pts) const
+{
+   const ossim_uint32 COUNT = width * height;
+   std::vector<ossimGpt> world_pts(COUNT, origin);
+   ossim_uint32 i = 0;
+   for (ossim_uint32 row = 0; row < height; ++row)
+   {
+      const double lat = origin.lat + row * spacing.y;
+      for (ossim_uint32 col = 0; col < width; ++col)
+      {
+         world_pts[i].lat = lat;
+         world_pts[i].lon = origin.lon + col * spacing.x;
+         ++i;
+      }
+   }
+   if (!COUNT)
+   {
+      return m_projection.valid();
+   }
+   return worldToLocal(&world_pts[0], local_pts, COUNT);
+}
+
 bool ossimImageGeometry::worldToLocal(const ossimGrect& world_rect, ossimDrect& local_rect) const
 {
-   ossimDpt dp1, dp2, dp3, dp4;
-   if (  worldToLocal(world_rect.ul(), dp1) && worldToLocal(world_rect.ur(), dp2) &&
-         worldToLocal(world_rect.lr(), dp3) && worldToLocal(world_rect.ll(), dp4))
+   const ossimGpt corners[4] = { world_rect.ul(), world_rect.ur(), world_rect.lr(), world_rect.ll() };
+   ossimDpt dp[4];
+   if ( worldToLocal(corners, dp, 4) )
    {
-      local_rect = ossimDrect(dp1, dp2, dp3, dp4);
+      local_rect = ossimDrect(dp[0], dp[1], dp[2], dp[3]);
       return true;
    }
    return false;
@@ -327,6 +507,122 @@ void ossimImageGeometry::setProjection(ossimProjection* projection)
    m_projection = projection; 
 }
 
+//**************************************************************************************************
+// FNV-1a hash of the saved states keying the coarse grid cache.
+//**************************************************************************************************
+static ossim_uint64 coarseGridHash(const ossimString& state)
+{
+   ossim_uint64 hash = 14695981039346656037ULL;
+   std::string::const_iterator iter = state.string().begin();
+   while ( iter != state.string().end() )
+   {
+      hash ^= (ossim_uint64)(unsigned char)(*iter);
+      hash *= 1099511628211ULL;
+      ++iter;
+   }
+   return hash;
+}
+
+//**************************************************************************************************
+//! Replaces an expensive rigorous projection with a (cached) coarse grid approximation.
+//**************************************************************************************************
+bool ossimImageGeometry::applyCoarseGridApproximation()
+{
+   if ( !m_projection.valid() || m_imageSize.hasNans() ||
+        (m_imageSize.x < 2) || (m_imageSize.y < 2) )
+   {
+      return false;
+   }
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("image_geometry.coarse_grid.enabled");
+   if ( !lookup || !ossimString(lookup).toBool() )
+   {
+      return false;
+   }
+
+   ossimString models = "ossimSpot5Model ossimRS1SarModel ossimNitfRsmModel";
+   lookup = ossimPreferences::instance()->findPreference("image_geometry.coarse_grid.models");
+   if ( lookup )
+   {
+      models = lookup;
+   }
+   std::vector<ossimString> modelList = models.split(" ", true);
+   const ossimString CLASS_NAME = m_projection->getClassName();
+   if ( std::find(modelList.begin(), modelList.end(), CLASS_NAME) == modelList.end() )
+   {
+      return false;
+   }
+
+   double error = 0.1;
+   lookup = ossimPreferences::instance()->findPreference("image_geometry.coarse_grid.error");
+   if ( lookup )
+   {
+      error = ossimString(lookup).toDouble();
+   }
+
+   //---
+   // Cache key: everything the grid depends on.  The model state includes its adjustments;
+   // the elevation state its databases and geoid.
+   //---
+   ossimFilename gridFile;
+   lookup = ossimPreferences::instance()->findPreference("image_geometry.coarse_grid.directory");
+   if ( lookup && *lookup )
+   {
+      ossimKeywordlist kwl;
+      m_projection->saveState(kwl, "model.");
+      ossimElevManager::instance()->saveState(kwl, "elevation.");
+      kwl.add("image_size", m_imageSize.toString().c_str());
+      kwl.add("error", error);
+      ossimString state;
+      kwl.toString(state);
+
+      char name[32];
+      sprintf(name, "%016llx", (unsigned long long)coarseGridHash(state));
+      gridFile = ossimFilename(lookup).expand().dirCat(ossimFilename(name));
+      gridFile.setExtension("ocg");
+   }
+
+   ossimRefPtr<ossimCoarseGridModel> coarseGrid = new ossimCoarseGridModel();
+   bool loaded = false;
+   if ( gridFile.size() && gridFile.isReadable() )
+   {
+      ossimFilename geomFile = gridFile;
+      geomFile.setExtension("geom");
+      ossimKeywordlist kwl;
+      if ( kwl.addFile(geomFile) )
+      {
+         kwl.add("grid_file_name", gridFile.c_str(), true);
+         loaded = coarseGrid->loadState(kwl);
+      }
+   }
+
+   if ( !loaded )
+   {
+      const double PREVIOUS_ERROR = ossimCoarseGridModel::getInterpolationError();
+      ossimCoarseGridModel::setInterpolationError(error);
+      ossimDrect imageBounds(0.0, 0.0, m_imageSize.x - 1, m_imageSize.y - 1);
+      coarseGrid->buildGrid(imageBounds, m_projection.get(), 500.0, true, false);
+      ossimCoarseGridModel::setInterpolationError(PREVIOUS_ERROR);
+      if ( coarseGrid->getErrorStatus() != ossimErrorCodes::OSSIM_OK )
+      {
+         return false;
+      }
+      if ( gridFile.size() )
+      {
+         ossimFilename(gridFile.path()).createDirectory();
+         if ( !coarseGrid->saveCoarseGrid(gridFile) )
+         {
+            ossimNotify(ossimNotifyLevel_WARN)
+               << "ossimImageGeometry::applyCoarseGridApproximation WARNING:"
+               << "\nCould not write coarse grid cache " << gridFile << std::endl;
+         }
+      }
+   }
+
+   m_projection = coarseGrid.get();
+   return true;
+}
+
 //**************************************************************************************************
 //! Returns TRUE if this geometry is sensitive to elevation
 //**************************************************************************************************
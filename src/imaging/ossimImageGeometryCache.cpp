@@ -0,0 +1,187 @@
+//*******************************************************************
+//
+// License:  LGPL
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description: Store of image geometries shared by handlers and processes.
+//
+//********************************************************************
+
+#include <ossim/imaging/ossimImageGeometryCache.h>
+#include <ossim/base/ossimDate.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimTrace.h>
+#include <ossim/imaging/ossimImageGeometry.h>
+#include <OpenThreads/ScopedLock>
+#include <cstdio>
+
+static ossimTrace traceDebug("ossimImageGeometryCache:debug");
+
+namespace
+{
+   const char CACHE_PREFIX[]    = "cache.";
+   const char GEOMETRY_PREFIX[] = "geometry.";
+
+   // Modification time and size, to tell if a saved geometry is older than its image.
+   bool getFileStamp(const ossimFilename& file, ossim_int64& modTime, ossim_int64& size)
+   {
+      ossimLocalTm t;
+      if ( !file.getTimes(0, &t, 0) )
+      {
+         return false;
+      }
+      modTime = (ossim_int64)(time_t)t;
+      size    = file.fileSize();
+      return true;
+   }
+}
+
+ossimImageGeometryCache* ossimImageGeometryCache::instance()
+{
+   static ossimImageGeometryCache theInstance;
+   return &theInstance;
+}
+
+ossimImageGeometryCache::ossimImageGeometryCache()
+   : m_mutex(),
+     m_directory()
+{
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("image_geometry.cache_directory");
+   if ( lookup && *lookup )
+   {
+      m_directory = ossimFilename(lookup).expand();
+   }
+}
+
+bool ossimImageGeometryCache::isEnabled() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   return !m_directory.empty();
+}
+
+void ossimImageGeometryCache::setDirectory(const ossimFilename& dir)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   m_directory = dir.empty() ? dir : dir.expand();
+}
+
+ossimFilename ossimImageGeometryCache::getDirectory() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   return m_directory;
+}
+
+bool ossimImageGeometryCache::load(const ossimFilename& file,
+                                   ossim_uint32 entry,
+                                   ossimImageGeometry& geom) const
+{
+   const ossimFilename CACHE_FILE = getCacheFile(file, entry);
+   ossim_int64 modTime = 0;
+   ossim_int64 size = 0;
+   if ( CACHE_FILE.empty() || !CACHE_FILE.exists() || !getFileStamp(file, modTime, size) )
+   {
+      return false;
+   }
+
+   ossimKeywordlist kwl;
+   if ( !kwl.addFile(CACHE_FILE) )
+   {
+      return false;
+   }
+
+   // The image is the reference; a geometry older than it is built again.
+   if ( ( ossimString(kwl.find(CACHE_PREFIX, "file")) != file.expand() ) ||
+        ( ossimString(kwl.find(CACHE_PREFIX, "entry")).toUInt32() != entry ) ||
+        ( ossimString(kwl.find(CACHE_PREFIX, "file_size")).toInt64() != size ) ||
+        ( ossimString(kwl.find(CACHE_PREFIX, "mod_time")).toInt64() != modTime ) )
+   {
+      return false;
+   }
+
+   geom.loadState(kwl, GEOMETRY_PREFIX);
+
+   if (traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimImageGeometryCache::load: " << file << " entry " << entry
+         << " from " << CACHE_FILE << std::endl;
+   }
+   return geom.hasProjection();
+}
+
+void ossimImageGeometryCache::save(const ossimFilename& file,
+                                   ossim_uint32 entry,
+                                   const ossimImageGeometry& geom) const
+{
+   const ossimFilename CACHE_FILE = getCacheFile(file, entry);
+   ossim_int64 modTime = 0;
+   ossim_int64 size = 0;
+   if ( CACHE_FILE.empty() || !geom.hasProjection() || !getFileStamp(file, modTime, size) )
+   {
+      return;
+   }
+
+   ossimKeywordlist kwl;
+   kwl.add(CACHE_PREFIX, "file", file.expand().c_str(), true);
+   kwl.add(CACHE_PREFIX, "entry", entry, true);
+   kwl.add(CACHE_PREFIX, "file_size", size, true);
+   kwl.add(CACHE_PREFIX, "mod_time", modTime, true);
+   if ( !geom.saveState(kwl, GEOMETRY_PREFIX) )
+   {
+      return;
+   }
+
+   // Write and rename, so other processes never read a partial file.
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   if ( !m_directory.exists() )
+   {
+      m_directory.createDirectory(true);
+   }
+   const ossimFilename TMP_FILE = CACHE_FILE + ".tmp";
+   if ( kwl.write(TMP_FILE.c_str()) && TMP_FILE.rename(CACHE_FILE, true) )
+   {
+      if (traceDebug())
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << "ossimImageGeometryCache::save: " << file << " entry " << entry
+            << " to " << CACHE_FILE << std::endl;
+      }
+   }
+   else
+   {
+      TMP_FILE.remove();
+      if (traceDebug())
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << "ossimImageGeometryCache::save: could not write " << CACHE_FILE << std::endl;
+      }
+   }
+}
+
+ossimFilename ossimImageGeometryCache::getCacheFile(const ossimFilename& file,
+                                                    ossim_uint32 entry) const
+{
+   const ossimFilename DIR = getDirectory();
+   if ( DIR.empty() || file.empty() )
+   {
+      return ossimFilename();
+   }
+
+   // Image name for people looking in the directory, and a hash of the whole path (FNV-1a).
+   const std::string PATH = file.expand().string();
+   ossim_uint64 hash = 14695981039346656037ULL;
+   for (std::string::size_type i = 0; i < PATH.size(); ++i)
+   {
+      hash ^= static_cast<unsigned char>(PATH[i]);
+      hash *= 1099511628211ULL;
+   }
+   char name[64];
+   sprintf(name, "_%08x%08x_e%u.geom",
+           static_cast<unsigned>(hash >> 32), static_cast<unsigned>(hash & 0xffffffff),
+           static_cast<unsigned>(entry));
+   return DIR.dirCat( ossimFilename(file.file() + name) );
+}
@@ -10,6 +10,8 @@
 // $Id$
 #include <ossim/imaging/ossimImageGeometryRegistry.h>
 #include <ossim/imaging/ossimImageGeometryFactory.h>
+#include <ossim/imaging/ossimImageGeometryCache.h>
+#include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/base/ossimObjectFactoryRegistry.h>
 ossimImageGeometryRegistry* ossimImageGeometryRegistry::m_instance = 0;
 RTTI_DEF1(ossimImageGeometryRegistry, "ossimImageGeometryRegistry", ossimImageGeometryFactoryBase);
@@ -27,12 +29,34 @@ ossimImageGeometryRegistry* ossimImageGeometryRegistry::instance()
 
 bool ossimImageGeometryRegistry::extendGeometry(ossimImageHandler* handler)const
 {
+   // A geometry saved by an earlier open skips the support data parsing.
+   ossimImageGeometryCache* cache = ossimImageGeometryCache::instance();
+   const bool CACHE_FLAG = handler && cache->isEnabled();
+   if ( CACHE_FLAG )
+   {
+      ossimRefPtr<ossimImageGeometry> geom = handler->getImageGeometry();
+      if ( geom.valid() &&
+           cache->load(handler->getFilename(), handler->getCurrentEntry(), *geom) )
+      {
+         return true;
+      }
+   }
+
    bool result = false;
    ossim_uint32 idx = 0;
    for(;((idx < m_factoryList.size())&&!result); ++idx)
    {
       result = m_factoryList[idx]->extendGeometry(handler);
    }
+
+   if ( result && CACHE_FLAG )
+   {
+      ossimRefPtr<ossimImageGeometry> geom = handler->getImageGeometry();
+      if ( geom.valid() )
+      {
+         cache->save(handler->getFilename(), handler->getCurrentEntry(), *geom);
+      }
+   }
    
    return result;
 }
@@ -63,12 +87,28 @@ ossimImageGeometry* ossimImageGeometryRegistry::createGeometry(const ossimKeywor
 ossimImageGeometry* ossimImageGeometryRegistry::createGeometry(const ossimFilename& filename,
                                                                        ossim_uint32 entryIdx)const
 {
+   ossimImageGeometryCache* cache = ossimImageGeometryCache::instance();
+   const bool CACHE_FLAG = cache->isEnabled();
+   if ( CACHE_FLAG )
+   {
+      ossimRefPtr<ossimImageGeometry> geom = new ossimImageGeometry();
+      if ( cache->load(filename, entryIdx, *geom) )
+      {
+         return geom.release();
+      }
+   }
+
    ossimImageGeometry* result = 0;
    ossim_uint32 idx = 0;
    for(;((idx < m_factoryList.size())&&!result); ++idx)
    {
       result = m_factoryList[idx]->createGeometry(filename, entryIdx);
    }
+
+   if ( result && CACHE_FLAG )
+   {
+      cache->save(filename, entryIdx, *result);
+   }
    
    return result;
 }
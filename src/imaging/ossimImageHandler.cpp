@@ -38,6 +38,7 @@
 #include <ossim/imaging/ossimTiffOverviewBuilder.h>
 #include <ossim/projection/ossimProjection.h>
 #include <ossim/projection/ossimProjectionFactoryRegistry.h>
+#include <ossim/support_data/ossimSupportFilesList.h>
 #include <algorithm>
 
 RTTI_DEF1(ossimImageHandler, "ossimImageHandler", ossimImageSource)
@@ -264,7 +265,7 @@ bool ossimImageHandler::initVertices(const char* file)
    static const char MODULE[] = "ossimImageHandler::initVertices";
 
    ossimFilename f = file;
-   if (!f.exists()) return false;
+   if (!ossimSupportFilesList::instance()->exists(f)) return false;
 
    ossimKeywordlist kwl(file);
    
@@ -507,6 +508,7 @@ bool ossimImageHandler::buildHistogram(int numberOfRLevels)
       writer->setFilename(file);
       writer->addListener(&theStdOutProgress);
       writer->execute();
+      ossimSupportFilesList::instance()->refresh(file);
       histoSource->disconnect();
       writer->disconnect();
       histoSource = 0;
@@ -633,6 +635,7 @@ bool ossimImageHandler::buildOverview(const ossimFilename& filename,
    tiffBuilder.setCompressionType(cType);
    tiffBuilder.setResampleType(resampleType);
    tiffBuilder.buildOverview(filename, includeFullResFlag);
+   ossimSupportFilesList::instance()->refresh(filename);
 
    return true;
 }
@@ -692,25 +695,25 @@ ossimRefPtr<ossimImageGeometry> ossimImageHandler::getExternalImageGeometry() co
    // No geometry object has been set up yet. Check for external geometry file.
    // Try "foo.geom" if image is "foo.tif":
    ossimFilename filename = getFilenameWithThisExtension(ossimString(".geom"), false);
-   if(!filename.exists())
+   if(!ossimSupportFilesList::instance()->exists(filename))
    {
       // Try "foo_e0.tif" if image is "foo.tif" where "e0" is entry index.
       filename = getFilenameWithThisExtension(ossimString(".geom"), true);
    }
-   if(!filename.exists())
+   if(!ossimSupportFilesList::instance()->exists(filename))
    {
       // Try supplementary data directory for remote geometry:
       filename = getFilenameWithThisExtension(ossimString(".geom"), false);
       filename = theSupplementaryDirectory.dirCat(filename.file());
    }
-   if(!filename.exists())
+   if(!ossimSupportFilesList::instance()->exists(filename))
    {
       // Try supplementary data directory for remote geometry with entry index:
       filename = getFilenameWithThisExtension(ossimString(".geom"), true);
       filename = theSupplementaryDirectory.dirCat(filename.file());
    }
 
-   if(filename.exists())
+   if(ossimSupportFilesList::instance()->exists(filename))
    {
       // Open the geom file as a KWL and initialize our geometry object:
       filename = filename.expand();
@@ -799,6 +802,25 @@ bool ossimImageHandler::hasOverviews() const
    return (getNumberOfDecimationLevels() > 1);
 }
 
+bool ossimImageHandler::hasConcurrentReads() const
+{
+   return false;
+}
+
+void ossimImageHandler::prefetch(const std::vector<ossimIrect>& rects,
+                                 ossim_uint32 resLevel)
+{
+   if ( theOverview.valid() && theOverview->isValidRLevel(resLevel) )
+   {
+      theOverview->prefetch(rects, resLevel);
+   }
+}
+
+bool ossimImageHandler::getIoCounters(ossimIoCounters::Values& values) const
+{
+   return theOverview.valid() && theOverview->getIoCounters(values);
+}
+
 bool ossimImageHandler::openOverview(const ossimFilename& overview_file)
 {
    bool result = false;
@@ -877,16 +899,16 @@ bool ossimImageHandler::openOverview()
    // 1) ESH 03/2009 -- Use the overview file set e.g. using a .spec file.
    ossimFilename overviewFilename = getOverviewFile();
    
-   if (overviewFilename.empty() || (overviewFilename.exists() == false) )
+   if (overviewFilename.empty() || !ossimSupportFilesList::instance()->exists(overviewFilename) )
    {
       // 2) Generate the name from image name.
       overviewFilename = createDefaultOverviewFilename();
       
-      if (overviewFilename.empty() || (overviewFilename.exists() == false) )
+      if (overviewFilename.empty() || !ossimSupportFilesList::instance()->exists(overviewFilename) )
       {  
          // 3) For backward compatibility check if single entry and _e0.ovr
          overviewFilename = getFilenameWithThisExtension(ossimString(".ovr"), true);
-         if (overviewFilename.empty() || (overviewFilename.exists() == false) )
+         if (overviewFilename.empty() || !ossimSupportFilesList::instance()->exists(overviewFilename) )
          {
             // 4) For overviews built with gdal look for foo.tif.ovr
             overviewFilename = getFilename();
@@ -904,7 +926,7 @@ bool ossimImageHandler::openOverview()
 
    bool status = false;
    
-   if ( overviewFilename.exists() )
+   if ( ossimSupportFilesList::instance()->exists(overviewFilename) )
    {
       status = openOverview( overviewFilename );
    }
@@ -957,6 +979,7 @@ bool ossimImageHandler::writeValidImageVertices(const std::vector<ossimIpt>& ver
       }
       
       tempKwl.write(tempFile.c_str());
+      ossimSupportFilesList::instance()->refresh(tempFile);
    }
 
    if ( tempFile.exists() )
@@ -1198,11 +1221,11 @@ void ossimImageHandler::loadMetaData()
   theMetaData.clear();
 
   ossimFilename filename = getFilenameWithThisExtension(ossimString(".omd"), false);
-  if ( filename.exists() == false )
+  if ( ossimSupportFilesList::instance()->exists(filename) == false )
   {
      filename = getFilenameWithThisExtension(ossimString(".omd"), true);
   }
-  if(filename.exists())
+  if(ossimSupportFilesList::instance()->exists(filename))
   {
      ossimKeywordlist kwl;
      
@@ -1684,5 +1707,8 @@ void ossimImageHandler::initImageParameters(ossimImageGeometry* geom) const
          ossimIrect rect = getBoundingRect();
          geom->setImageSize(ossimIpt(rect.width(), rect.height()));
       } 
+
+      // Swap expensive rigorous models for a coarse grid if so configured.
+      geom->applyCoarseGridApproximation();
    }
 }
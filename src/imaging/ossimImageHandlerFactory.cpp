@@ -8,6 +8,7 @@
 // $Id: ossimImageHandlerFactory.cpp 23464 2015-08-07 18:39:47Z okramer $
 
 #include <ossim/imaging/ossimImageHandlerFactory.h>
+#include <ossim/base/ossimHttpRangeStream.h>
 #include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimRegExp.h>
 #include <ossim/base/ossimTrace.h>
@@ -43,8 +44,58 @@
 #include <ossim/point_cloud/ossimPointCloudImageHandler.h>
 #endif
 
+#include <cstring>
+#include <fstream>
+
 static const ossimTrace traceDebug("ossimImageHandlerFactory:debug");
 
+namespace
+{
+   /** File signatures that select readers without trying the others. */
+   enum Signature
+   {
+      SIGNATURE_NONE = 0,
+      SIGNATURE_TIFF = 1,
+      SIGNATURE_JPEG = 2,
+      SIGNATURE_NITF = 3
+   };
+
+   Signature getSignature(const char* header, ossim_uint32 size)
+   {
+      if ( header && (size >= 4) )
+      {
+         const unsigned char* h = reinterpret_cast<const unsigned char*>(header);
+         if ( ( (h[0] == 'I') && (h[1] == 'I') && ((h[2] == 42) || (h[2] == 43)) && (h[3] == 0) ) ||
+              ( (h[0] == 'M') && (h[1] == 'M') && (h[2] == 0) && ((h[3] == 42) || (h[3] == 43)) ) )
+         {
+            return SIGNATURE_TIFF; // Classic or BigTIFF.
+         }
+         if ( (h[0] == 0xFF) && (h[1] == 0xD8) && (h[2] == 0xFF) )
+         {
+            return SIGNATURE_JPEG;
+         }
+         if ( (std::memcmp(h, "NITF", 4) == 0) || (std::memcmp(h, "NSIF", 4) == 0) )
+         {
+            return SIGNATURE_NITF;
+         }
+      }
+      return SIGNATURE_NONE;
+   }
+
+   Signature readSignature(const ossimFilename& file)
+   {
+      char header[4];
+      std::streamsize size = 0;
+      if ( file.isFile() )
+      {
+         std::ifstream in(file.c_str(), std::ios::in|std::ios::binary);
+         in.read(header, sizeof(header));
+         size = in.gcount();
+      }
+      return getSignature(header, (ossim_uint32)size);
+   }
+}
+
 RTTI_DEF1(ossimImageHandlerFactory, "ossimImageHandlerFactory", ossimImageHandlerFactoryBase);
 
 ossimImageHandlerFactory* ossimImageHandlerFactory::theInstance = 0;
@@ -90,13 +141,39 @@ ossimImageHandler* ossimImageHandlerFactory::open(const ossimFilename& fileName,
 
       // for all of our imagehandlers the filename must exist.
       // if we have any imagehandlers that require an encoded string and is contrlled in this factory then
-      // we need to move this.
-      if (!copyFilename.exists())  break;
+      // we need to move this.  Urls are left to handlers that read through the stream registry.
+      if (!copyFilename.exists() && !ossimHttpRangeStreamFactory::isUrl(copyFilename))  break;
 
       ossimString ext = copyFilename.ext().downcase();
       if(ext == "gz")
          copyFilename = copyFilename.setExtension("");
 
+      //---
+      // TIFF and JPEG files go straight to their readers rather than through
+      // the NITF and RPF readers tried first below.
+      //---
+      const Signature SIGNATURE = readSignature(copyFilename);
+      if (SIGNATURE == SIGNATURE_TIFF)
+      {
+         // Quickbird TIFF must be checked before the TIFF handler.
+         if (traceDebug()) ossimNotify(ossimNotifyLevel_DEBUG)<<M<< "Trying Quickbird TIFF...\n";
+         result = new ossimQuickbirdTiffTileSource;
+         result->setOpenOverviewFlag(openOverview);
+         if (result->open(copyFilename))  break;
+
+         if (traceDebug()) ossimNotify(ossimNotifyLevel_DEBUG)<<M<< "Trying TIFF...\n";
+         result = new ossimTiffTileSource;
+         result->setOpenOverviewFlag(openOverview);
+         if (result->open(copyFilename))  break;
+      }
+      else if (SIGNATURE == SIGNATURE_JPEG)
+      {
+         if (traceDebug()) ossimNotify(ossimNotifyLevel_DEBUG)<<M<< "Trying JPEG...\n";
+         result = new ossimJpegTileSource;
+         result->setOpenOverviewFlag(openOverview);
+         if (result->open(copyFilename)) break;
+      }
+
       // Try opening from extension logic first (this is faster than instantiating each type).
 //      if (traceDebug()) ossimNotify(ossimNotifyLevel_DEBUG)<<M<< "Trying via extension...";
 //      result = openFromExtension(copyFilename);
@@ -132,21 +209,27 @@ ossimImageHandler* ossimImageHandlerFactory::open(const ossimFilename& fileName,
       result->setOpenOverviewFlag(openOverview);
       if (result->open(copyFilename)) break;
 
-      if (traceDebug()) ossimNotify(ossimNotifyLevel_DEBUG)<<M<< "Trying JPEG...\n";
-      result = new ossimJpegTileSource;
-      result->setOpenOverviewFlag(openOverview);      
-      if (result->open(copyFilename)) break;
+      if (SIGNATURE != SIGNATURE_JPEG) // else tried above
+      {
+         if (traceDebug()) ossimNotify(ossimNotifyLevel_DEBUG)<<M<< "Trying JPEG...\n";
+         result = new ossimJpegTileSource;
+         result->setOpenOverviewFlag(openOverview);      
+         if (result->open(copyFilename)) break;
+      }
 
-      // this must be checked first before the TIFF handler
-      if (traceDebug()) ossimNotify(ossimNotifyLevel_DEBUG)<<M<< "Trying Quickbird TIFF...\n";
-      result = new ossimQuickbirdTiffTileSource;
-      result->setOpenOverviewFlag(openOverview);      
-      if (result->open(copyFilename)) break;
+      if (SIGNATURE != SIGNATURE_TIFF) // else tried above
+      {
+         // this must be checked first before the TIFF handler
+         if (traceDebug()) ossimNotify(ossimNotifyLevel_DEBUG)<<M<< "Trying Quickbird TIFF...\n";
+         result = new ossimQuickbirdTiffTileSource;
+         result->setOpenOverviewFlag(openOverview);      
+         if (result->open(copyFilename)) break;
 
-      if (traceDebug()) ossimNotify(ossimNotifyLevel_DEBUG)<<M<< "Trying TIFF...\n";
-      result = new ossimTiffTileSource;
-      result->setOpenOverviewFlag(openOverview);      
-      if (result->open(copyFilename))  break;
+         if (traceDebug()) ossimNotify(ossimNotifyLevel_DEBUG)<<M<< "Trying TIFF...\n";
+         result = new ossimTiffTileSource;
+         result->setOpenOverviewFlag(openOverview);      
+         if (result->open(copyFilename))  break;
+      }
 
       if (traceDebug()) ossimNotify(ossimNotifyLevel_DEBUG)<<M<< "Trying CIB/CADRG...\n";
       result = new ossimCibCadrgTileSource;
@@ -649,6 +732,18 @@ ossimObject* ossimImageHandlerFactory::createObject(const ossimString& typeName)
    return (ossimObject*)0;
 }
 
+ossimImageHandlerFactoryBase::OpenScore ossimImageHandlerFactory::getOpenScore(
+   const ossimFilename& file, const char* header, ossim_uint32 headerSize) const
+{
+   if ( getSignature(header, headerSize) != SIGNATURE_NONE )
+   {
+      return OPEN_SCORE_MAGIC;
+   }
+
+   // Raw formats (general raster, ENVI, SRTM, ...) have no signature:
+   return ossimImageHandlerFactoryBase::getOpenScore(file, header, headerSize);
+}
+
 void ossimImageHandlerFactory::getSupportedExtensions(ossimImageHandlerFactoryBase::UniqueStringList& extensionList)const
 {
    extensionList.push_back("img");
@@ -7,9 +7,37 @@
 //*******************************************************************
 //  $Id: ossimImageHandlerFactoryBase.cpp 22632 2014-02-20 00:53:14Z dburken $
 #include <ossim/imaging/ossimImageHandlerFactoryBase.h>
+#include <ossim/base/ossimFilename.h>
 
 RTTI_DEF1(ossimImageHandlerFactoryBase, "ossimImageHandlerFactoryBase", ossimObjectFactory);
 
+const ossim_uint32 ossimImageHandlerFactoryBase::OPEN_SCORE_HEADER_SIZE;
+
+ossimImageHandlerFactoryBase::OpenScore ossimImageHandlerFactoryBase::getOpenScore(
+   const ossimFilename& file,
+   const char* /* header */,
+   ossim_uint32 /* headerSize */ ) const
+{
+   ossimString ext = file.ext().downcase();
+   if ( ext == "gz" )
+   {
+      ext = file.noExtension().ext().downcase();
+   }
+   if ( ext.size() )
+   {
+      UniqueStringList extensions;
+      getSupportedExtensions(extensions);
+      for (ossim_uint32 i = 0; i < extensions.size(); ++i)
+      {
+         if ( extensions[i].downcase() == ext )
+         {
+            return OPEN_SCORE_EXTENSION;
+         }
+      }
+   }
+   return OPEN_SCORE_UNKNOWN;
+}
+
 void ossimImageHandlerFactoryBase::getImageHandlersBySuffix(ImageHandlerList& /*result*/,
                                                             const ossimString& /*ext*/)const
 {
@@ -0,0 +1,316 @@
+//*******************************************************************
+//
+// License:  LGPL
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description: Pool of image handlers reused across chains.
+//
+//********************************************************************
+
+#include <ossim/imaging/ossimImageHandlerPool.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTrace.h>
+#include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimImageHandlerRegistry.h>
+#include <OpenThreads/ScopedLock>
+
+static ossimTrace traceDebug("ossimImageHandlerPool:debug");
+
+ossimImageHandlerPool* ossimImageHandlerPool::instance()
+{
+   static ossimImageHandlerPool theInstance;
+   return &theInstance;
+}
+
+ossimImageHandlerPool::ossimImageHandlerPool()
+   : m_mutex(),
+     m_maxOpenHandlers(0),
+     m_clock(0),
+     m_slots()
+{
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("image_handler_pool.max_open_handlers");
+   if ( lookup )
+   {
+      m_maxOpenHandlers = ossimString(lookup).toUInt32();
+   }
+}
+
+bool ossimImageHandlerPool::isEnabled() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   return m_maxOpenHandlers != 0;
+}
+
+ossimRefPtr<ossimImageHandler> ossimImageHandlerPool::acquire(const ossimFilename& file,
+                                                              ossim_uint32 entry,
+                                                              bool openOverview,
+                                                              Mode mode)
+{
+   ossimRefPtr<ossimImageHandler> result = 0;
+   const ossimFilename PATH = file.expand();
+
+   if ( isEnabled() )
+   {
+      Slot* slot = 0;
+      bool idle = false;
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+
+         // An open handler before a closed one; any free one for EXCLUSIVE.
+         for ( std::list<Slot>::iterator i = m_slots.begin(); i != m_slots.end(); ++i )
+         {
+            if ( (i->m_entry != entry) || (i->m_openOverview != openOverview) ||
+                 (i->m_file != PATH) )
+            {
+               continue;
+            }
+            const bool IDLE = isIdle(*i);
+            if ( !IDLE && ( i->m_exclusive || (mode == EXCLUSIVE) ) )
+            {
+               continue;
+            }
+            if ( !slot || ( i->m_open && !slot->m_open ) )
+            {
+               slot = &(*i);
+               idle = IDLE;
+            }
+         }
+
+         if ( slot )
+         {
+            result = slot->m_handler;
+            slot->m_lastUsed = ++m_clock;
+
+            // Held exclusive while it is opened again outside the lock:
+            slot->m_exclusive = (mode == EXCLUSIVE) || !slot->m_open;
+            if ( slot->m_open )
+            {
+               if ( idle )
+               {
+                  restore(*slot);
+               }
+               trim();
+               return result;
+            }
+         }
+      }
+
+      if ( slot )
+      {
+         const bool OPENED = result->open();
+         if ( OPENED )
+         {
+            restore(*slot);
+         }
+
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if ( OPENED )
+         {
+            slot->m_open      = true;
+            slot->m_exclusive = (mode == EXCLUSIVE);
+            trim();
+
+            if (traceDebug())
+            {
+               ossimNotify(ossimNotifyLevel_DEBUG)
+                  << "ossimImageHandlerPool::acquire: opened again " << PATH
+                  << " entry " << entry << std::endl;
+            }
+            return result;
+         }
+
+         // File is gone or changed; forget it.
+         result = 0;
+         for ( std::list<Slot>::iterator i = m_slots.begin(); i != m_slots.end(); ++i )
+         {
+            if ( &(*i) == slot )
+            {
+               m_slots.erase(i);
+               break;
+            }
+         }
+         return result;
+      }
+   }
+
+   result = ossimImageHandlerRegistry::instance()->open(PATH, true, openOverview);
+   if ( result.valid() && entry && !result->setCurrentEntry(entry) )
+   {
+      result = 0;
+   }
+   if ( !result.valid() || !isEnabled() )
+   {
+      return result;
+   }
+
+   Slot newSlot;
+   newSlot.m_file         = PATH;
+   newSlot.m_entry        = entry;
+   newSlot.m_openOverview = openOverview;
+   newSlot.m_handler      = result;
+   newSlot.m_open         = true;
+   newSlot.m_exclusive    = (mode == EXCLUSIVE);
+   if ( result->isBandSelector() )
+   {
+      result->getOutputBandList(newSlot.m_bands);
+   }
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   newSlot.m_lastUsed = ++m_clock;
+   m_slots.push_back(newSlot);
+   trim();
+   return result;
+}
+
+void ossimImageHandlerPool::setMaxOpenHandlers(ossim_uint32 count)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   m_maxOpenHandlers = count;
+   if ( m_maxOpenHandlers )
+   {
+      trim();
+   }
+   else
+   {
+      removeIdle(ossimFilename());
+   }
+}
+
+ossim_uint32 ossimImageHandlerPool::getMaxOpenHandlers() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   return m_maxOpenHandlers;
+}
+
+ossim_uint32 ossimImageHandlerPool::getNumberOfOpenHandlers() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   ossim_uint32 count = 0;
+   for ( std::list<Slot>::const_iterator i = m_slots.begin(); i != m_slots.end(); ++i )
+   {
+      if ( i->m_open )
+      {
+         ++count;
+      }
+   }
+   return count;
+}
+
+void ossimImageHandlerPool::remove(const ossimFilename& file)
+{
+   if ( file.size() )
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      removeIdle(file.expand());
+   }
+}
+
+void ossimImageHandlerPool::clear()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   removeIdle(ossimFilename());
+}
+
+bool ossimImageHandlerPool::isIdle(const Slot& slot)
+{
+   return slot.m_handler->referenceCount() == 1;
+}
+
+void ossimImageHandlerPool::restore(Slot& slot)
+{
+   ossimImageHandler* handler = slot.m_handler.get();
+   if ( handler->getCurrentEntry() != slot.m_entry )
+   {
+      handler->setCurrentEntry(slot.m_entry);
+   }
+   if ( slot.m_bands.size() && handler->isBandSelector() )
+   {
+      handler->setOutputBandList(slot.m_bands);
+   }
+}
+
+void ossimImageHandlerPool::trim()
+{
+   ossim_uint32 openCount = 0;
+   ossim_uint32 closedCount = 0;
+   for ( std::list<Slot>::const_iterator i = m_slots.begin(); i != m_slots.end(); ++i )
+   {
+      if ( i->m_open )
+      {
+         ++openCount;
+      }
+      else if ( isIdle(*i) )
+      {
+         ++closedCount;
+      }
+   }
+
+   // Close the least recently used idle handlers past the cap...
+   while ( openCount > m_maxOpenHandlers )
+   {
+      std::list<Slot>::iterator lru = m_slots.end();
+      for ( std::list<Slot>::iterator i = m_slots.begin(); i != m_slots.end(); ++i )
+      {
+         if ( i->m_open && isIdle(*i) &&
+              ( (lru == m_slots.end()) || (i->m_lastUsed < lru->m_lastUsed) ) )
+         {
+            lru = i;
+         }
+      }
+      if ( lru == m_slots.end() )
+      {
+         break; // All in use.
+      }
+
+      if (traceDebug())
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << "ossimImageHandlerPool::trim: closing " << lru->m_file
+            << " entry " << lru->m_entry << std::endl;
+      }
+      lru->m_handler->close();
+      lru->m_open = false;
+      --openCount;
+      ++closedCount;
+   }
+
+   // ...and keep at most as many closed ones to open again.
+   while ( closedCount > m_maxOpenHandlers )
+   {
+      std::list<Slot>::iterator lru = m_slots.end();
+      for ( std::list<Slot>::iterator i = m_slots.begin(); i != m_slots.end(); ++i )
+      {
+         if ( !i->m_open && isIdle(*i) &&
+              ( (lru == m_slots.end()) || (i->m_lastUsed < lru->m_lastUsed) ) )
+         {
+            lru = i;
+         }
+      }
+      if ( lru == m_slots.end() )
+      {
+         break;
+      }
+      m_slots.erase(lru);
+      --closedCount;
+   }
+}
+
+void ossimImageHandlerPool::removeIdle(const ossimFilename& file)
+{
+   std::list<Slot>::iterator i = m_slots.begin();
+   while ( i != m_slots.end() )
+   {
+      if ( isIdle(*i) && ( file.empty() || (i->m_file == file) ) )
+      {
+         i = m_slots.erase(i);
+      }
+      else
+      {
+         ++i;
+      }
+   }
+}
@@ -13,12 +13,18 @@
 
 #include <ossim/imaging/ossimImageHandlerRegistry.h>
 #include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimFileStatCache.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimObjectFactoryRegistry.h>
 #include <ossim/base/ossimString.h>
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/imaging/ossimImageHandlerFactory.h>
 #include <ossim/imaging/ossimImageHandlerFactoryBase.h>
+#include <ossim/plugin/ossimSharedPluginRegistry.h>
 #include <algorithm>
+#include <fstream>
+#include <utility>
 
 RTTI_DEF1(ossimImageHandlerRegistry, "ossimImageHandlerRegistry", ossimObjectFactory);
 
@@ -78,6 +84,8 @@ ossimRefPtr<ossimImageHandler> ossimImageHandlerRegistry::openBySuffix(const oss
 void ossimImageHandlerRegistry::getImageHandlersBySuffix(ossimImageHandlerFactoryBase::ImageHandlerList& result,
                                                          const ossimString& ext)const
 {
+   ossimSharedPluginRegistry::instance()->loadDeferredPlugins(
+      ossimSharedPluginRegistry::MANIFEST_EXTENSIONS_KW, ext);
    vector<ossimImageHandlerFactoryBase*>::const_iterator iter = m_factoryList.begin();
    ossimImageHandlerFactoryBase::ImageHandlerList temp;
    while(iter != m_factoryList.end())
@@ -121,6 +129,7 @@ void ossimImageHandlerRegistry::getImageHandlersByMimeType(
 
 void ossimImageHandlerRegistry::getTypeNameList( std::vector<ossimString>& typeList ) const
 {
+   ossimSharedPluginRegistry::instance()->loadAllDeferredPlugins();
    getAllTypeNamesFromRegistry(typeList);
 }
 
@@ -128,6 +137,7 @@ void ossimImageHandlerRegistry::getSupportedExtensions(
    ossimImageHandlerFactoryBase::UniqueStringList& extensionList)const
 {
    vector<ossimString> result;
+   ossimSharedPluginRegistry::instance()->loadAllDeferredPlugins();
    vector<ossimImageHandlerFactoryBase*>::const_iterator iter = m_factoryList.begin();
 
    while(iter != m_factoryList.end())
@@ -143,6 +153,14 @@ ossimImageHandler* ossimImageHandlerRegistry::open(const ossimFilename& fileName
                                                    bool trySuffixFirst,
                                                    bool openOverview)const
 {
+   // Handlers probe many support files; stat each path and directory once.
+   ossimFileStatCache statCache;
+
+   // Plugins deferred to first demand that read this extension:
+   ossimSharedPluginRegistry* plugins = ossimSharedPluginRegistry::instance();
+   plugins->loadDeferredPlugins(ossimSharedPluginRegistry::MANIFEST_EXTENSIONS_KW,
+                                fileName.ext());
+
    if(trySuffixFirst)
    {
       ossimRefPtr<ossimImageHandler> h = openBySuffix(fileName, openOverview);
@@ -152,26 +170,71 @@ ossimImageHandler* ossimImageHandlerRegistry::open(const ossimFilename& fileName
       }
    }
    
-   // now try magic number opens
-   //
-   ossimImageHandler*                   result = NULL;
-   vector<ossimImageHandlerFactoryBase*>::const_iterator factory;
+   //---
+   // Now try magic number opens.  The header is read once and each factory
+   // scores it without opening anything; factories are then tried from the
+   // best score down, in registration order among equals, skipping those
+   // that cannot open the file.
+   //---
+   std::vector<char> header(ossimImageHandlerFactoryBase::OPEN_SCORE_HEADER_SIZE);
+   ossim_uint32 headerSize = 0;
+   if ( fileName.isFile() )
+   {
+      std::ifstream in(fileName.c_str(), std::ios::in|std::ios::binary);
+      in.read(&header.front(), (std::streamsize)header.size());
+      headerSize = (ossim_uint32)in.gcount();
+   }
 
-   factory = m_factoryList.begin();
-   while((factory != m_factoryList.end()) && !result)
+   // Negated score and factory index, so sorted best first:
+   std::vector< std::pair<int, ossim_uint32> > candidates;
+   for(ossim_uint32 idx = 0; idx < (ossim_uint32)m_factoryList.size(); ++idx)
    {
-      result = (*factory)->open(fileName, openOverview);
-      ++factory;
+      const ossimImageHandlerFactoryBase::OpenScore SCORE =
+         m_factoryList[idx]->getOpenScore(fileName,
+                                          headerSize ? &header.front() : 0,
+                                          headerSize);
+      if ( SCORE != ossimImageHandlerFactoryBase::OPEN_SCORE_NONE )
+      {
+         candidates.push_back(std::make_pair(-(int)SCORE, idx));
+      }
+   }
+   std::sort(candidates.begin(), candidates.end());
+
+   ossimImageHandler* result = NULL;
+   for(ossim_uint32 idx = 0; (idx < candidates.size()) && !result; ++idx)
+   {
+      result = m_factoryList[candidates[idx].second]->open(fileName, openOverview);
+   }
+
+   // A deferred plugin may read files its manifest does not list, e.g. directories:
+   if ( !result && plugins->loadAllDeferredPlugins() )
+   {
+      result = open(fileName, trySuffixFirst, openOverview);
    }
    
    return result;
 }
 
+ossimRefPtr<ossimImageHandler> ossimImageHandlerRegistry::openPooled(
+   const ossimFilename& fileName,
+   ossim_uint32 entry,
+   bool openOverview,
+   ossimImageHandlerPool::Mode mode)const
+{
+   return ossimImageHandlerPool::instance()->acquire(fileName, entry, openOverview, mode);
+}
+
 ossimImageHandler* ossimImageHandlerRegistry::open(const ossimKeywordlist& kwl,
                                                    const char* prefix)const
 {
    ossimImageHandler*                   result = NULL;
    vector<ossimImageHandlerFactoryBase*>::const_iterator factory;
+
+   ossimSharedPluginRegistry* plugins = ossimSharedPluginRegistry::instance();
+   plugins->loadDeferredPlugins(ossimSharedPluginRegistry::MANIFEST_EXTENSIONS_KW,
+      ossimFilename(kwl.find(prefix, ossimKeywordNames::FILENAME_KW)).ext());
+   plugins->loadDeferredPlugins(ossimSharedPluginRegistry::MANIFEST_CLASSES_KW,
+      ossimString(kwl.find(prefix, ossimKeywordNames::TYPE_KW)));
    
    factory = m_factoryList.begin();
    while((factory != m_factoryList.end()) && !result)
@@ -204,7 +267,10 @@ ossimRefPtr<ossimImageHandler> ossimImageHandlerRegistry::open( std::istream* st
 ossimRefPtr<ossimImageHandler> ossimImageHandlerRegistry::openOverview(
    const ossimFilename& file ) const
 {
+   ossimFileStatCache statCache;
    ossimRefPtr<ossimImageHandler> result = 0;
+   ossimSharedPluginRegistry::instance()->loadDeferredPlugins(
+      ossimSharedPluginRegistry::MANIFEST_EXTENSIONS_KW, file.ext());
    vector<ossimImageHandlerFactoryBase*>::const_iterator factory = m_factoryList.begin();
    while( factory != m_factoryList.end() )
    {
@@ -220,6 +286,8 @@ ossimRefPtr<ossimImageHandler> ossimImageHandlerRegistry::openOverview(
 
 ossimObject* ossimImageHandlerRegistry::createObject(const ossimString& typeName) const
 {
+   ossimSharedPluginRegistry::instance()->loadDeferredPlugins(
+      ossimSharedPluginRegistry::MANIFEST_CLASSES_KW, typeName);
    return createObjectFromRegistry(typeName);
 }
 
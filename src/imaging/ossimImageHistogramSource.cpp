@@ -11,12 +11,241 @@
 #include <ossim/base/ossimMultiResLevelHistogram.h>
 #include <ossim/base/ossimMultiBandHistogram.h>
 #include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/imaging/ossimImageSourceSequencer.h>
+#include <ossim/base/ossimHistogram.h>
 #include <ossim/base/ossimNotify.h>
 #include <ossim/base/ossimTrace.h>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 
 static ossimTrace traceDebug("ossimImageHistogramSource:debug");
 
+namespace
+{
+   //---
+   // Block histogram file: header, totals (bands x bins uint64), index
+   // (blocks x bands of uint64 offset, uint32 entries), then the records,
+   // each that many (uint32 bin, uint32 count) pairs of nonzero bins.
+   // Updates append the new records of the blocks recounted, so the file
+   // grows until the next full count rewrites it.  The complete flag is
+   // cleared while the totals and index are out of date.
+   //---
+   const char         BLOCK_MAGIC[] = "OSSIMHBK";
+   const ossim_uint32 BLOCK_VERSION = 1;
+   const ossim_uint32 BYTE_ORDER_MARK = 0x01020304;
+   const ossim_int64  BLOCK_TILES = 8;
+   const std::streamoff BLOCK_HEADER_SIZE = 72;
+   const std::streamoff BLOCK_COMPLETE_OFFSET = 16;
+   const std::streamoff BLOCK_INDEX_ENTRY_SIZE = 12;
+
+   template <class T> void writeValue(std::ostream& out, const T& value)
+   {
+      out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+   }
+
+   template <class T> bool readValue(std::istream& in, T& value)
+   {
+      in.read(reinterpret_cast<char*>(&value), sizeof(T));
+      return in.good();
+   }
+
+   /** Identity of a block histogram file; records match only the same. */
+   struct ossimHistogramBlockHeader
+   {
+      ossim_int32   theAoi[4];
+      ossim_int32   theTileSize[2];
+      ossim_uint32  theBands;
+      ossim_uint32  theBins;
+      ossim_float64 theMinValue;
+      ossim_float64 theMaxValue;
+
+      void write(std::ostream& out, ossim_uint32 complete) const
+      {
+         out.write(BLOCK_MAGIC, 8);
+         writeValue(out, BYTE_ORDER_MARK);
+         writeValue(out, BLOCK_VERSION);
+         writeValue(out, complete);
+         writeValue(out, (ossim_uint32)BLOCK_TILES);
+         for (int i = 0; i < 4; ++i) writeValue(out, theAoi[i]);
+         for (int i = 0; i < 2; ++i) writeValue(out, theTileSize[i]);
+         writeValue(out, theBands);
+         writeValue(out, theBins);
+         writeValue(out, theMinValue);
+         writeValue(out, theMaxValue);
+      }
+
+      /** @return true if in is a complete file of this header. */
+      bool matches(std::istream& in) const
+      {
+         char magic[8];
+         ossim_uint32 mark = 0, version = 0, complete = 0, blockTiles = 0, bands = 0, bins = 0;
+         ossim_int32 aoi[4], tileSize[2];
+         ossim_float64 minValue = 0, maxValue = 0;
+         in.read(magic, 8);
+         bool result = in.good() && (memcmp(magic, BLOCK_MAGIC, 8) == 0) &&
+            readValue(in, mark) && (mark == BYTE_ORDER_MARK) &&
+            readValue(in, version) && (version == BLOCK_VERSION) &&
+            readValue(in, complete) && (complete == 1) &&
+            readValue(in, blockTiles) && (blockTiles == (ossim_uint32)BLOCK_TILES);
+         for (int i = 0; result && (i < 4); ++i)
+            result = readValue(in, aoi[i]) && (aoi[i] == theAoi[i]);
+         for (int i = 0; result && (i < 2); ++i)
+            result = readValue(in, tileSize[i]) && (tileSize[i] == theTileSize[i]);
+         return result &&
+            readValue(in, bands) && (bands == theBands) &&
+            readValue(in, bins) && (bins == theBins) &&
+            readValue(in, minValue) && (minValue == theMinValue) &&
+            readValue(in, maxValue) && (maxValue == theMaxValue);
+      }
+   };
+
+   /** Where the nonzero bins of one band of a block are. */
+   struct ossimHistogramBlockRecord
+   {
+      ossimHistogramBlockRecord() : theOffset(0), theEntries(0) {}
+      ossim_uint64 theOffset;
+      ossim_uint32 theEntries;
+   };
+
+   void writeIndex(std::ostream& out, const std::vector<ossimHistogramBlockRecord>& index)
+   {
+      for (size_t i = 0; i < index.size(); ++i)
+      {
+         writeValue(out, index[i].theOffset);
+         writeValue(out, index[i].theEntries);
+      }
+   }
+
+   bool readIndex(std::istream& in, std::vector<ossimHistogramBlockRecord>& index)
+   {
+      bool result = true;
+      for (size_t i = 0; result && (i < index.size()); ++i)
+      {
+         result = readValue(in, index[i].theOffset) && readValue(in, index[i].theEntries);
+      }
+      return result;
+   }
+
+   /** Subtracts from totals the counts of record; false if unreadable or not in totals. */
+   bool subtractRecord(std::istream& in,
+                       const ossimHistogramBlockRecord& record,
+                       ossim_uint64* totals,
+                       ossim_uint32 numberOfBins)
+   {
+      if ( !record.theEntries )
+      {
+         return true;
+      }
+      std::vector<ossim_uint32> pairs(2*record.theEntries);
+      in.seekg(record.theOffset);
+      in.read(reinterpret_cast<char*>(&pairs.front()), pairs.size()*sizeof(ossim_uint32));
+      if ( !in.good() )
+      {
+         return false;
+      }
+      for (size_t i = 0; i < pairs.size(); i += 2)
+      {
+         if ( (pairs[i] >= numberOfBins) || (totals[pairs[i]] < pairs[i+1]) )
+         {
+            return false;
+         }
+         totals[pairs[i]] -= pairs[i+1];
+      }
+      return true;
+   }
+
+   /** Hands the tiles of a sequencer's area of interest to the counting threads. */
+   class ossimHistogramTileList
+   {
+   public:
+      ossimHistogramTileList(ossimProcessInterface* process,
+                             ossimImageSourceSequencer* sequencer,
+                             const std::vector<ossim_int64>* tileIds,
+                             double& tileCount,
+                             double totalTiles)
+         : theProcess(process),
+           theSequencer(sequencer),
+           theTileIds(tileIds),
+           theNextTile(0),
+           theNumberOfTiles(tileIds ? (ossim_int64)tileIds->size()
+                                    : sequencer->getNumberOfTiles()),
+           theTileCount(tileCount),
+           theTotalTiles(totalTiles)
+      {}
+
+      /** @return false once all tiles are handed out or on abort. */
+      bool next(ossimIrect& rect)
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+         if ( (theNextTile >= theNumberOfTiles) || theProcess->needsAborting() )
+         {
+            return false;
+         }
+         ossim_int64 id = theTileIds ? (*theTileIds)[theNextTile] : theNextTile;
+         ++theNextTile;
+         theSequencer->getTileRect(id, rect);
+         ++theTileCount;
+         theProcess->setPercentComplete(100.0*(theTileCount/theTotalTiles));
+         return true;
+      }
+
+   private:
+      ossimProcessInterface*     theProcess;
+      ossimImageSourceSequencer* theSequencer;
+      const std::vector<ossim_int64>* theTileIds;
+      OpenThreads::Mutex         theMutex;
+      ossim_int64                theNextTile;
+      ossim_int64                theNumberOfTiles;
+      double&                    theTileCount;
+      double                     theTotalTiles;
+   };
+
+   /** Reads tiles of the list into its own tile and counts them into its own histogram. */
+   class ossimHistogramTileThread : public OpenThreads::Thread
+   {
+   public:
+      ossimHistogramTileThread(ossimHistogramTileList& tiles,
+                               ossimImageHandler* handler,
+                               ossim_uint32 resLevel,
+                               ossimImageData* tile,
+                               ossimMultiBandHistogram* histogram)
+         : OpenThreads::Thread(),
+           theTiles(tiles),
+           theHandler(handler),
+           theResLevel(resLevel),
+           theTile(tile),
+           theHistogram(histogram)
+      {}
+
+      virtual void run()
+      {
+         ossimIrect rect;
+         while ( theTiles.next(rect) )
+         {
+            theTile->setImageRectangle(rect);
+            if ( theHandler->getTile(theTile.get(), theResLevel) &&
+                 (theTile->getDataObjectStatus() != OSSIM_EMPTY) )
+            {
+               theTile->populateHistogram(theHistogram);
+            }
+         }
+      }
+
+   private:
+      ossimHistogramTileList&              theTiles;
+      ossimImageHandler*                   theHandler;
+      ossim_uint32                         theResLevel;
+      ossimRefPtr<ossimImageData>          theTile;
+      ossimRefPtr<ossimMultiBandHistogram> theHistogram;
+   };
+}
+
   RTTI_DEF3(ossimImageHistogramSource, "ossimImageHistogramSource", ossimHistogramSource, ossimConnectableObjectListener, ossimProcessInterface);
 
 ossimImageHistogramSource::ossimImageHistogramSource(ossimObject* owner)
@@ -28,9 +257,12 @@ ossimImageHistogramSource::ossimImageHistogramSource(ossimObject* owner)
     theHistogramRecomputeFlag(true),
     theMaxNumberOfResLevels(1),
     theComputationMode(OSSIM_HISTO_MODE_NORMAL),
-    theNumberOfTilesToUseInFastMode(100)
+    theNumberOfTilesToUseInFastMode(100),
+    theNumberOfThreads(1),
+    theBlockHistogramFile()
 {
    theAreaOfInterest.makeNan();
+   theUpdateRect.makeNan();
    addListener((ossimConnectableObjectListener*)this);
 	
    theMinValueOverride     = ossim::nan();
@@ -176,6 +408,40 @@ void ossimImageHistogramSource::setComputationMode(ossimHistogramMode mode)
    theComputationMode = mode;
 }
 
+void ossimImageHistogramSource::setNumberOfThreads(ossim_uint32 threads)
+{
+   theNumberOfThreads = threads;
+}
+
+ossim_uint32 ossimImageHistogramSource::getNumberOfThreads()const
+{
+   return theNumberOfThreads;
+}
+
+void ossimImageHistogramSource::setBlockHistogramFile(const ossimFilename& file)
+{
+   theBlockHistogramFile = file;
+}
+
+const ossimFilename& ossimImageHistogramSource::getBlockHistogramFile()const
+{
+   return theBlockHistogramFile;
+}
+
+void ossimImageHistogramSource::setUpdateRect(const ossimIrect& rect)
+{
+   if ( !rect.hasNans() )
+   {
+      theHistogramRecomputeFlag = true;
+   }
+   theUpdateRect = rect;
+}
+
+const ossimIrect& ossimImageHistogramSource::getUpdateRect()const
+{
+   return theUpdateRect;
+}
+
 void ossimImageHistogramSource::propertyEvent(ossimPropertyEvent& /* event */)
 {
    theHistogramRecomputeFlag = true;
@@ -309,6 +575,15 @@ void ossimImageHistogramSource::computeNormalModeHistogram()
       ossimRefPtr<ossimImageSourceSequencer> sequencer = new ossimImageSourceSequencer;
       sequencer->connectMyInputTo(0, getInput(0));
       sequencer->initialize();
+
+      // Threads read through the handler itself, so it must allow concurrent reads:
+      ossimImageHandler* handler = PTR_CAST(ossimImageHandler, input);
+      ossim_uint32 numberOfThreads =
+         theNumberOfThreads ? theNumberOfThreads : ossim::getNumberOfThreads();
+      if ( !handler || !handler->hasConcurrentReads() )
+      {
+         numberOfThreads = 1;
+      }
       
       vector<ossimDpt> decimationFactors;
       input->getDecimationFactors(decimationFactors);
@@ -339,6 +614,9 @@ void ossimImageHistogramSource::computeNormalModeHistogram()
       
       if(numberOfBins > 0)
       {
+         const ossimIpt TILE_SIZE = sequencer->getTileSize();
+         setProgressWork("histogram", (ossim_uint64)totalTiles,
+                         (ossim_uint64)TILE_SIZE.x * TILE_SIZE.y);
          setPercentComplete(0.0);
          for(index = 0;
              (index < resLevelsToCompute);
@@ -359,6 +637,23 @@ void ossimImageHistogramSource::computeNormalModeHistogram()
                                                                numberOfBins,
                                                                minValue,
                                                                maxValue);
+            if ( (resLevelsToCompute == 1) && theBlockHistogramFile.size() )
+            {
+               computeBlockHistogram(handler, sequencer.get(), numberOfThreads,
+                                     numberOfBands, numberOfBins, minValue, maxValue);
+               continue;
+            }
+            if ( numberOfThreads > 1 )
+            {
+               computeTilesMt(handler, sequencer.get(), 0, index,
+                              theHistogram->getMultiBandHistogram(index).get(), numberOfThreads,
+                              numberOfBins, minValue, maxValue, tileCount, totalTiles);
+               if (needsAborting())
+               {
+                  setPercentComplete(100);
+               }
+               continue;
+            }
             
             ossimRefPtr<ossimImageData> data = sequencer->getNextTile(index);
             ++tileCount;
@@ -391,6 +686,288 @@ void ossimImageHistogramSource::computeNormalModeHistogram()
       sequencer->disconnect();
       sequencer = 0;
    }
+   theUpdateRect.makeNan();
+}
+
+void ossimImageHistogramSource::computeBlockHistogram(ossimImageHandler* handler,
+                                                      ossimImageSourceSequencer* sequencer,
+                                                      ossim_uint32 numberOfThreads,
+                                                      ossim_uint32 numberOfBands,
+                                                      ossim_uint32 numberOfBins,
+                                                      ossim_float64 minValue,
+                                                      ossim_float64 maxValue)
+{
+   const ossimIpt tileSize = sequencer->getTileSize();
+   ossimHistogramBlockHeader header;
+   header.theAoi[0]      = theAreaOfInterest.ul().x;
+   header.theAoi[1]      = theAreaOfInterest.ul().y;
+   header.theAoi[2]      = theAreaOfInterest.lr().x;
+   header.theAoi[3]      = theAreaOfInterest.lr().y;
+   header.theTileSize[0] = tileSize.x;
+   header.theTileSize[1] = tileSize.y;
+   header.theBands       = numberOfBands;
+   header.theBins        = numberOfBins;
+   header.theMinValue    = minValue;
+   header.theMaxValue    = maxValue;
+
+   const ossim_int64 tilesWide  = sequencer->getNumberOfTilesHorizontal();
+   const ossim_int64 tilesHigh  = sequencer->getNumberOfTilesVertical();
+   const ossim_int64 blocksWide = (tilesWide + BLOCK_TILES - 1) / BLOCK_TILES;
+   const ossim_int64 blocksHigh = (tilesHigh + BLOCK_TILES - 1) / BLOCK_TILES;
+   std::vector<ossim_uint64> totals((size_t)numberOfBands*numberOfBins, 0);
+   std::vector<ossimHistogramBlockRecord> index((size_t)(blocksWide*blocksHigh*numberOfBands));
+   const std::streamoff indexOffset = BLOCK_HEADER_SIZE + totals.size()*sizeof(ossim_uint64);
+
+   // Blocks to count, all unless updating:
+   std::vector<ossim_int64> blocks;
+   ossim_int64 numberOfTiles = 0;
+   for (ossim_int64 block = 0; block < blocksWide*blocksHigh; ++block)
+   {
+      const ossim_int64 x0 = (block % blocksWide)*BLOCK_TILES;
+      const ossim_int64 y0 = (block / blocksWide)*BLOCK_TILES;
+      const ossim_int64 x1 = ossim::min(x0 + BLOCK_TILES, tilesWide) - 1;
+      const ossim_int64 y1 = ossim::min(y0 + BLOCK_TILES, tilesHigh) - 1;
+      ossimIrect ulTile;
+      ossimIrect lrTile;
+      sequencer->getTileRect(y0*tilesWide + x0, ulTile);
+      sequencer->getTileRect(y1*tilesWide + x1, lrTile);
+      if ( theUpdateRect.hasNans() ||
+           ossimIrect(ulTile.ul(), lrTile.lr()).intersects(theUpdateRect) )
+      {
+         blocks.push_back(block);
+         numberOfTiles += (x1 - x0 + 1)*(y1 - y0 + 1);
+      }
+   }
+
+   //---
+   // Update: read the totals and index of a complete file for this header,
+   // and take the old counts of the blocks to recount out of the totals.
+   //---
+   std::fstream file;
+   bool update = false;
+   if ( !theUpdateRect.hasNans() )
+   {
+      file.open(theBlockHistogramFile.c_str(), std::ios::in|std::ios::out|std::ios::binary);
+      update = file.good() && header.matches(file);
+      if ( update && totals.size() )
+      {
+         file.read(reinterpret_cast<char*>(&totals.front()), totals.size()*sizeof(ossim_uint64));
+         update = file.good() && readIndex(file, index);
+      }
+      for (size_t b = 0; update && (b < blocks.size()); ++b)
+      {
+         for (ossim_uint32 band = 0; update && (band < numberOfBands); ++band)
+         {
+            update = subtractRecord(file, index[blocks[b]*numberOfBands + band],
+                                    &totals[band*numberOfBins], numberOfBins);
+         }
+      }
+      if ( !update )
+      {
+         ossimNotify(ossimNotifyLevel_NOTICE)
+            << "ossimImageHistogramSource::computeBlockHistogram NOTICE:"
+            << "\nBlock file " << theBlockHistogramFile
+            << " unusable for the update, counting all tiles." << std::endl;
+         file.close();
+         file.clear();
+         std::fill(totals.begin(), totals.end(), 0);
+         std::fill(index.begin(), index.end(), ossimHistogramBlockRecord());
+         blocks.clear();
+         numberOfTiles = tilesWide*tilesHigh;
+         for (ossim_int64 block = 0; block < blocksWide*blocksHigh; ++block)
+         {
+            blocks.push_back(block);
+         }
+      }
+   }
+   if ( !update )
+   {
+      // Reserves the totals and index, written last:
+      file.open(theBlockHistogramFile.c_str(),
+                std::ios::in|std::ios::out|std::ios::trunc|std::ios::binary);
+      header.write(file, 0);
+      file.seekp(indexOffset + (std::streamoff)(index.size()*BLOCK_INDEX_ENTRY_SIZE) - 1);
+      file.put(0);
+   }
+   else
+   {
+      file.seekp(BLOCK_COMPLETE_OFFSET);
+      writeValue(file, (ossim_uint32)0);
+      file.flush();
+   }
+   bool fileOk = file.good();
+   if ( !fileOk )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimImageHistogramSource::computeBlockHistogram WARNING:"
+         << "\nCould not write " << theBlockHistogramFile << std::endl;
+   }
+
+   double tileCount  = 0.0;
+   double totalTiles = ossim::max(numberOfTiles, (ossim_int64)1);
+   setProgressWork("histogram", (ossim_uint64)totalTiles,
+                   (ossim_uint64)tileSize.x * tileSize.y);
+   setPercentComplete(0.0);
+   std::vector<ossim_int64> tileIds;
+   std::vector<ossim_uint32> pairs;
+   for (size_t b = 0; (b < blocks.size()) && !needsAborting(); ++b)
+   {
+      const ossim_int64 x0 = (blocks[b] % blocksWide)*BLOCK_TILES;
+      const ossim_int64 y0 = (blocks[b] / blocksWide)*BLOCK_TILES;
+      tileIds.clear();
+      for (ossim_int64 y = y0; y < ossim::min(y0 + BLOCK_TILES, tilesHigh); ++y)
+      {
+         for (ossim_int64 x = x0; x < ossim::min(x0 + BLOCK_TILES, tilesWide); ++x)
+         {
+            tileIds.push_back(y*tilesWide + x);
+         }
+      }
+
+      ossimRefPtr<ossimMultiBandHistogram> blockHisto = new ossimMultiBandHistogram;
+      blockHisto->create(numberOfBands, numberOfBins, minValue, maxValue);
+      if ( numberOfThreads > 1 )
+      {
+         computeTilesMt(handler, sequencer, &tileIds, 0, blockHisto.get(), numberOfThreads,
+                        numberOfBins, minValue, maxValue, tileCount, totalTiles);
+      }
+      else
+      {
+         for (size_t t = 0; (t < tileIds.size()) && !needsAborting(); ++t)
+         {
+            ossimRefPtr<ossimImageData> data = sequencer->getTile(tileIds[t], 0);
+            if ( data.valid() && data->getBuf() && (data->getDataObjectStatus() != OSSIM_EMPTY) )
+            {
+               data->populateHistogram(blockHisto.get());
+            }
+            ++tileCount;
+            setPercentComplete(100.0*(tileCount/totalTiles));
+         }
+      }
+      if ( needsAborting() )
+      {
+         break;
+      }
+
+      // Adds the block to the totals and appends its records:
+      for (ossim_uint32 band = 0; band < numberOfBands; ++band)
+      {
+         const ossim_uint64* counts = blockHisto->getHistogram(band)->GetIntCounts();
+         ossim_uint64* bandTotals = &totals[band*numberOfBins];
+         pairs.clear();
+         for (ossim_uint32 bin = 0; counts && (bin < numberOfBins); ++bin)
+         {
+            if ( counts[bin] )
+            {
+               pairs.push_back(bin);
+               pairs.push_back((ossim_uint32)counts[bin]);
+               bandTotals[bin] += counts[bin];
+            }
+         }
+         ossimHistogramBlockRecord& record = index[blocks[b]*numberOfBands + band];
+         record.theOffset  = 0;
+         record.theEntries = (ossim_uint32)(pairs.size()/2);
+         if ( fileOk && pairs.size() )
+         {
+            file.seekp(0, std::ios::end);
+            record.theOffset = (ossim_uint64)file.tellp();
+            file.write(reinterpret_cast<const char*>(&pairs.front()),
+                       pairs.size()*sizeof(ossim_uint32));
+         }
+      }
+   }
+
+   // An interrupted count leaves the file flagged incomplete:
+   if ( fileOk && !needsAborting() )
+   {
+      file.seekp(BLOCK_HEADER_SIZE);
+      if ( totals.size() )
+      {
+         file.write(reinterpret_cast<const char*>(&totals.front()),
+                    totals.size()*sizeof(ossim_uint64));
+      }
+      writeIndex(file, index);
+      file.seekp(0);
+      header.write(file, 1);
+      file.flush();
+      if ( !file.good() )
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "ossimImageHistogramSource::computeBlockHistogram WARNING:"
+            << "\nCould not write " << theBlockHistogramFile << std::endl;
+      }
+   }
+   file.close();
+
+   ossimRefPtr<ossimMultiBandHistogram> histo = theHistogram->getMultiBandHistogram(0);
+   for (ossim_uint32 band = 0; band < numberOfBands; ++band)
+   {
+      ossim_uint64* counts = histo->getHistogram(band)->GetIntCounts();
+      for (ossim_uint32 bin = 0; counts && (bin < numberOfBins); ++bin)
+      {
+         counts[bin] = totals[band*numberOfBins + bin];
+      }
+   }
+   if ( needsAborting() )
+   {
+      setPercentComplete(100);
+   }
+}
+
+void ossimImageHistogramSource::computeTilesMt(ossimImageHandler* handler,
+                                               ossimImageSourceSequencer* sequencer,
+                                               const std::vector<ossim_int64>* tileIds,
+                                               ossim_uint32 resLevel,
+                                               ossimMultiBandHistogram* histo,
+                                               ossim_uint32 numberOfThreads,
+                                               ossim_uint32 numberOfBins,
+                                               ossim_float64 minValue,
+                                               ossim_float64 maxValue,
+                                               double& tileCount,
+                                               double totalTiles)
+{
+   const ossim_uint32 numberOfBands = handler->getNumberOfOutputBands();
+   const ossimIpt tileSize = sequencer->getTileSize();
+   ossimHistogramTileList tiles(this, sequencer, tileIds, tileCount, totalTiles);
+
+   // Thread 0 is this one:
+   std::vector< ossimRefPtr<ossimMultiBandHistogram> > histograms;
+   std::vector<ossimHistogramTileThread*> threads;
+   for(ossim_uint32 t = 0; t < numberOfThreads; ++t)
+   {
+      ossimRefPtr<ossimImageData> tile = ossimImageDataFactory::instance()->create(0, handler);
+      if ( !tile.valid() )
+      {
+         break;
+      }
+      tile->setWidthHeight(tileSize.x, tileSize.y);
+      tile->initialize();
+      histograms.push_back(new ossimMultiBandHistogram);
+      histograms.back()->create(numberOfBands, numberOfBins, minValue, maxValue);
+      threads.push_back(new ossimHistogramTileThread(tiles, handler, resLevel,
+                                                     tile.get(), histograms.back().get()));
+      if ( t )
+      {
+         threads.back()->start();
+      }
+   }
+   if ( threads.size() )
+   {
+      threads[0]->run();
+   }
+   for(ossim_uint32 t = 0; t < threads.size(); ++t)
+   {
+      if ( t )
+      {
+         threads[t]->join();
+      }
+      delete threads[t];
+   }
+
+   // Integer counts add exactly, so the sums match a single thread's counts:
+   for(ossim_uint32 t = 0; t < histograms.size(); ++t)
+   {
+      histo->addCounts(*histograms[t]);
+   }
 }
 
 void ossimImageHistogramSource::computeFastModeHistogram()
@@ -448,6 +1025,8 @@ void ossimImageHistogramSource::computeFastModeHistogram()
       ossim_uint32 y = 0;
       tileCount = 0;
       totalTiles = tilesWide*tilesHigh;
+      setProgressWork("histogram", (ossim_uint64)totalTiles,
+                      (ossim_uint64)tileSize.x * tileSize.y);
       for(y = 0; y < tilesHigh; ++y)
       {
          for(x = 0; x < tilesWide; ++x)
@@ -505,6 +1084,12 @@ bool ossimImageHistogramSource::loadState(const ossimKeywordlist& kwl,
    {
       theNumberOfTilesToUseInFastMode = numberOfTiles.toUInt32();
    }
+
+   ossimString numberOfThreads = kwl.find(prefix, "number_of_threads");
+   if(!numberOfThreads.empty())
+   {
+      theNumberOfThreads = numberOfThreads.toUInt32();
+   }
    theInputListIsFixedFlag = true;
    theOutputListIsFixedFlag = false;
 	
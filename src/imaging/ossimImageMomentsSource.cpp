@@ -0,0 +1,680 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+//*******************************************************************
+
+#include <ossim/imaging/ossimImageMomentsSource.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimImageSource.h>
+#include <ossim/imaging/ossimImageSourceSequencer.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimString.h>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+   // Percentiles written by saveStatistics:
+   const ossim_uint32 PERCENTILES[] = { 1, 2, 5, 25, 50, 75, 95, 98, 99 };
+   const ossim_uint32 NUMBER_OF_PERCENTILES = sizeof(PERCENTILES)/sizeof(ossim_uint32);
+
+   /** Hands the tiles of a sequencer's area of interest to the threads. */
+   class ossimMomentsTileList
+   {
+   public:
+      ossimMomentsTileList(ossimImageSourceSequencer* sequencer)
+         : theSequencer(sequencer),
+           theNextTile(0),
+           theNumberOfTiles(sequencer->getNumberOfTiles())
+      {}
+
+      /** @return false once all tiles are handed out. */
+      bool next(ossimIrect& rect)
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+         if ( theNextTile >= theNumberOfTiles )
+         {
+            return false;
+         }
+         theSequencer->getTileRect(theNextTile, rect);
+         ++theNextTile;
+         return true;
+      }
+
+   private:
+      ossimImageSourceSequencer* theSequencer;
+      OpenThreads::Mutex         theMutex;
+      ossim_int64                theNextTile;
+      ossim_int64                theNumberOfTiles;
+   };
+
+   /** Reads tiles of the list into its own tile and adds them to its own moments. */
+   class ossimMomentsTileThread : public OpenThreads::Thread
+   {
+   public:
+      ossimMomentsTileThread(ossimMomentsTileList& tiles,
+                             ossimImageHandler* handler,
+                             ossim_uint32 resLevel,
+                             ossimImageData* tile,
+                             ossimImageMoments* moments)
+         : OpenThreads::Thread(),
+           theTiles(tiles),
+           theHandler(handler),
+           theResLevel(resLevel),
+           theTile(tile),
+           theMoments(moments)
+      {}
+
+      virtual void run()
+      {
+         ossimIrect rect;
+         while ( theTiles.next(rect) )
+         {
+            theTile->setImageRectangle(rect);
+            if ( theHandler->getTile(theTile.get(), theResLevel) )
+            {
+               theMoments->addTile(theTile.get());
+            }
+         }
+      }
+
+   private:
+      ossimMomentsTileList&       theTiles;
+      ossimImageHandler*          theHandler;
+      ossim_uint32                theResLevel;
+      ossimRefPtr<ossimImageData> theTile;
+      ossimImageMoments*          theMoments;
+   };
+
+   /** Merges the mean and M2 of a part of nb values into those of na values. */
+   void mergeMoments(ossim_float64 na, ossim_float64& mean, ossim_float64& m2,
+                     ossim_float64 nb, ossim_float64 meanB, ossim_float64 m2B)
+   {
+      const ossim_float64 n = na + nb;
+      const ossim_float64 delta = meanB - mean;
+      mean += delta*nb/n;
+      m2   += m2B + delta*delta*na*nb/n;
+   }
+}
+
+ossimImageMoments::ossimImageMoments(ossim_uint32 numberOfBands,
+                                     ossim_float64 compression)
+   : theNumberOfBands(numberOfBands),
+     theCompression(compression),
+     theCount(numberOfBands, 0.0),
+     theMean(numberOfBands, 0.0),
+     theM2(numberOfBands, 0.0),
+     theMin(numberOfBands, ossim::nan()),
+     theMax(numberOfBands, ossim::nan()),
+     theCoCount(0.0),
+     theCoMean(numberOfBands, 0.0),
+     theCoMoment(numberOfBands*numberOfBands, 0.0),
+     theValueCounts(numberOfBands),
+     theCountOffset(0),
+     theDigests(numberOfBands, ossimTDigest(compression)),
+     theValidPixels()
+{
+}
+
+void ossimImageMoments::addTile(const ossimImageData* tile)
+{
+   if ( !tile || !tile->getBuf() || (tile->getDataObjectStatus() == OSSIM_EMPTY) ||
+        (tile->getNumberOfBands() < theNumberOfBands) )
+   {
+      return;
+   }
+   switch ( tile->getScalarType() )
+   {
+      case OSSIM_UINT8:
+      {
+         addTileTemplate(tile, (ossim_uint8)0);
+         break;
+      }
+      case OSSIM_SINT8:
+      {
+         addTileTemplate(tile, (ossim_sint8)0);
+         break;
+      }
+      case OSSIM_USHORT11:
+      case OSSIM_UINT16:
+      {
+         addTileTemplate(tile, (ossim_uint16)0);
+         break;
+      }
+      case OSSIM_SINT16:
+      {
+         addTileTemplate(tile, (ossim_sint16)0);
+         break;
+      }
+      case OSSIM_UINT32:
+      {
+         addTileTemplate(tile, (ossim_uint32)0);
+         break;
+      }
+      case OSSIM_SINT32:
+      {
+         addTileTemplate(tile, (ossim_sint32)0);
+         break;
+      }
+      case OSSIM_FLOAT32:
+      case OSSIM_NORMALIZED_FLOAT:
+      {
+         addTileTemplate(tile, (ossim_float32)0);
+         break;
+      }
+      case OSSIM_FLOAT64:
+      case OSSIM_NORMALIZED_DOUBLE:
+      {
+         addTileTemplate(tile, (ossim_float64)0);
+         break;
+      }
+      default:
+      {
+         break;
+      }
+   }
+}
+
+template <class T>
+void ossimImageMoments::addTileTemplate(const ossimImageData* tile, T /* dummy */)
+{
+   const ossim_uint32 size = tile->getWidth()*tile->getHeight();
+
+   // 8 and 16 bit integers are counted value by value, others go to the digest:
+   ossim_uint32 countSize = 0;
+   ossim_int32  countOffset = 0;
+   if ( std::numeric_limits<T>::is_integer && (sizeof(T) <= 2) )
+   {
+      countSize   = (sizeof(T) == 1) ? 256 : 65536;
+      countOffset = std::numeric_limits<T>::is_signed ? (ossim_int32)(countSize/2) : 0;
+   }
+
+   for (ossim_uint32 band = 0; band < theNumberOfBands; ++band)
+   {
+      const T* buf = static_cast<const T*>(tile->getBuf(band));
+      const T nullPix = static_cast<T>(tile->getNullPix(band));
+      if ( countSize && theValueCounts[band].empty() )
+      {
+         theValueCounts[band].resize(countSize, 0);
+         theCountOffset = countOffset;
+      }
+      ossim_uint64* counts = countSize ? &theValueCounts[band].front() : 0;
+
+      // First pass: count, sum, extremes and quantiles.
+      ossim_float64 n = 0.0;
+      ossim_float64 sum = 0.0;
+      ossim_float64 minValue = theMin[band];
+      ossim_float64 maxValue = theMax[band];
+      for (ossim_uint32 i = 0; i < size; ++i)
+      {
+         // Also skips NaNs in floating point data:
+         if ( (buf[i] != nullPix) && (buf[i] == buf[i]) )
+         {
+            const ossim_float64 value = buf[i];
+            ++n;
+            sum += value;
+            if ( !(value >= minValue) )
+            {
+               minValue = value;
+            }
+            if ( !(value <= maxValue) )
+            {
+               maxValue = value;
+            }
+            if ( counts )
+            {
+               ++counts[(ossim_int32)buf[i] + countOffset];
+            }
+            else
+            {
+               theDigests[band].add(value);
+            }
+         }
+      }
+      if ( n == 0.0 )
+      {
+         continue;
+      }
+      theMin[band] = minValue;
+      theMax[band] = maxValue;
+
+      // Second pass: squared deviations from the tile mean.
+      const ossim_float64 tileMean = sum/n;
+      ossim_float64 tileM2 = 0.0;
+      for (ossim_uint32 i = 0; i < size; ++i)
+      {
+         if ( (buf[i] != nullPix) && (buf[i] == buf[i]) )
+         {
+            const ossim_float64 delta = buf[i] - tileMean;
+            tileM2 += delta*delta;
+         }
+      }
+      mergeMoments(theCount[band], theMean[band], theM2[band], n, tileMean, tileM2);
+      theCount[band] += n;
+   }
+
+   if ( theNumberOfBands < 2 )
+   {
+      return;
+   }
+
+   // Covariance over the pixels valid in every band, about their tile means:
+   theValidPixels.assign(size, 1);
+   for (ossim_uint32 band = 0; band < theNumberOfBands; ++band)
+   {
+      const T* buf = static_cast<const T*>(tile->getBuf(band));
+      const T nullPix = static_cast<T>(tile->getNullPix(band));
+      for (ossim_uint32 i = 0; i < size; ++i)
+      {
+         if ( (buf[i] == nullPix) || (buf[i] != buf[i]) )
+         {
+            theValidPixels[i] = 0;
+         }
+      }
+   }
+   ossim_float64 n = 0.0;
+   for (ossim_uint32 i = 0; i < size; ++i)
+   {
+      n += theValidPixels[i];
+   }
+   if ( n == 0.0 )
+   {
+      return;
+   }
+   std::vector<ossim_float64> tileMean(theNumberOfBands, 0.0);
+   for (ossim_uint32 band = 0; band < theNumberOfBands; ++band)
+   {
+      const T* buf = static_cast<const T*>(tile->getBuf(band));
+      ossim_float64 sum = 0.0;
+      for (ossim_uint32 i = 0; i < size; ++i)
+      {
+         if ( theValidPixels[i] )
+         {
+            sum += buf[i];
+         }
+      }
+      tileMean[band] = sum/n;
+   }
+   const ossim_float64 total = theCoCount + n;
+   for (ossim_uint32 b1 = 0; b1 < theNumberOfBands; ++b1)
+   {
+      const T* buf1 = static_cast<const T*>(tile->getBuf(b1));
+      const ossim_float64 delta1 = tileMean[b1] - theCoMean[b1];
+      for (ossim_uint32 b2 = b1; b2 < theNumberOfBands; ++b2)
+      {
+         const T* buf2 = static_cast<const T*>(tile->getBuf(b2));
+         ossim_float64 coMoment = 0.0;
+         for (ossim_uint32 i = 0; i < size; ++i)
+         {
+            if ( theValidPixels[i] )
+            {
+               coMoment += (buf1[i] - tileMean[b1])*(buf2[i] - tileMean[b2]);
+            }
+         }
+         const ossim_float64 delta2 = tileMean[b2] - theCoMean[b2];
+         theCoMoment[b1*theNumberOfBands + b2] +=
+            coMoment + delta1*delta2*theCoCount*n/total;
+         theCoMoment[b2*theNumberOfBands + b1] = theCoMoment[b1*theNumberOfBands + b2];
+      }
+   }
+   for (ossim_uint32 band = 0; band < theNumberOfBands; ++band)
+   {
+      theCoMean[band] += (tileMean[band] - theCoMean[band])*n/total;
+   }
+   theCoCount = total;
+}
+
+void ossimImageMoments::merge(const ossimImageMoments& moments)
+{
+   if ( moments.theNumberOfBands != theNumberOfBands )
+   {
+      return;
+   }
+   for (ossim_uint32 band = 0; band < theNumberOfBands; ++band)
+   {
+      const ossim_float64 nb = moments.theCount[band];
+      if ( nb == 0.0 )
+      {
+         continue;
+      }
+      mergeMoments(theCount[band], theMean[band], theM2[band],
+                   nb, moments.theMean[band], moments.theM2[band]);
+      theCount[band] += nb;
+      if ( !(moments.theMin[band] >= theMin[band]) )
+      {
+         theMin[band] = moments.theMin[band];
+      }
+      if ( !(moments.theMax[band] <= theMax[band]) )
+      {
+         theMax[band] = moments.theMax[band];
+      }
+
+      const std::vector<ossim_uint64>& counts = moments.theValueCounts[band];
+      if ( counts.size() )
+      {
+         if ( theValueCounts[band].empty() )
+         {
+            theValueCounts[band].resize(counts.size(), 0);
+            theCountOffset = moments.theCountOffset;
+         }
+         for (size_t i = 0; i < counts.size(); ++i)
+         {
+            theValueCounts[band][i] += counts[i];
+         }
+      }
+      theDigests[band].merge(moments.theDigests[band]);
+   }
+
+   if ( moments.theCoCount > 0.0 )
+   {
+      const ossim_float64 na = theCoCount;
+      const ossim_float64 nb = moments.theCoCount;
+      const ossim_float64 total = na + nb;
+      for (ossim_uint32 b1 = 0; b1 < theNumberOfBands; ++b1)
+      {
+         const ossim_float64 delta1 = moments.theCoMean[b1] - theCoMean[b1];
+         for (ossim_uint32 b2 = 0; b2 < theNumberOfBands; ++b2)
+         {
+            const ossim_float64 delta2 = moments.theCoMean[b2] - theCoMean[b2];
+            theCoMoment[b1*theNumberOfBands + b2] +=
+               moments.theCoMoment[b1*theNumberOfBands + b2] + delta1*delta2*na*nb/total;
+         }
+      }
+      for (ossim_uint32 band = 0; band < theNumberOfBands; ++band)
+      {
+         theCoMean[band] += (moments.theCoMean[band] - theCoMean[band])*nb/total;
+      }
+      theCoCount = total;
+   }
+}
+
+ossim_uint32 ossimImageMoments::getNumberOfBands()const
+{
+   return theNumberOfBands;
+}
+
+ossim_float64 ossimImageMoments::getCount(ossim_uint32 band)const
+{
+   return (band < theNumberOfBands) ? theCount[band] : 0.0;
+}
+
+ossim_float64 ossimImageMoments::getMean(ossim_uint32 band)const
+{
+   return ( (band < theNumberOfBands) && (theCount[band] > 0.0) ) ?
+      theMean[band] : ossim::nan();
+}
+
+ossim_float64 ossimImageMoments::getVariance(ossim_uint32 band)const
+{
+   return ( (band < theNumberOfBands) && (theCount[band] > 1.0) ) ?
+      theM2[band]/(theCount[band] - 1.0) : ossim::nan();
+}
+
+ossim_float64 ossimImageMoments::getStdDev(ossim_uint32 band)const
+{
+   return std::sqrt(getVariance(band));
+}
+
+ossim_float64 ossimImageMoments::getMin(ossim_uint32 band)const
+{
+   return (band < theNumberOfBands) ? theMin[band] : ossim::nan();
+}
+
+ossim_float64 ossimImageMoments::getMax(ossim_uint32 band)const
+{
+   return (band < theNumberOfBands) ? theMax[band] : ossim::nan();
+}
+
+ossim_float64 ossimImageMoments::getCovariance(ossim_uint32 band1, ossim_uint32 band2)const
+{
+   if ( (band1 >= theNumberOfBands) || (band2 >= theNumberOfBands) )
+   {
+      return ossim::nan();
+   }
+   if ( theNumberOfBands == 1 )
+   {
+      return getVariance(0);
+   }
+   return (theCoCount > 1.0) ?
+      theCoMoment[band1*theNumberOfBands + band2]/(theCoCount - 1.0) : ossim::nan();
+}
+
+ossim_float64 ossimImageMoments::getCovarianceCount()const
+{
+   return (theNumberOfBands == 1) ? theCount[0] : theCoCount;
+}
+
+ossim_float64 ossimImageMoments::getQuantile(ossim_uint32 band, ossim_float64 q)const
+{
+   if ( (band >= theNumberOfBands) || !(theCount[band] > 0.0) )
+   {
+      return ossim::nan();
+   }
+   if ( theValueCounts[band].empty() )
+   {
+      return theDigests[band].quantile(q);
+   }
+
+   // Exact: the values of the two ranks around q interpolated.
+   q = ossim::max(0.0, ossim::min(q, 1.0));
+   const ossim_float64 index = q*(theCount[band] - 1.0);
+   const ossim_float64 lower = std::floor(index);
+   const ossim_float64 lowerValue = getCountedValue(band, lower);
+   if ( index == lower )
+   {
+      return lowerValue;
+   }
+   return lowerValue + (getCountedValue(band, lower + 1.0) - lowerValue)*(index - lower);
+}
+
+ossim_float64 ossimImageMoments::getCountedValue(ossim_uint32 band, ossim_float64 index)const
+{
+   const std::vector<ossim_uint64>& counts = theValueCounts[band];
+   ossim_float64 cumulative = 0.0;
+   for (size_t i = 0; i < counts.size(); ++i)
+   {
+      cumulative += counts[i];
+      if ( index < cumulative )
+      {
+         return (ossim_float64)((ossim_int32)i - theCountOffset);
+      }
+   }
+   return theMax[band];
+}
+
+ossimImageMomentsSource::ossimImageMomentsSource()
+   : ossimSource(0,
+                 1,
+                 0,
+                 true,
+                 false),
+     theMoments(),
+     theNumberOfThreads(1),
+     theResLevel(0),
+     theCompression(200.0)
+{
+}
+
+ossimImageMomentsSource::~ossimImageMomentsSource()
+{
+}
+
+void ossimImageMomentsSource::computeStatistics()
+{
+   ossimImageSource* input = PTR_CAST(ossimImageSource, getInput());
+   if ( !input || !isSourceEnabled() )
+   {
+      return;
+   }
+   const ossim_uint32 bands = input->getNumberOfOutputBands();
+   theMoments = ossimImageMoments(bands, theCompression);
+   if ( !bands )
+   {
+      return;
+   }
+
+   ossimRefPtr<ossimImageSourceSequencer> sequencer = new ossimImageSourceSequencer;
+   sequencer->connectMyInputTo(getInput());
+   if ( theResLevel )
+   {
+      sequencer->setAreaOfInterest(input->getBoundingRect(theResLevel));
+   }
+   sequencer->setToStartOfSequence();
+
+   // Threads read through the handler itself, so it must allow concurrent reads:
+   ossimImageHandler* handler = PTR_CAST(ossimImageHandler, input);
+   ossim_uint32 numberOfThreads =
+      theNumberOfThreads ? theNumberOfThreads : ossim::getNumberOfThreads();
+   if ( !handler || !handler->hasConcurrentReads() )
+   {
+      numberOfThreads = 1;
+   }
+
+   if ( numberOfThreads > 1 )
+   {
+      const ossimIpt tileSize = sequencer->getTileSize();
+      ossimMomentsTileList tiles(sequencer.get());
+
+      // Thread 0 is this one:
+      std::vector<ossimImageMoments> moments(numberOfThreads,
+                                             ossimImageMoments(bands, theCompression));
+      std::vector<ossimMomentsTileThread*> threads;
+      for (ossim_uint32 t = 0; t < numberOfThreads; ++t)
+      {
+         ossimRefPtr<ossimImageData> tile =
+            ossimImageDataFactory::instance()->create(0, handler);
+         if ( !tile.valid() )
+         {
+            break;
+         }
+         tile->setWidthHeight(tileSize.x, tileSize.y);
+         tile->initialize();
+         threads.push_back(new ossimMomentsTileThread(tiles, handler, theResLevel,
+                                                      tile.get(), &moments[t]));
+         if ( t )
+         {
+            threads.back()->start();
+         }
+      }
+      if ( threads.size() )
+      {
+         threads[0]->run();
+      }
+      for (ossim_uint32 t = 0; t < threads.size(); ++t)
+      {
+         if ( t )
+         {
+            threads[t]->join();
+         }
+         delete threads[t];
+      }
+
+      // Counts add exactly; the moments differ from a single thread's by rounding only:
+      for (ossim_uint32 t = 0; t < threads.size(); ++t)
+      {
+         theMoments.merge(moments[t]);
+      }
+   }
+   else
+   {
+      ossimRefPtr<ossimImageData> tile = sequencer->getNextTile(theResLevel);
+      while ( tile.valid() )
+      {
+         theMoments.addTile(tile.get());
+         tile = sequencer->getNextTile(theResLevel);
+      }
+   }
+
+   sequencer->disconnect();
+   sequencer = 0;
+}
+
+bool ossimImageMomentsSource::canConnectMyInputTo(ossim_int32 inputIndex,
+                                                  const ossimConnectableObject* object)const
+{
+   return (PTR_CAST(ossimImageSource, object)&&(inputIndex < 1));
+}
+
+const ossimImageMoments& ossimImageMomentsSource::getMoments()const
+{
+   return theMoments;
+}
+
+void ossimImageMomentsSource::setNumberOfThreads(ossim_uint32 threads)
+{
+   theNumberOfThreads = threads;
+}
+
+ossim_uint32 ossimImageMomentsSource::getNumberOfThreads()const
+{
+   return theNumberOfThreads;
+}
+
+void ossimImageMomentsSource::setResLevel(ossim_uint32 resLevel)
+{
+   theResLevel = resLevel;
+}
+
+ossim_uint32 ossimImageMomentsSource::getResLevel()const
+{
+   return theResLevel;
+}
+
+void ossimImageMomentsSource::setCompression(ossim_float64 compression)
+{
+   theCompression = compression;
+}
+
+ossim_float64 ossimImageMomentsSource::getCompression()const
+{
+   return theCompression;
+}
+
+void ossimImageMomentsSource::saveStatistics(ossimKeywordlist& kwl, const char* prefix)const
+{
+   const ossim_uint32 bands = theMoments.getNumberOfBands();
+   for (ossim_uint32 band = 0; band < bands; ++band)
+   {
+      ossimString bandPrefix = prefix;
+      bandPrefix += "band";
+      bandPrefix += ossimString::toString(band + 1);
+      bandPrefix += ".";
+      kwl.add(bandPrefix.c_str(), "count", theMoments.getCount(band));
+      kwl.add(bandPrefix.c_str(), "mean", theMoments.getMean(band));
+      kwl.add(bandPrefix.c_str(), "variance", theMoments.getVariance(band));
+      kwl.add(bandPrefix.c_str(), "std_dev", theMoments.getStdDev(band));
+      kwl.add(bandPrefix.c_str(), "min", theMoments.getMin(band));
+      kwl.add(bandPrefix.c_str(), "max", theMoments.getMax(band));
+      for (ossim_uint32 p = 0; p < NUMBER_OF_PERCENTILES; ++p)
+      {
+         ossimString key = "percentile_";
+         key += ossimString::toString(PERCENTILES[p]);
+         kwl.add(bandPrefix.c_str(), key.c_str(),
+                 theMoments.getQuantile(band, PERCENTILES[p]/100.0));
+      }
+   }
+   if ( bands > 1 )
+   {
+      ossimString covPrefix = prefix;
+      covPrefix += "covariance.";
+      kwl.add(covPrefix.c_str(), "count", theMoments.getCovarianceCount());
+      for (ossim_uint32 b1 = 0; b1 < bands; ++b1)
+      {
+         for (ossim_uint32 b2 = b1; b2 < bands; ++b2)
+         {
+            ossimString key = "band";
+            key += ossimString::toString(b1 + 1);
+            key += ".band";
+            key += ossimString::toString(b2 + 1);
+            kwl.add(covPrefix.c_str(), key.c_str(), theMoments.getCovariance(b1, b2));
+         }
+      }
+   }
+}
@@ -287,6 +287,11 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combineNorm(
    
    ossim_uint32 band;
    ossim_uint32 upperBound = destination->getWidth()*destination->getHeight();
+   ossim_uint32 tileWidth  = destination->getWidth();
+
+   // Nothing is covered yet.
+   ossimIrect neededRect = tileRect;
+   theCoverage.assign(upperBound, 0);
    ossim_uint32 minNumberOfBands = currentImageData->getNumberOfBands();
    for(band = 0; band < minNumberOfBands; ++band)
    {
@@ -323,7 +328,7 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combineNorm(
          currentImageData->getDataObjectStatus();
       if ( (currentStatus == OSSIM_EMPTY) || (currentStatus == OSSIM_NULL) )
       {
-         currentImageData = getNextNormTile(layerIdx, tileRect, resLevel);
+         currentImageData = getNextNormTile(layerIdx, tileRect, neededRect, resLevel);
          continue;
       }
       
@@ -358,14 +363,16 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combineNorm(
             }
          }
       }
-      else // Copy tile checking all the pixels...
+      else // Copy tile checking the pixels of the rows still to fill...
       {
+         const ossim_uint32 firstOffset = (neededRect.ul().y - tileRect.ul().y)*tileWidth;
+         const ossim_uint32 lastOffset  = (neededRect.lr().y - tileRect.ul().y + 1)*tileWidth;
          for(band = 0; band < theLargestNumberOfInputBands; ++band)
          {
             float delta = destBandsMaxPix[band] - destBandsMinPix[band];
             float minP  = destBandsMinPix[band];
             
-            for(ossim_uint32 offset = 0; offset < upperBound; ++offset)
+            for(ossim_uint32 offset = firstOffset; offset < lastOffset; ++offset)
             {
                if (destBands[band][offset] == destBandsNullPix[band])
                {
@@ -379,16 +386,25 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combineNorm(
          }
       }
 
-      // Validate output tile and return if full.
-      destinationStatus = destination->validate();
-      if (destinationStatus == OSSIM_FULL)
+      // Return if full.  Only the pixels still uncovered are rescanned.
+      if (updateCoverage(static_cast<T>(0), neededRect) == 0)
       {
-         
+         destination->setValidatedStatus(OSSIM_FULL);
+         destinationStatus = OSSIM_FULL;
          break;//return destination;
       }
+      destinationStatus = OSSIM_PARTIAL;
 
-      // If we get here we're are still not full.  Get a tile from next layer.
-      currentImageData = getNextNormTile(layerIdx, tileRect, resLevel);
+      // If we get here we're are still not full.  Get a tile from the next layer covering
+      // what is left.
+      currentImageData = getNextNormTile(layerIdx, tileRect, neededRect, resLevel);
+   }
+
+   if (destinationStatus != OSSIM_FULL)
+   {
+      // destBands were fetched before the loop so drop the cached status to force a rescan.
+      destination->invalidateStatus();
+      destination->validate();
    }
 
    // Cleanup...
@@ -429,6 +445,11 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combine(
       
    ossim_uint32 band;
    ossim_uint32 upperBound = destination->getWidth()*destination->getHeight();
+   ossim_uint32 tileWidth  = destination->getWidth();
+
+   // Nothing is covered yet.
+   ossimIrect neededRect = tileRect;
+   theCoverage.assign(upperBound, 0);
    ossim_uint32 minNumberOfBands = currentImageData->getNumberOfBands();
    for(band = 0; band < minNumberOfBands; ++band)
    {
@@ -458,7 +479,7 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combine(
          currentImageData->getDataObjectStatus();
       if ( (currentStatus == OSSIM_EMPTY) || (currentStatus == OSSIM_NULL) )
       {
-         currentImageData = getNextNormTile(layerIdx, tileRect, resLevel);
+         currentImageData = getNextTile(layerIdx, tileRect, neededRect, resLevel);
          continue;
       }
       
@@ -489,12 +510,14 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combine(
             }
          }
       }
-      else // Copy tile checking all the pixels...
+      else // Copy tile checking the pixels of the rows still to fill...
       {
+         const ossim_uint32 firstOffset = (neededRect.ul().y - tileRect.ul().y)*tileWidth;
+         const ossim_uint32 lastOffset  = (neededRect.lr().y - tileRect.ul().y + 1)*tileWidth;
          for(band = 0; band < theLargestNumberOfInputBands; ++band)
          {
             
-            for(ossim_uint32 offset = 0; offset < upperBound; ++offset)
+            for(ossim_uint32 offset = firstOffset; offset < lastOffset; ++offset)
             {
                if(destBands[band][offset] == destBandsNullPix[band])
                {
@@ -504,15 +527,25 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combine(
          }
       }
 
-      // Validate output tile and return if full.
-      destinationStatus = destination->validate();
-      if (destinationStatus == OSSIM_FULL)
+      // Return if full.  Only the pixels still uncovered are rescanned.
+      if (updateCoverage(static_cast<T>(0), neededRect) == 0)
       {
+         destination->setValidatedStatus(OSSIM_FULL);
+         destinationStatus = OSSIM_FULL;
          break;//return destination;
       }
+      destinationStatus = OSSIM_PARTIAL;
+
+      // If we get here we're are still not full.  Get a tile from the next layer covering
+      // what is left.
+      currentImageData = getNextTile(layerIdx, tileRect, neededRect, resLevel);
+   }
 
-      // If we get here we're are still not full.  Get a tile from next layer.
-      currentImageData = getNextTile(layerIdx, tileRect, resLevel);
+   if (destinationStatus != OSSIM_FULL)
+   {
+      // destBands were fetched before the loop so drop the cached status to force a rescan.
+      destination->invalidateStatus();
+      destination->validate();
    }
    
    // Cleanup...
@@ -523,3 +556,67 @@ template <class T> ossimRefPtr<ossimImageData> ossimImageMosaic::combine(
    
    return destination;
 }
+
+template <class T> ossim_uint32 ossimImageMosaic::updateCoverage(T, ossimIrect& neededRect)
+{
+   const ossimImageData* tile = theTile.get();
+   const ossim_int32  w     = static_cast<ossim_int32>(tile->getWidth());
+   const ossim_uint32 bands = tile->getNumberOfBands();
+   const ossimIpt     origin = tile->getOrigin();
+
+   std::vector<const T*> buf(bands);
+   std::vector<T>        np(bands);
+   for (ossim_uint32 band = 0; band < bands; ++band)
+   {
+      buf[band] = static_cast<const T*>(tile->getBuf(band));
+      np[band]  = static_cast<T>(tile->getNullPix(band));
+   }
+
+   // Pixels outside neededRect were covered by earlier layers.
+   const ossim_int32 firstRow = neededRect.ul().y - origin.y;
+   const ossim_int32 lastRow  = neededRect.lr().y - origin.y;
+   const ossim_int32 firstCol = neededRect.ul().x - origin.x;
+   const ossim_int32 lastCol  = neededRect.lr().x - origin.x;
+
+   ossim_uint32 remaining = 0;
+   ossim_int32 minX = lastCol;
+   ossim_int32 maxX = firstCol;
+   ossim_int32 minY = lastRow;
+   ossim_int32 maxY = firstRow;
+   for (ossim_int32 row = firstRow; row <= lastRow; ++row)
+   {
+      for (ossim_int32 col = firstCol; col <= lastCol; ++col)
+      {
+         const ossim_uint32 offset = row*w + col;
+         if (theCoverage[offset])
+         {
+            continue;
+         }
+
+         bool covered = true;
+         for (ossim_uint32 band = 0; covered && (band < bands); ++band)
+         {
+            covered = (buf[band][offset] != np[band]);
+         }
+         if (covered)
+         {
+            theCoverage[offset] = 1;
+         }
+         else
+         {
+            ++remaining;
+            if (col < minX) minX = col;
+            if (col > maxX) maxX = col;
+            if (row < minY) minY = row;
+            if (row > maxY) maxY = row;
+         }
+      }
+   }
+
+   if (remaining)
+   {
+      neededRect = ossimIrect(origin.x + minX, origin.y + minY,
+                              origin.x + maxX, origin.y + maxY);
+   }
+   return remaining;
+}
@@ -23,6 +23,7 @@
 #include <ossim/base/ossimViewController.h>
 #include <ossim/base/ossimStringProperty.h>
 #include <ossim/base/ossimNumericProperty.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
@@ -30,6 +31,8 @@
 #include <ossim/imaging/ossimDiscrete3x3HatFilter.h>
 #include <ossim/imaging/ossimDiscreteNearestNeighbor.h>
 #include <ossim/imaging/ossimFilterResampler.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
 #include <ossim/projection/ossimImageViewProjectionTransform.h>
 #include <ossim/projection/ossimProjectionFactoryRegistry.h>
 #include <ossim/projection/ossimImageViewTransformFactory.h>
@@ -43,10 +46,228 @@ static const char OSSIM_ID[] = "$Id: ossimImageRenderer.cpp 23663 2015-12-11 21:
 #endif
 
 static ossimTrace traceDebug("ossimImageRenderer:debug");
+static ossimTrace traceSpan("ossimImageRenderer:span");
 
 RTTI_DEF2(ossimImageRenderer, "ossimImageRenderer", ossimImageSourceFilter, ossimViewInterface);
 
+namespace
+{
+   //---
+   // Countdown shared by the resample jobs of one flush; releases the waiting getTile when the
+   // last job is done.
+   //---
+   class ossimRendererResampleBatch : public ossimReferenced
+   {
+   public:
+      ossimRendererResampleBatch(ossim_uint32 count)
+         : m_count(count)
+      {
+         if(m_count)
+         {
+            m_block.reset();
+         }
+         else
+         {
+            m_block.release();
+         }
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_count && (--m_count == 0))
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+   private:
+      OpenThreads::Mutex m_mutex;
+      OpenThreads::Block m_block;
+      ossim_uint32       m_count;
+   };
+
+   //---
+   // One fillTile resample.  The input tile is a copy as sources reuse their tiles; the output
+   // area, viewRect, is disjoint from that of every other job of the tile.
+   //---
+   class ossimRendererResampleJob : public ossimJob
+   {
+   public:
+      ossimRendererResampleJob(ossimFilterResampler* resampler,
+                               ossimRefPtr<ossimImageData> input,
+                               ossimRefPtr<ossimImageData> output,
+                               const ossimIrect& viewRect,
+                               const ossimDpt& ul,
+                               const ossimDpt& ur,
+                               const ossimDpt& deltaUl,
+                               const ossimDpt& deltaUr,
+                               const ossimDpt& length)
+         : m_resampler(resampler),
+           m_input(input),
+           m_output(output),
+           m_viewRect(viewRect),
+           m_ul(ul),
+           m_ur(ur),
+           m_deltaUl(deltaUl),
+           m_deltaUr(deltaUr),
+           m_length(length)
+      {
+         setName("ossimImageRenderer.resample");
+      }
+      void setBatch(ossimRendererResampleBatch* batch) { m_batch = batch; }
+      ossimImageData* getOutput() { return m_output.get(); }
+      virtual void start()
+      {
+         m_resampler->resample(m_input, m_output, m_viewRect,
+                               m_ul, m_ur, m_deltaUl, m_deltaUr, m_length);
+         m_input = 0;
+         if(m_batch.valid())
+         {
+            m_batch->done();
+         }
+      }
+   private:
+      ossimFilterResampler*                     m_resampler;
+      ossimRefPtr<ossimImageData>               m_input;
+      ossimRefPtr<ossimImageData>               m_output;
+      ossimIrect                                m_viewRect;
+      ossimDpt                                  m_ul;
+      ossimDpt                                  m_ur;
+      ossimDpt                                  m_deltaUl;
+      ossimDpt                                  m_deltaUr;
+      ossimDpt                                  m_length;
+      ossimRefPtr<ossimRendererResampleBatch>   m_batch;
+   };
+}
+
+
+
+ossimImageRenderer::ossimRendererTransformGrid::ossimRendererTransformGrid()
+   :m_transform(0),
+    m_tolerance(0.1),
+    m_cellCount(0)
+{
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("renderer.transform_grid_tolerance");
+   if(lookup)
+   {
+      m_tolerance = ossimString(lookup).toFloat64();
+   }
+}
+
+void ossimImageRenderer::ossimRendererTransformGrid::reset(ossimImageViewTransform* transform)
+{
+   m_transform = transform;
+   for(ossim_uint32 level = 0; level < LEVELS; ++level)
+   {
+      m_cells[level].clear();
+   }
+   m_cellCount = 0;
+}
+
+void ossimImageRenderer::ossimRendererTransformGrid::viewToImage(const ossimDpt& viewPt,
+                                                                 ossimDpt& imagePt)const
+{
+   if(!m_transform.valid())
+   {
+      imagePt.makeNan();
+      return;
+   }
+   if((m_tolerance > 0.0) && !viewPt.hasNans())
+   {
+      for(ossim_uint32 level = 0; level < LEVELS; ++level)
+      {
+         const ossim_float64 SIZE = (ossim_float64)(64 >> level);
+         const ossim_float64 X = viewPt.x/SIZE;
+         const ossim_float64 Y = viewPt.y/SIZE;
+         const ossim_float64 CX = std::floor(X);
+         const ossim_float64 CY = std::floor(Y);
+         const Cell& cell = getCell(level, (ossim_int32)CX, (ossim_int32)CY);
+         if(cell.m_linear)
+         {
+            const ossim_float64 U = X - CX;
+            const ossim_float64 V = Y - CY;
+            ossimDpt top    = cell.m_ul + (cell.m_ur - cell.m_ul)*U;
+            ossimDpt bottom = cell.m_ll + (cell.m_lr - cell.m_ll)*U;
+            imagePt = top + (bottom - top)*V;
+            return;
+         }
+      }
+   }
+   m_transform->viewToImage(viewPt, imagePt);
+}
+
+const ossimImageRenderer::ossimRendererTransformGrid::Cell&
+ossimImageRenderer::ossimRendererTransformGrid::getCell(ossim_uint32 level,
+                                                        ossim_int32 x,
+                                                        ossim_int32 y)const
+{
+   const ossim_int64 KEY = ((ossim_int64)y << 32) | (ossim_int64)(ossim_uint32)x;
+   std::map<ossim_int64, Cell>::const_iterator iter = m_cells[level].find(KEY);
+   if(iter != m_cells[level].end())
+   {
+      return iter->second;
+   }
+
+   // Bound the memory used when roaming far over a large view.
+   if(m_cellCount >= MAX_CELLS)
+   {
+      for(ossim_uint32 i = 0; i < LEVELS; ++i)
+      {
+         m_cells[i].clear();
+      }
+      m_cellCount = 0;
+   }
+
+   // Corners, then edge mid points and center, in cell units.
+   static const ossim_float64 POINTS[9][2] =
+      { {0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0},
+        {0.5, 0.0}, {1.0, 0.5}, {0.5, 1.0}, {0.0, 0.5}, {0.5, 0.5} };
+
+   // One batch, so sensor models with a batch projection evaluate all nine together.
+   const ossim_float64 SIZE = (ossim_float64)(64 >> level);
+   const ossimDpt UL(x*SIZE, y*SIZE);
+   ossimDpt viewPts[9];
+   ossimDpt imagePts[9];
+   for(ossim_uint32 i = 0; i < 9; ++i)
+   {
+      viewPts[i] = UL + ossimDpt(POINTS[i][0]*SIZE, POINTS[i][1]*SIZE);
+   }
+   m_transform->viewToImagePoints(viewPts, imagePts, 9);
+
+   Cell cell;
+   cell.m_ul = imagePts[0];
+   cell.m_ur = imagePts[1];
+   cell.m_lr = imagePts[2];
+   cell.m_ll = imagePts[3];
+   cell.m_linear = !(cell.m_ul.hasNans() || cell.m_ur.hasNans() ||
+                     cell.m_lr.hasNans() || cell.m_ll.hasNans());
+
+   if(cell.m_linear)
+   {
+      // Allow for cells that minify: the tolerance is per view pixel there.
+      ossim_float64 scale = std::max((cell.m_ur - cell.m_ul).length(),
+                                     (cell.m_ll - cell.m_ul).length())/SIZE;
+      const ossim_float64 TOLERANCE = m_tolerance*std::max(scale, 1.0);
+
+      for(ossim_uint32 i = 4; (i < 9) && cell.m_linear; ++i)
+      {
+         const ossim_float64 U = POINTS[i][0];
+         const ossim_float64 V = POINTS[i][1];
+         const ossimDpt& exact = imagePts[i];
+         ossimDpt top    = cell.m_ul + (cell.m_ur - cell.m_ul)*U;
+         ossimDpt bottom = cell.m_ll + (cell.m_lr - cell.m_ll)*U;
+         cell.m_linear = !exact.hasNans() &&
+                         ((top + (bottom - top)*V - exact).length() <= TOLERANCE);
+      }
+   }
 
+   ++m_cellCount;
+   return m_cells[level].insert(std::make_pair(KEY, cell)).first->second;
+}
 
 void ossimImageRenderer::ossimRendererSubRectInfo::splitHorizontal(std::vector<ossimRendererSubRectInfo>& result)const
 {
@@ -72,6 +293,8 @@ void ossimImageRenderer::ossimRendererSubRectInfo::splitHorizontal(std::vector<o
 
    left.m_viewBounds = m_viewBounds;
    right.m_viewBounds = m_viewBounds;
+   left.m_grid = m_grid;
+   right.m_grid = m_grid;
 
    left.m_Vul = tempLeftRect.ul();
    left.m_Vur = tempLeftRect.ur();
@@ -88,7 +311,7 @@ void ossimImageRenderer::ossimRendererSubRectInfo::splitHorizontal(std::vector<o
 
    if(left.imageIsNan())
    {
-      if(left.m_viewBounds->intersects(left.getViewRect()))
+      if(left.m_viewBounds->intersectsRect(left.getViewRect()))
       {
          result.push_back(left);
       }
@@ -99,7 +322,7 @@ void ossimImageRenderer::ossimRendererSubRectInfo::splitHorizontal(std::vector<o
    }
    if(right.imageIsNan())
    {
-      if(right.m_viewBounds->intersects(right.getViewRect()))
+      if(right.m_viewBounds->intersectsRect(right.getViewRect()))
       {
          result.push_back(right);
       }
@@ -133,6 +356,8 @@ void ossimImageRenderer::ossimRendererSubRectInfo::splitVertical(std::vector<oss
 
    top.m_viewBounds    = m_viewBounds;
    bottom.m_viewBounds = m_viewBounds;
+   top.m_grid          = m_grid;
+   bottom.m_grid       = m_grid;
 
    top.m_Vul = tempTopRect.ul();
    top.m_Vur = tempTopRect.ur();
@@ -149,7 +374,7 @@ void ossimImageRenderer::ossimRendererSubRectInfo::splitVertical(std::vector<oss
 
    if(top.imageIsNan())
    {
-      if(top.m_viewBounds->intersects(top.getViewRect()))
+      if(top.m_viewBounds->intersectsRect(top.getViewRect()))
       {
          result.push_back(top);
       }
@@ -160,7 +385,7 @@ void ossimImageRenderer::ossimRendererSubRectInfo::splitVertical(std::vector<oss
    }
    if(bottom.imageIsNan())
    {
-      if(bottom.m_viewBounds->intersects(bottom.getViewRect()))
+      if(bottom.m_viewBounds->intersectsRect(bottom.getViewRect()))
       {
          result.push_back(bottom);
       }
@@ -223,6 +448,10 @@ void ossimImageRenderer::ossimRendererSubRectInfo::splitAll(std::vector<ossimRen
    ur.m_viewBounds = m_viewBounds;
    lr.m_viewBounds = m_viewBounds;
    ll.m_viewBounds = m_viewBounds;
+   ul.m_grid = m_grid;
+   ur.m_grid = m_grid;
+   lr.m_grid = m_grid;
+   ll.m_grid = m_grid;
 
    ul.transformViewToImage();
    ur.transformViewToImage();
@@ -231,7 +460,7 @@ void ossimImageRenderer::ossimRendererSubRectInfo::splitAll(std::vector<ossimRen
 
    if(ul.imageIsNan())
    {
-      if(ul.m_viewBounds->intersects(ul.getViewRect()))
+      if(ul.m_viewBounds->intersectsRect(ul.getViewRect()))
       {
          result.push_back(ul);
       }
@@ -242,7 +471,7 @@ void ossimImageRenderer::ossimRendererSubRectInfo::splitAll(std::vector<ossimRen
    }
    if(ur.imageIsNan())
    {
-      if(ur.m_viewBounds->intersects(ur.getViewRect()))
+      if(ur.m_viewBounds->intersectsRect(ur.getViewRect()))
       {
          result.push_back(ur);
       }
@@ -253,7 +482,7 @@ void ossimImageRenderer::ossimRendererSubRectInfo::splitAll(std::vector<ossimRen
    }
    if(lr.imageIsNan())
    {
-      if(lr.m_viewBounds->intersects(lr.getViewRect()))
+      if(lr.m_viewBounds->intersectsRect(lr.getViewRect()))
       {
          result.push_back(lr);
       }
@@ -264,7 +493,7 @@ void ossimImageRenderer::ossimRendererSubRectInfo::splitAll(std::vector<ossimRen
    }
    if(ll.imageIsNan())
    {
-      if(ll.m_viewBounds->intersects(ll.getViewRect()))
+      if(ll.m_viewBounds->intersectsRect(ll.getViewRect()))
       {
          result.push_back(ll);
       }
@@ -298,11 +527,12 @@ void ossimImageRenderer::ossimRendererSubRectInfo::splitView(std::vector<ossimRe
                               m_Vul, 
                               m_Vul);
       rect.m_viewBounds = m_viewBounds;
+      rect.m_grid = m_grid;
       rect.transformViewToImage();
 
       if(rect.imageIsNan())
       {
-        if(rect.m_viewBounds->intersects(rect.getViewRect()))
+        if(rect.m_viewBounds->intersectsRect(rect.getViewRect()))
         {
           result.push_back(rect);
         }
@@ -386,7 +616,7 @@ ossim_uint16 ossimImageRenderer::ossimRendererSubRectInfo::getSplitFlags()const
 
   if(imageIsNan())
   {
-    if(m_viewBounds->intersects(getViewRect()))
+    if(m_viewBounds->intersectsRect(getViewRect()))
     {
 //      result = SPLIT_ALL;
     }
@@ -401,7 +631,7 @@ ossim_uint16 ossimImageRenderer::ossimRendererSubRectInfo::getSplitFlags()const
     if(m_ulRoundTripError.hasNans()&&m_urRoundTripError.hasNans()&&
         m_lrRoundTripError.hasNans()&&m_llRoundTripError.hasNans())
     {
-      if(m_viewBounds->intersects(getViewRect()))
+      if(m_viewBounds->intersectsRect(getViewRect()))
       {
         result = SPLIT_ALL;
       }
@@ -463,6 +693,19 @@ ossim_uint16 ossimImageRenderer::ossimRendererSubRectInfo::getSplitFlags()const
   return result;
 }
 
+void ossimImageRenderer::ossimRendererSubRectInfo::viewToImage(const ossimDpt& viewPt,
+                                                               ossimDpt& imagePt)const
+{
+   if(m_grid)
+   {
+      m_grid->viewToImage(viewPt, imagePt);
+   }
+   else
+   {
+      m_transform->viewToImage(viewPt, imagePt);
+   }
+}
+
 void ossimImageRenderer::ossimRendererSubRectInfo::transformViewToImage()
 {
 //  std::cout << "TRANSFORM VIEW TO IMAGE!!!!!!!!!!!!!!\n";
@@ -471,10 +714,10 @@ void ossimImageRenderer::ossimRendererSubRectInfo::transformViewToImage()
    ossim_float64 w = vrect.width() - 1; // subtract 1 to prevent core dump in full-earth view rect
    ossim_float64 h = vrect.height();
 
-   m_transform->viewToImage(m_Vul, m_Iul);
-   m_transform->viewToImage(m_Vur, m_Iur);
-   m_transform->viewToImage(m_Vlr, m_Ilr);
-   m_transform->viewToImage(m_Vll, m_Ill);
+   viewToImage(m_Vul, m_Iul);
+   viewToImage(m_Vur, m_Iur);
+   viewToImage(m_Vlr, m_Ilr);
+   viewToImage(m_Vll, m_Ill);
 
 //  m_ulRoundTripError = m_transform->getRoundTripErrorView(m_Vul);
 //  m_urRoundTripError = m_transform->getRoundTripErrorView(m_Vur);
@@ -573,8 +816,21 @@ ossimDpt ossimImageRenderer::ossimRendererSubRectInfo::computeViewToImageScale(c
   ossimDpt result;
   result.makeNan();
   if(viewPt.hasNans()) return result; 
+
+  // Local Jacobian from the transform's grid, so no extra projections.
+  const ossimImageViewProjectionTransform* ivpt =
+     PTR_CAST(ossimImageViewProjectionTransform, m_transform.get());
+  ossimDpt jdx;
+  ossimDpt jdy;
+  if(ivpt && ivpt->getViewToImageJacobian(viewPt, jdx, jdy))
+  {
+     result.x = jdx.length();
+     result.y = jdy.length();
+     return result;
+  }
+
   ossimDpt ipt;
-  m_transform->viewToImage(viewPt, ipt);
+  viewToImage(viewPt, ipt);
 
   if(!ipt.isNan())
   {
@@ -588,8 +844,8 @@ ossimDpt ossimImageRenderer::ossimRendererSubRectInfo::computeViewToImageScale(c
     ossimDpt dx;
     ossimDpt dy;
 
-    m_transform->viewToImage(viewPt + ossimDpt(delta.x,0.0), dx);
-    m_transform->viewToImage(viewPt + ossimDpt(0.0,delta.y), dy);
+    viewToImage(viewPt + ossimDpt(delta.x,0.0), dx);
+    viewToImage(viewPt + ossimDpt(0.0,delta.y), dy);
     dx = dx-ipt;
     dy = dy-ipt;
 
@@ -765,29 +1021,29 @@ bool ossimImageRenderer::ossimRendererSubRectInfo::canBilinearInterpolate(double
     getImageMids(iUpper, iRight, iBottom, iLeft, iCenter);
     
     // get the model centers for the mid upper left right bottom
-    m_transform->viewToImage(vCenter, testCenter);
+    viewToImage(vCenter, testCenter);
 
     if(testCenter.hasNans())
     {
        return false;
     }
 
-    m_transform->viewToImage(vUpper, testUpper);
+    viewToImage(vUpper, testUpper);
     if(testCenter.hasNans())
     {
        return false;
     }
-    m_transform->viewToImage(vRight, testRight);
+    viewToImage(vRight, testRight);
     if(testRight.hasNans())
     {
        return false;
     }
-    m_transform->viewToImage(vBottom, testBottom);
+    viewToImage(vBottom, testBottom);
     if(testBottom.hasNans())
     {
        return false;
     }
-    m_transform->viewToImage(vLeft, testLeft);
+    viewToImage(vLeft, testLeft);
     if(testLeft.hasNans())
     {
        return false;
@@ -823,7 +1079,7 @@ bool ossimImageRenderer::ossimRendererSubRectInfo::canBilinearInterpolate(double
     ossimDpt iFullRes(iCenter.x*imageToViewScale.x,
           iCenter.y*imageToViewScale.y);
 
-    m_transform->viewToImage(vCenter, testCenter);
+    viewToImage(vCenter, testCenter);
 
     if(testCenter.hasNans())
     {
@@ -837,7 +1093,7 @@ bool ossimImageRenderer::ossimRendererSubRectInfo::canBilinearInterpolate(double
     iFullRes = ossimDpt(iUpper.x*imageToViewScale.x,
             iUpper.y*imageToViewScale.y);
 
-    m_transform->viewToImage(vUpper, testCenter);
+    viewToImage(vUpper, testCenter);
     if(testCenter.hasNans())
     {
        return false;
@@ -849,7 +1105,7 @@ bool ossimImageRenderer::ossimRendererSubRectInfo::canBilinearInterpolate(double
     iFullRes = ossimDpt(iRight.x*imageToViewScale.x,
             iRight.y*imageToViewScale.y);
 
-    m_transform->viewToImage(vRight, testCenter);
+    viewToImage(vRight, testCenter);
     if(testCenter.hasNans())
     {
        return false;
@@ -861,7 +1117,7 @@ bool ossimImageRenderer::ossimRendererSubRectInfo::canBilinearInterpolate(double
     iFullRes = ossimDpt(iBottom.x*imageToViewScale.x,
             iBottom.y*imageToViewScale.y);
 
-    m_transform->viewToImage(vBottom, testCenter);
+    viewToImage(vBottom, testCenter);
     if(testCenter.hasNans())
     {
        return false;
@@ -873,7 +1129,7 @@ bool ossimImageRenderer::ossimRendererSubRectInfo::canBilinearInterpolate(double
     iFullRes = ossimDpt(iLeft.x*imageToViewScale.x,
             iLeft.y*imageToViewScale.y);
 
-    m_transform->viewToImage(vLeft, testCenter);
+    viewToImage(vLeft, testCenter);
     testFullRes = ossimDpt(testCenter.x*imageToViewScale.x,
          testCenter.y*imageToViewScale.y);
     double errorCheck5 = (testFullRes - iFullRes).length();
@@ -963,11 +1219,20 @@ m_viewRect(),
 m_rectsDirty(true),
 m_MaxRecursionLevel(5),
 m_AutoUpdateInputTransform(true),
-m_MaxLevelsToCompute(999999) // something large so it will always compute
+m_MaxLevelsToCompute(999999), // something large so it will always compute
+m_resampleThreads(1),
+m_deferResamples(false),
+m_resampleJobs(),
+m_resampleQueue(0)
 {
     ossimViewInterface::theObject = this;
     m_Resampler = new ossimFilterResampler();
     m_ImageViewTransform = new ossimImageViewProjectionTransform;
+    const char* lookup = ossimPreferences::instance()->findPreference("renderer.resample_threads");
+    if(lookup)
+    {
+       setNumberOfResampleThreads(ossimString(lookup).toUInt32());
+    }
 }
 
 ossimImageRenderer::ossimImageRenderer(ossimImageSource* inputSource,
@@ -985,7 +1250,11 @@ ossimImageRenderer::ossimImageRenderer(ossimImageSource* inputSource,
      m_rectsDirty(true),
      m_MaxRecursionLevel(5),
      m_AutoUpdateInputTransform(true),
-     m_MaxLevelsToCompute(999999) // something large so it will always compute
+     m_MaxLevelsToCompute(999999), // something large so it will always compute
+     m_resampleThreads(1),
+     m_deferResamples(false),
+     m_resampleJobs(),
+     m_resampleQueue(0)
 {
    ossimViewInterface::theObject = this;
    m_Resampler = new ossimFilterResampler();
@@ -993,10 +1262,17 @@ ossimImageRenderer::ossimImageRenderer(ossimImageSource* inputSource,
    {
       m_ImageViewTransform = new ossimImageViewProjectionTransform;
    }
+   const char* lookup = ossimPreferences::instance()->findPreference("renderer.resample_threads");
+   if(lookup)
+   {
+      setNumberOfResampleThreads(ossimString(lookup).toUInt32());
+   }
 }
 
 ossimImageRenderer::~ossimImageRenderer()
 {
+  m_resampleJobs.clear();
+  m_resampleQueue = 0;
   m_ImageViewTransform = 0;
 
    if(m_Resampler)
@@ -1012,12 +1288,8 @@ ossimRefPtr<ossimImageData> ossimImageRenderer::getTile(
 {
   // std::cout << "_________________________\n";
    static const char MODULE[] = "ossimImageRenderer::getTile";
-   if(traceDebug())
-   {
-      ossimNotify(ossimNotifyLevel_DEBUG)
-         << MODULE << " Requesting view rect = "
-         << tileRect << endl;
-   }
+   OSSIM_TRACE_SPAN_VALUE(traceSpan, "ossimImageRenderer::getTile", resLevel);
+   OSSIM_TRACE(traceDebug, MODULE << " Requesting view rect = " << tileRect);
 
    // long w = tileRect.width();
    // long h = tileRect.height();
@@ -1028,7 +1300,7 @@ ossimRefPtr<ossimImageData> ossimImageRenderer::getTile(
       allocate();
       if ( !m_BlankTile.valid() || !m_Tile.valid() )
       {
-         if(traceDebug())
+         if(OSSIM_TRACE_ENABLED(traceDebug))
          {
             ossimNotify(ossimNotifyLevel_WARN)
                << "ossimImageRenderer::getTile tile allocation failure!\n"
@@ -1070,11 +1342,7 @@ ossimRefPtr<ossimImageData> ossimImageRenderer::getTile(
 
    if( !theInputConnection || !m_viewRect.intersects(tileRect) )
    {
-      if(traceDebug())
-      {
-         ossimNotify(ossimNotifyLevel_DEBUG)
-            << MODULE << "No intersection, Returning...." << endl;
-      }
+      OSSIM_TRACE(traceDebug, MODULE << "No intersection, Returning....");
       return m_BlankTile;
    }
    
@@ -1085,6 +1353,12 @@ ossimRefPtr<ossimImageData> ossimImageRenderer::getTile(
 
    // long tw = m_Tile->getWidth();
    // long th = m_Tile->getHeight();
+
+   // The transform may have been replaced without a bounding rect update, e.g. by loadState.
+   if ( m_transformGrid.getTransform() != m_ImageViewTransform.get() )
+   {
+      m_transformGrid.reset(m_ImageViewTransform.get());
+   }
    
    m_Tile->setImageRectangle(tileRect);
    m_Tile->makeBlank();
@@ -1118,17 +1392,14 @@ ossimRefPtr<ossimImageData> ossimImageRenderer::getTile(
 
 #endif
    subRectInfo.m_viewBounds = &m_viewArea;
+   subRectInfo.m_grid = &m_transformGrid;
    subRectInfo.transformViewToImage();
 
-   if((!m_viewArea.intersects(subRectInfo.getViewRect())))
+   if((!m_viewArea.intersectsRect(subRectInfo.getViewRect())))
    {
      return m_BlankTile;
    }
-   if(traceDebug())
-   {
-      ossimNotify(ossimNotifyLevel_DEBUG)
-         << MODULE << " image rect = " << subRectInfo.getImageRect() << std::endl;
-   }
+   OSSIM_TRACE(traceDebug, MODULE << " image rect = " << subRectInfo.getImageRect());
 
    // If the image rect is completely outside of the valid image, there is no need to resample:
    // (OLK 11/18)
@@ -1136,17 +1407,19 @@ ossimRefPtr<ossimImageData> ossimImageRenderer::getTile(
 //   {
 //      return m_Tile;
 //   }
+   m_deferResamples = (m_resampleThreads > 1);
    recursiveResample(m_Tile, subRectInfo, 1);
+   if(m_deferResamples)
+   {
+      flushResampleJobs();
+      m_deferResamples = false;
+   }
    
    if(m_Tile.valid())
    {
       m_Tile->validate();
    }
-   if(traceDebug())
-   {
-      ossimNotify(ossimNotifyLevel_DEBUG)
-         << MODULE << "Returning...." << endl;
-   }
+   OSSIM_TRACE(traceDebug, MODULE << "Returning....");
    return m_Tile;
 }
 
@@ -1182,6 +1455,11 @@ void ossimImageRenderer::recursiveResample(ossimRefPtr<ossimImageData> outputDat
    // std::cout << "SPLITTING " << level << ", " << tempViewRect << "\n";
     for(idx = 0; idx < splitRects.size();++idx)
     {
+      if((level == 0) && ossimJob::isCurrentJobCanceled())
+      {
+         // Tile no longer wanted, leave the rest blank.
+         break;
+      }
       recursiveResample(outputData,
                         splitRects[idx],
                         level + 1);
@@ -1199,6 +1477,7 @@ void ossimImageRenderer::recursiveResample(ossimRefPtr<ossimImageData> outputDat
 void ossimImageRenderer::fillTile(ossimRefPtr<ossimImageData> outputData,
                                   const ossimRendererSubRectInfo& rectInfo)
 {
+   OSSIM_TRACE_SPAN(traceSpan, "ossimImageRenderer::fillTile");
    if(!outputData.valid() || !outputData->getBuf() || rectInfo.imageHasNans())
    {
       return;
@@ -1357,20 +1636,76 @@ void ossimImageRenderer::fillTile(ossimRefPtr<ossimImageData> outputData,
   //std::cout << "VIEW RECT: " << outputData->getImageRectangle() << std::endl;
 
 
-     m_Resampler->resample(data,
-                           outputData,
-                           vrect,
-                           nul,
-                           nur,
-                           ossimDpt( ( (nll.x - nul.x)/denominatorY ),
-                                     ( (nll.y - nul.y)/denominatorY ) ),
-                           ossimDpt( ( (nlr.x - nur.x)/denominatorY ),
-                                     ( (nlr.y - nur.y)/denominatorY ) ),
-                           tile_size);
+     if(m_deferResamples)
+     {
+        m_resampleJobs.push_back(
+           new ossimRendererResampleJob(m_Resampler,
+                                        (ossimImageData*)data->dup(),
+                                        outputData,
+                                        vrect,
+                                        nul,
+                                        nur,
+                                        ossimDpt( ( (nll.x - nul.x)/denominatorY ),
+                                                  ( (nll.y - nul.y)/denominatorY ) ),
+                                        ossimDpt( ( (nlr.x - nur.x)/denominatorY ),
+                                                  ( (nlr.y - nur.y)/denominatorY ) ),
+                                        tile_size));
+
+        // Bound the input copies held at once.
+        if(m_resampleJobs.size() >= 4*m_resampleThreads)
+        {
+           flushResampleJobs();
+        }
+     }
+     else
+     {
+        m_Resampler->resample(data,
+                              outputData,
+                              vrect,
+                              nul,
+                              nur,
+                              ossimDpt( ( (nll.x - nul.x)/denominatorY ),
+                                        ( (nll.y - nul.y)/denominatorY ) ),
+                              ossimDpt( ( (nlr.x - nur.x)/denominatorY ),
+                                        ( (nlr.y - nur.y)/denominatorY ) ),
+                              tile_size);
+     }
    }
    
 }
 
+void ossimImageRenderer::flushResampleJobs()
+{
+   if(m_resampleJobs.empty())
+   {
+      return;
+   }
+   if(!m_resampleQueue.valid())
+   {
+      m_resampleQueue = new ossimJobMultiThreadQueue(0, m_resampleThreads);
+   }
+
+   ossimRefPtr<ossimRendererResampleBatch> batch =
+      new ossimRendererResampleBatch((ossim_uint32)m_resampleJobs.size());
+   std::vector< ossimRefPtr<ossimJob> >::iterator iter = m_resampleJobs.begin();
+   while(iter != m_resampleJobs.end())
+   {
+      ossimRendererResampleJob* job = static_cast<ossimRendererResampleJob*>(iter->get());
+      job->setBatch(batch.get());
+
+      // Clear the output's cached status here so the workers never write it.
+      job->getOutput()->invalidateStatus();
+      ++iter;
+   }
+   ossimJobQueue* queue = m_resampleQueue->getJobQueue();
+   for(iter = m_resampleJobs.begin(); iter != m_resampleJobs.end(); ++iter)
+   {
+      queue->add(iter->get(), false);
+   }
+   batch->wait();
+   m_resampleJobs.clear();
+}
+
 long ossimImageRenderer::computeClosestResLevel(const std::vector<ossimDpt>& decimationFactors,
                                                 double scale)const
 {
@@ -1452,6 +1787,15 @@ void ossimImageRenderer::getBoundingRect(ossimIrect& rect, ossim_uint32 resLevel
 void ossimImageRenderer::initializeBoundingRects()
 {
    m_rectsDirty = true;
+
+   // Any view to image points and Jacobians cached so far are stale.
+   m_transformGrid.reset(m_ImageViewTransform.get());
+   ossimImageViewProjectionTransform* ivpt =
+      PTR_CAST(ossimImageViewProjectionTransform, m_ImageViewTransform.get());
+   if ( ivpt )
+   {
+      ivpt->invalidateJacobianGrid();
+   }
    
    // Get the input bounding rect:
    if ( theInputConnection && m_ImageViewTransform.valid())
@@ -1615,6 +1959,9 @@ bool ossimImageRenderer::saveState(ossimKeywordlist& kwl,
    kwl.add(prefix,
            "max_levels_to_compute",
            m_MaxLevelsToCompute);
+   kwl.add(prefix,
+           "resample_threads",
+           m_resampleThreads);
    
    return ossimImageSource::saveState(kwl, prefix);
 }
@@ -1653,6 +2000,12 @@ bool ossimImageRenderer::loadState(const ossimKeywordlist& kwl,
    {
       m_MaxLevelsToCompute = ossimString(maxLevelsToCompute).toUInt32();
    }
+   const char* resampleThreads = kwl.find(prefix,
+                                          "resample_threads");
+   if(resampleThreads)
+   {
+      setNumberOfResampleThreads(ossimString(resampleThreads).toUInt32());
+   }
    
    return result;
 }
@@ -1754,6 +2107,64 @@ ossimRefPtr<ossimImageGeometry> ossimImageRenderer::getImageGeometry()
    return ossimRefPtr<ossimImageGeometry>();
 }
 
+ossimImageSource* ossimImageRenderer::cloneSource() const
+{
+   ossimImageRenderer* result = new ossimImageRenderer;
+   copySourceSettings(result);
+
+   // The transform's copy references the same geometries:
+   if (m_ImageViewTransform.valid())
+   {
+      result->m_ImageViewTransform =
+         PTR_CAST(ossimImageViewTransform, m_ImageViewTransform->dup());
+      if (!result->m_ImageViewTransform.valid())
+         result->m_ImageViewTransform = new ossimImageViewProjectionTransform;
+   }
+   else
+   {
+      result->m_ImageViewTransform = 0;
+   }
+
+   if (m_Resampler && result->m_Resampler)
+   {
+      result->m_Resampler->setScaleFactor(m_Resampler->getScaleFactor());
+      result->m_Resampler->setMinifyFilterType(m_Resampler->getMinifyFilterTypeAsString());
+      result->m_Resampler->setMagnifyFilterType(m_Resampler->getMagnifyFilterTypeAsString());
+      result->m_Resampler->setBlurFactor(m_Resampler->getBlurFactor());
+   }
+   result->m_StartingResLevel         = m_StartingResLevel;
+   result->m_MaxRecursionLevel        = m_MaxRecursionLevel;
+   result->m_AutoUpdateInputTransform = m_AutoUpdateInputTransform;
+   result->m_MaxLevelsToCompute       = m_MaxLevelsToCompute;
+   result->m_deferResamples           = m_deferResamples;
+   result->setNumberOfResampleThreads(m_resampleThreads);
+   return result;
+}
+
+void ossimImageRenderer::shareReadOnlyState(ossimImageSource* source)
+{
+   ossimImageRenderer* original = PTR_CAST(ossimImageRenderer, source);
+   if (!original || (original == this))
+      return;
+
+   //---
+   // Reference the original's image and view geometries (projections, sensor models) rather than
+   // the copies loaded from its state. They are only read while rendering; the input image
+   // geometry is already shared when the image handlers are.
+   //---
+   ossimImageViewProjectionTransform* ivpt =
+      PTR_CAST(ossimImageViewProjectionTransform, m_ImageViewTransform.get());
+   ossimImageViewProjectionTransform* originalIvpt =
+      PTR_CAST(ossimImageViewProjectionTransform, original->m_ImageViewTransform.get());
+   if (ivpt && originalIvpt)
+   {
+      if (originalIvpt->getImageGeometry())
+         ivpt->setImageGeometry(originalIvpt->getImageGeometry());
+      if (originalIvpt->getViewGeometry())
+         ivpt->setViewGeometry(originalIvpt->getViewGeometry());
+   }
+}
+
 void ossimImageRenderer::connectInputEvent(ossimConnectionEvent& /* event */)
 {
    theInputConnection = PTR_CAST(ossimImageSource, getInput(0));
@@ -2099,6 +2510,10 @@ ossimRefPtr<ossimImageData>  ossimImageRenderer::getTileAtResLevel(const ossimIr
       ossimIrect boundingRect = theInputConnection->getBoundingRect(levels-1);
       for(yIndex = requestedRectAtValidRLevel.ul().y;yIndex < requestedRectAtValidRLevel.lr().y; yIndex += tileSize.y)
       {
+         if(ossimJob::isCurrentJobCanceled())
+         {
+            break;
+         }
          for(xIndex = requestedRectAtValidRLevel.ul().x; xIndex < requestedRectAtValidRLevel.lr().x; xIndex+=tileSize.x)
          {
             ossimIrect request(xIndex,
@@ -2183,6 +2598,27 @@ ossim_uint32 ossimImageRenderer::getMaxLevelsToCompute()const
    return m_MaxLevelsToCompute;
 }
 
+void ossimImageRenderer::setNumberOfResampleThreads(ossim_uint32 threads)
+{
+   m_resampleThreads = threads ? threads : 1;
+   if(m_resampleQueue.valid())
+   {
+      if(m_resampleThreads > 1)
+      {
+         m_resampleQueue->setNumberOfThreads(m_resampleThreads);
+      }
+      else
+      {
+         m_resampleQueue = 0;
+      }
+   }
+}
+
+ossim_uint32 ossimImageRenderer::getNumberOfResampleThreads()const
+{
+   return m_resampleThreads;
+}
+
 template <class T>
 void ossimImageRenderer::resampleTileToDecimation(T /* dummyVariable */,
 						  ossimRefPtr<ossimImageData> result,
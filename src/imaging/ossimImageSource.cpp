@@ -10,8 +10,12 @@
 // $Id: ossimImageSource.cpp 23100 2015-01-26 19:43:08Z okramer $
 
 #include <ossim/imaging/ossimImageSource.h>
+#include <ossim/imaging/ossimDeferredInitializeScope.h>
 #include <ossim/base/ossimProperty.h>
 #include <ossim/base/ossimKeywordNames.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimIdManager.h>
+#include <ossim/base/ossimObjectFactoryRegistry.h>
 
 RTTI_DEF1(ossimImageSource,
           "ossimImageSource" ,
@@ -35,6 +39,7 @@ ossimImageSource::ossimImageSource(ossimObject* owner,
 
 ossimImageSource::~ossimImageSource()
 {
+   ossimDeferredInitializeScope::cancel(this);
 }
 
 ossimRefPtr<ossimImageData> ossimImageSource::getTile(const ossimIpt& origin,
@@ -366,6 +371,52 @@ bool ossimImageSource::isIndexedData() const
    return result;
 }
 
+void ossimImageSource::shareReadOnlyState(ossimImageSource* /* source */)
+{
+}
+
+void ossimImageSource::requestInitialize()
+{
+   if ( !ossimDeferredInitializeScope::defer(this) )
+   {
+      initialize();
+   }
+}
+
+ossimImageSource* ossimImageSource::cloneSource() const
+{
+   ossimKeywordlist kwl;
+   if ( !saveState(kwl) )
+   {
+      return 0;
+   }
+
+   ossimRefPtr<ossimObject> obj = ossimObjectFactoryRegistry::instance()->createObject(kwl);
+   ossimImageSource* result = dynamic_cast<ossimImageSource*>( obj.get() );
+   if ( !result )
+   {
+      return 0;
+   }
+
+   // The copy was loaded with this object's id; inputs are left unconnected.
+   result->setId( ossimIdManager::instance()->generateId() );
+   result->shareReadOnlyState( const_cast<ossimImageSource*>(this) );
+   obj.release();
+   return result;
+}
+
+void ossimImageSource::copySourceSettings(ossimImageSource* clone) const
+{
+   if ( clone )
+   {
+      clone->theEnableFlag            = theEnableFlag;
+      clone->theDescription           = theDescription;
+      clone->theInputListIsFixedFlag  = theInputListIsFixedFlag;
+      clone->theOutputListIsFixedFlag = theOutputListIsFixedFlag;
+      clone->setNumberOfInputs( (ossim_int32)theInputObjectList.size() );
+   }
+}
+
 // Protected to hide from use...
 ossimImageSource::ossimImageSource (const ossimImageSource& /* rhs */)
    :ossimSource() 
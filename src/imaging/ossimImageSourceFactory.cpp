@@ -20,6 +20,7 @@
 #include <ossim/imaging/ossimImageGaussianFilter.h>
 #include <ossim/imaging/ossimImageRenderer.h>
 #include <ossim/imaging/ossimCacheTileSource.h>
+#include <ossim/imaging/ossimChainProfiler.h>
 #include <ossim/imaging/ossimFeatherMosaic.h>
 #include <ossim/imaging/ossimHistogramRemapper.h>
 #include <ossim/imaging/ossimNullPixelFlip.h>
@@ -33,6 +34,7 @@
 #include <ossim/imaging/ossimLocalCorrelationFusion.h>
 #include <ossim/imaging/ossimSFIMFusion.h>
 #include <ossim/imaging/ossimTopographicCorrectionFilter.h>
+#include <ossim/imaging/ossimTerrainDerivativeSource.h>
 #include <ossim/imaging/ossimBandSelector.h>
 #include <ossim/imaging/ossimNBandToIndexFilter.h>
 #include <ossim/imaging/ossimRgbToGreyFilter.h>
@@ -377,6 +379,10 @@ ossimObject* ossimImageSourceFactory::createObject(const ossimString& name)const
    {
       return new ossimImageToPlaneNormalFilter();
    }
+   else if(name == STATIC_TYPE_NAME(ossimTerrainDerivativeSource))
+   {
+      return new ossimTerrainDerivativeSource();
+   }
    else if(name == STATIC_TYPE_NAME(ossimTopographicCorrectionFilter))
    {
       return new ossimTopographicCorrectionFilter();
@@ -439,6 +445,11 @@ ossimObject* ossimImageSourceFactory::createObject(const ossimString& name)const
    {
       return new ossimDilationFilter();
    }
+   else if(name == STATIC_TYPE_NAME(ossimChainProfilerProbe))
+   {
+      // Pass through timing of its input, see ossimChainProfiler.
+      return new ossimChainProfilerProbe;
+   }
    return NULL;
 }
 
@@ -558,6 +569,7 @@ void ossimImageSourceFactory::getTypeNameList(std::vector<ossimString>& typeList
    typeList.push_back(STATIC_TYPE_NAME(ossimPixelFlipper));
    typeList.push_back(STATIC_TYPE_NAME(ossimScaleFilter));
    typeList.push_back(STATIC_TYPE_NAME(ossimImageToPlaneNormalFilter));
+   typeList.push_back(STATIC_TYPE_NAME(ossimTerrainDerivativeSource));
    typeList.push_back(STATIC_TYPE_NAME(ossimTopographicCorrectionFilter));
    typeList.push_back(STATIC_TYPE_NAME(ossimLandsatTopoCorrectionFilter));
    typeList.push_back(STATIC_TYPE_NAME(ossimAtCorrRemapper));
@@ -573,6 +585,7 @@ void ossimImageSourceFactory::getTypeNameList(std::vector<ossimString>& typeList
    typeList.push_back(STATIC_TYPE_NAME(ossimImageSourceFilter));
    typeList.push_back(STATIC_TYPE_NAME(ossimMemoryImageSource));
    typeList.push_back(STATIC_TYPE_NAME(ossimDilationFilter));
+   typeList.push_back(STATIC_TYPE_NAME(ossimChainProfilerProbe));
 }
 
 // Hide from use...
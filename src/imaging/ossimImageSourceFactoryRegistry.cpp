@@ -11,6 +11,8 @@
 #include <ossim/imaging/ossimImageSourceFactory.h>
 #include <ossim/imaging/ossimImageReconstructionFilterRegistry.h>
 #include <ossim/base/ossimString.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimKeywordNames.h>
 
 ossimImageSourceFactoryRegistry* ossimImageSourceFactoryRegistry::theInstance = NULL;
 
@@ -44,10 +46,23 @@ ossimObject* ossimImageSourceFactoryRegistry::createObject(const ossimString& na
    ossimObject*                   result = NULL;
    std::vector<ossimImageSourceFactoryBase*>::const_iterator factory;
 
+   ossimImageSourceFactoryBase* cached = theTypeNameCache.find(name);
+   if(cached)
+   {
+      result = cached->createObject(name);
+   }
+
    factory = theFactoryList.begin();
    while((factory != theFactoryList.end()) && !result)
    {
-     result = (*factory)->createObject(name);
+     if(*factory != cached)
+     {
+        result = (*factory)->createObject(name);
+        if(result)
+        {
+           theTypeNameCache.insert(name, *factory);
+        }
+     }
      ++factory;
    }
    
@@ -60,10 +75,24 @@ ossimObject* ossimImageSourceFactoryRegistry::createObject(const ossimKeywordlis
    ossimObject*                   result = NULL;
    std::vector<ossimImageSourceFactoryBase*>::const_iterator factory;
 
+   const ossimString TYPE = kwl.find(prefix, ossimKeywordNames::TYPE_KW);
+   ossimImageSourceFactoryBase* cached = theStateTypeCache.find(TYPE);
+   if(cached)
+   {
+      result = cached->createObject(kwl, prefix);
+   }
+
    factory = theFactoryList.begin();
    while((factory != theFactoryList.end()) && !result)
    {
-     result = (*factory)->createObject(kwl, prefix);
+     if(*factory != cached)
+     {
+        result = (*factory)->createObject(kwl, prefix);
+        if(result)
+        {
+           theStateTypeCache.insert(TYPE, *factory);
+        }
+     }
      ++factory;
    }
    
@@ -95,6 +124,8 @@ void ossimImageSourceFactoryRegistry::registerFactory(ossimImageSourceFactoryBas
   if(factory&&!findFactory(factory))
   {
      theFactoryList.push_back(factory);
+     theTypeNameCache.clear();
+     theStateTypeCache.clear();
   }
 }
 
@@ -106,6 +137,8 @@ void ossimImageSourceFactoryRegistry::unregisterFactory(ossimImageSourceFactoryB
    if(iter != theFactoryList.end())
    {
       theFactoryList.erase(iter);
+      theTypeNameCache.clear();
+      theStateTypeCache.clear();
    }
 }
 
@@ -133,7 +133,7 @@ void ossimImageSourceFilter::connectInputEvent(ossimConnectionEvent& /* event */
        }
     }
   theInputConnection = PTR_CAST(ossimImageSource, getInput(0));
-  initialize();
+  requestInitialize();
   if(traceDebug())
   {
      if(theInputConnection)
@@ -154,7 +154,7 @@ void ossimImageSourceFilter::disconnectInputEvent(ossimConnectionEvent& /* event
       ossimNotify(ossimNotifyLevel_DEBUG) << "ossimImageSourceFilter::disconnectInputEvent" << std::endl;
    }
    theInputConnection = PTR_CAST(ossimImageSource, getInput(0));
-   initialize();
+   requestInitialize();
    if(traceDebug())
    {
       ossimNotify(ossimNotifyLevel_DEBUG) << "Leaving ossimImageSourceFilter::disconnectInput" << std::endl;
@@ -166,7 +166,7 @@ void ossimImageSourceFilter::propertyEvent(ossimPropertyEvent& /* event */)
    {
       ossimNotify(ossimNotifyLevel_DEBUG) << "ossimImageSourceFilter::propertyEvent DEBUG: Entering..." << std::endl;
    }
-   initialize();
+   requestInitialize();
    
    if(traceDebug())
    {
@@ -180,7 +180,7 @@ void ossimImageSourceFilter::refreshEvent(ossimRefreshEvent& /* event */)
    {
       ossimNotify(ossimNotifyLevel_DEBUG) << "ossimImageSourceFilter::refreshEvent " << std::endl;
    }
-   initialize();
+   requestInitialize();
    
    if(traceDebug())
    {
@@ -16,15 +16,145 @@
 #include <ossim/base/ossimConstants.h>
 #include <ossim/base/ossimDrect.h>
 #include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossimTrace.h>
+#include <ossim/base/ossimVisitor.h>
 #include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageDataAccounting.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/imaging/ossimImageWriter.h>
+#include <OpenThreads/Condition>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <algorithm>
+#include <deque>
 
 RTTI_DEF2(ossimImageSourceSequencer, "ossimImageSourceSequencer",
           ossimImageSource, ossimConnectableObjectListener);
 
 static ossimTrace traceDebug("ossimImageSourceSequencer:debug");
+
+//---
+// Fetches the tiles of a sequence in order, from firstId, into a queue of at most depth tiles
+// that getNextTile pops. Tiles are copies since the chain reuses its tile buffers.
+//---
+class ossimImageSourceSequencer::Pipeline : public OpenThreads::Thread
+{
+public:
+   Pipeline(ossimImageSourceSequencer* sequencer,
+            ossim_int64 firstId,
+            ossim_uint32 resLevel,
+            ossim_uint32 depth)
+      : theSequencer(sequencer),
+        theNextId(firstId),
+        theResLevel(resLevel),
+        theDepth(depth),
+        theTiles(),
+        theMutex(),
+        theTileReady(),
+        theSpaceReady(),
+        theDoneFlag(false),
+        theStopFlag(false)
+   {
+   }
+
+   virtual ~Pipeline()
+   {
+      stop();
+   }
+
+   ossim_uint32 getResLevel() const
+   {
+      return theResLevel;
+   }
+
+   /** @return Next tile, null past the end of the sequence. */
+   ossimRefPtr<ossimImageData> pop()
+   {
+      ossimRefPtr<ossimImageData> result = 0;
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+      while ( theTiles.empty() && !theDoneFlag )
+      {
+         theTileReady.wait(&theMutex);
+      }
+      if ( !theTiles.empty() )
+      {
+         result = theTiles.front();
+         theTiles.pop_front();
+         theSpaceReady.signal();
+      }
+      return result;
+   }
+
+   void stop()
+   {
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+         theStopFlag = true;
+         theSpaceReady.signal();
+      }
+      if ( isRunning() )
+      {
+         join();
+      }
+   }
+
+   virtual void run()
+   {
+      ossimIrect tileRect;
+      while ( !theStopFlag && theSequencer->getTileRect( theNextId, tileRect ) )
+      {
+         if ( theSequencer->thePrefetchTiles )
+         {
+            theSequencer->prefetchTiles( theNextId + 1,
+                                         theNextId + 1 + theSequencer->thePrefetchTiles,
+                                         theResLevel );
+         }
+         ++theNextId;
+         ossimRefPtr<ossimImageData> tile =
+            theSequencer->theInputConnection->getTile(tileRect, theResLevel);
+         if( tile.valid() && tile->getBuf() )
+         {
+            tile = (ossimImageData*)tile->dup();
+         }
+         else
+         {
+            tile = (ossimImageData*)theSequencer->theBlankTile->dup();
+            tile->setImageRectangle(tileRect);
+         }
+
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+         // Over the ossimImageData memory budget hold one tile at a time:
+         while ( ( (theTiles.size() >= theDepth) ||
+                   ( !theTiles.empty() &&
+                     ossimImageDataAccounting::instance()->isOverBudget() ) ) &&
+                 !theStopFlag )
+         {
+            theSpaceReady.wait(&theMutex);
+         }
+         theTiles.push_back(tile);
+         theTileReady.signal();
+      }
+
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+      theDoneFlag = true;
+      theTileReady.signal();
+   }
+
+private:
+   ossimImageSourceSequencer*                theSequencer;
+   ossim_int64                               theNextId;
+   ossim_uint32                              theResLevel;
+   ossim_uint32                              theDepth;
+   std::deque< ossimRefPtr<ossimImageData> > theTiles;
+   OpenThreads::Mutex                        theMutex;
+   OpenThreads::Condition                    theTileReady;
+   OpenThreads::Condition                    theSpaceReady;
+   bool                                      theDoneFlag;
+   volatile bool                             theStopFlag;
+};
    
 ossimImageSourceSequencer::ossimImageSourceSequencer(ossimImageSource* inputSource,
                                                      ossimObject* owner)
@@ -38,8 +168,19 @@ ossimImageSourceSequencer::ossimImageSourceSequencer(ossimImageSource* inputSour
     theTileSize(OSSIM_DEFAULT_TILE_WIDTH, OSSIM_DEFAULT_TILE_HEIGHT),
     theNumberOfTilesHorizontal(0),
     theNumberOfTilesVertical(0),
-    theCurrentTileNumber(0)
-{
+    theCurrentTileNumber(0),
+    thePrefetchTiles(8),
+    thePrefetchEnd(0),
+    thePrefetchHandlers(0),
+    theOrderedOutputFlag(true),
+    thePipelineTiles(0),
+    thePipeline(0)
+{
+   const char* lookup = ossimPreferences::instance()->findPreference("sequencer.prefetch_tiles");
+   if ( lookup )
+   {
+      thePrefetchTiles = ossimString(lookup).toUInt32();
+   }
    ossim::defaultTileSize(theTileSize);
    theAreaOfInterest.makeNan();
    theInputConnection    = inputSource;
@@ -53,6 +194,7 @@ ossimImageSourceSequencer::ossimImageSourceSequencer(ossimImageSource* inputSour
 
 ossimImageSourceSequencer::~ossimImageSourceSequencer()
 {
+   stopPipeline();
    removeListener((ossimConnectableObjectListener*)this);
 }
 
@@ -101,6 +243,9 @@ void ossimImageSourceSequencer::setTileSize(ossim_int32 width, ossim_int32 heigh
 
 void ossimImageSourceSequencer::updateTileDimensions()
 {
+   // Tiles queued ahead are for the old layout:
+   stopPipeline();
+
    bool status = false;
    if( !theAreaOfInterest.hasNans() && !theTileSize.hasNans() )
    {
@@ -158,6 +303,7 @@ void ossimImageSourceSequencer::initialize()
          theBlankTile->initialize();
       }
    }
+   findPrefetchHandlers(theInputConnection);
 }
 
 bool ossimImageSourceSequencer::canConnectMyInputTo(ossim_int32 /* inputIndex */,
@@ -174,6 +320,7 @@ void ossimImageSourceSequencer::connectInputEvent(ossimConnectionEvent& /* event
 void ossimImageSourceSequencer::disconnectInputEvent(ossimConnectionEvent& /* event */)
 {
    theInputConnection = PTR_CAST(ossimImageSource, getInput(0));
+   findPrefetchHandlers(theInputConnection);
 }
 
 ossimIrect ossimImageSourceSequencer::getBoundingRect(ossim_uint32 resLevel)const
@@ -240,7 +387,9 @@ const ossimIrect& ossimImageSourceSequencer::getAreaOfInterest()const
 
 void ossimImageSourceSequencer::setToStartOfSequence()
 {
+   stopPipeline();
    theCurrentTileNumber = 0;
+   thePrefetchEnd = 0;
 }
 
 ossimRefPtr<ossimImageData> ossimImageSourceSequencer::getTile(
@@ -268,11 +417,34 @@ ossimRefPtr<ossimImageData> ossimImageSourceSequencer::getTile(
 ossimRefPtr<ossimImageData> ossimImageSourceSequencer::getNextTile( ossim_uint32 resLevel )
 {
    ossimRefPtr<ossimImageData> result = 0;
-   if ( theInputConnection )
+   if ( theInputConnection && thePipelineTiles && theBlankTile.valid() )
+   {
+      // Start fetching ahead from the current tile (restart on a resolution change):
+      if ( thePipeline && (thePipeline->getResLevel() != resLevel) )
+      {
+         stopPipeline();
+      }
+      if ( !thePipeline )
+      {
+         thePipeline = new Pipeline(this, theCurrentTileNumber, resLevel, thePipelineTiles);
+         thePipeline->start();
+      }
+      result = thePipeline->pop();
+      if ( result.valid() )
+      {
+         ++theCurrentTileNumber;
+      }
+   }
+   else if ( theInputConnection )
    {
       ossimIrect tileRect;
       if ( getTileRect( theCurrentTileNumber, tileRect ) )
       {
+         if ( thePrefetchTiles )
+         {
+            prefetchTiles( theCurrentTileNumber + 1,
+                           theCurrentTileNumber + 1 + thePrefetchTiles, resLevel );
+         }
          ++theCurrentTileNumber;
          result = theInputConnection->getTile(tileRect, resLevel);
          if( !result.valid() || !result->getBuf() )
@@ -445,4 +617,125 @@ bool ossimImageSourceSequencer::isMaster() const
    return true;
 }
 
+void ossimImageSourceSequencer::setPrefetchTiles(ossim_uint32 count)
+{
+   thePrefetchTiles = count;
+   findPrefetchHandlers(theInputConnection);
+}
+
+ossim_uint32 ossimImageSourceSequencer::getPrefetchTiles() const
+{
+   return thePrefetchTiles;
+}
+
+void ossimImageSourceSequencer::setOrderedOutput(bool flag)
+{
+   theOrderedOutputFlag = flag;
+}
+
+bool ossimImageSourceSequencer::getOrderedOutput() const
+{
+   return theOrderedOutputFlag;
+}
+
+void ossimImageSourceSequencer::setPipelineTiles(ossim_uint32 count)
+{
+   if ( count != thePipelineTiles )
+   {
+      stopPipeline();
+      thePipelineTiles = count;
+   }
+}
+
+ossim_uint32 ossimImageSourceSequencer::getPipelineTiles() const
+{
+   return thePipelineTiles;
+}
+
+void ossimImageSourceSequencer::stopPipeline()
+{
+   if ( thePipeline )
+   {
+      thePipeline->stop();
+      delete thePipeline;
+      thePipeline = 0;
+   }
+}
+
+void ossimImageSourceSequencer::findPrefetchHandlers(ossimImageSource* input)
+{
+   thePrefetchHandlers.clear();
+   thePrefetchEnd = 0;
+
+   if ( input && thePrefetchTiles )
+   {
+      ossimTypeNameVisitor visitor(ossimString("ossimImageHandler"),
+                                   false,
+                                   ossimVisitor::VISIT_CHILDREN|ossimVisitor::VISIT_INPUTS);
+      input->accept(visitor);
+
+      //---
+      // Tile rects are in our output space.  A handler with the same bounds is taken to be in
+      // it too; anything behind a renderer, mosaic or scale change is left alone.
+      //---
+      const ossimIrect BOUNDS = input->getBoundingRect(0);
+      std::vector<ossimFilename> files;
+      for (ossim_uint32 i = 0; i < visitor.getObjects().size(); ++i)
+      {
+         ossimImageHandler* ih = visitor.getObjectAs<ossimImageHandler>( i );
+         if ( ih && ( ih->getBoundingRect(0) == BOUNDS ) &&
+              ( std::find(files.begin(), files.end(), ih->getFilename()) == files.end() ) )
+         {
+            files.push_back( ih->getFilename() );
+            thePrefetchHandlers.push_back( ih );
+         }
+      }
+   }
+}
+
+void ossimImageSourceSequencer::prefetchTiles(ossim_int64 firstId,
+                                              ossim_int64 endId,
+                                              ossim_uint32 resLevel)
+{
+   if ( thePrefetchHandlers.empty() )
+   {
+      return;
+   }
+
+   const ossim_int64 TILES = getNumberOfTiles();
+   if ( endId > TILES )
+   {
+      endId = TILES;
+   }
+   if ( thePrefetchEnd < firstId )
+   {
+      thePrefetchEnd = firstId;
+   }
+
+   // Wait for at least half the range to be new.
+   if ( (endId <= thePrefetchEnd) || ( (endId - thePrefetchEnd) * 2 < (endId - firstId) ) )
+   {
+      return;
+   }
+
+   std::vector<ossimIrect> rects;
+   ossimIrect tileRect;
+   for (ossim_int64 id = thePrefetchEnd; id < endId; ++id)
+   {
+      if ( getTileRect( id, tileRect ) )
+      {
+         rects.push_back( tileRect );
+      }
+   }
+   thePrefetchEnd = endId;
 
+   if ( rects.size() )
+   {
+      std::vector<ossimImageHandler*>::iterator ih = thePrefetchHandlers.begin();
+      while ( ih != thePrefetchHandlers.end() )
+      {
+         (*ih)->prefetch( rects, resLevel );
+         ++ih;
+      }
+   }
+}
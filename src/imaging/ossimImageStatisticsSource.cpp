@@ -11,13 +11,70 @@
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageSource.h>
 #include <ossim/imaging/ossimImageSourceSequencer.h>
+#include <ossim/base/ossimCommon.h>
+#include <cmath>
+
+namespace
+{
+   // Tiles read before the error bound is tested.
+   const ossim_int64 MIN_SAMPLE_TILES = 8;
+
+   /** Running mean and variance (Welford) of the tile means of a band. */
+   struct ossimTileMeanStats
+   {
+      ossimTileMeanStats() : theCount(0), theMean(0.0), theM2(0.0) {}
+
+      void add(ossim_float64 value)
+      {
+         ++theCount;
+         const ossim_float64 delta = value - theMean;
+         theMean += delta/theCount;
+         theM2   += delta*(value - theMean);
+      }
+
+      /** Standard error of the mean of numberOfTiles tiles from theCount sampled. */
+      ossim_float64 standardError(ossim_int64 numberOfTiles)const
+      {
+         if ( theCount >= numberOfTiles )
+         {
+            return 0.0;
+         }
+         if ( theCount < 2 )
+         {
+            return ossim::nan();
+         }
+         const ossim_float64 variance = theM2/(theCount - 1);
+         const ossim_float64 fpc = 1.0 - (ossim_float64)theCount/numberOfTiles;
+         return std::sqrt(variance*fpc/theCount);
+      }
+
+      ossim_int64   theCount;
+      ossim_float64 theMean;
+      ossim_float64 theM2;
+   };
+
+   /** @return value's lowest bits bits in reverse order. */
+   ossim_int64 reverseBits(ossim_int64 value, ossim_uint32 bits)
+   {
+      ossim_int64 result = 0;
+      for(ossim_uint32 b = 0; b < bits; ++b)
+      {
+         result = (result << 1) | ((value >> b) & 1);
+      }
+      return result;
+   }
+}
 
 ossimImageStatisticsSource::ossimImageStatisticsSource()
       :ossimSource(0,
                    1,
                    0,
                    true,
-                   false)
+                   false),
+       theSampleFraction(1.0),
+       theMaxMeanError(0.0),
+       theResLevel(0),
+       theSampledFraction(0.0)
 {
 }
 
@@ -86,18 +143,61 @@ void ossimImageStatisticsSource::computeStatisticsTemplate(T /* dummyVariable */
    ossimRefPtr<ossimImageSourceSequencer> sequencer = new ossimImageSourceSequencer;
 
    sequencer->connectMyInputTo(getInput());
+   if(theResLevel)
+   {
+      ossimImageSource* input = PTR_CAST(ossimImageSource, getInput());
+      sequencer->setAreaOfInterest(input->getBoundingRect(theResLevel));
+   }
    sequencer->setToStartOfSequence();
    ossim_uint32 bands = sequencer->getNumberOfOutputBands();
 
    if(bands)
    {
       setStatsSize(bands);
+      std::vector<ossim_float64> pixelCounts(bands, 0.0);
+      std::vector<ossimTileMeanStats> tileMeans(bands);
+      const ossim_int64 numberOfTiles = sequencer->getNumberOfTiles();
+      const bool sampling = (theSampleFraction < 1.0) || (theMaxMeanError > 0.0);
+
+      // Sampled tiles are visited in bit-reversed order of their index:
+      ossim_uint32 bits = 0;
+      while((ossim_int64(1) << bits) < numberOfTiles)
+      {
+         ++bits;
+      }
+      const ossim_int64 maxTiles = ossim::max<ossim_int64>(
+         1, (ossim_int64)std::ceil(ossim::min(theSampleFraction, 1.0)*numberOfTiles));
+      ossim_int64 position = 0;
+      ossim_int64 tilesRead = 0;
+
       ossimRefPtr<ossimImageData> dataObject;
-      
-      while( (dataObject=sequencer->getNextTile()).valid() )
+      while(tilesRead < maxTiles)
       {
+         if(sampling)
+         {
+            ossim_int64 id = numberOfTiles;
+            while( (id >= numberOfTiles) && (position < (ossim_int64(1) << bits)) )
+            {
+               id = reverseBits(position++, bits);
+            }
+            if(id >= numberOfTiles)
+            {
+               break;
+            }
+            dataObject = sequencer->getTile(id, theResLevel);
+         }
+         else
+         {
+            dataObject = sequencer->getNextTile(theResLevel);
+         }
+         if(!dataObject.valid())
+         {
+            break;
+         }
+         ++tilesRead;
+
          ossim_uint32 bandIdx = 0;
-         bands = dataObject->getNumberOfBands();
+         bands = ossim::min(dataObject->getNumberOfBands(), (ossim_uint32)theMean.size());
          ossimDataObjectStatus status = dataObject->getDataObjectStatus();
          if((status != OSSIM_EMPTY)&&
             (dataObject->getBuf()))
@@ -106,6 +206,7 @@ void ossimImageStatisticsSource::computeStatisticsTemplate(T /* dummyVariable */
             for(bandIdx = 0; bandIdx < bands; ++bandIdx)
             {
                ossim_float64 pixelCount = 0.0;
+               ossim_float64 sum = 0.0;
                ossim_uint32 offset = 0;
                T* dataPtr   = static_cast<T*>(dataObject->getBuf(bandIdx));
                T nullPixel = static_cast<T>(dataObject->getNullPix(bandIdx)); 
@@ -113,7 +214,7 @@ void ossimImageStatisticsSource::computeStatisticsTemplate(T /* dummyVariable */
                {
                   if((*dataPtr) != nullPixel)
                   {
-                     theMean[bandIdx] += *dataPtr;
+                     sum += *dataPtr;
                      if((*dataPtr) < theMin[bandIdx])
                      {
                         theMin[bandIdx] = (*dataPtr);
@@ -126,13 +227,46 @@ void ossimImageStatisticsSource::computeStatisticsTemplate(T /* dummyVariable */
                   }
                   ++dataPtr;
                }
+
+               // The mean is taken over all valid pixels, not averaged tile by tile:
+               theMean[bandIdx]     += sum;
+               pixelCounts[bandIdx] += pixelCount;
                if(pixelCount > 0)
                {
-                  theMean[bandIdx] /= pixelCount;
+                  tileMeans[bandIdx].add(sum/pixelCount);
+               }
+            }
+         }
+
+         if( sampling && (theMaxMeanError > 0.0) && (tilesRead >= MIN_SAMPLE_TILES) )
+         {
+            bool withinError = true;
+            for(bandIdx = 0; withinError && (bandIdx < theMean.size()); ++bandIdx)
+            {
+               // Bands without valid pixels so far do not hold the sampling:
+               if(tileMeans[bandIdx].theCount)
+               {
+                  withinError = (tileMeans[bandIdx].standardError(numberOfTiles) <=
+                                 theMaxMeanError);
                }
             }
+            if(withinError)
+            {
+               break;
+            }
          }
       }
+
+      for(ossim_uint32 bandIdx = 0; bandIdx < theMean.size(); ++bandIdx)
+      {
+         if(pixelCounts[bandIdx] > 0)
+         {
+            theMean[bandIdx] /= pixelCounts[bandIdx];
+         }
+         theMeanError[bandIdx] = (tilesRead >= numberOfTiles) ? 0.0 :
+            tileMeans[bandIdx].standardError(numberOfTiles);
+      }
+      theSampledFraction = numberOfTiles ? (ossim_float64)tilesRead/numberOfTiles : 0.0;
    }
    
    sequencer->disconnect();
@@ -154,11 +288,53 @@ const std::vector<ossim_float64>& ossimImageStatisticsSource::getMax()const
    return theMax;
 }
 
+void ossimImageStatisticsSource::setSampleFraction(ossim_float64 fraction)
+{
+   theSampleFraction = fraction;
+}
+
+ossim_float64 ossimImageStatisticsSource::getSampleFraction()const
+{
+   return theSampleFraction;
+}
+
+void ossimImageStatisticsSource::setMaxMeanError(ossim_float64 maxError)
+{
+   theMaxMeanError = maxError;
+}
+
+ossim_float64 ossimImageStatisticsSource::getMaxMeanError()const
+{
+   return theMaxMeanError;
+}
+
+void ossimImageStatisticsSource::setResLevel(ossim_uint32 resLevel)
+{
+   theResLevel = resLevel;
+}
+
+ossim_uint32 ossimImageStatisticsSource::getResLevel()const
+{
+   return theResLevel;
+}
+
+const std::vector<ossim_float64>& ossimImageStatisticsSource::getMeanError()const
+{
+   return theMeanError;
+}
+
+ossim_float64 ossimImageStatisticsSource::getSampledFraction()const
+{
+   return theSampledFraction;
+}
+
 void ossimImageStatisticsSource::clearStatistics()
 {
    theMean.clear();
    theMin.clear();
    theMax.clear();
+   theMeanError.clear();
+   theSampledFraction = 0.0;
 }
 
 void ossimImageStatisticsSource::setStatsSize(ossim_uint32 size)
@@ -166,6 +342,7 @@ void ossimImageStatisticsSource::setStatsSize(ossim_uint32 size)
    theMean.resize(size);
    theMin.resize(size);
    theMax.resize(size);
+   theMeanError.resize(size);
 
    std::fill(theMean.begin(),
              theMean.end(),
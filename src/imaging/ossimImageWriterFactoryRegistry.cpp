@@ -17,6 +17,7 @@
 #include <ossim/base/ossimObjectFactoryRegistry.h>
 #include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimString.h>
+#include <ossim/plugin/ossimSharedPluginRegistry.h>
 #include <algorithm>
 #include <iterator>
 #include <ostream>
@@ -62,16 +63,21 @@ ossimImageFileWriter* ossimImageWriterFactoryRegistry::createWriter(const ossimF
 ossimObject* ossimImageWriterFactoryRegistry::createObject(const ossimKeywordlist &kwl,
                                                            const char *prefix)const
 {
+   ossimSharedPluginRegistry::instance()->loadDeferredPlugins(
+      ossimSharedPluginRegistry::MANIFEST_CLASSES_KW, ossimString(kwl.find(prefix, ossimKeywordNames::TYPE_KW)));
    return createObjectFromRegistry(kwl, prefix);
 }
 
 ossimObject* ossimImageWriterFactoryRegistry::createObject(const ossimString& typeName)const
 {
+   ossimSharedPluginRegistry::instance()->loadDeferredPlugins(
+      ossimSharedPluginRegistry::MANIFEST_CLASSES_KW, typeName);
    return createObjectFromRegistry(typeName);
 }
 
 void ossimImageWriterFactoryRegistry::getTypeNameList(std::vector<ossimString>& typeList)const
 {
+   ossimSharedPluginRegistry::instance()->loadAllDeferredPlugins();
    getAllTypeNamesFromRegistry(typeList);
 }
 
@@ -96,6 +102,8 @@ ossimImageFileWriter *ossimImageWriterFactoryRegistry::createWriter(const ossimK
    // ossimImageFileWriter
    //
    ossimString type = kwl.find(prefix, ossimKeywordNames::TYPE_KW);
+   ossimSharedPluginRegistry::instance()->loadDeferredPlugins(
+      ossimSharedPluginRegistry::MANIFEST_CLASSES_KW, type);
 
    if(type == "ossimImageFileWriter")
    {
@@ -133,6 +141,8 @@ ossimImageFileWriter *ossimImageWriterFactoryRegistry::createWriter(const ossimK
 
 ossimImageFileWriter *ossimImageWriterFactoryRegistry::createWriter(const ossimString& typeName)const
 {
+   ossimSharedPluginRegistry::instance()->loadDeferredPlugins(
+      ossimSharedPluginRegistry::MANIFEST_CLASSES_KW, typeName);
    vector<ossimImageWriterFactoryBase*>::const_iterator factories;
    ossimImageFileWriter *result = NULL;
 
@@ -154,6 +164,7 @@ ossimImageFileWriter *ossimImageWriterFactoryRegistry::createWriter(const ossimS
 void ossimImageWriterFactoryRegistry::getImageTypeList(std::vector<ossimString>& typeList)const
 {
    vector<ossimString> result;
+   ossimSharedPluginRegistry::instance()->loadAllDeferredPlugins();
    vector<ossimImageWriterFactoryBase*>::const_iterator iter = m_factoryList.begin();
    
    while(iter != m_factoryList.end())
@@ -173,6 +184,8 @@ void ossimImageWriterFactoryRegistry::getImageFileWritersBySuffix(ossimImageWrit
                                                                   const ossimString& ext)const
 {
    ossimImageWriterFactoryBase::ImageFileWriterList tempResult;
+   ossimSharedPluginRegistry::instance()->loadDeferredPlugins(
+      ossimSharedPluginRegistry::MANIFEST_EXTENSIONS_KW, ext);
    vector<ossimImageWriterFactoryBase*>::const_iterator iter = m_factoryList.begin();
    
    while(iter != m_factoryList.end())
@@ -223,6 +236,7 @@ std::ostream& ossimImageWriterFactoryRegistry::printImageTypeList(
 
 std::ostream& ossimImageWriterFactoryRegistry::printWriterProps(std::ostream& out)const
 {
+   ossimSharedPluginRegistry::instance()->loadAllDeferredPlugins();
    // Loop through factories:
    vector<ossimImageWriterFactoryBase*>::const_iterator factoryIter = m_factoryList.begin();
    while( factoryIter != m_factoryList.end() )
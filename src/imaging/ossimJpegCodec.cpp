@@ -20,15 +20,61 @@
 
 #include <ossim/imaging/ossimU8ImageData.h>
 #include <jpeglib.h>                   /** for jpeg stuff */
+#include <OpenThreads/ScopedLock>
+#include <algorithm>
 
 RTTI_DEF1(ossimJpegCodec, "ossimJpegCodec", ossimCodecBase);
+
+//---
+// A libjpeg decompress object kept between decodes.  Tables read by an
+// image (or from the codec's tables-only stream) stay loaded for the
+// abbreviated images that follow.  Line buffers live here rather than on
+// the stack of the decode, which may be left by longjmp.
+//---
+class ossimJpegDecompressor
+{
+public:
+   ossimJpegDecompressor()
+      : m_created(false),
+        m_tablesGeneration(0),
+        m_rows(),
+        m_lineBuffer()
+   {
+      m_cinfo.err = jpeg_std_error(&m_jerr.pub);
+      m_jerr.pub.error_exit = ossimJpegErrorExit;
+   }
+   ~ossimJpegDecompressor()
+   {
+      if ( m_created )
+      {
+         jpeg_destroy_decompress(&m_cinfo);
+      }
+   }
+
+   jpeg_decompress_struct    m_cinfo;
+   ossimJpegErrorMgr         m_jerr;
+   bool                      m_created;
+   ossim_uint32              m_tablesGeneration;
+   std::vector<JSAMPROW>     m_rows;
+   std::vector<ossim_uint8>  m_lineBuffer;
+};
+
 ossimJpegCodec::ossimJpegCodec()
-:m_quality(100)
+:m_quality(100),
+ m_tables(),
+ m_tablesGeneration(0),
+ m_decompressorMutex(),
+ m_decompressors()
 {
 }
 
 ossimJpegCodec::~ossimJpegCodec()
 {
+   for (ossim_uint32 i = 0; i < m_decompressors.size(); ++i)
+   {
+      delete m_decompressors[i];
+   }
+   m_decompressors.clear();
 }
 
 ossimString ossimJpegCodec::getCodecType()const
@@ -183,65 +229,122 @@ bool ossimJpegCodec::decode( const std::vector<ossim_uint8>& in,
    return result;	
 }
 
+bool ossimJpegCodec::decode( const ossim_uint8* in,
+                             ossim_uint64 size,
+                             ossimRefPtr<ossimImageData>& out,
+                             ossim_uint32 scale ) const
+{
+   bool result = false;
+
+   // Check for jpeg signature:
+   if ( in && (size > 3) && (in[0] == 0xff) && (in[1] == 0xd8) && (in[2] == 0xff) )
+   {
+      ossim_int32 colorSpace = JCS_UNKNOWN;
+      result = decodeJpeg( in, size, scale, out, &colorSpace );
+      if ( result && (colorSpace == JCS_CMYK) )
+      {
+         ossimRefPtr<ossimImageData> cmykTile = (ossimImageData*)out->dup();
+         result = cmykToRgb( cmykTile.get(), out );
+      }
+   }
+
+   return result;
+}
+
+void ossimJpegCodec::setTables( const ossim_uint8* tables, ossim_uint64 size )
+{
+   if ( tables && size )
+   {
+      m_tables.assign( tables, tables + size );
+   }
+   else
+   {
+      m_tables.clear();
+   }
+   ++m_tablesGeneration;
+}
+
+ossimJpegDecompressor* ossimJpegCodec::acquireDecompressor() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_decompressorMutex);
+   if ( m_decompressors.empty() )
+   {
+      return new ossimJpegDecompressor();
+   }
+   ossimJpegDecompressor* result = m_decompressors.back();
+   m_decompressors.pop_back();
+   return result;
+}
+
+void ossimJpegCodec::releaseDecompressor(ossimJpegDecompressor* decompressor) const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_decompressorMutex);
+   m_decompressors.push_back(decompressor);
+}
+
 bool ossimJpegCodec::decodeJpeg( const std::vector<ossim_uint8>& in,
                                     ossimRefPtr<ossimImageData>& out ) const
 {
+   return in.size() ? decodeJpeg( &(in.front()), in.size(), 1, out, 0 ) : false;
+}
+
+bool ossimJpegCodec::decodeJpeg( const ossim_uint8* in,
+                                 ossim_uint64 size,
+                                 ossim_uint32 scale,
+                                 ossimRefPtr<ossimImageData>& out,
+                                 ossim_int32* colorSpace ) const
+{
+   if ( (scale != 1) && (scale != 2) && (scale != 4) && (scale != 8) )
+   {
+      return false;
+   }
+
    bool result = false;
+   ossimJpegDecompressor* decompressor = acquireDecompressor();
+   jpeg_decompress_struct& cinfo = decompressor->m_cinfo;
 
-   /* This struct contains the JPEG decompression parameters and pointers
-    * to working space (which is allocated as needed by the JPEG library).
-    */
-   jpeg_decompress_struct cinfo;
-   
-   /* We use our private extension JPEG error handler.
-    * Note that this struct must live as long as the main JPEG parameter
-    * struct, to avoid dangling-pointer problems.
-    */
-   ossimJpegErrorMgr jerr;
-   
-   /* Step 1: allocate and initialize JPEG decompression object */
-   
-   /* We set up the normal JPEG error routines, then override error_exit. */
-   cinfo.err = jpeg_std_error(&jerr.pub);
-   
-   jerr.pub.error_exit = ossimJpegErrorExit;
-   
    /* Establish the setjmp return context for my_error_exit to use. */
-   if (setjmp(jerr.setjmp_buffer) == 0)
+   if (setjmp(decompressor->m_jerr.setjmp_buffer) == 0)
    {
-      result = true;
-      
-      /* Now we can initialize the JPEG decompression object. */
-      jpeg_CreateDecompress(&cinfo, JPEG_LIB_VERSION, sizeof(cinfo));
-      
+      if ( !decompressor->m_created )
+      {
+         /* Now we can initialize the JPEG decompression object. */
+         jpeg_CreateDecompress(&cinfo, JPEG_LIB_VERSION, sizeof(cinfo));
+         decompressor->m_created = true;
+      }
+
+      // Tables for abbreviated streams, once per decompressor.
+      if ( m_tables.size() && (decompressor->m_tablesGeneration != m_tablesGeneration) )
+      {
+         ossimJpegMemorySrc ( &cinfo, &(m_tables.front()), (size_t)(m_tables.size()) );
+         jpeg_read_header(&cinfo, FALSE);
+         decompressor->m_tablesGeneration = m_tablesGeneration;
+      }
+
       //---
-      // Step 2: specify data source.  In this case we will uncompress from
+      // Specify data source.  In this case we will uncompress from
       // memory so we will use "ossimJpegMemorySrc" in place of " jpeg_stdio_src".
       //---
-      ossimJpegMemorySrc ( &cinfo, &(in.front()), (size_t)(in.size()) );
-      
-      /* Step 3: read file parameters with jpeg_read_header() */
+      ossimJpegMemorySrc ( &cinfo, in, (size_t)size );
+
+      /* Read file parameters with jpeg_read_header() */
       jpeg_read_header(&cinfo, TRUE);
-      
-      /* Step 4: set parameters for decompression */
-      
-      /* Step 5: Start decompressor */
+      if ( colorSpace )
+      {
+         *colorSpace = cinfo.out_color_space;
+      }
+
+      /* Set parameters for decompression; DCT scaling for reduced resolution. */
+      cinfo.scale_num   = 1;
+      cinfo.scale_denom = scale;
+
+      /* Start decompressor */
       jpeg_start_decompress(&cinfo);
 
       const ossim_uint32 SAMPLES = cinfo.output_width;
       const ossim_uint32 LINES   = cinfo.output_height;
       const ossim_uint32 BANDS   = cinfo.output_components;
-
-#if 0       /* Please leave for debug. (drb) */
-      if ( traceDebug() )
-      {
-         ossimNotify(ossimNotifyLevel_DEBUG)
-            << "jpeg cinfo.output_width:  " << cinfo.output_width
-            << "\njpeg cinfo.output_height: " << cinfo.output_height
-            << "\njpeg cinfo.out_color_space: " << cinfo.out_color_space
-            << "\n";
-      }
-#endif
+      const ossim_uint32 ROWS    = cinfo.rec_outbuf_height;
 
       if ( out.valid() )
       {
@@ -254,54 +357,80 @@ bool ossimJpegCodec::decodeJpeg( const std::vector<ossim_uint8>& in,
          out = new ossimU8ImageData( 0, BANDS, SAMPLES, LINES );
          out->initialize();
       }
-      
-      // Get pointers to the cache tile buffers.
-      std::vector<ossim_uint8*> destinationBuffer(BANDS);
-      for (ossim_uint32 band = 0; band < BANDS; ++band)
-      {
-         destinationBuffer[band] = out->getUcharBuf(band);
-      }
-      
-      std::vector<ossim_uint8> lineBuffer(SAMPLES * cinfo.output_components);
-      JSAMPROW jbuf[1];
-      jbuf[0] = (JSAMPROW) &(lineBuffer.front());
-      
-      while (cinfo.output_scanline < LINES)
+
+      std::vector<JSAMPROW>& rows = decompressor->m_rows;
+      rows.resize(ROWS);
+
+      if ( BANDS == 1 )
       {
-         // Read a line from the jpeg file.
-         jpeg_read_scanlines(&cinfo, jbuf, 1);
-         
-         //---
-         // Copy the line which if band interleaved by pixel the the band
-         // separate buffers.
-         //---
-         ossim_uint32 index = 0;
-         for (ossim_uint32 sample = 0; sample < SAMPLES; ++sample)         
+         // Scanlines straight into the tile.
+         ossim_uint8* buf = out->getUcharBuf(0);
+         while (cinfo.output_scanline < LINES)
          {
-            for (ossim_uint32 band = 0; band < BANDS; ++band)
+            const ossim_uint32 COUNT = std::min(ROWS, LINES - cinfo.output_scanline);
+            for (ossim_uint32 row = 0; row < COUNT; ++row)
             {
-               destinationBuffer[band][sample] = lineBuffer[index];
-               ++index;
+               rows[row] = (JSAMPROW)(buf + (cinfo.output_scanline + row) * SAMPLES);
             }
+            jpeg_read_scanlines(&cinfo, &(rows.front()), COUNT);
          }
-         
+      }
+      else
+      {
+         // Get pointers to the tile buffers.
+         std::vector<ossim_uint8*> destinationBuffer(BANDS);
          for (ossim_uint32 band = 0; band < BANDS; ++band)
          {
-            destinationBuffer[band] += SAMPLES;
+            destinationBuffer[band] = out->getUcharBuf(band);
+         }
+
+         const ossim_uint32 ROW_STRIDE = SAMPLES * BANDS;
+         std::vector<ossim_uint8>& lineBuffer = decompressor->m_lineBuffer;
+         lineBuffer.resize(ROWS * ROW_STRIDE);
+         for (ossim_uint32 row = 0; row < ROWS; ++row)
+         {
+            rows[row] = (JSAMPROW) &(lineBuffer[row * ROW_STRIDE]);
+         }
+
+         while (cinfo.output_scanline < LINES)
+         {
+            const ossim_uint32 COUNT = jpeg_read_scanlines(&cinfo, &(rows.front()), ROWS);
+
+            //---
+            // Copy the lines which are band interleaved by pixel to the band
+            // separate buffers.
+            //---
+            for (ossim_uint32 row = 0; row < COUNT; ++row)
+            {
+               const ossim_uint8* line = rows[row];
+               for (ossim_uint32 band = 0; band < BANDS; ++band)
+               {
+                  ossim_uint8* dest = destinationBuffer[band];
+                  for (ossim_uint32 sample = 0; sample < SAMPLES; ++sample)
+                  {
+                     dest[sample] = line[sample * BANDS + band];
+                  }
+                  destinationBuffer[band] += SAMPLES;
+               }
+            }
          }
       }
 
       // Set the tile status:
       out->validate();
 
-      // clean up...
-      
       jpeg_finish_decompress(&cinfo);
-      
+      result = true;
+
    } // Matches: if (setjmp(jerr.setjmp_buffer) == 0)
+   else if ( decompressor->m_created )
+   {
+      // Back to the start state, tables kept.
+      jpeg_abort_decompress(&cinfo);
+   }
+
+   releaseDecompressor(decompressor);
 
-   jpeg_destroy_decompress(&cinfo);
-   
    return result;
 }
 
@@ -320,106 +449,8 @@ bool ossimJpegCodec::decodeJpegToRgb(const std::vector<ossim_uint8>& in,
       result = decodeJpeg( in, cmykTile ); // Decode to CMYK tile.
       if ( result )
       {
-         if ( cmykTile.valid() )
-         {
-            const ossim_uint32 INPUT_BANDS = cmykTile->getNumberOfBands();
-            if ( INPUT_BANDS == 4 )
-            {
-               const ossim_uint32 OUTPUT_BANDS = 3;
-               const ossimIrect   RECT         = cmykTile->getImageRectangle();
-               const ossim_uint32 LINES        = RECT.height();
-               const ossim_uint32 SAMPLES      = RECT.width();
-               ossim_uint32 band = 0;
-               
-               // Set or create output tile:
-               if ( out.valid() )
-               {
-                  // This will resize tile if not correct.
-                  out->setImageRectangleAndBands( RECT, OUTPUT_BANDS );
-               }
-               else
-               {
-                  out = new ossimU8ImageData( 0, OUTPUT_BANDS, SAMPLES, LINES );
-                  out->initialize();
-               }
-               
-               // Assign pointers to bands.
-               std::vector<const ossim_uint8*> inBands(INPUT_BANDS);
-               for ( band = 0; band < INPUT_BANDS; ++band )
-               {
-                  inBands[band] = cmykTile->getUcharBuf( band );
-               }
-               std::vector<ossim_uint8*> outBands(INPUT_BANDS);
-               for ( band = 0; band < OUTPUT_BANDS; ++band )
-               {
-                  outBands[band] = out->getUcharBuf( band );
-               }
-               
-               const ossim_uint8 NP   = 0;   // null pixel
-               const ossim_uint8 MAXP = 255; // max pixel
-               
-               std::vector<ossim_float32> cmyk(INPUT_BANDS, 0.0);
-               std::vector<ossim_float32> rgb(OUTPUT_BANDS, 0.0);
-               
-               for ( ossim_uint32 line = 0; line < LINES; ++line )
-               {
-                  for (ossim_uint32 sample = 0; sample < SAMPLES; ++sample)
-                  {
-                     //---
-                     // NOTE:
-                     // This current does NOT work, colors come out wrong, with
-                     // the one dataset that I have:
-                     // "2015_05_05_Whitehorse_3857.gpkg"
-                     // (drb - 03 June 2015)
-                     //---
-                     
-                     cmyk[0] = inBands[0][sample]; // C
-                     cmyk[1] = inBands[1][sample]; // M
-                     cmyk[2] = inBands[2][sample]; // Y
-                     cmyk[3] = inBands[3][sample]; // K
-
-                     //---
-                     // The red (R) color is calculated from the cyan (C) and black (K) colors.
-                     // The green color (G) is calculated from the magenta (M) and black (K) colors.
-                     // The blue color (B) is calculated from the yellow (Y) and black (K) colors.
-                     //---
-                     // rgb[0] = (255.0-cmyk[0]) * 255.0-cmyk[3];
-                     // rgb[1] = (255.0-cmyk[1]) * 255.0-cmyk[3];
-                     // rgb[2] = (255.0-cmyk[2]) * 255.0-cmyk[3];
-                     rgb[0] = (cmyk[0]) * cmyk[3]/255.0;
-                     rgb[1] = (cmyk[1]) * cmyk[3]/255.0;
-                     rgb[2] = (cmyk[2]) * cmyk[3]/255.0;
-                     
-                     outBands[0][sample] =
-                        ( (rgb[0] >= 0.0) ? ( (rgb[0] <= 255.0) ?
-                                              (ossim_uint8)rgb[0] : MAXP ) : NP );
-                     outBands[1][sample] =
-                        ( (rgb[1] >= 0.0) ? ( (rgb[1] <= 255.0) ?
-                                              (ossim_uint8)rgb[1] : MAXP ) : NP );
-                     outBands[2][sample] =
-                        ( (rgb[2] >= 0.0) ? ( (rgb[2] <= 255.0) ?
-                                              (ossim_uint8)rgb[2] : MAXP ) : NP );
-                     
-                  } // End sample loop.
-                  
-                  // Increment pointers.
-                  for (ossim_uint32 band = 0; band < OUTPUT_BANDS; ++band)
-                  {
-                     inBands[band]  += SAMPLES;
-                     outBands[band] += SAMPLES;
-                  }
-                  inBands[3] += SAMPLES; // Last band of input.
-                  
-               } // End of line loop.
-               
-               // Set the tile status:
-               out->validate();
-               
-            } // Matches sanity check: if ( INPUT_BANDS == 4 )
-
-         }  // Matches: if ( cmykTile.valid() )
-         
-      } // Matches: if ( decodeJpeg( in, cmykTile ) )
+         result = cmykTile.valid() && cmykToRgb( cmykTile.get(), out );
+      }
       
    } // Matches: if ( jpegColorSpace == JCS_CMYK )
    else
@@ -433,6 +464,108 @@ bool ossimJpegCodec::decodeJpegToRgb(const std::vector<ossim_uint8>& in,
    
 } // End: ossimJpegCodec::decodeJpegRgb( ... )
 
+bool ossimJpegCodec::cmykToRgb(const ossimImageData* cmykTile,
+                               ossimRefPtr<ossimImageData>& out ) const
+{
+   const ossim_uint32 INPUT_BANDS = cmykTile->getNumberOfBands();
+   if ( INPUT_BANDS != 4 )
+   {
+      return false;
+   }
+
+   const ossim_uint32 OUTPUT_BANDS = 3;
+   const ossimIrect   RECT         = cmykTile->getImageRectangle();
+   const ossim_uint32 LINES        = RECT.height();
+   const ossim_uint32 SAMPLES      = RECT.width();
+   ossim_uint32 band = 0;
+   
+   // Set or create output tile:
+   if ( out.valid() )
+   {
+      // This will resize tile if not correct.
+      out->setImageRectangleAndBands( RECT, OUTPUT_BANDS );
+   }
+   else
+   {
+      out = new ossimU8ImageData( 0, OUTPUT_BANDS, SAMPLES, LINES );
+      out->initialize();
+   }
+   
+   // Assign pointers to bands.
+   std::vector<const ossim_uint8*> inBands(INPUT_BANDS);
+   for ( band = 0; band < INPUT_BANDS; ++band )
+   {
+      inBands[band] = cmykTile->getUcharBuf( band );
+   }
+   std::vector<ossim_uint8*> outBands(INPUT_BANDS);
+   for ( band = 0; band < OUTPUT_BANDS; ++band )
+   {
+      outBands[band] = out->getUcharBuf( band );
+   }
+   
+   const ossim_uint8 NP   = 0;   // null pixel
+   const ossim_uint8 MAXP = 255; // max pixel
+   
+   std::vector<ossim_float32> cmyk(INPUT_BANDS, 0.0);
+   std::vector<ossim_float32> rgb(OUTPUT_BANDS, 0.0);
+   
+   for ( ossim_uint32 line = 0; line < LINES; ++line )
+   {
+      for (ossim_uint32 sample = 0; sample < SAMPLES; ++sample)
+      {
+         //---
+         // NOTE:
+         // This current does NOT work, colors come out wrong, with
+         // the one dataset that I have:
+         // "2015_05_05_Whitehorse_3857.gpkg"
+         // (drb - 03 June 2015)
+         //---
+         
+         cmyk[0] = inBands[0][sample]; // C
+         cmyk[1] = inBands[1][sample]; // M
+         cmyk[2] = inBands[2][sample]; // Y
+         cmyk[3] = inBands[3][sample]; // K
+
+         //---
+         // The red (R) color is calculated from the cyan (C) and black (K) colors.
+         // The green color (G) is calculated from the magenta (M) and black (K) colors.
+         // The blue color (B) is calculated from the yellow (Y) and black (K) colors.
+         //---
+         // rgb[0] = (255.0-cmyk[0]) * 255.0-cmyk[3];
+         // rgb[1] = (255.0-cmyk[1]) * 255.0-cmyk[3];
+         // rgb[2] = (255.0-cmyk[2]) * 255.0-cmyk[3];
+         rgb[0] = (cmyk[0]) * cmyk[3]/255.0;
+         rgb[1] = (cmyk[1]) * cmyk[3]/255.0;
+         rgb[2] = (cmyk[2]) * cmyk[3]/255.0;
+         
+         outBands[0][sample] =
+            ( (rgb[0] >= 0.0) ? ( (rgb[0] <= 255.0) ?
+                                  (ossim_uint8)rgb[0] : MAXP ) : NP );
+         outBands[1][sample] =
+            ( (rgb[1] >= 0.0) ? ( (rgb[1] <= 255.0) ?
+                                  (ossim_uint8)rgb[1] : MAXP ) : NP );
+         outBands[2][sample] =
+            ( (rgb[2] >= 0.0) ? ( (rgb[2] <= 255.0) ?
+                                  (ossim_uint8)rgb[2] : MAXP ) : NP );
+         
+      } // End sample loop.
+      
+      // Increment pointers.
+      for (ossim_uint32 band = 0; band < OUTPUT_BANDS; ++band)
+      {
+         inBands[band]  += SAMPLES;
+         outBands[band] += SAMPLES;
+      }
+      inBands[3] += SAMPLES; // Last band of input.
+      
+   } // End of line loop.
+   
+   // Set the tile status:
+   out->validate();
+   
+   return true;
+}
+
 ossim_int32 ossimJpegCodec::getColorSpace( const std::vector<ossim_uint8>& in ) const
 {
    J_COLOR_SPACE result = JCS_UNKNOWN;
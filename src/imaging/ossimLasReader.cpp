@@ -20,6 +20,7 @@
 #include <ossim/base/ossimGpt.h>
 #include <ossim/base/ossimEndian.h>
 #include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossimProperty.h>
 #include <ossim/base/ossimString.h>
 #include <ossim/base/ossimStringProperty.h>
@@ -38,6 +39,10 @@
 
 #include <ossim/support_data/ossimTiffInfo.h>
 
+#include <OpenThreads/Thread>
+
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <limits>
 #include <sstream>
@@ -49,6 +54,44 @@ static ossimTrace traceDebug("ossimLasReader:debug");
 static const char SCALE_KW[] = "scale";
 static const char SCAN_KW[]  = "scan"; // boolean
 
+// Records binned per piece of work when decoding a tile on several threads:
+static const ossim_uint64 RECORDS_PER_JOB = 65536;
+
+/** Bins every stride'th range of a tile into its own buckets. */
+class ossimLasTileThread : public OpenThreads::Thread
+{
+public:
+   ossimLasTileThread(const ossimLasReader* reader,
+                      const std::vector< std::pair<ossim_uint64, ossim_uint64> >& ranges,
+                      ossim_uint64 first,
+                      ossim_uint64 stride,
+                      const ossimLasReader::TileBins& bins,
+                      std::vector<ossimLasReader::Bucket>& bucket)
+      : OpenThreads::Thread(),
+        m_reader(reader),
+        m_ranges(ranges),
+        m_first(first),
+        m_stride(stride),
+        m_bins(bins),
+        m_bucket(bucket)
+   {
+   }
+   virtual void run()
+   {
+      for (ossim_uint64 i = m_first; i < m_ranges.size(); i += m_stride)
+      {
+         m_reader->binPoints(m_ranges[i].first, m_ranges[i].second, m_bins, m_bucket);
+      }
+   }
+private:
+   const ossimLasReader*                                        m_reader;
+   const std::vector< std::pair<ossim_uint64, ossim_uint64> >& m_ranges;
+   ossim_uint64                                                 m_first;
+   ossim_uint64                                                 m_stride;
+   const ossimLasReader::TileBins&                              m_bins;
+   std::vector<ossimLasReader::Bucket>&                         m_bucket;
+};
+
 ossimLasReader::ossimLasReader()
    : ossimImageHandler(),
      m_str(),
@@ -64,7 +107,11 @@ ossimLasReader::ossimLasReader()
      m_mutex(),
      m_scan(false), // ???
      m_units(OSSIM_METERS),
-     m_unitConverter(0)   
+     m_unitConverter(0),
+     m_map(0),
+     m_index(0),
+     m_indexInitialized(false),
+     m_unitFactor(1.0)
 {
    //---
    // Nan out as can be set in several places, i.e. setProperty,
@@ -159,6 +206,9 @@ void ossimLasReader::close()
       m_entry = 0;
       m_tile  = 0;
       m_proj  = 0;
+      m_map   = 0;
+      m_index = 0;
+      m_indexInitialized = false;
       ossimImageHandler::close();
    }
 }
@@ -242,47 +292,60 @@ bool ossimLasReader::getTile(ossimImageData* result, ossim_uint32 resLevel)
       // Create array of buckets.
       std::vector<ossimLasReader::Bucket> bucket( TILE_SIZE );
 
-      // Loop through the point data.
-      ossimLasPointRecordInterface* lasPtRec = getNewPointRecord();
-      ossimDpt lasPt;
-
-      m_str.clear();
-      m_str.seekg(m_hdr->getOffsetToPointData());
-
-      while ( m_str.good() )
+      if ( initIndex() )
       {
-         // m_str.read((char*)lasPtRec, 28);
-         lasPtRec->readStream( m_str );
+         TileBins bins;
+         bins.m_ulProgPt = UL_PROG_PT;
+         bins.m_scale    = scale;
+         bins.m_projRect = PROJ_RECT;
+         bins.m_width    = TILE_WIDTH;
+         bins.m_size     = TILE_SIZE;
+         binIndexedPoints( bins, bucket );
+      }
+      else
+      {
+         // Loop through the point data.
+         ossimLasPointRecordInterface* lasPtRec = getNewPointRecord();
+         ossimDpt lasPt;
+
+         m_str.clear();
+         m_str.seekg(m_hdr->getOffsetToPointData());
 
-         if ( lasPtRec->getReturnNumber() == ENTRY )
+         while ( m_str.good() )
          {
-            lasPt.x = lasPtRec->getX() * SCALE_X + OFFSET_X;
-            lasPt.y = lasPtRec->getY() * SCALE_Y + OFFSET_Y;
-            if ( m_unitConverter )
-            {
-               convertToMeters(lasPt.x);
-               convertToMeters(lasPt.y);
-            }
-            if ( PROJ_RECT.pointWithin( lasPt ) )
+            // m_str.read((char*)lasPtRec, 28);
+            lasPtRec->readStream( m_str );
+
+            if ( lasPtRec->getReturnNumber() == ENTRY )
             {
-               // Compute the bucket index:
-               ossim_int32 line = static_cast<ossim_int32>((UL_PROG_PT.y - lasPt.y) / scale.y);
-               ossim_int32 samp = static_cast<ossim_int32>((lasPt.x - UL_PROG_PT.x) / scale.x );
-               ossim_int32 bucketIndex = line * TILE_WIDTH + samp;
-               
-               // Range check and add if in there.
-               if ( ( bucketIndex >= 0 ) && ( bucketIndex < TILE_SIZE ) )
+               lasPt.x = lasPtRec->getX() * SCALE_X + OFFSET_X;
+               lasPt.y = lasPtRec->getY() * SCALE_Y + OFFSET_Y;
+               if ( m_unitConverter )
+               {
+                  convertToMeters(lasPt.x);
+                  convertToMeters(lasPt.y);
+               }
+               if ( PROJ_RECT.pointWithin( lasPt ) )
                {
-                  ossim_float64 z = lasPtRec->getZ() * SCALE_Z + OFFSET_Z;
-                  if (  m_unitConverter ) convertToMeters(z);
-                  bucket[bucketIndex].add( z ); 
+                  // Compute the bucket index:
+                  ossim_int32 line = static_cast<ossim_int32>((UL_PROG_PT.y - lasPt.y) / scale.y);
+                  ossim_int32 samp = static_cast<ossim_int32>((lasPt.x - UL_PROG_PT.x) / scale.x );
+                  ossim_int32 bucketIndex = line * TILE_WIDTH + samp;
+               
+                  // Range check and add if in there.
+                  if ( ( bucketIndex >= 0 ) && ( bucketIndex < TILE_SIZE ) )
+                  {
+                     ossim_float64 z = lasPtRec->getZ() * SCALE_Z + OFFSET_Z;
+                     if (  m_unitConverter ) convertToMeters(z);
+                     bucket[bucketIndex].add( z ); 
+                  }
                }
             }
+            if ( m_str.eof() ) break;
          }
-         if ( m_str.eof() ) break;
+         delete lasPtRec;
+         lasPtRec = 0;
       }
-      delete lasPtRec;
-      lasPtRec = 0;
 
       //---
       // We must always blank out the tile as we may not have a point for every
@@ -306,6 +369,201 @@ bool ossimLasReader::getTile(ossimImageData* result, ossim_uint32 resLevel)
    
 } // End: bool ossimLibLasReader::getTile(ossimImageData* result, ossim_uint32 resLevel)
 
+bool ossimLasReader::initIndex()
+{
+   if ( m_indexInitialized )
+   {
+      return m_index.valid();
+   }
+   m_indexInitialized = true;
+
+   const char* lookup = ossimPreferences::instance()->findPreference("point_cloud.spatial_index");
+   if ( lookup && !ossimString(lookup).toBool() )
+   {
+      return false;
+   }
+
+   const ossim_uint64 NUM_POINTS  = m_hdr->getNumberOfPoints();
+   const ossim_uint64 RECORD_SIZE = m_hdr->getPointDataRecordLength();
+   if ( !NUM_POINTS || (NUM_POINTS > 0xffffffff) || (RECORD_SIZE < 15) || m_ul.hasNans() )
+   {
+      return false;
+   }
+
+   m_map = new ossimMemoryMappedFile();
+   if ( !m_map->open(theImageFile) ||
+        (m_map->size() < m_hdr->getOffsetToPointData() + NUM_POINTS * RECORD_SIZE) )
+   {
+      m_map = 0;
+      return false;
+   }
+
+   if ( m_unitConverter )
+   {
+      m_unitConverter->setValue(1.0, m_units);
+      m_unitFactor = m_unitConverter->getMeters();
+   }
+
+   ossimFilename sidecar = theImageFile + ".xy.pci";
+   const ossim_int64 FILE_SIZE = static_cast<ossim_int64>(m_map->size());
+   ossimRefPtr<ossimPointCloudIndex> index = new ossimPointCloudIndex();
+   if ( !sidecar.exists() ||
+        !index->load(sidecar, static_cast<ossim_uint32>(NUM_POINTS), FILE_SIZE) )
+   {
+      // One pass over the records, x/y in meters as in getTile:
+      const ossim_uint32 CHUNK = ossimPointCloudIndex::DEFAULT_CHUNK_SIZE;
+      index->beginBuild(m_ul.x, m_lr.y, m_lr.x, m_ul.y, CHUNK);
+
+      const ossim_uint8*  DATA     = m_map->data() + m_hdr->getOffsetToPointData();
+      const ossim_float64 SCALE_X  = m_hdr->getScaleFactorX() * m_unitFactor;
+      const ossim_float64 SCALE_Y  = m_hdr->getScaleFactorY() * m_unitFactor;
+      const ossim_float64 OFFSET_X = m_hdr->getOffsetX() * m_unitFactor;
+      const ossim_float64 OFFSET_Y = m_hdr->getOffsetY() * m_unitFactor;
+      ossimEndian* endian = (ossim::byteOrder() == OSSIM_BIG_ENDIAN) ? new ossimEndian() : 0;
+
+      std::vector<ossim_float64> x(CHUNK);
+      std::vector<ossim_float64> y(CHUNK);
+      for (ossim_uint64 begin = 0; begin < NUM_POINTS; begin += CHUNK)
+      {
+         const ossim_uint32 N =
+            static_cast<ossim_uint32>(std::min<ossim_uint64>(CHUNK, NUM_POINTS - begin));
+         const ossim_uint8* rec = DATA + begin * RECORD_SIZE;
+         for (ossim_uint32 i = 0; i < N; ++i, rec += RECORD_SIZE)
+         {
+            ossim_int32 ix, iy;
+            memcpy(&ix, rec, 4);
+            memcpy(&iy, rec + 4, 4);
+            if ( endian )
+            {
+               endian->swap(ix);
+               endian->swap(iy);
+            }
+            x[i] = ix * SCALE_X + OFFSET_X;
+            y[i] = iy * SCALE_Y + OFFSET_Y;
+         }
+         index->addChunk(static_cast<ossim_uint32>(begin / CHUNK), &x.front(), &y.front(), N);
+      }
+      delete endian;
+      index->endBuild(static_cast<ossim_uint32>(NUM_POINTS));
+
+      // The sidecar is an optimization; a read only directory is not an error.
+      index->setFileSize(FILE_SIZE);
+      index->save(sidecar);
+   }
+
+   m_index = index;
+   return true;
+}
+
+void ossimLasReader::binPoints(ossim_uint64 begin,
+                               ossim_uint64 end,
+                               const TileBins& bins,
+                               std::vector<Bucket>& bucket) const
+{
+   // Point records of all formats start with int32 x, y, z, uint16 intensity and the return
+   // byte, return number in the low three bits.
+   const ossim_uint64  RECORD_SIZE = m_hdr->getPointDataRecordLength();
+   const ossim_uint8   ENTRY    = m_entry + 1;
+   const ossim_float64 SCALE_X  = m_hdr->getScaleFactorX() * m_unitFactor;
+   const ossim_float64 SCALE_Y  = m_hdr->getScaleFactorY() * m_unitFactor;
+   const ossim_float64 SCALE_Z  = m_hdr->getScaleFactorZ() * m_unitFactor;
+   const ossim_float64 OFFSET_X = m_hdr->getOffsetX() * m_unitFactor;
+   const ossim_float64 OFFSET_Y = m_hdr->getOffsetY() * m_unitFactor;
+   const ossim_float64 OFFSET_Z = m_hdr->getOffsetZ() * m_unitFactor;
+   const bool SWAP = (ossim::byteOrder() == OSSIM_BIG_ENDIAN);
+   ossimEndian endian;
+
+   const ossim_uint8* rec = m_map->data() + m_hdr->getOffsetToPointData() + begin * RECORD_SIZE;
+   ossimDpt lasPt;
+   for (ossim_uint64 i = begin; i < end; ++i, rec += RECORD_SIZE)
+   {
+      if ( (rec[14] & 0x07) != ENTRY )
+      {
+         continue;
+      }
+
+      ossim_int32 xyz[3];
+      memcpy(xyz, rec, 12);
+      if ( SWAP )
+      {
+         endian.swap(xyz[0]);
+         endian.swap(xyz[1]);
+      }
+      lasPt.x = xyz[0] * SCALE_X + OFFSET_X;
+      lasPt.y = xyz[1] * SCALE_Y + OFFSET_Y;
+      if ( bins.m_projRect.pointWithin( lasPt ) )
+      {
+         ossim_int32 line =
+            static_cast<ossim_int32>((bins.m_ulProgPt.y - lasPt.y) / bins.m_scale.y);
+         ossim_int32 samp =
+            static_cast<ossim_int32>((lasPt.x - bins.m_ulProgPt.x) / bins.m_scale.x);
+         ossim_int32 bucketIndex = line * bins.m_width + samp;
+         if ( ( bucketIndex >= 0 ) && ( bucketIndex < bins.m_size ) )
+         {
+            if ( SWAP )
+            {
+               endian.swap(xyz[2]);
+            }
+            bucket[bucketIndex].add( xyz[2] * SCALE_Z + OFFSET_Z );
+         }
+      }
+   }
+}
+
+void ossimLasReader::binIndexedPoints(const TileBins& bins, std::vector<Bucket>& bucket) const
+{
+   std::vector< std::pair<ossim_uint32, ossim_uint32> > runs;
+   m_index->getChunkRuns(bins.m_projRect.ul().x, bins.m_projRect.lr().y,
+                         bins.m_projRect.lr().x, bins.m_projRect.ul().y, runs);
+
+   // Record ranges of the runs, cut to pieces for the threads:
+   const ossim_uint64 NUM_POINTS = m_index->getNumPoints();
+   const ossim_uint64 CHUNK = m_index->getChunkSize();
+   std::vector< std::pair<ossim_uint64, ossim_uint64> > ranges;
+   for (ossim_uint32 i = 0; i < runs.size(); ++i)
+   {
+      const ossim_uint64 END = std::min<ossim_uint64>((runs[i].second + 1) * CHUNK, NUM_POINTS);
+      for (ossim_uint64 begin = runs[i].first * CHUNK; begin < END; begin += RECORDS_PER_JOB)
+      {
+         ranges.push_back(std::make_pair(begin, std::min(begin + RECORDS_PER_JOB, END)));
+      }
+   }
+
+   const ossim_uint64 THREADS = std::min<ossim_uint64>(ossim::getNumberOfThreads(),
+                                                       ranges.size());
+   if ( THREADS <= 1 )
+   {
+      for (ossim_uint32 i = 0; i < ranges.size(); ++i)
+      {
+         binPoints(ranges[i].first, ranges[i].second, bins, bucket);
+      }
+      return;
+   }
+
+   // Each thread bins its ranges into its own buckets, summed after the join:
+   std::vector< std::vector<Bucket> > threadBuckets(THREADS - 1,
+                                                    std::vector<Bucket>(bucket.size()));
+   std::vector<ossimLasTileThread*> threads;
+   for (ossim_uint64 i = 1; i < THREADS; ++i)
+   {
+      threads.push_back(new ossimLasTileThread(this, ranges, i, THREADS, bins,
+                                               threadBuckets[i - 1]));
+      threads.back()->start();
+   }
+   ossimLasTileThread(this, ranges, 0, THREADS, bins, bucket).run();
+   for (ossim_uint64 i = 0; i < threads.size(); ++i)
+   {
+      threads[i]->join();
+      delete threads[i];
+      const std::vector<Bucket>& tb = threadBuckets[i];
+      for (ossim_uint64 b = 0; b < bucket.size(); ++b)
+      {
+         bucket[b].a += tb[b].a;
+         bucket[b].c += tb[b].c;
+      }
+   }
+}
+
 ossim_uint32 ossimLasReader::getNumberOfInputBands() const
 {
    return 1; // tmp
@@ -141,7 +141,10 @@ ossimMapCompositionSource::ossimMapCompositionSource()
     theLeftMeterTickFlag(false),
     theRightMeterTickFlag(false),
     theGeographicSpacing(1.0, 1.0),
-    theMeterSpacing(3600*30, 3600*30)
+    theMeterSpacing(3600*30, 3600*30),
+    theBorderCacheId(-1),
+    theBorderCacheColor(255,255,255),
+    theBorderCacheBands(0)
 {
    theViewWidthHeight = ossimIpt(-1,-1);
    vector<ossimFontInformation> info;
@@ -248,7 +251,7 @@ ossimRefPtr<ossimImageData> ossimMapCompositionSource::getTile(const ossimIrect&
                                     band);
                }
             }
-	    drawBorders();
+	    loadBorders();
 	    drawAnnotations(theTile);
          }
       }
@@ -563,6 +566,7 @@ void ossimMapCompositionSource::initialize()
 
 void ossimMapCompositionSource::computeBorderRects()
 {
+   deleteBorderCache();
    if(theInputConnection)
    {
       ossimIrect inputRect = getViewingRect();;
@@ -647,6 +651,139 @@ void ossimMapCompositionSource::drawBorders()
    }
 }
 
+void ossimMapCompositionSource::loadBorders()
+{
+   if(!theTile.valid() || theTopBorder.hasNans())
+   {
+      return;
+   }
+
+   const ossimIrect tileRect = theTile->getImageRectangle();
+   if(!theTopBorder.intersects(tileRect) && !theBottomBorder.intersects(tileRect) &&
+      !theLeftBorder.intersects(tileRect) && !theRightBorder.intersects(tileRect))
+   {
+      return;
+   }
+   const ossimIrect outerRect(theTopBorder.ul(), theBottomBorder.lr());
+
+   if((theBorderCacheId != -1) &&
+      ((theBorderCacheColor != theBorderColor) ||
+       (theBorderCacheBands != theTile->getNumberOfBands())))
+   {
+      deleteBorderCache();
+   }
+
+   const ossim_int32 BLOCK_SIZE = 256;
+   ossimAppFixedTileCache* cache = ossimAppFixedTileCache::instance();
+   if(theBorderCacheId == -1)
+   {
+      ossimIrect cacheRect = outerRect;
+      cacheRect.stretchToTileBoundary(ossimIpt(BLOCK_SIZE, BLOCK_SIZE));
+      theBorderCacheId = cache->newTileCache(cacheRect, ossimIpt(BLOCK_SIZE, BLOCK_SIZE));
+      theBorderCacheColor = theBorderColor;
+      theBorderCacheBands = theTile->getNumberOfBands();
+   }
+
+   const ossimIrect borders[4] = { theTopBorder, theBottomBorder, theLeftBorder, theRightBorder };
+   ossimIrect blocksRect = tileRect.clipToRect(outerRect);
+   blocksRect.stretchToTileBoundary(ossimIpt(BLOCK_SIZE, BLOCK_SIZE));
+   for(ossim_int32 y = blocksRect.ul().y; y <= blocksRect.lr().y; y += BLOCK_SIZE)
+   {
+      for(ossim_int32 x = blocksRect.ul().x; x <= blocksRect.lr().x; x += BLOCK_SIZE)
+      {
+         const ossimIrect blockRect(x, y, x + BLOCK_SIZE - 1, y + BLOCK_SIZE - 1);
+         const ossimIrect clipRect = blockRect.clipToRect(tileRect);
+         ossimRefPtr<ossimImageData> block = 0;
+         for(ossim_uint32 idx = 0; idx < 4; ++idx)
+         {
+            if(!borders[idx].intersects(clipRect))
+            {
+               continue;
+            }
+            if(!block.valid())
+            {
+               block = cache->getTile(theBorderCacheId, blockRect.ul());
+               if(!block.valid())
+               {
+                  block = new ossimU8ImageData(0, theBorderCacheBands, BLOCK_SIZE, BLOCK_SIZE);
+                  block->initialize();
+                  block->setOrigin(blockRect.ul());
+                  renderBorderBlock(block.get());
+                  cache->addTile(theBorderCacheId, block, false);
+               }
+            }
+            theTile->loadTile(block->getBuf(), blockRect,
+                              borders[idx].clipToRect(clipRect), OSSIM_BSQ);
+         }
+      }
+   }
+}
+
+void ossimMapCompositionSource::renderBorderBlock(ossimImageData* block)
+{
+   const ossimIrect blockRect = block->getImageRectangle();
+   ossimImageDataHelper helper(block);
+
+   const ossimIrect borders[4] = { theTopBorder, theBottomBorder, theLeftBorder, theRightBorder };
+   for(ossim_uint32 idx = 0; idx < 4; ++idx)
+   {
+      if(borders[idx].intersects(blockRect))
+      {
+         helper.fill(theBorderColor, borders[idx].clipToRect(blockRect), false);
+      }
+   }
+
+   if(theImage.valid())
+   {
+      ossimRefPtr<ossimImageData> blockData = block;
+      theImage->setCurrentImageData(blockData);
+      ossimAnnotationSource::AnnotationObjectListType::iterator object = theFixedAnnotationList.begin();
+      while(object != theFixedAnnotationList.end())
+      {
+         if((*object).valid())
+         {
+            (*object)->draw(*theImage);
+         }
+         ++object;
+      }
+      theImage->setCurrentImageData(theTile);
+   }
+   block->validate();
+}
+
+void ossimMapCompositionSource::deleteBorderCache()
+{
+   if(theBorderCacheId != -1)
+   {
+      ossimAppFixedTileCache::instance()->deleteCache(theBorderCacheId);
+      theBorderCacheId = -1;
+   }
+}
+
+bool ossimMapCompositionSource::isWithinBorders(const ossimIrect& rect)const
+{
+   if(theTopBorder.hasNans())
+   {
+      return false;
+   }
+   const ossimIrect outerRect(theTopBorder.ul(), theBottomBorder.lr());
+   if(!rect.completely_within(outerRect))
+   {
+      return false;
+   }
+
+   // The borders overlap the edge pixels of the viewing rect; inside those:
+   const ossimIrect innerRect(theLeftBorder.lr().x + 1,
+                              theTopBorder.lr().y + 1,
+                              theRightBorder.ul().x - 1,
+                              theBottomBorder.ul().y - 1);
+   if((innerRect.lr().x < innerRect.ul().x) || (innerRect.lr().y < innerRect.ul().y))
+   {
+      return true;
+   }
+   return !rect.intersects(innerRect);
+}
+
 void ossimMapCompositionSource::addGridLabels()
 {
    addGeographicTopGridLabels();
@@ -1898,7 +2035,13 @@ void ossimMapCompositionSource::drawAnnotations(
       
    theImage->setCurrentImageData(theTile);
    
-   if(theImage->getImageData().valid())
+   //---
+   // Tiles of only border pixels got the fixed annotations with the borders.
+   // Elsewhere drawing them again over the cached border pixels leaves them
+   // as they are.
+   //---
+   if(theImage->getImageData().valid() &&
+      !isWithinBorders(theImage->getImageData()->getImageRectangle()))
    {
       ossimAnnotationSource::AnnotationObjectListType::iterator object = theFixedAnnotationList.begin();
       while(object != theFixedAnnotationList.end())
@@ -1917,6 +2060,7 @@ void ossimMapCompositionSource::drawAnnotations(
 void ossimMapCompositionSource::deleteFixedAnnotations()
 {
    theFixedAnnotationList.clear();
+   deleteBorderCache();
 }
 
 
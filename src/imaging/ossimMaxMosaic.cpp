@@ -397,6 +397,8 @@ template <class T> ossimRefPtr<ossimImageData> ossimMaxMosaic::combineNorm(
             }
          }
       }
+      // destBands were fetched before the loop so drop the cached status to force a rescan.
+      destination->invalidateStatus();
       destination->validate();
       
       currentImageData = getNextNormTile(layerIdx, tileRect, resLevel);
@@ -527,6 +529,8 @@ template <class T> ossimRefPtr<ossimImageData> ossimMaxMosaic::combine(
          }
       }
       
+      // destBands were fetched before the loop so drop the cached status to force a rescan.
+      destination->invalidateStatus();
       destination->validate();
       
       currentImageData = getNextTile(layerIdx,tileRect, resLevel);
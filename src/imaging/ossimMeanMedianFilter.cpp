@@ -17,6 +17,7 @@
 #include <ossim/imaging/ossimImageData.h>
 #include <vector>
 #include <algorithm>
+#include <limits>
 #include <numeric>
 using namespace std;
 
@@ -30,6 +31,69 @@ static const ossimString WINDOW_SIZE_KW = "window_size";
 static const ossimString FILTER_TYPE_KW = "filter_type";
 static const ossimString AUTO_GROW_KW   = "auto_grow_rectangle_flag";
 
+namespace
+{
+   //---
+   // Histogram of the samples of a window, as bin counts and counts of groups of bins, so the
+   // n-th smallest sample is found scanning at most all groups then one group.  Samples are
+   // offset to start at bin 0.
+   //---
+   class ossimWindowHistogram
+   {
+   public:
+      ossimWindowHistogram(ossim_uint32 bits, ossim_int32 offset)
+         : theBins(1 << bits, 0),
+           theGroups(1 << (bits - bits/2), 0),
+           theShift(bits/2),
+           theOffset(offset),
+           theCount(0)
+      {}
+
+      void add(ossim_int32 value)
+      {
+         const ossim_uint32 bin = (ossim_uint32)(value + theOffset);
+         ++theBins[bin];
+         ++theGroups[bin >> theShift];
+         ++theCount;
+      }
+
+      void remove(ossim_int32 value)
+      {
+         const ossim_uint32 bin = (ossim_uint32)(value + theOffset);
+         --theBins[bin];
+         --theGroups[bin >> theShift];
+         --theCount;
+      }
+
+      ossim_uint32 count() const { return theCount; }
+
+      /** @return The n-th smallest sample, from 0; n must be less than count(). */
+      ossim_int32 nth(ossim_uint32 n) const
+      {
+         ossim_uint32 group = 0;
+         while (n >= theGroups[group])
+         {
+            n -= theGroups[group];
+            ++group;
+         }
+         ossim_uint32 bin = group << theShift;
+         while (n >= theBins[bin])
+         {
+            n -= theBins[bin];
+            ++bin;
+         }
+         return (ossim_int32)bin - theOffset;
+      }
+
+   private:
+      std::vector<ossim_uint32> theBins;
+      std::vector<ossim_uint32> theGroups;
+      ossim_uint32 theShift;
+      ossim_int32  theOffset;
+      ossim_uint32 theCount;
+   };
+}
+
 ossimMeanMedianFilter::ossimMeanMedianFilter(ossimObject* owner)
    :ossimImageSourceFilter(owner),
     theTile(0),
@@ -285,6 +349,13 @@ template <class T>
 void ossimMeanMedianFilter::applyMean(T /* dummyVariable */,
                                       ossimRefPtr<ossimImageData>& inputData)
 {
+   if(std::numeric_limits<T>::is_integer)
+   {
+      // Integer sums are exact in any order.
+      applyRunningMean(T(0), inputData);
+      return;
+   }
+   
    ossim_uint32 halfWindow = (theWindowSize >> 1);
    ossim_uint32 bandIdx = 0;
    ossim_uint32 x = 0;
@@ -504,6 +575,12 @@ template <class T>
 void ossimMeanMedianFilter::applyMedian(T /* dummyVariable */,
                                         ossimRefPtr<ossimImageData>& inputData)
 {
+   if(std::numeric_limits<T>::is_integer && (sizeof(T) <= 2))
+   {
+      applyHistogramMedian(T(0), inputData);
+      return;
+   }
+   
    ossim_uint32 halfWindow = (theWindowSize >> 1);
    ossim_uint32 bandIdx = 0;
    ossim_uint32 x = 0;
@@ -542,8 +619,10 @@ void ossimMeanMedianFilter::applyMedian(T /* dummyVariable */,
                      }
                   }
 
-                  std::sort(values.begin(),
-                            values.end());
+                  // Only the middle element is needed.
+                  std::nth_element(values.begin(),
+                                   values.begin() + (values.size()>>1),
+                                   values.end());
 
                   if(values.size() > 0)
                   {
@@ -585,8 +664,10 @@ void ossimMeanMedianFilter::applyMedian(T /* dummyVariable */,
                      }
                   }
 
-                  std::sort(values.begin(),
-                            values.end());
+                  // Only the middle element is needed.
+                  std::nth_element(values.begin(),
+                                   values.begin() + (values.size()>>1),
+                                   values.end());
 
                   if(values.size() > 0)
                   {
@@ -713,6 +794,219 @@ template <class T> void ossimMeanMedianFilter::applyMedianNullCenterOnly (
    }  // End of else "partial tile" block.
 }
 
+template <class T>
+void ossimMeanMedianFilter::applyRunningMean(T /* dummyVariable */,
+                                             ossimRefPtr<ossimImageData>& inputData)
+{
+   // Same output as the applyMean() loops, from window sums updated one column at a time.
+   const ossim_uint32 halfWindow = (theWindowSize >> 1);
+   const ossim_uint32 iw = inputData->getWidth();
+   const ossim_uint32 ow = theTile->getWidth();
+   const ossim_uint32 oh = theTile->getHeight();
+   const ossim_uint32 numberOfBands = ossim::min(theTile->getNumberOfBands(),
+                                                 inputData->getNumberOfBands());
+   const bool checkNulls = (inputData->getDataObjectStatus() != OSSIM_FULL);
+   if(!theWindowSize)
+   {
+      return;
+   }
+
+   // Sums and non-null counts of theWindowSize rows, per input column.
+   std::vector<ossim_int64>  columnSum(iw);
+   std::vector<ossim_uint32> columnCount(iw);
+   
+   for(ossim_uint32 bandIdx = 0; bandIdx < numberOfBands; ++bandIdx)
+   {
+      const T* inputBuf = (const T*)inputData->getBuf(bandIdx);
+      T* outputBuf      = (T*)theTile->getBuf(bandIdx);
+      const T np        = (T)inputData->getNullPix(bandIdx);
+      if(!inputBuf || !outputBuf)
+      {
+         continue;
+      }
+
+      std::fill(columnSum.begin(), columnSum.end(), 0);
+      std::fill(columnCount.begin(), columnCount.end(), 0);
+      for(ossim_uint32 kernelY = 0; kernelY < theWindowSize; ++kernelY)
+      {
+         const T* row = inputBuf + kernelY*iw;
+         for(ossim_uint32 c = 0; c < iw; ++c)
+         {
+            if(!checkNulls || (row[c] != np))
+            {
+               columnSum[c] += row[c];
+               ++columnCount[c];
+            }
+         }
+      }
+      
+      for(ossim_uint32 y = 0; y < oh; ++y)
+      {
+         if(y > 0)
+         {
+            // Drop input row y-1, add row y+theWindowSize-1.
+            const T* top    = inputBuf + (y - 1)*iw;
+            const T* bottom = inputBuf + (y + theWindowSize - 1)*iw;
+            for(ossim_uint32 c = 0; c < iw; ++c)
+            {
+               if(!checkNulls || (top[c] != np))
+               {
+                  columnSum[c] -= top[c];
+                  --columnCount[c];
+               }
+               if(!checkNulls || (bottom[c] != np))
+               {
+                  columnSum[c] += bottom[c];
+                  ++columnCount[c];
+               }
+            }
+         }
+
+         ossim_int64  sum   = 0;
+         ossim_uint32 count = 0;
+         for(ossim_uint32 kernelX = 0; kernelX < theWindowSize; ++kernelX)
+         {
+            sum   += columnSum[kernelX];
+            count += columnCount[kernelX];
+         }
+         
+         const T* center = inputBuf + (y + halfWindow)*iw + halfWindow;
+         T* out = outputBuf + y*ow;
+         for(ossim_uint32 x = 0; x < ow; ++x)
+         {
+            if(x > 0)
+            {
+               sum   += columnSum[x + theWindowSize - 1] - columnSum[x - 1];
+               count += columnCount[x + theWindowSize - 1];
+               count -= columnCount[x - 1];
+            }
+
+            if(count > 0)
+            {
+               const double average = (double)sum/(double)count;
+               if(checkNulls && (center[x] == np) && !theEnableFillNullFlag)
+               {
+                  out[x] = np;
+               }
+               else
+               {
+                  out[x] = (T)average;
+               }
+            }
+            else
+            {
+               out[x] = np;
+            }
+         }
+      }
+   }
+}
+
+template <class T>
+void ossimMeanMedianFilter::applyHistogramMedian(T /* dummyVariable */,
+                                                 ossimRefPtr<ossimImageData>& inputData)
+{
+   //---
+   // Same output as the applyMedian() loops: the element at size/2 of the sorted non-null
+   // window, taken from the histogram of the window, which moves one column per pixel.
+   //---
+   const ossim_uint32 halfWindow = (theWindowSize >> 1);
+   const ossim_uint32 iw = inputData->getWidth();
+   const ossim_uint32 ow = theTile->getWidth();
+   const ossim_uint32 oh = theTile->getHeight();
+   const ossim_uint32 numberOfBands = ossim::min(theTile->getNumberOfBands(),
+                                                 inputData->getNumberOfBands());
+   const bool checkNulls = (inputData->getDataObjectStatus() != OSSIM_FULL);
+   if(!theWindowSize)
+   {
+      return;
+   }
+
+   const ossim_int32 offset = -(ossim_int32)std::numeric_limits<T>::min();
+   ossimWindowHistogram histogram(sizeof(T)*8, offset);
+
+   for(ossim_uint32 bandIdx = 0; bandIdx < numberOfBands; ++bandIdx)
+   {
+      const T* inputBuf = (const T*)inputData->getBuf(bandIdx);
+      T* outputBuf      = (T*)theTile->getBuf(bandIdx);
+      const T np        = (T)inputData->getNullPix(bandIdx);
+      if(!inputBuf || !outputBuf)
+      {
+         continue;
+      }
+
+      for(ossim_uint32 y = 0; y < oh; ++y)
+      {
+         const T* windowTop = inputBuf + y*iw;
+         for(ossim_uint32 kernelY = 0; kernelY < theWindowSize; ++kernelY)
+         {
+            const T* row = windowTop + kernelY*iw;
+            for(ossim_uint32 kernelX = 0; kernelX < theWindowSize; ++kernelX)
+            {
+               if(!checkNulls || (row[kernelX] != np))
+               {
+                  histogram.add(row[kernelX]);
+               }
+            }
+         }
+
+         const T* center = windowTop + halfWindow*iw + halfWindow;
+         T* out = outputBuf + y*ow;
+         for(ossim_uint32 x = 0; x < ow; ++x)
+         {
+            if(x > 0)
+            {
+               // Column x-1 leaves the window, column x+theWindowSize-1 enters.
+               const T* left  = windowTop + x - 1;
+               const T* right = windowTop + x + theWindowSize - 1;
+               for(ossim_uint32 kernelY = 0; kernelY < theWindowSize; ++kernelY)
+               {
+                  if(!checkNulls || (left[kernelY*iw] != np))
+                  {
+                     histogram.remove(left[kernelY*iw]);
+                  }
+                  if(!checkNulls || (right[kernelY*iw] != np))
+                  {
+                     histogram.add(right[kernelY*iw]);
+                  }
+               }
+            }
+
+            const ossim_uint32 count = histogram.count();
+            if(count > 0)
+            {
+               if(checkNulls && (center[x] == np) && !theEnableFillNullFlag)
+               {
+                  out[x] = np;
+               }
+               else
+               {
+                  out[x] = (T)histogram.nth(count>>1);
+               }
+            }
+            else
+            {
+               out[x] = np;
+            }
+         }
+
+         // Empty the histogram: remove the last window of the row.
+         const T* last = windowTop + ow - 1;
+         for(ossim_uint32 kernelY = 0; kernelY < theWindowSize; ++kernelY)
+         {
+            const T* row = last + kernelY*iw;
+            for(ossim_uint32 kernelX = 0; kernelX < theWindowSize; ++kernelX)
+            {
+               if(!checkNulls || (row[kernelX] != np))
+               {
+                  histogram.remove(row[kernelX]);
+               }
+            }
+         }
+      }
+   }
+}
+
 void ossimMeanMedianFilter::setProperty(ossimRefPtr<ossimProperty> property)
 {
    if(!property.valid())
@@ -26,6 +26,7 @@
 #include <ossim/base/ossimScalarTypeLut.h>
 #include <ossim/base/ossimEndian.h>
 #include <ossim/base/ossimBooleanProperty.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
 #include <ossim/imaging/ossimImageGeometry.h>
 #include <ossim/imaging/ossimJpegMemSrc.h>
@@ -39,6 +40,10 @@
 #include <ossim/support_data/ossimNitfImageHeaderV2_1.h>
 #include <ossim/support_data/ossimNitfStdidcTag.h>
 #include <ossim/support_data/ossimNitfVqCompressionHeader.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <OpenThreads/Block>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
 
 #if defined(JPEG_DUAL_MODE_8_12)
 #include <ossim/imaging/ossimNitfTileSource_12.h>
@@ -76,6 +81,76 @@ static ossimTrace traceDebug("ossimNitfTileSource:debug");
 // divide by 8 bits to get bytes gives you 6144 bytes
 static const ossim_uint32   OSSIM_NITF_VQ_BLOCKSIZE = 6144;
 
+namespace
+{
+   /** Completion count of the uncompress jobs of one getTile. */
+   class ossimNitfUncompressBatch : public ossimReferenced
+   {
+   public:
+      ossimNitfUncompressBatch(ossim_uint32 count)
+         : m_count(count)
+      {
+         if(m_count)
+         {
+            m_block.reset();
+         }
+         else
+         {
+            m_block.release();
+         }
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_count && (--m_count == 0))
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+   private:
+      OpenThreads::Mutex m_mutex;
+      OpenThreads::Block m_block;
+      ossim_uint32       m_count;
+   };
+}
+
+/** Uncompresses one block already read into memory into its own tile. */
+class ossimNitfUncompressJob : public ossimJob
+{
+public:
+   ossimNitfUncompressJob(ossimNitfTileSource* source,
+                          ossimImageData* tile,
+                          std::vector<ossim_uint8>& buf,
+                          ossimNitfUncompressBatch* batch)
+      : m_source(source),
+        m_tile(tile),
+        m_buf(),
+        m_status(false),
+        m_batch(batch)
+   {
+      m_buf.swap(buf);
+      setName("ossimNitfTileSource.uncompress");
+   }
+   virtual void start()
+   {
+      m_status = m_source->uncompressBlock(m_buf, m_tile.get());
+      std::vector<ossim_uint8>().swap(m_buf);
+      m_batch->done();
+   }
+   ossimImageData* getTile() { return m_tile.get(); }
+   bool getStatus() const { return m_status; }
+private:
+   ossimNitfTileSource*                  m_source;
+   ossimRefPtr<ossimImageData>           m_tile;
+   std::vector<ossim_uint8>              m_buf;
+   bool                                  m_status;
+   ossimRefPtr<ossimNitfUncompressBatch> m_batch;
+};
+
 ossimNitfTileSource::ossimNitfTileSource()
    :
       ossimImageHandler(),
@@ -94,6 +169,7 @@ ossimNitfTileSource::ossimNitfTileSource()
       theCurrentEntry(0),
       theImageRect(0,0,0,0),
       theFileStr(),
+      theReadAhead(),
       theOutputBandList(),
       theCacheSize(0, 0),
       theCacheTileInterLeaveType(OSSIM_INTERLEAVE_UNKNOWN),
@@ -104,8 +180,16 @@ ossimNitfTileSource::ossimNitfTileSource()
       theNitfBlockOffset(0),
       theNitfBlockSize(0),
       m_isJpeg12Bit(false),
-      m_jpegOffsetsDirty(false)
+      m_jpegOffsetsDirty(false),
+      m_uncompressThreads(1),
+      m_uncompressQueue(0)
 {
+   const char* lookup = ossimPreferences::instance()->findPreference("nitf.uncompress_threads");
+   if (lookup)
+   {
+      m_uncompressThreads = ossimString(lookup).toUInt32();
+   }
+
    if (traceDebug())
    {
       ossimNotify(ossimNotifyLevel_DEBUG)
@@ -137,6 +221,7 @@ void ossimNitfTileSource::destroy()
    {
       theFileStr.close();
    }
+   theReadAhead.close();
 
    theCacheTile = 0;
    theTile      = 0;
@@ -373,6 +458,9 @@ bool ossimNitfTileSource::parseFile()
       return false;
    }
 
+   // Read ahead hints for prefetch; not an error if not supported.
+   theReadAhead.open(file);
+
    if(traceDebug())
    {
       ossimNotify(ossimNotifyLevel_DEBUG)
@@ -1346,6 +1434,102 @@ ossimRefPtr<ossimImageData> ossimNitfTileSource::getTile(
    return theTile;   
 }
 
+void ossimNitfTileSource::prefetch(const std::vector<ossimIrect>& rects,
+                                   ossim_uint32 resLevel)
+{
+   if ( resLevel && theOverview.valid() && theOverview->isValidRLevel(resLevel) )
+   {
+      ossimImageHandler::prefetch(rects, resLevel);
+      return;
+   }
+
+   ossim_uint32 level = resLevel;
+   if ( theStartingResLevel && (theStartingResLevel <= resLevel) )
+   {
+      level -= theStartingResLevel; // Used as overview.
+   }
+
+   const ossimNitfImageHeader* hdr = getCurrentImageHeader();
+   if ( level || !hdr || !theReadAhead.isOpen() ||
+        (theCacheSize.x <= 0) || (theCacheSize.y <= 0) )
+   {
+      return;
+   }
+
+   //---
+   // Jpeg block offsets are only known after the first read scans for them; hint nothing until
+   // then.
+   //---
+   const bool JPEG = (theReadMode == READ_JPEG_BLOCK);
+   if ( JPEG && ( m_jpegOffsetsDirty || theNitfBlockOffset.empty() ||
+                  (theNitfBlockOffset.size() != theNitfBlockSize.size()) ) )
+   {
+      return;
+   }
+
+   ossim_uint32 bands = 1;
+   switch (theReadMode)
+   {
+      case READ_BIR:
+      case READ_BIR_BLOCK:
+      case READ_BIP:
+      case READ_BIP_BLOCK:
+      case READ_JPEG_BLOCK:
+      {
+         break;
+      }
+      case READ_BSQ_BLOCK:
+      case READ_BIB_BLOCK:
+      case READ_BIB:
+      {
+         bands = theNumberOfInputBands;
+         break;
+      }
+      default:
+      {
+         return;
+      }
+   }
+
+   std::vector<ossimIrect>::const_iterator r = rects.begin();
+   while ( r != rects.end() )
+   {
+      if ( (*r).intersects(theBlockImageRect) )
+      {
+         ossimIrect zbClipRect = (*r).clipToRect(theImageRect);
+         zbClipRect.stretchToTileBoundary(theCacheSize);
+
+         for (ossim_int32 y = zbClipRect.ul().y; y < zbClipRect.lr().y; y += theCacheSize.y)
+         {
+            for (ossim_int32 x = zbClipRect.ul().x; x < zbClipRect.lr().x; x += theCacheSize.x)
+            {
+               if ( JPEG )
+               {
+                  ossim_uint32 blockNumber = getBlockNumber( ossimIpt(x, y) );
+                  if ( blockNumber < theNitfBlockOffset.size() )
+                  {
+                     theReadAhead.willNeed(theNitfBlockOffset[blockNumber],
+                                           theNitfBlockSize[blockNumber]);
+                  }
+               }
+               else
+               {
+                  for (ossim_uint32 band = 0; band < bands; ++band)
+                  {
+                     std::streamoff p;
+                     if ( getPosition(p, x, y, band) )
+                     {
+                        theReadAhead.willNeed(p, theReadBlockSizeInBytes);
+                     }
+                  }
+               }
+            }
+         }
+      }
+      ++r;
+   }
+}
+
 bool ossimNitfTileSource::loadTile(const ossimIrect& clipRect)
 {
    ossimIrect zbClipRect  = clipRect;
@@ -1361,6 +1545,10 @@ bool ossimNitfTileSource::loadTile(const ossimIrect& clipRect)
    //---
    ossimIpt nitfBlockOrigin = zbClipRect.ul();
 
+   // Blocks missing from the cache, when they are uncompressed concurrently.
+   const bool CONCURRENT = (m_uncompressThreads > 1) && hasConcurrentUncompress();
+   std::vector<ossimIpt> origins;
+
    // Vertical block loop.
    ossim_int32 y = nitfBlockOrigin.y;
    while (y < zbClipRect.lr().y)
@@ -1371,7 +1559,11 @@ bool ossimNitfTileSource::loadTile(const ossimIrect& clipRect)
       {
          if ( loadBlockFromCache(x, y, clipRect) == false )
          {
-            if ( loadBlock(x, y) )
+            if ( CONCURRENT )
+            {
+               origins.push_back( ossimIpt(x, y) );
+            }
+            else if ( loadBlock(x, y) )
             {
                //---
                // Note: Clip the cache tile(nitf block) to the image clipRect
@@ -1399,9 +1591,278 @@ bool ossimNitfTileSource::loadTile(const ossimIrect& clipRect)
       y += BLOCK_HEIGHT; // Go to next row of blocks.
    }
 
+   if ( origins.size() )
+   {
+      return loadBlocksConcurrently(origins, clipRect);
+   }
+
+   return true;
+}
+
+bool ossimNitfTileSource::hasConcurrentUncompress() const
+{
+   const ossimNitfImageHeader* hdr = getCurrentImageHeader();
+   if ( !hdr )
+   {
+      return false;
+   }
+   switch (theReadMode)
+   {
+      case READ_JPEG_BLOCK:
+      {
+         return true;
+      }
+      case READ_BSQ_BLOCK:
+      case READ_BIB_BLOCK:
+      case READ_BIB:
+      {
+         return ( isVqCompressed(hdr->getCompressionCode()) ||
+                  hdr->getRepresentation().upcase().contains("LUT") );
+      }
+      default:
+      {
+         return false;
+      }
+   }
+}
+
+bool ossimNitfTileSource::loadBlocksConcurrently(const std::vector<ossimIpt>& origins,
+                                                 const ossimIrect& clipRect)
+{
+   std::vector<ossimIpt>::const_iterator origin = origins.begin();
+   if ( origins.size() == 1 )
+   {
+      if ( !loadBlock( (*origin).x, (*origin).y ) )
+      {
+         return false;
+      }
+      ossimIrect cr = theCacheTile->getImageRectangle().clipToRect(clipRect);
+      theTile->loadTile(theCacheTile->getBuf(),
+                        theCacheTile->getImageRectangle(),
+                        cr,
+                        theCacheTileInterLeaveType);
+      return true;
+   }
+
+   if ( !m_uncompressQueue.valid() )
+   {
+      m_uncompressQueue = new ossimJobMultiThreadQueue(0, m_uncompressThreads);
+   }
+
+   // Reads stay on this thread, on the one stream.
+   bool status = true;
+   ossimRefPtr<ossimNitfUncompressBatch> batch =
+      new ossimNitfUncompressBatch( static_cast<ossim_uint32>(origins.size()) );
+   std::vector< ossimRefPtr<ossimNitfUncompressJob> > jobs;
+   while ( origin != origins.end() )
+   {
+      ossimRefPtr<ossimImageData> tile = ossimImageDataFactory::instance()->create(
+         this, theScalarType, theNumberOfOutputBands, theCacheSize.x, theCacheSize.y);
+      tile->initialize();
+      tile->setOrigin(*origin);
+      tile->makeBlank();
+
+      std::vector<ossim_uint8> buf;
+      if ( !readCompressedBlock( (*origin).x, (*origin).y, buf ) )
+      {
+         theFileStr.clear();
+         ossimNotify(ossimNotifyLevel_FATAL)
+            << "ossimNitfTileSource::loadBlocksConcurrently Read Error!"
+            << "\nReturning error..." << endl;
+         status = false;
+         while ( origin != origins.end() )
+         {
+            batch->done();
+            ++origin;
+         }
+         break;
+      }
+
+      ossimRefPtr<ossimNitfUncompressJob> job =
+         new ossimNitfUncompressJob(this, tile.get(), buf, batch.get());
+      jobs.push_back(job);
+      m_uncompressQueue->getJobQueue()->add(job.get(), false);
+      ++origin;
+   }
+   batch->wait();
+
+   for (ossim_uint32 i = 0; i < jobs.size(); ++i)
+   {
+      ossimImageData* tile = jobs[i]->getTile();
+      if ( !jobs[i]->getStatus() )
+      {
+         ossimNotify(ossimNotifyLevel_FATAL)
+            << "ossimNitfTileSource::loadBlocksConcurrently uncompress error at "
+            << tile->getOrigin() << std::endl;
+         status = false;
+         continue;
+      }
+      if (theCacheEnabledFlag)
+      {
+         ossimAppFixedTileCache::instance()->addTile(theCacheId, tile, false);
+      }
+      ossimIrect cr = tile->getImageRectangle().clipToRect(clipRect);
+      theTile->loadTile(tile->getBuf(), tile->getImageRectangle(), cr,
+                        theCacheTileInterLeaveType);
+   }
+
+   return status;
+}
+
+bool ossimNitfTileSource::readCompressedBlock(ossim_uint32 x, ossim_uint32 y,
+                                              std::vector<ossim_uint8>& buf)
+{
+   if (theReadMode == READ_JPEG_BLOCK)
+   {
+      //---
+      // Logic to hold off on scanning for offsets until a block is actually
+      // needed to speed up loads for things like ossim-info that don't
+      // actually read pixel data.
+      //---
+      if ( m_jpegOffsetsDirty )
+      {
+         if ( scanForJpegBlockOffsets() )
+         {
+            m_jpegOffsetsDirty = false;
+         }
+         else
+         {
+            ossimNotify(ossimNotifyLevel_FATAL)
+               << "ossimNitfTileSource::readCompressedBlock scan for offsets error!"
+               << "\nReturning error..." << endl;
+            theErrorStatus = ossimErrorCodes::OSSIM_ERROR;
+            return false;
+         }
+      }
+
+      ossim_uint32 blockNumber = getBlockNumber( ossimIpt(x,y) );
+      if ( blockNumber >= theNitfBlockOffset.size() )
+      {
+         return false;
+      }
+
+      if (traceDebug())
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << "ossimNitfTileSource::readCompressedBlock DEBUG:"
+            << "\nblockNumber:  " << blockNumber
+            << "\noffset to block: " << theNitfBlockOffset[blockNumber]
+            << "\nblock size: " << theNitfBlockSize[blockNumber]
+            << std::endl;
+      }
+
+      // Seek to the block and read it into memory.
+      theFileStr.seekg(theNitfBlockOffset[blockNumber], ios::beg);
+      buf.resize(theNitfBlockSize[blockNumber]);
+      if (!theFileStr.read((char*)&(buf.front()), theNitfBlockSize[blockNumber]))
+      {
+         theFileStr.clear();
+         ossimNotify(ossimNotifyLevel_FATAL)
+            << "ossimNitfTileSource::readCompressedBlock Read Error!"
+            << "\nReturning error..." << endl;
+         return false;
+      }
+      return true;
+   }
+
+   // Vq and lut blocks, one read per band as in loadBlock.
+   ossim_uint32 readSize = theReadBlockSizeInBytes;
+   ossimIrect rect(x, y, x + theCacheSize.x - 1, y + theCacheSize.y - 1);
+   if ( !rect.completely_within(theBlockImageRect) )
+   {
+      readSize = getPartialReadSize( ossimIpt(x, y) );
+   }
+   buf.assign(theNumberOfInputBands * theReadBlockSizeInBytes, 0);
+   for (ossim_uint32 band = 0; band < theNumberOfInputBands; ++band)
+   {
+      std::streamoff p;
+      if ( !getPosition(p, x, y, band) )
+      {
+         buf.clear(); // Masked block, left blank.
+         break;
+      }
+      else
+      {
+         theFileStr.seekg(p, ios::beg);
+         if ( !theFileStr.read((char*)&buf[band * theReadBlockSizeInBytes], readSize) )
+         {
+            theFileStr.clear();
+            ossimNotify(ossimNotifyLevel_FATAL)
+               << "ossimNitfTileSource::readCompressedBlock Read Error!"
+               << "\nReturning error..." << endl;
+            theErrorStatus = ossimErrorCodes::OSSIM_ERROR;
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+bool ossimNitfTileSource::uncompressBlock(const std::vector<ossim_uint8>& buf,
+                                          ossimImageData* tile)
+{
+   if ( buf.empty() )
+   {
+      // Nothing stored for the block.
+   }
+   else if (theReadMode == READ_JPEG_BLOCK)
+   {
+      if ( !uncompressJpeg(buf, tile) )
+      {
+         tile->makeBlank();
+         return false;
+      }
+   }
+   else
+   {
+      const ossimNitfImageHeader* hdr = getCurrentImageHeader();
+      const ossimString CODE = hdr->getCompressionCode();
+      for (ossim_uint32 band = 0; band < theNumberOfInputBands; ++band)
+      {
+         ossim_uint8* source =
+            const_cast<ossim_uint8*>(&buf[band * theReadBlockSizeInBytes]);
+         if (CODE == "C4")
+         {
+            vqUncompressC4(tile, source);
+         }
+         else if (CODE == "M4")
+         {
+            vqUncompressM4(tile, source);
+         }
+         else
+         {
+            lutUncompress(tile, source);
+         }
+      }
+   }
+   finishBlock(tile);
    return true;
 }
 
+void ossimNitfTileSource::finishBlock(ossimImageData* tile) const
+{
+   if(thePackedBitsFlag)
+   {
+      explodePackedBits(tile);
+   }
+   // Check for swap bytes.
+   if (theSwapBytesFlag)
+   {
+      ossimEndian swapper;
+      swapper.swap(theScalarType,
+                   tile->getBuf(),
+                   tile->getSize());
+   }
+
+   const ossimNitfImageHeader* hdr = getCurrentImageHeader();
+   if ( !isVqCompressed(hdr->getCompressionCode()) )
+   {
+      convertTransparentToNull(tile);
+   }
+
+   tile->validate();
+}
+
 bool ossimNitfTileSource::loadBlockFromCache(ossim_uint32 x, ossim_uint32 y,
                                              const ossimIrect& clipRect)
 {
@@ -1428,7 +1889,9 @@ bool ossimNitfTileSource::loadBlockFromCache(ossim_uint32 x, ossim_uint32 y,
          ossimIrect cr =
             tempTile->getImageRectangle().clipToRect(clipRect);
 
-         theTile->loadTile(tempTile.get()->getBuf(),
+         // Const access so the cached tile's shared buffer is not copied.
+         const ossimImageData* cachedTile = tempTile.get();
+         theTile->loadTile(cachedTile->getBuf(),
                            tempTile->getImageRectangle(),
                            cr,
                            theCacheTileInterLeaveType);
@@ -1566,27 +2029,8 @@ bool ossimNitfTileSource::loadBlock(ossim_uint32 x, ossim_uint32 y)
       default:
          break;
    }
-   
-   if(thePackedBitsFlag)
-   {
-      explodePackedBits(theCacheTile);
-   }
-   // Check for swap bytes.
-   if (theSwapBytesFlag)
-   {
-      ossimEndian swapper;
-      swapper.swap(theScalarType,
-                   theCacheTile->getBuf(),
-                   theCacheTile->getSize());
-   }
 
-   if ( !isVqCompressed(hdr->getCompressionCode()) )
-   {
-      convertTransparentToNull(theCacheTile);
-   }
-
-   // Set the origin of the cache tile.
-   theCacheTile->validate();
+   finishBlock(theCacheTile.get());
    if (theCacheEnabledFlag)
    {
       // Add it to the cache for the next time.
@@ -3062,64 +3506,22 @@ bool ossimNitfTileSource::scanForJpegBlockOffsets()
 
 bool ossimNitfTileSource::uncompressJpegBlock(ossim_uint32 x, ossim_uint32 y)
 {
-   ossim_uint32 blockNumber = getBlockNumber( ossimIpt(x,y) );
-
-   if (traceDebug())
-   {
-      ossimNotify(ossimNotifyLevel_DEBUG)
-         << "ossimNitfTileSource::uncompressJpegBlock DEBUG:"
-         << "\nblockNumber:  " << blockNumber
-         << std::endl;
-   }
-
-   //---
-   // Logic to hold off on scanning for offsets until a block is actually needed
-   // to speed up loads for things like ossim-info that don't actually read
-   // pixel data.
-   //---
-   if ( m_jpegOffsetsDirty )
-   {
-      if ( scanForJpegBlockOffsets() )
-      {
-         m_jpegOffsetsDirty = false;
-      }
-      else
-      {
-         ossimNotify(ossimNotifyLevel_FATAL)
-            << "ossimNitfTileSource::uncompressJpegBlock scan for offsets error!"
-            << "\nReturning error..." << endl;
-         theErrorStatus = ossimErrorCodes::OSSIM_ERROR;
-         return false;
-      }
-   }
-   
-   if (traceDebug())
-   {
-      ossimNotify(ossimNotifyLevel_DEBUG)
-         << "\noffset to block: " << theNitfBlockOffset[blockNumber]
-         << "\nblock size: " << theNitfBlockSize[blockNumber]
-         << std::endl;
-   }
-   
-   // Seek to the block.
-   theFileStr.seekg(theNitfBlockOffset[blockNumber], ios::beg);
-   
-   // Read the block into memory.
-   std::vector<ossim_uint8> compressedBuf(theNitfBlockSize[blockNumber]);
-   if (!theFileStr.read((char*)&(compressedBuf.front()),
-                        theNitfBlockSize[blockNumber]))
+   std::vector<ossim_uint8> compressedBuf;
+   if ( !readCompressedBlock(x, y, compressedBuf) )
    {
-      theFileStr.clear();
-      ossimNotify(ossimNotifyLevel_FATAL)
-         << "ossimNitfTileSource::uncompressJpegBlock Read Error!"
-         << "\nReturning error..." << endl;
       return false;
    }
-   
+   return uncompressJpeg(compressedBuf, theCacheTile.get());
+}
+
+bool ossimNitfTileSource::uncompressJpeg(const std::vector<ossim_uint8>& compressedBuf,
+                                         ossimImageData* tile)
+{
    if (m_isJpeg12Bit)
    {
 #if defined(JPEG_DUAL_MODE_8_12)
-      return ossimNitfTileSource_12::uncompressJpeg12Block(x,y,theCacheTile, 
+      return ossimNitfTileSource_12::uncompressJpeg12Block(tile->getOrigin().x,
+       tile->getOrigin().y, tile, 
        getCurrentImageHeader(), theCacheSize, compressedBuf, theReadBlockSizeInBytes, 
        theNumberOfOutputBands);
 #endif  
@@ -3230,14 +3632,14 @@ bool ossimNitfTileSource::uncompressJpegBlock(ossim_uint32 x, ossim_uint32 y)
    /* JSAMPLEs per row in output buffer */
    const ossim_uint32 ROW_STRIDE = SAMPLES * cinfo.output_components;
 
-   if ( (SAMPLES < theCacheTile->getWidth() ) ||
-        (LINES_TO_READ < theCacheTile->getHeight()) )
+   if ( (SAMPLES < tile->getWidth() ) ||
+        (LINES_TO_READ < tile->getHeight()) )
    {
-      theCacheTile->makeBlank();
+      tile->makeBlank();
    }
 
-   if ( (SAMPLES > theCacheTile->getWidth()) ||
-        (LINES_TO_READ > theCacheTile->getHeight()) )
+   if ( (SAMPLES > tile->getWidth()) ||
+        (LINES_TO_READ > tile->getHeight()) )
    {
      // Error...
      jpeg_finish_decompress(&cinfo);
@@ -3249,7 +3651,7 @@ bool ossimNitfTileSource::uncompressJpegBlock(ossim_uint32 x, ossim_uint32 y)
    std::vector<ossim_uint8*> destinationBuffer(theNumberOfInputBands);
    for (ossim_uint32 band = 0; band < theNumberOfInputBands; ++band)
    {
-     destinationBuffer[band] = theCacheTile->getUcharBuf(band);
+     destinationBuffer[band] = tile->getUcharBuf(band);
    }
 
    std::vector<ossim_uint8> lineBuffer(ROW_STRIDE);
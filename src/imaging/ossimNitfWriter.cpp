@@ -14,6 +14,8 @@
 #include <ossim/base/ossimContainerProperty.h>
 #include <ossim/base/ossimEndian.h>
 #include <ossim/base/ossimNumericProperty.h>
+#include <ossim/base/ossimPositionalFile.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossimProperty.h>
 #include <ossim/base/ossimRefPtr.h>
 #include <ossim/base/ossimStringProperty.h>
@@ -25,10 +27,14 @@
 #include <ossim/projection/ossimProjectionFactoryRegistry.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimRectangleCutFilter.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
 #include <ossim/support_data/ossimNitfCommon.h>
 #include <ossim/support_data/ossimNitfProjectionParameterTag.h>
 #include <ossim/support_data/ossimNitfNameConversionTables.h>
 #include <ossim/support_data/ossimNitfImageDataMaskV2_1.h>
+#include <OpenThreads/Block>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
 #include <tiffio.h>
 #include <fstream>
 #include <algorithm>
@@ -46,6 +52,153 @@ static const ossim_uint64 MB50 = 50 * MB;
 static const ossim_uint64 GB = KB * MB;
 static const ossim_uint64 GB2 = 2 * GB;
 static const ossim_uint64 GB10 = 10 * GB;
+
+namespace
+{
+   /** Count of the unfinished block write jobs of one batch. */
+   class ossimNitfWriteBatch : public ossimReferenced
+   {
+   public:
+      ossimNitfWriteBatch()
+         : m_count(0)
+      {
+         m_block.release();
+      }
+      void add()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_count++ == 0)
+         {
+            m_block.reset();
+         }
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_count && (--m_count == 0))
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+   private:
+      OpenThreads::Mutex m_mutex;
+      OpenThreads::Block m_block;
+      ossim_uint32       m_count;
+   };
+
+   /** Swaps the samples of data to big endian, the nitf byte order. */
+   void swapTile(ossimImageData* data)
+   {
+      ossimEndian endian;
+      if(endian.getSystemEndianType() != OSSIM_LITTLE_ENDIAN)
+      {
+         return;
+      }
+      const ossim_uint32 SIZE = data->getWidth()*data->getHeight()*data->getNumberOfBands();
+      switch(data->getScalarType())
+      {
+         case OSSIM_USHORT16:
+         case OSSIM_USHORT11:
+         {
+            endian.swap((ossim_uint16*)data->getBuf(), SIZE);
+            break;
+         }
+         case OSSIM_SSHORT16:
+         {
+            endian.swap((ossim_sint16*)data->getBuf(), SIZE);
+            break;
+         }
+         case OSSIM_FLOAT:
+         case OSSIM_NORMALIZED_FLOAT:
+         {
+            endian.swap((ossim_float32*)data->getBuf(), SIZE);
+            break;
+         }
+         case OSSIM_DOUBLE:
+         case OSSIM_NORMALIZED_DOUBLE:
+         {
+            endian.swap((ossim_float64*)data->getBuf(), SIZE);
+            break;
+         }
+         default:
+            break;
+      }
+   }
+
+   /**
+    * Swaps one tile and writes it at its offset: the whole tile, or for band
+    * sequential output each band at offset + band * bandOffset.
+    */
+   class ossimNitfBlockWriteJob : public ossimJob
+   {
+   public:
+      ossimNitfBlockWriteJob(ossimImageData* tile,
+                             const ossimPositionalFile* file,
+                             ossim_uint64 offset,
+                             ossim_uint64 blockLength,
+                             bool bandSequential,
+                             ossim_uint64 bandOffset,
+                             ossimNitfWriteBatch* batch)
+         : m_tile(tile),
+           m_file(file),
+           m_offset(offset),
+           m_blockLength(blockLength),
+           m_bandSequential(bandSequential),
+           m_bandOffset(bandOffset),
+           m_status(false),
+           m_batch(batch)
+      {
+         setName("ossimNitfWriter.write");
+      }
+      virtual void start()
+      {
+         swapTile(m_tile.get());
+         if ( m_bandSequential )
+         {
+            m_status = true;
+            for (ossim_uint32 band = 0; band < m_tile->getNumberOfBands(); ++band)
+            {
+               m_status &= m_file->write(m_offset + band * m_bandOffset,
+                                         m_tile->getBuf(band),
+                                         static_cast<ossim_uint32>(m_blockLength));
+            }
+         }
+         else
+         {
+            m_status = m_file->write(m_offset, m_tile->getBuf(), m_tile->getSizeInBytes());
+         }
+         m_tile = 0;
+         m_batch->done();
+      }
+      bool getStatus() const { return m_status; }
+   private:
+      ossimRefPtr<ossimImageData>      m_tile;
+      const ossimPositionalFile*       m_file;
+      ossim_uint64                     m_offset;
+      ossim_uint64                     m_blockLength;
+      bool                             m_bandSequential;
+      ossim_uint64                     m_bandOffset;
+      bool                             m_status;
+      ossimRefPtr<ossimNitfWriteBatch> m_batch;
+   };
+
+   /** Waits for the jobs of batch. @return true if they all wrote their block. */
+   bool finishBlocks(ossimNitfWriteBatch* batch,
+                     std::vector< ossimRefPtr<ossimNitfBlockWriteJob> >& jobs)
+   {
+      batch->wait();
+      bool status = true;
+      for (ossim_uint32 i = 0; i < jobs.size(); ++i)
+      {
+         status &= jobs[i]->getStatus();
+      }
+      return status;
+   }
+}
                             
 ossimNitfWriter::ossimNitfWriter(const ossimFilename& filename,
                                  ossimImageSource* inputSource)
@@ -55,8 +208,15 @@ ossimNitfWriter::ossimNitfWriter(const ossimFilename& filename,
      m_imageHeader(0),
      m_textHeader(0),
      m_textEntry(),
-     m_blockSize(OSSIM_DEFAULT_TILE_WIDTH, OSSIM_DEFAULT_TILE_HEIGHT)
+     m_blockSize(OSSIM_DEFAULT_TILE_WIDTH, OSSIM_DEFAULT_TILE_HEIGHT),
+     m_writeThreads(1)
 {
+   const char* lookup = ossimPreferences::instance()->findPreference("nitf_writer.write_threads");
+   if (lookup)
+   {
+      m_writeThreads = ossimString(lookup).toUInt32();
+   }
+
    //---
    // Since the internal nitf tags are not very accurate, write an external
    // geometry out as default behavior.  Users can disable this via the
@@ -430,6 +590,18 @@ bool ossimNitfWriter::writeBlockBandSeparate()
       memset(&blockZeros.front(), '\0', blockLength);
       datamask.writeStream(*m_outputStream);
    }
+
+   if ( m_writeThreads > 1 )
+   {
+      // Written by the threads; the loop below has nothing left to do.
+      if ( !writeBlocksConcurrently(data.get(), numberOfTiles, blockLength, false, 0,
+                                    masked ? &datamask : 0) )
+      {
+         return false;
+      }
+      data = 0;
+   }
+
    while( data.valid() && !needsAborting())
    {
       bool write = true;
@@ -641,6 +813,17 @@ bool ossimNitfWriter::writeBlockBandSequential()
    ossim_uint64 blockSizeInBytes = m_blockSize.x*m_blockSize.y*ossim::scalarSizeInBytes(data->getScalarType());
    ossim_uint64 bandOffsetInBytes = (blockSizeInBytes*blocksHorizontal*blocksVertical);
 
+   if ( m_writeThreads > 1 )
+   {
+      // Written by the threads; the loop below has nothing left to do.
+      if ( !writeBlocksConcurrently(data.get(), numberOfTiles, blockSizeInBytes, true,
+                                    bandOffsetInBytes, 0) )
+      {
+         return false;
+      }
+      data = 0;
+   }
+
    bool needSwapping = endian.getSystemEndianType() == OSSIM_LITTLE_ENDIAN;
    while(data.valid() && !needsAborting())
    {
@@ -726,6 +909,115 @@ bool ossimNitfWriter::writeBlockBandSequential()
    return true;
 }
 
+bool ossimNitfWriter::writeBlocksConcurrently(ossimImageData* data,
+                                              ossim_uint64 numberOfTiles,
+                                              ossim_uint64 blockLength,
+                                              bool bandSequential,
+                                              ossim_uint64 bandOffset,
+                                              ossimNitfImageDataMaskV2_1* datamask)
+{
+   static const char MODULE[] = "ossimNitfWriter::writeBlocksConcurrently";
+
+   // The threads write through their own descriptor, after what the stream holds so far.
+   m_outputStream->flush();
+   const ossim_uint64 DATA_START = m_outputStream->tellp64();
+   ossimPositionalFile file;
+   if ( !data || !file.openForUpdate(theFilename) )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << MODULE << " ERROR:\nCould not open " << theFilename << " for update." << std::endl;
+      return false;
+   }
+   const ossim_uint64 BANDS = data->getNumberOfBands();
+
+   std::vector<char> blockZeros;
+   if ( datamask )
+   {
+      blockZeros.resize(blockLength, '\0');
+   }
+
+   const ossim_uint32 BATCH = 4 * m_writeThreads;
+   ossimRefPtr<ossimJobMultiThreadQueue> queue =
+      new ossimJobMultiThreadQueue(0, m_writeThreads);
+
+   //---
+   // Each batch of blocks is read and queued while the previous one is
+   // written.  Offsets are worked out here in tile order, so the blocks land
+   // where the serial loop would put them.
+   //---
+   std::vector< ossimRefPtr<ossimNitfBlockWriteJob> > pendingJobs;
+   ossimRefPtr<ossimNitfWriteBatch> pendingBatch = 0;
+   ossimRefPtr<ossimImageData> tile = data;
+   ossim_uint64 tileNumber = 0;
+   ossim_uint64 blocksWritten = 0;
+   bool status = true;
+
+   while ( status && tile.valid() && !needsAborting() )
+   {
+      ossimRefPtr<ossimNitfWriteBatch> batch = new ossimNitfWriteBatch();
+      std::vector< ossimRefPtr<ossimNitfBlockWriteJob> > jobs;
+      while ( tile.valid() && (jobs.size() < BATCH) && !needsAborting() )
+      {
+         bool write = true;
+         if ( datamask &&
+              (memcmp(tile->getBuf(), &blockZeros.front(), blockLength) == 0) )
+         {
+            write = false;
+            datamask->setIncludeBlock(tileNumber, false);
+         }
+         if ( write )
+         {
+            const ossim_uint64 OFFSET = DATA_START +
+               (bandSequential ? tileNumber : blocksWritten) * blockLength;
+
+            // The sequencer may hand back the same tile each time.
+            ossimRefPtr<ossimImageData> copy = static_cast<ossimImageData*>(tile->dup());
+            ossimRefPtr<ossimNitfBlockWriteJob> job =
+               new ossimNitfBlockWriteJob(copy.get(), &file, OFFSET, blockLength,
+                                          bandSequential, bandOffset, batch.get());
+            batch->add();
+            jobs.push_back(job);
+            queue->getJobQueue()->add(job.get(), false);
+            ++blocksWritten;
+         }
+         ++tileNumber;
+
+         setPercentComplete(((double)tileNumber / (double)numberOfTiles) * 100);
+
+         if(!needsAborting())
+         {
+            tile = theInputConnection->getNextTile();
+         }
+      }
+
+      if ( pendingBatch.valid() && !finishBlocks(pendingBatch.get(), pendingJobs) )
+      {
+         status = false;
+      }
+      pendingJobs.swap(jobs);
+      pendingBatch = batch;
+   }
+
+   if ( pendingBatch.valid() && !finishBlocks(pendingBatch.get(), pendingJobs) )
+   {
+      status = false;
+   }
+
+   if ( !status )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << MODULE << " ERROR:\nWriting image blocks failed." << std::endl;
+      setErrorStatus();
+      return false;
+   }
+
+   // Continue after the image data.
+   m_outputStream->seekp(
+      DATA_START + (bandSequential ? BANDS * bandOffset : blocksWritten * blockLength), ios::beg);
+
+   return true;
+}
+
 void ossimNitfWriter::addRegisteredTag(ossimRefPtr<ossimNitfRegisteredTag> registeredTag,
    bool unique)
 {
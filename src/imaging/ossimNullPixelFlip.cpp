@@ -133,12 +133,10 @@ void ossimNullPixelFlip::flipPixels(T /* dummy */,
                                static_cast<T>(inputTile->getMaxPix(bandIdx)));
             for(y = 0; y < h; ++y)
             {
+               // Select rather than branch so the loop vectorizes:
                for(x = 0; x < w; ++x)
                {
-                  if(bandPtr[x] == nullValue)
-                  {
-                     bandPtr[x] = replaceValue;
-                  }
+                  bandPtr[x] = (bandPtr[x] == nullValue) ? replaceValue : bandPtr[x];
                }
                bandPtr += inputW;
             }
@@ -159,11 +157,7 @@ void ossimNullPixelFlip::flipPixels(T /* dummy */,
             ossim_uint32 idx = 0;
             for(idx = 0; idx < size;++idx)
             {
-               if((*bandPtr) == nullValue)
-               {
-                  (*bandPtr) = replaceValue;
-               }
-               ++bandPtr;
+               bandPtr[idx] = (bandPtr[idx] == nullValue) ? replaceValue : bandPtr[idx];
             }
          }
          inputTile->setDataObjectStatus(OSSIM_FULL);
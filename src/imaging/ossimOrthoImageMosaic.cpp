@@ -290,6 +290,17 @@ void ossimOrthoImageMosaic::initialize()
 ossimRefPtr<ossimImageData> ossimOrthoImageMosaic::getNextTile(ossim_uint32& returnedIdx,
                                                                const ossimIrect& origin,
                                                                ossim_uint32 resLevel)
+{
+   return getNextTile(returnedIdx, origin, origin, resLevel);
+}
+
+//**************************************************************************************************
+// 
+//**************************************************************************************************
+ossimRefPtr<ossimImageData> ossimOrthoImageMosaic::getNextTile(ossim_uint32& returnedIdx,
+                                                               const ossimIrect& origin,
+                                                               const ossimIrect& neededRect,
+                                                               ossim_uint32 resLevel)
 {
    const char *MODULE="ossimOrthoImageMosaic::getNextTile";
    
@@ -319,7 +330,7 @@ ossimRefPtr<ossimImageData> ossimOrthoImageMosaic::getNextTile(ossim_uint32& ret
                  << endl;
          }
 
-         if(origin.intersects(relRect))
+         if(neededRect.intersects(relRect))
          {
             // get the rect relative to the input rect
             //
@@ -327,6 +338,7 @@ ossimRefPtr<ossimImageData> ossimOrthoImageMosaic::getNextTile(ossim_uint32& ret
                                                         -relRect.ul().y));
 
             // request that tile from the input space.
+            openInputHandler(theCurrentIndex);
             result = temp->getTile(shiftedRect, resLevel);
 
             // now change the origin to the output origin.
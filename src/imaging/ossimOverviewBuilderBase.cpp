@@ -10,10 +10,21 @@
 // $Id: ossimOverviewBuilderBase.cpp 21745 2012-09-16 15:21:53Z dburken $
 
 #include <ossim/imaging/ossimOverviewBuilderBase.h>
+#include <ossim/base/ossimCommon.h>
 #include <ossim/base/ossimIpt.h>
 #include <ossim/base/ossimKeywordNames.h>
+#include <ossim/base/ossimNotify.h>
 #include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimProperty.h>
 #include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimOverviewBuilderFactoryRegistry.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobQueue.h>
+#include <OpenThreads/Block>
+#include <OpenThreads/Condition>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <algorithm>
 
 RTTI_DEF3(ossimOverviewBuilderBase,
           "ossimOverviewBuilderBase",
@@ -22,6 +33,178 @@ RTTI_DEF3(ossimOverviewBuilderBase,
           ossimConnectableObjectListener)
 
 static const std::string SCAN_FLOAT_DATA_KW = "overview_builder.scan_for_min_max_null_if_float";
+static const std::string BATCH_THREADS_KW = "overview_builder.batch_threads";
+static const std::string BATCH_MEMORY_BUDGET_KW = "overview_builder.batch_memory_budget";
+
+namespace
+{
+   // Default of overview_builder.batch_memory_budget in megabytes.
+   const ossim_uint64 DEFAULT_BATCH_MEMORY_BUDGET = 2048;
+
+   /** Orders target indexes by estimated memory, largest first. */
+   class ossimOverviewBatchLarger
+   {
+   public:
+      ossimOverviewBatchLarger(const std::vector<ossim_uint64>& memory) : m_memory(memory) {}
+      bool operator()(ossim_uint32 a, ossim_uint32 b) const
+      {
+         return m_memory[a] > m_memory[b];
+      }
+   private:
+      const std::vector<ossim_uint64>& m_memory;
+   };
+
+   /** Memory of the batch targets being built, over all batches at once. */
+   struct ossimOverviewBatchMemory
+   {
+      ossimOverviewBatchMemory() : m_mutex(), m_fits(), m_inUse(0), m_running(0) {}
+
+      OpenThreads::Mutex     m_mutex;
+      OpenThreads::Condition m_fits;
+      ossim_uint64           m_inUse;
+      ossim_uint32           m_running;
+   };
+
+   ossimOverviewBatchMemory& batchMemory()
+   {
+      static ossimOverviewBatchMemory memory;
+      return memory;
+   }
+
+   //---
+   // Hands the targets of executeBatch to the jobs, largest first among those
+   // that fit in what is left of the memory budget, waiting for running ones
+   // (of any batch) to finish when none does.
+   //---
+   class ossimOverviewBatch : public ossimReferenced
+   {
+   public:
+      ossimOverviewBatch(const std::vector<ossim_uint64>& memory,
+                         ossim_uint64 budget,
+                         ossim_uint32 jobs)
+         : m_memory(memory),
+           m_order(memory.size()),
+           m_budget(budget),
+           m_jobs(jobs)
+      {
+         for (ossim_uint32 i = 0; i < m_order.size(); ++i)
+         {
+            m_order[i] = i;
+         }
+         std::stable_sort( m_order.begin(), m_order.end(), ossimOverviewBatchLarger(m_memory) );
+         if ( m_jobs )
+         {
+            m_block.reset();
+         }
+         else
+         {
+            m_block.release();
+         }
+      }
+      /** @return false when no target is left. */
+      bool next(ossim_uint32& index)
+      {
+         ossimOverviewBatchMemory& global = batchMemory();
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(global.m_mutex);
+         while ( !m_order.empty() )
+         {
+            for (std::vector<ossim_uint32>::iterator i = m_order.begin(); i != m_order.end(); ++i)
+            {
+               // One over the budget runs when nothing else does.
+               if ( (global.m_running == 0) || (global.m_inUse + m_memory[*i] <= m_budget) )
+               {
+                  index = *i;
+                  m_order.erase(i);
+                  global.m_inUse += m_memory[index];
+                  ++global.m_running;
+                  return true;
+               }
+            }
+            global.m_fits.wait(&global.m_mutex);
+         }
+         return false;
+      }
+      /** Returns the memory of a target built. */
+      void finished(ossim_uint32 index)
+      {
+         ossimOverviewBatchMemory& global = batchMemory();
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(global.m_mutex);
+         global.m_inUse -= m_memory[index];
+         --global.m_running;
+         global.m_fits.broadcast();
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if ( m_jobs && (--m_jobs == 0) )
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+   private:
+      OpenThreads::Mutex               m_mutex;
+      OpenThreads::Block               m_block;
+      const std::vector<ossim_uint64>& m_memory;
+      std::vector<ossim_uint32>        m_order; // Targets not started.
+      ossim_uint64                     m_budget;
+      ossim_uint32                     m_jobs;
+   };
+
+   /** Builds targets of a batch, each with its own builder, until none is left. */
+   class ossimOverviewBatchJob : public ossimJob
+   {
+   public:
+      ossimOverviewBatchJob(std::vector<ossimOverviewBuilderBase::BatchTarget>& targets,
+                            std::vector< ossimRefPtr<ossimOverviewBuilderBase> >& builders,
+                            ossimOverviewBatch* batch)
+         : m_targets(targets),
+           m_builders(builders),
+           m_batch(batch)
+      {
+         setName("ossimOverviewBuilderBase.batch");
+      }
+      virtual void start()
+      {
+         ossim_uint32 index = 0;
+         while ( m_batch->next(index) )
+         {
+            build( m_targets[index], m_builders[index].get() );
+            m_builders[index] = 0; // Release its buffers before the next target.
+            m_batch->finished(index);
+         }
+         m_batch->done();
+      }
+   private:
+      void build(ossimOverviewBuilderBase::BatchTarget& target, ossimOverviewBuilderBase* builder)
+      {
+         target.m_status = false;
+         if ( !builder || !target.m_handler.valid() )
+         {
+            return;
+         }
+         if ( ( target.m_handler->getCurrentEntry() != target.m_entry ) &&
+              !target.m_handler->setCurrentEntry(target.m_entry) )
+         {
+            return;
+         }
+         if ( target.m_histoMode != OSSIM_HISTO_MODE_UNKNOWN )
+         {
+            builder->setHistogramMode(target.m_histoMode);
+         }
+         builder->setOutputFile(target.m_outputFile);
+         target.m_status = builder->setInputSource( target.m_handler.get() ) &&
+            builder->execute();
+      }
+
+      std::vector<ossimOverviewBuilderBase::BatchTarget>&    m_targets;
+      std::vector< ossimRefPtr<ossimOverviewBuilderBase> >& m_builders;
+      ossimRefPtr<ossimOverviewBatch>                        m_batch;
+   };
+}
    
 ossimOverviewBuilderBase::ossimOverviewBuilderBase()
    : m_overviewStopDimension(0),
@@ -209,3 +392,146 @@ void ossimOverviewBuilderBase::initializeScanOptions()
       }
    }
 }
+
+ossimOverviewBuilderBase::BatchTarget::BatchTarget()
+   : m_handler(0),
+     m_entry(0),
+     m_outputFile(),
+     m_histoMode(OSSIM_HISTO_MODE_UNKNOWN),
+     m_status(false)
+{
+}
+
+void ossimOverviewBuilderBase::setJobQueue(ossimJobMultiThreadQueue* queue)
+{
+   m_jobQueue = queue;
+}
+
+ossim_uint64 ossimOverviewBuilderBase::estimateMemory(const ossimImageHandler* ih) const
+{
+   ossim_uint64 result = 0;
+   if ( ih )
+   {
+      ossimIpt tileSize;
+      ossim::defaultTileSize(tileSize);
+      const ossim_uint64 TILE_HEIGHT = std::max<ossim_uint64>(
+         ih->getImageTileHeight(), static_cast<ossim_uint64>(tileSize.y) );
+
+      // Source strip of two tile rows, and the strips of the levels below it:
+      result = 4 * TILE_HEIGHT * ih->getNumberOfSamples(0) *
+         ih->getNumberOfOutputBands() * ossim::scalarSizeInBytes( ih->getOutputScalarType() );
+   }
+   return result;
+}
+
+ossimOverviewBuilderBase* ossimOverviewBuilderBase::createBatchBuilder() const
+{
+   ossimOverviewBuilderBase* result =
+      ossimOverviewBuilderFactoryRegistry::instance()->createBuilder( getOverviewType() );
+   if ( result )
+   {
+      std::vector< ossimRefPtr<ossimProperty> > properties;
+      getPropertyList(properties);
+      for ( std::vector< ossimRefPtr<ossimProperty> >::const_iterator i = properties.begin();
+            i != properties.end(); ++i )
+      {
+         if ( (*i).valid() )
+         {
+            result->setProperty(*i);
+         }
+      }
+      result->setOverviewStopDimension(m_overviewStopDimension);
+      result->setHistogramMode(m_histoMode);
+      result->setBitMaskSpec(m_bitMaskSpec);
+      result->setScanForMinMax(m_scanForMinMax);
+      result->setScanForMinMaxNull(m_scanForMinMaxNull);
+   }
+   return result;
+}
+
+bool ossimOverviewBuilderBase::executeBatch(std::vector<BatchTarget>& targets)
+{
+   static const char MODULE[] = "ossimOverviewBuilderBase::executeBatch";
+
+   const ossim_uint32 TARGETS = static_cast<ossim_uint32>( targets.size() );
+   if ( TARGETS == 0 )
+   {
+      return true;
+   }
+
+   ossim_uint32 threads = ossim::getNumberOfThreads();
+   const char* lookup = ossimPreferences::instance()->findPreference( BATCH_THREADS_KW.c_str() );
+   if ( lookup && ossimString(lookup).toUInt32() )
+   {
+      threads = ossimString(lookup).toUInt32();
+   }
+   ossim_uint64 budget = DEFAULT_BATCH_MEMORY_BUDGET;
+   lookup = ossimPreferences::instance()->findPreference( BATCH_MEMORY_BUDGET_KW.c_str() );
+   if ( lookup && ossimString(lookup).toUInt64() )
+   {
+      budget = ossimString(lookup).toUInt64();
+   }
+   budget *= 1024 * 1024;
+
+   //---
+   // Builders are made here rather than on the jobs, and their tile jobs go
+   // on one queue, so that concurrent targets do not each start a pool of
+   // threads.
+   //---
+   ossimRefPtr<ossimJobMultiThreadQueue> tileQueue = m_jobQueue;
+   const ossim_uint32 TILE_THREADS = ossim::getNumberOfThreads();
+   if ( !tileQueue.valid() && (TILE_THREADS > 1) )
+   {
+      tileQueue = new ossimJobMultiThreadQueue(0, TILE_THREADS);
+   }
+   std::vector< ossimRefPtr<ossimOverviewBuilderBase> > builders(TARGETS);
+   std::vector<ossim_uint64> memory(TARGETS, 0);
+   for (ossim_uint32 i = 0; i < TARGETS; ++i)
+   {
+      targets[i].m_status = false;
+      builders[i] = createBatchBuilder();
+      if ( builders[i].valid() )
+      {
+         builders[i]->setJobQueue( tileQueue.get() );
+         if ( targets[i].m_handler.valid() &&
+              ( ( targets[i].m_handler->getCurrentEntry() == targets[i].m_entry ) ||
+                targets[i].m_handler->setCurrentEntry( targets[i].m_entry ) ) )
+         {
+            memory[i] = builders[i]->estimateMemory( targets[i].m_handler.get() );
+         }
+      }
+   }
+
+   const ossim_uint32 JOBS = std::max<ossim_uint32>( 1, std::min(threads, TARGETS) );
+   ossimRefPtr<ossimOverviewBatch> batch = new ossimOverviewBatch(memory, budget, JOBS);
+   if ( JOBS == 1 )
+   {
+      ossimRefPtr<ossimJob> job = new ossimOverviewBatchJob(targets, builders, batch.get());
+      job->start();
+   }
+   else
+   {
+      ossimRefPtr<ossimJobMultiThreadQueue> queue = new ossimJobMultiThreadQueue(0, JOBS);
+      for (ossim_uint32 i = 0; i < JOBS; ++i)
+      {
+         ossimRefPtr<ossimJob> job = new ossimOverviewBatchJob(targets, builders, batch.get());
+         queue->getJobQueue()->add(job.get(), false);
+      }
+      batch->wait();
+   }
+
+   bool result = true;
+   for (ossim_uint32 i = 0; i < TARGETS; ++i)
+   {
+      if ( !targets[i].m_status )
+      {
+         result = false;
+         ossimNotify(ossimNotifyLevel_WARN)
+            << MODULE << " ERROR:\nOverviews not built for entry " << targets[i].m_entry
+            << " of " << ( targets[i].m_handler.valid() ?
+                           targets[i].m_handler->getFilename() : ossimFilename() )
+            << std::endl;
+      }
+   }
+   return result;
+}
@@ -48,6 +48,8 @@ ossimOverviewSequencer::ossimOverviewSequencer()
    m_histogram(0),
    m_histoMode(OSSIM_HISTO_MODE_UNKNOWN),
    m_histoTileIndex(1),
+   m_outputHistogram(0),
+   m_outputHistoFlag(false),
    m_scanForMinMax(false),
    m_scanForMinMaxNull(false),
    m_minValues(0),
@@ -76,6 +78,7 @@ ossimOverviewSequencer::~ossimOverviewSequencer()
    m_maskWriter   = 0;
    m_tile         = 0;
    m_histogram    = 0;
+   m_outputHistogram = 0;
 
    if (traceDebug())
    {
@@ -159,6 +162,22 @@ void ossimOverviewSequencer::setHistogramMode(ossimHistogramMode mode)
    m_dirtyFlag = true;
 }
 
+void ossimOverviewSequencer::setOutputHistogramFlag(bool flag)
+{
+   m_outputHistoFlag = flag;
+   m_dirtyFlag = true;
+}
+
+ossimRefPtr<ossimMultiBandHistogram> ossimOverviewSequencer::getHistogram() const
+{
+   return m_histogram;
+}
+
+ossimRefPtr<ossimMultiBandHistogram> ossimOverviewSequencer::getOutputHistogram() const
+{
+   return m_outputHistogram;
+}
+
 void ossimOverviewSequencer::writeHistogram()
 {
    if ( m_histogram.valid() && m_imageHandler.valid() )
@@ -264,6 +283,13 @@ void ossimOverviewSequencer::initialize()
       m_histogram = 0;
    }
 
+   m_outputHistogram = 0;
+   if ( m_outputHistoFlag )
+   {
+      m_outputHistogram = new ossimMultiBandHistogram;
+      m_outputHistogram->create(imageSource);
+   }
+
 
    if ( m_scanForMinMax || m_scanForMinMaxNull )
    {
@@ -391,6 +417,12 @@ ossimRefPtr<ossimImageData> ossimOverviewSequencer::getNextTile()
          // Scan the resampled pixels for bogus values to be masked out (if masking enabled)
          if (m_maskWriter.valid())
             m_maskWriter->generateMask(m_tile, m_sourceResLevel+1);
+
+         // Counted as written, bogus pixels flipped to null:
+         if ( m_outputHistogram.valid() )
+         {
+            m_tile->populateHistogram(m_outputHistogram);
+         }
       }
    }
    else
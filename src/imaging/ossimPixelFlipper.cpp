@@ -20,6 +20,7 @@
 #include <ossim/base/ossimKeywordNames.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <OpenThreads/ScopedLock>
+#include <algorithm>
 #include <cstdlib>
 
 RTTI_DEF1(ossimPixelFlipper, "ossimPixelFlipper", ossimImageSourceFilter)
@@ -150,6 +151,88 @@ ossimRefPtr<ossimImageData> ossimPixelFlipper::getTile(
    return inputTile;
 }
 
+namespace
+{
+   //---
+   // Per band kernels of ossimPixelFlipper::flipPixels. Conditions are
+   // combined with & and | and applied as selects, not branches, so the
+   // loops vectorize for every scalar type.
+   //---
+
+   /** Replaces values in [lo, hi]; where given, only at pixels with mask set. */
+   template <class T> void replaceInRange(T* p, ossim_uint32 n, T lo, T hi, T replacement,
+                                          const ossim_uint8* mask)
+   {
+      if (mask)
+      {
+         for (ossim_uint32 i = 0; i < n; ++i)
+         {
+            const T V = p[i];
+            p[i] = ((mask[i] != 0) & (V >= lo) & (V <= hi)) ? replacement : V;
+         }
+      }
+      else
+      {
+         for (ossim_uint32 i = 0; i < n; ++i)
+         {
+            const T V = p[i];
+            p[i] = ((V >= lo) & (V <= hi)) ? replacement : V;
+         }
+      }
+   }
+
+   /** Replaces all values at pixels with mask set. */
+   template <class T> void replaceMasked(T* p, ossim_uint32 n, T replacement,
+                                         const ossim_uint8* mask)
+   {
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         p[i] = mask[i] ? replacement : p[i];
+      }
+   }
+
+   /** Adds each band's vote to the counts of bands inside and outside [lo, hi]. */
+   template <class T> void countTargets(const T* p, ossim_uint32 n, T lo, T hi,
+                                        ossim_uint16* inside, ossim_uint16* outside)
+   {
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         const T V = p[i];
+         inside[i]  += (ossim_uint16)((V >= lo) & (V <= hi));
+         outside[i] += (ossim_uint16)((V < lo) | (V > hi));
+      }
+   }
+
+   /**
+    * Clamp counterpart of countTargets: bands to be clamped, and bands within
+    * the clamp range. A missing limit is open.
+    */
+   template <class T> void countClamps(const T* p, ossim_uint32 n,
+                                       bool hasLo, T lo, bool hasHi, T hi,
+                                       ossim_uint16* clamped, ossim_uint16* within)
+   {
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         const T V = p[i];
+         clamped[i] += (ossim_uint16)((hasLo & (V < lo)) | (hasHi & (V > hi)));
+         within[i]  += (ossim_uint16)((!hasLo | (V >= lo)) & (!hasHi | (V <= hi)));
+      }
+   }
+
+   /** Clamps to [lo, hi]; where given, only at pixels with mask set. */
+   template <class T> void clampBand(T* p, ossim_uint32 n, bool hasLo, T lo, bool hasHi, T hi,
+                                     const ossim_uint8* mask)
+   {
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         const T V = p[i];
+         const bool APPLY = !mask || mask[i];
+         const T C = (hasLo & (V < lo)) ? lo : ((hasHi & (V > hi)) ? hi : V);
+         p[i] = APPLY ? C : V;
+      }
+   }
+}
+
 template <class T>
 void ossimPixelFlipper::flipPixels(T /* dummy */,
                                    ossimImageData* inputTile,
@@ -157,18 +240,16 @@ void ossimPixelFlipper::flipPixels(T /* dummy */,
 {
    if (!inputTile) return;
 
+   const bool HAS_CLAMP_LO = !ossim::isnan(theClampValueLo);
+   const bool HAS_CLAMP_HI = !ossim::isnan(theClampValueHi);
    T targetLo    = static_cast<T>(theTargetValueLo);
    T targetHi    = static_cast<T>(theTargetValueHi);
    T replacement = static_cast<T>(theReplacementValue);
-   T clampLo       = static_cast<T>(theClampValueLo);
-   T clampHi       = static_cast<T>(theClampValueHi);
+   T clampLo     = HAS_CLAMP_LO ? static_cast<T>(theClampValueLo) : T(0);
+   T clampHi     = HAS_CLAMP_HI ? static_cast<T>(theClampValueHi) : T(0);
 
-   // Get pointers to data for each band.
    ossim_uint32 bands = inputTile->getNumberOfBands();
    ossim_uint32 band;
-   T** buf = new T*[bands];
-   for(band=0; band<bands; ++band)
-      buf[band] = static_cast<T*>(inputTile->getBuf(band));
 
    ossimIrect rect = inputTile->getImageRectangle();
    ossimIpt ul = rect.ul();
@@ -200,219 +281,152 @@ void ossimPixelFlipper::flipPixels(T /* dummy */,
    if (is_outside_aoi)
    {
       // none of the tile is inside so just return with empty tile:
-      delete [] buf;
       return; 
    }
 
-   ossim_uint32 i = 0;  // index into band buffers;
-   ossimIpt pixel_loc; 
-   bool can_replace, found_candidate;
-
-   // Begin loop over each pixel in the tile. The individual bands are handled inside this loop:
-   for(pixel_loc.y = ul.y; pixel_loc.y <= lr.y; ++pixel_loc.y)
+   //---
+   // A full tile has no null pixels, so if only nulls are targeted and there is no clamping or
+   // clipping, there is nothing to flip. Checked before the buffers are taken, as the non-const
+   // buffer access discards the status validate() caches.
+   //---
+   if (!theClampingMode && !needsTesting)
    {
-      for(pixel_loc.x = ul.x; pixel_loc.x <= lr.x; ++pixel_loc.x)
+      bool nullTargetsOnly = true;
+      for (band = 0; (band < bands) && nullTargetsOnly; ++band)
       {
-         // First consider if we need to test the pixel for border clipping:
-         if (needsTesting)
-         {
-            bool is_inside = true; // Assume it will pass the border test
-            if (theClipMode == BOUNDING_RECT)
-               is_inside = theBoundingRects[resLevel].pointWithin(pixel_loc);
-            else if (theClipMode == VALID_VERTICES)
-               is_inside = theValidVertices[resLevel].isPointWithin(pixel_loc);
+         const T NULL_PIX = static_cast<T>(inputTile->getNullPix(band));
+         nullTargetsOnly = (targetLo == NULL_PIX) && (targetHi == NULL_PIX);
+      }
+      if (nullTargetsOnly && (inputTile->validate() == OSSIM_FULL))
+         return;
+   }
 
-            if (!is_inside)
-            {
-               // Remap this pixel to the replacement value (all bands)
-               for (band=0; band<bands; ++band)
-                  buf[band][i] = replacement;
+   // Get pointers to data for each band.
+   std::vector<T*> buf(bands);
+   for(band=0; band<bands; ++band)
+      buf[band] = static_cast<T*>(inputTile->getBuf(band));
+   const ossim_uint32 N = inputTile->getSizePerBand();
 
-               // Proceed to next pixel location:
-               ++i;
-               continue; 
-            }
-         }
+   //---
+   // Modes that decide per pixel over all bands first count, per pixel, the bands that qualify
+   // (inside the target range or to be clamped) and those that do not, then build a mask of the
+   // pixels to change. Bands are processed as whole arrays throughout.
+   //---
+   const bool PER_BAND = (theReplacementMode == REPLACE_BAND_IF_TARGET) ||
+      (theClampingMode && (theReplacementMode == REPLACE_ALL_BANDS_IF_ANY_TARGET));
+   std::vector<ossim_uint8> mask;
+   if (!PER_BAND)
+   {
+      std::vector<ossim_uint16> qualify(N, 0);
+      std::vector<ossim_uint16> other(N, 0);
+      for (band=0; band<bands; ++band)
+      {
+         if (theClampingMode)
+            countClamps(buf[band], N, HAS_CLAMP_LO, clampLo, HAS_CLAMP_HI, clampHi,
+                        &qualify.front(), &other.front());
+         else
+            countTargets(buf[band], N, targetLo, targetHi, &qualify.front(), &other.front());
+      }
 
-         // If clamping specified, the target replacement function is disabled:
+      mask.resize(N);
+      switch (theReplacementMode)
+      {
+      case REPLACE_BAND_IF_PARTIAL_TARGET:
+      case REPLACE_ALL_BANDS_IF_PARTIAL_TARGET:
+         // At least one band qualifies and one is valid. A NaN band is neither inside nor
+         // outside the target range and is taken as a target here, as it is to be clamped:
          if (theClampingMode)
          {
-            switch (theReplacementMode)
-            {
-            case REPLACE_BAND_IF_TARGET:
-            case REPLACE_ALL_BANDS_IF_ANY_TARGET:
-               for (band=0; band<bands; ++band)
-               {
-                  if (!ossim::isnan(theClampValueLo) && (buf[band][i] < clampLo))
-                     buf[band][i] = clampLo;
-                  else if (!ossim::isnan(theClampValueHi) && (buf[band][i] > clampHi))
-                     buf[band][i] = clampHi;
-               }
-               break;
-
-            case REPLACE_BAND_IF_PARTIAL_TARGET: 
-            case REPLACE_ALL_BANDS_IF_PARTIAL_TARGET:
-               // First band loop to establish if pixel qualifies for replacement (at least one 
-               // band must be valid):
-               can_replace = false;
-               found_candidate = false;
-               for (band=0; (band < bands) && !(can_replace && found_candidate); ++band)
-               {
-                  if ((!ossim::isnan(theClampValueLo) && (buf[band][i] < clampLo)) ||
-                     (!ossim::isnan(theClampValueHi) && (buf[band][i] > clampHi)))
-                     found_candidate = true;
-                  else
-                     can_replace = true;
-               }
-               if (can_replace && found_candidate)
-               {
-                  // This pixel has at least one band with normal value, so need to rescan bands
-                  // to find pixels that need replacing (are within the target range):
-                  for (band=0; band<bands; ++band)
-                  {
-                     if (!ossim::isnan(theClampValueLo) && (buf[band][i] < clampLo))
-                        buf[band][i] = clampLo;
-                     else if (!ossim::isnan(theClampValueHi) && buf[band][i] > clampHi)
-                        buf[band][i] = clampHi;
-                  }
-               }
-               break;
-
-            case REPLACE_ONLY_FULL_TARGETS:
-               // First band loop to establish if pixel qualifies for replacement (all 
-               // bands must be in target range):
-               can_replace = true;
-               for (band=0; (band < bands) && can_replace; ++band)
-               {
-                  if ((ossim::isnan(theClampValueLo) || (buf[band][i] >= clampLo)) &&
-                      (ossim::isnan(theClampValueHi) || (buf[band][i] <= clampHi)))
-                     can_replace = false;
-               }
-               if (can_replace)
-               {
-                  // Map all pixels to replacement value: 
-                  for (band=0; band<bands; ++band)
-                  {
-                     if (!ossim::isnan(theClampValueLo) && (buf[band][i] < clampLo))
-                        buf[band][i] = clampLo;
-                     else if (!ossim::isnan(theClampValueHi) && buf[band][i] > clampHi)
-                        buf[band][i] = clampHi;
-                  }
-               }
-               break;
-            } // close switch
-
-            // Proceed to next pixel location:
-            ++i;
-            continue; 
+            for (ossim_uint32 i = 0; i < N; ++i)
+               mask[i] = (ossim_uint8)((qualify[i] > 0) & (qualify[i] < bands));
          }
-
-         // If we got here (the continue statement was not reached) then
-         // the pixel value now needs to be checked for possible target replacement:
-         switch (theReplacementMode)
+         else
          {
-         case REPLACE_BAND_IF_TARGET:
-            for (band=0; band<bands; ++band)
-            {
-               if ((buf[band][i] >= targetLo) && (buf[band][i] <=targetHi)) 
-                  buf[band][i] = theReplacementValue;
-            }
-            break;
-
-         case REPLACE_BAND_IF_PARTIAL_TARGET: 
+            for (ossim_uint32 i = 0; i < N; ++i)
+               mask[i] = (ossim_uint8)((other[i] > 0) & (other[i] < bands));
+         }
+         break;
 
-            // First band loop to establish if pixel qualifies for replacement (at least one 
-            // band must be valid):
-            can_replace = false;
-            found_candidate = false;
-            for (band=0; (band < bands) && !(can_replace && found_candidate); ++band)
-            {
-               //  check for target range replacement qualification:
-               if ((buf[band][i] < targetLo) || (buf[band][i] > targetHi))
-                  can_replace = true; // Has valid band
-               else
-                  found_candidate = true; // found band within target range
-            }
-            if (can_replace && found_candidate)
-            {
-               // This pixel has at least one band with normal value, so need to rescan bands
-               // to find pixels that need replacing (are within the target range):
-               for (band=0; band<bands; ++band)
-               {
-                  if ((buf[band][i] >= targetLo) && (buf[band][i] <= targetHi)) 
-                     buf[band][i] = theReplacementValue;
-               }
-            }
-            break;
+      case REPLACE_ONLY_FULL_TARGETS:
+         // No band is valid (within the clamp range, or outside the target range):
+         for (ossim_uint32 i = 0; i < N; ++i)
+            mask[i] = (ossim_uint8)(other[i] == 0);
+         break;
 
-         case REPLACE_ALL_BANDS_IF_PARTIAL_TARGET:
+      case REPLACE_ALL_BANDS_IF_ANY_TARGET:
+         for (ossim_uint32 i = 0; i < N; ++i)
+            mask[i] = (ossim_uint8)(qualify[i] > 0);
+         break;
 
-            // First band loop to establish if pixel qualifies for replacement (at least one 
-            // band must be valid):
-            can_replace = false;
-            found_candidate = false;
-            for (band=0; (band < bands) && !(can_replace && found_candidate); ++band)
-            {
-               // check for target range replacement qualification:
-               if ((buf[band][i] < targetLo) || (buf[band][i] > targetHi))
-                  can_replace = true;
-               else
-                  found_candidate = true;
-            }
-            if (can_replace && found_candidate)
-            {
-               // This pixel has at least one band with normal value and one with target, so 
-               // map all bands to target:
-               for (band=0; band<bands; ++band)
-                  buf[band][i] = theReplacementValue;
-            }
-            break;
+      default:
+         break;
+      }
+   }
+   const ossim_uint8* pixelMask = mask.empty() ? 0 : &mask.front();
 
-         case REPLACE_ONLY_FULL_TARGETS:
+   // If clamping specified, the target replacement function is disabled:
+   for (band=0; band<bands; ++band)
+   {
+      if (theClampingMode)
+      {
+         clampBand(buf[band], N, HAS_CLAMP_LO, clampLo, HAS_CLAMP_HI, clampHi, pixelMask);
+      }
+      else if ((theReplacementMode == REPLACE_BAND_IF_TARGET) ||
+               (theReplacementMode == REPLACE_BAND_IF_PARTIAL_TARGET))
+      {
+         replaceInRange(buf[band], N, targetLo, targetHi, replacement, pixelMask);
+      }
+      else
+      {
+         replaceMasked(buf[band], N, replacement, pixelMask);
+      }
+   }
 
-            // First band loop to establish if pixel qualifies for replacement (all 
-            // bands must be in target range):
-            can_replace = true;
-            for (band=0; (band < bands) && can_replace; ++band)
-            {
-               // check for target range replacement qualification:
-               if ((buf[band][i] < targetLo) || (buf[band][i] > targetHi))
-                  can_replace = false;
-            }
-            if (can_replace)
+   //---
+   // Border clipping last: pixels outside the area of interest get the replacement value in all
+   // bands whatever they were flipped to above.
+   //---
+   if (needsTesting)
+   {
+      const ossim_int32 W = rect.width();
+      ossim_uint32 i = 0;
+      ossimIpt pixel_loc;
+      for(pixel_loc.y = ul.y; pixel_loc.y <= lr.y; ++pixel_loc.y, i += W)
+      {
+         if (theClipMode == BOUNDING_RECT)
+         {
+            // Inside run of this row, [x0, x1) relative to the tile:
+            const ossimIrect& bounds = theBoundingRects[resLevel];
+            ossim_int32 x0 = 0;
+            ossim_int32 x1 = 0;
+            if ((pixel_loc.y >= bounds.ul().y) && (pixel_loc.y <= bounds.lr().y))
             {
-               // Map all pixels to replacement value: 
-               for (band=0; band<bands; ++band)
-                  buf[band][i] = theReplacementValue;
+               x0 = ossim::max<ossim_int32>(bounds.ul().x - ul.x, 0);
+               x1 = ossim::min<ossim_int32>(bounds.lr().x - ul.x + 1, W);
+               if (x1 < x0)
+                  x1 = x0;
             }
-            break;
-
-         case REPLACE_ALL_BANDS_IF_ANY_TARGET:
-
-            // First band loop to establish if pixel qualifies for replacement (all 
-            // bands must be in target range):
-            can_replace = false;
-            for (band=0; (band < bands) && !can_replace; ++band)
+            for (band=0; band<bands; ++band)
             {
-               // check for target range replacement qualification:
-               if ((buf[band][i] >= targetLo) && (buf[band][i] <= targetHi))
-                  can_replace = true;
+               std::fill(buf[band] + i, buf[band] + i + x0, replacement);
+               std::fill(buf[band] + i + x1, buf[band] + i + W, replacement);
             }
-            if (can_replace)
+         }
+         else if (theClipMode == VALID_VERTICES)
+         {
+            for(pixel_loc.x = ul.x; pixel_loc.x <= lr.x; ++pixel_loc.x)
             {
-               // Map all pixels to replacement value: 
-               for (band=0; band<bands; ++band)
-                  buf[band][i] = theReplacementValue;
+               if (!theValidVertices[resLevel].isPointWithin(pixel_loc))
+               {
+                  const ossim_uint32 OFFSET = i + (pixel_loc.x - ul.x);
+                  for (band=0; band<bands; ++band)
+                     buf[band][OFFSET] = replacement;
+               }
             }
-            break;
-         } // close switch
+         }
+      }
+   }
 
-         // Reached end of processing for one pixel location. Increment the band buffers index:
-         ++i;
-      } // end of loop over pixel_loc.x
-   } // end of loop over pixel_loc.y
-   
-   delete [] buf;
    inputTile->validate();
 }
 
@@ -16,6 +16,9 @@
 #include <ossim/base/ossimCommon.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
 #include <ossim/base/ossimActiveEdgeTable.h>
+#include <ossim/base/ossimNotify.h>
+#include <algorithm>
+#include <exception>
 static const char* NUMBER_POLYGONS_KW = "number_polygons";
 
 RTTI_DEF1(ossimPolyCutter, "ossimPolyCutter", ossimImageSourceFilter)
@@ -24,7 +27,11 @@ ossimPolyCutter::ossimPolyCutter()
    : ossimImageSourceFilter(),
      theTile(NULL),
      theCutType(OSSIM_POLY_NULL_OUTSIDE),
-     m_boundingOverwrite(false)
+     m_boundingOverwrite(false),
+     theAreaPolygons(),
+     theAreas(),
+     theRasterizer(),
+     theSpans()
 {
    thePolygonList.push_back(ossimPolygon());
    theBoundingRect.makeNan();
@@ -37,7 +44,11 @@ ossimPolyCutter::ossimPolyCutter(ossimImageSource* inputSource,
    : ossimImageSourceFilter(inputSource),
      theTile(NULL),
      theCutType(OSSIM_POLY_NULL_INSIDE),
-     m_boundingOverwrite(false)
+     m_boundingOverwrite(false),
+     theAreaPolygons(),
+     theAreas(),
+     theRasterizer(),
+     theSpans()
 {
    thePolygonList.push_back(polygon);
    computeBoundingRect();
@@ -110,17 +121,26 @@ ossimRefPtr<ossimImageData> ossimPolyCutter::getTile(const ossimIrect& tileRect,
 //       ossimActiveEdgeTable aet;
       
       
+      //---
+      // Only tiles crossing a polygon edge are masked, by runs of pixels;
+      // the others are kept or nulled whole.
+      //---
+      ossimPolyArea2d::RectRelation relation = ossimPolyArea2d::RECT_OUTSIDE;
+      if(boundingRect.intersects(tileRect))
+      {
+         relation = classifyTile(tileRect, *polyList);
+      }
+
       if(theCutType == OSSIM_POLY_NULL_OUTSIDE)
       {
-         if(boundingRect.intersects(tileRect))
+         if(relation == ossimPolyArea2d::RECT_INSIDE)
          {
-            theTile->makeBlank();
-            theHelper.setImageData(theTile.get());
-            for(int polyIndex = 0; polyIndex < (int)polyList->size(); ++polyIndex)
-            {
-               theHelper.copyInputToThis(input->getBuf(),
-                                      (*polyList)[polyIndex]);
-            }
+            return theTile;
+         }
+         if(relation == ossimPolyArea2d::RECT_CROSSING)
+         {
+            theRasterizer.getSpans(tileRect, theSpans);
+            nullSpans(false);
             theTile->validate();
          }
          else
@@ -130,16 +150,15 @@ ossimRefPtr<ossimImageData> ossimPolyCutter::getTile(const ossimIrect& tileRect,
       }
       else if(theCutType == OSSIM_POLY_NULL_INSIDE)
       {
-         if(boundingRect.intersects(tileRect))
+         if(relation == ossimPolyArea2d::RECT_INSIDE)
          {
-            theHelper.setImageData(theTile.get());
-            for(int polyIndex = 0;
-                polyIndex < (int)polyList->size();
-                ++polyIndex)
-            {
-               theHelper.fill(theTile->getNullPix(),
-                           (*polyList)[polyIndex]);
-            }
+            theTile->makeBlank();
+            return theTile;
+         }
+         if(relation == ossimPolyArea2d::RECT_CROSSING)
+         {
+            theRasterizer.getSpans(tileRect, theSpans);
+            nullSpans(true);
          }
          theTile->validate();
       }
@@ -148,6 +167,159 @@ ossimRefPtr<ossimImageData> ossimPolyCutter::getTile(const ossimIrect& tileRect,
    return theTile;
 }
 
+ossimPolyArea2d::RectRelation ossimPolyCutter::classifyTile(
+   const ossimIrect& tileRect, const vector<ossimPolygon>& polyList)
+{
+   if(theAreaPolygons != polyList)
+   {
+      theAreaPolygons = polyList;
+      theRasterizer.setPolygons(polyList);
+      theAreas.clear();
+      try // GEOS code throws exceptions...
+      {
+         for(ossim_uint32 polyIndex = 0; polyIndex < polyList.size(); ++polyIndex)
+         {
+            if(polyList[polyIndex].getNumberOfVertices() > 2)
+            {
+               theAreas.push_back(new ossimPolyArea2d(polyList[polyIndex]));
+            }
+         }
+      }
+      catch(const std::exception& e)
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "ossimPolyCutter::classifyTile: " << e.what() << std::endl;
+         theAreas.clear();
+      }
+      if(theAreas.empty() && polyList.size())
+      {
+         // Unclassified; every tile is masked pixel by pixel.
+         theAreas.push_back(ossimRefPtr<ossimPolyArea2d>());
+      }
+   }
+
+   // Footprint of the tile's pixels, so every pixel center is classified.
+   const ossimDrect footprint(tileRect.ul().x - 0.5, tileRect.ul().y - 0.5,
+                              tileRect.lr().x + 0.5, tileRect.lr().y + 0.5);
+
+   ossimPolyArea2d::RectRelation result = ossimPolyArea2d::RECT_OUTSIDE;
+   for(ossim_uint32 areaIndex = 0; areaIndex < theAreas.size(); ++areaIndex)
+   {
+      if(!theAreas[areaIndex].valid())
+      {
+         return ossimPolyArea2d::RECT_CROSSING;
+      }
+      ossimPolyArea2d::RectRelation relation = theAreas[areaIndex]->classify(footprint);
+      if(relation == ossimPolyArea2d::RECT_INSIDE)
+      {
+         return relation;
+      }
+      if(relation == ossimPolyArea2d::RECT_CROSSING)
+      {
+         result = relation;
+      }
+   }
+   return result;
+}
+
+void ossimPolyCutter::nullSpans(bool nullInside)
+{
+   switch(theTile->getScalarType())
+   {
+      case OSSIM_UINT8:
+      {
+         nullSpansTemplate(ossim_uint8(0), nullInside);
+         break;
+      }
+      case OSSIM_SINT8:
+      {
+         nullSpansTemplate(ossim_sint8(0), nullInside);
+         break;
+      }
+      case OSSIM_UINT16:
+      case OSSIM_USHORT11:
+      {
+         nullSpansTemplate(ossim_uint16(0), nullInside);
+         break;
+      }
+      case OSSIM_SINT16:
+      {
+         nullSpansTemplate(ossim_sint16(0), nullInside);
+         break;
+      }
+      case OSSIM_UINT32:
+      {
+         nullSpansTemplate(ossim_uint32(0), nullInside);
+         break;
+      }
+      case OSSIM_SINT32:
+      {
+         nullSpansTemplate(ossim_sint32(0), nullInside);
+         break;
+      }
+      case OSSIM_FLOAT32:
+      case OSSIM_NORMALIZED_FLOAT:
+      {
+         nullSpansTemplate(ossim_float32(0.0), nullInside);
+         break;
+      }
+      case OSSIM_FLOAT64:
+      case OSSIM_NORMALIZED_DOUBLE:
+      {
+         nullSpansTemplate(ossim_float64(0.0), nullInside);
+         break;
+      }
+      case OSSIM_SCALAR_UNKNOWN:
+      default:
+      {
+         break;
+      }
+   }
+}
+
+template <class T>
+void ossimPolyCutter::nullSpansTemplate(T /* dummy */, bool nullInside)
+{
+   const ossim_int32 WIDTH  = (ossim_int32)theTile->getWidth();
+   const ossim_int32 HEIGHT = (ossim_int32)theTile->getHeight();
+   const ossim_int32 MIN_X  = theTile->getImageRectangle().ul().x;
+   const ossim_uint32 BANDS = theTile->getNumberOfBands();
+
+   for(ossim_uint32 band = 0; band < BANDS; ++band)
+   {
+      T* buf = static_cast<T*>(theTile->getBuf(band));
+      if(!buf)
+      {
+         continue;
+      }
+      const T NULL_PIX = static_cast<T>(theTile->getNullPix(band));
+      for(ossim_int32 row = 0; row < HEIGHT; ++row)
+      {
+         T* line = buf + row*WIDTH;
+         const ossimPolygonRasterizer::SpanList& spans = theSpans[row];
+         if(nullInside)
+         {
+            for(ossim_uint32 i = 0; i < spans.size(); ++i)
+            {
+               std::fill(line + (spans[i].first - MIN_X),
+                         line + (spans[i].second - MIN_X + 1), NULL_PIX);
+            }
+         }
+         else
+         {
+            // Null the gaps between the runs:
+            ossim_int32 x = 0;
+            for(ossim_uint32 i = 0; i < spans.size(); ++i)
+            {
+               std::fill(line + x, line + (spans[i].first - MIN_X), NULL_PIX);
+               x = spans[i].second - MIN_X + 1;
+            }
+            std::fill(line + x, line + WIDTH, NULL_PIX);
+         }
+      }
+   }
+}
+
 ossimIrect ossimPolyCutter::getBoundingRect(ossim_uint32 resLevel)const
 {
    ossimIrect result;
@@ -64,6 +64,7 @@
 #include <cmath>
 #include <ossim/imaging/ossimRgbImage.h>
 #include <ossim/base/ossimCommon.h>
+#include <algorithm>
 
 // this should be in another file.  This is from gd's gdtable.c file and has
 // precomputations for sine and cosine.  It looks like they multiply the cos and
@@ -1031,6 +1032,70 @@ inline int gdCompareInt (const void *a, const void *b)
   return (*(const int *) a) - (*(const int *) b);
 }
 
+namespace
+{
+   /**
+    * Clips a gd line to the image once instead of testing each pixel.  The
+    * line starts at (major, minor), takes dmajor steps along its major axis
+    * and moves minorStep on the other dminor times, spread evenly; its stroke
+    * is wid pixels across.  Sets first and last to the steps that can draw
+    * into [0, majorSize) x [0, minorSize).  Conservative across the line: the
+    * stroke itself is clipped when plotted.
+    *
+    * @return false if no step can.
+    */
+   bool clipLineSteps(int major, int dmajor, int majorSize,
+                      int minor, int minorStep, int dminor, int minorSize,
+                      int wid, int& first, int& last)
+   {
+      first = std::max(0, -major);
+      last  = std::min(dmajor, majorSize - 1 - major);
+      if (first > last)
+      {
+         return false;
+      }
+
+      // gd's minor coordinate is within half a pixel of the real line:
+      const double margin = std::abs(wid) + 1.0;
+      const double lo = -margin - minor;
+      const double hi = minorSize + margin - minor;
+      if (dminor == 0)
+      {
+         return (lo <= 0.0) && (0.0 <= hi);
+      }
+      const double slope = minorStep * (double)dminor / (double)dmajor;
+      double k0 = lo / slope;
+      double k1 = hi / slope;
+      if (k0 > k1)
+      {
+         std::swap(k0, k1);
+      }
+      k0 = std::max(k0, (double)first);
+      k1 = std::min(k1, (double)last);
+      if (k0 > k1)
+      {
+         return false;
+      }
+      first = (int)std::floor(k0);
+      last  = std::min((int)std::ceil(k1), last);
+      return true;
+   }
+
+   /**
+    * Number of minor axis moves, and error term, of a gd line after k of its
+    * steps, so a clipped line starts where the whole one would have been.
+    */
+   void advanceLine(int k, int dmajor, int dminor, int& moves, int& d)
+   {
+      moves = 0;
+      if (k > 0)
+      {
+         moves = (int)(((ossim_int64)2 * dminor * k + dmajor) / ((ossim_int64)2 * dmajor));
+      }
+      d = (int)((ossim_int64)2 * dminor * (k + 1) - dmajor - (ossim_int64)2 * dmajor * moves);
+   }
+}
+
 void ossimRgbImage::drawFilledArc (double cx,
                                    double cy,
                                    double w,
@@ -1328,8 +1393,15 @@ void ossimRgbImage::drawFilledPolygon(ossimIpt *p,
       maxy = std::max((int)p[i].y, maxy);
       maxx = std::max((int)p[i].x, maxx);
    }
+   // Only the rows that can reach the image:
+   ossim_int32 minRow;
+   ossim_int32 maxRow;
+   getSpanRows(minRow, maxRow);
+   const int yStart = std::max(miny, (int)minRow);
+   const int yEnd   = std::min(maxy, (int)maxRow);
+
    /* Fix in 1.3: count a vertex only once */
-   for (y = miny; (y <= maxy); y++)
+   for (y = yStart; (y <= yEnd); y++)
    {
       ints = 0;
       for (i = 0; (i < n); i++)
@@ -1377,8 +1449,7 @@ void ossimRgbImage::drawFilledPolygon(ossimIpt *p,
       {
          for (i = 0; (i < (ints)); i += 2)
          {
-            drawLine (polyInts[i], y,
-                      polyInts[i + 1], y);
+            drawSpan (polyInts[i], polyInts[i + 1], y);
          }
       }
       else
@@ -1432,8 +1503,15 @@ void ossimRgbImage::drawFilledPolygon(ossimDpt *p,
          maxy = testPy;
       }
    }
+   // Only the rows that can reach the image:
+   ossim_int32 minRow;
+   ossim_int32 maxRow;
+   getSpanRows(minRow, maxRow);
+   const int yStart = std::max(miny, (int)minRow);
+   const int yEnd   = std::min(maxy, (int)maxRow);
+
    /* Fix in 1.3: count a vertex only once */
-   for (y = miny; (y <= maxy); y++)
+   for (y = yStart; (y <= yEnd); y++)
    {
       ints = 0;
       for (i = 0; (i < n); i++)
@@ -1485,8 +1563,7 @@ void ossimRgbImage::drawFilledPolygon(ossimDpt *p,
       
       for (i = 0; (i < (ints)); i += 2)
       {
-         drawLine (polyInts[i], y,
-                   polyInts[i + 1], y);
+         drawSpan (polyInts[i], polyInts[i + 1], y);
       }
    }
 
@@ -1528,8 +1605,15 @@ void ossimRgbImage::drawFilledPolygon(const std::vector<ossimIpt> &p)
          maxy = p[i].y;
       }
    }
+   // Only the rows that can reach the image:
+   ossim_int32 minRow;
+   ossim_int32 maxRow;
+   getSpanRows(minRow, maxRow);
+   const int yStart = std::max(miny, (int)minRow);
+   const int yEnd   = std::min(maxy, (int)maxRow);
+
    /* Fix in 1.3: count a vertex only once */
-   for (y = miny; (y <= maxy); y++)
+   for (y = yStart; (y <= yEnd); y++)
    {
       ints = 0;
       for (i = 0; (i < n); i++)
@@ -1575,8 +1659,7 @@ void ossimRgbImage::drawFilledPolygon(const std::vector<ossimIpt> &p)
       
       for (i = 0; (i < (ints)); i += 2)
       {
-         drawLine (polyInts[i], y,
-                   polyInts[i + 1], y);
+         drawSpan (polyInts[i], polyInts[i + 1], y);
       }
    }
 
@@ -1619,8 +1702,15 @@ void ossimRgbImage::drawFilledPolygon(const std::vector<ossimDpt> &p)
          maxy = testPy;
       }
    }
+   // Only the rows that can reach the image:
+   ossim_int32 minRow;
+   ossim_int32 maxRow;
+   getSpanRows(minRow, maxRow);
+   const int yStart = std::max(miny, (int)minRow);
+   const int yEnd   = std::min(maxy, (int)maxRow);
+
    /* Fix in 1.3: count a vertex only once */
-   for (y = miny; (y <= maxy); y++)
+   for (y = yStart; (y <= yEnd); y++)
    {
       ints = 0;
       for (i = 0; (i < n); i++)
@@ -1674,8 +1764,7 @@ void ossimRgbImage::drawFilledPolygon(const std::vector<ossimDpt> &p)
       
       for (i = 0; (i < (ints)); i += 2)
       {
-         drawLine (polyInts[i], y,
-                   polyInts[i + 1], y);
+         drawSpan (polyInts[i], polyInts[i + 1], y);
       }
    }
 
@@ -1742,20 +1831,10 @@ void ossimRgbImage::drawLine(int x1,
    x2 += (-origin.x);
    y2 += (-origin.y);
 
-//   ossimDpt start(x1, y1);
-//   ossimDpt end(x2,y2);
-//   ossimDrect bounds(0,0,theWidth-1, theHeight-1);
-
-//   if(bounds.clip(start, end)) return;
-
-//   x1 = (int)start.x;
-//   y1 = (int)start.y;
-//   x2 = (int)end.x;
-//   y2 = (int)end.y;
-   
    int dx, dy, incr1, incr2, d, x, y, xend, yend, xdirflag, ydirflag;
    int wid;
-   int w, wstart;
+   int wstart;
+   int step, first, last, moves;
    int thick = theThickness;
    
   dx = abs (x2 - x1);
@@ -1786,7 +1865,6 @@ void ossimRgbImage::drawLine(int x1,
 	      wid = 1;
 	    }
 	}
-      d = 2 * dy - dx;
       incr1 = 2 * dy;
       incr2 = 2 * (dy - dx);
       if (x1 > x2)
@@ -1803,49 +1881,33 @@ void ossimRgbImage::drawLine(int x1,
 	  ydirflag = 1;
 	  xend = x2;
 	}
+      step = (((y2 - y1) * ydirflag) > 0) ? 1 : -1;
 
-      /* Set up line thickness */
-      wstart = y - wid / 2;
-      for (w = wstart; w < wstart + wid; w++)
-	slowPlotPixel(x, w, theRed, theGreen, theBlue);
+      // Skip the steps off the image, then plot the strokes without tests:
+      if (!clipLineSteps(x, xend - x, theWidth, y, step, dy, theHeight, wid, first, last))
+	{
+	  return;
+	}
+      advanceLine(first, dx, dy, moves, d);
+      x += first;
+      y += step * moves;
 
-      if (((y2 - y1) * ydirflag) > 0)
+      wstart = y - wid / 2;
+      plotColumn(x, wstart, wstart + wid - 1);
+      for (int k = first; k < last; ++k)
 	{
-	  while (x < xend)
+	  x++;
+	  if (d < 0)
 	    {
-	      x++;
-	      if (d < 0)
-		{
-		  d += incr1;
-		}
-	      else
-		{
-		  y++;
-		  d += incr2;
-		}
-	      wstart = y - wid / 2;
-	      for (w = wstart; w < wstart + wid; w++)
-		slowPlotPixel(x, w, theRed, theGreen, theBlue);
+	      d += incr1;
 	    }
-	}
-      else
-	{
-	  while (x < xend)
+	  else
 	    {
-	      x++;
-	      if (d < 0)
-		{
-		  d += incr1;
-		}
-	      else
-		{
-		  y--;
-		  d += incr2;
-		}
-	      wstart = y - wid / 2;
-	      for (w = wstart; w < wstart + wid; w++)
-		slowPlotPixel(x, w, theRed, theGreen, theBlue);
+	      y += step;
+	      d += incr2;
 	    }
+	  wstart = y - wid / 2;
+	  plotColumn(x, wstart, wstart + wid - 1);
 	}
     }
   else
@@ -1865,7 +1927,6 @@ void ossimRgbImage::drawLine(int x1,
       if (wid == 0)
 	wid = 1;
 
-      d = 2 * dx - dy;
       incr1 = 2 * dx;
       incr2 = 2 * (dx - dy);
       if (y1 > y2)
@@ -1882,52 +1943,77 @@ void ossimRgbImage::drawLine(int x1,
 	  yend = y2;
 	  xdirflag = 1;
 	}
+      step = (((x2 - x1) * xdirflag) > 0) ? 1 : -1;
 
-      /* Set up line thickness */
-      wstart = x - wid / 2;
-      for (w = wstart; w < wstart + wid; w++)
-	slowPlotPixel(w, y, theRed, theGreen, theBlue);
+      // Skip the steps off the image, then plot the strokes without tests:
+      if (!clipLineSteps(y, yend - y, theHeight, x, step, dx, theWidth, wid, first, last))
+	{
+	  return;
+	}
+      advanceLine(first, dy, dx, moves, d);
+      y += first;
+      x += step * moves;
 
-      if (((x2 - x1) * xdirflag) > 0)
+      wstart = x - wid / 2;
+      plotSpan(wstart, wstart + wid - 1, y);
+      for (int k = first; k < last; ++k)
 	{
-	  while (y < yend)
+	  y++;
+	  if (d < 0)
 	    {
-	      y++;
-	      if (d < 0)
-		{
-		  d += incr1;
-		}
-	      else
-		{
-		  x++;
-		  d += incr2;
-		}
-	      wstart = x - wid / 2;
-	      for (w = wstart; w < wstart + wid; w++)
-		slowPlotPixel(w, y, theRed, theGreen, theBlue);
+	      d += incr1;
 	    }
-	}
-      else
-	{
-	  while (y < yend)
+	  else
 	    {
-	      y++;
-	      if (d < 0)
-		{
-		  d += incr1;
-		}
-	      else
-		{
-		  x--;
-		  d += incr2;
-		}
-	      wstart = x - wid / 2;
-	      for (w = wstart; w < wstart + wid; w++)
-		slowPlotPixel(w, y, theRed, theGreen, theBlue);
+	      x += step;
+	      d += incr2;
 	    }
+	  wstart = x - wid / 2;
+	  plotSpan(wstart, wstart + wid - 1, y);
 	}
     }
 }
+
+void ossimRgbImage::drawSpan(ossim_int32 x1,
+                             ossim_int32 x2,
+                             ossim_int32 y)
+{
+   if(!theImageData)
+   {
+      return;
+   }
+   ossimIpt origin = ossimDpt(theImageData->getOrigin());
+   x1 -= origin.x;
+   x2 -= origin.x;
+   y  -= origin.y;
+   if(x1 > x2)
+   {
+      std::swap(x1, x2);
+   }
+
+   // The vertical stroke drawLine gives a horizontal line; a single pixel
+   // has none.
+   ossim_int32 wid = (x1 == x2) ? 1 : theThickness;
+   if(wid == 0)
+   {
+      wid = 1;
+   }
+   const ossim_int32 rowStart = y - wid / 2;
+   for(ossim_int32 row = rowStart; row < rowStart + wid; ++row)
+   {
+      plotSpan(x1, x2, row);
+   }
+}
+
+void ossimRgbImage::getSpanRows(ossim_int32& minRow, ossim_int32& maxRow) const
+{
+   const ossim_int32 margin = std::abs(theThickness);
+   const ossim_int32 originY = theImageData.valid() ?
+      (ossim_int32)theImageData->getOrigin().y : 0;
+   minRow = originY - margin;
+   maxRow = originY + theHeight - 1 + margin;
+}
+
 void ossimRgbImage::drawRectangle(double x1,
                                   double y1,
                                   double x2,
@@ -2012,7 +2098,7 @@ void ossimRgbImage::drawFilledRectangle(int x1,
                                         int x2,
                                         int y2)
 {
-   int x, y;
+   int y;
 
    if(x1 > x2)
    {
@@ -2022,12 +2108,15 @@ void ossimRgbImage::drawFilledRectangle(int x1,
    {
       swap(y1, y2);
    }
+   if(!theImageData)
+   {
+      return;
+   }
+   y1 = std::max(y1, 0);
+   y2 = std::min(y2, (int)theHeight - 1);
    for (y = y1; (y <= y2); y++)
    {
-      for (x = x1; (x <= x2); x++)
-      {
-         slowPlotPixel (x, y, theRed, theGreen, theBlue);
-      }
+      plotSpan (x1, x2, y);
    }
 }
 
@@ -2037,16 +2126,9 @@ void ossimRgbImage::fill()
    {
       return;
    }
-   ossim_int32 width = theWidth;
-   ossim_int32 height = theHeight;
-   
-   for(ossim_int32 row = 0; row < height; ++row)
+   for(ossim_int32 row = 0; row < theHeight; ++row)
    {
-      for(ossim_int32 col = 0; col < width; ++col)
-      {
-         fastPlotPixel(col, row,
-                       theRed, theGreen, theBlue);
-      }
+      plotSpan(0, theWidth - 1, row);
    }
 }
 
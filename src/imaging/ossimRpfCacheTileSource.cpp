@@ -51,22 +51,13 @@ const ossim_uint32 ossimRpfCacheTileSource::CIBCADRG_FRAME_HEIGHT = 1536;
 ossimRpfCacheTileSource::ossimRpfCacheTileSource()
    :
    ossimImageHandler(),
-
-   // a CADRG and CIBis a 64*64*12 bit buffer and must divide by 8 to
-   // convert to bytes   
-   m_compressedBuffer(new ossim_uint8[(64*64*12)/8]),
-
-   // whether CIB or CADRG we will alocate the buffer
-   // to the larger of the 2 (CADRG is 3 bands) 
-   m_uncompressedBuffer(new ossim_uint8[256*256*3]),
-   
    m_numberOfLines(0),
    m_numberOfSamples(0),
    m_tile(0),
    m_fileNames(),
    m_tileSize(128, 128),
    m_productType(OSSIM_PRODUCT_TYPE_UNKNOWN),
-   m_workFrame(new ossimRpfFrame),
+   m_subframeCache(),
    m_bBox_LL_Lon(0.0),
    m_bBox_LL_Lat(0.0),
    m_bBox_UR_Lon(0.0),
@@ -91,21 +82,6 @@ ossimRpfCacheTileSource::ossimRpfCacheTileSource()
 
 ossimRpfCacheTileSource::~ossimRpfCacheTileSource()
 {
-  if(m_compressedBuffer)
-  {
-    delete [] m_compressedBuffer;
-    m_compressedBuffer = 0;
-  }
-  if(m_uncompressedBuffer)
-  {
-    delete [] m_uncompressedBuffer;
-    m_uncompressedBuffer = 0;
-  }
-  if(m_workFrame)
-  {
-    delete m_workFrame;
-    m_workFrame = 0;
-  }
   close();
 }
 
@@ -173,6 +149,9 @@ bool ossimRpfCacheTileSource::open()
     //---
     setActualImageRect();
 
+    // Subframes are cached by image position.
+    m_subframeCache.reset(getImageRectangle(), getNumberOfOutputBands());
+
     // Set the base class image file name.
     theImageFile = imageFile;
     m_tile = ossimImageDataFactory::instance()->create(this, this);
@@ -800,312 +779,16 @@ void ossimRpfCacheTileSource::fillTile(
    const vector<ossimFrameEntryData>& framesInvolved,
    ossimImageData* tile)
 {
-   ossim_uint32 idx = 0;
-   for(idx = 0;
-       idx < framesInvolved.size();
-       ++idx)
+   // the actual pixel of a frame will be 1536*row and 1536 *col.
+   std::vector<ossimRpfSubframeCache::Frame> frames;
+   for(ossim_uint32 idx = 0; idx < framesInvolved.size(); ++idx)
    {
-
-      if(m_workFrame->parseFile(framesInvolved[idx].theFrameEntry.getFullPath())
-         == ossimErrorCodes::OSSIM_OK)
-      {
-         // we will fill a subtile.  We pass in which frame it is and the position of the frame.
-         // the actual pixel will be 1536*row and 1536 *col.
-         if(m_productType == OSSIM_PRODUCT_TYPE_CIB)
-         {
-            fillSubTileCib(*m_workFrame,
-                           tileRect,
-                           framesInvolved[idx],
-                           tile);
-         }
-         else
-         {
-            fillSubTileCadrg(*m_workFrame,
-                             tileRect,
-                             framesInvolved[idx],
-                             tile);
-         }
-      }
+      frames.push_back(ossimRpfSubframeCache::Frame(
+                          framesInvolved[idx].theFrameEntry.getFullPath(),
+                          ossimIpt(framesInvolved[idx].thePixelCol,
+                                   framesInvolved[idx].thePixelRow)));
    }
-}
-
-void ossimRpfCacheTileSource::fillSubTileCadrg(
-   const ossimRpfFrame&  aFrame,
-   const ossimIrect& tileRect,
-   const ossimFrameEntryData& frameEntryData,
-   ossimImageData* tile)
-{;
-// first let's grab the absolute position of the frame rectangle in pixel space
-   ossimIrect frameRect(frameEntryData.thePixelCol,
-                        frameEntryData.thePixelRow,
-                        frameEntryData.thePixelCol + CIBCADRG_FRAME_WIDTH  - 1,
-                        frameEntryData.thePixelRow + CIBCADRG_FRAME_HEIGHT - 1);
-
-
-// now clip it to the tile
-   ossimIrect clipRect = tileRect.clipToRect(frameRect);
-
-   const ossimRpfCompressionSection* compressionSection = aFrame.getCompressionSection();
-
-   if(!compressionSection)
-   {
-      return;
-   }
-
-   const vector<ossimRpfColorGrayscaleTable>& colorTable =
-      aFrame.getColorGrayscaleTable();
-
-// ESH 03/2009 -- Partial fix for ticket #646.
-// Crash fix on reading RPFs: Make sure the colorTable vector 
-// has entries before trying to make use of them. 
-   int numTables = (int)colorTable.size();
-   if ( numTables <= 0 )
-   {
-      return;
-   }
-
-   ossim_uint8 *tempRows[3];
-
-   tempRows[0] = m_uncompressedBuffer;
-   tempRows[1] = (m_uncompressedBuffer + 256*256);
-   tempRows[2] = (tempRows[1] + 256*256);
-
-// find the shift to 0,0
-   ossimIpt tempDelta(clipRect.ul().x - frameEntryData.thePixelCol,
-                      clipRect.ul().y - frameEntryData.thePixelRow);
-
-
-// In order to compute the subframe we will need the corner offsets of
-// the upper left of the frame and the upper left of the clip rect.  The
-// clip rect should be completely within the frame.  This just translates the value
-// to make the upper left of the frame be 0,0.
-//
-   ossimIrect offsetRect(tempDelta.x,
-                         tempDelta.y,
-                         tempDelta.x + clipRect.width()-1,
-                         tempDelta.y + clipRect.height()-1);
-
-// each subframe is 64x64.  We will actually use 256x256 since
-// we will be uncompressing them.  Note CADRG is a 256x256 tile
-// compressed to 64x64x12 bit data
-//
-   ossimIrect subFrameRect(offsetRect.ul().x/256,
-                           offsetRect.ul().y/256,
-                           (offsetRect.lr().x)/256,
-                           (offsetRect.lr().y)/256);
-
-   ossim_uint32 readPtr  = 0;
-
-   ossim_int32 row = 0;
-   ossim_int32 col = 0;
-   ossim_uint32 i = 0;
-   ossim_uint32 j = 0;
-   ossim_int32 upperY = subFrameRect.lr().y;
-   ossim_int32 upperX = subFrameRect.lr().x;
-   ossim_int32 lowerY = subFrameRect.ul().y;
-   ossim_int32 lowerX = subFrameRect.ul().x; 
-   for(row = lowerY; row <= upperY; ++row)
-   {
-      for(col = lowerX; col <= upperX; ++col)
-      {
-         readPtr = 0;
-         if(aFrame.fillSubFrameBuffer(m_compressedBuffer, 0, row, col))
-         {
-            for (i = 0; i < 256; i += 4)
-            {
-               for (j = 0; j < 256; j += 8)
-               {
-                  ossim_uint16 firstByte  = m_compressedBuffer[readPtr++] & 0xff;
-                  ossim_uint16 secondByte = m_compressedBuffer[readPtr++] & 0xff;
-                  ossim_uint16 thirdByte  = m_compressedBuffer[readPtr++] & 0xff;
-
-                  //because dealing with half-bytes is hard, we
-                  //uncompress two 4x4 tiles at the same time. (a
-                  //4x4 tile compressed is 12 bits )
-                  // this little code was grabbed from openmap software.
-
-                  /* Get first 12-bit value as index into VQ table */
-                  // I think we need to swap
-                  ossim_uint16 val1 = (firstByte << 4) | (secondByte >> 4);
-
-                  /* Get second 12-bit value as index into VQ table*/
-                  ossim_uint16 val2 = ((secondByte & 0x000F) << 8) | thirdByte;
-
-                  for (ossim_uint32 t = 0; t < 4; ++t)
-                  {
-                     for (ossim_uint32 e = 0; e < 4; ++e)
-                     {
-                        ossim_uint16 tableVal1 = compressionSection->getTable()[t].theData[val1*4 + e] & 0xff;
-                        ossim_uint16 tableVal2 = compressionSection->getTable()[t].theData[val2*4 + e] & 0xff;
-
-                        ossim_uint32 pixindex = ((i+t)*256) +
-                           (j + e);
-                        const ossim_uint8* color1 = colorTable[0].getStartOfData(tableVal1);
-                        const ossim_uint8* color2 = colorTable[0].getStartOfData(tableVal2);
-
-
-                        tempRows[0][pixindex] = color1[0];
-                        tempRows[1][pixindex] = color1[1];
-                        tempRows[2][pixindex] = color1[2];
-
-                        tempRows[0][pixindex+4] = color2[0];
-                        tempRows[1][pixindex+4] = color2[1];
-                        tempRows[2][pixindex+4] = color2[2];
-                     } //for e
-                  } //for t
-               }  /* for j */
-            } //for i
-         }
-         else
-         {
-            memset(m_uncompressedBuffer, 0, 256*256*3);
-         }
-         ossim_int32 tempCol = col*256;
-         ossim_int32 tempRow = row*256;
-         ossimIrect subRectToFill(frameRect.ul().x + tempCol,
-                                  frameRect.ul().y + tempRow,
-                                  frameRect.ul().x + tempCol + 255,
-                                  frameRect.ul().y + tempRow + 255);
-         tile->loadTile(m_uncompressedBuffer,
-                        subRectToFill,
-                        OSSIM_BSQ);
-      }
-   }
-}
-
-void ossimRpfCacheTileSource::fillSubTileCib(
-   const ossimRpfFrame&  aFrame,
-   const ossimIrect& tileRect,
-   const ossimFrameEntryData& frameEntryData,
-   ossimImageData* tile)
-{
-   // first let's grab the absolute position of the frame rectangle in pixel
-   // space
-   ossimIrect frameRect(frameEntryData.thePixelCol,
-                        frameEntryData.thePixelRow,
-                        frameEntryData.thePixelCol + CIBCADRG_FRAME_WIDTH  - 1,
-                        frameEntryData.thePixelRow + CIBCADRG_FRAME_HEIGHT - 1);
-
-
-   // now clip it to the tile
-   ossimIrect clipRect = tileRect.clipToRect(frameRect);
-
-   const ossimRpfCompressionSection* compressionSection = aFrame.getCompressionSection();
-
-   if(!compressionSection)
-   {
-      return;
-   }
-
-   const vector<ossimRpfColorGrayscaleTable>& colorTable =
-      aFrame.getColorGrayscaleTable();
-
-   // ESH 03/2009 -- Partial fix for ticket #646.
-   // Crash fix on reading RPFs: Make sure the colorTable vector 
-   // has entries before trying to make use of them. 
-   int numTables = (int)colorTable.size();
-   if ( numTables <= 0 )
-   {
-      return;
-   }
-
-   // check to see if it does overlap.  If it doesn't then the width and height
-   // will be a single point
-   {
-      ossim_uint8 *tempRow;
-
-      tempRow = m_uncompressedBuffer;
-
-      // find the shift to 0,0
-      ossimIpt tempDelta(clipRect.ul().x - frameEntryData.thePixelCol,
-                         clipRect.ul().y - frameEntryData.thePixelRow);
-
-      // In order to compute the subframe we will need the corner offsets of
-      // the upper left of the frame and the upper left of the clip rect.  The
-      // clip rect should be completely within the frame.  This just translates the value
-      // to make the upper left of the frame be 0,0.
-      //
-      ossimIrect offsetRect(tempDelta.x,
-                            tempDelta.y,
-                            tempDelta.x + clipRect.width()-1,
-                            tempDelta.y + clipRect.height()-1);
-
-      // each subframe is 64x64.  We will actually use 256x256 since
-      // we will be uncompressing them.  Note CADRG is a 256x256 tile
-      // compressed to 64x64x12 bit data
-      //
-      ossimIrect subFrameRect(offsetRect.ul().x/256,
-                              offsetRect.ul().y/256,
-                              (offsetRect.lr().x)/256,
-                              (offsetRect.lr().y)/256);
-
-      ossim_int32 row = 0;
-      ossim_int32 col = 0;
-      ossim_uint32 i = 0;
-      ossim_uint32 j = 0;
-      ossim_uint32 readPtr = 0;
-      for(row = subFrameRect.ul().y; row <= subFrameRect.lr().y; ++row)
-      {
-         for(col = subFrameRect.ul().x; col <= subFrameRect.lr().x; ++col)
-         {
-            readPtr = 0;
-            if(aFrame.fillSubFrameBuffer(m_compressedBuffer, 0, row, col))
-            {
-               for (i = 0; i < 256; i += 4)
-               {
-                  for (j = 0; j < 256; j += 8)
-                  {
-                     ossim_uint16 firstByte  = m_compressedBuffer[readPtr++] & 0xff;
-                     ossim_uint16 secondByte = m_compressedBuffer[readPtr++] & 0xff;
-                     ossim_uint16 thirdByte  = m_compressedBuffer[readPtr++] & 0xff;
-
-                     //because dealing with half-bytes is hard, we
-                     //uncompress two 4x4 tiles at the same time. (a
-                     //4x4 tile compressed is 12 bits )
-                     // this little code was grabbed from openmap software.
-
-                     /* Get first 12-bit value as index into VQ table */
-                     // I think we need to swap
-                     ossim_uint16 val1 = (firstByte << 4) | (secondByte >> 4);
-
-                     /* Get second 12-bit value as index into VQ table*/
-                     ossim_uint16 val2 = ((secondByte & 0x000F) << 8) | thirdByte;
-
-                     for (ossim_uint32 t = 0; t < 4; ++t)
-                     {
-                        for (ossim_uint32 e = 0; e < 4; ++e)
-                        {
-                           ossim_uint16 tableVal1 = compressionSection->getTable()[t].theData[val1*4 + e] & 0xff;
-                           ossim_uint16 tableVal2 = compressionSection->getTable()[t].theData[val2*4 + e] & 0xff;
-
-                           ossim_uint32 pixindex = ((i+t)*256) + (j + e);
-                           const ossim_uint8* color1 = colorTable[0].getStartOfData(tableVal1);
-                           const ossim_uint8* color2 = colorTable[0].getStartOfData(tableVal2);
-
-
-                           tempRow[pixindex]      = color1[0];
-                           tempRow[pixindex + 4]  = color2[0];
-                        } //for e
-                     } //for t
-                  }  /* for j */
-               } //for i
-            }
-            else
-            {
-               memset(m_uncompressedBuffer, 0, 256*256);
-            }
-            ossim_int32 tCol = col*256;
-            ossim_int32 tRow = row*256;
-            ossimIrect subRectToFill(frameRect.ul().x + tCol,
-                                     frameRect.ul().y + tRow,
-                                     frameRect.ul().x + tCol + 255,
-                                     frameRect.ul().y + tRow + 255);
-            tile->loadTile(m_uncompressedBuffer,
-                           subRectToFill,
-                           OSSIM_BSQ);
-         }
-      }
-   }  
+   m_subframeCache.fillTile(tileRect, frames, tile);
 }
 
 void ossimRpfCacheTileSource::allocateForProduct()
@@ -1114,29 +797,6 @@ void ossimRpfCacheTileSource::allocateForProduct()
    {
       return;
    }
-   if(m_uncompressedBuffer)
-   {
-      delete [] m_uncompressedBuffer;
-      m_uncompressedBuffer = 0;
-   }
-   if(m_compressedBuffer)
-   {
-      delete [] m_compressedBuffer;
-      m_compressedBuffer = 0;
-   }
-
-   // a CADRG and CIBis a 64*64*12 bit buffer and must divide by 8 to
-   // convert to bytes
-   m_compressedBuffer   = new ossim_uint8[(64*64*12)/8];
-   if(m_productType == OSSIM_PRODUCT_TYPE_CIB)
-   {
-      m_uncompressedBuffer = new ossim_uint8[256*256];
-   }
-   else
-   {
-      m_uncompressedBuffer = new ossim_uint8[256*256*3];
-   }
-
    m_tile = ossimImageDataFactory::instance()->create(this, this);
    m_tile->initialize();
 }
@@ -1144,6 +804,7 @@ void ossimRpfCacheTileSource::allocateForProduct()
 void ossimRpfCacheTileSource::deleteAll()
 {
    theOverview = 0;
+   m_subframeCache.clear();
 }
 
 bool ossimRpfCacheTileSource::saveState(ossimKeywordlist& kwl,
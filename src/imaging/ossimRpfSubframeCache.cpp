@@ -0,0 +1,287 @@
+//*******************************************************************
+//
+// License:  LGPL
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description: Cache of uncompressed RPF (CIB/CADRG) subframes.
+//
+//********************************************************************
+
+#include <ossim/imaging/ossimRpfSubframeCache.h>
+#include <ossim/base/ossimErrorCodes.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimReferenced.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/imaging/ossimChainProfiler.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <ossim/support_data/ossimRpfFrame.h>
+#include <OpenThreads/Block>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+
+const ossim_int32 ossimRpfSubframeCache::FRAME_SIZE    = 1536;
+const ossim_int32 ossimRpfSubframeCache::SUBFRAME_SIZE = 256;
+
+namespace
+{
+   /** Completion count of the decode jobs of one fillTile. */
+   class ossimRpfDecodeBatch : public ossimReferenced
+   {
+   public:
+      ossimRpfDecodeBatch(ossim_uint32 count)
+         : m_count(count)
+      {
+         if(m_count)
+         {
+            m_block.reset();
+         }
+         else
+         {
+            m_block.release();
+         }
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_count && (--m_count == 0))
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+   private:
+      OpenThreads::Mutex m_mutex;
+      OpenThreads::Block m_block;
+      ossim_uint32       m_count;
+   };
+
+   /** Parses one frame file and uncompresses the subframes a tile needs. */
+   class ossimRpfDecodeJob : public ossimJob
+   {
+   public:
+      ossimRpfDecodeJob(const ossimRpfSubframeCache* cache,
+                        const ossimRpfSubframeCache::Frame& frame,
+                        const std::vector<ossimIpt>& origins,
+                        ossimRpfDecodeBatch* batch)
+         : m_cache(cache),
+           m_frame(frame),
+           m_origins(origins),
+           m_subframes(),
+           m_batch(batch)
+      {
+         setName("ossimRpfSubframeCache.decode");
+      }
+      virtual void start()
+      {
+         m_cache->uncompressFrame(m_frame, m_origins, m_subframes);
+         m_batch->done();
+      }
+      const std::vector< ossimRefPtr<ossimImageData> >& getSubframes() const
+      {
+         return m_subframes;
+      }
+   private:
+      const ossimRpfSubframeCache*               m_cache;
+      ossimRpfSubframeCache::Frame               m_frame;
+      std::vector<ossimIpt>                      m_origins;
+      std::vector< ossimRefPtr<ossimImageData> > m_subframes;
+      ossimRefPtr<ossimRpfDecodeBatch>           m_batch;
+   };
+}
+
+ossimRpfSubframeCache::ossimRpfSubframeCache()
+   : m_imageRect(0, 0, 0, 0),
+     m_bands(0),
+     m_cacheId(-1),
+     m_decodeThreads(1),
+     m_decodeQueue(0)
+{
+   const char* lookup = ossimPreferences::instance()->findPreference("rpf.decode_threads");
+   if (lookup)
+   {
+      m_decodeThreads = ossimString(lookup).toUInt32();
+   }
+}
+
+ossimRpfSubframeCache::~ossimRpfSubframeCache()
+{
+   clear();
+   m_decodeQueue = 0;
+}
+
+void ossimRpfSubframeCache::reset(const ossimIrect& imageRect, ossim_uint32 bands)
+{
+   clear();
+   m_imageRect = imageRect;
+   m_bands = bands;
+}
+
+void ossimRpfSubframeCache::clear()
+{
+   if (m_cacheId != -1)
+   {
+      ossimAppFixedTileCache::instance()->deleteCache(m_cacheId);
+      m_cacheId = -1;
+   }
+}
+
+void ossimRpfSubframeCache::fillTile(const ossimIrect& tileRect,
+                                     const std::vector<Frame>& frames,
+                                     ossimImageData* tile)
+{
+   if ( !tile || !m_bands )
+   {
+      return;
+   }
+   if (m_cacheId == -1)
+   {
+      ossimIrect cacheRect = m_imageRect;
+      cacheRect.stretchToTileBoundary(ossimIpt(SUBFRAME_SIZE, SUBFRAME_SIZE));
+      m_cacheId = ossimAppFixedTileCache::instance()->
+         newTileCache(cacheRect, ossimIpt(SUBFRAME_SIZE, SUBFRAME_SIZE));
+   }
+
+   // Load the cached subframes; gather the others by frame.
+   std::vector<const Frame*> misses;
+   std::vector< std::vector<ossimIpt> > missOrigins;
+   std::vector<Frame>::const_iterator frame = frames.begin();
+   while ( frame != frames.end() )
+   {
+      const ossimIrect frameRect((*frame).m_origin.x,
+                                 (*frame).m_origin.y,
+                                 (*frame).m_origin.x + FRAME_SIZE - 1,
+                                 (*frame).m_origin.y + FRAME_SIZE - 1);
+      if ( frameRect.intersects(tileRect) )
+      {
+         const ossimIrect clipRect = tileRect.clipToRect(frameRect);
+         const ossim_int32 COL0 = (clipRect.ul().x - frameRect.ul().x) / SUBFRAME_SIZE;
+         const ossim_int32 COL1 = (clipRect.lr().x - frameRect.ul().x) / SUBFRAME_SIZE;
+         const ossim_int32 ROW0 = (clipRect.ul().y - frameRect.ul().y) / SUBFRAME_SIZE;
+         const ossim_int32 ROW1 = (clipRect.lr().y - frameRect.ul().y) / SUBFRAME_SIZE;
+
+         std::vector<ossimIpt> origins;
+         for (ossim_int32 row = ROW0; row <= ROW1; ++row)
+         {
+            for (ossim_int32 col = COL0; col <= COL1; ++col)
+            {
+               const ossimIpt origin(frameRect.ul().x + col*SUBFRAME_SIZE,
+                                     frameRect.ul().y + row*SUBFRAME_SIZE);
+               ossimRefPtr<ossimImageData> subframe =
+                  ossimAppFixedTileCache::instance()->getTile(m_cacheId, origin);
+               if ( subframe.valid() )
+               {
+                  ossimChainProfiler::cacheHit();
+                  const ossimImageData* cached = subframe.get(); // const, no copy on write
+                  tile->loadTile(cached->getBuf(), subframe->getImageRectangle(), OSSIM_BSQ);
+               }
+               else
+               {
+                  origins.push_back(origin);
+               }
+            }
+         }
+         if ( origins.size() )
+         {
+            misses.push_back(&(*frame));
+            missOrigins.push_back(origins);
+         }
+      }
+      ++frame;
+   }
+
+   if ( misses.empty() )
+   {
+      return;
+   }
+
+   if ( (misses.size() == 1) || (m_decodeThreads < 2) )
+   {
+      std::vector< ossimRefPtr<ossimImageData> > subframes;
+      for (ossim_uint32 i = 0; i < misses.size(); ++i)
+      {
+         if ( uncompressFrame(*misses[i], missOrigins[i], subframes) )
+         {
+            addSubframes(subframes, tile);
+         }
+      }
+      return;
+   }
+
+   if ( !m_decodeQueue.valid() )
+   {
+      m_decodeQueue = new ossimJobMultiThreadQueue(0, m_decodeThreads);
+   }
+   ossimRefPtr<ossimRpfDecodeBatch> batch =
+      new ossimRpfDecodeBatch( static_cast<ossim_uint32>(misses.size()) );
+   std::vector< ossimRefPtr<ossimRpfDecodeJob> > jobs;
+   for (ossim_uint32 i = 0; i < misses.size(); ++i)
+   {
+      ossimRefPtr<ossimRpfDecodeJob> job =
+         new ossimRpfDecodeJob(this, *misses[i], missOrigins[i], batch.get());
+      jobs.push_back(job);
+      m_decodeQueue->getJobQueue()->add(job.get(), false);
+   }
+   batch->wait();
+
+   for (ossim_uint32 i = 0; i < jobs.size(); ++i)
+   {
+      addSubframes(jobs[i]->getSubframes(), tile);
+   }
+}
+
+bool ossimRpfSubframeCache::uncompressFrame(
+   const Frame& frame,
+   const std::vector<ossimIpt>& origins,
+   std::vector< ossimRefPtr<ossimImageData> >& subframes) const
+{
+   subframes.clear();
+
+   ossimRefPtr<ossimRpfFrame> rpfFrame = new ossimRpfFrame();
+   if ( rpfFrame->parseFile(frame.m_file) != ossimErrorCodes::OSSIM_OK )
+   {
+      return false;
+   }
+
+   // A CADRG and CIB subframe is 64*64*12 bits.
+   std::vector<ossim_uint8> compressed( (64*64*12)/8 );
+   std::vector<ossimIpt>::const_iterator origin = origins.begin();
+   while ( origin != origins.end() )
+   {
+      ossimRefPtr<ossimImageData> subframe =
+         new ossimImageData(0, OSSIM_UINT8, m_bands, SUBFRAME_SIZE, SUBFRAME_SIZE);
+      subframe->initialize();
+      subframe->setOrigin(*origin);
+
+      const ossim_uint32 ROW = ((*origin).y - frame.m_origin.y) / SUBFRAME_SIZE;
+      const ossim_uint32 COL = ((*origin).x - frame.m_origin.x) / SUBFRAME_SIZE;
+      if ( !rpfFrame->uncompressSubFrame(subframe->getUcharBuf(), m_bands,
+                                         ROW, COL, &compressed.front()) )
+      {
+         // Missing subframes are zeros, as the readers always filled them.
+         memset(subframe->getBuf(), 0, subframe->getSizeInBytes());
+      }
+      subframe->validate();
+      subframes.push_back(subframe);
+      ++origin;
+   }
+   return true;
+}
+
+void ossimRpfSubframeCache::addSubframes(
+   const std::vector< ossimRefPtr<ossimImageData> >& subframes,
+   ossimImageData* tile)
+{
+   std::vector< ossimRefPtr<ossimImageData> >::const_iterator subframe = subframes.begin();
+   while ( subframe != subframes.end() )
+   {
+      ossimAppFixedTileCache::instance()->addTile(m_cacheId, (*subframe), false);
+      tile->loadTile((*subframe)->getBuf(), (*subframe)->getImageRectangle(), OSSIM_BSQ);
+      ++subframe;
+   }
+}
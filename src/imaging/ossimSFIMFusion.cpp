@@ -124,70 +124,37 @@ ossimRefPtr<ossimImageData> ossimSFIMFusion::getTile(const ossimIrect& rect,
       return theTile;
    }
    
-   ossim_uint32 y = 0;
-   ossim_uint32 x = 0;
-   ossim_uint32 w = theTile->getWidth();
-   ossim_uint32 h = theTile->getHeight();
-
-   ossimRefPtr<ossimImageData> normColorOutputData = (ossimImageData*)normColorData->dup();
-   normColorOutputData->setImageRectangle(rect);
-   normColorOutputData->loadTile(normColorData.get());
-   
-   // ossim_float64 slopeResult = 0.0;
-   ossim_uint32 idx = 0;
-   std::vector<ossim_float32*> bands(normColorData->getNumberOfBands());
+   //---
+   // Single pass per band, in place: normColorData is theNormTile, which getNormTile() refills on
+   // every call, and the pan low and high pass buffers are ours.
+   //---
+   const ossim_uint32 size = theTile->getWidth()*theTile->getHeight();
 
    // Use copyTileBand... in case n-band data passed in for pan input.
    lowTile->copyTileBandToNormalizedBuffer(0, (ossim_float32*)theNormLowPassTile->getBuf());
    highTile->copyTileBandToNormalizedBuffer(0, (ossim_float32*)theNormHighPassTile->getBuf());
 
-   theNormLowPassTile->validate();
-   theNormHighPassTile->validate();
-   ossimRefPtr<ossimImageData> lowPan = (ossimImageData*)theNormLowPassTile->dup();
-   lowPan->setImageRectangle(rect);
-   lowPan->loadTile(theNormLowPassTile.get());
-   ossimRefPtr<ossimImageData> highPan = (ossimImageData*)theNormHighPassTile->dup();
-   highPan->setImageRectangle(rect);
-   highPan->loadTile(theNormHighPassTile.get());
-   
-   ossim_float32* panHigh = (ossim_float32*)highPan->getBuf();
-   ossim_float32* panLow  = (ossim_float32*)lowPan->getBuf();
-   for(idx = 0; idx < bands.size(); ++idx)
-   {
-      bands[idx] = (ossim_float32*)normColorOutputData->getBuf(idx);
-   }
-   // double delta = 0.0;
-   ossim_uint32 bandsSize = (ossim_uint32)bands.size();
-   double normMinPix = 0.0;
-   for(y = 0; y < h; ++y)
+   const ossim_float32* panHigh = (const ossim_float32*)theNormHighPassTile->getBuf();
+   const ossim_float32* panLow  = (const ossim_float32*)theNormLowPassTile->getBuf();
+   const ossim_uint32 bandsSize = normColorData->getNumberOfBands();
+   for(ossim_uint32 idx = 0; idx < bandsSize; ++idx)
    {
-      for(x = 0; x < w; ++x)
+      ossim_float32* band = (ossim_float32*)normColorData->getBuf(idx);
+      const double normMinPix = (ossim_float32)normColorData->getMinPix(idx);
+      for(ossim_uint32 i = 0; i < size; ++i)
       {
-         for(idx = 0; idx < bandsSize; ++idx)
+         if((band[i] != 0.0)&&
+            (panLow[i] > FLT_EPSILON) ) // if band is not null and not divide by 0
          {
-            if((*bands[idx] != 0.0)&&
-               (*panLow > FLT_EPSILON) ) // if band is not null and not divide by 0
-            {
-               normMinPix = (ossim_float32)normColorOutputData->getMinPix(idx);
-               *bands[idx] = ((*bands[idx])*(*panHigh))/
-                  (*panLow);
-               if(*bands[idx] > 1.0) *bands[idx] = 1.0;
-               if(*bands[idx] < normMinPix) *bands[idx] = normMinPix;
-            }
-            // let's comment out the nulling and we will instead just pass the color on
-            //
-//            else
-//            {
-//               *bands[idx] = 0.0;
-//            }
-            ++bands[idx];
+            band[i] = (band[i]*panHigh[i])/panLow[i];
+            if(band[i] > 1.0) band[i] = 1.0;
+            if(band[i] < normMinPix) band[i] = normMinPix;
          }
-         ++panHigh;
-         ++panLow;
+         // Null or divide by 0: the color is passed on.
       }
    }
    
-   theTile->copyNormalizedBufferToTile((ossim_float32*)normColorOutputData->getBuf());
+   theTile->copyNormalizedBufferToTile((ossim_float32*)normColorData->getBuf());
    theTile->validate();
    
    return theTile;
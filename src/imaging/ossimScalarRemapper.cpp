@@ -23,12 +23,85 @@
 #include <ossim/base/ossimRefreshEvent.h>
 #include <ossim/base/ossimTrace.h>
 #include <ossim/base/ossimStringProperty.h>
+#include <ossim/imaging/ossimImageDataKernels.h>
 
 RTTI_DEF1(ossimScalarRemapper,
           "ossimScalarRemapper",
           ossimImageSourceFilter)
 
 static const ossimTrace traceDebug("ossimScalarRemapper:debug");
+
+namespace
+{
+   template <class S, class D>
+   void remapBands(const ossimImageData* input, ossimImageData* output)
+   {
+      const ossim_uint32 BANDS = ossim::min(input->getNumberOfBands(),
+                                            output->getNumberOfBands());
+      const ossim_uint32 SIZE  = output->getSizePerBand();
+      for (ossim_uint32 band = 0; band < BANDS; ++band)
+      {
+         const S* s = static_cast<const S*>(input->getBuf(band));
+         D* d = static_cast<D*>(output->getBuf(band));
+         if (s && d)
+         {
+            ossim::remap(s, d, SIZE,
+                         input->getMinPix(band), input->getMaxPix(band), input->getNullPix(band),
+                         output->getMinPix(band), output->getMaxPix(band),
+                         output->getNullPix(band));
+         }
+      }
+   }
+
+   template <class S>
+   bool remapBands(S /* dummy */, const ossimImageData* input, ossimImageData* output)
+   {
+      switch (output->getScalarType())
+      {
+         case OSSIM_UINT8:
+            remapBands<S, ossim_uint8>(input, output);
+            return true;
+         case OSSIM_USHORT11:
+         case OSSIM_UINT16:
+            remapBands<S, ossim_uint16>(input, output);
+            return true;
+         case OSSIM_SINT16:
+            remapBands<S, ossim_sint16>(input, output);
+            return true;
+         case OSSIM_FLOAT32:
+            remapBands<S, ossim_float32>(input, output);
+            return true;
+         default:
+            return false;
+      }
+   }
+
+   //---
+   // Remaps in one pass with the ossim::remap kernels, for the types they have.
+   // Returns false if the types need the normalized buffer round trip.
+   //---
+   bool remapTile(const ossimImageData* input, ossimImageData* output)
+   {
+      if (input->getSizePerBand() != output->getSizePerBand())
+      {
+         return false;
+      }
+      switch (input->getScalarType())
+      {
+         case OSSIM_UINT8:
+            return remapBands(ossim_uint8(0), input, output);
+         case OSSIM_USHORT11:
+         case OSSIM_UINT16:
+            return remapBands(ossim_uint16(0), input, output);
+         case OSSIM_SINT16:
+            return remapBands(ossim_sint16(0), input, output);
+         case OSSIM_FLOAT32:
+            return remapBands(ossim_float32(0), input, output);
+         default:
+            return false;
+      }
+   }
+}
    
 ossimScalarRemapper::ossimScalarRemapper()
    :
@@ -151,12 +224,6 @@ ossimRefPtr<ossimImageData> ossimScalarRemapper::getTile(
       return theTile;
    }
 
-   if (!theNormBuf) // First time through or size changed and was deleted...
-   {
-      theNormBuf = new double[newSize];
-      memset(theNormBuf, '\0', newSize);
-   }
-
    if (inputTile->getScalarType() == theOutputScalarType)
    {
       // Scalar types already the same.  Nothing to do...
@@ -189,6 +256,18 @@ ossimRefPtr<ossimImageData> ossimScalarRemapper::getTile(
          //---
          // inputTile->stretchMinMax();
 
+         // Direct conversion for the common types:
+         if ( remapTile(inputTile.get(), theTile.get()) )
+         {
+            break;
+         }
+
+         if (!theNormBuf) // First time through or size changed and was deleted...
+         {
+            theNormBuf = new double[newSize];
+            memset(theNormBuf, '\0', newSize);
+         }
+
          // Normalize and copy the source tile to a buffer.
          inputTile->copyTileToNormalizedBuffer(theNormBuf);
          
@@ -454,6 +533,14 @@ bool ossimScalarRemapper::loadState(const ossimKeywordlist& kwl,
    return true;
 }
 
+ossimImageSource* ossimScalarRemapper::cloneSource() const
+{
+   ossimScalarRemapper* result = new ossimScalarRemapper;
+   copySourceSettings(result);
+   result->theOutputScalarType = theOutputScalarType;
+   return result;
+}
+
 ossimString ossimScalarRemapper::getOutputScalarTypeString() const
 {
    return ossimScalarTypeLut::instance()->getEntryString(theOutputScalarType);
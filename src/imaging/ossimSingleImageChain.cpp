@@ -362,8 +362,9 @@ bool ossimSingleImageChain::addImageHandler(const ossimFilename& file, bool open
    bool result = false;
 
    close();
-   
-   m_handler = ossimImageHandlerRegistry::instance()->open(file, true, openOverview);
+
+   // Reuses a handler let go by an earlier chain when the handler pool is on.
+   m_handler = ossimImageHandlerRegistry::instance()->openPooled(file, 0, openOverview);
    
    if ( m_handler.valid() )
    {
@@ -378,7 +379,18 @@ bool ossimSingleImageChain::addImageHandler(const ossimFilename& file, bool open
 
 bool ossimSingleImageChain::addImageHandler(const ossimSrcRecord& src)
 {
-   bool result = addImageHandler( src.getFilename() );
+   bool result = false;
+
+   close();
+
+   // Not pooled, as the record sets the support directory and overview of the handler.
+   m_handler = ossimImageHandlerRegistry::instance()->open(src.getFilename());
+   if ( m_handler.valid() )
+   {
+      addLast( m_handler.get() );
+      result = true;
+   }
+   
    if (result)
    {
       //---
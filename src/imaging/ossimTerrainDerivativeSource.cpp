@@ -0,0 +1,670 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Single pass terrain derivatives (slope, aspect, hillshade and plane normals) of an
+// elevation input.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/imaging/ossimTerrainDerivativeSource.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimColumnVector3d.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimKeywordNames.h>
+#include <ossim/base/ossimMatrix3x3.h>
+#include <ossim/base/ossimSimd.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageGeometry.h>
+#include <cmath>
+#include <limits>
+
+#if OSSIM_SIMD_X86
+#  include <immintrin.h>
+#endif
+
+RTTI_DEF1(ossimTerrainDerivativeSource, "ossimTerrainDerivativeSource", ossimImageSourceFilter)
+
+static const char* PRODUCTS_KW          = "products";
+static const char* SLOPE_TYPE_KW        = "slope_type";
+static const char* SMOOTHNESS_FACTOR_KW = "smoothness_factor";
+static const char* TRACK_SCALE_FLAG_KW  = "track_scale_flag";
+
+namespace
+{
+   //---
+   // One row of posts.  The elevations are NaN where null.  Outputs are NaN where the gradient
+   // is undefined.
+   //---
+   struct RowKernel
+   {
+      const ossim_float32* above;
+      const ossim_float32* row;
+      const ossim_float32* below;
+      double               sx;    // Gradient scale along x, smoothness included.
+      double               sy;
+      ossim_float32        light[3];
+      ossim_float32*       nx;
+      ossim_float32*       ny;
+      ossim_float32*       nz;
+      ossim_float32*       shade;
+   };
+
+   inline bool isValid(ossim_float32 v) { return v == v; }
+
+   //---
+   // One sided difference where a neighbour is null, as in
+   // ossimImageToPlaneNormalFilter::computeNormalsTemplate().
+   //---
+   inline bool difference(ossim_float32 prev, ossim_float32 center, ossim_float32 next,
+                          double scale, double& d)
+   {
+      d = 0.0;
+      if (isValid(next))
+      {
+         if (isValid(prev))
+            d = scale*(next - prev) / 2.0;
+         else if (isValid(center))
+            d = scale*(next - center);
+         return true;
+      }
+      if (isValid(center) && isValid(prev))
+      {
+         d = scale*(center - prev);
+         return true;
+      }
+      return false;
+   }
+
+   void postScalar(const RowKernel& k, ossim_int32 i)
+   {
+      double dx, dy;
+      if (difference(k.row[i-1], k.row[i], k.row[i+1], k.sx, dx) &&
+          difference(k.above[i], k.row[i], k.below[i], k.sy, dy))
+      {
+         const double inv = 1.0 / std::sqrt(dx*dx + dy*dy + 1.0);
+         const double nx = dx*inv;
+         const double ny = dy*inv;
+         const double c = nx*k.light[0] + ny*k.light[1] + inv*k.light[2];
+         k.nx[i] = (ossim_float32) nx;
+         k.ny[i] = (ossim_float32) ny;
+         k.nz[i] = (ossim_float32) inv;
+         k.shade[i] = (ossim_float32) ((c < 0.0) ? 0.0 : ((c > 1.0) ? 1.0 : c));
+      }
+      else
+      {
+         const ossim_float32 NAN_F = std::numeric_limits<ossim_float32>::quiet_NaN();
+         k.nx[i] = k.ny[i] = k.nz[i] = k.shade[i] = NAN_F;
+      }
+   }
+
+#if OSSIM_SIMD_X86
+
+   //---
+   // Central differences for posts whose four neighbours are valid.  A vector with any invalid
+   // lane is redone by postScalar().
+   //---
+   OSSIM_SIMD_TARGET("sse2")
+   ossim_int32 rowSse2(const RowKernel& k, ossim_int32 count)
+   {
+      const __m128 HX = _mm_set1_ps((ossim_float32) (k.sx / 2.0));
+      const __m128 HY = _mm_set1_ps((ossim_float32) (k.sy / 2.0));
+      const __m128 ONE = _mm_set1_ps(1.0f);
+      const __m128 ZERO = _mm_setzero_ps();
+      const __m128 LX = _mm_set1_ps(k.light[0]);
+      const __m128 LY = _mm_set1_ps(k.light[1]);
+      const __m128 LZ = _mm_set1_ps(k.light[2]);
+      ossim_int32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         const __m128 L = _mm_loadu_ps(k.row + i - 1);
+         const __m128 R = _mm_loadu_ps(k.row + i + 1);
+         const __m128 U = _mm_loadu_ps(k.above + i);
+         const __m128 D = _mm_loadu_ps(k.below + i);
+         const __m128 DX = _mm_mul_ps(_mm_sub_ps(R, L), HX);
+         const __m128 DY = _mm_mul_ps(_mm_sub_ps(D, U), HY);
+         const __m128 INV = _mm_div_ps(ONE, _mm_sqrt_ps(
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(DX, DX), _mm_mul_ps(DY, DY)), ONE)));
+         const __m128 NX = _mm_mul_ps(DX, INV);
+         const __m128 NY = _mm_mul_ps(DY, INV);
+         const __m128 C = _mm_add_ps(_mm_add_ps(_mm_mul_ps(NX, LX), _mm_mul_ps(NY, LY)),
+                                     _mm_mul_ps(INV, LZ));
+         _mm_storeu_ps(k.nx + i, NX);
+         _mm_storeu_ps(k.ny + i, NY);
+         _mm_storeu_ps(k.nz + i, INV);
+         _mm_storeu_ps(k.shade + i, _mm_min_ps(_mm_max_ps(C, ZERO), ONE));
+
+         const int VALID = _mm_movemask_ps(_mm_and_ps(_mm_cmpord_ps(L, R), _mm_cmpord_ps(U, D)));
+         if (VALID != 0xf)
+         {
+            for (ossim_int32 j = 0; j < 4; ++j)
+            {
+               if (!(VALID & (1 << j)))
+                  postScalar(k, i + j);
+            }
+         }
+      }
+      return i;
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   ossim_int32 rowAvx2(const RowKernel& k, ossim_int32 count)
+   {
+      const __m256 HX = _mm256_set1_ps((ossim_float32) (k.sx / 2.0));
+      const __m256 HY = _mm256_set1_ps((ossim_float32) (k.sy / 2.0));
+      const __m256 ONE = _mm256_set1_ps(1.0f);
+      const __m256 ZERO = _mm256_setzero_ps();
+      const __m256 LX = _mm256_set1_ps(k.light[0]);
+      const __m256 LY = _mm256_set1_ps(k.light[1]);
+      const __m256 LZ = _mm256_set1_ps(k.light[2]);
+      ossim_int32 i = 0;
+      for (; i + 8 <= count; i += 8)
+      {
+         const __m256 L = _mm256_loadu_ps(k.row + i - 1);
+         const __m256 R = _mm256_loadu_ps(k.row + i + 1);
+         const __m256 U = _mm256_loadu_ps(k.above + i);
+         const __m256 D = _mm256_loadu_ps(k.below + i);
+         const __m256 DX = _mm256_mul_ps(_mm256_sub_ps(R, L), HX);
+         const __m256 DY = _mm256_mul_ps(_mm256_sub_ps(D, U), HY);
+         const __m256 INV = _mm256_div_ps(ONE, _mm256_sqrt_ps(_mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(DX, DX), _mm256_mul_ps(DY, DY)), ONE)));
+         const __m256 NX = _mm256_mul_ps(DX, INV);
+         const __m256 NY = _mm256_mul_ps(DY, INV);
+         const __m256 C = _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(NX, LX), _mm256_mul_ps(NY, LY)), _mm256_mul_ps(INV, LZ));
+         _mm256_storeu_ps(k.nx + i, NX);
+         _mm256_storeu_ps(k.ny + i, NY);
+         _mm256_storeu_ps(k.nz + i, INV);
+         _mm256_storeu_ps(k.shade + i, _mm256_min_ps(_mm256_max_ps(C, ZERO), ONE));
+
+         const int VALID = _mm256_movemask_ps(_mm256_and_ps(_mm256_cmp_ps(L, R, _CMP_ORD_Q),
+                                                            _mm256_cmp_ps(U, D, _CMP_ORD_Q)));
+         if (VALID != 0xff)
+         {
+            for (ossim_int32 j = 0; j < 8; ++j)
+            {
+               if (!(VALID & (1 << j)))
+                  postScalar(k, i + j);
+            }
+         }
+      }
+      return i;
+   }
+
+#endif /* #if OSSIM_SIMD_X86 */
+
+   void computeRow(const RowKernel& k, ossim_int32 count)
+   {
+      ossim_int32 done = 0;
+#if OSSIM_SIMD_X86
+      const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+      if (LEVEL >= ossim::SIMD_AVX2)
+         done = rowAvx2(k, count);
+      else if (LEVEL >= ossim::SIMD_SSE2)
+         done = rowSse2(k, count);
+#endif
+      for (ossim_int32 i = done; i < count; ++i)
+         postScalar(k, i);
+   }
+
+   template <class T>
+   void toElevations(const T* s, ossim_float32* d, ossim_uint32 count, T nullPix)
+   {
+      const ossim_float32 NAN_F = std::numeric_limits<ossim_float32>::quiet_NaN();
+      for (ossim_uint32 i = 0; i < count; ++i)
+         d[i] = (s[i] == nullPix) ? NAN_F : (ossim_float32) s[i];
+   }
+}
+
+ossimTerrainDerivativeSource::ossimTerrainDerivativeSource()
+   : ossimImageSourceFilter(),
+     m_slopeType(ossimSlopeFilter::DEGREES),
+     m_azimuth(180.0),
+     m_elevation(45.0),
+     m_smoothnessFactor(1.0),
+     m_trackScaleFlag(true),
+     m_xScale(1.0),
+     m_yScale(1.0),
+     m_tile(0),
+     m_elevationsWidth(0)
+{
+   m_products.push_back(SLOPE);
+   m_products.push_back(ASPECT);
+   m_products.push_back(HILLSHADE);
+   computeLightDirection();
+}
+
+ossimTerrainDerivativeSource::ossimTerrainDerivativeSource(ossimImageSource* inputSource)
+   : ossimImageSourceFilter(inputSource),
+     m_slopeType(ossimSlopeFilter::DEGREES),
+     m_azimuth(180.0),
+     m_elevation(45.0),
+     m_smoothnessFactor(1.0),
+     m_trackScaleFlag(true),
+     m_xScale(1.0),
+     m_yScale(1.0),
+     m_tile(0),
+     m_elevationsWidth(0)
+{
+   m_products.push_back(SLOPE);
+   m_products.push_back(ASPECT);
+   m_products.push_back(HILLSHADE);
+   computeLightDirection();
+}
+
+ossimTerrainDerivativeSource::~ossimTerrainDerivativeSource()
+{
+}
+
+ossimRefPtr<ossimImageData> ossimTerrainDerivativeSource::getTile(const ossimIrect& tileRect,
+                                                                  ossim_uint32 resLevel)
+{
+   if ( !isSourceEnabled() || !theInputConnection )
+      return ossimImageSourceFilter::getTile(tileRect, resLevel);
+
+   if ( !m_tile.valid() )
+   {
+      m_tile = ossimImageDataFactory::instance()->create(this, this);
+      if ( !m_tile.valid() )
+         return m_tile;
+   }
+   m_tile->setImageRectangle(tileRect);
+   m_tile->initialize();
+   m_tile->makeBlank();
+
+   // One post border for the differences:
+   ossimIrect requestRect(tileRect.ul().x - 1, tileRect.ul().y - 1,
+                          tileRect.lr().x + 1, tileRect.lr().y + 1);
+   ossimRefPtr<ossimImageData> input = theInputConnection->getTile(requestRect, resLevel);
+   if ( !input.valid() || (input->getDataObjectStatus() == OSSIM_EMPTY) || !input->getBuf() ||
+        (input->getWidth() != requestRect.width()) ||
+        (input->getHeight() != requestRect.height()) )
+   {
+      return m_tile;
+   }
+
+   double xScale = m_xScale;
+   double yScale = m_yScale;
+   if (resLevel > 0)
+   {
+      ossimDpt scaleFactor;
+      theInputConnection->getDecimationFactor(resLevel, scaleFactor);
+      if ( !scaleFactor.hasNans() )
+      {
+         xScale *= scaleFactor.x;
+         yScale *= scaleFactor.y;
+      }
+   }
+
+   loadElevations(input.get());
+   computeProducts(xScale, yScale);
+   m_tile->validate();
+   return m_tile;
+}
+
+void ossimTerrainDerivativeSource::loadElevations(const ossimImageData* input)
+{
+   const ossim_uint32 count = input->getSizePerBand();
+   m_elevationsWidth = (ossim_int32) input->getWidth();
+   m_elevations.resize(count);
+   ossim_float32* d = &m_elevations.front();
+   const double np = input->getNullPix(0);
+   switch (input->getScalarType())
+   {
+      case OSSIM_UINT8:
+         toElevations(static_cast<const ossim_uint8*>(input->getBuf(0)), d, count,
+                      (ossim_uint8) np);
+         break;
+      case OSSIM_SINT16:
+         toElevations(static_cast<const ossim_sint16*>(input->getBuf(0)), d, count,
+                      (ossim_sint16) np);
+         break;
+      case OSSIM_UINT16:
+      case OSSIM_USHORT11:
+         toElevations(static_cast<const ossim_uint16*>(input->getBuf(0)), d, count,
+                      (ossim_uint16) np);
+         break;
+      case OSSIM_SINT32:
+         toElevations(static_cast<const ossim_sint32*>(input->getBuf(0)), d, count,
+                      (ossim_sint32) np);
+         break;
+      case OSSIM_UINT32:
+         toElevations(static_cast<const ossim_uint32*>(input->getBuf(0)), d, count,
+                      (ossim_uint32) np);
+         break;
+      case OSSIM_FLOAT32:
+      case OSSIM_NORMALIZED_FLOAT:
+         toElevations(static_cast<const ossim_float32*>(input->getBuf(0)), d, count,
+                      (ossim_float32) np);
+         break;
+      case OSSIM_FLOAT64:
+      case OSSIM_NORMALIZED_DOUBLE:
+         toElevations(static_cast<const ossim_float64*>(input->getBuf(0)), d, count, np);
+         break;
+      default:
+         std::fill(m_elevations.begin(), m_elevations.end(),
+                   std::numeric_limits<ossim_float32>::quiet_NaN());
+         break;
+   }
+}
+
+void ossimTerrainDerivativeSource::computeProducts(double xScale, double yScale)
+{
+   const ossim_int32 width = (ossim_int32) m_tile->getWidth();
+   const ossim_int32 height = (ossim_int32) m_tile->getHeight();
+   std::vector<ossim_float32> nx(width), ny(width), nz(width), shade(width);
+
+   RowKernel k;
+   k.sx = xScale*m_smoothnessFactor;
+   k.sy = yScale*m_smoothnessFactor;
+   k.light[0] = (ossim_float32) m_lightDirection[0];
+   k.light[1] = (ossim_float32) m_lightDirection[1];
+   k.light[2] = (ossim_float32) m_lightDirection[2];
+   k.nx = &nx.front();
+   k.ny = &ny.front();
+   k.nz = &nz.front();
+   k.shade = &shade.front();
+
+   const ossim_uint32 bands = (ossim_uint32) m_products.size();
+   for (ossim_int32 y = 0; y < height; ++y)
+   {
+      k.row = &m_elevations[(y + 1)*m_elevationsWidth + 1];
+      k.above = k.row - m_elevationsWidth;
+      k.below = k.row + m_elevationsWidth;
+      computeRow(k, width);
+
+      for (ossim_uint32 band = 0; band < bands; ++band)
+      {
+         ossim_float32* out = static_cast<ossim_float32*>(m_tile->getBuf(band)) + y*width;
+         const ossim_float32 np = (ossim_float32) m_tile->getNullPix(band);
+         for (ossim_int32 x = 0; x < width; ++x)
+         {
+            if ( !isValid(nz[x]) )
+            {
+               out[x] = np;
+               continue;
+            }
+            switch (m_products[band])
+            {
+               case SLOPE:
+                  switch (m_slopeType)
+                  {
+                     case ossimSlopeFilter::RADIANS:
+                        out[x] = (ossim_float32) std::acos(nz[x]);
+                        break;
+                     case ossimSlopeFilter::RATIO:
+                        out[x] = nz[x];
+                        break;
+                     case ossimSlopeFilter::NORMALIZED:
+                        out[x] = (ossim_float32) std::fabs(std::acos(nz[x])/M_PI);
+                        break;
+                     default:
+                        out[x] = (ossim_float32) ossim::acosd(nz[x]);
+                  }
+                  break;
+               case ASPECT:
+                  if ((nx[x] == 0.0f) && (ny[x] == 0.0f))
+                  {
+                     out[x] = np;
+                  }
+                  else
+                  {
+                     // Downslope is -dz/dx east and +dz/dy north, rows running south:
+                     double a = ossim::atan2d(-nx[x], ny[x]);
+                     out[x] = (ossim_float32) ((a < 0.0) ? a + 360.0 : a);
+                  }
+                  break;
+               case HILLSHADE:
+                  out[x] = shade[x];
+                  break;
+               case NORMAL_X:
+                  out[x] = nx[x];
+                  break;
+               case NORMAL_Y:
+                  out[x] = ny[x];
+                  break;
+               case NORMAL_Z:
+                  out[x] = nz[x];
+                  break;
+            }
+         }
+      }
+   }
+}
+
+void ossimTerrainDerivativeSource::initialize()
+{
+   ossimImageSourceFilter::initialize();
+   m_tile = 0;
+
+   if ( theInputConnection && m_trackScaleFlag )
+   {
+      ossimRefPtr<ossimImageGeometry> geom = theInputConnection->getImageGeometry();
+      if ( geom.valid() )
+      {
+         ossimDpt pt = geom->getMetersPerPixel();
+         if ( !pt.hasNans() )
+         {
+            m_xScale = 1.0/pt.x;
+            m_yScale = 1.0/pt.y;
+         }
+      }
+   }
+   computeLightDirection();
+}
+
+void ossimTerrainDerivativeSource::computeLightDirection()
+{
+   NEWMAT::Matrix m = ossimMatrix3x3::createRotationMatrix(m_elevation, 0.0, -m_azimuth);
+   NEWMAT::ColumnVector v(3);
+   v[0] = 0;
+   v[1] = 1;
+   v[2] = 0;
+   v = m*v;
+
+   // Z up from the surface:
+   ossimColumnVector3d d(v[0], v[1], -v[2]);
+   d = d.unit();
+   m_lightDirection[0] = d[0];
+   m_lightDirection[1] = d[1];
+   m_lightDirection[2] = d[2];
+}
+
+void ossimTerrainDerivativeSource::setProducts(const std::vector<Product>& products)
+{
+   if ( !products.empty() )
+   {
+      m_products = products;
+      m_tile = 0;
+   }
+}
+
+void ossimTerrainDerivativeSource::setLightSource(double azimuth, double elevation)
+{
+   m_azimuth = azimuth;
+   m_elevation = elevation;
+   computeLightDirection();
+}
+
+ossim_uint32 ossimTerrainDerivativeSource::getNumberOfOutputBands() const
+{
+   if ( !isSourceEnabled() )
+      return ossimImageSourceFilter::getNumberOfOutputBands();
+   return (ossim_uint32) m_products.size();
+}
+
+void ossimTerrainDerivativeSource::getOutputBandList(std::vector<ossim_uint32>& bandList) const
+{
+   if ( !isSourceEnabled() )
+   {
+      ossimImageSourceFilter::getOutputBandList(bandList);
+      return;
+   }
+   bandList.resize(m_products.size());
+   for (ossim_uint32 i = 0; i < bandList.size(); ++i)
+      bandList[i] = i;
+}
+
+double ossimTerrainDerivativeSource::getNullPixelValue(ossim_uint32 band) const
+{
+   if ( !isSourceEnabled() )
+      return ossimImageSourceFilter::getNullPixelValue(band);
+   return OSSIM_DEFAULT_NULL_PIX_FLOAT;
+}
+
+double ossimTerrainDerivativeSource::getMinPixelValue(ossim_uint32 band) const
+{
+   if ( !isSourceEnabled() || (band >= m_products.size()) )
+      return ossimImageSourceFilter::getMinPixelValue(band);
+   switch (m_products[band])
+   {
+      case NORMAL_X:
+      case NORMAL_Y:
+         return -1.0;
+      default:
+         return 0.0;
+   }
+}
+
+double ossimTerrainDerivativeSource::getMaxPixelValue(ossim_uint32 band) const
+{
+   if ( !isSourceEnabled() || (band >= m_products.size()) )
+      return ossimImageSourceFilter::getMaxPixelValue(band);
+   switch (m_products[band])
+   {
+      case SLOPE:
+         if (m_slopeType == ossimSlopeFilter::DEGREES)
+            return 90.0;
+         if (m_slopeType == ossimSlopeFilter::RADIANS)
+            return M_PI/2.0;
+         return 1.0;
+      case ASPECT:
+         return 360.0;
+      default:
+         return 1.0;
+   }
+}
+
+bool ossimTerrainDerivativeSource::getProduct(const ossimString& name, Product& product)
+{
+   ossimString s = name;
+   s.downcase();
+   if (s == "slope")
+      product = SLOPE;
+   else if (s == "aspect")
+      product = ASPECT;
+   else if (s == "hillshade")
+      product = HILLSHADE;
+   else if (s == "normal_x")
+      product = NORMAL_X;
+   else if (s == "normal_y")
+      product = NORMAL_Y;
+   else if (s == "normal_z")
+      product = NORMAL_Z;
+   else
+      return false;
+   return true;
+}
+
+ossimString ossimTerrainDerivativeSource::getProductString(Product product)
+{
+   switch (product)
+   {
+      case SLOPE:     return "slope";
+      case ASPECT:    return "aspect";
+      case HILLSHADE: return "hillshade";
+      case NORMAL_X:  return "normal_x";
+      case NORMAL_Y:  return "normal_y";
+      case NORMAL_Z:  return "normal_z";
+   }
+   return "";
+}
+
+bool ossimTerrainDerivativeSource::saveState(ossimKeywordlist& kwl, const char* prefix) const
+{
+   ossimString products;
+   for (ossim_uint32 i = 0; i < m_products.size(); ++i)
+   {
+      if (i)
+         products += " ";
+      products += getProductString(m_products[i]);
+   }
+   kwl.add(prefix, PRODUCTS_KW, products.c_str(), true);
+
+   const char* slopeType = "DEGREES";
+   if (m_slopeType == ossimSlopeFilter::RADIANS)
+      slopeType = "RADIANS";
+   else if (m_slopeType == ossimSlopeFilter::RATIO)
+      slopeType = "RATIO";
+   else if (m_slopeType == ossimSlopeFilter::NORMALIZED)
+      slopeType = "NORMALIZED";
+   kwl.add(prefix, SLOPE_TYPE_KW, slopeType, true);
+
+   kwl.add(prefix, ossimKeywordNames::AZIMUTH_ANGLE_KW, m_azimuth, true);
+   kwl.add(prefix, ossimKeywordNames::ELEVATION_ANGLE_KW, m_elevation, true);
+   kwl.add(prefix, SMOOTHNESS_FACTOR_KW, m_smoothnessFactor, true);
+   kwl.add(prefix, TRACK_SCALE_FLAG_KW, (ossim_uint32) m_trackScaleFlag, true);
+
+   return ossimImageSourceFilter::saveState(kwl, prefix);
+}
+
+bool ossimTerrainDerivativeSource::loadState(const ossimKeywordlist& kwl, const char* prefix)
+{
+   ossimString lookup = kwl.find(prefix, PRODUCTS_KW);
+   if ( !lookup.empty() )
+   {
+      std::vector<ossimString> names = lookup.split(" ,", true);
+      std::vector<Product> products;
+      Product product;
+      for (ossim_uint32 i = 0; i < names.size(); ++i)
+      {
+         if (getProduct(names[i], product))
+            products.push_back(product);
+      }
+      setProducts(products);
+   }
+
+   lookup = kwl.find(prefix, SLOPE_TYPE_KW);
+   if ( !lookup.empty() )
+   {
+      lookup.upcase();
+      if (lookup.contains("RADIANS"))
+         m_slopeType = ossimSlopeFilter::RADIANS;
+      else if (lookup.contains("RATIO"))
+         m_slopeType = ossimSlopeFilter::RATIO;
+      else if (lookup.contains("NORMALIZED"))
+         m_slopeType = ossimSlopeFilter::NORMALIZED;
+      else
+         m_slopeType = ossimSlopeFilter::DEGREES;
+   }
+
+   lookup = kwl.find(prefix, ossimKeywordNames::AZIMUTH_ANGLE_KW);
+   if ( !lookup.empty() )
+      m_azimuth = lookup.toDouble();
+   lookup = kwl.find(prefix, ossimKeywordNames::ELEVATION_ANGLE_KW);
+   if ( !lookup.empty() )
+      m_elevation = lookup.toDouble();
+   lookup = kwl.find(prefix, SMOOTHNESS_FACTOR_KW);
+   if ( !lookup.empty() )
+      m_smoothnessFactor = lookup.toDouble();
+   lookup = kwl.find(prefix, TRACK_SCALE_FLAG_KW);
+   if ( !lookup.empty() )
+      m_trackScaleFlag = lookup.toBool();
+   computeLightDirection();
+
+   return ossimImageSourceFilter::loadState(kwl, prefix);
+}
+
+ossimString ossimTerrainDerivativeSource::getShortName() const
+{
+   return ossimString("Terrain Derivatives");
+}
+
+ossimString ossimTerrainDerivativeSource::getLongName() const
+{
+   return ossimString("Terrain Derivatives, computes slope, aspect, hillshade and plane normals "
+                      "of an elevation input in one pass.");
+}
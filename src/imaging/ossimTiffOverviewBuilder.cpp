@@ -25,6 +25,8 @@
 #include <ossim/base/ossimIpt.h>
 #include <ossim/base/ossimIrect.h>
 #include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossimScalarTypeLut.h>
 #include <ossim/base/ossimTrace.h>
 #include <ossim/imaging/ossimBitMaskTileSource.h>
@@ -33,13 +35,20 @@
 #include <ossim/imaging/ossimImageGeometry.h>
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/imaging/ossimTiffTileSource.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
 #include <ossim/projection/ossimMapProjection.h>
 #include <ossim/projection/ossimMapProjectionInfo.h>
 #include <ossim/projection/ossimProjectionFactoryRegistry.h>
 #include <ossim/support_data/ossimGeoTiff.h>
 
 #include <xtiffio.h>
+#include <OpenThreads/Block>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
 #include <algorithm> /* for std::fill */
+#include <cstring>
+#include <fstream>
 #include <sstream>
 using namespace std;
 
@@ -52,11 +61,223 @@ static ossimTrace traceDebug("ossimTiffOverviewBuilder:degug");
 // Property keywords.
 static const char COPY_ALL_KW[]           = "copy_all_flag";
 static const char INTERNAL_OVERVIEWS_KW[] = "internal_overviews_flag";
+static const char SINGLE_PASS_KW[]        = "single_pass_flag";
 
 #ifdef OSSIM_ID_ENABLED
 static const char OSSIM_ID[] = "$Id: ossimTiffOverviewBuilder.cpp 22362 2013-08-07 20:23:22Z dburken $";
 #endif
 
+namespace
+{
+   //---
+   // Single pass helpers.  A level's strip is one row of its output tiles; the
+   // strips are decimated into each other, a half tile row at a time.
+   //---
+
+   template <class T>
+   void decimateLines(const ossimImageData* src,
+                      ossimImageData* dst,
+                      ossim_uint32 dstSamp,
+                      ossim_uint32 dstLine,
+                      ossim_uint32 samps,
+                      ossim_uint32 lines,
+                      bool boxFlag,
+                      T /* dummy */)
+   {
+      const ossim_uint32 BANDS     = dst->getNumberOfBands();
+      const ossim_uint32 SRC_WIDTH = src->getWidth();
+      const ossim_uint32 DST_WIDTH = dst->getWidth();
+
+      for (ossim_uint32 band = 0; band < BANDS; ++band)
+      {
+         const T* s = static_cast<const T*>(src->getBuf(band));
+         T*       d = static_cast<T*>(dst->getBuf(band)) + dstLine*DST_WIDTH + dstSamp;
+         const T nullPixel = static_cast<T>(src->getNullPix(band));
+
+         for (ossim_uint32 i = 0; i < lines; ++i)
+         {
+            const T* s1 = s + 2*i*SRC_WIDTH;
+            const T* s2 = s1 + SRC_WIDTH;
+            
+            for (ossim_uint32 j = 0; j < samps; ++j)
+            {
+               if ( !boxFlag )
+               {
+                  d[j] = s1[2*j];
+                  continue;
+               }
+               
+               // Same average of the non null pixels as ossimOverviewSequencer.
+               ossim_float64 weight = 0.0;
+               ossim_float64 value  = 0.0;
+               const T* p[4] = { s1 + 2*j, s1 + 2*j + 1, s2 + 2*j, s2 + 2*j + 1 };
+               for (ossim_uint32 k = 0; k < 4; ++k)
+               {
+                  if ( *p[k] != nullPixel )
+                  {
+                     ++weight;
+                     value += *p[k];
+                  }
+               }
+               d[j] = weight ? static_cast<T>( value/weight ) : nullPixel;
+            }
+            d += DST_WIDTH;
+         }
+      }
+   }
+
+   /**
+    * Box or nearest decimates 2*lines x 2*samps pixels from the top left of
+    * src into dst at dstSamp, dstLine.
+    */
+   void decimateLines(const ossimImageData* src,
+                      ossimImageData* dst,
+                      ossim_uint32 dstSamp,
+                      ossim_uint32 dstLine,
+                      ossim_uint32 samps,
+                      ossim_uint32 lines,
+                      bool boxFlag)
+   {
+      switch( dst->getScalarType() )
+      {
+         case OSSIM_UINT8:
+            decimateLines(src, dst, dstSamp, dstLine, samps, lines, boxFlag, ossim_uint8(0));
+            break;
+         case OSSIM_USHORT11:
+         case OSSIM_UINT16:
+            decimateLines(src, dst, dstSamp, dstLine, samps, lines, boxFlag, ossim_uint16(0));
+            break;
+         case OSSIM_SINT16:
+            decimateLines(src, dst, dstSamp, dstLine, samps, lines, boxFlag, ossim_sint16(0));
+            break;
+         case OSSIM_UINT32:
+            decimateLines(src, dst, dstSamp, dstLine, samps, lines, boxFlag, ossim_uint32(0));
+            break;
+         case OSSIM_SINT32:
+            decimateLines(src, dst, dstSamp, dstLine, samps, lines, boxFlag, ossim_sint32(0));
+            break;
+         case OSSIM_FLOAT32:
+            decimateLines(src, dst, dstSamp, dstLine, samps, lines, boxFlag, ossim_float32(0.0));
+            break;
+         case OSSIM_NORMALIZED_DOUBLE:
+         case OSSIM_FLOAT64:
+            decimateLines(src, dst, dstSamp, dstLine, samps, lines, boxFlag, ossim_float64(0.0));
+            break;
+         default:
+            ossimNotify(ossimNotifyLevel_WARN)
+               << "ossimTiffOverviewBuilder decimateLines Unknown pixel type!" << std::endl;
+            break;
+      }
+   }
+
+   /** Fills a strip with nulls; makeBlank skips tiles still flagged empty. */
+   void clearStrip(ossimImageData* strip)
+   {
+      strip->setDataObjectStatus(OSSIM_PARTIAL);
+      strip->makeBlank();
+   }
+
+   /** Completion count of the jobs of one block of tiles. */
+   class ossimOverviewBlockBatch : public ossimReferenced
+   {
+   public:
+      ossimOverviewBlockBatch(ossim_uint32 count)
+         : m_count(count)
+      {
+         if(m_count)
+         {
+            m_block.reset();
+         }
+         else
+         {
+            m_block.release();
+         }
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_count && (--m_count == 0))
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+   private:
+      OpenThreads::Mutex m_mutex;
+      OpenThreads::Block m_block;
+      ossim_uint32       m_count;
+   };
+
+   //---
+   // Decimates one source block, read here when the handler allows
+   // concurrent reads, into its column of the first level's strip.  Jobs of
+   // a block write disjoint columns.
+   //---
+   class ossimOverviewDecimateJob : public ossimJob
+   {
+   public:
+      ossimOverviewDecimateJob(ossimImageHandler* handler,
+                               ossim_uint32 sourceResLevel,
+                               ossimImageData* input,
+                               ossimImageData* strip,
+                               ossim_uint32 stripSamp,
+                               bool readFlag,
+                               bool boxFlag,
+                               ossimOverviewBlockBatch* batch)
+         : m_handler(handler),
+           m_sourceResLevel(sourceResLevel),
+           m_input(input),
+           m_strip(strip),
+           m_stripSamp(stripSamp),
+           m_readFlag(readFlag),
+           m_boxFlag(boxFlag),
+           m_batch(batch)
+      {
+         setName("ossimTiffOverviewBuilder.decimate");
+      }
+      virtual void start()
+      {
+         if ( m_readFlag )
+         {
+            m_handler->getTile(m_input, m_sourceResLevel);
+         }
+         if ( (m_input->getDataObjectStatus() == OSSIM_PARTIAL) ||
+              (m_input->getDataObjectStatus() == OSSIM_FULL) )
+         {
+            decimateLines(m_input, m_strip, m_stripSamp, 0,
+                          m_input->getWidth()/2, m_input->getHeight()/2, m_boxFlag);
+         }
+         m_batch->done();
+      }
+   private:
+      ossimImageHandler*                   m_handler;
+      ossim_uint32                         m_sourceResLevel;
+      ossimImageData*                      m_input;
+      ossimImageData*                      m_strip;
+      ossim_uint32                         m_stripSamp;
+      bool                                 m_readFlag;
+      bool                                 m_boxFlag;
+      ossimRefPtr<ossimOverviewBlockBatch> m_batch;
+   };
+
+   /** One level of the single pass pyramid. */
+   struct ossimOverviewLevel
+   {
+      ossim_uint32                m_resLevel;
+      ossimIrect                  m_rect;
+      ossim_uint32                m_tilesWide;
+      ossim_uint32                m_tilesHigh;
+      ossim_uint32                m_row;   // Tile row held in m_strip.
+      ossimRefPtr<ossimImageData> m_strip;
+      ossimFilename               m_spillFile;
+      std::fstream*               m_spill; // Null for the first level.
+      ossimRefPtr<ossimMultiBandHistogram> m_histogram; // Of the tiles made.
+   };
+}
+
 
 //*******************************************************************
 // Public Constructor:
@@ -78,8 +299,17 @@ ossimTiffOverviewBuilder::ossimTiffOverviewBuilder()
       m_nullPixelValues(),
       m_copyAllFlag(false),
       m_outputTileSizeSetFlag(false),
-      m_internalOverviewsFlag(false)
+      m_internalOverviewsFlag(false),
+      m_singlePassFlag(false),
+      m_histogram(0),
+      m_histogramLevelsFlag(false)
 {
+   const char* lookup = ossimPreferences::instance()->findPreference("overview_builder.single_pass");
+   if ( lookup )
+   {
+      m_singlePassFlag = ossimString(lookup).toBool();
+   }
+
    if (traceDebug())
    {
       ossimNotify(ossimNotifyLevel_DEBUG)
@@ -170,6 +400,9 @@ bool ossimTiffOverviewBuilder::execute()
    // Required number of levels needed including r0.
    ossim_uint32 requiedResLevels = getRequiredResLevels(m_imageHandler.get());
 
+   m_histogram = 0;
+   m_histogramLevelsFlag = false;
+
    // Zero based starting resLevel.
    ossim_uint32 startingResLevel  = 0;
    if ( !copyR0() )
@@ -356,7 +589,17 @@ bool ossimTiffOverviewBuilder::execute()
          m_maskWriter->connectMyInputTo(ih.get());
       }
 
-      if ( !writeRn( ih.get(), tif, i, (i==startingResLevel) && !copyR0() ) )
+      bool status = false;
+      if ( buildSinglePass() )
+      {
+         status = writeRnSinglePass( ih.get(), tif, i, requiedResLevels );
+      }
+      else
+      {
+         status = writeRn( ih.get(), tif, i, (i==startingResLevel) && !copyR0() );
+      }
+      
+      if ( !status )
       {
          // Set the error...
          setErrorStatus();
@@ -411,6 +654,11 @@ bool ossimTiffOverviewBuilder::execute()
          m_maskWriter->disconnectAllInputs();
       }
       ih = 0;
+
+      if ( buildSinglePass() )
+      {
+         break; // All levels written from the one pass.
+      }
    }
 
    if (ossimMpi::instance()->getRank() == 0 )
@@ -421,6 +669,16 @@ bool ossimTiffOverviewBuilder::execute()
          tif = 0;
       }
 
+      if ( m_histogram.valid() && m_histogram->getNumberOfResLevels() )
+      {
+         ossimFilename histoFilename = getOutputFile();
+         histoFilename.setExtension("his");
+         ossimKeywordlist kwl;
+         m_histogram->saveState(kwl);
+         kwl.write(histoFilename.c_str());
+      }
+      m_histogram = 0;
+
       // Write out the alpha bit mask if one was enabled:
       if (m_maskWriter.valid())
       {
@@ -504,6 +762,8 @@ bool ossimTiffOverviewBuilder::writeR0(TIFF* tif)
    }
 
    setCurrentMessage(ossimString("Copying r0..."));
+   setProgressWork("overviews", numberOfTiles,
+                   (ossim_uint64)m_tileWidth * m_tileHeight);
    
    //***
    // Tile loop in the line direction.
@@ -675,6 +935,14 @@ bool ossimTiffOverviewBuilder::writeRn( ossimImageHandler* imageHandler,
          if(ossimMpi::instance()->getNumberOfProcessors() == 1)
          {
             sequencer->setHistogramMode(getHistogramMode());
+
+            //---
+            // A normal mode histogram of r0 is followed by those of the
+            // levels, each counted by the sequencer decimating it.
+            //---
+            m_histogram = new ossimMultiResLevelHistogram;
+            m_histogramLevelsFlag = ( (getHistogramMode() == OSSIM_HISTO_MODE_NORMAL) &&
+                                      (sourceResLevel == 0) );
          }
          //---
          // else{} Not sure if we want an error thrown here.  For now will handle at the
@@ -691,6 +959,11 @@ bool ossimTiffOverviewBuilder::writeRn( ossimImageHandler* imageHandler,
       }
    }
 
+   if ( m_histogramLevelsFlag )
+   {
+      sequencer->setOutputHistogramFlag(true);
+   }
+
    // Note sequence setup must be performed before intialize. 
    sequencer->initialize();
 
@@ -718,34 +991,11 @@ bool ossimTiffOverviewBuilder::writeRn( ossimImageHandler* imageHandler,
    ossimIrect rect;
    sequencer->getOutputImageRectangle(rect);
 
-   if (!setTags(tif, rect, resLevel))
+   if ( !setResLevelTags(tif, rect, resLevel) )
    {
-      setErrorStatus();
-      closeTiff(tif);
-      tif = 0;
-      ossimNotify(ossimNotifyLevel_WARN) << MODULE << " Error writing tags!" << std::endl;
       return false;
    }
 
-   if ( !buildInternalOverviews() && !copyR0() && (resLevel == 1) )
-   {
-      //---
-      // Set the geotif tags for the first layer.
-      // Note this is done in writeR0 method if m_copyAllFlag is set.
-      //---
-      if ( setGeotiffTags(m_imageHandler->getImageGeometry().get(),
-                          ossimDrect(rect),
-                          resLevel,
-                          tif) == false )
-      {
-         if (traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_NOTICE)
-               << MODULE << " NOTICE: geotiff tags not set." << std::endl;
-         } 
-      }
-   }
-
    ossim_uint32 outputTilesWide = sequencer->getNumberOfTilesHorizontal();
    ossim_uint32 outputTilesHigh = sequencer->getNumberOfTilesVertical();
    ossim_uint32 numberOfTiles   = sequencer->getNumberOfTiles();
@@ -760,6 +1010,9 @@ bool ossimTiffOverviewBuilder::writeRn( ossimImageHandler* imageHandler,
          << "\nnumberOfTiles:    " << numberOfTiles
          << std::endl;
    }
+
+   setProgressWork("overviews", numberOfTiles,
+                   (ossim_uint64)m_tileWidth * m_tileHeight);
  
    // Tile loop in the line direction.
    ossim_uint32 y = 0;
@@ -846,12 +1099,10 @@ bool ossimTiffOverviewBuilder::writeRn( ossimImageHandler* imageHandler,
    {
       if ( ossimMpi::instance()->getNumberOfProcessors() == 1 )
       {
-         if ( getHistogramMode() != OSSIM_HISTO_MODE_UNKNOWN )
+         if ( m_histogram.valid() && sequencer->getHistogram().valid() )
          {
-            // Write the histogram.
-            ossimFilename histoFilename = getOutputFile();
-            histoFilename.setExtension("his");
-            sequencer->writeHistogram(histoFilename);
+            // Written by execute once the levels are added.
+            m_histogram->addHistogram( sequencer->getHistogram().get() );
          }
 
          if ( ( getScanForMinMaxNull() == true ) || ( getScanForMinMax() == true ) )
@@ -864,11 +1115,471 @@ bool ossimTiffOverviewBuilder::writeRn( ossimImageHandler* imageHandler,
       }
    }
 
+   if ( m_histogramLevelsFlag && sequencer->getOutputHistogram().valid() )
+   {
+      m_histogram->addHistogram( sequencer->getOutputHistogram().get() );
+   }
+
    ++m_currentTiffDir;
 
    return true;
 }
 
+bool ossimTiffOverviewBuilder::writeRnSinglePass( ossimImageHandler* imageHandler,
+                                                  TIFF* tif,
+                                                  ossim_uint32 startResLevel,
+                                                  ossim_uint32 endResLevel )
+{
+   static const char MODULE[] = "ossimTiffOverviewBuilder::writeRnSinglePass";
+
+   if ( !tif || !imageHandler || (startResLevel == 0) || (startResLevel >= endResLevel) )
+   {
+      return false;
+   }
+
+   TIFFCreateDirectory( tif );
+
+   ossim_uint32 sourceResLevel = imageHandler->getNumberOfDecimationLevels() +
+      imageHandler->getStartingResLevel() - 1;
+   const ossimIrect SOURCE_RECT = imageHandler->getImageRectangle(sourceResLevel);
+   const ossim_uint32 BANDS     = imageHandler->getNumberOfOutputBands();
+   const bool BOX_FLAG =
+      (m_resampleType != ossimFilterResampler::ossimFilterResampler_NEAREST_NEIGHBOR);
+
+   // Levels, sized like ossimOverviewSequencer::getOutputImageRectangle.
+   std::vector<ossimOverviewLevel> levels(endResLevel - startResLevel);
+
+   //---
+   // Normal mode histogram: the source blocks are counted once decimated,
+   // and the tiles of each level as they are made when the source is r0.
+   //---
+   ossimRefPtr<ossimMultiBandHistogram> sourceHistogram = 0;
+   if ( (getHistogramMode() == OSSIM_HISTO_MODE_NORMAL) && !copyR0() )
+   {
+      m_histogram = new ossimMultiResLevelHistogram;
+      m_histogramLevelsFlag = (sourceResLevel == 0);
+      sourceHistogram = new ossimMultiBandHistogram;
+      sourceHistogram->create(imageHandler);
+   }
+   
+   ossim_int32 width  = SOURCE_RECT.width();
+   ossim_int32 height = SOURCE_RECT.height();
+   bool status = true;
+   ossim_uint32 k = 0;
+   for (k = 0; k < levels.size(); ++k)
+   {
+      width  = width/2  + (width%2);
+      height = height/2 + (height%2);
+
+      ossimOverviewLevel& level = levels[k];
+      level.m_resLevel  = startResLevel + k;
+      level.m_rect      = ossimIrect(0, 0, width-1, height-1);
+      level.m_tilesWide = (width  + m_tileWidth  - 1) / m_tileWidth;
+      level.m_tilesHigh = (height + m_tileHeight - 1) / m_tileHeight;
+      level.m_row       = 0;
+      level.m_spill     = 0;
+      if ( m_histogramLevelsFlag )
+      {
+         level.m_histogram = new ossimMultiBandHistogram;
+         level.m_histogram->create(imageHandler);
+      }
+      level.m_strip     = ossimImageDataFactory::instance()->create(0, BANDS, imageHandler);
+      if ( level.m_strip.valid() )
+      {
+         level.m_strip->setWidthHeight(level.m_tilesWide * m_tileWidth, m_tileHeight);
+         level.m_strip->initialize();
+         clearStrip(level.m_strip.get());
+      }
+      else
+      {
+         status = false;
+      }
+      if ( k )
+      {
+         ostringstream os;
+         os << m_outputFile << ".r" << level.m_resLevel << ".tmp";
+         level.m_spillFile = os.str();
+         level.m_spill = new std::fstream( level.m_spillFile.c_str(),
+                                           std::ios::in|std::ios::out|
+                                           std::ios::binary|std::ios::trunc );
+         if ( !level.m_spill->good() )
+         {
+            ossimNotify(ossimNotifyLevel_WARN)
+               << MODULE << " ERROR:\nCannot open file: " << level.m_spillFile << std::endl;
+            status = false;
+         }
+      }
+   }
+
+   ossimRefPtr<ossimImageData> tile =
+      ossimImageDataFactory::instance()->create(0, BANDS, imageHandler);
+   if ( tile.valid() )
+   {
+      tile->setWidthHeight(m_tileWidth, m_tileHeight);
+      tile->initialize();
+   }
+   else
+   {
+      status = false;
+   }
+
+   if ( status )
+   {
+      setCurrentMessage( ossimString("creating r") +
+                         ossimString::toString(startResLevel) + "..." );
+      status = setResLevelTags( tif, levels[0].m_rect, startResLevel );
+
+      // Progress goes by the rows of the first level; counted in its tiles.
+      setProgressWork( "overviews",
+                       (ossim_uint64)levels[0].m_tilesWide * levels[0].m_tilesHigh,
+                       (ossim_uint64)m_tileWidth * m_tileHeight );
+   }
+
+   //---
+   // Reads go on the workers only if the handler allows it; otherwise they
+   // are done here and the workers only decimate.
+   //---
+   const ossim_uint32 THREADS   = ossim::getNumberOfThreads();
+   const bool READ_FLAG         = imageHandler->hasConcurrentReads();
+   const ossim_uint32 BLOCK     = std::min<ossim_uint32>( levels[0].m_tilesWide,
+                                                           4 * (THREADS ? THREADS : 1) );
+   ossimRefPtr<ossimJobMultiThreadQueue> queue = m_jobQueue; // Shared by a batch if set.
+   if ( !queue.valid() && (THREADS > 1) )
+   {
+      queue = new ossimJobMultiThreadQueue(0, THREADS);
+   }
+   std::vector< ossimRefPtr<ossimImageData> > inputs(BLOCK);
+   for (ossim_uint32 i = 0; status && (i < BLOCK); ++i)
+   {
+      inputs[i] = ossimImageDataFactory::instance()->create(0, BANDS, imageHandler);
+      if ( inputs[i].valid() )
+      {
+         inputs[i]->setWidthHeight(2*m_tileWidth, 2*m_tileHeight);
+         inputs[i]->initialize();
+      }
+      else
+      {
+         status = false;
+      }
+   }
+
+   char flag = 0; // Spill file tile marker, 0 for a null tile.
+   
+   // Tile row loop over the first level.
+   for (ossim_uint32 row = 0; status && (row < levels[0].m_tilesHigh); ++row)
+   {
+      // Hint the next row of source blocks to the reader.
+      if ( row + 1 < levels[0].m_tilesHigh )
+      {
+         std::vector<ossimIrect> rects;
+         for (ossim_uint32 col = 0; col < levels[0].m_tilesWide; ++col)
+         {
+            ossimIpt ul( SOURCE_RECT.ul().x + col*2*m_tileWidth,
+                         SOURCE_RECT.ul().y + (row+1)*2*m_tileHeight );
+            rects.push_back( ossimIrect(ul.x, ul.y,
+                                        ul.x + 2*m_tileWidth - 1, ul.y + 2*m_tileHeight - 1) );
+         }
+         imageHandler->prefetch(rects, sourceResLevel);
+      }
+      
+      for (ossim_uint32 col = 0; col < levels[0].m_tilesWide; col += BLOCK)
+      {
+         ossim_uint32 count = std::min<ossim_uint32>(BLOCK, levels[0].m_tilesWide - col);
+         ossimRefPtr<ossimOverviewBlockBatch> batch = new ossimOverviewBlockBatch(count);
+         for (ossim_uint32 i = 0; i < count; ++i)
+         {
+            ossimIpt ul( SOURCE_RECT.ul().x + (col+i)*2*m_tileWidth,
+                         SOURCE_RECT.ul().y + row*2*m_tileHeight );
+            inputs[i]->setImageRectangle(
+               ossimIrect(ul.x, ul.y, ul.x + 2*m_tileWidth - 1, ul.y + 2*m_tileHeight - 1) );
+            if ( !READ_FLAG )
+            {
+               imageHandler->getTile(inputs[i].get(), sourceResLevel);
+            }
+            ossimRefPtr<ossimJob> job =
+               new ossimOverviewDecimateJob( imageHandler, sourceResLevel, inputs[i].get(),
+                                             levels[0].m_strip.get(), (col+i)*m_tileWidth,
+                                             READ_FLAG, BOX_FLAG, batch.get() );
+            if ( queue.valid() )
+            {
+               queue->getJobQueue()->add(job.get(), false);
+            }
+            else
+            {
+               job->start();
+            }
+         }
+         batch->wait();
+
+         // The jobs are done with the blocks:
+         for (ossim_uint32 i = 0; sourceHistogram.valid() && (i < count); ++i)
+         {
+            inputs[i]->populateHistogram(sourceHistogram);
+         }
+      }
+
+      if ( imageHandler->hasError() )
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << MODULE << " ERROR: reading tile row:  " << row << std::endl;
+         status = false;
+         break;
+      }
+
+      //---
+      // Write the finished strip of each level, first level to the tiff,
+      // the others to their spill files, and decimate it into the next.
+      //---
+      k = 0;
+      while ( status && (k < levels.size()) )
+      {
+         ossimOverviewLevel& level = levels[k];
+         ossimImageData* strip = level.m_strip.get();
+         const ossim_uint32 STRIP_WIDTH = strip->getWidth();
+         
+         for (ossim_uint32 col = 0; status && (col < level.m_tilesWide); ++col)
+         {
+            for (ossim_uint32 band = 0; band < BANDS; ++band)
+            {
+               const ossim_uint8* s = static_cast<const ossim_uint8*>(strip->getBuf(band)) +
+                  col * m_tileWidth * m_bytesPerPixel;
+               ossim_uint8* d = static_cast<ossim_uint8*>(tile->getBuf(band));
+               for (ossim_int32 line = 0; line < m_tileHeight; ++line)
+               {
+                  memcpy( d + line * m_tileWidth * m_bytesPerPixel,
+                          s + line * STRIP_WIDTH * m_bytesPerPixel,
+                          m_tileWidth * m_bytesPerPixel );
+               }
+            }
+            if ( m_maskWriter.valid() )
+            {
+               //---
+               // Masks the tile, flipping its bogus pixels to null, and puts it
+               // back so the next level decimates the masked pixels, as the
+               // level by level build reads them through the mask filter.
+               //---
+               tile->setOrigin( ossimIpt(col * m_tileWidth, (level.m_row) * m_tileHeight) );
+               m_maskWriter->generateMask(tile, level.m_resLevel);
+               for (ossim_uint32 band = 0; band < BANDS; ++band)
+               {
+                  ossim_uint8* s = static_cast<ossim_uint8*>(strip->getBuf(band)) +
+                     col * m_tileWidth * m_bytesPerPixel;
+                  const ossim_uint8* d = static_cast<const ossim_uint8*>(tile->getBuf(band));
+                  for (ossim_int32 line = 0; line < m_tileHeight; ++line)
+                  {
+                     memcpy( s + line * STRIP_WIDTH * m_bytesPerPixel,
+                             d + line * m_tileWidth * m_bytesPerPixel,
+                             m_tileWidth * m_bytesPerPixel );
+                  }
+               }
+            }
+            tile->validate();
+            bool nullFlag = (tile->getDataObjectStatus() == OSSIM_NULL);
+            if ( !nullFlag && level.m_histogram.valid() )
+            {
+               tile->populateHistogram(level.m_histogram);
+            }
+
+            if ( level.m_spill )
+            {
+               flag = nullFlag ? 0 : 1;
+               level.m_spill->write( &flag, 1 );
+               for (ossim_uint32 band = 0; !nullFlag && (band < BANDS); ++band)
+               {
+                  level.m_spill->write( (const char*)tile->getBuf(band), m_tileSizeInBytes );
+               }
+               if ( !level.m_spill->good() )
+               {
+                  ossimNotify(ossimNotifyLevel_WARN)
+                     << MODULE << " ERROR: writing " << level.m_spillFile << std::endl;
+                  status = false;
+               }
+            }
+            else if ( !nullFlag )
+            {
+               for (ossim_uint32 band = 0; band < BANDS; ++band)
+               {
+                  int bytesWritten = TIFFWriteTile( tif, tile->getBuf(band),
+                                                    col * m_tileWidth, row * m_tileHeight,
+                                                    0, band );
+                  if (bytesWritten != m_tileSizeInBytes)
+                  {
+                     ossimNotify(ossimNotifyLevel_WARN)
+                        << MODULE << " ERROR:"
+                        << "Error returned writing tiff tile:  " << row
+                        << "\nExpected bytes written:  " << m_tileSizeInBytes
+                        << "\nBytes written:  " << bytesWritten
+                        << std::endl;
+                     status = false;
+                     break;
+                  }
+               }
+            }
+         }
+
+         bool nextRowDone = false;
+         if ( k + 1 < levels.size() )
+         {
+            // Top or bottom half of the next level's tile row.
+            ossimImageData* nextStrip = levels[k+1].m_strip.get();
+            ossim_uint32 half = level.m_row % 2;
+            decimateLines( strip, nextStrip, 0, half * m_tileHeight/2,
+                           std::min<ossim_uint32>(STRIP_WIDTH/2, nextStrip->getWidth()),
+                           m_tileHeight/2, BOX_FLAG );
+            nextRowDone = (half == 1) || (level.m_row + 1 == level.m_tilesHigh);
+         }
+         ++level.m_row;
+         clearStrip(strip);
+
+         if ( !nextRowDone )
+         {
+            break;
+         }
+         ++k;
+      }
+
+      if (needsAborting())
+      {
+         setPercentComplete(100.0);
+         break;
+      }
+      else
+      {
+         double rows = row + 1;
+         double numRows = levels[0].m_tilesHigh;
+         setPercentComplete(rows / numRows * 100.0);
+      }
+      
+   } // End of tile row loop.
+
+   queue = 0;
+
+   if ( status && !TIFFFlush(tif) )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << MODULE << " Error writing to TIF file!" << std::endl;
+      status = false;
+   }
+   if ( status )
+   {
+      ++m_currentTiffDir;
+   }
+
+   // Copy the staged levels into their own directories.
+   for (k = 1; k < levels.size(); ++k)
+   {
+      ossimOverviewLevel& level = levels[k];
+      if ( status && !needsAborting() )
+      {
+         setCurrentMessage( ossimString("creating r") +
+                            ossimString::toString(level.m_resLevel) + "..." );
+         TIFFCreateDirectory( tif );
+         status = setResLevelTags( tif, level.m_rect, level.m_resLevel );
+         level.m_spill->seekg(0);
+         for (ossim_uint32 row = 0; status && (row < level.m_tilesHigh); ++row)
+         {
+            for (ossim_uint32 col = 0; status && (col < level.m_tilesWide); ++col)
+            {
+               level.m_spill->read( &flag, 1 );
+               for (ossim_uint32 band = 0; flag && (band < BANDS); ++band)
+               {
+                  level.m_spill->read( (char*)tile->getBuf(band), m_tileSizeInBytes );
+                  if ( !level.m_spill->good() ||
+                       ( TIFFWriteTile( tif, tile->getBuf(band),
+                                        col * m_tileWidth, row * m_tileHeight,
+                                        0, band ) != m_tileSizeInBytes ) )
+                  {
+                     ossimNotify(ossimNotifyLevel_WARN)
+                        << MODULE << " ERROR: copying tile " << row << ", " << col
+                        << " of r" << level.m_resLevel << std::endl;
+                     status = false;
+                     break;
+                  }
+               }
+            }
+         }
+         if ( status && !TIFFFlush(tif) )
+         {
+            ossimNotify(ossimNotifyLevel_WARN)
+               << MODULE << " Error writing to TIF file!" << std::endl;
+            status = false;
+         }
+         if ( status )
+         {
+            ++m_currentTiffDir;
+         }
+      }
+   }
+
+   for (k = 0; k < levels.size(); ++k)
+   {
+      if ( levels[k].m_spill )
+      {
+         delete levels[k].m_spill;
+         levels[k].m_spill = 0;
+         ossimFilename::remove( levels[k].m_spillFile );
+      }
+   }
+
+   if ( status && sourceHistogram.valid() )
+   {
+      m_histogram->addHistogram( sourceHistogram.get() );
+      for (k = 0; m_histogramLevelsFlag && (k < levels.size()); ++k)
+      {
+         m_histogram->addHistogram( levels[k].m_histogram.get() );
+      }
+   }
+
+   if ( !status )
+   {
+      setErrorStatus();
+   }
+   return status;
+}
+
+bool ossimTiffOverviewBuilder::buildSinglePass() const
+{
+   return ( m_singlePassFlag &&
+            (ossimMpi::instance()->getNumberOfProcessors() == 1) &&
+            (getHistogramMode() != OSSIM_HISTO_MODE_FAST) &&
+            !getScanForMinMax() && !getScanForMinMaxNull() &&
+            (m_tileWidth % 2 == 0) && (m_tileHeight % 2 == 0) );
+}
+
+bool ossimTiffOverviewBuilder::setResLevelTags(TIFF* tif,
+                                               const ossimIrect& outputRect,
+                                               ossim_uint32 resLevel)
+{
+   static const char MODULE[] = "ossimTiffOverviewBuilder::setResLevelTags";
+   
+   if (!setTags(tif, outputRect, resLevel))
+   {
+      setErrorStatus();
+      ossimNotify(ossimNotifyLevel_WARN) << MODULE << " Error writing tags!" << std::endl;
+      return false;
+   }
+
+   if ( !buildInternalOverviews() && !copyR0() && (resLevel == 1) )
+   {
+      //---
+      // Set the geotif tags for the first layer.
+      // Note this is done in writeR0 method if m_copyAllFlag is set.
+      //---
+      if ( setGeotiffTags(m_imageHandler->getImageGeometry().get(),
+                          ossimDrect(outputRect),
+                          resLevel,
+                          tif) == false )
+      {
+         if (traceDebug())
+         {
+            ossimNotify(ossimNotifyLevel_NOTICE)
+               << MODULE << " NOTICE: geotiff tags not set." << std::endl;
+         } 
+      }
+   }
+   return true;
+}
+
 //*******************************************************************
 // Private Method:
 //*******************************************************************
@@ -1124,6 +1835,16 @@ bool ossimTiffOverviewBuilder::getInternalOverviewsFlag() const
    return m_internalOverviewsFlag;
 }
 
+void ossimTiffOverviewBuilder::setSinglePassFlag( bool flag )
+{
+   m_singlePassFlag = flag;
+}
+
+bool ossimTiffOverviewBuilder::getSinglePassFlag() const
+{
+   return m_singlePassFlag;
+}
+
 ossimObject* ossimTiffOverviewBuilder::getObject()
 {
    return this;
@@ -1375,6 +2096,10 @@ void ossimTiffOverviewBuilder::setProperty(ossimRefPtr<ossimProperty> property)
       {
          m_internalOverviewsFlag = property->valueToString().toBool();
       }
+      else if( property->getName() == SINGLE_PASS_KW )
+      {
+         m_singlePassFlag = property->valueToString().toBool();
+      }
       else if(property->getName() == ossimKeywordNames::OVERVIEW_STOP_DIMENSION_KW)
       {
          m_overviewStopDimension = property->valueToString().toUInt32();
@@ -1396,6 +2121,7 @@ void ossimTiffOverviewBuilder::getPropertyNames(std::vector<ossimString>& proper
    propertyNames.push_back(ossimKeywordNames::COMPRESSION_TYPE_KW);
    propertyNames.push_back(COPY_ALL_KW);
    propertyNames.push_back(INTERNAL_OVERVIEWS_KW);
+   propertyNames.push_back(SINGLE_PASS_KW);
    propertyNames.push_back(ossimKeywordNames::OVERVIEW_STOP_DIMENSION_KW);
 }
 
@@ -25,7 +25,10 @@
 #include <ossim/base/ossimIpt.h>
 #include <ossim/base/ossimDpt.h>
 #include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimHttpRangeStream.h>
 #include <ossim/base/ossimIoStream.h> /* for ossimIOMemoryStream */
+#include <ossim/base/ossimPositionalFile.h>
+#include <ossim/base/ossimStreamFactoryRegistry.h>
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimEllipsoid.h>
 #include <ossim/base/ossimDatum.h>
@@ -40,6 +43,146 @@
 RTTI_DEF1(ossimTiffTileSource, "ossimTiffTileSource", ossimImageHandler)
 
 static ossimTrace traceDebug("ossimTiffTileSource:debug");
+static ossimTrace traceSpan("ossimTiffTileSource:span");
+
+namespace
+{
+   //---
+   // libtiff client procs on a stream from ossimStreamFactoryRegistry.  The
+   // handle owns the stream; libtiff calls closeProc from XTIFFClose.  Reads
+   // and seeks are counted in the tile source's counters.
+   //---
+   struct ossimTiffStreamHandle
+   {
+      ossimRefPtr<ossimIFStream> stream;
+      ossim_uint64               size;
+      ossimIoCounters*           counters;
+   };
+
+   tsize_t tiffStreamRead(thandle_t h, tdata_t buf, tsize_t size)
+   {
+      ossimTiffStreamHandle* handle = static_cast<ossimTiffStreamHandle*>(h);
+      std::istream& str = *(handle->stream);
+      str.clear();
+      const ossimTimer::Timer_t BEGIN = ossimTimer::instance()->tick();
+      str.read(static_cast<char*>(buf), size);
+      handle->counters->addRead( str.gcount(), BEGIN, ossimTimer::instance()->tick() );
+      return static_cast<tsize_t>(str.gcount());
+   }
+
+   tsize_t tiffStreamWrite(thandle_t /* h */, tdata_t /* buf */, tsize_t /* size */)
+   {
+      return 0;
+   }
+
+   toff_t tiffStreamSeek(thandle_t h, toff_t offset, int whence)
+   {
+      ossimTiffStreamHandle* handle = static_cast<ossimTiffStreamHandle*>(h);
+      std::istream& str = *(handle->stream);
+      str.clear();
+      const std::streampos BEFORE = str.tellg();
+      std::ios_base::seekdir dir = (whence == SEEK_CUR) ? std::ios_base::cur :
+         ( (whence == SEEK_END) ? std::ios_base::end : std::ios_base::beg );
+      str.seekg(static_cast<std::streamoff>(offset), dir);
+      if ( str.fail() )
+      {
+         return static_cast<toff_t>(-1);
+      }
+      const std::streampos AFTER = str.tellg();
+      if ( AFTER != BEFORE )
+      {
+         handle->counters->addSeek();
+      }
+      return static_cast<toff_t>(AFTER);
+   }
+
+   int tiffStreamClose(thandle_t h)
+   {
+      delete static_cast<ossimTiffStreamHandle*>(h);
+      return 0;
+   }
+
+   toff_t tiffStreamSize(thandle_t h)
+   {
+      return static_cast<toff_t>(static_cast<ossimTiffStreamHandle*>(h)->size);
+   }
+
+   int tiffStreamMap(thandle_t /* h */, tdata_t* /* base */, toff_t* /* size */)
+   {
+      return 0;
+   }
+
+   void tiffStreamUnmap(thandle_t /* h */, tdata_t /* base */, toff_t /* size */)
+   {
+   }
+
+   //---
+   // libtiff client procs on a local file, read with ossimPositionalFile so
+   // the reads and seeks are counted like those of a stream.  Never mapped,
+   // as with the "m" open mode.
+   //---
+   struct ossimTiffFileHandle
+   {
+      ossimPositionalFile file;
+      ossim_uint64        position;
+      ossimIoCounters*    counters;
+   };
+
+   tsize_t tiffFileRead(thandle_t h, tdata_t buf, tsize_t size)
+   {
+      ossimTiffFileHandle* handle = static_cast<ossimTiffFileHandle*>(h);
+      const ossim_uint64 FILE_SIZE = handle->file.size();
+      if ( (size <= 0) || (handle->position >= FILE_SIZE) )
+      {
+         return 0;
+      }
+      const ossim_uint64 LEFT = FILE_SIZE - handle->position;
+      const ossim_uint32 BYTES = static_cast<ossim_uint32>(
+         ( static_cast<ossim_uint64>(size) < LEFT ) ? static_cast<ossim_uint64>(size) : LEFT );
+
+      const ossimTimer::Timer_t BEGIN = ossimTimer::instance()->tick();
+      const bool OK = handle->file.read(handle->position, buf, BYTES);
+      handle->counters->addRead( OK ? BYTES : 0, BEGIN, ossimTimer::instance()->tick() );
+      if ( !OK )
+      {
+         return 0;
+      }
+      handle->position += BYTES;
+      return static_cast<tsize_t>(BYTES);
+   }
+
+   toff_t tiffFileSeek(thandle_t h, toff_t offset, int whence)
+   {
+      ossimTiffFileHandle* handle = static_cast<ossimTiffFileHandle*>(h);
+      ossim_uint64 position = static_cast<ossim_uint64>(offset);
+      if ( (whence == SEEK_CUR) || (whence == SEEK_END) )
+      {
+         // Relative offsets may be negative; toff_t is 32 bits before libtiff 4.
+         const ossim_int64 DELTA = ( sizeof(toff_t) < 8 ) ?
+            static_cast<ossim_int64>( static_cast<ossim_int32>(offset) ) :
+            static_cast<ossim_int64>(offset);
+         position = static_cast<ossim_uint64>( DELTA ) +
+            ( (whence == SEEK_CUR) ? handle->position : handle->file.size() );
+      }
+      if ( position != handle->position )
+      {
+         handle->counters->addSeek();
+         handle->position = position;
+      }
+      return static_cast<toff_t>(position);
+   }
+
+   int tiffFileClose(thandle_t h)
+   {
+      delete static_cast<ossimTiffFileHandle*>(h);
+      return 0;
+   }
+
+   toff_t tiffFileSize(thandle_t h)
+   {
+      return static_cast<toff_t>(static_cast<ossimTiffFileHandle*>(h)->file.size());
+   }
+}
 
 #define OSSIM_TIFF_UNPACK_R4(value) ( (value)&0x000000FF)
 #define OSSIM_TIFF_UNPACK_G4(value) ( ((value)>>8)&0x000000FF)
@@ -96,8 +239,24 @@ ossimTiffTileSource::ossimTiffTileSource()
       theImageDirectoryList(0),
       theCurrentTiffRlevel(0),
       theCompressionType(0),
-      theOutputBandList(0)
-{}
+      theOutputBandList(0),
+      theConcurrentReadFlag(false),
+      theFreeReadHandles(0),
+      theReadHandleCount(0),
+      theReadHandleMutex(),
+      theMainHandleMutex(),
+      thePrefetchTiffPtr(0),
+      thePrefetchDirectory(0),
+      theReadAhead(),
+      thePrefetchMutex(),
+      theIoCounters()
+{
+   const char* lookup = ossimPreferences::instance()->findPreference("tiff.concurrent_reads");
+   if ( lookup )
+   {
+      theConcurrentReadFlag = ossimString(lookup).toBool();
+   }
+}
 
 ossimTiffTileSource::~ossimTiffTileSource()
 {
@@ -131,6 +290,26 @@ ossimRefPtr<ossimImageData> ossimTiffTileSource::getTile(
 
 bool ossimTiffTileSource::getTile(ossimImageData* result,
                                   ossim_uint32 resLevel)
+{
+   OSSIM_TRACE_SPAN_VALUE(traceSpan, "ossimTiffTileSource::getTile", resLevel);
+   bool status = false;
+   if ( theConcurrentReadFlag )
+   {
+      if ( getTileFromReadHandle( result, resLevel, status ) == false )
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMainHandleMutex);
+         status = getTileFromMainHandle( result, resLevel );
+      }
+   }
+   else
+   {
+      status = getTileFromMainHandle( result, resLevel );
+   }
+   return status;
+}
+
+bool ossimTiffTileSource::getTileFromMainHandle(ossimImageData* result,
+                                                ossim_uint32 resLevel)
 {
    static const char MODULE[] = "ossimTiffTileSource::getTile(ossimImageData*, resLevel)";
 
@@ -247,7 +426,7 @@ bool ossimTiffTileSource::getTile(ossimImageData* result,
                {
                   // Would like to change this to throw ossimException.(drb)
                   status = false;
-                  if(traceDebug())
+                  if(OSSIM_TRACE_ENABLED(traceDebug))
                   {
                      // Error in filling buffer.
                      ossimNotify(ossimNotifyLevel_WARN)
@@ -276,6 +455,451 @@ bool ossimTiffTileSource::getTile(ossimImageData* result,
    return status;
 }
 
+bool ossimTiffTileSource::getTileFromReadHandle(ossimImageData* result,
+                                                ossim_uint32 resLevel,
+                                                bool& status)
+{
+   static const char MODULE[] = "ossimTiffTileSource::getTileFromReadHandle";
+
+   if( !isOpen() || !isSourceEnabled() || !isValidRLevel(resLevel) ||
+       !result || (result->getNumberOfBands() != getNumberOfOutputBands()) )
+   {
+      return false; // Let the main handle path sort it out.
+   }
+
+   // Overview levels are read by the overview handler on the main path.
+   if ( theOverview.valid() && theOverview->isValidRLevel(resLevel) )
+   {
+      return false;
+   }
+
+   ossim_uint32 level = resLevel;
+   if (theStartingResLevel && !theR0isFullRes && (level >= theStartingResLevel) )
+   {
+      level -= theStartingResLevel; // Used as overview.
+   }
+   if ( level >= theImageDirectoryList.size() )
+   {
+      return false;
+   }
+
+   const ossim_uint16 DIRECTORY = theImageDirectoryList[level];
+   if ( theReadMethod[DIRECTORY] != READ_TILE )
+   {
+      return false;
+   }
+
+   ossimIrect tile_rect = result->getImageRectangle();
+   ossimIrect image_rect = getImageRectangle(resLevel);
+
+   if ( !tile_rect.intersects(image_rect) )
+   {
+      // No part of requested tile within the image rectangle.
+      result->makeBlank();
+      status = true;
+      return true;
+   }
+
+   ReadHandle* handle = acquireReadHandle(DIRECTORY);
+   if ( !handle )
+   {
+      return false; // Pool is full.
+   }
+
+   result->ref();
+
+   if (result->getDataObjectStatus() == OSSIM_NULL)
+   {
+      result->initialize();
+   }
+
+   ossimIrect clip_rect = tile_rect.clipToRect( image_rect );
+   if ( !tile_rect.completely_within( clip_rect ) )
+   {
+      result->makeBlank();
+   }
+
+   status = loadFromTile( handle, clip_rect, result );
+   if ( status )
+   {
+      result->validate();
+   }
+   else if(OSSIM_TRACE_ENABLED(traceDebug))
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << MODULE
+         << " Error filling buffer. Return status = false..."
+         << std::endl;
+   }
+
+   releaseReadHandle(handle);
+   result->unref();
+
+   return true;
+}
+
+bool ossimTiffTileSource::loadFromTile(ReadHandle* handle,
+                                       const ossimIrect& clip_rect,
+                                       ossimImageData* result) const
+{
+   static const char MODULE[] = "ossimTiffTileSource::loadFromTile(handle)";
+
+   const ossim_uint16 DIR = handle->directory;
+   const ossim_int32 TW = (ossim_int32)theImageTileWidth[DIR];
+   const ossim_int32 TL = (ossim_int32)theImageTileLength[DIR];
+   const bool CONTIG = (thePlanarConfig[DIR] == PLANARCONFIG_CONTIG);
+
+   if ( !TW || !TL )
+   {
+      return false;
+   }
+
+   const tsize_t TILE_SIZE = TIFFTileSize(handle->tiff);
+   if ( TILE_SIZE <= 0 )
+   {
+      return false;
+   }
+   if ( handle->buffer.size() < (std::vector<ossim_uint8>::size_type)TILE_SIZE )
+   {
+      handle->buffer.resize(TILE_SIZE);
+   }
+   ossim_uint8* buf = &handle->buffer.front();
+
+   // Copy of the band list; theOutputBandList may not be set yet.
+   std::vector<ossim_uint32> bandList;
+   if ( !CONTIG )
+   {
+      getOutputBandList( bandList );
+   }
+
+   // Shift clip_rect's upper left to the start of its tile.
+   ossimIpt tileOrigin = clip_rect.ul();
+   tileOrigin.x = (tileOrigin.x / TW) * TW;
+   tileOrigin.y = (tileOrigin.y / TL) * TL;
+
+   for (ossim_int32 y = tileOrigin.y; y <= clip_rect.lr().y; y += TL)
+   {
+      for (ossim_int32 x = tileOrigin.x; x <= clip_rect.lr().x; x += TW)
+      {
+         ossimIrect tiff_tile_rect(x, y, x + TW - 1, y + TL - 1);
+         ossimIrect tiff_tile_clip_rect = tiff_tile_rect.clipToRect(clip_rect);
+
+         if ( CONTIG )
+         {
+            tsize_t tileSizeRead = TIFFReadTile(handle->tiff, buf, x, y, 0, 0);
+            if (tileSizeRead > 0)
+            {
+               result->loadTile(buf, tiff_tile_rect, tiff_tile_clip_rect, OSSIM_BIP);
+            }
+            else if (tileSizeRead < 0)
+            {
+               if(traceDebug())
+               {
+                  ossimNotify(ossimNotifyLevel_WARN)
+                     << MODULE << " Read Error!"
+                     << "\nReturning error...  " << endl;
+               }
+               return false;
+            }
+         }
+         else
+         {
+            for (ossim_uint32 band = 0; band < bandList.size(); ++band)
+            {
+               tsize_t tileSizeRead = TIFFReadTile(handle->tiff, buf, x, y, 0,
+                                                   (tsample_t)bandList[band]);
+               if (tileSizeRead > 0)
+               {
+                  result->loadBand(buf, tiff_tile_rect, tiff_tile_clip_rect, band);
+               }
+               else if (tileSizeRead < 0)
+               {
+                  if(traceDebug())
+                  {
+                     ossimNotify(ossimNotifyLevel_WARN)
+                        << MODULE << " Read Error!"
+                        << "\nReturning error...  " << endl;
+                  }
+                  return false;
+               }
+            }
+         }
+      }
+   }
+
+   return true;
+}
+
+ossimTiffTileSource::ReadHandle* ossimTiffTileSource::acquireReadHandle(
+   ossim_uint16 directory)
+{
+   ReadHandle* handle = 0;
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theReadHandleMutex);
+      if ( theFreeReadHandles.size() )
+      {
+         // Prefer a handle already on the directory to save a TIFFSetDirectory.
+         std::vector<ReadHandle*>::iterator i = theFreeReadHandles.end() - 1;
+         for (std::vector<ReadHandle*>::iterator j = theFreeReadHandles.begin();
+              j != theFreeReadHandles.end(); ++j)
+         {
+            if ( (*j)->directory == directory )
+            {
+               i = j;
+               break;
+            }
+         }
+         handle = *i;
+         theFreeReadHandles.erase(i);
+      }
+      else if ( theReadHandleCount < ossim::getNumberOfThreads() )
+      {
+         ++theReadHandleCount; // Reserve the slot; open outside the lock.
+      }
+      else
+      {
+         return 0;
+      }
+   }
+
+   if ( !handle )
+   {
+      TIFF* tiff = openTiffPtr();
+      if ( !tiff )
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theReadHandleMutex);
+         --theReadHandleCount;
+         return 0;
+      }
+      handle = new ReadHandle();
+      handle->tiff = tiff;
+      handle->directory = 0;
+   }
+
+   if ( handle->directory != directory )
+   {
+      if ( TIFFSetDirectory(handle->tiff, directory) )
+      {
+         handle->directory = directory;
+      }
+      else
+      {
+         if(traceDebug())
+         {
+            ossimNotify(ossimNotifyLevel_WARN)
+               << "ossimTiffTileSource::acquireReadHandle ERROR setting directory "
+               << directory << "!" << endl;
+         }
+         releaseReadHandle(handle);
+         handle = 0;
+      }
+   }
+
+   return handle;
+}
+
+TIFF* ossimTiffTileSource::openTiffPtr() const
+{
+   if ( !ossimHttpRangeStreamFactory::isUrl(theImageFile) )
+   {
+      ossimTiffFileHandle* fileHandle = new ossimTiffFileHandle();
+      if ( !fileHandle->file.open(theImageFile) )
+      {
+         delete fileHandle;
+         return 0;
+      }
+      fileHandle->position = 0;
+      fileHandle->counters = &theIoCounters;
+
+      // Note: The 'm' in "rm" is to tell libtiff to not memory map the file.
+      TIFF* tiff = XTIFFClientOpen(theImageFile.c_str(), "rm",
+                                   static_cast<thandle_t>(fileHandle),
+                                   tiffFileRead, tiffStreamWrite, tiffFileSeek,
+                                   tiffFileClose, tiffFileSize,
+                                   tiffStreamMap, tiffStreamUnmap);
+      if ( !tiff )
+      {
+         delete fileHandle; // libtiff does not call the close proc on a failed open.
+      }
+      return tiff;
+   }
+
+   ossimRefPtr<ossimIFStream> str = ossimStreamFactoryRegistry::instance()->
+      createNewIFStream(theImageFile, std::ios::in | std::ios::binary);
+   ossimHttpRangeIFStream* rangeStr = dynamic_cast<ossimHttpRangeIFStream*>(str.get());
+   if ( !rangeStr || !rangeStr->is_open() )
+   {
+      return 0;
+   }
+
+   ossimTiffStreamHandle* handle = new ossimTiffStreamHandle();
+   handle->stream   = str;
+   handle->size     = rangeStr->getSize();
+   handle->counters = &theIoCounters;
+   TIFF* tiff = XTIFFClientOpen(theImageFile.c_str(), "rm", static_cast<thandle_t>(handle),
+                                tiffStreamRead, tiffStreamWrite, tiffStreamSeek,
+                                tiffStreamClose, tiffStreamSize,
+                                tiffStreamMap, tiffStreamUnmap);
+   if ( !tiff )
+   {
+      delete handle; // libtiff does not call the close proc on a failed open.
+   }
+   return tiff;
+}
+
+bool ossimTiffTileSource::getIoCounters(ossimIoCounters::Values& values) const
+{
+   ossimImageHandler::getIoCounters(values);
+   values += theIoCounters.getValues();
+   return true;
+}
+
+void ossimTiffTileSource::releaseReadHandle(ReadHandle* handle)
+{
+   if ( handle )
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theReadHandleMutex);
+      theFreeReadHandles.push_back(handle);
+   }
+}
+
+void ossimTiffTileSource::closeReadHandles()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theReadHandleMutex);
+   for (ossim_uint32 i = 0; i < theFreeReadHandles.size(); ++i)
+   {
+      XTIFFClose(theFreeReadHandles[i]->tiff);
+      delete theFreeReadHandles[i];
+   }
+   theFreeReadHandles.clear();
+   theReadHandleCount = 0;
+}
+
+void ossimTiffTileSource::prefetch(const std::vector<ossimIrect>& rects,
+                                   ossim_uint32 resLevel)
+{
+   if ( !isOpen() || !isValidRLevel(resLevel) || rects.empty() )
+   {
+      return;
+   }
+
+   if ( theOverview.valid() && theOverview->isValidRLevel(resLevel) )
+   {
+      ossimImageHandler::prefetch(rects, resLevel);
+      return;
+   }
+
+   ossim_uint32 level = resLevel;
+   if (theStartingResLevel && !theR0isFullRes && (level >= theStartingResLevel) )
+   {
+      level -= theStartingResLevel; // Used as overview.
+   }
+   if ( level >= theImageDirectoryList.size() )
+   {
+      return;
+   }
+   const ossim_uint16 DIRECTORY = theImageDirectoryList[level];
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(thePrefetchMutex);
+
+   if ( !thePrefetchTiffPtr )
+   {
+      if ( !theReadAhead.open(theImageFile) )
+      {
+         return; // No read ahead on this platform or file.
+      }
+      thePrefetchTiffPtr = openTiffPtr();
+      if ( !thePrefetchTiffPtr )
+      {
+         theReadAhead.close();
+         return;
+      }
+      thePrefetchDirectory = 0;
+   }
+
+   if ( thePrefetchDirectory != DIRECTORY )
+   {
+      if ( !TIFFSetDirectory(thePrefetchTiffPtr, DIRECTORY) )
+      {
+         return;
+      }
+      thePrefetchDirectory = DIRECTORY;
+   }
+
+   const bool TILED = TIFFIsTiled(thePrefetchTiffPtr);
+   toff_t* offsets = 0;
+   toff_t* byteCounts = 0;
+   if ( !TIFFGetField(thePrefetchTiffPtr,
+                      TILED ? TIFFTAG_TILEOFFSETS : TIFFTAG_STRIPOFFSETS, &offsets) ||
+        !TIFFGetField(thePrefetchTiffPtr,
+                      TILED ? TIFFTAG_TILEBYTECOUNTS : TIFFTAG_STRIPBYTECOUNTS, &byteCounts) ||
+        !offsets || !byteCounts )
+   {
+      return;
+   }
+   const ossim_uint32 COUNT = TILED ? TIFFNumberOfTiles(thePrefetchTiffPtr) :
+      TIFFNumberOfStrips(thePrefetchTiffPtr);
+
+   const ossim_int32 STEP_X = TILED ? theImageTileWidth[DIRECTORY] : theImageWidth[DIRECTORY];
+   const ossim_int32 STEP_Y = TILED ? theImageTileLength[DIRECTORY] :
+      theRowsPerStrip[DIRECTORY];
+   if ( (STEP_X <= 0) || (STEP_Y <= 0) )
+   {
+      return;
+   }
+
+   // Samples (planes) to hint; just the first for contiguous data.
+   std::vector<ossim_uint32> samples(1, 0);
+   if ( thePlanarConfig[DIRECTORY] == PLANARCONFIG_SEPARATE )
+   {
+      getOutputBandList( samples );
+   }
+
+   const ossimIrect IMAGE_RECT = getImageRectangle(resLevel);
+   std::vector<ossimIrect>::const_iterator r = rects.begin();
+   while ( r != rects.end() )
+   {
+      if ( (*r).intersects(IMAGE_RECT) )
+      {
+         ossimIrect clip_rect = (*r).clipToRect(IMAGE_RECT);
+         for (ossim_int32 y = (clip_rect.ul().y / STEP_Y) * STEP_Y;
+              y <= clip_rect.lr().y; y += STEP_Y)
+         {
+            for (ossim_int32 x = (clip_rect.ul().x / STEP_X) * STEP_X;
+                 x <= clip_rect.lr().x; x += STEP_X)
+            {
+               for (ossim_uint32 s = 0; s < samples.size(); ++s)
+               {
+                  ossim_uint32 idx = TILED ?
+                     TIFFComputeTile(thePrefetchTiffPtr, x, y, 0, (tsample_t)samples[s]) :
+                     TIFFComputeStrip(thePrefetchTiffPtr, y, (tsample_t)samples[s]);
+                  if ( idx < COUNT )
+                  {
+                     theReadAhead.willNeed(offsets[idx], byteCounts[idx]);
+                  }
+               }
+            }
+         }
+      }
+      ++r;
+   }
+}
+
+void ossimTiffTileSource::setConcurrentReadFlag(bool flag)
+{
+   theConcurrentReadFlag = flag;
+}
+
+bool ossimTiffTileSource::getConcurrentReadFlag()const
+{
+   return theConcurrentReadFlag;
+}
+
+bool ossimTiffTileSource::hasConcurrentReads() const
+{
+   return theConcurrentReadFlag;
+}
+
 //*******************************************************************
 // Public method:
 //*******************************************************************
@@ -304,6 +928,11 @@ bool ossimTiffTileSource::saveState(ossimKeywordlist& kwl,
               "apply_color_palette_flag",
               theApplyColorPaletteFlag,
               true);
+
+      kwl.add(prefix,
+              "concurrent_reads",
+              theConcurrentReadFlag,
+              true);
    }
    
    return result;
@@ -334,6 +963,13 @@ bool ossimTiffTileSource::loadState(const ossimKeywordlist& kwl,
          theApplyColorPaletteFlag = true;
       }
 
+      key = "concurrent_reads";
+      value.string() = kwl.findKey( pfx, key );
+      if ( value.size() )
+      {
+         theConcurrentReadFlag = value.toBool();
+      }
+
       key = ossimKeywordNames::BANDS_KW;
       value.string() = kwl.findKey( pfx, key );
       if ( value.size() )
@@ -362,6 +998,17 @@ bool ossimTiffTileSource::open(const ossimFilename& image_file)
 
 void ossimTiffTileSource::close()
 {
+   closeReadHandles();
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(thePrefetchMutex);
+      if ( thePrefetchTiffPtr )
+      {
+         XTIFFClose(thePrefetchTiffPtr);
+         thePrefetchTiffPtr = 0;
+         thePrefetchDirectory = 0;
+      }
+      theReadAhead.close();
+   }
    if(theTiffPtr)
    {
       XTIFFClose(theTiffPtr);
@@ -424,10 +1071,7 @@ bool ossimTiffTileSource::open()
    
    theImageDirectoryList.clear();
 
-   //---
-   // Note:  The 'm' in "rm" is to tell TIFFOpen to not memory map the file.
-   //---
-   theTiffPtr = XTIFFOpen(theImageFile.c_str(), "rm");
+   theTiffPtr = openTiffPtr();
    if (!theTiffPtr)
    {
       if (traceDebug())
@@ -2375,13 +3019,14 @@ void ossimTiffTileSource::validateMinMaxNull()
 
    if (theScalarType == OSSIM_FLOAT32)
    {
-      std::ifstream inStr(theImageFile.c_str(), std::ios::in|std::ios::binary);
-      if ( inStr.good() )
+      ossimRefPtr<ossimIFStream> inStr = ossimStreamFactoryRegistry::instance()->
+         createNewIFStream(theImageFile, std::ios::in|std::ios::binary);
+      if ( inStr.valid() && inStr->good() )
       {   
          // Do a print to a memory stream in key:value format.
          ossimTiffInfo ti;
          ossimIOMemoryStream memStr;
-         ti.print(inStr, memStr);
+         ti.print(*inStr, memStr);
 
          // Make keywordlist with all the tags.
          ossimKeywordlist gtiffKwl;
@@ -33,6 +33,16 @@
 #include <ossim/support_data/ossimGeoTiff.h>
 #include <ossim/imaging/ossimMemoryImageSource.h>
 #include <ossim/imaging/ossimScalarRemapper.h>
+#include <ossim/imaging/ossimTiffOverviewBuilder.h>
+#include <ossim/imaging/ossimTiffTileSource.h>
+#include <ossim/base/ossimEndian.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimTimeline.h>
+#include <ossim/imaging/ossimJpegMemDest.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <OpenThreads/Block>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
 
 #include <tiffio.h>
 #ifdef OSSIM_HAS_GEOTIFF
@@ -44,7 +54,14 @@
 #  endif
 #endif
 
+#if OSSIM_HAS_LIBZ
+#  include <zlib.h>
+#endif
+
 #include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
 #include <sstream>
 
 static ossimTrace traceDebug("ossimTiffWriter:debug");
@@ -54,6 +71,668 @@ static const long  DEFAULT_JPEG_QUALITY = 75;
 
 RTTI_DEF1(ossimTiffWriter, "ossimTiffWriter", ossimImageFileWriter);
 
+namespace
+{
+   // Alignment, in bytes, of each tile in a tiff_tiled_cog file.
+   const ossim_uint64 COG_TILE_ALIGNMENT = 16;
+
+   // Guard against IFD chains that loop back on themselves.
+   const ossim_uint32 COG_MAX_IFDS = 1024;
+
+   ossim_uint16 tiffCompression(ossimString type)
+   {
+      type.downcase();
+      if (type == "jpeg")
+      {
+         return COMPRESSION_JPEG;
+      }
+      else if (type == "packbits")
+      {
+         return COMPRESSION_PACKBITS;
+      }
+      else if ( (type == "deflate") || (type == "zip") )
+      {
+         return COMPRESSION_DEFLATE;
+      }
+      return COMPRESSION_NONE;
+   }
+
+   /**
+    * Reads the IFD chain of a tiled tiff or bigtiff and writes it back out
+    * laid out for range reads: header, GDAL ghost area, every IFD with its
+    * out of line values, then the tiles of the last IFD first through to
+    * the tiles of the first IFD, with TileOffsets rewritten to match.
+    * IFD links such as SubIFDs and Exif are not followed, so files having
+    * them are refused.
+    */
+   class ossimTiffLayout
+   {
+   public:
+      ossimTiffLayout() : m_bigTiff(false), m_swap(false) {}
+
+      bool read(std::istream& in);
+      bool write(std::istream& in, std::ostream& out);
+
+   private:
+      struct Entry
+      {
+         ossim_uint16      tag;
+         ossim_uint16      type;
+         ossim_uint64      count;
+         std::vector<char> value;  // File byte order.
+         ossim_uint64      offset; // Where an out of line value is written.
+      };
+
+      struct Ifd
+      {
+         std::vector<Entry>        entries;
+         std::vector<ossim_uint64> tileOffsets;
+         std::vector<ossim_uint64> tileByteCounts;
+         ossim_uint64              position;
+      };
+
+      static ossim_uint64 typeSize(ossim_uint16 type)
+      {
+         switch (type)
+         {
+            case 1: case 2: case 6: case 7:    return 1; // BYTE ASCII SBYTE UNDEFINED
+            case 3: case 8:                    return 2; // SHORT SSHORT
+            case 4: case 9: case 11:           return 4; // LONG SLONG FLOAT
+            case 5: case 10: case 12: case 16:
+            case 17:                           return 8; // RATIONAL DOUBLE LONG8
+            default:                           return 0; // IFD, IFD8 or unknown.
+         }
+      }
+
+      static ossim_uint64 align(ossim_uint64 pos, ossim_uint64 alignment)
+      {
+         return ( (pos + alignment - 1) / alignment ) * alignment;
+      }
+
+      ossim_uint64 inlineSize() const { return m_bigTiff ? 8 : 4; }
+
+      template <class T> T get(std::istream& in) const
+      {
+         T v = 0;
+         in.read(reinterpret_cast<char*>(&v), sizeof(T));
+         if (m_swap)
+         {
+            m_endian.swap(v);
+         }
+         return v;
+      }
+
+      template <class T> T get(const char* buf) const
+      {
+         T v;
+         std::memcpy(&v, buf, sizeof(T));
+         if (m_swap)
+         {
+            m_endian.swap(v);
+         }
+         return v;
+      }
+
+      template <class T> void put(std::vector<char>& buf, T v) const
+      {
+         if (m_swap)
+         {
+            m_endian.swap(v);
+         }
+         const char* c = reinterpret_cast<const char*>(&v);
+         buf.insert(buf.end(), c, c + sizeof(T));
+      }
+
+      ossim_uint64 getOffset(std::istream& in) const
+      {
+         return m_bigTiff ? get<ossim_uint64>(in) : get<ossim_uint32>(in);
+      }
+
+      void putOffset(std::vector<char>& buf, ossim_uint64 v) const
+      {
+         if (m_bigTiff)
+         {
+            put(buf, v);
+         }
+         else
+         {
+            put(buf, static_cast<ossim_uint32>(v));
+         }
+      }
+
+      bool decode(const Entry& e, std::vector<ossim_uint64>& values) const;
+
+      void encode(Entry& e, const std::vector<ossim_uint64>& values) const;
+
+      static void pad(std::ostream& out, ossim_uint64& pos, ossim_uint64 target)
+      {
+         static const char ZEROS[64] = { 0 };
+         while (pos < target)
+         {
+            const ossim_uint64 n = std::min<ossim_uint64>(target - pos, sizeof(ZEROS));
+            out.write(ZEROS, n);
+            pos += n;
+         }
+      }
+
+      bool m_bigTiff;
+      bool m_swap;
+      ossimEndian m_endian;
+      std::vector<Ifd> m_ifds;
+   };
+
+   bool ossimTiffLayout::decode(const Entry& e, std::vector<ossim_uint64>& values) const
+   {
+      const ossim_uint64 SIZE = typeSize(e.type);
+      if ( (e.type != 3) && (e.type != 4) && (e.type != 16) )
+      {
+         return false;
+      }
+      values.resize(e.count);
+      for (ossim_uint64 i = 0; i < e.count; ++i)
+      {
+         const char* buf = &e.value[i * SIZE];
+         values[i] = (e.type == 3) ? get<ossim_uint16>(buf) :
+            ( (e.type == 4) ? get<ossim_uint32>(buf) : get<ossim_uint64>(buf) );
+      }
+      return true;
+   }
+
+   void ossimTiffLayout::encode(Entry& e, const std::vector<ossim_uint64>& values) const
+   {
+      e.type  = m_bigTiff ? 16 : 4; // LONG8 : LONG
+      e.count = values.size();
+      e.value.clear();
+      for (ossim_uint64 i = 0; i < values.size(); ++i)
+      {
+         putOffset(e.value, values[i]);
+      }
+   }
+
+   bool ossimTiffLayout::read(std::istream& in)
+   {
+      char order[2] = { 0, 0 };
+      in.read(order, 2);
+      ossimByteOrder fileOrder;
+      if ( (order[0] == 'I') && (order[1] == 'I') )
+      {
+         fileOrder = OSSIM_LITTLE_ENDIAN;
+      }
+      else if ( (order[0] == 'M') && (order[1] == 'M') )
+      {
+         fileOrder = OSSIM_BIG_ENDIAN;
+      }
+      else
+      {
+         return false;
+      }
+      m_swap = (fileOrder != ossim::byteOrder());
+
+      const ossim_uint16 MAGIC = get<ossim_uint16>(in);
+      if (MAGIC == 43)
+      {
+         m_bigTiff = true;
+         const ossim_uint16 OFFSET_SIZE = get<ossim_uint16>(in);
+         get<ossim_uint16>(in);
+         if (OFFSET_SIZE != 8)
+         {
+            return false;
+         }
+      }
+      else if (MAGIC != 42)
+      {
+         return false;
+      }
+
+      const ossim_uint64 INLINE_SIZE = inlineSize();
+      ossim_uint64 next = getOffset(in);
+      while ( next && in.good() && (m_ifds.size() < COG_MAX_IFDS) )
+      {
+         in.seekg(next);
+         const ossim_uint64 N = m_bigTiff ? get<ossim_uint64>(in) : get<ossim_uint16>(in);
+         if ( !in.good() || (N > 4096) )
+         {
+            return false;
+         }
+
+         m_ifds.push_back(Ifd());
+         Ifd& ifd = m_ifds.back();
+         ifd.entries.resize(N);
+         std::vector<char> inlineValues(N * INLINE_SIZE);
+         for (ossim_uint64 i = 0; i < N; ++i)
+         {
+            Entry& e = ifd.entries[i];
+            e.tag    = get<ossim_uint16>(in);
+            e.type   = get<ossim_uint16>(in);
+            e.count  = m_bigTiff ? get<ossim_uint64>(in) : get<ossim_uint32>(in);
+            e.offset = 0;
+            in.read(&inlineValues[i * INLINE_SIZE], INLINE_SIZE);
+         }
+         next = getOffset(in);
+
+         for (ossim_uint64 i = 0; i < N; ++i)
+         {
+            Entry& e = ifd.entries[i];
+            const ossim_uint64 SIZE = e.count * typeSize(e.type);
+            if ( !typeSize(e.type) || (e.count > (ossim_uint64(1) << 32)) ||
+                 (e.tag == 273) || (e.tag == 330) || (e.tag == 34665) || (e.tag == 34853) )
+            {
+               return false; // Strips, IFD links or an unknown type.
+            }
+            const char* buf = &inlineValues[i * INLINE_SIZE];
+            if (SIZE <= INLINE_SIZE)
+            {
+               e.value.assign(buf, buf + SIZE);
+            }
+            else
+            {
+               e.value.resize(SIZE);
+               in.seekg( m_bigTiff ? get<ossim_uint64>(buf) : get<ossim_uint32>(buf) );
+               in.read(&e.value.front(), SIZE);
+            }
+
+            if ( (e.tag == 324) && !decode(e, ifd.tileOffsets) ) // TileOffsets
+            {
+               return false;
+            }
+            if ( (e.tag == 325) && !decode(e, ifd.tileByteCounts) ) // TileByteCounts
+            {
+               return false;
+            }
+         }
+
+         if ( ifd.tileOffsets.empty() ||
+              (ifd.tileOffsets.size() != ifd.tileByteCounts.size()) )
+         {
+            return false;
+         }
+      }
+
+      return in.good() && !m_ifds.empty() && !next;
+   }
+
+   bool ossimTiffLayout::write(std::istream& in, std::ostream& out)
+   {
+      const ossim_uint64 INLINE_SIZE = inlineSize();
+      const ossim_uint64 HEADER_SIZE = m_bigTiff ? 16 : 8;
+      const ossim_uint64 ENTRY_SIZE  = m_bigTiff ? 20 : 12;
+      const ossim_uint64 COUNT_SIZE  = m_bigTiff ? 8 : 2;
+
+      // Ghost area; readers check it to know the file was not edited since.
+      const std::string GHOST_BODY =
+         "LAYOUT=IFDS_BEFORE_DATA\n"
+         "BLOCK_ORDER=ROW_MAJOR\n"
+         "BLOCK_LEADER=NONE\n"
+         "BLOCK_TRAILER=NONE\n"
+         "KNOWN_INCOMPATIBLE_EDITION=NO\n ";
+      std::ostringstream ghost;
+      ghost << "GDAL_STRUCTURAL_METADATA_SIZE=" << std::setw(6) << std::setfill('0')
+            << GHOST_BODY.size() << " bytes\n" << GHOST_BODY;
+      const std::string GHOST = ghost.str();
+
+      // Place the IFDs with their values; tile arrays are sized now, filled later.
+      ossim_uint64 pos = HEADER_SIZE + GHOST.size();
+      std::vector< std::vector<ossim_uint64> > newOffsets(m_ifds.size());
+      for (ossim_uint64 i = 0; i < m_ifds.size(); ++i)
+      {
+         Ifd& ifd = m_ifds[i];
+         newOffsets[i].assign(ifd.tileOffsets.size(), 0);
+         for (ossim_uint64 j = 0; j < ifd.entries.size(); ++j)
+         {
+            Entry& e = ifd.entries[j];
+            if (e.tag == 324)
+            {
+               encode(e, newOffsets[i]);
+            }
+            else if (e.tag == 325)
+            {
+               encode(e, ifd.tileByteCounts);
+            }
+         }
+
+         pos = align(pos, 8);
+         ifd.position = pos;
+         pos += COUNT_SIZE + ifd.entries.size() * ENTRY_SIZE + INLINE_SIZE;
+         for (ossim_uint64 j = 0; j < ifd.entries.size(); ++j)
+         {
+            Entry& e = ifd.entries[j];
+            if (e.value.size() > INLINE_SIZE)
+            {
+               pos = align(pos, 8);
+               e.offset = pos;
+               pos += e.value.size();
+            }
+         }
+      }
+
+      // Tiles, smallest overview first.
+      for (ossim_uint64 i = m_ifds.size(); i > 0; --i)
+      {
+         const Ifd& ifd = m_ifds[i - 1];
+         for (ossim_uint64 t = 0; t < ifd.tileOffsets.size(); ++t)
+         {
+            if (ifd.tileByteCounts[t])
+            {
+               pos = align(pos, COG_TILE_ALIGNMENT);
+               newOffsets[i - 1][t] = pos;
+               pos += ifd.tileByteCounts[t];
+            }
+         }
+      }
+      if ( !m_bigTiff && (pos > 0xffffffffULL) )
+      {
+         return false; // Padding pushed a classic tiff over 4GB.
+      }
+      for (ossim_uint64 i = 0; i < m_ifds.size(); ++i)
+      {
+         for (ossim_uint64 j = 0; j < m_ifds[i].entries.size(); ++j)
+         {
+            if (m_ifds[i].entries[j].tag == 324)
+            {
+               encode(m_ifds[i].entries[j], newOffsets[i]);
+            }
+         }
+      }
+
+      // Header and ghost area.
+      std::vector<char> buf;
+      const char ORDER = ( (ossim::byteOrder() == OSSIM_LITTLE_ENDIAN) != m_swap ) ? 'I' : 'M';
+      buf.push_back(ORDER);
+      buf.push_back(ORDER);
+      if (m_bigTiff)
+      {
+         put(buf, ossim_uint16(43));
+         put(buf, ossim_uint16(8));
+         put(buf, ossim_uint16(0));
+      }
+      else
+      {
+         put(buf, ossim_uint16(42));
+      }
+      putOffset(buf, m_ifds.front().position);
+      buf.insert(buf.end(), GHOST.begin(), GHOST.end());
+      out.write(&buf.front(), buf.size());
+      pos = buf.size();
+
+      // IFDs.
+      for (ossim_uint64 i = 0; i < m_ifds.size(); ++i)
+      {
+         const Ifd& ifd = m_ifds[i];
+         buf.clear();
+         if (m_bigTiff)
+         {
+            put(buf, ossim_uint64(ifd.entries.size()));
+         }
+         else
+         {
+            put(buf, ossim_uint16(ifd.entries.size()));
+         }
+         for (ossim_uint64 j = 0; j < ifd.entries.size(); ++j)
+         {
+            const Entry& e = ifd.entries[j];
+            put(buf, e.tag);
+            put(buf, e.type);
+            putOffset(buf, e.count);
+            if (e.value.size() > INLINE_SIZE)
+            {
+               putOffset(buf, e.offset);
+            }
+            else
+            {
+               buf.insert(buf.end(), e.value.begin(), e.value.end());
+               buf.insert(buf.end(), INLINE_SIZE - e.value.size(), 0);
+            }
+         }
+         putOffset( buf, (i + 1 < m_ifds.size()) ? m_ifds[i + 1].position : 0 );
+
+         pad(out, pos, ifd.position);
+         out.write(&buf.front(), buf.size());
+         pos += buf.size();
+
+         for (ossim_uint64 j = 0; j < ifd.entries.size(); ++j)
+         {
+            const Entry& e = ifd.entries[j];
+            if (e.value.size() > INLINE_SIZE)
+            {
+               pad(out, pos, e.offset);
+               out.write(&e.value.front(), e.value.size());
+               pos += e.value.size();
+            }
+         }
+      }
+
+      // Tile data.
+      std::vector<char> tile;
+      for (ossim_uint64 i = m_ifds.size(); i > 0; --i)
+      {
+         const Ifd& ifd = m_ifds[i - 1];
+         for (ossim_uint64 t = 0; t < ifd.tileOffsets.size(); ++t)
+         {
+            const ossim_uint64 SIZE = ifd.tileByteCounts[t];
+            if (SIZE)
+            {
+               tile.resize(SIZE);
+               in.seekg(ifd.tileOffsets[t]);
+               in.read(&tile.front(), SIZE);
+               if ( !in.good() )
+               {
+                  return false;
+               }
+               pad(out, pos, newOffsets[i - 1][t]);
+               out.write(&tile.front(), SIZE);
+               pos += SIZE;
+            }
+         }
+      }
+
+      return out.good();
+   }
+
+   /** Completion count of one batch of tile compression jobs. */
+   class ossimTiffCompressBatch : public ossimReferenced
+   {
+   public:
+      ossimTiffCompressBatch(ossim_uint32 count)
+         : m_count(count)
+      {
+         if(m_count)
+         {
+            m_block.reset();
+         }
+         else
+         {
+            m_block.release();
+         }
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_count && (--m_count == 0))
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+   private:
+      OpenThreads::Mutex m_mutex;
+      OpenThreads::Block m_block;
+      ossim_uint32       m_count;
+   };
+
+   //---
+   // Compresses one band interleaved tile into the bytes libtiff's own
+   // codec would have written for it, for TIFFWriteRawTile.  JPEG tiles are
+   // complete interchange streams (no JPEGTables), coded in the tiff's
+   // photometric like libtiff does: no JFIF or Adobe marker, no color
+   // conversion, no subsampling.
+   //---
+   class ossimTiffCompressJob : public ossimJob
+   {
+   public:
+      ossimTiffCompressJob(ossim_uint16 compression,
+                           ossim_uint32 tile,
+                           const ossim_uint8* buf,
+                           ossim_uint32 size,
+                           ossim_uint32 width,
+                           ossim_uint32 height,
+                           ossim_uint32 bands,
+                           ossim_int32 quality,
+                           ossimTiffCompressBatch* batch)
+         : m_compression(compression),
+           m_tile(tile),
+           m_input(buf, buf + size),
+           m_output(),
+           m_width(width),
+           m_height(height),
+           m_bands(bands),
+           m_quality(quality),
+           m_status(false),
+           m_batch(batch)
+      {
+         setName("ossimTiffWriter.compress");
+      }
+      virtual void start()
+      {
+         if ( m_compression == COMPRESSION_JPEG )
+         {
+            m_status = compressJpeg();
+         }
+#if OSSIM_HAS_LIBZ
+         else if ( m_compression == COMPRESSION_DEFLATE )
+         {
+            uLongf size = compressBound(m_input.size());
+            m_output.resize(size);
+            m_status = ( compress2(&m_output.front(), &size, &m_input.front(),
+                                   m_input.size(), Z_DEFAULT_COMPRESSION) == Z_OK );
+            m_output.resize(size);
+         }
+#endif
+         // Done with the pixels; the batch may wait on many jobs.
+         std::vector<ossim_uint8>().swap(m_input);
+         m_batch->done();
+      }
+      ossim_uint32 getTile() const { return m_tile; }
+      bool getStatus() const { return m_status; }
+      std::vector<ossim_uint8>& getOutput() { return m_output; }
+   private:
+      bool compressJpeg()
+      {
+         std::ostringstream jpegStreamBuf;
+         struct jpeg_compress_struct cinfo;
+         struct jpeg_error_mgr jerr;
+         cinfo.err = jpeg_std_error( &jerr );
+         jpeg_create_compress( &cinfo );
+         jpeg_cpp_stream_dest( &cinfo, jpegStreamBuf );
+
+         cinfo.image_width      = m_width;
+         cinfo.image_height     = m_height;
+         cinfo.input_components = m_bands;
+         cinfo.in_color_space   = (m_bands == 3) ? JCS_RGB : JCS_GRAYSCALE;
+         jpeg_set_defaults( &cinfo );
+         jpeg_set_colorspace( &cinfo, cinfo.in_color_space );
+         jpeg_set_quality( &cinfo, m_quality, TRUE );
+         cinfo.write_JFIF_header  = FALSE;
+         cinfo.write_Adobe_marker = FALSE;
+
+         jpeg_start_compress( &cinfo, TRUE );
+         const ossim_uint32 LINE_SIZE = m_width * m_bands;
+         for (ossim_uint32 line = 0; line < m_height; ++line)
+         {
+            JSAMPROW row_pointer[1];
+            row_pointer[0] = (JSAMPLE*)&m_input[line * LINE_SIZE];
+            jpeg_write_scanlines( &cinfo, row_pointer, 1 );
+         }
+         jpeg_finish_compress( &cinfo );
+         jpeg_destroy_compress( &cinfo );
+
+         const std::string& out = jpegStreamBuf.str();
+         m_output.assign(out.begin(), out.end());
+         return !m_output.empty();
+      }
+
+      ossim_uint16                        m_compression;
+      ossim_uint32                        m_tile;
+      std::vector<ossim_uint8>            m_input;
+      std::vector<ossim_uint8>            m_output;
+      ossim_uint32                        m_width;
+      ossim_uint32                        m_height;
+      ossim_uint32                        m_bands;
+      ossim_int32                         m_quality;
+      bool                                m_status;
+      ossimRefPtr<ossimTiffCompressBatch> m_batch;
+   };
+
+   bool lessTile(const ossimRefPtr<ossimTiffCompressJob>& a,
+                 const ossimRefPtr<ossimTiffCompressJob>& b)
+   {
+      return a->getTile() < b->getTile();
+   }
+
+   //---
+   // @return The compression of tif if its tiles can be compressed by
+   // ossimTiffCompressJob, else COMPRESSION_NONE: deflate (with zlib) of any
+   // pixel type without a predictor, jpeg of eight bit grey or rgb.
+   //---
+   ossim_uint16 jobCompression(TIFF* tif)
+   {
+      ossim_uint16 compression = COMPRESSION_NONE;
+      ossim_uint16 photometric = PHOTOMETRIC_MINISBLACK;
+      ossim_uint16 bits        = 0;
+      ossim_uint16 samples     = 0;
+      ossim_uint16 predictor   = PREDICTOR_NONE;
+      TIFFGetField(tif, TIFFTAG_COMPRESSION, &compression);
+      TIFFGetField(tif, TIFFTAG_PHOTOMETRIC, &photometric);
+      TIFFGetField(tif, TIFFTAG_BITSPERSAMPLE, &bits);
+      TIFFGetField(tif, TIFFTAG_SAMPLESPERPIXEL, &samples);
+      if ( photometric == PHOTOMETRIC_PALETTE )
+      {
+         return COMPRESSION_NONE;
+      }
+#if OSSIM_HAS_LIBZ
+      if ( compression == COMPRESSION_DEFLATE )
+      {
+         TIFFGetField(tif, TIFFTAG_PREDICTOR, &predictor);
+         return (predictor == PREDICTOR_NONE) ? compression : COMPRESSION_NONE;
+      }
+#endif
+      if ( (compression == COMPRESSION_JPEG) && (bits == 8) &&
+           ( ((samples == 3) && (photometric == PHOTOMETRIC_RGB)) ||
+             ((samples == 1) && (photometric == PHOTOMETRIC_MINISBLACK)) ) )
+      {
+         return compression;
+      }
+      return COMPRESSION_NONE;
+   }
+
+   //---
+   // Waits for the jobs of batch and writes their tiles raw, in tile order,
+   // libtiff recording each tile's offset and byte count.
+   //---
+   bool writeCompressedTiles(TIFF* tif,
+                             ossimTiffCompressBatch* batch,
+                             std::vector< ossimRefPtr<ossimTiffCompressJob> >& jobs)
+   {
+      batch->wait();
+      ossimTimeline::Span span("ossimTiffWriter flush", "writer");
+      std::sort(jobs.begin(), jobs.end(), lessTile);
+      for (ossim_uint32 i = 0; i < jobs.size(); ++i)
+      {
+         std::vector<ossim_uint8>& data = jobs[i]->getOutput();
+         if ( !jobs[i]->getStatus() ||
+              (TIFFWriteRawTile(tif, jobs[i]->getTile(), &data.front(), data.size()) !=
+               (tsize_t)data.size()) )
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
+} // End: anonymous namespace
+
 #ifdef OSSIM_ID_ENABLED
 static const char OSSIM_ID[] = "$Id: ossimTiffWriter.cpp 22942 2014-11-02 20:39:27Z gpotts $";
 #endif
@@ -69,8 +748,15 @@ ossimTiffWriter::ossimTiffWriter()
       theProjectionInfo(NULL),
       theOutputTileSize(OSSIM_DEFAULT_TILE_WIDTH, OSSIM_DEFAULT_TILE_HEIGHT),
       theForceBigTiffFlag(false),
-      theBigTiffFlag(false)
+      theBigTiffFlag(false),
+      theCompressionThreads(1)
 {
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("tiff_writer.compression_threads");
+   if (lookup)
+   {
+      theCompressionThreads = ossimString(lookup).toUInt32();
+   }
    theColorLut = new ossimNBandLutDataObject();
    ossim::defaultTileSize(theOutputTileSize);
    theOutputImageType = "tiff_tiled_band_separate";
@@ -256,6 +942,7 @@ Call setFilename method.\n",
    // Set the planar configuration.
    if ( (theOutputImageType == "tiff_strip") ||
         (theOutputImageType == "tiff_tiled") ||
+        (theOutputImageType == "tiff_tiled_cog") ||
         (theOutputImageType == "image/tiff") ||
         (theOutputImageType == "image/tif") ||
         (theOutputImageType == "image/gtif") ||
@@ -446,6 +1133,11 @@ bool ossimTiffWriter::writeFile()
 
    if (traceDebug()) CLOG << "Entered..." << std::endl;
 
+   if (theOutputImageType == "tiff_tiled_cog")
+   {
+      return writeCogFile();
+   }
+
    //checkColorLut();
 
    if(isLutEnabled())
@@ -650,6 +1342,76 @@ bool ossimTiffWriter::writeFile()
    return status;
 }
 
+bool ossimTiffWriter::writeCogFile()
+{
+   static const char MODULE[] = "ossimTiffWriter::writeCogFile";
+
+   const ossimFilename OUTPUT_FILE = theFilename;
+   ossimFilename tempFile = theFilename;
+   tempFile += ".tmp";
+
+   // Full resolution to the temp file as a plain contiguous tiled tiff.
+   theFilename = tempFile;
+   theOutputImageType = "tiff_tiled";
+   bool status = writeFile();
+   theFilename = OUTPUT_FILE;
+   theOutputImageType = "tiff_tiled_cog";
+
+   // Slaves only helped with r0; the rest is done by the master.
+   if ( theInputConnection.valid() && !theInputConnection->isMaster() )
+   {
+      return status;
+   }
+
+   // Add the reduced resolution sets as internal overviews.
+   if (status)
+   {
+      ossimRefPtr<ossimImageHandler> ih = new ossimTiffTileSource();
+      status = ih->open(tempFile);
+      if (status)
+      {
+         ossimRefPtr<ossimTiffOverviewBuilder> builder = new ossimTiffOverviewBuilder();
+         builder->setInternalOverviewsFlag(true);
+         builder->setOutputTileSize(theOutputTileSize);
+         builder->setCompressionType(tiffCompression(theCompressionType));
+         if (tiffCompression(theCompressionType) == COMPRESSION_JPEG)
+         {
+            builder->setJpegCompressionQuality(theJpegQuality);
+         }
+         status = builder->setInputSource(ih.get()) && builder->execute();
+      }
+      ih->close();
+   }
+
+   // Rewrite with the IFDs up front and the tile data smallest level first.
+   if (status)
+   {
+      std::ifstream in(tempFile.c_str(), std::ios::in | std::ios::binary);
+      std::ofstream out(OUTPUT_FILE.c_str(),
+                        std::ios::out | std::ios::binary | std::ios::trunc);
+      ossimTiffLayout layout;
+      status = in.good() && out.good() && layout.read(in) && layout.write(in, out);
+      out.close();
+      status = status && !out.fail();
+   }
+
+   if ( tempFile.exists() )
+   {
+      ossimFilename::remove(tempFile);
+   }
+
+   if (!status)
+   {
+      setErrorStatus(); // base class
+      ossimNotify(ossimNotifyLevel_WARN)
+         << MODULE << " ERROR:"
+         << "\nError writing cloud optimized geotiff:  " << OUTPUT_FILE
+         << std::endl;
+   }
+
+   return status;
+}
+
 void ossimTiffWriter::setLut(const ossimNBandLutDataObject& lut)
 {
    theColorLutFlag = true;
@@ -802,6 +1564,7 @@ bool ossimTiffWriter::loadState(const ossimKeywordlist& kwl,
                                       prefix))
    {
       if((theOutputImageType!="tiff_tiled") &&
+         (theOutputImageType!="tiff_tiled_cog") &&
          (theOutputImageType!="tiff_tiled_band_separate") &&
          (theOutputImageType!="tiff_strip") &&
          (theOutputImageType!="tiff_strip_band_separate")&&
@@ -825,6 +1588,7 @@ bool ossimTiffWriter::loadState(const ossimKeywordlist& kwl,
 bool ossimTiffWriter::isTiled() const
 {
    return ( theOutputImageType == "tiff_tiled" ||
+            theOutputImageType == "tiff_tiled_cog" ||
             theOutputImageType == "image/tiff" ||
             theOutputImageType == "image/tif" ||
             theOutputImageType == "image/gtif" ||
@@ -839,8 +1603,19 @@ bool ossimTiffWriter::writeToTiles()
 
    if (traceDebug()) CLOG << " Entered." << std::endl;
 
-   // Start the sequence at the first tile.
+   if ( (theCompressionThreads > 1) && !theColorLutFlag &&
+        (jobCompression(tiffPtr) != COMPRESSION_NONE) )
+   {
+      return writeToTilesCompressed();
+   }
+
+   //---
+   // Tiles are placed by their rectangle below, so a threaded sequencer may hand them out in
+   // the order they finish. Start the sequence at the first tile.
+   //---
+   theInputConnection->setOrderedOutput(false);
    theInputConnection->setToStartOfSequence();
+   const ossimIpt AOI_UL = theInputConnection->getAreaOfInterest().ul();
 
    ossimRefPtr<ossimImageData> tempTile = 0;
 
@@ -868,14 +1643,9 @@ bool ossimTiffWriter::writeToTiles()
    vector<ossim_float64> maxBands;
    for(ossim_uint32 i = 0; ((i < tilesHigh)&&!needsAborting()); i++)
    {
-      ossimIpt origin(0,0);
-      origin.y = i * tileHeight;
-
       // Tile loop in the sample (width) direction.
       for(ossim_uint32 j = 0; ((j < tilesWide)&&!needsAborting()); j++)
       {
-         origin.x = j * tileWidth;
-
          // Grab the tile.
          ossimRefPtr<ossimImageData> id = theInputConnection->getNextTile();
          if (!id)
@@ -885,8 +1655,10 @@ bool ossimTiffWriter::writeToTiles()
                << "Error returned writing tiff tile:  " << tileNumber
                << "\nNULL Tile encountered"
                << std::endl;
+            theInputConnection->setOrderedOutput(true);
             return false;
          }
+         ossimIpt origin = id->getImageRectangle().ul() - AOI_UL;
 
          ossimDataObjectStatus  tileStatus      = id->getDataObjectStatus();
          ossim_uint32           tileSizeInBytes = id->getSizeInBytes();
@@ -914,6 +1686,7 @@ bool ossimTiffWriter::writeToTiles()
          // Write the tile to disk.
          //---
          ossim_uint32 bytesWritten = 0;
+         ossimTimeline::Span span("TIFFWriteTile", "writer");
          bytesWritten = TIFFWriteTile(tiffPtr,
                                       tempTile->getBuf(),
                                       origin.x,
@@ -933,6 +1706,7 @@ bool ossimTiffWriter::writeToTiles()
                   << std::endl;
             }
             setErrorStatus();
+            theInputConnection->setOrderedOutput(true);
             return false;
          }
 
@@ -946,6 +1720,8 @@ bool ossimTiffWriter::writeToTiles()
 
    } // End of tile loop in the line (height) direction.
 
+   theInputConnection->setOrderedOutput(true);
+
    if(!theColorLutFlag&&!needsAborting())
    {
       writeMinMaxTags(minBands, maxBands);
@@ -956,6 +1732,141 @@ bool ossimTiffWriter::writeToTiles()
    return true;
 }
 
+bool ossimTiffWriter::writeToTilesCompressed()
+{
+   static const char* const MODULE = "ossimTiffWriter::writeToTilesCompressed";
+   TIFF* tiffPtr = (TIFF*)theTif;
+
+   if (traceDebug()) CLOG << " Entered." << std::endl;
+
+   theInputConnection->setOrderedOutput(false);
+   theInputConnection->setToStartOfSequence();
+   const ossimIpt AOI_UL = theInputConnection->getAreaOfInterest().ul();
+
+   ossimRefPtr<ossimImageData> tempTile =
+      ossimImageDataFactory::instance()->create(this, theInputConnection.get());
+   if ( !tempTile.valid() )
+   {
+      theInputConnection->setOrderedOutput(true);
+      return false;
+   }
+   tempTile->initialize();
+
+   const ossim_uint16 COMPRESSION     = jobCompression(tiffPtr);
+   const ossim_uint32 NUMBER_OF_TILES = theInputConnection->getNumberOfTiles();
+   const ossim_uint32 BATCH           = 4 * theCompressionThreads;
+   ossimRefPtr<ossimJobMultiThreadQueue> queue =
+      new ossimJobMultiThreadQueue(0, theCompressionThreads);
+
+   //---
+   // Each batch of tiles is read and queued while the previous one
+   // compresses, then the previous one is written.
+   //---
+   std::vector< ossimRefPtr<ossimTiffCompressJob> > pendingJobs;
+   ossimRefPtr<ossimTiffCompressBatch> pendingBatch = 0;
+   ossim_uint32 tileNumber = 0;
+   vector<ossim_float64> minBands;
+   vector<ossim_float64> maxBands;
+   bool status = true;
+
+   while ( status && (tileNumber < NUMBER_OF_TILES) && !needsAborting() )
+   {
+      const ossim_uint32 COUNT = std::min(BATCH, NUMBER_OF_TILES - tileNumber);
+      ossimRefPtr<ossimTiffCompressBatch> batch = new ossimTiffCompressBatch(COUNT);
+      std::vector< ossimRefPtr<ossimTiffCompressJob> > jobs;
+      for (ossim_uint32 i = 0; i < COUNT; ++i)
+      {
+         ossimRefPtr<ossimImageData> id = theInputConnection->getNextTile();
+         if (!id)
+         {
+            ossimNotify(ossimNotifyLevel_WARN)
+               << MODULE << " ERROR:"
+               << "Error returned writing tiff tile:  " << (tileNumber + i)
+               << "\nNULL Tile encountered"
+               << std::endl;
+            status = false;
+            for (ossim_uint32 j = i; j < COUNT; ++j)
+            {
+               batch->done();
+            }
+            break;
+         }
+         ossimIpt origin = id->getImageRectangle().ul() - AOI_UL;
+
+         ossimDataObjectStatus tileStatus = id->getDataObjectStatus();
+         if (tileStatus != OSSIM_FULL)
+         {
+            tempTile->setImageRectangle(id->getImageRectangle());
+            tempTile->makeBlank();
+         }
+         if ((tileStatus == OSSIM_PARTIAL || tileStatus == OSSIM_FULL))
+         {
+            id->unloadTile(tempTile->getBuf(), id->getImageRectangle(), OSSIM_BIP);
+            id->computeMinMaxPix(minBands, maxBands);
+         }
+
+         ossimRefPtr<ossimTiffCompressJob> job =
+            new ossimTiffCompressJob(COMPRESSION,
+                                     TIFFComputeTile(tiffPtr, origin.x, origin.y, 0, 0),
+                                     (const ossim_uint8*)tempTile->getBuf(),
+                                     tempTile->getSizeInBytes(),
+                                     tempTile->getWidth(),
+                                     tempTile->getHeight(),
+                                     tempTile->getNumberOfBands(),
+                                     theJpegQuality,
+                                     batch.get());
+         jobs.push_back(job);
+         queue->getJobQueue()->add(job.get(), false);
+      }
+
+      if ( pendingBatch.valid() &&
+           !writeCompressedTiles(tiffPtr, pendingBatch.get(), pendingJobs) )
+      {
+         status = false;
+      }
+      if ( status )
+      {
+         setPercentComplete(100.0 * tileNumber / NUMBER_OF_TILES);
+      }
+      pendingJobs.swap(jobs);
+      pendingBatch = batch;
+      tileNumber += COUNT;
+   }
+
+   if ( pendingBatch.valid() )
+   {
+      if ( status && !needsAborting() )
+      {
+         status = writeCompressedTiles(tiffPtr, pendingBatch.get(), pendingJobs);
+      }
+      else
+      {
+         pendingBatch->wait();
+      }
+   }
+   if ( !status )
+   {
+      if (traceDebug())
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << MODULE << " ERROR: compressing or writing tiles" << std::endl;
+      }
+      setErrorStatus();
+   }
+
+   theInputConnection->setOrderedOutput(true);
+
+   if ( status && !needsAborting() )
+   {
+      setPercentComplete(100.0);
+      writeMinMaxTags(minBands, maxBands);
+   }
+
+   if (traceDebug()) CLOG << " Exited." << std::endl;
+
+   return status;
+}
+
 bool ossimTiffWriter::writeToTilesBandSep()
 {
    static const char* const MODULE = "ossimTiffWriter::writeToTilesBandSep";
@@ -1029,6 +1940,7 @@ bool ossimTiffWriter::writeToTilesBandSep()
             tsize_t bytesWritten = 0;
             if(data)
             {
+               ossimTimeline::Span span("TIFFWriteTile", "writer");
                bytesWritten = TIFFWriteTile(tiffPtr,
                                             data,
                                             (ossim_uint32)origin.x,
@@ -1624,6 +2536,7 @@ void ossimTiffWriter::getImageTypeList(std::vector<ossimString>& imageTypeList)c
    imageTypeList.push_back(ossimString("tiff_strip_band_separate"));
    imageTypeList.push_back(ossimString("tiff_tiled"));
    imageTypeList.push_back(ossimString("tiff_tiled_band_separate"));
+   imageTypeList.push_back(ossimString("tiff_tiled_cog"));
 }
 
 ossimString ossimTiffWriter::getExtension() const
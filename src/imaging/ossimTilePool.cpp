@@ -0,0 +1,333 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Size-class pool of recycled tile buffers used by ossimImageData.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/imaging/ossimTilePool.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/parallel/ossimThreadAffinity.h>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <iostream>
+
+static const ossim_uint64 DEFAULT_POOL_SIZE = 64 * 1024 * 1024; // bytes
+static const ossim_uint32 MIN_STRIPES = 4;
+static const ossim_uint32 MAX_STRIPES = 64;
+
+ossimTilePool* ossimTilePool::m_instance = 0;
+
+ossimTilePool::Statistics::Statistics()
+   : m_hits(0),
+     m_misses(0),
+     m_returns(0),
+     m_rejects(0),
+     m_bytesHeld(0),
+     m_buffersHeld(0)
+{
+}
+
+bool ossimTilePool::Key::operator<(const Key& rhs) const
+{
+   if (m_scalar != rhs.m_scalar) return (m_scalar < rhs.m_scalar);
+   if (m_bands  != rhs.m_bands)  return (m_bands  < rhs.m_bands);
+   if (m_width  != rhs.m_width)  return (m_width  < rhs.m_width);
+   return (m_height < rhs.m_height);
+}
+
+ossimTilePool::Stripe::Stripe()
+   : m_mutex(),
+     m_freeLists(),
+     m_bytesHeld(0),
+     m_buffersHeld(0),
+     m_hits(0),
+     m_misses(0),
+     m_returns(0),
+     m_rejects(0)
+{
+}
+
+ossimTilePool::Stripe::~Stripe()
+{
+   clear();
+}
+
+bool ossimTilePool::Stripe::pop(const Key& key, std::vector<ossim_uint8>& buffer)
+{
+   bool result = false;
+   FreeListMap::iterator i = m_freeLists.find(key);
+   if ( (i != m_freeLists.end()) && (i->second.size() > 0) )
+   {
+      std::vector<ossim_uint8>* pooled = i->second.back();
+      i->second.pop_back();
+      m_bytesHeld -= pooled->size();
+      --m_buffersHeld;
+      buffer.swap(*pooled);
+      delete pooled;
+      result = true;
+   }
+   return result;
+}
+
+void ossimTilePool::Stripe::trim(ossim_uint64 maxBytes)
+{
+   // Free from the largest size classes first; they are the most expensive to hold.
+   FreeListMap::reverse_iterator i = m_freeLists.rbegin();
+   while ( (m_bytesHeld > maxBytes) && (i != m_freeLists.rend()) )
+   {
+      while ( (m_bytesHeld > maxBytes) && (i->second.size() > 0) )
+      {
+         m_bytesHeld -= i->second.back()->size();
+         --m_buffersHeld;
+         delete i->second.back();
+         i->second.pop_back();
+      }
+      ++i;
+   }
+}
+
+void ossimTilePool::Stripe::clear()
+{
+   FreeListMap::iterator i = m_freeLists.begin();
+   while (i != m_freeLists.end())
+   {
+      for (ossim_uint32 idx = 0; idx < i->second.size(); ++idx)
+      {
+         delete i->second[idx];
+      }
+      ++i;
+   }
+   m_freeLists.clear();
+   m_bytesHeld   = 0;
+   m_buffersHeld = 0;
+}
+
+ossimTilePool* ossimTilePool::instance()
+{
+   static OpenThreads::Mutex instanceMutex;
+   if (!m_instance)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(instanceMutex);
+      if (!m_instance)
+      {
+         m_instance = new ossimTilePool();
+      }
+   }
+   return m_instance;
+}
+
+ossimTilePool::ossimTilePool()
+   : m_stripes(),
+     m_numberOfNodes(1),
+     m_enabled(true),
+     m_maxBytes(DEFAULT_POOL_SIZE)
+{
+   ossim_uint32 stripes = ossim::getNumberOfThreads();
+   if (stripes < MIN_STRIPES) stripes = MIN_STRIPES;
+   if (stripes > MAX_STRIPES) stripes = MAX_STRIPES;
+
+   // Stripe i belongs to NUMA node i % nodes, so every node needs the same number of stripes.
+   m_numberOfNodes = ossimThreadAffinity::instance()->getNumberOfNodes();
+   if (m_numberOfNodes > stripes) m_numberOfNodes = 1; // More nodes than stripes; ignore nodes.
+   stripes = ((stripes + m_numberOfNodes - 1) / m_numberOfNodes) * m_numberOfNodes;
+   for (ossim_uint32 i = 0; i < stripes; ++i)
+   {
+      m_stripes.push_back(new Stripe());
+   }
+
+   const char* lookup = ossimPreferences::instance()->findPreference("tile_pool.enabled");
+   if (lookup)
+   {
+      m_enabled = ossimString(lookup).toBool();
+   }
+   lookup = ossimPreferences::instance()->findPreference("tile_pool.size");
+   if (lookup)
+   {
+      m_maxBytes = ossimString(lookup).toUInt64() * 1024 * 1024;
+   }
+}
+
+ossimTilePool::~ossimTilePool()
+{
+   for (ossim_uint32 i = 0; i < m_stripes.size(); ++i)
+   {
+      delete m_stripes[i];
+   }
+   m_stripes.clear();
+}
+
+bool ossimTilePool::acquire(ossimScalarType scalar,
+                            ossim_uint32 bands,
+                            ossim_uint32 width,
+                            ossim_uint32 height,
+                            std::vector<ossim_uint8>& buffer)
+{
+   if (!m_enabled)
+   {
+      return false;
+   }
+
+   const Key key(scalar, bands, width, height);
+   const ossim_uint32 home = stripeIndex();
+   const ossim_uint32 count = (ossim_uint32)m_stripes.size();
+
+   //---
+   // Own stripe first, then steal from the others so buffers released by a different thread
+   // than the one requesting still get reused.  Stripes of our own NUMA node (those at a
+   // multiple of the node count from home) are tried before remote ones:
+   //---
+   for (ossim_uint32 pass = 0; pass < 2; ++pass)
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         if ( ((i % m_numberOfNodes) == 0) != (pass == 0) )
+         {
+            continue;
+         }
+         Stripe* stripe = m_stripes[(home + i) % count];
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(stripe->m_mutex);
+         if (stripe->pop(key, buffer))
+         {
+            ++stripe->m_hits;
+            return true;
+         }
+      }
+   }
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_stripes[home]->m_mutex);
+   ++m_stripes[home]->m_misses;
+   return false;
+}
+
+bool ossimTilePool::release(ossimScalarType scalar,
+                            ossim_uint32 bands,
+                            ossim_uint32 width,
+                            ossim_uint32 height,
+                            std::vector<ossim_uint8>& buffer)
+{
+   const ossim_uint64 bytes = buffer.size();
+   if ( !bytes )
+   {
+      return false;
+   }
+
+   Stripe* stripe = m_stripes[stripeIndex()];
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(stripe->m_mutex);
+
+   const ossim_uint64 expected = (ossim_uint64)ossim::scalarSizeInBytes(scalar) *
+                                 bands * width * height;
+   if ( !m_enabled || (bytes != expected) || (stripe->m_bytesHeld + bytes > stripeBudget()) )
+   {
+      ++stripe->m_rejects;
+      return false;
+   }
+
+   std::vector<ossim_uint8>* pooled = new std::vector<ossim_uint8>();
+   pooled->swap(buffer);
+   stripe->m_freeLists[Key(scalar, bands, width, height)].push_back(pooled);
+   stripe->m_bytesHeld += bytes;
+   ++stripe->m_buffersHeld;
+   ++stripe->m_returns;
+   return true;
+}
+
+void ossimTilePool::clear()
+{
+   for (ossim_uint32 i = 0; i < m_stripes.size(); ++i)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_stripes[i]->m_mutex);
+      m_stripes[i]->clear();
+   }
+}
+
+void ossimTilePool::setEnabled(bool flag)
+{
+   m_enabled = flag;
+   if (!m_enabled)
+   {
+      clear();
+   }
+}
+
+void ossimTilePool::setMaxBytes(ossim_uint64 maxBytes)
+{
+   m_maxBytes = maxBytes;
+   const ossim_uint64 budget = stripeBudget();
+   for (ossim_uint32 i = 0; i < m_stripes.size(); ++i)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_stripes[i]->m_mutex);
+      m_stripes[i]->trim(budget);
+   }
+}
+
+ossimTilePool::Statistics ossimTilePool::getStatistics() const
+{
+   Statistics stats;
+   for (ossim_uint32 i = 0; i < m_stripes.size(); ++i)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_stripes[i]->m_mutex);
+      stats.m_hits        += m_stripes[i]->m_hits;
+      stats.m_misses      += m_stripes[i]->m_misses;
+      stats.m_returns     += m_stripes[i]->m_returns;
+      stats.m_rejects     += m_stripes[i]->m_rejects;
+      stats.m_bytesHeld   += m_stripes[i]->m_bytesHeld;
+      stats.m_buffersHeld += m_stripes[i]->m_buffersHeld;
+   }
+   return stats;
+}
+
+void ossimTilePool::resetStatistics()
+{
+   for (ossim_uint32 i = 0; i < m_stripes.size(); ++i)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_stripes[i]->m_mutex);
+      m_stripes[i]->m_hits    = 0;
+      m_stripes[i]->m_misses  = 0;
+      m_stripes[i]->m_returns = 0;
+      m_stripes[i]->m_rejects = 0;
+   }
+}
+
+std::ostream& ossimTilePool::print(std::ostream& out) const
+{
+   Statistics stats = getStatistics();
+   out << "ossimTilePool:"
+       << "\nenabled:      " << (m_enabled ? "true" : "false")
+       << "\nstripes:      " << m_stripes.size()
+       << "\nmax_bytes:    " << m_maxBytes
+       << "\nbytes_held:   " << stats.m_bytesHeld
+       << "\nbuffers_held: " << stats.m_buffersHeld
+       << "\nhits:         " << stats.m_hits
+       << "\nmisses:       " << stats.m_misses
+       << "\nreturns:      " << stats.m_returns
+       << "\nrejects:      " << stats.m_rejects
+       << std::endl;
+   return out;
+}
+
+ossim_uint32 ossimTilePool::stripeIndex() const
+{
+   // Threads not created through OpenThreads (e.g. the main thread) all map to stripe 0.
+   ossim_uint64 id = (ossim_uint64)(size_t)OpenThreads::Thread::CurrentThread();
+   id ^= (id >> 17);
+   id *= 0x9E3779B97F4A7C15ULL;
+   if (m_numberOfNodes > 1)
+   {
+      // A stripe of the node the thread runs on.
+      const ossim_uint32 node = ossimThreadAffinity::instance()->getCurrentNode() % m_numberOfNodes;
+      const ossim_uint32 perNode = (ossim_uint32)m_stripes.size() / m_numberOfNodes;
+      return (ossim_uint32)((id >> 32) % perNode) * m_numberOfNodes + node;
+   }
+   return (ossim_uint32)((id >> 32) % m_stripes.size());
+}
+
+ossim_uint64 ossimTilePool::stripeBudget() const
+{
+   return m_maxBytes / m_stripes.size();
+}
@@ -304,14 +304,8 @@ bool ossimTilingPoly::parseShpFile()
                if (annoPoly != 0)
                {
                   result = true;
-                  std::vector<ossimGpt> polygon;
-
                   //get the points of a polygon
-                  std::vector<ossimGpt> points = annoPoly->getPoints();
-                  for (ossim_uint32 i = 0; i < points.size(); i++)
-                  {
-                     polygon.push_back(points[i]);
-                  }
+                  const std::vector<ossimGpt>& polygon = annoPoly->getPolygon();
 
                   //get polygon type, if it is an internal polygon, initialize the internal cutter
                   ossimGeoAnnotationPolyObject::ossimPolyType polyType = annoPoly->getPolyType();
@@ -73,39 +73,6 @@ ossimObject* ossimU11ImageData::dup()const
    return new ossimU11ImageData(*this);
 }
 
-ossimDataObjectStatus ossimU11ImageData::validate() const
-{
-   if (m_dataBuffer.size() == 0)
-   {
-      setDataObjectStatus(OSSIM_NULL);
-      return OSSIM_NULL;
-   }
-   
-   ossim_uint32 count = 0;
-   const ossim_uint32 SIZE = getSize();
-   const ossim_uint32 BOUNDS = getSizePerBand();
-   const ossim_uint32 NUMBER_OF_BANDS = getNumberOfBands();
-   
-   for(ossim_uint32 band = 0; band < NUMBER_OF_BANDS; ++band)
-   {
-      const ossim_uint16* p  = getUshortBuf(band);
-      for (ossim_uint32 i=0; i<BOUNDS; ++i)
-      {
-         // check if the band is null
-         if (p[i] != 0) ++count;         
-      }
-   }
-   
-   if (!count)
-      setDataObjectStatus(OSSIM_EMPTY);
-   else if (count == SIZE)
-      setDataObjectStatus(OSSIM_FULL);
-   else
-      setDataObjectStatus(OSSIM_PARTIAL);
-
-   return getDataObjectStatus();
-}
-
 void ossimU11ImageData::getNormalizedFloat(ossim_uint32 offset,
                                            ossim_uint32 bandNumber,
                                            float& result)const
@@ -313,7 +280,7 @@ double ossimU11ImageData::computeAverageBandValue(ossim_uint32 bandNumber)
 
 void ossimU11ImageData::setValue(long x, long y, double color)
 {
-   if(m_dataBuffer.size() > 0 && isWithin(x, y))
+   if(getBufferSizeInBytes() > 0 && isWithin(x, y))
    {
       //***
       // Compute the offset into the buffer for (x,y).  This should always
@@ -324,7 +291,7 @@ void ossimU11ImageData::setValue(long x, long y, double color)
       
       ossim_uint32 offset = uy * m_spatialExtents[0] + ux;
       
-      for(ossim_uint32 band = 0; offset < m_dataBuffer.size() && // prevent buffer overrun
+      for(ossim_uint32 band = 0; offset < getBufferSizeInBytes() && // prevent buffer overrun
                                  band < m_numberOfDataComponents; band++)
       {
          ossim_uint16* buf = getUshortBuf(band)+offset;
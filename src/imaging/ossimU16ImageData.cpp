@@ -68,39 +68,6 @@ ossimObject* ossimU16ImageData::dup()const
    return new ossimU16ImageData(*this);
 }
 
-ossimDataObjectStatus ossimU16ImageData::validate() const
-{
-   if (getBuf() == NULL)
-   {
-      setDataObjectStatus(OSSIM_NULL);
-      return OSSIM_NULL;
-   }
-   
-   ossim_uint32 count = 0;
-   const ossim_uint32 SIZE = getSize();
-   const ossim_uint32 BOUNDS = getSizePerBand();
-   const ossim_uint32 NUMBER_OF_BANDS = getNumberOfBands();
-   
-   for(ossim_uint32 band = 0; band < NUMBER_OF_BANDS; ++band)
-   {
-      const ossim_uint16* p  = getUshortBuf(band);
-      for (ossim_uint32 i=0; i<BOUNDS; i++)
-      {
-         // check if the band is null
-         if (p[i] != 0) count++;         
-      }
-   }
-   
-   if (!count)
-      setDataObjectStatus(OSSIM_EMPTY);
-   else if (count == SIZE)
-      setDataObjectStatus(OSSIM_FULL);
-   else
-      setDataObjectStatus(OSSIM_PARTIAL);
-
-   return getDataObjectStatus();
-}
-
 void ossimU16ImageData::getNormalizedFloat(ossim_uint32 offset,
                                            ossim_uint32 bandNumber,
                                            float& result)const
@@ -69,40 +69,6 @@ void ossimU8ImageData::fill(double value)
    ossimImageData::fill(value);
 }
 
-ossimDataObjectStatus ossimU8ImageData::validate() const
-{
-   if (m_dataBuffer.size() == 0)
-   {
-      setDataObjectStatus(OSSIM_NULL);
-      return OSSIM_NULL;
-   }
-   
-   ossim_uint32 count = 0;
-   const ossim_uint32 SIZE = getSize();
-   const ossim_uint32 BOUNDS = getSizePerBand();
-   const ossim_uint32 NUMBER_OF_BANDS = getNumberOfBands();
-   
-   for(ossim_uint32 band = 0; band < NUMBER_OF_BANDS; ++band)
-   {
-      const ossim_uint8* p  = getUcharBuf(band);
-      ossim_uint8 np = (ossim_uint8)getNullPix(band);
-      for (ossim_uint32 i=0; i<BOUNDS; ++i)
-      {
-         // check if the band is null
-         if (p[i] != np) ++count;         
-      }
-   }
-   
-   if (!count)
-      setDataObjectStatus(OSSIM_EMPTY);
-   else if (count == SIZE)
-      setDataObjectStatus(OSSIM_FULL);
-   else
-      setDataObjectStatus(OSSIM_PARTIAL);
-
-   return getDataObjectStatus();
-}
-
 void ossimU8ImageData::getNormalizedFloat(ossim_uint32 offset,
                                           ossim_uint32 bandNumber,
                                           float& result)const
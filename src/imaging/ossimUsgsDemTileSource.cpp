@@ -231,32 +231,25 @@ bool ossimUsgsDemTileSource::open()
 
    if (theIsDemFlag)
    {
-      // Open up the file for reading.
-      std::ifstream is(theImageFile.c_str(),
-                       std::ios_base::in | std::ios_base::binary);
-      if (is.good())
-      {
-         // Start out with a fresh dem.
-         if (theDem) delete theDem;
-         
-         //---
-         // Set the null to -32768.  This will also be the missing data values.
-         //---
-         theNullValue = OSSIM_DEFAULT_NULL_PIX_SINT16;
-         
-         //---
-         // Read the dem.
-         // 
-         // NOTE:  This defines the missing data value.  It should be the
-         // same as null for mosaicing and min/max calculations.
-         //---
-         theDem = new ossimDemGrid(theNullValue);
-         theDem->read(is);
-         
-         is.close();
-      }
-      else
+      // Start out with a fresh dem.
+      if (theDem) delete theDem;
+      
+      //---
+      // Set the null to -32768.  This will also be the missing data values.
+      //---
+      theNullValue = OSSIM_DEFAULT_NULL_PIX_SINT16;
+      
+      //---
+      // Open the dem.  Profiles are decoded as tiles need them.
+      // 
+      // NOTE:  This defines the missing data value.  It should be the
+      // same as null for mosaicing and min/max calculations.
+      //---
+      theDem = new ossimDemGrid(theNullValue);
+      if ( !theDem->open(theImageFile) )
       {
+         delete theDem;
+         theDem = 0;
          theIsDemFlag = false;
       }
    }
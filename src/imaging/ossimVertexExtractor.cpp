@@ -14,11 +14,286 @@ using namespace std;
 #include <ossim/imaging/ossimVertexExtractor.h>
 #include <ossim/imaging/ossimImageSource.h>
 #include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/base/ossimCommon.h>
 #include <ossim/base/ossimTrace.h>
 #include <ossim/base/ossimNotifyContext.h>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <cmath>
+#include <vector>
 
 static ossimTrace traceDebug("ossimVertexExtractor:degug");
 
+namespace
+{
+   // Pixels searched beyond the edges scaled from the coarser level.
+   const ossim_int32 EDGE_MARGIN = 4;
+
+   /** Edges of each line of the area of interest at a res level. */
+   struct ossimEdgeLevel
+   {
+      ossimIrect               theBounds;
+      std::vector<ossim_int32> theLeft;  // samples, OSSIM_INT_NAN if null line
+      std::vector<ossim_int32> theRight;
+   };
+
+   /** Scans the lines of a level in groups, each taken by one thread. */
+   class ossimEdgeScan
+   {
+   public:
+      ossimEdgeScan(ossimImageSource* src,
+                    ossimImageHandler* handler,
+                    ossim_uint32 resLevel,
+                    ossimEdgeLevel& level,
+                    const ossimEdgeLevel* coarse)
+         : theSource(src),
+           theHandler(handler),
+           theResLevel(resLevel),
+           theLevel(level),
+           theCoarse(coarse),
+           theChunkHeight(ossim::max<ossim_int32>(1, src->getTileHeight())),
+           theNextLine(level.theBounds.ul().y)
+      {}
+
+      /** @return false once all lines are handed out. */
+      bool next(ossim_int32& firstLine, ossim_int32& lastLine)
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theMutex);
+         if ( theNextLine > theLevel.theBounds.lr().y )
+         {
+            return false;
+         }
+         firstLine = theNextLine;
+         lastLine  = ossim::min(theNextLine + theChunkHeight - 1, theLevel.theBounds.lr().y);
+         theNextLine = lastLine + 1;
+         return true;
+      }
+
+      /**
+       * Finds the edges of lines firstLine to lastLine, reading into tile
+       * from the handler if not NULL, else from the source.
+       */
+      void scan(ossim_int32 firstLine, ossim_int32 lastLine, ossimImageData* tile)
+      {
+         const ossim_int32 UL_X = theLevel.theBounds.ul().x;
+         const ossim_int32 LR_X = theLevel.theBounds.lr().x;
+         const ossim_int32 LINES = lastLine - firstLine + 1;
+         std::vector<bool> rescan(LINES, false);
+
+         if ( !theCoarse )
+         {
+            ossimRefPtr<ossimImageData> data =
+               read(ossimIrect(UL_X, firstLine, LR_X, lastLine), tile);
+            for (ossim_int32 y = firstLine; y <= lastLine; ++y)
+            {
+               const ossim_int32 i = y - theLevel.theBounds.ul().y;
+               theLevel.theLeft[i]  = firstValid(data.get(), y, UL_X, LR_X);
+               theLevel.theRight[i] = lastValid(data.get(), y, UL_X, LR_X);
+            }
+            return;
+         }
+
+         // Windows around the coarse edges of each line and of its neighbors:
+         std::vector<ossim_int32> leftA(LINES), leftB(LINES), rightA(LINES), rightB(LINES);
+         ossimIrect leftRect;
+         ossimIrect rightRect;
+         leftRect.makeNan();
+         rightRect.makeNan();
+         for (ossim_int32 y = firstLine; y <= lastLine; ++y)
+         {
+            const ossim_int32 j = y - firstLine;
+            const ossim_int32 i = y - theLevel.theBounds.ul().y;
+            theLevel.theLeft[i]  = OSSIM_INT_NAN;
+            theLevel.theRight[i] = OSSIM_INT_NAN;
+            leftA[j] = OSSIM_INT_NAN;
+
+            const ossim_int32 parent = y/2 - theCoarse->theBounds.ul().y;
+            const ossim_int32 last = (ossim_int32)theCoarse->theLeft.size() - 1;
+            ossim_int32 minLeft  = OSSIM_INT_NAN;
+            ossim_int32 maxLeft  = OSSIM_INT_NAN;
+            ossim_int32 minRight = OSSIM_INT_NAN;
+            ossim_int32 maxRight = OSSIM_INT_NAN;
+            for (ossim_int32 p = ossim::max(parent - 1, 0); p <= ossim::min(parent + 1, last); ++p)
+            {
+               if ( theCoarse->theLeft[p] == OSSIM_INT_NAN )
+               {
+                  continue;
+               }
+               if ( minLeft == OSSIM_INT_NAN )
+               {
+                  minLeft  = maxLeft  = theCoarse->theLeft[p];
+                  minRight = maxRight = theCoarse->theRight[p];
+               }
+               else
+               {
+                  minLeft  = ossim::min(minLeft, theCoarse->theLeft[p]);
+                  maxLeft  = ossim::max(maxLeft, theCoarse->theLeft[p]);
+                  minRight = ossim::min(minRight, theCoarse->theRight[p]);
+                  maxRight = ossim::max(maxRight, theCoarse->theRight[p]);
+               }
+            }
+            if ( minLeft == OSSIM_INT_NAN )
+            {
+               continue; // Null on the coarser level.
+            }
+            leftA[j]  = ossim::max(UL_X, 2*minLeft - EDGE_MARGIN);
+            leftB[j]  = ossim::min(LR_X, 2*maxLeft + 1 + EDGE_MARGIN);
+            rightA[j] = ossim::max(UL_X, 2*minRight - EDGE_MARGIN);
+            rightB[j] = ossim::min(LR_X, 2*maxRight + 1 + EDGE_MARGIN);
+            leftRect  = grow(leftRect, ossimIrect(leftA[j], y, leftB[j], y));
+            rightRect = grow(rightRect, ossimIrect(rightA[j], y, rightB[j], y));
+         }
+         if ( leftRect.hasNans() )
+         {
+            return;
+         }
+
+         //---
+         // An edge on the side of its window that faces outward may lie
+         // beyond it, and a window without one may have missed it: those
+         // lines are rescanned whole.  The left edges are taken before the
+         // right read, which may reuse the source's tile.
+         //---
+         ossimRefPtr<ossimImageData> data = read(leftRect, tile);
+         for (ossim_int32 j = 0; j < LINES; ++j)
+         {
+            if ( leftA[j] == OSSIM_INT_NAN )
+            {
+               continue;
+            }
+            const ossim_int32 x = firstValid(data.get(), firstLine + j, leftA[j], leftB[j]);
+            if ( (x == OSSIM_INT_NAN) || ((x == leftA[j]) && (x > UL_X)) )
+            {
+               rescan[j] = true;
+            }
+            else
+            {
+               theLevel.theLeft[firstLine + j - theLevel.theBounds.ul().y] = x;
+            }
+         }
+         data = read(rightRect, tile);
+         for (ossim_int32 j = 0; j < LINES; ++j)
+         {
+            if ( (leftA[j] == OSSIM_INT_NAN) || rescan[j] )
+            {
+               continue;
+            }
+            const ossim_int32 x = lastValid(data.get(), firstLine + j, rightA[j], rightB[j]);
+            if ( (x == OSSIM_INT_NAN) || ((x == rightB[j]) && (x < LR_X)) )
+            {
+               rescan[j] = true;
+            }
+            else
+            {
+               theLevel.theRight[firstLine + j - theLevel.theBounds.ul().y] = x;
+            }
+         }
+         for (ossim_int32 j = 0; j < LINES; ++j)
+         {
+            if ( rescan[j] )
+            {
+               const ossim_int32 y = firstLine + j;
+               const ossim_int32 i = y - theLevel.theBounds.ul().y;
+               data = read(ossimIrect(UL_X, y, LR_X, y), tile);
+               theLevel.theLeft[i]  = firstValid(data.get(), y, UL_X, LR_X);
+               theLevel.theRight[i] = lastValid(data.get(), y, UL_X, LR_X);
+            }
+         }
+      }
+
+   private:
+      ossimRefPtr<ossimImageData> read(const ossimIrect& rect, ossimImageData* tile)
+      {
+         if ( tile )
+         {
+            tile->setImageRectangle(rect);
+            return theHandler->getTile(tile, theResLevel) ? tile : 0;
+         }
+         return theSource->getTile(rect, theResLevel);
+      }
+
+      static ossimIrect grow(const ossimIrect& rect, const ossimIrect& add)
+      {
+         return rect.hasNans() ? add : rect.combine(add);
+      }
+
+      static bool isEmpty(const ossimImageData* data)
+      {
+         return ( !data || (data->getDataObjectStatus() == OSSIM_NULL) ||
+                  (data->getDataObjectStatus() == OSSIM_EMPTY) );
+      }
+
+      static ossim_int32 firstValid(const ossimImageData* data, ossim_int32 y,
+                                    ossim_int32 a, ossim_int32 b)
+      {
+         if ( !isEmpty(data) )
+         {
+            for (ossim_int32 x = a; x <= b; ++x)
+            {
+               if ( !data->isNull(ossimIpt(x, y)) )
+               {
+                  return x;
+               }
+            }
+         }
+         return OSSIM_INT_NAN;
+      }
+
+      static ossim_int32 lastValid(const ossimImageData* data, ossim_int32 y,
+                                   ossim_int32 a, ossim_int32 b)
+      {
+         if ( !isEmpty(data) )
+         {
+            for (ossim_int32 x = b; x >= a; --x)
+            {
+               if ( !data->isNull(ossimIpt(x, y)) )
+               {
+                  return x;
+               }
+            }
+         }
+         return OSSIM_INT_NAN;
+      }
+
+      ossimImageSource*     theSource;
+      ossimImageHandler*    theHandler;
+      ossim_uint32          theResLevel;
+      ossimEdgeLevel&       theLevel;
+      const ossimEdgeLevel* theCoarse;
+      ossim_int32           theChunkHeight;
+      OpenThreads::Mutex    theMutex;
+      ossim_int32           theNextLine;
+   };
+
+   class ossimEdgeScanThread : public OpenThreads::Thread
+   {
+   public:
+      ossimEdgeScanThread(ossimEdgeScan& scan, ossimImageData* tile)
+         : OpenThreads::Thread(),
+           theScan(scan),
+           theTile(tile)
+      {}
+
+      virtual void run()
+      {
+         ossim_int32 firstLine = 0;
+         ossim_int32 lastLine  = 0;
+         while ( theScan.next(firstLine, lastLine) )
+         {
+            theScan.scan(firstLine, lastLine, theTile.get());
+         }
+      }
+
+   private:
+      ossimEdgeScan&              theScan;
+      ossimRefPtr<ossimImageData> theTile;
+   };
+}
+
+
 RTTI_DEF2(ossimVertexExtractor, "ossimVertexExtractor",
           ossimSource, ossimProcessInterface);
 
@@ -35,7 +310,9 @@ ossimVertexExtractor::ossimVertexExtractor(ossimImageSource* inputSource)
       theFileStream(),
       theVertice(4),
       theLeftEdge(0),
-      theRightEdge(0)
+      theRightEdge(0),
+      theCoarseToFineFlag(false),
+      theNumberOfThreads(1)
 {
    if (inputSource == 0)
    {
@@ -89,7 +366,7 @@ bool ossimVertexExtractor::execute()
 
    setProcessStatus(ossimProcessInterface::PROCESS_STATUS_EXECUTING);
    
-   if (scanForEdges())
+   if (theCoarseToFineFlag ? scanForEdgesCoarseToFine() : scanForEdges())
    {
       if (extractVertices())
       {
@@ -308,6 +585,123 @@ bool ossimVertexExtractor::scanForEdges()
    return true;
 }
 
+bool ossimVertexExtractor::scanForEdgesCoarseToFine()
+{
+   static const char MODULE[] = "ossimVertexExtractor::scanForEdgesCoarseToFine";
+
+   if (traceDebug()) CLOG << " Entered..." << endl;
+
+   ossimImageSource* src = PTR_CAST(ossimImageSource, getInput(0));
+   if (!src)
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "WARN ossimVertexExtractor::scanForEdgesCoarseToFine():"
+         << "\nInput source is null.  Returning..." << std::endl;
+      return false;
+   }
+
+   //---
+   // Coarsest level halving the one below it at each step and still a few
+   // pixels across.
+   //---
+   ossim_uint32 coarsest = 0;
+   for (ossim_uint32 r = 1; r < src->getNumberOfDecimationLevels(); ++r)
+   {
+      ossimDpt decimation;
+      src->getDecimationFactor(r, decimation);
+      const double expected = 1.0/(double)(1 << r);
+      if ( (std::fabs(decimation.x - expected) > 1.0e-6) ||
+           (std::fabs(decimation.y - expected) > 1.0e-6) ||
+           ((theAreaOfInterest.width()  >> r) < 8) ||
+           ((theAreaOfInterest.height() >> r) < 8) )
+      {
+         break;
+      }
+      coarsest = r;
+   }
+
+   // Threads read through the handler itself, so it must allow concurrent reads:
+   ossimImageHandler* handler = PTR_CAST(ossimImageHandler, src);
+   ossim_uint32 numberOfThreads =
+      theNumberOfThreads ? theNumberOfThreads : ossim::getNumberOfThreads();
+   if ( !handler || !handler->hasConcurrentReads() )
+   {
+      numberOfThreads = 1;
+   }
+
+   ossimNotify(ossimNotifyLevel_INFO)
+      << "Scanning image source for edges from res level " << coarsest << "..." << std::endl;
+   setPercentComplete(0.0);
+
+   ossimEdgeLevel coarse;
+   for (ossim_int32 r = (ossim_int32)coarsest; r >= 0; --r)
+   {
+      ossimEdgeLevel level;
+      level.theBounds = ossimIrect(theAreaOfInterest.ul().x >> r,
+                                   theAreaOfInterest.ul().y >> r,
+                                   theAreaOfInterest.lr().x >> r,
+                                   theAreaOfInterest.lr().y >> r);
+      level.theLeft.resize(level.theBounds.height(), OSSIM_INT_NAN);
+      level.theRight.resize(level.theBounds.height(), OSSIM_INT_NAN);
+
+      ossimEdgeScan scan(src, handler, r, level,
+                         (r == (ossim_int32)coarsest) ? 0 : &coarse);
+
+      // Thread 0 is this one, reading from the source if alone:
+      std::vector<ossimEdgeScanThread*> threads;
+      for (ossim_uint32 t = 0; t < numberOfThreads; ++t)
+      {
+         ossimRefPtr<ossimImageData> tile;
+         if ( numberOfThreads > 1 )
+         {
+            tile = ossimImageDataFactory::instance()->create(0, handler);
+            if ( !tile.valid() )
+            {
+               break;
+            }
+            tile->initialize();
+         }
+         threads.push_back(new ossimEdgeScanThread(scan, tile.get()));
+         if ( t )
+         {
+            threads.back()->start();
+         }
+      }
+      if ( threads.size() )
+      {
+         threads[0]->run();
+      }
+      for (ossim_uint32 t = 0; t < threads.size(); ++t)
+      {
+         if ( t )
+         {
+            threads[t]->join();
+         }
+         delete threads[t];
+      }
+
+      coarse = level;
+      setPercentComplete(100.0*(coarsest - r + 1)/(coarsest + 1));
+   }
+
+   // Full resolution edges, relative to the area of interest:
+   if (theLeftEdge)  delete [] theLeftEdge;
+   if (theRightEdge) delete [] theRightEdge;
+   theLeftEdge  = new ossim_int32[theAreaOfInterest.height()];
+   theRightEdge = new ossim_int32[theAreaOfInterest.height()];
+   for (ossim_int32 i=0; i<(int)theAreaOfInterest.height(); ++i)
+   {
+      theLeftEdge[i]  = (coarse.theLeft[i] == OSSIM_INT_NAN) ? OSSIM_INT_NAN :
+         coarse.theLeft[i] - theAreaOfInterest.ul().x;
+      theRightEdge[i] = (coarse.theRight[i] == OSSIM_INT_NAN) ? OSSIM_INT_NAN :
+         coarse.theRight[i] - theAreaOfInterest.ul().x;
+   }
+
+   if (traceDebug()) CLOG << " Exited..." << endl;
+
+   return true;
+}
+
 bool ossimVertexExtractor::extractVertices()
 {
    //***
@@ -1870,6 +2264,26 @@ void ossimVertexExtractor::setOutputName(const ossimString& filename)
    theFilename = filename;
 }
 
+void ossimVertexExtractor::setCoarseToFineFlag(bool flag)
+{
+   theCoarseToFineFlag = flag;
+}
+
+bool ossimVertexExtractor::getCoarseToFineFlag() const
+{
+   return theCoarseToFineFlag;
+}
+
+void ossimVertexExtractor::setNumberOfThreads(ossim_uint32 threads)
+{
+   theNumberOfThreads = threads;
+}
+
+ossim_uint32 ossimVertexExtractor::getNumberOfThreads() const
+{
+   return theNumberOfThreads;
+}
+
 void ossimVertexExtractor::setAreaOfInterest(const ossimIrect& rect)
 {
    theAreaOfInterest = rect;
@@ -37,7 +37,10 @@ ossimVpfAnnotationFeatureInfo::ossimVpfAnnotationFeatureInfo(const ossimString&
     theEnabledFlag(enabledFlag),
     theFeatureType(ossimVpfAnnotationFeatureType_UNKNOWN),
     theFontInformation(),
-    theAnnotationArray(0)
+    theAnnotationArray(0),
+    theObjectIndex(),
+    theObjectIndexDirtyFlag(true),
+    theDrawList()
 {
    ossimFont* font = ossimFontFactoryRegistry::instance()->getDefaultFont();
 
@@ -73,6 +76,7 @@ void ossimVpfAnnotationFeatureInfo::transform(ossimImageGeometry* proj)
          }
       }
    }
+   theObjectIndexDirtyFlag = true;
 }
 ossimIrect ossimVpfAnnotationFeatureInfo::getBoundingProjectedRect()const
 {
@@ -198,12 +202,24 @@ void ossimVpfAnnotationFeatureInfo::buildFeature()
 
 void ossimVpfAnnotationFeatureInfo::drawAnnotations(ossimRgbImage* tile)
 {
-   if(theEnabledFlag)
+   if(theEnabledFlag && tile && tile->getImageData().valid())
    {
-      int idx = 0;
-      for(idx = 0; idx < (int)theAnnotationArray.size(); ++idx)
+      if(theObjectIndexDirtyFlag ||
+         (theObjectIndex.getNumberOfObjects() != theAnnotationArray.size()))
       {
-         theAnnotationArray[idx]->draw(*tile);
+         std::vector<ossimDrect> rects(theAnnotationArray.size());
+         for(ossim_uint32 idx = 0; idx < rects.size(); ++idx)
+         {
+            theAnnotationArray[idx]->getBoundingRect(rects[idx]);
+         }
+         theObjectIndex.build(rects);
+         theObjectIndexDirtyFlag = false;
+      }
+
+      theObjectIndex.query(tile->getImageData()->getImageRectangle(), theDrawList);
+      for(ossim_uint32 idx = 0; idx < theDrawList.size(); ++idx)
+      {
+         theAnnotationArray[theDrawList[idx]]->draw(*tile);
       }
    }
 }
@@ -420,6 +436,8 @@ ossimVpfAnnotationFeatureInfo::ossimVpfAnnotationFeatureType ossimVpfAnnotationF
 void ossimVpfAnnotationFeatureInfo::deleteAllObjects()
 {
    theAnnotationArray.clear();
+   theObjectIndex.clear();
+   theObjectIndexDirtyFlag = true;
 }
 
 void ossimVpfAnnotationFeatureInfo::setDrawingFeaturesToAnnotation()
@@ -500,6 +518,9 @@ void ossimVpfAnnotationFeatureInfo::setDrawingFeaturesToAnnotation()
       break;
    }
    }
+
+   // Point radius and font changes move the bounds.
+   theObjectIndexDirtyFlag = true;
 }
 
 
@@ -686,9 +707,12 @@ void ossimVpfAnnotationFeatureInfo::buildEdgFeature(const ossimFilename& tableNa
 void ossimVpfAnnotationFeatureInfo::readAttributes(ossimPolyLine& polyLine, ossimVpfTable& table, int row) {
   int numCols = table.getNumberOfColumns();
 
+  // Read the row once rather than once per column:
+  row_type tableRow = read_row( row, *table.getVpfTableData() );
   for (int col = 0; col < numCols; col ++) {
-    polyLine.addAttribute( table.getColumnValueAsString( row, col ));
+    polyLine.addAttribute( table.getColumnValueAsString( tableRow, col ));
   }
+  free_row( tableRow, *table.getVpfTableData() );
 }
 
 void ossimVpfAnnotationFeatureInfo::buildPointFeature(const ossimString& primitiveName,
@@ -972,10 +996,13 @@ void ossimVpfAnnotationFeatureInfo::buildFaceFeature(const ossimFilename& tableN
 void ossimVpfAnnotationFeatureInfo::readAttributes(ossimGeoPolygon& polygon, ossimVpfTable& table, int row) {
   int numCols = table.getNumberOfColumns();
 
+  // Read the row once rather than once per column:
+  row_type tableRow = read_row( row, *table.getVpfTableData() );
   for (int col = 0; col < numCols; col ++) {
-    ossimString s = table.getColumnValueAsString( row, col );
+    ossimString s = table.getColumnValueAsString( tableRow, col );
     polygon.addAttribute( s );
   }
+  free_row( tableRow, *table.getVpfTableData() );
 }
 
 /* GET_XY                                                                    */
@@ -1098,6 +1125,16 @@ int ossimVpfAnnotationFeatureInfo::readTableCellAsInt (int rowNumber,
 						       ossimVpfTable& table)
 {
   int result = -1;
+
+  // Integer columns straight from the mapped table:
+  const char TYPE = table.getVpfTableData()->header[colNumber].type;
+  ossim_int32 value = 0;
+  if ( ((TYPE == 'I') || (TYPE == 'S')) &&
+       table.getColumnValue(rowNumber, colNumber, value) )
+  {
+     return value;
+  }
+
   row_type row = read_row( rowNumber, *table.getVpfTableData());
   
   result = table.getColumnValueAsString(row, colNumber).toInt();
@@ -1111,34 +1148,14 @@ int ossimVpfAnnotationFeatureInfo::readRngId(int rowNumber,
 					     int colNumber,
 					     ossimVpfTable& faceTable)
 {
-  int idResult = -1;
-  row_type row = read_row( rowNumber, 
-			   *faceTable.getVpfTableData());
-  
-  idResult = faceTable.getColumnValueAsString(row,
-					      colNumber).toInt();
-  
-  free_row(row, *faceTable.getVpfTableData());
-  
-  return idResult;
+  return readTableCellAsInt(rowNumber, colNumber, faceTable);
 }
 
 int ossimVpfAnnotationFeatureInfo::readStartEdgeId(int rowNumber,
 						   int colNumber,
 						   ossimVpfTable& rngTable)
 {
-  int idResult = -1;
-
-  row_type row = read_row( rowNumber, 
-			   *rngTable.getVpfTableData());
-  
-  idResult = rngTable.getColumnValueAsString(row,
-					     colNumber).toInt();
-  
-  free_row(row, *rngTable.getVpfTableData());
-  
-  return idResult;
-  
+  return readTableCellAsInt(rowNumber, colNumber, rngTable);
 }
 
 int ossimVpfAnnotationFeatureInfo::getEdgeKeyId (vpf_table_type& table, row_type& row, int col) {
@@ -1418,6 +1435,22 @@ void ossimVpfAnnotationFeatureInfo::readEdge(ossimPolyLine& polyLine,
 					     ossimVpfTable& edgeTable)
 {
   polyLine.clear();
+
+  // Coordinates straight from the mapped table:
+  std::vector<ossimDpt> points;
+  if ( edgeTable.getCoordinates(rowNumber, colPosition, points) )
+  {
+     for(ossim_uint32 i = 0; i < points.size(); ++i)
+     {
+        if((fabs(points[i].x) <= 180.0)&&
+           (fabs(points[i].y) <= 90.0))
+        {
+           polyLine.addPoint(points[i]);
+        }
+     }
+     return;
+  }
+
   row_type row = read_row( rowNumber, 
 			   *edgeTable.getVpfTableData());
 
@@ -32,6 +32,7 @@
 #include <ossim/base/ossimEnvironmentUtility.h>
 #include <ossim/base/ossimGeoidEgm96.h>
 #include <ossim/imaging/ossimCodecFactoryRegistry.h>
+#include <ossim/imaging/ossimCacheStatistics.h>
 
 //***
 // Define Trace flags for use within this file:
@@ -67,6 +68,32 @@
 static ossimTrace traceExec = ossimTrace("ossimInit:exec");
 static ossimTrace traceDebug = ossimTrace("ossimInit:debug");
 
+namespace
+{
+   //---
+   // Registers a plugin.  One with a manifest is only recorded, and loaded on
+   // first demand from a factory lookup, unless preference
+   // "ossim_init.lazy_load_plugins" is false.
+   //---
+   void registerPlugin(const ossimFilename& file, const char* options)
+   {
+      if ( file.ext() == "manifest" )
+      {
+         return;
+      }
+      ossimString lazy =
+         ossimPreferences::instance()->findPreference("ossim_init.lazy_load_plugins");
+      if ( lazy.empty() || lazy.toBool() )
+      {
+         if ( ossimSharedPluginRegistry::instance()->registerDeferredPlugin(file, options) )
+         {
+            return;
+         }
+      }
+      ossimSharedPluginRegistry::instance()->registerPlugin(file, options);
+   }
+}
+
 ossimInit* ossimInit::theInstance = 0;
 
 ossimInit::~ossimInit()
@@ -292,7 +319,7 @@ void ossimInit::loadPlugins(const ossimFilename& plugin, const char* options)
             {
                do
                { 
-                  ossimSharedPluginRegistry::instance()->registerPlugin(file, options);
+                  registerPlugin(file, options);
                }
                while(dir.getNext(file));
             }
@@ -300,7 +327,7 @@ void ossimInit::loadPlugins(const ossimFilename& plugin, const char* options)
       }
       else
       {
-         ossimSharedPluginRegistry::instance()->registerPlugin(plugin, options);
+         registerPlugin(plugin, options);
       }
    }
 }
@@ -614,7 +641,7 @@ void ossimInit::initializePlugins()
          ossim_uint32 idx = 0;
          for(idx = 0; idx < result.size(); ++idx)
          {
-            ossimSharedPluginRegistry::instance()->registerPlugin(result[idx]);
+            registerPlugin(result[idx], 0);
          }
       }
    }
@@ -693,6 +720,37 @@ void ossimInit::initializeLogFile()
          ossimSetLogFilename(logFile);
       }
    }
+
+   if ( thePreferences )
+   {
+      const char* lookup = thePreferences->preferencesKWL().find("ossim.log.rate_limit");
+      if (lookup)
+      {
+         ossimSetNotifyRateLimit(ossimString(lookup).toUInt32());
+      }
+      lookup = thePreferences->preferencesKWL().find("ossim.log.async");
+      if (lookup)
+      {
+         ossimSetNotifyAsync(ossimString(lookup).toBool());
+      }
+
+      double seconds = 0.0;
+      bool signalFlag = false;
+      lookup = thePreferences->preferencesKWL().find("cache_statistics.log_interval");
+      if (lookup)
+      {
+         seconds = ossimString(lookup).toDouble();
+      }
+      lookup = thePreferences->preferencesKWL().find("cache_statistics.signal");
+      if (lookup)
+      {
+         signalFlag = ossimString(lookup).toBool();
+      }
+      if ( (seconds > 0.0) || signalFlag )
+      {
+         ossimCacheStatistics::startReporter(seconds, signalFlag);
+      }
+   }
 }
 
 ossimString ossimInit::version() const
@@ -32,15 +32,273 @@
 #include <ossim/imaging/ossimTilingRect.h>
 #include <ossim/imaging/ossimTilingPoly.h>
 #include <ossim/base/ossimPreferences.h>
+#include <ossim/imaging/ossimImageWriterFactoryRegistry.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
 #include <ossim/parallel/ossimMpi.h>
 #include <ossim/parallel/ossimMultiThreadSequencer.h>
 #include <ossim/parallel/ossimMtDebug.h> //### For debug/performance eval
+#include <OpenThreads/Block>
+#include <OpenThreads/ScopedLock>
 #include <iterator>
 #include <sstream>
 
 static ossimTrace traceDebug(ossimString("ossimIgen:debug"));
 static ossimTrace traceLog(ossimString("ossimIgen:log"));
 
+namespace
+{
+   //---
+   // Points every view client of chain at a copy of proj.
+   //---
+   void setChainView(ossimImageSource* chain, const ossimMapProjection* proj)
+   {
+      ossimTypeNameVisitor visitor( ossimString("ossimViewInterface"),
+                                    false, // firstofTypeFlag
+                                    (ossimVisitor::VISIT_INPUTS|
+                                     ossimVisitor::VISIT_CHILDREN) );
+      chain->accept( visitor );
+      for( ossim_uint32 i = 0; i < visitor.getObjects().size(); ++i )
+      {
+         ossimViewInterface* viewClient = visitor.getObjectAs<ossimViewInterface>( i );
+         if (viewClient)
+         {
+            viewClient->setView( proj->dup() );
+         }
+      }
+   }
+
+   //---
+   // Initializes chain and returns its bounding rect stretched out to integer
+   // boundaries.
+   //---
+   ossimDrect initializeChainRect(ossimImageSource* chain)
+   {
+      // Force initialization of the chain to recompute parameters:
+      chain->initialize();
+      ossimDrect rect = chain->getBoundingRect();
+
+      if(!rect.hasNans())
+      {
+         // Stretch the rectangle out to integer boundaries.
+         rect.stretchOut();
+
+         // Communicate the new product size to the view's geometry object. This is a total HACK
+         // that external code needs to worry about setting this. Something is wrong with this
+         // picture (OLK 02/11)
+         ossimImageGeometry* geom = chain->getImageGeometry().get();
+         if (geom)
+            geom->setImageSize(ossimIpt(rect.size()));
+      }
+      return rect;
+   }
+
+   //---
+   // One file of a tiled output: its view, clip rectangle and name, and for
+   // polygon tiling copies of the feature cuts.
+   //---
+   struct ossimIgenProduct
+   {
+      ossimRefPtr<ossimMapProjection> m_projection;
+      ossimIrect                      m_clipRect;
+      ossimFilename                   m_filename;
+      ossimRefPtr<ossimImageSource>   m_exteriorCut;
+      ossimRefPtr<ossimImageSource>   m_interiorCut;
+   };
+
+   //---
+   // Hands out the products to the jobs, stops on the first failure and
+   // releases the caller once the last job is done.
+   //---
+   class ossimIgenBatch : public ossimReferenced
+   {
+   public:
+      ossimIgenBatch(std::vector<ossimIgenProduct>& products,
+                     ossim_uint32 jobs,
+                     bool progressFlag)
+         : m_products(products),
+           m_next(0),
+           m_written(0),
+           m_jobs(jobs),
+           m_failed(false),
+           m_progressFlag(progressFlag)
+      {
+         if(m_jobs)
+         {
+            m_block.reset();
+         }
+         else
+         {
+            m_block.release();
+         }
+      }
+      bool next(ossimIgenProduct*& product)
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if ( m_failed || (m_next >= m_products.size()) )
+         {
+            return false;
+         }
+         product = &m_products[m_next++];
+         return true;
+      }
+      void written(const ossimIgenProduct& product)
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         ++m_written;
+         if ( m_progressFlag )
+         {
+            ossimNotify(ossimNotifyLevel_NOTICE)
+               << "Wrote " << product.m_filename << " (" << m_written << " of "
+               << m_products.size() << ")" << std::endl;
+         }
+      }
+      void fail()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         m_failed = true;
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_jobs && (--m_jobs == 0))
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+   private:
+      OpenThreads::Mutex                    m_mutex;
+      OpenThreads::Block                    m_block;
+      std::vector<ossimIgenProduct>&        m_products;
+      std::vector<ossimIgenProduct>::size_type m_next;
+      ossim_uint32                          m_written;
+      ossim_uint32                          m_jobs;
+      bool                                  m_failed;
+      bool                                  m_progressFlag;
+   };
+
+   //---
+   // Writes products until the batch runs out, through a chain and writer of
+   // its own.
+   //---
+   class ossimIgenProductJob : public ossimJob
+   {
+   public:
+      ossimIgenProductJob(ossimImageChain* chain,
+                          ossimImageFileWriter* writer,
+                          bool polyFlag,
+                          bool useMbrFlag,
+                          ossimIgenBatch* batch)
+         : m_chain(chain),
+           m_writer(writer),
+           m_cut(0),
+           m_polyFlag(polyFlag),
+           m_useMbrFlag(useMbrFlag),
+           m_batch(batch)
+      {
+         setName("ossimIgen.product");
+      }
+      virtual void start()
+      {
+         ossimIgenProduct* product = 0;
+         while ( m_batch->next(product) )
+         {
+            if ( !write(*product) )
+            {
+               m_batch->fail();
+            }
+         }
+         m_batch->done();
+      }
+   private:
+      bool write(ossimIgenProduct& product)
+      {
+         if ( m_useMbrFlag )
+         {
+            if ( !m_cut.valid() )
+            {
+               m_cut = new ossimRectangleCutFilter;
+               m_chain->addFirst( m_cut.get() );
+            }
+            m_cut->setRectangle( product.m_clipRect );
+         }
+         if ( product.m_exteriorCut.valid() )
+         {
+            m_chain->addFirst( product.m_exteriorCut.get() );
+         }
+         if ( product.m_interiorCut.valid() )
+         {
+            m_chain->addFirst( product.m_interiorCut.get() );
+         }
+
+         setChainView( m_chain.get(), product.m_projection.get() );
+         ossimDrect bounds = initializeChainRect( m_chain.get() );
+
+         bool result = true;
+
+         // A polygon tile the chain has no data in is skipped before any read:
+         if ( !m_polyFlag ||
+              ( !bounds.hasNans() && ossimIrect(bounds).intersects(product.m_clipRect) ) )
+         {
+            m_writer->disconnect();
+            m_writer->connectMyInputTo( m_chain.get() );
+            m_writer->setFilename( product.m_filename );
+            m_writer->initialize();
+            if ( !m_polyFlag )
+            {
+               m_writer->setAreaOfInterest( product.m_clipRect );
+            }
+
+            try
+            {
+               m_writer->execute();
+               m_batch->written( product );
+            }
+            catch(const ossimException& e)
+            {
+               ossimNotify(ossimNotifyLevel_FATAL)
+                  << "ossimIgen::outputProduct ERROR:\n"
+                  << "Caught exception writing " << product.m_filename << "!\n"
+                  << e.what()
+                  << std::endl;
+               result = false;
+            }
+            catch(...)
+            {
+               ossimNotify(ossimNotifyLevel_FATAL)
+                  << "ossimIgen::outputProduct ERROR:\n"
+                  << "Unknown exception caught writing " << product.m_filename << "!\n"
+                  << std::endl;
+               result = false;
+            }
+            m_writer->disconnect();
+         }
+
+         // The cuts are the product's own; take them out for the next one.
+         if ( product.m_interiorCut.valid() )
+         {
+            m_chain->removeChild( product.m_interiorCut.get() );
+         }
+         if ( product.m_exteriorCut.valid() )
+         {
+            m_chain->removeChild( product.m_exteriorCut.get() );
+         }
+         return result;
+      }
+
+      ossimRefPtr<ossimImageChain>          m_chain;
+      ossimRefPtr<ossimImageFileWriter>     m_writer;
+      ossimRefPtr<ossimRectangleCutFilter>  m_cut;
+      bool                                  m_polyFlag;
+      bool                                  m_useMbrFlag;
+      ossimRefPtr<ossimIgenBatch>           m_batch;
+   };
+}
+
 ossimIgen::ossimIgen()
 :
 theContainer(new ossimConnectableContainer()),
@@ -51,11 +309,14 @@ theOutputRect(),
 theBuildThumbnailFlag(false),
 theThumbnailSize(0, 0),
 theNumberOfTilesToBuffer(2),
+theDynamicSchedulingFlag(false),
 theKwl(),
 theTilingEnabled(false),
 theProgressFlag(true),
 theStdoutFlag(false),
-theThreadCount(9999) // Default no threading
+theThreadCount(9999), // Default no threading
+theProductThreads(1),
+theProductMemoryBudget(0)
 {
    theOutputRect.makeNan();
 }
@@ -147,6 +408,11 @@ void ossimIgen::initializeAttributes()
    {
       theNumberOfTilesToBuffer = ossimString(numberOfSlaveTileBuffersStr).toLong();
    }
+   const char* dynamicSchedulingStr = theKwl.find("igen.dynamic_scheduling");
+   if(dynamicSchedulingStr)
+   {
+      theDynamicSchedulingFlag = ossimString(dynamicSchedulingStr).toBool();
+   }
 
    const char* tilingKw = theKwl.find("igen.tiling.type");
    if(tilingKw)
@@ -157,6 +423,23 @@ void ossimIgen::initializeAttributes()
          theTilingEnabled = false;
       }
    }
+
+   // Tiling products written concurrently, 0 for one per core:
+   const char* productThreadsStr = theKwl.find("igen.tiling.product_threads");
+   if(productThreadsStr)
+   {
+      theProductThreads = ossimString(productThreadsStr).toUInt32();
+      if(!theProductThreads)
+      {
+         theProductThreads = ossim::getNumberOfThreads();
+      }
+   }
+   // Megabytes the concurrent products may take:
+   const char* memoryBudgetStr = theKwl.find("igen.tiling.memory_budget");
+   if(memoryBudgetStr)
+   {
+      theProductMemoryBudget = ossimString(memoryBudgetStr).toUInt64() * 1024 * 1024;
+   }
 }
 
 void ossimIgen::slaveSetup()
@@ -401,9 +684,19 @@ void ossimIgen::outputProduct()
    if(ossimMpi::instance()->getNumberOfProcessors() > 1)
    {
       if(ossimMpi::instance()->getRank()!=0)
-         sequencer = new ossimImageMpiSWriterSequenceConnection(0, theNumberOfTilesToBuffer);
+      {
+         ossimImageMpiSWriterSequenceConnection* slave =
+            new ossimImageMpiSWriterSequenceConnection(0, theNumberOfTilesToBuffer);
+         slave->setDynamicScheduling(theDynamicSchedulingFlag);
+         sequencer = slave;
+      }
       else
-         sequencer = new ossimImageMpiMWriterSequenceConnection();
+      {
+         ossimImageMpiMWriterSequenceConnection* master =
+            new ossimImageMpiMWriterSequenceConnection(0, theNumberOfTilesToBuffer);
+         master->setDynamicScheduling(theDynamicSchedulingFlag);
+         sequencer = master;
+      }
    }
 #endif
 
@@ -475,6 +768,12 @@ void ossimIgen::outputProduct()
    {
       theTiling->initialize(*(theProductProjection.get()), theOutputRect);
 
+      // Several products at once if igen.tiling.product_threads asks for it:
+      if ( outputTiledProducts( writer.get() ) )
+      {
+         return;
+      }
+
       ossimRectangleCutFilter* cut = 0;
       ossimTilingPoly* tilingPoly = dynamic_cast<ossimTilingPoly*>( theTiling.get() );
       
@@ -542,6 +841,13 @@ void ossimIgen::outputProduct()
             }
 
             initializeChain();
+
+            // Nothing to read if the chain has no data in the tile:
+            if ( theOutputRect.hasNans() || !ossimIrect(theOutputRect).intersects(clipRect) )
+            {
+               continue;
+            }
+
             writer->disconnect();
             writer->connectMyInputTo(theProductChain.get());
             writer->setFilename(tempFile.dirCat(tileName));
@@ -588,6 +894,131 @@ void ossimIgen::outputProduct()
    //##################################################################
 }
 
+//*************************************************************************************************
+//! Writes the tiling products concurrently, each job on a clone of the product chain.
+//*************************************************************************************************
+bool ossimIgen::outputTiledProducts(ossimImageFileWriter* writer)
+{
+   // Threads share no sequencer, standard out, or MPI rank:
+   if ( (theProductThreads < 2) || theStdoutFlag ||
+        (ossimMpi::instance()->getNumberOfProcessors() > 1) )
+   {
+      return false;
+   }
+
+   ossimTilingPoly* tilingPoly = dynamic_cast<ossimTilingPoly*>( theTiling.get() );
+   const bool USE_MBR = tilingPoly && tilingPoly->useMbr();
+
+   ossimFilename tempFile = writer->getFilename();
+   if(!tempFile.isDir())
+   {
+      tempFile = tempFile.path();
+   }
+
+   //---
+   // Collect the products first, as 'next' modifies theProductProjection. Feature cuts are
+   // reused from one polygon to the next, so each product gets copies.
+   //---
+   const ossim_uint64 PIXEL_BYTES = theProductChain->getNumberOfOutputBands() *
+      ossim::scalarSizeInBytes( theProductChain->getOutputScalarType() );
+   ossim_uint64 productBytes = 0;
+   std::vector<ossimIgenProduct> products;
+   ossimString tileName;
+   ossimIrect clipRect;
+   while(theTiling->next(theProductProjection, clipRect, tileName))
+   {
+      if ( tilingPoly && !tilingPoly->isFeatureBoundingIntersect() )
+      {
+         continue;
+      }
+      ossimIgenProduct product;
+      product.m_projection = static_cast<ossimMapProjection*>( theProductProjection->dup() );
+      product.m_clipRect = clipRect;
+      product.m_filename = tempFile.dirCat(tileName);
+      if ( tilingPoly && !USE_MBR )
+      {
+         if ( tilingPoly->hasExteriorCut() )
+         {
+            product.m_exteriorCut = tilingPoly->getExteriorCut()->cloneSource();
+         }
+         if ( tilingPoly->hasInteriorCut() )
+         {
+            product.m_interiorCut = tilingPoly->getInteriorCut()->cloneSource();
+         }
+      }
+      products.push_back(product);
+
+      // Some writers hold a whole product in memory, so budget for that:
+      productBytes = ossim::max<ossim_uint64>(
+         productBytes, static_cast<ossim_uint64>(clipRect.area()) * PIXEL_BYTES );
+   }
+
+   ossim_uint32 jobs = ossim::min<ossim_uint32>(
+      theProductThreads, static_cast<ossim_uint32>(products.size()) );
+   if ( theProductMemoryBudget && productBytes )
+   {
+      jobs = ossim::min<ossim_uint32>(
+         jobs, static_cast<ossim_uint32>(
+            ossim::max<ossim_uint64>(1, theProductMemoryBudget / productBytes) ) );
+   }
+
+   //---
+   // The first job writes through the product chain and writer, the others through clones.
+   // Clones are made here as the object factories are not thread safe; they share the
+   // read-only state of the product chain (see ossimImageSource::cloneSource).
+   //---
+   ossimKeywordlist writerKwl;
+   writer->saveState(writerKwl, "writer.");
+   std::vector< ossimRefPtr<ossimImageChain> > chains(1, theProductChain);
+   std::vector< ossimRefPtr<ossimImageFileWriter> > writers(1, writer);
+   while ( chains.size() < jobs )
+   {
+      ossimRefPtr<ossimImageSource> chainClone = theProductChain->cloneSource();
+      ossimRefPtr<ossimImageFileWriter> writerClone =
+         ossimImageWriterFactoryRegistry::instance()->createWriter(writerKwl, "writer.");
+      ossimImageChain* chain = dynamic_cast<ossimImageChain*>( chainClone.get() );
+      if ( !chain || !writerClone.valid() )
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "ossimIgen::outputTiledProducts WARNING: Could not copy the product chain or "
+            << "writer; writing " << chains.size() << " products at once." << std::endl;
+         break;
+      }
+      chains.push_back(chain);
+      writers.push_back(writerClone);
+   }
+   jobs = ossim::max<ossim_uint32>( 1, static_cast<ossim_uint32>(chains.size()) );
+
+   ossimRefPtr<ossimIgenBatch> batch = new ossimIgenBatch(products, jobs, theProgressFlag);
+   std::vector< ossimRefPtr<ossimIgenProductJob> > productJobs;
+   for ( ossim_uint32 i = 0; i < jobs; ++i )
+   {
+      productJobs.push_back( new ossimIgenProductJob( chains[i].get(),
+                                                      writers[i].get(),
+                                                      tilingPoly != 0,
+                                                      USE_MBR,
+                                                      batch.get() ) );
+   }
+   if ( jobs == 1 )
+   {
+      productJobs[0]->start();
+   }
+   else
+   {
+      ossimRefPtr<ossimJobMultiThreadQueue> queue = new ossimJobMultiThreadQueue(0, jobs);
+      for ( ossim_uint32 i = 0; i < jobs; ++i )
+      {
+         queue->getJobQueue()->add(productJobs[i].get(), false);
+      }
+      batch->wait();
+   }
+
+   // Leave the product chain with its own view and bounds:
+   setView();
+
+   return true;
+}
+
 //*************************************************************************************************
 //! Consolidates job of actually writing to the output file.
 //*************************************************************************************************
@@ -655,30 +1086,7 @@ void ossimIgen::setView()
    if( theProductChain.valid() && theProductProjection.valid() )
    {
       // Find all view clients in the chain, and notify them of the new view:
-#if 0
-      ossimConnectableObject::ConnectableObjectList clientList;
-      theProductChain->findAllInputsOfType(clientList, STATIC_TYPE_INFO(ossimViewInterface), true, true);
-      for(ossim_uint32 i = 0; i < clientList.size();++i)
-      {
-         ossimViewInterface* viewClient = dynamic_cast<ossimViewInterface*>( clientList[i].get() );
-         if (viewClient)
-            viewClient->setView(theProductProjection->dup());
-      }
-#endif
-      
-      ossimTypeNameVisitor visitor( ossimString("ossimViewInterface"),
-                                    false, // firstofTypeFlag
-                                    (ossimVisitor::VISIT_INPUTS|
-                                     ossimVisitor::VISIT_CHILDREN) );
-      theProductChain->accept( visitor );
-      for( ossim_uint32 i = 0; i < visitor.getObjects().size(); ++i )
-      {
-         ossimViewInterface* viewClient = visitor.getObjectAs<ossimViewInterface>( i );
-         if (viewClient)
-         {
-            viewClient->setView( theProductProjection->dup() );
-         }
-      }
+      setChainView( theProductChain.get(), theProductProjection.get() );
 
       // Force recompute of bounding rect:
       initializeChain();
@@ -724,20 +1132,5 @@ void ossimIgen::initThumbnailProjection()
 //*************************************************************************************************
 void ossimIgen::initializeChain()
 {
-   // Force initialization of the chain to recompute parameters:
-   theProductChain->initialize();
-   theOutputRect = theProductChain->getBoundingRect();
-   
-   if(!theOutputRect.hasNans())
-   {
-      // Stretch the rectangle out to integer boundaries.
-      theOutputRect.stretchOut();
-
-      // Communicate the new product size to the view's geometry object. This is a total HACK that 
-      // external code needs to worry about setting this. Something is wrong with this picture 
-      // (OLK 02/11)
-      ossimImageGeometry* geom = theProductChain->getImageGeometry().get();
-      if (geom)
-         geom->setImageSize(ossimIpt(theOutputRect.size()));
-   }
+   theOutputRect = initializeChainRect( theProductChain.get() );
 }
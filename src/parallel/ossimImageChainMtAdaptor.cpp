@@ -138,6 +138,11 @@ bool ossimImageChainMtAdaptor::replicate()
    if (m_numThreads == 1)
       return true;
 
+   // Handlers that serve concurrent reads are shared even if not directed: they are then opened
+   // once, with their geometry, instead of once per clone.
+   if (!d_useSharedHandlers)
+      d_useSharedHandlers = handlersHaveConcurrentReads();
+
    // If the handlers are to be shared, need to isolate them from the original chain and replace
    // them with a "hollow adaptor" (i.e., a handler adaptor without the adaptee set yet:
    m_sharedHandlers.clear();
@@ -310,6 +315,10 @@ bool ossimImageChainMtAdaptor::loadState(const ossimKeywordlist& kwl, const char
             return false;
       }
 
+      // The clone's objects still carry the IDs of the originals they were loaded from. Let them
+      // reference the originals' read-only state (geometries, histograms) instead of copies:
+      shareOriginalState(i);
+
       // Find the first (right-most) source in the chain and store it in the clone list. Need to
       // Modify all IDs
       ossimIdVisitor visitor (orig_source_id);
@@ -391,6 +400,50 @@ bool ossimImageChainMtAdaptor::connectSharedHandlers(ossim_uint32 chain_index)
 }
 
 
+//*************************************************************************************************
+// Lets each object of a cloned chain reference the read-only state of its original.
+//*************************************************************************************************
+void ossimImageChainMtAdaptor::shareOriginalState(ossim_uint32 chain_index)
+{
+   if ((chain_index == 0) || ((size_t)chain_index >= m_chainContainers.size()))
+      return;
+
+   ossimTypeNameVisitor visitor (ossimString("ossimImageSource"), false,
+                                 ossimVisitor::VISIT_CHILDREN);
+   m_chainContainers[chain_index]->accept(visitor);
+   ossim_uint32 idx = 0;
+   ossimImageSource* clone_obj = 0;
+   while ((clone_obj = visitor.getObjectAs<ossimImageSource>(idx++)) != 0)
+   {
+      // Shared handlers are not in the containers, and are shared already:
+      ossimIdVisitor id_visitor (clone_obj->getId(), ossimVisitor::VISIT_CHILDREN);
+      m_chainContainers[0]->accept(id_visitor);
+      ossimImageSource* original_obj = dynamic_cast<ossimImageSource*>(id_visitor.getObject());
+      if (original_obj && (original_obj != clone_obj))
+         clone_obj->shareReadOnlyState(original_obj);
+   }
+}
+
+//*************************************************************************************************
+// Returns TRUE if all image handlers of the original chain serve concurrent reads.
+//*************************************************************************************************
+bool ossimImageChainMtAdaptor::handlersHaveConcurrentReads()
+{
+   if (m_chainContainers.empty())
+      return false;
+
+   ossimTypeNameVisitor visitor (ossimString("ossimImageHandler"));
+   m_chainContainers[0]->accept(visitor);
+   ossim_uint32 idx = 0;
+   ossimImageHandler* handler = 0;
+   while ((handler = visitor.getObjectAs<ossimImageHandler>(idx++)) != 0)
+   {
+      if (!handler->hasConcurrentReads())
+         return false;
+   }
+   return (idx > 1); // At least one handler.
+}
+
 //*************************************************************************************************
 // Adapts base class method for accessing connectables in the original chain.
 //*************************************************************************************************
@@ -12,8 +12,10 @@
 //  $Id$
 #include <ossim/parallel/ossimImageHandlerMtAdaptor.h>
 #include <ossim/imaging/ossimImageHandlerRegistry.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
 #include <ossim/parallel/ossimMtDebug.h>
 #include <ossim/base/ossimTimer.h>
+#include <ossim/base/ossimTimeline.h>
 
 RTTI_DEF1(ossimImageHandlerMtAdaptor, "ossimImageHandlerMtAdaptor", ossimImageHandler);
 
@@ -141,8 +143,28 @@ ossimRefPtr<ossimImageData>
    if (!m_adaptedHandler.valid())
       return NULL;
 
+   // Handlers that can read concurrently fill our own tile directly, no lock or copy needed:
+   if (!d_useCache && m_adaptedHandler->hasConcurrentReads())
+   {
+      ossimRefPtr<ossimImageData> tile =
+         ossimImageDataFactory::instance()->create(this, m_adaptedHandler.get());
+      if (!tile.valid())
+         return NULL;
+      tile->setImageRectangle(tile_rect);
+      tile->initialize();
+      ossimTimeline::Span span("handler read", "io");
+      if (!m_adaptedHandler->getTile(tile.get(), rLevel))
+         tile->makeBlank();
+      return tile;
+   }
+
    // The sole purpose of the adapter is this mutex lock around the actual handler getTile:
+   ossimTimeline* timeline = ossimTimeline::instance();
+   const ossimTimer::Timer_t WAIT = timeline->isRecording() ? ossimTimer::instance()->tick() : 0;
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   if (WAIT && timeline->isSampled(WAIT))
+      timeline->record("handler lock wait", "lock", WAIT, ossimTimer::instance()->tick());
+   ossimTimeline::Span span("handler read", "io");
 
    ossimRefPtr<ossimImageData> tile = new ossimImageData();
    ossimRefPtr<ossimImageData> temp_tile = 0;
@@ -164,6 +186,20 @@ ossimRefPtr<ossimImageData>
    return tile;
 }
 
+//**************************************************************************************************
+//! Forwards the prefetch hint to the adaptee.
+//**************************************************************************************************
+void ossimImageHandlerMtAdaptor::prefetch(const std::vector<ossimIrect>& rects, ossim_uint32 rLevel)
+{
+   if (m_adaptedHandler.valid())
+      m_adaptedHandler->prefetch(rects, rLevel);
+}
+
+bool ossimImageHandlerMtAdaptor::getIoCounters(ossimIoCounters::Values& values) const
+{
+   return m_adaptedHandler.valid() && m_adaptedHandler->getIoCounters(values);
+}
+
 //**************************************************************************************************
 //! Intercepts the getTile call intended for the adaptee and sets a mutex lock around the
 //! adaptee's getTile call.
@@ -173,8 +209,19 @@ bool ossimImageHandlerMtAdaptor::getTile(ossimImageData* tile, ossim_uint32 rLev
    if ((!m_adaptedHandler.valid()) || (tile == NULL))
       return false;
 
+   if (!d_useCache && m_adaptedHandler->hasConcurrentReads())
+   {
+      ossimTimeline::Span span("handler read", "io");
+      return m_adaptedHandler->getTile(tile, rLevel);
+   }
+
    // The sole purpose of the adapter is this mutex lock around the actual handler getTile:
+   ossimTimeline* timeline = ossimTimeline::instance();
+   const ossimTimer::Timer_t WAIT = timeline->isRecording() ? ossimTimer::instance()->tick() : 0;
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   if (WAIT && timeline->isSampled(WAIT))
+      timeline->record("handler lock wait", "lock", WAIT, ossimTimer::instance()->tick());
+   ossimTimeline::Span span("handler read", "io");
 
    // This is effectively a copy of ossimImageSource::getTile(ossimImageData*). It is reimplemented 
    // here to save two additional function calls:
@@ -39,12 +39,23 @@ RTTI_DEF1(ossimImageMpiMWriterSequenceConnection, "ossimImageMpiMWriterSequenceC
 
 ossimImageMpiMWriterSequenceConnection::ossimImageMpiMWriterSequenceConnection(
    ossimImageSource* inputSource,
-   ossimObject* owner)
+   ossimObject* owner,
+   long numberOfTilesToBuffer)
    :ossimImageSourceSequencer(inputSource, owner),
-    theOutputTile(NULL)
+    theNumberOfTilesToBuffer(numberOfTilesToBuffer),
+    theOutputTiles(),
+    theRequests(0),
+    theNextReceiveTile(0),
+    theDynamicSchedulingFlag(false),
+    theSchedulingStartedFlag(false),
+    theNextAssignTile(0),
+    theTileOwner(),
+    theActiveSlaves(0),
+    theWorkRequestRank(0)
 {
    theRank = 0;
    theNumberOfProcessors = 1;
+   theNumberOfTilesToBuffer = ((theNumberOfTilesToBuffer>0)?theNumberOfTilesToBuffer:2);
 
 #ifdef OSSIM_HAS_MPI   
 #  if OSSIM_HAS_MPI
@@ -64,12 +75,23 @@ ossimImageMpiMWriterSequenceConnection::ossimImageMpiMWriterSequenceConnection(
    theNeedToSendRequest = true;
 }
 
-ossimImageMpiMWriterSequenceConnection::ossimImageMpiMWriterSequenceConnection(ossimObject* owner)
+ossimImageMpiMWriterSequenceConnection::ossimImageMpiMWriterSequenceConnection(ossimObject* owner,
+                                                                               long numberOfTilesToBuffer)
    :ossimImageSourceSequencer(NULL, owner),
-    theOutputTile(NULL)
+    theNumberOfTilesToBuffer(numberOfTilesToBuffer),
+    theOutputTiles(),
+    theRequests(0),
+    theNextReceiveTile(0),
+    theDynamicSchedulingFlag(false),
+    theSchedulingStartedFlag(false),
+    theNextAssignTile(0),
+    theTileOwner(),
+    theActiveSlaves(0),
+    theWorkRequestRank(0)
 {
    theRank = 0;
    theNumberOfProcessors = 1;
+   theNumberOfTilesToBuffer = ((theNumberOfTilesToBuffer>0)?theNumberOfTilesToBuffer:2);
    
 #ifdef OSSIM_HAS_MPI     
 #  if OSSIM_HAS_MPI
@@ -91,6 +113,17 @@ ossimImageMpiMWriterSequenceConnection::ossimImageMpiMWriterSequenceConnection(o
 
 ossimImageMpiMWriterSequenceConnection::~ossimImageMpiMWriterSequenceConnection()
 {
+   deleteOutputTiles();
+}
+
+void ossimImageMpiMWriterSequenceConnection::deleteOutputTiles()
+{
+   cancelReceives();
+#if OSSIM_HAS_MPI
+   delete [] static_cast<MPI_Request*>(theRequests);
+#endif
+   theRequests = 0;
+   theOutputTiles.clear();
 }
 
 void ossimImageMpiMWriterSequenceConnection::initialize()
@@ -98,18 +131,37 @@ void ossimImageMpiMWriterSequenceConnection::initialize()
   ossimImageSourceSequencer::initialize();
 
   theCurrentTileNumber = theRank;//-1;
-  theOutputTile = NULL;
+  deleteOutputTiles();
   
   if(theInputConnection)
   {
-     theOutputTile = ossimImageDataFactory::instance()->create(this, this);
-     theOutputTile->initialize();
+     // Keep every slave's outstanding sends matched by a posted receive.
+     ossim_uint32 slaves = (theNumberOfProcessors > 1) ? (theNumberOfProcessors - 1) : 1;
+     ossim_uint32 slots  = slaves * theNumberOfTilesToBuffer;
+     theOutputTiles.resize(slots);
+     for(ossim_uint32 index = 0; index < slots; ++index)
+     {
+        theOutputTiles[index] = ossimImageDataFactory::instance()->create(this, this);
+        theOutputTiles[index]->initialize();
+     }
+#if OSSIM_HAS_MPI
+     // One extra request for the pending work request.
+     MPI_Request* requests = new MPI_Request[slots+1];
+     for(ossim_uint32 index = 0; index <= slots; ++index)
+     {
+        requests[index] = MPI_REQUEST_NULL;
+     }
+     theRequests = requests;
+#endif
   }
+  theNextReceiveTile = theCurrentTileNumber;
+  theSchedulingStartedFlag = false;
 }
 
 void ossimImageMpiMWriterSequenceConnection::setToStartOfSequence()
 {
    ossimImageSourceSequencer::setToStartOfSequence();
+   cancelReceives();
    if(theRank != 0)
    {
       // we will subtract one since the masters job is just
@@ -122,6 +174,170 @@ void ossimImageMpiMWriterSequenceConnection::setToStartOfSequence()
       // the master will start at 0
       theCurrentTileNumber = 0;
    }
+   theNextReceiveTile = theCurrentTileNumber;
+   theSchedulingStartedFlag = false;
+}
+
+void ossimImageMpiMWriterSequenceConnection::setDynamicScheduling(bool flag)
+{
+   theDynamicSchedulingFlag = flag;
+}
+
+bool ossimImageMpiMWriterSequenceConnection::getDynamicScheduling()const
+{
+   return theDynamicSchedulingFlag;
+}
+
+void ossimImageMpiMWriterSequenceConnection::postReceive(ossim_int64 tileNumber)
+{
+#if OSSIM_HAS_MPI
+   if(theOutputTiles.empty() || (tileNumber >= getNumberOfTiles()))
+   {
+      return;
+   }
+   ossim_int64 slot = tileNumber%static_cast<ossim_int64>(theOutputTiles.size());
+   MPI_Request* requests = static_cast<MPI_Request*>(theRequests);
+
+   // The slave for a tile is fixed, and MPI keeps messages from one source
+   // in order, so receives posted ahead match the right tiles.
+   MPI_Irecv(theOutputTiles[slot]->getBuf(),
+             theOutputTiles[slot]->getSizeInBytes(),
+             MPI_UNSIGNED_CHAR,
+             getTileOwner(tileNumber),
+             ossimMpi::TILE_TAG,
+             MPI_COMM_WORLD,
+             &requests[slot]);
+#endif
+}
+
+int ossimImageMpiMWriterSequenceConnection::getTileOwner(ossim_int64 tileNumber)const
+{
+   if(theDynamicSchedulingFlag)
+   {
+      return theTileOwner[tileNumber];
+   }
+   return static_cast<int>(tileNumber%(theNumberOfProcessors-1)+1);
+}
+
+ossim_int64 ossimImageMpiMWriterSequenceConnection::getBatchSize()const
+{
+   //---
+   // Guided scheduling: hand out a share of what is left so early batches
+   // amortize the request round trip and the last ones even out the
+   // finish.  Capped at the receive window since tiles past it can not be
+   // taken by the master yet anyway.
+   //---
+   ossim_int64 slaves    = (theNumberOfProcessors > 1) ? (theNumberOfProcessors - 1) : 1;
+   ossim_int64 remaining = getNumberOfTiles() - theNextAssignTile;
+   ossim_int64 maxBatch  = static_cast<ossim_int64>(theOutputTiles.size());
+   ossim_int64 result    = remaining / (2 * slaves);
+   if(result > maxBatch)
+   {
+      result = maxBatch;
+   }
+   if(result < 1)
+   {
+      result = 1;
+   }
+   if(result > remaining)
+   {
+      result = remaining;
+   }
+   return result;
+}
+
+void ossimImageMpiMWriterSequenceConnection::startScheduling()
+{
+   theSchedulingStartedFlag = true;
+   if(!theDynamicSchedulingFlag)
+   {
+      // Static: every tile has a fixed rank so all can be received.
+      theNextAssignTile = getNumberOfTiles();
+      return;
+   }
+#if OSSIM_HAS_MPI
+   theNextAssignTile = theCurrentTileNumber;
+   theTileOwner.assign(static_cast<std::vector<int>::size_type>(getNumberOfTiles()), 0);
+   theActiveSlaves = theNumberOfProcessors - 1;
+
+   MPI_Request* requests = static_cast<MPI_Request*>(theRequests);
+   MPI_Irecv(&theWorkRequestRank,
+             1,
+             MPI_INT,
+             MPI_ANY_SOURCE,
+             ossimMpi::WORK_REQUEST_TAG,
+             MPI_COMM_WORLD,
+             &requests[theOutputTiles.size()]);
+#endif
+}
+
+void ossimImageMpiMWriterSequenceConnection::serviceWorkRequest(int rank)
+{
+#if OSSIM_HAS_MPI
+   long batch[2];
+   batch[0] = static_cast<long>(theNextAssignTile);
+   batch[1] = static_cast<long>(getBatchSize());
+   for(long index = 0; index < batch[1]; ++index)
+   {
+      theTileOwner[theNextAssignTile] = rank;
+      ++theNextAssignTile;
+   }
+   MPI_Send(batch, 2, MPI_LONG, rank, ossimMpi::WORK_ASSIGN_TAG, MPI_COMM_WORLD);
+
+   if(batch[1] == 0)
+   {
+      // Empty batch, the slave is done.
+      --theActiveSlaves;
+   }
+   if(theActiveSlaves > 0)
+   {
+      MPI_Request* requests = static_cast<MPI_Request*>(theRequests);
+      MPI_Irecv(&theWorkRequestRank,
+                1,
+                MPI_INT,
+                MPI_ANY_SOURCE,
+                ossimMpi::WORK_REQUEST_TAG,
+                MPI_COMM_WORLD,
+                &requests[theOutputTiles.size()]);
+   }
+#endif
+}
+
+void ossimImageMpiMWriterSequenceConnection::finishScheduling()
+{
+#if OSSIM_HAS_MPI
+   if(!theDynamicSchedulingFlag || !theRequests)
+   {
+      return;
+   }
+
+   // Slaves block on their last request, so answer them all before leaving.
+   MPI_Request* requests = static_cast<MPI_Request*>(theRequests);
+   while(theActiveSlaves > 0)
+   {
+      MPI_Status status;
+      MPI_Wait(&requests[theOutputTiles.size()], &status);
+      serviceWorkRequest(status.MPI_SOURCE);
+   }
+#endif
+}
+
+void ossimImageMpiMWriterSequenceConnection::cancelReceives()
+{
+#if OSSIM_HAS_MPI
+   MPI_Request* requests = static_cast<MPI_Request*>(theRequests);
+   if(requests)
+   {
+      for(ossim_uint32 index = 0; index <= theOutputTiles.size(); ++index)
+      {
+         if(requests[index] != MPI_REQUEST_NULL)
+         {
+            MPI_Cancel(&requests[index]);
+            MPI_Wait(&requests[index], MPI_STATUS_IGNORE);
+         }
+      }
+   }
+#endif
 }
 
 /*!
@@ -131,155 +347,98 @@ ossimRefPtr<ossimImageData> ossimImageMpiMWriterSequenceConnection::getNextTile(
 {
 #if OSSIM_HAS_MPI
    ossimEndian endian;
-   if(!theOutputTile)
+   if(theOutputTiles.empty())
    {
       initialize();
-      if (!theOutputTile)
+      if (theOutputTiles.empty())
       {
-         return theOutputTile;
+         return ossimRefPtr<ossimImageData>();
       }
    }
    
-   void* buf = theOutputTile->getBuf();
-
-   ossim_uint32 numberOfTiles = getNumberOfTiles();
-   int errorValue = 0;
+   ossim_int64 numberOfTiles = getNumberOfTiles();
+   ossim_int64 slots = static_cast<ossim_int64>(theOutputTiles.size());
    
    if(theCurrentTileNumber >= numberOfTiles)
    {
       return NULL;
    }
-   errorValue = MPI_Recv(buf,
-                         theOutputTile->getSizeInBytes(),
-                         MPI_UNSIGNED_CHAR,
-                         theCurrentTileNumber%(theNumberOfProcessors-1)+1,
-                         0,
-                         MPI_COMM_WORLD,
-                         MPI_STATUS_IGNORE);
-   if((endian.getSystemEndianType()!=OSSIM_BIG_ENDIAN)&&
-      (theOutputTile->getScalarType()!=OSSIM_UINT8))
+   if(!theSchedulingStartedFlag)
    {
-      endian.swap(theOutputTile->getScalarType(),
-                  buf,
-                  theOutputTile->getSize());
+      startScheduling();
    }
-   
-#if 0
-   // Since MPI can run on different platforms
-   // I am not sure if MPI has built in byte
-   // swap.  If so I will name each datatype
-   // so it can handle byte swap.  Does anyone
-   // know if MPI does byte swapping.
-   switch(theOutputTile->getScalarType())
+
+   ossim_int64 slot = theCurrentTileNumber%slots;
+   ossimRefPtr<ossimImageData> tile = theOutputTiles[slot];
+   MPI_Request* requests = static_cast<MPI_Request*>(theRequests);
+   MPI_Status status;
+   int count = 0;
+   while(true)
    {
-      case OSSIM_UINT8:
-      {
-         // we add 1 to the rank so we don't wait on a message
-         // to ourself (rank = 0).
-         errorValue = MPI_Recv(buf,
-                               theOutputTile->getSize(),
-                               MPI_UNSIGNED_CHAR,
-                               theCurrentTileNumber%(theNumberOfProcessors-1)+1,
-                               0,
-                               MPI_COMM_WORLD,
-                               MPI_STATUS_IGNORE);
-         break;
-      }
-      case OSSIM_SINT8:
-      {
-         // we add 1 to the rank so we don't wait on a message
-         // to ourself (rank = 0).
-         errorValue = MPI_Recv(buf,
-                               theOutputTile->getSize(),
-                               MPI_CHAR,
-                               theCurrentTileNumber%(theNumberOfProcessors-1)+1,
-                               0,
-                               MPI_COMM_WORLD,
-                               MPI_STATUS_IGNORE);
-         break;
-      }
-      case OSSIM_UINT16:
-      case OSSIM_USHORT11:
-      {
-         errorValue = MPI_Recv(buf,
-                               theOutputTile->getSize(),
-                               MPI_UNSIGNED_SHORT,
-                               theCurrentTileNumber%(theNumberOfProcessors-1)+1,
-                               0,
-                               MPI_COMM_WORLD,
-                               MPI_STATUS_IGNORE);
-         break;
-      }
-      case OSSIM_SINT16:
-      {
-         errorValue = MPI_Recv(buf,
-                               theOutputTile->getSize(),
-                               MPI_SHORT,
-                               theCurrentTileNumber%(theNumberOfProcessors-1)+1,
-                               0,
-                               MPI_COMM_WORLD,
-                               MPI_STATUS_IGNORE);
-         break;
-      }
-      case OSSIM_SINT32:
+      //---
+      // Top up the posted receives.  The slot of the tile returned on the
+      // previous call is only reused now, once the writer is done with it.
+      // Only tiles already handed out have a known source.
+      //---
+      while( (theNextReceiveTile < theNextAssignTile) &&
+             (theNextReceiveTile < theCurrentTileNumber + slots) )
       {
-         errorValue = MPI_Recv(buf,
-                               theOutputTile->getSize(),
-                               MPI_LONG,
-                               theCurrentTileNumber%(theNumberOfProcessors-1)+1,
-                               0,
-                               MPI_COMM_WORLD,
-                               MPI_STATUS_IGNORE);
-         break;
-      }
-      case OSSIM_UINT32:
-      {
-         errorValue = MPI_Recv(buf,
-                               theOutputTile->getSize(),
-                               MPI_UNSIGNED_LONG,
-                               theCurrentTileNumber%(theNumberOfProcessors-1)+1,
-                               0,
-                               MPI_COMM_WORLD,
-                               MPI_STATUS_IGNORE);
-         break;
+         postReceive(theNextReceiveTile);
+         ++theNextReceiveTile;
       }
-      case OSSIM_FLOAT32:
-      case OSSIM_NORMALIZED_FLOAT:
+
+      // Wait on our tile, servicing work requests in the meantime.
+      MPI_Request pending[2];
+      pending[0] = (theCurrentTileNumber < theNextReceiveTile) ? requests[slot] : MPI_REQUEST_NULL;
+      pending[1] = requests[slots];
+      int index = MPI_UNDEFINED;
+      MPI_Waitany(2, pending, &index, &status);
+      requests[slot]  = (theCurrentTileNumber < theNextReceiveTile) ? pending[0] : requests[slot];
+      requests[slots] = pending[1];
+      if(index == 0)
       {
-         errorValue = MPI_Recv(buf,
-                               theOutputTile->getSize(),
-                               MPI_FLOAT,
-                               theCurrentTileNumber%(theNumberOfProcessors-1)+1,
-                               0,
-                               MPI_COMM_WORLD,
-                               MPI_STATUS_IGNORE);
          break;
       }
-      case OSSIM_FLOAT64:
-      case OSSIM_NORMALIZED_DOUBLE:
+      if(index == 1)
       {
-         errorValue = MPI_Recv(buf,
-                               theOutputTile->getSize(),
-                               MPI_DOUBLE,
-                               theCurrentTileNumber%(theNumberOfProcessors-1)+1,
-                               0,
-                               MPI_COMM_WORLD,
-                               MPI_STATUS_IGNORE);
-         break;
+         serviceWorkRequest(status.MPI_SOURCE);
       }
-      default:
+      else
       {
-         break;
+         // Nothing pending, can only happen on a protocol error.
+         return ossimRefPtr<ossimImageData>();
       }
    }
-#endif
+   MPI_Get_count(&status, MPI_UNSIGNED_CHAR, &count);
+
    ossimIpt origin;
    getTileOrigin(theCurrentTileNumber,
                  origin);
-   theOutputTile->setOrigin(origin);
-   theOutputTile->validate();
+   tile->setOrigin(origin);
+
+   if(count < static_cast<int>(tile->getSizeInBytes()))
+   {
+      // Slaves send a short message in place of empty tiles.
+      tile->makeBlank();
+   }
+   else
+   {
+      void* buf = tile->getBuf();
+      if((endian.getSystemEndianType()!=OSSIM_BIG_ENDIAN)&&
+         (tile->getScalarType()!=OSSIM_UINT8))
+      {
+         endian.swap(tile->getScalarType(),
+                     buf,
+                     tile->getSize());
+      }
+      tile->validate();
+   }
    ++theCurrentTileNumber;
-   return theOutputTile;
+   if(theCurrentTileNumber >= numberOfTiles)
+   {
+      finishScheduling();
+   }
+   return tile;
 #else
    return ossimImageSourceSequencer::getNextTile(resLevel);
 #endif
@@ -31,6 +31,7 @@ ossimImageMpiSWriterSequenceConnection::ossimImageMpiSWriterSequenceConnection(o
    :ossimImageSourceSequencer(NULL,
                               owner),
     theNumberOfTilesToBuffer(numberOfTilesToBuffer),
+    theDynamicSchedulingFlag(false),
     theOutputTile(NULL)
 {
    theRank = 0;
@@ -60,6 +61,7 @@ ossimImageMpiSWriterSequenceConnection::ossimImageMpiSWriterSequenceConnection(o
    :ossimImageSourceSequencer(inputSource,
                                  owner),
     theNumberOfTilesToBuffer(numberOfTilesToBuffer),
+    theDynamicSchedulingFlag(false),
     theOutputTile(NULL)
 {
    theRank = 0;
@@ -133,6 +135,33 @@ void ossimImageMpiSWriterSequenceConnection::setToStartOfSequence()
    }
 }
 
+void ossimImageMpiSWriterSequenceConnection::setDynamicScheduling(bool flag)
+{
+   theDynamicSchedulingFlag = flag;
+}
+
+bool ossimImageMpiSWriterSequenceConnection::getDynamicScheduling()const
+{
+   return theDynamicSchedulingFlag;
+}
+
+bool ossimImageMpiSWriterSequenceConnection::requestTiles(ossim_int64& start,
+                                                          ossim_int64& end)
+{
+#if OSSIM_HAS_MPI
+   long batch[2] = { 0, 0 };
+   MPI_Send(&theRank, 1, MPI_INT, 0, ossimMpi::WORK_REQUEST_TAG, MPI_COMM_WORLD);
+   MPI_Recv(batch, 2, MPI_LONG, 0, ossimMpi::WORK_ASSIGN_TAG, MPI_COMM_WORLD,
+            MPI_STATUS_IGNORE);
+   start = batch[0];
+   end   = batch[0] + batch[1];
+   return (batch[1] > 0);
+#else
+   start = end = 0;
+   return false;
+#endif
+}
+
 void ossimImageMpiSWriterSequenceConnection::slaveProcessTiles()
 {
 #ifdef OSSIM_HAS_MPI 
@@ -152,8 +181,26 @@ void ossimImageMpiSWriterSequenceConnection::slaveProcessTiles()
    {
       ossimNotify(ossimNotifyLevel_DEBUG) << "DEBUG ossimImageMpiSWriterSequenceConnection::slaveProcessTiles(): entering slave and will look at " << numberOfTiles << " tiles" << std::endl;
    }
-   while(theCurrentTileNumber < numberOfTiles)
+   ossim_int64 batchEnd = 0;
+   if(theDynamicSchedulingFlag)
    {
+      theCurrentTileNumber = 0;
+   }
+   while(true)
+   {
+      if(theDynamicSchedulingFlag)
+      {
+         if((theCurrentTileNumber >= batchEnd) &&
+            !requestTiles(theCurrentTileNumber, batchEnd))
+         {
+            break;
+         }
+      }
+      else if(theCurrentTileNumber >= numberOfTiles)
+      {
+         break;
+      }
+
       ossimRefPtr<ossimImageData> data = ossimImageSourceSequencer::getTile(theCurrentTileNumber);
 
       // if the current send requests have looped around
@@ -161,6 +208,7 @@ void ossimImageMpiSWriterSequenceConnection::slaveProcessTiles()
       //
       errorValue = MPI_Wait(&requests[currentSendRequest], MPI_STATUS_IGNORE);
       requests[currentSendRequest] = MPI_REQUEST_NULL;
+      bool emptyFlag = false;
       if(data.valid() &&
          (data->getDataObjectStatus()!=OSSIM_NULL)&&
          (data->getDataObjectStatus()!=OSSIM_EMPTY))
@@ -198,21 +246,28 @@ void ossimImageMpiSWriterSequenceConnection::slaveProcessTiles()
             }
          }
          theOutputTile[currentSendRequest]->makeBlank();
+         emptyFlag = true;
       }
 
       void* buf = theOutputTile[currentSendRequest]->getBuf();
-      if((endian.getSystemEndianType()!=OSSIM_BIG_ENDIAN)&&
+      if(!emptyFlag &&
+         (endian.getSystemEndianType()!=OSSIM_BIG_ENDIAN)&&
          (theOutputTile[currentSendRequest]->getScalarType()!=OSSIM_UINT8))
       {
          endian.swap(theOutputTile[currentSendRequest]->getScalarType(),
                      buf,
                      theOutputTile[currentSendRequest]->getSize());
       }
+
+      //---
+      // Empty tiles go out as a single byte; the master sees the short
+      // message and blanks the tile itself.
+      //---
       errorValue = MPI_Isend(buf,
-                             theOutputTile[currentSendRequest]->getSizeInBytes(),
+                             (emptyFlag ? 1 : theOutputTile[currentSendRequest]->getSizeInBytes()),
                              MPI_UNSIGNED_CHAR,
                              0,
-                             0,
+                             ossimMpi::TILE_TAG,
                              MPI_COMM_WORLD,
                              &requests[currentSendRequest]);
 #if 0      
@@ -312,7 +367,14 @@ void ossimImageMpiSWriterSequenceConnection::slaveProcessTiles()
             break;
       }
 #endif
-      theCurrentTileNumber += (theNumberOfProcessors-1);
+      if(theDynamicSchedulingFlag)
+      {
+         ++theCurrentTileNumber;
+      }
+      else
+      {
+         theCurrentTileNumber += (theNumberOfProcessors-1);
+      }
       numberOfTilesSent++;
       currentSendRequest++;
       currentSendRequest %= theNumberOfTilesToBuffer;
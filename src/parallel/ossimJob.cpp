@@ -1,4 +1,24 @@
 #include <ossim/parallel/ossimJob.h>
+#include <ossim/base/ossimTimeline.h>
+#include <OpenThreads/Thread>
+#include <map>
+
+namespace
+{
+   typedef std::map<const OpenThreads::Thread*, ossimJob*> CurrentJobMap;
+
+   OpenThreads::Mutex& currentJobMutex()
+   {
+      static OpenThreads::Mutex mutex;
+      return mutex;
+   }
+
+   CurrentJobMap& currentJobs()
+   {
+      static CurrentJobMap jobs;
+      return jobs;
+   }
+}
 
 void ossimJob::setState(int value, bool on)
 {
@@ -58,3 +78,90 @@ void ossimJob::setState(int value, bool on)
       }
    }
 }
+
+ossimJob* ossimJob::setCurrentJob(ossimJob* job)
+{
+   const OpenThreads::Thread* thread = OpenThreads::Thread::CurrentThread();
+   ossimJob* previous = 0;
+   if(thread)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(currentJobMutex());
+      CurrentJobMap::iterator iter = currentJobs().find(thread);
+      if(iter != currentJobs().end())
+      {
+         previous = iter->second;
+         if(job)
+         {
+            iter->second = job;
+         }
+         else
+         {
+            currentJobs().erase(iter);
+         }
+      }
+      else if(job)
+      {
+         currentJobs().insert(std::make_pair(thread, job));
+      }
+   }
+   return previous;
+}
+
+bool ossimJob::isCurrentJobCanceled()
+{
+   const OpenThreads::Thread* thread = OpenThreads::Thread::CurrentThread();
+   if(!thread)
+   {
+      return false;
+   }
+   // The running thread holds a reference while the job is recorded.
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(currentJobMutex());
+   CurrentJobMap::const_iterator iter = currentJobs().find(thread);
+   return (iter != currentJobs().end()) && iter->second->isCanceled();
+}
+
+void ossimJob::markQueued()
+{
+   m_queuedTick   = ossimTimer::instance()->tick();
+   m_startedTick  = 0;
+   m_finishedTick = 0;
+   m_workerId     = -1;
+}
+
+void ossimJob::markStarted()
+{
+   OpenThreads::Thread* thread = OpenThreads::Thread::CurrentThread();
+   m_workerId    = thread ? thread->getThreadId() : -1;
+   m_startedTick = ossimTimer::instance()->tick();
+}
+
+void ossimJob::markFinished()
+{
+   m_finishedTick = ossimTimer::instance()->tick();
+
+   ossimTimeline* timeline = ossimTimeline::instance();
+   if ( timeline->isRecording() && timeline->isSampled(m_startedTick) )
+   {
+      const ossimString& jobName = name();
+      timeline->record(timeline->intern(jobName.empty() ? std::string("ossimJob") : jobName.string()),
+                       "job", m_startedTick, m_finishedTick);
+   }
+}
+
+double ossimJob::waitTime()const
+{
+   if(m_queuedTick && m_startedTick)
+   {
+      return ossimTimer::instance()->delta_s(m_queuedTick, m_startedTick);
+   }
+   return 0.0;
+}
+
+double ossimJob::runTime()const
+{
+   if(m_startedTick && m_finishedTick)
+   {
+      return ossimTimer::instance()->delta_s(m_startedTick, m_finishedTick);
+   }
+   return 0.0;
+}
@@ -1,4 +1,5 @@
 #include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <ossim/parallel/ossimThreadAffinity.h>
 
 ossimJobMultiThreadQueue::ossimJobMultiThreadQueue(ossimJobQueue* q, ossim_uint32 nThreads)
 :m_jobQueue(q?q:new ossimJobQueue())
@@ -36,6 +37,13 @@ void ossimJobMultiThreadQueue::setNumberOfThreads(ossim_uint32 nThreads)
       for(idx = queueSize; idx < nThreads;++idx)
       {
          ossimRefPtr<ossimJobThreadQueue> threadQueue = new ossimJobThreadQueue();
+
+         // Pin before setJobQueue starts the thread (see ossimThreadAffinity).
+         ossim_int32 cpu = ossimThreadAffinity::instance()->nextWorkerCpu();
+         if(cpu >= 0)
+         {
+            threadQueue->setProcessorAffinity(static_cast<unsigned int>(cpu));
+         }
          threadQueue->setJobQueue(m_jobQueue.get());
          m_threadQueueList.push_back(threadQueue);
       }
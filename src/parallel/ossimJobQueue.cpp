@@ -4,6 +4,7 @@
 
 
 ossimJobQueue::ossimJobQueue()
+   : m_statistics(new ossimJobStatistics())
 {
 }
 
@@ -27,8 +28,23 @@ void ossimJobQueue::add(ossimJob* job, bool guaranteeUniqueFlag)
       if(cb.valid()) cb->adding(this, job);
       
       job->ready();
+      job->markQueued();
       m_jobQueueMutex.lock();
-      m_jobQueue.push_back(job);
+
+      // Insert after the last job of equal or higher priority.
+      double priority = job->priority();
+      ossimJob::List::iterator iter = m_jobQueue.end();
+      while(iter != m_jobQueue.begin())
+      {
+         ossimJob::List::iterator previous = iter;
+         --previous;
+         if(!(priority > (*previous)->priority()))
+         {
+            break;
+         }
+         iter = previous;
+      }
+      m_jobQueue.insert(iter, job);
       m_jobQueueMutex.unlock();
    }
    if(cb.valid())
@@ -140,6 +156,40 @@ void ossimJobQueue::removeStoppedJobs()
    }
 }
 
+void ossimJobQueue::removeCanceledJobs()
+{
+   ossimJob::List removedJobs;
+   ossimRefPtr<Callback> cb;
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_jobQueueMutex);
+      cb = m_callback.get();
+      ossimJob::List::iterator iter = m_jobQueue.begin();
+      while(iter!=m_jobQueue.end())
+      {
+         if((*iter)->isCanceled())
+         {
+            removedJobs.push_back(*iter);
+            iter = m_jobQueue.erase(iter);
+         }
+         else 
+         {
+            ++iter;
+         }
+      }
+      m_block.set(!m_jobQueue.empty());
+   }
+   ossimJob::List::iterator iter = removedJobs.begin();
+   while(iter!=removedJobs.end())
+   {
+      (*iter)->finished();
+      if(cb.valid())
+      {
+         cb->removed(this, (*iter).get());
+      }
+      ++iter;
+   }
+}
+
 void ossimJobQueue::clear()
 {
    ossimJob::List removedJobs(m_jobQueue);
@@ -297,3 +347,8 @@ ossimJobQueue::Callback* ossimJobQueue::callback()
    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_jobQueueMutex);
    return m_callback.get();
 }
+
+ossimJobStatistics* ossimJobQueue::getStatistics()
+{
+   return m_statistics.get();
+}
@@ -0,0 +1,194 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Per job name wait and run time histograms for the job queues.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/parallel/ossimJobStatistics.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimPreferences.h>
+#include <OpenThreads/ScopedLock>
+#include <iostream>
+#include <sstream>
+
+// -1 until the preferences are read.
+static int enabledFlag = -1;
+
+ossimJobStatistics::Histogram::Histogram()
+   : m_count(0),
+     m_total(0.0),
+     m_max(0.0)
+{
+   for (ossim_uint32 i = 0; i < NUMBER_OF_BUCKETS; ++i)
+   {
+      m_buckets[i] = 0;
+   }
+}
+
+void ossimJobStatistics::Histogram::add(double seconds)
+{
+   ++m_count;
+   m_total += seconds;
+   if (seconds > m_max)
+   {
+      m_max = seconds;
+   }
+   ossim_uint64 us = (ossim_uint64)(seconds * 1.0e6);
+   ossim_uint32 bucket = 0;
+   while ( (us > 1) && (bucket < NUMBER_OF_BUCKETS - 1) )
+   {
+      us >>= 1;
+      ++bucket;
+   }
+   ++m_buckets[bucket];
+}
+
+ossimJobStatistics::ossimJobStatistics()
+   : m_mutex(),
+     m_entries()
+{
+}
+
+ossimJobStatistics::~ossimJobStatistics()
+{
+}
+
+ossimJobStatistics* ossimJobStatistics::instance()
+{
+   // Never released, so queues may still record during static destruction.
+   static ossimJobStatistics* statistics = 0;
+   static OpenThreads::Mutex instanceMutex;
+   if (!statistics)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(instanceMutex);
+      if (!statistics)
+      {
+         statistics = new ossimJobStatistics();
+         statistics->ref();
+      }
+   }
+   return statistics;
+}
+
+bool ossimJobStatistics::isEnabled()
+{
+   if (enabledFlag < 0)
+   {
+      const char* lookup = ossimPreferences::instance()->findPreference("job_statistics.enabled");
+      enabledFlag = ( lookup && ossimString(lookup).toBool() ) ? 1 : 0;
+   }
+   return (enabledFlag == 1);
+}
+
+void ossimJobStatistics::setEnabled(bool flag)
+{
+   enabledFlag = flag ? 1 : 0;
+}
+
+void ossimJobStatistics::record(const ossimJob* job)
+{
+   if (!job)
+   {
+      return;
+   }
+   ossimString name = job->name();
+   if (name.empty())
+   {
+      name = "unnamed";
+   }
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   Entry& entry = m_entries[name];
+   entry.m_wait.add(job->waitTime());
+   entry.m_run.add(job->runTime());
+   ++entry.m_workers[job->workerId()];
+}
+
+void ossimJobStatistics::recordFinished(ossimJobStatistics* queueStatistics, const ossimJob* job)
+{
+   if ( isEnabled() )
+   {
+      if (queueStatistics)
+      {
+         queueStatistics->record(job);
+      }
+      if (queueStatistics != instance())
+      {
+         instance()->record(job);
+      }
+   }
+}
+
+void ossimJobStatistics::clear()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   m_entries.clear();
+}
+
+std::map<ossimString, ossimJobStatistics::Entry> ossimJobStatistics::getEntries() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   return m_entries;
+}
+
+static void saveHistogram(ossimKeywordlist& kwl,
+                          const std::string& prefix,
+                          const ossimJobStatistics::Histogram& h,
+                          bool saveTotal)
+{
+   double mean = h.m_count ? (h.m_total / h.m_count) : 0.0;
+   kwl.add(prefix.c_str(), "mean_ms", mean * 1.0e3, true);
+   kwl.add(prefix.c_str(), "max_ms", h.m_max * 1.0e3, true);
+   if (saveTotal)
+   {
+      kwl.add(prefix.c_str(), "total_s", h.m_total, true);
+   }
+   std::ostringstream buckets;
+   for (ossim_uint32 i = 0; i < ossimJobStatistics::NUMBER_OF_BUCKETS; ++i)
+   {
+      if (h.m_buckets[i])
+      {
+         if (!buckets.str().empty()) buckets << " ";
+         buckets << ((ossim_uint64)1 << (i + 1)) << ":" << h.m_buckets[i];
+      }
+   }
+   kwl.add(prefix.c_str(), "histogram", buckets.str().c_str(), true);
+}
+
+bool ossimJobStatistics::saveState(ossimKeywordlist& kwl, const char* prefix) const
+{
+   std::map<ossimString, Entry> entries = getEntries();
+   std::string base = prefix ? prefix : "";
+   std::map<ossimString, Entry>::const_iterator iter = entries.begin();
+   while (iter != entries.end())
+   {
+      std::string name = base + iter->first.string() + ".";
+      kwl.add(name.c_str(), "count", iter->second.m_run.m_count, true);
+      saveHistogram(kwl, name + "wait.", iter->second.m_wait, false);
+      saveHistogram(kwl, name + "run.", iter->second.m_run, true);
+
+      std::ostringstream workers;
+      std::map<ossim_int32, ossim_uint64>::const_iterator w = iter->second.m_workers.begin();
+      while (w != iter->second.m_workers.end())
+      {
+         if (w != iter->second.m_workers.begin()) workers << " ";
+         workers << w->first << ":" << w->second;
+         ++w;
+      }
+      kwl.add(name.c_str(), "workers", workers.str().c_str(), true);
+      ++iter;
+   }
+   return true;
+}
+
+std::ostream& ossimJobStatistics::print(std::ostream& out) const
+{
+   ossimKeywordlist kwl;
+   saveState(kwl, "job_statistics.");
+   out << kwl;
+   return out;
+}
@@ -81,7 +81,15 @@ void ossimJobThreadQueue::run()
          if(job->isReady())
          {
             job->resetState(ossimJob::ossimJob_RUNNING);
+            ossimJob* previous = ossimJob::setCurrentJob(job.get());
+            job->markStarted();
             job->start();
+            job->markFinished();
+            ossimJob::setCurrentJob(previous);
+
+            ossimRefPtr<ossimJobQueue> queue = getJobQueue();
+            ossimJobStatistics::recordFinished(queue.valid() ? queue->getStatistics() : 0,
+                                               job.get());
          }
          {            
             OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_threadMutex);
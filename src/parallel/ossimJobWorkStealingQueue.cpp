@@ -0,0 +1,261 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/parallel/ossimJobWorkStealingQueue.h>
+#include <ossim/parallel/ossimThreadAffinity.h>
+#include <ossim/base/ossimCommon.h>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+
+//*************************************************************************************************
+// Worker thread, runs the queue's loop for its deque.
+//*************************************************************************************************
+class ossimJobWorkStealingQueue::Worker : public OpenThreads::Thread
+{
+public:
+   Worker(ossimJobWorkStealingQueue* queue, ossim_uint32 index)
+      : m_queue(queue), m_index(index)
+   {
+   }
+
+   virtual void run()
+   {
+      m_queue->run(m_index);
+   }
+
+private:
+   ossimJobWorkStealingQueue* m_queue;
+   ossim_uint32               m_index;
+};
+
+ossimJobWorkStealingQueue::ossimJobWorkStealingQueue(ossim_uint32 nThreads)
+   : m_deques(),
+     m_workers(),
+     m_nextDeque(0),
+     m_queued(0),
+     m_outstanding(0),
+     m_busy(0),
+     m_sleepers(0),
+     m_sleepMutex(),
+     m_workCondition(),
+     m_idleCondition(),
+     m_doneFlag(false),
+     m_statistics(new ossimJobStatistics())
+{
+   if (nThreads == 0)
+      nThreads = ossim::getNumberOfThreads();
+   if (nThreads == 0)
+      nThreads = 1;
+
+   // All deques must exist before the first worker looks for a job to steal.
+   for (ossim_uint32 i = 0; i < nThreads; ++i)
+      m_deques.push_back(new JobDeque());
+   for (ossim_uint32 i = 0; i < nThreads; ++i)
+   {
+      m_workers.push_back(new Worker(this, i));
+      ossim_int32 cpu = ossimThreadAffinity::instance()->nextWorkerCpu();
+      if (cpu >= 0)
+         m_workers[i]->setProcessorAffinity(static_cast<unsigned int>(cpu));
+   }
+   for (ossim_uint32 i = 0; i < nThreads; ++i)
+      m_workers[i]->start();
+}
+
+ossimJobWorkStealingQueue::~ossimJobWorkStealingQueue()
+{
+   clear();
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_sleepMutex);
+      m_doneFlag = true;
+      m_workCondition.broadcast();
+   }
+   for (ossim_uint32 i = 0; i < m_workers.size(); ++i)
+   {
+      m_workers[i]->join();
+      delete m_workers[i];
+   }
+   m_workers.clear();
+   for (ossim_uint32 i = 0; i < m_deques.size(); ++i)
+      delete m_deques[i];
+   m_deques.clear();
+}
+
+void ossimJobWorkStealingQueue::add(ossimJob* job)
+{
+   if (!job)
+      return;
+
+   job->ready();
+   job->markQueued();
+   ++m_outstanding;
+
+   ossim_int32 index = currentWorker();
+   if (index < 0)
+      index = (ossim_int32)( (++m_nextDeque) % m_deques.size() );
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_deques[index]->m_mutex);
+      m_deques[index]->m_jobs.push_back(job);
+   }
+
+   //---
+   // A worker going to sleep counts itself in m_sleepers before checking m_queued, so either it
+   // sees this job or we see it and signal it (under the mutex, so not before it waits).
+   //---
+   ++m_queued;
+   if (m_sleepers)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_sleepMutex);
+      m_workCondition.signal();
+   }
+}
+
+void ossimJobWorkStealingQueue::clear()
+{
+   for (ossim_uint32 i = 0; i < m_deques.size(); ++i)
+   {
+      std::deque< ossimRefPtr<ossimJob> > removed;
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_deques[i]->m_mutex);
+         removed.swap(m_deques[i]->m_jobs);
+      }
+      for (ossim_uint32 j = 0; j < removed.size(); ++j)
+      {
+         --m_queued;
+         jobDone();
+      }
+   }
+}
+
+void ossimJobWorkStealingQueue::waitForCompletion()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_sleepMutex);
+   while (m_outstanding != 0)
+      m_idleCondition.wait(&m_sleepMutex);
+}
+
+bool ossimJobWorkStealingQueue::hasJobsToProcess() const
+{
+   return (m_outstanding != 0);
+}
+
+ossim_uint32 ossimJobWorkStealingQueue::numberOfBusyThreads() const
+{
+   return m_busy;
+}
+
+ossim_uint32 ossimJobWorkStealingQueue::getNumberOfThreads() const
+{
+   return (ossim_uint32) m_workers.size();
+}
+
+ossimJobStatistics* ossimJobWorkStealingQueue::getStatistics()
+{
+   return m_statistics.get();
+}
+
+void ossimJobWorkStealingQueue::run(ossim_uint32 index)
+{
+   while (!m_doneFlag)
+   {
+      ossimRefPtr<ossimJob> job = popJob(index);
+      if (!job.valid())
+         job = stealJob(index);
+
+      if (job.valid())
+      {
+         --m_queued;
+         ++m_busy;
+         runJob(job.get());
+         --m_busy;
+         job = 0;
+         jobDone();
+      }
+      else
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_sleepMutex);
+         ++m_sleepers;
+         if (!m_doneFlag && (m_queued == 0))
+            m_workCondition.wait(&m_sleepMutex);
+         --m_sleepers;
+      }
+   }
+}
+
+ossimRefPtr<ossimJob> ossimJobWorkStealingQueue::popJob(ossim_uint32 index)
+{
+   ossimRefPtr<ossimJob> job;
+   JobDeque* d = m_deques[index];
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(d->m_mutex);
+   if (!d->m_jobs.empty())
+   {
+      job = d->m_jobs.back();
+      d->m_jobs.pop_back();
+   }
+   return job;
+}
+
+ossimRefPtr<ossimJob> ossimJobWorkStealingQueue::stealJob(ossim_uint32 thief)
+{
+   ossimRefPtr<ossimJob> job;
+   const ossim_uint32 N = (ossim_uint32) m_deques.size();
+   for (ossim_uint32 i = 1; (i < N) && !job.valid(); ++i)
+   {
+      JobDeque* d = m_deques[(thief + i) % N];
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(d->m_mutex);
+      if (!d->m_jobs.empty())
+      {
+         job = d->m_jobs.front();
+         d->m_jobs.pop_front();
+      }
+   }
+   return job;
+}
+
+void ossimJobWorkStealingQueue::runJob(ossimJob* job)
+{
+   // Same state handling as ossimJobQueue::nextJob and ossimJobThreadQueue::run:
+   if (job->isCanceled())
+   {
+      job->finished();
+      return;
+   }
+   if (job->isReady())
+   {
+      job->resetState(ossimJob::ossimJob_RUNNING);
+      ossimJob* previous = ossimJob::setCurrentJob(job);
+      job->markStarted();
+      job->start();
+      job->markFinished();
+      ossimJob::setCurrentJob(previous);
+      ossimJobStatistics::recordFinished(m_statistics.get(), job);
+   }
+   job->setState(ossimJob::ossimJob_FINISHED);
+}
+
+void ossimJobWorkStealingQueue::jobDone()
+{
+   if ((--m_outstanding) == 0)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_sleepMutex);
+      m_idleCondition.broadcast();
+   }
+}
+
+ossim_int32 ossimJobWorkStealingQueue::currentWorker() const
+{
+   OpenThreads::Thread* current = OpenThreads::Thread::CurrentThread();
+   if (current)
+   {
+      for (ossim_uint32 i = 0; i < m_workers.size(); ++i)
+      {
+         if (m_workers[i] == current)
+            return (ossim_int32) i;
+      }
+   }
+   return -1;
+}
@@ -15,7 +15,9 @@
 #include <ossim/parallel/ossimMultiThreadSequencer.h>
 #include <ossim/parallel/ossimMtDebug.h>
 #include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossimTimer.h>
+#include <ossim/imaging/ossimImageDataAccounting.h>
 
 static const ossim_uint32 DEFAULT_MAX_TILE_CACHE_FACTOR = 8; // Must be > 1
 
@@ -53,15 +55,16 @@ void ossimMultiThreadSequencer::ossimGetTileJob::start()
       }
       dt = ossimTimer::instance()->time_s() - dt; //###
 
-      // Give the sequencer the tile. Execution may pause here while waiting for space to free up
-      // if the cache is full.
+      // Give the sequencer the tile. Its slot in the output window is free since the job was only
+      // launched once there was room:
       m_sequencer.setTileInCache(m_tileID, (ossimImageData*)tile->dup(), m_chainID, dt);
    }
 
    // Unblock the main thread which might be blocked waiting for jobs to finish:
    m_sequencer.m_getTileBlock.release();
 
-   // Queue the next job using this job's freed-up image chain:
+   // Queue the next job using this job's freed-up image chain (or park the chain if the output
+   // window is full):
    if (t_launchNewJob)
       m_sequencer.nextJob(m_chainID);
 
@@ -96,14 +99,17 @@ ossimMultiThreadSequencer::ossimMultiThreadSequencer(ossimImageSource* input,
    m_numThreads (num_threads),
    m_callback(new ossimGetTileCallback()),
    m_nextTileID (0),
-   m_tileCache(),                       
+   m_tileRing(),
+   m_ringHead(0),
+   m_ringCount(0),
+   m_idleChains(),
+   m_orderedFlag(true),
    m_maxCacheSize (DEFAULT_MAX_TILE_CACHE_FACTOR * num_threads),
    m_maxTileCacheFactor (DEFAULT_MAX_TILE_CACHE_FACTOR),
+   m_outputWindow(0),
    m_cacheMutex(),
-   m_jobMutex(),
    m_totalNumberOfTiles(0),
    m_getTileBlock(),
-   m_nextJobBlock(),
    d_printMutex(),
    d_timerMutex(),                                 
    d_debugEnabled(false),
@@ -120,10 +126,13 @@ ossimMultiThreadSequencer::ossimMultiThreadSequencer(ossimImageSource* input,
    d_timeMetricsEnabled = mt_debug->seqMetricsEnabled;
    //###### END DEBUG ############
 
+   const char* lookup = ossimPreferences::instance()->findPreference("sequencer.output_window");
+   if (lookup)
+      m_outputWindow = ossimString(lookup).toUInt32();
+
    // The base-class' initialize() method should have been called by the base class constructor
    // unless somebody moved it!
    OpenThreads::Thread::Init();
-   m_nextJobBlock.release();
    m_getTileBlock.release();
    ossimTimer::instance()->setStartTick();
 }
@@ -140,8 +149,18 @@ ossimMultiThreadSequencer::~ossimMultiThreadSequencer()
 //*************************************************************************************************
 void ossimMultiThreadSequencer::setToStartOfSequence()
 {
+   // Stop the jobs of a previous sequence first since they write to the output window. Workers
+   // check m_jobMtQueue under the cache mutex before queuing a job:
+   ossimRefPtr<ossimJobWorkStealingQueue> previousQueue;
+   m_cacheMutex.lock();
+   previousQueue = m_jobMtQueue;
+   m_jobMtQueue = 0;
+   m_cacheMutex.unlock();
+   previousQueue = 0; // Waits for its running jobs.
+
    // Reset important indices:
    theCurrentTileNumber = 0;
+   thePrefetchEnd = 0;
    m_nextTileID = 0;
    m_totalNumberOfTiles = theNumberOfTilesHorizontal * theNumberOfTilesVertical;
 
@@ -156,6 +175,18 @@ void ossimMultiThreadSequencer::setToStartOfSequence()
       m_maxCacheSize = m_maxTileCacheFactor * m_numThreads;
    }
 
+   // Size the output window. The first tiles fetched below plus one job per chain must fit:
+   if (m_outputWindow)
+      m_maxCacheSize = m_outputWindow;
+   if (m_maxCacheSize < 2 * m_numThreads)
+      m_maxCacheSize = 2 * m_numThreads;
+   m_tileRing.clear();
+   m_tileRing.resize(m_maxCacheSize);
+   m_ringHead = 0;
+   m_ringCount = 0;
+   m_idleChains.clear();
+   m_orderedFlag = theOrderedOutputFlag;
+
    // Adapt the input source to be an ossimImageChainMtAdaptor since we can only work
    // with this type:
    m_inputChain = dynamic_cast<ossimImageChainMtAdaptor*>(theInputConnection);
@@ -181,6 +212,11 @@ void ossimMultiThreadSequencer::setToStartOfSequence()
 
    // Set the output of the chain to be this sequencer:
    m_inputChain->disconnectAllOutputs();
+
+   // Hint the handlers of the adapted chain about the tiles the first jobs will fetch:
+   findPrefetchHandlers(m_inputChain.get());
+   if (thePrefetchTiles)
+      prefetchTiles(0, m_maxCacheSize + thePrefetchTiles, 0);
    //connectMyInputTo(m_inputChain.get());
    //setAreaOfInterest(m_inputChain->getBoundingRect());
 
@@ -195,25 +231,22 @@ void ossimMultiThreadSequencer::setToStartOfSequence()
 
    // Set up the job queue and fill it with first N jobs:
    ossim_uint32 num_jobs_to_launch =  min<ossim_uint32>(m_numThreads, m_totalNumberOfTiles);
-   ossimRefPtr<ossimJobQueue> jobQueue = new ossimJobQueue();
+   // Each worker queues the follow-on job of the tile it just fetched on its own deque (see
+   // nextJob()), so the workers do not contend on a shared job list:
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_cacheMutex);
+   m_jobMtQueue = new ossimJobWorkStealingQueue(num_jobs_to_launch);
    for (ossim_uint32 chain_id=0; chain_id<num_jobs_to_launch; ++chain_id)
    {
+      if (m_nextTileID >= m_totalNumberOfTiles)
+         break;
       if (d_debugEnabled)
       {
          ostringstream s;
          s<<"setToStartOfSequence() -- Creating tile/job #"<<m_nextTileID;
          print(s);
       }
-
-      ossimGetTileJob* job = new ossimGetTileJob(m_nextTileID++, chain_id, *this);
-      job->setCallback(m_callback.get());
-      jobQueue->add(job, false);
+      launchJob(chain_id);
    }
-
-   // Initialize the multi-thread queue. Note the setQueue is done after construction as it was 
-   // crashing do to jobs being launched during init:
-   m_jobMtQueue = new ossimJobMultiThreadQueue(0, num_jobs_to_launch);
-   m_jobMtQueue->setQueue(jobQueue.get());
 }
 
 
@@ -237,45 +270,77 @@ ossimRefPtr<ossimImageData> ossimMultiThreadSequencer::getNextTile(ossim_uint32
       return tile;
    }
 
+   // Jobs run up to a cache's worth of tiles ahead of the caller. Keep the hints ahead of them:
+   if (thePrefetchTiles)
+   {
+      prefetchTiles(theCurrentTileNumber + m_maxCacheSize,
+                    theCurrentTileNumber + m_maxCacheSize + thePrefetchTiles, 0);
+   }
+
    // May need to wait until the corresponding job is finished if the tile is not in the cache:
-   TileCache::iterator tile_iter = m_tileCache.begin();
+   const ossim_uint32 WINDOW = (ossim_uint32) m_tileRing.size();
    while (!tile.valid()) 
    {
-      // If the tile is not yet copied into the cache, it means the job is still running. Let's 
-      // block this thread and let the getTile jobs unlock as they finish. We'll exit this loop
-      // when the job of interest finishes.
+      // Reset before looking so that a job finishing in between still releases the block:
+      m_getTileBlock.reset();
+
       if (d_timeMetricsEnabled)
          d_t1 = ossimTimer::instance()->time_s(); 
       m_cacheMutex.lock();
       if (d_timeMetricsEnabled)
          d_idleTime1 += ossimTimer::instance()->time_s() - d_t1; 
 
-      tile_iter = m_tileCache.find(theCurrentTileNumber);
-      m_cacheMutex.unlock();
+      if (m_orderedFlag)
+      {
+         ossim_uint32 slot = (ossim_uint32) (theCurrentTileNumber % WINDOW);
+         tile = m_tileRing[slot];
+         m_tileRing[slot] = 0;
+      }
+      else if (m_ringCount)
+      {
+         // Unordered: take the oldest tile finished, whatever its ID:
+         tile = m_tileRing[m_ringHead];
+         m_tileRing[m_ringHead] = 0;
+         m_ringHead = (m_ringHead + 1) % WINDOW;
+      }
+
+      if (tile.valid())
+      {
+         if (d_debugEnabled)
+         {
+            ostringstream s2;
+            s2<<"getNextTile() -- Copying tile #"<<theCurrentTileNumber<<".  Cache size: "<<m_ringCount;
+            print(s2);
+         }
+         --m_ringCount;
+         if (m_ringCount == 0) 
+            ++d_cacheEmptyCount; 
 
-      if (tile_iter == m_tileCache.end())
+         // Advance the caller-requested tile count. This is different from the last threaded
+         // getTile()'s tile index maintained in m_nextTileID. The window moved, relaunch the chains
+         // waiting on it:
+         ++theCurrentTileNumber;
+         launchIdleChains();
+         m_cacheMutex.unlock();
+      }
+      else
       {
+         // If the tile is not yet copied into the cache, it means the job is still running. Let's 
+         // block this thread and let the getTile jobs unlock as they finish. We'll exit this loop
+         // when the job of interest finishes.
          if (d_debugEnabled)
          {
             ostringstream s1;
-            s1<<"getNextTile() -- Waiting on tile #"<<theCurrentTileNumber;
-            m_cacheMutex.lock();
-            s1<<"\n   cache size = "<<m_tileCache.size();
-            TileCache::iterator iter = m_tileCache.begin();
-            while(iter != m_tileCache.end())
-            {
-               s1<<"\n   cache.tile_id = "<<iter->first;
-               iter++;
-            }
-            m_cacheMutex.unlock();
+            s1<<"getNextTile() -- Waiting on tile #"<<theCurrentTileNumber
+              <<"\n   cache size = "<<m_ringCount;
             print(s1);
          }
+         m_cacheMutex.unlock();
 
          if (d_timedBlocksDt > 0)
             m_getTileBlock.block(d_timedBlocksDt); 
          else
          {
-            m_getTileBlock.reset();
             if (d_timeMetricsEnabled)
                d_t1 = ossimTimer::instance()->time_s(); 
             m_getTileBlock.block();
@@ -283,38 +348,21 @@ ossimRefPtr<ossimImageData> ossimMultiThreadSequencer::getNextTile(ossim_uint32
                d_idleTime2 += ossimTimer::instance()->time_s() - d_t1; 
          }
       }
-      else
-      {
-         // A valid tile was found. Need to assign the output tile and free up the reference in the
-         // cache:
-         if (d_debugEnabled)
-         {
-            ostringstream s2;
-            s2<<"getNextTile() -- Copying tile #"<<theCurrentTileNumber<<".  Cache size: "<<m_tileCache.size();
-            print(s2);
-         }
-         tile = tile_iter->second;
-         
-         if (d_timeMetricsEnabled)
-            d_t1 = ossimTimer::instance()->time_s(); 
-         m_cacheMutex.lock();
-         m_tileCache.erase(tile_iter);
-         m_cacheMutex.unlock();
-         if (d_timeMetricsEnabled)
-            d_idleTime3 += ossimTimer::instance()->time_s() - d_t1; 
-
-         if (m_tileCache.empty()) 
-            ++d_cacheEmptyCount; 
-         m_nextJobBlock.release(); // nextJob() may be blocked until cache space is freed
-      }
    }
 
-   // Advance the caller-requested tile ID. This is different from the last threaded getTile()'s
-   // tile index maintained in m_nextTileID and advanced in initNextJob():
-   ++theCurrentTileNumber;
    return tile;
 }
 
+//*************************************************************************************************
+// Sets the number of tiles that may be in flight ahead of the caller, 0 for the default.
+//*************************************************************************************************
+void ossimMultiThreadSequencer::setOutputWindow(ossim_uint32 tiles)
+{
+   m_outputWindow = tiles;
+   if (m_outputWindow == 0)
+      m_maxCacheSize = m_maxTileCacheFactor * m_numThreads;
+}
+
 //*************************************************************************************************
 // Specifies number of thread to support. Default behavior (if this method is never called) is
 // query the system for number of cores available.
@@ -328,7 +376,7 @@ void ossimMultiThreadSequencer::setNumberOfThreads(ossim_uint32 num_threads)
       m_inputChain->setNumberOfThreads(num_threads);
 
    if (m_jobMtQueue.valid() && m_jobMtQueue->hasJobsToProcess())
-      m_jobMtQueue->getJobQueue()->clear();
+      m_jobMtQueue->clear();
 
    m_nextTileID = 0; // effectively resets this sequencer
 }
@@ -350,56 +398,51 @@ void ossimMultiThreadSequencer::setTileInCache(ossim_uint32 tile_id,
 
    d_jobGetTileT += dt;
 
-   m_tileCache[tile_id] = tile;
+   const ossim_uint32 WINDOW = (ossim_uint32) m_tileRing.size();
+   if (m_orderedFlag)
+      m_tileRing[tile_id % WINDOW] = tile;
+   else
+      m_tileRing[(m_ringHead + m_ringCount) % WINDOW] = tile;
+   ++m_ringCount;
    if (d_debugEnabled)
    {
       ostringstream s2;
       s2<<"THREAD #"<<chain_id<<" -- setTileInCache() Wrote tile #"<<tile_id;
       print(s2);
    }
-   if (d_maxCacheUsed < m_tileCache.size())
-      d_maxCacheUsed = (ossim_uint32) m_tileCache.size();
+   if (d_maxCacheUsed < m_ringCount)
+      d_maxCacheUsed = m_ringCount;
 }
 
 //*************************************************************************************************
-// Queues up the next getTile job if cache is not full. This is called as soon as the job
+// Queues up the next getTile job if the output window has room. This is called as soon as the job
 // handling the corresponding chain ID is finished.
 //*************************************************************************************************
 void ossimMultiThreadSequencer::nextJob(ossim_uint32 chain_id)
 {
-   // Check for end of sequence:
-   if (m_nextTileID >= m_totalNumberOfTiles)
+   if (d_timeMetricsEnabled)
+      d_t1 = ossimTimer::instance()->time_s(); 
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_cacheMutex);
+   if (d_timeMetricsEnabled)
+      d_idleTime6 += ossimTimer::instance()->time_s() - d_t1; 
+
+   // Check for end of sequence (or of the queue, see setToStartOfSequence()):
+   if (!m_jobMtQueue.valid() || (m_nextTileID >= m_totalNumberOfTiles))
       return;
 
-   while (((ossim_uint32) m_tileCache.size()) >= m_maxCacheSize)
+   if (!windowHasRoom())
    {
+      // The window is full. Rather than holding this worker until the caller takes a tile, park
+      // the chain; getNextTile() relaunches it:
       if (d_debugEnabled)
       {
-         m_cacheMutex.lock();
-         TileCache::const_iterator iter = m_tileCache.begin();
          ostringstream s1;
-         s1<<"THREAD #"<<chain_id<<" -- nextJob() Waiting on cache before queuing tile/job #"
-            <<m_nextTileID<<"using chain #"<<chain_id<<". Cache size: "<<m_tileCache.size();
-         while(iter != m_tileCache.end())
-         {
-            s1<<"\n   cache.tile_id = "<<iter->first;
-            iter++;
-         }
-         m_cacheMutex.unlock();
+         s1<<"THREAD #"<<chain_id<<" -- nextJob() Window full before queuing tile/job #"
+            <<m_nextTileID<<". Cache size: "<<m_ringCount;
          print(s1);
       }
-
-      if (d_timedBlocksDt > 0)
-         m_nextJobBlock.block(d_timedBlocksDt);
-      else
-      {
-         m_nextJobBlock.reset();
-         if (d_timeMetricsEnabled)
-            d_t1 = ossimTimer::instance()->time_s(); 
-         m_nextJobBlock.block();
-         if (d_timeMetricsEnabled)
-         d_idleTime5 += ossimTimer::instance()->time_s() - d_t1; 
-      }
+      m_idleChains.push_back(chain_id);
+      return;
    }
 
    if (d_debugEnabled)
@@ -408,17 +451,49 @@ void ossimMultiThreadSequencer::nextJob(ossim_uint32 chain_id)
       s2<<"THREAD #"<<chain_id<<" -- nextJob() Queuing tile/job #"<<m_nextTileID;
       print(s2);
    }
+   launchJob(chain_id);
+}
 
-   // Job queue will receive pointer into ossimRefPtr so no leak here:
-   if (d_timeMetricsEnabled)
-      d_t1 = ossimTimer::instance()->time_s(); 
-   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_jobMutex);
-   if (d_timeMetricsEnabled)
-      d_idleTime6 += ossimTimer::instance()->time_s() - d_t1; 
+//*************************************************************************************************
+// Relaunches the chains parked by nextJob() while the window has room. Called with the cache
+// mutex locked.
+//*************************************************************************************************
+void ossimMultiThreadSequencer::launchIdleChains()
+{
+   if (!m_jobMtQueue.valid())
+      return;
+
+   while (!m_idleChains.empty() &&
+          (m_nextTileID < m_totalNumberOfTiles) &&
+          windowHasRoom())
+   {
+      ossim_uint32 chain_id = m_idleChains.back();
+      m_idleChains.pop_back();
+      launchJob(chain_id);
+   }
+}
+
+//*************************************************************************************************
+// True if tile m_nextTileID may be launched. Over the ossimImageData memory budget only the tile
+// the caller waits for is, so the tiles in flight drain to one. Called with the cache mutex locked.
+//*************************************************************************************************
+bool ossimMultiThreadSequencer::windowHasRoom() const
+{
+   if (m_nextTileID >= theCurrentTileNumber + m_maxCacheSize)
+      return false;
+   return (m_nextTileID <= theCurrentTileNumber) ||
+          !ossimImageDataAccounting::instance()->isOverBudget();
+}
 
+//*************************************************************************************************
+// Queues the job for tile m_nextTileID on chain_id. Called with the cache mutex locked.
+//*************************************************************************************************
+void ossimMultiThreadSequencer::launchJob(ossim_uint32 chain_id)
+{
+   // Job queue will receive pointer into ossimRefPtr so no leak here:
    ossimGetTileJob* job = new ossimGetTileJob(m_nextTileID++, chain_id, *this);
    job->setCallback(m_callback.get());
-   m_jobMtQueue->getJobQueue()->add(job);
+   m_jobMtQueue->add(job);
 }
 
 //*************************************************************************************************
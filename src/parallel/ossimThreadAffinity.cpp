@@ -0,0 +1,202 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Cpu affinity and NUMA node placement of the job queue worker threads.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/parallel/ossimThreadAffinity.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <fstream>
+#include <sstream>
+
+#if defined(__linux__)
+#  include <sched.h>
+#endif
+
+static const ossim_uint32 MAX_NODES = 64;
+
+ossimThreadAffinity* ossimThreadAffinity::m_instance = 0;
+
+// Parses a cpu list such as "0-7,16-23" (sysfs and taskset format).
+static void parseCpuList(const std::string& list, std::vector<ossim_int32>& cpus)
+{
+   std::istringstream in(list);
+   std::string range;
+   while ( std::getline(in, range, ',') )
+   {
+      ossimString r = ossimString(range).trim();
+      if ( r.empty() )
+      {
+         continue;
+      }
+      std::vector<ossimString> bounds = r.split("-");
+      if ( bounds.empty() )
+      {
+         continue;
+      }
+      ossim_int32 first = bounds[0].toInt32();
+      ossim_int32 last  = (bounds.size() > 1) ? bounds[1].toInt32() : first;
+      for (ossim_int32 cpu = first; cpu <= last; ++cpu)
+      {
+         cpus.push_back(cpu);
+      }
+   }
+}
+
+ossimThreadAffinity* ossimThreadAffinity::instance()
+{
+   static OpenThreads::Mutex instanceMutex;
+   if (!m_instance)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(instanceMutex);
+      if (!m_instance)
+      {
+         m_instance = new ossimThreadAffinity();
+      }
+   }
+   return m_instance;
+}
+
+ossimThreadAffinity::ossimThreadAffinity()
+   : m_cpuNodes(),
+     m_cpus(),
+     m_numberOfNodes(1),
+     m_nextWorker(0)
+{
+   ossim_uint32 numberOfCpus = (ossim_uint32)OpenThreads::GetNumberOfProcessors();
+   if (!numberOfCpus)
+   {
+      numberOfCpus = 1;
+   }
+   readNodes(numberOfCpus);
+
+   ossimString policy;
+   const char* lookup = ossimPreferences::instance()->findPreference("thread_affinity");
+   if (lookup)
+   {
+      policy = ossimString(lookup).downcase().trim();
+   }
+   if ( (policy != "compact") && (policy != "scatter") )
+   {
+      return; // Off.
+   }
+
+   std::vector<ossim_int32> cpus;
+   lookup = ossimPreferences::instance()->findPreference("thread_affinity.cpus");
+   if (lookup)
+   {
+      parseCpuList(std::string(lookup), cpus);
+   }
+   if (cpus.empty())
+   {
+      for (ossim_uint32 cpu = 0; cpu < numberOfCpus; ++cpu)
+      {
+         cpus.push_back((ossim_int32)cpu);
+      }
+   }
+
+   // Group the cpus by node, keeping the given order within a node.
+   std::vector< std::vector<ossim_int32> > byNode(m_numberOfNodes);
+   for (ossim_uint32 i = 0; i < cpus.size(); ++i)
+   {
+      if ( (cpus[i] >= 0) && ((ossim_uint32)cpus[i] < numberOfCpus) )
+      {
+         byNode[getNode(cpus[i])].push_back(cpus[i]);
+      }
+   }
+
+   if (policy == "compact")
+   {
+      for (ossim_uint32 node = 0; node < byNode.size(); ++node)
+      {
+         m_cpus.insert(m_cpus.end(), byNode[node].begin(), byNode[node].end());
+      }
+   }
+   else
+   {
+      bool added = true;
+      for (ossim_uint32 i = 0; added; ++i)
+      {
+         added = false;
+         for (ossim_uint32 node = 0; node < byNode.size(); ++node)
+         {
+            if (i < byNode[node].size())
+            {
+               m_cpus.push_back(byNode[node][i]);
+               added = true;
+            }
+         }
+      }
+   }
+}
+
+void ossimThreadAffinity::readNodes(ossim_uint32 numberOfCpus)
+{
+   m_cpuNodes.assign(numberOfCpus, 0);
+   m_numberOfNodes = 1;
+#if defined(__linux__)
+   for (ossim_uint32 node = 0; node < MAX_NODES; ++node)
+   {
+      std::ostringstream path;
+      path << "/sys/devices/system/node/node" << node << "/cpulist";
+      std::ifstream in(path.str().c_str());
+      if (!in)
+      {
+         continue; // Node ids may have holes.
+      }
+      std::string list;
+      std::getline(in, list);
+      std::vector<ossim_int32> cpus;
+      parseCpuList(list, cpus);
+      for (ossim_uint32 i = 0; i < cpus.size(); ++i)
+      {
+         if ( (cpus[i] >= 0) && ((ossim_uint32)cpus[i] < numberOfCpus) )
+         {
+            m_cpuNodes[cpus[i]] = node;
+         }
+      }
+      if (node + 1 > m_numberOfNodes)
+      {
+         m_numberOfNodes = node + 1;
+      }
+   }
+#endif
+}
+
+ossim_int32 ossimThreadAffinity::nextWorkerCpu()
+{
+   if (m_cpus.empty())
+   {
+      return -1;
+   }
+   ossim_uint32 worker = (++m_nextWorker) - 1;
+   return m_cpus[worker % m_cpus.size()];
+}
+
+ossim_uint32 ossimThreadAffinity::getNode(ossim_int32 cpu) const
+{
+   if ( (cpu >= 0) && ((ossim_uint32)cpu < m_cpuNodes.size()) )
+   {
+      return m_cpuNodes[cpu];
+   }
+   return 0;
+}
+
+ossim_uint32 ossimThreadAffinity::getCurrentNode() const
+{
+#if defined(__linux__)
+   if (m_numberOfNodes > 1)
+   {
+      return getNode(sched_getcpu());
+   }
+#endif
+   return 0;
+}
@@ -15,12 +15,19 @@
 #include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/plugin/ossimSharedObjectBridge.h>
+#include <OpenThreads/ScopedLock>
 
 //ossimSharedPluginRegistry* ossimSharedPluginRegistry::theInstance = NULL;
 //ossimPluginBridgeStructure ossimSharedPluginRegistry::thePluginBridgeFactoryPointers;
 
 static ossimTrace traceDebug("ossimSharedPluginRegistry:debug");
 
+const char* ossimSharedPluginRegistry::MANIFEST_DESCRIPTION_KW = "description";
+const char* ossimSharedPluginRegistry::MANIFEST_EXTENSIONS_KW  = "extensions";
+const char* ossimSharedPluginRegistry::MANIFEST_PROJECTIONS_KW = "projections";
+const char* ossimSharedPluginRegistry::MANIFEST_UTILITIES_KW   = "utilities";
+const char* ossimSharedPluginRegistry::MANIFEST_CLASSES_KW     = "classes";
+
 ossimSharedPluginRegistry::ossimSharedPluginRegistry()
 {
 }
@@ -39,6 +46,7 @@ ossimSharedPluginRegistry* ossimSharedPluginRegistry::instance()
 
 bool ossimSharedPluginRegistry::registerPlugin(const ossimFilename& filename, const ossimString& options)//, bool insertFrontFlag)
 {
+   OpenThreads::ScopedLock<OpenThreads::ReentrantMutex> lock(theMutex);
    bool result = false;
    if(!getPlugin(filename))
    {
@@ -204,6 +212,133 @@ bool ossimSharedPluginRegistry::isLoaded(const ossimFilename& filename) const
    return result;
 }
 
+ossimFilename ossimSharedPluginRegistry::getManifestFilename(const ossimFilename& plugin)
+{
+   ossimFilename result = plugin;
+   result.setExtension("manifest");
+   return result;
+}
+
+bool ossimSharedPluginRegistry::registerDeferredPlugin(const ossimFilename& filename,
+                                                       const ossimString& options)
+{
+   OpenThreads::ScopedLock<OpenThreads::ReentrantMutex> lock(theMutex);
+   if ( getPlugin(filename) )
+   {
+      return false;
+   }
+   const ossimFilename FILE_ONLY = filename.file();
+   for (ossim_uint32 idx = 0; idx < theDeferredList.size(); ++idx)
+   {
+      if ( FILE_ONLY == theDeferredList[idx].theFilename.file() )
+      {
+         return true; // Already deferred, e.g. listed twice in preferences.
+      }
+   }
+
+   ossimKeywordlist manifest;
+   const ossimFilename MANIFEST = getManifestFilename(filename);
+   if ( !MANIFEST.isFile() || !manifest.addFile(MANIFEST) )
+   {
+      return false;
+   }
+
+   DeferredPlugin plugin;
+   plugin.theFilename    = filename;
+   plugin.theOptions     = options;
+   plugin.theDescription = ossimString(manifest.find(MANIFEST_DESCRIPTION_KW));
+
+   const char* KEYS[] = { MANIFEST_EXTENSIONS_KW, MANIFEST_PROJECTIONS_KW,
+                          MANIFEST_UTILITIES_KW,  MANIFEST_CLASSES_KW, 0 };
+   for (const char** key = KEYS; *key; ++key)
+   {
+      std::vector<ossimString> values;
+      ossimString(manifest.find(*key)).split(values, " \t", true);
+      std::set<ossimString>& provides = plugin.theProvides[*key];
+      for (ossim_uint32 idx = 0; idx < values.size(); ++idx)
+      {
+         provides.insert(values[idx].downcase());
+      }
+   }
+   theDeferredList.push_back(plugin);
+
+   if (traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimSharedPluginRegistry DEBUG: deferred " << filename << std::endl;
+   }
+   return true;
+}
+
+bool ossimSharedPluginRegistry::loadDeferredPlugins(const ossimString& key,
+                                                    const ossimString& value)
+{
+   return loadDeferred(key, value.downcase());
+}
+
+bool ossimSharedPluginRegistry::loadAllDeferredPlugins()
+{
+   return loadDeferred(ossimString(), ossimString());
+}
+
+bool ossimSharedPluginRegistry::loadDeferred(const ossimString& key, const ossimString& value)
+{
+   OpenThreads::ScopedLock<OpenThreads::ReentrantMutex> lock(theMutex);
+   if ( theDeferredList.empty() )
+   {
+      return false;
+   }
+
+   //---
+   // Plugins are taken off the list before loading so the lookups of a
+   // plugin's own initialization do not load it again.
+   //---
+   std::vector<DeferredPlugin> toLoad;
+   std::vector<DeferredPlugin>::iterator iter = theDeferredList.begin();
+   while ( iter != theDeferredList.end() )
+   {
+      bool matches = key.empty();
+      if ( !matches )
+      {
+         std::map<ossimString, std::set<ossimString> >::const_iterator provides =
+            iter->theProvides.find(key);
+         matches = (provides != iter->theProvides.end()) &&
+            (provides->second.find(value) != provides->second.end());
+      }
+      if ( matches )
+      {
+         toLoad.push_back(*iter);
+         iter = theDeferredList.erase(iter);
+      }
+      else
+      {
+         ++iter;
+      }
+   }
+
+   bool result = false;
+   for (ossim_uint32 idx = 0; idx < toLoad.size(); ++idx)
+   {
+      if (traceDebug())
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << "ossimSharedPluginRegistry DEBUG: loading " << toLoad[idx].theFilename
+            << " for " << (key.empty() ? ossimString("all") : key + " " + value) << std::endl;
+      }
+      if ( registerPlugin(toLoad[idx].theFilename, toLoad[idx].theOptions) )
+      {
+         result = true;
+      }
+   }
+   return result;
+}
+
+ossim_uint32 ossimSharedPluginRegistry::getNumberOfDeferredPlugins()const
+{
+   OpenThreads::ScopedLock<OpenThreads::ReentrantMutex> lock(theMutex);
+   return (ossim_uint32)theDeferredList.size();
+}
+
 void ossimSharedPluginRegistry::printAllPluginInformation(std::ostream& out)
 {
    ossim_uint32 count = getNumberOfPlugins();
@@ -226,4 +361,28 @@ void ossimSharedPluginRegistry::printAllPluginInformation(std::ostream& out)
          out << "\n";
       }
    }
+
+   // Deferred plugins as told by their manifests:
+   OpenThreads::ScopedLock<OpenThreads::ReentrantMutex> lock(theMutex);
+   for(idx = 0; idx < theDeferredList.size(); ++idx)
+   {
+      const DeferredPlugin& plugin = theDeferredList[idx];
+      out << "Plugin: " << plugin.theFilename << " (not loaded)" << std::endl;
+      out << "DESCRIPTION: \n";
+      out << plugin.theDescription << "\n";
+      std::map<ossimString, std::set<ossimString> >::const_iterator i =
+         plugin.theProvides.begin();
+      while ( i != plugin.theProvides.end() )
+      {
+         if ( i->second.size() )
+         {
+            out << i->first.upcase() << "\n     ";
+            std::copy(i->second.begin(),
+                      i->second.end(),
+                      std::ostream_iterator<ossimString>(out, "\n     "));
+            out << "\n";
+         }
+         ++i;
+      }
+   }
 }
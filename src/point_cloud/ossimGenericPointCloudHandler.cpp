@@ -1,69 +1,560 @@
 #include <ossim/point_cloud/ossimGenericPointCloudHandler.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimMemoryMappedFile.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <OpenThreads/Thread>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+RTTI_DEF1(ossimGenericPointCloudHandler, "ossimGenericPointCloudHandler", ossimPointCloudHandler);
+
+static const char         MAGIC[] = "OSSIMPCB";
+static const ossim_uint32 VERSION = 1;
+static const ossim_uint32 BYTE_ORDER_MARK = 0x01020304;
+
+namespace
+{
+   const ossim_uint32 MAX_COLUMNS = 7;
+
+   // Least text a parse thread is given:
+   const ossim_uint64 MIN_THREAD_BYTES = 0x400000;
+
+   // Fields of the columns after X Y Z, by number of columns:
+   const ossim_uint32 NUM_LAYOUTS = 3;
+   const ossim_uint32 LAYOUT_COLUMNS[NUM_LAYOUTS] = { 4, 6, 7 };
+   const ossimPointRecord::FIELD_CODES LAYOUT_FIELDS[NUM_LAYOUTS][4] =
+   {
+      { ossimPointRecord::Intensity },
+      { ossimPointRecord::Red, ossimPointRecord::Green, ossimPointRecord::Blue },
+      { ossimPointRecord::Intensity, ossimPointRecord::Red, ossimPointRecord::Green,
+        ossimPointRecord::Blue }
+   };
+
+   // Float fields a sidecar may hold, in file order:
+   const ossim_uint32 NUM_SIDECAR_FIELDS = 4;
+   const ossimPointRecord::FIELD_CODES SIDECAR_FIELDS[NUM_SIDECAR_FIELDS] =
+   {
+      ossimPointRecord::Intensity, ossimPointRecord::Red, ossimPointRecord::Green,
+      ossimPointRecord::Blue
+   };
+
+   // Exact powers of ten as doubles:
+   const double POW10[] =
+   {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+      1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+   };
+
+   template <class T> void writeValue(std::ostream& out, const T& value)
+   {
+      out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+   }
+
+   template <class T> bool readValue(std::istream& in, T& value)
+   {
+      in.read(reinterpret_cast<char*>(&value), sizeof(T));
+      return in.good();
+   }
+
+   inline bool isDigit(char c) { return (c >= '0') && (c <= '9'); }
+
+   inline bool isSeparator(char c)
+   {
+      return (c == ' ') || (c == '\t') || (c == ',') || (c == ';') || (c == '\r');
+   }
+
+   /**
+    * Converts the number at p, of the [+-]digits[.digits][(e|E)[+-]digits] form of point files,
+    * without the locale and stream overhead of strtod(). Up to 19 significant digits are kept,
+    * scaled by an exact power of ten, so values of up to 15 digits convert as strtod() does.
+    * Returns the end of the number, or 0 if there is none at p.
+    */
+   const char* parseNumber(const char* p, const char* end, double& value)
+   {
+      bool negative = false;
+      if ((p < end) && ((*p == '-') || (*p == '+')))
+      {
+         negative = (*p == '-');
+         ++p;
+      }
+
+      ossim_uint64 mantissa = 0;
+      int numDigits = 0;
+      int exponent = 0;
+      bool found = false;
+      for (; (p < end) && isDigit(*p); ++p)
+      {
+         found = true;
+         if (numDigits < 19)
+         {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa)
+               ++numDigits;
+         }
+         else
+            ++exponent;
+      }
+      if ((p < end) && (*p == '.'))
+      {
+         for (++p; (p < end) && isDigit(*p); ++p)
+         {
+            found = true;
+            if (numDigits < 19)
+            {
+               mantissa = mantissa * 10 + (*p - '0');
+               if (mantissa)
+                  ++numDigits;
+               --exponent;
+            }
+         }
+      }
+      if (!found)
+         return 0;
+
+      if ((p < end) && ((*p == 'e') || (*p == 'E')))
+      {
+         const char* q = p + 1;
+         bool negativeExp = false;
+         if ((q < end) && ((*q == '-') || (*q == '+')))
+         {
+            negativeExp = (*q == '-');
+            ++q;
+         }
+         if ((q < end) && isDigit(*q))
+         {
+            int e = 0;
+            for (; (q < end) && isDigit(*q); ++q)
+            {
+               if (e < 10000)
+                  e = e * 10 + (*q - '0');
+            }
+            exponent += negativeExp ? -e : e;
+            p = q;
+         }
+      }
+
+      double v = (double) mantissa;
+      if ((exponent >= 0) && (exponent <= 22))
+         v *= POW10[exponent];
+      else if ((exponent < 0) && (exponent >= -22))
+         v /= POW10[-exponent];
+      else
+         v *= std::pow(10.0, exponent);
+      value = negative ? -v : v;
+      return p;
+   }
+
+   /** Reads up to MAX_COLUMNS numbers of the line; returns how many precede its first non-number. */
+   ossim_uint32 parseLine(const char* p, const char* eol, double* values)
+   {
+      ossim_uint32 n = 0;
+      while (n < MAX_COLUMNS)
+      {
+         while ((p < eol) && isSeparator(*p))
+            ++p;
+         if (p >= eol)
+            break;
+         const char* q = parseNumber(p, eol, values[n]);
+         if (!q || ((q < eol) && !isSeparator(*q)))
+            break;
+         ++n;
+         p = q;
+      }
+      return n;
+   }
+
+   inline const char* endOfLine(const char* p, const char* end)
+   {
+      const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+      return eol ? eol : end;
+   }
+
+   /** Parses the point lines of [begin, end) into block, which has the layout's fields. */
+   void parseChunk(const char* begin,
+                   const char* end,
+                   const ossimPointRecord::FIELD_CODES* fields,
+                   ossim_uint32 numFields,
+                   ossimPointColumnBlock& block)
+   {
+      // One pass to size the columns, so that filling them never reallocates:
+      block.resize((ossim_uint32) std::count(begin, end, '\n') + 1);
+      ossim_float64* x = block.getX();
+      ossim_float64* y = block.getY();
+      ossim_float64* z = block.getZ();
+      ossim_float32* columns[4];
+      for (ossim_uint32 f=0; f<numFields; ++f)
+         columns[f] = block.getFloatField(fields[f]);
+
+      double values[MAX_COLUMNS];
+      ossim_uint32 numPoints = 0;
+      for (const char* p=begin; p<end; )
+      {
+         const char* eol = endOfLine(p, end);
+         const ossim_uint32 n = parseLine(p, eol, values);
+         if (n >= 3)
+         {
+            x[numPoints] = values[0];
+            y[numPoints] = values[1];
+            z[numPoints] = values[2];
+            for (ossim_uint32 f=0; f<numFields; ++f)
+               columns[f][numPoints] = (n > 3 + f) ? (ossim_float32) values[3 + f] : ossim::nan();
+            ++numPoints;
+         }
+         p = eol + 1;
+      }
+      block.resize(numPoints);
+   }
+
+   class ossimTextPointThread : public OpenThreads::Thread
+   {
+   public:
+      ossimTextPointThread(const char* begin,
+                           const char* end,
+                           const ossimPointRecord::FIELD_CODES* fields,
+                           ossim_uint32 numFields,
+                           ossimPointColumnBlock& block)
+         : OpenThreads::Thread(),
+           m_begin(begin),
+           m_end(end),
+           m_fields(fields),
+           m_numFields(numFields),
+           m_block(block)
+      {
+      }
+      virtual void run()
+      {
+         parseChunk(m_begin, m_end, m_fields, m_numFields, m_block);
+      }
+   private:
+      const char*                          m_begin;
+      const char*                          m_end;
+      const ossimPointRecord::FIELD_CODES* m_fields;
+      ossim_uint32                         m_numFields;
+      ossimPointColumnBlock&               m_block;
+   };
+}
+
+ossimGenericPointCloudHandler::ossimGenericPointCloudHandler()
+:  m_fieldCode(0)
+{
+}
 
 ossimGenericPointCloudHandler::ossimGenericPointCloudHandler(vector<ossimEcefPoint>& ecef_points)
+:  m_fieldCode(0)
 {
    // Fill the point storage in any order.
    // Loop to add your points (assume your points are passed in a vector ecef_points[])
+   m_points.reserve(ecef_points.size());
    for (ossim_uint32 i=0; i<ecef_points.size(); ++i)
-   {
-      ossimPointRecord* point = new ossimPointRecord(ossimGpt(ecef_points[i]));
-      m_pointBlock.addPoint(point);
-   }
+      m_points.addPoint(ossimGpt(ecef_points[i]));
    ossimGrect bounds;
-   m_pointBlock.getBounds(bounds);
+   m_points.getBounds(bounds);
    m_minRecord = new ossimPointRecord(bounds.ll());
    m_maxRecord = new ossimPointRecord(bounds.ur());
 }
 
 ossimGenericPointCloudHandler::ossimGenericPointCloudHandler(vector<ossimGpt>& ground_points)
+:  m_fieldCode(0)
 {
    // Fill the point storage in any order.
    // Loop to add your points (assume your points are passed in a vector ecef_points[])
+   m_points.reserve(ground_points.size());
    for (ossim_uint32 i=0; i<ground_points.size(); ++i)
-   {
-      ossimPointRecord* point = new ossimPointRecord(ground_points[i]);
-      m_pointBlock.addPoint(point);
-   }
+      m_points.addPoint(ground_points[i]);
    ossimGrect bounds;
-   m_pointBlock.getBounds(bounds);
+   m_points.getBounds(bounds);
    m_minRecord = new ossimPointRecord(bounds.ll());
    m_maxRecord = new ossimPointRecord(bounds.ur());
 }
 
-ossimGenericPointCloudHandler::~ossimGenericPointCloudHandler() 
-{ 
-   m_pointBlock.clear(); 
+ossimGenericPointCloudHandler::~ossimGenericPointCloudHandler()
+{
+   m_points.clear();
 }
 
-ossim_uint32 ossimGenericPointCloudHandler::getNumPoints() const 
-{ 
-   return m_pointBlock.size(); 
+ossim_uint32 ossimGenericPointCloudHandler::getNumPoints() const
+{
+   return m_points.size();
 }
 
 void ossimGenericPointCloudHandler::getFileBlock(ossim_uint32 offset,
                                                  ossimPointBlock& block,
-                                                 ossim_uint32 /* maxNumPoints */) const
+                                                 ossim_uint32 maxNumPoints) const
 {
    block.clear();
-   if (offset >= m_pointBlock.size())
+   if (offset >= m_points.size())
       return;
 
-   for (ossim_uint32 i=offset; i<m_pointBlock.size(); ++i)
-      block.addPoint(new ossimPointRecord(*(m_pointBlock[i])));
+   m_points.appendTo(block, offset, maxNumPoints);
+   m_currentPID = offset + block.size();
+}
+
+void ossimGenericPointCloudHandler::getFileBlock(ossim_uint32 offset,
+                                                 ossimPointColumnBlock& block,
+                                                 ossim_uint32 maxNumPoints) const
+{
+   block.clear();
+   if (offset >= m_points.size())
+      return;
 
-   m_currentPID = block.size();
+   block.append(m_points, offset, maxNumPoints);
+   m_currentPID = offset + block.size();
 }
 
-ossim_uint32 ossimGenericPointCloudHandler::getFieldCode() const 
-{ 
-  return 0; 
+ossim_uint32 ossimGenericPointCloudHandler::getFieldCode() const
+{
+  return m_fieldCode;
 }
 
-bool ossimGenericPointCloudHandler::open(const ossimFilename& /* pointsFile */)
-{ 
-   return false; 
+bool ossimGenericPointCloudHandler::open(const ossimFilename& pointsFile)
+{
+   close();
+   if (!pointsFile.isFile())
+      return false;
+
+   bool useSidecar = true;
+   const char* lookup = ossimPreferences::instance()->findPreference("point_cloud.text_sidecar");
+   if (lookup)
+      useSidecar = ossimString(lookup).toBool();
+
+   const ossim_int64 fileSize = pointsFile.fileSize();
+   const ossimFilename sidecar = getSidecarFile(pointsFile);
+   if (!useSidecar || !sidecar.exists() || !loadSidecar(sidecar, fileSize))
+   {
+      ossimRefPtr<ossimMemoryMappedFile> map = new ossimMemoryMappedFile();
+      if (!map->open(pointsFile) ||
+          !parseText(reinterpret_cast<const char*>(map->data()), map->size()))
+      {
+         close();
+         return false;
+      }
+
+      // The sidecar is an optimization; a read only directory is not an error.
+      if (useSidecar)
+         saveSidecar(sidecar, fileSize);
+   }
+
+   m_inputFilename = pointsFile;
+   initBounds();
+   return true;
 }
- 
-void ossimGenericPointCloudHandler::close() 
-{  
+
+void ossimGenericPointCloudHandler::close()
+{
+   m_points.setFieldCode(0);
+   m_points.clear();
+   m_fieldCode = 0;
+   m_inputFilename.clear();
+}
+
+ossimFilename ossimGenericPointCloudHandler::getSidecarFile(const ossimFilename& pointsFile)
+{
+   ossimFilename sidecar (pointsFile);
+   sidecar += ".pcb";
+   return sidecar;
+}
+
+bool ossimGenericPointCloudHandler::parseText(const char* data, ossim_uint64 size)
+{
+   const char* end = data + size;
+
+   // The first point line sets the columns:
+   double values[MAX_COLUMNS];
+   ossim_uint32 numColumns = 0;
+   for (const char* p=data; (p<end) && (numColumns<3); )
+   {
+      const char* eol = endOfLine(p, end);
+      numColumns = parseLine(p, eol, values);
+      p = eol + 1;
+   }
+   if (numColumns < 3)
+      return false;
+
+   const ossimPointRecord::FIELD_CODES* fields = 0;
+   ossim_uint32 numFields = 0;
+   for (ossim_uint32 i=0; i<NUM_LAYOUTS; ++i)
+   {
+      if (LAYOUT_COLUMNS[i] == numColumns)
+      {
+         fields = LAYOUT_FIELDS[i];
+         numFields = numColumns - 3;
+      }
+   }
+   m_fieldCode = 0;
+   for (ossim_uint32 f=0; f<numFields; ++f)
+      m_fieldCode |= fields[f];
+
+   // Chunks end on line boundaries, each parsed by its own thread into its own block:
+   const ossim_uint64 numThreads = std::max<ossim_uint64>(1,
+      std::min<ossim_uint64>(ossim::getNumberOfThreads(), size / MIN_THREAD_BYTES));
+   std::vector<const char*> bounds (1, data);
+   for (ossim_uint64 t=1; t<numThreads; ++t)
+   {
+      const char* p = std::max(data + size * t / numThreads, bounds.back());
+      p = endOfLine(p, end);
+      bounds.push_back((p < end) ? p + 1 : end);
+   }
+   bounds.push_back(end);
+
+   std::vector< ossimRefPtr<ossimPointColumnBlock> > blocks;
+   for (ossim_uint64 t=0; t<numThreads; ++t)
+      blocks.push_back(new ossimPointColumnBlock(m_fieldCode));
+
+   std::vector<ossimTextPointThread*> threads;
+   for (ossim_uint64 t=1; t<numThreads; ++t)
+   {
+      threads.push_back(new ossimTextPointThread(bounds[t], bounds[t + 1], fields, numFields,
+                                                 *blocks[t]));
+      threads.back()->start();
+   }
+   parseChunk(bounds[0], bounds[1], fields, numFields, *blocks[0]);
+
+   ossim_uint32 numPoints = blocks[0]->size();
+   for (ossim_uint64 t=0; t<threads.size(); ++t)
+   {
+      threads[t]->join();
+      delete threads[t];
+      numPoints += blocks[t + 1]->size();
+   }
+
+   m_points.setFieldCode(m_fieldCode);
+   m_points.reserve(numPoints);
+   for (ossim_uint64 t=0; t<numThreads; ++t)
+   {
+      m_points.append(*blocks[t]);
+      blocks[t] = 0;
+   }
+
+   // Point ids are the line order:
+   ossim_uint32* ids = m_points.getPointIds();
+   for (ossim_uint32 i=0; i<numPoints; ++i)
+      ids[i] = i;
+
+   return (numPoints > 0);
+}
+
+bool ossimGenericPointCloudHandler::saveSidecar(const ossimFilename& sidecar,
+                                                ossim_int64 fileSize) const
+{
+   std::ofstream out (sidecar.c_str(), std::ios::out | std::ios::binary);
+   if (!out)
+      return false;
+
+   const ossim_uint32 numPoints = m_points.size();
+   out.write(MAGIC, 8);
+   writeValue(out, BYTE_ORDER_MARK);
+   writeValue(out, VERSION);
+   writeValue(out, fileSize);
+   writeValue(out, numPoints);
+   writeValue(out, m_fieldCode);
+
+   out.write(reinterpret_cast<const char*>(m_points.getX()), numPoints * sizeof(ossim_float64));
+   out.write(reinterpret_cast<const char*>(m_points.getY()), numPoints * sizeof(ossim_float64));
+   out.write(reinterpret_cast<const char*>(m_points.getZ()), numPoints * sizeof(ossim_float64));
+   for (ossim_uint32 f=0; f<NUM_SIDECAR_FIELDS; ++f)
+   {
+      const ossim_float32* column = m_points.getFloatField(SIDECAR_FIELDS[f]);
+      if (column)
+         out.write(reinterpret_cast<const char*>(column), numPoints * sizeof(ossim_float32));
+   }
+
+   return out.good();
+}
+
+bool ossimGenericPointCloudHandler::loadSidecar(const ossimFilename& sidecar,
+                                                ossim_int64 fileSize)
+{
+   std::ifstream in (sidecar.c_str(), std::ios::in | std::ios::binary);
+   if (!in)
+      return false;
+
+   char magic[8];
+   ossim_uint32 mark, version, numPoints, fieldCode;
+   ossim_int64 size;
+   in.read(magic, 8);
+   if (!in.good() || (memcmp(magic, MAGIC, 8) != 0) ||
+       !readValue(in, mark) || (mark != BYTE_ORDER_MARK) ||
+       !readValue(in, version) || (version != VERSION) ||
+       !readValue(in, size) || (size != fileSize) ||
+       !readValue(in, numPoints) || (numPoints == 0) || !readValue(in, fieldCode))
+   {
+      return false;
+   }
+
+   // Stale or foreign sidecar, by its size:
+   ossim_uint64 bytesPerPoint = 3 * sizeof(ossim_float64);
+   for (ossim_uint32 f=0; f<NUM_SIDECAR_FIELDS; ++f)
+   {
+      if (fieldCode & SIDECAR_FIELDS[f])
+         bytesPerPoint += sizeof(ossim_float32);
+   }
+   const ossim_uint64 headerSize = (ossim_uint64) in.tellg();
+   if ((fieldCode & ~ossimPointRecord::All) ||
+       (headerSize + numPoints * bytesPerPoint != (ossim_uint64) sidecar.fileSize()))
+   {
+      return false;
+   }
+
+   m_points.setFieldCode(fieldCode);
+   m_points.resize(numPoints);
+   in.read(reinterpret_cast<char*>(m_points.getX()), numPoints * sizeof(ossim_float64));
+   in.read(reinterpret_cast<char*>(m_points.getY()), numPoints * sizeof(ossim_float64));
+   in.read(reinterpret_cast<char*>(m_points.getZ()), numPoints * sizeof(ossim_float64));
+   for (ossim_uint32 f=0; f<NUM_SIDECAR_FIELDS; ++f)
+   {
+      ossim_float32* column = m_points.getFloatField(SIDECAR_FIELDS[f]);
+      if (column)
+         in.read(reinterpret_cast<char*>(column), numPoints * sizeof(ossim_float32));
+   }
+   if (!in.good())
+   {
+      close();
+      return false;
+   }
+
+   ossim_uint32* ids = m_points.getPointIds();
+   for (ossim_uint32 i=0; i<numPoints; ++i)
+      ids[i] = i;
+   m_fieldCode = fieldCode;
+   return true;
+}
+
+void ossimGenericPointCloudHandler::initBounds()
+{
+   ossimGrect bounds;
+   m_points.getBounds(bounds);
+   m_minRecord = new ossimPointRecord(m_fieldCode);
+   m_maxRecord = new ossimPointRecord(m_fieldCode);
+   m_minRecord->setPosition(bounds.ll());
+   m_maxRecord->setPosition(bounds.ur());
+
+   // Field ranges, for normalizeBlock() and the image handler's scaling:
+   for (ossim_uint32 f=0; f<NUM_SIDECAR_FIELDS; ++f)
+   {
+      const ossim_float32* column = m_points.getFloatField(SIDECAR_FIELDS[f]);
+      if (!column)
+         continue;
+      ossim_float32 minValue = ossim::nan();
+      ossim_float32 maxValue = ossim::nan();
+      for (ossim_uint32 i=0; i<m_points.size(); ++i)
+      {
+         if (ossim::isnan(column[i]))
+            continue;
+         if (ossim::isnan(minValue) || (column[i] < minValue))
+            minValue = column[i];
+         if (ossim::isnan(maxValue) || (column[i] > maxValue))
+            maxValue = column[i];
+      }
+      m_minRecord->setField(SIDECAR_FIELDS[f], minValue);
+      m_maxRecord->setField(SIDECAR_FIELDS[f], maxValue);
+   }
+
+   if ((bounds.ll().lon >= -180.0) && (bounds.ur().lon <= 180.0) &&
+       (bounds.ll().lat >= -90.0) && (bounds.ur().lat <= 90.0))
+      m_geometry = new ossimPointCloudGeometry(ossimPointCloudGeometry::GEOGRAPHIC);
+   else
+      m_geometry = new ossimPointCloudGeometry(ossimPointCloudGeometry::MAP_PROJECTED);
 }
@@ -0,0 +1,71 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+
+#include <ossim/point_cloud/ossimGenericPointCloudHandlerFactory.h>
+#include <ossim/point_cloud/ossimGenericPointCloudHandler.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimKeywordNames.h>
+
+RTTI_DEF1(ossimGenericPointCloudHandlerFactory, "ossimGenericPointCloudHandlerFactory",
+          ossimPointCloudHandlerFactory);
+
+ossimGenericPointCloudHandlerFactory* ossimGenericPointCloudHandlerFactory::m_instance = 0;
+
+ossimGenericPointCloudHandlerFactory::~ossimGenericPointCloudHandlerFactory()
+{
+   m_instance = 0;
+}
+
+ossimGenericPointCloudHandlerFactory* ossimGenericPointCloudHandlerFactory::instance()
+{
+   if (!m_instance)
+      m_instance = new ossimGenericPointCloudHandlerFactory;
+   return m_instance;
+}
+
+ossimPointCloudHandler* ossimGenericPointCloudHandlerFactory::open(const ossimFilename& fileName) const
+{
+   const ossimString ext = fileName.ext().downcase();
+   if ((ext != "xyz") && (ext != "txt") && (ext != "csv") && (ext != "pts"))
+      return 0;
+
+   ossimRefPtr<ossimGenericPointCloudHandler> handler = new ossimGenericPointCloudHandler();
+   if (!handler->open(fileName))
+      return 0;
+   return handler.release();
+}
+
+ossimPointCloudHandler* ossimGenericPointCloudHandlerFactory::open(const ossimKeywordlist& kwl,
+                                                               const char* prefix) const
+{
+   const char* lookup = kwl.find(prefix, ossimKeywordNames::FILENAME_KW);
+   if (!lookup)
+      return 0;
+   return open(ossimFilename(lookup));
+}
+
+ossimObject* ossimGenericPointCloudHandlerFactory::createObject(const ossimString& typeName) const
+{
+   if (typeName == STATIC_TYPE_NAME(ossimGenericPointCloudHandler))
+      return new ossimGenericPointCloudHandler();
+   return 0;
+}
+
+void ossimGenericPointCloudHandlerFactory::getTypeNameList(std::vector<ossimString>& typeList) const
+{
+   typeList.push_back(STATIC_TYPE_NAME(ossimGenericPointCloudHandler));
+}
+
+void ossimGenericPointCloudHandlerFactory::getSupportedExtensions(
+   std::vector<ossimString>& extList) const
+{
+   extList.push_back("xyz");
+   extList.push_back("txt");
+   extList.push_back("csv");
+   extList.push_back("pts");
+}
@@ -0,0 +1,586 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+
+#include <ossim/ossimConfig.h>
+#include <ossim/point_cloud/ossimLazPointCloudHandler.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimEndian.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTrace.h>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#if OSSIM_HAS_LASZIP
+#  include <laszip/laszip.hpp>
+#  include <laszip/lasunzipper.hpp>
+#endif
+
+RTTI_DEF1(ossimLazPointCloudHandler, "ossimLazPointCloudHandler", ossimPointCloudHandler);
+
+static ossimTrace traceDebug("ossimLazPointCloudHandler:debug");
+
+// Decoded chunks kept by default, "point_cloud.laz_cache_chunks" preference:
+static const ossim_uint32 DEFAULT_CACHED_CHUNKS = 16;
+
+// Unit of decoding when the file was compressed with variable size chunks:
+static const ossim_uint32 VARIABLE_CHUNK_STEP = 50000;
+
+#if OSSIM_HAS_LASZIP
+
+class ossimLazPointCloudHandler::Decoder
+{
+public:
+   bool open(const ossimFilename& file, ossim_uint32 offsetToPointData, const LASzip* laszip)
+   {
+      m_stream.open(file.c_str(), std::ios::in | std::ios::binary);
+      if (!m_stream.good())
+         return false;
+
+      // LASunzipper reads the chunk table pointer from the start of the point data:
+      m_stream.seekg(offsetToPointData, std::ios::beg);
+      if (!m_unzipper.open(m_stream, laszip))
+      {
+         if (traceDebug())
+         {
+            ossimNotify(ossimNotifyLevel_DEBUG)
+               << "ossimLazPointCloudHandler::Decoder::open: " << m_unzipper.get_error()
+               << std::endl;
+         }
+         return false;
+      }
+
+      // Items are decoded in place, one after the other, into a raw LAS record:
+      ossim_uint32 offset = 0;
+      for (ossim_uint32 i = 0; i < laszip->num_items; ++i)
+      {
+         m_itemOffsets.push_back(offset);
+         offset += laszip->items[i].size;
+      }
+      m_recordSize = offset;
+      m_items.resize(m_itemOffsets.size());
+      return true;
+   }
+
+   /** Decodes n records from point index first into m_records. */
+   bool read(ossim_uint32 first, ossim_uint32 n)
+   {
+      if (!m_unzipper.seek(first))
+         return false;
+      m_records.resize((size_t) n * m_recordSize);
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         unsigned char* record = &m_records[(size_t) i * m_recordSize];
+         for (ossim_uint32 k = 0; k < m_items.size(); ++k)
+            m_items[k] = record + m_itemOffsets[k];
+         if (!m_unzipper.read(&m_items[0]))
+            return false;
+      }
+      return true;
+   }
+
+   ~Decoder()
+   {
+      m_unzipper.close();
+   }
+
+   std::ifstream                m_stream;
+   LASunzipper                  m_unzipper;
+   std::vector<ossim_uint32>    m_itemOffsets;
+   std::vector<unsigned char*>  m_items;
+   ossim_uint32                 m_recordSize;
+   std::vector<ossim_uint8>     m_records;
+};
+
+#else
+
+// Never instantiated without LASzip:
+class ossimLazPointCloudHandler::Decoder
+{
+};
+
+#endif /* #if OSSIM_HAS_LASZIP */
+
+/** Decodes every stride'th missing chunk. */
+class ossimLazChunkThread : public OpenThreads::Thread
+{
+public:
+   ossimLazChunkThread(const ossimLazPointCloudHandler* handler,
+                       const std::vector<ossim_uint32>& chunks,
+                       ossim_uint32 first,
+                       ossim_uint32 stride,
+                       std::vector< ossimRefPtr<ossimPointColumnBlock> >& blocks)
+      : OpenThreads::Thread(),
+        m_handler(handler),
+        m_chunks(chunks),
+        m_first(first),
+        m_stride(stride),
+        m_blocks(blocks)
+   {
+   }
+   virtual void run()
+   {
+      for (ossim_uint32 i = m_first; i < m_chunks.size(); i += m_stride)
+      {
+         ossimRefPtr<ossimPointColumnBlock> block = new ossimPointColumnBlock();
+         if (m_handler->decodeChunk(m_chunks[i], *block))
+            m_blocks[i] = block;
+      }
+   }
+private:
+   const ossimLazPointCloudHandler*                     m_handler;
+   const std::vector<ossim_uint32>&                     m_chunks;
+   ossim_uint32                                         m_first;
+   ossim_uint32                                         m_stride;
+   std::vector< ossimRefPtr<ossimPointColumnBlock> >&   m_blocks;
+};
+
+ossimLazPointCloudHandler::ossimLazPointCloudHandler()
+   : ossimPointCloudHandler(),
+     m_hdr(),
+     m_laszip(0),
+     m_numPoints(0),
+     m_chunkSize(0),
+     m_pointFormat(0),
+     m_fieldCode(0),
+     m_decoders(),
+     m_decoderMutex(),
+     m_maxCachedChunks(DEFAULT_CACHED_CHUNKS),
+     m_chunkCache(),
+     m_lru(),
+     m_cacheMutex()
+{
+}
+
+ossimLazPointCloudHandler::~ossimLazPointCloudHandler()
+{
+   close();
+}
+
+bool ossimLazPointCloudHandler::open(const ossimFilename& lazFile)
+{
+   close();
+
+#if OSSIM_HAS_LASZIP
+   std::ifstream in (lazFile.c_str(), std::ios::in | std::ios::binary);
+   if (!in.good() || !m_hdr.checkSignature(in))
+      return false;
+   in.seekg(0, std::ios::beg);
+   m_hdr.readStream(in);
+
+   // LASzip sets bit 7 (and bit 6 for old files) of the format id of a compressed file:
+   const ossim_uint8 formatId = m_hdr.getPointDataFormatId();
+   if (!(formatId & 0xC0))
+      return false;
+   m_pointFormat = formatId & 0x3F;
+   if (m_pointFormat > 5)
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimLazPointCloudHandler::open: Unsupported LAS point format "
+         << int(m_pointFormat) << " in " << lazFile << std::endl;
+      return false;
+   }
+   if (m_hdr.getNumberOfPoints() > 0xFFFFFFFF)
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimLazPointCloudHandler::open: Too many points in " << lazFile << std::endl;
+      return false;
+   }
+   m_numPoints = (ossim_uint32) m_hdr.getNumberOfPoints();
+
+   in.seekg(m_hdr.getHeaderSize(), std::ios::beg);
+   if (!readLaszipVlr(in))
+   {
+      close();
+      return false;
+   }
+
+   m_chunkSize = m_laszip->chunk_size;
+   if ((m_chunkSize == 0) || (m_chunkSize == 0xFFFFFFFF))
+      m_chunkSize = VARIABLE_CHUNK_STEP;
+
+   m_fieldCode = ossimPointRecord::Intensity | ossimPointRecord::ReturnNumber |
+                 ossimPointRecord::NumberOfReturns | ossimPointRecord::Classification;
+   if ((m_pointFormat == 1) || (m_pointFormat >= 3))
+      m_fieldCode |= ossimPointRecord::GpsTime;
+   if ((m_pointFormat == 2) || (m_pointFormat == 3) || (m_pointFormat == 5))
+      m_fieldCode |= ossimPointRecord::Red | ossimPointRecord::Green | ossimPointRecord::Blue;
+
+   const char* lookup = ossimPreferences::instance()->findPreference("point_cloud.laz_cache_chunks");
+   if (lookup)
+      m_maxCachedChunks = ossimString(lookup).toUInt32();
+
+   // Check that the point data decodes before claiming the file:
+   m_inputFilename = lazFile;
+   Decoder* decoder = acquireDecoder();
+   if (!decoder)
+   {
+      close();
+      return false;
+   }
+   releaseDecoder(decoder);
+
+   // The header bounds give the min and max points:
+   ossimGpt minPos (m_hdr.getMinY(), m_hdr.getMinX(), m_hdr.getMinZ());
+   ossimGpt maxPos (m_hdr.getMaxY(), m_hdr.getMaxX(), m_hdr.getMaxZ());
+   m_minRecord = new ossimPointRecord(minPos);
+   m_maxRecord = new ossimPointRecord(maxPos);
+
+   if ((m_hdr.getMinX() >= -180.0) && (m_hdr.getMaxX() <= 180.0) &&
+       (m_hdr.getMinY() >= -90.0) && (m_hdr.getMaxY() <= 90.0))
+      m_geometry = new ossimPointCloudGeometry(ossimPointCloudGeometry::GEOGRAPHIC);
+   else
+      m_geometry = new ossimPointCloudGeometry(ossimPointCloudGeometry::MAP_PROJECTED);
+
+   return true;
+#else
+   if (traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimLazPointCloudHandler::open: OSSIM was built without LASzip, cannot open "
+         << lazFile << std::endl;
+   }
+   return false;
+#endif
+}
+
+bool ossimLazPointCloudHandler::readLaszipVlr(std::istream& in)
+{
+#if OSSIM_HAS_LASZIP
+   ossimEndian* endian = (ossim::byteOrder() == OSSIM_BIG_ENDIAN) ? new ossimEndian() : 0;
+   ossim_uint16 reserved;
+   char uid[17];
+   ossim_uint16 recordId;
+   ossim_uint16 length;
+   char des[32];
+   uid[16] = '\0';
+   bool found = false;
+   for (ossim_uint32 i = 0; !found && (i < m_hdr.getNumberOfVlrs()) && in.good(); ++i)
+   {
+      in.read((char*)&reserved, 2);
+      in.read(uid, 16);
+      in.read((char*)&recordId, 2);
+      in.read((char*)&length, 2);
+      in.read(des, 32);
+      if (endian)
+      {
+         endian->swap(recordId);
+         endian->swap(length);
+      }
+
+      if ((recordId == 22204) && length && (std::strncmp(uid, "laszip encoded", 14) == 0))
+      {
+         std::vector<ossim_uint8> payload (length);
+         in.read((char*)&payload[0], length);
+         m_laszip = new LASzip();
+         found = in.good() && m_laszip->unpack(&payload[0], length);
+      }
+      else
+      {
+         in.seekg(length, std::ios::cur);
+      }
+   }
+   delete endian;
+   return found;
+#else
+   return false;
+#endif
+}
+
+void ossimLazPointCloudHandler::close()
+{
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_decoderMutex);
+      for (ossim_uint32 i = 0; i < m_decoders.size(); ++i)
+         delete m_decoders[i];
+      m_decoders.clear();
+   }
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_cacheMutex);
+      m_chunkCache.clear();
+      m_lru.clear();
+   }
+#if OSSIM_HAS_LASZIP
+   delete m_laszip;
+#endif
+   m_laszip = 0;
+   m_numPoints = 0;
+   m_chunkSize = 0;
+   m_fieldCode = 0;
+   m_currentPID = 0;
+   m_minRecord = 0;
+   m_maxRecord = 0;
+   m_inputFilename.clear();
+}
+
+ossim_uint32 ossimLazPointCloudHandler::getNumPoints() const
+{
+   return m_numPoints;
+}
+
+ossim_uint32 ossimLazPointCloudHandler::getFieldCode() const
+{
+   return m_fieldCode;
+}
+
+ossim_uint32 ossimLazPointCloudHandler::getIndexChunkSize() const
+{
+   return m_chunkSize ? m_chunkSize : ossimPointCloudHandler::getIndexChunkSize();
+}
+
+ossim_uint32 ossimLazPointCloudHandler::getNumChunks() const
+{
+   return m_chunkSize ? (ossim_uint32)(((ossim_uint64) m_numPoints + m_chunkSize - 1) / m_chunkSize)
+                      : 0;
+}
+
+void ossimLazPointCloudHandler::getFileBlock(ossim_uint32 offset,
+                                             ossimPointBlock& block,
+                                             ossim_uint32 maxNumPoints) const
+{
+   block.clear();
+   ossimPointColumnBlock columns (block.getFieldCode() ? block.getFieldCode() : m_fieldCode);
+   getFileBlock(offset, columns, maxNumPoints);
+   columns.appendTo(block);
+}
+
+void ossimLazPointCloudHandler::getFileBlock(ossim_uint32 offset,
+                                             ossimPointColumnBlock& block,
+                                             ossim_uint32 maxNumPoints) const
+{
+   block.clear();
+   if ((offset >= m_numPoints) || (maxNumPoints == 0) || !m_chunkSize)
+      return;
+
+   const ossim_uint64 end = std::min<ossim_uint64>((ossim_uint64) offset + maxNumPoints,
+                                                   m_numPoints);
+   const ossim_uint32 firstChunk = offset / m_chunkSize;
+   const ossim_uint32 lastChunk = (ossim_uint32)((end - 1) / m_chunkSize);
+   block.reserve((ossim_uint32)(end - offset));
+
+   // Chunks are decoded a thread's worth at a time to bound the memory of long reads:
+   const ossim_uint32 batch = std::max<ossim_uint32>(ossim::getNumberOfThreads(), 1);
+   ChunkList chunks;
+   for (ossim_uint32 c0 = firstChunk; c0 <= lastChunk; c0 += batch)
+   {
+      const ossim_uint32 c1 = std::min(c0 + batch - 1, lastChunk);
+      getChunks(c0, c1, chunks);
+      for (ossim_uint32 c = c0; c <= c1; ++c)
+      {
+         const ossimPointColumnBlock* chunk = chunks[c - c0].get();
+         if (!chunk)
+         {
+            ossimNotify(ossimNotifyLevel_WARN)
+               << "ossimLazPointCloudHandler::getFileBlock: Could not decode chunk " << c
+               << " of " << m_inputFilename << std::endl;
+            m_currentPID = offset + block.size();
+            return;
+         }
+         const ossim_uint64 chunkStart = (ossim_uint64) c * m_chunkSize;
+         const ossim_uint64 from = std::max<ossim_uint64>(offset, chunkStart);
+         const ossim_uint64 to = std::min<ossim_uint64>(end, chunkStart + chunk->size());
+         if (to > from)
+            block.append(*chunk, (ossim_uint32)(from - chunkStart), (ossim_uint32)(to - from));
+      }
+   }
+   m_currentPID = offset + block.size();
+}
+
+void ossimLazPointCloudHandler::getChunks(ossim_uint32 first, ossim_uint32 last,
+                                          ChunkList& chunks) const
+{
+   chunks.assign(last - first + 1, 0);
+   std::vector<ossim_uint32> missing;
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_cacheMutex);
+      for (ossim_uint32 c = first; c <= last; ++c)
+      {
+         std::map<ossim_uint32, ossimRefPtr<ossimPointColumnBlock> >::iterator iter =
+            m_chunkCache.find(c);
+         if (iter != m_chunkCache.end())
+         {
+            chunks[c - first] = iter->second;
+            m_lru.remove(c);
+            m_lru.push_front(c);
+         }
+         else
+         {
+            missing.push_back(c);
+         }
+      }
+   }
+   if (missing.empty())
+      return;
+
+   // Each thread decodes with its own decoder from the pool:
+   ChunkList decoded (missing.size());
+   const ossim_uint32 THREADS = std::min<ossim_uint32>(ossim::getNumberOfThreads(),
+                                                       (ossim_uint32) missing.size());
+   std::vector<ossimLazChunkThread*> threads;
+   for (ossim_uint32 i = 1; i < THREADS; ++i)
+   {
+      threads.push_back(new ossimLazChunkThread(this, missing, i, THREADS, decoded));
+      threads.back()->start();
+   }
+   ossimLazChunkThread(this, missing, 0, std::max<ossim_uint32>(THREADS, 1), decoded).run();
+   for (ossim_uint32 i = 0; i < threads.size(); ++i)
+   {
+      threads[i]->join();
+      delete threads[i];
+   }
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_cacheMutex);
+   for (ossim_uint32 i = 0; i < missing.size(); ++i)
+   {
+      chunks[missing[i] - first] = decoded[i];
+      if (!decoded[i].valid() || !m_maxCachedChunks)
+         continue;
+      if (m_chunkCache.find(missing[i]) == m_chunkCache.end())
+         m_lru.push_front(missing[i]);
+      m_chunkCache[missing[i]] = decoded[i];
+   }
+   while (m_lru.size() > m_maxCachedChunks)
+   {
+      m_chunkCache.erase(m_lru.back());
+      m_lru.pop_back();
+   }
+}
+
+bool ossimLazPointCloudHandler::decodeChunk(ossim_uint32 chunk, ossimPointColumnBlock& block) const
+{
+   block.clear();
+#if OSSIM_HAS_LASZIP
+   if (chunk >= getNumChunks())
+      return false;
+
+   Decoder* decoder = acquireDecoder();
+   if (!decoder)
+      return false;
+
+   const ossim_uint32 first = chunk * m_chunkSize;
+   const ossim_uint32 n = std::min(m_chunkSize, m_numPoints - first);
+   if (!decoder->read(first, n))
+   {
+      // The decoder state is unknown after an error, do not pool it:
+      delete decoder;
+      return false;
+   }
+   decodeRecords(&decoder->m_records[0], decoder->m_recordSize, first, n, block);
+   releaseDecoder(decoder);
+   return true;
+#else
+   return false;
+#endif
+}
+
+ossimLazPointCloudHandler::Decoder* ossimLazPointCloudHandler::acquireDecoder() const
+{
+#if OSSIM_HAS_LASZIP
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_decoderMutex);
+      if (!m_decoders.empty())
+      {
+         Decoder* decoder = m_decoders.back();
+         m_decoders.pop_back();
+         return decoder;
+      }
+   }
+
+   Decoder* decoder = new Decoder();
+   if (!m_laszip || !decoder->open(m_inputFilename, m_hdr.getOffsetToPointData(), m_laszip))
+   {
+      delete decoder;
+      decoder = 0;
+   }
+   return decoder;
+#else
+   return 0;
+#endif
+}
+
+void ossimLazPointCloudHandler::releaseDecoder(Decoder* decoder) const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_decoderMutex);
+   m_decoders.push_back(decoder);
+}
+
+void ossimLazPointCloudHandler::decodeRecords(const ossim_uint8* records,
+                                              ossim_uint32 stride,
+                                              ossim_uint32 firstId,
+                                              ossim_uint32 numRecords,
+                                              ossimPointColumnBlock& block) const
+{
+#if OSSIM_HAS_LASZIP
+   block.setFieldCode(m_fieldCode);
+   block.resize(numRecords);
+
+   ossim_float64* x = block.getX();
+   ossim_float64* y = block.getY();
+   ossim_float64* z = block.getZ();
+   ossim_uint32* ids = block.getPointIds();
+   ossim_float32* intensity = block.getFloatField(ossimPointRecord::Intensity);
+   ossim_uint8* returnNumber = block.getByteField(ossimPointRecord::ReturnNumber);
+   ossim_uint8* numReturns = block.getByteField(ossimPointRecord::NumberOfReturns);
+   ossim_uint8* classification = block.getByteField(ossimPointRecord::Classification);
+   ossim_float64* gpsTime = block.getGpsTime();
+   ossim_float32* red = block.getFloatField(ossimPointRecord::Red);
+   ossim_float32* green = block.getFloatField(ossimPointRecord::Green);
+   ossim_float32* blue = block.getFloatField(ossimPointRecord::Blue);
+
+   // Point formats 0 to 5 share the first 20 bytes; GPS time and RGB follow:
+   const ossim_uint32 rgbOffset = (m_pointFormat == 2) ? 20 : 28;
+
+   ossimEndian* endian = (ossim::byteOrder() == OSSIM_BIG_ENDIAN) ? new ossimEndian() : 0;
+   ossim_int32 xyz[3];
+   ossim_uint16 u16[3];
+   ossim_float64 t;
+   for (ossim_uint32 i = 0; i < numRecords; ++i)
+   {
+      const ossim_uint8* rec = records + (size_t) i * stride;
+      ids[i] = firstId + i;
+      memcpy(xyz, rec, 12);
+      if (endian)
+         endian->swap(xyz, 3);
+      x[i] = xyz[0] * m_hdr.getScaleFactorX() + m_hdr.getOffsetX();
+      y[i] = xyz[1] * m_hdr.getScaleFactorY() + m_hdr.getOffsetY();
+      z[i] = xyz[2] * m_hdr.getScaleFactorZ() + m_hdr.getOffsetZ();
+
+      memcpy(u16, rec + 12, 2);
+      if (endian)
+         endian->swap(u16[0]);
+      intensity[i] = u16[0];
+      returnNumber[i] = rec[14] & 0x07;
+      numReturns[i] = (rec[14] >> 3) & 0x07;
+      classification[i] = rec[15] & 0x1F; // upper bits are the synthetic/key-point/withheld flags
+
+      if (gpsTime)
+      {
+         memcpy(&t, rec + 20, 8);
+         if (endian)
+            endian->swap(t);
+         gpsTime[i] = t;
+      }
+      if (red)
+      {
+         memcpy(u16, rec + rgbOffset, 6);
+         if (endian)
+            endian->swap(u16, 3);
+         red[i] = u16[0];
+         green[i] = u16[1];
+         blue[i] = u16[2];
+      }
+   }
+   delete endian;
+#else
+   block.clear();
+#endif
+}
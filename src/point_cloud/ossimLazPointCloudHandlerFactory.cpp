@@ -0,0 +1,67 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+
+#include <ossim/point_cloud/ossimLazPointCloudHandlerFactory.h>
+#include <ossim/point_cloud/ossimLazPointCloudHandler.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimKeywordNames.h>
+
+RTTI_DEF1(ossimLazPointCloudHandlerFactory, "ossimLazPointCloudHandlerFactory",
+          ossimPointCloudHandlerFactory);
+
+ossimLazPointCloudHandlerFactory* ossimLazPointCloudHandlerFactory::m_instance = 0;
+
+ossimLazPointCloudHandlerFactory::~ossimLazPointCloudHandlerFactory()
+{
+   m_instance = 0;
+}
+
+ossimLazPointCloudHandlerFactory* ossimLazPointCloudHandlerFactory::instance()
+{
+   if (!m_instance)
+      m_instance = new ossimLazPointCloudHandlerFactory;
+   return m_instance;
+}
+
+ossimPointCloudHandler* ossimLazPointCloudHandlerFactory::open(const ossimFilename& fileName) const
+{
+   if (fileName.ext().downcase() != "laz")
+      return 0;
+
+   ossimRefPtr<ossimLazPointCloudHandler> handler = new ossimLazPointCloudHandler();
+   if (!handler->open(fileName))
+      return 0;
+   return handler.release();
+}
+
+ossimPointCloudHandler* ossimLazPointCloudHandlerFactory::open(const ossimKeywordlist& kwl,
+                                                               const char* prefix) const
+{
+   const char* lookup = kwl.find(prefix, ossimKeywordNames::FILENAME_KW);
+   if (!lookup)
+      return 0;
+   return open(ossimFilename(lookup));
+}
+
+ossimObject* ossimLazPointCloudHandlerFactory::createObject(const ossimString& typeName) const
+{
+   if (typeName == STATIC_TYPE_NAME(ossimLazPointCloudHandler))
+      return new ossimLazPointCloudHandler();
+   return 0;
+}
+
+void ossimLazPointCloudHandlerFactory::getTypeNameList(std::vector<ossimString>& typeList) const
+{
+   typeList.push_back(STATIC_TYPE_NAME(ossimLazPointCloudHandler));
+}
+
+void ossimLazPointCloudHandlerFactory::getSupportedExtensions(
+   std::vector<ossimString>& extList) const
+{
+   extList.push_back("laz");
+}
@@ -119,6 +119,8 @@ vector<ossimPointRecord::FIELD_CODES> ossimPointBlock::getFieldCodesAsList() con
       code_list.push_back(ossimPointRecord::GpsTime);
    if (m_fieldCode & ossimPointRecord::Infrared)
       code_list.push_back(ossimPointRecord::Infrared);
+   if (m_fieldCode & ossimPointRecord::Classification)
+      code_list.push_back(ossimPointRecord::Classification);
   return code_list;
 }
 
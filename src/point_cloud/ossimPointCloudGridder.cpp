@@ -0,0 +1,862 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+
+#include <ossim/point_cloud/ossimPointCloudGridder.h>
+#include <ossim/point_cloud/ossimPointColumnBlock.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimGrect.h>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <algorithm>
+#include <cmath>
+
+RTTI_DEF1(ossimPointCloudGridder, "ossimPointCloudGridder", ossimImageSource);
+
+// Fewest points an IDW pixel is interpolated from, if found within the halo:
+static const ossim_uint32 IDW_MIN_POINTS = 6;
+
+//**************************************************************************************************
+// Read-ahead thread of the gridder.
+//**************************************************************************************************
+class ossimPointCloudGridderThread : public OpenThreads::Thread
+{
+public:
+   ossimPointCloudGridderThread(ossimPointCloudGridder* gridder)
+      : OpenThreads::Thread(), m_gridder(gridder) {}
+   virtual void run() { m_gridder->runReadAhead(); }
+private:
+   ossimPointCloudGridder* m_gridder;
+};
+
+//**************************************************************************************************
+// Incremental (Bowyer-Watson) Delaunay triangulation of the samples of a tile. Triangles are
+// counterclockwise; n[i] is the triangle across the edge facing vertex v[i], -1 on the hull.
+// Vertices 0 to 2 are the corners of a triangle enclosing all samples.
+//**************************************************************************************************
+class ossimPcgTriangulation
+{
+public:
+   struct Triangle
+   {
+      ossim_int32 v[3];
+      ossim_int32 n[3];
+      bool        dead;
+   };
+
+   ossimPcgTriangulation(double minX, double minY, double maxX, double maxY, ossim_uint32 n)
+      : m_last(0)
+   {
+      const double cx = 0.5 * (minX + maxX);
+      const double cy = 0.5 * (minY + maxY);
+      const double m = 10.0 * (std::max(maxX - minX, maxY - minY) + 1.0);
+      m_x.reserve(n + 3);
+      m_y.reserve(n + 3);
+      m_z.reserve(n + 3);
+      addVertex(cx - 20.0*m, cy - m, 0.0);
+      addVertex(cx + 20.0*m, cy - m, 0.0);
+      addVertex(cx, cy + 20.0*m, 0.0);
+      m_tris.reserve(2*n + 1);
+      Triangle t;
+      for (ossim_uint32 i = 0; i < 3; ++i)
+      {
+         t.v[i] = i;
+         t.n[i] = -1;
+      }
+      t.dead = false;
+      m_tris.push_back(t);
+   }
+
+   /** Inserts a sample; samples must be distinct. */
+   void insert(double x, double y, double z)
+   {
+      const ossim_int32 p = addVertex(x, y, z);
+      const ossim_int32 start = locate(p);
+      if (start < 0)
+         return;
+
+      // Cavity: the triangles around start whose circumcircle holds p.
+      m_cavity.clear();
+      m_cavity.push_back(start);
+      m_tris[start].dead = true;
+      for (ossim_uint32 i = 0; i < m_cavity.size(); ++i)
+      {
+         const Triangle& t = m_tris[m_cavity[i]];
+         for (ossim_uint32 e = 0; e < 3; ++e)
+         {
+            const ossim_int32 nb = t.n[e];
+            if ((nb >= 0) && !m_tris[nb].dead && inCircle(m_tris[nb], p))
+            {
+               m_tris[nb].dead = true;
+               m_cavity.push_back(nb);
+            }
+         }
+      }
+
+      // Boundary edges (a, b) of the cavity, counterclockwise, and the triangle outside each:
+      m_edges.clear();
+      for (ossim_uint32 i = 0; i < m_cavity.size(); ++i)
+      {
+         const Triangle& t = m_tris[m_cavity[i]];
+         for (ossim_uint32 e = 0; e < 3; ++e)
+         {
+            const ossim_int32 nb = t.n[e];
+            if ((nb < 0) || !m_tris[nb].dead)
+            {
+               Edge edge;
+               edge.a = t.v[(e+1)%3];
+               edge.b = t.v[(e+2)%3];
+               edge.outside = nb;
+               m_edges.push_back(edge);
+            }
+         }
+      }
+      for (ossim_uint32 i = 0; i < m_cavity.size(); ++i)
+         m_free.push_back(m_cavity[i]);
+
+      // Fan of triangles (a, b, p) filling the cavity:
+      for (ossim_uint32 i = 0; i < m_edges.size(); ++i)
+      {
+         Edge& edge = m_edges[i];
+         Triangle t;
+         t.v[0] = edge.a;
+         t.v[1] = edge.b;
+         t.v[2] = p;
+         t.n[0] = t.n[1] = -1;
+         t.n[2] = edge.outside;
+         t.dead = false;
+         edge.tri = newTriangle(t);
+         if (edge.outside >= 0)
+         {
+            Triangle& o = m_tris[edge.outside];
+            for (ossim_uint32 e = 0; e < 3; ++e)
+            {
+               if ((o.v[(e+1)%3] == edge.b) && (o.v[(e+2)%3] == edge.a))
+               {
+                  o.n[e] = edge.tri;
+                  break;
+               }
+            }
+         }
+      }
+
+      // Links within the fan: edge (b, p) is shared with the triangle starting at b, and edge
+      // (p, a) with the one ending at a.
+      for (ossim_uint32 i = 0; i < m_edges.size(); ++i)
+      {
+         Triangle& t = m_tris[m_edges[i].tri];
+         for (ossim_uint32 j = 0; j < m_edges.size(); ++j)
+         {
+            if (m_edges[j].a == m_edges[i].b)
+               t.n[0] = m_edges[j].tri;
+            if (m_edges[j].b == m_edges[i].a)
+               t.n[1] = m_edges[j].tri;
+         }
+      }
+      m_last = m_edges.empty() ? 0 : m_edges[0].tri;
+   }
+
+   ossim_uint32 numTriangles() const { return (ossim_uint32) m_tris.size(); }
+   const Triangle& triangle(ossim_uint32 i) const { return m_tris[i]; }
+   double x(ossim_int32 v) const { return m_x[v]; }
+   double y(ossim_int32 v) const { return m_y[v]; }
+   double z(ossim_int32 v) const { return m_z[v]; }
+
+private:
+   struct Edge
+   {
+      ossim_int32 a;
+      ossim_int32 b;
+      ossim_int32 outside;
+      ossim_int32 tri;
+   };
+
+   ossim_int32 addVertex(double x, double y, double z)
+   {
+      m_x.push_back(x);
+      m_y.push_back(y);
+      m_z.push_back(z);
+      return (ossim_int32) m_x.size() - 1;
+   }
+
+   ossim_int32 newTriangle(const Triangle& t)
+   {
+      if (!m_free.empty())
+      {
+         const ossim_int32 i = m_free.back();
+         m_free.pop_back();
+         m_tris[i] = t;
+         return i;
+      }
+      m_tris.push_back(t);
+      return (ossim_int32) m_tris.size() - 1;
+   }
+
+   /** Twice the signed area of (a, b, p); positive when counterclockwise. */
+   double orient(ossim_int32 a, ossim_int32 b, ossim_int32 p) const
+   {
+      return (m_x[b] - m_x[a]) * (m_y[p] - m_y[a]) - (m_y[b] - m_y[a]) * (m_x[p] - m_x[a]);
+   }
+
+   bool inCircle(const Triangle& t, ossim_int32 p) const
+   {
+      const double ax = m_x[t.v[0]] - m_x[p], ay = m_y[t.v[0]] - m_y[p];
+      const double bx = m_x[t.v[1]] - m_x[p], by = m_y[t.v[1]] - m_y[p];
+      const double cx = m_x[t.v[2]] - m_x[p], cy = m_y[t.v[2]] - m_y[p];
+      const double det = (ax*ax + ay*ay) * (bx*cy - cx*by) -
+                         (bx*bx + by*by) * (ax*cy - cx*ay) +
+                         (cx*cx + cy*cy) * (ax*by - bx*ay);
+      return (det > 0.0);
+   }
+
+   bool contains(const Triangle& t, ossim_int32 p) const
+   {
+      return ((orient(t.v[1], t.v[2], p) >= 0.0) && (orient(t.v[2], t.v[0], p) >= 0.0) &&
+              (orient(t.v[0], t.v[1], p) >= 0.0));
+   }
+
+   /** Triangle holding p, walked to from the last one inserted. */
+   ossim_int32 locate(ossim_int32 p) const
+   {
+      ossim_int32 t = m_last;
+      for (ossim_uint32 step = 0; (t >= 0) && (step < m_tris.size()); ++step)
+      {
+         const Triangle& tri = m_tris[t];
+         ossim_int32 next = -1;
+         for (ossim_uint32 e = 0; e < 3; ++e)
+         {
+            if (orient(tri.v[(e+1)%3], tri.v[(e+2)%3], p) < 0.0)
+            {
+               next = tri.n[e];
+               break;
+            }
+         }
+         if (next < 0)
+            break;
+         t = next;
+      }
+      if ((t >= 0) && !m_tris[t].dead && contains(m_tris[t], p))
+         return t;
+
+      // Walk cycled on a degenerate configuration:
+      for (ossim_uint32 i = 0; i < m_tris.size(); ++i)
+      {
+         if (!m_tris[i].dead && contains(m_tris[i], p))
+            return i;
+      }
+      return -1;
+   }
+
+   std::vector<double>      m_x;
+   std::vector<double>      m_y;
+   std::vector<double>      m_z;
+   std::vector<Triangle>    m_tris;
+   std::vector<ossim_int32> m_free;
+   std::vector<ossim_int32> m_cavity;
+   std::vector<Edge>        m_edges;
+   ossim_int32              m_last;
+};
+
+//**************************************************************************************************
+// ossimPointCloudGridder
+//**************************************************************************************************
+ossimPointCloudGridder::ossimPointCloudGridder(ossimPointCloudHandler* pch, ossimImageGeometry* geom)
+   : ossimImageSource(0, 0, 0, true, false),
+     m_pch(pch),
+     m_geom(geom),
+     m_reducer(MAX_Z),
+     m_halo(16),
+     m_tileBudget(0),
+     m_numThreads(0),
+     m_tilesPerRow(0),
+     m_numTiles(0),
+     m_minHgt(0.0),
+     m_maxHgt(0.0),
+     m_nextId(0),
+     m_stopFlag(false)
+{
+   m_imageRect.makeNan();
+   ossim::defaultTileSize(m_tileSize);
+   if (m_pch.valid() && m_geom.valid())
+      initialize();
+}
+
+ossimPointCloudGridder::~ossimPointCloudGridder()
+{
+   stopThreads();
+}
+
+void ossimPointCloudGridder::setInputs(ossimPointCloudHandler* pch, ossimImageGeometry* geom)
+{
+   m_pch = pch;
+   m_geom = geom;
+   initialize();
+}
+
+bool ossimPointCloudGridder::setReducer(const ossimString& name)
+{
+   const ossimString s = name.downcase();
+   if (s == "min")
+      m_reducer = MIN_Z;
+   else if (s == "max")
+      m_reducer = MAX_Z;
+   else if (s == "mean")
+      m_reducer = MEAN_Z;
+   else if (s == "idw")
+      m_reducer = IDW;
+   else if (s == "tin")
+      m_reducer = TIN;
+   else
+      return false;
+   return true;
+}
+
+ossim_uint32 ossimPointCloudGridder::getNumberOfThreads() const
+{
+   return m_numThreads ? m_numThreads : ossim::getNumberOfThreads();
+}
+
+ossim_uint32 ossimPointCloudGridder::getTileBudget() const
+{
+   return m_tileBudget ? m_tileBudget : 4 * getNumberOfThreads();
+}
+
+void ossimPointCloudGridder::initialize()
+{
+   stopThreads();
+
+   m_imageRect.makeNan();
+   m_tilesPerRow = 0;
+   m_numTiles = 0;
+   if (!m_pch.valid() || !m_geom.valid())
+      return;
+
+   ossimGrect bounds;
+   m_pch->getBounds(bounds);
+
+   // Output rect covers all four corners, in case the projection is rotated to the lon/lat grid:
+   ossimDpt corner[4];
+   m_geom->worldToLocal(bounds.ul(), corner[0]);
+   m_geom->worldToLocal(bounds.ur(), corner[1]);
+   m_geom->worldToLocal(bounds.lr(), corner[2]);
+   m_geom->worldToLocal(bounds.ll(), corner[3]);
+   if (corner[0].hasNans() || corner[1].hasNans() || corner[2].hasNans() || corner[3].hasNans())
+      return;
+   ossimDpt ul (corner[0]);
+   ossimDpt lr (corner[0]);
+   for (ossim_uint32 i = 1; i < 4; ++i)
+   {
+      ul.x = std::min(ul.x, corner[i].x);
+      ul.y = std::min(ul.y, corner[i].y);
+      lr.x = std::max(lr.x, corner[i].x);
+      lr.y = std::max(lr.y, corner[i].y);
+   }
+   m_imageRect = ossimIrect(ossim::round<ossim_int32,double>(ul.x),
+                            ossim::round<ossim_int32,double>(ul.y),
+                            ossim::round<ossim_int32,double>(lr.x),
+                            ossim::round<ossim_int32,double>(lr.y));
+   m_geom->setImageSize(m_imageRect.size());
+
+   m_tilesPerRow = (m_imageRect.width() + m_tileSize.x - 1) / m_tileSize.x;
+   m_numTiles = m_tilesPerRow * ((m_imageRect.height() + m_tileSize.y - 1) / m_tileSize.y);
+
+   m_minHgt = 0.0;
+   m_maxHgt = 0.0;
+   if (m_pch->getMinPoint() && m_pch->getMaxPoint())
+   {
+      m_minHgt = m_pch->getMinPoint()->getPosition().hgt;
+      m_maxHgt = m_pch->getMaxPoint()->getPosition().hgt;
+   }
+}
+
+ossimIrect ossimPointCloudGridder::getBoundingRect(ossim_uint32 resLevel) const
+{
+   ossimIrect rect;
+   if (resLevel == 0)
+      rect = m_imageRect;
+   else
+      rect.makeNan();
+   return rect;
+}
+
+double ossimPointCloudGridder::getNullPixelValue(ossim_uint32 /* band */) const
+{
+   return OSSIM_DEFAULT_NULL_PIX_FLOAT;
+}
+
+double ossimPointCloudGridder::getMinPixelValue(ossim_uint32 /* band */) const
+{
+   return m_minHgt;
+}
+
+double ossimPointCloudGridder::getMaxPixelValue(ossim_uint32 /* band */) const
+{
+   return m_maxHgt;
+}
+
+ossimRefPtr<ossimImageData> ossimPointCloudGridder::newTile(const ossimIrect& rect) const
+{
+   ossimRefPtr<ossimImageData> tile = new ossimImageData(
+      const_cast<ossimPointCloudGridder*>(this), OSSIM_FLOAT32, 1, rect.width(), rect.height());
+   tile->setMinPix(getMinPixelValue(0), 0);
+   tile->setMaxPix(getMaxPixelValue(0), 0);
+   tile->setNullPix(getNullPixelValue(0), 0);
+   tile->setImageRectangle(rect);
+   tile->initialize();
+   return tile;
+}
+
+ossimRefPtr<ossimImageData> ossimPointCloudGridder::getTile(const ossimIrect& rect,
+                                                            ossim_uint32 resLevel)
+{
+   if (!isSourceEnabled() || (resLevel != 0) || m_imageRect.hasNans())
+      return 0;
+
+   ossimRefPtr<ossimImageData> tile = newTile(rect);
+   if (!getTile(tile.get(), resLevel))
+      return 0;
+   return tile;
+}
+
+bool ossimPointCloudGridder::getTile(ossimImageData* result, ossim_uint32 resLevel)
+{
+   if (!result || (resLevel != 0) || m_imageRect.hasNans() ||
+       (result->getNumberOfBands() != 1))
+   {
+      return false;
+   }
+
+   result->makeBlank();
+   const ossimIrect rect = result->getImageRectangle();
+   if (!rect.intersects(m_imageRect))
+      return true;
+   const ossimIrect clip = rect.clipToRect(m_imageRect);
+
+   // Grid tiles under the request; a tile is last used once the request reaches its corner.
+   const ossim_int64 col0 = (clip.ul().x - m_imageRect.ul().x) / m_tileSize.x;
+   const ossim_int64 col1 = (clip.lr().x - m_imageRect.ul().x) / m_tileSize.x;
+   const ossim_int64 row0 = (clip.ul().y - m_imageRect.ul().y) / m_tileSize.y;
+   const ossim_int64 row1 = (clip.lr().y - m_imageRect.ul().y) / m_tileSize.y;
+   for (ossim_int64 row = row0; row <= row1; ++row)
+   {
+      for (ossim_int64 col = col0; col <= col1; ++col)
+      {
+         const ossim_int64 id = row * m_tilesPerRow + col;
+         const ossimIrect gridRect = getGridTileRect(id);
+         const bool lastUse = ((gridRect.lr().x <= clip.lr().x) &&
+                               (gridRect.lr().y <= clip.lr().y));
+         ossimRefPtr<ossimImageData> gridded = fetchGridTile(id, lastUse);
+         if (gridded.valid() && (gridded->getDataObjectStatus() != OSSIM_EMPTY))
+            result->loadTile(gridded.get());
+      }
+   }
+   result->validate();
+   return true;
+}
+
+ossimIrect ossimPointCloudGridder::getGridTileRect(ossim_int64 id) const
+{
+   const ossim_int32 x = m_imageRect.ul().x + (ossim_int32) (id % m_tilesPerRow) * m_tileSize.x;
+   const ossim_int32 y = m_imageRect.ul().y + (ossim_int32) (id / m_tilesPerRow) * m_tileSize.y;
+   return ossimIrect(x, y, std::min(x + m_tileSize.x - 1, m_imageRect.lr().x),
+                     std::min(y + m_tileSize.y - 1, m_imageRect.lr().y));
+}
+
+ossimRefPtr<ossimImageData> ossimPointCloudGridder::fetchGridTile(ossim_int64 id, bool lastUse)
+{
+   const ossim_uint32 numThreads = getNumberOfThreads();
+   if (numThreads < 2)
+   {
+      ossimRefPtr<ossimImageData> tile = newTile(getGridTileRect(id));
+      gridTile(tile.get());
+      return tile;
+   }
+
+   ossimRefPtr<ossimImageData> tile;
+   m_mutex.lock();
+   if (m_threads.empty())
+      startThreads();
+
+   // Read ahead from past this request; finished tiles over a row behind it will not be read.
+   if (id >= m_nextId)
+   {
+      m_nextId = id + 1;
+      while (!m_gridded.empty() && (m_gridded.begin()->first < id - m_tilesPerRow))
+         m_gridded.erase(m_gridded.begin());
+      m_workReady.broadcast();
+   }
+
+   while (!tile.valid())
+   {
+      std::map<ossim_int64, ossimRefPtr<ossimImageData> >::iterator i = m_gridded.find(id);
+      if (i != m_gridded.end())
+      {
+         tile = i->second;
+         if (lastUse)
+         {
+            m_gridded.erase(i);
+            m_workReady.broadcast();
+         }
+      }
+      else if (m_inProgress.find(id) != m_inProgress.end())
+      {
+         m_tileReady.wait(&m_mutex);
+      }
+      else
+      {
+         // Not read ahead (out of order, or dropped): grid it here.
+         m_inProgress.insert(id);
+         m_mutex.unlock();
+         tile = newTile(getGridTileRect(id));
+         gridTile(tile.get());
+         m_mutex.lock();
+         m_inProgress.erase(id);
+         if (!lastUse)
+            m_gridded[id] = tile;
+         m_tileReady.broadcast();
+      }
+   }
+   m_mutex.unlock();
+   return tile;
+}
+
+void ossimPointCloudGridder::runReadAhead()
+{
+   const std::size_t budget = getTileBudget();
+   m_mutex.lock();
+   while (!m_stopFlag)
+   {
+      if ((m_nextId >= m_numTiles) || (m_gridded.size() + m_inProgress.size() >= budget))
+      {
+         m_workReady.wait(&m_mutex);
+         continue;
+      }
+      const ossim_int64 id = m_nextId++;
+      if ((m_gridded.find(id) != m_gridded.end()) || (m_inProgress.find(id) != m_inProgress.end()))
+         continue;
+
+      m_inProgress.insert(id);
+      m_mutex.unlock();
+      ossimRefPtr<ossimImageData> tile = newTile(getGridTileRect(id));
+      gridTile(tile.get());
+      m_mutex.lock();
+      m_inProgress.erase(id);
+      m_gridded[id] = tile;
+      m_tileReady.broadcast();
+   }
+   m_mutex.unlock();
+}
+
+void ossimPointCloudGridder::startThreads()
+{
+   // Called with m_mutex locked; the requesting thread grids too, so one less is started.
+   const ossim_uint32 numThreads = getNumberOfThreads();
+   for (ossim_uint32 i = 1; i < numThreads; ++i)
+   {
+      ossimPointCloudGridderThread* thread = new ossimPointCloudGridderThread(this);
+      thread->start();
+      m_threads.push_back(thread);
+   }
+}
+
+void ossimPointCloudGridder::stopThreads()
+{
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_mutex);
+      m_stopFlag = true;
+      m_workReady.broadcast();
+   }
+   for (ossim_uint32 i = 0; i < m_threads.size(); ++i)
+   {
+      m_threads[i]->join();
+      delete m_threads[i];
+   }
+   m_threads.clear();
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_mutex);
+   m_stopFlag = false;
+   m_gridded.clear();
+   m_inProgress.clear();
+   m_nextId = 0;
+}
+
+bool ossimPointCloudGridder::gridTile(ossimImageData* tile) const
+{
+   if (!tile || !m_pch.valid() || !m_geom.valid())
+      return false;
+
+   const ossimIrect rect = tile->getImageRectangle();
+   const ossim_int32 halo = (ossim_int32) m_halo;
+   const ossimIrect haloRect (rect.ul().x - halo, rect.ul().y - halo,
+                              rect.lr().x + halo, rect.lr().y + halo);
+
+   ossimGpt gnd_ul, gnd_lr;
+   m_geom->localToWorld(ossimDpt(haloRect.ul().x - 0.5, haloRect.ul().y - 0.5), gnd_ul);
+   m_geom->localToWorld(ossimDpt(haloRect.lr().x + 0.5, haloRect.lr().y + 0.5), gnd_lr);
+   const ossimGrect gnd_rect (gnd_ul, gnd_lr);
+
+   ossimPointColumnBlock points (0);
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_pchMutex);
+      m_pch->rewind();
+      m_pch->getBlock(gnd_rect, points);
+   }
+   if (points.empty())
+      return true;
+
+   // Pixel coordinates relative to the halo rect, and their cells:
+   const ossim_uint32 width = haloRect.width();
+   const ossim_uint32 height = haloRect.height();
+   const ossim_uint32 numCells = width * height;
+   std::vector<ossim_uint32> cell (points.size());
+   std::vector<ossim_float64> px (points.size());
+   std::vector<ossim_float64> py (points.size());
+   std::vector<ossim_uint32> cellStart (numCells + 1, 0);
+   ossimDpt ipt;
+   for (ossim_uint32 i = 0; i < points.size(); ++i)
+   {
+      cell[i] = numCells;
+      if (ossim::isnan(points.getZ()[i]))
+         continue;
+      m_geom->worldToLocal(points.getPosition(i), ipt);
+      px[i] = ipt.x - haloRect.ul().x;
+      py[i] = ipt.y - haloRect.ul().y;
+      const ossim_float64 cx = ossim::round<ossim_float64,ossim_float64>(px[i]);
+      const ossim_float64 cy = ossim::round<ossim_float64,ossim_float64>(py[i]);
+      if ((cx < 0.0) || (cy < 0.0) || (cx >= width) || (cy >= height))
+         continue;
+      cell[i] = (ossim_uint32) cy * width + (ossim_uint32) cx;
+      ++cellStart[cell[i] + 1];
+   }
+   for (ossim_uint32 c = 0; c < numCells; ++c)
+      cellStart[c + 1] += cellStart[c];
+
+   // Counting sort of the points by cell:
+   const ossim_uint32 numInside = cellStart[numCells];
+   std::vector<ossim_float64> x (numInside);
+   std::vector<ossim_float64> y (numInside);
+   std::vector<ossim_float64> z (numInside);
+   std::vector<ossim_uint32> next (cellStart.begin(), cellStart.end() - 1);
+   for (ossim_uint32 i = 0; i < points.size(); ++i)
+   {
+      if (cell[i] == numCells)
+         continue;
+      const ossim_uint32 j = next[cell[i]]++;
+      x[j] = px[i];
+      y[j] = py[i];
+      z[j] = points.getZ()[i];
+   }
+
+   if (m_reducer == IDW)
+      interpolateIdw(tile, haloRect, cellStart, x, y, z);
+   else if (m_reducer == TIN)
+      interpolateTin(tile, haloRect, cellStart, x, y, z);
+   else
+      reduceBins(tile, haloRect, cellStart, x, y, z);
+
+   tile->validate();
+   return true;
+}
+
+void ossimPointCloudGridder::reduceBins(ossimImageData* tile, const ossimIrect& haloRect,
+                                        const std::vector<ossim_uint32>& cellStart,
+                                        const std::vector<ossim_float64>& /* x */,
+                                        const std::vector<ossim_float64>& /* y */,
+                                        const std::vector<ossim_float64>& z) const
+{
+   const ossim_uint32 tileWidth = tile->getWidth();
+   const ossim_uint32 tileHeight = tile->getHeight();
+   const ossim_uint32 width = haloRect.width();
+   ossim_float32* buf = tile->getFloatBuf(0);
+
+   for (ossim_uint32 ty = 0; ty < tileHeight; ++ty)
+   {
+      for (ossim_uint32 tx = 0; tx < tileWidth; ++tx)
+      {
+         const ossim_uint32 c = (ty + m_halo) * width + tx + m_halo;
+         const ossim_uint32 first = cellStart[c];
+         const ossim_uint32 last = cellStart[c + 1];
+         if (first == last)
+            continue;
+
+         ossim_float64 value = z[first];
+         for (ossim_uint32 i = first + 1; i < last; ++i)
+         {
+            if (m_reducer == MIN_Z)
+               value = std::min(value, z[i]);
+            else if (m_reducer == MAX_Z)
+               value = std::max(value, z[i]);
+            else
+               value += z[i];
+         }
+         if (m_reducer == MEAN_Z)
+            value /= (last - first);
+         buf[ty * tileWidth + tx] = (ossim_float32) value;
+      }
+   }
+}
+
+void ossimPointCloudGridder::interpolateIdw(ossimImageData* tile, const ossimIrect& haloRect,
+                                            const std::vector<ossim_uint32>& cellStart,
+                                            const std::vector<ossim_float64>& x,
+                                            const std::vector<ossim_float64>& y,
+                                            const std::vector<ossim_float64>& z) const
+{
+   const ossim_int32 tileWidth = tile->getWidth();
+   const ossim_int32 tileHeight = tile->getHeight();
+   const ossim_int32 width = haloRect.width();
+   const ossim_int32 height = haloRect.height();
+   const ossim_int32 halo = (ossim_int32) m_halo;
+   ossim_float32* buf = tile->getFloatBuf(0);
+
+   for (ossim_int32 ty = 0; ty < tileHeight; ++ty)
+   {
+      for (ossim_int32 tx = 0; tx < tileWidth; ++tx)
+      {
+         const ossim_int32 cx = tx + halo;
+         const ossim_int32 cy = ty + halo;
+
+         // Rings of cells out from the pixel, until enough points are found, plus one more ring
+         // for the points nearer than the farthest ones of the last ring:
+         ossim_float64 sumW = 0.0;
+         ossim_float64 sumWz = 0.0;
+         ossim_uint32 found = 0;
+         ossim_int32 lastRing = halo;
+         bool exact = false;
+         for (ossim_int32 r = 0; (r <= lastRing) && !exact; ++r)
+         {
+            for (ossim_int32 dy = -r; (dy <= r) && !exact; ++dy)
+            {
+               const ossim_int32 row = cy + dy;
+               if ((row < 0) || (row >= height))
+                  continue;
+               const ossim_int32 step = ((dy == -r) || (dy == r)) ? 1 : 2*r;
+               for (ossim_int32 dx = -r; dx <= r; dx += step)
+               {
+                  const ossim_int32 col = cx + dx;
+                  if ((col < 0) || (col >= width))
+                     continue;
+                  const ossim_uint32 c = row * width + col;
+                  for (ossim_uint32 i = cellStart[c]; i < cellStart[c + 1]; ++i)
+                  {
+                     const ossim_float64 ddx = x[i] - cx;
+                     const ossim_float64 ddy = y[i] - cy;
+                     const ossim_float64 d2 = ddx*ddx + ddy*ddy;
+                     if (d2 < 1.0e-12)
+                     {
+                        sumWz = z[i];
+                        sumW = 1.0;
+                        exact = true;
+                        break;
+                     }
+                     sumW += 1.0 / d2;
+                     sumWz += z[i] / d2;
+                     ++found;
+                  }
+                  if (exact)
+                     break;
+               }
+            }
+            if ((found >= IDW_MIN_POINTS) && (lastRing > r + 1))
+               lastRing = r + 1;
+         }
+         if (sumW > 0.0)
+            buf[ty * tileWidth + tx] = (ossim_float32) (sumWz / sumW);
+      }
+   }
+}
+
+void ossimPointCloudGridder::interpolateTin(ossimImageData* tile, const ossimIrect& haloRect,
+                                            const std::vector<ossim_uint32>& cellStart,
+                                            const std::vector<ossim_float64>& x,
+                                            const std::vector<ossim_float64>& y,
+                                            const std::vector<ossim_float64>& z) const
+{
+   const ossim_int32 tileWidth = tile->getWidth();
+   const ossim_int32 tileHeight = tile->getHeight();
+   const ossim_uint32 numCells = haloRect.area();
+   const ossim_int32 halo = (ossim_int32) m_halo;
+   ossim_float32* buf = tile->getFloatBuf(0);
+
+   // One sample per occupied cell, the mean of its points, keeps the samples distinct and the
+   // triangulation no larger than the halo rect:
+   ossim_uint32 numSamples = 0;
+   for (ossim_uint32 c = 0; c < numCells; ++c)
+   {
+      if (cellStart[c + 1] > cellStart[c])
+         ++numSamples;
+   }
+   if (numSamples < 3)
+      return;
+
+   ossimPcgTriangulation tin (0.0, 0.0, haloRect.width(), haloRect.height(), numSamples);
+   for (ossim_uint32 c = 0; c < numCells; ++c)
+   {
+      const ossim_uint32 first = cellStart[c];
+      const ossim_uint32 last = cellStart[c + 1];
+      if (first == last)
+         continue;
+      ossim_float64 sx = 0.0, sy = 0.0, sz = 0.0;
+      for (ossim_uint32 i = first; i < last; ++i)
+      {
+         sx += x[i];
+         sy += y[i];
+         sz += z[i];
+      }
+      const ossim_float64 n = last - first;
+      tin.insert(sx / n, sy / n, sz / n);
+   }
+
+   // Linear interpolation at the pixel centers inside each triangle. Triangles on the enclosing
+   // corners, or spanning gaps wider than the halo, are left null.
+   const ossim_float64 maxEdge2 = (2.0*halo + 1.0) * (2.0*halo + 1.0);
+   for (ossim_uint32 t = 0; t < tin.numTriangles(); ++t)
+   {
+      const ossimPcgTriangulation::Triangle& tri = tin.triangle(t);
+      if (tri.dead || (tri.v[0] < 3) || (tri.v[1] < 3) || (tri.v[2] < 3))
+         continue;
+
+      const ossim_float64 x0 = tin.x(tri.v[0]), y0 = tin.y(tri.v[0]);
+      const ossim_float64 x1 = tin.x(tri.v[1]), y1 = tin.y(tri.v[1]);
+      const ossim_float64 x2 = tin.x(tri.v[2]), y2 = tin.y(tri.v[2]);
+      if (((x1-x0)*(x1-x0) + (y1-y0)*(y1-y0) > maxEdge2) ||
+          ((x2-x1)*(x2-x1) + (y2-y1)*(y2-y1) > maxEdge2) ||
+          ((x0-x2)*(x0-x2) + (y0-y2)*(y0-y2) > maxEdge2))
+      {
+         continue;
+      }
+      const ossim_float64 area = (x1 - x0) * (y2 - y0) - (y1 - y0) * (x2 - x0);
+      if (area <= 0.0)
+         continue;
+
+      // Pixels of the tile in the triangle's bounding box:
+      const ossim_int32 minX = std::max((ossim_int32) std::ceil(std::min(x0, std::min(x1, x2))) - halo, 0);
+      const ossim_int32 maxX = std::min((ossim_int32) std::floor(std::max(x0, std::max(x1, x2))) - halo,
+                                        tileWidth - 1);
+      const ossim_int32 minY = std::max((ossim_int32) std::ceil(std::min(y0, std::min(y1, y2))) - halo, 0);
+      const ossim_int32 maxY = std::min((ossim_int32) std::floor(std::max(y0, std::max(y1, y2))) - halo,
+                                        tileHeight - 1);
+      for (ossim_int32 ty = minY; ty <= maxY; ++ty)
+      {
+         const ossim_float64 py = ty + halo;
+         for (ossim_int32 tx = minX; tx <= maxX; ++tx)
+         {
+            const ossim_float64 px = tx + halo;
+            const ossim_float64 w0 = ((x1 - px) * (y2 - py) - (y1 - py) * (x2 - px)) / area;
+            const ossim_float64 w1 = ((x2 - px) * (y0 - py) - (y2 - py) * (x0 - px)) / area;
+            const ossim_float64 w2 = 1.0 - w0 - w1;
+            if ((w0 < -1.0e-9) || (w1 < -1.0e-9) || (w2 < -1.0e-9))
+               continue;
+            buf[ty * tileWidth + tx] = (ossim_float32) (w0 * tin.z(tri.v[0]) +
+                                                        w1 * tin.z(tri.v[1]) +
+                                                        w2 * tin.z(tri.v[2]));
+         }
+      }
+   }
+}
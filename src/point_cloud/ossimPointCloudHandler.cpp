@@ -8,6 +8,9 @@
 // $Id$
 
 #include <ossim/point_cloud/ossimPointCloudHandler.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <OpenThreads/ScopedLock>
 
 RTTI_DEF1(ossimPointCloudHandler, "ossimPointCloudHandler" , ossimPointCloudSource);
 
@@ -29,38 +32,236 @@ ossimPointCloudHandler::~ossimPointCloudHandler()
 {
 }
 
+void ossimPointCloudHandler::getFileBlock(ossim_uint32 offset,
+                                          ossimPointColumnBlock& block,
+                                          ossim_uint32 maxPts) const
+{
+   block.clear();
+   ossimPointBlock record_block;
+   record_block.setFieldCode(block.getFieldCode());
+   getFileBlock(offset, record_block, maxPts);
+   block.append(record_block);
+}
+
 void ossimPointCloudHandler::getNextFileBlock(ossimPointBlock& block, ossim_uint32 maxPts) const
 {
    getFileBlock(m_currentPID, block, maxPts);
    return;
 }
 
+void ossimPointCloudHandler::getNextFileBlock(ossimPointColumnBlock& block,
+                                              ossim_uint32 maxPts) const
+{
+   getFileBlock(m_currentPID, block, maxPts);
+}
+
 void ossimPointCloudHandler::getBlock(const ossimGrect& bounds, ossimPointBlock& block) const
 {
    block.clear();
 
-   // This default implementation simply reads the whole datafile in file-blocks, retaining
-   // only those points inside the bounds:
-   ossimPointBlock file_block;
-   rewind();
-   ossimGpt gpt;
+   // Read column blocks so that only the points kept become records:
+   ossim_uint32 field_code = block.getFieldCode();
+   if (field_code == 0)
+      field_code = getFieldCode();
+   ossimPointColumnBlock columns (field_code);
+   getBlock(bounds, columns);
+   columns.appendTo(block);
+}
 
-   do
+void ossimPointCloudHandler::getBlock(const ossimGrect& bounds, ossimPointColumnBlock& block) const
+{
+   block.clear();
+
+   // The file blocks also carry the fields the point filter tests, those the file has:
+   const ossim_uint32 filterFields = m_pointFilter.valid() ? m_pointFilter->getFieldCode() : 0;
+   ossimPointColumnBlock file_block (block.getFieldCode() | (filterFields & getFieldCode()));
+   const ossimPointBoundsFilter boundsFilter (bounds);
+   ossimPointFilter::Selection selection;
+
+   // The file-blocks to scan, as [offset, offset+count) point ranges. Without an index this
+   // default implementation simply reads the whole datafile:
+   std::vector< std::pair<ossim_uint32, ossim_uint32> > ranges;
+   const ossimPointCloudIndex* index = getSpatialIndex();
+   if (index)
    {
-      file_block.clear();
-      getNextFileBlock(file_block, DEFAULT_BLOCK_SIZE);
-      ossimPointBlock::PointList& pointList = file_block.getPoints();
-      ossimPointBlock::PointList::iterator iter = pointList.begin();
-      while (iter != pointList.end())
+      std::vector< std::pair<ossim_uint32, ossim_uint32> > runs;
+      index->getChunkRuns(bounds, runs);
+      for (ossim_uint32 i=0; i<runs.size(); ++i)
       {
-         gpt = (*iter)->getPosition();
-         if (bounds.pointWithin(gpt))
-         {
-            block.addPoint(iter->get());
-         }
-         ++iter;
+         ranges.push_back(std::make_pair(runs[i].first * index->getChunkSize(),
+                                         (runs[i].second - runs[i].first + 1) *
+                                         index->getChunkSize()));
+      }
+   }
+   else
+   {
+      ranges.push_back(std::make_pair((ossim_uint32) 0, (ossim_uint32) 0xFFFFFFFF));
+   }
+
+   for (ossim_uint32 r=0; r<ranges.size(); ++r)
+   {
+      ossim_uint32 offset = ranges[r].first;
+      ossim_uint32 remaining = ranges[r].second;
+      while (remaining)
+      {
+         const ossim_uint32 numToRead = std::min(remaining, DEFAULT_BLOCK_SIZE);
+         getFileBlock(offset, file_block, numToRead);
+         const ossim_uint32 numPoints = file_block.size();
+
+         // Points passing are copied a run of consecutive ones at a time:
+         ossimPointFilter::selectAll(file_block, selection);
+         boundsFilter.filter(file_block, selection);
+         if (m_pointFilter.valid() && !selection.empty())
+            m_pointFilter->filter(file_block, selection);
+         block.append(file_block, selection);
+         if (numPoints < numToRead)
+            break;
+         offset += numPoints;
+         remaining -= numPoints;
       }
-   } while (file_block.size() == DEFAULT_BLOCK_SIZE);
+   }
+}
+
+void ossimPointCloudHandler::getBlock(const ossimGrect& bounds,
+                                      ossimPointBlock& block,
+                                      double gsd) const
+{
+   block.clear();
+   ossim_uint32 field_code = block.getFieldCode();
+   if (field_code == 0)
+      field_code = getFieldCode();
+   ossimPointColumnBlock columns (field_code);
+   getBlock(bounds, columns, gsd);
+   columns.appendTo(block);
+}
+
+void ossimPointCloudHandler::getBlock(const ossimGrect& bounds,
+                                      ossimPointColumnBlock& block,
+                                      double gsd) const
+{
+   const ossimPointCloudPyramid* pyramid = (gsd > 0.0) ? getPyramid() : 0;
+   const ossim_int32 level = pyramid ? pyramid->getLevelForGsd(gsd) : -1;
+   if (level < 0)
+   {
+      getBlock(bounds, block);
+      return;
+   }
+   block.clear();
+   if (!m_pointFilter.valid())
+   {
+      pyramid->getBlock((ossim_uint32) level, bounds, block);
+      return;
+   }
+
+   ossimPointColumnBlock level_block (block.getFieldCode() |
+                                      (m_pointFilter->getFieldCode() & getFieldCode()));
+   pyramid->getBlock((ossim_uint32) level, bounds, level_block);
+   ossimPointFilter::Selection selection;
+   ossimPointFilter::selectAll(level_block, selection);
+   m_pointFilter->filter(level_block, selection);
+   block.append(level_block, selection);
+}
+
+void ossimPointCloudHandler::setPointFilter(ossimPointFilter* filter)
+{
+   m_pointFilter = filter;
+}
+
+const ossimPointCloudIndex* ossimPointCloudHandler::getSpatialIndex() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_indexMutex);
+
+   if (m_index.valid() && (m_indexFile == m_inputFilename) &&
+       (m_index->getNumPoints() == getNumPoints()))
+   {
+      return m_index.get();
+   }
+   m_index = 0;
+
+   const char* lookup = ossimPreferences::instance()->findPreference("point_cloud.spatial_index");
+   if (lookup && !ossimString(lookup).toBool())
+      return 0;
+
+   ossimRefPtr<ossimPointCloudIndex> index = new ossimPointCloudIndex();
+   ossimFilename sidecar;
+   ossim_int64 fileSize = 0;
+   if (!m_inputFilename.empty() && m_inputFilename.isFile())
+   {
+      sidecar = ossimPointCloudIndex::getSidecarFile(m_inputFilename);
+      fileSize = m_inputFilename.fileSize();
+   }
+
+   if (sidecar.empty() || !sidecar.exists() ||
+       !index->load(sidecar, getNumPoints(), fileSize))
+   {
+      if (!index->build(*this, getIndexChunkSize()))
+         return 0;
+
+      // The sidecar is an optimization; a read only directory is not an error.
+      index->setFileSize(fileSize);
+      if (!sidecar.empty())
+         index->save(sidecar);
+   }
+
+   m_index = index;
+   m_indexFile = m_inputFilename;
+   return m_index.get();
+}
+
+ossim_uint32 ossimPointCloudHandler::getIndexChunkSize() const
+{
+   ossim_uint32 chunkSize = ossimPointCloudIndex::DEFAULT_CHUNK_SIZE;
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("point_cloud.index_chunk_size");
+   if (lookup && ossimString(lookup).toUInt32())
+      chunkSize = ossimString(lookup).toUInt32();
+   return chunkSize;
+}
+
+const ossimPointCloudPyramid* ossimPointCloudHandler::getPyramid() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_pyramidMutex);
+
+   if (m_pyramid.valid() && (m_pyramidFile == m_inputFilename) &&
+       (m_pyramid->getNumCloudPoints() == getNumPoints()))
+   {
+      return m_pyramid.get();
+   }
+   m_pyramid = 0;
+
+   const char* lookup = ossimPreferences::instance()->findPreference("point_cloud.lod_pyramid");
+   if (lookup && !ossimString(lookup).toBool())
+      return 0;
+
+   ossim_uint32 maxPoints = ossimPointCloudPyramid::DEFAULT_MAX_POINTS;
+   lookup = ossimPreferences::instance()->findPreference("point_cloud.lod_max_points");
+   if (lookup && ossimString(lookup).toUInt32())
+      maxPoints = ossimString(lookup).toUInt32();
+
+   ossimRefPtr<ossimPointCloudPyramid> pyramid = new ossimPointCloudPyramid();
+   ossimFilename sidecar;
+   ossim_int64 fileSize = 0;
+   if (!m_inputFilename.empty() && m_inputFilename.isFile())
+   {
+      sidecar = ossimPointCloudPyramid::getSidecarFile(m_inputFilename);
+      fileSize = m_inputFilename.fileSize();
+   }
+
+   if (sidecar.empty() || !sidecar.exists() ||
+       !pyramid->load(sidecar, getNumPoints(), fileSize))
+   {
+      if (!pyramid->build(*this, maxPoints))
+         return 0;
+
+      // As the index sidecar, an optimization only:
+      pyramid->setFileSize(fileSize);
+      if (!sidecar.empty())
+         pyramid->save(sidecar);
+   }
+
+   m_pyramid = pyramid;
+   m_pyramidFile = m_inputFilename;
+   return m_pyramid.get();
 }
 
 void ossimPointCloudHandler::getBounds(ossimGrect& bounds) const
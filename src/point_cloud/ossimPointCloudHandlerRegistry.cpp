@@ -10,6 +10,9 @@
 #include <ossim/point_cloud/ossimPointCloudHandlerRegistry.h>
 #include <ossim/point_cloud/ossimPointCloudHandler.h>
 #include <ossim/point_cloud/ossimPointCloudHandlerFactory.h>
+#include <ossim/point_cloud/ossimLazPointCloudHandlerFactory.h>
+#include <ossim/point_cloud/ossimGenericPointCloudHandlerFactory.h>
+#include <ossim/ossimConfig.h>
 
 ossimPointCloudHandlerRegistry* ossimPointCloudHandlerRegistry::m_instance = 0;
 
@@ -17,7 +20,11 @@ RTTI_DEF1(ossimPointCloudHandlerRegistry, "ossimPointCloudHandlerRegistry" , oss
 
 ossimPointCloudHandlerRegistry::ossimPointCloudHandlerRegistry()
 {
-   // TODO Auto-generated constructor stub
+   // Plugins register their factories after these:
+#if OSSIM_HAS_LASZIP
+   registerFactory(ossimLazPointCloudHandlerFactory::instance());
+#endif
+   registerFactory(ossimGenericPointCloudHandlerFactory::instance());
 }
 
 ossimPointCloudHandlerRegistry::~ossimPointCloudHandlerRegistry()
@@ -25,6 +25,8 @@
 #include <ossim/base/ossimNumericProperty.h>
 #include <ossim/base/ossimStringProperty.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
+#include <OpenThreads/ScopedLock>
+#include <algorithm>
 #include <ossim/projection/ossimEpsgProjectionFactory.h>
 
 RTTI_DEF1(ossimPointCloudImageHandler, "ossimPointCloudImageHandler", ossimImageHandler);
@@ -41,51 +43,15 @@ static const char* LOWEST_KW = "LOWEST";
 static const char* RETURNS_KW = "RETURNS";
 static const char* RGB_KW = "RGB";
 
-ossimPointCloudImageHandler::PcrBucket::PcrBucket(const ossim_float32* init_value,
-                                                  ossim_uint32 numBands)
-:  m_numSamples (1)
-{
-   m_bucket = new ossim_float32[numBands];
-   for (ossim_uint32 i=0; i<numBands; i++)
-      m_bucket[i] = init_value[i];
-}
-
-
-ossimPointCloudImageHandler::PcrBucket::PcrBucket(const ossim_float32& R,
-      const ossim_float32& G,
-      const ossim_float32& B)
-:  m_numSamples (1)
-{
-   m_bucket = new ossim_float32[3];
-   m_bucket[0] = R;
-   m_bucket[1] = G;
-   m_bucket[2] = B;
-
-}
-
-
-ossimPointCloudImageHandler::PcrBucket::PcrBucket(const ossim_float32& init_value)
-:  m_numSamples (1)
-{
-   m_bucket = new ossim_float32[1];
-   m_bucket[0] = init_value;
-}
-
-
-ossimPointCloudImageHandler::PcrBucket::~PcrBucket()
-{
-   delete [] m_bucket;
-}
-
-
 ossimPointCloudImageHandler::ossimPointCloudImageHandler()
       : ossimImageHandler(),
         m_maxPixel(1.0),
         m_minPixel(0.0),
         m_gsd(),
         m_gsdFactor (1.0),
-        m_tile(0),
         m_mutex(),
+        m_pchMutex(),
+        m_cacheIds(),
         m_activeComponent(INTENSITY)
 {
    //---
@@ -144,10 +110,10 @@ bool ossimPointCloudImageHandler::setPointCloudHandler(ossimPointCloudHandler* p
 
 void ossimPointCloudImageHandler::close()
 {
+   deleteCaches();
    if (isOpen())
    {
       m_pch->close();
-      m_tile = 0;
       ossimImageHandler::close();
    }
 }
@@ -200,21 +166,26 @@ ossimRefPtr<ossimImageGeometry> ossimPointCloudImageHandler::getImageGeometry()
    return theGeometry;
 }
 
+// Rounds v down to a multiple of size, also for negative v.
+static ossim_int32 alignDown(ossim_int32 v, ossim_int32 size)
+{
+   if (v >= 0)
+      return (v / size) * size;
+   return -(((size - 1 - v) / size) * size);
+}
+
 ossimRefPtr<ossimImageData> ossimPointCloudImageHandler::getTile(const ossimIrect& tile_rect,
                                                                  ossim_uint32 resLevel)
 {
-   if (!m_tile.valid())
-      initTile();
-
-   // Image rectangle must be set prior to calling getTile.
-   m_tile->setImageRectangle(tile_rect);
-   if (getTile(m_tile.get(), resLevel) == false)
+   // A fresh tile per request so concurrent callers do not share a buffer.
+   ossimRefPtr<ossimImageData> tile = newTile(tile_rect);
+   if (getTile(tile.get(), resLevel) == false)
    {
-      if (m_tile->getDataObjectStatus() != OSSIM_NULL)
-         m_tile->makeBlank();
+      if (tile->getDataObjectStatus() != OSSIM_NULL)
+         tile->makeBlank();
    }
 
-   return m_tile;
+   return tile;
 }
 
 bool ossimPointCloudImageHandler::getTile(ossimImageData* result, ossim_uint32 resLevel)
@@ -226,16 +197,98 @@ bool ossimPointCloudImageHandler::getTile(ossimImageData* result, ossim_uint32 r
       return false;
    }
 
-   // Overviews achieved with GSD setting. This may be too slow.
-   ossimDpt gsd (m_gsd);
-   if (resLevel > 0)
-      getGSD(gsd, resLevel);
+   ossim_uint32 numBands = result->getNumberOfBands();
+   if (numBands != getNumberOfInputBands())
+   {
+      // This should never happen;
+      ossimNotify(ossimNotifyLevel_FATAL)
+            << "ossimPointCloudImageHandler::getTile() ERROR: \n"
+            << "Band count of the requested tile does not match the point cloud source. Returning "
+            << "blank tile." << endl;
+      result->makeBlank();
+      return false;
+   }
+
+   result->setNullPix(OSSIM_DEFAULT_NULL_PIX_FLOAT);
+   result->makeBlank();
+
+   const ossimIrect image_rect (0, 0, (ossim_int32) getNumberOfSamples(resLevel) - 1,
+                                (ossim_int32) getNumberOfLines(resLevel) - 1);
+   const ossimIrect tile_rect = result->getImageRectangle();
+   if ((image_rect.width() == 0) || (image_rect.height() == 0) ||
+       !tile_rect.intersects(image_rect))
+   {
+      return true;
+   }
+
+   // Assemble the result from the cached tiles it overlaps:
+   const ossimIrect clip_rect = tile_rect.clipToRect(image_rect);
+   const ossim_int32 tile_width = (ossim_int32) getTileWidth();
+   const ossim_int32 tile_height = (ossim_int32) getTileHeight();
+   const ossim_int32 x0 = alignDown(clip_rect.ul().x, tile_width);
+   const ossim_int32 y0 = alignDown(clip_rect.ul().y, tile_height);
+   for (ossim_int32 y = y0; y <= clip_rect.lr().y; y += tile_height)
+   {
+      for (ossim_int32 x = x0; x <= clip_rect.lr().x; x += tile_width)
+      {
+         ossimRefPtr<ossimImageData> tile = getCachedTile(ossimIpt(x, y), resLevel);
+         if (!tile.valid())
+            return false;
+         if (tile->getDataObjectStatus() != OSSIM_EMPTY)
+            result->loadTile(tile.get());
+      }
+   }
+
+   result->validate();
+   return true;
+}
+
+ossimRefPtr<ossimImageData>
+ossimPointCloudImageHandler::getCachedTile(const ossimIpt& origin, ossim_uint32 resLevel)
+{
+   ossimAppFixedTileCache::ossimAppFixedCacheId cacheId = getCacheId(resLevel);
+   ossimRefPtr<ossimImageData> tile = ossimAppFixedTileCache::instance()->getTile(cacheId, origin);
+   if (tile.valid())
+      return tile;
+
+   // Not cached. Two threads may rasterize the same tile here, the second add just replaces the
+   // first one's identical tile, which is cheaper than holding a lock over the rasterization.
+   const ossimIrect rect (origin.x, origin.y,
+                          origin.x + (ossim_int32) getTileWidth() - 1,
+                          origin.y + (ossim_int32) getTileHeight() - 1);
+   tile = newTile(rect);
+   tile->setNullPix(OSSIM_DEFAULT_NULL_PIX_FLOAT);
+   tile->makeBlank();
+   bool status = false;
+   if ((resLevel == 0) || hasLodLevel(resLevel))
+      status = rasterizeTile(tile.get(), resLevel);
+   else
+      status = decimateTile(tile.get(), resLevel);
+   if (!status)
+      return 0;
+
+   tile->validate();
+   ossimAppFixedTileCache::instance()->addTile(cacheId, tile, false);
+   return tile;
+}
+
+bool ossimPointCloudImageHandler::hasLodLevel(ossim_uint32 resLevel)
+{
+   // Thinned points do not sum to the returns of a pixel:
+   if ((resLevel == 0) || (m_activeComponent == RETURNS) || m_gsd.hasNans())
+      return false;
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_pchMutex);
+   const ossimPointCloudPyramid* pyramid = m_pch->getPyramid();
+   return (pyramid && (pyramid->getLevelForGsd(m_gsd.x * (1 << resLevel)) >= 0));
+}
 
-   // Establish the ground and image rects for this tile:
-   const ossimIrect img_tile_rect = result->getImageRectangle();
+bool ossimPointCloudImageHandler::rasterizeTile(ossimImageData* tile, ossim_uint32 resLevel)
+{
+   // Establish the ground rect for this tile:
+   const ossimIrect img_tile_rect = tile->getImageRectangle();
    const ossimIpt tile_offset (img_tile_rect.ul());
    const ossim_uint32 tile_width = img_tile_rect.width();
-   const ossim_uint32 tile_height = img_tile_rect.height();
    const ossim_uint32 tile_size = img_tile_rect.area();
 
    ossimGpt gnd_ul, gnd_lr;
@@ -245,192 +298,192 @@ bool ossimPointCloudImageHandler::getTile(ossimImageData* result, ossim_uint32 r
    theGeometry->rnToWorld(dpt_lr, resLevel, gnd_lr);
    const ossimGrect gnd_rect (gnd_ul, gnd_lr);
 
-   // Create array of buckets to store accumulated point data.
-   ossim_uint32 numBands = result->getNumberOfBands();
-   if (numBands > getNumberOfInputBands())
-   {
-      // This should never happen;
-      ossimNotify(ossimNotifyLevel_FATAL)
-            << "ossimPointCloudImageHandler::getTile() ERROR: \n"
-            << "More bands were requsted than was available from the point cloud source. Returning "
-            << "blank tile." << endl;
-      result->makeBlank();
-      return false;
-   }
-   std::map<ossim_int32, PcrBucket*> accumulator;
-
    // initialize a point block with desired fields as requested in the reader properties
    ossimPointBlock pointBlock (this);
    pointBlock.setFieldCode(componentToFieldCode());
-   m_pch->rewind();
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_pchMutex);
+      m_pch->rewind();
+      if (resLevel)
+         m_pch->getBlock(gnd_rect, pointBlock, m_gsd.x * (1 << resLevel));
+      else
+         m_pch->getBlock(gnd_rect, pointBlock);
+   }
 
-   ossimDpt ipt;
-   ossimGpt pos;
+   // Dense accumulators, band sequential, and the sample count of each pixel:
+   const ossim_uint32 numBands = tile->getNumberOfBands();
+   std::vector<ossim_float32> accum (numBands * tile_size, 0.0f);
+   std::vector<ossim_uint32> counts (tile_size, 0);
 
-#define USE_GETBLOCK
-#ifdef USE_GETBLOCK
-   m_pch->getBlock(gnd_rect, pointBlock);
+   ossimDpt ipt;
+   ossim_float32 value[3];
    for (ossim_uint32 id=0; id<pointBlock.size(); ++id)
    {
-      pos = pointBlock[id]->getPosition();
-      theGeometry->worldToRn(pos, resLevel, ipt);
+      const ossimPointRecord* sample = pointBlock[id];
+      theGeometry->worldToRn(sample->getPosition(), resLevel, ipt);
       ipt.x = ossim::round<double,double>(ipt.x) - tile_offset.x;
       ipt.y = ossim::round<double,double>(ipt.y) - tile_offset.y;
-
-      ossim_int32 bucketIndex = ipt.y*tile_width + ipt.x;
-      if ((bucketIndex >= 0) && (bucketIndex < (ossim_int32)tile_size))
-         addSample(accumulator, bucketIndex, pointBlock[id]);
-   }
-
-#else // using getFileBlock
-   ossim_uint32 numPoints = m_pch->getNumPoints();
-   if (numPoints > ossimPointCloudHandler::DEFAULT_BLOCK_SIZE)
-      numPoints = ossimPointCloudHandler::DEFAULT_BLOCK_SIZE;
-
-   // Loop to read all point blocks:
-   do
-   {
-      pointBlock.clear();
-      m_pch->getNextFileBlock(pointBlock, numPoints);
-      //m_pch->normalizeBlock(pointBlock);
-
-      for (ossim_uint32 id=0; id<pointBlock.size(); ++id)
+      if ((ipt.x < 0) || (ipt.y < 0) || (ipt.x >= tile_width) ||
+          (ipt.y >= img_tile_rect.height()))
       {
-         // Check that each point in read block is inside the ROI before accumulating it:
-         pos = pointBlock[id]->getPosition();
-         if (gnd_rect.pointWithin(pos))
-         {
-            theGeometry->worldToRn(pos, resLevel, ipt);
-            ipt.x = ossim::round<double,double>(ipt.x) - tile_offset.x;
-            ipt.y = ossim::round<double,double>(ipt.y) - tile_offset.y;
+         continue;
+      }
+      ossim_uint32 index = (ossim_uint32) ipt.y * tile_width + (ossim_uint32) ipt.x;
 
-            ossim_int32 bucketIndex = ipt.y*tile_width + ipt.x;
-            if ((bucketIndex >= 0) && (bucketIndex < (ossim_int32)tile_size))
-               addSample(accumulator, bucketIndex, pointBlock[id]);
-         }
+      if (m_activeComponent == INTENSITY)
+         value[0] = sample->getField(ossimPointRecord::Intensity);
+      else if (m_activeComponent == RGB)
+      {
+         value[0] = sample->getField(ossimPointRecord::Red);
+         value[1] = sample->getField(ossimPointRecord::Green);
+         value[2] = sample->getField(ossimPointRecord::Blue);
       }
-   } while (pointBlock.size() == numPoints);
-#endif
-
-   // Finished accumulating, need to normalize and fill the tile.
-   // We must always blank out the tile as we may not have a point for every pixel.
-   normalize(accumulator);
-   ossim_float32** buf = new ossim_float32*[numBands];
-   std::map<ossim_int32, PcrBucket*>::iterator accum_iter;
-   ossim_float32 null_pixel = OSSIM_DEFAULT_NULL_PIX_FLOAT;
-   result->setNullPix(null_pixel);
-   for (ossim_uint32 band = 0; band < numBands; band++)
-   {
-      ossim_uint32 index = 0;
-      buf[band] = result->getFloatBuf(band);
-      for (ossim_uint32 y = 0; y < tile_height; y++)
+      else if ((m_activeComponent == LOWEST) || (m_activeComponent == HIGHEST))
+         value[0] = sample->getPosition().hgt;
+      else
+         value[0] = sample->getField(ossimPointRecord::NumberOfReturns);
+
+      for (ossim_uint32 band=0; band<numBands; ++band)
       {
-         for (ossim_uint32 x = 0; x < tile_width; x++)
-         {
-            accum_iter = accumulator.find(index);
-            if (accum_iter != accumulator.end())
-               buf[band][index] = accum_iter->second->m_bucket[band];
-            else
-               buf[band][index] = null_pixel;
-            ++index;
-         }
+         ossim_float32& bucket = accum[band*tile_size + index];
+         if (counts[index] == 0)
+            bucket = value[band];
+         else if (m_activeComponent == HIGHEST)
+            bucket = std::max(bucket, value[band]);
+         else if (m_activeComponent == LOWEST)
+            bucket = std::min(bucket, value[band]);
+         else
+            bucket += value[band];
       }
+      ++counts[index];
    }
 
-   delete [] buf;
-   buf = 0;
-
-   std::map<ossim_int32, PcrBucket*>::iterator pcr_iter = accumulator.begin();
-   while (pcr_iter != accumulator.end())
+   // Intensity and color are means; highest and lowest latch extremes and returns are summed.
+   const bool mean = ((m_activeComponent == INTENSITY) || (m_activeComponent == RGB));
+   const ossim_float32 null_pixel = OSSIM_DEFAULT_NULL_PIX_FLOAT;
+   for (ossim_uint32 band = 0; band < numBands; band++)
    {
-      delete pcr_iter->second;
-      pcr_iter++;
+      ossim_float32* buf = tile->getFloatBuf(band);
+      const ossim_float32* bucket = &accum[band*tile_size];
+      for (ossim_uint32 index = 0; index < tile_size; ++index)
+      {
+         if (counts[index] == 0)
+            buf[index] = null_pixel;
+         else if (mean)
+            buf[index] = bucket[index] / counts[index];
+         else
+            buf[index] = bucket[index];
+      }
    }
 
-   result->validate();
    return true;
 }
 
-void ossimPointCloudImageHandler::addSample(std::map<ossim_int32, PcrBucket*>& accumulator,
-                                            ossim_int32 index,
-                                            const ossimPointRecord* sample)
+bool ossimPointCloudImageHandler::decimateTile(ossimImageData* tile, ossim_uint32 resLevel)
 {
-   if (sample == 0)
-      return;
-
-   //cout << "sample: "<<*sample<<endl;//TODO: REMOVE DEBUG
+   // The tile's pixels are each 2x2 pixels of the level above, which this recursion fetches
+   // (from its own cache) down to R0:
+   const ossimIrect rect = tile->getImageRectangle();
+   const ossim_uint32 width = rect.width();
+   const ossim_uint32 height = rect.height();
+   const ossimIrect parent_rect (rect.ul().x * 2, rect.ul().y * 2,
+                                 rect.ul().x * 2 + (ossim_int32) width * 2 - 1,
+                                 rect.ul().y * 2 + (ossim_int32) height * 2 - 1);
+   ossimRefPtr<ossimImageData> parent = newTile(parent_rect);
+   if (!getTile(parent.get(), resLevel - 1))
+      return false;
+   if (parent->getDataObjectStatus() == OSSIM_EMPTY)
+      return true; // tile already blank
 
-   // Search map for exisiting point in that location:
-   std::map<ossim_int32, PcrBucket*>::iterator iter = accumulator.find(index);
-   if (iter == accumulator.end())
+   const ossim_float32 null_pixel = OSSIM_DEFAULT_NULL_PIX_FLOAT;
+   const ossim_uint32 parent_width = width * 2;
+   const ossim_uint32 numBands = tile->getNumberOfBands();
+   for (ossim_uint32 band = 0; band < numBands; band++)
    {
-      // First hit. Initialize location with current sample:
-      if (m_activeComponent == INTENSITY)
-      {
-         accumulator[index] = new PcrBucket(sample->getField(ossimPointRecord::Intensity));
-      }
-      else if (m_activeComponent == RGB)
+      const ossim_float32* src = parent->getFloatBuf(band);
+      ossim_float32* dst = tile->getFloatBuf(band);
+      for (ossim_uint32 y = 0; y < height; ++y)
       {
-         ossim_float32 color[3];
-         color[0] = sample->getField(ossimPointRecord::Red);
-         color[1] = sample->getField(ossimPointRecord::Green);
-         color[2] = sample->getField(ossimPointRecord::Blue);
-         accumulator[index] = new PcrBucket(color, 3);
+         const ossim_float32* row = src + 2 * y * parent_width;
+         for (ossim_uint32 x = 0; x < width; ++x)
+         {
+            const ossim_float32 v[4] = { row[2*x], row[2*x+1],
+                                         row[parent_width+2*x], row[parent_width+2*x+1] };
+            ossim_float32 r = 0.0f;
+            ossim_uint32 n = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+               if (v[i] == null_pixel)
+                  continue;
+               if (n == 0)
+                  r = v[i];
+               else if (m_activeComponent == HIGHEST)
+                  r = std::max(r, v[i]);
+               else if (m_activeComponent == LOWEST)
+                  r = std::min(r, v[i]);
+               else
+                  r += v[i];
+               ++n;
+            }
+
+            // Returns sum, as binning the points at the coarser GSD would:
+            if (n == 0)
+               r = null_pixel;
+            else if ((m_activeComponent == INTENSITY) || (m_activeComponent == RGB))
+               r /= n;
+            dst[y*width + x] = r;
+         }
       }
-      else if ((m_activeComponent == LOWEST) || (m_activeComponent == HIGHEST))
-         accumulator[index] = new PcrBucket(sample->getPosition().hgt);
-      else if (m_activeComponent == RETURNS)
-         accumulator[index] = new PcrBucket(sample->getField(ossimPointRecord::NumberOfReturns));
    }
-   else
+
+   return true;
+}
+
+ossimAppFixedTileCache::ossimAppFixedCacheId
+ossimPointCloudImageHandler::getCacheId(ossim_uint32 resLevel)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_mutex);
+   if (resLevel >= m_cacheIds.size())
+      m_cacheIds.resize(resLevel + 1, -1);
+   if (m_cacheIds[resLevel] < 0)
    {
-      // Not the first hit at this location, accumulate:
-      // First hit. Initialize location with current sample:
-      if (m_activeComponent == INTENSITY)
-      {
-         iter->second->m_bucket[0] += sample->getField(ossimPointRecord::Intensity);
-      }
-      else if (m_activeComponent == RGB)
-      {
-         iter->second->m_bucket[0] += sample->getField(ossimPointRecord::Red);
-         iter->second->m_bucket[1] += sample->getField(ossimPointRecord::Green);
-         iter->second->m_bucket[2] += sample->getField(ossimPointRecord::Blue);
-      }
-      else if ((m_activeComponent == HIGHEST) &&
-            (sample->getPosition().hgt > iter->second->m_bucket[0]))
-         iter->second->m_bucket[0] = sample->getPosition().hgt;
-      else if ((m_activeComponent == LOWEST) &&
-            (sample->getPosition().hgt < iter->second->m_bucket[0]))
-         iter->second->m_bucket[0] = sample->getPosition().hgt;
-      else if (m_activeComponent == RETURNS)
-         iter->second->m_bucket[0] += sample->getField(ossimPointRecord::NumberOfReturns);
+      const ossimIrect image_rect (0, 0, (ossim_int32) getNumberOfSamples(resLevel) - 1,
+                                   (ossim_int32) getNumberOfLines(resLevel) - 1);
+      m_cacheIds[resLevel] = ossimAppFixedTileCache::instance()->newTileCache(
+         image_rect, ossimIpt(getTileWidth(), getTileHeight()));
+   }
+   return m_cacheIds[resLevel];
+}
 
-      iter->second->m_numSamples++;
+void ossimPointCloudImageHandler::deleteCaches()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_mutex);
+   for (ossim_uint32 i = 0; i < m_cacheIds.size(); ++i)
+   {
+      if (m_cacheIds[i] >= 0)
+         ossimAppFixedTileCache::instance()->deleteCache(m_cacheIds[i]);
    }
+   m_cacheIds.clear();
 }
 
-void ossimPointCloudImageHandler::normalize(std::map<ossim_int32, PcrBucket*>& accumulator)
+ossimRefPtr<ossimImageData> ossimPointCloudImageHandler::newTile(const ossimIrect& rect) const
 {
-   // highest and lowest elevations latch extremes, no mean is computed but needs to be normalized
-   if ((m_activeComponent == LOWEST) || (m_activeComponent == HIGHEST) ||
-         (m_activeComponent == RETURNS))
-      return;
+   const ossim_uint32 BANDS = getNumberOfOutputBands();
 
-   int numBands = 1;
-   if (m_activeComponent == RGB)
-      numBands = 3;
+   ossimRefPtr<ossimImageData> tile = new ossimImageData(
+      const_cast<ossimPointCloudImageHandler*>(this), getOutputScalarType(), BANDS,
+      rect.width(), rect.height());
 
-   std::map<ossim_int32, PcrBucket*>::iterator iter = accumulator.begin();
-   ossim_float32 avg;
-   while (iter != accumulator.end())
+   for (ossim_uint32 band = 0; band < BANDS; ++band)
    {
-      for (int i=0; i<numBands; i++)
-      {
-         avg = iter->second->m_bucket[i] / iter->second->m_numSamples;
-         iter->second->m_bucket[i] = avg;
-      }
-      iter++;
+      tile->setMinPix(getMinPixelValue(band), band);
+      tile->setMaxPix(getMaxPixelValue(band), band);
+      tile->setNullPix(getNullPixelValue(band), band);
    }
+
+   tile->setImageRectangle(rect);
+   tile->initialize();
+   return tile;
 }
 
 ossim_uint32 ossimPointCloudImageHandler::getNumberOfInputBands() const
@@ -529,6 +582,8 @@ bool ossimPointCloudImageHandler::setCurrentEntry(ossim_uint32 entryIdx)
    if (entryIdx >= NUM_COMPONENTS)
       return false;
 
+   if (m_activeComponent != (Components) entryIdx)
+      deleteCaches();
    m_activeComponent = (Components) entryIdx;
    if (m_pch.valid() && m_pch->getMinPoint() && m_pch->getMaxPoint())
    {
@@ -597,22 +652,6 @@ ossim_uint32 ossimPointCloudImageHandler::getNumberOfDecimationLevels() const
    return result;
 }
 
-void ossimPointCloudImageHandler::initTile()
-{
-   const ossim_uint32 BANDS = getNumberOfOutputBands();
-
-   m_tile = new ossimImageData(this, getOutputScalarType(), BANDS, getTileWidth(), getTileHeight());
-
-   for (ossim_uint32 band = 0; band < BANDS; ++band)
-   {
-      m_tile->setMinPix(getMinPixelValue(band), band);
-      m_tile->setMaxPix(getMaxPixelValue(band), band);
-      m_tile->setNullPix(getNullPixelValue(band), band);
-   }
-
-   m_tile->initialize();
-}
-
 void ossimPointCloudImageHandler::getGSD(ossimDpt& gsd, ossim_uint32 resLevel) const
 {
    // std::pow(2.0, 0) returns 1.
@@ -646,6 +685,9 @@ void ossimPointCloudImageHandler::setGSD(const ossim_float64& gsd)
    image_size.y = ossim::round<ossim_int32,double>(ipt_lr.y - ipt_ul.y) + 1;
 
    theGeometry->setImageSize(image_size);
+
+   // Cached tiles were rasterized at the old GSD:
+   deleteCaches();
 }
 
 bool ossimPointCloudImageHandler::saveState(ossimKeywordlist& kwl, const char* prefix) const
@@ -762,7 +804,7 @@ void ossimPointCloudImageHandler::setProperty(ossimRefPtr<ossimProperty> propert
    }
    else if ( property->getName() == ossimKeywordNames::ENTRY_KW )
    {
-      m_activeComponent = (Components) s.toUInt32();
+      setCurrentEntry(s.toUInt32());
    }
    else if ( property->getName() == COMPONENT_KW )
    {
@@ -770,7 +812,7 @@ void ossimPointCloudImageHandler::setProperty(ossimRefPtr<ossimProperty> propert
       {
          if (s.upcase() == m_componentNames[i])
          {
-            m_activeComponent = (Components) i;
+            setCurrentEntry(i);
             break;
          }
       }
@@ -94,12 +94,13 @@ ossimObject* ossimPointCloudImageHandlerFactory::createObject(const ossimString&
 void ossimPointCloudImageHandlerFactory::getSupportedExtensions(ossimImageHandlerFactoryBase::UniqueStringList& extensionList)const
 {
    extensionList.push_back("las");
+   extensionList.push_back("laz");
    extensionList.push_back("gpkg");
 }
 
 void ossimPointCloudImageHandlerFactory::getImageHandlersBySuffix(ossimImageHandlerFactoryBase::ImageHandlerList& result, const ossimString& ext)const
 {
-   if ((ext == "las") || (ext == "gpkg"))
+   if ((ext == "las") || (ext == "laz") || (ext == "gpkg"))
    {
       result.push_back(new ossimPointCloudImageHandler);
       return;
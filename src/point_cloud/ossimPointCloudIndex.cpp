@@ -0,0 +1,370 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#include <ossim/point_cloud/ossimPointCloudIndex.h>
+#include <ossim/point_cloud/ossimPointCloudHandler.h>
+#include <ossim/point_cloud/ossimPointColumnBlock.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimNotify.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+const ossim_uint32 ossimPointCloudIndex::DEFAULT_CHUNK_SIZE = 65536;
+const ossim_uint32 ossimPointCloudIndex::DEFAULT_LEVELS = 8;
+
+static const char         MAGIC[] = "OSSIMPCI";
+static const ossim_uint32 VERSION = 1;
+static const ossim_uint32 BYTE_ORDER_MARK = 0x01020304;
+static const ossim_uint32 MAX_LEVELS = 10;
+
+namespace
+{
+   template <class T> void writeValue(std::ostream& out, const T& value)
+   {
+      out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+   }
+
+   template <class T> bool readValue(std::istream& in, T& value)
+   {
+      in.read(reinterpret_cast<char*>(&value), sizeof(T));
+      return in.good();
+   }
+}
+
+ossimPointCloudIndex::ossimPointCloudIndex()
+:  m_numPoints(0),
+   m_chunkSize(DEFAULT_CHUNK_SIZE),
+   m_levels(DEFAULT_LEVELS),
+   m_fileSize(0)
+{
+   m_bounds.makeNan();
+}
+
+ossimPointCloudIndex::~ossimPointCloudIndex()
+{
+}
+
+ossim_uint32 ossimPointCloudIndex::getNumChunks() const
+{
+   return m_chunkSize ? (m_numPoints + m_chunkSize - 1) / m_chunkSize : 0;
+}
+
+ossimFilename ossimPointCloudIndex::getSidecarFile(const ossimFilename& pointFile)
+{
+   ossimFilename sidecar (pointFile);
+   sidecar += ".pci";
+   return sidecar;
+}
+
+bool ossimPointCloudIndex::build(const ossimPointCloudHandler& handler,
+                                 ossim_uint32 chunkSize,
+                                 ossim_uint32 levels)
+{
+   m_numPoints = 0;
+   m_chunkSize = std::max<ossim_uint32>(chunkSize, 1);
+   ossimPointColumnBlock block (0, m_chunkSize);
+
+   // Bounds from the handler, else from a first pass over the points:
+   ossimGrect bounds;
+   handler.getBounds(bounds);
+   if (bounds.ul().isLatLonNan() || bounds.lr().isLatLonNan())
+   {
+      double minLat = ossim::nan(), maxLat = ossim::nan();
+      double minLon = ossim::nan(), maxLon = ossim::nan();
+      ossim_uint32 offset = 0;
+      do
+      {
+         handler.getFileBlock(offset, block, m_chunkSize);
+         for (ossim_uint32 i=0; i<block.size(); ++i)
+         {
+            const double lon = block.getX()[i];
+            const double lat = block.getY()[i];
+            if (ossim::isnan(lon) || ossim::isnan(lat))
+               continue;
+            if (ossim::isnan(minLat))
+            {
+               minLat = maxLat = lat;
+               minLon = maxLon = lon;
+            }
+            minLat = std::min(minLat, lat);
+            maxLat = std::max(maxLat, lat);
+            minLon = std::min(minLon, lon);
+            maxLon = std::max(maxLon, lon);
+         }
+         offset += block.size();
+      } while (block.size() == m_chunkSize);
+
+      if (ossim::isnan(minLat))
+         return false;
+      bounds = ossimGrect(maxLat, minLon, minLat, maxLon);
+   }
+
+   beginBuild(bounds.ul().lon, bounds.lr().lat, bounds.lr().lon, bounds.ul().lat,
+              m_chunkSize, levels);
+
+   // Points are read a chunk at a time:
+   ossim_uint32 offset = 0;
+   do
+   {
+      handler.getFileBlock(offset, block, m_chunkSize);
+      addChunk(offset / m_chunkSize, block.getX(), block.getY(), block.size());
+      offset += block.size();
+   } while (block.size() == m_chunkSize);
+
+   endBuild(offset);
+   return isValid();
+}
+
+void ossimPointCloudIndex::beginBuild(double minX, double minY, double maxX, double maxY,
+                                      ossim_uint32 chunkSize, ossim_uint32 levels)
+{
+   m_numPoints = 0;
+   m_chunkSize = std::max<ossim_uint32>(chunkSize, 1);
+   m_levels = std::min(levels, MAX_LEVELS);
+   m_bounds = ossimGrect(maxY, minX, minY, maxX);
+
+   const ossim_uint32 side = 1 << m_levels;
+   m_cellChunks.assign(side * side, std::vector<ossim_uint32>());
+   m_nodeCounts.assign(m_levels + 1, std::vector<ossim_uint32>());
+   m_nodeCounts[m_levels].assign(side * side, 0);
+}
+
+void ossimPointCloudIndex::addChunk(ossim_uint32 chunk,
+                                    const ossim_float64* x,
+                                    const ossim_float64* y,
+                                    ossim_uint32 n)
+{
+   // A chunk is listed once in each cell it touches:
+   const ossim_uint32 side = 1 << m_levels;
+   std::vector<ossim_uint32>& leafCounts = m_nodeCounts[m_levels];
+   ossim_uint32 col, row;
+   for (ossim_uint32 i=0; i<n; ++i)
+   {
+      if (ossim::isnan(x[i]) || ossim::isnan(y[i]))
+         continue;
+      getCell(x[i], y[i], col, row);
+      const ossim_uint32 cell = row * side + col;
+      ++leafCounts[cell];
+      std::vector<ossim_uint32>& chunks = m_cellChunks[cell];
+      if (chunks.empty() || (chunks.back() != chunk))
+         chunks.push_back(chunk);
+   }
+}
+
+void ossimPointCloudIndex::endBuild(ossim_uint32 numPoints)
+{
+   m_numPoints = numPoints;
+   buildQuadTree();
+}
+
+void ossimPointCloudIndex::getCell(double lon, double lat,
+                                   ossim_uint32& col, ossim_uint32& row) const
+{
+   const ossim_int32 side = 1 << m_levels;
+   const double width  = m_bounds.lr().lon - m_bounds.ul().lon;
+   const double height = m_bounds.ul().lat - m_bounds.lr().lat;
+
+   ossim_int32 c = (width > 0.0) ?
+      (ossim_int32) ((lon - m_bounds.ul().lon) / width * side) : 0;
+   ossim_int32 r = (height > 0.0) ?
+      (ossim_int32) ((lat - m_bounds.lr().lat) / height * side) : 0;
+
+   col = (ossim_uint32) std::max(0, std::min(c, side - 1));
+   row = (ossim_uint32) std::max(0, std::min(r, side - 1));
+}
+
+void ossimPointCloudIndex::buildQuadTree()
+{
+   // Each parent is the sum of its four children:
+   for (ossim_int32 level=(ossim_int32)m_levels-1; level>=0; --level)
+   {
+      const ossim_uint32 side = 1 << level;
+      const std::vector<ossim_uint32>& children = m_nodeCounts[level + 1];
+      std::vector<ossim_uint32>& nodes = m_nodeCounts[level];
+      nodes.assign(side * side, 0);
+      for (ossim_uint32 row=0; row<side; ++row)
+      {
+         for (ossim_uint32 col=0; col<side; ++col)
+         {
+            const ossim_uint32 c = 2 * row * (2 * side) + 2 * col;
+            nodes[row * side + col] = children[c] + children[c + 1] +
+               children[c + 2 * side] + children[c + 2 * side + 1];
+         }
+      }
+   }
+}
+
+void ossimPointCloudIndex::collectChunks(ossim_uint32 level, ossim_uint32 col, ossim_uint32 row,
+                                         ossim_uint32 c0, ossim_uint32 c1,
+                                         ossim_uint32 r0, ossim_uint32 r1,
+                                         std::vector<ossim_uint32>& chunks) const
+{
+   if (m_nodeCounts[level][row * (1 << level) + col] == 0)
+      return;
+
+   // Leaf cells under the node:
+   const ossim_uint32 shift = m_levels - level;
+   const ossim_uint32 nc0 = col << shift;
+   const ossim_uint32 nc1 = ((col + 1) << shift) - 1;
+   const ossim_uint32 nr0 = row << shift;
+   const ossim_uint32 nr1 = ((row + 1) << shift) - 1;
+   if ((nc1 < c0) || (nc0 > c1) || (nr1 < r0) || (nr0 > r1))
+      return;
+
+   if (level == m_levels)
+   {
+      const std::vector<ossim_uint32>& cell = m_cellChunks[row * (1 << m_levels) + col];
+      chunks.insert(chunks.end(), cell.begin(), cell.end());
+      return;
+   }
+
+   for (ossim_uint32 i=0; i<4; ++i)
+   {
+      collectChunks(level + 1, 2 * col + (i & 1), 2 * row + (i >> 1),
+                    c0, c1, r0, r1, chunks);
+   }
+}
+
+void ossimPointCloudIndex::getChunkRuns(
+   const ossimGrect& bounds, std::vector< std::pair<ossim_uint32, ossim_uint32> >& runs) const
+{
+   runs.clear();
+   if (bounds.ul().isLatLonNan() || bounds.lr().isLatLonNan())
+      return;
+   getChunkRuns(bounds.ul().lon, bounds.lr().lat, bounds.lr().lon, bounds.ul().lat, runs);
+}
+
+void ossimPointCloudIndex::getChunkRuns(
+   double minX, double minY, double maxX, double maxY,
+   std::vector< std::pair<ossim_uint32, ossim_uint32> >& runs) const
+{
+   runs.clear();
+   if (!isValid())
+      return;
+
+   // Nothing if the query misses the cloud:
+   if ((maxX < m_bounds.ul().lon) || (minX > m_bounds.lr().lon) ||
+       (maxY < m_bounds.lr().lat) || (minY > m_bounds.ul().lat))
+   {
+      return;
+   }
+
+   ossim_uint32 c0, c1, r0, r1;
+   getCell(minX, minY, c0, r0);
+   getCell(maxX, maxY, c1, r1);
+
+   std::vector<ossim_uint32> chunks;
+   collectChunks(0, 0, 0, c0, c1, r0, r1, chunks);
+   std::sort(chunks.begin(), chunks.end());
+   chunks.erase(std::unique(chunks.begin(), chunks.end()), chunks.end());
+
+   for (ossim_uint32 i=0; i<chunks.size(); ++i)
+   {
+      if (!runs.empty() && (runs.back().second + 1 == chunks[i]))
+         runs.back().second = chunks[i];
+      else
+         runs.push_back(std::make_pair(chunks[i], chunks[i]));
+   }
+}
+
+bool ossimPointCloudIndex::save(const ossimFilename& file) const
+{
+   if (!isValid())
+      return false;
+
+   std::ofstream out (file.c_str(), std::ios::out | std::ios::binary);
+   if (!out)
+      return false;
+
+   out.write(MAGIC, 8);
+   writeValue(out, BYTE_ORDER_MARK);
+   writeValue(out, VERSION);
+   writeValue(out, m_numPoints);
+   writeValue(out, m_chunkSize);
+   writeValue(out, m_levels);
+   writeValue(out, m_fileSize);
+   writeValue(out, m_bounds.ul().lat);
+   writeValue(out, m_bounds.ul().lon);
+   writeValue(out, m_bounds.lr().lat);
+   writeValue(out, m_bounds.lr().lon);
+
+   const std::vector<ossim_uint32>& leafCounts = m_nodeCounts[m_levels];
+   for (ossim_uint32 i=0; i<m_cellChunks.size(); ++i)
+   {
+      const std::vector<ossim_uint32>& chunks = m_cellChunks[i];
+      writeValue(out, leafCounts[i]);
+      writeValue(out, (ossim_uint32) chunks.size());
+      if (!chunks.empty())
+         out.write(reinterpret_cast<const char*>(&chunks.front()),
+                   chunks.size() * sizeof(ossim_uint32));
+   }
+
+   return out.good();
+}
+
+bool ossimPointCloudIndex::load(const ossimFilename& file,
+                                ossim_uint32 numPoints,
+                                ossim_int64 fileSize)
+{
+   m_numPoints = 0;
+
+   std::ifstream in (file.c_str(), std::ios::in | std::ios::binary);
+   if (!in)
+      return false;
+
+   char magic[8];
+   ossim_uint32 mark, version, points, chunkSize, levels;
+   ossim_int64 size;
+   double ulLat, ulLon, lrLat, lrLon;
+   in.read(magic, 8);
+   if (!in.good() || (memcmp(magic, MAGIC, 8) != 0) ||
+       !readValue(in, mark) || (mark != BYTE_ORDER_MARK) ||
+       !readValue(in, version) || (version != VERSION) ||
+       !readValue(in, points) || !readValue(in, chunkSize) || !readValue(in, levels) ||
+       !readValue(in, size) || !readValue(in, ulLat) || !readValue(in, ulLon) ||
+       !readValue(in, lrLat) || !readValue(in, lrLon))
+   {
+      return false;
+   }
+
+   // Stale or foreign index:
+   if ((levels > MAX_LEVELS) || (chunkSize == 0) || (points == 0) ||
+       (numPoints && (points != numPoints)) || (fileSize && (size != fileSize)))
+   {
+      return false;
+   }
+
+   const ossim_uint32 side = 1 << levels;
+   m_levels = levels;
+   m_chunkSize = chunkSize;
+   m_fileSize = size;
+   m_bounds = ossimGrect(ulLat, ulLon, lrLat, lrLon);
+   m_cellChunks.assign(side * side, std::vector<ossim_uint32>());
+   m_nodeCounts.assign(m_levels + 1, std::vector<ossim_uint32>());
+   m_nodeCounts[m_levels].assign(side * side, 0);
+
+   const ossim_uint32 numChunks = (points + chunkSize - 1) / chunkSize;
+   for (ossim_uint32 i=0; i<m_cellChunks.size(); ++i)
+   {
+      ossim_uint32 count, n;
+      if (!readValue(in, count) || !readValue(in, n) || (n > numChunks))
+         return false;
+      m_nodeCounts[m_levels][i] = count;
+      m_cellChunks[i].resize(n);
+      if (n)
+      {
+         in.read(reinterpret_cast<char*>(&m_cellChunks[i].front()), n * sizeof(ossim_uint32));
+         if (in.fail())
+            return false;
+      }
+   }
+
+   buildQuadTree();
+   m_numPoints = points;
+   return true;
+}
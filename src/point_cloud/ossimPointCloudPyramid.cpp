@@ -0,0 +1,483 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#include <ossim/point_cloud/ossimPointCloudPyramid.h>
+#include <ossim/point_cloud/ossimPointCloudHandler.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimGpt.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+const ossim_uint32 ossimPointCloudPyramid::DEFAULT_MAX_POINTS = 4194304;
+
+static const char         MAGIC[] = "OSSIMPCP";
+static const ossim_uint32 VERSION = 1;
+static const ossim_uint32 BYTE_ORDER_MARK = 0x01020304;
+static const ossim_uint32 GRID_SIZE = 256;    // query grid cells on a side
+static const ossim_uint32 MIN_LEVEL_POINTS = 4096; // no coarser level is made from one this small
+static const ossim_uint32 MAX_LEVELS = 16;
+static const ossim_uint32 READ_BLOCK_SIZE = 65536;
+
+namespace
+{
+   const ossimPointRecord::FIELD_CODES FLOAT_FIELDS[] =
+   {
+      ossimPointRecord::Intensity, ossimPointRecord::Red, ossimPointRecord::Green,
+      ossimPointRecord::Blue, ossimPointRecord::Infrared
+   };
+   const ossim_uint32 NUM_FLOAT_FIELDS = 5;
+   const ossimPointRecord::FIELD_CODES BYTE_FIELDS[] =
+   {
+      ossimPointRecord::ReturnNumber, ossimPointRecord::NumberOfReturns,
+      ossimPointRecord::Classification
+   };
+   const ossim_uint32 NUM_BYTE_FIELDS = 3;
+
+   template <class T> void writeValue(std::ostream& out, const T& value)
+   {
+      out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+   }
+
+   template <class T> bool readValue(std::istream& in, T& value)
+   {
+      in.read(reinterpret_cast<char*>(&value), sizeof(T));
+      return in.good();
+   }
+
+   template <class T> void writeColumn(std::ostream& out, const T* column, ossim_uint32 n)
+   {
+      if (column && n)
+         out.write(reinterpret_cast<const char*>(column), n * sizeof(T));
+   }
+
+   template <class T> bool readColumn(std::istream& in, T* column, ossim_uint32 n)
+   {
+      if (column && n)
+         in.read(reinterpret_cast<char*>(column), n * sizeof(T));
+      return !in.fail();
+   }
+
+   /** Open addressing set of voxel keys; ~0 marks an empty slot. */
+   class VoxelSet
+   {
+   public:
+      void reset(ossim_uint32 maxKeys)
+      {
+         ossim_uint32 bits = 4;
+         while ((1u << bits) < 2 * maxKeys)
+            ++bits;
+         m_shift = 64 - bits;
+         m_slots.assign((size_t) 1 << bits, ~(ossim_uint64) 0);
+         m_size = 0;
+      }
+      /** @return true if key was not in the set. */
+      bool insert(ossim_uint64 key)
+      {
+         const size_t mask = m_slots.size() - 1;
+         size_t i = (size_t) ((key * 0x9E3779B97F4A7C15ULL) >> m_shift);
+         while (m_slots[i] != ~(ossim_uint64) 0)
+         {
+            if (m_slots[i] == key)
+               return false;
+            i = (i + 1) & mask;
+         }
+         m_slots[i] = key;
+         ++m_size;
+         return true;
+      }
+      ossim_uint32 size() const { return m_size; }
+   private:
+      std::vector<ossim_uint64> m_slots;
+      ossim_uint32              m_shift;
+      ossim_uint32              m_size;
+   };
+
+   /** Voxel of each thinning, the spacing in position units. */
+   struct VoxelGrid
+   {
+      double minX, minY, minZ;
+      double dx, dy, dz; // voxel size in position units
+
+      ossim_uint64 key(double x, double y, double z) const
+      {
+         const ossim_uint64 ix = index((x - minX) / dx, 0x1FFFFE);
+         const ossim_uint64 iy = index((y - minY) / dy, 0x1FFFFE);
+         const ossim_uint64 iz = ossim::isnan(z) ? 0 : index((z - minZ) / dz, 0x3FFFFE);
+         return ix | (iy << 21) | (iz << 42);
+      }
+
+      static ossim_uint64 index(double v, ossim_uint64 maxIndex)
+      {
+         if (!(v > 0.0))
+            return 0;
+         return std::min((ossim_uint64) v, maxIndex);
+      }
+   };
+
+   /** Keeps the first point of each voxel of block, in order; voxels holds those kept. */
+   void thinBlock(ossimPointColumnBlock& block, const VoxelGrid& grid, VoxelSet& voxels)
+   {
+      ossimPointColumnBlock thinned (block.getFieldCode());
+      thinned.reserve(block.size() / 2);
+      const ossim_float64* x = block.getX();
+      const ossim_float64* y = block.getY();
+      const ossim_float64* z = block.getZ();
+      ossim_uint32 runStart = 0;
+      ossim_uint32 runLength = 0;
+      for (ossim_uint32 i = 0; i < block.size(); ++i)
+      {
+         if (voxels.insert(grid.key(x[i], y[i], z[i])))
+         {
+            if (runLength == 0)
+               runStart = i;
+            ++runLength;
+         }
+         else if (runLength)
+         {
+            thinned.append(block, runStart, runLength);
+            runLength = 0;
+         }
+      }
+      if (runLength)
+         thinned.append(block, runStart, runLength);
+      block = thinned;
+   }
+}
+
+ossimPointCloudPyramid::ossimPointCloudPyramid()
+:  m_numPoints(0),
+   m_fileSize(0),
+   m_fieldCode(0),
+   m_minZ(0.0)
+{
+   m_bounds.makeNan();
+}
+
+ossimPointCloudPyramid::~ossimPointCloudPyramid()
+{
+}
+
+ossimFilename ossimPointCloudPyramid::getSidecarFile(const ossimFilename& pointFile)
+{
+   ossimFilename sidecar (pointFile);
+   sidecar += ".pcp";
+   return sidecar;
+}
+
+double ossimPointCloudPyramid::getSpacing(ossim_uint32 level) const
+{
+   return (level < m_levels.size()) ? m_levels[level].spacing : ossim::nan();
+}
+
+ossim_uint32 ossimPointCloudPyramid::getNumPoints(ossim_uint32 level) const
+{
+   return (level < m_levels.size()) ? m_levels[level].points->size() : 0;
+}
+
+ossim_int32 ossimPointCloudPyramid::getLevelForGsd(double gsd) const
+{
+   ossim_int32 level = -1;
+   for (ossim_uint32 i = 0; i < m_levels.size(); ++i)
+   {
+      if (m_levels[i].spacing > gsd)
+         break;
+      level = (ossim_int32) i;
+   }
+   return level;
+}
+
+ossimDpt ossimPointCloudPyramid::getMetersPerUnit() const
+{
+   // Geographic positions when the bounds are inside lon/lat range, as the LAS handlers decide:
+   const ossimGpt& ul = m_bounds.ul();
+   const ossimGpt& lr = m_bounds.lr();
+   if ((ul.lon >= -180.0) && (lr.lon <= 180.0) && (lr.lat >= -90.0) && (ul.lat <= 90.0))
+   {
+      const ossimGpt center (0.5 * (ul.lat + lr.lat), 0.5 * (ul.lon + lr.lon));
+      return center.metersPerDegree();
+   }
+   return ossimDpt(1.0, 1.0);
+}
+
+void ossimPointCloudPyramid::getCell(double x, double y, ossim_uint32& col, ossim_uint32& row) const
+{
+   const double w = m_bounds.lr().lon - m_bounds.ul().lon;
+   const double h = m_bounds.ul().lat - m_bounds.lr().lat;
+   double c = (w > 0.0) ? (x - m_bounds.ul().lon) / w * GRID_SIZE : 0.0;
+   double r = (h > 0.0) ? (m_bounds.ul().lat - y) / h * GRID_SIZE : 0.0;
+   c = (c > 0.0) ? std::min(c, GRID_SIZE - 1.0) : 0.0;
+   r = (r > 0.0) ? std::min(r, GRID_SIZE - 1.0) : 0.0;
+   col = (ossim_uint32) c;
+   row = (ossim_uint32) r;
+}
+
+bool ossimPointCloudPyramid::build(const ossimPointCloudHandler& handler, ossim_uint32 maxPoints)
+{
+   m_levels.clear();
+   m_numPoints = handler.getNumPoints();
+   m_fieldCode = handler.getFieldCode();
+   handler.getBounds(m_bounds);
+   if (!m_numPoints || m_bounds.ul().isLatLonNan() || m_bounds.lr().isLatLonNan())
+      return false;
+   maxPoints = std::max(maxPoints, MIN_LEVEL_POINTS);
+   m_minZ = handler.getMinPoint() ? handler.getMinPoint()->getPosition().hgt : 0.0;
+   if (ossim::isnan(m_minZ))
+      m_minZ = 0.0;
+
+   // The point spacing if the points were even over the bounds; the finest level doubles it,
+   // or more until that thinning is expected to fit maxPoints:
+   const ossimDpt mpu = getMetersPerUnit();
+   const double area = (m_bounds.lr().lon - m_bounds.ul().lon) * mpu.x *
+                       (m_bounds.ul().lat - m_bounds.lr().lat) * mpu.y;
+   double spacing = (area > 0.0) ? 2.0 * std::sqrt(area / m_numPoints) : 1.0;
+   double expected = m_numPoints / 4.0;
+   while (expected > maxPoints)
+   {
+      spacing *= 2.0;
+      expected /= 4.0;
+   }
+
+   VoxelGrid grid;
+   grid.minX = m_bounds.ul().lon;
+   grid.minY = m_bounds.lr().lat;
+   grid.minZ = m_minZ;
+   grid.dx = spacing / mpu.x;
+   grid.dy = spacing / mpu.y;
+   grid.dz = spacing;
+
+   // One pass keeps the first point of each voxel. Heights can fill more voxels than expected;
+   // the spacing then doubles and the points kept so far are thinned again.
+   VoxelSet voxels;
+   voxels.reset(maxPoints);
+   ossimRefPtr<ossimPointColumnBlock> kept = new ossimPointColumnBlock(m_fieldCode);
+   ossimPointColumnBlock block (m_fieldCode, READ_BLOCK_SIZE);
+   ossim_uint32 offset = 0;
+   ossim_uint32 numRead = 0;
+   do
+   {
+      handler.getFileBlock(offset, block, READ_BLOCK_SIZE);
+      numRead = block.size();
+      offset += numRead;
+      thinBlock(block, grid, voxels);
+      kept->append(block);
+      while (voxels.size() > maxPoints)
+      {
+         spacing *= 2.0;
+         grid.dx *= 2.0;
+         grid.dy *= 2.0;
+         grid.dz *= 2.0;
+         voxels.reset(maxPoints);
+         thinBlock(*kept, grid, voxels);
+      }
+   } while (numRead == READ_BLOCK_SIZE);
+
+   // Coarser levels thin the finer one until small:
+   while (kept->size() && (m_levels.size() < MAX_LEVELS))
+   {
+      Level level;
+      level.spacing = spacing;
+      level.points = kept;
+      m_levels.push_back(level);
+      if (kept->size() <= MIN_LEVEL_POINTS)
+         break;
+
+      kept = new ossimPointColumnBlock(*kept);
+      spacing *= 2.0;
+      grid.dx *= 2.0;
+      grid.dy *= 2.0;
+      grid.dz *= 2.0;
+      voxels.reset(kept->size());
+      thinBlock(*kept, grid, voxels);
+   }
+
+   for (ossim_uint32 i = 0; i < m_levels.size(); ++i)
+      sortByCell(m_levels[i]);
+   return isValid();
+}
+
+void ossimPointCloudPyramid::sortByCell(Level& level) const
+{
+   const ossimPointColumnBlock& points = *level.points;
+   const ossim_uint32 n = points.size();
+   const ossim_uint32 numCells = GRID_SIZE * GRID_SIZE;
+   std::vector<ossim_uint32> cell (n);
+   level.cellStart.assign(numCells + 1, 0);
+   ossim_uint32 col, row;
+   for (ossim_uint32 i = 0; i < n; ++i)
+   {
+      getCell(points.getX()[i], points.getY()[i], col, row);
+      cell[i] = row * GRID_SIZE + col;
+      ++level.cellStart[cell[i] + 1];
+   }
+   for (ossim_uint32 c = 0; c < numCells; ++c)
+      level.cellStart[c + 1] += level.cellStart[c];
+
+   // Counting sort, the points of a cell staying in file order:
+   std::vector<ossim_uint32> order (n);
+   std::vector<ossim_uint32> next (level.cellStart.begin(), level.cellStart.end() - 1);
+   for (ossim_uint32 i = 0; i < n; ++i)
+      order[next[cell[i]]++] = i;
+
+   ossimRefPtr<ossimPointColumnBlock> sorted = new ossimPointColumnBlock(points.getFieldCode(), n);
+   for (ossim_uint32 i = 0; i < n; ++i)
+      sorted->append(points, order[i], 1);
+   level.points = sorted;
+}
+
+void ossimPointCloudPyramid::getBlock(ossim_uint32 level,
+                                      const ossimGrect& bounds,
+                                      ossimPointColumnBlock& block) const
+{
+   if (level >= m_levels.size())
+      return;
+
+   const Level& lod = m_levels[level];
+   ossim_uint32 c0, c1, r0, r1;
+   getCell(bounds.ul().lon, bounds.ul().lat, c0, r0);
+   getCell(bounds.lr().lon, bounds.lr().lat, c1, r1);
+
+   // Each row of cells is one run of points to test:
+   ossimGpt gpt;
+   for (ossim_uint32 row = r0; row <= r1; ++row)
+   {
+      const ossim_uint32 first = lod.cellStart[row * GRID_SIZE + c0];
+      const ossim_uint32 last = lod.cellStart[row * GRID_SIZE + c1 + 1];
+      ossim_uint32 runStart = first;
+      ossim_uint32 runLength = 0;
+      for (ossim_uint32 i = first; i < last; ++i)
+      {
+         gpt = lod.points->getPosition(i);
+         if (bounds.pointWithin(gpt))
+         {
+            if (runLength == 0)
+               runStart = i;
+            ++runLength;
+         }
+         else if (runLength)
+         {
+            block.append(*lod.points, runStart, runLength);
+            runLength = 0;
+         }
+      }
+      if (runLength)
+         block.append(*lod.points, runStart, runLength);
+   }
+}
+
+bool ossimPointCloudPyramid::save(const ossimFilename& file) const
+{
+   if (!isValid())
+      return false;
+
+   std::ofstream out (file.c_str(), std::ios::out | std::ios::binary);
+   if (!out)
+      return false;
+
+   out.write(MAGIC, 8);
+   writeValue(out, BYTE_ORDER_MARK);
+   writeValue(out, VERSION);
+   writeValue(out, m_numPoints);
+   writeValue(out, m_fileSize);
+   writeValue(out, m_fieldCode);
+   writeValue(out, m_bounds.ul().lat);
+   writeValue(out, m_bounds.ul().lon);
+   writeValue(out, m_bounds.lr().lat);
+   writeValue(out, m_bounds.lr().lon);
+   writeValue(out, m_minZ);
+   writeValue(out, (ossim_uint32) m_levels.size());
+
+   for (ossim_uint32 l = 0; l < m_levels.size(); ++l)
+   {
+      const Level& level = m_levels[l];
+      const ossimPointColumnBlock& points = *level.points;
+      const ossim_uint32 n = points.size();
+      writeValue(out, level.spacing);
+      writeValue(out, n);
+      writeColumn(out, &level.cellStart.front(), (ossim_uint32) level.cellStart.size());
+      writeColumn(out, points.getX(), n);
+      writeColumn(out, points.getY(), n);
+      writeColumn(out, points.getZ(), n);
+      writeColumn(out, points.getPointIds(), n);
+      for (ossim_uint32 f = 0; f < NUM_FLOAT_FIELDS; ++f)
+         writeColumn(out, points.getFloatField(FLOAT_FIELDS[f]), n);
+      for (ossim_uint32 f = 0; f < NUM_BYTE_FIELDS; ++f)
+         writeColumn(out, points.getByteField(BYTE_FIELDS[f]), n);
+      writeColumn(out, points.getGpsTime(), n);
+   }
+
+   return out.good();
+}
+
+bool ossimPointCloudPyramid::load(const ossimFilename& file,
+                                  ossim_uint32 numPoints,
+                                  ossim_int64 fileSize)
+{
+   m_levels.clear();
+
+   std::ifstream in (file.c_str(), std::ios::in | std::ios::binary);
+   if (!in)
+      return false;
+
+   char magic[8];
+   ossim_uint32 mark, version, points, fieldCode, numLevels;
+   ossim_int64 size;
+   double ulLat, ulLon, lrLat, lrLon, minZ;
+   in.read(magic, 8);
+   if (!in.good() || (memcmp(magic, MAGIC, 8) != 0) ||
+       !readValue(in, mark) || (mark != BYTE_ORDER_MARK) ||
+       !readValue(in, version) || (version != VERSION) ||
+       !readValue(in, points) || !readValue(in, size) || !readValue(in, fieldCode) ||
+       !readValue(in, ulLat) || !readValue(in, ulLon) || !readValue(in, lrLat) ||
+       !readValue(in, lrLon) || !readValue(in, minZ) || !readValue(in, numLevels))
+   {
+      return false;
+   }
+
+   // Stale or foreign pyramid:
+   if ((numLevels == 0) || (numLevels > MAX_LEVELS) || (points == 0) ||
+       (numPoints && (points != numPoints)) || (fileSize && (size != fileSize)))
+   {
+      return false;
+   }
+
+   std::vector<Level> levels (numLevels);
+   for (ossim_uint32 l = 0; l < numLevels; ++l)
+   {
+      Level& level = levels[l];
+      ossim_uint32 n;
+      if (!readValue(in, level.spacing) || !readValue(in, n) || (n > points))
+         return false;
+      level.cellStart.resize(GRID_SIZE * GRID_SIZE + 1);
+      if (!readColumn(in, &level.cellStart.front(), (ossim_uint32) level.cellStart.size()) ||
+          (level.cellStart.back() != n))
+      {
+         return false;
+      }
+
+      level.points = new ossimPointColumnBlock(fieldCode, n);
+      ossimPointColumnBlock& block = *level.points;
+      block.resize(n);
+      bool ok = readColumn(in, block.getX(), n) && readColumn(in, block.getY(), n) &&
+                readColumn(in, block.getZ(), n) && readColumn(in, block.getPointIds(), n);
+      for (ossim_uint32 f = 0; ok && (f < NUM_FLOAT_FIELDS); ++f)
+         ok = readColumn(in, block.getFloatField(FLOAT_FIELDS[f]), n);
+      for (ossim_uint32 f = 0; ok && (f < NUM_BYTE_FIELDS); ++f)
+         ok = readColumn(in, block.getByteField(BYTE_FIELDS[f]), n);
+      if (!ok || !readColumn(in, block.getGpsTime(), n))
+         return false;
+   }
+
+   m_numPoints = points;
+   m_fileSize = size;
+   m_fieldCode = fieldCode;
+   m_bounds = ossimGrect(ulLat, ulLon, lrLat, lrLon);
+   m_minZ = minZ;
+   m_levels.swap(levels);
+   return true;
+}
@@ -12,6 +12,7 @@
 
 #include <ossim/point_cloud/ossimPointCloudUtilityFilter.h>
 #include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
 #include <ossim/imaging/ossimImageGeometry.h>
 #include <ossim/elevation/ossimElevManager.h>
 #include <ossim/util/ossimPointCloudUtil.h>
@@ -24,10 +25,24 @@ ossimPointCloudUtilityFilter::ossimPointCloudUtilityFilter( ossimPointCloudUtil*
 {
 }
 
+ossimRefPtr<ossimImageData> ossimPointCloudUtilityFilter::getTile(const ossimIrect& rect,
+                                                                  ossim_uint32 resLevel)
+{
+   ossimRefPtr<ossimImageData> tile =
+      ossimImageDataFactory::instance()->create(this, OSSIM_FLOAT32, 1,
+                                                rect.width(), rect.height());
+   tile->setImageRectangle(rect);
+   tile->initialize();
+   if (!getTile(tile.get(), resLevel))
+      return 0;
+   return tile;
+}
+
 bool ossimPointCloudUtilityFilter::getTile(ossimImageData* result, ossim_uint32 resLevel)
 {
    if (!result)
       return false;
+   result->makeBlank();
 
    ossimIrect irect (result->getImageRectangle());
    ossimIpt ipt;
@@ -37,18 +52,21 @@ bool ossimPointCloudUtilityFilter::getTile(ossimImageData* result, ossim_uint32
    ossimRefPtr<ossimImageData> highest = 0;
    ossimRefPtr<ossimImageData> lowest = 0;
 
-   // Fetch tile from inputs as needed:
+   // Fetch tile from the gridders as needed:
    if ((m_util->m_operation == ossimPointCloudUtil::HIGHEST_DEM) ||
          (m_util->m_operation == ossimPointCloudUtil::HIGHEST_LOWEST))
    {
-      m_util->m_pciHandler->setCurrentEntry(ossimPointCloudImageHandler::HIGHEST);
-      highest = m_util->m_pciHandler->getTile(irect, resLevel);
+      highest = m_util->m_highest->getTile(irect, resLevel);
    }
    if ((m_util->m_operation == ossimPointCloudUtil::LOWEST_DEM) ||
          (m_util->m_operation == ossimPointCloudUtil::HIGHEST_LOWEST))
    {
-      m_util->m_pciHandler->setCurrentEntry(ossimPointCloudImageHandler::LOWEST);
-      lowest = m_util->m_pciHandler->getTile(irect, resLevel);
+      lowest = m_util->m_lowest->getTile(irect, resLevel);
+   }
+   if ((m_util->m_highest.valid() && !highest.valid()) ||
+       (m_util->m_lowest.valid() && !lowest.valid()))
+   {
+      return false;
    }
 
    // Now loop over all pixels in tile and perform operations as needed:
@@ -58,6 +76,8 @@ bool ossimPointCloudUtilityFilter::getTile(ossimImageData* result, ossim_uint32
       for (ipt.x=irect.ul().x; ipt.x<=irect.lr().x; ++ipt.x)
       {
          pt_l0 = ipt * (resLevel + 1);
+         if ((highest.valid() && highest->isNull(ipt)) || (lowest.valid() && lowest->isNull(ipt)))
+            continue; // no points
          switch (m_util->m_operation)
          {
          case ossimPointCloudUtil::HIGHEST_DEM:
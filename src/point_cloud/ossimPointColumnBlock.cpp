@@ -0,0 +1,454 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#include <ossim/point_cloud/ossimPointColumnBlock.h>
+#include <ossim/point_cloud/ossimPointBlock.h>
+#include <ossim/base/ossimCommon.h>
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+   const ossimPointRecord::FIELD_CODES FLOAT_FIELDS[] =
+   {
+      ossimPointRecord::Intensity,
+      ossimPointRecord::Red,
+      ossimPointRecord::Green,
+      ossimPointRecord::Blue,
+      ossimPointRecord::Infrared
+   };
+   const ossim_uint32 NUM_FLOAT_FIELDS = 5;
+
+   const ossimPointRecord::FIELD_CODES BYTE_FIELDS[] =
+   {
+      ossimPointRecord::ReturnNumber,
+      ossimPointRecord::NumberOfReturns,
+      ossimPointRecord::Classification
+   };
+   const ossim_uint32 NUM_BYTE_FIELDS = 3;
+
+   /** Bytes of a column of n values, rounded up to keep the next column 8 byte aligned. */
+   template <class T> ossim_uint32 columnBytes(ossim_uint32 n)
+   {
+      return ((n * sizeof(T) + 7) / 8) * 8;
+   }
+
+   /** Column of n values at p, or null if not present. Advances p past it. */
+   template <class T> T* carve(char*& p, ossim_uint32 n, bool present)
+   {
+      if (!present)
+         return 0;
+      T* column = reinterpret_cast<T*>(p);
+      p += columnBytes<T>(n);
+      return column;
+   }
+
+   template <class T> void copyColumn(T* dest, const T* src, ossim_uint32 n)
+   {
+      if (dest && src && n)
+         memcpy(dest, src, n * sizeof(T));
+   }
+}
+
+ossimPointColumnBlock::ossimPointColumnBlock(ossim_uint32 fields, ossim_uint32 capacity)
+:  m_fieldCode(fields & ossimPointRecord::All),
+   m_size(0),
+   m_capacity(0),
+   m_x(0),
+   m_y(0),
+   m_z(0),
+   m_ids(0),
+   m_intensity(0),
+   m_red(0),
+   m_green(0),
+   m_blue(0),
+   m_infrared(0),
+   m_returnNumber(0),
+   m_numberOfReturns(0),
+   m_classification(0),
+   m_gpsTime(0)
+{
+   allocate(capacity);
+}
+
+ossimPointColumnBlock::ossimPointColumnBlock(const ossimPointColumnBlock& rhs)
+:  ossimReferenced(),
+   m_fieldCode(rhs.m_fieldCode),
+   m_size(0),
+   m_capacity(0),
+   m_x(0),
+   m_y(0),
+   m_z(0),
+   m_ids(0),
+   m_intensity(0),
+   m_red(0),
+   m_green(0),
+   m_blue(0),
+   m_infrared(0),
+   m_returnNumber(0),
+   m_numberOfReturns(0),
+   m_classification(0),
+   m_gpsTime(0)
+{
+   allocate(rhs.m_size);
+   append(rhs);
+}
+
+ossimPointColumnBlock::~ossimPointColumnBlock()
+{
+}
+
+const ossimPointColumnBlock& ossimPointColumnBlock::operator=(const ossimPointColumnBlock& rhs)
+{
+   if (this == &rhs)
+      return *this;
+
+   setFieldCode(rhs.m_fieldCode);
+   clear();
+   append(rhs);
+   return *this;
+}
+
+ossim_uint32 ossimPointColumnBlock::getBytesPerPoint(ossim_uint32 code)
+{
+   ossim_uint32 bytes = 3 * sizeof(ossim_float64) + sizeof(ossim_uint32);
+   for (ossim_uint32 i=0; i<NUM_FLOAT_FIELDS; ++i)
+   {
+      if (code & FLOAT_FIELDS[i])
+         bytes += sizeof(ossim_float32);
+   }
+   for (ossim_uint32 i=0; i<NUM_BYTE_FIELDS; ++i)
+   {
+      if (code & BYTE_FIELDS[i])
+         bytes += sizeof(ossim_uint8);
+   }
+   if (code & ossimPointRecord::GpsTime)
+      bytes += sizeof(ossim_float64);
+   return bytes;
+}
+
+void ossimPointColumnBlock::allocate(ossim_uint32 n)
+{
+   const ossim_uint32 code = m_fieldCode;
+   ossim_uint32 bytes = 3 * columnBytes<ossim_float64>(n) + columnBytes<ossim_uint32>(n);
+   for (ossim_uint32 i=0; i<NUM_FLOAT_FIELDS; ++i)
+   {
+      if (code & FLOAT_FIELDS[i])
+         bytes += columnBytes<ossim_float32>(n);
+   }
+   for (ossim_uint32 i=0; i<NUM_BYTE_FIELDS; ++i)
+   {
+      if (code & BYTE_FIELDS[i])
+         bytes += columnBytes<ossim_uint8>(n);
+   }
+   if (code & ossimPointRecord::GpsTime)
+      bytes += columnBytes<ossim_float64>(n);
+
+   // Carve the new arena, copy the points over then drop the old one:
+   std::vector<ossim_float64> arena (bytes / sizeof(ossim_float64));
+   char* p = arena.empty() ? 0 : reinterpret_cast<char*>(&arena.front());
+   const ossim_uint32 numPoints = std::min(m_size, n);
+
+   ossim_float64* x = carve<ossim_float64>(p, n, true);
+   copyColumn(x, m_x, numPoints);
+   m_x = x;
+   ossim_float64* y = carve<ossim_float64>(p, n, true);
+   copyColumn(y, m_y, numPoints);
+   m_y = y;
+   ossim_float64* z = carve<ossim_float64>(p, n, true);
+   copyColumn(z, m_z, numPoints);
+   m_z = z;
+   ossim_float64* gpsTime = carve<ossim_float64>(p, n, (code & ossimPointRecord::GpsTime) != 0);
+   copyColumn(gpsTime, m_gpsTime, numPoints);
+   m_gpsTime = gpsTime;
+   ossim_uint32* ids = carve<ossim_uint32>(p, n, true);
+   copyColumn(ids, m_ids, numPoints);
+   m_ids = ids;
+
+   ossim_float32** floatColumns[NUM_FLOAT_FIELDS] =
+      { &m_intensity, &m_red, &m_green, &m_blue, &m_infrared };
+   for (ossim_uint32 i=0; i<NUM_FLOAT_FIELDS; ++i)
+   {
+      ossim_float32* column = carve<ossim_float32>(p, n, (code & FLOAT_FIELDS[i]) != 0);
+      copyColumn(column, *floatColumns[i], numPoints);
+      *floatColumns[i] = column;
+   }
+
+   ossim_uint8** byteColumns[NUM_BYTE_FIELDS] =
+      { &m_returnNumber, &m_numberOfReturns, &m_classification };
+   for (ossim_uint32 i=0; i<NUM_BYTE_FIELDS; ++i)
+   {
+      ossim_uint8* column = carve<ossim_uint8>(p, n, (code & BYTE_FIELDS[i]) != 0);
+      copyColumn(column, *byteColumns[i], numPoints);
+      *byteColumns[i] = column;
+   }
+
+   m_arena.swap(arena);
+   m_capacity = n;
+   m_size = numPoints;
+}
+
+void ossimPointColumnBlock::setFieldCode(ossim_uint32 code)
+{
+   code &= ossimPointRecord::All;
+   if (code == m_fieldCode)
+      return;
+
+   m_fieldCode = code;
+   m_size = 0;
+   allocate(m_capacity);
+}
+
+void ossimPointColumnBlock::reserve(ossim_uint32 numPoints)
+{
+   if (numPoints > m_capacity)
+      allocate(numPoints);
+}
+
+void ossimPointColumnBlock::resize(ossim_uint32 numPoints)
+{
+   if (numPoints > m_capacity)
+      allocate(std::max(numPoints, 2 * m_capacity));
+
+   const ossim_float32 null_float = ossim::nan();
+   const ossim_float64 null_double = ossim::nan();
+   for (ossim_uint32 i=m_size; i<numPoints; ++i)
+   {
+      m_x[i] = null_double;
+      m_y[i] = null_double;
+      m_z[i] = null_double;
+      m_ids[i] = 0;
+   }
+   if (m_gpsTime)
+      std::fill(m_gpsTime + m_size, m_gpsTime + std::max(m_size, numPoints), null_double);
+   for (ossim_uint32 f=0; f<NUM_FLOAT_FIELDS; ++f)
+   {
+      ossim_float32* column = getFloatField(FLOAT_FIELDS[f]);
+      if (column)
+         std::fill(column + m_size, column + std::max(m_size, numPoints), null_float);
+   }
+   for (ossim_uint32 f=0; f<NUM_BYTE_FIELDS; ++f)
+   {
+      ossim_uint8* column = getByteField(BYTE_FIELDS[f]);
+      if (column)
+         std::fill(column + m_size, column + std::max(m_size, numPoints), 0);
+   }
+   m_size = numPoints;
+}
+
+ossim_uint32 ossimPointColumnBlock::addPoint(const ossimGpt& position, ossim_uint32 pointId)
+{
+   const ossim_uint32 i = m_size;
+   resize(i + 1);
+   setPosition(i, position);
+   m_ids[i] = pointId;
+   return i;
+}
+
+ossim_uint32 ossimPointColumnBlock::addPoint(const ossimPointRecord& record)
+{
+   const ossim_uint32 i = addPoint(record.getPosition(), record.getPointId());
+   const std::map<ossimPointRecord::FIELD_CODES, ossim_float32>& fields = record.getFieldMap();
+   std::map<ossimPointRecord::FIELD_CODES, ossim_float32>::const_iterator iter = fields.begin();
+   while (iter != fields.end())
+   {
+      setField(i, iter->first, iter->second);
+      ++iter;
+   }
+   return i;
+}
+
+ossim_float32* ossimPointColumnBlock::getFloatField(ossimPointRecord::FIELD_CODES field)
+{
+   switch (field)
+   {
+   case ossimPointRecord::Intensity: return m_intensity;
+   case ossimPointRecord::Red:       return m_red;
+   case ossimPointRecord::Green:     return m_green;
+   case ossimPointRecord::Blue:      return m_blue;
+   case ossimPointRecord::Infrared:  return m_infrared;
+   default:                          return 0;
+   }
+}
+
+const ossim_float32* ossimPointColumnBlock::getFloatField(ossimPointRecord::FIELD_CODES field) const
+{
+   return const_cast<ossimPointColumnBlock*>(this)->getFloatField(field);
+}
+
+ossim_uint8* ossimPointColumnBlock::getByteField(ossimPointRecord::FIELD_CODES field)
+{
+   switch (field)
+   {
+   case ossimPointRecord::ReturnNumber:    return m_returnNumber;
+   case ossimPointRecord::NumberOfReturns: return m_numberOfReturns;
+   case ossimPointRecord::Classification:  return m_classification;
+   default:                                return 0;
+   }
+}
+
+const ossim_uint8* ossimPointColumnBlock::getByteField(ossimPointRecord::FIELD_CODES field) const
+{
+   return const_cast<ossimPointColumnBlock*>(this)->getByteField(field);
+}
+
+ossim_float32 ossimPointColumnBlock::getField(ossim_uint32 i,
+                                              ossimPointRecord::FIELD_CODES field) const
+{
+   if (i < m_size)
+   {
+      if (const ossim_float32* column = getFloatField(field))
+         return column[i];
+      if (const ossim_uint8* column = getByteField(field))
+         return column[i];
+      if ((field == ossimPointRecord::GpsTime) && m_gpsTime)
+         return (ossim_float32) m_gpsTime[i];
+   }
+   return ossim::nan();
+}
+
+void ossimPointColumnBlock::setField(ossim_uint32 i,
+                                     ossimPointRecord::FIELD_CODES field,
+                                     ossim_float32 value)
+{
+   if (i >= m_size)
+      return;
+
+   if (ossim_float32* column = getFloatField(field))
+      column[i] = value;
+   else if (ossim_uint8* column = getByteField(field))
+      column[i] = ossim::isnan(value) ? 0 : (ossim_uint8) value;
+   else if ((field == ossimPointRecord::GpsTime) && m_gpsTime)
+      m_gpsTime[i] = value;
+}
+
+void ossimPointColumnBlock::getPoint(ossim_uint32 i, ossimPointRecord& record) const
+{
+   record = ossimPointRecord(m_fieldCode);
+   if (i >= m_size)
+      return;
+
+   record.setPointId(m_ids[i]);
+   record.setPosition(getPosition(i));
+   for (ossim_uint32 f=0; f<NUM_FLOAT_FIELDS; ++f)
+   {
+      if (const ossim_float32* column = getFloatField(FLOAT_FIELDS[f]))
+         record.setField(FLOAT_FIELDS[f], column[i]);
+   }
+   for (ossim_uint32 f=0; f<NUM_BYTE_FIELDS; ++f)
+   {
+      if (const ossim_uint8* column = getByteField(BYTE_FIELDS[f]))
+         record.setField(BYTE_FIELDS[f], column[i]);
+   }
+   if (m_gpsTime)
+      record.setField(ossimPointRecord::GpsTime, (ossim_float32) m_gpsTime[i]);
+}
+
+void ossimPointColumnBlock::appendTo(ossimPointBlock& block,
+                                     ossim_uint32 offset,
+                                     ossim_uint32 count) const
+{
+   if (offset >= m_size)
+      return;
+   const ossim_uint32 end = offset + std::min(count, m_size - offset);
+   for (ossim_uint32 i=offset; i<end; ++i)
+   {
+      ossimPointRecord* record = new ossimPointRecord(m_fieldCode);
+      getPoint(i, *record);
+      block.addPoint(record);
+   }
+}
+
+void ossimPointColumnBlock::append(const ossimPointBlock& block)
+{
+   const ossim_uint32 numPoints = block.size();
+   reserve(m_size + numPoints);
+   for (ossim_uint32 i=0; i<numPoints; ++i)
+   {
+      if (block[i])
+         addPoint(*block[i]);
+   }
+}
+
+void ossimPointColumnBlock::append(const ossimPointColumnBlock& rhs,
+                                   ossim_uint32 offset,
+                                   ossim_uint32 count)
+{
+   if ((offset >= rhs.m_size) || (&rhs == this))
+      return;
+
+   const ossim_uint32 n = std::min(count, rhs.m_size - offset);
+   const ossim_uint32 start = m_size;
+   resize(start + n);
+
+   copyColumn(m_x + start, rhs.m_x + offset, n);
+   copyColumn(m_y + start, rhs.m_y + offset, n);
+   copyColumn(m_z + start, rhs.m_z + offset, n);
+   copyColumn(m_ids + start, rhs.m_ids + offset, n);
+   if (m_gpsTime && rhs.m_gpsTime)
+      copyColumn(m_gpsTime + start, rhs.m_gpsTime + offset, n);
+   for (ossim_uint32 f=0; f<NUM_FLOAT_FIELDS; ++f)
+   {
+      ossim_float32* dest = getFloatField(FLOAT_FIELDS[f]);
+      const ossim_float32* src = rhs.getFloatField(FLOAT_FIELDS[f]);
+      if (dest && src)
+         copyColumn(dest + start, src + offset, n);
+   }
+   for (ossim_uint32 f=0; f<NUM_BYTE_FIELDS; ++f)
+   {
+      ossim_uint8* dest = getByteField(BYTE_FIELDS[f]);
+      const ossim_uint8* src = rhs.getByteField(BYTE_FIELDS[f]);
+      if (dest && src)
+         copyColumn(dest + start, src + offset, n);
+   }
+}
+
+void ossimPointColumnBlock::append(const ossimPointColumnBlock& rhs,
+                                   const std::vector<ossim_uint32>& selection)
+{
+   const ossim_uint32 numSelected = (ossim_uint32) selection.size();
+   if ((numSelected == 0) || (&rhs == this))
+      return;
+
+   reserve(m_size + numSelected);
+   ossim_uint32 runStart = selection[0];
+   ossim_uint32 runLength = 1;
+   for (ossim_uint32 k=1; k<numSelected; ++k)
+   {
+      if (selection[k] == runStart + runLength)
+      {
+         ++runLength;
+         continue;
+      }
+      append(rhs, runStart, runLength);
+      runStart = selection[k];
+      runLength = 1;
+   }
+   append(rhs, runStart, runLength);
+}
+
+void ossimPointColumnBlock::getBounds(ossimGrect& bounds) const
+{
+   if (m_size == 0)
+   {
+      bounds.makeNan();
+      return;
+   }
+
+   ossimGpt minPos (m_y[0], m_x[0], m_z[0]);
+   ossimGpt maxPos (minPos);
+   for (ossim_uint32 i=1; i<m_size; ++i)
+   {
+      minPos.lon = std::min(minPos.lon, m_x[i]);
+      maxPos.lon = std::max(maxPos.lon, m_x[i]);
+      minPos.lat = std::min(minPos.lat, m_y[i]);
+      maxPos.lat = std::max(maxPos.lat, m_y[i]);
+      minPos.hgt = std::min(minPos.hgt, m_z[i]);
+      maxPos.hgt = std::max(maxPos.hgt, m_z[i]);
+   }
+   bounds = ossimGrect(minPos, maxPos);
+}
@@ -0,0 +1,118 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+
+#include <ossim/point_cloud/ossimPointFilter.h>
+
+void ossimPointFilter::selectAll(const ossimPointColumnBlock& block, Selection& selection)
+{
+   const ossim_uint32 numPoints = block.size();
+   selection.resize(numPoints);
+   for (ossim_uint32 i=0; i<numPoints; ++i)
+      selection[i] = i;
+}
+
+ossimPointClassFilter::ossimPointClassFilter()
+{
+   for (ossim_uint32 c=0; c<256; ++c)
+      m_keep[c] = false;
+}
+
+void ossimPointClassFilter::filter(const ossimPointColumnBlock& block, Selection& selection) const
+{
+   const ossim_uint8* classification = block.getByteField(ossimPointRecord::Classification);
+   if (!classification)
+      return;
+
+   ossim_uint32 numKept = 0;
+   for (ossim_uint32 k=0; k<selection.size(); ++k)
+   {
+      if (m_keep[classification[selection[k]]])
+         selection[numKept++] = selection[k];
+   }
+   selection.resize(numKept);
+}
+
+ossimPointReturnFilter::ossimPointReturnFilter()
+:  m_keepLast(false)
+{
+   for (ossim_uint32 n=0; n<8; ++n)
+      m_keep[n] = false;
+}
+
+ossim_uint32 ossimPointReturnFilter::getFieldCode() const
+{
+   ossim_uint32 code = ossimPointRecord::ReturnNumber;
+   if (m_keepLast)
+      code |= ossimPointRecord::NumberOfReturns;
+   return code;
+}
+
+void ossimPointReturnFilter::filter(const ossimPointColumnBlock& block, Selection& selection) const
+{
+   const ossim_uint8* returnNumber = block.getByteField(ossimPointRecord::ReturnNumber);
+   if (!returnNumber)
+      return;
+   const ossim_uint8* numReturns =
+      m_keepLast ? block.getByteField(ossimPointRecord::NumberOfReturns) : 0;
+
+   ossim_uint32 numKept = 0;
+   for (ossim_uint32 k=0; k<selection.size(); ++k)
+   {
+      const ossim_uint32 i = selection[k];
+      if (m_keep[returnNumber[i] & 0x07] || (numReturns && (returnNumber[i] == numReturns[i])))
+         selection[numKept++] = i;
+   }
+   selection.resize(numKept);
+}
+
+void ossimPointBoundsFilter::filter(const ossimPointColumnBlock& block, Selection& selection) const
+{
+   const ossim_float64* x = block.getX();
+   const ossim_float64* y = block.getY();
+   const double minX = m_bounds.ul().lon;
+   const double maxX = m_bounds.lr().lon;
+   const double minY = m_bounds.lr().lat;
+   const double maxY = m_bounds.ul().lat;
+
+   ossim_uint32 numKept = 0;
+   for (ossim_uint32 k=0; k<selection.size(); ++k)
+   {
+      const ossim_uint32 i = selection[k];
+      if ((x[i] >= minX) && (x[i] <= maxX) && (y[i] >= minY) && (y[i] <= maxY))
+         selection[numKept++] = i;
+   }
+   selection.resize(numKept);
+}
+
+void ossimPointZRangeFilter::filter(const ossimPointColumnBlock& block, Selection& selection) const
+{
+   // NaN heights fail both comparisons:
+   const ossim_float64* z = block.getZ();
+   ossim_uint32 numKept = 0;
+   for (ossim_uint32 k=0; k<selection.size(); ++k)
+   {
+      const ossim_uint32 i = selection[k];
+      if ((z[i] >= m_minZ) && (z[i] <= m_maxZ))
+         selection[numKept++] = i;
+   }
+   selection.resize(numKept);
+}
+
+ossim_uint32 ossimPointFilterChain::getFieldCode() const
+{
+   ossim_uint32 code = 0;
+   for (ossim_uint32 f=0; f<m_filters.size(); ++f)
+      code |= m_filters[f]->getFieldCode();
+   return code;
+}
+
+void ossimPointFilterChain::filter(const ossimPointColumnBlock& block, Selection& selection) const
+{
+   for (ossim_uint32 f=0; (f<m_filters.size()) && !selection.empty(); ++f)
+      m_filters[f]->filter(block, selection);
+}
@@ -0,0 +1,366 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#include <ossim/point_cloud/ossimPointKdTree.h>
+#include <ossim/point_cloud/ossimPointColumnBlock.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <OpenThreads/Block>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <algorithm>
+
+const ossim_uint32 ossimPointKdTree::DEFAULT_LEAF_SIZE = 16;
+
+// Deeper than any tree of 2^32 points split at the median.
+static const ossim_uint32 MAX_DEPTH = 64;
+
+namespace
+{
+   // Orders point indices by one coordinate column.
+   class AxisLess
+   {
+   public:
+      AxisLess(const ossim_float64* column) : m_column(column) {}
+      bool operator()(ossim_uint32 a, ossim_uint32 b) const { return m_column[a] < m_column[b]; }
+   private:
+      const ossim_float64* m_column;
+   };
+
+   //---
+   // Hands out blocks of query points to the jobs and releases the caller
+   // once the last job is done.
+   //---
+   class ossimPointKdTreeBatch : public ossimReferenced
+   {
+   public:
+      ossimPointKdTreeBatch(ossim_uint32 items, ossim_uint32 jobs)
+         : m_next(0),
+           m_items(items),
+           m_jobs(jobs)
+      {
+         if(m_jobs)
+         {
+            m_block.reset();
+         }
+         else
+         {
+            m_block.release();
+         }
+      }
+      bool next(ossim_uint32& first, ossim_uint32& last)
+      {
+         const ossim_uint32 BLOCK = 1024;
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if ( m_next >= m_items )
+         {
+            return false;
+         }
+         first  = m_next;
+         m_next = ossim::min( m_next + BLOCK, m_items );
+         last   = m_next;
+         return true;
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_jobs && (--m_jobs == 0))
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+   private:
+      OpenThreads::Mutex m_mutex;
+      OpenThreads::Block m_block;
+      ossim_uint32       m_next;
+      ossim_uint32       m_items;
+      ossim_uint32       m_jobs;
+   };
+
+   //---
+   // Searches blocks of query points until the batch runs out. Item i of the
+   // batch is query point (*selection)[i], or i without a selection.
+   //---
+   class ossimPointKdTreeJob : public ossimJob
+   {
+   public:
+      ossimPointKdTreeJob(const ossimPointKdTree* tree,
+                          const ossimPointColumnBlock& queries,
+                          const std::vector<ossim_uint32>* selection,
+                          double maxDist2,
+                          std::vector<ossim_uint32>& indices,
+                          std::vector<ossim_float64>& dist2,
+                          ossimPointKdTreeBatch* batch)
+         : m_tree(tree),
+           m_queries(queries),
+           m_selection(selection),
+           m_maxDist2(maxDist2),
+           m_indices(indices),
+           m_dist2(dist2),
+           m_batch(batch)
+      {
+         setName("ossimPointKdTree.query");
+      }
+      virtual void start()
+      {
+         const ossim_float64* x = m_queries.getX();
+         const ossim_float64* y = m_queries.getY();
+         const ossim_float64* z = m_queries.getZ();
+         ossim_uint32 first;
+         ossim_uint32 last;
+         while ( m_batch->next(first, last) )
+         {
+            for ( ossim_uint32 i = first; i < last; ++i )
+            {
+               const ossim_uint32 Q = m_selection ? (*m_selection)[i] : i;
+               ossim_uint32 index;
+               double d2;
+               if ( m_tree->findNearest(x[Q], y[Q], z[Q], index, d2, m_maxDist2) )
+               {
+                  m_indices[Q] = index;
+                  m_dist2[Q]   = d2;
+               }
+            }
+         }
+         m_batch->done();
+      }
+   private:
+      const ossimPointKdTree*             m_tree;
+      const ossimPointColumnBlock&        m_queries;
+      const std::vector<ossim_uint32>*    m_selection;
+      double                              m_maxDist2;
+      std::vector<ossim_uint32>&          m_indices;
+      std::vector<ossim_float64>&         m_dist2;
+      ossimRefPtr<ossimPointKdTreeBatch>  m_batch;
+   };
+}
+
+ossimPointKdTree::ossimPointKdTree()
+:  m_leafSize(DEFAULT_LEAF_SIZE)
+{
+}
+
+ossimPointKdTree::~ossimPointKdTree()
+{
+}
+
+void ossimPointKdTree::build(const ossimPointColumnBlock& points, ossim_uint32 leafSize)
+{
+   build(points.getX(), points.getY(), points.getZ(), points.size(), leafSize);
+}
+
+void ossimPointKdTree::build(const ossim_float64* x, const ossim_float64* y,
+                             const ossim_float64* z, ossim_uint32 n, ossim_uint32 leafSize)
+{
+   m_leafSize = std::max<ossim_uint32>(leafSize, 1);
+   m_nodes.clear();
+   m_x.clear();
+   m_y.clear();
+   m_z.clear();
+   m_ids.clear();
+
+   std::vector<ossim_uint32> order;
+   order.reserve(n);
+   for (ossim_uint32 i = 0; i < n; ++i)
+   {
+      if (!ossim::isnan(x[i]) && !ossim::isnan(y[i]) && !ossim::isnan(z[i]))
+         order.push_back(i);
+   }
+   if (order.empty())
+      return;
+
+   const ossim_float64* const xyz[3] = { x, y, z };
+   m_nodes.reserve(2 * (order.size() / m_leafSize) + 1);
+   buildNode(order, 0, (ossim_uint32)order.size(), xyz);
+
+   // Copy the coordinates in leaf order so a leaf scan reads contiguous memory:
+   const ossim_uint32 N = (ossim_uint32)order.size();
+   m_x.resize(N);
+   m_y.resize(N);
+   m_z.resize(N);
+   m_ids.swap(order);
+   for (ossim_uint32 i = 0; i < N; ++i)
+   {
+      m_x[i] = x[m_ids[i]];
+      m_y[i] = y[m_ids[i]];
+      m_z[i] = z[m_ids[i]];
+   }
+}
+
+ossim_uint32 ossimPointKdTree::buildNode(std::vector<ossim_uint32>& order,
+                                         ossim_uint32 begin, ossim_uint32 end,
+                                         const ossim_float64* const xyz[3])
+{
+   const ossim_uint32 NODE = (ossim_uint32)m_nodes.size();
+   Node node;
+   node.m_split = 0.0;
+   node.m_begin = begin;
+   node.m_end   = end;
+   node.m_left  = 0;
+   node.m_right = 0;
+   node.m_axis  = 3;
+   m_nodes.push_back(node);
+
+   if (end - begin <= m_leafSize)
+      return NODE;
+
+   // Split across the widest extent:
+   double width = -1.0;
+   for (ossim_uint32 a = 0; a < 3; ++a)
+   {
+      double lo = xyz[a][order[begin]];
+      double hi = lo;
+      for (ossim_uint32 i = begin + 1; i < end; ++i)
+      {
+         const double V = xyz[a][order[i]];
+         if (V < lo)
+            lo = V;
+         else if (V > hi)
+            hi = V;
+      }
+      if (hi - lo > width)
+      {
+         width = hi - lo;
+         node.m_axis = a;
+      }
+   }
+   if (width <= 0.0)
+      return NODE; // All points coincide.
+
+   const ossim_uint32 MID = begin + (end - begin) / 2;
+   std::nth_element(order.begin() + begin, order.begin() + MID, order.begin() + end,
+                    AxisLess(xyz[node.m_axis]));
+   node.m_split = xyz[node.m_axis][order[MID]];
+
+   // Children are added after this node; m_nodes may reallocate meanwhile.
+   node.m_left  = buildNode(order, begin, MID, xyz);
+   node.m_right = buildNode(order, MID, end, xyz);
+   m_nodes[NODE] = node;
+   return NODE;
+}
+
+bool ossimPointKdTree::findNearest(double x, double y, double z, ossim_uint32& index,
+                                   double& dist2, double maxDist2) const
+{
+   if (m_nodes.empty() || ossim::isnan(x) || ossim::isnan(y) || ossim::isnan(z))
+      return false;
+
+   const double Q[3] = { x, y, z };
+   double best = maxDist2;
+   ossim_uint32 bestIdx = NO_MATCH;
+
+   // Nodes still to visit with the squared distance to their splitting plane:
+   ossim_uint32 stackNode[MAX_DEPTH];
+   double       stackDist2[MAX_DEPTH];
+   ossim_uint32 top = 0;
+   stackNode[top] = 0;
+   stackDist2[top++] = 0.0;
+
+   while (top)
+   {
+      --top;
+      if (stackDist2[top] >= best)
+         continue;
+
+      const Node* node = &m_nodes[stackNode[top]];
+      while (node->m_axis != 3)
+      {
+         const double DIFF = Q[node->m_axis] - node->m_split;
+         ossim_uint32 nearChild = node->m_left;
+         ossim_uint32 farChild  = node->m_right;
+         if (DIFF >= 0.0)
+         {
+            nearChild = node->m_right;
+            farChild  = node->m_left;
+         }
+         if (DIFF*DIFF < best)
+         {
+            stackNode[top] = farChild;
+            stackDist2[top++] = DIFF*DIFF;
+         }
+         node = &m_nodes[nearChild];
+      }
+
+      for (ossim_uint32 i = node->m_begin; i < node->m_end; ++i)
+      {
+         const double DX = m_x[i] - x;
+         const double DY = m_y[i] - y;
+         const double DZ = m_z[i] - z;
+         const double D2 = DX*DX + DY*DY + DZ*DZ;
+         if (D2 < best)
+         {
+            best = D2;
+            bestIdx = i;
+         }
+      }
+   }
+
+   if (bestIdx == NO_MATCH)
+      return false;
+
+   index = m_ids[bestIdx];
+   dist2 = best;
+   return true;
+}
+
+void ossimPointKdTree::findNearest(const ossimPointColumnBlock& queries,
+                                   std::vector<ossim_uint32>& indices,
+                                   std::vector<ossim_float64>& dist2,
+                                   double maxDistance,
+                                   const std::vector<ossim_uint32>* selection,
+                                   ossim_uint32 numThreads) const
+{
+   indices.assign(queries.size(), NO_MATCH);
+   dist2.assign(queries.size(), ossim::nan());
+
+   const ossim_uint32 ITEMS = selection ? (ossim_uint32)selection->size() : queries.size();
+   if (!ITEMS || m_nodes.empty())
+      return;
+
+   const double MAX_DIST2 = (maxDistance < OSSIM_DEFAULT_MAX_PIX_DOUBLE) ?
+                            maxDistance*maxDistance : OSSIM_DEFAULT_MAX_PIX_DOUBLE;
+   if (!numThreads)
+      numThreads = ossim::getNumberOfThreads();
+   const ossim_uint32 JOBS = ossim::max<ossim_uint32>(
+      1, ossim::min<ossim_uint32>( numThreads, ITEMS / 1024 ) );
+
+   ossimRefPtr<ossimPointKdTreeBatch> batch = new ossimPointKdTreeBatch(ITEMS, JOBS);
+   std::vector< ossimRefPtr<ossimPointKdTreeJob> > jobs;
+   for ( ossim_uint32 i = 0; i < JOBS; ++i )
+   {
+      jobs.push_back( new ossimPointKdTreeJob( this, queries, selection, MAX_DIST2,
+                                               indices, dist2, batch.get() ) );
+   }
+   if ( JOBS == 1 )
+   {
+      jobs[0]->start();
+   }
+   else
+   {
+      ossimRefPtr<ossimJobMultiThreadQueue> queue = new ossimJobMultiThreadQueue(0, JOBS);
+      for ( ossim_uint32 i = 0; i < JOBS; ++i )
+      {
+         queue->getJobQueue()->add(jobs[i].get(), false);
+      }
+      batch->wait();
+   }
+}
+
+void ossimPointKdTree::getSubsample(ossim_uint32 numPoints, ossim_uint32 stride,
+                                    std::vector<ossim_uint32>& selection)
+{
+   stride = std::max<ossim_uint32>(stride, 1);
+   selection.clear();
+   selection.reserve(numPoints / stride + 1);
+   for (ossim_uint32 i = 0; i < numPoints; i += stride)
+      selection.push_back(i);
+}
@@ -28,6 +28,8 @@ ossimPointRecord::ossimPointRecord(ossim_uint32 field_code)
       m_fieldMap[GpsTime] = ossim::nan();
    if (field_code & Infrared)
       m_fieldMap[Infrared] = ossim::nan();
+   if (field_code & Classification)
+      m_fieldMap[Classification] = ossim::nan();
 }
 
 ossimPointRecord::ossimPointRecord(const ossimPointRecord& pcr)
@@ -67,6 +69,8 @@ inline bool ossimPointRecord::hasFields(ossim_uint32 field_code) const
          found = m_fieldMap.find(GpsTime) != m_fieldMap.end();
    if (found && (field_code & Infrared))
          found = m_fieldMap.find(Infrared) != m_fieldMap.end();
+   if (found && (field_code & Classification))
+         found = m_fieldMap.find(Classification) != m_fieldMap.end();
 
    return found;
 }
@@ -91,6 +95,8 @@ inline ossim_uint32 ossimPointRecord::getFieldCode() const
       field_code |= GpsTime;
    if (m_fieldMap.find(Infrared) != m_fieldMap.end())
       field_code |= Infrared;
+   if (m_fieldMap.find(Classification) != m_fieldMap.end())
+      field_code |= Classification;
 
    return field_code;
 }
@@ -155,6 +161,9 @@ std::ostream& operator << (std::ostream& out, const ossimPointRecord& p)
       case ossimPointRecord::Infrared:
          out << "\n   Infrared: ";
          break;
+      case ossimPointRecord::Classification:
+         out << "\n   Classification: ";
+         break;
       default:
          out << "\n   Unidentified: ";
       }
@@ -26,11 +26,21 @@ RTTI_DEF1(ossimCoarseGridModel, "ossimCoarseGridModel", ossimSensorModel);
 #include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimDatumFactory.h>
 #include <ossim/base/ossimNotifyContext.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/elevation/ossimElevManager.h>
 #include <ossim/imaging/ossimImageGeometry.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
 #include <ossim/support_data/ossimSupportFilesList.h>
+#include <OpenThreads/Atomic>
+#include <OpenThreads/Block>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <algorithm>
 #include <cstdio>
 #include <fstream>
+#include <vector>
 
 //***
 // Define Trace flags for use within this file:
@@ -46,6 +56,287 @@ const ossimFilename DEFAULT_GEOM_FILE_EXT ("geom");
 const ossimFilename DEFAULT_GRID_FILE_EXT ("ocg");
 double ossimCoarseGridModel::theInterpolationError = .1;
 ossim_int32 ossimCoarseGridModel::theMinGridSpacing     = 100;
+ossim_uint32 ossimCoarseGridModel::theBuildThreads      = 0;
+
+namespace
+{
+   //---
+   // Node values of grid rows [y0, y1) of a gridSize grid over the image, as the serial build
+   // computed them. Outputs are indexed y*gridSize.x + x.
+   //---
+   void sampleGridNodes(ossimImageGeometry* geom,
+                        const ossimIpt& imageOrigin,
+                        const ossimIpt& imageSize,
+                        const ossimIpt& gridSize,
+                        ossim_int32 y0,
+                        ossim_int32 y1,
+                        double heightDelta,
+                        double* lat,
+                        double* lon,
+                        double* dlatDh,
+                        double* dlonDh)
+   {
+      const ossimDatum* targetDatum = ossimDatumFactory::instance()->wgs84();
+      ossimGpt gpt;
+      ossimGpt gpt2;
+      for(ossim_int32 y = y0; y < y1; ++y)
+      {
+         for(ossim_int32 x = 0; x < gridSize.x; ++x)
+         {
+            ossimDpt norm((double)x/(double)(gridSize.x-1),
+               (double)y/(double)(gridSize.y-1));
+
+            ossimDpt pt(imageOrigin.x + norm.x*(imageSize.x-1),
+               imageOrigin.y + norm.y*(imageSize.y-1));
+
+            geom->localToWorld(pt, gpt);
+            double h = gpt.height();
+            if(ossim::isnan(h))
+            {
+               h += heightDelta;
+            }
+            ossimDpt fullPt;
+            geom->rnToFull(pt, 0, fullPt);
+            geom->getProjection()->lineSampleHeightToWorld(fullPt, h, gpt2);
+            gpt.changeDatum(targetDatum);
+            gpt2.changeDatum(targetDatum);
+
+            const ossim_int32 idx = y*gridSize.x + x;
+            lat[idx]    = gpt.latd();
+            lon[idx]    = gpt.lond();
+            dlatDh[idx] = (gpt2.latd() - gpt.latd())/heightDelta;
+            dlonDh[idx] = (gpt2.lond() - gpt.lond())/heightDelta;
+         }
+      }
+   }
+
+   //---
+   // Round trip error of rows [y0, y1) of the upperX by upperY check grid. Stops at the first
+   // point at or over maxError, or once another band has set stopFlag, and returns the largest
+   // error seen.
+   //---
+   double checkGridError(ossimImageGeometry* geom,
+                         const ossimProjection* model,
+                         const ossimIpt& imageOrigin,
+                         const ossimIpt& imageSize,
+                         ossim_int32 upperX,
+                         ossim_int32 upperY,
+                         ossim_int32 y0,
+                         ossim_int32 y1,
+                         double maxError,
+                         OpenThreads::Atomic* stopFlag)
+   {
+      ossimGpt gpt;
+      double result = 0.0;
+      for(ossim_int32 y = y0; y < y1; ++y)
+      {
+         if(stopFlag && ((unsigned)(*stopFlag) != 0))
+         {
+            break;
+         }
+         for(ossim_int32 x = 0; x < upperX; ++x)
+         {
+            ossimDpt norm((double)x/(double)(upperX-1),
+               (double)y/(double)(upperY-1));
+
+            ossimDpt imagePoint(imageOrigin.x + norm.x*(imageSize.x-1),
+               imageOrigin.y + norm.y*(imageSize.y-1));
+            ossimDpt testIpt;
+
+            geom->localToWorld(imagePoint, gpt);
+            model->worldToLineSample(gpt, testIpt);
+            double error = (testIpt-imagePoint).length();
+            if(error > result)
+            {
+               result = error;
+            }
+            if(!(error < maxError))
+            {
+               if(stopFlag)
+               {
+                  stopFlag->exchange(1);
+               }
+               return result;
+            }
+         }
+      }
+      return result;
+   }
+
+   //---
+   // Countdown shared by the jobs of one build pass; releases buildGrid when the last band is
+   // done.
+   //---
+   class ossimCoarseGridBuildBatch : public ossimReferenced
+   {
+   public:
+      ossimCoarseGridBuildBatch(ossim_uint32 count)
+         : m_count(count)
+      {
+         if(m_count)
+         {
+            m_block.reset();
+         }
+         else
+         {
+            m_block.release();
+         }
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_count && (--m_count == 0))
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+   private:
+      OpenThreads::Mutex m_mutex;
+      OpenThreads::Block m_block;
+      ossim_uint32       m_count;
+   };
+
+   //---
+   // One grid row of a build pass: the node sampling (checkModel null) or the error check.
+   // Each row runs on a fresh copy of the prototype geometry, as rigorous models are not
+   // thread safe and carry per point state (e.g. DEM intersection start heights) that would
+   // otherwise make the nodes depend on which rows a copy saw before.
+   //---
+   class ossimCoarseGridBuildJob : public ossimJob
+   {
+   public:
+      ossimCoarseGridBuildJob(const ossimImageGeometry* prototype,
+                              ossimCoarseGridBuildBatch* batch,
+                              const ossimIpt& imageOrigin,
+                              const ossimIpt& imageSize,
+                              const ossimIpt& gridSize,
+                              ossim_int32 row)
+         : m_prototype(prototype),
+           m_batch(batch),
+           m_imageOrigin(imageOrigin),
+           m_imageSize(imageSize),
+           m_gridSize(gridSize),
+           m_row(row),
+           m_heightDelta(0.0),
+           m_nodes(0),
+           m_checkModel(0),
+           m_maxError(0.0),
+           m_stopFlag(0),
+           m_error(0.0)
+      {
+         setName("ossimCoarseGridModel.buildGrid");
+      }
+      void setNodeOutput(double heightDelta, double** nodes)
+      {
+         m_heightDelta = heightDelta;
+         m_nodes       = nodes;
+      }
+      void setErrorCheck(const ossimProjection* model, double maxError,
+                         OpenThreads::Atomic* stopFlag)
+      {
+         m_checkModel = model;
+         m_maxError   = maxError;
+         m_stopFlag   = stopFlag;
+      }
+      double getError() const { return m_error; }
+      virtual void start()
+      {
+         if(!m_stopFlag || ((unsigned)(*m_stopFlag) == 0))
+         {
+            ossimRefPtr<ossimImageGeometry> geom = new ossimImageGeometry(*m_prototype);
+            if(m_checkModel)
+            {
+               m_error = checkGridError(geom.get(), m_checkModel, m_imageOrigin, m_imageSize,
+                                        m_gridSize.x, m_gridSize.y, m_row, m_row+1,
+                                        m_maxError, m_stopFlag);
+            }
+            else if(m_nodes)
+            {
+               sampleGridNodes(geom.get(), m_imageOrigin, m_imageSize, m_gridSize,
+                               m_row, m_row+1, m_heightDelta,
+                               m_nodes[0], m_nodes[1], m_nodes[2], m_nodes[3]);
+            }
+         }
+         if(m_batch.valid())
+         {
+            m_batch->done();
+         }
+      }
+   private:
+      const ossimImageGeometry*              m_prototype;
+      ossimRefPtr<ossimCoarseGridBuildBatch> m_batch;
+      ossimIpt                               m_imageOrigin;
+      ossimIpt                               m_imageSize;
+      ossimIpt                               m_gridSize;
+      ossim_int32                            m_row;
+      double                                 m_heightDelta;
+      double**                               m_nodes;
+      const ossimProjection*                 m_checkModel;
+      double                                 m_maxError;
+      OpenThreads::Atomic*                   m_stopFlag;
+      double                                 m_error;
+   };
+
+   //---
+   // Runs one pass, a job per row of gridSize, on the queue or, without one, in the caller.
+   // Returns the largest row error (0 for the node pass). The nodes, and whether the error
+   // bound is met, do not depend on the number of threads.
+   //---
+   double runBuildPass(ossimJobMultiThreadQueue* queue,
+                       const ossimImageGeometry* prototype,
+                       const ossimIpt& imageOrigin,
+                       const ossimIpt& imageSize,
+                       const ossimIpt& gridSize,
+                       double heightDelta,
+                       double** nodes,
+                       const ossimProjection* checkModel,
+                       double maxError)
+   {
+      const ossim_int32 ROWS = gridSize.y;
+      ossimRefPtr<ossimCoarseGridBuildBatch> batch =
+         queue ? new ossimCoarseGridBuildBatch(ROWS) : 0;
+      OpenThreads::Atomic stopFlag(0);
+      std::vector< ossimRefPtr<ossimCoarseGridBuildJob> > jobs;
+      for(ossim_int32 row = 0; row < ROWS; ++row)
+      {
+         ossimRefPtr<ossimCoarseGridBuildJob> job =
+            new ossimCoarseGridBuildJob(prototype, batch.get(),
+                                        imageOrigin, imageSize, gridSize, row);
+         if(checkModel)
+         {
+            job->setErrorCheck(checkModel, maxError, &stopFlag);
+         }
+         else
+         {
+            job->setNodeOutput(heightDelta, nodes);
+         }
+         jobs.push_back(job);
+         if(queue)
+         {
+            queue->getJobQueue()->add(job.get(), false);
+         }
+         else
+         {
+            job->start();
+         }
+      }
+      if(batch.valid())
+      {
+         batch->wait();
+      }
+
+      double error = 0.0;
+      for(ossim_uint32 i = 0; i < jobs.size(); ++i)
+      {
+         error = std::max(error, jobs[i]->getError());
+      }
+      return error;
+   }
+}
 
 //*****************************************************************************
 //  DEFAULT CONSTRUCTOR: ossimCoarseGridModel()
@@ -235,6 +526,14 @@ void ossimCoarseGridModel::buildGrid(const ossimDrect& imageBounds,
 
    geom->localToWorld(imageBounds.midPoint(), gpt);
 
+   //---
+   // The node and error passes run a job per grid row, each on its own copy of the geometry,
+   // on a queue of getBuildThreads() threads (in this thread if one).
+   //---
+   const ossim_uint32 THREADS = getBuildThreads();
+   ossimRefPtr<ossimJobMultiThreadQueue> queue =
+      (THREADS > 1) ? new ossimJobMultiThreadQueue(0, THREADS) : 0;
+
    do
    {
       if(traceDebug())
@@ -257,58 +556,33 @@ void ossimCoarseGridModel::buildGrid(const ossimDrect& imageBounds,
       theDlonDhGrid.initialize(gridSize, gridOrigin, spacing);
       ossim_int32 x, y;
 
+      const ossim_int32 NODES = gridSize.x*gridSize.y;
+      std::vector<double> lat(NODES);
+      std::vector<double> lon(NODES);
+      std::vector<double> dlatDh(NODES);
+      std::vector<double> dlonDh(NODES);
+      double* nodes[4] = { &lat.front(), &lon.front(), &dlatDh.front(), &dlonDh.front() };
+      runBuildPass(queue.get(), geom, imageOrigin, imageSize, gridSize, heightDelta,
+                   nodes, 0, 0.0);
       for(y = 0; y < gridSize.y; ++y)
       {
          for(x = 0; x < gridSize.x; ++x)
          {
-            ossimDpt norm((double)x/(double)(gridSize.x-1),
-               (double)y/(double)(gridSize.y-1));
-
-            ossimDpt pt(imageOrigin.x + norm.x*(imageSize.x-1),
-               imageOrigin.y + norm.y*(imageSize.y-1));
-
-            geom->localToWorld(pt, gpt);
-            double h = gpt.height();
-            if(ossim::isnan(h))
-            {
-               h += heightDelta;
-            }
-            ossimDpt fullPt;
-            geom->rnToFull(pt, 0, fullPt);
-            geom->getProjection()->lineSampleHeightToWorld(fullPt, h, gpt2);
-            gpt.changeDatum(targetDatum);
-            gpt2.changeDatum(targetDatum);
-
-            theLatGrid.setNode(x, y, gpt.latd());
-            theLonGrid.setNode(x, y, gpt.lond());
-
-            theDlatDhGrid.setNode(x, y, (gpt2.latd() - gpt.latd())/heightDelta);
-            theDlonDhGrid.setNode(x, y, (gpt2.lond() - gpt.lond())/heightDelta);
+            const ossim_int32 idx = y*gridSize.x + x;
+            theLatGrid.setNode(x, y, lat[idx]);
+            theLonGrid.setNode(x, y, lon[idx]);
+            theDlatDhGrid.setNode(x, y, dlatDh[idx]);
+            theDlonDhGrid.setNode(x, y, dlonDh[idx]);
          }
       }
       ossim_int32 upperY = 2*gridSize.y;
       ossim_int32 upperX = 2*gridSize.x;
-      error = 0.0;
 
       // Set all base-class data members needed for subsequent calls to projection code:
       initializeModelParams(imageBounds);
 
-      for(y = 0; ((y < upperY)&&(error < theInterpolationError)); ++y)
-      {
-         for(x = 0; ((x < upperX)&&(error<theInterpolationError)); ++x)
-         {
-            ossimDpt norm((double)x/(double)(upperX-1),
-               (double)y/(double)(upperY-1));
-
-            ossimDpt imagePoint(imageOrigin.x + norm.x*(imageSize.x-1),
-               imageOrigin.y + norm.y*(imageSize.y-1));
-            ossimDpt testIpt;
-
-            geom->localToWorld(imagePoint, gpt);
-            worldToLineSample(gpt, testIpt);
-            error = (testIpt-imagePoint).length();
-         }
-      }
+      error = runBuildPass(queue.get(), geom, imageOrigin, imageSize, ossimIpt(upperX, upperY),
+                           heightDelta, 0, this, theInterpolationError);
 
       gridSize.x *= 2;
       gridSize.y *= 2;
@@ -398,11 +672,39 @@ void ossimCoarseGridModel::setInterpolationError(double error)
    theInterpolationError = error;
 }
 
+double ossimCoarseGridModel::getInterpolationError()
+{
+   return theInterpolationError;
+}
+
 void ossimCoarseGridModel::setMinGridSpacing(ossim_int32 minSpacing)
 {
    theMinGridSpacing = minSpacing;
 }
 
+void ossimCoarseGridModel::setBuildThreads(ossim_uint32 threads)
+{
+   theBuildThreads = threads;
+}
+
+ossim_uint32 ossimCoarseGridModel::getBuildThreads()
+{
+   ossim_uint32 result = theBuildThreads;
+   if(!result)
+   {
+      const char* lookup = ossimPreferences::instance()->findPreference("coarse_grid.build_threads");
+      if(lookup)
+      {
+         result = ossimString(lookup).toUInt32();
+      }
+   }
+   if(!result)
+   {
+      result = static_cast<ossim_uint32>( OpenThreads::GetNumberOfProcessors() );
+   }
+   return result ? result : 1;
+}
+
 //*************************************************************************************************
 //! Initializes base class data members after grids have been assigned.
 //! It is assumed that theImageSize and the origin image point were already set.
@@ -13,6 +13,7 @@
 #include <ossim/projection/ossimStatePlaneProjectionInfo.h>
 #include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimDate.h>
 #include <ossim/projection/ossimUtmProjection.h>
 #include <ossim/projection/ossimEquDistCylProjection.h>
 #include <ossim/projection/ossimTransMercatorProjection.h>
@@ -30,6 +31,7 @@
 #include <ossim/projection/ossimMapProjectionFactory.h>
 #include <ossim/base/ossimException.h>
 #include <cmath>
+#include <cstring>
 
 //ossimEpsgProjectionDatabase* ossimEpsgProjectionDatabase::m_instance = 0;
 
@@ -111,6 +113,23 @@ enum
 };
 static const ossimString SPCS_EPSG_MAP_FORMAT_C ("SPCS_EPSG_MAP");
 
+// Binary index of a Db file (see ossimEpsgProjectionDatabase::loadCsvFile):
+static const char DB_INDEX_MAGIC[] = "OSSIMEPSGIDX1";
+static const size_t DB_INDEX_MAGIC_SIZE = sizeof(DB_INDEX_MAGIC);
+
+// Modification time and size, to tell if an index is older than its Db file.
+static bool getDbFileStamp(const ossimFilename& file, ossim_int64& modTime, ossim_int64& size)
+{
+   ossimLocalTm t;
+   if ( !file.getTimes(0, &t, 0) )
+   {
+      return false;
+   }
+   modTime = (ossim_int64)(time_t)t;
+   size    = file.fileSize();
+   return true;
+}
+
 //*************************************************************************************************
 //! Converts sexagesimal DMS to decimal degrees
 //*************************************************************************************************
@@ -205,9 +224,6 @@ void ossimEpsgProjectionDatabase::initialize() const
 
    // Create only once outside the loop:
    ossimFilename db_name;
-   ossimString group_id;
-   ossimString format_id;
-   ossimString line;
 
    // Loop over each file and read contents into memory:
    while ( i != keys.end() )
@@ -231,72 +247,235 @@ void ossimEpsgProjectionDatabase::initialize() const
       if (!db_name.isReadable())
          continue;
 
-      // Open the DB file:
-      std::ifstream db_stream (db_name.chars());
-      bool good_file = false;
-      if (db_stream.good())
-      {
-         // Format specification implied in file's magic number:
-         std::getline(db_stream, format_id.string());
-         format_id.trim();
-         if ((format_id == EPSG_DB_FORMAT_A) || 
-             (format_id == STATE_PLANE_FORMAT_B) ||
-             (format_id == SPCS_EPSG_MAP_FORMAT_C))
-            good_file = true;
-      }
-      if (!good_file)
-      {
-         ossimNotify(ossimNotifyLevel_WARN)<<"ossimEpsgProjectionDatabase::initialize() -- "
-            "Encountered bad database file <"<<db_name<<">. Skipping this file."<<endl;
-         db_stream.close();
-         continue;
-      }
+      // Only the code and name of each record are loaded here, from the file's binary index
+      // when it is current:
+      const ossim_uint32 file_index = (ossim_uint32) m_dbFiles.size();
+      m_dbFiles.push_back(db_name);
+      if (!loadIndex(db_name, file_index))
+         loadCsvFile(db_name, file_index);
 
-      // The file is good. Skip over the column descriptor line:
-      std::getline(db_stream, line.string());
+   } // end of while loop over all DB files
+}
 
-      // Loop to read all data records:
-      while (!db_stream.eof())
+//*************************************************************************************************
+//! Adds the records of a Db file by reading it through, then writes its binary index.
+//*************************************************************************************************
+void ossimEpsgProjectionDatabase::loadCsvFile(const ossimFilename& db_name,
+                                              ossim_uint32 file_index) const
+{
+   // Open the DB file:
+   std::ifstream db_stream (db_name.chars());
+   ossimString format_id;
+   ossimString line;
+   bool good_file = false;
+   if (db_stream.good())
+   {
+      // Format specification implied in file's magic number:
+      std::getline(db_stream, format_id.string());
+      format_id.trim();
+      if ((format_id == EPSG_DB_FORMAT_A) || 
+          (format_id == STATE_PLANE_FORMAT_B) ||
+          (format_id == SPCS_EPSG_MAP_FORMAT_C))
+         good_file = true;
+   }
+   if (!good_file)
+   {
+      ossimNotify(ossimNotifyLevel_WARN)<<"ossimEpsgProjectionDatabase::initialize() -- "
+         "Encountered bad database file <"<<db_name<<">. Skipping this file."<<endl;
+      db_stream.close();
+      return;
+   }
+
+   // The file is good. Skip over the column descriptor line:
+   std::getline(db_stream, line.string());
+
+   // Loop to read all data records:
+   std::vector< ossimRefPtr<ProjDbRecord> > records;
+   while (!db_stream.eof())
+   {
+      ossimRefPtr<ProjDbRecord> db_record = new ProjDbRecord;
+      const std::streamoff offset = db_stream.tellg();
+      std::getline(db_stream, line.string());
+      std::vector<ossimString> csv_record = line.explode(","); // ONLY CSV FILES CONSIDERED HERE
+      if (csv_record.size())
       {
-         ossimRefPtr<ProjDbRecord> db_record = new ProjDbRecord;
-         std::getline(db_stream, line.string());
-         db_record->csvRecord = line.explode(","); // ONLY CSV FILES CONSIDERED HERE
-         if (db_record->csvRecord.size())
-         {
-            // Check if primary EPSG database format A:
-            if (format_id == EPSG_DB_FORMAT_A)
-            {
-               db_record->code = db_record->csvRecord[A_CODE].toUInt32();
-               db_record->name = db_record->csvRecord[A_NAME];
-               db_record->csvFormat = FORMAT_A;
-            }
+         db_record->fileIndex = file_index;
+         db_record->fileOffset = (ossim_uint64) offset;
 
-            // Check if State Plane (subset of EPSG but handled differently until projection 
-            // geotrans-EPSG disconnect is resolved. 
-            else if (format_id == STATE_PLANE_FORMAT_B)
-            {
-               db_record->code = db_record->csvRecord[B_CODE].toUInt32();
-               db_record->name = db_record->csvRecord[B_NAME];
-               db_record->csvFormat = FORMAT_B;
-            }
+         // Check if primary EPSG database format A:
+         if (format_id == EPSG_DB_FORMAT_A)
+         {
+            db_record->code = csv_record[A_CODE].toUInt32();
+            db_record->name = csv_record[A_NAME];
+            db_record->csvFormat = FORMAT_A;
+         }
 
-            // This format is for Ming-special State Plane Coordinate System coded format.
-            // This format is simply a mapping from SPCS spec name (OSSIM-specific) to EPSG code.
-            // Note that no proj is instantiated and no KWL is populated. Only name and EPSG mapped
-            // code is saved.
-            else if (format_id == SPCS_EPSG_MAP_FORMAT_C)
-            {
-               db_record->code = db_record->csvRecord[C_CODE].toUInt32();
-               db_record->name = db_record->csvRecord[C_NAME];
-               db_record->csvFormat = FORMAT_C;
-            }
+         // Check if State Plane (subset of EPSG but handled differently until projection 
+         // geotrans-EPSG disconnect is resolved. 
+         else if (format_id == STATE_PLANE_FORMAT_B)
+         {
+            db_record->code = csv_record[B_CODE].toUInt32();
+            db_record->name = csv_record[B_NAME];
+            db_record->csvFormat = FORMAT_B;
+         }
 
-            m_projDatabase.insert(make_pair(db_record->code, db_record));
+         // This format is for Ming-special State Plane Coordinate System coded format.
+         // This format is simply a mapping from SPCS spec name (OSSIM-specific) to EPSG code.
+         // Note that no proj is instantiated and no KWL is populated. Only name and EPSG mapped
+         // code is saved.
+         else if (format_id == SPCS_EPSG_MAP_FORMAT_C)
+         {
+            db_record->code = csv_record[C_CODE].toUInt32();
+            db_record->name = csv_record[C_NAME];
+            db_record->csvFormat = FORMAT_C;
          }
+
+         m_projDatabase.insert(make_pair(db_record->code, db_record));
+         records.push_back(db_record);
       }
+   }
+   db_stream.close();
+
+   //---
+   // Write the index for the next run. Layout (native byte order):
+   //    magic, ossim_int64 mod time, ossim_int64 size, ossim_uint32 format, ossim_uint32 count,
+   //    then per record: ossim_uint32 code, ossim_uint64 offset, ossim_uint32 name length, name.
+   //---
+   ossim_int64 mod_time = 0;
+   ossim_int64 size = 0;
+   ossimFilename index_file = getIndexFile(db_name);
+   if (!getDbFileStamp(db_name, mod_time, size) || index_file.empty())
+      return;
+
+   ossimFilename index_dir = index_file.path();
+   if (index_dir.size() && !index_dir.exists())
+      index_dir.createDirectory();
+   std::ofstream out (index_file.chars(), std::ios::out | std::ios::binary | std::ios::trunc);
+   if (!out.good())
+      return;
+   const ossim_uint32 format = records.size() ? (ossim_uint32) records[0]->csvFormat : 0;
+   const ossim_uint32 count = (ossim_uint32) records.size();
+   out.write(DB_INDEX_MAGIC, DB_INDEX_MAGIC_SIZE);
+   out.write((const char*) &mod_time, sizeof(mod_time));
+   out.write((const char*) &size, sizeof(size));
+   out.write((const char*) &format, sizeof(format));
+   out.write((const char*) &count, sizeof(count));
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      const ossim_uint32 name_size = (ossim_uint32) records[i]->name.size();
+      out.write((const char*) &records[i]->code, sizeof(ossim_uint32));
+      out.write((const char*) &records[i]->fileOffset, sizeof(ossim_uint64));
+      out.write((const char*) &name_size, sizeof(name_size));
+      out.write(records[i]->name.c_str(), name_size);
+   }
+   out.close();
+   if (out.fail())
+      index_file.remove();
+}
 
-      db_stream.close();
-   } // end of while loop over all DB files
+//*************************************************************************************************
+//! Adds the code, name and line offset of each record of a Db file from its binary index.
+//*************************************************************************************************
+bool ossimEpsgProjectionDatabase::loadIndex(const ossimFilename& db_name,
+                                            ossim_uint32 file_index) const
+{
+   ossim_int64 mod_time = 0;
+   ossim_int64 size = 0;
+   ossimFilename index_file = getIndexFile(db_name);
+   if (index_file.empty() || !index_file.isReadable() ||
+       !getDbFileStamp(db_name, mod_time, size))
+      return false;
+
+   // Read the whole index in one go and parse it from memory:
+   std::vector<char> buf;
+   {
+      std::ifstream in (index_file.chars(), std::ios::in | std::ios::binary);
+      const ossim_int64 index_size = index_file.fileSize();
+      if (!in.good() || (index_size <= 0))
+         return false;
+      buf.resize((size_t) index_size);
+      in.read(&buf.front(), index_size);
+      if (in.gcount() != index_size)
+         return false;
+   }
+
+   const size_t HEADER_SIZE = DB_INDEX_MAGIC_SIZE + 2*sizeof(ossim_int64) + 2*sizeof(ossim_uint32);
+   if ((buf.size() < HEADER_SIZE) || memcmp(&buf.front(), DB_INDEX_MAGIC, DB_INDEX_MAGIC_SIZE))
+      return false;
+
+   size_t pos = DB_INDEX_MAGIC_SIZE;
+   ossim_int64 index_mod_time;
+   ossim_int64 index_db_size;
+   ossim_uint32 format;
+   ossim_uint32 count;
+   memcpy(&index_mod_time, &buf[pos], sizeof(index_mod_time)); pos += sizeof(index_mod_time);
+   memcpy(&index_db_size, &buf[pos], sizeof(index_db_size));   pos += sizeof(index_db_size);
+   memcpy(&format, &buf[pos], sizeof(format));                 pos += sizeof(format);
+   memcpy(&count, &buf[pos], sizeof(count));                   pos += sizeof(count);
+
+   // The CSV is the reference; an index older than it is rebuilt:
+   if ((index_mod_time != mod_time) || (index_db_size != size) || (format > CUSTOM))
+      return false;
+
+   const size_t FIXED_SIZE = sizeof(ossim_uint32) + sizeof(ossim_uint64) + sizeof(ossim_uint32);
+   std::vector< ossimRefPtr<ProjDbRecord> > records;
+   records.reserve(count);
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      if (buf.size() - pos < FIXED_SIZE)
+         return false;
+      ossimRefPtr<ProjDbRecord> db_record = new ProjDbRecord;
+      ossim_uint32 name_size;
+      memcpy(&db_record->code, &buf[pos], sizeof(ossim_uint32));       pos += sizeof(ossim_uint32);
+      memcpy(&db_record->fileOffset, &buf[pos], sizeof(ossim_uint64)); pos += sizeof(ossim_uint64);
+      memcpy(&name_size, &buf[pos], sizeof(name_size));                pos += sizeof(name_size);
+      if (buf.size() - pos < name_size)
+         return false;
+      db_record->name.string().assign(&buf[pos], name_size);
+      pos += name_size;
+      db_record->fileIndex = file_index;
+      db_record->csvFormat = (RecordFormat) format;
+      records.push_back(db_record);
+   }
+
+   for (ossim_uint32 i = 0; i < count; ++i)
+      m_projDatabase.insert(make_pair(records[i]->code, records[i]));
+   return true;
+}
+
+//*************************************************************************************************
+//! Reads the CSV fields of the record from its Db file if not already done.
+//*************************************************************************************************
+bool ossimEpsgProjectionDatabase::loadCsvRecord(ProjDbRecord* record) const
+{
+   if (!record->csvRecord.empty())
+      return true;
+   if (record->fileIndex >= m_dbFiles.size())
+      return false;
+
+   std::ifstream db_stream (m_dbFiles[record->fileIndex].chars());
+   if (!db_stream.good())
+      return false;
+   db_stream.seekg((std::streamoff) record->fileOffset);
+   ossimString line;
+   std::getline(db_stream, line.string());
+   record->csvRecord = line.explode(",");
+   return !record->csvRecord.empty();
+}
+
+//*************************************************************************************************
+//! Binary index file of a Db file.
+//*************************************************************************************************
+ossimFilename ossimEpsgProjectionDatabase::getIndexFile(const ossimFilename& db_name) const
+{
+   ossimFilename index_dir = db_name.path();
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("epsg_database_index_directory");
+   if (lookup && *lookup)
+      index_dir = ossimFilename(lookup).expand();
+   if (index_dir.empty())
+      return db_name + ".idx";
+   return index_dir.dirCat(db_name.file() + ".idx");
 }
 
 //*************************************************************************************************
@@ -361,11 +540,13 @@ ossimProjection* ossimEpsgProjectionDatabase::findProjection(ossim_uint32 epsg_c
                   db_record->proj = proj;
                   db_record->datumValid = true;
                }
-               else if (db_iter->second->csvFormat == FORMAT_A)
+               else if ((db_iter->second->csvFormat == FORMAT_A) &&
+                        loadCsvRecord(db_record.get()))
                {
                   proj = createProjFromFormatARecord( db_record.get() );
                }
-               else if (db_iter->second->csvFormat == FORMAT_B)
+               else if ((db_iter->second->csvFormat == FORMAT_B) &&
+                        loadCsvRecord(db_record.get()))
                {
                   proj = createProjFromFormatBRecord( db_record.get() );
                }
@@ -395,6 +395,49 @@ ossimDpt ossimEquDistCylProjection::forward(const ossimGpt &latLon)const
    return ossimDpt(easting, northing);
 }
 
+void ossimEquDistCylProjection::forwardPoints(const ossimGpt* worldPoints,
+                                              ossimDpt* eastingNorthings,
+                                              ossim_uint32 count) const
+{
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      Convert_Geodetic_To_Equidistant_Cyl(worldPoints[i].latr(),
+                                          worldPoints[i].lonr(),
+                                          &eastingNorthings[i].x,
+                                          &eastingNorthings[i].y);
+   }
+}
+
+void ossimEquDistCylProjection::inversePoints(const ossimDpt* eastingNorthings,
+                                              ossimGpt* worldPoints,
+                                              ossim_uint32 count) const
+{
+   double lat = 0.0;
+   double lon = 0.0;
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      Convert_Equidistant_Cyl_To_Geodetic(eastingNorthings[i].x,
+                                          eastingNorthings[i].y,
+                                          &lat,
+                                          &lon);
+      worldPoints[i] = ossimGpt(lat*DEG_PER_RAD, lon*DEG_PER_RAD, 0.0, theDatum);
+   }
+}
+
+void ossimEquDistCylProjection::worldToLineSamples(const ossimGpt* worldPoints,
+                                                   ossimDpt* lineSamples,
+                                                   ossim_uint32 count) const
+{
+   forwardToLineSamples(worldPoints, lineSamples, count);
+}
+
+void ossimEquDistCylProjection::lineSampleToWorlds(const ossimDpt* lineSamples,
+                                                   ossimGpt* worldPoints,
+                                                   ossim_uint32 count) const
+{
+   inverseToWorlds(lineSamples, worldPoints, count, false);
+}
+
 
 
 bool ossimEquDistCylProjection::saveState(ossimKeywordlist& kwl, const char* prefix) const
@@ -97,6 +97,42 @@ ossimDpt ossimGoogleProjection::forward(const ossimGpt &latLon)const
    return ossimDpt(lon2x_m(latLon.lond()), lat2y_m(latLon.latd()));
 }
 
+void ossimGoogleProjection::forwardPoints(const ossimGpt* worldPoints,
+                                          ossimDpt* eastingNorthings,
+                                          ossim_uint32 count) const
+{
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      eastingNorthings[i].x = lon2x_m(worldPoints[i].lond());
+      eastingNorthings[i].y = lat2y_m(worldPoints[i].latd());
+   }
+}
+
+void ossimGoogleProjection::inversePoints(const ossimDpt* eastingNorthings,
+                                          ossimGpt* worldPoints,
+                                          ossim_uint32 count) const
+{
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      worldPoints[i] = ossimGpt(y2lat_m(eastingNorthings[i].y),
+                                x2lon_m(eastingNorthings[i].x), 0, theDatum);
+   }
+}
+
+void ossimGoogleProjection::worldToLineSamples(const ossimGpt* worldPoints,
+                                               ossimDpt* lineSamples,
+                                               ossim_uint32 count) const
+{
+   forwardToLineSamples(worldPoints, lineSamples, count);
+}
+
+void ossimGoogleProjection::lineSampleToWorlds(const ossimDpt* lineSamples,
+                                               ossimGpt* worldPoints,
+                                               ossim_uint32 count) const
+{
+   inverseToWorlds(lineSamples, worldPoints, count, true);
+}
+
 bool ossimGoogleProjection::saveState(ossimKeywordlist& kwl, const char* prefix) const
 {
    return ossimMapProjection::saveState(kwl, prefix);
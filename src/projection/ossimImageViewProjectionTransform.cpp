@@ -25,11 +25,18 @@
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimPolyArea2d.h>
 #include <ossim/projection/ossimEquDistCylProjection.h>
+#include <OpenThreads/ScopedLock>
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
-RTTI_DEF1(ossimImageViewProjectionTransform,
+RTTI_DEF2(ossimImageViewProjectionTransform,
           "ossimImageViewProjectionTransform",
-          ossimImageViewTransform);
+          ossimImageViewTransform,
+          ossimImageGeometryEventListener);
+
+// Bounds the Jacobian nodes kept when roaming far over a large view.
+static const ossim_uint32 MAX_JACOBIAN_NODES = 65536;
 
 //*****************************************************************************
 //  CONSTRUCTOR: ossimImageViewProjectionTransform
@@ -47,6 +54,7 @@ ossimImageViewProjectionTransform::ossimImageViewProjectionTransform
 ossimImageViewProjectionTransform::
 ossimImageViewProjectionTransform(const ossimImageViewProjectionTransform& src)
 : ossimImageViewTransform(src),
+  ossimImageGeometryEventListener(),
   m_imageGeometry(src.m_imageGeometry),
   m_viewGeometry(src.m_viewGeometry)
 {
@@ -170,6 +178,34 @@ void ossimImageViewProjectionTransform::viewToImage(const ossimDpt& vp, ossimDpt
 #endif
 }
 
+//*****************************************************************************
+//  Batch form of viewToImage.
+//*****************************************************************************
+void ossimImageViewProjectionTransform::viewToImagePoints(const ossimDpt* viewPoints,
+                                                          ossimDpt*       imagePoints,
+                                                          ossim_uint32    count) const
+{
+   // Same geometries, same projections or bad geometries are cheap or trivial; no ground step.
+   const ossimProjection* iproj = m_imageGeometry.valid() ? m_imageGeometry->getProjection() : 0;
+   const ossimProjection* vproj = m_viewGeometry.valid() ? m_viewGeometry->getProjection() : 0;
+   if ( (m_imageGeometry == m_viewGeometry) || !m_imageGeometry || !m_viewGeometry ||
+        (iproj && vproj && iproj->isEqualTo(*vproj)) || (iproj == vproj) )
+   {
+      ossimImageViewTransform::viewToImagePoints(viewPoints, imagePoints, count);
+      return;
+   }
+
+   std::vector<ossimGpt> gpts(count);
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      m_viewGeometry->localToWorld(viewPoints[i], gpts[i]);
+   }
+   if (count)
+   {
+      m_imageGeometry->worldToLocal(&gpts[0], imagePoints, count);
+   }
+}
+
 //*****************************************************************************
 //! OLK: Not sure where this is used, but needed to satisfy ossimViewInterface base class.
 //*****************************************************************************
@@ -205,6 +241,7 @@ bool ossimImageViewProjectionTransform::setView(ossimObject* baseObject)
       // Sets the view image size from the image geometry if present.
       initializeViewSize();
    } 
+   invalidateJacobianGrid();
 
    return new_view_set;
 }
@@ -309,7 +346,7 @@ bool ossimImageViewProjectionTransform::loadState(const ossimKeywordlist& kwl,
          m_viewGeometry = new ossimImageGeometry();
          m_viewGeometry->loadState(kwl, viewPrefix.c_str());
       }
-      
+      invalidateJacobianGrid();
    }
    
    return result;
@@ -505,3 +542,225 @@ bool ossimImageViewProjectionTransform::initializeViewSize()
    return result;
    
 } // End:  bool ossimImageViewProjectionTransform::initializeViewSize()
+
+//**************************************************************************************************
+// Local view to image Jacobian, bilinear between the nodes of the coarse grid.
+//**************************************************************************************************
+bool ossimImageViewProjectionTransform::getViewToImageJacobian(const ossimDpt& viewPoint,
+                                                               ossimDpt& dx,
+                                                               ossimDpt& dy) const
+{
+   if (viewPoint.hasNans())
+   {
+      return false;
+   }
+
+   const ossim_float64 X  = viewPoint.x / JACOBIAN_GRID_SIZE;
+   const ossim_float64 Y  = viewPoint.y / JACOBIAN_GRID_SIZE;
+   const ossim_float64 CX = std::floor(X);
+   const ossim_float64 CY = std::floor(Y);
+
+   Jacobian cell[4];
+   getJacobianCell((ossim_int32)CX, (ossim_int32)CY, cell);
+   if (!cell[0].m_valid || !cell[1].m_valid || !cell[2].m_valid || !cell[3].m_valid)
+   {
+      return false;
+   }
+
+   const ossim_float64 U = X - CX;
+   const ossim_float64 V = Y - CY;
+   ossimDpt top    = cell[0].m_dx + (cell[1].m_dx - cell[0].m_dx)*U;
+   ossimDpt bottom = cell[3].m_dx + (cell[2].m_dx - cell[3].m_dx)*U;
+   dx = top + (bottom - top)*V;
+   top    = cell[0].m_dy + (cell[1].m_dy - cell[0].m_dy)*U;
+   bottom = cell[3].m_dy + (cell[2].m_dy - cell[3].m_dy)*U;
+   dy = top + (bottom - top)*V;
+   return true;
+}
+
+void ossimImageViewProjectionTransform::getJacobianCell(ossim_int32 x,
+                                                        ossim_int32 y,
+                                                        Jacobian cell[4]) const
+{
+   static const ossim_int32 NODES[4][2] = { {0, 0}, {1, 0}, {1, 1}, {0, 1} };
+
+   ossim_int64 keys[4];
+   bool missing[4];
+   ossim_uint32 missingCount = 0;
+   ossim_uint32 i;
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_jacobianMutex);
+      for (i = 0; i < 4; ++i)
+      {
+         keys[i] = ((ossim_int64)(y + NODES[i][1]) << 32) |
+            (ossim_int64)(ossim_uint32)(x + NODES[i][0]);
+         std::map<ossim_int64, Jacobian>::const_iterator iter = m_jacobians.find(keys[i]);
+         missing[i] = (iter == m_jacobians.end());
+         if (missing[i])
+         {
+            ++missingCount;
+         }
+         else
+         {
+            cell[i] = iter->second;
+         }
+      }
+   }
+   if (!missingCount)
+   {
+      return;
+   }
+
+   // Central differences, half a view pixel either side; one batch for the missing nodes.
+   ossimDpt viewPts[16];
+   ossimDpt imagePts[16];
+   ossim_uint32 n = 0;
+   for (i = 0; i < 4; ++i)
+   {
+      if (missing[i])
+      {
+         const ossimDpt NODE((ossim_float64)(x + NODES[i][0]) * JACOBIAN_GRID_SIZE,
+                             (ossim_float64)(y + NODES[i][1]) * JACOBIAN_GRID_SIZE);
+         viewPts[n++] = NODE - ossimDpt(0.5, 0.0);
+         viewPts[n++] = NODE + ossimDpt(0.5, 0.0);
+         viewPts[n++] = NODE - ossimDpt(0.0, 0.5);
+         viewPts[n++] = NODE + ossimDpt(0.0, 0.5);
+      }
+   }
+   viewToImagePoints(viewPts, imagePts, n);
+
+   n = 0;
+   for (i = 0; i < 4; ++i)
+   {
+      if (missing[i])
+      {
+         cell[i].m_dx = imagePts[n+1] - imagePts[n];
+         cell[i].m_dy = imagePts[n+3] - imagePts[n+2];
+         cell[i].m_valid = !cell[i].m_dx.hasNans() && !cell[i].m_dy.hasNans();
+         n += 4;
+      }
+   }
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_jacobianMutex);
+   if (m_jacobians.size() >= MAX_JACOBIAN_NODES)
+   {
+      m_jacobians.clear();
+   }
+   for (i = 0; i < 4; ++i)
+   {
+      if (missing[i])
+      {
+         m_jacobians[keys[i]] = cell[i];
+      }
+   }
+}
+
+//**************************************************************************************************
+// Image-space bounding size of one view pixel over a view rect.
+//**************************************************************************************************
+ossimDpt ossimImageViewProjectionTransform::getViewToImageFootprint(const ossimDrect& viewRect) const
+{
+   ossimDpt result;
+   result.makeNan();
+   if (viewRect.hasNans())
+   {
+      return result;
+   }
+
+   // 5 x 5 lattice, corners included.
+   const ossim_uint32 STEPS = 4;
+   const ossimDpt UL = viewRect.ul();
+   const ossimDpt SPAN = viewRect.lr() - UL;
+   ossimDpt dx;
+   ossimDpt dy;
+   for (ossim_uint32 j = 0; j <= STEPS; ++j)
+   {
+      for (ossim_uint32 i = 0; i <= STEPS; ++i)
+      {
+         const ossimDpt PT(UL.x + SPAN.x*i/STEPS, UL.y + SPAN.y*j/STEPS);
+         if (getViewToImageJacobian(PT, dx, dy))
+         {
+            const ossimDpt SIZE(std::fabs(dx.x) + std::fabs(dy.x),
+                                std::fabs(dx.y) + std::fabs(dy.y));
+            if (result.hasNans())
+            {
+               result = SIZE;
+            }
+            else
+            {
+               result.x = std::max(result.x, SIZE.x);
+               result.y = std::max(result.y, SIZE.y);
+            }
+         }
+      }
+   }
+   return result;
+}
+
+//**************************************************************************************************
+// Scale changes from the Jacobian grid.
+//**************************************************************************************************
+void ossimImageViewProjectionTransform::getScaleChangeImageToView(ossimDpt& result,
+                                                                  const ossimDrect& imageRect)
+{
+   result.makeNan();
+   if (imageRect.hasNans())
+   {
+      return;
+   }
+
+   ossimDpt viewPt;
+   ossimDpt dx;
+   ossimDpt dy;
+   imageToView(imageRect.midPoint(), viewPt);
+   if (getViewToImageJacobian(viewPt, dx, dy) &&
+       (std::fabs(dx.x*dy.y - dy.x*dx.y) > DBL_EPSILON))
+   {
+      // Lengths of the columns of the inverse Jacobian: view steps for one image pixel.
+      const double INV_DET = 1.0/(dx.x*dy.y - dy.x*dx.y);
+      result.x = ossimDpt(dy.y*INV_DET, -dx.y*INV_DET).length();
+      result.y = ossimDpt(-dy.x*INV_DET, dx.x*INV_DET).length();
+      return;
+   }
+   ossimImageViewTransform::getScaleChangeImageToView(result, imageRect);
+}
+
+void ossimImageViewProjectionTransform::getScaleChangeViewToImage(ossimDpt& result,
+                                                                  const ossimDrect& viewRect)
+{
+   result.makeNan();
+   if (viewRect.hasNans())
+   {
+      return;
+   }
+
+   const ossimDpt CORNERS[4] = { viewRect.ul(), viewRect.ur(), viewRect.lr(), viewRect.ll() };
+   ossimDpt sum(0.0, 0.0);
+   ossimDpt dx;
+   ossimDpt dy;
+   for (ossim_uint32 i = 0; i < 4; ++i)
+   {
+      if (!getViewToImageJacobian(CORNERS[i], dx, dy))
+      {
+         ossimImageViewTransform::getScaleChangeViewToImage(result, viewRect);
+         return;
+      }
+      sum.x += dx.length();
+      sum.y += dy.length();
+   }
+   result = sum*0.25;
+}
+
+//**************************************************************************************************
+// Drops the Jacobian grid.
+//**************************************************************************************************
+void ossimImageViewProjectionTransform::invalidateJacobianGrid()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_jacobianMutex);
+   m_jacobians.clear();
+}
+
+void ossimImageViewProjectionTransform::imageGeometryEvent(ossimImageGeometryEvent& /* event */)
+{
+   invalidateJacobianGrid();
+}
@@ -38,6 +38,16 @@ void ossimImageViewTransform::viewToImage(const ossimDpt& viewPoint,
    ossim2dTo2dTransform::inverse(viewPoint, imagePoint);
 }
 
+void ossimImageViewTransform::viewToImagePoints(const ossimDpt* viewPoints,
+                                                ossimDpt*       imagePoints,
+                                                ossim_uint32    count)const
+{
+   for(ossim_uint32 i = 0; i < count; ++i)
+   {
+      viewToImage(viewPoints[i], imagePoints[i]);
+   }
+}
+
 ossimDpt ossimImageViewTransform::imageToView(const ossimDpt& imagePoint)const
 {
    ossimDpt tempPt;
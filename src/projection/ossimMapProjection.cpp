@@ -11,6 +11,7 @@
 //*******************************************************************
 //  $Id: ossimMapProjection.cpp 23418 2015-07-09 18:46:41Z gpotts $
 
+#include <algorithm>
 #include <iostream>
 #include <cstdlib>
 #include <iomanip>
@@ -693,6 +694,164 @@ void ossimMapProjection::lineSampleToWorld (const ossimDpt& lineSampPt,
 
 }
 
+//*****************************************************************************
+//  METHOD: ossimMapProjection::forwardPoints
+//
+//*****************************************************************************
+void ossimMapProjection::forwardPoints(const ossimGpt* worldPoints,
+                                       ossimDpt* eastingNorthings,
+                                       ossim_uint32 count) const
+{
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      eastingNorthings[i] = forward(worldPoints[i]);
+   }
+}
+
+//*****************************************************************************
+//  METHOD: ossimMapProjection::inversePoints
+//
+//*****************************************************************************
+void ossimMapProjection::inversePoints(const ossimDpt* eastingNorthings,
+                                       ossimGpt* worldPoints,
+                                       ossim_uint32 count) const
+{
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      worldPoints[i] = inverse(eastingNorthings[i]);
+   }
+}
+
+// Points per pass of the batch paths; bounds the stack buffers.
+static const ossim_uint32 BATCH_BLOCK = 64;
+
+//*****************************************************************************
+//  METHOD: ossimMapProjection::forwardToLineSamples
+//
+//*****************************************************************************
+void ossimMapProjection::forwardToLineSamples(const ossimGpt* worldPoints,
+                                              ossimDpt* lineSamples,
+                                              ossim_uint32 count) const
+{
+   if (theModelTransformUnitType != OSSIM_UNIT_UNKNOWN)
+   {
+      ossimProjection::worldToLineSamples(worldPoints, lineSamples, count);
+      return;
+   }
+   if (theUlEastingNorthing.isNan())
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         lineSamples[i].makeNan();
+      }
+      return;
+   }
+
+   ossimGpt shifted[BATCH_BLOCK];
+   for (ossim_uint32 start = 0; start < count; start += BATCH_BLOCK)
+   {
+      const ossim_uint32 BLOCK_SIZE = std::min(BATCH_BLOCK, count - start);
+      const ossimGpt* gpts = worldPoints + start;
+      ossimDpt* ls = lineSamples + start;
+
+      // Datum pointers are shared, so one compare per point finds the common case of no shift.
+      if (theDatum)
+      {
+         ossim_uint32 i = 0;
+         while ( (i < BLOCK_SIZE) && (gpts[i].datum() == theDatum) )
+         {
+            ++i;
+         }
+         if (i < BLOCK_SIZE)
+         {
+            for (i = 0; i < BLOCK_SIZE; ++i)
+            {
+               shifted[i] = gpts[i];
+               shifted[i].changeDatum(theDatum);
+            }
+            gpts = shifted;
+         }
+      }
+
+      // Easting, northing in place, then to line, sample.
+      forwardPoints(gpts, ls, BLOCK_SIZE);
+      for (ossim_uint32 i = 0; i < BLOCK_SIZE; ++i)
+      {
+         ls[i].x = (ls[i].x - theUlEastingNorthing.x) / theMetersPerPixel.x;
+         ls[i].y = -(ls[i].y - theUlEastingNorthing.y) / theMetersPerPixel.y;
+      }
+   }
+}
+
+//*****************************************************************************
+//  METHOD: ossimMapProjection::inverseToWorlds
+//
+//*****************************************************************************
+void ossimMapProjection::inverseToWorlds(const ossimDpt* lineSamples,
+                                         ossimGpt* worldPoints,
+                                         ossim_uint32 count,
+                                         bool clampFlag) const
+{
+   if (theModelTransformUnitType != OSSIM_UNIT_UNKNOWN)
+   {
+      ossimProjection::lineSampleToWorlds(lineSamples, worldPoints, count);
+      return;
+   }
+   if (theUlEastingNorthing.hasNans())
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         worldPoints[i].makeNan();
+      }
+      return;
+   }
+
+   ossimDpt eastingNorthings[BATCH_BLOCK];
+   double heights[BATCH_BLOCK];
+   for (ossim_uint32 start = 0; start < count; start += BATCH_BLOCK)
+   {
+      const ossim_uint32 BLOCK_SIZE = std::min(BATCH_BLOCK, count - start);
+      const ossimDpt* ls = lineSamples + start;
+      ossimGpt* gpts = worldPoints + start;
+
+      // Note: the Northing is positive up, image lines down.
+      for (ossim_uint32 i = 0; i < BLOCK_SIZE; ++i)
+      {
+         eastingNorthings[i].x = theUlEastingNorthing.x + ls[i].x * theMetersPerPixel.x;
+         eastingNorthings[i].y = theUlEastingNorthing.y - ls[i].y * theMetersPerPixel.y;
+      }
+
+      inversePoints(eastingNorthings, gpts, BLOCK_SIZE);
+      for (ossim_uint32 i = 0; i < BLOCK_SIZE; ++i)
+      {
+         ossimGpt& gpt = gpts[i];
+         gpt.datum(theDatum);
+         if ( ls[i].hasNans() || (gpt.isLatNan() && gpt.isLonNan()) )
+         {
+            gpt.makeNan();
+         }
+         else
+         {
+            if (clampFlag)
+            {
+               gpt.clampLat(-90, 90);
+               gpt.clampLon(-180, 180);
+            }
+            gpt.hgt = ossim::nan();
+         }
+      }
+
+      if (theElevationLookupFlag)
+      {
+         ossimElevManager::instance()->getHeightsAboveEllipsoid(gpts, heights, BLOCK_SIZE);
+         for (ossim_uint32 i = 0; i < BLOCK_SIZE; ++i)
+         {
+            gpts[i].hgt = heights[i];
+         }
+      }
+   }
+}
+
 //*****************************************************************************
 //  METHOD: ossimMapProjection::lineSampleToEastingNorthing
 //
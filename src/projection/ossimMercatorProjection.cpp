@@ -185,6 +185,80 @@ ossimDpt ossimMercatorProjection::forward(const ossimGpt &latLon)const
    return ossimDpt(easting, northing);
 }
 
+void ossimMercatorProjection::forwardPoints(const ossimGpt* worldPoints,
+                                            ossimDpt* eastingNorthings,
+                                            ossim_uint32 count) const
+{
+   if(theSphericalFlag)
+   {
+      const double SHIFT = M_PI * Merc_a;
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         const double lat = worldPoints[i].latd();
+         const double lon = worldPoints[i].lond();
+         eastingNorthings[i].x = lon * SHIFT / 180.0;
+         eastingNorthings[i].y = log( tan((90 + lat) * M_PI / 360.0 )) / (M_PI / 180.0);
+         eastingNorthings[i].y = eastingNorthings[i].y * SHIFT / 180.0;
+      }
+   }
+   else
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         Convert_Geodetic_To_Mercator(worldPoints[i].latr(),
+                                      worldPoints[i].lonr(),
+                                      &eastingNorthings[i].x,
+                                      &eastingNorthings[i].y);
+      }
+   }
+}
+
+void ossimMercatorProjection::inversePoints(const ossimDpt* eastingNorthings,
+                                            ossimGpt* worldPoints,
+                                            ossim_uint32 count) const
+{
+   if(theSphericalFlag)
+   {
+      const double SHIFT = M_PI * 6378137.0;
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         const double lon = (eastingNorthings[i].x / SHIFT) * 180.0;
+         double lat = (eastingNorthings[i].y / SHIFT) * 180.0;
+         lat = 180 / M_PI * (2 * atan( exp( lat * M_PI / 180.0)) - M_PI / 2.0);
+         worldPoints[i] = ossimGpt(lat, lon, 0.0, theDatum);
+      }
+   }
+   else
+   {
+      double lat = 0.0;
+      double lon = 0.0;
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         Convert_Mercator_To_Geodetic(eastingNorthings[i].x,
+                                      eastingNorthings[i].y,
+                                      &lat,
+                                      &lon);
+         worldPoints[i] = ossimGpt(ossim::radiansToDegrees(lat),
+                                   ossim::radiansToDegrees(lon),
+                                   0.0, theDatum);
+      }
+   }
+}
+
+void ossimMercatorProjection::worldToLineSamples(const ossimGpt* worldPoints,
+                                                 ossimDpt* lineSamples,
+                                                 ossim_uint32 count) const
+{
+   forwardToLineSamples(worldPoints, lineSamples, count);
+}
+
+void ossimMercatorProjection::lineSampleToWorlds(const ossimDpt* lineSamples,
+                                                 ossimGpt* worldPoints,
+                                                 ossim_uint32 count) const
+{
+   inverseToWorlds(lineSamples, worldPoints, count, true);
+}
+
 
 bool ossimMercatorProjection::saveState(ossimKeywordlist& kwl, const char* prefix) const
 {
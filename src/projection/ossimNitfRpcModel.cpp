@@ -270,6 +270,18 @@ void ossimNitfRpcModel::worldToLineSample(const ossimGpt& world_point,
    image_point.y = image_point.y * theDecimation;
 }
 
+void ossimNitfRpcModel::worldToLineSamples(const ossimGpt* world_points,
+                                           ossimDpt*       image_points,
+                                           ossim_uint32    count) const
+{
+   ossimRpcModel::worldToLineSamples(world_points, image_points, count);
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      image_points[i].x = image_points[i].x * theDecimation;
+      image_points[i].y = image_points[i].y * theDecimation;
+   }
+}
+
 void ossimNitfRpcModel::lineSampleHeightToWorld(
    const ossimDpt& image_point,
    const double&   heightEllipsoid,
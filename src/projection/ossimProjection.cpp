@@ -168,6 +168,26 @@ void ossimProjection::worldToLineSample(const ossimGpt& worldPoint,
    
 }
 
+void ossimProjection::worldToLineSamples(const ossimGpt* worldPoints,
+                                         ossimDpt*       lineSampPts,
+                                         ossim_uint32    count) const
+{
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      worldToLineSample(worldPoints[i], lineSampPts[i]);
+   }
+}
+
+void ossimProjection::lineSampleToWorlds(const ossimDpt* lineSampPts,
+                                         ossimGpt*       worldPts,
+                                         ossim_uint32    count) const
+{
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      lineSampleToWorld(lineSampPts[i], worldPts[i]);
+   }
+}
+
 void ossimProjection::getRoundTripError(const ossimDpt& imagePoint,
                                         ossimDpt& errorResult)const
 {
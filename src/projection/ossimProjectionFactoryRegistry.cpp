@@ -16,7 +16,10 @@
 #include <ossim/projection/ossimSensorModelFactory.h>
 #include <ossim/projection/ossimMiscProjectionFactory.h>
 #include <ossim/projection/ossimProjection.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimObjectFactoryRegistry.h>
+#include <ossim/plugin/ossimSharedPluginRegistry.h>
 #include <algorithm>
 #include <vector>
 
@@ -58,6 +61,8 @@ ossimProjection*
 ossimProjectionFactoryRegistry::createProjection(const ossimFilename& name,
                                                  ossim_uint32 entryIdx)const
 {
+   ossimSharedPluginRegistry::instance()->loadDeferredPlugins(
+      ossimSharedPluginRegistry::MANIFEST_EXTENSIONS_KW, name.ext());
    ossimProjection* result = 0;
    ossim_uint32 idx = 0;
    for(idx = 0; ((idx < m_factoryList.size())&&(!result)); ++idx)
@@ -68,6 +73,13 @@ ossimProjectionFactoryRegistry::createProjection(const ossimFilename& name,
    return result;
 }
 
+ossimProjection* ossimProjectionFactoryRegistry::createProjection(const ossimString& name)const
+{
+   ossimSharedPluginRegistry::instance()->loadDeferredPlugins(
+      ossimSharedPluginRegistry::MANIFEST_PROJECTIONS_KW, name);
+   return createNativeObjectFromRegistry(name);
+}
+
 ossimProjection* ossimProjectionFactoryRegistry::createProjection(ossimImageHandler* handler)const
 {
    ossimProjection* result = 0;
@@ -85,6 +97,8 @@ ossimProjection* ossimProjectionFactoryRegistry::createProjection(
 {
    ossimProjection* result = 0;//createNativeObjectFromRegistry(kwl, prefix); 
    ossim_uint32 idx = 0; 
+   ossimSharedPluginRegistry::instance()->loadDeferredPlugins(
+      ossimSharedPluginRegistry::MANIFEST_PROJECTIONS_KW, ossimString(kwl.find(prefix, ossimKeywordNames::TYPE_KW)));
    for(idx = 0; ((idx < m_factoryList.size())&&!result);++idx) 
    { 
       result = m_factoryList[idx]->createProjection(kwl, prefix); 
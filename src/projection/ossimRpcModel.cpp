@@ -29,12 +29,17 @@ RTTI_DEF1(ossimRpcModel, "ossimRpcModel", ossimSensorModel);
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimSimd.h>
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include <ossim/projection/ossimProjectionFactoryRegistry.h>
 
+#if OSSIM_SIMD_X86
+#  include <immintrin.h>
+#endif
+
 //***
 // Define Trace flags for use within this file:
 //***
@@ -77,6 +82,171 @@ static const ossimString PARAM_UNITS[] ={"pixel",
                                         "scale",
                                         "degrees",
                                         "degrees"};
+
+//---
+// Batch polynomial evaluation for worldToLineSamples().  Monomials are in
+// the type A order:
+//
+//    1 L P H LP LH PH LPH LL PP HH LLL LLP LLH LPP PPP PPH LHH PHH HHH
+//
+// and type B coefficients are moved to it with B_TO_A.  Every path forms
+// the monomials and sums the terms in the same order, so they agree bit for
+// bit with each other.
+//---
+static const int RPC_BLOCK = 64;
+static const int B_TO_A[20] = { 0, 1, 2, 3, 4, 5, 6, 8, 9, 10,
+                                7, 11, 14, 17, 12, 15, 18, 13, 16, 19 };
+
+namespace
+{
+   // u[i] = c[0].m / c[1].m, v[i] = c[2].m / c[3].m
+   void rpcRatiosScalar(const double* P, const double* L, const double* H, int n,
+                        const double (*c)[20], double* u, double* v)
+   {
+      for (int i = 0; i < n; ++i)
+      {
+         double m[20];
+         m[ 1] = L[i];
+         m[ 2] = P[i];
+         m[ 3] = H[i];
+         m[ 4] = m[1]*m[2];
+         m[ 5] = m[1]*m[3];
+         m[ 6] = m[2]*m[3];
+         m[ 7] = m[4]*m[3];
+         m[ 8] = m[1]*m[1];
+         m[ 9] = m[2]*m[2];
+         m[10] = m[3]*m[3];
+         m[11] = m[8]*m[1];
+         m[12] = m[8]*m[2];
+         m[13] = m[8]*m[3];
+         m[14] = m[4]*m[2];
+         m[15] = m[9]*m[2];
+         m[16] = m[9]*m[3];
+         m[17] = m[5]*m[3];
+         m[18] = m[6]*m[3];
+         m[19] = m[10]*m[3];
+         double r[4];
+         for (int j = 0; j < 4; ++j)
+         {
+            double acc = c[j][0];
+            for (int k = 1; k < 20; ++k)
+            {
+               acc = acc + c[j][k]*m[k];
+            }
+            r[j] = acc;
+         }
+         u[i] = r[0] / r[1];
+         v[i] = r[2] / r[3];
+      }
+   }
+
+#if OSSIM_SIMD_X86
+   OSSIM_SIMD_TARGET("sse2")
+   void rpcRatiosSse2(const double* P, const double* L, const double* H, int n,
+                      const double (*c)[20], double* u, double* v)
+   {
+      int i = 0;
+      for (; i + 2 <= n; i += 2)
+      {
+         __m128d m[20];
+         m[ 1] = _mm_loadu_pd(L + i);
+         m[ 2] = _mm_loadu_pd(P + i);
+         m[ 3] = _mm_loadu_pd(H + i);
+         m[ 4] = _mm_mul_pd(m[1], m[2]);
+         m[ 5] = _mm_mul_pd(m[1], m[3]);
+         m[ 6] = _mm_mul_pd(m[2], m[3]);
+         m[ 7] = _mm_mul_pd(m[4], m[3]);
+         m[ 8] = _mm_mul_pd(m[1], m[1]);
+         m[ 9] = _mm_mul_pd(m[2], m[2]);
+         m[10] = _mm_mul_pd(m[3], m[3]);
+         m[11] = _mm_mul_pd(m[8], m[1]);
+         m[12] = _mm_mul_pd(m[8], m[2]);
+         m[13] = _mm_mul_pd(m[8], m[3]);
+         m[14] = _mm_mul_pd(m[4], m[2]);
+         m[15] = _mm_mul_pd(m[9], m[2]);
+         m[16] = _mm_mul_pd(m[9], m[3]);
+         m[17] = _mm_mul_pd(m[5], m[3]);
+         m[18] = _mm_mul_pd(m[6], m[3]);
+         m[19] = _mm_mul_pd(m[10], m[3]);
+         __m128d r[4];
+         for (int j = 0; j < 4; ++j)
+         {
+            __m128d acc = _mm_set1_pd(c[j][0]);
+            for (int k = 1; k < 20; ++k)
+            {
+               acc = _mm_add_pd(acc, _mm_mul_pd(_mm_set1_pd(c[j][k]), m[k]));
+            }
+            r[j] = acc;
+         }
+         _mm_storeu_pd(u + i, _mm_div_pd(r[0], r[1]));
+         _mm_storeu_pd(v + i, _mm_div_pd(r[2], r[3]));
+      }
+      rpcRatiosScalar(P + i, L + i, H + i, n - i, c, u + i, v + i);
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   void rpcRatiosAvx2(const double* P, const double* L, const double* H, int n,
+                      const double (*c)[20], double* u, double* v)
+   {
+      int i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+         __m256d m[20];
+         m[ 1] = _mm256_loadu_pd(L + i);
+         m[ 2] = _mm256_loadu_pd(P + i);
+         m[ 3] = _mm256_loadu_pd(H + i);
+         m[ 4] = _mm256_mul_pd(m[1], m[2]);
+         m[ 5] = _mm256_mul_pd(m[1], m[3]);
+         m[ 6] = _mm256_mul_pd(m[2], m[3]);
+         m[ 7] = _mm256_mul_pd(m[4], m[3]);
+         m[ 8] = _mm256_mul_pd(m[1], m[1]);
+         m[ 9] = _mm256_mul_pd(m[2], m[2]);
+         m[10] = _mm256_mul_pd(m[3], m[3]);
+         m[11] = _mm256_mul_pd(m[8], m[1]);
+         m[12] = _mm256_mul_pd(m[8], m[2]);
+         m[13] = _mm256_mul_pd(m[8], m[3]);
+         m[14] = _mm256_mul_pd(m[4], m[2]);
+         m[15] = _mm256_mul_pd(m[9], m[2]);
+         m[16] = _mm256_mul_pd(m[9], m[3]);
+         m[17] = _mm256_mul_pd(m[5], m[3]);
+         m[18] = _mm256_mul_pd(m[6], m[3]);
+         m[19] = _mm256_mul_pd(m[10], m[3]);
+         __m256d r[4];
+         for (int j = 0; j < 4; ++j)
+         {
+            __m256d acc = _mm256_set1_pd(c[j][0]);
+            for (int k = 1; k < 20; ++k)
+            {
+               acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_set1_pd(c[j][k]), m[k]));
+            }
+            r[j] = acc;
+         }
+         _mm256_storeu_pd(u + i, _mm256_div_pd(r[0], r[1]));
+         _mm256_storeu_pd(v + i, _mm256_div_pd(r[2], r[3]));
+      }
+      rpcRatiosSse2(P + i, L + i, H + i, n - i, c, u + i, v + i);
+   }
+#endif
+
+   void rpcRatios(const double* P, const double* L, const double* H, int n,
+                  const double (*c)[20], double* u, double* v)
+   {
+#if OSSIM_SIMD_X86
+      const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+      if (LEVEL >= ossim::SIMD_AVX2)
+      {
+         rpcRatiosAvx2(P, L, H, n, c, u, v);
+         return;
+      }
+      if (LEVEL >= ossim::SIMD_SSE2)
+      {
+         rpcRatiosSse2(P, L, H, n, c, u, v);
+         return;
+      }
+#endif
+      rpcRatiosScalar(P, L, H, n, c, u, v);
+   }
+}
       
 //*****************************************************************************
 //  DEFAULT CONSTRUCTOR: ossimRpcModel()
@@ -320,6 +490,67 @@ void ossimRpcModel::worldToLineSample(const ossimGpt& ground_point,
    return;
 }
 
+//*****************************************************************************
+//  METHOD: ossimRpcModel::worldToLineSamples()
+//  
+//  Overrides base class implementation. Normalizes a block of points into
+//  lat, lon and height arrays and evaluates the polynomials on all of them.
+//*****************************************************************************
+void ossimRpcModel::worldToLineSamples(const ossimGpt* world_points,
+                                       ossimDpt*       image_points,
+                                       ossim_uint32    count) const
+{
+   double c[4][20];
+   const double* coefs[4] = { theLineNumCoef, theLineDenCoef,
+                              theSampNumCoef, theSampDenCoef };
+   for (int j = 0; j < 4; ++j)
+   {
+      for (int k = 0; k < 20; ++k)
+      {
+         c[j][(thePolyType == A) ? k : B_TO_A[k]] = coefs[j][k];
+      }
+   }
+
+   const double NULL_HGT   = ( - theHgtOffset) / theHgtScale;
+   const double LINE_SCALE = theLineScale + theIntrackScale;
+   const double SAMP_SCALE = theSampScale + theCrtrackScale;
+
+   double P[RPC_BLOCK];
+   double L[RPC_BLOCK];
+   double H[RPC_BLOCK];
+   double U_rot[RPC_BLOCK];
+   double V_rot[RPC_BLOCK];
+
+   for (ossim_uint32 start = 0; start < count; start += RPC_BLOCK)
+   {
+      const int N = (int)std::min((ossim_uint32)RPC_BLOCK, count - start);
+      const ossimGpt* gpts = world_points + start;
+      ossimDpt* ipts = image_points + start;
+
+      for (int i = 0; i < N; ++i)
+      {
+         P[i] = (gpts[i].lat - theLatOffset) / theLatScale;
+         L[i] = (gpts[i].lon - theLonOffset) / theLonScale;
+         H[i] = gpts[i].isHgtNan() ? NULL_HGT : (gpts[i].hgt - theHgtOffset) / theHgtScale;
+      }
+
+      rpcRatios(P, L, H, N, c, U_rot, V_rot);
+
+      for (int i = 0; i < N; ++i)
+      {
+         if ( gpts[i].isLatNan() || gpts[i].isLonNan() )
+         {
+            ipts[i].makeNan();
+            continue;
+         }
+         double U = U_rot[i]*theCosMapRot + V_rot[i]*theSinMapRot;
+         double V = V_rot[i]*theCosMapRot - U_rot[i]*theSinMapRot;
+         ipts[i].line = U*LINE_SCALE + theLineOffset + theIntrackOffset;
+         ipts[i].samp = V*SAMP_SCALE + theSampOffset + theCrtrackOffset;
+      }
+   }
+}
+
 //*****************************************************************************
 //  METHOD: ossimRpcModel::lineSampleToWorld()
 //  
@@ -346,17 +577,67 @@ void  ossimRpcModel::lineSampleToWorld(const ossimDpt& imagePoint,
       worldPoint.makeNan();
    }
 #else
-   if(!imagePoint.hasNans())
+   intersectTerrain(imagePoint, getHeightHint(imagePoint), worldPoint);
+   setHeightHint(imagePoint, worldPoint.hgt);
+#endif
+}
+
+//*****************************************************************************
+//  METHOD: ossimRpcModel::intersectTerrain()
+//  
+//  Iterates on the ellipsoid height h of the inverse solution until the DEM
+//  height under it agrees. Without a start height or hints this is the
+//  imaging ray intersection lineSampleToWorld() always did.
+//*****************************************************************************
+void ossimRpcModel::intersectTerrain(const ossimDpt& imagePoint,
+                                     double          startHeight,
+                                     ossimGpt&       worldPoint) const
+{
+   static const int    MAX_NUM_ITERATIONS    = 8;
+   static const double CONVERGENCE_THRESHOLD = 0.01;   // meters
+   static const double MAX_STEP              = 2000.0; // meters
+
+   if(imagePoint.hasNans())
    {
-      ossimEcefRay ray;
-      imagingRay(imagePoint, ray);
-      ossimElevManager::instance()->intersectRay(ray, worldPoint);
+      worldPoint.makeNan();
+      return;
    }
-   else
+
+   ossimElevManager* elev = ossimElevManager::instance();
+   if( !ossim::isnan(startHeight) || hasHeightHints() )
    {
-      worldPoint.makeNan();
+      // Secant iteration on f(h) = DEM(h) - h; the first step is a plain
+      // fixed point step.
+      double h0 = ossim::isnan(startHeight) ? theHgtOffset : startHeight;
+      double f0 = 0.0;
+      double h1 = h0;
+      for(int i = 0; i < MAX_NUM_ITERATIONS; ++i)
+      {
+         lineSampleHeightToWorld(imagePoint, h1, worldPoint);
+         double dem = elev->getHeightAboveEllipsoid(worldPoint);
+         if(ossim::isnan(dem))
+         {
+            dem = 0.0; // As intersectRay's default.
+         }
+         double f1 = dem - h1;
+         if(std::fabs(f1) < CONVERGENCE_THRESHOLD)
+         {
+            return;
+         }
+         double h2 = ( (i == 0) || (f1 == f0) ) ? (h1 + f1) : (h1 - f1*(h1 - h0)/(f1 - f0));
+         if( ossim::isnan(h2) || (std::fabs(h2 - h1) > MAX_STEP) )
+         {
+            break;
+         }
+         h0 = h1;
+         f0 = f1;
+         h1 = h2;
+      }
    }
-#endif
+
+   ossimEcefRay ray;
+   imagingRay(imagePoint, ray);
+   elev->intersectRayFromHeight(ray, startHeight, worldPoint);
 }
 
 //*****************************************************************************
@@ -25,6 +25,7 @@ RTTI_DEF3(ossimRpcProjection, "ossimRpcProjection", ossimProjection, ossimOptimi
 #include <ossim/base/ossimDpt.h>
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimKeywordNames.h>
+#include <ossim/base/ossimLinearAlgebra.h>
 #include <cstdio>
 #include <fstream>
 #include <iostream>
@@ -1007,16 +1008,16 @@ ossimRpcProjection::getInverseDeriv(int parmIdx, const ossimDpt& ipos, double hd
 ossimDpt
 ossimRpcProjection::getForwardDeriv(int parmIdx, const ossimGpt& gpos, double hdelta)
 {   
-   static double den = 0.5/hdelta;
+   double den = 0.5/hdelta;
    ossimDpt res;
 
    double middle = getAdjustableParameter(parmIdx);
    //set parm to high value
    setAdjustableParameter(parmIdx, middle + hdelta, true);
-   res = inverse(gpos);
+   res = forward(gpos);
    //set parm to low value and gte difference
    setAdjustableParameter(parmIdx, middle - hdelta, true);
-   res -= inverse(gpos);
+   res -= forward(gpos);
    //get partial derivative
    res = res*den;
 
@@ -1359,35 +1360,13 @@ ossimRpcProjection::solveLeastSquares(NEWMAT::SymmetricMatrix& A,  NEWMAT::Colum
 NEWMAT::Matrix 
 ossimRpcProjection::invert(const NEWMAT::Matrix& m)const
 {
-   ossim_uint32 idx = 0;
-   NEWMAT::DiagonalMatrix d;
-   NEWMAT::Matrix u;
-   NEWMAT::Matrix v;
-
-   // decompose m.t*m which is stored in Temp into the singular values and vectors.
-   //
-   NEWMAT::SVD(m, d, u, v, true, true);
-   
-   // invert the diagonal
-   // this is just doing the reciprical fo all diagonal components and store back int
-   // d.  ths compute d inverse.
-   //
-   for(idx=0; idx < (ossim_uint32)d.Ncols(); ++idx)
+   // Pseudo inverse from the singular value decomposition; values at or
+   // below 1e-14 are taken as zero.
+   NEWMAT::Matrix result;
+   if ( ossimLinearAlgebra::pseudoInverse(m, 1e-14, result) < (ossim_uint32)m.Ncols() ) //TBC : use DBL_EPSILON ?
    {
-      if(d[idx] > 1e-14) //TBC : use DBL_EPSILON ?
-      {
-         d[idx] = 1.0/d[idx];
-      }
-      else
-      {
-         d[idx] = 0.0;
-
 //DEBUG TBR
 cout<<"warning: singular matrix in SVD"<<endl;
-
-      }
    }
-
-   //compute inverse of decomposed m;
-   return v*d*u.t();
+   return result;
 }
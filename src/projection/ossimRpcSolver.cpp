@@ -27,6 +27,129 @@
 #include <ossim/support_data/ossimNitfRpcBTag.h>
 #include <ossim/imaging/ossimImageGeometry.h>
 #include <ossim/base/ossim2dTo2dIdentityTransform.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimLinearAlgebra.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <OpenThreads/Block>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+
+namespace
+{
+   //---
+   // Hands out blocks of grid points to the jobs and releases the caller
+   // once the last job is done.
+   //---
+   class ossimRpcSolverGridBatch : public ossimReferenced
+   {
+   public:
+      ossimRpcSolverGridBatch(ossim_uint32 items, ossim_uint32 jobs)
+         : m_next(0),
+           m_items(items),
+           m_jobs(jobs)
+      {
+         if(m_jobs)
+         {
+            m_block.reset();
+         }
+         else
+         {
+            m_block.release();
+         }
+      }
+      bool next(ossim_uint32& first, ossim_uint32& last)
+      {
+         const ossim_uint32 BLOCK = 16;
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if ( m_next >= m_items )
+         {
+            return false;
+         }
+         first  = m_next;
+         m_next = ossim::min( m_next + BLOCK, m_items );
+         last   = m_next;
+         return true;
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_jobs && (--m_jobs == 0))
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+   private:
+      OpenThreads::Mutex m_mutex;
+      OpenThreads::Block m_block;
+      ossim_uint32       m_next;
+      ossim_uint32       m_items;
+      ossim_uint32       m_jobs;
+   };
+
+   //---
+   // Drops grid image points to the ground until the batch runs out, on its
+   // own copy of the geometry as rigorous models are not thread safe.
+   //---
+   class ossimRpcSolverGridJob : public ossimJob
+   {
+   public:
+      ossimRpcSolverGridJob(const ossimImageGeometry* prototype,
+                            const std::vector<ossimDpt>& imagePoints,
+                            std::vector<ossimGpt>& groundPoints,
+                            bool heightAboveMSLFlag,
+                            ossimRpcSolverGridBatch* batch)
+         : m_prototype(prototype),
+           m_imagePoints(imagePoints),
+           m_groundPoints(groundPoints),
+           m_heightAboveMSLFlag(heightAboveMSLFlag),
+           m_batch(batch)
+      {
+         setName("ossimRpcSolver.grid");
+      }
+      virtual void start()
+      {
+         ossimRefPtr<ossimImageGeometry> geom = new ossimImageGeometry(*m_prototype);
+         ossimGpt defaultGround;
+         ossim_uint32 first;
+         ossim_uint32 last;
+         while ( m_batch->next(first, last) )
+         {
+            for ( ossim_uint32 i = first; i < last; ++i )
+            {
+               ossimGpt gpt;
+               geom->localToWorld(m_imagePoints[i], gpt);
+               gpt.changeDatum(defaultGround.datum());
+               if(m_heightAboveMSLFlag)
+               {
+                  double h = ossimElevManager::instance()->getHeightAboveMSL(gpt);
+                  if(ossim::isnan(h) == false)
+                  {
+                     gpt.height(h);
+                  }
+               }
+               if(gpt.isHgtNan())
+               {
+                  gpt.height(0.0);
+               }
+               m_groundPoints[i] = gpt;
+            }
+         }
+         m_batch->done();
+      }
+   private:
+      const ossimImageGeometry*            m_prototype;
+      const std::vector<ossimDpt>&         m_imagePoints;
+      std::vector<ossimGpt>&               m_groundPoints;
+      bool                                 m_heightAboveMSLFlag;
+      ossimRefPtr<ossimRpcSolverGridBatch> m_batch;
+   };
+}
+
 ossimRpcSolver::ossimRpcSolver(bool useElevation,
                                bool useHeightAboveMSLFlag)
 {
@@ -70,11 +193,10 @@ void ossimRpcSolver::solveCoefficients(const ossimDrect& imageBounds,
 {
    std::vector<ossimGpt> theGroundPoints;
    std::vector<ossimDpt> theImagePoints;
+   std::vector<ossimDpt> gridPoints;
    ossim_uint32 x,y;
    ossim_float64 w = imageBounds.width();
    ossim_float64 h = imageBounds.height();
-   ossimGpt gpt;
-   ossimGpt defaultGround;
    if(ySamples < 1) ySamples = 12;
    if(xSamples < 1) xSamples = 12;
    srand(time(0));
@@ -110,9 +232,7 @@ void ossimRpcSolver::solveCoefficients(const ossimDrect& imageBounds,
 //                       (.25 + .5*ynorm)*h + ul.y);
          ossimDpt dpt(w*xnorm + ul.x,
                       h*ynorm + ul.y);
-         
-         geom->localToWorld(dpt, gpt);
-         gpt.changeDatum(defaultGround.datum());
+         gridPoints.push_back(dpt);
 
          if(shiftTo0Flag)
          {
@@ -122,21 +242,36 @@ void ossimRpcSolver::solveCoefficients(const ossimDrect& imageBounds,
          {
             theImagePoints.push_back(dpt);
          }
-         if(theHeightAboveMSLFlag)
-         {
-            double h = ossimElevManager::instance()->getHeightAboveMSL(gpt);
-            if(ossim::isnan(h) == false)
-            {
-               gpt.height(h);
-            }
-         }
-         if(gpt.isHgtNan())
-         {
-            gpt.height(0.0);
-         }
-         theGroundPoints.push_back(gpt);
       }
    }
+
+   // Drop the grid to the ground, the projection and DEM lookups being most
+   // of the cost of a fit; a block of points per job pick.
+   theGroundPoints.resize(gridPoints.size());
+   const ossim_uint32 POINTS = static_cast<ossim_uint32>(gridPoints.size());
+   const ossim_uint32 JOBS = ossim::max<ossim_uint32>(
+      1, ossim::min<ossim_uint32>( ossim::getNumberOfThreads(), POINTS / 16 ) );
+   ossimRefPtr<ossimRpcSolverGridBatch> batch = new ossimRpcSolverGridBatch(POINTS, JOBS);
+   std::vector< ossimRefPtr<ossimRpcSolverGridJob> > jobs;
+   for ( ossim_uint32 i = 0; i < JOBS; ++i )
+   {
+      jobs.push_back( new ossimRpcSolverGridJob( geom, gridPoints, theGroundPoints,
+                                                 theHeightAboveMSLFlag, batch.get() ) );
+   }
+   if ( JOBS == 1 )
+   {
+      jobs[0]->start();
+   }
+   else
+   {
+      ossimRefPtr<ossimJobMultiThreadQueue> queue = new ossimJobMultiThreadQueue(0, JOBS);
+      for ( ossim_uint32 i = 0; i < JOBS; ++i )
+      {
+         queue->getJobQueue()->add(jobs[i].get(), false);
+      }
+      batch->wait();
+   }
+
    solveCoefficients(theImagePoints,
                      theGroundPoints);
 }
@@ -519,19 +654,18 @@ void ossimRpcSolver::solveInitialCoefficients(NEWMAT::ColumnVector& coeff,
                                               const std::vector<double>& z)const
 {
    ossim_uint32 idx = 0;
-   NEWMAT::Matrix m;
    NEWMAT::ColumnVector r((int)f.size());
+   NEWMAT::DiagonalMatrix weights((int)f.size());
    for(idx = 0; idx < f.size(); ++idx)
    {
       r[idx] = f[idx];
+      weights[idx] = 1.0;
    }
-   setupSystemOfEquations(m,
-                          r,
-                          x,
-                          y,
-                          z);
-   
-   coeff = invert(m.t()*m)*m.t()*r;
+
+   NEWMAT::SymmetricMatrix normals;
+   NEWMAT::ColumnVector constants;
+   accumulateNormals(normals, constants, weights, r, x, y, z);
+   coeff = invert(normals)*constants;
 }
 
 void ossimRpcSolver::solveCoefficients(NEWMAT::ColumnVector& coeff,
@@ -544,7 +678,9 @@ void ossimRpcSolver::solveCoefficients(NEWMAT::ColumnVector& coeff,
    // a nonlinear fit instead
    //
    ossim_uint32 idx = 0;
-   NEWMAT::Matrix m;
+   NEWMAT::SymmetricMatrix normals;
+   NEWMAT::ColumnVector constants;
+   double row[39];
 
    NEWMAT::ColumnVector r((int)f.size());
 
@@ -566,24 +702,37 @@ void ossimRpcSolver::solveCoefficients(NEWMAT::ColumnVector& coeff,
 
    double residualValue = 1.0/FLT_EPSILON;
    ossim_uint32 iterations = 0;
-   NEWMAT::Matrix w2;
    do
    {
-      w2 = weights*weights;
-
-      // sets up the matrix to hold the system of
-      // equations
-      setupSystemOfEquations(m,
-                             r,
-                             x,
-                             y,
-                             z);
+      // sums the weighted normal equations point by point; the design
+      // matrix and the weight products are never formed
+      accumulateNormals(normals, constants, weights, r, x, y, z);
 
       // solve the least squares solution.  Note: the invert is used
       // to do a Singular Value Decomposition for the inverse since the
       // matrix is more than likely singular.  Slower but more robust
       //
-      tempCoeff = invert(m.t()*w2*m)*m.t()*w2*r;
+      tempCoeff = invert(normals)*constants;
+
+      // compute the residual, m.t()*w2*(m*tempCoeff-r), with the weights
+      // of this solve
+      //
+      NEWMAT::ColumnVector residual(39);
+      residual = 0.0;
+      for(idx = 0; idx < f.size(); ++idx)
+      {
+         setupEquation(row, f[idx], x[idx], y[idx], z[idx]);
+         double e = -f[idx];
+         for(int j = 0; j < 39; ++j)
+         {
+            e += row[j]*tempCoeff[j];
+         }
+         e *= weights[idx]*weights[idx];
+         for(int j = 0; j < 39; ++j)
+         {
+            residual[j] += row[j]*e;
+         }
+      }
 
       // set up the weight matrix by using the denominator
       //
@@ -600,10 +749,6 @@ void ossimRpcSolver::solveCoefficients(NEWMAT::ColumnVector& coeff,
                         y,
                         z);
 
-      // compute the residual
-      //
-      NEWMAT::ColumnVector residual = m.t()*w2*(m*tempCoeff-r);
-
       // now get the innerproduct
       //
       NEWMAT::Matrix tempRes = (residual.t()*residual);
@@ -619,33 +764,11 @@ void ossimRpcSolver::solveCoefficients(NEWMAT::ColumnVector& coeff,
 
 NEWMAT::Matrix ossimRpcSolver::invert(const NEWMAT::Matrix& m)const
 {
-   ossim_uint32 idx = 0;
-   NEWMAT::DiagonalMatrix d;
-   NEWMAT::Matrix u;
-   NEWMAT::Matrix v;
-
-   // decompose m.t*m which is stored in Temp into the singular values and vectors.
-   //
-   NEWMAT::SVD(m, d, u, v, true, true);
-   
-   // invert the diagonal
-   // this is just doing the reciprical fo all diagonal components and store back int
-   // d.  ths compute d inverse.
-   //
-   for(idx=0; idx < (ossim_uint32)d.Ncols(); ++idx)
-   {
-      if(d[idx] > FLT_EPSILON)
-      {
-         d[idx] = 1.0/d[idx];
-      }
-      else
-      {
-         d[idx] = 0.0;
-      }
-   }
-
-   //compute inverse of decomposed m;
-   return v*d*u.t();
+   // Pseudo inverse from the singular value decomposition; values at or
+   // below FLT_EPSILON are taken as zero.
+   NEWMAT::Matrix result;
+   ossimLinearAlgebra::pseudoInverse(m, FLT_EPSILON, result);
+   return result;
 }
 
 
@@ -661,45 +784,81 @@ void ossimRpcSolver::setupSystemOfEquations(NEWMAT::Matrix& equations,
    
    for(idx = 0; idx < (ossim_uint32)f.Nrows();++idx)
    {
-      equations[idx][0]  = 1;
-      equations[idx][1]  = x[idx];
-      equations[idx][2]  = y[idx];
-      equations[idx][3]  = z[idx];
-      equations[idx][4]  = x[idx]*y[idx];
-      equations[idx][5]  = x[idx]*z[idx];
-      equations[idx][6]  = y[idx]*z[idx];
-      equations[idx][7]  = x[idx]*x[idx];
-      equations[idx][8]  = y[idx]*y[idx];
-      equations[idx][9]  = z[idx]*z[idx];
-      equations[idx][10] = x[idx]*y[idx]*z[idx];
-      equations[idx][11] = x[idx]*x[idx]*x[idx];
-      equations[idx][12] = x[idx]*y[idx]*y[idx];
-      equations[idx][13] = x[idx]*z[idx]*z[idx];
-      equations[idx][14] = x[idx]*x[idx]*y[idx];
-      equations[idx][15] = y[idx]*y[idx]*y[idx];
-      equations[idx][16] = y[idx]*z[idx]*z[idx];
-      equations[idx][17] = x[idx]*x[idx]*z[idx];
-      equations[idx][18] = y[idx]*y[idx]*z[idx];
-      equations[idx][19] = z[idx]*z[idx]*z[idx];
-      equations[idx][20] = -f[idx]*x[idx];
-      equations[idx][21] = -f[idx]*y[idx];
-      equations[idx][22] = -f[idx]*z[idx];
-      equations[idx][23] = -f[idx]*x[idx]*y[idx];
-      equations[idx][24] = -f[idx]*x[idx]*z[idx];
-      equations[idx][25] = -f[idx]*y[idx]*z[idx];
-      equations[idx][26] = -f[idx]*x[idx]*x[idx];
-      equations[idx][27] = -f[idx]*y[idx]*y[idx];
-      equations[idx][28] = -f[idx]*z[idx]*z[idx];
-      equations[idx][29] = -f[idx]*x[idx]*y[idx]*z[idx];
-      equations[idx][30] = -f[idx]*x[idx]*x[idx]*x[idx];
-      equations[idx][31] = -f[idx]*x[idx]*y[idx]*y[idx];
-      equations[idx][32] = -f[idx]*x[idx]*z[idx]*z[idx];
-      equations[idx][33] = -f[idx]*x[idx]*x[idx]*y[idx];
-      equations[idx][34] = -f[idx]*y[idx]*y[idx]*y[idx];
-      equations[idx][35] = -f[idx]*y[idx]*z[idx]*z[idx];
-      equations[idx][36] = -f[idx]*x[idx]*x[idx]*z[idx];
-      equations[idx][37] = -f[idx]*y[idx]*y[idx]*z[idx];
-      equations[idx][38] = -f[idx]*z[idx]*z[idx]*z[idx];
+      setupEquation(equations[idx], f[idx], x[idx], y[idx], z[idx]);
+   }
+}
+
+void ossimRpcSolver::accumulateNormals(NEWMAT::SymmetricMatrix& normals,
+                                       NEWMAT::ColumnVector& constants,
+                                       const NEWMAT::DiagonalMatrix& weights,
+                                       const NEWMAT::ColumnVector& f,
+                                       const std::vector<double>& x,
+                                       const std::vector<double>& y,
+                                       const std::vector<double>& z)const
+{
+   normals.ReSize(39);
+   constants.ReSize(39);
+   normals   = 0.0;
+   constants = 0.0;
+
+   // SymmetricMatrix keeps the lower triangle by rows.
+   double* n = normals.Store();
+   double row[39];
+   double wrow[39];
+   for(ossim_uint32 idx = 0; idx < (ossim_uint32)f.Nrows(); ++idx)
+   {
+      setupEquation(row, f[idx], x[idx], y[idx], z[idx]);
+      const double W2 = weights[idx]*weights[idx];
+      for(int i = 0; i < 39; ++i)
+      {
+         wrow[i] = W2*row[i];
+      }
+      double* ni = n;
+      for(int i = 0; i < 39; ++i)
+      {
+         const double WI = wrow[i];
+         for(int j = 0; j <= i; ++j)
+         {
+            ni[j] += WI*row[j];
+         }
+         ni += i + 1;
+         constants[i] += WI*f[idx];
+      }
+   }
+}
+
+void ossimRpcSolver::setupEquation(double* equation,
+                                   double f,
+                                   double x,
+                                   double y,
+                                   double z)
+{
+   double* e = equation;
+   e[0]  = 1;
+   e[1]  = x;
+   e[2]  = y;
+   e[3]  = z;
+   e[4]  = x*y;
+   e[5]  = x*z;
+   e[6]  = y*z;
+   e[7]  = x*x;
+   e[8]  = y*y;
+   e[9]  = z*z;
+   e[10] = x*y*z;
+   e[11] = x*x*x;
+   e[12] = x*y*y;
+   e[13] = x*z*z;
+   e[14] = x*x*y;
+   e[15] = y*y*y;
+   e[16] = y*z*z;
+   e[17] = x*x*z;
+   e[18] = y*y*z;
+   e[19] = z*z*z;
+
+   // denominator terms, less the constant fixed at 1.0
+   for(int i = 1; i < 20; ++i)
+   {
+      e[19+i] = -f*e[i];
    }
 }
 
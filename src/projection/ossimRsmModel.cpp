@@ -20,6 +20,7 @@
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimSimd.h>
 #include <ossim/base/ossimTrace.h>
 #include <ossim/elevation/ossimElevManager.h>
 #include <ossim/elevation/ossimHgtRef.h>
@@ -30,6 +31,10 @@
 #include <iostream>
 #include <sstream>
 
+#if OSSIM_SIMD_X86
+#  include <immintrin.h>
+#endif
+
 RTTI_DEF1(ossimRsmModel, "ossimRsmModel", ossimSensorModel);
 
 // Define Trace flags for use within this file:
@@ -38,6 +43,305 @@ static const ossimTrace traceDebug ("ossimRsmModel:debug");
 
 static std::string MODEL_TYPE_KW  = "ossimRsmModel";
 
+//---
+// Batch polynomial evaluation for worldToLineSamples() and lineSampleToWorlds().
+//
+// The four polynomials of a section are laid over one table of monomials
+// x^i * y^j * z^k, i < nx, j < ny, k < nz (the largest powers of the four
+// plus one), in the RSMPCA term order (x fastest, then y, then z). Terms a
+// polynomial does not have get a zero coefficient. Every path forms the
+// monomials and sums the terms in the same order, so they agree bit for bit
+// with each other. RSMPCA powers are at most 5.
+//---
+static const int RSM_BLOCK     = 64;
+static const int RSM_MAX_POWER = 6;
+static const int RSM_MAX_TERMS = RSM_MAX_POWER * RSM_MAX_POWER * RSM_MAX_POWER;
+
+namespace
+{
+   struct RsmPolyTable
+   {
+      int    nx;
+      int    ny;
+      int    nz;
+      int    terms;
+      double c[4][RSM_MAX_TERMS]; // row num, row den, col num, col den
+   };
+
+   void addRsmPoly(RsmPolyTable& t, int p, ossim_uint32 px, ossim_uint32 py, ossim_uint32 pz,
+                   const std::vector<double>& pcf)
+   {
+      ossim_uint32 index = 0;
+      for (ossim_uint32 k = 0; k <= pz; ++k)
+      {
+         for (ossim_uint32 j = 0; j <= py; ++j)
+         {
+            for (ossim_uint32 i = 0; i <= px; ++i)
+            {
+               if (index < pcf.size())
+               {
+                  t.c[p][(k*t.ny + j)*t.nx + i] = pcf[index];
+               }
+               ++index;
+            }
+         }
+      }
+   }
+
+   // false if the section's powers do not fit the table.
+   bool makeRsmPolyTable(const ossimRsmpca& pca, RsmPolyTable& t)
+   {
+      t.nx = 1 + (int)std::max(std::max(pca.m_rnpwrx, pca.m_rdpwrx),
+                               std::max(pca.m_cnpwrx, pca.m_cdpwrx));
+      t.ny = 1 + (int)std::max(std::max(pca.m_rnpwry, pca.m_rdpwry),
+                               std::max(pca.m_cnpwry, pca.m_cdpwry));
+      t.nz = 1 + (int)std::max(std::max(pca.m_rnpwrz, pca.m_rdpwrz),
+                               std::max(pca.m_cnpwrz, pca.m_cdpwrz));
+      if ( (t.nx > RSM_MAX_POWER) || (t.ny > RSM_MAX_POWER) || (t.nz > RSM_MAX_POWER) )
+      {
+         return false;
+      }
+      t.terms = t.nx * t.ny * t.nz;
+      for (int p = 0; p < 4; ++p)
+      {
+         std::fill(t.c[p], t.c[p] + t.terms, 0.0);
+      }
+      addRsmPoly(t, 0, pca.m_rnpwrx, pca.m_rnpwry, pca.m_rnpwrz, pca.m_rnpcf);
+      addRsmPoly(t, 1, pca.m_rdpwrx, pca.m_rdpwry, pca.m_rdpwrz, pca.m_rdpcf);
+      addRsmPoly(t, 2, pca.m_cnpwrx, pca.m_cnpwry, pca.m_cnpwrz, pca.m_cnpcf);
+      addRsmPoly(t, 3, pca.m_cdpwrx, pca.m_cdpwry, pca.m_cdpwrz, pca.m_cdpcf);
+      return true;
+   }
+
+   // r[i] = row num / row den, c[i] = col num / col den at normalized X, Y, Z.
+   void rsmRatiosScalar(const double* X, const double* Y, const double* Z, int n,
+                        const RsmPolyTable& t, double* r, double* c)
+   {
+      for (int i = 0; i < n; ++i)
+      {
+         double xp[RSM_MAX_POWER];
+         double yp[RSM_MAX_POWER];
+         double zp[RSM_MAX_POWER];
+         xp[0] = yp[0] = zp[0] = 1.0;
+         for (int a = 1; a < t.nx; ++a) xp[a] = xp[a-1]*X[i];
+         for (int a = 1; a < t.ny; ++a) yp[a] = yp[a-1]*Y[i];
+         for (int a = 1; a < t.nz; ++a) zp[a] = zp[a-1]*Z[i];
+
+         double acc[4] = { 0.0, 0.0, 0.0, 0.0 };
+         int index = 0;
+         for (int k = 0; k < t.nz; ++k)
+         {
+            for (int j = 0; j < t.ny; ++j)
+            {
+               const double yz = yp[j]*zp[k];
+               for (int a = 0; a < t.nx; ++a)
+               {
+                  const double m = xp[a]*yz;
+                  acc[0] = acc[0] + t.c[0][index]*m;
+                  acc[1] = acc[1] + t.c[1][index]*m;
+                  acc[2] = acc[2] + t.c[2][index]*m;
+                  acc[3] = acc[3] + t.c[3][index]*m;
+                  ++index;
+               }
+            }
+         }
+         r[i] = acc[0] / acc[1];
+         c[i] = acc[2] / acc[3];
+      }
+   }
+
+#if OSSIM_SIMD_X86
+   OSSIM_SIMD_TARGET("sse2")
+   void rsmRatiosSse2(const double* X, const double* Y, const double* Z, int n,
+                      const RsmPolyTable& t, double* r, double* c)
+   {
+      int i = 0;
+      for (; i + 2 <= n; i += 2)
+      {
+         __m128d xp[RSM_MAX_POWER];
+         __m128d yp[RSM_MAX_POWER];
+         __m128d zp[RSM_MAX_POWER];
+         xp[0] = yp[0] = zp[0] = _mm_set1_pd(1.0);
+         const __m128d x = _mm_loadu_pd(X + i);
+         const __m128d y = _mm_loadu_pd(Y + i);
+         const __m128d z = _mm_loadu_pd(Z + i);
+         for (int a = 1; a < t.nx; ++a) xp[a] = _mm_mul_pd(xp[a-1], x);
+         for (int a = 1; a < t.ny; ++a) yp[a] = _mm_mul_pd(yp[a-1], y);
+         for (int a = 1; a < t.nz; ++a) zp[a] = _mm_mul_pd(zp[a-1], z);
+
+         __m128d acc[4];
+         acc[0] = acc[1] = acc[2] = acc[3] = _mm_setzero_pd();
+         int index = 0;
+         for (int k = 0; k < t.nz; ++k)
+         {
+            for (int j = 0; j < t.ny; ++j)
+            {
+               const __m128d yz = _mm_mul_pd(yp[j], zp[k]);
+               for (int a = 0; a < t.nx; ++a)
+               {
+                  const __m128d m = _mm_mul_pd(xp[a], yz);
+                  acc[0] = _mm_add_pd(acc[0], _mm_mul_pd(_mm_set1_pd(t.c[0][index]), m));
+                  acc[1] = _mm_add_pd(acc[1], _mm_mul_pd(_mm_set1_pd(t.c[1][index]), m));
+                  acc[2] = _mm_add_pd(acc[2], _mm_mul_pd(_mm_set1_pd(t.c[2][index]), m));
+                  acc[3] = _mm_add_pd(acc[3], _mm_mul_pd(_mm_set1_pd(t.c[3][index]), m));
+                  ++index;
+               }
+            }
+         }
+         _mm_storeu_pd(r + i, _mm_div_pd(acc[0], acc[1]));
+         _mm_storeu_pd(c + i, _mm_div_pd(acc[2], acc[3]));
+      }
+      rsmRatiosScalar(X + i, Y + i, Z + i, n - i, t, r + i, c + i);
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   void rsmRatiosAvx2(const double* X, const double* Y, const double* Z, int n,
+                      const RsmPolyTable& t, double* r, double* c)
+   {
+      int i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+         __m256d xp[RSM_MAX_POWER];
+         __m256d yp[RSM_MAX_POWER];
+         __m256d zp[RSM_MAX_POWER];
+         xp[0] = yp[0] = zp[0] = _mm256_set1_pd(1.0);
+         const __m256d x = _mm256_loadu_pd(X + i);
+         const __m256d y = _mm256_loadu_pd(Y + i);
+         const __m256d z = _mm256_loadu_pd(Z + i);
+         for (int a = 1; a < t.nx; ++a) xp[a] = _mm256_mul_pd(xp[a-1], x);
+         for (int a = 1; a < t.ny; ++a) yp[a] = _mm256_mul_pd(yp[a-1], y);
+         for (int a = 1; a < t.nz; ++a) zp[a] = _mm256_mul_pd(zp[a-1], z);
+
+         __m256d acc[4];
+         acc[0] = acc[1] = acc[2] = acc[3] = _mm256_setzero_pd();
+         int index = 0;
+         for (int k = 0; k < t.nz; ++k)
+         {
+            for (int j = 0; j < t.ny; ++j)
+            {
+               const __m256d yz = _mm256_mul_pd(yp[j], zp[k]);
+               for (int a = 0; a < t.nx; ++a)
+               {
+                  const __m256d m = _mm256_mul_pd(xp[a], yz);
+                  acc[0] = _mm256_add_pd(acc[0], _mm256_mul_pd(_mm256_set1_pd(t.c[0][index]), m));
+                  acc[1] = _mm256_add_pd(acc[1], _mm256_mul_pd(_mm256_set1_pd(t.c[1][index]), m));
+                  acc[2] = _mm256_add_pd(acc[2], _mm256_mul_pd(_mm256_set1_pd(t.c[2][index]), m));
+                  acc[3] = _mm256_add_pd(acc[3], _mm256_mul_pd(_mm256_set1_pd(t.c[3][index]), m));
+                  ++index;
+               }
+            }
+         }
+         _mm256_storeu_pd(r + i, _mm256_div_pd(acc[0], acc[1]));
+         _mm256_storeu_pd(c + i, _mm256_div_pd(acc[2], acc[3]));
+      }
+      rsmRatiosSse2(X + i, Y + i, Z + i, n - i, t, r + i, c + i);
+   }
+#endif
+
+   void rsmRatios(const double* X, const double* Y, const double* Z, int n,
+                  const RsmPolyTable& t, double* r, double* c)
+   {
+#if OSSIM_SIMD_X86
+      const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+      if (LEVEL >= ossim::SIMD_AVX2)
+      {
+         rsmRatiosAvx2(X, Y, Z, n, t, r, c);
+         return;
+      }
+      if (LEVEL >= ossim::SIMD_SSE2)
+      {
+         rsmRatiosSse2(X, Y, Z, n, t, r, c);
+         return;
+      }
+#endif
+      rsmRatiosScalar(X, Y, Z, n, t, r, c);
+   }
+
+   //---
+   // Values and lat (y), lon (x) partials of the four polynomials at one
+   // normalized point, from one table of powers.
+   //---
+   void rsmPartials(const RsmPolyTable& t, double x, double y, double z,
+                    double* val, double* dLat, double* dLon)
+   {
+      double xp[RSM_MAX_POWER];
+      double yp[RSM_MAX_POWER];
+      double zp[RSM_MAX_POWER];
+      xp[0] = yp[0] = zp[0] = 1.0;
+      for (int a = 1; a < t.nx; ++a) xp[a] = xp[a-1]*x;
+      for (int a = 1; a < t.ny; ++a) yp[a] = yp[a-1]*y;
+      for (int a = 1; a < t.nz; ++a) zp[a] = zp[a-1]*z;
+
+      for (int p = 0; p < 4; ++p)
+      {
+         val[p] = dLat[p] = dLon[p] = 0.0;
+      }
+      int index = 0;
+      for (int k = 0; k < t.nz; ++k)
+      {
+         for (int j = 0; j < t.ny; ++j)
+         {
+            const double yz  = yp[j]*zp[k];
+            const double dyz = j ? j*yp[j-1]*zp[k] : 0.0;
+            for (int a = 0; a < t.nx; ++a)
+            {
+               const double m  = xp[a]*yz;
+               const double my = xp[a]*dyz;
+               const double mx = a ? a*xp[a-1]*yz : 0.0;
+               for (int p = 0; p < 4; ++p)
+               {
+                  val[p]  += t.c[p][index]*m;
+                  dLat[p] += t.c[p][index]*my;
+                  dLon[p] += t.c[p][index]*mx;
+               }
+               ++index;
+            }
+         }
+      }
+   }
+
+   //---
+   // lineSampleHeightToWorld() iteration for normalized image point U, V at
+   // normalized height nhgt. Returns false if it did not converge.
+   //---
+   bool rsmSolveGround(const RsmPolyTable& t, double U, double V, double nhgt,
+                       double epsilonU, double epsilonV, double& nlat, double& nlon)
+   {
+      static const int MAX_NUM_ITERATIONS = 100;
+      nlat = 0.0;
+      nlon = 0.0;
+      double val[4];
+      double dLat[4];
+      double dLon[4];
+      double deltaU;
+      double deltaV;
+      int iteration = 0;
+      do
+      {
+         rsmPartials(t, nlon, nlat, nhgt, val, dLat, dLon);
+         const double Pu = val[0];
+         const double Qu = val[1];
+         const double Pv = val[2];
+         const double Qv = val[3];
+         deltaU = U - Pu/Qu;
+         deltaV = V - Pv/Qv;
+         if ((fabs(deltaU) > epsilonU) || (fabs(deltaV) > epsilonV))
+         {
+            const double dU_dLat = (Qu*dLat[0] - Pu*dLat[1])/(Qu*Qu);
+            const double dU_dLon = (Qu*dLon[0] - Pu*dLon[1])/(Qu*Qu);
+            const double dV_dLat = (Qv*dLat[2] - Pv*dLat[3])/(Qv*Qv);
+            const double dV_dLon = (Qv*dLon[2] - Pv*dLon[3])/(Qv*Qv);
+            const double W = dU_dLon*dV_dLat - dU_dLat*dV_dLon;
+            nlat += (dU_dLon*deltaV - dV_dLon*deltaU) / W;
+            nlon += (dV_dLat*deltaU - dU_dLat*deltaV) / W;
+         }
+         ++iteration;
+      } while (((fabs(deltaU)>epsilonU) || (fabs(deltaV)>epsilonV))
+               && (iteration < MAX_NUM_ITERATIONS));
+      return iteration < MAX_NUM_ITERATIONS;
+   }
+}
+
 ossimRsmModel::ossimRsmModel()
    :
    ossimSensorModel(),
@@ -159,6 +463,117 @@ void ossimRsmModel::worldToLineSample(const ossimGpt& ground_point,
 
 } // End: ossimRsmModel::worldToLineSample( ... )
 
+//---
+//  METHOD: ossimRsmModel::worldToLineSamples()
+//  
+//  Overrides base class implementation. Finds the section of each point of
+//  a block, then normalizes and evaluates each run of points in one section
+//  together.
+//---
+void ossimRsmModel::worldToLineSamples(const ossimGpt* world_points,
+                                       ossimDpt*       image_points,
+                                       ossim_uint32    count) const
+{
+   if ( m_pca.empty() )
+   {
+      ossimSensorModel::worldToLineSamples(world_points, image_points, count);
+      return;
+   }
+
+   RsmPolyTable table;
+   ossim_uint32 tableIndex = (ossim_uint32)m_pca.size(); // none yet
+   bool tableValid = false;
+
+   ossim_uint32 S[RSM_BLOCK];
+   double X[RSM_BLOCK];
+   double Y[RSM_BLOCK];
+   double Z[RSM_BLOCK];
+   double R[RSM_BLOCK];
+   double C[RSM_BLOCK];
+
+   for (ossim_uint32 start = 0; start < count; start += RSM_BLOCK)
+   {
+      const int N = (int)std::min((ossim_uint32)RSM_BLOCK, count - start);
+      const ossimGpt* gpts = world_points + start;
+      ossimDpt* ipts = image_points + start;
+
+      // Ground domain coordinates and section of each point (see worldToLineSample):
+      for (int i = 0; i < N; ++i)
+      {
+         if ( gpts[i].isLatNan() || gpts[i].isLonNan() )
+         {
+            // Keep the run going; the result is set to nan below.
+            S[i] = i ? S[i-1] : 0;
+            X[i] = Y[i] = Z[i] = 0.0;
+            continue;
+         }
+         if ( m_ida.m_grndd == 'H' )
+         {
+            X[i] = ossim::degreesToRadians((gpts[i].lon >= 0.0) ?
+                                           gpts[i].lon : gpts[i].lon + 360.0);
+         }
+         else
+         {
+            X[i] = ossim::degreesToRadians( gpts[i].lon );
+         }
+         Y[i] = ossim::degreesToRadians( gpts[i].lat );
+         Z[i] = gpts[i].isHgtNan() ? 0.0 : gpts[i].hgt;
+         S[i] = (m_pca.size() == 1) ? 0 : getPcaIndex( X[i], Y[i], Z[i] );
+      }
+
+      int runStart = 0;
+      while ( runStart < N )
+      {
+         int runEnd = runStart + 1;
+         while ( (runEnd < N) && (S[runEnd] == S[runStart]) )
+         {
+            ++runEnd;
+         }
+         const ossimRsmpca& pca = m_pca[ S[runStart] ];
+         if ( S[runStart] != tableIndex )
+         {
+            tableIndex = S[runStart];
+            tableValid = makeRsmPolyTable( pca, table );
+         }
+
+         if ( tableValid )
+         {
+            for (int i = runStart; i < runEnd; ++i)
+            {
+               X[i] = (X[i] - pca.m_xnrmo) / pca.m_xnrmsf;
+               Y[i] = (Y[i] - pca.m_ynrmo) / pca.m_ynrmsf;
+               Z[i] = (Z[i] - pca.m_znrmo) / pca.m_znrmsf;
+            }
+            rsmRatios(X + runStart, Y + runStart, Z + runStart, runEnd - runStart,
+                      table, R + runStart, C + runStart);
+            for (int i = runStart; i < runEnd; ++i)
+            {
+               // RSM (0,0) is upper left corner of pixel(0,0); hence, the - 0.5.
+               ipts[i].line = (R[i] * pca.m_rnrmsf) + pca.m_rnrmo - 0.5; 
+               ipts[i].samp = (C[i] * pca.m_cnrmsf) + pca.m_cnrmo - 0.5; 
+            }
+         }
+         else
+         {
+            for (int i = runStart; i < runEnd; ++i)
+            {
+               worldToLineSample( gpts[i], ipts[i] );
+            }
+         }
+         runStart = runEnd;
+      }
+
+      for (int i = 0; i < N; ++i)
+      {
+         if ( gpts[i].isLatNan() || gpts[i].isLonNan() )
+         {
+            ipts[i].makeNan();
+         }
+      }
+   }
+   
+} // End: ossimRsmModel::worldToLineSamples( ... )
+
 //---
 //  METHOD: ossimRsmModel::lineSampleToWorld()
 //  
@@ -186,6 +601,96 @@ void  ossimRsmModel::lineSampleToWorld(const ossimDpt& imagePoint,
    }
 }
 
+//---
+//  METHOD: ossimRsmModel::lineSampleToWorlds()
+//  
+//  Overrides base class implementation. Same rays as lineSampleToWorld();
+//  the DEM intersections are warm started from the previous point.
+//---
+void ossimRsmModel::lineSampleToWorlds(const ossimDpt* image_points,
+                                       ossimGpt*       world_points,
+                                       ossim_uint32    count) const
+{
+   if ( m_pca.empty() )
+   {
+      ossimSensorModel::lineSampleToWorlds(image_points, world_points, count);
+      return;
+   }
+
+   static const double CONVERGENCE_EPSILON = 0.05;  // pixels, as lineSampleHeightToWorld
+
+   RsmPolyTable table;
+   ossim_uint32 tableIndex = (ossim_uint32)m_pca.size(); // none yet
+   bool tableValid = false;
+   bool converged = true;
+   double startHeight = count ? getHeightHint(image_points[0]) : ossim::nan();
+
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      if ( image_points[i].hasNans() )
+      {
+         world_points[i].makeNan();
+         continue;
+      }
+
+      // Point given to imagingRay by lineSampleToWorld:
+      const ossimDpt rayPt(image_points[i].x+0.5, image_points[i].y+0.5);
+      const ossim_uint32 pcaIndex = getPcaIndex( rayPt, true );
+      const ossimRsmpca& pca = m_pca[pcaIndex];
+      if ( pcaIndex != tableIndex )
+      {
+         tableIndex = pcaIndex;
+         tableValid = makeRsmPolyTable( pca, table );
+      }
+
+      ossimEcefRay ray;
+      if ( tableValid )
+      {
+         const double U = (rayPt.y+0.5-pca.m_rnrmo) / (pca.m_rnrmsf);
+         const double V = (rayPt.x+0.5-pca.m_cnrmo) / (pca.m_cnrmsf);
+         const double EPSILON_U = CONVERGENCE_EPSILON/pca.m_rnrmsf;
+         const double EPSILON_V = CONVERGENCE_EPSILON/pca.m_cnrmsf;
+
+         // "from" point above, "to" point at the height offset (see imagingRay):
+         const double HEIGHTS[2] = { pca.m_znrmo + pca.m_znrmsf * 2.0, pca.m_znrmo };
+         ossimEcefPoint ends[2];
+         for (int e = 0; e < 2; ++e)
+         {
+            const double nhgt = (HEIGHTS[e] - pca.m_znrmo) / pca.m_znrmsf;
+            double nlat;
+            double nlon;
+            converged &= rsmSolveGround(table, U, V, nhgt, EPSILON_U, EPSILON_V, nlat, nlon);
+            ossimGpt gpt;
+            gpt.lat = ossim::radiansToDegrees(nlat*pca.m_ynrmsf + pca.m_ynrmo);
+            gpt.lon = ossim::radiansToDegrees(nlon*pca.m_xnrmsf + pca.m_xnrmo);
+            gpt.hgt = (nhgt * pca.m_znrmsf) + pca.m_znrmo;
+            gpt.wrap();
+            ends[e] = ossimEcefPoint(gpt);
+         }
+         ray = ossimEcefRay(ends[0], ends[1]);
+      }
+      else
+      {
+         imagingRay( rayPt, ray );
+      }
+
+      ossimElevManager::instance()->intersectRayFromHeight(ray, startHeight, world_points[i]);
+      if ( !world_points[i].isHgtNan() )
+      {
+         startHeight = world_points[i].hgt;
+         setHeightHint(image_points[i], startHeight);
+      }
+   }
+
+   if ( !converged )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "WARNING ossimRsmModel::lineSampleToWorlds:\n"
+         << "Max number of iterations reached in ground point "
+         << "solution. Results are inaccurate." << endl;
+   }
+}
+
 //---
 //  METHOD: ossimRsmModel::lineSampleHeightToWorld()
 //  
@@ -573,7 +1078,7 @@ void ossimRsmModel::lowOrderPolynomial(
 
 double ossimRsmModel::polynomial(
    const double& x, const double& y, const double& z, const ossim_uint32& maxx,
-   const ossim_uint32& maxy, const ossim_uint32& maxz, std::vector<double> pcf) const
+   const ossim_uint32& maxy, const ossim_uint32& maxz, const std::vector<double>& pcf) const
 {
    double r = 0.0;
    ossim_uint32 index = 0;
@@ -593,7 +1098,7 @@ double ossimRsmModel::polynomial(
 
 double ossimRsmModel::dPoly_dLat(
    const double& x, const double& y, const double& z, const ossim_uint32& maxx,
-   const ossim_uint32& maxy, const ossim_uint32& maxz, std::vector<double> pcf) const
+   const ossim_uint32& maxy, const ossim_uint32& maxz, const std::vector<double>& pcf) const
                                  
 {
    double dr = 0.0;
@@ -617,7 +1122,7 @@ double ossimRsmModel::dPoly_dLat(
 
 double ossimRsmModel::dPoly_dLon(
    const double& x, const double& y, const double& z, const ossim_uint32& maxx,
-   const ossim_uint32& maxy, const ossim_uint32& maxz, std::vector<double> pcf) const
+   const ossim_uint32& maxy, const ossim_uint32& maxz, const std::vector<double>& pcf) const
 {
    double dr = 0.0;
    ossim_uint32 index = 0;
@@ -641,7 +1146,7 @@ double ossimRsmModel::dPoly_dLon(
 
 double ossimRsmModel::dPoly_dHgt(
    const double& x, const double& y, const double& z, const ossim_uint32& maxx,
-   const ossim_uint32& maxy, const ossim_uint32& maxz, std::vector<double> pcf) const
+   const ossim_uint32& maxy, const ossim_uint32& maxz, const std::vector<double>& pcf) const
 {
    double dr = 0.0;
    ossim_uint32 index = 0;
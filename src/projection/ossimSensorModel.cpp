@@ -30,6 +30,8 @@
 //  $Id: ossimSensorModel.cpp 23564 2015-10-02 14:12:25Z dburken $
 #include <iostream>
 #include <sstream>
+#include <cstring>
+#include <cmath>
 using namespace std;
 
 // #include <stdio.h>
@@ -46,9 +48,16 @@ RTTI_DEF3(ossimSensorModel, "ossimSensorModel", ossimProjection, ossimOptimizabl
 #include <ossim/base/ossimException.h>
 #include <ossim/base/ossimNotifyContext.h>
 #include <ossim/base/ossimDatumFactory.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimLinearAlgebra.h>
 
 #include <ossim/elevation/ossimElevManager.h>
 #include <ossim/base/ossimTieGptSet.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <OpenThreads/Block>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
 
 #include <ossim/matrix/newmatrc.h>
 
@@ -69,6 +78,177 @@ static const char*       SENSOR_ID_KW        = "sensor";
 static const ossimString NULL_STRING         = "NULL";
 static const double      RAY_ORIGIN_HEIGHT   = 10000.0; //meters
 
+//***
+// Height hints for sensor_model.coherent_intersection: one per
+// HINT_GRID x HINT_GRID pixel node, in a direct mapped table.
+//***
+static const double       HINT_GRID  = 32.0; // pixels
+
+namespace
+{
+   //---
+   // Hands out jacobian columns (adjustable parameters) to the jobs and
+   // releases the caller once the last job is done.
+   //---
+   class ossimSensorModelJacobianBatch : public ossimReferenced
+   {
+   public:
+      ossimSensorModelJacobianBatch(ossim_uint32 items, ossim_uint32 jobs)
+         : m_next(0),
+           m_items(items),
+           m_jobs(jobs)
+      {
+         if(m_jobs)
+         {
+            m_block.reset();
+         }
+         else
+         {
+            m_block.release();
+         }
+      }
+      bool next(ossim_uint32& item)
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if ( m_next >= m_items )
+         {
+            return false;
+         }
+         item = m_next++;
+         return true;
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_jobs && (--m_jobs == 0))
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+   private:
+      OpenThreads::Mutex m_mutex;
+      OpenThreads::Block m_block;
+      ossim_uint32       m_next;
+      ossim_uint32       m_items;
+      ossim_uint32       m_jobs;
+   };
+
+   //---
+   // Centered difference column parmIdx of the jacobian: all tie points are
+   // projected with the parameter high, then low, so the model is updated
+   // twice for the whole column.  Scaling matches getInverseDeriv().
+   //---
+   void computeJacobianColumn(ossimSensorModel* model,
+                              const std::vector< ossimRefPtr<ossimTieGpt> >& tiePoints,
+                              bool useImageObs,
+                              int parmIdx,
+                              double hdelta,
+                              NEWMAT::Matrix& jacobian)
+   {
+      const double den = 0.5/hdelta;
+      const ossim_uint32 N = (ossim_uint32)tiePoints.size();
+      const double middle = model->getAdjustableParameter(parmIdx);
+
+      if (useImageObs)
+      {
+         std::vector<ossimDpt> high(N);
+         model->setAdjustableParameter(parmIdx, middle + hdelta, true);
+         for (ossim_uint32 i = 0; i < N; ++i)
+         {
+            high[i] = model->forward(*(tiePoints[i]));
+         }
+         model->setAdjustableParameter(parmIdx, middle - hdelta, true);
+         for (ossim_uint32 i = 0; i < N; ++i)
+         {
+            ossimDpt d = (high[i] - model->forward(*(tiePoints[i]))) * den;
+            jacobian[2*i  ][parmIdx] = d.x;
+            jacobian[2*i+1][parmIdx] = d.y;
+         }
+      }
+      else
+      {
+         std::vector<ossimGpt> high(N);
+         model->setAdjustableParameter(parmIdx, middle + hdelta, true);
+         for (ossim_uint32 i = 0; i < N; ++i)
+         {
+            high[i] = model->inverse(tiePoints[i]->tie);
+         }
+         model->setAdjustableParameter(parmIdx, middle - hdelta, true);
+         for (ossim_uint32 i = 0; i < N; ++i)
+         {
+            ossimGpt gd = model->inverse(tiePoints[i]->tie);
+            jacobian[3*i  ][parmIdx] = den*(high[i].lon - gd.lon) * 100000.0;
+            jacobian[3*i+1][parmIdx] = den*(high[i].lat - gd.lat) * 100000.0 *
+                                       cos(gd.lat / 180.0 * M_PI);
+            jacobian[3*i+2][parmIdx] = den*(high[i].hgt - gd.hgt);
+         }
+      }
+
+      model->setAdjustableParameter(parmIdx, middle, true);
+   }
+
+   //---
+   // Computes jacobian columns until the batch runs out, on a model of its
+   // own since perturbing a parameter changes the model state.
+   //---
+   class ossimSensorModelJacobianJob : public ossimJob
+   {
+   public:
+      ossimSensorModelJacobianJob(ossimSensorModel* model,
+                                  const std::vector< ossimRefPtr<ossimTieGpt> >& tiePoints,
+                                  bool useImageObs,
+                                  double hdelta,
+                                  NEWMAT::Matrix& jacobian,
+                                  ossimSensorModelJacobianBatch* batch)
+         : m_model(model),
+           m_tiePoints(tiePoints),
+           m_useImageObs(useImageObs),
+           m_hdelta(hdelta),
+           m_jacobian(jacobian),
+           m_batch(batch)
+      {
+         setName("ossimSensorModel.jacobian");
+      }
+      virtual void start()
+      {
+         ossim_uint32 parmIdx;
+         while ( m_batch->next(parmIdx) )
+         {
+            computeJacobianColumn(m_model.get(), m_tiePoints, m_useImageObs,
+                                  (int)parmIdx, m_hdelta, m_jacobian);
+         }
+         m_batch->done();
+      }
+   private:
+      ossimRefPtr<ossimSensorModel>                   m_model;
+      const std::vector< ossimRefPtr<ossimTieGpt> >&  m_tiePoints;
+      bool                                            m_useImageObs;
+      double                                          m_hdelta;
+      NEWMAT::Matrix&                                 m_jacobian;
+      ossimRefPtr<ossimSensorModelJacobianBatch>      m_batch;
+   };
+}
+static const ossim_uint32 HINT_SLOTS = 4096;
+static const ossim_uint64 NO_HINT    = 0x7fc00000; // Key 0, nan height.
+
+static ossim_uint32 heightHintSlots()
+{
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("sensor_model.coherent_intersection");
+   return ( lookup && ossimString(lookup).toBool() ) ? HINT_SLOTS : 0;
+}
+
+static ossim_uint32 heightHintKey(const ossimDpt& image_point)
+{
+   ossim_int32 r = (ossim_int32)std::floor(image_point.y / HINT_GRID + 0.5);
+   ossim_int32 c = (ossim_int32)std::floor(image_point.x / HINT_GRID + 0.5);
+   return ( ((ossim_uint32)r & 0xffff) << 16 ) | ( (ossim_uint32)c & 0xffff );
+}
+
 
 //DEBUG TBR : output ops
 std::ostream& operator<<(std::ostream& os, NEWMAT::GeneralMatrix& mat)
@@ -116,7 +296,8 @@ ossimSensorModel::ossimSensorModel()
    theObs              (0.0, 0.0),
    theResid            (0.0, 0.0),
    theExtrapolateImageFlag(false),
-   theExtrapolateGroundFlag(false)
+   theExtrapolateGroundFlag(false),
+   theHeightHints(heightHintSlots(), NO_HINT)
 {
    if (traceExec())
    {
@@ -152,7 +333,8 @@ ossimSensorModel::ossimSensorModel(const ossimSensorModel& model)
    theObs             (model.theObs),
    theResid           (model.theResid),
    theExtrapolateImageFlag(false),
-   theExtrapolateGroundFlag(false)
+   theExtrapolateGroundFlag(false),
+   theHeightHints(heightHintSlots(), NO_HINT)
 {
    if (traceExec())
    {
@@ -199,7 +381,8 @@ ossimSensorModel::ossimSensorModel(const ossimKeywordlist& geom_kwl)
    theObs              (0.0, 0.0),
    theResid            (0.0, 0.0),
    theExtrapolateImageFlag(false),
-   theExtrapolateGroundFlag(false)
+   theExtrapolateGroundFlag(false),
+   theHeightHints(heightHintSlots(), NO_HINT)
 {
    if (traceExec())
    {
@@ -244,6 +427,7 @@ const ossimSensorModel& ossimSensorModel::operator=( const ossimSensorModel& rhs
       theResid                 = rhs.theResid;
       theExtrapolateImageFlag  = rhs.theExtrapolateImageFlag;
       theExtrapolateGroundFlag = rhs.theExtrapolateGroundFlag;
+      theHeightHints.assign(theHeightHints.size(), NO_HINT);
    }
    return *this;
 }
@@ -283,6 +467,45 @@ void ossimSensorModel::lineSampleToWorld(const ossimDpt& image_point,
    bool debug = false;  // setable via interactive debugger
    if (traceExec() || debug)  ossimNotify(ossimNotifyLevel_DEBUG) << "DEBUG ossimSensorModel::lineSampleToWorld:entering..." << std::endl;
    
+   intersectTerrain(image_point, getHeightHint(image_point), gpt);
+   setHeightHint(image_point, gpt.hgt);
+
+   if (traceExec() || debug)  ossimNotify(ossimNotifyLevel_DEBUG) << "DEBUG ossimSensorModel::lineSampleToWorld: returning..." << std::endl;
+   return;
+}
+
+//*****************************************************************************
+//  METHOD: ossimSensorModel::lineSampleToWorlds()
+//  
+//  Batch form of lineSampleToWorld(), warm started from the previous point.
+//  
+//*****************************************************************************
+void ossimSensorModel::lineSampleToWorlds(const ossimDpt* image_points,
+                                          ossimGpt*       world_points,
+                                          ossim_uint32    count) const
+{
+   double startHeight = count ? getHeightHint(image_points[0]) : ossim::nan();
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      intersectTerrain(image_points[i], startHeight, world_points[i]);
+      if ( !world_points[i].isHgtNan() )
+      {
+         startHeight = world_points[i].hgt;
+         setHeightHint(image_points[i], startHeight);
+      }
+   }
+}
+
+//*****************************************************************************
+//  METHOD: ossimSensorModel::intersectTerrain()
+//  
+//  Image point to ground on the DEM, starting from startHeight if given.
+//  
+//*****************************************************************************
+void ossimSensorModel::intersectTerrain(const ossimDpt& image_point,
+                                        double          startHeight,
+                                        ossimGpt&       gpt) const
+{
    if(image_point.hasNans())
    {
       gpt.makeNan();
@@ -303,17 +526,45 @@ void ossimSensorModel::lineSampleToWorld(const ossimDpt& image_point,
    //***
    ossimEcefRay ray;
    imagingRay(image_point, ray);
-   ossimElevManager::instance()->intersectRay(ray, gpt);
+   ossimElevManager::instance()->intersectRayFromHeight(ray, startHeight, gpt);
 
-   if (traceDebug() || debug)
+   if (traceDebug())
    {
       ossimNotify(ossimNotifyLevel_DEBUG) << "image_point = " << image_point << std::endl;
       ossimNotify(ossimNotifyLevel_DEBUG) << "ray = " << ray << std::endl;
       ossimNotify(ossimNotifyLevel_DEBUG) << "gpt = " << gpt << std::endl;
    }
+}
 
-   if (traceExec() || debug)  ossimNotify(ossimNotifyLevel_DEBUG) << "DEBUG ossimSensorModel::lineSampleToWorld: returning..." << std::endl;
-   return;
+double ossimSensorModel::getHeightHint(const ossimDpt& image_point) const
+{
+   if ( theHeightHints.empty() || image_point.hasNans() )
+   {
+      return ossim::nan();
+   }
+   const ossim_uint32 KEY = heightHintKey(image_point);
+   const ossim_uint64 ENTRY = theHeightHints[(KEY * 2654435761U) % HINT_SLOTS];
+   if ( (ossim_uint32)(ENTRY >> 32) != KEY )
+   {
+      return ossim::nan();
+   }
+   ossim_uint32 bits = (ossim_uint32)ENTRY;
+   ossim_float32 height;
+   memcpy(&height, &bits, sizeof(height));
+   return height;
+}
+
+void ossimSensorModel::setHeightHint(const ossimDpt& image_point, double height) const
+{
+   if ( theHeightHints.empty() || image_point.hasNans() || ossim::isnan(height) )
+   {
+      return;
+   }
+   const ossim_uint32 KEY = heightHintKey(image_point);
+   ossim_float32 h = (ossim_float32)height;
+   ossim_uint32 bits;
+   memcpy(&bits, &h, sizeof(bits));
+   theHeightHints[(KEY * 2654435761U) % HINT_SLOTS] = ((ossim_uint64)KEY << 32) | bits;
 }
 
 //*****************************************************************************
@@ -1532,8 +1783,8 @@ ossimSensorModel::buildNormalEquation(const ossimTieGptSet& tieSet,
                                       double pstep_scale)
 {
    //goal:       build Least Squares system
-   //constraint: never store full Jacobian matrix in memory (can be huge)
-   //            so we build the matrices incrementally
+   // the jacobian is built column by column (see computeJacobian()), which
+   // is what lets finite differences reuse one model update per column
    // the system can be built using forward() or inverse() depending on the projection capabilities : useForward()
    //
    //TBD : add covariance matrix for each tie point
@@ -1553,9 +1804,6 @@ ossimSensorModel::buildNormalEquation(const ossimTieGptSet& tieSet,
    A.ReSize(np);
    residue.ReSize(no);
    projResidue.ReSize(np);
-   //Zeroify matrices that will be accumulated
-   A           = 0.0;
-   projResidue = 0.0;
 
    const vector<ossimRefPtr<ossimTieGpt> >& theTPV = tieSet.getTiePoints();
    vector<ossimRefPtr<ossimTieGpt> >::const_iterator tit;
@@ -1563,72 +1811,140 @@ ossimSensorModel::buildNormalEquation(const ossimTieGptSet& tieSet,
 
    if (useImageObs)
    { 
-     //image observations 
-      std::vector<ossimDpt> imDerp(np);
-     ossimDpt resIm;
-     // loop on tie points
+      //image observations 
+      ossimDpt resIm;
+      // loop on tie points
       for (tit = theTPV.begin() ; tit != theTPV.end() ; ++tit)
       {
          //compute residue
          resIm = (*tit)->tie - forward(*(*tit));
          residue(c++) = resIm.x;
          residue(c++) = resIm.y;
-
-         //compute all image derivatives regarding parametres for the tie point position
-         for(int p=0;p<np;++p)
-         {
-            imDerp[p] = getForwardDeriv( p , *(*tit) , pstep_scale);
-         }
-
-         //compute influence of tie point on all sytem elements
-         for(int p1=0;p1<np;++p1)
-         {        
-            //proj residue: J * residue
-            projResidue.element(p1) += imDerp[p1].x * resIm.x + imDerp[p1].y * resIm.y;
-
-            //normal matrix A = transpose(J)*J
-            for(int p2=p1;p2<np;++p2)
-            {
-               A.element(p1,p2) += imDerp[p1].x * imDerp[p2].x + imDerp[p1].y * imDerp[p2].y;
-            }
-         }
       }
    }
    else
    {
       // ground observations
-      std::vector<ossimGpt>  gdDerp(np);
-      ossimGpt gd, resGd;
+      ossimGpt gd;
       // loop on tie points
       for (tit = theTPV.begin() ; tit != theTPV.end() ; ++tit)
       {
          //compute residue
          gd = inverse((*tit)->tie);
-         residue(c++) = resGd.lon = ((*tit)->lon - gd.lon) * 100000.0;
-         residue(c++) = resGd.lat = ((*tit)->lat - gd.lat) * 100000.0 * cos(gd.lat / 180.0 * M_PI);
-         residue(c++) = resGd.hgt = (*tit)->hgt - gd.hgt; //TBD : normalize to meters?
+         residue(c++) = ((*tit)->lon - gd.lon) * 100000.0;
+         residue(c++) = ((*tit)->lat - gd.lat) * 100000.0 * cos(gd.lat / 180.0 * M_PI);
+         residue(c++) = (*tit)->hgt - gd.hgt; //TBD : normalize to meters?
+      }
+   } //end of if (useImageObs)
 
-         //compute all image derivatives regarding parametres for the tie point position
+   //---
+   // Jacobian, observations x parameters. Kept whole so the normal matrix is
+   // a single product; a few MB even for thousands of tie points.
+   //---
+   NEWMAT::Matrix J;
+   if ( hasAnalyticParameterDerivs() )
+   {
+      J.ReSize(no, np);
+      int row = 0;
+      for (tit = theTPV.begin() ; tit != theTPV.end() ; ++tit, row += dimObs)
+      {
          for(int p=0;p<np;++p)
          {
-            gdDerp[p] = getInverseDeriv( p , (*tit)->tie, pstep_scale);
-         }
-
-         //compute influence of tie point on all sytem elements
-         for(int p1=0;p1<np;++p1)
-         {        
-            //proj residue: J * residue
-            projResidue.element(p1) += gdDerp[p1].lon * resGd.lon + gdDerp[p1].lat * resGd.lat + gdDerp[p1].hgt * resGd.hgt; //TBC
-
-            //normal matrix A = transpose(J)*J
-            for(int p2=p1;p2<np;++p2)
+            if (useImageObs)
             {
-               A.element(p1,p2) += gdDerp[p1].lon * gdDerp[p2].lon + gdDerp[p1].lat * gdDerp[p2].lat + gdDerp[p1].hgt * gdDerp[p2].hgt;
+               ossimDpt d = getForwardDeriv( p , *(*tit) , pstep_scale);
+               J[row  ][p] = d.x;
+               J[row+1][p] = d.y;
+            }
+            else
+            {
+               ossimGpt d = getInverseDeriv( p , (*tit)->tie, pstep_scale);
+               J[row  ][p] = d.lon;
+               J[row+1][p] = d.lat;
+               J[row+2][p] = d.hgt;
             }
          }
       }
+   }
+   else
+   {
+      computeJacobian(tieSet, useImageObs, pstep_scale, J);
+   }
 
-   } //end of if (useImageObs)
+   //normal matrix A = transpose(J)*J, proj residue = transpose(J)*residue
+   NEWMAT::Matrix JtJ;
+   NEWMAT::Matrix Jtr;
+   ossimLinearAlgebra::transposeMultiply(J, J, JtJ);
+   ossimLinearAlgebra::transposeMultiply(J, residue, Jtr);
+   for(int p1=0;p1<np;++p1)
+   {
+      projResidue.element(p1) = Jtr[p1][0];
+      for(int p2=p1;p2<np;++p2)
+      {
+         A.element(p1,p2) = JtJ[p1][p2];
+      }
+   }
+}
+
+bool
+ossimSensorModel::hasAnalyticParameterDerivs() const
+{
+   return false;
+}
+
+void
+ossimSensorModel::computeJacobian(const ossimTieGptSet& tieSet,
+                                  bool useImageObs,
+                                  double hdelta,
+                                  NEWMAT::Matrix& jacobian)
+{
+   const vector<ossimRefPtr<ossimTieGpt> >& theTPV = tieSet.getTiePoints();
+   const ossim_uint32 NP = getNumberOfAdjustableParameters();
+   const ossim_uint32 NO = (useImageObs ? 2 : 3) * (ossim_uint32)theTPV.size();
+   jacobian.ReSize(NO, NP);
+   if ( !NP || !NO )
+   {
+      return;
+   }
+
+   //---
+   // A job per thread, a model copy per job; each column is a full sweep of
+   // the tie points so columns are handed out one at a time.
+   //---
+   ossim_uint32 jobCount = ossim::max<ossim_uint32>(
+      1, ossim::min<ossim_uint32>( ossim::getNumberOfThreads(), NP ) );
+   std::vector< ossimRefPtr<ossimSensorModel> > models;
+   for ( ossim_uint32 i = 0; (jobCount > 1) && (i < jobCount); ++i )
+   {
+      ossimRefPtr<ossimSensorModel> model = dynamic_cast<ossimSensorModel*>( dup() );
+      if ( !model.valid() )
+      {
+         jobCount = 1;
+         break;
+      }
+      models.push_back(model);
+   }
+
+   if ( jobCount == 1 )
+   {
+      for ( ossim_uint32 p = 0; p < NP; ++p )
+      {
+         computeJacobianColumn(this, theTPV, useImageObs, (int)p, hdelta, jacobian);
+      }
+      return;
+   }
+
+   ossimRefPtr<ossimSensorModelJacobianBatch> batch =
+      new ossimSensorModelJacobianBatch(NP, jobCount);
+   std::vector< ossimRefPtr<ossimSensorModelJacobianJob> > jobs;
+   ossimRefPtr<ossimJobMultiThreadQueue> queue = new ossimJobMultiThreadQueue(0, jobCount);
+   for ( ossim_uint32 i = 0; i < jobCount; ++i )
+   {
+      jobs.push_back( new ossimSensorModelJacobianJob( models[i].get(), theTPV, useImageObs,
+                                                       hdelta, jacobian, batch.get() ) );
+      queue->getJobQueue()->add(jobs[i].get(), false);
+   }
+   batch->wait();
 }
 
 //give inverse() partial derivative regarding parameter parmIdx (>=0)
@@ -1660,16 +1976,16 @@ ossimSensorModel::getInverseDeriv(int parmIdx, const ossimDpt& ipos, double hdel
 ossimDpt
 ossimSensorModel::getForwardDeriv(int parmIdx, const ossimGpt& gpos, double hdelta)
 {   
-   static double den = 0.5/hdelta;
+   double den = 0.5/hdelta;
    ossimDpt res;
 
    double middle = getAdjustableParameter(parmIdx);
    //set parm to high value
    setAdjustableParameter(parmIdx, middle + hdelta, true);
-   res = inverse(gpos);
+   res = forward(gpos);
    //set parm to low value and gte difference
    setAdjustableParameter(parmIdx, middle - hdelta, true);
-   res -= inverse(gpos);
+   res -= forward(gpos);
    //get partial derivative
    res = res*den;
 
@@ -1748,35 +2064,13 @@ ossimSensorModel::solveLeastSquares(NEWMAT::SymmetricMatrix& A,  NEWMAT::ColumnV
 NEWMAT::Matrix 
 ossimSensorModel::invert(const NEWMAT::Matrix& m)const
 {
-   ossim_uint32 idx = 0;
-   NEWMAT::DiagonalMatrix d;
-   NEWMAT::Matrix u;
-   NEWMAT::Matrix v;
-
-   // decompose m.t*m which is stored in Temp into the singular values and vectors.
-   //
-   NEWMAT::SVD(m, d, u, v, true, true);
-   
-   // invert the diagonal
-   // this is just doing the reciprical fo all diagonal components and store back int
-   // d.  ths compute d inverse.
-   //
-   for(idx=0; idx < (ossim_uint32)d.Ncols(); ++idx)
+   // Pseudo inverse from the singular value decomposition; values at or
+   // below 1e-14 are taken as zero.
+   NEWMAT::Matrix result;
+   if ( ossimLinearAlgebra::pseudoInverse(m, 1e-14, result) < (ossim_uint32)m.Ncols() ) //TBC : use DBL_EPSILON ?
    {
-      if(d[idx] > 1e-14) //TBC : use DBL_EPSILON ?
-      {
-         d[idx] = 1.0/d[idx];
-      }
-      else
-      {
-         d[idx] = 0.0;
-
 //DEBUG TBR
 cout<<"warning: singular matrix in SVD"<<endl;
-
-      }
    }
-
-   //compute inverse of decomposed m;
-   return v*d*u.t();
+   return result;
 }
@@ -0,0 +1,315 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Batch transverse Mercator series shared by ossimUtmProjection and
+// ossimTransMercatorProjection.
+//
+// Points are done in blocks: a scalar pass takes the sines and cosines (and for the inverse the
+// footpoint latitude), then the series terms, which are most of the arithmetic, run a vector of
+// points at a time.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/projection/ossimTransMercatorKernels.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimSimd.h>
+#include <algorithm>
+#include <cmath>
+
+#if OSSIM_SIMD_X86
+#  include <immintrin.h>
+#endif
+
+namespace
+{
+   const int TM_BLOCK = 64;
+
+   //---
+   // Scalar instance; also does the tail of the vector instances.
+   //---
+#define TM_VEC            double
+#define TM_WIDTH          1
+#define TM_TARGET
+#define TM_NAME(x)        x##Scalar
+#define TM_LOAD(ptr)      (*(ptr))
+#define TM_STORE(ptr, v)  (*(ptr) = (v))
+#define TM_SET1(x)        ((double)(x))
+#define TM_ADD(a, b)      ((a) + (b))
+#define TM_SUB(a, b)      ((a) - (b))
+#define TM_MUL(a, b)      ((a) * (b))
+#define TM_DIV(a, b)      ((a) / (b))
+#include "ossimTransMercatorSeries.inc"
+#undef TM_VEC
+#undef TM_WIDTH
+#undef TM_TARGET
+#undef TM_NAME
+#undef TM_LOAD
+#undef TM_STORE
+#undef TM_SET1
+#undef TM_ADD
+#undef TM_SUB
+#undef TM_MUL
+#undef TM_DIV
+
+#if OSSIM_SIMD_X86
+#define TM_VEC            __m128d
+#define TM_WIDTH          2
+#define TM_TARGET         OSSIM_SIMD_TARGET("sse2")
+#define TM_NAME(x)        x##Sse2
+#define TM_LOAD(ptr)      _mm_loadu_pd(ptr)
+#define TM_STORE(ptr, v)  _mm_storeu_pd((ptr), (v))
+#define TM_SET1(x)        _mm_set1_pd(x)
+#define TM_ADD(a, b)      _mm_add_pd((a), (b))
+#define TM_SUB(a, b)      _mm_sub_pd((a), (b))
+#define TM_MUL(a, b)      _mm_mul_pd((a), (b))
+#define TM_DIV(a, b)      _mm_div_pd((a), (b))
+#include "ossimTransMercatorSeries.inc"
+#undef TM_VEC
+#undef TM_WIDTH
+#undef TM_TARGET
+#undef TM_NAME
+#undef TM_LOAD
+#undef TM_STORE
+#undef TM_SET1
+#undef TM_ADD
+#undef TM_SUB
+#undef TM_MUL
+#undef TM_DIV
+
+#define TM_VEC            __m256d
+#define TM_WIDTH          4
+#define TM_TARGET         OSSIM_SIMD_TARGET("avx2")
+#define TM_NAME(x)        x##Avx2
+#define TM_LOAD(ptr)      _mm256_loadu_pd(ptr)
+#define TM_STORE(ptr, v)  _mm256_storeu_pd((ptr), (v))
+#define TM_SET1(x)        _mm256_set1_pd(x)
+#define TM_ADD(a, b)      _mm256_add_pd((a), (b))
+#define TM_SUB(a, b)      _mm256_sub_pd((a), (b))
+#define TM_MUL(a, b)      _mm256_mul_pd((a), (b))
+#define TM_DIV(a, b)      _mm256_div_pd((a), (b))
+#include "ossimTransMercatorSeries.inc"
+#undef TM_VEC
+#undef TM_WIDTH
+#undef TM_TARGET
+#undef TM_NAME
+#undef TM_LOAD
+#undef TM_STORE
+#undef TM_SET1
+#undef TM_ADD
+#undef TM_SUB
+#undef TM_MUL
+#undef TM_DIV
+#endif /* #if OSSIM_SIMD_X86 */
+
+   // SPHTMD macro of the projection classes.
+   double meridionalDistance(const ossim::TransMercatorParams& p, double lat)
+   {
+      return p.ap * lat - p.bp * std::sin(2.0 * lat) + p.cp * std::sin(4.0 * lat)
+         - p.dp * std::sin(6.0 * lat) + p.ep * std::sin(8.0 * lat);
+   }
+
+   // SPHTMD from the sine and cosine of lat, as in the series.
+   inline double meridionalDistance(const ossim::TransMercatorParams& p, double lat,
+                                    double s, double c)
+   {
+      const double sin2 = 2.0 * (s * c);
+      const double cos2 = 1.0 - 2.0 * (s * s);
+      const double sin4 = 2.0 * (sin2 * cos2);
+      const double cos4 = 1.0 - 2.0 * (sin2 * sin2);
+      const double sin6 = sin4 * cos2 + cos4 * sin2;
+      const double sin8 = 2.0 * (sin4 * cos4);
+      return p.ap * lat - p.bp * sin2 + p.cp * sin4 - p.dp * sin6 + p.ep * sin8;
+   }
+
+   void forwardSeries(const ossim::TransMercatorParams& p, double tmdo,
+                      const double* L, const double* S, const double* C,
+                      const double* SN, const double* D, double* E, double* N, int n)
+   {
+      int i = 0;
+#if OSSIM_SIMD_X86
+      const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+      if (LEVEL >= ossim::SIMD_AVX2)
+      {
+         i = forwardSeriesAvx2(p, tmdo, L, S, C, SN, D, E, N, n);
+      }
+      else if (LEVEL >= ossim::SIMD_SSE2)
+      {
+         i = forwardSeriesSse2(p, tmdo, L, S, C, SN, D, E, N, n);
+      }
+#endif
+      forwardSeriesScalar(p, tmdo, L + i, S + i, C + i, SN + i, D + i, E + i, N + i, n - i);
+   }
+
+   void inverseSeries(const ossim::TransMercatorParams& p, const double* kn,
+                      const double* F, const double* S, const double* C,
+                      const double* SR, const double* SN, const double* DE,
+                      double* LAT, double* LON, int n)
+   {
+      int i = 0;
+#if OSSIM_SIMD_X86
+      const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+      if (LEVEL >= ossim::SIMD_AVX2)
+      {
+         i = inverseSeriesAvx2(p, kn, F, S, C, SR, SN, DE, LAT, LON, n);
+      }
+      else if (LEVEL >= ossim::SIMD_SSE2)
+      {
+         i = inverseSeriesSse2(p, kn, F, S, C, SR, SN, DE, LAT, LON, n);
+      }
+#endif
+      inverseSeriesScalar(p, kn, F + i, S + i, C + i, SR + i, SN + i, DE + i,
+                          LAT + i, LON + i, n - i);
+   }
+
+} // End: anonymous namespace
+
+void ossim::transMercatorForward(const TransMercatorParams& p,
+                                 const ossimGpt* worldPoints,
+                                 ossimDpt* eastingNorthings,
+                                 ossim_uint32 count)
+{
+   const double TMDO = meridionalDistance(p, p.originLat);
+
+   double L[TM_BLOCK];
+   double S[TM_BLOCK];
+   double C[TM_BLOCK];
+   double SN[TM_BLOCK];
+   double D[TM_BLOCK];
+   double E[TM_BLOCK];
+   double N[TM_BLOCK];
+
+   for (ossim_uint32 start = 0; start < count; start += TM_BLOCK)
+   {
+      const int BLOCK_SIZE = (int)std::min((ossim_uint32)TM_BLOCK, count - start);
+      const ossimGpt* gpts = worldPoints + start;
+      for (int i = 0; i < BLOCK_SIZE; ++i)
+      {
+         const double lat = gpts[i].latr();
+         double lon = gpts[i].lonr();
+         if (lon > M_PI)
+            lon -= TWO_PI;
+         double dlam = lon - p.originLon;
+         if (dlam > M_PI)
+            dlam -= TWO_PI;
+         if (dlam < -M_PI)
+            dlam += TWO_PI;
+         if (std::fabs(dlam) < 2.e-10)
+            dlam = 0.0;
+
+         L[i]  = lat;
+         S[i]  = std::sin(lat);
+         C[i]  = std::cos(lat);
+         SN[i] = p.a / std::sqrt(1.0 - p.es * (S[i] * S[i]));
+         D[i]  = dlam;
+      }
+
+      forwardSeries(p, TMDO, L, S, C, SN, D, E, N, BLOCK_SIZE);
+
+      ossimDpt* en = eastingNorthings + start;
+      for (int i = 0; i < BLOCK_SIZE; ++i)
+      {
+         en[i].x = E[i];
+         en[i].y = N[i];
+      }
+   }
+}
+
+void ossim::transMercatorInverse(const TransMercatorParams& p,
+                                 const ossimDpt* eastingNorthings,
+                                 ossimGpt* worldPoints,
+                                 ossim_uint32 count)
+{
+   const double TMDO = meridionalDistance(p, p.originLat);
+   const double SR0  = p.a * (1.0 - p.es);
+
+   // Powers of the scale factor, kn[i] = k0^i.
+   double kn[9];
+   for (int i = 0; i < 9; ++i)
+   {
+      kn[i] = std::pow(p.scaleFactor, i);
+   }
+
+   double F[TM_BLOCK];
+   double S[TM_BLOCK];
+   double C[TM_BLOCK];
+   double SR[TM_BLOCK];
+   double SN[TM_BLOCK];
+   double DE[TM_BLOCK];
+   double LAT[TM_BLOCK];
+   double LON[TM_BLOCK];
+
+   for (ossim_uint32 start = 0; start < count; start += TM_BLOCK)
+   {
+      const int BLOCK_SIZE = (int)std::min((ossim_uint32)TM_BLOCK, count - start);
+      const ossimDpt* en = eastingNorthings + start;
+      for (int i = 0; i < BLOCK_SIZE; ++i)
+      {
+         const double tmd = TMDO + (en[i].y - p.falseNorthing) / p.scaleFactor;
+
+         // Footpoint latitude.
+         double ftphi = tmd / SR0;
+         double s = 0.0;
+         double c = 0.0;
+         double denom = 0.0;
+         for (int iter = 0; iter < 5; ++iter)
+         {
+            s = std::sin(ftphi);
+            c = std::cos(ftphi);
+            denom = std::sqrt(1.0 - p.es * (s * s));
+            ftphi += (tmd - meridionalDistance(p, ftphi, s, c)) /
+               (SR0 / (denom * denom * denom));
+         }
+         s = std::sin(ftphi);
+         c = std::cos(ftphi);
+         denom = std::sqrt(1.0 - p.es * (s * s));
+
+         double de = en[i].x - p.falseEasting;
+         if (std::fabs(de) < 0.0001)
+            de = 0.0;
+
+         F[i]  = ftphi;
+         S[i]  = s;
+         C[i]  = c;
+         SR[i] = SR0 / (denom * denom * denom);
+         SN[i] = p.a / denom;
+         DE[i] = de;
+      }
+
+      inverseSeries(p, kn, F, S, C, SR, SN, DE, LAT, LON, BLOCK_SIZE);
+
+      ossimGpt* gpts = worldPoints + start;
+      for (int i = 0; i < BLOCK_SIZE; ++i)
+      {
+         double lat = LAT[i];
+         double lon = LON[i];
+         while (lat > (90.0 * RAD_PER_DEG))
+         {
+            lat = M_PI - lat;
+            lon += M_PI;
+            if (lon > M_PI)
+               lon -= TWO_PI;
+         }
+         while (lat < (-90.0 * RAD_PER_DEG))
+         {
+            lat = - (lat + M_PI);
+            lon += M_PI;
+            if (lon > M_PI)
+               lon -= TWO_PI;
+         }
+         if (lon > TWO_PI)
+            lon -= TWO_PI;
+         if (lon < -M_PI)
+            lon += TWO_PI;
+
+         gpts[i].lat = lat * DEG_PER_RAD;
+         gpts[i].lon = lon * DEG_PER_RAD;
+         gpts[i].hgt = 0.0;
+      }
+   }
+}
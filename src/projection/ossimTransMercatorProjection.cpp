@@ -201,6 +201,59 @@ ossimDpt ossimTransMercatorProjection::forward(const ossimGpt &latLon)const
    return ossimDpt(easting, northing);
 }
 
+void ossimTransMercatorProjection::getTransMercatorParams(ossim::TransMercatorParams& p) const
+{
+   p.a             = getA();
+   p.es            = TranMerc_es;
+   p.ebs           = TranMerc_ebs;
+   p.ap            = TranMerc_ap;
+   p.bp            = TranMerc_bp;
+   p.cp            = TranMerc_cp;
+   p.dp            = TranMerc_dp;
+   p.ep            = TranMerc_ep;
+   p.originLat     = TranMerc_Origin_Lat;
+   p.originLon     = TranMerc_Origin_Long;
+   p.falseEasting  = TranMerc_False_Easting;
+   p.falseNorthing = TranMerc_False_Northing;
+   p.scaleFactor   = TranMerc_Scale_Factor;
+}
+
+void ossimTransMercatorProjection::forwardPoints(const ossimGpt* worldPoints,
+                                                 ossimDpt* eastingNorthings,
+                                                 ossim_uint32 count) const
+{
+   ossim::TransMercatorParams p;
+   getTransMercatorParams(p);
+   ossim::transMercatorForward(p, worldPoints, eastingNorthings, count);
+}
+
+void ossimTransMercatorProjection::inversePoints(const ossimDpt* eastingNorthings,
+                                                 ossimGpt* worldPoints,
+                                                 ossim_uint32 count) const
+{
+   ossim::TransMercatorParams p;
+   getTransMercatorParams(p);
+   ossim::transMercatorInverse(p, eastingNorthings, worldPoints, count);
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      worldPoints[i].datum(theDatum);
+   }
+}
+
+void ossimTransMercatorProjection::worldToLineSamples(const ossimGpt* worldPoints,
+                                                      ossimDpt* lineSamples,
+                                                      ossim_uint32 count) const
+{
+   forwardToLineSamples(worldPoints, lineSamples, count);
+}
+
+void ossimTransMercatorProjection::lineSampleToWorlds(const ossimDpt* lineSamples,
+                                                      ossimGpt* worldPoints,
+                                                      ossim_uint32 count) const
+{
+   inverseToWorlds(lineSamples, worldPoints, count, true);
+}
+
 bool ossimTransMercatorProjection::saveState(ossimKeywordlist& kwl, const char* prefix) const
 {
    kwl.add(prefix,
@@ -224,6 +224,59 @@ ossimDpt ossimUtmProjection::forward(const ossimGpt &latLon)const
    return ossimDpt(easting, northing);
 }
 
+void ossimUtmProjection::getTransMercatorParams(ossim::TransMercatorParams& p) const
+{
+   p.a             = getA();
+   p.es            = theTranMerc_es;
+   p.ebs           = theTranMerc_ebs;
+   p.ap            = theTranMerc_ap;
+   p.bp            = theTranMerc_bp;
+   p.cp            = theTranMerc_cp;
+   p.dp            = theTranMerc_dp;
+   p.ep            = theTranMerc_ep;
+   p.originLat     = theTranMerc_Origin_Lat;
+   p.originLon     = theTranMerc_Origin_Long;
+   p.falseEasting  = theTranMerc_False_Easting;
+   p.falseNorthing = theTranMerc_False_Northing;
+   p.scaleFactor   = theTranMerc_Scale_Factor;
+}
+
+void ossimUtmProjection::forwardPoints(const ossimGpt* worldPoints,
+                                       ossimDpt* eastingNorthings,
+                                       ossim_uint32 count) const
+{
+   ossim::TransMercatorParams p;
+   getTransMercatorParams(p);
+   ossim::transMercatorForward(p, worldPoints, eastingNorthings, count);
+}
+
+void ossimUtmProjection::inversePoints(const ossimDpt* eastingNorthings,
+                                       ossimGpt* worldPoints,
+                                       ossim_uint32 count) const
+{
+   ossim::TransMercatorParams p;
+   getTransMercatorParams(p);
+   ossim::transMercatorInverse(p, eastingNorthings, worldPoints, count);
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      worldPoints[i].datum(theDatum);
+   }
+}
+
+void ossimUtmProjection::worldToLineSamples(const ossimGpt* worldPoints,
+                                            ossimDpt* lineSamples,
+                                            ossim_uint32 count) const
+{
+   forwardToLineSamples(worldPoints, lineSamples, count);
+}
+
+void ossimUtmProjection::lineSampleToWorlds(const ossimDpt* lineSamples,
+                                            ossimGpt* worldPoints,
+                                            ossim_uint32 count) const
+{
+   inverseToWorlds(lineSamples, worldPoints, count, true);
+}
+
 ossimObject* ossimUtmProjection::dup()const
 {
    ossimUtmProjection* proj = new ossimUtmProjection(*this);
@@ -27,6 +27,7 @@ static const char* PROJECTION_PREFIX = "projection.";
 // Define Trace flags for use within this file:
 //***
 #include <ossim/base/ossimTrace.h>
+#include <vector>
 static ossimTrace traceExec  ("ossimWarpProjection:exec");
 static ossimTrace traceDebug ("ossimWarpProjection:debug");
 
@@ -120,6 +121,25 @@ void ossimWarpProjection::worldToLineSample (const ossimGpt& worldPoint,
    if (traceExec())  ossimNotify(ossimNotifyLevel_DEBUG) << "DEBUG ossimWarpProjection::worldToLineSample: Returning..." << std::endl;
 }
 
+void ossimWarpProjection::worldToLineSamples(const ossimGpt* worldPoints,
+                                             ossimDpt*       lineSampPts,
+                                             ossim_uint32    count) const
+{
+   if (theClientProjection.valid() && theWarpTransform.valid() && theAffineTransform.valid())
+   {
+      theClientProjection->worldToLineSamples(worldPoints, lineSampPts, count);
+      theAffineTransform->inversePoints(lineSampPts, lineSampPts, count);
+      theWarpTransform->inversePoints(lineSampPts, lineSampPts, count);
+   }
+   else
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         lineSampPts[i].makeNan();
+      }
+   }
+}
+
 //*****************************************************************************
 //  METHOD: ossimWarpProjection::lineSampleToWorld()
 //*****************************************************************************
@@ -142,6 +162,31 @@ void ossimWarpProjection::lineSampleToWorld(const ossimDpt& lineSampPt,
    
    if (traceExec())  ossimNotify(ossimNotifyLevel_DEBUG) << "DEBUG ossimWarpProjection::lineSampleToWorld: Returning..." << std::endl;
 }
+
+void ossimWarpProjection::lineSampleToWorlds(const ossimDpt* lineSampPts,
+                                             ossimGpt*       worldPts,
+                                             ossim_uint32    count) const
+{
+   if (!count)
+   {
+      return;
+   }
+   if (theClientProjection.valid() && theWarpTransform.valid() && theAffineTransform.valid())
+   {
+      // Same chain as lineSampleToWorld(), where the affine result is what
+      // reaches the client projection.
+      std::vector<ossimDpt> adjustedPts(count);
+      theAffineTransform->forwardPoints(lineSampPts, &adjustedPts.front(), count);
+      theClientProjection->lineSampleToWorlds(&adjustedPts.front(), worldPts, count);
+   }
+   else
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         worldPts[i].makeNan();
+      }
+   }
+}
    
 //*****************************************************************************
 //  METHOD: ossimWarpProjection::lineSampleToWorld()
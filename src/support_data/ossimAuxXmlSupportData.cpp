@@ -49,13 +49,20 @@ ossimRefPtr<ossimProjection> ossimAuxXmlSupportData::getProjection(const ossimFi
 
    if ( is.good() )
    {
-      // Read the xml document:
+      //---
+      // Read the xml document, only the nodes used here; .aux.xml files
+      // can hold large histograms:
+      //---
+      const ossimString WKT_PATH = "/PAMDataset/Metadata/GeodataXform/SpatialReference/WKT";
+      std::vector<ossimString> xpaths;
+      xpaths.push_back( WKT_PATH );
+      xpaths.push_back( ossimString("/PAMDataset/Metadata/MDI") );
       ossimXmlDocument xdoc;
-      if ( xdoc.read( is ) )
+      if ( xdoc.read( is, xpaths ) )
       {
          // Get the WKT string
          ossimString wkt;
-         ossimString path = "/PAMDataset/Metadata/GeodataXform/SpatialReference/WKT";
+         ossimString path = WKT_PATH;
          if ( getPath( path, xdoc, wkt ) )
          {
             if ( wkt.size() )
@@ -99,7 +106,7 @@ ossimRefPtr<ossimProjection> ossimAuxXmlSupportData::getProjection(const ossimFi
    
 } // End: ossimAuxXmlSupportData::getProjection
 
-bool ossimAuxXmlSupportData::initializeProjection( const ossimXmlDocument xdoc,
+bool ossimAuxXmlSupportData::initializeProjection( const ossimXmlDocument& xdoc,
                                                    const std::string& wkt, 
                                                    ossimProjection* proj ) const
 {
@@ -13,7 +13,34 @@
 #include <ossim/support_data/ossimDemGrid.h>
 #include <ossim/support_data/ossimDemPoint.h>
 #include <ossim/support_data/ossimDemUtil.h>
+#include <ossim/base/ossimDate.h>
 #include <ossim/base/ossimNotifyContext.h>
+#include <ossim/base/ossimPreferences.h>
+#include <OpenThreads/ScopedLock>
+#include <cstring>
+
+namespace
+{
+   //---
+   // Sidecar layout: magic, the DEM modification time and size, width and
+   // height (ossim_int64), north west corner (double), then the float32
+   // grid by rows.  Native byte order; it is a cache for this machine.
+   //---
+   const char         SIDECAR_MAGIC[16] = "OSSIMDEMGRID1";
+   const std::size_t  SIDECAR_HEADER_SIZE = 64;
+
+   bool getFileStamp(const ossimFilename& file, ossim_int64& modTime, ossim_int64& size)
+   {
+      ossimLocalTm t;
+      if ( !file.getTimes(0, &t, 0) )
+      {
+         return false;
+      }
+      modTime = (ossim_int64)(time_t)t;
+      size    = file.fileSize();
+      return true;
+   }
+}
 
 ossimDemGrid::ossimDemGrid(ossim_float32 missingDataValue)
    : _missDataVal(missingDataValue),
@@ -21,7 +48,15 @@ ossimDemGrid::ossimDemGrid(ossim_float32 missingDataValue)
      _height(0),
      _grid(0),
      _firstTime(true),
-     _curProfile(0)
+     _curProfile(0),
+     _northwest_x(0.0),
+     _northwest_y(0.0),
+     _profileInfo(),
+     _columns(),
+     _stream(),
+     _mutex(),
+     _sidecar(0),
+     _sidecarGrid(0)
 {        
 }
 
@@ -71,13 +106,23 @@ ossimDemGrid::getHeight() const
 
 ossim_float32 ossimDemGrid::getElevation(long x, long y) const
 {
-   if (_grid == 0)
+   if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
       return _missDataVal;
 
-   if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+   if (_grid)
+      return _grid[(y * _width) + x];
+
+   if (_sidecarGrid)
+      return _sidecarGrid[(y * _width) + x];
+
+   if (_profileInfo.empty())
       return _missDataVal;
 
-   return _grid[(y * _width) + x];
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_mutex);
+   if (_columns[x].empty() && !loadProfile(x))
+      return _missDataVal;
+
+   return _columns[x][y];
 }
 
 ossim_float32 ossimDemGrid::getMissingDataValue() const
@@ -226,6 +271,218 @@ ossimDemGrid::fillUTM(std::istream& dem, bool incrementalRead)
    return 0;
 }
 
+bool ossimDemGrid::open(const ossimFilename& file)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_mutex);
+
+   delete [] _grid;
+   _grid = 0;
+   _sidecar = 0;
+   _sidecarGrid = 0;
+   _profileInfo.clear();
+   _columns.clear();
+   if (_stream.is_open())
+      _stream.close();
+   _stream.clear();
+
+   _stream.open(file.c_str(), std::ios::in | std::ios::binary);
+   if (!_stream)
+      return false;
+
+   _stream >> _header;
+   _firstTime = false;
+   _width = _header.getProfileColumns();
+   if (!_stream || (_width <= 0))
+      return false;
+
+   //---
+   // Read the first record of each profile for its location and number of
+   // elevations; the elevation records are skipped.
+   //---
+   std::vector<double> profileY;
+   profileY.reserve(_width);
+   _profileInfo.reserve(_width);
+   double westX = 0.0;
+   char bufstr[1024];
+   for (long i = 0; i < _width; ++i)
+   {
+      ProfileInfo info;
+      info._offset = _stream.tellg();
+      if ((info._offset < 0) || !ossimDemUtil::getRecord(_stream, bufstr))
+         return false;
+
+      info._numberElevations = ossimDemUtil::getLong(bufstr, 12, 6);
+      info._startRow = 0;
+      double x = 0.0;
+      double y = 0.0;
+      ossimDemUtil::getDouble(bufstr, 24, 24, x);
+      ossimDemUtil::getDouble(bufstr, 48, 24, y);
+      if (i == 0)
+         westX = x;
+
+      // Same record layout as operator>>(std::istream&, ossimDemProfile&).
+      for (ossim_int32 count = 146; count < info._numberElevations; count += 170)
+         ossimDemUtil::skipRecord(_stream);
+
+      _profileInfo.push_back(info);
+      profileY.push_back(y);
+   }
+   _stream.clear();
+
+   // Same grid as fillGeographic and fillUTM.
+   const double DY = _header.getSpatialResY();
+   if (_header.getGroundRefSysCode() == 0)  // Geographic
+   {
+      _height = _profileInfo[0]._numberElevations;
+      _northwest_y = profileY[0] + ((_height - 1) * DY);
+   }
+   else
+   {
+      bool found = false;
+      double miny = 0.0;
+      double maxy = 0.0;
+      for (std::vector<ProfileInfo>::size_type i = 0; i < _profileInfo.size(); ++i)
+      {
+         if (_profileInfo[i]._numberElevations > 0)
+         {
+            const double PROFYMIN = profileY[i];
+            const double PROFYMAX = PROFYMIN + ((_profileInfo[i]._numberElevations - 1) * DY);
+            if (!found || (PROFYMIN < miny))
+               miny = PROFYMIN;
+            if (!found || (PROFYMAX > maxy))
+               maxy = PROFYMAX;
+            found = true;
+         }
+      }
+      if (!found || (DY == 0.0))
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "ossimDemGrid::open: All profiles have zero elevations!\n";
+         return false;
+      }
+
+      _height = static_cast<long>(((maxy - miny) / DY) + 1);
+      _northwest_y = maxy;
+      for (std::vector<ProfileInfo>::size_type i = 0; i < _profileInfo.size(); ++i)
+         _profileInfo[i]._startRow = static_cast<long>((profileY[i] - miny) / DY);
+   }
+   _northwest_x = westX;
+   if (_height <= 0)
+      return false;
+
+   _columns.resize(_width);
+
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("usgs_dem.binary_sidecar");
+   if (lookup && ossimString(lookup).toBool())
+   {
+      const ossimFilename SIDECAR = file + ".ogrid";
+      if (!openSidecar(SIDECAR, file))
+      {
+         bool decoded = true;
+         for (long x = 0; decoded && (x < _width); ++x)
+            decoded = loadProfile(x);
+         if (decoded && writeSidecar(SIDECAR, file))
+            openSidecar(SIDECAR, file);
+      }
+      if (_sidecarGrid)
+      {
+         _columns.clear();
+         _stream.close();
+      }
+   }
+
+   return true;
+}
+
+bool ossimDemGrid::loadProfile(long x) const
+{
+   std::vector<ossim_float32>& column = _columns[x];
+   column.assign(_height, _missDataVal);
+
+   _stream.clear();
+   _stream.seekg(_profileInfo[x]._offset);
+   if (!_stream)
+      return false;
+
+   ossimDemProfile profile;
+   _stream >> profile;
+
+   ossimDemElevationVector const& elev = profile.getElevations();
+   const long START = _height - _profileInfo[x]._startRow - 1;
+   for (ossimDemElevationVector::size_type j = 0; j < elev.size(); ++j)
+   {
+      const long ROW = START - static_cast<long>(j);
+      if ((ROW >= 0) && (ROW < _height))
+         column[ROW] = static_cast<ossim_float32>(elev[j]);
+   }
+   return true;
+}
+
+bool ossimDemGrid::openSidecar(const ossimFilename& sidecar, const ossimFilename& file)
+{
+   ossim_int64 modTime = 0;
+   ossim_int64 size = 0;
+   if (!sidecar.exists() || !getFileStamp(file, modTime, size))
+      return false;
+
+   ossimRefPtr<ossimMemoryMappedFile> map = new ossimMemoryMappedFile();
+   const ossim_uint64 GRID_SIZE = static_cast<ossim_uint64>(_width) * _height * 4;
+   if (!map->open(sidecar) || (map->size() != SIDECAR_HEADER_SIZE + GRID_SIZE))
+      return false;
+
+   const ossim_uint8* data = map->data();
+   ossim_int64 fields[4];
+   double northwest[2];
+   memcpy(fields, data + 16, sizeof(fields));
+   memcpy(northwest, data + 48, sizeof(northwest));
+   if ((memcmp(data, SIDECAR_MAGIC, 16) != 0) ||
+       (fields[0] != modTime) || (fields[1] != size) ||
+       (fields[2] != _width) || (fields[3] != _height) ||
+       (northwest[0] != _northwest_x) || (northwest[1] != _northwest_y))
+      return false;
+
+   _sidecar = map;
+   _sidecarGrid = reinterpret_cast<const ossim_float32*>(data + SIDECAR_HEADER_SIZE);
+   return true;
+}
+
+bool ossimDemGrid::writeSidecar(const ossimFilename& sidecar, const ossimFilename& file) const
+{
+   ossim_int64 fields[4] = { 0, 0, _width, _height };
+   if (!getFileStamp(file, fields[0], fields[1]))
+      return false;
+
+   // Write and rename, so a partial file is never mapped.
+   const ossimFilename TMP_FILE = sidecar + ".tmp";
+   std::ofstream out(TMP_FILE.c_str(), std::ios::out | std::ios::binary);
+   if (!out)
+      return false;
+
+   char header[SIDECAR_HEADER_SIZE];
+   const double NORTHWEST[2] = { _northwest_x, _northwest_y };
+   memcpy(header, SIDECAR_MAGIC, 16);
+   memcpy(header + 16, fields, sizeof(fields));
+   memcpy(header + 48, NORTHWEST, sizeof(NORTHWEST));
+   out.write(header, SIDECAR_HEADER_SIZE);
+
+   std::vector<ossim_float32> row(_width);
+   for (long y = 0; out && (y < _height); ++y)
+   {
+      for (long x = 0; x < _width; ++x)
+         row[x] = _columns[x][y];
+      out.write(reinterpret_cast<const char*>(&row.front()), _width * sizeof(ossim_float32));
+   }
+   out.close();
+
+   if (!out || !TMP_FILE.rename(sidecar, true))
+   {
+      TMP_FILE.remove();
+      return false;
+   }
+   return true;
+}
+
 void
 ossimDemGrid::getGroundCoords(long x, long y, double& ground_x,
                               double& ground_y)
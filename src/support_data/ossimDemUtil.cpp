@@ -140,17 +140,39 @@ ossimDemUtil::getRecord(istream& s, char* buf, long reclength)
    if (!s)
       return false;
 
+   //---
+   // Reads up to reclength characters through the stream buffer, keeping
+   // reclength-1 of them; the character ending the record is dropped.
+   //---
+   std::streambuf* sb = s.rdbuf();
    long curpos = 0;
-   buf[curpos] = s.get();
-   while ((buf[curpos] != EOF) && 
-          (buf[curpos] != '\n') &&
-          (curpos < reclength-1))
+   int c = sb->sbumpc();
+   while ((c != EOF) && (c != '\n') && (curpos < reclength-1))
    {
-      curpos++;
-      buf[curpos] = s.get();
+      buf[curpos++] = static_cast<char>(c);
+      c = sb->sbumpc();
    }
    buf[curpos] = '\0';
 
+   if (c == EOF)
+   {
+      s.setstate(std::ios::eofbit|std::ios::failbit);
+   }
+   else if (sb->sgetc() == '\n')
+   {
+      sb->sbumpc();
+   }
+
+   return true;
+}
+
+bool
+ossimDemUtil::skipRecord(istream& s, long reclength)
+{
+   if (!s)
+      return false;
+
+   s.ignore(reclength, '\n');
    if (s.peek() == '\n')
       s.get();
 
@@ -176,3 +198,23 @@ ossimDemUtil::getDouble(string const& strbuf,
    val = atof(tempbuf.c_str());
    return true;
 }
+
+bool
+ossimDemUtil::getDouble(const char* strbuf,
+                        long const startpos,
+                        long const width,
+                        double& val)
+{
+   if ((startpos + width - 1) > (long)(strlen(strbuf)))
+      return false;
+
+   // Convert FORTRAN 'D' exponent indicator to 'E'.
+   char tempbuf[1024];
+   long i = 0;
+   for (; (i < width) && (i < 1023) && strbuf[startpos+i]; ++i)
+      tempbuf[i] = (strbuf[startpos+i] == 'D') ? 'E' : strbuf[startpos+i];
+   tempbuf[i] = '\0';
+
+   val = atof(tempbuf);
+   return true;
+}
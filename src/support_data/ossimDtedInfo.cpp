@@ -22,6 +22,8 @@
 #include <ossim/base/ossimProperty.h>
 #include <ossim/base/ossimContainerProperty.h>
 #include <ossim/base/ossimRegExp.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimKeywordNames.h>
 
 
 ossimDtedInfo::ossimDtedInfo()
@@ -104,6 +106,41 @@ std::ostream& ossimDtedInfo::print(std::ostream& out) const
    return out;
 }
 
+bool ossimDtedInfo::getImageSummary(ossimKeywordlist& kwl, const std::string& prefix) const
+{
+   bool result = false;
+   if ( theFile.size() )
+   {
+      ossimDtedVol vol(theFile, 0);
+      ossimDtedHdr hdr(theFile, vol.stopOffset());
+      ossimDtedUhl uhl(theFile, hdr.stopOffset());
+      if ( uhl.getErrorStatus() == ossimErrorCodes::OSSIM_OK )
+      {
+         // Lines run north to south along a longitude line.
+         const ossim_uint32 LINES   = uhl.numLatPoints();
+         const ossim_uint32 SAMPLES = uhl.numLonLines();
+         addImageSummary( kwl, prefix, 0, LINES, SAMPLES, 1 );
+
+         const double S = uhl.latOrigin();
+         const double W = uhl.lonOrigin();
+         const double N = S + (LINES - 1) * uhl.latInterval();
+         const double E = W + (SAMPLES - 1) * uhl.lonInterval();
+         const std::string PFX = prefix + "image0.";
+         kwl.add( PFX.c_str(), ossimKeywordNames::UL_LAT_KW, N );
+         kwl.add( PFX.c_str(), ossimKeywordNames::UL_LON_KW, W );
+         kwl.add( PFX.c_str(), ossimKeywordNames::UR_LAT_KW, N );
+         kwl.add( PFX.c_str(), ossimKeywordNames::UR_LON_KW, E );
+         kwl.add( PFX.c_str(), ossimKeywordNames::LR_LAT_KW, S );
+         kwl.add( PFX.c_str(), ossimKeywordNames::LR_LON_KW, E );
+         kwl.add( PFX.c_str(), ossimKeywordNames::LL_LAT_KW, S );
+         kwl.add( PFX.c_str(), ossimKeywordNames::LL_LON_KW, W );
+         kwl.add( prefix.c_str(), ossimKeywordNames::NUMBER_ENTRIES_KW, 1 );
+         result = true;
+      }
+   }
+   return result;
+}
+
 ossimRefPtr<ossimProperty> ossimDtedInfo::getProperty(
    const ossimString& name)const
 {
@@ -14,7 +14,10 @@
 // $Id: ossimIkonosMetaData.cpp 17206 2010-04-25 23:20:40Z dburken $
 
 #include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <ossim/support_data/ossimIkonosMetaData.h>
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimNotify.h>
@@ -27,6 +30,50 @@ RTTI_DEF1(ossimIkonosMetaData, "ossimIkonosMetaData", ossimObject);
 static ossimTrace traceExec  ("ossimIkonosMetaData:exec");
 static ossimTrace traceDebug ("ossimIkonosMetaData:debug");
 
+//---
+// Reads the "Name: value" lines of file until each of the count names is
+// found at the start of a line, keeping the words after the first one.
+// Stops reading there, so a large metadata file is read only as far as the
+// last name needed.  Returns false if the file could not be opened.
+//---
+static bool readNamedValues(const ossimFilename& file,
+                            const char* const names[],
+                            ossim_uint32 count,
+                            std::vector< std::vector<ossimString> >& values)
+{
+   std::ifstream in(file.c_str(), std::ios::in|std::ios::binary);
+   if (!in)
+   {
+      return false;
+   }
+
+   values.assign(count, std::vector<ossimString>());
+   ossim_uint32 missing = count;
+   std::string line;
+   while ( missing && std::getline(in, line) )
+   {
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         const std::string::size_type LENGTH = std::strlen(names[i]);
+         if ( values[i].empty() && (line.compare(0, LENGTH, names[i]) == 0) )
+         {
+            std::istringstream words(line.substr(LENGTH));
+            std::string word;
+            while (words >> word)
+            {
+               values[i].push_back(ossimString(word));
+            }
+            if ( values[i].size() )
+            {
+               --missing;
+            }
+            break;
+         }
+      }
+   }
+   return true;
+}
+
 ossimIkonosMetaData::ossimIkonosMetaData()
   :
   theNominalCollectionAzimuth(0.0),
@@ -316,8 +363,18 @@ bool ossimIkonosMetaData::parseMetaData(const ossimFilename& data_file)
          << std::endl;
    }
 
-   FILE* fptr = fopen (data_file, "r");
-   if (!fptr)
+   static const char* const NAMES[] =
+   {
+      "Creation Date:",
+      "Sensor:",
+      "Nominal Collection Azimuth:",
+      "Nominal Collection Elevation:",
+      "Sun Angle Azimuth:",
+      "Sun Angle Elevation:",
+      "Acquisition Date/Time:"
+   };
+   std::vector< std::vector<ossimString> > values;
+   if ( !readNamedValues(data_file, NAMES, 7, values) )
    {
       if (traceDebug())
       {
@@ -329,163 +386,29 @@ bool ossimIkonosMetaData::parseMetaData(const ossimFilename& data_file)
       return false;
    }
 
-   char* strptr;
-   char dummy[80], name[80];
-   double value;
-
-   //---
-   // Read the file into a buffer:
-   //---
-   ossim_int32 fileSize = static_cast<ossim_int32>(data_file.fileSize());
-   char* filebuf = new char[fileSize];
-   fread(filebuf, 1, fileSize, fptr);
-   fclose(fptr);
-
-   //---
-   // Production date:
-   //---
-   strptr = strstr(filebuf, "\nCreation Date:");
-   if (!strptr)
-   {
-      if(traceDebug())
-      {
-         ossimNotify(ossimNotifyLevel_FATAL)
-            << "FATAL ossimIkonosRpcModel::parseMetaData(data_file): "
-            << "\n\tAborting construction. Error encountered parsing "
-            << "presumed meta-data file." << std::endl;
-      }
-      delete [] filebuf;
-      return false;
-   }
-
-   sscanf(strptr, "%15c %s", dummy, name);
-   theProductionDate = name;
-
-   //***
-   // Sensor Type:
-   //***
-   strptr = strstr(strptr, "\nSensor:");
-   if (!strptr)
+   for (ossim_uint32 i = 0; i < 7; ++i)
    {
-      if(traceDebug())
-      { 
-         ossimNotify(ossimNotifyLevel_FATAL)
-            << "FATAL ossimIkonosRpcModel::parseMetaData(data_file): "
-            << "\n\tAborting construction. Error encountered parsing "
-            << "presumed meta-data file." << std::endl;
-      }
-      delete [] filebuf;
-      return false;
-   }
-
-   sscanf(strptr, "%8c %s", dummy, name);
-   theSensorID = name;
-
-
-   //***
-   // Nominal Azimuth:
-   //***
-   strptr = strstr(strptr, "\nNominal Collection Azimuth:");
-   if (!strptr)
-   {
-      if(traceDebug())
+      if ( values[i].empty() || ( (i == 6) && (values[i].size() < 2) ) )
       {
-         ossimNotify(ossimNotifyLevel_FATAL)
-            << "FATAL ossimIkonosRpcModel::parseMetaData(data_file): "
-            << "\n\tAborting construction. Error encountered parsing "
-            << "presumed meta-data file." << std::endl;
-      }
-      delete [] filebuf;
-      return false;
-   }
-
-   sscanf(strptr, "%28c %lf %s", dummy, &value, dummy);
-   theNominalCollectionAzimuth = value;
-
-   //***
-   // Nominal Elevation:
-   //***
-   strptr = strstr(strptr, "\nNominal Collection Elevation:");
-   if (!strptr)
-   {
-      if(traceDebug())
-      {
-         ossimNotify(ossimNotifyLevel_FATAL)
-            << "FATAL ossimIkonosRpcModel::parseMetaData(data_file): "
-            << "\n\tAborting construction. Error encountered parsing "
-            << "presumed meta-data file." << std::endl;
-      }
-      delete [] filebuf;
-      return false;
-   }
-  
-   sscanf(strptr, "%31c %lf %s", dummy, &value, dummy);
-   theNominalCollectionElevation = value;
-
-   //***
-   // Sun Azimuth:
-   //***
-   strptr = strstr(strptr, "\nSun Angle Azimuth:");
-   if (!strptr)
-   {
-      if(traceDebug())
-      {
-         ossimNotify(ossimNotifyLevel_FATAL)
-            << "FATAL ossimIkonosRpcModel::parseMetaData(data_file): "
-            << "\n\tAborting construction. Error encountered parsing "
-            << "presumed meta-data file." << std::endl;
-      }
-      delete [] filebuf;
-      return false;
-   }
-
-   sscanf(strptr, "%19c %lf %s", dummy, &value, dummy);
-   theSunAzimuth = value;
-
-   //***
-   // Sun Elevation:
-   //***
-   strptr = strstr(strptr, "\nSun Angle Elevation:");
-   if (!strptr)
-   {
-      if(traceDebug())
-      {
-         ossimNotify(ossimNotifyLevel_FATAL)
-            << "FATAL ossimIkonosRpcModel::parseMetaData(data_file): "
-            << "\n\tAborting construction. Error encountered parsing "
-            << "presumed meta-data file." << std::endl;
-      }
-      delete [] filebuf;
-      return false;
-   }
-
-   sscanf(strptr, "%21c %lf %s", dummy, &value, name);
-   theSunElevation = value;
-
-   //---
-   // Acquisition date and time:
-   //---
-   strptr = strstr(filebuf, "\nAcquisition Date/Time:");
-   if (!strptr)
-   {
-      if(traceDebug())
-      {
-      ossimNotify(ossimNotifyLevel_FATAL)
-          << "FATAL ossimIkonosRpcModel::parseMetaData(data_file): "
-          << "\n\tAborting construction. Error encountered parsing "
-          << "presumed meta-data file." << std::endl;
+         if(traceDebug())
+         {
+            ossimNotify(ossimNotifyLevel_FATAL)
+               << "FATAL ossimIkonosRpcModel::parseMetaData(data_file): "
+               << "\n\tAborting construction. Error encountered parsing "
+               << "presumed meta-data file." << std::endl;
+         }
+         return false;
       }
-      delete [] filebuf;
-      return false;
    }
 
-   char name2[80];
-   sscanf(strptr, "%23c %s %s", dummy, name, name2);
-   theAcquisitionDate = name;
-   theAcquisitionTime = name2;
-
-   delete [] filebuf;
-   filebuf = 0;
+   theProductionDate             = values[0][0];
+   theSensorID                   = values[1][0];
+   theNominalCollectionAzimuth   = values[2][0].toDouble();
+   theNominalCollectionElevation = values[3][0].toDouble();
+   theSunAzimuth                 = values[4][0].toDouble();
+   theSunElevation               = values[5][0].toDouble();
+   theAcquisitionDate            = values[6][0];
+   theAcquisitionTime            = values[6][1];
 
    if (traceExec())
    {
@@ -512,8 +435,9 @@ bool ossimIkonosMetaData::parseHdrData(const ossimFilename& data_file)
          << std::endl;
    }
 
-   FILE* fptr = fopen (data_file, "r");
-   if (!fptr)
+   static const char* const NAMES[] = { "Band:", "Number of Bands:" };
+   std::vector< std::vector<ossimString> > values;
+   if ( !readNamedValues(data_file, NAMES, 2, values) )
    {
       if (traceDebug())
       {
@@ -525,44 +449,7 @@ bool ossimIkonosMetaData::parseHdrData(const ossimFilename& data_file)
       return false;
    }
 
-   char* strptr;
-   // char linebuf[80];
-   char dummy[80];
-   char name[80];
-   int value=0;
-
-   //***
-   // Read the file into a buffer:
-   //***
-   char filebuf[5000];
-   fread(filebuf, 1, 5000, fptr);
-   fclose(fptr);
-
-   //***
-   // Band name:
-   //***
-   strptr = strstr(filebuf, "\nBand:");
-   if (!strptr)
-   {
-      if(traceDebug())
-      {
-         ossimNotify(ossimNotifyLevel_WARN)
-            << "ossimIkonosRpcModel::parseHdrData(data_file):"
-            << "\n\tAborting construction. Error encountered parsing "
-            << "presumed hdr file." << std::endl;
-      }
-
-      return false;
-   }
-
-   sscanf(strptr, "%6c %s", dummy, name);
-   theBandName = name;
-
-   //***
-   // Number of Bands:
-   //***
-   strptr = strstr(filebuf, "\nNumber of Bands:");
-   if (!strptr)
+   if ( values[0].empty() || values[1].empty() )
    {
       if(traceDebug())
       {
@@ -575,8 +462,8 @@ bool ossimIkonosMetaData::parseHdrData(const ossimFilename& data_file)
       return false;
    }
 
-   sscanf(strptr, "%17c %d", dummy, &value);
-   theNumBands = value;
+   theBandName = values[0][0];
+   theNumBands = values[1][0].toUInt32();
 
    if (traceExec())
    {
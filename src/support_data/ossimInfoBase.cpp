@@ -13,6 +13,7 @@
 
 #include <ossim/support_data/ossimInfoBase.h>
 #include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimKeywordNames.h>
 #include <sstream>
 
 ossimInfoBase::ossimInfoBase()
@@ -42,3 +43,24 @@ bool ossimInfoBase::getKeywordlist(ossimKeywordlist& kwl)const
    // Give the result to the keyword list.
    return kwl.parseStream(in);
 }
+
+bool ossimInfoBase::getImageSummary(ossimKeywordlist& /* kwl */,
+                                    const std::string& /* prefix */) const
+{
+   return false;
+}
+
+void ossimInfoBase::addImageSummary(ossimKeywordlist& kwl,
+                                    const std::string& prefix,
+                                    ossim_uint32 entry,
+                                    ossim_uint32 lines,
+                                    ossim_uint32 samples,
+                                    ossim_uint32 bands) const
+{
+   std::ostringstream s;
+   s << prefix << "image" << entry << ".";
+   const std::string PFX = s.str();
+   kwl.add(PFX.c_str(), ossimKeywordNames::NUMBER_LINES_KW, lines);
+   kwl.add(PFX.c_str(), ossimKeywordNames::NUMBER_SAMPLES_KW, samples);
+   kwl.add(PFX.c_str(), ossimKeywordNames::NUMBER_BANDS_KW, bands);
+}
@@ -10,6 +10,8 @@
 // $Id$
 
 #include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/support_data/ossimInfoBase.h>
 #include <ossim/support_data/ossimInfoFactoryRegistry.h>
 #include <ossim/support_data/ossimInfoFactoryInterface.h>
 #include <ossim/support_data/ossimInfoFactory.h>
@@ -89,6 +91,20 @@ ossimInfoBase* ossimInfoFactoryRegistry::create(
    return result;
 }
 
+bool ossimInfoFactoryRegistry::getImageSummary(const ossimFilename& file,
+                                               ossimKeywordlist& kwl,
+                                               const std::string& prefix) const
+{
+   bool result = false;
+   ossimRefPtr<ossimInfoBase> info = create(file);
+   if ( info.valid() )
+   {
+      info->setProcessOverviewFlag(false);
+      result = info->getImageSummary(kwl, prefix);
+   }
+   return result;
+}
+
 /** hidden from use default constructor */
 ossimInfoFactoryRegistry::ossimInfoFactoryRegistry()
    : m_factoryList(),
@@ -14,12 +14,15 @@
 #include <ossim/support_data/ossimJ2kInfo.h>
 #include <ossim/base/ossimCommon.h>
 #include <ossim/base/ossimEndian.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimNotify.h>
 #include <ossim/base/ossimTrace.h>
 // #include <ossim/support_data/ossimJ2kCommon.h>
 #include <ossim/support_data/ossimJ2kCodRecord.h>
 #include <ossim/support_data/ossimJ2kSizRecord.h>
 #include <ossim/support_data/ossimJ2kSotRecord.h>
+#include <ossim/support_data/ossimJ2kTileIndex.h>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
@@ -156,6 +159,37 @@ std::ostream& ossimJ2kInfo::print(std::ostream& out) const
    return out;
 }
 
+bool ossimJ2kInfo::getImageSummary(ossimKeywordlist& kwl, const std::string& prefix) const
+{
+   bool result = false;
+   if ( m_file.size() )
+   {
+      std::ifstream str(m_file.c_str(), std::ios_base::binary|std::ios_base::in);
+      if ( str.good() )
+      {
+         ossim_uint16 marker;
+         readUInt16(marker, str); // SOC
+         readUInt16(marker, str); // SIZ
+
+         ossimJ2kSizRecord siz;
+         siz.parseStream(str);
+         if ( str.good() )
+         {
+            addImageSummary( kwl, prefix, 0, siz.m_Ysiz - siz.m_YOsiz,
+                             siz.m_Xsiz - siz.m_XOsiz, siz.m_Csiz );
+            kwl.add( prefix.c_str(), ossimKeywordNames::NUMBER_ENTRIES_KW, 1 );
+            result = true;
+         }
+      }
+   }
+   return result;
+}
+
+bool ossimJ2kInfo::getTileIndex(ossimJ2kTileIndex& index) const
+{
+   return m_file.size() ? index.open(m_file, 0) : false;
+}
+
 void ossimJ2kInfo::readUInt16(ossim_uint16& s, std::ifstream& str) const
 {
    str.read((char*)&s, 2);
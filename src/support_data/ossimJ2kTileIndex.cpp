@@ -0,0 +1,433 @@
+//----------------------------------------------------------------------------
+//
+// License:  LGPL
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description: Offsets of the tile-parts of a JPEG 2000 codestream.
+//
+//----------------------------------------------------------------------------
+// $Id$
+
+#include <ossim/support_data/ossimJ2kTileIndex.h>
+#include <ossim/base/ossimDate.h>
+#include <ossim/base/ossimFileBlockCache.h>
+#include <ossim/base/ossimMemoryMappedFile.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTrace.h>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+
+static ossimTrace traceDebug("ossimJ2kTileIndex:debug");
+
+namespace
+{
+   const ossim_uint16 SOC_MARKER = 0xff4f; // start of codestream
+   const ossim_uint16 TLM_MARKER = 0xff55; // tile-part lengths
+   const ossim_uint16 SOT_MARKER = 0xff90; // start of tile-part
+   const ossim_uint16 EOC_MARKER = 0xffd9; // end of codestream
+
+   // SOT marker segment: marker, Lsot, Isot, Psot, TPsot, TNsot.
+   const ossim_uint32 SOT_SIZE = 12;
+
+   // Index file: magic, image modification time and size, codestream offset,
+   // tile-part count, TLM flag, then the TilePart records.
+   const char INDEX_MAGIC[16] = "OSSIMJ2KTPI1";
+   const ossim_uint64 INDEX_HEADER_SIZE = 56;
+
+   ossim_uint16 getUInt16(const ossim_uint8* p)
+   {
+      return static_cast<ossim_uint16>( (p[0] << 8) | p[1] );
+   }
+
+   ossim_uint32 getUInt32(const ossim_uint8* p)
+   {
+      return ( (static_cast<ossim_uint32>(p[0]) << 24) |
+               (static_cast<ossim_uint32>(p[1]) << 16) |
+               (static_cast<ossim_uint32>(p[2]) << 8) |
+               static_cast<ossim_uint32>(p[3]) );
+   }
+
+   // Modification time and size, to tell if an index is older than its image.
+   bool getFileStamp(const ossimFilename& file, ossim_int64& modTime, ossim_int64& size)
+   {
+      ossimLocalTm t;
+      if ( !file.getTimes(0, &t, 0) )
+      {
+         return false;
+      }
+      modTime = (ossim_int64)(time_t)t;
+      size    = file.fileSize();
+      return true;
+   }
+}
+
+ossimJ2kTileIndex::ossimJ2kTileIndex()
+   : m_file(),
+     m_tlmFlag(false),
+     m_tileParts()
+{
+}
+
+bool ossimJ2kTileIndex::open(const ossimFilename& file, ossim_uint64 codestreamOffset)
+{
+   const ossimFilename INDEX_FILE = getIndexFile(file);
+   m_file = file;
+   if ( INDEX_FILE.size() && load(INDEX_FILE, codestreamOffset) )
+   {
+      return true;
+   }
+
+   bool result = build(file, codestreamOffset);
+   if ( result && INDEX_FILE.size() )
+   {
+      save(INDEX_FILE, codestreamOffset);
+   }
+   return result;
+}
+
+bool ossimJ2kTileIndex::build(const ossimFilename& file, ossim_uint64 codestreamOffset)
+{
+   m_file = file;
+   m_tlmFlag = false;
+   m_tileParts.clear();
+
+   ossimRefPtr<ossimFileBlockCache> cache = new ossimFileBlockCache(file);
+   ossim_uint8 buf[4];
+   if ( (cache->read(codestreamOffset, (char*)buf, 2) != 2) || (getUInt16(buf) != SOC_MARKER) )
+   {
+      return false;
+   }
+
+   // Main header: marker segments up to the first SOT.
+   std::map<ossim_uint8, std::string> tlm;
+   ossim_uint64 pos = codestreamOffset + 2;
+   while ( true )
+   {
+      if ( cache->read(pos, (char*)buf, 4) != 4 )
+      {
+         return false;
+      }
+      const ossim_uint16 MARKER = getUInt16(buf);
+      const ossim_uint16 LENGTH = getUInt16(buf + 2);
+      if ( MARKER == SOT_MARKER )
+      {
+         break;
+      }
+      if ( ( (MARKER >> 8) != 0xff ) || (LENGTH < 2) )
+      {
+         return false;
+      }
+      if ( (MARKER == TLM_MARKER) && (LENGTH > 4) )
+      {
+         // Ztlm, Stlm and the lengths:
+         std::string segment(LENGTH - 2, '\0');
+         if ( cache->read(pos + 4, &segment[0], segment.size()) != segment.size() )
+         {
+            return false;
+         }
+         tlm[ static_cast<ossim_uint8>(segment[0]) ] = segment;
+      }
+      pos += 2 + LENGTH;
+   }
+
+   if ( tlm.size() && buildFromTlm(cache.get(), pos, tlm) )
+   {
+      m_tlmFlag = true;
+   }
+   else
+   {
+      m_tileParts.clear();
+      if ( !buildFromSot(cache.get(), pos) )
+      {
+         m_tileParts.clear();
+         return false;
+      }
+   }
+
+   if (traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimJ2kTileIndex::build: " << file << " tile-parts: " << m_tileParts.size()
+         << (m_tlmFlag ? " from TLM" : " from SOT") << " file reads: "
+         << cache->getNumberOfFileReads() << std::endl;
+   }
+   return m_tileParts.size() > 0;
+}
+
+bool ossimJ2kTileIndex::buildFromTlm(ossimFileBlockCache* cache, ossim_uint64 firstSot,
+                                     const std::map<ossim_uint8, std::string>& tlm)
+{
+   std::vector<ossim_uint8> partCounts;
+   ossim_uint64 offset = firstSot;
+
+   std::map<ossim_uint8, std::string>::const_iterator i = tlm.begin();
+   for ( ; i != tlm.end(); ++i )
+   {
+      const ossim_uint8* p   = reinterpret_cast<const ossim_uint8*>(i->second.data());
+      const ossim_uint8* end = p + i->second.size();
+      const ossim_uint8 STLM = p[1];
+      const ossim_uint32 ST = (STLM >> 4) & 0x3; // Bytes of Ttlm.
+      const ossim_uint32 SP = (STLM >> 6) & 0x1; // Ptlm is 4 bytes if set, else 2.
+      if ( ST == 3 )
+      {
+         return false;
+      }
+      const ossim_uint32 RECORD_SIZE = ST + (SP ? 4 : 2);
+      for ( p += 2; p + RECORD_SIZE <= end; p += RECORD_SIZE )
+      {
+         TilePart part;
+         // With no Ttlm each tile is one tile-part, in order.
+         part.m_tile   = static_cast<ossim_uint16>( (ST == 0) ? m_tileParts.size() :
+                                                    (ST == 1) ? p[0] : getUInt16(p) );
+         part.m_length = SP ? getUInt32(p + ST) : getUInt16(p + ST);
+         part.m_offset = offset;
+         part.m_parts  = 0;
+         if ( part.m_tile >= partCounts.size() )
+         {
+            partCounts.resize(part.m_tile + 1, 0);
+         }
+         part.m_part = partCounts[part.m_tile]++;
+         if ( part.m_length < SOT_SIZE )
+         {
+            return false;
+         }
+         offset += part.m_length;
+         m_tileParts.push_back(part);
+      }
+   }
+
+   // Check the first and last tile-parts are where the lengths put them.
+   ossim_uint8 buf[SOT_SIZE];
+   if ( m_tileParts.empty() || (offset > cache->getSize()) )
+   {
+      return false;
+   }
+   const TilePart* CHECK[2] = { &m_tileParts.front(), &m_tileParts.back() };
+   for ( ossim_uint32 c = 0; c < 2; ++c )
+   {
+      if ( (cache->read(CHECK[c]->m_offset, (char*)buf, SOT_SIZE) != SOT_SIZE) ||
+           (getUInt16(buf) != SOT_MARKER) || (getUInt16(buf + 4) != CHECK[c]->m_tile) ||
+           ( (getUInt32(buf + 6) != CHECK[c]->m_length) &&
+             ( c == 0 || getUInt32(buf + 6) ) ) ) // Psot of the last may be 0.
+      {
+         if (traceDebug())
+         {
+            ossimNotify(ossimNotifyLevel_DEBUG)
+               << "ossimJ2kTileIndex::buildFromTlm: TLM does not match " << m_file
+               << ", reading SOT markers." << std::endl;
+         }
+         return false;
+      }
+   }
+   return true;
+}
+
+bool ossimJ2kTileIndex::buildFromSot(ossimFileBlockCache* cache, ossim_uint64 firstSot)
+{
+   const ossim_uint64 SIZE = cache->getSize();
+   ossim_uint64 pos = firstSot;
+   ossim_uint8 buf[SOT_SIZE];
+   while ( cache->read(pos, (char*)buf, 2) == 2 )
+   {
+      const ossim_uint16 MARKER = getUInt16(buf);
+      if ( MARKER == EOC_MARKER )
+      {
+         break;
+      }
+      if ( (MARKER != SOT_MARKER) || (cache->read(pos, (char*)buf, SOT_SIZE) != SOT_SIZE) )
+      {
+         return false;
+      }
+
+      TilePart part;
+      part.m_offset = pos;
+      part.m_tile   = getUInt16(buf + 4);
+      part.m_length = getUInt32(buf + 6);
+      part.m_part   = buf[10];
+      part.m_parts  = buf[11];
+      if ( part.m_length == 0 )
+      {
+         // Last tile-part, up to the EOC marker.
+         const ossim_uint64 END = (SIZE >= pos + 2) ? SIZE - 2 : pos;
+         part.m_length = static_cast<ossim_uint32>(END - pos);
+         m_tileParts.push_back(part);
+         break;
+      }
+      if ( part.m_length < SOT_SIZE )
+      {
+         return false;
+      }
+      m_tileParts.push_back(part);
+      pos += part.m_length;
+   }
+   return m_tileParts.size() > 0;
+}
+
+bool ossimJ2kTileIndex::getTlmFlag() const
+{
+   return m_tlmFlag;
+}
+
+const std::vector<ossimJ2kTileIndex::TilePart>& ossimJ2kTileIndex::getTileParts() const
+{
+   return m_tileParts;
+}
+
+bool ossimJ2kTileIndex::getTileParts(ossim_uint32 tile, std::vector<TilePart>& parts) const
+{
+   parts.clear();
+   for ( std::vector<TilePart>::const_iterator i = m_tileParts.begin();
+         i != m_tileParts.end(); ++i )
+   {
+      if ( i->m_tile == tile )
+      {
+         parts.push_back(*i);
+      }
+   }
+   return parts.size() > 0;
+}
+
+ossim_uint32 ossimJ2kTileIndex::getNumberOfTiles() const
+{
+   ossim_uint32 result = 0;
+   for ( std::vector<TilePart>::const_iterator i = m_tileParts.begin();
+         i != m_tileParts.end(); ++i )
+   {
+      if ( i->m_tile >= result )
+      {
+         result = i->m_tile + 1;
+      }
+   }
+   return result;
+}
+
+ossimFilename ossimJ2kTileIndex::getIndexFile(const ossimFilename& file)
+{
+   ossimFilename result;
+   const char* lookup = ossimPreferences::instance()->findPreference("j2k.tile_index");
+   if ( file.empty() || ( lookup && !ossimString(lookup).toBool() ) )
+   {
+      return result;
+   }
+
+   lookup = ossimPreferences::instance()->findPreference("j2k.tile_index_directory");
+   if ( lookup && *lookup )
+   {
+      // Name the index after the whole path.
+      ossimString name = file.expand();
+      name.gsub(ossimString("/"), ossimString("_"), true);
+      name.gsub(ossimString("\\"), ossimString("_"), true);
+      name.gsub(ossimString(":"), ossimString("_"), true);
+      result = ossimFilename(lookup).expand().dirCat( ossimFilename(name + ".tpi") );
+   }
+   else
+   {
+      result = file + ".tpi";
+   }
+   return result;
+}
+
+std::ostream& ossimJ2kTileIndex::print(std::ostream& out, const std::string& prefix) const
+{
+   std::string pfx = prefix;
+   pfx += "tile_index.";
+
+   out << pfx << "source: " << (m_tlmFlag ? "tlm" : "sot") << "\n"
+       << pfx << "tiles: " << getNumberOfTiles() << "\n"
+       << pfx << "tile_parts: " << m_tileParts.size() << std::endl;
+   return out;
+}
+
+bool ossimJ2kTileIndex::load(const ossimFilename& indexFile, ossim_uint64 codestreamOffset)
+{
+   ossim_int64 modTime = 0;
+   ossim_int64 size = 0;
+   if ( !indexFile.exists() || !getFileStamp(m_file, modTime, size) )
+   {
+      return false;
+   }
+
+   ossimRefPtr<ossimMemoryMappedFile> map = new ossimMemoryMappedFile();
+   if ( !map->open(indexFile) || (map->size() < INDEX_HEADER_SIZE) ||
+        memcmp(map->data(), INDEX_MAGIC, sizeof(INDEX_MAGIC)) )
+   {
+      return false;
+   }
+
+   const ossim_uint8* data = map->data();
+   ossim_int64 stamp[2];
+   ossim_uint64 fields[3]; // codestream offset, count, TLM flag
+   memcpy(stamp, data + 16, sizeof(stamp));
+   memcpy(fields, data + 32, sizeof(fields));
+
+   // The image is the reference; an index older than it is built again.
+   if ( (stamp[0] != modTime) || (stamp[1] != size) || (fields[0] != codestreamOffset) ||
+        (map->size() != INDEX_HEADER_SIZE + fields[1] * sizeof(TilePart)) )
+   {
+      return false;
+   }
+
+   m_tlmFlag = (fields[2] != 0);
+   m_tileParts.resize( static_cast<std::size_t>(fields[1]) );
+   if ( m_tileParts.size() )
+   {
+      memcpy(&m_tileParts.front(), data + INDEX_HEADER_SIZE,
+             m_tileParts.size() * sizeof(TilePart));
+   }
+
+   if (traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimJ2kTileIndex::load: " << indexFile << " tile-parts: "
+         << m_tileParts.size() << std::endl;
+   }
+   return m_tileParts.size() > 0;
+}
+
+void ossimJ2kTileIndex::save(const ossimFilename& indexFile, ossim_uint64 codestreamOffset) const
+{
+   ossim_int64 stamp[2];
+   if ( !getFileStamp(m_file, stamp[0], stamp[1]) )
+   {
+      return;
+   }
+   const ossim_uint64 FIELDS[3] = { codestreamOffset, m_tileParts.size(), static_cast<ossim_uint64>(m_tlmFlag ? 1 : 0) };
+
+   ossimFilename indexDir = indexFile.path();
+   if ( indexDir.size() && !indexDir.exists() )
+   {
+      indexDir.createDirectory();
+   }
+
+   // Write and rename, so a partial index is never loaded.
+   const ossimFilename TMP_FILE = indexFile + ".tmp";
+   std::ofstream out(TMP_FILE.c_str(), std::ios::out|std::ios::binary|std::ios::trunc);
+   if ( !out.good() )
+   {
+      return;
+   }
+   out.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+   out.write((const char*)stamp, sizeof(stamp));
+   out.write((const char*)FIELDS, sizeof(FIELDS));
+   if ( m_tileParts.size() )
+   {
+      out.write((const char*)&m_tileParts.front(), m_tileParts.size() * sizeof(TilePart));
+   }
+   out.close();
+
+   if ( out.fail() || !TMP_FILE.rename(indexFile, true) )
+   {
+      TMP_FILE.remove();
+   }
+   else if (traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimJ2kTileIndex::save: wrote " << indexFile << std::endl;
+   }
+}
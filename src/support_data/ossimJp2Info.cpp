@@ -18,6 +18,7 @@
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimTrace.h>
 // #include <ossim/support_data/ossimJ2kCommon.h>
+#include <ossim/support_data/ossimJ2kTileIndex.h>
 #include <ossim/support_data/ossimTiffInfo.h>
 #include <fstream>
 #include <istream>
@@ -316,6 +317,23 @@ std::streamoff ossimJp2Info::findBoxData( const ossim_uint32& type,
    return dataPosOfType;
 }
 
+bool ossimJp2Info::getTileIndex(ossimJ2kTileIndex& index) const
+{
+   bool result = false;
+   if ( m_file.size() )
+   {
+      std::ifstream str( m_file.c_str(), std::ios_base::in | std::ios_base::binary );
+      const ossim_uint32 JP2C_TYPE = 0x6a703263; // jp2c
+      ossim_uint32 length = 0;
+      std::streamoff pos = findBoxData( JP2C_TYPE, str, length );
+      if ( pos > 0 )
+      {
+         result = index.open( m_file, static_cast<ossim_uint64>(pos) );
+      }
+   }
+   return result;
+}
+
 std::streamoff ossimJp2Info::getBox( const ossim_uint32 type,
                                      bool includeAll,
                                      std::vector<ossim_uint8>& box ) const
@@ -501,6 +501,11 @@ ossim_uint8 ossimLasHdr::getPointDataFormatId() const
    return m_pointDataFormatId;
 }
 
+ossim_uint16 ossimLasHdr::getPointDataRecordLength() const
+{
+   return m_pointDataRecordLength;
+}
+
 ossim_uint64 ossimLasHdr::getNumberOfPoints() const
 {
    return m_numberOfPointRecords;
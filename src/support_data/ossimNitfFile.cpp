@@ -22,6 +22,7 @@
 #include <ossim/support_data/ossimNitfRegisteredTag.h>
 #include <ossim/support_data/ossimRpfToc.h>
 #include <ossim/base/ossimTrace.h>
+#include <ossim/base/ossimFileBlockCache.h>
 #include <ossim/base/ossimFilename.h>
 #include <ossim/base/ossimNotify.h>
 #include <ossim/base/ossimIoStream.h>
@@ -154,7 +155,8 @@ bool ossimNitfFile::saveState(ossimKeywordlist& kwl, const ossimString& prefix)c
 
 ossimNitfFile::ossimNitfFile()
    : theFilename(""),
-     theNitfFileHeader(0)
+     theNitfFileHeader(0),
+     theHeaderCache(0)
 {
 }
 
@@ -173,14 +175,15 @@ bool ossimNitfFile::parseFile(const ossimFilename& file)
          << std::endl;
    }
    if(!file.exists()) return false;
-   // this currently crashes if the open fails so I am going back to
-   // using ifstream instead of this one
-   //
 
-   //ossimIFStream64 in(file.c_str(), std::ios::in|std::ios::binary);
-
-   std::ifstream in(file.c_str(), std::ios::in|std::ios::binary);
-   if (in.fail())
+   //---
+   // Headers are parsed from blocks read in large chunks and kept for the
+   // subheaders, rather than field by field from the file.
+   //---
+   theHeaderCache = new ossimFileBlockCache(file);
+   ossimFileBlockStreamBuffer buffer(theHeaderCache.get());
+   std::istream in(&buffer);
+   if (theHeaderCache->getSize() == 0)
    {
       if (traceDebug())
       {
@@ -321,9 +324,9 @@ ossimNitfImageHeader* ossimNitfFile::getNewImageHeader(
    {
       try // getNewImageHeader can throw exception on parse.
       {
-         std::ifstream in(theFilename.c_str(), std::ios::in|std::ios::binary);
+         ossimFileBlockStreamBuffer buffer(getHeaderCache());
+         std::istream in(&buffer);
          result = theNitfFileHeader->getNewImageHeader(imageNumber, in);
-         in.close();
       }
       catch( const ossimException& e )
       {
@@ -346,10 +349,10 @@ ossimNitfSymbolHeader* ossimNitfFile::getNewSymbolHeader(
    ossimNitfSymbolHeader* result = 0;
    if(theNitfFileHeader.valid())
    {
-      std::ifstream in(theFilename.c_str(), std::ios::in|std::ios::binary);
+      ossimFileBlockStreamBuffer buffer(getHeaderCache());
+      std::istream in(&buffer);
 
       result = theNitfFileHeader->getNewSymbolHeader(symbolNumber, in);
-      in.close();
    }
    
    return result;
@@ -361,10 +364,10 @@ ossimNitfLabelHeader* ossimNitfFile::getNewLabelHeader(
    ossimNitfLabelHeader* result = 0;
    if(theNitfFileHeader.valid())
    {
-      std::ifstream in(theFilename.c_str(), std::ios::in|std::ios::binary);
+      ossimFileBlockStreamBuffer buffer(getHeaderCache());
+      std::istream in(&buffer);
 
       result = theNitfFileHeader->getNewLabelHeader(labelNumber, in);
-      in.close();
    }
    
    return result;
@@ -376,10 +379,10 @@ ossimNitfTextHeader* ossimNitfFile::getNewTextHeader(
    ossimNitfTextHeader* result = 0;
    if(theNitfFileHeader.valid())
    {
-      std::ifstream in(theFilename.c_str(), std::ios::in|std::ios::binary);
+      ossimFileBlockStreamBuffer buffer(getHeaderCache());
+      std::istream in(&buffer);
 
       result = theNitfFileHeader->getNewTextHeader(textNumber, in);
-      in.close();
    }
    
    return result;
@@ -391,15 +394,29 @@ ossimNitfDataExtensionSegment* ossimNitfFile::getNewDataExtensionSegment(
    ossimNitfDataExtensionSegment* result = 0;
    if(theNitfFileHeader.valid())
    {
-      std::ifstream in(theFilename.c_str(), std::ios::in|std::ios::binary);
+      ossimFileBlockStreamBuffer buffer(getHeaderCache());
+      std::istream in(&buffer);
 
       result = theNitfFileHeader->getNewDataExtensionSegment(dataExtNumber, in);
-      in.close();
    }
    
    return result;
 }
 
+ossimFileBlockCache* ossimNitfFile::getHeaderCache()const
+{
+   if ( !theHeaderCache.valid() )
+   {
+      theHeaderCache = new ossimFileBlockCache(theFilename);
+   }
+   return theHeaderCache.get();
+}
+
+void ossimNitfFile::releaseHeaderCache()
+{
+   theHeaderCache = 0;
+}
+
 ossimString ossimNitfFile::getVersion()const
 {
    if(theNitfFileHeader.valid())
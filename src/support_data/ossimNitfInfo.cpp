@@ -12,6 +12,11 @@
 #include <iostream>
 
 #include <ossim/support_data/ossimNitfInfo.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimKeywordNames.h>
+#include <ossim/support_data/ossimNitfFileHeader.h>
+#include <ossim/support_data/ossimNitfImageHeader.h>
+#include <sstream>
 
 ossimNitfInfo::ossimNitfInfo()
    : m_nitfFile(0)
@@ -47,6 +52,34 @@ std::ostream& ossimNitfInfo::print(std::ostream& out) const
    return out;
 }
 
+bool ossimNitfInfo::getImageSummary(ossimKeywordlist& kwl, const std::string& prefix) const
+{
+   bool result = false;
+   if ( m_nitfFile.valid() && m_nitfFile->getHeader() )
+   {
+      const ossim_int32 IMAGES = m_nitfFile->getHeader()->getNumberOfImages();
+      for ( ossim_int32 i = 0; i < IMAGES; ++i )
+      {
+         ossimRefPtr<ossimNitfImageHeader> ih = m_nitfFile->getNewImageHeader(i);
+         if ( !ih.valid() )
+         {
+            continue;
+         }
+         addImageSummary( kwl, prefix, i, ih->getNumberOfRows(), ih->getNumberOfCols(),
+                          ih->getNumberOfBands() );
+
+         // Corners as stored; decoding them is left to the projection factory.
+         std::ostringstream s;
+         s << prefix << "image" << i << ".";
+         kwl.add( s.str().c_str(), "icords", ih->getCoordinateSystem().trim().c_str() );
+         kwl.add( s.str().c_str(), "igeolo", ih->getGeographicLocation().trim().c_str() );
+      }
+      kwl.add( prefix.c_str(), ossimKeywordNames::NUMBER_ENTRIES_KW, IMAGES );
+      result = true;
+   }
+   return result;
+}
+
 bool ossimNitfInfo::getKeywordlist(ossimKeywordlist& kwl)const
 {
    bool result = false;
@@ -13,11 +13,17 @@
 #include <ossim/base/ossimNotify.h>
 #include <ossim/support_data/ossimNitfTagFactoryRegistry.h>
 #include <ossim/support_data/ossimNitfUnknownTag.h>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
 #include <sstream>
 #include <iomanip>
 #include <cstring> // for memset
 
+// Guards the first parse of the tags shared by copies.
+static OpenThreads::Mutex theTagDataMutex;
+
 ossimNitfTagInformation::ossimNitfTagInformation(ossimRefPtr<ossimNitfRegisteredTag> tagData)
+   : theTagData(0)
 {
    clearFields();
    setTagData(tagData);
@@ -37,43 +43,66 @@ void ossimNitfTagInformation::parseStream(std::istream &in)
       in.read(theTagLength, 5);
       theTagDataOffset = in.tellg();
 
-      theTagData = ossimNitfTagFactoryRegistry::instance()->create(getTagName());
+      // Keep the bytes; parseTagData() makes the tag on first access.
+      theTagData = new TagData();
+      theTagData->theParsedFlag = false;
+      const ossim_uint32 LENGTH = getTagLength();
+      if ( in && LENGTH )
+      {
+         theTagData->theBytes.resize(LENGTH);
+         in.read(&theTagData->theBytes.front(), LENGTH);
+         theTagData->theBytes.resize( static_cast<std::size_t>(in.gcount()) );
+      }
+   }
+}
+
+void ossimNitfTagInformation::parseTagData()const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theTagDataMutex);
+   if ( !theTagData.valid() || theTagData->theParsedFlag )
+   {
+      return;
+   }
+
+   ossimRefPtr<ossimNitfRegisteredTag> tag =
+      ossimNitfTagFactoryRegistry::instance()->create(getTagName());
 
-      if (theTagData.valid())
+   if (tag.valid())
+   {
+      if (tag->getClassName() == "ossimNitfUnknownTag")
       {
-         if (theTagData->getClassName() == "ossimNitfUnknownTag")
-         {
-            // Unknown tag doesn't know his tag name yet.
-            theTagData->setTagName( getTagName() );
-         }
+         // Unknown tag doesn't know his tag name yet.
+         tag->setTagName( getTagName() );
+      }
 
-         //---
-         // Tags with dynamic tag length construct with 0 length.
-         // Set if 0.
-         //---
-         if ( theTagData->getTagLength() == 0 )
-         {
-            theTagData->setTagLength( getTagLength() );
-         }
-         // Sanity check fixed length in code with length from CEL field:
-         else if ( theTagData->getTagLength() != getTagLength() )
-         {
-            ossimNotify(ossimNotifyLevel_WARN)
-               << "ossimNitfTagInformation::parseStream WARNING!"
-               << "\nCEL field length does not match fixed tag length for tag: "
-               << theTagData->getTagName().c_str()
-               << "\nCEL: " << getTagLength()
-               << "\nTag: " << theTagData->getTagLength()
-               << std::endl;
-         }
-                               
-         theTagData->parseStream(in);
+      //---
+      // Tags with dynamic tag length construct with 0 length.
+      // Set if 0.
+      //---
+      if ( tag->getTagLength() == 0 )
+      {
+         tag->setTagLength( getTagLength() );
       }
-      else
+      // Sanity check fixed length in code with length from CEL field:
+      else if ( tag->getTagLength() != getTagLength() )
       {
-         theTagData = (ossimNitfRegisteredTag*)NULL;
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "ossimNitfTagInformation::parseStream WARNING!"
+            << "\nCEL field length does not match fixed tag length for tag: "
+            << tag->getTagName().c_str()
+            << "\nCEL: " << getTagLength()
+            << "\nTag: " << tag->getTagLength()
+            << std::endl;
       }
+
+      std::istringstream in( std::string( theTagData->theBytes.begin(),
+                                          theTagData->theBytes.end() ) );
+      tag->parseStream(in);
    }
+
+   theTagData->theTag = tag;
+   theTagData->theParsedFlag = true;
+   std::vector<char>().swap(theTagData->theBytes);
 }
 
 void ossimNitfTagInformation::writeStream(std::ostream &out)
@@ -84,7 +113,18 @@ void ossimNitfTagInformation::writeStream(std::ostream &out)
    if(theTagData.valid())
    {
       theTagDataOffset = out.tellp();
-      theTagData->writeStream(out);
+      if ( !isTagDataParsed() )
+      {
+         // Never accessed so unchanged; write the bytes read.
+         if ( theTagData->theBytes.size() )
+         {
+            out.write(&theTagData->theBytes.front(), theTagData->theBytes.size());
+         }
+      }
+      else if ( theTagData->theTag.valid() )
+      {
+         theTagData->theTag->writeStream(out);
+      }
    }
 }
 
@@ -170,27 +210,56 @@ void ossimNitfTagInformation::setTagLength(ossim_uint32 tagLength)
 
 ossimRefPtr<ossimNitfRegisteredTag> ossimNitfTagInformation::getTagData()
 {
-   return theTagData;
+   parseTagData();
+   return theTagData.valid() ? theTagData->theTag : ossimRefPtr<ossimNitfRegisteredTag>();
 }
 
 const ossimRefPtr<ossimNitfRegisteredTag> ossimNitfTagInformation::getTagData()const
 {
-   return theTagData;
+   parseTagData();
+   return theTagData.valid() ? theTagData->theTag : ossimRefPtr<ossimNitfRegisteredTag>();
 }
 
 void ossimNitfTagInformation::setTagData(ossimRefPtr<ossimNitfRegisteredTag> tagData)
 {
-   theTagData = tagData;
+   theTagData = new TagData();
+   theTagData->theTag = tagData;
 
    memset(theTagName, ' ', 6);
    memset(theTagLength, ' ', 5);
    
-   if(theTagData.valid())
+   if(tagData.valid())
+   {
+      setTagName(tagData->getRegisterTagName());
+      setTagLength(tagData->getSizeInBytes());
+   }
+}
+
+void ossimNitfTagInformation::getTagDataBytes(std::vector<char>& bytes)const
+{
+   bytes.clear();
+   if ( theTagData.valid() )
    {
-      setTagName(theTagData->getRegisterTagName());
-      setTagLength(theTagData->getSizeInBytes());
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theTagDataMutex);
+      if ( !theTagData->theParsedFlag )
+      {
+         bytes = theTagData->theBytes;
+      }
+      else if ( theTagData->theTag.valid() )
+      {
+         // Parsed or set, so the tag may have changed: write it.
+         std::ostringstream out;
+         theTagData->theTag->writeStream(out);
+         const std::string DATA = out.str();
+         bytes.assign(DATA.begin(), DATA.end());
+      }
    }
 }
+
+bool ossimNitfTagInformation::isTagDataParsed()const
+{
+   return !theTagData.valid() || theTagData->theParsedFlag;
+}
 ossimString ossimNitfTagInformation::getTagType() const
 {
    return ossimString(theTagType).trim();
@@ -19,7 +19,10 @@
 #include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimTrace.h>
 #include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <sstream>
 
 
 RTTI_DEF1(ossimQuickbirdMetaData, "ossimQuickbirdMetaData", ossimObject);
@@ -28,6 +31,92 @@ RTTI_DEF1(ossimQuickbirdMetaData, "ossimQuickbirdMetaData", ossimObject);
 static ossimTrace traceExec  ("ossimQuickbirdMetaData:exec");
 static ossimTrace traceDebug ("ossimQuickbirdMetaData:debug");
 
+//---
+// Values of an IMD file, read in one pass over its lines.  A "name = value;"
+// line is kept by its indent and name, e.g. "\tsatId", with the first word
+// of its value; the first line wins.  absCalFactor is also kept per
+// BEGIN_GROUP = BAND_x group.
+//---
+namespace
+{
+   struct ossimQuickbirdImd
+   {
+      std::map<std::string, ossimString> theValues;
+      std::vector<ossimString>           theBandNames;
+      std::map<std::string, ossimString> theBandAbsCalFactors;
+      ossimString                        theFirstAbsCalFactor;
+
+      bool read(const ossimFilename& file)
+      {
+         std::ifstream in(file.c_str(), std::ios::in|std::ios::binary);
+         if (!in)
+         {
+            return false;
+         }
+
+         std::string line;
+         std::string band;
+         while ( std::getline(in, line) )
+         {
+            const std::string::size_type START = line.find_first_not_of(" \t");
+            const std::string::size_type EQUAL = line.find(" =");
+            if ( (START == std::string::npos) || (EQUAL == std::string::npos) ||
+                 (EQUAL <= START) )
+            {
+               continue;
+            }
+            const std::string NAME = line.substr(START, EQUAL - START);
+            std::istringstream words(line.substr(EQUAL + 2));
+            std::string word;
+            words >> word;
+            const ossimString VALUE(word);
+
+            if ( NAME == "BEGIN_GROUP" )
+            {
+               if ( VALUE.substr(0, 5) == "BAND_" )
+               {
+                  band = VALUE.substr(5);
+                  theBandNames.push_back(band);
+               }
+            }
+            else if ( NAME == "END_GROUP" )
+            {
+               band.clear();
+            }
+            else if ( (NAME == "absCalFactor") && START && (line[START-1] == '\t') )
+            {
+               if ( theFirstAbsCalFactor.empty() )
+               {
+                  theFirstAbsCalFactor = VALUE;
+               }
+               if ( band.size() && !theBandAbsCalFactors.count(band) )
+               {
+                  theBandAbsCalFactors[band] = VALUE;
+               }
+            }
+            theValues.insert( std::make_pair(line.substr(0, EQUAL), VALUE) );
+         }
+         return true;
+      }
+
+      /** Value of name, else of alternate if given. */
+      bool find(const char* name, ossimString& value, const char* alternate = 0) const
+      {
+         std::map<std::string, ossimString>::const_iterator i = theValues.find(name);
+         if ( (i == theValues.end()) && alternate )
+         {
+            i = theValues.find(alternate);
+         }
+         if ( i != theValues.end() )
+         {
+            value = i->second;
+            return true;
+         }
+         return false;
+      }
+   };
+}
+
 ossimQuickbirdMetaData::ossimQuickbirdMetaData()
    :
    theGenerationDate("Unknown"),
@@ -342,8 +431,8 @@ bool ossimQuickbirdMetaData::parseMetaData(const ossimFilename& data_file)
    }
   
 
-   FILE* fptr = fopen (data_file, "r");
-   if (!fptr)
+   ossimQuickbirdImd imd;
+   if ( !imd.read(data_file) )
    {
       if (traceDebug())
       {
@@ -355,102 +444,44 @@ bool ossimQuickbirdMetaData::parseMetaData(const ossimFilename& data_file)
       return false;
    }
 
-   char* strptr(NULL);
-
-   //---
-   // Read the file into a buffer:
-   //---
-   ossim_int32 fileSize = static_cast<ossim_int32>(data_file.fileSize());
-   char* filebuf = new char[fileSize];
-   fread(filebuf, 1, fileSize, fptr);
-   strptr = filebuf;
-   fclose(fptr);
    ossimString temp;
+   bool parsed = true;
 
-   //---
    // Generation time:
-   //---
-  
-   if(getEndOfLine( strptr, ossimString("\ngenerationTime ="), "%17c %s", temp))
-      theGenerationDate = ossimString(temp).before(";");
+   if ( imd.find("generationTime", temp) )
+      theGenerationDate = temp.before(";");
    else
-   {
-      if(traceDebug())
-      {
-         ossimNotify(ossimNotifyLevel_FATAL)
-	    << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
-	    << "\n\tAborting construction. Error encountered parsing "
-	    << "presumed meta-data file." << std::endl;
-
-         delete [] filebuf;
-         return false;
-      }
-   }
+      parsed = false;
 
    // Number of rows and columns in full image:
-   if(getEndOfLine( strptr, ossimString("\nnumRows ="), "%10c %s", temp))
-      theImageSize.line = ossimString(temp).before("\";").toInt();
+   if ( imd.find("numRows", temp) )
+      theImageSize.line = temp.before("\";").toInt();
 
-   if(getEndOfLine( strptr, ossimString("\nnumColumns ="), "%13c %s", temp))
-      theImageSize.samp = ossimString(temp).before("\";").toInt();
+   if ( imd.find("numColumns", temp) )
+      theImageSize.samp = temp.before("\";").toInt();
 
-   //---
    // BandId:
-   //---
-   if(getEndOfLine( strptr, ossimString("\nbandId ="), "%9c %s", temp))
-      theBandId = ossimString(temp).after("\"").before("\";");
+   if ( imd.find("bandId", temp) )
+      theBandId = temp.after("\"").before("\";");
    else
-   {
-      if(traceDebug())
-      {
-         ossimNotify(ossimNotifyLevel_FATAL)
-	    << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
-	    << "\n\tAborting construction. Error encountered parsing "
-	    << "presumed meta-data file." << std::endl;
+      parsed = false;
 
-         delete [] filebuf;
-         return false;
-      }
-   }
-    
-  
-   //---
    // BitsPerPixel:
-   //---
-   if(getEndOfLine( strptr, ossimString("\nbitsPerPixel = "), "%16c %s", temp))
-      theBitsPerPixel = ossimString(temp).before(";").toInt();
+   if ( imd.find("bitsPerPixel", temp) )
+      theBitsPerPixel = temp.before(";").toInt();
    else
-   {
-      if(traceDebug())
-      {
-         ossimNotify(ossimNotifyLevel_FATAL)
-	    << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
-	    << "\n\tAborting construction. Error encountered parsing "
-	    << "presumed meta-data file." << std::endl;
+      parsed = false;
 
-         delete [] filebuf;
-         return false;
-      }
-   }
-     
    //---
    // absCalFactors:
    //---
-
-   char *iter = (char *)filebuf;
-   unsigned int nbBand = 0;
    theBandNameList = "";
-   for(iter = strstr(iter, "BEGIN_GROUP = BAND_"); iter ; iter = strstr(iter, "BEGIN_GROUP = BAND_"))
+   for (std::vector<ossimString>::size_type i = 0; i < imd.theBandNames.size(); ++i)
    {
-      ++nbBand;
-      char dummy[80], nameChar[80];
-      sscanf(iter, "%19c %s", dummy, nameChar);
-      ossimString bandCur = ossimString(nameChar).before("\n");
-      theBandNameList = theBandNameList + bandCur + " ";
-      ++iter;
+      theBandNameList = theBandNameList + imd.theBandNames[i] + " ";
    }
    theBandNameList.trim();
-   
+
    //--- Multispectral
    if(theBandId=="Multi")
    {
@@ -459,40 +490,11 @@ bool ossimQuickbirdMetaData::parseMetaData(const ossimFilename& data_file)
       theAbsCalFactors = std::vector<double>(bandList.size(), 1.);
       for(unsigned int j=0; j<bandList.size(); j++)
       {
-         ossimString begin_group = "BEGIN_GROUP = BAND_" + bandList[j];
-         strptr = strstr(filebuf, begin_group.c_str());
-         if(!strptr && traceDebug())
-         {	  				
-            ossimNotify(ossimNotifyLevel_FATAL)
-               << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
-               << "\n\tAborting construction. Error encountered parsing "
-               << "presumed meta-data file." << std::endl;
-            delete [] filebuf;
-            return false;
-         }
-         else
+         std::map<std::string, ossimString>::const_iterator factor =
+            imd.theBandAbsCalFactors.find(bandList[j].string());
+         if ( factor != imd.theBandAbsCalFactors.end() )
          {
-            char dummy[80], nameChar[80];
-            sscanf(strptr, "%19c %s", dummy, nameChar);
-            ossimString bandCur = ossimString(nameChar).before("\n");
-            if(!strptr && traceDebug())
-            {	  				
-               ossimNotify(ossimNotifyLevel_FATAL)
-                  << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
-                  << "\n\tAborting construction. Error encountered parsing "
-                  << "presumed meta-data file." << std::endl;
-               delete [] filebuf;
-               return false;
-            }
-            else
-            {
-               if(bandList[j] == bandCur)
-               {
-                  strptr = strstr(strptr, "\tabsCalFactor = ");
-                  sscanf(strptr, "%16c %s", dummy, nameChar);
-                  theAbsCalFactors[j] = ossimString(nameChar).before(";").toDouble();
-               }
-            }
+            theAbsCalFactors[j] = factor->second.before(";").toDouble();
          }
       }
    }
@@ -500,234 +502,62 @@ bool ossimQuickbirdMetaData::parseMetaData(const ossimFilename& data_file)
    else
    {
       theAbsCalFactors = std::vector<double>(1, 1.);
-      if(getEndOfLine( strptr, ossimString("\tabsCalFactor = "), "%16c %s", temp))
-         theAbsCalFactors[0] = ossimString(temp).before(";").toDouble();
+      if ( imd.theFirstAbsCalFactor.size() )
+         theAbsCalFactors[0] = imd.theFirstAbsCalFactor.before(";").toDouble();
       else
-      {
-         if(traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_FATAL)
-               << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
-               << "\n\tAborting construction. Error encountered parsing "
-               << "presumed meta-data file." << std::endl;
-
-            delete [] filebuf;
-            return false;
-         }
-      }
+         parsed = false;
    }
-    
-   //---
+
    // SatID:
-   //---
-   if(getEndOfLine( strptr, ossimString("\n\tsatId ="), "%9c %s", temp))
-      theSatID = ossimString(temp).after("\"").before("\";");
+   if ( imd.find("\tsatId", temp) )
+      theSatID = temp.after("\"").before("\";");
    else
-   {
-      if(traceDebug())
-      {
-         ossimNotify(ossimNotifyLevel_FATAL)
-	    << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
-	    << "\n\tAborting construction. Error encountered parsing "
-	    << "presumed meta-data file." << std::endl;
-
-         delete [] filebuf;
-         return false;
-      }
-   }
+      parsed = false;
 
-   //---
    // TLCTime:
-   //---
-   if(getEndOfLine( strptr, ossimString("\n\tTLCTime ="), "%11c %s", temp))
-      theTLCDate = ossimString(temp).before("\";");
-   else
-   {
-      if(getEndOfLine( strptr, ossimString("\n\tfirstLineTime ="), "%17c %s", temp))
-         theTLCDate = ossimString(temp).before("\";");
-      else
-      {
-         if(traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_FATAL)
-               << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
-               << "\n\tAborting construction. Error encountered parsing "
-               << "presumed meta-data file." << std::endl;
-            delete [] filebuf;
-            return false;
-         }
-      }
-   }
-   
-   //---
-   // Sun Azimuth:
-   //---
-   if(getEndOfLine( strptr, ossimString("\n\tsunAz ="), "%9c %s", temp))
-        theSunAzimuth = ossimString(temp).before(";").toFloat64();
+   if ( imd.find("\tTLCTime", temp, "\tfirstLineTime") )
+      theTLCDate = temp.before("\";");
    else
-   {
-      if(getEndOfLine( strptr, ossimString("\n\tmeanSunAz ="), "%13c %s", temp))
-         theSunAzimuth = ossimString(temp).before(";").toFloat64();
-      else
-      {
-         if(traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_FATAL)
-               << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
-               << "\n\tAborting construction. Error encountered parsing "
-               << "presumed meta-data file." << std::endl;
-
-            delete [] filebuf;
-            return false;
-         }
-      }
-   }
+      parsed = false;
 
-   //---
-   // Sun Elevation:
-   //---
-   if(getEndOfLine( filebuf, ossimString("\n\tsunEl ="), "%9c %s", temp))
-        theSunElevation = ossimString(temp).before(";").toFloat64();
+   // Sun Azimuth and Elevation:
+   if ( imd.find("\tsunAz", temp, "\tmeanSunAz") )
+      theSunAzimuth = temp.before(";").toFloat64();
    else
-   {
-      if(getEndOfLine( filebuf, ossimString("\n\tmeanSunEl ="), "%13c %s", temp))
-         theSunElevation = ossimString(temp).before(";").toFloat64();
-      else
-      {
-         if(traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_FATAL)
-               << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
-               << "\n\tAborting construction. Error encountered parsing "
-               << "presumed meta-data file." << std::endl;
+      parsed = false;
 
-            delete [] filebuf;
-            return false;
-         }
-      }
-   }
-
-   //---
-   // Sun Azimuth:
-   //---
-   if(getEndOfLine( strptr, ossimString("\n\tsunAz ="), "%9c %s", temp))
-      theSunAzimuth = ossimString(temp).before(";").toFloat64();
+   if ( imd.find("\tsunEl", temp, "\tmeanSunEl") )
+      theSunElevation = temp.before(";").toFloat64();
    else
-   {
-      if(getEndOfLine( strptr, ossimString("\n\tmeanSunAz ="), "%13c %s", temp))
-         theSunAzimuth = ossimString(temp).before(";").toFloat64();
-      else
-      {
-         if(traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_FATAL)
-               << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
-               << "\n\tAborting construction. Error encountered parsing "
-               << "presumed meta-data file." << std::endl;
-            
-            delete [] filebuf;
-            return false;
-         }
-      }
-   }
+      parsed = false;
 
-   //---
-   // Sun Elevation:
-   //---
-   if(getEndOfLine( filebuf, ossimString("\n\tsunEl ="), "%9c %s", temp))
-      theSunElevation = ossimString(temp).before(";").toFloat64();
+   // Sat Azimuth and Elevation:
+   if ( imd.find("\tsatAz", temp, "\tmeanSatAz") )
+      theSatAzimuth = temp.before(";").toFloat64();
    else
-   {
-      if(getEndOfLine( filebuf, ossimString("\n\tmeanSunEl ="), "%13c %s", temp))
-         theSunElevation = ossimString(temp).before(";").toFloat64();
-      else
-      {
-         if(traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_FATAL)
-               << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
-               << "\n\tAborting construction. Error encountered parsing "
-               << "presumed meta-data file." << std::endl;
-
-            delete [] filebuf;
-            return false;
-         }
-      }
-   }
+      parsed = false;
 
-
-   //---
-   // Sat Azimuth:
-   //---
-   if(getEndOfLine( strptr, ossimString("\n\tsatAz ="), "%9c %s", temp))
-      theSatAzimuth = ossimString(temp).before(";").toFloat64();
-   else
-   {
-      if(getEndOfLine( strptr, ossimString("\n\tmeanSatAz ="), "%13c %s", temp))
-         theSatAzimuth = ossimString(temp).before(";").toFloat64();
-      else
-      {
-         if(traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_FATAL)
-               << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
-               << "\n\tAborting construction. Error encountered parsing "
-               << "presumed meta-data file." << std::endl;
-            
-            delete [] filebuf;
-            return false;
-         }
-      }
-   }
-   
-   //---
-   // Sat Elevation:
-   //---
-   if(getEndOfLine( filebuf, ossimString("\n\tsatEl ="), "%9c %s", temp))
-      theSatElevation = ossimString(temp).before(";").toFloat64();
+   if ( imd.find("\tsatEl", temp, "\tmeanSatEl") )
+      theSatElevation = temp.before(";").toFloat64();
    else
-   {
-      if(getEndOfLine( filebuf, ossimString("\n\tmeanSatEl ="), "%13c %s", temp))
-         theSatElevation = ossimString(temp).before(";").toFloat64();
-      else
-      {
-         if(traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_FATAL)
-               << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
-               << "\n\tAborting construction. Error encountered parsing "
-               << "presumed meta-data file." << std::endl;
-            
-            delete [] filebuf;
-            return false;
-         }
-      }
-   }
-   
-   
-   //---
+      parsed = false;
+
    // TDILevel:
-   //---
-   if(getEndOfLine( strptr, ossimString("\n\tTDILevel = "), "%13c %s", temp))
-      theTDILevel = ossimString(temp).before(";").toInt();
+   if ( imd.find("\tTDILevel", temp) )
+      theTDILevel = temp.before(";").toInt();
    else
-   {
-      if(traceDebug())
-      {
-         ossimNotify(ossimNotifyLevel_FATAL)
-	    << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
-	    << "\n\tAborting construction. Error encountered parsing "
-	    << "presumed meta-data file." << std::endl;
+      parsed = false;
 
-         delete [] filebuf;
-         return false;
-      }
+   // As before, a missing field fails the parse only when debugging.
+   if ( !parsed && traceDebug() )
+   {
+      ossimNotify(ossimNotifyLevel_FATAL)
+         << "FATAL ossimQuickbirdRpcModel::parseMetaData(data_file): "
+         << "\n\tAborting construction. Error encountered parsing "
+         << "presumed meta-data file." << std::endl;
+      return false;
    }
 
-
-   delete [] filebuf;
-   filebuf = 0;
-
    if (traceExec())
    {
       ossimNotify(ossimNotifyLevel_DEBUG)
@@ -38,6 +38,8 @@
 #include <ossim/base/ossimEndian.h>
 #include <ossim/base/ossimErrorCodes.h>
 #include <ossim/base/ossimTrace.h>
+#include <algorithm>
+#include <cstring>
 #include <istream>
 #include <ostream>
 
@@ -401,6 +403,83 @@ bool ossimRpfFrame::fillSubFrameBuffer(ossim_uint8* buffer,
    return true;
 }
 
+bool ossimRpfFrame::uncompressSubFrame(ossim_uint8* buffer,
+                                       ossim_uint32 bands,
+                                       ossim_uint32 row,
+                                       ossim_uint32 col,
+                                       ossim_uint8* compressedBuffer)const
+{
+   if(!buffer || !compressedBuffer || (bands < 1) || (bands > 3) ||
+      !theCompressionSection || (theCompressionSection->getTable().size() < 4) ||
+      theColorGrayscaleTable.empty())
+   {
+      return false;
+   }
+   if(!fillSubFrameBuffer(compressedBuffer, 0, row, col))
+   {
+      return false;
+   }
+
+   // The VQ tables hold color table indexes.  Expand the first color table
+   // to bands bytes per index once instead of decoding each pixel's entry.
+   const ossimRpfColorGrayscaleTable& colorTable = theColorGrayscaleTable[0];
+   const ossim_uint32 numberOfColors =
+      std::min((ossim_uint32)colorTable.getNumberOfElements(), (ossim_uint32)256);
+   ossim_uint8 lut[256][3];
+   memset(lut, 0, sizeof(lut));
+   ossim_uint32 color;
+   ossim_uint32 band;
+   for(color = 0; color < numberOfColors; ++color)
+   {
+      const ossim_uint8* data = colorTable.getStartOfData(color);
+      for(band = 0; band < bands; ++band)
+      {
+         lut[color][band] = data[band];
+      }
+   }
+
+   const ossimRpfCompressionOffsetTableData* vqTable = &theCompressionSection->getTable()[0];
+   ossim_uint8* bandBuffer[3];
+   for(band = 0; band < bands; ++band)
+   {
+      bandBuffer[band] = buffer + band*256*256;
+   }
+
+   ossim_uint32 readPtr = 0;
+   for (ossim_uint32 i = 0; i < 256; i += 4)
+   {
+      for (ossim_uint32 j = 0; j < 256; j += 8)
+      {
+         ossim_uint16 firstByte  = compressedBuffer[readPtr++] & 0xff;
+         ossim_uint16 secondByte = compressedBuffer[readPtr++] & 0xff;
+         ossim_uint16 thirdByte  = compressedBuffer[readPtr++] & 0xff;
+
+         // Two 12-bit values index the VQ table, each for a 4x4 block:
+         ossim_uint16 val1 = (firstByte << 4) | (secondByte >> 4);
+         ossim_uint16 val2 = ((secondByte & 0x000F) << 8) | thirdByte;
+
+         for (ossim_uint32 t = 0; t < 4; ++t)
+         {
+            const ossim_uint8* codes1 = vqTable[t].theData + val1*4;
+            const ossim_uint8* codes2 = vqTable[t].theData + val2*4;
+            const ossim_uint32 pixindex = ((i+t)*256) + j;
+            for (ossim_uint32 e = 0; e < 4; ++e)
+            {
+               const ossim_uint8* color1 = lut[codes1[e]];
+               const ossim_uint8* color2 = lut[codes2[e]];
+               for(band = 0; band < bands; ++band)
+               {
+                  bandBuffer[band][pixindex + e]     = color1[band];
+                  bandBuffer[band][pixindex + e + 4] = color2[band];
+               }
+            }
+         }
+      }
+   }
+
+   return true;
+}
+
 void ossimRpfFrame::clearFields()
 {   
    theFilename = "";
@@ -92,6 +92,16 @@ void ossimRpfFrameEntry::setEntry(const ossimFilename& rootDirectory,
       }
    }
 }
+void ossimRpfFrameEntry::setEntry(const ossimFilename& rootDirectory,
+                                  const ossimFilename& pathToFrameFileFromRoot,
+                                  bool exists)
+{
+   m_rootDirectory           = rootDirectory;
+   m_pathToFrameFileFromRoot = pathToFrameFileFromRoot;
+   m_fullValidPath           = m_rootDirectory.dirCat(m_pathToFrameFileFromRoot);
+   m_exists                  = exists;
+}
+
 std::ostream& ossimRpfFrameEntry::print(
    std::ostream& out, const std::string& prefix) const
 {
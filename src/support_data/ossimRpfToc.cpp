@@ -12,8 +12,11 @@
 // $Id: ossimRpfToc.cpp 21214 2012-07-03 16:20:11Z dburken $
 
 #include <ossim/support_data/ossimRpfToc.h>
+#include <ossim/base/ossimDate.h>
 #include <ossim/base/ossimErrorCodes.h>
 #include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimMemoryMappedFile.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossimProperty.h>
 #include <ossim/base/ossimStringProperty.h>
 #include <ossim/support_data/ossimNitfFileHeaderV2_X.h>
@@ -29,11 +32,52 @@
 #include <ossim/support_data/ossimRpfPathnameRecord.h>
 #include <ossim/support_data/ossimNitfFile.h>
 #include <ossim/base/ossimTrace.h>
+#include <cstring>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 static ossimTrace traceDebug("ossimRpfToc:debug");
 
+//---
+// Binary index of an a.toc (see ossimRpfToc::writeIndex).  Layout, native
+// byte order:
+//    magic, ossim_int64 toc mod time, ossim_int64 toc size,
+//    ossim_uint64 rpf header offset, ossim_uint32 entry count,
+//    ossim_uint32 frame count,
+//    then per entry the boundary rect record as written by its writeStream,
+//    then per frame a RpfTocIndexFrame,
+//    then the relative paths of the frames.
+//---
+static const char RPF_TOC_INDEX_MAGIC[] = "OSSIMRPFTOCIDX1";
+static const std::size_t RPF_TOC_INDEX_MAGIC_SIZE = sizeof(RPF_TOC_INDEX_MAGIC);
+static const std::size_t RPF_TOC_INDEX_HEADER_SIZE =
+   RPF_TOC_INDEX_MAGIC_SIZE + 3*sizeof(ossim_uint64) + 2*sizeof(ossim_uint32);
+static const std::size_t RPF_BOUNDARY_RECORD_SIZE = 132;
+
+struct RpfTocIndexFrame
+{
+   ossim_uint32 theEntry;
+   ossim_uint32 theRow;
+   ossim_uint32 theCol;
+   ossim_uint32 theExistsFlag;
+   ossim_uint64 thePathOffset; //!< In the path block.
+   ossim_uint64 thePathLength;
+};
+
+// Modification time and size, to tell if an index is older than its a.toc.
+static bool getRpfTocStamp(const ossimFilename& file, ossim_int64& modTime, ossim_int64& size)
+{
+   ossimLocalTm t;
+   if ( !file.getTimes(0, &t, 0) )
+   {
+      return false;
+   }
+   modTime = (ossim_int64)(time_t)t;
+   size    = file.fileSize();
+   return true;
+}
+
 std::ostream& operator <<(std::ostream& out, const ossimRpfToc& data)
 {
    return data.print(out);
@@ -61,10 +105,26 @@ ossimErrorCode ossimRpfToc::parseFile(const ossimFilename &fileName, bool keepFi
       ossimNotify(ossimNotifyLevel_DEBUG) << MODULE << " entered....." << std::endl;
    }
 
-   ossimRefPtr<ossimNitfFile> nitfFile = new ossimNitfFile;
-
    clearAll();
 
+   if ( !keepFileHeader )
+   {
+      m_filename = fileName;
+      if ( loadIndex() )
+      {
+         m_nitfFileHeader = 0;
+         if(traceDebug())
+         {
+            ossimNotify(ossimNotifyLevel_DEBUG)
+               << MODULE << " loaded index: " << getIndexFile() << std::endl;
+         }
+         return ossimErrorCodes::OSSIM_OK;
+      }
+      clearAll();
+   }
+
+   ossimRefPtr<ossimNitfFile> nitfFile = new ossimNitfFile;
+
    nitfFile->parseFile(fileName);
 
    m_nitfFileHeader = nitfFile->getHeader();
@@ -142,6 +202,11 @@ ossimErrorCode ossimRpfToc::parseFile(const ossimFilename &fileName, bool keepFi
          ossimNotify(ossimNotifyLevel_DEBUG) << "DEBUG: Building toc list" << "\n";
       }
       buildTocEntryList( m_rpfHeader.get() );
+
+      if ( !keepFileHeader )
+      {
+         writeIndex( info.getTagDataOffset() );
+      }
    }
    else
    {
@@ -854,6 +919,10 @@ void ossimRpfToc::buildTocEntryList(ossimRpfHeader* rpfHeader)
             ossimRpfFrameFileIndexRecord tempIndexRec;
             ossimRpfPathnameRecord       tempPathNameRec;
             
+            // We have the root directory where all frame files are subfiles of
+            ossimFilename rootDirectory;
+            getRootDirectory(rootDirectory);
+
             ossim_int32 count = frameFileIndexHead->getNumberOfIndexRecords();
             while(count > 0)
             {
@@ -866,12 +935,6 @@ void ossimRpfToc::buildTocEntryList(ossimRpfHeader* rpfHeader)
                in.seekg(offsetToIndexSubsection + tempIndexRec.getPathnameRecordOffset(), ios::beg);
                tempPathNameRec.parseStream(in, rpfHeader->getByteOrder());
 
-               // We have the root directory where all frame files are subfiles of
-//               ossimString rootDirectory(ossimFilename(m_filename.path())+
-               // ossimFilename(ossimFilename::thePathSeparator));
-               ossimFilename rootDirectory;
-               getRootDirectory(rootDirectory);
-
                // we have the actual path from the root directory to the
                // frame file.  We must separate the two.  There have been
                // occurrences where the path in the A.TOC file
@@ -918,6 +981,201 @@ void ossimRpfToc::allocateTocEntryList(ossim_uint32 numberOfEntries)
    }   
 }
 
+ossimFilename ossimRpfToc::getIndexFile() const
+{
+   ossimFilename result;
+   const char* lookup = ossimPreferences::instance()->findPreference("rpf.toc_index");
+   if ( m_filename.empty() || ( lookup && !ossimString(lookup).toBool() ) )
+   {
+      return result;
+   }
+
+   lookup = ossimPreferences::instance()->findPreference("rpf.toc_index_directory");
+   if ( lookup && *lookup )
+   {
+      // Every a.toc has the same name; name the index after the whole path.
+      ossimString name = m_filename.expand();
+      name.gsub(ossimString("/"), ossimString("_"), true);
+      name.gsub(ossimString("\\"), ossimString("_"), true);
+      name.gsub(ossimString(":"), ossimString("_"), true);
+      result = ossimFilename(lookup).expand().dirCat( ossimFilename(name + ".idx") );
+   }
+   else
+   {
+      result = m_filename + ".idx";
+   }
+   return result;
+}
+
+bool ossimRpfToc::loadIndex()
+{
+   ossim_int64 modTime = 0;
+   ossim_int64 size = 0;
+   ossimFilename indexFile = getIndexFile();
+   if ( indexFile.empty() || !indexFile.exists() || !getRpfTocStamp(m_filename, modTime, size) )
+   {
+      return false;
+   }
+
+   ossimRefPtr<ossimMemoryMappedFile> map = new ossimMemoryMappedFile();
+   if ( !map->open(indexFile) || (map->size() < RPF_TOC_INDEX_HEADER_SIZE) ||
+        memcmp(map->data(), RPF_TOC_INDEX_MAGIC, RPF_TOC_INDEX_MAGIC_SIZE) )
+   {
+      return false;
+   }
+
+   const ossim_uint8* buf = map->data();
+   std::size_t pos = RPF_TOC_INDEX_MAGIC_SIZE;
+   ossim_int64  indexModTime;
+   ossim_int64  indexTocSize;
+   ossim_uint64 rpfHeaderOffset;
+   ossim_uint32 entryCount;
+   ossim_uint32 frameCount;
+   memcpy(&indexModTime, buf + pos, sizeof(indexModTime));       pos += sizeof(indexModTime);
+   memcpy(&indexTocSize, buf + pos, sizeof(indexTocSize));       pos += sizeof(indexTocSize);
+   memcpy(&rpfHeaderOffset, buf + pos, sizeof(rpfHeaderOffset)); pos += sizeof(rpfHeaderOffset);
+   memcpy(&entryCount, buf + pos, sizeof(entryCount));           pos += sizeof(entryCount);
+   memcpy(&frameCount, buf + pos, sizeof(frameCount));           pos += sizeof(frameCount);
+
+   // The a.toc is the reference; an index older than it is rebuilt.
+   const ossim_uint64 PATHS_START = pos + (ossim_uint64)entryCount * RPF_BOUNDARY_RECORD_SIZE +
+      (ossim_uint64)frameCount * sizeof(RpfTocIndexFrame);
+   if ( (indexModTime != modTime) || (indexTocSize != size) || (PATHS_START > map->size()) ||
+        (rpfHeaderOffset >= (ossim_uint64)size) )
+   {
+      return false;
+   }
+
+   // The rpf header is small; read it from the a.toc.
+   std::ifstream in(m_filename.c_str(), std::ios::in|std::ios::binary);
+   if ( !in )
+   {
+      return false;
+   }
+   in.seekg(rpfHeaderOffset, std::ios::beg);
+   m_rpfHeader = new ossimRpfHeader;
+   m_rpfHeader->parseStream(in);
+   if ( !in )
+   {
+      m_rpfHeader = 0;
+      return false;
+   }
+
+   allocateTocEntryList(entryCount);
+   for (ossim_uint32 i = 0; i < entryCount; ++i)
+   {
+      std::istringstream record( std::string( (const char*)buf + pos,
+                                              RPF_BOUNDARY_RECORD_SIZE ) );
+      m_tocEntryList[i]->parseStream(record, OSSIM_BIG_ENDIAN);
+      pos += RPF_BOUNDARY_RECORD_SIZE;
+   }
+
+   ossimFilename rootDirectory;
+   getRootDirectory(rootDirectory);
+   const ossim_uint64 PATHS_SIZE = map->size() - PATHS_START;
+   for (ossim_uint32 i = 0; i < frameCount; ++i)
+   {
+      RpfTocIndexFrame frame;
+      memcpy(&frame, buf + pos, sizeof(frame));
+      pos += sizeof(frame);
+      if ( (frame.theEntry >= entryCount) || (frame.thePathOffset > PATHS_SIZE) ||
+           (frame.thePathLength > PATHS_SIZE - frame.thePathOffset) )
+      {
+         deleteTocEntryList();
+         m_rpfHeader = 0;
+         return false;
+      }
+      ossimRpfFrameEntry entry;
+      entry.setEntry(rootDirectory,
+                     ossimFilename( std::string( (const char*)buf + PATHS_START +
+                                                 frame.thePathOffset,
+                                                 (std::size_t)frame.thePathLength ) ),
+                     frame.theExistsFlag != 0);
+      m_tocEntryList[frame.theEntry]->setEntry(entry, frame.theRow, frame.theCol);
+   }
+   return true;
+}
+
+void ossimRpfToc::writeIndex(ossim_uint64 rpfHeaderOffset) const
+{
+   ossim_int64 modTime = 0;
+   ossim_int64 size = 0;
+   ossimFilename indexFile = getIndexFile();
+   if ( indexFile.empty() || !getRpfTocStamp(m_filename, modTime, size) )
+   {
+      return;
+   }
+
+   // Frames listed in the a.toc, with the path found on disk:
+   std::vector<RpfTocIndexFrame> frames;
+   std::string paths;
+   for (ossim_uint32 i = 0; i < m_tocEntryList.size(); ++i)
+   {
+      const ossimRpfTocEntry* tocEntry = m_tocEntryList[i];
+      for (ossim_uint32 row = 0; row < tocEntry->getNumberOfFramesVertical(); ++row)
+      {
+         for (ossim_uint32 col = 0; col < tocEntry->getNumberOfFramesHorizontal(); ++col)
+         {
+            ossimRpfFrameEntry entry;
+            tocEntry->getEntry(row, col, entry);
+            const ossimString PATH = entry.getPathToFrameFileFromRoot();
+            if ( PATH.empty() )
+            {
+               continue;
+            }
+            RpfTocIndexFrame frame;
+            frame.theEntry      = i;
+            frame.theRow        = row;
+            frame.theCol        = col;
+            frame.theExistsFlag = entry.exists() ? 1 : 0;
+            frame.thePathOffset = paths.size();
+            frame.thePathLength = PATH.size();
+            frames.push_back(frame);
+            paths += PATH.string();
+         }
+      }
+   }
+
+   ossimFilename indexDir = indexFile.path();
+   if ( indexDir.size() && !indexDir.exists() )
+   {
+      indexDir.createDirectory();
+   }
+   std::ofstream out(indexFile.c_str(), std::ios::out|std::ios::binary|std::ios::trunc);
+   if ( !out.good() )
+   {
+      return;
+   }
+   const ossim_uint32 ENTRY_COUNT = (ossim_uint32)m_tocEntryList.size();
+   const ossim_uint32 FRAME_COUNT = (ossim_uint32)frames.size();
+   out.write(RPF_TOC_INDEX_MAGIC, RPF_TOC_INDEX_MAGIC_SIZE);
+   out.write((const char*)&modTime, sizeof(modTime));
+   out.write((const char*)&size, sizeof(size));
+   out.write((const char*)&rpfHeaderOffset, sizeof(rpfHeaderOffset));
+   out.write((const char*)&ENTRY_COUNT, sizeof(ENTRY_COUNT));
+   out.write((const char*)&FRAME_COUNT, sizeof(FRAME_COUNT));
+   for (ossim_uint32 i = 0; i < ENTRY_COUNT; ++i)
+   {
+      ossimRpfBoundaryRectRecord record = m_tocEntryList[i]->getBoundaryInformation();
+      record.writeStream(out);
+   }
+   if ( FRAME_COUNT )
+   {
+      out.write((const char*)&frames.front(), FRAME_COUNT * sizeof(RpfTocIndexFrame));
+   }
+   out.write(paths.data(), paths.size());
+   out.close();
+   if ( out.fail() )
+   {
+      indexFile.remove();
+   }
+   else if(traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimRpfToc::writeIndex: wrote " << indexFile << std::endl;
+   }
+}
+
 void ossimRpfToc::getRootDirectory(ossimFilename& dir) const
 {
    dir = m_filename.expand().path();
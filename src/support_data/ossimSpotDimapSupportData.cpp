@@ -32,6 +32,66 @@ static ossimTrace traceDebug ("ossimSpotDimapSupportData:debug");
 
 static const ossim_uint32  LAGRANGE_FILTER_SIZE = 8; // num samples considered
 
+//---
+// Sections of the document read by loadXmlFile; everything else (the raw
+// attitudes, quality assessment, per detector data...) is skipped by the
+// parser without building nodes.
+//---
+static const char* DIMAP_PATHS[] =
+{
+   "/Dimap_Document/Metadata_Id/METADATA_FORMAT",
+   "/Dimap_Document/Production",
+   "/Dimap_Document/Dataset_Sources/Source_Information/Scene_Source",
+   "/Dimap_Document/Raster_Dimensions",
+   "/Dimap_Document/Dataset_Frame",
+   "/Dimap_Document/Data_Processing/Regions_Of_Interest",
+   "/Dimap_Document/Data_Strip/Sensor_Configuration",
+   "/Dimap_Document/Data_Strip/Ephemeris",
+   "/Dimap_Document/Data_Strip/Satellite_Attitudes/Corrected_Attitudes",
+   "/Dimap_Document/Data_Strip/Sensor_Calibration/Solar_Irradiance",
+   "/Dimap_Document/Geoposition/Geoposition_Points",
+   "/Dimap_Document/Image_Interpretation",
+   0
+};
+
+static const char RAW_ATTITUDES_PATH[] =
+   "/Dimap_Document/Data_Strip/Satellite_Attitudes/Raw_Attitudes/Aocs_Attitude/Angles_List/Angles";
+
+//---
+// Finds the first child of node for each of the COUNT tags, in one pass
+// over the children.  Returns false if one is missing.
+//---
+static bool findFirstChildren(const ossimXmlNode* node,
+                              const char* const tags[],
+                              ossim_uint32 count,
+                              const ossimXmlNode* found[])
+{
+   ossim_uint32 missing = count;
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      found[i] = 0;
+   }
+   if ( node )
+   {
+      const ossimXmlNode::ChildListType& children = node->getChildNodes();
+      for (ossimXmlNode::ChildListType::const_iterator child = children.begin();
+           (child != children.end()) && missing; ++child)
+      {
+         const ossimString& tag = (*child)->getTag();
+         for (ossim_uint32 i = 0; i < count; ++i)
+         {
+            if ( !found[i] && (tag == tags[i]) )
+            {
+               found[i] = child->get();
+               --missing;
+               break;
+            }
+         }
+      }
+   }
+   return (missing == 0);
+}
+
 ossimSpotDimapSupportData::ossimSpotDimapSupportData ()
    :
    ossimErrorStatusInterface(),
@@ -252,53 +312,18 @@ bool ossimSpotDimapSupportData::loadXmlFile(const ossimFilename& file,
    theSwirDataFlag = processSwir;
    theMetadataFile = file;
 
-   ossim_int64 fileSize = file.fileSize();
-   std::ifstream in(file.c_str(), std::ios::binary|std::ios::in);
-   std::vector<char> fullBuffer;
-   ossimString bufferedIo;
-   if(in.good()&&(fileSize > 0))
-   {
-      char buf[100];
-      fullBuffer.resize(fileSize);
-      in.read(buf, ossim::min((ossim_int64)100, fileSize));
-      if(!in.fail())
-      {
-         ossimString testString = ossimString(buf,
-                                              buf + in.gcount());
-         if(testString.contains("xml"))
-         {
-            in.seekg(0);
-            in.read(&fullBuffer.front(), (std::streamsize)fullBuffer.size());
-            if(!in.fail())
-            {
-               bufferedIo = ossimString(fullBuffer.begin(),
-                                        fullBuffer.begin()+in.gcount());
-            }
-         }
-      }
-   }
-   else
-   {
-      return false;
-   }
    //---
-   // Instantiate the XML parser:
+   // Instantiate the XML parser, loading only the sections used below:
    //---
-   ossimRefPtr<ossimXmlDocument> xmlDocument;
-
-   if(bufferedIo.empty())
+   std::vector<ossimString> paths;
+   for (ossim_uint32 i = 0; DIMAP_PATHS[i]; ++i)
    {
-      xmlDocument = new ossimXmlDocument(file);
+      paths.push_back(ossimString(DIMAP_PATHS[i]));
    }
-   else
+   ossimRefPtr<ossimXmlDocument> xmlDocument = new ossimXmlDocument;
+   if ( (file.fileSize() <= 0) || !xmlDocument->openFile(file, paths) )
    {
-
-      xmlDocument = new ossimXmlDocument;
-      std::istringstream inStringStream(bufferedIo.string());
-      if(!xmlDocument->read(inStringStream))
-      {
-         return false;
-      }
+      return false;
    }
    if (xmlDocument->getErrorStatus())
    {
@@ -2136,70 +2161,39 @@ bool ossimSpotDimapSupportData::parsePart2(
    xmlDocument->findNodes(xpath, xml_nodes);
    if (xml_nodes.size() == 0)
    {
-      xpath = "/Dimap_Document/Data_Strip/Satellite_Attitudes/Raw_Attitudes/Aocs_Attitude/Angles_List/Angles";
-
-      xmlDocument->findNodes(xpath, xml_nodes);
+      // The raw attitudes are not in the selective load; read just them.
+      ossimRefPtr<ossimXmlDocument> rawDocument = new ossimXmlDocument;
+      std::vector<ossimString> rawPath(1, ossimString(RAW_ATTITUDES_PATH));
+      if ( rawDocument->openFile(theMetadataFile, rawPath) )
+      {
+         rawDocument->findNodes(ossimString(RAW_ATTITUDES_PATH), xml_nodes);
+      }
       if (xml_nodes.size() == 0)
       {
          setErrorStatus();
          return false;
       }
    }
+   theAttitudeSamples.reserve(xml_nodes.size());
+   theAttSampTimes.reserve(xml_nodes.size());
+   static const char* const ANGLES_TAGS[] = { "OUT_OF_RANGE", "PITCH", "ROLL", "YAW", "TIME" };
+   const ossimXmlNode* angles[5];
    node = xml_nodes.begin();
    while (node != xml_nodes.end())
    {
-      ossimDpt3d V;
-      sub_nodes.clear();
-      xpath = "OUT_OF_RANGE";
-      (*node)->findChildNodes(xpath, sub_nodes);
-      if (sub_nodes.size() == 0)
+      // Out of range samples need only the flag.
+      if ( !findFirstChildren(node->get(), ANGLES_TAGS, 5, angles) &&
+           ( !angles[0] || (angles[0]->getText() == "N") ) )
       {
          setErrorStatus();
          return false;
       }
-      if (sub_nodes[0]->getText() == "N")
+      if (angles[0]->getText() == "N")
       {
-         sub_nodes.clear();
-         xpath = "PITCH";
-         (*node)->findChildNodes(xpath, sub_nodes);
-         if (sub_nodes.size() == 0)
-         {
-            setErrorStatus();
-            return false;
-         }
-         V.x = sub_nodes[0]->getText().toDouble();
-
-         sub_nodes.clear();
-         xpath = "ROLL";
-         (*node)->findChildNodes(xpath, sub_nodes);
-         if (sub_nodes.size() == 0)
-         {
-            setErrorStatus();
-            return false;
-         }
-         V.y = sub_nodes[0]->getText().toDouble();
-
-         sub_nodes.clear();
-         xpath = "YAW";
-         (*node)->findChildNodes(xpath, sub_nodes);
-         if (sub_nodes.size() == 0)
-         {
-            setErrorStatus();
-            return false;
-         }
-         V.z = sub_nodes[0]->getText().toDouble();
-
-         theAttitudeSamples.push_back(V);
-
-         sub_nodes.clear();
-         xpath = "TIME";
-         (*node)->findChildNodes(xpath, sub_nodes);
-         if (sub_nodes.size() == 0)
-         {
-            setErrorStatus();
-            return false;
-         }
-         theAttSampTimes.push_back(convertTimeStamp(sub_nodes[0]->getText()));
+         theAttitudeSamples.push_back(ossimDpt3d(angles[1]->getText().toDouble(),
+                                                 angles[2]->getText().toDouble(),
+                                                 angles[3]->getText().toDouble()));
+         theAttSampTimes.push_back(convertTimeStamp(angles[4]->getText()));
       }
       ++node;
    }
@@ -2212,7 +2206,6 @@ bool ossimSpotDimapSupportData::parsePart3(
 {
    ossimString xpath;
    std::vector<ossimRefPtr<ossimXmlNode> > xml_nodes;
-   std::vector<ossimRefPtr<ossimXmlNode> > sub_nodes;
    std::vector<ossimRefPtr<ossimXmlNode> >::iterator node;
 
    //---
@@ -2229,85 +2222,33 @@ bool ossimSpotDimapSupportData::parsePart3(
       setErrorStatus();
       return false;
    }
+   thePosEcfSamples.reserve(xml_nodes.size());
+   theVelEcfSamples.reserve(xml_nodes.size());
+   theEphSampTimes.reserve(xml_nodes.size());
+   static const char* const POINT_TAGS[] = { "Location", "Velocity", "TIME" };
+   static const char* const XYZ_TAGS[]   = { "X", "Y", "Z" };
+   const ossimXmlNode* point[3];
+   const ossimXmlNode* location[3];
+   const ossimXmlNode* velocity[3];
    node = xml_nodes.begin();
 
    while (node != xml_nodes.end())
    {
-      ossimDpt3d VP;
-      sub_nodes.clear();
-      xpath  = "Location/X";
-      (*node)->findChildNodes(xpath, sub_nodes);
-      if (sub_nodes.size() == 0)
-      {
-         setErrorStatus();
-         return false;
-      }
-      VP.x = sub_nodes[0]->getText().toDouble();
-
-      sub_nodes.clear();
-      xpath  = "Location/Y";
-      (*node)->findChildNodes(xpath, sub_nodes);
-      if (sub_nodes.size() == 0)
-      {
-         setErrorStatus();
-         return false;
-      }
-      VP.y = sub_nodes[0]->getText().toDouble();
-
-      sub_nodes.clear();
-      xpath  = "Location/Z";
-      (*node)->findChildNodes(xpath, sub_nodes);
-      if (sub_nodes.size() == 0)
-      {
-         setErrorStatus();
-         return false;
-      }
-      VP.z = sub_nodes[0]->getText().toDouble();
-
-      thePosEcfSamples.push_back(VP);
-
-      ossimDpt3d VV;
-      sub_nodes.clear();
-      xpath = "Velocity/X";
-      (*node)->findChildNodes(xpath, sub_nodes);
-      if (sub_nodes.size() == 0)
+      if ( !findFirstChildren(node->get(), POINT_TAGS, 3, point) ||
+           !findFirstChildren(point[0], XYZ_TAGS, 3, location) ||
+           !findFirstChildren(point[1], XYZ_TAGS, 3, velocity) )
       {
          setErrorStatus();
          return false;
       }
-      VV.x = sub_nodes[0]->getText().toDouble();
 
-      sub_nodes.clear();
-      xpath = "Velocity/Y";
-      (*node)->findChildNodes(xpath, sub_nodes);
-      if (sub_nodes.size() == 0)
-      {
-         setErrorStatus();
-         return false;
-      }
-      VV.y = sub_nodes[0]->getText().toDouble();
-
-      sub_nodes.clear();
-      xpath = "Velocity/Z";
-      (*node)->findChildNodes(xpath, sub_nodes);
-      if (sub_nodes.size() == 0)
-      {
-         setErrorStatus();
-         return false;
-      }
-      VV.z = sub_nodes[0]->getText().toDouble();
-
-      theVelEcfSamples.push_back(VV);
-
-      sub_nodes.clear();
-      xpath  = "TIME";
-      (*node)->findChildNodes(xpath, sub_nodes);
-      if (sub_nodes.size() == 0)
-      {
-         setErrorStatus();
-         return false;
-      }
-      theEphSampTimes.push_back(convertTimeStamp(sub_nodes[0]->getText()));
+      thePosEcfSamples.push_back(ossimDpt3d(location[0]->getText().toDouble(),
+                                            location[1]->getText().toDouble(),
+                                            location[2]->getText().toDouble()));
+      theVelEcfSamples.push_back(ossimDpt3d(velocity[0]->getText().toDouble(),
+                                            velocity[1]->getText().toDouble(),
+                                            velocity[2]->getText().toDouble()));
+      theEphSampTimes.push_back(convertTimeStamp(point[2]->getText()));
 
       ++node;
    }
@@ -2339,64 +2280,28 @@ bool ossimSpotDimapSupportData::parsePart3(
    xml_nodes.clear();
    xpath = "/Dimap_Document/Geoposition/Geoposition_Points/Tie_Point";
    xmlDocument->findNodes(xpath, xml_nodes);
+   theGeoPosImagePoints.reserve(xml_nodes.size());
+   theGeoPosGroundPoints.reserve(xml_nodes.size());
+   static const char* const TIE_POINT_TAGS[] =
+   {
+      "TIE_POINT_DATA_Y", "TIE_POINT_DATA_X",
+      "TIE_POINT_CRS_Y", "TIE_POINT_CRS_X", "TIE_POINT_CRS_Z"
+   };
+   const ossimXmlNode* tiePoint[5];
    node = xml_nodes.begin();
    while (node != xml_nodes.end())
    {
-      ossimGpt gpt;
-      ossimDpt  ipt;
-
-      sub_nodes.clear();
-      xpath = "TIE_POINT_DATA_Y";
-      (*node)->findChildNodes(xpath, sub_nodes);
-      if (sub_nodes.size() == 0)
-      {
-         setErrorStatus();
-         return false;
-      }
-      ipt.line = sub_nodes[0]->getText().toDouble() - 1.0;
-
-      sub_nodes.clear();
-      xpath = "TIE_POINT_DATA_X";
-      (*node)->findChildNodes(xpath, sub_nodes);
-      if (sub_nodes.size() == 0)
-      {
-         setErrorStatus();
-         return false;
-      }
-      ipt.samp = sub_nodes[0]->getText().toDouble() - 1.0;
-
-      sub_nodes.clear();
-      xpath = "TIE_POINT_CRS_Y";
-      (*node)->findChildNodes(xpath, sub_nodes);
-      if (sub_nodes.size() == 0)
-      {
-         setErrorStatus();
-         return false;
-      }
-      gpt.lat = sub_nodes[0]->getText().toDouble();
-
-      sub_nodes.clear();
-      xpath = "TIE_POINT_CRS_X";
-      (*node)->findChildNodes(xpath, sub_nodes);
-      if (sub_nodes.size() == 0)
-      {
-         setErrorStatus();
-         return false;
-      }
-      gpt.lon = sub_nodes[0]->getText().toDouble();
-
-      sub_nodes.clear();
-      xpath = "TIE_POINT_CRS_Z";
-      (*node)->findChildNodes(xpath, sub_nodes);
-      if (sub_nodes.size() == 0)
+      if ( !findFirstChildren(node->get(), TIE_POINT_TAGS, 5, tiePoint) )
       {
          setErrorStatus();
          return false;
       }
-      gpt.hgt = sub_nodes[0]->getText().toDouble();
 
-      theGeoPosImagePoints.push_back(ipt);
-      theGeoPosGroundPoints.push_back(gpt);
+      theGeoPosImagePoints.push_back(ossimDpt(tiePoint[1]->getText().toDouble() - 1.0,
+                                              tiePoint[0]->getText().toDouble() - 1.0));
+      theGeoPosGroundPoints.push_back(ossimGpt(tiePoint[2]->getText().toDouble(),
+                                               tiePoint[3]->getText().toDouble(),
+                                               tiePoint[4]->getText().toDouble()));
 
       ++node;
    }
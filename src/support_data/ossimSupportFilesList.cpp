@@ -14,6 +14,62 @@
 
 #include <ossim/support_data/ossimSupportFilesList.h>
 #include <ossim/base/ossimKeywordlist.h>
+#include <OpenThreads/ScopedLock>
+#include <cctype>
+
+#if defined(_WIN32)
+#  include <io.h>
+#else
+#  include <dirent.h>
+#endif
+
+namespace
+{
+   // Names compare as the file system does.
+   std::string nameKey(const std::string& name)
+   {
+#if defined(_WIN32)
+      std::string key = name;
+      for (std::string::size_type i = 0; i < key.size(); ++i)
+      {
+         key[i] = static_cast<char>( std::tolower( static_cast<unsigned char>(key[i]) ) );
+      }
+      return key;
+#else
+      return name;
+#endif
+   }
+
+   // Reads the names in dir without a stat per entry.
+   bool readDirectory(const ossimFilename& dir, std::set<std::string>& names)
+   {
+#if defined(_WIN32)
+      struct _finddata_t data;
+      intptr_t handle = _findfirst( dir.dirCat("*").c_str(), &data );
+      if ( handle == -1 )
+      {
+         return false;
+      }
+      do
+      {
+         names.insert( nameKey(data.name) );
+      } while ( _findnext(handle, &data) == 0 );
+      _findclose(handle);
+#else
+      DIR* d = opendir( dir.c_str() );
+      if ( !d )
+      {
+         return false;
+      }
+      while ( dirent* de = readdir(d) )
+      {
+         names.insert( de->d_name );
+      }
+      closedir(d);
+#endif
+      return true;
+   }
+}
 
 ossimSupportFilesList* ossimSupportFilesList::m_instance = 0;
 
@@ -40,3 +96,81 @@ void ossimSupportFilesList::save(ossimKeywordlist& kwl, const char* prefix) cons
       kwl.add(prefix, key.chars(), m_list[i]);
    }
 }
+
+//*************************************************************************************************
+// Batches of support file probes
+//*************************************************************************************************
+void ossimSupportFilesList::beginBatch()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   ++m_batchCount;
+}
+
+void ossimSupportFilesList::endBatch()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   if ( m_batchCount && (--m_batchCount == 0) )
+   {
+      m_listings.clear();
+   }
+}
+
+bool ossimSupportFilesList::exists(const ossimFilename& f)
+{
+   if ( f.empty() )
+   {
+      return false;
+   }
+
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+      if ( m_batchCount )
+      {
+         std::string name;
+         Listing& listing = getListing(f, name);
+         if ( listing.m_listed )
+         {
+            return ( listing.m_names.find(name) != listing.m_names.end() );
+         }
+      }
+   }
+
+   return f.exists();
+}
+
+void ossimSupportFilesList::refresh(const ossimFilename& f)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+   if ( m_batchCount && !f.empty() )
+   {
+      std::string name;
+      Listing& listing = getListing(f, name);
+      if ( f.exists() )
+      {
+         listing.m_names.insert(name);
+      }
+      else
+      {
+         listing.m_names.erase(name);
+      }
+   }
+}
+
+ossimSupportFilesList::Listing& ossimSupportFilesList::getListing(const ossimFilename& f,
+                                                                  std::string& name)
+{
+   ossimFilename dir = f.path();
+   if ( dir.empty() )
+   {
+      dir = ".";
+   }
+   name = nameKey( f.file().string() );
+
+   std::map<std::string, Listing>::iterator i = m_listings.find( nameKey(dir.string()) );
+   if ( i == m_listings.end() )
+   {
+      i = m_listings.insert( std::make_pair(nameKey(dir.string()), Listing()) ).first;
+      i->second.m_listed = readDirectory(dir, i->second.m_names);
+   }
+   return i->second;
+}
@@ -28,6 +28,8 @@
 #include <ossim/projection/ossimProjection.h>
 #include <ossim/projection/ossimEpsgProjectionFactory.h>
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
@@ -158,12 +160,6 @@ std::ostream& ossimTiffInfo::print(std::ostream& out) const
 {
    static const char MODULE[] = "ossimTiffInfo::print";
 
-   if (traceDebug())
-   {
-      ossimNotify(ossimNotifyLevel_DEBUG)
-         << MODULE << " DEBUG Entered...\n";
-   }
-
    //---
    // Open the tif file.
    //---
@@ -177,414 +173,59 @@ std::ostream& ossimTiffInfo::print(std::ostream& out) const
       }
       return out;
    }
-   
-   //---
-   // Get the byte order.  First two byte should be "II" or "MM".
-   //---
-   char byteOrder[2];
-   str.read(byteOrder, 2); // Read the byte order.
-   ossimByteOrder sysByteOrder = ossim::byteOrder();
-   ossimByteOrder tifByteOrder = OSSIM_LITTLE_ENDIAN;
-   
-   if (byteOrder[0] == 'M')
-   {
-      tifByteOrder = OSSIM_BIG_ENDIAN;
-   }
-   
-   if (sysByteOrder != tifByteOrder)
-   {
-      if (!theEndian)
-      {
-         theEndian = new ossimEndian();
-      }
-   }
-   else if (theEndian) // No swapping required.
-   {
-      delete theEndian;
-      theEndian = 0;
-   }
-
-   //--
-   // Get the version. Note theEndian must be set/unset before calling
-   // "readShort".
-   //---
-   ossim_uint16 version;
-   readShort(version, str);
-
-   // Set the tag value length.
-   ossim_uint64 tagValueLength;
-   if (version == 42)
-   {
-      tagValueLength = 4;
-   }
-   else
-   {
-      tagValueLength = 8;
-   }
-
-   out << "tiff.version: " << int(version)
-       << ((version==42)?"(classic)\n":"(big)\n")
-       << "tiff.byte_order: ";
-   
-   if (byteOrder[0] == 'M')
-   {
-      out << "big_endian\n";
-   }
-   else // OSSIM_LITTLE_ENDIAN
-   {
-      out  << "little_endian\n";
-   }
 
-   if (traceDebug())
-   {
-      ossimNotify(ossimNotifyLevel_DEBUG)<< "system_byte_order: ";
-      if (ossim::byteOrder() == OSSIM_BIG_ENDIAN)
-      {
-         ossimNotify(ossimNotifyLevel_DEBUG)<< "big_endian\n";
-      }
-      else // OSSIM_LITTLE_ENDIAN
-      {
-         ossimNotify(ossimNotifyLevel_DEBUG)<< "little_endian\n";
-      }
-      ossimNotify(ossimNotifyLevel_DEBUG)
-         << "tiff.tag_value_length: " << tagValueLength << "\n";
-   }
-
-   //---
-   // Variables used within the loop.
-   //---
-   std::streamoff seekOffset;      // used throughout
-   std::streampos streamPosition;  // used throughout
-
-   if (version == 43)
-   {
-      // We must skip the first four bytes.
-      ossim_uint32 offsetSize;
-      readLong(offsetSize, str);
-   }
+   return print(str, out);
+}
 
-   // Get the offset.
-   if (getOffset(seekOffset, str, version) == false)
-   {
-     ossimNotify(ossimNotifyLevel_WARN) 
-        << MODULE << " FATAL ERROR - "
-        << "No offset to an image file directory found.\n"
-        << "Returning with error."
-        << std::endl;
-     str.close();
-     return out;
-   }
-   
-   if (traceDebug())
-   {
-      ossimNotify(ossimNotifyLevel_DEBUG)
-         << MODULE << " DEBUG: "
-         << "Offset to first ifd:  " << seekOffset
-         << "\n";
-   }
+bool ossimTiffInfo::getImageSummary(ossimKeywordlist& kwl, const std::string& prefix) const
+{
+   // The tags of the directories, from the header walk of print:
+   std::ostringstream out;
+   print(out);
+   std::istringstream in(out.str());
+   ossimKeywordlist tiffKwl;
+   tiffKwl.parseStream(in);
 
-   // Capture the original flags then set float output to full precision.
-   std::ios_base::fmtflags f = out.flags();
-   out << std::setprecision(15);
-   
-   // Image File Directory (IFD) loop.
-   ossim_int32 ifdIndex = 0;
-   while(seekOffset)
+   ossim_uint32 entries = 0;
+   while ( 1 )
    {
-      out << "tiff.directory_offset: " << seekOffset << "\n";
-
-      // Seek to the image file directory.
-      str.seekg(seekOffset, std::ios_base::beg);  
-
-      // directory prefix for prints.
-      std::string prefix = "tiff.";
-      getDirPrefix(ifdIndex, prefix);
-
-      //---
-      // Things we need to save for printGeoKeys:
-      //---
-      ossim_uint16*  geoKeyBlock     = 0;
-      ossim_uint64   geoKeyLength    = 0;
-      ossim_float64* geoDoubleBlock  = 0;
-      ossim_uint64   geoDoubleLength = 0;
-      ossim_int8*    geoAsciiBlock   = 0;
-      ossim_uint64   geoAsciiLength  = 0;
-      
-      //---
-      // Get the number of directories within the IFD.
-      //---
-      ossim_uint64 nTags; // Number of tags in an IFD.
-      if (getValue(nTags, str, TWO_OR_EIGHT, version) == false)
-      {
-         if(traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_WARN)
-               << MODULE << " FATAL error reading number of direcories."
-               << std::endl;
-         }
-         str.close();
-         return out;
-      }
-
-      if (traceDebug())
-      {
-         ossimNotify(ossimNotifyLevel_DEBUG)
-            << MODULE << " DEBUG:\n"
-            << "ifd:  " << seekOffset
-            << "\ntags in directory:  " << nTags<< "\n";
-      }
-
-      // Tag loop:
-      for (ossim_uint64 tagIdx = 0; tagIdx < nTags; ++tagIdx)
-      {
-         // Variables used within the loop.
-         ossim_uint16   tag              = 0; // Tag number
-         ossim_uint16   type             = 0; // Type(short, long...)
-         ossim_uint64   count            = 0;
-         ossim_uint64   arraySizeInBytes = 0; // 
-         ossim_uint8*   valueArray       = 0; // To hold value.
-         
-         //---
-         // Get the tag.
-         //---
-         readShort(tag, str);
-         if (!str)
-         {
-            if(traceDebug())
-            {
-               ossimNotify(ossimNotifyLevel_WARN)
-                  << MODULE << " FATAL error reading tag number."
-                  << std::endl;
-            }
-            str.close();
-            return out;
-         }
-
-         //---
-         // Get the type (byte, ascii, short...)
-         //---
-         readShort(type, str);
-         if (!str)
-         {
-            if(traceDebug())
-            {
-               ossimNotify(ossimNotifyLevel_WARN)
-                  << MODULE << " FATAL error reading type number."
-                  << std::endl;
-            }
-            str.close();
-            return out;
-         }
-
-         //---
-         // Get the count.  This is not in bytes.  It is based on the
-         // type.  So if the type is a short and the count is one then
-         // read "sizeof(short"(2) bytes.
-         //---
-         getValue(count, str, FOUR_OR_EIGHT, version);
-         if (!str)
-         {
-            if(traceDebug())
-            {
-               ossimNotify(ossimNotifyLevel_WARN)
-                  << MODULE << " FATAL error reading count."
-                  << std::endl;
-            }
-            str.close();
-            return out;
-         }
-
-         // Get the array size in bytes.
-         arraySizeInBytes = getArraySizeInBytes(count, type);
-         if (arraySizeInBytes == 0)
-         {
-            // Could be an unhandle type.  Gobble the value.
-            eatValue(str, version);
-         }
-         else
-         {
-            // Allocate array.
-            if (valueArray) delete [] valueArray;
-            valueArray = new ossim_uint8[arraySizeInBytes];
-
-            if (arraySizeInBytes <= tagValueLength)
-            {
-               // Read in the value(s).
-               str.read((char*)valueArray, arraySizeInBytes);
-
-               // Skip any byes left in the field.
-               if (arraySizeInBytes < tagValueLength)
-               {
-                  // Skip these bytes.
-                  str.ignore(tagValueLength-arraySizeInBytes);
-               }
-            }
-            else // Data to big for field.  Stored elsewhere...
-            {
-               // Get the offset to the data.
-               getOffset(seekOffset, str, version);
-
-               // Capture the seek position to come back to.
-               streamPosition = str.tellg();
-
-               // Seek to the data.
-               str.seekg(seekOffset, std::ios_base::beg);
-
-               // Read in the value(s).
-               str.read((char*)valueArray, arraySizeInBytes);
-
-               // Seek back.
-               str.seekg(streamPosition);
-            }
-
-            // Swap the bytes if needed.
-            swapBytes(valueArray, type, count);
-         }
-
-         if( traceDebug() )
-         {
-            ossimNotify(ossimNotifyLevel_DEBUG)
-               << MODULE << " DEBUG:"
-               << "\ntag[" << tagIdx << "]:" << tag
-               << "\ntype:                " << type
-               << "\ncount:        " << count
-               << "\narray size in bytes: " << arraySizeInBytes
-               << "\n";
-	 }
-
-         if (tag == OGEO_KEY_DIRECTORY_TAG)
-         {
-            // tag 34735 save for printGeoKeys
-            if ( geoKeyBlock )
-            {
-               delete [] geoKeyBlock;
-            }
-            geoKeyBlock = reinterpret_cast<ossim_uint16*>(valueArray);
-            geoKeyLength = count;
-         }
-         else if (tag == OGEO_DOUBLE_PARAMS_TAG)
-         {
-            // tag 34736 save for printGeoKeys
-            if ( geoDoubleBlock )
-            {
-               delete [] geoDoubleBlock;
-            }
-            geoDoubleBlock  = reinterpret_cast<ossim_float64*>(valueArray);
-            geoDoubleLength = count;
-         }
-         else if (tag == OGEO_ASCII_PARAMS_TAG)
-         {
-            // tag 34737 save for printGeoKeys
-            if ( geoAsciiBlock )
-            {
-               delete [] geoAsciiBlock;
-            }
-            geoAsciiBlock   = reinterpret_cast<ossim_int8*>(valueArray);
-            geoAsciiLength  = count;
-         }
-         else
-         {
-            print(out,
-                  prefix,
-                  tagIdx,
-                  tag,
-                  type,
-                  count,
-                  arraySizeInBytes,
-                  valueArray);
-            
-            // Free memory if allocated...
-            if (valueArray)
-            {
-               delete [] valueArray;
-               valueArray = 0;
-            }
-         }
-         
-      } // End of tag loop.
-
-      //---
-      // If Geotiff Keys read them.
-      // This had to done last since the keys could
-      // have references to tags GEO_DOUBLE_PARAMS_TAG and
-      // GEO_ASCII_PARAMS_TAG.
-      //---
-      if (geoKeyBlock)
-      {
-         printGeoKeys(out, prefix, geoKeyLength, geoKeyBlock,
-                      geoDoubleLength,geoDoubleBlock,
-                      geoAsciiLength,geoAsciiBlock);
-
-         delete [] geoKeyBlock;
-         geoKeyBlock = 0;
-      }
-
-      if (geoDoubleBlock)
+      std::string dirPrefix = "tiff.";
+      getDirPrefix(entries, dirPrefix);
+      const ossim_uint32 lines   = getLines(dirPrefix, tiffKwl);
+      const ossim_uint32 samples = getSamples(dirPrefix, tiffKwl);
+      if ( !lines || !samples )
       {
-         delete [] geoDoubleBlock;
-         geoDoubleBlock = 0;
+         break;
       }
-      if (geoAsciiBlock)
+      ossim_uint32 bands = 1;
+      const char* lookup = tiffKwl.find(dirPrefix.c_str(), "samples_per_pixel");
+      if ( lookup )
       {
-         delete [] geoAsciiBlock;
-         geoAsciiBlock = 0;
+         bands = ossimString(lookup).toUInt32();
       }
-      geoKeyLength = 0;
-      geoDoubleLength = 0;
-      geoAsciiLength = 0;
+      addImageSummary(kwl, prefix, entries, lines, samples, bands);
 
-      //---
-      // Get the next IFD offset.  Continue this loop until the offset is
-      // zero.
-      //---
-      if (getOffset(seekOffset, str, version) == false)
+      // Tie point and scale as stored; turning them into a footprint needs a projection.
+      std::ostringstream s;
+      s << prefix << "image" << entries << ".";
+      lookup = tiffKwl.find(dirPrefix.c_str(), MODEL_TIE_POINT_KW.c_str());
+      if ( lookup )
       {
-         if(traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_WARN)
-               << MODULE << " No offset to an image file directory found.\n"
-               << "Returning with error."
-               << std::endl;
-         }
-         str.close();
-         return out;
+         kwl.add(s.str().c_str(), MODEL_TIE_POINT_KW.c_str(), lookup);
       }
-      
-      if (traceDebug())
-      {
-         ossimNotify(ossimNotifyLevel_DEBUG)
-            << "DEBUG ossimTiffInfo::readTags: "
-            << "Next Image File Directory(IFD) offset = "
-            << seekOffset << "\n";
-      }
-
-      ++ifdIndex; // next ifd
-
-      //---
-      // Note this does NOT check to see if sub_file_type is '1' simply
-      // skips all directories past the first if theOverviewFlag is false.
-      //---
-      if ( ifdIndex && !theOverviewFlag) // Don't process overviews...
+      lookup = tiffKwl.find(dirPrefix.c_str(), MODEL_PIXEL_SCALE_KW.c_str());
+      if ( lookup )
       {
-         break;
+         kwl.add(s.str().c_str(), MODEL_PIXEL_SCALE_KW.c_str(), lookup);
       }
-      
-   } // End of loop through the IFD's.
-   
-   out << std::endl;
-    
-   str.close();
+      ++entries;
+   }
 
-   // Reset flags.
-   out.setf(f);
-   
-   if (traceDebug())
+   if ( entries )
    {
-      ossimNotify(ossimNotifyLevel_DEBUG)
-         << MODULE << " DEBUG Exited..." << std::endl;
+      kwl.add(prefix.c_str(), ossimKeywordNames::NUMBER_ENTRIES_KW, entries);
    }
-   
-   return out;
+   return (entries > 0);
 }
 
 std::ostream& ossimTiffInfo::print(std::istream& inStr,
@@ -718,33 +359,22 @@ std::ostream& ossimTiffInfo::print(std::istream& inStr,
    {
       outStr << "tiff.directory_offset: " << seekOffset << "\n";
 
-      // Seek to the image file directory.
-      inStr.seekg(startPosition+seekOffset, std::ios_base::beg);  
-
       // directory prefix for prints.
       std::string prefix = "tiff.";
       getDirPrefix(ifdIndex, prefix);
 
       //---
-      // Things we need to save for printGeoKeys:
-      //---
-      ossim_uint16*  geoKeyBlock     = 0;
-      ossim_uint64   geoKeyLength    = 0;
-      ossim_float64* geoDoubleBlock  = 0;
-      ossim_uint64   geoDoubleLength = 0;
-      ossim_int8*    geoAsciiBlock   = 0;
-      ossim_uint64   geoAsciiLength  = 0;
-      
-      //---
-      // Get the number of directories within the IFD.
+      // Read the directory, with its values, in a few large reads.
       //---
-      ossim_uint64 nTags; // Number of tags in an IFD.
-      if (getValue(nTags, inStr, TWO_OR_EIGHT, version) == false)
+      std::vector<IfdEntry> entries;
+      std::vector<ossim_uint8> values;
+      std::streamoff nextOffset = 0;
+      if ( !readIfd(inStr, startPosition, seekOffset, version, entries, values, nextOffset) )
       {
          if(traceDebug())
          {
             ossimNotify(ossimNotifyLevel_WARN)
-               << MODULE << " FATAL error reading number of direcories."
+               << MODULE << " FATAL error reading image file directory."
                << std::endl;
          }
          return outStr;
@@ -752,165 +382,67 @@ std::ostream& ossimTiffInfo::print(std::istream& inStr,
 
       if (traceDebug())
       {
-         if(traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_DEBUG)
-               << MODULE << " DEBUG:\n"
-               << "ifd:  " << seekOffset
-               << "\ntags in directory:  " << nTags<< "\n";
-         }
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << MODULE << " DEBUG:\n"
+            << "ifd:  " << seekOffset
+            << "\ntags in directory:  " << entries.size() << "\n";
       }
 
-      // Tag loop:
-      for (ossim_uint64 tagIdx = 0; tagIdx < nTags; ++tagIdx)
-      {
-         // Variables used within the loop.
-         ossim_uint16   tag              = 0; // Tag number
-         ossim_uint16   type             = 0; // Type(short, long...)
-         ossim_uint64   count            = 0;
-         ossim_uint64   arraySizeInBytes = 0; // 
-         ossim_uint8*   valueArray       = 0; // To hold value.
-         
-         //---
-         // Get the tag.
-         //---
-         readShort(tag, inStr);
-         if (!inStr)
-         {
-            if(traceDebug())
-            {
-               ossimNotify(ossimNotifyLevel_WARN)
-                  << MODULE << " FATAL error reading tag number."
-                  << std::endl;
-            }
-            return outStr;
-         }
-
-         //---
-         // Get the type (byte, ascii, short...)
-         //---
-         readShort(type, inStr);
-         if (!inStr)
-         {
-            if(traceDebug())
-            {
-               ossimNotify(ossimNotifyLevel_WARN)
-                  << MODULE << " FATAL error reading type number."
-                  << std::endl;
-            }
-            return outStr;
-         }
-
-         //---
-         // Get the count.  This is not in bytes.  It is based on the
-         // type.  So if the type is a short and the count is one then
-         // read "sizeof(short"(2) bytes.
-         //---
-         getValue(count, inStr, FOUR_OR_EIGHT, version);
-         if (!inStr)
-         {
-            if(traceDebug())
-            {
-               ossimNotify(ossimNotifyLevel_WARN)
-                  << MODULE << " FATAL error reading count."
-                  << std::endl;
-            }
-            return outStr;
-         }
-
-         // Get the array size in bytes.
-         arraySizeInBytes = getArraySizeInBytes(count, type);
-         if (arraySizeInBytes == 0)
-         {
-            // Could be an unhandle type.  Gobble the value.
-            eatValue(inStr, version);
-         }
-         else
-         {
-            // Allocate array.
-            if (valueArray) delete [] valueArray;
-            valueArray = new ossim_uint8[arraySizeInBytes];
-
-            if (arraySizeInBytes <= tagValueLength)
-            {
-               // Read in the value(s).
-               inStr.read((char*)valueArray, arraySizeInBytes);
-
-               // Skip any byes left in the field.
-               if (arraySizeInBytes < tagValueLength)
-               {
-                  // Skip these bytes.
-                  inStr.ignore(tagValueLength-arraySizeInBytes);
-               }
-            }
-            else // Data to big for field.  Stored elsewhere...
-            {
-               // Get the offset to the data.
-               getOffset(seekOffset, inStr, version);
-
-               // Capture the seek position to come back to.
-               streamPosition = inStr.tellg();
-
-               // Seek to the data.
-               inStr.seekg(startPosition+seekOffset, std::ios_base::beg);
-
-               // Read in the value(s).
-               inStr.read((char*)valueArray, arraySizeInBytes);
-
-               // Seek back.
-               inStr.seekg(streamPosition);
-            }
+      //---
+      // Things we need to save for printGeoKeys.  These point into values.
+      //---
+      ossim_uint16*  geoKeyBlock     = 0;
+      ossim_uint64   geoKeyLength    = 0;
+      ossim_float64* geoDoubleBlock  = 0;
+      ossim_uint64   geoDoubleLength = 0;
+      ossim_int8*    geoAsciiBlock   = 0;
+      ossim_uint64   geoAsciiLength  = 0;
 
-            // Swap the bytes if needed.
-            swapBytes(valueArray, type, count);
-         }
+      // Tag loop:
+      for (ossim_uint64 tagIdx = 0; tagIdx < entries.size(); ++tagIdx)
+      {
+         const IfdEntry& ENTRY = entries[tagIdx];
+         ossim_uint8* valueArray = ENTRY.theLoadedFlag ? &values[ENTRY.theValueOffset] : 0;
 
          if( traceDebug() )
          {
             ossimNotify(ossimNotifyLevel_DEBUG)
                << MODULE << " DEBUG:"
-               << "\ntag[" << tagIdx << "]:" << tag
-               << "\ntype:                " << type
-               << "\ncount:        " << count
-               << "\narray size in bytes: " << arraySizeInBytes
+               << "\ntag[" << tagIdx << "]:" << ENTRY.theTag
+               << "\ntype:                " << ENTRY.theType
+               << "\ncount:        " << ENTRY.theCount
+               << "\narray size in bytes: " << ENTRY.theArraySizeInBytes
                << "\n";
          }
 
-         if (tag == OGEO_KEY_DIRECTORY_TAG)
+         if (ENTRY.theTag == OGEO_KEY_DIRECTORY_TAG)
          {
             // tag 34735 save for printGeoKeys
             geoKeyBlock = reinterpret_cast<ossim_uint16*>(valueArray);
-            geoKeyLength = count;
+            geoKeyLength = ENTRY.theCount;
          }
-         else if (tag == OGEO_DOUBLE_PARAMS_TAG)
+         else if (ENTRY.theTag == OGEO_DOUBLE_PARAMS_TAG)
          {
             // tag 34736 save for printGeoKeys
             geoDoubleBlock  = reinterpret_cast<ossim_float64*>(valueArray);
-            geoDoubleLength = count;
+            geoDoubleLength = ENTRY.theCount;
          }
-         else if (tag == OGEO_ASCII_PARAMS_TAG)
+         else if (ENTRY.theTag == OGEO_ASCII_PARAMS_TAG)
          {
             // tag 34737 save for printGeoKeys
             geoAsciiBlock   = reinterpret_cast<ossim_int8*>(valueArray);
-            geoAsciiLength  = count;
+            geoAsciiLength  = ENTRY.theCount;
          }
          else
          {
             print(outStr,
                   prefix,
                   tagIdx,
-                  tag,
-                  type,
-                  count,
-                  arraySizeInBytes,
+                  ENTRY.theTag,
+                  ENTRY.theType,
+                  ENTRY.theCount,
+                  ENTRY.theArraySizeInBytes,
                   valueArray);
-            
-            // Free memory if allocated...
-            if (valueArray)
-            {
-               delete [] valueArray;
-               valueArray = 0;
-            }
          }
          
       } // End of tag loop.
@@ -926,40 +458,13 @@ std::ostream& ossimTiffInfo::print(std::istream& inStr,
          printGeoKeys(outStr, prefix, geoKeyLength, geoKeyBlock,
                       geoDoubleLength,geoDoubleBlock,
                       geoAsciiLength,geoAsciiBlock);
-
-         delete [] geoKeyBlock;
-         geoKeyBlock = 0;
       }
 
-      if (geoDoubleBlock)
-      {
-         delete [] geoDoubleBlock;
-         geoDoubleBlock = 0;
-      }
-      if (geoAsciiBlock)
-      {
-         delete [] geoAsciiBlock;
-         geoAsciiBlock = 0;
-      }
-      geoKeyLength = 0;
-      geoDoubleLength = 0;
-      geoAsciiLength = 0;
-
       //---
       // Get the next IFD offset.  Continue this loop until the offset is
       // zero.
       //---
-      if (getOffset(seekOffset, inStr, version) == false)
-      {
-         if(traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_WARN)
-               << MODULE << " No offset to an image file directory found.\n"
-               << "Returning with error."
-               << std::endl;
-         }
-         return outStr;
-      }
+      seekOffset = nextOffset;
       
       if (traceDebug())
       {
@@ -1496,6 +1001,185 @@ bool ossimTiffInfo::getValue(ossim_uint64& value,
    return status;
 }
 
+bool ossimTiffInfo::readIfd(std::istream& str,
+                            std::streampos startPosition,
+                            std::streamoff ifdOffset,
+                            ossim_uint16 version,
+                            std::vector<IfdEntry>& entries,
+                            std::vector<ossim_uint8>& values,
+                            std::streamoff& nextOffset) const
+{
+   // Out of line values closer than this are read together.
+   const ossim_uint64 MAX_GAP = 65536;
+
+   const bool BIG = (version != 42);
+   const ossim_uint64 ENTRY_SIZE  = BIG ? 20 : 12;
+   const ossim_uint64 OFFSET_SIZE = BIG ? 8 : 4;
+
+   entries.clear();
+   values.clear();
+   nextOffset = 0;
+
+   str.seekg(startPosition+ifdOffset, std::ios_base::beg);
+
+   ossim_uint64 nTags; // Number of tags in an IFD.
+   if ( !getValue(nTags, str, TWO_OR_EIGHT, version) || !nTags )
+   {
+      return false;
+   }
+
+   // Entries and the next directory offset in one read.
+   if ( nTags > 1000000 )
+   {
+      return false; // Corrupt.
+   }
+   std::vector<ossim_uint8> table( static_cast<std::size_t>(nTags*ENTRY_SIZE + OFFSET_SIZE) );
+   str.read( (char*)&table.front(), table.size() );
+   if ( static_cast<ossim_uint64>(str.gcount()) < nTags*ENTRY_SIZE )
+   {
+      return false;
+   }
+   const bool HAS_NEXT = ( static_cast<std::size_t>(str.gcount()) == table.size() );
+   str.clear();
+
+   // Lay the values out in "values", 8 byte aligned for the casts to doubles.
+   std::vector< std::pair<ossim_uint64, ossim_uint64> > outOfLine; // file offset, entry
+   ossim_uint64 valuesSize = 0;
+   entries.resize( static_cast<std::size_t>(nTags) );
+   for (ossim_uint64 i = 0; i < nTags; ++i)
+   {
+      const ossim_uint8* p = &table[ static_cast<std::size_t>(i*ENTRY_SIZE) ];
+      IfdEntry& entry = entries[ static_cast<std::size_t>(i) ];
+      entry.theTag   = getBufferShort(p);
+      entry.theType  = getBufferShort(p + 2);
+      entry.theCount = BIG ? getBufferLongLong(p + 4) : getBufferLong(p + 4);
+      entry.theArraySizeInBytes = getArraySizeInBytes(entry.theCount, entry.theType);
+      entry.theValueOffset = 0;
+      entry.theLoadedFlag  = false;
+
+      if ( !entry.theArraySizeInBytes || isValueSkipped(entry.theTag) )
+      {
+         continue;
+      }
+
+      entry.theValueOffset = valuesSize;
+      entry.theLoadedFlag  = true;
+      valuesSize += (entry.theArraySizeInBytes + 7) & ~((ossim_uint64)7);
+      if ( entry.theArraySizeInBytes > OFFSET_SIZE )
+      {
+         const ossim_uint8* v = p + (BIG ? 12 : 8);
+         const ossim_uint64 OFFSET = BIG ? getBufferLongLong(v) : getBufferLong(v);
+         outOfLine.push_back( std::make_pair(OFFSET, i) );
+      }
+   }
+   values.resize( static_cast<std::size_t>(valuesSize) );
+
+   // In line values.
+   for (ossim_uint64 i = 0; i < nTags; ++i)
+   {
+      const IfdEntry& ENTRY = entries[ static_cast<std::size_t>(i) ];
+      if ( ENTRY.theLoadedFlag && (ENTRY.theArraySizeInBytes <= OFFSET_SIZE) )
+      {
+         memcpy( &values[ static_cast<std::size_t>(ENTRY.theValueOffset) ],
+                 &table[ static_cast<std::size_t>(i*ENTRY_SIZE + (BIG ? 12 : 8)) ],
+                 static_cast<std::size_t>(ENTRY.theArraySizeInBytes) );
+      }
+   }
+
+   //---
+   // Out of line values, in file order, one read per cluster.  Short reads
+   // (truncated file) leave zeros.
+   //---
+   std::sort( outOfLine.begin(), outOfLine.end() );
+   std::vector<ossim_uint8> cluster;
+   for (std::size_t first = 0; first < outOfLine.size(); )
+   {
+      const ossim_uint64 BEGIN = outOfLine[first].first;
+      ossim_uint64 end = BEGIN +
+         entries[ static_cast<std::size_t>(outOfLine[first].second) ].theArraySizeInBytes;
+      std::size_t last = first + 1;
+      while ( (last < outOfLine.size()) && (outOfLine[last].first <= end + MAX_GAP) )
+      {
+         end = std::max( end, outOfLine[last].first +
+            entries[ static_cast<std::size_t>(outOfLine[last].second) ].theArraySizeInBytes );
+         ++last;
+      }
+
+      cluster.assign( static_cast<std::size_t>(end - BEGIN), 0 );
+      str.seekg( startPosition + std::streamoff(BEGIN), std::ios_base::beg );
+      str.read( (char*)&cluster.front(), cluster.size() );
+      str.clear();
+
+      for (std::size_t k = first; k < last; ++k)
+      {
+         const IfdEntry& ENTRY = entries[ static_cast<std::size_t>(outOfLine[k].second) ];
+         memcpy( &values[ static_cast<std::size_t>(ENTRY.theValueOffset) ],
+                 &cluster[ static_cast<std::size_t>(outOfLine[k].first - BEGIN) ],
+                 static_cast<std::size_t>(ENTRY.theArraySizeInBytes) );
+      }
+      first = last;
+   }
+
+   // Swap the bytes if needed.
+   for (std::size_t i = 0; i < entries.size(); ++i)
+   {
+      if ( entries[i].theLoadedFlag )
+      {
+         swapBytes( &values[ static_cast<std::size_t>(entries[i].theValueOffset) ],
+                    entries[i].theType, entries[i].theCount );
+      }
+   }
+
+   if ( HAS_NEXT )
+   {
+      const ossim_uint8* p = &table[ static_cast<std::size_t>(nTags*ENTRY_SIZE) ];
+      nextOffset = static_cast<std::streamoff>( BIG ? getBufferLongLong(p) : getBufferLong(p) );
+   }
+   return true;
+}
+
+bool ossimTiffInfo::isValueSkipped(ossim_uint16 tag) const
+{
+   // Only printed when dumping, and can be megabytes on large tiled images.
+   return !traceDump() &&
+      ( (tag == OTIFFTAG_STRIPOFFSETS) || (tag == OTIFFTAG_STRIPBYTECOUNTS) ||
+        (tag == OTIFFTAG_TILEOFFSETS)  || (tag == OTIFFTAG_TILEBYTECOUNTS) );
+}
+
+ossim_uint16 ossimTiffInfo::getBufferShort(const ossim_uint8* p) const
+{
+   ossim_uint16 s;
+   memcpy(&s, p, sizeof(s));
+   if (theEndian)
+   {
+      theEndian->swap(s);
+   }
+   return s;
+}
+
+ossim_uint32 ossimTiffInfo::getBufferLong(const ossim_uint8* p) const
+{
+   ossim_uint32 l;
+   memcpy(&l, p, sizeof(l));
+   if (theEndian)
+   {
+      theEndian->swap(l);
+   }
+   return l;
+}
+
+ossim_uint64 ossimTiffInfo::getBufferLongLong(const ossim_uint8* p) const
+{
+   ossim_uint64 l;
+   memcpy(&l, p, sizeof(l));
+   if (theEndian)
+   {
+      theEndian->swap(l);
+   }
+   return l;
+}
+
+
 ossim_uint64 ossimTiffInfo::getArraySizeInBytes(ossim_uint64 length,
                                                 ossim_uint16 type) const
 {
@@ -17,6 +17,7 @@
 
 #include <ossim/base/ossimArgumentParser.h>
 #include <ossim/base/ossimApplicationUsage.h>
+#include <ossim/base/ossimCommon.h>
 #include <ossim/base/ossimConnectableObject.h>
 #include <ossim/base/ossimDate.h>
 #include <ossim/base/ossimException.h>
@@ -45,6 +46,12 @@
 #include <ossim/imaging/ossimImageHandlerRegistry.h>
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/init/ossimInit.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <OpenThreads/Block>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
 
 #include <iostream>
 
@@ -71,6 +78,7 @@ static const std::string ROI_MAX_LON_KW                 = "roi_max_lon";
 static const std::string ROI_MIN_LAT_KW                 = "roi_min_lat";
 static const std::string ROI_MIN_LON_KW                 = "roi_min_lon";
 static const std::string ROI_WIDTH_KW                   = "roi_width";   // pixels
+static const std::string THREADS_KW                     = "threads";
 static const std::string REPORT_FILE_KW                 = "report_file";
         
 static const std::string FILE_KW                 = "file";
@@ -96,6 +104,112 @@ static const std::string OAX_HGT_SIGMA_KW               = "oax_hgt_sigma";
 static const std::string OAX_CONTROL_SIGMA_KW           = "oax_control_sigma";
 static const std::string OAX_MAX_ITERATIONS_KW          = "oax_max_iterations";
 
+namespace
+{
+   /**
+    * Hands the measurements of one image out to its jobs one block at a
+    * time and counts the jobs done.
+    */
+   class ossimAutRegDropBatch : public ossimReferenced
+   {
+   public:
+      ossimAutRegDropBatch(ossim_uint32 items, ossim_uint32 jobs)
+         : m_next(0),
+           m_items(items),
+           m_jobs(jobs)
+      {
+         if(m_jobs)
+         {
+            m_block.reset();
+         }
+         else
+         {
+            m_block.release();
+         }
+      }
+      bool next(ossim_uint32& first, ossim_uint32& last)
+      {
+         const ossim_uint32 BLOCK = 32;
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if ( m_next >= m_items )
+         {
+            return false;
+         }
+         first  = m_next;
+         m_next = ossim::min( m_next + BLOCK, m_items );
+         last   = m_next;
+         return true;
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_jobs && (--m_jobs == 0))
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+   private:
+      OpenThreads::Mutex m_mutex;
+      OpenThreads::Block m_block;
+      ossim_uint32       m_next;
+      ossim_uint32       m_items;
+      ossim_uint32       m_jobs;
+   };
+
+   //---
+   // Drops control image points to the ground until the batch runs out.  Each
+   // job projects on its own copy of the geometry, as rigorous models are not
+   // thread safe; the copy keeps its DEM intersection state from one point to
+   // the next of its blocks.
+   //---
+   class ossimAutRegDropJob : public ossimJob
+   {
+   public:
+      ossimAutRegDropJob(const ossimImageGeometry* prototype,
+                         const std::vector<ossimDpt>& imgPts,
+                         std::vector<ossimGpt>& worldPts,
+                         ossimAutRegDropBatch* batch)
+         : m_prototype(prototype),
+           m_imgPts(imgPts),
+           m_worldPts(worldPts),
+           m_batch(batch)
+      {
+         setName("ossimAutRegUtil.drop");
+      }
+      virtual void start()
+      {
+         ossimRefPtr<ossimImageGeometry> geom = new ossimImageGeometry(*m_prototype);
+         ossim_uint32 first;
+         ossim_uint32 last;
+         while ( m_batch->next(first, last) )
+         {
+            for ( ossim_uint32 i = first; i < last; ++i )
+            {
+               ossimGpt worldPt;
+               geom->localToWorld(m_imgPts[i], worldPt);
+               if (worldPt.isHgtNan())
+               {
+                  ossim_float64 hgt =
+                     ossimElevManager::instance()->getHeightAboveEllipsoid(worldPt);
+                  worldPt.height(hgt);
+               }
+               m_worldPts[i] = worldPt;
+            }
+         }
+         m_batch->done();
+      }
+   private:
+      const ossimImageGeometry*         m_prototype;
+      const std::vector<ossimDpt>&      m_imgPts;
+      std::vector<ossimGpt>&            m_worldPts;
+      ossimRefPtr<ossimAutRegDropBatch> m_batch;
+   };
+}
+
 
 //*****************************************************************************
 //  METHOD: ossimAutRegUtil::ossimAutRegUtil()
@@ -204,6 +318,8 @@ void ossimAutRegUtil::addArguments(ossimArgumentParser& ap)
 
    au->addCommandLineOption("--oax_config_file","<file_path>\nSpecify a keyword list oax configuration file.");
 
+   au->addCommandLineOption("--threads","<threads>\nThreads for the ground projection of control points.\nDefault = number of processors.");
+
    
 } // End: ossimAutRegUtil::addArguments
 
@@ -320,6 +436,12 @@ bool ossimAutRegUtil::initialize(ossimArgumentParser& ap)
      m_kwl->addPair( std::string(OAX_CONFIG_FILE_KW), tempString1 );
    }
 
+   // threads
+   if( ap.read("--threads", stringParam1))
+   {
+     m_kwl->addPair( THREADS_KW, tempString1 );
+   }
+
    // llwh chipping parameters
    if( ap.read("--roi-center-llwh", stringParam1, stringParam2, stringParam3, stringParam4) )
    {
@@ -890,8 +1012,33 @@ bool ossimAutRegUtil::populateObsSet()
    ossimString id;
    ossimGpt gp;
 
+   //---
+   // Collect the measurements, then drop those of control images to the
+   // ground on a job queue; the point drops, DEM intersections for rigorous
+   // models, are most of the time spent here for large strips.
+   //---
+   const ossim_uint32 COUNT = static_cast<ossim_uint32>( m_tGen->numMeasurements() );
+   std::vector<ossimDpt> imgPts[2];
+   std::vector<ossimGpt> worldPts[2];
+   ossimFilename filename[2];
+   for (int img=0; img<2; ++img)
+   {
+      imgPts[img].resize(COUNT);
+      for (ossim_uint32 m=0; m<COUNT; ++m)
+      {
+         imgPts[img][m] = m_tGen->pointIndexedAt(img,m);
+      }
+      if (m_controlImage[img])
+      {
+         dropControlPoints(img, imgPts[img], worldPts[img]);
+      }
+      else
+      {
+         filename[img] = m_imgLayer[img]->getImageHandler()->getFilename();
+      }
+   }
 
-   for (int m=0; m<m_tGen->numMeasurements(); ++m)
+   for (ossim_uint32 m=0; m<COUNT; ++m)
    {
       id = ossimString::toString(m+1);
 
@@ -901,20 +1048,10 @@ bool ossimAutRegUtil::populateObsSet()
 
       for (int img=0; img<2; ++img)
       {
-         ossimDpt imgPt = m_tGen->pointIndexedAt(img,m);
          // If control, set ground coordinates and reset sigmas
          if (m_controlImage[img])
          {
-            // Point drop to get control coordinates
-            ossimGpt worldPt;
-            m_geom[img]->localToWorld(imgPt, worldPt);
-            if (worldPt.isHgtNan())
-            {
-               ossim_float64 hgt =
-                  ossimElevManager::instance()->getHeightAboveEllipsoid(worldPt);
-               worldPt.height(hgt);
-            }
-            pt->Gpt() = worldPt;
+            pt->Gpt() = worldPts[img][m];
 
             // Set control sigmas
             pt->setGroundSigmas
@@ -922,11 +1059,8 @@ bool ossimAutRegUtil::populateObsSet()
          }
          else
          {
-            // Get image filename
-            ossimFilename filename = m_imgLayer[img]->getImageHandler()->getFilename();
-            
             // Add measurement to point observation
-            pt->addMeasurement(imgPt, filename);
+            pt->addMeasurement(imgPts[img][m], filename[img]);
          }
       }
       // Add point observation to set
@@ -945,6 +1079,60 @@ bool ossimAutRegUtil::populateObsSet()
 }
 
 
+//*****************************************************************************
+//  METHOD: ossimAutRegUtil::dropControlPoints()
+//  
+//  Ground points of the image points of control image img.
+//  
+//*****************************************************************************
+void ossimAutRegUtil::dropControlPoints(int img,
+                                        const std::vector<ossimDpt>& imgPts,
+                                        std::vector<ossimGpt>& worldPts) const
+{
+   worldPts.resize(imgPts.size());
+   if ( imgPts.empty() )
+   {
+      return;
+   }
+
+   ossim_uint32 threads = 0;
+   std::string value = m_kwl->findKey(THREADS_KW);
+   if ( value.size() )
+   {
+      threads = ossimString(value).toUInt32();
+   }
+   if ( !threads )
+   {
+      threads = static_cast<ossim_uint32>( OpenThreads::GetNumberOfProcessors() );
+   }
+
+   // A block of points per job pick, so a few points do not start many threads:
+   const ossim_uint32 JOBS = ossim::max<ossim_uint32>(
+      1, ossim::min<ossim_uint32>( threads, static_cast<ossim_uint32>(imgPts.size() / 32) ) );
+   ossimRefPtr<ossimAutRegDropBatch> batch =
+      new ossimAutRegDropBatch( static_cast<ossim_uint32>(imgPts.size()), JOBS );
+   std::vector< ossimRefPtr<ossimAutRegDropJob> > jobs;
+   for ( ossim_uint32 i = 0; i < JOBS; ++i )
+   {
+      jobs.push_back( new ossimAutRegDropJob( m_geom[img].get(), imgPts, worldPts, batch.get() ) );
+   }
+
+   if ( JOBS == 1 )
+   {
+      jobs[0]->start();
+   }
+   else
+   {
+      ossimRefPtr<ossimJobMultiThreadQueue> queue = new ossimJobMultiThreadQueue(0, JOBS);
+      for ( ossim_uint32 i = 0; i < JOBS; ++i )
+      {
+         queue->getJobQueue()->add(jobs[i].get(), false);
+      }
+      batch->wait();
+   }
+}
+
+
 //*****************************************************************************
 //  METHOD: ossimAutRegUtil::configureTieMeasGenerator()
 //  
@@ -1583,10 +1771,10 @@ ossimRefPtr<ossimSingleImageChain> ossimAutRegUtil::createChain(const ossimFilen
             ic->setAddResamplerCacheFlag(true);
 
             //---
-            // Don't need a chain cache as we're doing a sequential write.  So the same tile
-            // should never be visited more than once.
+            // Chain cache, as the patches read by the tie point generator overlap, so
+            // neighboring measurements share the reads of the tiles under them.
             //---
-            ic->setAddChainCacheFlag(false);
+            ic->setAddChainCacheFlag(true);
 
 
             // // Brightness, contrast. Note in same filter.
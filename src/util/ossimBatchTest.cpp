@@ -22,6 +22,7 @@
 #include <ossim/base/ossimTimer.h>
 #include <ossim/init/ossimInit.h>
 
+#include <cerrno>
 #include <cstdlib> /* for system() */
 #include <ctime>
 #include <iomanip>
@@ -29,8 +30,67 @@
 #include <string>
 #include <sstream>
 
+#if !defined(_WIN32)
+#  include <sys/types.h>
+#  include <sys/resource.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
 using namespace std;
 
+static const double DEFAULT_PERFORMANCE_TOLERANCE = 0.10;
+
+namespace
+{
+   //---
+   // Runs the command through the shell like system(), adding the CPU seconds of the command
+   // and keeping the largest resident set of the commands in KB. Only the wall time is
+   // measured by the caller on Windows.
+   //---
+   int runCommand(const char* command, double& cpuTime, ossim_uint64& peakRss)
+   {
+#if defined(_WIN32)
+      return system(command);
+#else
+      cout << flush;
+      pid_t pid = fork();
+      if (pid < 0)
+      {
+         return -1;
+      }
+      if (pid == 0)
+      {
+         execl("/bin/sh", "sh", "-c", command, (char*)0);
+         _exit(127);
+      }
+
+      int status = -1;
+      struct rusage usage;
+      while (wait4(pid, &status, 0, &usage) < 0)
+      {
+         if (errno != EINTR)
+         {
+            return -1;
+         }
+      }
+
+      cpuTime += usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1.0e-6 +
+                 usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1.0e-6;
+#if defined(__APPLE__)
+      const ossim_uint64 RSS = (ossim_uint64)usage.ru_maxrss / 1024; // bytes on OS X
+#else
+      const ossim_uint64 RSS = (ossim_uint64)usage.ru_maxrss;
+#endif
+      if (RSS > peakRss)
+      {
+         peakRss = RSS;
+      }
+      return status;
+#endif
+   }
+}
+
 //**************************************************************************************************
 // Constructor
 //**************************************************************************************************
@@ -44,7 +104,11 @@ ossimBatchTest::ossimBatchTest()
    m_configFileName(),
    m_outDir(),
    m_expDir(),
-   m_logStr()
+   m_logStr(),
+   m_recordBaselines(false),
+   m_perfTolerance(-1.0),
+   m_baselineFile(),
+   m_baselines()
 {
 }
 
@@ -170,6 +234,16 @@ bool ossimBatchTest::initialize(ossimArgumentParser& ap)
       }
    }
 
+   if ( ap.read("-b") || ap.read("--record-baselines") )
+   {
+      m_recordBaselines = true;
+   }
+
+   if ( ap.read("--performance-tolerance", stringParam) )
+   {
+      m_perfTolerance = ossimString(tempString).toDouble();
+   }
+
    // End of arg parsing.
    ap.reportRemainingOptionsAsUnrecognized();
    if ( ap.errors() )
@@ -295,6 +369,14 @@ void ossimBatchTest::writeTemplate(const ossimFilename& templateFile, bool write
          << "// Where you want the top-level (inter-test) log files to go:\n"
          << "log_directory: $(OBT_OUT_DIR)\\..\\log\n"
          << "\n"
+         << "// Performance baselines of the test commands, written with -b or --record-baselines\n"
+         << "// (default $(OBT_EXP_DIR)\\baselines.kwl):\n"
+         << "baseline_file: $(OBT_EXP_DIR)\\baselines.kwl\n"
+         << "\n"
+         << "// A test fails when its test commands take more than the baseline times\n"
+         << "// (1 + performance_tolerance). Overridden by --performance-tolerance.\n"
+         << "performance_tolerance: 0.10\n"
+         << "\n"
          << "//===================================================================================\n"
          << "// Begin Test 1\n"
          << "// NOTE: If the config file contains just a single test, then the use of the \"test1\"\n"
@@ -339,6 +421,16 @@ void ossimBatchTest::writeTemplate(const ossimFilename& templateFile, bool write
          << "// Post process commands for diffs, etc.\n"
          << "//-------------------------------------------\n"
          << "test1.postprocess_command0: $(DIFF_CMD) $(OBT_EXP_DIR)\\height.txt $(OBT_OUT_DIR)\\height.txt\n"
+         << "\n"
+         << "//-------------------------------------------\n"
+         << "// Optional performance baselines of the test commands. These override the\n"
+         << "// baseline_file. Wall and cpu times are in seconds, peak resident set in KB.\n"
+         << "// CPU time and peak rss are not measured on Windows.\n"
+         << "//-------------------------------------------\n"
+         << "// test1.baseline_wall_time: 2.5\n"
+         << "// test1.baseline_cpu_time: 2.2\n"
+         << "// test1.baseline_peak_rss: 65536\n"
+         << "// test1.performance_tolerance: 0.25\n"
          << " \n"
          << "\n"
          << "// End <TEST_NAME>\n"
@@ -497,8 +589,21 @@ ossim_uint8 ossimBatchTest::execute()
          preprocessKwl(m_runTestList, testCommand, kwl);
       }
 
+      // Baselines of the test command performance, kept with the expected results by default:
+      m_baselineFile = m_expDir.dirCat("baselines.kwl");
+      const char* lookup = kwl.find("baseline_file");
+      if ( lookup )
+      {
+         m_baselineFile = convertToNative( lookup ).c_str();
+      }
+      m_baselines.clear();
+      if ( m_baselineFile.exists() )
+      {
+         m_baselines.addFile(m_baselineFile);
+      }
+
       ossimFilename logDir = base_output_dir.dirCat("log");
-      const char* lookup = kwl.find("log_directory");
+      lookup = kwl.find("log_directory");
       if ( lookup )
       {
          logDir = convertToNative( lookup ).c_str();
@@ -557,6 +662,26 @@ ossim_uint8 ossimBatchTest::execute()
          status |= individual_test_status;
       }
       
+      if ( m_recordBaselines )
+      {
+         ossimFilename baselineDir = m_baselineFile.path();
+         if ( baselineDir.size() && !baselineDir.exists() )
+         {
+            baselineDir.createDirectory();
+         }
+         if ( m_baselines.write(m_baselineFile.c_str()) )
+         {
+            cout << "Wrote baselines: " << m_baselineFile << "\n";
+            m_logStr << "\nbaseline_file: " << m_baselineFile << "\n";
+         }
+         else
+         {
+            status |= TEST_ERROR;
+            cout << "Could not write baselines: " << m_baselineFile << "\n";
+            m_logStr << "\nERROR could not write baselines: " << m_baselineFile << "\n";
+         }
+      }
+
       getDateString(date);
       m_logStr << "\nstop_time: " << date << "\n";
       double stopTime = ossimTimer::instance()->time_s();
@@ -776,7 +901,12 @@ ossim_uint8 ossimBatchTest::processTest(const ossimString& prefix, const ossimKe
    if ( testFlag  && !(testStatus & TEST_ERROR))
    {
       ossimString prefixBase = prefix + "test_command";
-      testStatus |= processCommands( prefixBase, kwl, testName, true );
+      Performance perf;
+      testStatus |= processCommands( prefixBase, kwl, testName, true, ossimFilename(""), &perf );
+      if ( !(testStatus & TEST_ERROR) )
+      {
+         testStatus |= checkPerformance( prefix, kwl, testName, perf );
+      }
    }
    if ( postProcessFlag  && !(testStatus & TEST_ERROR))
    {
@@ -806,7 +936,8 @@ ossim_uint8 ossimBatchTest::processCommands(const ossimString& prefixBase,
                                             const ossimKeywordlist& kwl,
                                             const ossimString& testName,
                                             bool logTime,
-                                            const ossimFilename& tempFileName)
+                                            const ossimFilename& tempFileName,
+                                            Performance* perf)
 {
    ossim_uint8 result = TEST_TBD;
 
@@ -839,8 +970,10 @@ ossim_uint8 ossimBatchTest::processCommands(const ossimString& prefixBase,
    }
 
    ossimString date;
-   double startTime;
-   double stopTime;
+   double startTime = 0.0;
+   double stopTime = 0.0;
+   double cpuTime = 0.0;
+   ossim_uint64 peakRss = 0;
    
    ossimString command;
    ossim_uint32 index = 0;
@@ -865,7 +998,7 @@ ossim_uint8 ossimBatchTest::processCommands(const ossimString& prefixBase,
 
          m_logStr << "executing command: " << command_line << "\n";
 
-         if ( logTime )
+         if ( logTime || perf )
          {
             getDateString(date);
             m_logStr << "begin: " << date << "\n";
@@ -875,7 +1008,17 @@ ossim_uint8 ossimBatchTest::processCommands(const ossimString& prefixBase,
          }
             
          // Launch the command:
-         int status = system(command_line.chars());
+         int status = 0;
+         if ( perf )
+         {
+            cpuTime = 0.0;
+            peakRss = 0;
+            status = runCommand(command_line.chars(), cpuTime, peakRss);
+         }
+         else
+         {
+            status = system(command_line.chars());
+         }
          if (status == 0)
             result |= TEST_PASSED;
          else if (postprocessing)
@@ -883,7 +1026,7 @@ ossim_uint8 ossimBatchTest::processCommands(const ossimString& prefixBase,
          else
             result |= TEST_ERROR;
 
-         if ( logTime )
+         if ( logTime || perf )
          {
             // Log the time and status:
             stopTime = ossimTimer::instance()->time_s();
@@ -894,6 +1037,20 @@ ossim_uint8 ossimBatchTest::processCommands(const ossimString& prefixBase,
                    << std::setprecision(4)
                    << (stopTime-startTime) << "\n";
          }
+         if ( perf )
+         {
+#if !defined(_WIN32)
+            m_logStr << testName << "[" << index << "]: cpu time in seconds: "
+                     << std::setiosflags(ios::fixed) << std::setprecision(4) << cpuTime << "\n"
+                     << testName << "[" << index << "]: peak rss in KB: " << peakRss << "\n";
+#endif
+            perf->m_wallTime += stopTime - startTime;
+            perf->m_cpuTime  += cpuTime;
+            if ( peakRss > perf->m_peakRss )
+            {
+               perf->m_peakRss = peakRss;
+            }
+         }
          
          m_logStr << "return status: " << status << "\n";
          
@@ -955,6 +1112,96 @@ ossim_uint8 ossimBatchTest::processCommands(const ossimString& prefixBase,
    return result;
 }
 
+//**************************************************************************************************
+ossim_uint8 ossimBatchTest::checkPerformance(const ossimString& prefix,
+                                             const ossimKeywordlist& kwl,
+                                             const ossimString& testName,
+                                             const Performance& perf)
+{
+   ossim_uint8 result = TEST_TBD;
+
+   m_logStr << testName << ": total wall time in seconds: "
+            << std::setiosflags(ios::fixed) << std::setprecision(4) << perf.m_wallTime << "\n";
+#if !defined(_WIN32)
+   m_logStr << testName << ": total cpu time in seconds: " << perf.m_cpuTime << "\n"
+            << testName << ": peak rss in KB: " << perf.m_peakRss << "\n";
+#endif
+
+   if ( m_recordBaselines )
+   {
+      m_baselines.add(prefix.c_str(), "baseline_wall_time", perf.m_wallTime, true, 4);
+#if !defined(_WIN32)
+      m_baselines.add(prefix.c_str(), "baseline_cpu_time", perf.m_cpuTime, true, 4);
+      m_baselines.add(prefix.c_str(), "baseline_peak_rss", perf.m_peakRss, true);
+#endif
+      return result;
+   }
+
+   // Tolerance: command line, test, config, default.
+   double tolerance = DEFAULT_PERFORMANCE_TOLERANCE;
+   const char* lookup = kwl.find(prefix.c_str(), "performance_tolerance");
+   if ( !lookup )
+   {
+      lookup = kwl.find("performance_tolerance");
+   }
+   if ( lookup )
+   {
+      tolerance = ossimString(lookup).toDouble();
+   }
+   if ( m_perfTolerance >= 0.0 )
+   {
+      tolerance = m_perfTolerance;
+   }
+
+   const char* KEYS[3]   = { "baseline_wall_time", "baseline_cpu_time", "baseline_peak_rss" };
+   const char* LABELS[3] = { "wall time", "cpu time", "peak rss" };
+   const double MEASURED[3] = { perf.m_wallTime, perf.m_cpuTime, (double)perf.m_peakRss };
+
+   for ( ossim_uint32 i = 0; i < 3; ++i )
+   {
+#if defined(_WIN32)
+      if ( i > 0 )
+      {
+         break; // Only the wall time is measured.
+      }
+#endif
+      // The config file overrides the baseline file:
+      lookup = kwl.find(prefix.c_str(), KEYS[i]);
+      if ( !lookup )
+      {
+         lookup = m_baselines.find(prefix.c_str(), KEYS[i]);
+      }
+      if ( !lookup )
+      {
+         continue;
+      }
+      const double BASELINE = ossimString(lookup).toDouble();
+      if ( BASELINE <= 0.0 )
+      {
+         continue;
+      }
+
+      const double LIMIT = BASELINE * (1.0 + tolerance);
+      ostringstream statusString;
+      statusString << prefix << "performance: " << LABELS[i] << " "
+                   << std::setiosflags(ios::fixed) << std::setprecision(4) << MEASURED[i]
+                   << " baseline " << BASELINE << " limit " << LIMIT << ": ";
+      if ( MEASURED[i] > LIMIT )
+      {
+         statusString << "FAILED";
+         result |= TEST_FAILED;
+      }
+      else
+      {
+         statusString << "PASSED";
+      }
+      cout << statusString.str() << endl;
+      m_logStr << statusString.str() << endl;
+   }
+
+   return result;
+}
+
 //**************************************************************************************************
 void ossimBatchTest::preprocessKwl(const std::vector<std::string>& testList,
                                    const std::string& testCommand,
@@ -1192,6 +1439,17 @@ void ossimBatchTest::usage(ossimArgumentParser& ap)
       "file. Notes: Multiple tests can be entered by quoting string of space separated test, e.g. "
       "\"test1 test2\". To run all tests use \"all\" for test.");
    
+   au->addCommandLineOption("-b or --record-baselines",
+      "Records the wall time, cpu time and peak resident set of the test commands of each test "
+      "run as its performance baseline, in the \"baseline_file\" of the test configuration file "
+      "(default $(OBT_EXP_DIR)/baselines.kwl). Without it a test fails when its test commands "
+      "exceed a baseline by more than the tolerance.");
+
+   au->addCommandLineOption("--performance-tolerance",
+      "<fraction> Allowed slowdown over the performance baselines, e.g. 0.1 for 10 percent. "
+      "Overrides the \"performance_tolerance\" keywords of the test configuration file. "
+      "Default 0.1.");
+
    au->addCommandLineOption("-h or --help", "Display usage.");
    
    au->addCommandLineOption("-W or -w", 
@@ -425,6 +425,13 @@ bool ossimChipProcUtil::execute()
    if (m_writer->getErrorStatus() != ossimErrorCodes::OSSIM_OK)
       throw ossimException( "Unable to initialize writer for execution" );
 
+   // Open the elevation cells under the AOI while the first tiles are written, and report
+   // holes in coverage now rather than at the end of the run.
+   if ( !m_aoiGroundRect.hasNans() )
+   {
+      ossimElevManager::instance()->prefetch(m_aoiGroundRect);
+   }
+
    // Add a listener to get percent complete.
    ossimStdOutProgress prog(0, true);
    m_writer->addListener(&prog);
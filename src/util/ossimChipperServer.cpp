@@ -0,0 +1,178 @@
+//----------------------------------------------------------------------------
+//
+// File: ossimChipperServer.cpp
+// 
+// License:  LGPL
+// 
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description:
+// 
+// Long running chipper: keeps the handlers and chains of ossimChipperUtil
+// set up across requests to the same inputs and operation.
+// 
+//----------------------------------------------------------------------------
+// $Id$
+
+#include <ossim/util/ossimChipperServer.h>
+#include <ossim/base/ossimException.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimKeywordNames.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTrace.h>
+#include <iostream>
+
+static ossimTrace traceDebug("ossimChipperServer:debug");
+
+ossimChipperServer::ossimChipperServer()
+   : ossimReferenced(),
+     m_setups(),
+     m_maxSetups(8),
+     m_requestCount(0)
+{
+   const char* lookup = ossimPreferences::instance()->findPreference("chipper_server.max_setups");
+   if (lookup)
+   {
+      setMaxSetups( ossimString(lookup).toUInt32() );
+   }
+}
+
+ossimChipperServer::~ossimChipperServer()
+{
+   std::map<std::string, Setup>::iterator i = m_setups.begin();
+   while ( i != m_setups.end() )
+   {
+      i->second.m_chipper->clear();
+      ++i;
+   }
+   m_setups.clear();
+}
+
+void ossimChipperServer::serve( std::istream& in, std::ostream& out )
+{
+   std::string line;
+   std::string request;
+   while ( std::getline( in, line ) )
+   {
+      ossimString command = ossimString(line).trim();
+      if ( command == "quit" )
+      {
+         break;
+      }
+      if ( command != "end" )
+      {
+         request += line;
+         request += "\n";
+         continue;
+      }
+
+      ossimKeywordlist kwl;
+      std::string message = "malformed request";
+      bool reused = false;
+      bool status = kwl.parseString( request ) && process( kwl, message, reused );
+      request.clear();
+
+      out << "status: " << ( status ? "ok" : "error" ) << "\n"
+          << "setup: " << ( reused ? "reused" : "new" ) << "\n"
+          << ( status ? ossimKeywordNames::OUTPUT_FILE_KW : "message" ) << ": "
+          << ossimString(message).substitute("\n", " ", true) << "\n"
+          << "end" << std::endl;
+   }
+}
+
+bool ossimChipperServer::process( const ossimKeywordlist& request,
+                                  std::string& message,
+                                  bool& reused )
+{
+   ++m_requestCount;
+   const std::string KEY = getSetupKey( request );
+
+   std::map<std::string, Setup>::iterator i = m_setups.find( KEY );
+   reused = ( i != m_setups.end() );
+   try
+   {
+      if ( !reused )
+      {
+         // Make room: drop the least recently used setup.
+         while ( m_setups.size() && ( m_setups.size() >= m_maxSetups ) )
+         {
+            std::map<std::string, Setup>::iterator oldest = m_setups.begin();
+            std::map<std::string, Setup>::iterator j = m_setups.begin();
+            for ( ; j != m_setups.end(); ++j )
+            {
+               if ( j->second.m_lastUsed < oldest->second.m_lastUsed )
+               {
+                  oldest = j;
+               }
+            }
+            oldest->second.m_chipper->clear();
+            m_setups.erase( oldest );
+         }
+
+         Setup setup;
+         setup.m_chipper = new ossimChipperUtil();
+         setup.m_lastUsed = m_requestCount;
+         setup.m_chipper->initialize( request );
+         i = m_setups.insert( std::make_pair( KEY, setup ) ).first;
+      }
+      i->second.m_lastUsed = m_requestCount;
+      i->second.m_chipper->executeRequest( request );
+
+      ossimFilename file;
+      i->second.m_chipper->getOutputFilename( file );
+      message = file.string();
+   }
+   catch ( const ossimException& e )
+   {
+      // The chains may be half set up; start over on the next request.
+      if ( i != m_setups.end() )
+      {
+         i->second.m_chipper->clear();
+         m_setups.erase( i );
+      }
+      message = e.what();
+      if ( traceDebug() )
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << "ossimChipperServer::process failed: " << message << "\n";
+      }
+      return false;
+   }
+   return true;
+}
+
+void ossimChipperServer::setMaxSetups( ossim_uint32 count )
+{
+   m_maxSetups = ( count > 0 ) ? count : 1;
+}
+
+ossim_uint32 ossimChipperServer::getMaxSetups() const
+{
+   return m_maxSetups;
+}
+
+ossim_uint32 ossimChipperServer::getNumberOfSetups() const
+{
+   return (ossim_uint32)m_setups.size();
+}
+
+std::string ossimChipperServer::getSetupKey( const ossimKeywordlist& request )
+{
+   // The map is sorted, so equal setups give equal keys.
+   std::string key;
+   ossimKeywordlist::KeywordMap::const_iterator i = request.getMap().begin();
+   while ( i != request.getMap().end() )
+   {
+      if ( !ossimChipperUtil::isRequestKey( i->first ) )
+      {
+         key += i->first;
+         key += '\0';
+         key += i->second;
+         key += '\n';
+      }
+      ++i;
+   }
+   return key;
+}
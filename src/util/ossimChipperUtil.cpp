@@ -37,6 +37,8 @@
 
 #include <ossim/imaging/ossimBrightnessContrastSource.h>
 #include <ossim/imaging/ossimBumpShadeTileSource.h>
+#include <ossim/imaging/ossimChainProfiler.h>
+#include <ossim/base/ossimTimeline.h>
 #include <ossim/imaging/ossimFilterResampler.h>
 #include <ossim/imaging/ossimFusionCombiner.h>
 #include <ossim/imaging/ossimImageData.h>
@@ -48,7 +50,7 @@
 #include <ossim/imaging/ossimImageRenderer.h>
 #include <ossim/imaging/ossimImageSource.h>
 #include <ossim/imaging/ossimImageSourceFilter.h>
-#include <ossim/imaging/ossimImageToPlaneNormalFilter.h>
+#include <ossim/imaging/ossimTerrainDerivativeSource.h>
 #include <ossim/imaging/ossimImageWriterFactoryRegistry.h>
 #include <ossim/imaging/ossimIndexToRgbLutFilter.h>
 #include <ossim/imaging/ossimRectangleCutFilter.h>
@@ -112,6 +114,7 @@ static const std::string NORTH_UP_KW             = "north_up"; // bool
 static const std::string OP_KW                   = "operation";
 static const std::string OUTPUT_RADIOMETRY_KW    = "output_radiometry";
 static const std::string PAD_THUMBNAIL_KW        = "pad_thumbnail"; // bool
+static const std::string PROFILE_KW              = "profile";
 static const std::string READER_PROPERTY_KW      = "reader_property";
 static const std::string RESAMPLER_FILTER_KW     = "resampler_filter";
 static const std::string ROTATION_KW             = "rotation";
@@ -124,6 +127,7 @@ static const std::string SRS_KW                  = "srs";
 static const std::string THREE_BAND_OUT_KW       = "three_band_out"; // bool
 static const std::string THUMBNAIL_RESOLUTION_KW = "thumbnail_resolution"; // pixels
 static const std::string TILE_SIZE_KW            = "tile_size"; // pixels
+static const std::string TIMELINE_KW             = "timeline";
 static const std::string TRUE_KW                 = "true";
 static const std::string UP_IS_UP_KW             = "up_is_up"; // bool
 static const std::string WRITER_KW               = "writer";
@@ -275,6 +279,8 @@ void ossimChipperUtil::addArguments(ossimArgumentParser& ap)
 
    au->addCommandLineOption("--pad-thumbnail", "<boolean>\nIf true, output thumbnail dimensions will be padded in width or height to make square; else, it will have the aspect ratio of input,  Default=false");
 
+   au->addCommandLineOption("--profile", "<file>\nTimes the getTile calls of each node of the chain, per thread, and writes the node tree with the calls, seconds, bytes and cache hits to the keyword list file.  Overrides the chain_profile.file preference.  Not used by --server.");
+
    au->addCommandLineOption("--projection", "<output_projection> Valid projections: geo, geo-scaled, input or utm\ngeo = Equidistant Cylindrical, origin latitude = 0.0\ngeo-scaled = Equidistant Cylindrical, origin latitude = image center\ninput Use first images projection. Must be a map projecion.\nutm = Universal Tranverse Mercator\nIf input and multiple sources the projection of the first image will be used.\nIf utm the zone will be set from the scene center of first image.\nNOTE: --srs takes precedence over this option.");
 
    au->addCommandLineOption("--resample-filter","<type>\nSpecify what resampler filter to use, e.g. nearest neighbor, bilinear, cubic, sinc.\nSee ossim-info --resampler-filters"); 
@@ -287,6 +293,8 @@ void ossimChipperUtil::addArguments(ossimArgumentParser& ap)
    
    au->addCommandLineOption("--scale-to-8-bit", "Scales the output to unsigned eight bits per band. This option has been deprecated by the newer \"--output-radiometry\" option.");
 
+   au->addCommandLineOption("--server", "Runs until standard input ends, reading requests as options keyword lists, each ended by a line \"end\", and answering each on standard output.  Requests to the same inputs and operation reuse the handlers and chains; only the cut, output file and writer options change.  Must be the only option.");
+
    au->addCommandLineOption("--sharpen-mode", "<mode> Applies sharpness to image chain(s). Valid modes: \"light\", \"heavy\"");
 
    au->addCommandLineOption("--snap-tie-to-origin",
@@ -300,6 +308,8 @@ void ossimChipperUtil::addArguments(ossimArgumentParser& ap)
 
    au->addCommandLineOption("--tile-size", "<size_in_pixels>\nSets the output tile size if supported by writer.  Notes: This sets both dimensions. Must be a multiple of 16, e.g. 1024.");
 
+   au->addCommandLineOption("--timeline", "<file>\nRecords what each thread does when, e.g. jobs, getTile of each node of the chain, reads and writer flushes, and writes it in the Chrome trace format for chrome://tracing or Perfetto.  Overrides the timeline.file preference.  Not used by --server.");
+
    au->addCommandLineOption("-u or --up-is-up", "Rotates image to up is up. \"chip\" operation only.");
 
    au->addCommandLineOption("-w or --writer","<writer>\nSpecifies the output writer.  Default uses output file extension to determine writer. For valid output writer types use: \"ossim-info --writers\"\n");
@@ -637,6 +647,11 @@ bool ossimChipperUtil::initialize(ossimArgumentParser& ap)
       m_kwl->addPair( PAD_THUMBNAIL_KW, tempString1 );
    }
    
+   if( ap.read("--profile", stringParam1) )
+   {
+      m_kwl->addPair( PROFILE_KW, tempString1 );
+   }
+
    if( ap.read("--projection", stringParam1) )
    {
       m_kwl->addPair( std::string(ossimKeywordNames::PROJECTION_KW), tempString1 );
@@ -705,6 +720,11 @@ bool ossimChipperUtil::initialize(ossimArgumentParser& ap)
       m_kwl->addPair( TILE_SIZE_KW, tempString1 );
    }
 
+   if( ap.read("--timeline", stringParam1) )
+   {
+      m_kwl->addPair( TIMELINE_KW, tempString1 );
+   }
+
    if ( ap.read("-u") || ap.read("--up-is-up") )
    {
       m_kwl->addPair( UP_IS_UP_KW, TRUE_KW);
@@ -1073,31 +1093,7 @@ ossimRefPtr<ossimImageSource> ossimChipperUtil::initializeChain( ossimIrect& aoi
          source = addScalarRemapper( source, getOutputScalarType() );
       }
       
-      //---
-      // Get the area of interest. This will be the scene bounding rect if not
-      // explicitly set by user with one of the --cut options.
-      //  Need to get this before the thumbnail code.
-      //---
-      getAreaOfInterest(source.get(), aoi);
-
-      //---
-      // Set the image size here.  Note must be set after combineLayers.  This is needed for
-      // the ossimImageGeometry::worldToLocal call for a geographic projection to handle wrapping
-      // accross the date line.
-      //---
-      m_geom->setImageSize( aoi.size() );
-
-      if ( hasThumbnailResolution() )
-      {
-         //---
-         // Adjust the projection scale and get the new rect.
-         // Note this will resize the ossimImageGeometry::m_imageSize is scale changes.
-         //---
-         initializeThumbnailProjection( aoi, aoi );
-
-         // Reset the source bounding rect if it changed.
-         source->initialize();
-      }
+      initializeAreaOfInterest( source.get(), aoi );
    }
    
    if ( traceDebug() )
@@ -1108,6 +1104,35 @@ ossimRefPtr<ossimImageSource> ossimChipperUtil::initializeChain( ossimIrect& aoi
    return source;
 }
 
+void ossimChipperUtil::initializeAreaOfInterest( ossimImageSource* source, ossimIrect& aoi )
+{
+   //---
+   // Get the area of interest. This will be the scene bounding rect if not
+   // explicitly set by user with one of the --cut options.
+   //  Need to get this before the thumbnail code.
+   //---
+   getAreaOfInterest(source, aoi);
+
+   //---
+   // Set the image size here.  Note must be set after combineLayers.  This is needed for
+   // the ossimImageGeometry::worldToLocal call for a geographic projection to handle wrapping
+   // accross the date line.
+   //---
+   m_geom->setImageSize( aoi.size() );
+
+   if ( hasThumbnailResolution() )
+   {
+      //---
+      // Adjust the projection scale and get the new rect.
+      // Note this will resize the ossimImageGeometry::m_imageSize is scale changes.
+      //---
+      initializeThumbnailProjection( aoi, aoi );
+
+      // Reset the source bounding rect if it changed.
+      source->initialize();
+   }
+}
+
 void ossimChipperUtil::setOptionsToChain(
    ossimIrect& aoi, const ossimKeywordlist& /* kwl */ )
 {
@@ -1129,7 +1154,12 @@ ossimRefPtr<ossimImageSource> ossimChipperUtil::initializeBumpShadeChain()
    ossimRefPtr<ossimImageSource> demSource = combineLayers( m_demLayer );
    
    // Set up the normal source.
-   ossimRefPtr<ossimImageToPlaneNormalFilter> normSource = new ossimImageToPlaneNormalFilter;
+   ossimRefPtr<ossimTerrainDerivativeSource> normSource = new ossimTerrainDerivativeSource;
+   std::vector<ossimTerrainDerivativeSource::Product> normals;
+   normals.push_back(ossimTerrainDerivativeSource::NORMAL_X);
+   normals.push_back(ossimTerrainDerivativeSource::NORMAL_Y);
+   normals.push_back(ossimTerrainDerivativeSource::NORMAL_Z);
+   normSource->setProducts(normals);
 
    //---
    // Set the track scale flag to true.  This enables scaling the surface
@@ -1375,7 +1405,118 @@ void ossimChipperUtil::execute()
    ossimIrect aoi;
    ossimRefPtr<ossimImageSource> source = initializeChain( aoi );
 
-   if ( source.valid() && !aoi.hasNans() )
+   ossimFilename profileFile = ossimChainProfiler::getPreferenceFile();
+   const char* lookup = m_kwl->find( PROFILE_KW.c_str() );
+   if ( lookup )
+   {
+      profileFile = lookup;
+   }
+
+   ossimFilename timelineFile = ossimTimeline::getPreferenceFile();
+   lookup = m_kwl->find( TIMELINE_KW.c_str() );
+   if ( lookup )
+   {
+      timelineFile = lookup;
+   }
+
+   // The timeline takes its getTile spans from the profiler's probes:
+   if ( profileFile.size() || timelineFile.size() )
+   {
+      m_profiler = new ossimChainProfiler();
+   }
+   if ( timelineFile.size() )
+   {
+      ossimTimeline::instance()->startFromPreferences();
+   }
+
+   writeChip( source.get(), aoi, true );
+
+   if ( timelineFile.size() )
+   {
+      ossimTimeline::instance()->stop();
+      if ( !ossimTimeline::instance()->write( timelineFile ) )
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << MODULE << " WARNING: Could not write timeline " << timelineFile << "\n";
+      }
+   }
+
+   if ( m_profiler.valid() && profileFile.size() )
+   {
+      if ( !m_profiler->write( profileFile ) )
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << MODULE << " WARNING: Could not write chain profile " << profileFile << "\n";
+      }
+   }
+   m_profiler = 0;
+
+   if ( traceDebug() )
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG) << MODULE << " exited...\n";
+   }   
+}
+
+void ossimChipperUtil::executeRequest( const ossimKeywordlist& kwl )
+{
+   static const char MODULE[] = "ossimChipperUtil::executeRequest";
+
+   if ( traceDebug() )
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG) << MODULE << " entered...\n";
+   }
+
+   // Start with the request's options; none of the last request's carry over.
+   m_kwl->clear();
+   m_kwl->addList( kwl, true );
+
+   ossimIrect aoi;
+   initializeOutputProjection();
+   if ( !m_source.valid() )
+   {
+      m_source = initializeChain( aoi );
+   }
+   else
+   {
+      // Chains have the new view; refresh the combined bounds.
+      m_source->initialize();
+      initializeAreaOfInterest( m_source.get(), aoi );
+   }
+
+   writeChip( m_source.get(), aoi, false );
+
+   // Drop the writer and its cutter, keeping the chain for the next request.
+   if ( m_writer.valid() )
+   {
+      ossimRefPtr<ossimConnectableObject> cutter = m_writer->getInput(0);
+      m_writer->disconnect();
+      m_writer = 0;
+      if ( cutter.valid() )
+      {
+         cutter->disconnect();
+      }
+   }
+
+   if ( traceDebug() )
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG) << MODULE << " exited...\n";
+   }   
+}
+
+bool ossimChipperUtil::isRequestKey( const std::string& key )
+{
+   // Area of interest, output file and writer options.
+   return ( ( key.compare( 0, 4, "cut_" ) == 0 ) ||
+            ( key == ossimKeywordNames::OUTPUT_FILE_KW ) ||
+            ( key.compare( 0, WRITER_KW.size(), WRITER_KW ) == 0 ) || // writer, writer_property*
+            ( key == TILE_SIZE_KW ) ||
+            ( key == THUMBNAIL_RESOLUTION_KW ) ||
+            ( key == PAD_THUMBNAIL_KW ) );
+}
+
+void ossimChipperUtil::writeChip( ossimImageSource* source, const ossimIrect& aoi, bool progress )
+{
+   if ( source && !aoi.hasNans() )
    {
       //---
       // Add a cut filter. This will:
@@ -1392,7 +1533,7 @@ void ossimChipperUtil::execute()
       cutter->setCutType( ossimRectangleCutFilter::OSSIM_RECTANGLE_NULL_OUTSIDE );
 
       // Connect cutter input to source chain.
-      cutter->connectMyInputTo( 0, source.get() );
+      cutter->connectMyInputTo( 0, source );
       
       // Set up the writer.
       m_writer = createNewWriter();
@@ -1400,6 +1541,12 @@ void ossimChipperUtil::execute()
       // Connect the writer to the cutter.
       m_writer->connectMyInputTo(0, cutter.get());
 
+      // Time the cutter and everything it pulls from.
+      if ( m_profiler.valid() )
+      {
+         m_profiler->instrument( m_writer.get() );
+      }
+
       //---
       // Set the area of interest.
       // NOTE: This must be called after the writer->connectMyInputTo as
@@ -1412,7 +1559,10 @@ void ossimChipperUtil::execute()
       {
          // Add a listener to get percent complete.
          ossimStdOutProgress prog(0, true);
-         m_writer->addListener(&prog);
+         if ( progress )
+         {
+            m_writer->addListener(&prog);
+         }
 
          if ( traceLog() )
          {
@@ -1441,11 +1591,6 @@ void ossimChipperUtil::execute()
          throw ossimException( "Unable to initialize writer for execution" );
       }
    }
-   
-   if ( traceDebug() )
-   {
-      ossimNotify(ossimNotifyLevel_DEBUG) << MODULE << " exited...\n";
-   }   
 }
 void ossimChipperUtil::abort()
 {
@@ -29,6 +29,11 @@ ossimFileWalker::ossimFileWalker()
    : m_fileProcessor(0),
      m_jobQueue(new ossimJobMultiThreadQueue(new ossimJobQueue(), 1)),     
      m_filteredExtensions(0),
+     m_filteredExtensionSet(),
+     m_dirQueue(0),
+     m_walkThreads(1),
+     m_maxQueuedFiles(4096),
+     m_pendingDirs(0),
      m_recurseFlag(true),
      m_waitOnDirFlag(false),
      m_abortFlag(false),
@@ -38,6 +43,7 @@ ossimFileWalker::ossimFileWalker()
 
 ossimFileWalker::~ossimFileWalker()
 {
+   m_dirQueue = 0; // Not a leak, ref pointer.
    m_jobQueue = 0; // Not a leak, ref pointer.
 }
 
@@ -49,6 +55,8 @@ void ossimFileWalker::walk(const std::vector<ossimFilename>& files)
       ossimNotify(ossimNotifyLevel_DEBUG) << M << " entered\n";
    }
 
+   updateFilteredExtensionSet();
+
    if ( files.size() )
    {
       std::vector<ossimFilename>::const_iterator i = files.begin();
@@ -62,37 +70,20 @@ void ossimFileWalker::walk(const std::vector<ossimFilename>& files)
             {
                if ( file.isDir() ) // Directory:
                {
-                  walkDir(file);
+                  walkDirectory(file);
                }  
                else // File:
                {
                   if ( isFiltered(file) == false )
                   {
-                     if(traceDebug())
-                     {
-                        ossimNotify(ossimNotifyLevel_DEBUG)
-                           << "Making the job for: " << (*i) << std::endl;
-                     }
-                     
-                     // Make the job:
-                     ossimRefPtr<ossimFileWalkerJob> job =
-                        new ossimFileWalkerJob( m_fileProcessor, file );
-                     
-                     job->setName( ossimString( file.string() ) );
-                     
-                     job->setCallback( new ossimFileWalkerJobCallback() );
-                     
-                     // Set the state to ready:
-                     job->ready();
-                     
-                     // Add job to the queue:
-                     m_jobQueue->getJobQueue()->add( job.get() );
+                     queueFile( file );
                      
                      m_mutex.lock();
                      if ( m_abortFlag )
                      {
                         // Clear out the queue.
                         m_jobQueue->getJobQueue()->clear();
+                        m_mutex.unlock();
                         
                         break; // Callee set our abort flag so break out of loop.
                      }
@@ -139,6 +130,8 @@ void ossimFileWalker::walk(const ossimFilename& root)
       ossimNotify(ossimNotifyLevel_DEBUG) << M << " entered root=" << root << "\n";
    }
 
+   updateFilteredExtensionSet();
+
    // Must have call back set at this point.
    if ( !m_abortFlag && m_fileProcessor )
    {
@@ -147,7 +140,7 @@ void ossimFileWalker::walk(const ossimFilename& root)
       {
          if ( rootFile.isDir() )
          {
-            walkDir(rootFile);
+            walkDirectory(rootFile);
 
             // FOREVER loop until all jobs are completed.
             while (1)
@@ -234,30 +227,14 @@ void ossimFileWalker::walkDir(const ossimFilename& dir)
       std::vector<ossimFilename>::const_iterator i = files.begin();
       while (i != files.end())
       {
-         if(traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_DEBUG) << "Making the job for: " << (*i) << std::endl;
-         }
-         
-         // Make the job:
-         ossimRefPtr<ossimFileWalkerJob> job =
-            new ossimFileWalkerJob( m_fileProcessor, (*i) );
-
-         job->setName( ossimString( (*i).string() ) );
-
-         job->setCallback( new ossimFileWalkerJobCallback() );
-
-         // Set the state to ready:
-         job->ready();
-
-         // Add job to the queue:
-         m_jobQueue->getJobQueue()->add( job.get() );
+         queueFile( (*i) );
 
          m_mutex.lock();
          if ( m_abortFlag )
          {
             // Clear out the queue.
             m_jobQueue->getJobQueue()->clear();
+            m_mutex.unlock();
             
             break; // Callee set our abort flag so break out of loop.
          }
@@ -314,6 +291,162 @@ void ossimFileWalker::walkDir(const ossimFilename& dir)
    }
 }
 
+void ossimFileWalker::walkDirectory(const ossimFilename& dir)
+{
+   m_mutex.lock();
+   bool concurrent = ( (m_walkThreads > 1) && !m_waitOnDirFlag );
+   m_mutex.unlock();
+
+   if ( concurrent )
+   {
+      walkDirConcurrent(dir);
+   }
+   else
+   {
+      walkDir(dir);
+   }
+}
+
+void ossimFileWalker::walkDirConcurrent(const ossimFilename& dir)
+{
+   m_mutex.lock();
+   if ( !m_dirQueue.valid() )
+   {
+      m_dirQueue = new ossimJobMultiThreadQueue(new ossimJobQueue(), m_walkThreads);
+   }
+   m_mutex.unlock();
+
+   queueDir(dir);
+
+   // FOREVER loop until all directories are listed.
+   while (1)
+   {
+      if ( OpenThreads::Thread::microSleep(250) == 0 )
+      {
+         m_mutex.lock();
+         bool done = (m_pendingDirs == 0);
+         m_mutex.unlock();
+         if ( done )
+         {
+            break;
+         }
+      }
+   }
+}
+
+void ossimFileWalker::queueDir(const ossimFilename& dir)
+{
+   m_mutex.lock();
+   ++m_pendingDirs;
+   m_mutex.unlock();
+
+   ossimRefPtr<ossimFileWalkerDirJob> job = new ossimFileWalkerDirJob( this, dir );
+   job->setName( ossimString( dir.string() ) );
+   job->ready();
+   m_dirQueue->getJobQueue()->add( job.get() );
+}
+
+void ossimFileWalker::listDir(const ossimFilename& dir)
+{
+   if(traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimFileWalker::listDir processing dir: " << dir << "\n";
+   }
+
+   std::vector<ossimFilename> dirs;
+   std::vector<ossimFilename> files;
+
+   ossimDirectory d;
+   if ( d.open(dir) )
+   {
+      ossimFilename f;
+      bool valid_file = d.getFirst(f);
+      while ( valid_file )
+      {
+         if ( isFiltered(f) == false )
+         {
+            if (f.isDir())
+            {
+               dirs.push_back(f);
+            }
+            else
+            {
+               files.push_back(f);
+            }
+         }
+         valid_file = d.getNext(f);
+      }
+   }
+
+   // Files first, as walkDir does:
+   bool abort = false;
+   std::vector<ossimFilename>::const_iterator i = files.begin();
+   while ( i != files.end() )
+   {
+      m_mutex.lock();
+      abort = m_abortFlag;
+      m_mutex.unlock();
+      if ( abort )
+      {
+         m_jobQueue->getJobQueue()->clear();
+         break;
+      }
+      queueFile( (*i) );
+      ++i;
+   }
+
+   if ( !abort )
+   {
+      i = dirs.begin();
+      while ( i != dirs.end() )
+      {
+         queueDir( (*i) );
+         ++i;
+      }
+   }
+
+   // After the sub directories are counted so the walk cannot see zero early.
+   m_mutex.lock();
+   --m_pendingDirs;
+   m_mutex.unlock();
+}
+
+void ossimFileWalker::queueFile(const ossimFilename& file)
+{
+   // Bound the files waiting on the processor threads:
+   while ( 1 )
+   {
+      m_mutex.lock();
+      bool full = m_maxQueuedFiles && !m_abortFlag &&
+         ( m_jobQueue->getJobQueue()->size() >= m_maxQueuedFiles );
+      m_mutex.unlock();
+      if ( !full )
+      {
+         break;
+      }
+      OpenThreads::Thread::microSleep(1000);
+   }
+
+   if(traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG) << "Making the job for: " << file << std::endl;
+   }
+
+   // Make the job:
+   ossimRefPtr<ossimFileWalkerJob> job = new ossimFileWalkerJob( m_fileProcessor, file );
+
+   job->setName( ossimString( file.string() ) );
+
+   job->setCallback( new ossimFileWalkerJobCallback() );
+
+   // Set the state to ready:
+   job->ready();
+
+   // Add job to the queue:
+   m_jobQueue->getJobQueue()->add( job.get() );
+}
+
 bool ossimFileWalker::isFiltered(const ossimFilename& file) const
 {
    bool result = false;
@@ -332,16 +465,7 @@ bool ossimFileWalker::isFiltered(const ossimFilename& file) const
          std::string ext = file.ext().downcase().c_str();
          if ( ext.size() )
          {
-            std::vector<std::string>::const_iterator i = m_filteredExtensions.begin();
-            while ( i != m_filteredExtensions.end() )
-            {
-               if ( ext == (*i) )
-               {
-                  result = true;
-                  break;
-               }
-               ++i;
-            }
+            result = ( m_filteredExtensionSet.find( ext ) != m_filteredExtensionSet.end() );
          }
       }
    }
@@ -460,6 +584,16 @@ void ossimFileWalker::initializeDefaultFilterList()
    m_filteredExtensions.push_back(std::string("txt"));
 
    m_mutex.unlock();
+
+   updateFilteredExtensionSet();
+}
+
+void ossimFileWalker::updateFilteredExtensionSet()
+{
+   m_mutex.lock();
+   m_filteredExtensionSet.clear();
+   m_filteredExtensionSet.insert( m_filteredExtensions.begin(), m_filteredExtensions.end() );
+   m_mutex.unlock();
 }
 
 void ossimFileWalker::setRecurseFlag(bool flag)
@@ -490,6 +624,24 @@ void ossimFileWalker::setNumberOfThreads(ossim_uint32 nThreads)
    m_mutex.unlock();
 }
 
+void ossimFileWalker::setNumberOfWalkThreads(ossim_uint32 nThreads)
+{
+   m_mutex.lock();
+   m_walkThreads = nThreads ? nThreads : 1;
+   if ( m_dirQueue.valid() )
+   {
+      m_dirQueue->setNumberOfThreads(m_walkThreads);
+   }
+   m_mutex.unlock();
+}
+
+void ossimFileWalker::setMaxQueuedFiles(ossim_uint32 maxFiles)
+{
+   m_mutex.lock();
+   m_maxQueuedFiles = maxFiles;
+   m_mutex.unlock();
+}
+
 void ossimFileWalker::setFileProcessor(ossimFileProcessorInterface* fpi)
 {
    m_mutex.lock();
@@ -513,6 +665,21 @@ void ossimFileWalker::ossimFileWalkerJob::start()
    }
 }
 
+ossimFileWalker::ossimFileWalkerDirJob::ossimFileWalkerDirJob(ossimFileWalker* walker,
+                                                              const ossimFilename& dir)
+   : m_walker( walker ),
+     m_dir( dir )
+{
+}
+
+void ossimFileWalker::ossimFileWalkerDirJob::start()
+{
+   if ( m_walker )
+   {
+      m_walker->listDir( m_dir );
+   }
+}
+
 ossimFileWalker::ossimFileWalkerJobCallback::ossimFileWalkerJobCallback()
    : ossimJobCallback()
 {
@@ -35,7 +35,7 @@
 #include <ossim/imaging/ossimImageRenderer.h>
 #include <ossim/imaging/ossimImageSource.h>
 #include <ossim/imaging/ossimImageSourceFilter.h>
-#include <ossim/imaging/ossimImageToPlaneNormalFilter.h>
+#include <ossim/imaging/ossimTerrainDerivativeSource.h>
 #include <ossim/imaging/ossimImageWriterFactoryRegistry.h>
 #include <ossim/imaging/ossimIndexToRgbLutFilter.h>
 #include <ossim/imaging/ossimRectangleCutFilter.h>
@@ -153,7 +153,12 @@ void ossimHillshadeUtil::initProcessingChain()
    m_procChain->add(demMosaic.get());
 
    // Set up the normal source.
-   ossimRefPtr<ossimImageToPlaneNormalFilter> normSource = new ossimImageToPlaneNormalFilter;
+   ossimRefPtr<ossimTerrainDerivativeSource> normSource = new ossimTerrainDerivativeSource;
+   std::vector<ossimTerrainDerivativeSource::Product> normals;
+   normals.push_back(ossimTerrainDerivativeSource::NORMAL_X);
+   normals.push_back(ossimTerrainDerivativeSource::NORMAL_Y);
+   normals.push_back(ossimTerrainDerivativeSource::NORMAL_Z);
+   normSource->setProducts(normals);
    normSource->setTrackScaleFlag(true);
    m_procChain->add( normSource.get() );
 
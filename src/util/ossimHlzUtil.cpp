@@ -39,6 +39,10 @@ static const string LZ_MIN_RADIUS_KW = "min_lz_radius";
 static const string ROUGHNESS_THRESHOLD_KW = "max_roughness";
 static const string SLOPE_THRESHOLD_KW = "max_slope";
 
+// Bits of ossimHlzUtil::m_pcRaster:
+static const ossim_uint8 PC_POINTS = 1;
+static const ossim_uint8 PC_OBSTRUCTION = 2;
+
 const char* ossimHlzUtil::DESCRIPTION =
       "Computes bitmap of helicopter landing zones given ROI and DEM.";
 
@@ -53,6 +57,7 @@ ossimHlzUtil::ossimHlzUtil()
   m_marginalLzValue(128),
   m_goodLzValue(64),
   m_useLsFitMethod(true),
+  m_useIntegralImages(true),
   m_numThreads(1),
   d_accumT(0)
 {
@@ -91,6 +96,9 @@ void ossimHlzUtil::setUsage(ossimArgumentParser& ap)
    au->addCommandLineOption("--point-clouds <file1>[, <file2>...]",
          "Specifies ancillary point-cloud data file(s) for level-2 search for obstructions. "
          "Must be comma-separated file names.");
+   au->addCommandLineOption("--no-integral",
+         "Fits the plane of each patch from its posts instead of from summed-area tables of the "
+         "DEM. Much slower. For engineering/debug purposes.");
    au->addCommandLineOption("--min-lz-radius <meters>",
          "Specifies minimum radius of landing zone. Defaults to 25 m. ");
    au->addCommandLineOption("--max-roughness <meters>",
@@ -170,6 +178,12 @@ bool ossimHlzUtil::initialize(ossimArgumentParser& ap)
       m_numThreads = ossimString(ts1).toUInt32();
    }
 
+   if (ap.read("--no-integral"))
+   {
+      // Command line mode only
+      m_useIntegralImages = false;
+   }
+
    if (ap.read("--use_slope"))
    {
       // Command line mode only
@@ -452,9 +466,61 @@ bool ossimHlzUtil::computeHLZ()
    if (dem_step <= 0)
       dem_step = 1;
 
+   rasterizePointClouds();
+
+   if (m_useLsFitMethod && m_useIntegralImages)
+   {
+      // One job per tile of patch origins. The tiles are large against the patch so that the
+      // posts shared by neighbouring tiles' tables stay few:
+      const ossim_int32 tileSize = dem_step *
+            std::max(1, std::max(256, 4*std::max(m_demFilterSize.x, m_demFilterSize.y))/dem_step);
+      vector<ossimIrect> tiles;
+      for (ossim_int32 y = min_y; y <= max_y; y += tileSize)
+      {
+         for (ossim_int32 x = min_x; x <= max_x; x += tileSize)
+         {
+            tiles.push_back(ossimIrect(x, y, std::min(x + tileSize - 1, max_x),
+                                       std::min(y + tileSize - 1, max_y)));
+         }
+      }
+
+      if (m_numThreads == 0)
+         m_numThreads = ossim::getNumberOfThreads();
+
+      setPercentComplete(0);
+      if (m_numThreads == 1)
+      {
+         for (ossim_uint32 i=0; i<tiles.size(); ++i)
+         {
+            IntegralPatchProcessorJob job (this, tiles[i], dem_step);
+            job.start();
+            setPercentComplete(100*(i+1)/tiles.size());
+         }
+      }
+      else
+      {
+         ossimRefPtr<ossimJobMultiThreadQueue> jobMtQueue =
+               new ossimJobMultiThreadQueue(0, m_numThreads);
+         ossimJobQueue* jobQueue = jobMtQueue->getJobQueue();
+         for (ossim_uint32 i=0; i<tiles.size(); ++i)
+            jobQueue->add(new IntegralPatchProcessorJob(this, tiles[i], dem_step), false);
+
+         ossimNotify(ossimNotifyLevel_INFO) << "\nQueued " << tiles.size() << " tiles. Waiting "
+               "for job threads to finish..." << endl;
+         ossim_int32 qsize = 0;
+         while (jobMtQueue->hasJobsToProcess() || jobMtQueue->numberOfBusyThreads())
+         {
+            qsize = jobMtQueue->getJobQueue()->size();
+            setPercentComplete(100*(tiles.size()-qsize)/tiles.size());
+            OpenThreads::Thread::microSleep(10000);
+         }
+         jobMtQueue = 0;
+      }
+   }
+
    // Hack: degrading to single thread when slope-image scheme is used. Runs extremely slow in
    // multithread mode, but much faster as single thread than multithreaded ls-fit
-   if ((m_numThreads == 1) || !m_useLsFitMethod)
+   else if ((m_numThreads == 1) || !m_useLsFitMethod)
    {
       // Not threaded (or slope-image scheme):
       setPercentComplete(0);
@@ -519,6 +585,50 @@ bool ossimHlzUtil::computeHLZ()
    return true;
 }
 
+void ossimHlzUtil::rasterizePointClouds()
+{
+   m_pcRaster.clear();
+   if (m_pcSources.empty())
+      return;
+
+   const ossim_uint32 width = m_aoiViewRect.width();
+   const ossim_int32 height = (ossim_int32) m_aoiViewRect.height();
+   const ossimIpt& ul = m_aoiViewRect.ul();
+   m_pcRaster.assign((size_t) width*height, 0);
+
+   // By bands of rows, to bound the size of the point blocks:
+   const ossim_int32 BAND_ROWS = 256;
+   ossimDpt point_xy;
+   for (ossim_uint32 i=0; i<m_pcSources.size(); ++i)
+   {
+      for (ossim_int32 row=0; row<height; row+=BAND_ROWS)
+      {
+         ossimIrect band (ul.x, ul.y + row, m_aoiViewRect.lr().x,
+                          std::min(ul.y + row + BAND_ROWS - 1, m_aoiViewRect.lr().y));
+         ossimDrect bandEdges (band.ul().x - 0.5, band.ul().y - 0.5,
+                               band.lr().x + 0.5, band.lr().y + 0.5);
+         ossimGrect grect;
+         m_geom->localToWorld(bandEdges, grect);
+
+         ossimPointBlock pc_block(0, ossimPointRecord::NumberOfReturns);
+         m_pcSources[i]->getBlock(grect, pc_block);
+         for (ossim_uint32 k=0; k<pc_block.size(); ++k)
+         {
+            m_geom->worldToLocal(pc_block[k]->getPosition(), point_xy);
+            ossimIpt p (point_xy);
+            if (p.hasNans() || !band.pointWithin(p))
+               continue;
+
+            // If this is not the only return, implies clutter along the ray:
+            ossim_uint8& cell = m_pcRaster[(p.y - ul.y)*width + p.x - ul.x];
+            cell |= PC_POINTS;
+            if ((int) pc_block[k]->getField(ossimPointRecord::NumberOfReturns) > 1)
+               cell |= PC_OBSTRUCTION;
+         }
+      }
+   }
+}
+
 void ossimHlzUtil::writeSlopeImage()
 {
    // Set up the writer:
@@ -646,6 +756,26 @@ bool ossimHlzUtil::PatchProcessorJob::level2Test()
       return true;
    }
 
+   // Points binned by rasterizePointClouds(), from all the clouds:
+   if (!m_hlzUtil->m_pcRaster.empty())
+   {
+      const ossimIrect& aoi = m_hlzUtil->m_aoiViewRect;
+      ossim_uint8 flags = 0;
+      ossimIpt p;
+      for (p.y = m_demPatchUL.y; p.y < m_demPatchLR.y; ++p.y)
+      {
+         const ossim_uint8* row = &m_hlzUtil->m_pcRaster[(p.y - aoi.ul().y)*aoi.width()];
+         for (p.x = m_demPatchUL.x; p.x < m_demPatchLR.x; ++p.x)
+            flags |= row[p.x - aoi.ul().x];
+      }
+      m_status = 0; // reset assumes no coverage
+      if (!(flags & PC_POINTS))
+         return false;
+      if (!(flags & PC_OBSTRUCTION))
+         m_status = 2;
+      return true;
+   }
+
    // Need to convert DEM file coordinate bounds to geographic.
    ossimGpt chipUlGpt, chipLrGpt;
    m_hlzUtil->m_geom->localToWorld(ossimDpt(m_demPatchUL), chipUlGpt);
@@ -723,6 +853,158 @@ bool ossimHlzUtil::PatchProcessorJob::maskTest()
    return test_passed;
 }
 
+ossimHlzUtil::IntegralPatchProcessorJob::IntegralPatchProcessorJob(ossimHlzUtil* hlzUtil,
+                                                                  const ossimIrect& origins,
+                                                                  ossim_int32 step)
+: PatchProcessorJob(hlzUtil, origins.ul()),
+  m_origins (origins),
+  m_step (step),
+  m_regionUL (origins.ul()),
+  m_tableWidth (0),
+  m_zRef (0.0)
+{
+}
+
+void ossimHlzUtil::IntegralPatchProcessorJob::start()
+{
+   // Region of all the posts under the tile's patches:
+   const ossimIpt& filterSize = m_hlzUtil->m_demFilterSize;
+   const ossim_int32 width = m_origins.width() - 1 + filterSize.x;
+   const ossim_int32 height = m_origins.height() - 1 + filterSize.y;
+   const double gx = m_hlzUtil->m_gsd.x;
+   const double gy = m_hlzUtil->m_gsd.y;
+   m_regionUL = m_origins.ul();
+   m_tableWidth = width + 1;
+
+   // Table entry (u, v) holds the sums over posts [0, u) x [0, v), x and y in meters from the
+   // region UL:
+   const Sums ZERO = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+   m_table.assign(m_tableWidth*(height + 1), ZERO);
+   bool haveRef = false;
+   ossimIpt p;
+   for (ossim_int32 v=0; v<height; ++v)
+   {
+      p.y = m_regionUL.y + v;
+      const double y = v*gy;
+      Sums rowSums = ZERO;
+      const Sums* above = &m_table[v*m_tableWidth];
+      Sums* sums = &m_table[(v + 1)*m_tableWidth];
+      for (ossim_int32 u=0; u<width; ++u)
+      {
+         p.x = m_regionUL.x + u;
+         double z = m_hlzUtil->m_demBuffer->getPix(p, 0);
+         if ((z != m_nullValue) && !ossim::isnan(z))
+         {
+            if (!haveRef)
+            {
+               m_zRef = z;
+               haveRef = true;
+            }
+            z -= m_zRef;
+            rowSums.n  += 1.0;
+            rowSums.z  += z;
+            rowSums.xz += u*gx*z;
+            rowSums.yz += y*z;
+            rowSums.zz += z*z;
+         }
+         Sums& s = sums[u + 1];
+         s.n  = above[u + 1].n  + rowSums.n;
+         s.z  = above[u + 1].z  + rowSums.z;
+         s.xz = above[u + 1].xz + rowSums.xz;
+         s.yz = above[u + 1].yz + rowSums.yz;
+         s.zz = above[u + 1].zz + rowSums.zz;
+      }
+   }
+   if (!haveRef)
+      return;
+
+   for (ossim_int32 y = m_origins.ul().y; y <= m_origins.lr().y; y += m_step)
+   {
+      for (ossim_int32 x = m_origins.ul().x; x <= m_origins.lr().x; x += m_step)
+      {
+         m_demPatchUL = ossimIpt(x, y);
+         m_demPatchLR = ossimIpt(x + filterSize.x, y + filterSize.y);
+         m_status = 0;
+         PatchProcessorJob::start();
+      }
+   }
+}
+
+ossimHlzUtil::IntegralPatchProcessorJob::Sums
+ossimHlzUtil::IntegralPatchProcessorJob::getSums(ossim_int32 x0, ossim_int32 y0,
+                                                 ossim_int32 x1, ossim_int32 y1) const
+{
+   const Sums& a = m_table[y0*m_tableWidth + x0];
+   const Sums& b = m_table[y0*m_tableWidth + x1];
+   const Sums& c = m_table[y1*m_tableWidth + x0];
+   const Sums& d = m_table[y1*m_tableWidth + x1];
+   Sums s;
+   s.n  = d.n  - b.n  - c.n  + a.n;
+   s.z  = d.z  - b.z  - c.z  + a.z;
+   s.xz = d.xz - b.xz - c.xz + a.xz;
+   s.yz = d.yz - b.yz - c.yz + a.yz;
+   s.zz = d.zz - b.zz - c.zz + a.zz;
+   return s;
+}
+
+bool ossimHlzUtil::IntegralPatchProcessorJob::level1Test()
+{
+   const ossim_int32 w = m_hlzUtil->m_demFilterSize.x;
+   const ossim_int32 h = m_hlzUtil->m_demFilterSize.y;
+   const double n = (double) w*h;
+   const double gx = m_hlzUtil->m_gsd.x;
+   const double gy = m_hlzUtil->m_gsd.y;
+   const ossim_int32 x0 = m_demPatchUL.x - m_regionUL.x;
+   const ossim_int32 y0 = m_demPatchUL.y - m_regionUL.y;
+
+   // Any null post fails the patch:
+   const Sums s = getSums(x0, y0, x0 + w, y0 + h);
+   if (s.n < n)
+      return false;
+
+   // About the patch center the posts are symmetric, so the normal equations of the plane
+   // z = a*x + b*y + c are diagonal:
+   const double mx = 0.5*(w - 1)*gx;
+   const double my = 0.5*(h - 1)*gy;
+   const double sxz = s.xz - (x0*gx + mx)*s.z;
+   const double syz = s.yz - (y0*gy + my)*s.z;
+   const double sxx = h*gx*gx*w*((double) w*w - 1.0)/12.0;
+   const double syy = w*gy*gy*h*((double) h*h - 1.0)/12.0;
+   const double a = sxz/sxx;
+   const double b = syz/syy;
+   const double c = s.z/n;
+
+   double z_proj = 1.0 / sqrt(a*a + b*b + 1.0);
+   double theta = fabs(ossim::acosd(z_proj));
+   if (theta > m_hlzUtil->m_slopeThreshold)
+      return false;
+
+   // The RMS distance from the plane cannot exceed the peak:
+   const double threshold = m_hlzUtil->m_roughnessThreshold;
+   const double residual = s.zz - n*c*c - a*sxz - b*syz;
+   if (z_proj*z_proj*residual > n*threshold*threshold)
+      return false;
+
+   // Passed the slope test. Now measure the roughness as peak deviation from the plane:
+   ossimIpt p;
+   double distance;
+   for (p.y = m_demPatchUL.y; (p.y < m_demPatchLR.y); ++p.y)
+   {
+      const double y = (p.y - m_demPatchUL.y)*gy - my;
+      for (p.x = m_demPatchUL.x; (p.x < m_demPatchLR.x); ++p.x)
+      {
+         const double x = (p.x - m_demPatchUL.x)*gx - mx;
+         const double z = m_hlzUtil->m_demBuffer->getPix(p, 0) - m_zRef;
+         distance = fabs(z_proj * (a*x + b*y + c - z));
+         if (distance > threshold)
+            return false;
+      }
+   }
+
+   m_status = 1; // indicates passed level 1
+   return true;
+}
+
 ossimHlzUtil::MaskSource::MaskSource(ossimHlzUtil* hlzUtil,
                                      const ossimFilename& mask_image,
                                      bool exclusion)
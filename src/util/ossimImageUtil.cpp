@@ -27,6 +27,7 @@
 #include <ossim/base/ossimEllipsoid.h>
 #include <ossim/base/ossimException.h>
 #include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimGeoidManager.h>
 #include <ossim/base/ossimGpt.h>
 #include <ossim/init/ossimInit.h>
@@ -46,6 +47,7 @@
 #include <ossim/imaging/ossimImageGeometry.h>
 #include <ossim/imaging/ossimImageHandlerRegistry.h>
 #include <ossim/imaging/ossimImageHistogramSource.h>
+#include <ossim/imaging/ossimImageMomentsSource.h>
 #include <ossim/imaging/ossimImageWriterFactoryRegistry.h>
 #include <ossim/imaging/ossimOverviewBuilderFactoryRegistry.h>
 #include <ossim/init/ossimInit.h>
@@ -62,6 +64,8 @@
 static std::string CMM_MAX_KW                  = "cmm_max"; // CMM(ComputeMinMax)
 static std::string CMM_MIN_KW                  = "cmm_min";
 static std::string CMM_NULL_KW                 = "cmm_null";
+static std::string COMPUTE_STATISTICS_KW       = "compute_statistics";
+static std::string CONCURRENT_OPENS_KW         = "concurrent_opens";
 static std::string COPY_ALL_FLAG_KW            = "copy_all_flag";
 static std::string CREATE_HISTOGRAM_KW         = "create_histogram";
 static std::string CREATE_HISTOGRAM_FAST_KW    = "create_histogram_fast";
@@ -70,6 +74,7 @@ static std::string CREATE_OVERVIEWS_KW         = "create_overviews";
 static std::string DUMP_FILTERED_IMAGES_KW     = "dump_filter_image";
 static std::string FALSE_KW                    = "false";
 static std::string FILE_KW                     = "file";
+static std::string HISTOGRAM_BLOCKS_KW         = "histogram_blocks";
 static std::string INTERNAL_OVERVIEWS_FLAG_KW  = "internal_overviews_flag";
 static std::string OUTPUT_DIRECTORY_KW         = "output_directory";
 static std::string OUTPUT_FILENAMES_KW         = "output_filenames";
@@ -84,6 +89,7 @@ static std::string SCAN_MIN_MAX_NULL_KW        = "scan_for_min_max_null";
 static std::string THREADS_KW                  = "threads";
 static std::string TILE_SIZE_KW                = "tile_size";
 static std::string TRUE_KW                     = "true";
+static std::string UPDATE_HISTOGRAM_KW         = "update_histogram_rect";
 static std::string WRITER_PROP_KW              = "writer_prop";
  
 // Static trace for debugging.  Use -T ossimImageUtil to turn on.
@@ -96,6 +102,9 @@ ossimImageUtil::ossimImageUtil()
    m_kwl( new ossimKeywordlist() ),
    m_fileWalker(0),
    m_mutex(),
+   m_openMutex(),
+   m_openCondition(),
+   m_opensInProgress(0),
    m_errorStatus(0),
    m_filteredImages(0)
 {
@@ -121,10 +130,14 @@ void ossimImageUtil::addOptions(ossimApplicationUsage* au)
  
    au->addCommandLineOption("--compression-quality", "Compression quality for TIFF JPEG takes values from 0 to 100, where 100 is best.  For J2K plugin, numerically_lossless, visually_lossless, lossy");
  
+   au->addCommandLineOption("--concurrent-opens", "<opens> The number of files the threads may be opening at the same time. (default=1) Raising it helps with many small files on network storage when the readers are thread safe on open.");
+ 
    au->addCommandLineOption("--compute-min-max", "Turns on min, max scanning when reading tiles and writes a dot omd file. This option assumes the null is known.");
  
    au->addCommandLineOption("--compute-min-max-null", "Turns on min, max, null scanning when reading tiles and write a dot omd file. This option tries to find a null value which is useful for float data.");
  
+   au->addCommandLineOption("--compute-statistics", "Computes the count, mean, variance, min, max and percentiles of each band and the covariance between bands in one pass over the full resolution tiles and writes them to a dot stats file.");
+
    au->addCommandLineOption("--compression-type", "Compression type can be: deflate, jpeg, lzw, none or packbits");
  
    au->addCommandLineOption("--create-histogram-r0", "Forces create-histogram code to compute a histogram using r0 instead of the starting resolution for the overview builder. Can require a separate pass of R0 layer if the base image has built in overviews.");
@@ -153,6 +166,8 @@ void ossimImageUtil::addOptions(ossimApplicationUsage* au)
  
    au->addCommandLineOption("--ot", "<overview_type> Overview type. see list at bottom for valid types. (default=ossim_tiff_box)");
  
+   au->addCommandLineOption("--histogram-blocks", "Keeps the full histogram of each block of 8x8 tiles in a .hbk file alongside the .his, so that --update-histogram can recount only the changed blocks.");
+ 
    au->addCommandLineOption("--override-filtered-images", "Allows processing of file that is in the filtered image list.");
  
    au->addCommandLineOption("-r or --rebuild-overviews", "Rebuild overviews even if they are already present.");
@@ -167,6 +182,8 @@ void ossimImageUtil::addOptions(ossimApplicationUsage* au)
  
    au->addCommandLineOption("--threads", "<threads> The number of threads to use. (default=1) Note a default can be set in your ossim preferences file by setting the key \"ossim_threads\".");
  
+   au->addCommandLineOption("--update-histogram", "<ulx,uly,lrx,lry> Rewrites the full histogram recounting only the tiles of the .hbk blocks touching the full resolution rectangle, e.g. after editing or appending imagery there. Implies --histogram-blocks; counts all tiles if the .hbk file is missing or stale.");
+ 
    au->addCommandLineOption("--writer-prop", "Adds a property to send to the writer. format is name=value");
 }
 
@@ -233,6 +250,15 @@ bool ossimImageUtil::initialize(ossimArgumentParser& ap)
             }
          }
  
+         if( ap.read("--concurrent-opens", sp1) )
+         {
+            m_kwl->addPair( CONCURRENT_OPENS_KW, ts1 );
+            if ( ap.argc() < 2 )
+            {
+               break;
+            }
+         }
+ 
          if( ap.read("--compression-type", sp1) )
          {
             if ( ts1.size() )
@@ -280,6 +306,15 @@ bool ossimImageUtil::initialize(ossimArgumentParser& ap)
                break;
             }
          }
+
+         if( ap.read("--compute-statistics") )
+         {
+            setComputeStatisticsFlag( true );
+            if ( ap.argc() < 2 )
+            {
+               break;
+            }
+         }
  
          if( ap.read("--create-histogram-r0") )
          {
@@ -418,6 +453,24 @@ bool ossimImageUtil::initialize(ossimArgumentParser& ap)
             }
          }
  
+         if( ap.read("--histogram-blocks") )
+         {
+            setHistogramBlocksFlag( true );
+            if ( ap.argc() < 2 )
+            {
+               break;
+            }
+         }
+ 
+         if( ap.read("--update-histogram", sp1) )
+         {
+            setUpdateHistogramRect( ts1 );
+            if ( ap.argc() < 2 )
+            {
+               break;
+            }
+         }
+ 
          while(ap.read("--reader-prop", sp1))
          {
             if (ts1.size())
@@ -585,6 +638,12 @@ ossim_int32 ossimImageUtil::execute()
       // This links the file walker back to our "processFile" method.
       m_fileWalker->setFileProcessor( this );
  
+      //---
+      // The support file probes made opening the images are answered from one listing of
+      // each directory.
+      //---
+      ossimSupportFilesList::instance()->beginBatch();
+
       // Wrap in try catch block as excptions can be thrown under the hood.
       try
       {
@@ -616,6 +675,8 @@ ossim_int32 ossimImageUtil::execute()
             << "Caught exception: " << e.what() << endl;
          setErrorStatus( ossimErrorCodes::OSSIM_ERROR );
       }
+
+      ossimSupportFilesList::instance()->endBatch();
  
    } // if ( fileCount )
 
@@ -655,10 +716,38 @@ void ossimImageUtil::processFile(const ossimFilename& file)
    {
       ossimNotify(ossimNotifyLevel_NOTICE) << "Processing file: " << file << std::endl;
  
-      m_mutex.lock();
-      ossimRefPtr<ossimImageHandler> ih =
-         ossimImageHandlerRegistry::instance()->open(file, true, true);
-      m_mutex.unlock();
+      //---
+      // Up to getConcurrentOpens() at a time.  The file jobs are on
+      // getNumberOfThreads() threads, so this only matters when it is the
+      // smaller of the two.
+      //---
+      const ossim_uint32 MAX_OPENS = getConcurrentOpens();
+      m_openMutex.lock();
+      while ( m_opensInProgress >= MAX_OPENS )
+      {
+         m_openCondition.wait( &m_openMutex );
+      }
+      ++m_opensInProgress;
+      m_openMutex.unlock();
+      
+      ossimRefPtr<ossimImageHandler> ih = 0;
+      try
+      {
+         ih = ossimImageHandlerRegistry::instance()->open(file, true, true);
+      }
+      catch ( ... )
+      {
+         m_openMutex.lock();
+         --m_opensInProgress;
+         m_openCondition.signal();
+         m_openMutex.unlock();
+         throw;
+      }
+      
+      m_openMutex.lock();
+      --m_opensInProgress;
+      m_openCondition.signal();
+      m_openMutex.unlock();
  
       if ( ih.valid() && !ih->hasError() )
       {
@@ -716,6 +805,11 @@ void ossimImageUtil::processFile(const ossimFilename& file)
             computeMinMax( ih );
          }
 
+         if ( computeStatistics() )
+         {
+            computeStatistics( ih );
+         }
+
          // Launch any file system commands.
          executeFileCommands( file );
       }
@@ -788,9 +882,17 @@ void ossimImageUtil::createOverview( ossimRefPtr<ossimImageHandler>& ih,
             consumedCmmOptions = true;
          }
  
-         for(ossim_uint32 idx = 0; idx < entryList.size(); ++idx)
+         if ( entryList.size() > 1 )
+         {
+            // Entries in parallel, e.g. the images of a multi entry nitf:
+            createOverviewBatch(ih, ob, entryList, consumedHistogramOptions);
+         }
+         else
          {
-            createOverview(ih, ob, entryList[idx], useEntryIndex, consumedHistogramOptions);
+            for(ossim_uint32 idx = 0; idx < entryList.size(); ++idx)
+            {
+               createOverview(ih, ob, entryList[idx], useEntryIndex, consumedHistogramOptions);
+            }
          }
       }
       else
@@ -829,113 +931,209 @@ void ossimImageUtil::createOverview(ossimRefPtr<ossimImageHandler>& ih,
          ossimNotify(ossimNotifyLevel_NOTICE) << "entry number: "<< entry << std::endl;
       }
  
-      ossimFilename outputFile =
-         ih->getFilenameWithThisExtension(ossimString(".ovr"), useEntryIndex);
- 
-      if ( rebuildOverviews() )
-      {
-         ih->closeOverview(); 
-         if ( outputFile.exists() )
-         {
-            outputFile.remove();
-         }
-      }
- 
-      if ( getInternalOverviewsFlag() )
+      ossimFilename outputFile;
+      ossimHistogramMode histoMode = OSSIM_HISTO_MODE_UNKNOWN;
+      if ( prepareOverview( ih, ob, useEntryIndex, outputFile, histoMode,
+                            consumedHistogramOptions ) )
       {
-         if ( ih->getClassName() == "ossimTiffTileSource")
+         if ( histoMode != OSSIM_HISTO_MODE_UNKNOWN )
          {
-            //---
-            // INTERNAL_OVERVIEWS_FLAG_KW is set to true:
-            // Tiff reader can handle internal overviews.  Set the output file to
-            // input file.  Do it after the above remove so that if there were
-            // external overviews they will get removed.
-            //---
-            outputFile = ih->getFilename();
+            ob->setHistogramMode(histoMode);
          }
-         else 
+         ob->setOutputFile(outputFile);
+         ob->setInputSource(ih.get());
+
+         // Create the overview for this entry in this file:
+         if ( ob->execute() == false )
          {
-            ossimNotify(ossimNotifyLevel_NOTICE)
-               << "Internal overviews not supported for reader type: "
-               <<ih->getClassName()
-               << "\nIgnoring option..."
-               << endl;
+            setErrorStatus( ossimErrorCodes::OSSIM_ERROR );
+            ossimNotify(ossimNotifyLevel_WARN)
+               << "Error returned creating overviews for file: " << ih->getFilename() << std::endl;
          }
+         ossimSupportFilesList::instance()->refresh(outputFile);
       }
+   }
  
-      if ( hasRequiredOverview( ih, ob ) == false )
+   if(traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG) << M << " exited...\n";
+   }
+}
+
+// Create overviews for all entries at once:
+void ossimImageUtil::createOverviewBatch(ossimRefPtr<ossimImageHandler>& ih,
+                                         ossimRefPtr<ossimOverviewBuilderBase>& ob,
+                                         const std::vector<ossim_uint32>& entryList,
+                                         bool& consumedHistogramOptions)
+{
+   static const char M[] = "ossimImageUtil::createOverviewBatch";
+   if(traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG) << M << " entered...\n";
+   }
+
+   if ( ih.valid() && ob.valid() )
+   {
+      std::vector<ossimOverviewBuilderBase::BatchTarget> targets;
+      for ( ossim_uint32 idx = 0; idx < entryList.size(); ++idx )
       {
          //---
-         // Set create histogram code...
-         //
-         // Notes:
-         // 1) Must put this logic after any removal of external overview file.
-         // 
-         // 2) Base file could have built in overviews, e.g. jp2 files.  So the sequensor could
-         //    start at R6 even if there is no external overview file.
-         //
-         // 3) If user want the histogram from R0 the overview builder can do as long as
-         //    ossimImageHandler::getNumberOfDecimationLevels returns 1.  If we are starting
-         //    overview building at R6 then we must do the create histogram in a separate path.
+         // A handler has one current entry, so each target gets its own; the
+         // first reuses ih.
          //---
-         ossimHistogramMode histoMode = OSSIM_HISTO_MODE_UNKNOWN;
-         if ( createHistogram() ||
-              ( createHistogramR0() && ( ih->getNumberOfDecimationLevels() == 1 ) ) )
+         ossimRefPtr<ossimImageHandler> entryHandler = ih;
+         if ( idx )
          {
-            histoMode = OSSIM_HISTO_MODE_NORMAL;
-         }
-         else if ( createHistogramFast() )
-         {
-            histoMode = OSSIM_HISTO_MODE_FAST;
-         }
- 
-         if(traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_DEBUG) << "Histogram mode: " << histoMode << "\n";
-         }
- 
-         if ( histoMode != OSSIM_HISTO_MODE_UNKNOWN )
-         {
-            consumedHistogramOptions = true;
-            ob->setHistogramMode(histoMode);
- 
-            ossimNotify(ossimNotifyLevel_NOTICE)
-               << "Creating overviews with histogram for file: " << ih->getFilename() << std::endl;
-         }
-         else
-         {
-            if ( histoMode != OSSIM_HISTO_MODE_UNKNOWN )
+            entryHandler =
+               ossimImageHandlerRegistry::instance()->open(ih->getFilename(), true, true);
+            if ( entryHandler.valid() )
             {
-               consumedHistogramOptions = false;  
-               ossimNotify(ossimNotifyLevel_NOTICE)
-                  << "Creating overviews for file: " << ih->getFilename() << std::endl;
+               if ( ih->getSupplementaryDirectory().size() )
+               {
+                  entryHandler->setSupplementaryDirectory( ih->getSupplementaryDirectory() );
+               }
+               ossimPropertyInterface* pi =
+                  dynamic_cast<ossimPropertyInterface*>( entryHandler.get() );
+               if ( pi ) setProps(pi);
             }
          }
- 
-         ob->setOutputFile(outputFile);
-         ob->setInputSource(ih.get());
-
-         // Create the overview for this entry in this file:
-         if ( ob->execute() == false )
+         if ( !entryHandler.valid() || !entryHandler->setCurrentEntry( entryList[idx] ) )
          {
             setErrorStatus( ossimErrorCodes::OSSIM_ERROR );
             ossimNotify(ossimNotifyLevel_WARN)
-               << "Error returned creating overviews for file: " << ih->getFilename() << std::endl;
+               << "Could not open entry " << entryList[idx] << " of: " << ih->getFilename()
+               << std::endl;
+            continue;
+         }
+         ossimNotify(ossimNotifyLevel_NOTICE) << "entry number: "<< entryList[idx] << std::endl;
+
+         ossimOverviewBuilderBase::BatchTarget target;
+         if ( prepareOverview( entryHandler, ob, true, target.m_outputFile,
+                               target.m_histoMode, consumedHistogramOptions ) )
+         {
+            target.m_handler = entryHandler;
+            target.m_entry   = entryList[idx];
+            targets.push_back(target);
          }
       }
-      else
+
+      if ( ob->executeBatch(targets) == false )
       {
-         consumedHistogramOptions = false;
-         ossimNotify(ossimNotifyLevel_NOTICE)
-            << "Image has required reduced resolution data sets." << std::endl;
+         setErrorStatus( ossimErrorCodes::OSSIM_ERROR );
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "Error returned creating overviews for file: " << ih->getFilename() << std::endl;
+      }
+      for ( ossim_uint32 idx = 0; idx < targets.size(); ++idx )
+      {
+         ossimSupportFilesList::instance()->refresh( targets[idx].m_outputFile );
       }
    }
- 
+
    if(traceDebug())
    {
       ossimNotify(ossimNotifyLevel_DEBUG) << M << " exited...\n";
    }
 }
+
+bool ossimImageUtil::prepareOverview(ossimRefPtr<ossimImageHandler>& ih,
+                                     ossimRefPtr<ossimOverviewBuilderBase>& ob,
+                                     bool useEntryIndex,
+                                     ossimFilename& outputFile,
+                                     ossimHistogramMode& histoMode,
+                                     bool& consumedHistogramOptions)
+{
+   histoMode = OSSIM_HISTO_MODE_UNKNOWN;
+   outputFile = ih->getFilenameWithThisExtension(ossimString(".ovr"), useEntryIndex);
+ 
+   if ( rebuildOverviews() )
+   {
+      ih->closeOverview(); 
+      if ( outputFile.exists() )
+      {
+         outputFile.remove();
+      }
+   }
+ 
+   if ( getInternalOverviewsFlag() )
+   {
+      if ( ih->getClassName() == "ossimTiffTileSource")
+      {
+         //---
+         // INTERNAL_OVERVIEWS_FLAG_KW is set to true:
+         // Tiff reader can handle internal overviews.  Set the output file to
+         // input file.  Do it after the above remove so that if there were
+         // external overviews they will get removed.
+         //---
+         outputFile = ih->getFilename();
+      }
+      else 
+      {
+         ossimNotify(ossimNotifyLevel_NOTICE)
+            << "Internal overviews not supported for reader type: "
+            <<ih->getClassName()
+            << "\nIgnoring option..."
+            << endl;
+      }
+   }
+ 
+   if ( hasRequiredOverview( ih, ob ) == false )
+   {
+      //---
+      // Set create histogram code...
+      //
+      // Notes:
+      // 1) Must put this logic after any removal of external overview file.
+      // 
+      // 2) Base file could have built in overviews, e.g. jp2 files.  So the sequensor could
+      //    start at R6 even if there is no external overview file.
+      //
+      // 3) If user want the histogram from R0 the overview builder can do as long as
+      //    ossimImageHandler::getNumberOfDecimationLevels returns 1.  If we are starting
+      //    overview building at R6 then we must do the create histogram in a separate path.
+      //---
+      // Blocks are only kept by the stand alone histogram:
+      if ( !histogramBlocks() &&
+           ( createHistogram() ||
+             ( createHistogramR0() && ( ih->getNumberOfDecimationLevels() == 1 ) ) ) )
+      {
+         histoMode = OSSIM_HISTO_MODE_NORMAL;
+      }
+      else if ( createHistogramFast() )
+      {
+         histoMode = OSSIM_HISTO_MODE_FAST;
+      }
+ 
+      if(traceDebug())
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG) << "Histogram mode: " << histoMode << "\n";
+      }
+ 
+      if ( histoMode != OSSIM_HISTO_MODE_UNKNOWN )
+      {
+         consumedHistogramOptions = true;
+ 
+         ossimNotify(ossimNotifyLevel_NOTICE)
+            << "Creating overviews with histogram for file: " << ih->getFilename() << std::endl;
+      }
+      else
+      {
+         if ( histoMode != OSSIM_HISTO_MODE_UNKNOWN )
+         {
+            consumedHistogramOptions = false;  
+            ossimNotify(ossimNotifyLevel_NOTICE)
+               << "Creating overviews for file: " << ih->getFilename() << std::endl;
+         }
+      }
+   }
+   else
+   {
+      consumedHistogramOptions = false;
+      ossimNotify(ossimNotifyLevel_NOTICE)
+         << "Image has required reduced resolution data sets." << std::endl;
+      return false;
+   }
+   return true;
+}
  
 bool ossimImageUtil::hasRequiredOverview( ossimRefPtr<ossimImageHandler>& ih,
                                           ossimRefPtr<ossimOverviewBuilderBase>& ob )
@@ -1032,8 +1230,10 @@ void ossimImageUtil::createHistogram(ossimRefPtr<ossimImageHandler>& ih,
       ossimFilename outputFile =
          ih->getFilenameWithThisExtension(ossimString(".his"), useEntryIndex);
 
+      ossimIrect updateRect = getUpdateHistogramRect();
+
       // Only build if needed:
-      if ( (outputFile.exists() == false) || rebuildHistogram() )
+      if ( (outputFile.exists() == false) || rebuildHistogram() || !updateRect.hasNans() )
       {
          ossimNotify(ossimNotifyLevel_NOTICE)
             << "Computing histogram for file: " << ih->getFilename() << std::endl;
@@ -1079,6 +1279,12 @@ void ossimImageUtil::createHistogram(ossimRefPtr<ossimImageHandler>& ih,
  
          // Connect histogram source to image handler.
          histoSource->setComputationMode( getHistogramMode() );
+         if ( histogramBlocks() )
+         {
+            histoSource->setBlockHistogramFile(
+               ih->getFilenameWithThisExtension(ossimString(".hbk"), useEntryIndex) );
+            histoSource->setUpdateRect( updateRect );
+         }
          histoSource->connectMyInputTo(0, ih.get() );
          histoSource->enableSource();
  
@@ -1090,6 +1296,7 @@ void ossimImageUtil::createHistogram(ossimRefPtr<ossimImageHandler>& ih,
  
          // Compute...
          writer->execute();
+         ossimSupportFilesList::instance()->refresh(outputFile);
  
          writer=0;
  
@@ -1099,7 +1306,7 @@ void ossimImageUtil::createHistogram(ossimRefPtr<ossimImageHandler>& ih,
             ih->setOutputBandList( originalBandList );
          }
  
-      } // Matches: if ( (outputFile.exists() == false) || rebuildHistogram() )
+      } // Matches: if ( (outputFile.exists() == false) || rebuildHistogram() || ... )
  
    } // Matches: if ( ih.valid() )
  
@@ -1110,6 +1317,62 @@ void ossimImageUtil::createHistogram(ossimRefPtr<ossimImageHandler>& ih,
  
 } // End: ossimImageUtil::createHistogram #2
  
+void ossimImageUtil::computeStatistics(ossimRefPtr<ossimImageHandler>& ih)
+{
+   static const char M[] = "ossimImageUtil::computeStatistics";
+   if(traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG) << M << " entered...\n";
+   }
+ 
+   if ( ih.valid() )
+   {
+      // Get the entry list:
+      std::vector<ossim_uint32> entryList;
+      ih->getEntryList(entryList);
+ 
+      bool useEntryIndex = false;
+      if ( entryList.size() )
+      {
+         if ( (entryList.size() > 1) || (entryList[0] != 0) ) useEntryIndex = true;
+      }
+ 
+      for(ossim_uint32 idx = 0; idx < entryList.size(); ++idx)
+      {
+         if (useEntryIndex)
+         {
+            ih->setCurrentEntry(entryList[idx]);
+         }
+         ossimFilename outputFile =
+            ih->getFilenameWithThisExtension(ossimString(".stats"), useEntryIndex);
+
+         ossimNotify(ossimNotifyLevel_NOTICE)
+            << "Computing statistics for file: " << ih->getFilename() << std::endl;
+
+         // Single threaded, as the files are on getNumberOfThreads() threads:
+         ossimRefPtr<ossimImageMomentsSource> stats = new ossimImageMomentsSource;
+         stats->connectMyInputTo( ih.get() );
+         stats->computeStatistics();
+         stats->disconnect();
+
+         ossimKeywordlist kwl;
+         stats->saveStatistics( kwl );
+         if ( !kwl.write( outputFile.c_str() ) )
+         {
+            ossimNotify(ossimNotifyLevel_WARN)
+               << M << "\nCould not write: " << outputFile << std::endl;
+         }
+         ossimSupportFilesList::instance()->refresh(outputFile);
+      }
+   }
+ 
+   if(traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG) << M << " exited...\n";
+   }
+ 
+} // End: ossimImageUtil::computeStatistics( ih )
+ 
 void ossimImageUtil::computeMinMax(ossimRefPtr<ossimImageHandler>& ih)
 {
    static const char M[] = "ossimImageUtil::computeMinMax #1";
@@ -1377,6 +1640,7 @@ void ossimImageUtil::computeMinMax( ossimRefPtr<ossimImageHandler>& ih,
 
       // Write the file to disk:
       okwl.write(omd_file);
+      ossimSupportFilesList::instance()->refresh(omd_file);
       ossimNotify(ossimNotifyLevel_INFO)
          << "wrote file:  " << omd_file << endl;
          
@@ -1787,6 +2051,60 @@ bool ossimImageUtil::createHistogramR0() const
    return keyIsTrue( CREATE_HISTOGRAM_R0_KW );
 }
 
+void ossimImageUtil::setHistogramBlocksFlag( bool flag )
+{
+   addOption( HISTOGRAM_BLOCKS_KW, ( flag ? TRUE_KW : FALSE_KW ) );
+   if ( flag )
+   {
+      setCreateHistogramFlag( true ); // Turn on histogram building.
+   }
+}
+
+bool ossimImageUtil::histogramBlocks() const
+{
+   return keyIsTrue( HISTOGRAM_BLOCKS_KW );
+}
+
+void ossimImageUtil::setComputeStatisticsFlag( bool flag )
+{
+   addOption( COMPUTE_STATISTICS_KW, ( flag ? TRUE_KW : FALSE_KW ) );
+}
+
+bool ossimImageUtil::computeStatistics() const
+{
+   return keyIsTrue( COMPUTE_STATISTICS_KW );
+}
+
+void ossimImageUtil::setUpdateHistogramRect( const std::string& rect )
+{
+   addOption( UPDATE_HISTOGRAM_KW, rect );
+   setHistogramBlocksFlag( true );
+}
+
+ossimIrect ossimImageUtil::getUpdateHistogramRect() const
+{
+   ossimIrect result;
+   result.makeNan();
+   std::string lookup = m_kwl->findKey( UPDATE_HISTOGRAM_KW );
+   if ( lookup.size() )
+   {
+      std::vector<ossimString> values;
+      ossimString(lookup).split(values, ",");
+      if ( values.size() == 4 )
+      {
+         result = ossimIrect( values[0].toInt32(), values[1].toInt32(),
+                              values[2].toInt32(), values[3].toInt32() );
+      }
+      else
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "ossimImageUtil::getUpdateHistogramRect WARNING:"
+            << "\nExpected ulx,uly,lrx,lry: " << lookup << std::endl;
+      }
+   }
+   return result;
+}
+
 bool ossimImageUtil::hasHistogramOption() const
 {
    return ( createHistogram() || createHistogramFast() || createHistogramR0() );
@@ -1836,6 +2154,26 @@ ossim_uint32 ossimImageUtil::getNumberOfThreads() const
    return result;
 }
 
+void ossimImageUtil::setConcurrentOpens( ossim_uint32 opens )
+{
+   addOption( CONCURRENT_OPENS_KW, opens );
+}
+
+ossim_uint32 ossimImageUtil::getConcurrentOpens() const
+{
+   ossim_uint32 result = 1;
+   std::string lookup = m_kwl->findKey( CONCURRENT_OPENS_KW );
+   if ( lookup.size() )
+   {
+      result = ossimString(lookup).toUInt32();
+      if ( !result )
+      {
+         result = 1;
+      }
+   }
+   return result;
+}
+
 ossim_uint32 ossimImageUtil::getNextWriterPropIndex() const
 {
    ossim_uint32 result = m_kwl->numberOf( WRITER_PROP_KW.c_str() );
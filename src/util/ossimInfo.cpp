@@ -38,8 +38,10 @@
 #include <ossim/base/ossimXmlDocument.h>
 #include <ossim/elevation/ossimElevManager.h>
 #include <ossim/imaging/ossimFilterResampler.h>
+#include <ossim/imaging/ossimCacheStatistics.h>
 #include <ossim/imaging/ossimImageGeometry.h>
 #include <ossim/imaging/ossimImageHandlerRegistry.h>
+#include <ossim/imaging/ossimImageMomentsSource.h>
 #include <ossim/imaging/ossimImageWriterFactoryRegistry.h>
 #include <ossim/imaging/ossimOverviewBuilderFactoryRegistry.h>
 #include <ossim/init/ossimInit.h>
@@ -49,11 +51,14 @@
 #include <ossim/support_data/ossimInfoFactoryRegistry.h>
 #include <ossim/support_data/ossimSupportFilesList.h>
 
+#include <fstream>
 #include <iomanip>
+#include <iostream>
 #include <sstream>
 #include <vector>
 
 static const char BUILD_DATE_KW[]           = "build_date";
+static const char CACHE_STATISTICS_KW[]     = "cache_statistics";
 static const char CENTER_GROUND_KW[]        = "center_ground";
 static const char CENTER_IMAGE_KW[]         = "center_image";
 static const char CONFIGURATION_KW[]        = "configuration";
@@ -84,11 +89,14 @@ static const char OVERWRITE_KW[]            = "overwrite";
 static const char PALETTE_KW[]              = "palette";
 static const char PLUGINS_KW[]              = "plugins";
 static const char PLUGIN_TEST_KW[]          = "plugin_test";
+static const char PROBE_KW[]                = "probe";
+static const char PROBE_LIST_KW[]           = "probe_list";
 static const char PROJECTIONS_KW[]          = "projections";
 static const char RAD2DEG_KW[]              = "rad2deg";
 static const char READER_PROPS_KW[]         = "reader_props";
 static const char RESAMPLER_FILTERS_KW[]    = "resampler_filters";
 static const char REVISION_NUMBER_KW[]      = "revision_number";
+static const char STATISTICS_KW[]           = "statistics";
 static const char UP_IS_UP_KW[]             = "up_is_up_angle";
 static const char VERSION_KW[]              = "version";
 static const char WRITERS_KW[]              = "writers_kw";
@@ -123,6 +131,8 @@ void ossimInfo::setUsage(ossimArgumentParser& ap)
    
    au->addCommandLineOption("-c", "Will print ground and image center.");
 
+   au->addCommandLineOption("--cache-stats", "Prints the tile and elevation cache hits, misses,\nevictions and bytes at the end.");
+
    au->addCommandLineOption("--cg", "Will print out ground center.");
 
    au->addCommandLineOption("--ci", "Will print out image center.");
@@ -175,6 +185,10 @@ void ossimInfo::setUsage(ossimArgumentParser& ap)
    
    au->addCommandLineOption("--plugin-test", "Test plugin passed to option.");
    
+   au->addCommandLineOption("--probe", "Header only summary of the image (entries, lines, samples, bands and corners stored in the header) without opening an image handler. For catalog ingest.");
+
+   au->addCommandLineOption("--probe-list", "<file> Does a --probe of each image listed in file, one per line, writing each result as it is made. Use \"-\" to read the list from standard in.");
+
    au->addCommandLineOption("--projections", "Prints projections.");
    
    au->addCommandLineOption("-r", "Will print image rectangle.");
@@ -188,6 +202,8 @@ void ossimInfo::setUsage(ossimArgumentParser& ap)
    au->addCommandLineOption("--revision", "Revision of code.");
    
    au->addCommandLineOption("-s", "Force the ground rect to be the specified datum");
+
+   au->addCommandLineOption("--stats", "Prints the count, mean, variance, min, max and percentiles of each band and the covariance between bands, of the full resolution image, in one pass on all threads.");
    
    au->addCommandLineOption("-u or --up-is-up", "Rotation angle to \"up is up\" for an image.\nWill return 0 if image's projection is not affected by elevation.");
 
@@ -247,6 +263,15 @@ bool ossimInfo::initialize(ossimArgumentParser& ap)
             }
          }
 
+         if( ap.read("--cache-stats") )
+         {
+            m_kwl.add( CACHE_STATISTICS_KW, TRUE_KW );
+            if ( ap.argc() < 2 )
+            {
+               break;
+            }
+         }
+
          if( ap.read("-c") )
          {
             m_kwl.add( IMAGE_CENTER_KW, TRUE_KW );
@@ -464,6 +489,25 @@ bool ossimInfo::initialize(ossimArgumentParser& ap)
             }
          }
 
+         if( ap.read("--probe") )
+         {
+            m_kwl.add( PROBE_KW, TRUE_KW );
+            requiresInputImage = true;
+            if ( ap.argc() < 2 )
+            {
+               break;
+            }
+         }
+
+         if( ap.read("--probe-list", sp1) )
+         {
+            m_kwl.add( PROBE_LIST_KW, ts1.c_str() );
+            if ( ap.argc() < 2 )
+            {
+               break;
+            }
+         }
+
          if( ap.read("-p") )
          {
             m_kwl.add( GEOM_INFO_KW, TRUE_KW );
@@ -558,6 +602,16 @@ bool ossimInfo::initialize(ossimArgumentParser& ap)
             }
          }
          
+         if( ap.read("--stats") )
+         {
+            m_kwl.add( STATISTICS_KW, TRUE_KW );
+            requiresInputImage = true;
+            if ( ap.argc() < 2 )
+            {
+               break;
+            }
+         }
+         
          if( ap.read("-u") || ap.read("--up-is-up") )
          {
             m_kwl.add( UP_IS_UP_KW, TRUE_KW );
@@ -679,6 +733,13 @@ bool ossimInfo::execute()
          consumedKeys += executeImageOptions(image);
       }
 
+      lookup = m_kwl.find(PROBE_LIST_KW);
+      if ( lookup )
+      {
+         ++consumedKeys;
+         probeImages( ossimFilename(lookup) );
+      }
+
       if ( consumedKeys < KEY_COUNT )
       {
          ossimString value;
@@ -903,6 +964,13 @@ bool ossimInfo::execute()
          
       } // if ( consumedKeys < KEY_COUNT )
 
+      if ( keyIsTrue( std::string(CACHE_STATISTICS_KW) ) )
+      {
+         std::ostringstream out;
+         ossimCacheStatistics::print(out);
+         ossimNotify(ossimNotifyLevel_INFO) << out.str();
+      }
+
       if ( traceDebug() )
       {
          ossimNotify(ossimNotifyLevel_DEBUG)
@@ -995,6 +1063,18 @@ ossim_uint32 ossimInfo::executeImageOptions(const ossimFilename& file)
       }
    }
    
+   // Check for probe.  Does not require image to be opened.
+   lookup = m_kwl.find( PROBE_KW );
+   if ( lookup )
+   {
+      ++consumedKeys;
+      value = lookup;
+      if ( value.toBool() )
+      {
+         probeImage( file, okwl, std::string() );
+      }
+   }
+   
    bool centerGroundFlag = false;
    bool centerImageFlag  = false;
    bool imageCenterFlag  = false;
@@ -1005,6 +1085,7 @@ ossim_uint32 ossimInfo::executeImageOptions(const ossimFilename& file)
    bool metaDataFlag     = false;
    bool northUpFlag      = false;
    bool paletteFlag      = false;
+   bool statisticsFlag   = false;
    bool upIsUpFlag       = false;
    
    // Center Ground:
@@ -1043,6 +1124,15 @@ ossim_uint32 ossimInfo::executeImageOptions(const ossimFilename& file)
       paletteFlag = value.toBool();
    }
 
+   // Statistics:
+   lookup = m_kwl.find( STATISTICS_KW );
+   if ( lookup )
+   {
+      ++consumedKeys;
+      value = lookup;
+      statisticsFlag = value.toBool();
+   }
+
    // Image center:
    lookup = m_kwl.find( IMAGE_CENTER_KW );
    if ( lookup )
@@ -1119,7 +1209,7 @@ ossim_uint32 ossimInfo::executeImageOptions(const ossimFilename& file)
 
    if ( centerGroundFlag || centerImageFlag || imageCenterFlag || imageRectFlag ||
         img2grdFlag || metaDataFlag || paletteFlag || imageInfoFlag ||
-        imageGeomFlag || northUpFlag || upIsUpFlag )
+        imageGeomFlag || northUpFlag || upIsUpFlag || statisticsFlag )
    {
       // Requires open image.
       if ( m_img.valid() == false )
@@ -1163,6 +1253,11 @@ ossim_uint32 ossimInfo::executeImageOptions(const ossimFilename& file)
       {
          getImagePalette(okwl);
       }
+
+      if ( statisticsFlag )
+      {
+         getImageStatistics(okwl);
+      }
       
       if ( imageInfoFlag )
       {
@@ -1378,6 +1473,72 @@ void ossimInfo::dumpImage(const ossimFilename& file,
          << "No dump available for:  " << file.c_str() << std::endl;
    }
 }
+bool ossimInfo::probeImage(const ossimFilename& file,
+                           ossimKeywordlist& kwl,
+                           const std::string& prefix) const
+{
+   kwl.add( prefix.c_str(), ossimKeywordNames::FILENAME_KW, file.c_str() );
+   bool result = ossimInfoFactoryRegistry::instance()->getImageSummary(file, kwl, prefix);
+   if ( !result )
+   {
+      kwl.add( prefix.c_str(), "probe_status", "unsupported" );
+   }
+   return result;
+}
+
+ossim_uint32 ossimInfo::probeImages(const ossimFilename& listFile) const
+{
+   ossim_uint32 count = 0;
+
+   std::ifstream listStream;
+   std::istream* in = &std::cin;
+   if ( listFile != "-" )
+   {
+      listStream.open( listFile.c_str() );
+      if ( !listStream )
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "ossimInfo::probeImages WARNING: Could not open: " << listFile << std::endl;
+         return count;
+      }
+      in = &listStream;
+   }
+
+   std::ofstream outStream;
+   std::ostream* out = &ossimNotify(ossimNotifyLevel_INFO);
+   const char* lookup = m_kwl.find( OUTPUT_FILE_KW );
+   if ( lookup )
+   {
+      outStream.open( lookup );
+      if ( !outStream )
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "ossimInfo::probeImages WARNING: Could not open: " << lookup << std::endl;
+         return count;
+      }
+      out = &outStream;
+   }
+
+   std::string line;
+   while ( std::getline( *in, line ) )
+   {
+      ossimFilename file = ossimString(line).trim();
+      if ( file.empty() )
+      {
+         continue;
+      }
+      std::ostringstream prefix;
+      prefix << "file" << count << ".";
+      ossimKeywordlist kwl;
+      probeImage( file, kwl, prefix.str() );
+      (*out) << kwl;
+      ++count;
+   }
+   out->flush();
+
+   return count;
+}
+
 void ossimInfo::getImageMetadata(ossimKeywordlist& kwl) const
 {
    if ( m_img.valid() )
@@ -1465,6 +1626,22 @@ void ossimInfo::getImagePalette(ossimImageHandler* ih, ossimKeywordlist& kwl) co
    } // if ( ih )
 }
 
+void ossimInfo::getImageStatistics(ossimKeywordlist& kwl)
+{
+   if ( m_img.valid() )
+   {
+      ossimRefPtr<ossimImageMomentsSource> stats = new ossimImageMomentsSource;
+      stats->connectMyInputTo( m_img.get() );
+      stats->setNumberOfThreads( 0 );
+      stats->computeStatistics();
+      stats->disconnect();
+
+      ossimString prefix = "image";
+      prefix = prefix + ossimString::toString(m_img->getCurrentEntry()) + ".statistics.";
+      stats->saveStatistics( kwl, prefix.c_str() );
+   }
+}
+
 void ossimInfo::getImageInfo(ossimKeywordlist& kwl, bool dnoFlag)
 {
    if ( m_img.valid() )
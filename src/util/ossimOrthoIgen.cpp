@@ -30,6 +30,8 @@
 #include <ossim/imaging/ossimImageMosaic.h>
 #include <ossim/imaging/ossimBlendMosaic.h>
 #include <ossim/imaging/ossimBandMergeSource.h>
+#include <ossim/imaging/ossimChainProfiler.h>
+#include <ossim/base/ossimTimeline.h>
 #include <ossim/imaging/ossimFilterResampler.h>
 #include <ossim/imaging/ossimImageHandlerRegistry.h>
 #include <ossim/imaging/ossimOrthoImageMosaic.h>
@@ -165,6 +167,8 @@ ossimOrthoIgen::ossimOrthoIgen()
    theCombinerTemplate(""),
    theAnnotationTemplate(""),
    theWriterTemplate(""),
+   theProfileFilename(""),
+   theTimelineFilename(""),
    theSupplementaryDirectory(""),
    theSlaveBuffers("2"),
    theCutOriginType(ossimOrthoIgen::OSSIM_CENTER_ORIGIN),
@@ -280,6 +284,14 @@ void ossimOrthoIgen::addArguments(ossimArgumentParser& argumentParser)
       "--output-radiometry","Specifies the desired product's pixel radiometry type. Possible "
       "values are: U8, U11, U16, S16, F32. Note this overrides the deprecated option \"scale-to"
       "-8-bit\".");
+   argumentParser.getApplicationUsage()->addCommandLineOption(
+      "--profile","<file> Times the getTile calls of each node of the image chains, per thread, "
+      "and writes the node tree with the calls, seconds, bytes and cache hits to the keyword list "
+      "file. Overrides the chain_profile.file preference.");
+   argumentParser.getApplicationUsage()->addCommandLineOption(
+      "--timeline","<file> Records what each thread does when, e.g. jobs, getTile of each node of "
+      "the image chains, reads and writer flushes, and writes it in the Chrome trace format for "
+      "chrome://tracing or Perfetto. Overrides the timeline.file preference.");
    argumentParser.getApplicationUsage()->addCommandLineOption(
       "--reader-prop","Passes a name=value pair to the reader(s) for setting it's property.  Any "
       "number of these can appear on the line.");
@@ -627,6 +639,16 @@ void ossimOrthoIgen::initialize(ossimArgumentParser& argumentParser)
    {
       theWriterTemplate = tempString;
    }
+   theProfileFilename = ossimChainProfiler::getPreferenceFile();
+   if(argumentParser.read("--profile", stringParam))
+   {
+      theProfileFilename = tempString;
+   }
+   theTimelineFilename = ossimTimeline::getPreferenceFile();
+   if(argumentParser.read("--timeline", stringParam))
+   {
+      theTimelineFilename = tempString;
+   }
    if(argumentParser.read("--tiling-template", stringParam))
    {
       theTilingTemplate = ossimFilename(tempString);
@@ -844,6 +866,19 @@ bool ossimOrthoIgen::execute()
       }
    }
 
+   // Probes go in before the writer clones the chain for its threads. The timeline takes its
+   // getTile spans from them too.
+   ossimRefPtr<ossimChainProfiler> profiler = 0;
+   if ( (theProfileFilename.size() || theTimelineFilename.size()) && theProductChain.valid() )
+   {
+      profiler = new ossimChainProfiler();
+      profiler->instrument(theProductChain.get());
+   }
+   if ( theTimelineFilename.size() )
+   {
+      ossimTimeline::instance()->startFromPreferences();
+   }
+
    try
    {
       // theProductProjection->print(cout) << endl;
@@ -857,6 +892,37 @@ bool ossimOrthoIgen::execute()
       }
       throw; // re-throw
    }
+
+   if ( theTimelineFilename.size() )
+   {
+      ossimTimeline::instance()->stop();
+      if ( ossimTimeline::instance()->write(theTimelineFilename) )
+      {
+         ossimNotify(ossimNotifyLevel_INFO)
+            << "Wrote timeline: " << theTimelineFilename << std::endl;
+      }
+      else
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "ossimOrthoIgen::execute WARNING: Could not write timeline "
+            << theTimelineFilename << std::endl;
+      }
+   }
+
+   if ( profiler.valid() && theProfileFilename.size() )
+   {
+      if ( profiler->write(theProfileFilename) )
+      {
+         ossimNotify(ossimNotifyLevel_INFO)
+            << "Wrote chain profile: " << theProfileFilename << std::endl;
+      }
+      else
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "ossimOrthoIgen::execute WARNING: Could not write chain profile "
+            << theProfileFilename << std::endl;
+      }
+   }
    
    return true;
 }
@@ -1292,6 +1358,13 @@ void ossimOrthoIgen::setupIgenChain()
    // Lastly, set up the write object (object2):
    setupWriter();
 
+   // Setup is done with the handlers, so from here the mosaic may close them:
+   ossimString maxOpenHandlers =
+      ossimPreferences::instance()->findPreference("orthoigen.max_open_handlers");
+   if ( maxOpenHandlers.size() )
+   {
+      mosaicObject->setMaxOpenHandlers( maxOpenHandlers.toUInt32() );
+   }
 }
 
 //*************************************************************************************************
@@ -1377,7 +1450,51 @@ void ossimOrthoIgen::setupCutter()
        {
          shpInterface->setQuery(query);
        }
-       std::multimap<long, ossimAnnotationObject*> features = shpInterface->getFeatureTable();
+       //---
+       // Only the features over the product need to be cut with. The view rect
+       // maps linearly to lat/lon only for a geographic product, so others read
+       // all of them.
+       //---
+       ossimGrect region;
+       region.makeNan();
+       if ( theProductProjection->isGeographic() && !inputRect.hasNans() )
+       {
+         const ossimDpt dpp = theProductProjection->getDecimalDegreesPerPixel();
+         ossimGpt ulg;
+         ossimGpt lrg;
+         theProductProjection->lineSampleToWorld(ossimDpt(inputRect.ul()), ulg);
+         theProductProjection->lineSampleToWorld(ossimDpt(inputRect.lr()), lrg);
+         region = ossimGrect(ulg, lrg);
+         region.ul().lat += dpp.y;
+         region.ul().lon -= dpp.x;
+         region.lr().lat -= dpp.y;
+         region.lr().lon += dpp.x;
+       }
+       std::multimap<long, ossimAnnotationObject*> features =
+          shpInterface->getFeatureTableInRegion(region);
+
+       //---
+       // With no exterior polygon left the cutter would pass everything, where
+       // the polygons off the product null all of it; cut with all of them.
+       //---
+       if ( !region.isLonLatNan() )
+       {
+         bool hasExterior = false;
+         std::multimap<long, ossimAnnotationObject*>::iterator it = features.begin();
+         while ( !hasExterior && (it != features.end()) )
+         {
+           ossimGeoAnnotationPolyObject* annoPoly = PTR_CAST(ossimGeoAnnotationPolyObject, it->second);
+           hasExterior = annoPoly ?
+             (annoPoly->getPolyType() != ossimGeoAnnotationPolyObject::OSSIM_POLY_INTERIOR_RING) :
+             (PTR_CAST(ossimGeoAnnotationMultiPolyObject, it->second) != NULL);
+           ++it;
+         }
+         if (!hasExterior)
+         {
+           features = shpInterface->getFeatureTable();
+         }
+       }
+
        if (features.size() > 0)
        {
          std::multimap<long, ossimAnnotationObject*>::iterator it = features.begin();
@@ -1394,14 +1511,8 @@ void ossimOrthoIgen::setupCutter()
              }
              if (annoPoly != NULL)
              {
-               std::vector<ossimGpt> polygon;
-
                //get the points of a polygon
-               std::vector<ossimGpt> points = annoPoly->getPoints();
-               for (ossim_uint32 i = 0; i < points.size(); i++)
-               {
-                 polygon.push_back(points[i]);
-               }
+               const std::vector<ossimGpt>& polygon = annoPoly->getPolygon();
 
                //get polygon type, if it is an internal polygon, initialize the internal cutter
                ossimGeoAnnotationPolyObject::ossimPolyType polyType = annoPoly->getPolyType();
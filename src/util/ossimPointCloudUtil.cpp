@@ -26,6 +26,9 @@ using namespace std;
 
 ossimPointCloudUtil::ossimPointCloudUtil()
 :  m_operation (LOWEST_DEM),
+   m_halo (16),
+   m_tileBudget (0),
+   m_numThreads (0),
    m_gsd (0)
 {
 }
@@ -35,6 +38,10 @@ ossimPointCloudUtil::~ossimPointCloudUtil()
    m_pcHandler = 0;
    m_prodGeom = 0;
    m_pcuFilter = 0;
+   m_gridder = 0;
+   m_highest = 0;
+   m_lowest = 0;
+   m_pointFilter = 0;
 }
 
 void ossimPointCloudUtil::addArguments(ossimArgumentParser& ap)
@@ -66,6 +73,31 @@ void ossimPointCloudUtil::addArguments(ossimArgumentParser& ap)
          "  \"highest-dem\", \"lowest-dem\" (default), or \"highest-lowest\". \n"
          "Alternatively can be specified in shorthand as \"h-d\", \"l-d\", or \"h-l\", "
          "respectively.");
+   au->addCommandLineOption(
+         "--reducer <name>",
+         "Writes the point cloud gridded to a DEM instead of the --op product. The grid "
+         "value of a pixel is the \"min\", \"max\" or \"mean\" height of its points, or is "
+         "interpolated from the points around it by inverse distance weighting (\"idw\") or "
+         "in their triangulation (\"tin\").");
+   au->addCommandLineOption(
+         "--halo <pixels>",
+         "Points this many pixels beyond a tile are used to grid it, the farthest "
+         "\"idw\" and \"tin\" interpolate from. Defaults to 16.");
+   au->addCommandLineOption(
+         "--tile-budget <n>",
+         "Most tiles gridded and held ahead of the writer at once, bounding memory use. "
+         "Defaults to 4 per thread.");
+   au->addCommandLineOption(
+         "--classes <c1,c2,...>",
+         "Only uses the points of these ASPRS classes, e.g. \"2\" for ground or \"2,9\" for "
+         "ground and water.");
+   au->addCommandLineOption(
+         "--returns <r1,r2,...>",
+         "Only uses the points of these return numbers (1 is the first return) or \"last\" "
+         "returns, e.g. \"1\" or \"last\".");
+   au->addCommandLineOption(
+         "--z-range <min> <max>",
+         "Only uses the points with heights in this range.");
    au->addCommandLineOption(
          "--request-api",
          "Causes applications API to be output as JSON to stdout."
@@ -102,6 +134,8 @@ bool ossimPointCloudUtil::initialize(ossimArgumentParser& ap)
 
    ossimString ts1;
    ossimArgumentParser::ossimParameter sp1(ts1);
+   ossimString ts2;
+   ossimArgumentParser::ossimParameter sp2(ts2);
 
    if ( ap.read("--dem", sp1) )
       m_demFile = ts1;
@@ -120,9 +154,47 @@ bool ossimPointCloudUtil::initialize(ossimArgumentParser& ap)
          m_operation = HIGHEST_LOWEST;
    }
 
+   if ( ap.read("--reducer", sp1) )
+      m_reducer = ts1;
+
+   if ( ap.read("--halo", sp1) )
+      m_halo = ossimString(ts1).toUInt32();
+
+   if ( ap.read("--tile-budget", sp1) )
+      m_tileBudget = ossimString(ts1).toUInt32();
+
+   if ( ap.read("--threads", sp1) )
+      m_numThreads = ossimString(ts1).toUInt32();
+
    if ( ap.read("--pc", sp1) )
       m_demFile = ts1;
 
+   // Point selections, applied by the handler to every block read:
+   m_pointFilter = new ossimPointFilterChain;
+   if ( ap.read("--classes", sp1) )
+   {
+      ossimRefPtr<ossimPointClassFilter> classFilter = new ossimPointClassFilter;
+      vector<ossimString> classes = ts1.split(",", true);
+      for (ossim_uint32 i=0; i<classes.size(); ++i)
+         classFilter->addClass((ossim_uint8) classes[i].toUInt32());
+      m_pointFilter->addFilter(classFilter.get());
+   }
+   if ( ap.read("--returns", sp1) )
+   {
+      ossimRefPtr<ossimPointReturnFilter> returnFilter = new ossimPointReturnFilter;
+      vector<ossimString> returns = ts1.split(",", true);
+      for (ossim_uint32 i=0; i<returns.size(); ++i)
+      {
+         if (returns[i].downcase() == "last")
+            returnFilter->setKeepLast(true);
+         else
+            returnFilter->addReturnNumber((ossim_uint8) returns[i].toUInt32());
+      }
+      m_pointFilter->addFilter(returnFilter.get());
+   }
+   if ( ap.read("--z-range", sp1, sp2) )
+      m_pointFilter->addFilter(new ossimPointZRangeFilter(ts1.toDouble(), ts2.toDouble()));
+
 /*
    if ( ap.read("--request-api", sp1))
    {
@@ -153,7 +225,7 @@ bool ossimPointCloudUtil::initialize(ossimArgumentParser& ap)
 
 bool ossimPointCloudUtil::initialize()
 {
-   if (loadPC())
+   if (!loadPC())
    {
       ossimNotify(ossimNotifyLevel_WARN)
               << "ossimPointCloudUtil::initialize ERR: Cannot open PC file at <"<<m_pcFile
@@ -164,10 +236,46 @@ bool ossimPointCloudUtil::initialize()
    if (!m_demFile.empty() && !loadDem())
       return false;
 
+   if (!m_reducer.empty())
+   {
+      m_gridder = newGridder(ossimPointCloudGridder::MAX_Z);
+      if (!m_gridder->setReducer(m_reducer))
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+               << "ossimPointCloudUtil::initialize ERR: Unknown reducer <"<<m_reducer<<">\n"
+               << endl;
+         return false;
+      }
+      return true;
+   }
+
+   if ((m_operation == HIGHEST_DEM) || (m_operation == HIGHEST_LOWEST))
+      m_highest = newGridder(ossimPointCloudGridder::MAX_Z);
+   if ((m_operation == LOWEST_DEM) || (m_operation == HIGHEST_LOWEST))
+      m_lowest = newGridder(ossimPointCloudGridder::MIN_Z);
+
+   // The filter takes its bounds from a gridder:
    m_pcuFilter = new ossimPointCloudUtilityFilter(this);
+   if (m_highest.valid())
+      m_pcuFilter->connectMyInputTo(m_highest.get());
+   else
+      m_pcuFilter->connectMyInputTo(m_lowest.get());
+   m_pcuFilter->initialize();
    return true;
 }
 
+ossimRefPtr<ossimPointCloudGridder>
+ossimPointCloudUtil::newGridder(ossimPointCloudGridder::Reducer reducer)
+{
+   ossimRefPtr<ossimPointCloudGridder> gridder = new ossimPointCloudGridder;
+   gridder->setReducer(reducer);
+   gridder->setHalo(m_halo);
+   gridder->setTileBudget(m_tileBudget);
+   gridder->setNumberOfThreads(m_numThreads);
+   gridder->setInputs(m_pcHandler.get(), m_prodGeom.get());
+   return gridder;
+}
+
 bool ossimPointCloudUtil::loadPC()
 {
    // DEM provided as file on command line, reset the elev manager to use only this:
@@ -179,6 +287,8 @@ bool ossimPointCloudUtil::loadPC()
             <<">\n" << std::endl;
       return false;
    }
+   if (m_pointFilter.valid() && !m_pointFilter->empty())
+      m_pcHandler->setPointFilter(m_pointFilter.get());
 
    // Use "rasterized" PC to establish best output image geometry:
    m_pciHandler = new ossimPointCloudImageHandler;
@@ -223,6 +333,14 @@ void ossimPointCloudUtil::setGSD(const double& meters_per_pixel)
    {
       m_gsd = meters_per_pixel;
       m_prodGeom->getAsMapProjection()->setMetersPerPixel(ossimDpt(m_gsd, m_gsd));
+
+      // Grid over the new pixels:
+      if (m_gridder.valid())
+         m_gridder->initialize();
+      if (m_highest.valid())
+         m_highest->initialize();
+      if (m_lowest.valid())
+         m_lowest->initialize();
    }
 }
 
@@ -230,6 +348,8 @@ bool ossimPointCloudUtil::execute()
 {
    // See if an LUT is requested:
    ossimImageSource* last_source = m_pcuFilter.get();
+   if (m_gridder.valid())
+      last_source = m_gridder.get();
    ossimRefPtr<ossimIndexToRgbLutFilter> lutSource = 0;
    if (!m_lutFile.empty())
    {
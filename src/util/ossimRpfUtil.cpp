@@ -18,16 +18,178 @@
 #include <ossim/base/ossimFilename.h>
 #include <ossim/base/ossimGpt.h>
 #include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossimTrace.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <ossim/support_data/ossimRpfFrame.h>
 #include <ossim/support_data/ossimRpfToc.h>
 #include <ossim/support_data/ossimRpfTocEntry.h>
+#include <OpenThreads/Block>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
 #include <ctime>
 #include <iomanip>
 
 static ossimTrace traceDebug = ossimTrace("ossimRpfUtil:debug");
 
+namespace
+{
+   /** Guards localtime, which returns a static buffer. */
+   OpenThreads::Mutex timeMutex;
+
+   /**
+    * Hands the items, frame files or entries, of one run out to its jobs one
+    * at a time and counts the jobs done.  The first error stops the run.
+    */
+   class ossimRpfUtilBatch : public ossimReferenced
+   {
+   public:
+      ossimRpfUtilBatch(ossim_uint32 items, ossim_uint32 jobs)
+         : m_next(0),
+           m_items(items),
+           m_jobs(jobs),
+           m_error()
+      {
+         if(m_jobs)
+         {
+            m_block.reset();
+         }
+         else
+         {
+            m_block.release();
+         }
+      }
+      bool next(ossim_uint32& item)
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if ( !m_error.empty() || (m_next >= m_items) )
+         {
+            return false;
+         }
+         item = m_next++;
+         return true;
+      }
+      void fail(const std::string& error)
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if ( m_error.empty() )
+         {
+            m_error = error;
+         }
+      }
+      void done()
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(m_mutex);
+         if(m_jobs && (--m_jobs == 0))
+         {
+            m_block.release();
+         }
+      }
+      void wait()
+      {
+         m_block.block();
+      }
+      /** Only valid after wait. */
+      const std::string& getError() const
+      {
+         return m_error;
+      }
+   private:
+      OpenThreads::Mutex m_mutex;
+      OpenThreads::Block m_block;
+      ossim_uint32       m_next;
+      ossim_uint32       m_items;
+      ossim_uint32       m_jobs;
+      std::string        m_error;
+   };
+
+   /** Parses frame files until the batch runs out. */
+   class ossimRpfParseJob : public ossimJob
+   {
+   public:
+      ossimRpfParseJob(const std::vector<ossimFilename>& files,
+                       std::vector< ossimRefPtr<ossimRpfFrame> >& frames,
+                       bool minimalParse,
+                       ossimRpfUtilBatch* batch)
+         : m_files(files),
+           m_frames(frames),
+           m_minimalParse(minimalParse),
+           m_batch(batch)
+      {
+         setName("ossimRpfUtil.parse");
+      }
+      virtual void start()
+      {
+         ossim_uint32 i;
+         while ( m_batch->next(i) )
+         {
+            ossimRefPtr<ossimRpfFrame> frame = new ossimRpfFrame();
+            if ( frame->parseFile(m_files[i], m_minimalParse) == ossimErrorCodes::OSSIM_OK )
+            {
+               m_frames[i] = frame;
+            }
+         }
+         m_batch->done();
+      }
+   private:
+      const std::vector<ossimFilename>&           m_files;
+      std::vector< ossimRefPtr<ossimRpfFrame> >&  m_frames;
+      bool                                        m_minimalParse;
+      ossimRefPtr<ossimRpfUtilBatch>              m_batch;
+   };
+
+   /** Writes dot rpf files of entries until the batch runs out. */
+   class ossimRpfWriteJob : public ossimJob
+   {
+   public:
+      ossimRpfWriteJob(ossimRpfUtil* util,
+                       const ossimRpfToc* toc,
+                       const std::vector<ossim_uint32>& entries,
+                       const ossimFilename& outputDir,
+                       ossimRpfUtilBatch* batch)
+         : m_util(util),
+           m_toc(toc),
+           m_entries(entries),
+           m_outputDir(outputDir),
+           m_batch(batch)
+      {
+         setName("ossimRpfUtil.write");
+      }
+      virtual void start()
+      {
+         ossim_uint32 i;
+         while ( m_batch->next(i) )
+         {
+            try
+            {
+               m_util->writeDotRpfFile(m_toc, m_toc->getTocEntry(m_entries[i]),
+                                       m_outputDir, m_entries[i]);
+            }
+            catch (const ossimException& e)
+            {
+               m_batch->fail(e.what());
+            }
+         }
+         m_batch->done();
+      }
+   private:
+      ossimRpfUtil*                     m_util;
+      const ossimRpfToc*                m_toc;
+      const std::vector<ossim_uint32>&  m_entries;
+      ossimFilename                     m_outputDir;
+      ossimRefPtr<ossimRpfUtilBatch>    m_batch;
+   };
+}
+
 ossimRpfUtil::ossimRpfUtil()
+   : m_threads(1)
 {
+   const char* lookup = ossimPreferences::instance()->findPreference("rpf.util_threads");
+   if (lookup)
+   {
+      m_threads = ossimString(lookup).toUInt32();
+   }
 }
 
 ossimRpfUtil::~ossimRpfUtil()
@@ -75,6 +237,7 @@ void ossimRpfUtil::writeDotRpfFiles( const ossimFilename& aDotTocFile,
    //---
    // Go through the entries...
    //---
+   std::vector<ossim_uint32> nonEmptyEntries;
    ossim_uint32 entries = toc->getNumberOfEntries();
    for (ossim_uint32 entry = 0; entry < entries; ++entry)
    {
@@ -83,7 +246,14 @@ void ossimRpfUtil::writeDotRpfFiles( const ossimFilename& aDotTocFile,
       {
          if ( tocEntry->isEmpty() == false )
          {
-            writeDotRpfFile(toc.get(), tocEntry, outputDir, entry);
+            if ( m_threads < 2 )
+            {
+               writeDotRpfFile(toc.get(), tocEntry, outputDir, entry);
+            }
+            else
+            {
+               nonEmptyEntries.push_back(entry);
+            }
          }
       }
       else
@@ -94,9 +264,65 @@ void ossimRpfUtil::writeDotRpfFiles( const ossimFilename& aDotTocFile,
          throw ossimException(e);
       }
    }
+
+   if ( nonEmptyEntries.size() )
+   {
+      // Each entry's frames are written by one job; entries go to idle jobs.
+      const ossim_uint32 JOBS = ossim::min( m_threads,
+         static_cast<ossim_uint32>( nonEmptyEntries.size() ) );
+      ossimRefPtr<ossimJobMultiThreadQueue> queue = new ossimJobMultiThreadQueue(0, JOBS);
+      ossimRefPtr<ossimRpfUtilBatch> batch =
+         new ossimRpfUtilBatch( static_cast<ossim_uint32>( nonEmptyEntries.size() ), JOBS );
+      std::vector< ossimRefPtr<ossimJob> > jobs;
+      for (ossim_uint32 i = 0; i < JOBS; ++i)
+      {
+         jobs.push_back( new ossimRpfWriteJob( this, toc.get(), nonEmptyEntries,
+                                               outputDir, batch.get() ) );
+         queue->getJobQueue()->add(jobs.back().get(), false);
+      }
+      batch->wait();
+
+      if ( batch->getError().size() )
+      {
+         throw ossimException( batch->getError() );
+      }
+   }
    
 } // End: ossimRpfUtil::writeDotRpfFiles
 
+void ossimRpfUtil::parseFrames( const std::vector<ossimFilename>& files,
+                                std::vector< ossimRefPtr<ossimRpfFrame> >& frames,
+                                bool minimalParse ) const
+{
+   frames.clear();
+   frames.resize( files.size() );
+   if ( files.empty() )
+   {
+      return;
+   }
+
+   // Each job parses one file at a time, which bounds the open files.
+   const ossim_uint32 JOBS = ossim::max<ossim_uint32>(
+      1, ossim::min( m_threads, static_cast<ossim_uint32>( files.size() ) ) );
+   ossimRefPtr<ossimRpfUtilBatch> batch =
+      new ossimRpfUtilBatch( static_cast<ossim_uint32>( files.size() ), JOBS );
+   if ( JOBS == 1 )
+   {
+      ossimRefPtr<ossimJob> job = new ossimRpfParseJob( files, frames, minimalParse, batch.get() );
+      job->start();
+      return;
+   }
+
+   ossimRefPtr<ossimJobMultiThreadQueue> queue = new ossimJobMultiThreadQueue(0, JOBS);
+   std::vector< ossimRefPtr<ossimJob> > jobs;
+   for (ossim_uint32 i = 0; i < JOBS; ++i)
+   {
+      jobs.push_back( new ossimRpfParseJob( files, frames, minimalParse, batch.get() ) );
+      queue->getJobQueue()->add(jobs.back().get(), false);
+   }
+   batch->wait();
+}
+
 //---
 // Writer a dot rpf file for entry to output directory.
 // 
@@ -337,8 +563,12 @@ void ossimRpfUtil::getDotRfpFilenameForEntry(const ossimFilename& outputDir,
    s[14] = '\0';
    time_t t;
    time(&t);
-   tm* lt = localtime(&t);
-   strftime(s, 15, "%Y%m%d%H%M%S", lt);
+   {
+      // Entries may be written concurrently.
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock(timeMutex);
+      tm* lt = localtime(&t);
+      strftime(s, 15, "%Y%m%d%H%M%S", lt);
+   }
    std::string date = s;
    
    outFile = outputDir.dirCat(s);
@@ -23,7 +23,19 @@
 #include <ossim/imaging/ossimImageGaussianFilter.h>
 #include <ossim/util/ossimShorelineUtil.h>
 #include <ossim/util/ossimUtilityRegistry.h>
+#include <ossim/base/ossimSimd.h>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+#include <cmath>
 #include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <set>
+
+#if OSSIM_SIMD_X86
+#  include <immintrin.h>
+#endif
 
 static const string COLOR_CODING_KW = "color_coding";
 static const string SMOOTHING_KW = "smoothing";
@@ -31,6 +43,8 @@ static const string THRESHOLD_KW = "threshold";
 static const string TOLERANCE_KW = "tolerance";
 static const string ALGORITHM_KW = "algorithm";
 static const string DO_EDGE_DETECT_KW = "do_edge_detect";
+static const string TILE_SIZE_KW = "tile_size";
+static const string THREADS_KW = "threads";
 static const ossimFilename DUMMY_OUTPUT_FILENAME = "@@NEVER_USE_THIS@@";
 static const ossimFilename TEMP_RASTER_PRODUCT_FILENAME = "temp_shoreline.tif";
 
@@ -39,6 +53,222 @@ const char* ossimShorelineUtil::DESCRIPTION =
 
 using namespace std;
 
+namespace
+{
+   //---
+   // Water index and threshold of one run of pixels.  The inputs are NaN where null, which
+   // classifies as land.
+   //---
+   struct ClassKernel
+   {
+      const ossim_float32* in[4];
+      bool                 awei;
+      ossim_float32        lo;   // Above is marginal.
+      ossim_float32        hi;   // Above is water.
+      ossim_float32        land;
+      ossim_float32        marginal;
+      ossim_float32        water;
+      ossim_float32*       out;
+   };
+
+   inline void classScalar(const ClassKernel& k, ossim_uint32 i)
+   {
+      ossim_float32 v;
+      if (k.awei)
+         v = 4.0f*(k.in[0][i] + k.in[1][i]) - 0.25f*k.in[2][i] - 2.75f*k.in[3][i];
+      else
+         v = k.in[0][i] / (k.in[0][i] + k.in[1][i]);
+      k.out[i] = (v > k.hi) ? k.water : ((v > k.lo) ? k.marginal : k.land);
+   }
+
+#if OSSIM_SIMD_X86
+
+   OSSIM_SIMD_TARGET("sse2")
+   ossim_uint32 classSse2(const ClassKernel& k, ossim_uint32 count)
+   {
+      const __m128 LO = _mm_set1_ps(k.lo);
+      const __m128 HI = _mm_set1_ps(k.hi);
+      const __m128 LAND = _mm_set1_ps(k.land);
+      const __m128 MARGINAL = _mm_set1_ps(k.marginal);
+      const __m128 WATER = _mm_set1_ps(k.water);
+      ossim_uint32 i = 0;
+      for (; i + 4 <= count; i += 4)
+      {
+         __m128 v;
+         if (k.awei)
+         {
+            v = _mm_sub_ps(_mm_sub_ps(
+                   _mm_mul_ps(_mm_set1_ps(4.0f),
+                              _mm_add_ps(_mm_loadu_ps(k.in[0] + i), _mm_loadu_ps(k.in[1] + i))),
+                   _mm_mul_ps(_mm_set1_ps(0.25f), _mm_loadu_ps(k.in[2] + i))),
+                   _mm_mul_ps(_mm_set1_ps(2.75f), _mm_loadu_ps(k.in[3] + i)));
+         }
+         else
+         {
+            const __m128 A = _mm_loadu_ps(k.in[0] + i);
+            v = _mm_div_ps(A, _mm_add_ps(A, _mm_loadu_ps(k.in[1] + i)));
+         }
+         const __m128 W = _mm_cmpgt_ps(v, HI);
+         const __m128 M = _mm_andnot_ps(W, _mm_cmpgt_ps(v, LO));
+         _mm_storeu_ps(k.out + i,
+                       _mm_or_ps(_mm_or_ps(_mm_and_ps(W, WATER), _mm_and_ps(M, MARGINAL)),
+                                 _mm_andnot_ps(_mm_or_ps(W, M), LAND)));
+      }
+      return i;
+   }
+
+   OSSIM_SIMD_TARGET("avx2")
+   ossim_uint32 classAvx2(const ClassKernel& k, ossim_uint32 count)
+   {
+      const __m256 LO = _mm256_set1_ps(k.lo);
+      const __m256 HI = _mm256_set1_ps(k.hi);
+      const __m256 LAND = _mm256_set1_ps(k.land);
+      const __m256 MARGINAL = _mm256_set1_ps(k.marginal);
+      const __m256 WATER = _mm256_set1_ps(k.water);
+      ossim_uint32 i = 0;
+      for (; i + 8 <= count; i += 8)
+      {
+         __m256 v;
+         if (k.awei)
+         {
+            v = _mm256_sub_ps(_mm256_sub_ps(
+                   _mm256_mul_ps(_mm256_set1_ps(4.0f), _mm256_add_ps(
+                                    _mm256_loadu_ps(k.in[0] + i), _mm256_loadu_ps(k.in[1] + i))),
+                   _mm256_mul_ps(_mm256_set1_ps(0.25f), _mm256_loadu_ps(k.in[2] + i))),
+                   _mm256_mul_ps(_mm256_set1_ps(2.75f), _mm256_loadu_ps(k.in[3] + i)));
+         }
+         else
+         {
+            const __m256 A = _mm256_loadu_ps(k.in[0] + i);
+            v = _mm256_div_ps(A, _mm256_add_ps(A, _mm256_loadu_ps(k.in[1] + i)));
+         }
+         const __m256 W = _mm256_cmp_ps(v, HI, _CMP_GT_OQ);
+         const __m256 M = _mm256_andnot_ps(W, _mm256_cmp_ps(v, LO, _CMP_GT_OQ));
+         _mm256_storeu_ps(k.out + i, _mm256_or_ps(
+                             _mm256_or_ps(_mm256_and_ps(W, WATER), _mm256_and_ps(M, MARGINAL)),
+                             _mm256_andnot_ps(_mm256_or_ps(W, M), LAND)));
+      }
+      return i;
+   }
+
+#endif /* #if OSSIM_SIMD_X86 */
+
+   void classify(const ClassKernel& k, ossim_uint32 count)
+   {
+      ossim_uint32 done = 0;
+#if OSSIM_SIMD_X86
+      const ossim::SimdLevel LEVEL = ossim::getSimdLevel();
+      if (LEVEL >= ossim::SIMD_AVX2)
+         done = classAvx2(k, count);
+      else if (LEVEL >= ossim::SIMD_SSE2)
+         done = classSse2(k, count);
+#endif
+      for (ossim_uint32 i = done; i < count; ++i)
+         classScalar(k, i);
+   }
+
+   template <class T>
+   void toValues(const T* s, ossim_float32* d, ossim_uint32 count, T nullPix)
+   {
+      const ossim_float32 NAN_F = std::numeric_limits<ossim_float32>::quiet_NaN();
+      for (ossim_uint32 i = 0; i < count; ++i)
+         d[i] = (s[i] == nullPix) ? NAN_F : (ossim_float32) s[i];
+   }
+
+   /** First band of tile as float, NaN where null. */
+   void toValues(const ossimImageData* tile, std::vector<ossim_float32>& values)
+   {
+      const ossim_float32 NAN_F = std::numeric_limits<ossim_float32>::quiet_NaN();
+      const ossim_uint32 count = (ossim_uint32) values.size();
+      if ( !tile || (tile->getDataObjectStatus() == OSSIM_NULL) ||
+           (tile->getDataObjectStatus() == OSSIM_EMPTY) || !tile->getBuf(0) )
+      {
+         std::fill(values.begin(), values.end(), NAN_F);
+         return;
+      }
+      const double np = tile->getNullPix(0);
+      ossim_float32* d = &values.front();
+      switch (tile->getScalarType())
+      {
+         case OSSIM_UINT8:
+            toValues(static_cast<const ossim_uint8*>(tile->getBuf(0)), d, count,
+                     (ossim_uint8) np);
+            break;
+         case OSSIM_SINT16:
+            toValues(static_cast<const ossim_sint16*>(tile->getBuf(0)), d, count,
+                     (ossim_sint16) np);
+            break;
+         case OSSIM_UINT16:
+         case OSSIM_USHORT11:
+            toValues(static_cast<const ossim_uint16*>(tile->getBuf(0)), d, count,
+                     (ossim_uint16) np);
+            break;
+         case OSSIM_SINT32:
+            toValues(static_cast<const ossim_sint32*>(tile->getBuf(0)), d, count,
+                     (ossim_sint32) np);
+            break;
+         case OSSIM_UINT32:
+            toValues(static_cast<const ossim_uint32*>(tile->getBuf(0)), d, count,
+                     (ossim_uint32) np);
+            break;
+         case OSSIM_FLOAT32:
+         case OSSIM_NORMALIZED_FLOAT:
+            toValues(static_cast<const ossim_float32*>(tile->getBuf(0)), d, count,
+                     (ossim_float32) np);
+            break;
+         case OSSIM_FLOAT64:
+         case OSSIM_NORMALIZED_DOUBLE:
+            toValues(static_cast<const ossim_float64*>(tile->getBuf(0)), d, count,
+                     (ossim_float64) np);
+            break;
+         default:
+            std::fill(values.begin(), values.end(), NAN_F);
+            break;
+      }
+   }
+
+   // Cell corners a (upper left), b, c (lower right), d; edges T (a-b), R (b-c), B (d-c), L (a-d).
+   enum { A_CORNER, B_CORNER, C_CORNER, D_CORNER };
+   enum { T_EDGE, R_EDGE, B_EDGE, L_EDGE };
+   const double CORNER_X[4] = { 0.0, 1.0, 1.0, 0.0 };
+   const double CORNER_Y[4] = { 0.0, 0.0, 1.0, 1.0 };
+   const double EDGE_X[4]   = { 0.5, 1.0, 0.5, 0.0 };
+   const double EDGE_Y[4]   = { 0.0, 0.5, 1.0, 0.5 };
+   const int    EDGE_CORNERS[4][2] = { {A_CORNER, B_CORNER}, {B_CORNER, C_CORNER},
+                                       {D_CORNER, C_CORNER}, {A_CORNER, D_CORNER} };
+
+   /** Segment of the boundary through one cell, from edge e1 to edge e2. */
+   struct Segment
+   {
+      int e1;
+      int e2;
+   };
+
+   //---
+   // Orders the edges so that water is on the right going from e1 to e2 (x right, y down).
+   // ref is a corner off the segment, on the water side if refIsWater.  Decided on the edge
+   // midpoints so the order is the same for every cell with this configuration.
+   //---
+   Segment orient(int e1, int e2, int ref, bool refIsWater)
+   {
+      const double CROSS = (EDGE_X[e2] - EDGE_X[e1])*(CORNER_Y[ref] - EDGE_Y[e1]) -
+                           (EDGE_Y[e2] - EDGE_Y[e1])*(CORNER_X[ref] - EDGE_X[e1]);
+      Segment s;
+      s.e1 = ((CROSS > 0.0) == refIsWater) ? e1 : e2;
+      s.e2 = (s.e1 == e1) ? e2 : e1;
+      return s;
+   }
+
+   /** Traced segment, from the crossing p of edge from to the crossing q of edge to. */
+   struct Piece
+   {
+      std::pair<ossim_int32, ossim_int32> from;
+      std::pair<ossim_int32, ossim_int32> to;
+      ossimDpt p;
+      ossimDpt q;
+   };
+}
+
 ossimShorelineUtil::ossimShorelineUtil()
 :    m_waterValue (255),
      m_marginalValue (128),
@@ -49,7 +279,9 @@ ossimShorelineUtil::ossimShorelineUtil()
      m_algorithm(NDWI),
      m_skipThreshold(false),
      m_smoothing(0.2),
-     m_doEdgeDetect(false)
+     m_doEdgeDetect(false),
+     m_tileSize(0),
+     m_numThreads(0)
 {
 }
 
@@ -87,9 +319,16 @@ void ossimShorelineUtil::setUsage(ossimArgumentParser& ap)
    au->addCommandLineOption("--smooth [S]",
          "Applies gaussian filter to index raster file. S is filter sigma (defaults to 0.2). S=0 "
          "indicates no smoothing.");
+   au->addCommandLineOption("--threads <n>",
+         "Number of threads for --tile-size processing. Defaults to the number of cores.");
    au->addCommandLineOption("--threshold <0.0-1.0>",
          "Normalized threshold for converting the image to bitmap. Defaults to 0.55. Alternatively "
          "can be set to 'X' to skip thresholding operation.");
+   au->addCommandLineOption("--tile-size <pixels>",
+         "Processes the AOI in square tiles on a thread pool and traces the shoreline itself "
+         "(marching squares at midway between the water and land values) rather than through "
+         "the potrace plugin, so memory is bounded by the tile size. Ignored with --edge or "
+         "--threshold X. Defaults to 0 (whole AOI).");
    au->addCommandLineOption("--tolerance <float>",
          "tolerance +- deviation from threshold for marginal classifications. Defaults to 0.01.");
 }
@@ -125,9 +364,15 @@ bool ossimShorelineUtil::initialize(ossimArgumentParser& ap)
    if ( ap.read("--smooth", sp1))
       m_kwl.addPair(SMOOTHING_KW, ts1);
 
+   if ( ap.read("--threads", sp1))
+      m_kwl.addPair(THREADS_KW, ts1);
+
    if ( ap.read("--threshold", sp1))
       m_kwl.addPair(THRESHOLD_KW, ts1);
 
+   if ( ap.read("--tile-size", sp1))
+      m_kwl.addPair(TILE_SIZE_KW, ts1);
+
    if ( ap.read("--tolerance", sp1))
       m_kwl.addPair(TOLERANCE_KW, ts1);
 
@@ -209,6 +454,14 @@ void ossimShorelineUtil::initialize(const ossimKeywordlist& kwl)
    if (!value.empty())
       m_tolerance = value.toDouble();
 
+   value = m_kwl.findKey(TILE_SIZE_KW);
+   if (!value.empty())
+      m_tileSize = value.toUInt32();
+
+   value = m_kwl.findKey(THREADS_KW);
+   if (!value.empty())
+      m_numThreads = value.toUInt32();
+
    // Output filename specifies the vector output, while base class interprets as raster, correct:
    if (!m_doEdgeDetect)
    {
@@ -365,6 +618,9 @@ ossimRefPtr<ossimImageData> ossimShorelineUtil::getChip(const ossimIrect& boundi
 
 bool ossimShorelineUtil::execute()
 {
+   if (m_tileSize && !m_doEdgeDetect && !m_skipThreshold)
+      return executeTiled();
+
    // Base class handles the thresholded image generation. May throw exception. Output written to
    // m_productFilename:
    bool status = ossimChipProcUtil::execute();
@@ -397,6 +653,389 @@ bool ossimShorelineUtil::execute()
    return status;
 }
 
+bool ossimShorelineUtil::executeTiled()
+{
+   ostringstream xmsg;
+   if (!m_geom.valid() || m_aoiViewRect.hasNans())
+   {
+      xmsg<<"ossimShorelineUtil:"<<__LINE__<<"  AOI not initialized."<<ends;
+      throw ossimException(xmsg.str());
+   }
+
+   // Cells have their upper left pixel over the AOI grown by one on the upper left, so the
+   // land outside the AOI closes every boundary.
+   const ossimIrect CELLS (m_aoiViewRect.ul() - ossimIpt(1, 1), m_aoiViewRect.lr());
+   const ossim_int32 TS = (ossim_int32) m_tileSize;
+   vector<ossimIrect> tiles;
+   for (ossim_int32 y = CELLS.ul().y; y <= CELLS.lr().y; y += TS)
+   {
+      for (ossim_int32 x = CELLS.ul().x; x <= CELLS.lr().x; x += TS)
+      {
+         tiles.push_back(ossimIrect(x, y, std::min(x + TS - 1, CELLS.lr().x),
+                                    std::min(y + TS - 1, CELLS.lr().y)));
+      }
+   }
+
+   m_polylines.clear();
+   if (m_numThreads == 0)
+      m_numThreads = ossim::getNumberOfThreads();
+
+   setPercentComplete(0);
+   if (m_numThreads == 1)
+   {
+      for (ossim_uint32 i=0; i<tiles.size(); ++i)
+      {
+         traceTile(tiles[i]);
+         setPercentComplete(100*(i+1)/tiles.size());
+      }
+   }
+   else
+   {
+      ossimRefPtr<ossimJobMultiThreadQueue> jobMtQueue =
+            new ossimJobMultiThreadQueue(0, m_numThreads);
+      ossimJobQueue* jobQueue = jobMtQueue->getJobQueue();
+      for (ossim_uint32 i=0; i<tiles.size(); ++i)
+         jobQueue->add(new TileJob(this, tiles[i]), false);
+
+      ossim_int32 qsize = 0;
+      while (jobMtQueue->hasJobsToProcess() || jobMtQueue->numberOfBusyThreads())
+      {
+         qsize = jobMtQueue->getJobQueue()->size();
+         setPercentComplete(100*(tiles.size()-qsize)/tiles.size());
+         OpenThreads::Thread::microSleep(10000);
+      }
+      jobMtQueue = 0;
+   }
+   setPercentComplete(100);
+
+   stitchPolylines();
+
+   if (m_vectorFilename.empty())
+   {
+      writeGeoJson(*m_consoleStream);
+   }
+   else
+   {
+      ofstream out (m_vectorFilename.chars());
+      if (!out)
+      {
+         xmsg<<"ossimShorelineUtil:"<<__LINE__<<"  Could not open <"<<m_vectorFilename
+               <<"> for writing."<<ends;
+         throw ossimException(xmsg.str());
+      }
+      writeGeoJson(out);
+      ossimNotify(ossimNotifyLevel_INFO)<<"Wrote shoreline vectors to <"<<m_vectorFilename
+            <<">"<<endl;
+   }
+   return true;
+}
+
+void ossimShorelineUtil::getClassValues(const ossimIrect& rect, vector<ossim_float32>& values)
+{
+   // Same support as ossimImageGaussianFilter, 2.5 sigma each side:
+   const ossim_int32 HALF = (m_smoothing > 0) ?
+         (ossim_int32) std::floor(m_smoothing * 2.5 + 0.5) : 0;
+   const ossimIrect READ (rect.ul() - ossimIpt(HALF, HALF), rect.lr() + ossimIpt(HALF, HALF));
+   const ossim_int32 RW = (ossim_int32) READ.width();
+   const ossim_int32 RH = (ossim_int32) READ.height();
+   const ossim_uint32 COUNT = RW*RH;
+
+   const ossim_uint32 numInputs = (m_algorithm == AWEI) ? 4 : 2;
+   vector< vector<ossim_float32> > inputs (numInputs, vector<ossim_float32>(COUNT));
+   for (ossim_uint32 i=0; i<numInputs; ++i)
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_readMutex);
+      ossimRefPtr<ossimImageData> tile = m_imgLayers[i]->getTile(READ, 0);
+      toValues(tile.get(), inputs[i]);
+   }
+
+   vector<ossim_float32> classes (COUNT);
+   ClassKernel k;
+   for (ossim_uint32 i=0; i<4; ++i)
+      k.in[i] = &inputs[std::min(i, numInputs-1)].front();
+   k.awei = (m_algorithm == AWEI);
+   k.lo = (ossim_float32) (m_threshold - m_tolerance);
+   k.hi = (ossim_float32) (m_threshold + m_tolerance);
+   k.land = m_landValue;
+   k.marginal = m_marginalValue;
+   k.water = m_waterValue;
+   k.out = &classes.front();
+   classify(k, COUNT);
+
+   const ossim_int32 W = (ossim_int32) rect.width();
+   const ossim_int32 H = (ossim_int32) rect.height();
+   values.resize(W*H);
+   if (HALF)
+   {
+      double sum = 1.0;
+      vector<double> kernel (2*HALF + 1, 1.0);
+      const double SIG22 = m_smoothing*m_smoothing*2.0;
+      for (ossim_int32 i=1; i<=HALF; ++i)
+      {
+         kernel[HALF + i] = kernel[HALF - i] = std::exp(-i*i/SIG22);
+         sum += 2.0*kernel[HALF + i];
+      }
+      for (ossim_int32 i=0; i<2*HALF+1; ++i)
+         kernel[i] /= sum;
+
+      // Rows, then columns of the rows:
+      vector<ossim_float32> rows (RH*W);
+      for (ossim_int32 y=0; y<RH; ++y)
+      {
+         for (ossim_int32 x=0; x<W; ++x)
+         {
+            const ossim_float32* s = &classes[y*RW + x];
+            double v = 0.0;
+            for (ossim_int32 i=0; i<2*HALF+1; ++i)
+               v += kernel[i]*s[i];
+            rows[y*W + x] = (ossim_float32) v;
+         }
+      }
+      for (ossim_int32 y=0; y<H; ++y)
+      {
+         for (ossim_int32 x=0; x<W; ++x)
+         {
+            double v = 0.0;
+            for (ossim_int32 i=0; i<2*HALF+1; ++i)
+               v += kernel[i]*rows[(y+i)*W + x];
+            values[y*W + x] = (ossim_float32) v;
+         }
+      }
+   }
+   else
+   {
+      values = classes;
+   }
+
+   // Land outside the AOI:
+   for (ossim_int32 y=0; y<H; ++y)
+   {
+      const ossim_int32 Y = rect.ul().y + y;
+      for (ossim_int32 x=0; x<W; ++x)
+      {
+         const ossim_int32 X = rect.ul().x + x;
+         if ( (X < m_aoiViewRect.ul().x) || (X > m_aoiViewRect.lr().x) ||
+              (Y < m_aoiViewRect.ul().y) || (Y > m_aoiViewRect.lr().y) )
+            values[y*W + x] = m_landValue;
+      }
+   }
+}
+
+void ossimShorelineUtil::TileJob::start()
+{
+   m_util->traceTile(m_cells);
+}
+
+void ossimShorelineUtil::traceTile(const ossimIrect& cells)
+{
+   // The pixels of the cells: one more on the right and bottom.
+   const ossimIrect PIXELS (cells.ul(), cells.lr() + ossimIpt(1, 1));
+   vector<ossim_float32> v;
+   getClassValues(PIXELS, v);
+   const ossim_int32 W = (ossim_int32) PIXELS.width();
+   const double LEVEL = (m_landValue + m_waterValue) / 2.0;
+   const bool WATER_ABOVE = (m_waterValue > m_landValue);
+
+   vector<Piece> pieces;
+
+   for (ossim_int32 y = cells.ul().y; y <= cells.lr().y; ++y)
+   {
+      for (ossim_int32 x = cells.ul().x; x <= cells.lr().x; ++x)
+      {
+         const ossim_uint32 I = (y - PIXELS.ul().y)*W + (x - PIXELS.ul().x);
+         const double c[4] = { v[I], v[I+1], v[I+W+1], v[I+W] };
+         bool water[4];
+         int numWater = 0;
+         for (int i=0; i<4; ++i)
+         {
+            water[i] = ((c[i] > LEVEL) == WATER_ABOVE) && (c[i] != LEVEL);
+            numWater += water[i];
+         }
+         if ((numWater == 0) || (numWater == 4))
+            continue;
+
+         Segment segs[2];
+         int numSegs = 0;
+         if ((numWater == 2) && (water[A_CORNER] == water[C_CORNER]))
+         {
+            // Saddle, decided by the cell center:
+            const double CENTER = (c[0] + c[1] + c[2] + c[3]) / 4.0;
+            const bool centerWater = ((CENTER > LEVEL) == WATER_ABOVE) && (CENTER != LEVEL);
+            if (centerWater == water[A_CORNER])
+            {
+               // a and c connect; b and d are cut off.
+               segs[0] = orient(T_EDGE, R_EDGE, B_CORNER, water[B_CORNER]);
+               segs[1] = orient(L_EDGE, B_EDGE, D_CORNER, water[D_CORNER]);
+            }
+            else
+            {
+               segs[0] = orient(T_EDGE, L_EDGE, A_CORNER, water[A_CORNER]);
+               segs[1] = orient(R_EDGE, B_EDGE, C_CORNER, water[C_CORNER]);
+            }
+            numSegs = 2;
+         }
+         else
+         {
+            int crossed[2];
+            int n = 0;
+            for (int e=0; e<4; ++e)
+            {
+               if (water[EDGE_CORNERS[e][0]] != water[EDGE_CORNERS[e][1]])
+                  crossed[n++] = e;
+            }
+            // The corner alone on its side, or a when two and two:
+            int ref = A_CORNER;
+            if (numWater != 2)
+            {
+               for (int i=0; i<4; ++i)
+               {
+                  if (water[i] == (numWater == 1))
+                     ref = i;
+               }
+            }
+            segs[0] = orient(crossed[0], crossed[1], ref, water[ref]);
+            numSegs = 1;
+         }
+
+         for (int s=0; s<numSegs; ++s)
+         {
+            Piece piece;
+            const int E[2] = { segs[s].e1, segs[s].e2 };
+            for (int j=0; j<2; ++j)
+            {
+               const int C0 = EDGE_CORNERS[E[j]][0];
+               const int C1 = EDGE_CORNERS[E[j]][1];
+               const double T = (LEVEL - c[C0]) / (c[C1] - c[C0]);
+               const double PX = x + CORNER_X[C0] + T*(CORNER_X[C1] - CORNER_X[C0]);
+               const double PY = y + CORNER_Y[C0] + T*(CORNER_Y[C1] - CORNER_Y[C0]);
+               const EdgeKey KEY ((ossim_int32) (2.0*(x + EDGE_X[E[j]])),
+                                  (ossim_int32) (2.0*(y + EDGE_Y[E[j]])));
+               if (j == 0)
+               {
+                  piece.from = KEY;
+                  piece.p = ossimDpt(PX, PY);
+               }
+               else
+               {
+                  piece.to = KEY;
+                  piece.q = ossimDpt(PX, PY);
+               }
+            }
+            pieces.push_back(piece);
+         }
+      }
+   }
+
+   // Chain the pieces: each crossed edge starts at most one piece and ends at most one.
+   map<EdgeKey, ossim_uint32> byStart;
+   set<EdgeKey> ends;
+   for (ossim_uint32 i=0; i<pieces.size(); ++i)
+   {
+      byStart[pieces[i].from] = i;
+      ends.insert(pieces[i].to);
+   }
+   vector<bool> used (pieces.size(), false);
+   vector<Polyline> lines;
+   for (int pass=0; pass<2; ++pass)
+   {
+      // Heads of open chains first, then what is left are loops.
+      for (ossim_uint32 i=0; i<pieces.size(); ++i)
+      {
+         if (used[i] || ((pass == 0) && ends.count(pieces[i].from)))
+            continue;
+         Polyline line;
+         line.m_first = pieces[i].from;
+         line.m_points.push_back(pieces[i].p);
+         ossim_uint32 j = i;
+         while (true)
+         {
+            used[j] = true;
+            line.m_points.push_back(pieces[j].q);
+            line.m_last = pieces[j].to;
+            map<EdgeKey, ossim_uint32>::const_iterator next = byStart.find(pieces[j].to);
+            if ((next == byStart.end()) || used[next->second])
+               break;
+            j = next->second;
+         }
+         line.m_closed = (line.m_last == line.m_first);
+         lines.push_back(line);
+      }
+   }
+
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_polylineMutex);
+   m_polylines.insert(m_polylines.end(), lines.begin(), lines.end());
+}
+
+void ossimShorelineUtil::stitchPolylines()
+{
+   vector<Polyline> result;
+   vector<ossim_uint32> open;
+   for (ossim_uint32 i=0; i<m_polylines.size(); ++i)
+   {
+      if (m_polylines[i].m_closed)
+         result.push_back(m_polylines[i]);
+      else
+         open.push_back(i);
+   }
+
+   map<EdgeKey, ossim_uint32> byFirst;
+   set<EdgeKey> lasts;
+   for (ossim_uint32 i=0; i<open.size(); ++i)
+   {
+      byFirst[m_polylines[open[i]].m_first] = open[i];
+      lasts.insert(m_polylines[open[i]].m_last);
+   }
+   vector<bool> used (m_polylines.size(), false);
+   for (int pass=0; pass<2; ++pass)
+   {
+      for (ossim_uint32 i=0; i<open.size(); ++i)
+      {
+         const ossim_uint32 START = open[i];
+         if (used[START] || ((pass == 0) && lasts.count(m_polylines[START].m_first)))
+            continue;
+         Polyline line = m_polylines[START];
+         used[START] = true;
+         while (true)
+         {
+            map<EdgeKey, ossim_uint32>::const_iterator next = byFirst.find(line.m_last);
+            if ((next == byFirst.end()) || used[next->second])
+               break;
+            const Polyline& piece = m_polylines[next->second];
+            used[next->second] = true;
+            // The first point of the next piece is the same crossing as our last.
+            line.m_points.insert(line.m_points.end(), piece.m_points.begin() + 1,
+                                 piece.m_points.end());
+            line.m_last = piece.m_last;
+         }
+         line.m_closed = (line.m_last == line.m_first);
+         result.push_back(line);
+      }
+   }
+   m_polylines.swap(result);
+}
+
+void ossimShorelineUtil::writeGeoJson(ostream& out) const
+{
+   out << "{\"type\":\"FeatureCollection\",\"features\":[";
+   out << setprecision(10);
+   ossimGpt gpt;
+   for (ossim_uint32 i=0; i<m_polylines.size(); ++i)
+   {
+      const vector<ossimDpt>& pts = m_polylines[i].m_points;
+      out << (i ? ",\n" : "\n")
+          << "{\"type\":\"Feature\",\"properties\":{\"closed\":"
+          << (m_polylines[i].m_closed ? "true" : "false")
+          << "},\"geometry\":{\"type\":\"LineString\",\"coordinates\":[";
+      for (ossim_uint32 j=0; j<pts.size(); ++j)
+      {
+         m_geom->localToWorld(pts[j], gpt);
+         out << (j ? "," : "") << "[" << gpt.lon << "," << gpt.lat << "]";
+      }
+      out << "]}}";
+   }
+   out << "\n]}\n";
+}
+
 /*
 void ossimShorelineUtil::computeKMeans()
 {
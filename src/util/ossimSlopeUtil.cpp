@@ -19,7 +19,7 @@
 #include <ossim/elevation/ossimElevManager.h>
 #include <ossim/projection/ossimEquDistCylProjection.h>
 #include <ossim/projection/ossimImageViewProjectionTransform.h>
-#include <ossim/imaging/ossimSlopeFilter.h>
+#include <ossim/imaging/ossimTerrainDerivativeSource.h>
 #include <ossim/imaging/ossimImageHandlerRegistry.h>
 #include <ossim/imaging/ossimImageWriterFactoryRegistry.h>
 #include <ossim/imaging/ossimTiffWriter.h>
@@ -129,7 +129,9 @@ void ossimSlopeUtil::initProcessingChain()
    m_procChain->add(combiner.get());
 
    // Finally add the slope filter:
-   ossimRefPtr<ossimSlopeFilter> slope_filter = new ossimSlopeFilter;
+   ossimRefPtr<ossimTerrainDerivativeSource> slope_filter = new ossimTerrainDerivativeSource;
+   slope_filter->setProducts(std::vector<ossimTerrainDerivativeSource::Product>(
+                                1, ossimTerrainDerivativeSource::SLOPE));
    slope_filter->setSlopeType(ossimSlopeFilter::NORMALIZED);
    m_procChain->add(slope_filter.get());
 
@@ -7,6 +7,7 @@
 
 #include <ossim/util/ossimUtilityRegistry.h>
 #include <ossim/util/ossimUtilityFactory.h>
+#include <ossim/plugin/ossimSharedPluginRegistry.h>
 
 using namespace std;
 
@@ -38,6 +39,7 @@ void ossimUtilityRegistry::getCapabilities(map<string, string>& capabilities) co
 {
    capabilities.clear();
    ossimString name, descr;
+   ossimSharedPluginRegistry::instance()->loadAllDeferredPlugins();
 
    // Loop over all factories and get capabilities which is list of (name, descr) pairs for all
    // registered operations:
@@ -59,6 +61,8 @@ std::map<std::string, std::string> ossimUtilityRegistry::getCapabilities() const
 ossimUtility* ossimUtilityRegistry::createUtility(const std::string& argName) const
 {
    ossimUtility* result = 0;
+   ossimSharedPluginRegistry::instance()->loadDeferredPlugins(
+      ossimSharedPluginRegistry::MANIFEST_UTILITIES_KW, ossimString(argName));
    vector<ossimUtilityFactoryBase*>::const_iterator iter = m_factoryList.begin();
    while ((iter != m_factoryList.end()) && (!result))
    {
@@ -71,6 +75,7 @@ ossimUtility* ossimUtilityRegistry::createUtility(const std::string& argName) co
 void ossimUtilityRegistry::getTypeNameList(vector<ossimString>& typeList) const
 {
    typeList.clear();
+   ossimSharedPluginRegistry::instance()->loadAllDeferredPlugins();
    vector<ossimUtilityFactoryBase*>::const_iterator iter = m_factoryList.begin();
    while (iter != m_factoryList.end())
    {
@@ -32,15 +32,23 @@ using namespace std;
 const char* ossimViewshedUtil::DESCRIPTION =
       "Computes bitmap image representing the viewshed from specified location using only "
       "DEM information.";
+static const string BATCH_OUTPUT_KW      = "batch_output";
+static const string ENGINE_KW            = "engine";
 static const string FOV_KW               = "fov";
 static const string HEIGHT_OF_EYE_KW     = "height_of_eye";
 static const string HORIZON_FILE_KW      = "horizon_file";
 static const string OBSERVER_KW          = "observer";
+static const string OBSERVERS_FILE_KW    = "observers_file";
 static const string VISIBILITY_RADIUS_KW = "visibility_radius";
 static const string RETICLE_SIZE_KW      = "reticle_size";
 static const string VIEWSHED_CODING_KW   = "viewshed_coding";
 static const string AOI_SIZE_METERS_KW   = "aoi_size_meters";
 
+// Largest shared height grid of a batch, in posts (4 bytes each). Beyond this the sweeps read
+// the elevations ring by ring as for a single observer.
+static const ossim_uint64 MAX_SHARED_HEIGHTS = 64*1024*1024;
+static const ossim_int32 HEIGHT_ROWS_PER_JOB = 64;
+
 ossimViewshedUtil::ossimViewshedUtil()
 :   m_obsHgtAbvTer (1.5),
     m_visRadius (0.0),
@@ -58,6 +66,8 @@ ossimViewshedUtil::ossimViewshedUtil()
     m_startFov(0),
     m_stopFov(0),
     m_threadBySector(false),
+    m_useXDraw(false),
+    m_countVisibility(true),
     d_accumT(0)
 {
    m_observerGpt.makeNan();
@@ -83,6 +93,16 @@ void ossimViewshedUtil::setUsage(ossimArgumentParser& ap)
    au->setCommandLineUsage(usageString);
 
    // Set the command line options:
+   au->addCommandLineOption(
+         "--batch-output <count|each>", "With --observers, \"count\" (default) writes the "
+         "number of observers seeing each pixel, as 16 bit, and \"each\" writes one viewshed "
+         "per observer, <output-image> with the observer index appended to its base name.");
+   au->addCommandLineOption(
+         "--engine <radial|xdraw>", "Visibility algorithm. \"radial\" (default) casts a ray "
+         "to each pixel of the outer ring. \"xdraw\" sweeps rings outward from the observer, "
+         "interpolating the line of sight from the previous ring, and reads each DEM post once. "
+         "Much faster for large radii, with slightly different results where the terrain "
+         "grazes the line of sight.");
    au->addCommandLineOption(
          "--fov <start> <end>", "Optional arguments specifying the field-of"
          "-view boundary azimuths (in degrees). By default, a 360 deg FOV is"
@@ -94,6 +114,11 @@ void ossimViewshedUtil::setUsage(ossimArgumentParser& ap)
    au->addCommandLineOption(
          "--horizon <filename>", "Experimental. Outputs the max elevation angles "
          "for all azimuths to <filename>, for horizon profiling.");
+   au->addCommandLineOption(
+         "--observers <filename>", "Batch of observers, one \"<lat> <lon>\" per line ('#' "
+         "starts a comment), replacing the <obs_lat> <obs_lon> arguments. The elevations under "
+         "all of them are read once and the observers run on the threads with the xdraw engine. "
+         "Requires --radius. See --batch-output.");
    au->addCommandLineOption(
          "--radius <meters>", "Specifies max visibility in meters. Required "
          "unless --size is specified. This option constrains output to a circle, "
@@ -145,6 +170,12 @@ bool ossimViewshedUtil::initialize(ossimArgumentParser& ap)
    string ts3;
    ossimArgumentParser::ossimParameter sp3(ts3);
 
+   if ( ap.read("--batch-output", sp1) )
+      m_kwl.addPair( BATCH_OUTPUT_KW, ts1 );
+
+   if ( ap.read("--engine", sp1) )
+      m_kwl.addPair( ENGINE_KW, ts1 );
+
    if ( ap.read("--fov", sp1, sp2) )
    {
       double startFov = ossimString(ts1).toDouble();
@@ -169,6 +200,12 @@ bool ossimViewshedUtil::initialize(ossimArgumentParser& ap)
       numArgsExpected -= 2;
    }
 
+   if ( ap.read("--observers", sp1) )
+   {
+      m_kwl.addPair( OBSERVERS_FILE_KW, ts1 );
+      numArgsExpected -= 2;
+   }
+
    if ( ap.read("--radius", sp1) )
       m_kwl.addPair( VISIBILITY_RADIUS_KW, ts1 );
 
@@ -199,12 +236,15 @@ bool ossimViewshedUtil::initialize(ossimArgumentParser& ap)
    }
    else
    {
-      ossimString latstr = ap[1];
-      ossimString lonstr = ap[2];
-      ostringstream value;
-      value<<latstr<<" "<<lonstr;
-      m_kwl.addPair( OBSERVER_KW, value.str() );
-      ap.remove(1,2);
+      if (!m_kwl.hasKey(OBSERVERS_FILE_KW))
+      {
+         ossimString latstr = ap[1];
+         ossimString lonstr = ap[2];
+         ostringstream value;
+         value<<latstr<<" "<<lonstr;
+         m_kwl.addPair( OBSERVER_KW, value.str() );
+         ap.remove(1,2);
+      }
       processRemainingArgs(ap);
    }
 
@@ -230,6 +270,12 @@ void ossimViewshedUtil::initialize(const ossimKeywordlist& kwl)
       }
    }
 
+   value = kwl.findKey(ENGINE_KW);
+   m_useXDraw = (value.downcase() == "xdraw");
+
+   value = kwl.findKey(BATCH_OUTPUT_KW);
+   m_countVisibility = (value.downcase() != "each");
+
    value = kwl.findKey(HEIGHT_OF_EYE_KW);
    if (!value.empty())
       m_obsHgtAbvTer = value.toDouble();
@@ -249,6 +295,14 @@ void ossimViewshedUtil::initialize(const ossimKeywordlist& kwl)
       }
    }
 
+   m_observerFile = kwl.findKey(OBSERVERS_FILE_KW);
+   if (!m_observerFile.empty())
+   {
+      loadObservers();
+      if (m_observerGpt.hasNans())
+         m_observerGpt = m_observers[0];
+   }
+
    value = kwl.findKey(RETICLE_SIZE_KW);
    if (!value.empty())
       m_reticleSize = value.toInt32();
@@ -291,6 +345,12 @@ void ossimViewshedUtil::clear()
    m_outBuffer = 0;
    m_horizonMap.clear();
    m_jobMtQueue = 0;
+   m_observerFile.clear();
+   m_observers.clear();
+   m_observerVpts.clear();
+   m_observerHgts.clear();
+   m_heights.clear();
+   m_batchBuffers.clear();
    ossimChipProcUtil::clear();
 }
 
@@ -345,14 +405,23 @@ void ossimViewshedUtil::initializeAOI()
       if (!proj)
          return;
 
-      ossimDpt metersPerDegree (m_observerGpt.metersPerDegree());
-      double dlat = m_visRadius/metersPerDegree.y;
-      double dlon = m_visRadius/metersPerDegree.x;
-      ossimGpt ulg (m_observerGpt.lat + dlat, m_observerGpt.lon - dlon);
-      ossimGpt lrg (m_observerGpt.lat - dlat, m_observerGpt.lon + dlon);
-
-      m_aoiGroundRect = ossimGrect(ulg, lrg);
-      proj->setUlTiePoints(ulg);
+      // In batch mode the AOI covers every observer's visibility square:
+      vector<ossimGpt> observers (m_observers);
+      if (observers.empty())
+         observers.push_back(m_observerGpt);
+      for (ossim_uint32 i=0; i<observers.size(); ++i)
+      {
+         ossimDpt metersPerDegree (observers[i].metersPerDegree());
+         double dlat = m_visRadius/metersPerDegree.y;
+         double dlon = m_visRadius/metersPerDegree.x;
+         ossimGpt ulg (observers[i].lat + dlat, observers[i].lon - dlon);
+         ossimGpt lrg (observers[i].lat - dlat, observers[i].lon + dlon);
+         if (i == 0)
+            m_aoiGroundRect = ossimGrect(ulg, lrg);
+         else
+            m_aoiGroundRect = m_aoiGroundRect.combine(ossimGrect(ulg, lrg));
+      }
+      proj->setUlTiePoints(m_aoiGroundRect.ul());
 
       computeAdjustedViewFromGrect();
    }
@@ -395,8 +464,9 @@ void ossimViewshedUtil::initProcessingChain()
    }
 
    // Allocate the output image buffer:
+   // A batch only needs some observer to see into the AOI:
    ossimIrect bufViewRect = visRect.clipToRect(m_aoiViewRect);
-   if (bufViewRect.area() == 0)
+   if ((bufViewRect.area() == 0) && m_observers.empty())
    {
       xmsg<<"ossimViewshedUtil:"<<__LINE__<<" The requested AOI rect is outside the visibility range." << ends;
       throw ossimException(xmsg.str());
@@ -453,6 +523,9 @@ ossimRefPtr<ossimImageData> ossimViewshedUtil::getChip(const ossimIrect& boundin
 
 bool ossimViewshedUtil::execute()
 {
+   if (!m_observers.empty())
+      return executeBatch();
+
    if (!computeViewshed())
       return false;
 
@@ -494,9 +567,37 @@ bool ossimViewshedUtil::computeViewshed()
    if (m_numThreads == 0)
       m_numThreads = ossim::getNumberOfThreads();
 
-   if (m_numThreads > 1)
+   if (m_useXDraw)
    {
-      ossimRefPtr<ossimJobQueue> jobQueue = new ossimJobQueue();
+      // One job per sector; the sectors only share their boundary cells.
+      ossimNotify(ossimNotifyLevel_INFO) << "\nProcessing sectors (xdraw)..."<<endl;
+      if (m_numThreads > 1)
+      {
+         m_jobMtQueue = new ossimJobWorkStealingQueue(std::min(m_numThreads, (ossim_uint32) 8));
+         for (int sector=0; sector<8; ++sector)
+         {
+            if (m_radials[sector])
+               m_jobMtQueue->add(new XDrawSectorJob(this, sector));
+         }
+         m_jobMtQueue->waitForCompletion();
+      }
+      else
+      {
+         for (int sector=0; sector<8; ++sector)
+         {
+            if (m_radials[sector])
+               doXDrawSector(sector);
+         }
+      }
+      if (needsAborting())
+         return false;
+   }
+   else if (m_numThreads > 1)
+   {
+      // The radial jobs are short and numerous, the workers take them from their own deques and
+      // steal from each other once done:
+      m_jobMtQueue = new ossimJobWorkStealingQueue(m_numThreads);
+      ossim_uint32 numJobs = 0;
       for (int sector=0; sector<8; ++sector)
       {
          if (m_radials[sector] == 0)
@@ -505,27 +606,31 @@ bool ossimViewshedUtil::computeViewshed()
          if (m_threadBySector)
          {
             SectorProcessorJob* job = new SectorProcessorJob(this, sector, m_halfWindow);
-            jobQueue->add(job, false);
+            m_jobMtQueue->add(job);
+            ++numJobs;
          }
          else
          {
             for (ossim_uint32 r=0; r<=m_halfWindow; ++r)
             {
                RadialProcessorJob* job = new RadialProcessorJob(this, sector, r, m_halfWindow);
-               jobQueue->add(job, false);
+               m_jobMtQueue->add(job);
+               ++numJobs;
             }
          }
          if (needsAborting())
+         {
+            m_jobMtQueue->clear();
+            m_jobMtQueue->waitForCompletion();
             return 0;
+         }
       }
 
-      ossimNotify(ossimNotifyLevel_INFO) << "\nSubmitting "<<jobQueue->size()<<" jobs..."<<endl;
-      m_jobMtQueue = new ossimJobMultiThreadQueue(jobQueue.get(), m_numThreads);
+      ossimNotify(ossimNotifyLevel_INFO) << "\nSubmitted "<<numJobs<<" jobs..."<<endl;
 
       // Wait until all radials have been processed before proceeding:
       ossimNotify(ossimNotifyLevel_INFO) << "Waiting for job threads to finish..."<<endl;
-      while (m_jobMtQueue->hasJobsToProcess() || m_jobMtQueue->numberOfBusyThreads())
-         OpenThreads::Thread::microSleep(250);
+      m_jobMtQueue->waitForCompletion();
    }
    else
    {
@@ -865,6 +970,441 @@ bool ossimViewshedUtil::writeHorizonProfile()
    return true;
 }
 
+void ossimViewshedUtil::doXDrawSector(ossim_uint32 s)
+{
+   doXDrawSector(s, m_observerVpt, m_observerGpt.hgt, m_outBuffer.get(), m_radials[s]);
+}
+
+void ossimViewshedUtil::doXDrawSector(ossim_uint32 s, const ossimDpt& obsVpt, double obsHgt,
+                                      ossimImageData* buffer, Radial* radials)
+{
+   // Unit steps in view space along the sector's abscissa u and ordinate v, matching the (u, v)
+   // of RadialProcessor::doRadial():
+   static const ossim_int32 U_DIR[8][2] =
+      { {0,-1}, {1,0}, {1,0}, {0,1}, {0,1}, {-1,0}, {-1,0}, {0,-1} };
+   static const ossim_int32 V_DIR[8][2] =
+      { {1,0}, {0,-1}, {0,1}, {1,0}, {-1,0}, {0,1}, {0,-1}, {-1,0} };
+
+   const ossim_int32 R = (ossim_int32) m_halfWindow;
+   const double r2_max = (double) R * R;
+   const double groundHgt = obsHgt - m_obsHgtAbvTer;
+
+   // A line of sight leaving the AOI from an observer inside it never comes back in:
+   const bool obsInsideAoi = m_aoiViewRect.pointWithin(ossimIpt(obsVpt));
+
+   // The v=u diagonal is shared with the odd/even neighbour, the v=0 axis with the other one.
+   // Only one of the two writes a shared cell. Both compute it, with the same result.
+   const bool writeDiagonal = !(s & 1) || (m_radials[s-1] == 0);
+   const bool writeAxis = (s & 1) || (m_radials[(s+7)%8] == 0);
+
+   // Horizon slope (dz/distance) of each cell of the previous ring, v = 0..u-1. The observer
+   // is ring 0, with nothing in the way:
+   vector<double> prev (1, Radial().elevation);
+   vector<double> cur;
+   vector<double> hgts;
+
+   ossim_int32 u = 1;
+   for (; u <= R; ++u)
+   {
+      cur.resize(u+1);
+      const ossimDpt origin (obsVpt.x + u*U_DIR[s][0], obsVpt.y + u*U_DIR[s][1]);
+
+      // Find the span of the ring needing elevations, within the radius and the AOI:
+      ossim_int32 vmin = u+1;
+      ossim_int32 vmax = -1;
+      for (ossim_int32 v = 0; v <= u; ++v)
+      {
+         if (m_displayAsRadar && ((double) u*u + (double) v*v >= r2_max))
+            break;
+         ossimIpt ipt (ossimDpt(origin.x + v*V_DIR[s][0], origin.y + v*V_DIR[s][1]));
+         if (!obsInsideAoi || m_aoiViewRect.pointWithin(ipt))
+         {
+            vmin = std::min(vmin, v);
+            vmax = v;
+         }
+      }
+      // Both spans start at v=0, so with nothing needed here nothing further out is either.
+      // This ring may still hold part of the circumference:
+      const bool lastRing = (vmin > vmax);
+
+      if (!lastRing)
+      {
+         ossimDpt start (origin.x + vmin*V_DIR[s][0], origin.y + vmin*V_DIR[s][1]);
+         getHeights(start, ossimIpt(V_DIR[s][0], V_DIR[s][1]), vmax - vmin + 1, hgts);
+      }
+
+      for (ossim_int32 v = 0; v <= u; ++v)
+      {
+         // Line of sight through the previous ring, interpolated between its two cells:
+         const double vp = (double) v * (u-1) / u;
+         const ossim_int32 i0 = (ossim_int32) vp;
+         const ossim_int32 i1 = std::min(i0+1, u-1);
+         const double f = vp - i0;
+         const double req = prev[i0] + f*(prev[i1] - prev[i0]);
+         cur[v] = req;
+
+         const bool owned = (v == 0) ? writeAxis : ((v == u) ? writeDiagonal : true);
+         ossimIpt ipt (ossimDpt(origin.x + v*V_DIR[s][0], origin.y + v*V_DIR[s][1]));
+
+         if (m_displayAsRadar && ((double) u*u + (double) v*v >= r2_max))
+         {
+            // The first cell past the radius along a line of sight is on the circumference:
+            const ossim_int32 pv = ossim::round<ossim_int32, double>(vp);
+            if (owned && ((double) (u-1)*(u-1) + (double) pv*pv < r2_max))
+               buffer->setValue(ipt.x, ipt.y, m_overlayValue);
+            continue;
+         }
+         if ((v < vmin) || (v > vmax))
+            continue;
+
+         double hgt = hgts[v - vmin];
+         if (m_simulation && ossim::isnan(hgt))
+            hgt = groundHgt;
+         if (ossim::isnan(hgt))
+            continue;
+
+         const double slope = (hgt - obsHgt) / std::sqrt((double) u*u + (double) v*v);
+         if (slope > req)
+         {
+            cur[v] = slope;
+            if (owned)
+               buffer->setValue(ipt.x, ipt.y, m_visibleValue);
+         }
+         else if (owned)
+            buffer->setValue(ipt.x, ipt.y, m_hiddenValue);
+      }
+
+      prev.swap(cur);
+      if (lastRing || needsAborting())
+         break;
+   }
+
+   // Latch the radials' elevation angles, as dz/du like RadialProcessor::doRadial(), from the
+   // last ring reached:
+   const ossim_int32 last = (ossim_int32) prev.size() - 1;
+   for (ossim_uint32 r = 0; radials && last && (r <= m_halfWindow); ++r)
+   {
+      Radial& radial = radials[r];
+      const double vp = radial.azimuth * last;
+      const ossim_int32 i0 = std::min((ossim_int32) vp, last);
+      const ossim_int32 i1 = std::min(i0+1, last);
+      const double slope = prev[i0] + (vp - i0)*(prev[i1] - prev[i0]);
+      if (slope > radial.elevation)
+         radial.elevation = slope * std::sqrt(1.0 + radial.azimuth*radial.azimuth);
+   }
+}
+
+void ossimViewshedUtil::getHeights(const ossimDpt& start, const ossimIpt& dir, ossim_uint32 n,
+                                   vector<double>& heights) const
+{
+   heights.resize(n);
+   if (!m_heights.empty())
+   {
+      const ossimIpt first (start);
+      const ossimIpt end (first.x + (n-1)*dir.x, first.y + (n-1)*dir.y);
+      if (m_heightsRect.pointWithin(first) && m_heightsRect.pointWithin(end))
+      {
+         const ossim_int32 width = (ossim_int32) m_heightsRect.width();
+         const ossim_int32 stride = dir.y*width + dir.x;
+         ossim_int32 offset = (first.y - m_heightsRect.ul().y)*width + first.x - m_heightsRect.ul().x;
+         for (ossim_uint32 k=0; k<n; ++k, offset+=stride)
+            heights[k] = m_heights[offset];
+         return;
+      }
+   }
+
+   ossimGpt nanGpt;
+   nanGpt.makeNan();
+   vector<ossimGpt> gpts (n, nanGpt);
+   if (dir.x)
+      m_geom->localToWorld(start, ossimDpt(dir.x, 1.0), n, 1, &gpts.front());
+   else
+      m_geom->localToWorld(start, ossimDpt(1.0, dir.y), 1, n, &gpts.front());
+   for (ossim_uint32 k=0; k<n; ++k)
+      heights[k] = gpts[k].hgt;
+}
+
+void ossimViewshedUtil::loadObservers()
+{
+   ostringstream xmsg;
+   ifstream fstr (m_observerFile.chars());
+   if (!fstr.is_open())
+   {
+      xmsg<<"ossimViewshedUtil:"<<__LINE__<<" Could not open observers file <"<<m_observerFile
+            <<">."<<ends;
+      throw ossimException(xmsg.str());
+   }
+
+   m_observers.clear();
+   string line;
+   while (getline(fstr, line))
+   {
+      ossimString value (ossimString(line).before("#"));
+      vector <ossimString> coordstr;
+      value.split(coordstr, ossimString(" ,\t\r"), true);
+      if (coordstr.size() != 2)
+         continue;
+      m_observers.push_back(ossimGpt(coordstr[0].toDouble(), coordstr[1].toDouble(), 0.0));
+   }
+
+   if (m_observers.empty())
+   {
+      xmsg<<"ossimViewshedUtil:"<<__LINE__<<" No observers found in <"<<m_observerFile<<">."<<ends;
+      throw ossimException(xmsg.str());
+   }
+}
+
+void ossimViewshedUtil::loadHeights()
+{
+   m_heights.clear();
+
+   // Every post any sweep can read, one past the radius for the circumference:
+   const ossim_int32 R = (ossim_int32) m_halfWindow + 1;
+   bool first = true;
+   for (ossim_uint32 i=0; i<m_observerVpts.size(); ++i)
+   {
+      if (m_observerVpts[i].hasNans())
+         continue;
+      ossimIpt ipt (m_observerVpts[i]);
+      ossimIrect rect (ipt.x - R, ipt.y - R, ipt.x + R, ipt.y + R);
+      m_heightsRect = first ? rect : m_heightsRect.combine(rect);
+      first = false;
+   }
+   if (first)
+      return;
+
+   const ossim_uint64 area = (ossim_uint64) m_heightsRect.width() * m_heightsRect.height();
+   if (area > MAX_SHARED_HEIGHTS)
+   {
+      ossimNotify(ossimNotifyLevel_INFO)<<"ossimViewshedUtil::loadHeights() -- The observers "
+            "span "<<area<<" posts, too many to share. Reading them per observer."<<endl;
+      return;
+   }
+
+   ossimNotify(ossimNotifyLevel_INFO) << "\nLoading "<<area<<" elevation posts..."<<endl;
+   m_heights.assign(area, ossim::nan());
+   const ossim_int32 height = (ossim_int32) m_heightsRect.height();
+   if (m_numThreads > 1)
+   {
+      m_jobMtQueue = new ossimJobWorkStealingQueue(m_numThreads);
+      for (ossim_int32 row=0; row<height; row+=HEIGHT_ROWS_PER_JOB)
+      {
+         m_jobMtQueue->add(new HeightRowsJob(this, m_heightsRect.ul().y + row,
+                                             std::min(HEIGHT_ROWS_PER_JOB, height - row)));
+      }
+      m_jobMtQueue->waitForCompletion();
+   }
+   else
+   {
+      loadHeightRows(m_heightsRect.ul().y, height);
+   }
+}
+
+void ossimViewshedUtil::loadHeightRows(ossim_int32 firstRow, ossim_uint32 numRows)
+{
+   const ossim_uint32 width = m_heightsRect.width();
+   ossimGpt nanGpt;
+   nanGpt.makeNan();
+   vector<ossimGpt> gpts;
+   for (ossim_uint32 r=0; r<numRows; ++r)
+   {
+      const ossim_int32 y = firstRow + r;
+      gpts.assign(width, nanGpt);
+      m_geom->localToWorld(ossimDpt(m_heightsRect.ul().x, y), ossimDpt(1.0, 1.0), width, 1,
+                           &gpts.front());
+      float* row = &m_heights[(y - m_heightsRect.ul().y)*width];
+      for (ossim_uint32 x=0; x<width; ++x)
+         row[x] = (float) gpts[x].hgt;
+      if (needsAborting())
+         return;
+   }
+}
+
+void ossimViewshedUtil::doObserver(ossim_uint32 index)
+{
+   const ossimDpt& vpt = m_observerVpts[index];
+   if (vpt.hasNans())
+      return;
+
+   ossimRefPtr<ossimImageData> buffer;
+   ossimIrect bufRect;
+   if (m_countVisibility)
+   {
+      // Own buffer over the visibility square, added into the counts once swept:
+      const ossim_int32 R = (ossim_int32) m_halfWindow;
+      ossimIpt ipt (vpt);
+      ossimIrect visRect (ipt.x - R, ipt.y - R, ipt.x + R, ipt.y + R);
+      if (!visRect.intersects(m_aoiViewRect))
+         return;
+      bufRect = visRect.clipToRect(m_aoiViewRect);
+      buffer = new ossimImageData(0, OSSIM_UINT8, 1, bufRect.width(), bufRect.height());
+      buffer->initialize();
+      buffer->setImageRectangle(bufRect);
+      buffer->fill(m_visibleValue ? 0 : 1);
+   }
+   else
+   {
+      buffer = m_batchBuffers[index];
+   }
+
+   for (ossim_uint32 sector=0; sector<8; ++sector)
+   {
+      if (m_radials[sector])
+         doXDrawSector(sector, vpt, m_observerHgts[index], buffer.get(), 0);
+   }
+
+   if (!m_countVisibility)
+      return;
+
+   const ossim_uint8* visible = (const ossim_uint8*) buffer->getBuf(0);
+   ossim_uint16* counts = (ossim_uint16*) m_outBuffer->getBuf(0);
+   const ossim_uint32 width = bufRect.width();
+   const ossim_uint32 countWidth = m_aoiViewRect.width();
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_batchMutex);
+   for (ossim_uint32 y=0; y<bufRect.height(); ++y)
+   {
+      ossim_uint16* row = counts + (bufRect.ul().y - m_aoiViewRect.ul().y + y)*countWidth
+            + bufRect.ul().x - m_aoiViewRect.ul().x;
+      for (ossim_uint32 x=0; x<width; ++x)
+      {
+         if ((visible[y*width + x] == m_visibleValue) && (row[x] < OSSIM_DEFAULT_MAX_PIX_UINT16))
+            ++row[x];
+      }
+   }
+}
+
+bool ossimViewshedUtil::executeBatch()
+{
+   ostringstream xmsg;
+   if (!m_displayAsRadar)
+   {
+      xmsg<<"ossimViewshedUtil:"<<__LINE__<<" Batch mode requires a visibility radius."<<ends;
+      throw ossimException(xmsg.str());
+   }
+
+   if (m_numThreads == 0)
+      m_numThreads = ossim::getNumberOfThreads();
+
+   // Observer positions, snapped to their pixel so that all rings fall on the shared posts:
+   ossimElevManager* elevMgr = ossimElevManager::instance();
+   const ossim_uint32 numObservers = (ossim_uint32) m_observers.size();
+   m_observerVpts.resize(numObservers);
+   m_observerHgts.resize(numObservers);
+   for (ossim_uint32 i=0; i<numObservers; ++i)
+   {
+      ossimDpt vpt;
+      m_geom->worldToLocal(m_observers[i], vpt);
+      m_observerVpts[i] = vpt.hasNans() ? vpt : ossimDpt(ossimIpt(vpt));
+      m_observerHgts[i] = elevMgr->getHeightAboveEllipsoid(m_observers[i]) + m_obsHgtAbvTer;
+   }
+
+   // Sectors come from the requested FOV only, the same for every observer:
+   m_useXDraw = true;
+   initRadials();
+   loadHeights();
+   if (needsAborting())
+      return false;
+
+   if (m_countVisibility)
+   {
+      m_outBuffer = ossimImageDataFactory::instance()->create(0, OSSIM_UINT16, 1,
+            m_aoiViewRect.width(), m_aoiViewRect.height());
+      if (!m_outBuffer.valid())
+      {
+         xmsg<<"ossimViewshedUtil:"<<__LINE__<<" Output buffer allocation failed." << ends;
+         throw ossimException(xmsg.str());
+      }
+      m_outBuffer->initialize();
+      m_outBuffer->setImageRectangle(m_aoiViewRect);
+      m_outBuffer->fill(0.0);
+
+      ossimNotify(ossimNotifyLevel_INFO) << "\nProcessing "<<numObservers<<" observers..."<<endl;
+      if (m_numThreads > 1)
+      {
+         m_jobMtQueue = new ossimJobWorkStealingQueue(m_numThreads);
+         for (ossim_uint32 i=0; i<numObservers; ++i)
+            m_jobMtQueue->add(new ObserverProcessorJob(this, i));
+         m_jobMtQueue->waitForCompletion();
+      }
+      else
+      {
+         for (ossim_uint32 i=0; (i<numObservers) && !needsAborting(); ++i)
+            doObserver(i);
+      }
+      if (needsAborting())
+         return false;
+
+      m_memSource->setImage(m_outBuffer);
+      m_procChain->initialize();
+      return ossimChipProcUtil::execute();
+   }
+
+   // One output per observer, computed m_numThreads at a time:
+   const ossimFilename productFilename (m_productFilename);
+   const double nullPix = m_procChain->getNullPixelValue();
+   m_batchBuffers.resize(numObservers);
+   bool status = true;
+   for (ossim_uint32 first=0; status && (first<numObservers); first+=m_numThreads)
+   {
+      const ossim_uint32 last = std::min(first + m_numThreads, numObservers);
+      for (ossim_uint32 i=first; i<last; ++i)
+      {
+         m_batchBuffers[i] = ossimImageDataFactory::instance()->create(0, OSSIM_UINT8, 1,
+               m_aoiViewRect.width(), m_aoiViewRect.height());
+         m_batchBuffers[i]->initialize();
+         m_batchBuffers[i]->setImageRectangle(m_aoiViewRect);
+         m_batchBuffers[i]->fill(nullPix);
+      }
+      if (m_numThreads > 1)
+      {
+         m_jobMtQueue = new ossimJobWorkStealingQueue(m_numThreads);
+         for (ossim_uint32 i=first; i<last; ++i)
+            m_jobMtQueue->add(new ObserverProcessorJob(this, i));
+         m_jobMtQueue->waitForCompletion();
+      }
+      else
+      {
+         doObserver(first);
+      }
+      if (needsAborting())
+         break;
+
+      for (ossim_uint32 i=first; status && (i<last); ++i)
+      {
+         m_observerGpt = m_observers[i];
+         m_observerGpt.hgt = m_observerHgts[i];
+         m_observerVpt = m_observerVpts[i];
+         m_outBuffer = m_batchBuffers[i];
+         m_batchBuffers[i] = 0;
+         m_memSource->setImage(m_outBuffer);
+         paintReticle();
+
+         m_productFilename = productFilename.noExtension();
+         m_productFilename += "_" + ossimString::toString(i);
+         if (!productFilename.ext().empty())
+            m_productFilename.setExtension(productFilename.ext());
+         status = ossimChipProcUtil::execute();
+      }
+   }
+   m_productFilename = productFilename;
+   return status && !needsAborting();
+}
+
+void XDrawSectorJob::start()
+{
+   m_vsUtil->doXDrawSector(m_sector);
+}
+
+void HeightRowsJob::start()
+{
+   m_vsUtil->loadHeightRows(m_firstRow, m_numRows);
+}
+
+void ObserverProcessorJob::start()
+{
+   m_vsUtil->doObserver(m_index);
+}
+
 void SectorProcessorJob::start()
 {
    // Loop over all the sector's radials and walk over each one.
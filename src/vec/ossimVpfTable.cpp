@@ -13,9 +13,73 @@
 #include <ossim/vec/ossimVpfTable.h>
 #include <ossim/vec/vpf.h>
 #include <ossim/base/ossimErrorCodes.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimEndian.h>
 #include <cstdlib>
 #include <cstring>
 
+namespace
+{
+   const ossimEndian theEndian;
+
+   template <class T> inline T readValue(const ossim_uint8* data, bool swapFlag)
+   {
+      T value;
+      std::memcpy(&value, data, sizeof(T));
+      if ( swapFlag )
+      {
+         theEndian.swap(value);
+      }
+      return value;
+   }
+
+   /** @return Size of a part of an id triplet of type t, see TYPE0. */
+   inline ossim_int32 keyPartSize(int t)
+   {
+      return (t == 3) ? 4 : t;
+   }
+
+   inline ossim_int32 readKeyPart(const ossim_uint8*& data, int t, bool swapFlag)
+   {
+      ossim_int32 result = 0;
+      switch ( t )
+      {
+         case 1:
+            result = data[0];
+            break;
+         case 2:
+            result = readValue<ossim_uint16>(data, swapFlag);
+            break;
+         case 3:
+            result = readValue<ossim_int32>(data, swapFlag);
+            break;
+      }
+      data += keyPartSize(t);
+      return result;
+   }
+
+   /** @return Size of an element of the VPF type, 0 for keys, -1 if unknown. */
+   inline ossim_int32 elementSize(char type)
+   {
+      switch ( type )
+      {
+         case 'T': return 1;
+         case 'S': return 2;
+         case 'I': return 4;
+         case 'F': return 4;
+         case 'R': return 8;
+         case 'D': return 20;
+         case 'C': return 8;
+         case 'Z': return 12;
+         case 'B': return 16;
+         case 'Y': return 24;
+         case 'K': return 0;
+         case 'X': return 0;
+      }
+      return -1;
+   }
+}
+
 std::ostream& operator <<(std::ostream& out,
                      const ossimVpfTable& data)
 {
@@ -24,7 +88,12 @@ std::ostream& operator <<(std::ostream& out,
 }
 
 ossimVpfTable::ossimVpfTable()
-   :theTableInformation(NULL)
+   :theTableInformation(NULL),
+    theTableName(),
+    theMappedFile(0),
+    theRowOffsets(),
+    theMapAttemptedFlag(false),
+    theSwapFlag(false)
 {
 }
 
@@ -75,6 +144,9 @@ void ossimVpfTable::closeTable()
    {
       vpf_close_table(theTableInformation);
    }
+   theMappedFile = 0;
+   theRowOffsets.clear();
+   theMapAttemptedFlag = false;
 }
 
 int ossimVpfTable::getNumberOfRows()const
@@ -144,25 +216,7 @@ std::vector<ossimString> ossimVpfTable::getColumnValues(const ossimString& colum
       theTableInformation->status == OPENED)
    {
       long int columnNumber = table_pos(const_cast<char*>(columnName.c_str()), *theTableInformation);
-
-      if(columnNumber >=0 &&
-         (columnNumber < theTableInformation->nfields))
-      {
-         row_type row;
-         // start at the first row of the table
-         reset();
-         for (int rowIndex = 1;
-              rowIndex <= theTableInformation->nrows;
-              ++rowIndex)
-         {
-            row = read_next_row(*theTableInformation);
-            ossimString value = getColumnValueAsString(row,
-                                                       columnNumber);
-      value.trim();
-            result.push_back(value);
-            free_row(row, *theTableInformation);
-         }
-      }
+      result = getColumnValues(columnNumber);
    }
 
    return result;
@@ -178,6 +232,20 @@ std::vector<ossimString> ossimVpfTable::getColumnValues(long columnNumber)const
       if(columnNumber >=0 &&
          (columnNumber < theTableInformation->nfields))
       {
+         // Integer columns, e.g. keys, straight from the mapped table:
+         const char TYPE = theTableInformation->header[columnNumber].type;
+         std::vector<ossim_int32> values;
+         if( ((TYPE == 'I') || (TYPE == 'S')) &&
+             getColumnValues(columnNumber, values) )
+         {
+            result.resize(values.size());
+            for(ossim_uint32 idx = 0; idx < values.size(); ++idx)
+            {
+               result[idx] = ossimString::toString(values[idx]);
+            }
+            return result;
+         }
+
          row_type row;
          // start at the first row of the table
          reset();
@@ -432,6 +500,311 @@ ossim_int32 ossimVpfTable::getColumnPosition(const ossimString& columnName)const
    return ((ossim_int32)table_pos(const_cast<char*>(columnName.c_str()), *theTableInformation));
 }
 
+bool ossimVpfTable::getColumnValues(long columnNumber,
+                                    std::vector<ossim_int32>& values)const
+{
+   values.clear();
+   if ( !mapTable() || (columnNumber < 0) ||
+        (columnNumber >= theTableInformation->nfields) )
+   {
+      return false;
+   }
+   const char TYPE = theTableInformation->header[columnNumber].type;
+   if ( (TYPE != 'I') && (TYPE != 'S') && (TYPE != 'K') )
+   {
+      return false;
+   }
+
+   values.resize(theTableInformation->nrows, 0);
+   for (ossim_int32 row = 1; row <= theTableInformation->nrows; ++row)
+   {
+      getColumnValue(row, columnNumber, values[row - 1]);
+   }
+   return true;
+}
+
+bool ossimVpfTable::getColumnValues(long columnNumber,
+                                    std::vector<ossim_float64>& values)const
+{
+   values.clear();
+   if ( !mapTable() || (columnNumber < 0) ||
+        (columnNumber >= theTableInformation->nfields) )
+   {
+      return false;
+   }
+   const char TYPE = theTableInformation->header[columnNumber].type;
+   if ( (TYPE != 'I') && (TYPE != 'S') && (TYPE != 'F') && (TYPE != 'R') )
+   {
+      return false;
+   }
+
+   values.resize(theTableInformation->nrows, ossim::nan());
+   for (ossim_int32 row = 1; row <= theTableInformation->nrows; ++row)
+   {
+      ossim_int32 count = 0;
+      const ossim_uint8* data = getFieldData(row, columnNumber, count);
+      if ( data && (count > 0) )
+      {
+         ossim_float64& value = values[row - 1];
+         switch ( TYPE )
+         {
+            case 'I':
+               value = readValue<ossim_int32>(data, theSwapFlag);
+               break;
+            case 'S':
+               value = readValue<ossim_int16>(data, theSwapFlag);
+               break;
+            case 'F':
+            {
+               const ossim_float32 F = readValue<ossim_float32>(data, theSwapFlag);
+               if ( !is_vpf_null_float(F) )
+               {
+                  value = F;
+               }
+               break;
+            }
+            case 'R':
+            {
+               const ossim_float64 D = readValue<ossim_float64>(data, theSwapFlag);
+               if ( !is_vpf_null_double(D) )
+               {
+                  value = D;
+               }
+               break;
+            }
+         }
+      }
+   }
+   return true;
+}
+
+bool ossimVpfTable::getColumnValue(ossim_int32 rowNumber,
+                                   long columnNumber,
+                                   ossim_int32& value)const
+{
+   ossim_int32 count = 0;
+   const ossim_uint8* data = getFieldData(rowNumber, columnNumber, count);
+   if ( !data || (count < 1) )
+   {
+      return false;
+   }
+   switch ( theTableInformation->header[columnNumber].type )
+   {
+      case 'I':
+         value = readValue<ossim_int32>(data, theSwapFlag);
+         return true;
+      case 'S':
+         value = readValue<ossim_int16>(data, theSwapFlag);
+         return true;
+      case 'K':
+      {
+         const int KEY_TYPE = *data++;
+         value = readKeyPart(data, TYPE0(KEY_TYPE), theSwapFlag);
+         return true;
+      }
+   }
+   return false;
+}
+
+bool ossimVpfTable::getCoordinates(long columnNumber,
+                                   std::vector<ossimDpt>& points,
+                                   std::vector<ossim_uint32>& rowStarts)const
+{
+   points.clear();
+   rowStarts.clear();
+   if ( !mapTable() )
+   {
+      return false;
+   }
+   rowStarts.reserve(theTableInformation->nrows + 1);
+   rowStarts.push_back(0);
+   std::vector<ossimDpt> rowPoints;
+   for (ossim_int32 row = 1; row <= theTableInformation->nrows; ++row)
+   {
+      if ( !getCoordinates(row, columnNumber, rowPoints) )
+      {
+         points.clear();
+         rowStarts.clear();
+         return false;
+      }
+      points.insert(points.end(), rowPoints.begin(), rowPoints.end());
+      rowStarts.push_back((ossim_uint32)points.size());
+   }
+   return true;
+}
+
+bool ossimVpfTable::getCoordinates(ossim_int32 rowNumber,
+                                   long columnNumber,
+                                   std::vector<ossimDpt>& points)const
+{
+   points.clear();
+   ossim_int32 count = 0;
+   const ossim_uint8* data = getFieldData(rowNumber, columnNumber, count);
+   if ( !data )
+   {
+      return false;
+   }
+   const char TYPE = theTableInformation->header[columnNumber].type;
+   const ossim_int32 SIZE = elementSize(TYPE);
+   const bool DOUBLE_FLAG = (TYPE == 'B') || (TYPE == 'Y');
+   if ( (TYPE != 'C') && (TYPE != 'Z') && !DOUBLE_FLAG )
+   {
+      return false;
+   }
+
+   points.resize(count);
+   for (ossim_int32 i = 0; i < count; ++i, data += SIZE)
+   {
+      if ( DOUBLE_FLAG )
+      {
+         points[i].x = readValue<ossim_float64>(data, theSwapFlag);
+         points[i].y = readValue<ossim_float64>(data + 8, theSwapFlag);
+      }
+      else
+      {
+         points[i].x = readValue<ossim_float32>(data, theSwapFlag);
+         points[i].y = readValue<ossim_float32>(data + 4, theSwapFlag);
+      }
+   }
+   return true;
+}
+
+bool ossimVpfTable::mapTable()const
+{
+   if ( theMapAttemptedFlag )
+   {
+      return theMappedFile.valid();
+   }
+   theMapAttemptedFlag = true;
+   if ( !theTableInformation || (theTableInformation->status != OPENED) ||
+        (theTableInformation->mode != Read) )
+   {
+      return false;
+   }
+
+   ossimRefPtr<ossimMemoryMappedFile> file = new ossimMemoryMappedFile();
+   if ( !file->open(theTableName) )
+   {
+      return false;
+   }
+   theMappedFile = file;
+   theSwapFlag = (theTableInformation->byte_order != MACHINE_BYTE_ORDER);
+
+   //---
+   // Rows follow the header back to back.  Fixed length rows are a
+   // multiple of reclen in; variable length ones are walked once, field by
+   // field, rather than looked up in the index file row by row.
+   //---
+   const ossim_int32  ROWS  = theTableInformation->nrows;
+   const ossim_uint8* START = file->data();
+   const ossim_uint8* END   = START + file->size();
+   ossim_uint64 pos = (ossim_uint64)theTableInformation->ddlen;
+   bool valid = (pos <= file->size());
+   theRowOffsets.resize(ROWS + 1);
+   for (ossim_int32 row = 0; valid && (row < ROWS); ++row)
+   {
+      theRowOffsets[row] = pos;
+      if ( theTableInformation->reclen > 0 )
+      {
+         pos += theTableInformation->reclen;
+      }
+      else
+      {
+         const ossim_uint8* data = START + pos;
+         const ossim_uint8* elements = 0;
+         ossim_int32 count = 0;
+         for (long column = 0; valid && (column < theTableInformation->nfields); ++column)
+         {
+            valid = skipField(data, END, column, elements, count);
+         }
+         pos = (ossim_uint64)(data - START);
+      }
+      valid = valid && (pos <= file->size());
+   }
+   theRowOffsets[ROWS] = pos;
+
+   if ( !valid )
+   {
+      theMappedFile = 0;
+      theRowOffsets.clear();
+   }
+   return theMappedFile.valid();
+}
+
+const ossim_uint8* ossimVpfTable::getFieldData(ossim_int32 rowNumber,
+                                               long columnNumber,
+                                               ossim_int32& count)const
+{
+   if ( !mapTable() || (rowNumber < 1) || (rowNumber > theTableInformation->nrows) ||
+        (columnNumber < 0) || (columnNumber >= theTableInformation->nfields) )
+   {
+      return 0;
+   }
+   const ossim_uint8* data = theMappedFile->data() + theRowOffsets[rowNumber - 1];
+   const ossim_uint8* end  = theMappedFile->data() + theRowOffsets[rowNumber];
+   const ossim_uint8* elements = 0;
+   for (long column = 0; column <= columnNumber; ++column)
+   {
+      if ( !skipField(data, end, column, elements, count) )
+      {
+         return 0;
+      }
+   }
+   return elements;
+}
+
+bool ossimVpfTable::skipField(const ossim_uint8*& data,
+                              const ossim_uint8* end,
+                              long columnNumber,
+                              const ossim_uint8*& elements,
+                              ossim_int32& count)const
+{
+   const header_cell& header = theTableInformation->header[columnNumber];
+   count = header.count;
+   if ( count < 0 )
+   {
+      if ( end - data < 4 )
+      {
+         return false;
+      }
+      count = readValue<ossim_int32>(data, theSwapFlag);
+      data += 4;
+      if ( count < 0 )
+      {
+         return false;
+      }
+   }
+   elements = data;
+
+   const ossim_int32 SIZE = elementSize(header.type);
+   if ( SIZE < 0 )
+   {
+      return false;
+   }
+   if ( header.type == 'K' )
+   {
+      for (ossim_int32 i = 0; i < count; ++i)
+      {
+         if ( data >= end )
+         {
+            return false;
+         }
+         const int KEY_TYPE = *data;
+         data += 1 + keyPartSize(TYPE0(KEY_TYPE)) + keyPartSize(TYPE1(KEY_TYPE)) +
+            keyPartSize(TYPE2(KEY_TYPE));
+      }
+   }
+   else
+   {
+      if ( (ossim_int64)(end - data) < (ossim_int64)count*SIZE )
+      {
+         return false;
+      }
+      data += (ossim_int64)count*SIZE;
+   }
+   return (data <= end);
+}
+
 void ossimVpfTable::print(std::ostream& out)const
 {
    if(theTableInformation &&
@@ -0,0 +1,297 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// DESCRIPTION: Decoded frame cache with read ahead for video frame sources.
+//
+//**************************************************************************************************
+
+#include <ossim/video/ossimVideoFrameCache.h>
+#include <ossim/video/ossimVideoSource.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimIrect.h>
+#include <OpenThreads/ScopedLock>
+#include <OpenThreads/Thread>
+
+//*************************************************************************************************
+//! Background thread decoding the frames ahead of the play position.
+//*************************************************************************************************
+class ossimVideoFrameCacheThread : public OpenThreads::Thread
+{
+public:
+   ossimVideoFrameCacheThread(ossimVideoFrameCache* cache)
+      : OpenThreads::Thread(), m_cache(cache) {}
+
+   virtual void run() { m_cache->runReadAhead(); }
+
+private:
+   ossimVideoFrameCache* m_cache;
+};
+
+//*************************************************************************************************
+// Constructor
+//*************************************************************************************************
+ossimVideoFrameCache::ossimVideoFrameCache(ossimVideoImageSource* frameSource,
+                                           ossim_uint32 capacity,
+                                           ossim_uint32 framesAhead)
+   : m_frameSource(frameSource),
+     m_capacity(capacity ? capacity : 1),
+     m_framesAhead(0),
+     m_decoderMutex(),
+     m_mutex(),
+     m_workReady(),
+     m_frameReady(),
+     m_frames(),
+     m_inProgress(),
+     m_position(0),
+     m_direction(1),
+     m_stopFlag(false),
+     m_thread(0)
+{
+   m_framesAhead = ossim::min(framesAhead, m_capacity);
+}
+
+//*************************************************************************************************
+// Destructor stops the read ahead.
+//*************************************************************************************************
+ossimVideoFrameCache::~ossimVideoFrameCache()
+{
+   stopThread();
+}
+
+//*************************************************************************************************
+// Returns frame frameNumber, decoding it if not cached.
+//*************************************************************************************************
+ossimRefPtr<ossimImageData> ossimVideoFrameCache::getFrame(ossim_uint32 frameNumber)
+{
+   return fetch(frameNumber).m_tile;
+}
+
+//*************************************************************************************************
+// Returns the image geometry of frame frameNumber.
+//*************************************************************************************************
+ossimRefPtr<ossimImageGeometry> ossimVideoFrameCache::getFrameGeometry(ossim_uint32 frameNumber)
+{
+   return fetch(frameNumber).m_geometry;
+}
+
+//*************************************************************************************************
+// Changes the read ahead depth.
+//*************************************************************************************************
+void ossimVideoFrameCache::setFramesAhead(ossim_uint32 framesAhead)
+{
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_mutex);
+      m_framesAhead = ossim::min(framesAhead, m_capacity);
+      m_workReady.broadcast();
+   }
+   if (!framesAhead)
+      stopThread();
+}
+
+ossim_uint32 ossimVideoFrameCache::getFramesAhead() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_mutex);
+   return m_framesAhead;
+}
+
+//*************************************************************************************************
+// Drops all decoded frames. Frames being decoded are kept when done.
+//*************************************************************************************************
+void ossimVideoFrameCache::clear()
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_mutex);
+   m_frames.clear();
+   m_workReady.broadcast();
+}
+
+ossim_uint32 ossimVideoFrameCache::getNumberOfCachedFrames() const
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_mutex);
+   return (ossim_uint32) m_frames.size();
+}
+
+//*************************************************************************************************
+// Looks the frame up, waits for it if being read ahead, or decodes it here.
+//*************************************************************************************************
+ossimVideoFrameCache::Frame ossimVideoFrameCache::fetch(ossim_uint32 frameNumber)
+{
+   Frame frame;
+   m_mutex.lock();
+   if (m_framesAhead && !m_thread)
+      startThread();
+
+   // Play position and direction, for the read ahead:
+   if (frameNumber != m_position)
+   {
+      m_direction = (frameNumber < m_position) ? -1 : 1;
+      m_position = frameNumber;
+      trim();
+      m_workReady.broadcast();
+   }
+
+   while (true)
+   {
+      std::map<ossim_uint32, Frame>::const_iterator i = m_frames.find(frameNumber);
+      if (i != m_frames.end())
+      {
+         frame = i->second;
+         break;
+      }
+      if (m_inProgress.find(frameNumber) != m_inProgress.end())
+      {
+         m_frameReady.wait(&m_mutex);
+         continue;
+      }
+
+      // Not read ahead (first request, or a jump): decode it here.
+      m_inProgress.insert(frameNumber);
+      m_mutex.unlock();
+      decode(frameNumber, frame);
+      m_mutex.lock();
+      m_inProgress.erase(frameNumber);
+      m_frames[frameNumber] = frame; // Also failures, so they are not retried.
+      trim();
+      m_frameReady.broadcast();
+      break;
+   }
+   m_mutex.unlock();
+   return frame;
+}
+
+//*************************************************************************************************
+// Decodes frameNumber through the frame source.
+//*************************************************************************************************
+bool ossimVideoFrameCache::decode(ossim_uint32 frameNumber, Frame& frame)
+{
+   OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_decoderMutex);
+   if (!m_frameSource.valid())
+      return false;
+
+   ossimVideoSource* video = dynamic_cast<ossimVideoSource*>(m_frameSource->getInput());
+   if (!video)
+      return false;
+
+   const double frameTime = video->computeFrameTime(frameNumber);
+   if (ossim::isnan(frameTime) || !m_frameSource->setFrameTime(frameTime))
+      return false;
+
+   const ossim_uint32 width  = m_frameSource->getNumberOfSamples();
+   const ossim_uint32 height = m_frameSource->getNumberOfLines();
+   if (!width || !height)
+      return false;
+
+   // The source reuses its tile for the next frame:
+   ossimRefPtr<ossimImageData> tile =
+      m_frameSource->getTile(ossimIrect(0, 0, width - 1, height - 1));
+   if (!tile.valid())
+      return false;
+
+   frame.m_tile = static_cast<ossimImageData*>(tile->dup());
+   frame.m_geometry = m_frameSource->getImageGeometry();
+   return true;
+}
+
+//*************************************************************************************************
+// Next frame ahead of the play position neither decoded nor being decoded.
+//*************************************************************************************************
+bool ossimVideoFrameCache::nextFrameToRead(ossim_uint32& frameNumber) const
+{
+   const ossim_int64 numFrames = getNumberOfFrames();
+   for (ossim_uint32 k = 1; k <= m_framesAhead; ++k)
+   {
+      const ossim_int64 candidate = (ossim_int64) m_position + m_direction * (ossim_int64) k;
+      if ((candidate < 0) || (candidate >= numFrames))
+         break;
+      frameNumber = (ossim_uint32) candidate;
+      if ((m_frames.find(frameNumber) == m_frames.end()) &&
+          (m_inProgress.find(frameNumber) == m_inProgress.end()))
+         return true;
+   }
+   return false;
+}
+
+//*************************************************************************************************
+// Drops the frames farthest from the play position past the capacity.
+//*************************************************************************************************
+void ossimVideoFrameCache::trim()
+{
+   while (m_frames.size() > m_capacity)
+   {
+      // The map is ordered, so the farthest frame is the first or the last:
+      std::map<ossim_uint32, Frame>::iterator first = m_frames.begin();
+      std::map<ossim_uint32, Frame>::iterator last = --m_frames.end();
+      const ossim_int64 behind = (ossim_int64) m_position - (ossim_int64) first->first;
+      const ossim_int64 ahead  = (ossim_int64) last->first - (ossim_int64) m_position;
+
+      // On a tie drop the frame behind the play direction:
+      if ((behind > ahead) || ((behind == ahead) && (m_direction > 0)))
+         m_frames.erase(first);
+      else
+         m_frames.erase(last);
+   }
+}
+
+ossim_uint32 ossimVideoFrameCache::getNumberOfFrames() const
+{
+   if (!m_frameSource.valid())
+      return 0;
+   const ossimVideoSource* video = dynamic_cast<const ossimVideoSource*>(m_frameSource->getInput());
+   return video ? video->getNumberOfFrames() : 0;
+}
+
+//*************************************************************************************************
+// Loop of the background thread: decodes the frames ahead of the play position.
+//*************************************************************************************************
+void ossimVideoFrameCache::runReadAhead()
+{
+   m_mutex.lock();
+   while (!m_stopFlag)
+   {
+      ossim_uint32 frameNumber = 0;
+      if (!nextFrameToRead(frameNumber))
+      {
+         m_workReady.wait(&m_mutex);
+         continue;
+      }
+
+      m_inProgress.insert(frameNumber);
+      m_mutex.unlock();
+      Frame frame;
+      decode(frameNumber, frame);
+      m_mutex.lock();
+      m_inProgress.erase(frameNumber);
+      m_frames[frameNumber] = frame;
+      trim();
+      m_frameReady.broadcast();
+   }
+   m_mutex.unlock();
+}
+
+//*************************************************************************************************
+// Called with m_mutex locked.
+//*************************************************************************************************
+void ossimVideoFrameCache::startThread()
+{
+   m_stopFlag = false;
+   m_thread = new ossimVideoFrameCacheThread(this);
+   m_thread->start();
+}
+
+void ossimVideoFrameCache::stopThread()
+{
+   ossimVideoFrameCacheThread* thread = 0;
+   {
+      OpenThreads::ScopedLock<OpenThreads::Mutex> lock (m_mutex);
+      thread = m_thread;
+      m_thread = 0;
+      m_stopFlag = true;
+      m_workReady.broadcast();
+   }
+   if (thread)
+   {
+      thread->join();
+      delete thread;
+   }
+}
@@ -912,7 +912,8 @@ vpf_table_type vpf_open_table( const char * tablename,
 #ifdef __MSDOS__
 	if ( (idxsize < (farcoreleft()/2)) && (idxsize < __64K) )
 #else
-	if (0)
+	/* Keep the index in memory: a row lookup costs no seek and read. */
+	if (1)
 #endif
 	  {
 	    table.xstorage = (storage_type)RAM;
@@ -35,6 +35,8 @@
 #include <iostream>
 #include <ostream>
 #include <istream>
+#include <sstream>
+#include <string>
 using namespace std;
 
 
@@ -83,6 +85,32 @@ int main(int argc, char *argv[])
             std::iostream inout2(&buf2);
             std::cout << "Test read after copy constructor? " << ((inout.get() == inout2.get())?"Passed":"Failed") << std::endl;
         }
+        {
+            // segmented buffer, segments smaller than the writes
+            ossimByteStreamBuffer buf;
+            buf.setSegmentSize(7);
+            std::iostream inout(&buf);
+            std::string expected;
+            for(int i = 0; i < 100; ++i)
+            {
+                std::ostringstream line;
+                line << "line " << i << "\n";
+                inout << line.str();
+                expected += line.str();
+            }
+            std::cout << "Segmented size? " << ((buf.bufferSize() == expected.size())?"Passed":"Failed") << std::endl;
+            std::cout << "Segmented tellp? " << (((ossim_uint64)inout.tellp() == expected.size())?"Passed":"Failed") << std::endl;
+            inout.seekg(500);
+            std::string word;
+            std::getline(inout, word);
+            std::cout << "Segmented seekg and read across segments? " << ((word == expected.substr(500, expected.find('\n', 500) - 500))?"Passed":"Failed") << std::endl;
+            std::ostringstream out;
+            buf.writeSegments(out);
+            std::cout << "Write segments? " << ((out.str() == expected)?"Passed":"Failed") << std::endl;
+            ossimByteStreamBuffer buf2(buf);
+            std::cout << "Segmented copy? " << ((std::string(buf2.buffer(), buf2.bufferSize()) == expected)?"Passed":"Failed") << std::endl;
+            std::cout << "Gathered into one buffer? " << (((buf2.getSegmentSize() == 0) && (buf2.getNumberOfSegments() == 1))?"Passed":"Failed") << std::endl;
+        }
     }
     catch (const ossimException& e)
     {
@@ -0,0 +1,123 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Reads a url through ossimHttpRangeIFStream, served by an in process http request
+// answering range requests from memory, and compares random seeks and reads with the data.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimHttpRangeStream.h>
+#include <ossim/base/ossimHttpRequest.h>
+#include <ossim/base/ossimHttpResponse.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimStreamFactoryRegistry.h>
+#include <ossim/base/ossimWebRequestFactoryRegistry.h>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+static const ossim_uint64 SIZE = 1000003;
+static vector<char> theData;
+static OpenThreads::Mutex theCountMutex;
+static ossim_uint32 theRequestCount = 0;
+
+class ossimTestHttpRequest : public ossimHttpRequest
+{
+public:
+   virtual ossimWebResponse* getResponse()
+   {
+      {
+         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(theCountMutex);
+         ++theRequestCount;
+      }
+
+      // Range: bytes=<first>-<last>
+      ossimString range = getHeaderOptions().find("Range");
+      ossim_uint64 first = ossimString(range.after("=").before("-")).toUInt64();
+      ossim_uint64 last  = std::min(ossimString(range.after("-")).toUInt64(), SIZE - 1);
+
+      ossimHttpResponse* response = new ossimHttpResponse();
+      response->headerStream() << "HTTP/1.1 206 Partial Content\n"
+                               << "Content-Range: bytes " << first << "-" << last << "/"
+                               << SIZE << "\n";
+      response->bodyStream().write(&theData[first], last - first + 1);
+      return response;
+   }
+};
+
+class ossimTestWebRequestFactory : public ossimWebRequestFactoryBase
+{
+public:
+   virtual ossimWebRequest* create(const ossimUrl& url)
+   {
+      return (url.getProtocol() == "http") ? new ossimTestHttpRequest() : 0;
+   }
+};
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+   ossimPreferences::instance()->addPreference("http_range_stream.block_size", "4096");
+   ossimPreferences::instance()->addPreference("http_range_stream.cache_blocks", "64");
+   // In front of the built in http:// transport:
+   ossimWebRequestFactoryRegistry::instance()->registerFactory(new ossimTestWebRequestFactory(),
+                                                               true);
+
+   theData.resize(SIZE);
+   for (ossim_uint64 i = 0; i < SIZE; ++i)
+   {
+      theData[i] = static_cast<char>((i * 7) ^ (i >> 11));
+   }
+
+   ossimRefPtr<ossimIFStream> str = ossimStreamFactoryRegistry::instance()->
+      createNewIFStream(ossimFilename("http://localhost/test.bin"), ios::in | ios::binary);
+   if ( !dynamic_cast<ossimHttpRangeIFStream*>(str.get()) )
+   {
+      cout << "no range stream FAILED" << endl;
+      return 1;
+   }
+
+   str->seekg(0, ios::end);
+   bool status = (static_cast<ossim_uint64>(str->tellg()) == SIZE);
+
+   srand(1);
+   ossim_uint32 mismatches = 0;
+   vector<char> buf;
+   for (int i = 0; i < 500; ++i)
+   {
+      // Mostly small reads that stay in a block, some spanning many.
+      const ossim_uint64 OFFSET = static_cast<ossim_uint64>(rand()) % SIZE;
+      const ossim_uint64 COUNT  = (i % 5 == 0) ? (rand() % 100000) : (rand() % 100);
+      buf.assign(COUNT, 0);
+      str->clear();
+      str->seekg(OFFSET);
+      str->read(&buf.front(), COUNT);
+      const ossim_uint64 EXPECTED = std::min(COUNT, SIZE - OFFSET);
+      mismatches += (static_cast<ossim_uint64>(str->gcount()) != EXPECTED) ||
+         (EXPECTED && memcmp(&buf.front(), &theData[OFFSET], EXPECTED));
+
+      // Byte at a time from the same place.
+      str->clear();
+      str->seekg(OFFSET);
+      for (int j = 0; (j < 10) && (OFFSET + j < SIZE); ++j)
+      {
+         mismatches += (str->get() != static_cast<unsigned char>(theData[OFFSET + j]));
+      }
+   }
+   status &= (mismatches == 0);
+
+   cout << "reads: 500 mismatches: " << mismatches << " requests: " << theRequestCount
+        << (status ? " PASSED" : " FAILED") << endl;
+   return status ? 0 : 1;
+}
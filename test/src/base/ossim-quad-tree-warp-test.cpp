@@ -0,0 +1,124 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Compares the indexed ossimQuadTreeWarp::getShift() and forwardPoints() with a
+// shift computed from findNode(), on a tree split at random points, then again after a prune.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimDrect.h>
+#include <ossim/base/ossimQuadTreeWarp.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+static const ossim_uint32 COUNT = 20000;
+
+static double uniform(double lo, double hi)
+{
+   return lo + (hi - lo) * rand() / RAND_MAX;
+}
+
+// Shift of the node findNode() returns, as ossimQuadTreeWarp computed it before the index.
+static ossimDpt nodeShift(const ossimQuadTreeWarp* warp, const ossimDpt& pt)
+{
+   const ossimQuadTreeWarpNode* node = warp->findNode(pt);
+   if (!node || !node->isLeaf() || !node->hasValidVertices())
+   {
+      return ossimDpt(0.0, 0.0);
+   }
+   ossimDpt ul = node->theBoundingRect.ul();
+   ossimDpt ur = node->theBoundingRect.ur();
+   ossimDpt ll = node->theBoundingRect.ll();
+   double hp = fabs(pt.x - ul.x) / (ur.x - ul.x);
+   double vp = fabs(pt.y - ul.y) / (ll.y - ul.y);
+   const ossimDpt& ulShift = node->theUlVertex->getDelta();
+   const ossimDpt& urShift = node->theUrVertex->getDelta();
+   const ossimDpt& lrShift = node->theLrVertex->getDelta();
+   const ossimDpt& llShift = node->theLlVertex->getDelta();
+   ossimDpt upper = ulShift + (urShift - ulShift) * hp;
+   ossimDpt lower = llShift + (lrShift - llShift) * hp;
+   return upper + (lower - upper) * vp;
+}
+
+static bool check(const char* name, const ossimQuadTreeWarp* warp, const ossimDrect& rect)
+{
+   vector<ossimDpt> pts(COUNT);
+   for (ossim_uint32 i = 0; i < COUNT; ++i)
+   {
+      if (i % 4 == 0)
+      {
+         // Whole pixels, so on shared edges and corners of the leaves.
+         pts[i] = ossimDpt(floor(uniform(rect.ul().x - 10.0, rect.lr().x + 10.0)),
+                           floor(uniform(rect.ul().y - 10.0, rect.lr().y + 10.0)));
+      }
+      else
+      {
+         pts[i] = ossimDpt(uniform(rect.ul().x, rect.lr().x), uniform(rect.ul().y, rect.lr().y));
+      }
+   }
+   pts[5].makeNan();
+
+   vector<ossimDpt> batch(COUNT);
+   warp->forwardPoints(&pts.front(), &batch.front(), COUNT);
+
+   ossim_uint32 mismatches = 0;
+   for (ossim_uint32 i = 0; i < COUNT; ++i)
+   {
+      ossimDpt expected = pts[i] + nodeShift(warp, pts[i]);
+      ossimDpt shift = warp->getShift(pts[i]);
+      if (pts[i].hasNans())
+      {
+         mismatches += !batch[i].hasNans();
+         continue;
+      }
+      mismatches += (shift != nodeShift(warp, pts[i])) || (batch[i] != expected);
+   }
+
+   cout << name << " points: " << COUNT << " mismatches: " << mismatches
+        << (mismatches ? " FAILED" : " PASSED") << endl;
+   return mismatches == 0;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   srand(1);
+   ossimDrect rect(0.0, 0.0, 4095.0, 2047.0);
+   ossimRefPtr<ossimQuadTreeWarp> warp = new ossimQuadTreeWarp(rect);
+   for (int i = 0; i < 300; ++i)
+   {
+      warp->split(ossimDpt(uniform(1.0, 4094.0), uniform(1.0, 2046.0)));
+   }
+   const vector<ossimQuadTreeWarpVertex*>& vertices = warp->getVertices();
+   for (ossim_uint32 i = 0; i < vertices.size(); ++i)
+   {
+      vertices[i]->setDelta(ossimDpt(uniform(-5.0, 5.0), uniform(-5.0, 5.0)));
+   }
+
+   bool status = check("split", warp.get(), rect);
+
+   // Deltas are read live, so changing them needs no rebuild.
+   warp->setToIdentity();
+   vertices[0]->setDelta(ossimDpt(1.5, -2.5));
+   status &= check("identity", warp.get(), rect);
+
+   ossimQuadTreeWarpNode* node = warp->findNode(ossimDpt(1000.0, 500.0));
+   if (node && node->theParent)
+   {
+      warp->pruneTree(node->theParent);
+   }
+   status &= check("pruned", warp.get(), rect);
+
+   return status ? 0 : 1;
+}
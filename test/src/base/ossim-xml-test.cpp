@@ -22,9 +22,10 @@ int main(int argc, char *argv[])
 {
    ossimInit::instance()->initialize(argc, argv);
 
-   if (argc != 2)
+   if (argc < 2)
    {
-      cout << "usage: " << argv[0] << " <xml_file>" << endl;
+      cout << "usage: " << argv[0] << " <xml_file> [<xpath>...]\n"
+           << "With xpaths, loads only those nodes and prints them." << endl;
       return 0;
    }
    
@@ -32,10 +33,27 @@ int main(int argc, char *argv[])
 
    cout << "file: " << f << endl;
 
+   std::vector<ossimString> xpaths;
+   for (int i = 2; i < argc; ++i)
+   {
+      xpaths.push_back( ossimString(argv[i]) );
+   }
+
    ossimXmlDocument* xdoc = new ossimXmlDocument();
-   if ( xdoc->openFile(f) )
+   bool opened = xpaths.empty() ? xdoc->openFile(f) : xdoc->openFile(f, xpaths);
+   if ( opened )
    {
       cout << "opened..." << endl;
+      for (size_t i = 0; i < xpaths.size(); ++i)
+      {
+         std::vector<ossimRefPtr<ossimXmlNode> > xnodes;
+         xdoc->findNodes(xpaths[i], xnodes);
+         cout << xpaths[i] << ": " << xnodes.size() << " node(s)" << endl;
+         for (size_t n = 0; n < xnodes.size(); ++n)
+         {
+            cout << xnodes[n].get() << endl;
+         }
+      }
    }
    else
    {
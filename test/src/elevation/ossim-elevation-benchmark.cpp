@@ -0,0 +1,445 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Repeatable ossimElevManager throughput benchmark.  Runs random, scanline and
+// radial query patterns over a bounding box at several thread counts and writes queries per
+// second, latency percentiles and cell cache hit rates as a keyword list.
+//
+// The elevation setup is whatever the preferences file given with -P loads, so one
+// preferences file per database type (DTED, SRTM, general raster, image) gives comparable runs.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/base/ossimArgumentParser.h>
+#include <ossim/base/ossimApplicationUsage.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/elevation/ossimElevManager.h>
+#include <ossim/elevation/ossimElevationDatabase.h>
+#include <ossim/init/ossimInit.h>
+#include <OpenThreads/Barrier>
+#include <OpenThreads/Thread>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+static OpenThreads::Barrier* startBarrier = 0;
+static OpenThreads::Barrier* endBarrier = 0;
+
+// Small LCG so every run with the same seed queries the same points on every platform.
+static double nextRandom(ossim_uint64& state)
+{
+   state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+   return (double)(state >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Points for one thread.  Scanline and radial give each thread its own rows or rays, the way
+// a tiled or sensor model job would split work.
+static void makePoints(const ossimString& pattern,
+                       ossim_uint32 thread,
+                       ossim_uint32 threads,
+                       ossim_uint32 count,
+                       ossim_uint32 seed,
+                       double minLat, double minLon, double maxLat, double maxLon,
+                       std::vector<ossimGpt>& points)
+{
+   points.resize(count);
+   const double dLat = maxLat - minLat;
+   const double dLon = maxLon - minLon;
+
+   if (pattern == "scanline")
+   {
+      // Roughly square grid of count * threads posts; this thread takes every threads'th row.
+      ossim_uint32 cols = (ossim_uint32)std::sqrt((double)count * threads);
+      if (cols < 1) cols = 1;
+      ossim_uint32 rows = ((ossim_uint64)count * threads + cols - 1) / cols;
+      ossim_uint32 row = thread;
+      ossim_uint32 col = 0;
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         points[i] = ossimGpt(maxLat - dLat * (row % rows + 0.5) / rows,
+                              minLon + dLon * (col + 0.5) / cols);
+         if (++col == cols)
+         {
+            col = 0;
+            row += threads;
+         }
+      }
+   }
+   else if (pattern == "radial")
+   {
+      // Rays out from the centre, as an orthorectification of a look angle fan; rays are dealt
+      // to threads in turn.
+      const ossim_uint32 perRay = 256;
+      const ossim_uint32 rays = ( (ossim_uint64)count * threads + perRay - 1 ) / perRay;
+      const double cLat = minLat + 0.5 * dLat;
+      const double cLon = minLon + 0.5 * dLon;
+      ossim_uint32 ray = thread;
+      ossim_uint32 step = 0;
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         double angle = (2.0 * M_PI * ray) / rays;
+         double r = (step + 0.5) / perRay * 0.5;
+         points[i] = ossimGpt(cLat + r * dLat * std::sin(angle),
+                              cLon + r * dLon * std::cos(angle));
+         if (++step == perRay)
+         {
+            step = 0;
+            ray += threads;
+         }
+      }
+   }
+   else // random
+   {
+      ossim_uint64 state = (ossim_uint64)seed * 0x9E3779B97F4A7C15ULL + thread + 1;
+      for (ossim_uint32 i = 0; i < count; ++i)
+      {
+         double lat = minLat + nextRandom(state) * dLat;
+         double lon = minLon + nextRandom(state) * dLon;
+         points[i] = ossimGpt(lat, lon);
+      }
+   }
+}
+
+class BenchmarkThread : public OpenThreads::Thread
+{
+public:
+   BenchmarkThread(ossimElevationDatabase* database, bool mslFlag, ossim_uint32 batch)
+      : m_database(database),
+        m_mslFlag(mslFlag),
+        m_batch(batch),
+        m_points(),
+        m_latencies(),
+        m_nulls(0),
+        m_seconds(0.0)
+   {
+   }
+
+   virtual void run()
+   {
+      ossimElevManager* mgr = ossimElevManager::instance();
+      ossimTimer* timer = ossimTimer::instance();
+      m_latencies.clear();
+      m_latencies.reserve(m_points.size() / m_batch + 1);
+      m_nulls = 0;
+
+      startBarrier->block();
+      ossimTimer::Timer_t t0 = timer->tick();
+      ossim_uint32 i = 0;
+      while (i < m_points.size())
+      {
+         ossim_uint32 end = std::min((ossim_uint32)m_points.size(), i + m_batch);
+         ossim_uint32 n = end - i;
+         ossimTimer::Timer_t t1 = timer->tick();
+         for (; i < end; ++i)
+         {
+            double h;
+            if (m_database)
+            {
+               h = m_mslFlag ? m_database->getHeightAboveMSL(m_points[i])
+                             : m_database->getHeightAboveEllipsoid(m_points[i]);
+            }
+            else
+            {
+               h = m_mslFlag ? mgr->getHeightAboveMSL(m_points[i])
+                             : mgr->getHeightAboveEllipsoid(m_points[i]);
+            }
+            if (ossim::isnan(h))
+            {
+               ++m_nulls;
+            }
+         }
+         m_latencies.push_back((float)(timer->delta_u(t1, timer->tick()) / n));
+      }
+      m_seconds = timer->delta_s(t0, timer->tick());
+      endBarrier->block();
+   }
+
+   ossimElevationDatabase* m_database; //!< Queried directly if set, else the manager.
+   bool                    m_mslFlag;
+   ossim_uint32            m_batch;
+   std::vector<ossimGpt>   m_points;
+   std::vector<float>      m_latencies; //!< Mean microseconds per query of each batch.
+   ossim_uint64            m_nulls;
+   double                  m_seconds;
+};
+
+static double percentile(const std::vector<float>& sorted, double p)
+{
+   if (sorted.empty())
+   {
+      return 0.0;
+   }
+   size_t idx = (size_t)(p * (sorted.size() - 1) + 0.5);
+   return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+int main(int argc, char* argv[])
+{
+   ossimString tempString;
+   ossimArgumentParser::ossimParameter stringParam(tempString);
+   ossimArgumentParser argumentParser(&argc, argv);
+   ossimInit::instance()->addOptions(argumentParser);
+   ossimInit::instance()->initialize(argumentParser);
+
+   std::vector<ossim_uint32> threadCounts;
+   std::vector<ossimString> patterns;
+   ossim_uint32 queries = 100000;
+   ossim_uint32 batch = 64;
+   ossim_uint32 seed = 0;
+   ossim_int32 databaseIdx = -1;
+   bool mslFlag = false;
+   bool warmFlag = true;
+   ossimFilename outputFile;
+   double minLon = -110.0;
+   double minLat = 30.0;
+   double maxLon = -100.0;
+   double maxLat = 40.0;
+
+   ossimApplicationUsage* au = argumentParser.getApplicationUsage();
+   au->setCommandLineUsage(argumentParser.getApplicationName() + " [options] -P <preferences>");
+   au->setDescription("Measures elevation query throughput, latency and cell cache hit rate of the elevation setup in the preferences file.");
+   au->addCommandLineOption("-h or --help", "Display this information");
+   au->addCommandLineOption("--threads", "<list> Comma separated thread counts to run, default 1,2,4,8");
+   au->addCommandLineOption("--pattern", "<list> Comma separated patterns of random, scanline and radial, default all three");
+   au->addCommandLineOption("--queries", "<int> Queries per thread for each run, default 100000");
+   au->addCommandLineOption("--batch", "<int> Queries timed together for the latency figures, default 64");
+   au->addCommandLineOption("--bbox", "<min-lon,min-lat,max-lon,max-lat> Area queried, default -110,30,-100,40");
+   au->addCommandLineOption("--database", "<int> Query elevation database <int> directly instead of through the manager");
+   au->addCommandLineOption("--msl", "Query height above MSL instead of above the ellipsoid");
+   au->addCommandLineOption("--cold", "Skip the untimed pass that opens the cells before each run");
+   au->addCommandLineOption("--random-seed", "<int> Seed for the random pattern, default 0");
+   au->addCommandLineOption("--output", "<file> Write the report to <file> instead of standard output");
+
+   if (argumentParser.read("-h") || argumentParser.read("--help"))
+   {
+      au->write(ossimNotify(ossimNotifyLevel_INFO));
+      return 0;
+   }
+   if (argumentParser.read("--threads", stringParam))
+   {
+      std::vector<ossimString> splitArray;
+      tempString.split(splitArray, ",");
+      for (ossim_uint32 i = 0; i < splitArray.size(); ++i)
+      {
+         ossim_uint32 n = splitArray[i].toUInt32();
+         if (n) threadCounts.push_back(n);
+      }
+   }
+   if (argumentParser.read("--pattern", stringParam))
+   {
+      std::vector<ossimString> splitArray;
+      tempString.split(splitArray, ",");
+      for (ossim_uint32 i = 0; i < splitArray.size(); ++i)
+      {
+         ossimString p = splitArray[i].trim().downcase();
+         if ( (p == "random") || (p == "scanline") || (p == "radial") )
+         {
+            patterns.push_back(p);
+         }
+         else
+         {
+            ossimNotify(ossimNotifyLevel_WARN) << "Unknown pattern ignored: " << p << std::endl;
+         }
+      }
+   }
+   if (argumentParser.read("--queries", stringParam))
+   {
+      queries = tempString.toUInt32();
+   }
+   if (argumentParser.read("--batch", stringParam))
+   {
+      batch = std::max((ossim_uint32)1, tempString.toUInt32());
+   }
+   if (argumentParser.read("--bbox", stringParam))
+   {
+      std::vector<ossimString> splitArray;
+      tempString.split(splitArray, ",");
+      if (splitArray.size() == 4)
+      {
+         minLon = splitArray[0].toDouble();
+         minLat = splitArray[1].toDouble();
+         maxLon = splitArray[2].toDouble();
+         maxLat = splitArray[3].toDouble();
+      }
+   }
+   if (argumentParser.read("--database", stringParam))
+   {
+      databaseIdx = tempString.toInt32();
+   }
+   if (argumentParser.read("--random-seed", stringParam))
+   {
+      seed = tempString.toUInt32();
+   }
+   if (argumentParser.read("--output", stringParam))
+   {
+      outputFile = tempString;
+   }
+   mslFlag = argumentParser.read("--msl");
+   warmFlag = !argumentParser.read("--cold");
+
+   if (threadCounts.empty())
+   {
+      threadCounts.push_back(1);
+      threadCounts.push_back(2);
+      threadCounts.push_back(4);
+      threadCounts.push_back(8);
+   }
+   if (patterns.empty())
+   {
+      patterns.push_back("random");
+      patterns.push_back("scanline");
+      patterns.push_back("radial");
+   }
+
+   ossimElevManager* mgr = ossimElevManager::instance();
+   ossim_uint32 maxThreads = *std::max_element(threadCounts.begin(), threadCounts.end());
+   mgr->setRoundRobinMaxSize(maxThreads);
+
+   ossim_uint32 numberOfDatabases = mgr->getNumberOfElevationDatabases();
+   if (numberOfDatabases == 0)
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "No elevation databases loaded; check the -P preferences file." << std::endl;
+      return 1;
+   }
+   ossimElevationDatabase* database = 0;
+   if (databaseIdx >= 0)
+   {
+      if ((ossim_uint32)databaseIdx >= numberOfDatabases)
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "--database " << databaseIdx << " out of range, " << numberOfDatabases
+            << " databases loaded." << std::endl;
+         return 1;
+      }
+      database = mgr->getElevationDatabase(databaseIdx);
+   }
+
+   ossimKeywordlist kwl;
+   kwl.add("benchmark.", "queries_per_thread", queries, true);
+   kwl.add("benchmark.", "batch", batch, true);
+   kwl.add("benchmark.", "bbox", (ossimString::toString(minLon) + "," + ossimString::toString(minLat) + "," +
+                                  ossimString::toString(maxLon) + "," + ossimString::toString(maxLat)).c_str(), true);
+   kwl.add("benchmark.", "height", mslFlag ? "msl" : "ellipsoid", true);
+   kwl.add("benchmark.", "target", database ? ("database" + ossimString::toString(databaseIdx)).c_str()
+                                            : "manager", true);
+   for (ossim_uint32 idx = 0; idx < numberOfDatabases; ++idx)
+   {
+      std::string prefix = "benchmark.database" + ossimString::toString(idx).string() + ".";
+      const ossimElevationDatabase* db = mgr->getElevationDatabase(idx);
+      kwl.add(prefix.c_str(), "type", db->getClassName().c_str(), true);
+      kwl.add(prefix.c_str(), "connection_string", db->getConnectionString().c_str(), true);
+   }
+
+   for (ossim_uint32 p = 0; p < patterns.size(); ++p)
+   {
+      for (ossim_uint32 t = 0; t < threadCounts.size(); ++t)
+      {
+         ossim_uint32 threads = threadCounts[t];
+         std::vector< std::vector<ossimGpt> > points(threads);
+         for (ossim_uint32 idx = 0; idx < threads; ++idx)
+         {
+            makePoints(patterns[p], idx, threads, queries, seed,
+                       minLat, minLon, maxLat, maxLon, points[idx]);
+         }
+
+         // Threads are not restartable, so each pass gets its own.
+         std::vector<BenchmarkThread*> threadList(threads, (BenchmarkThread*)0);
+         for (ossim_uint32 pass = warmFlag ? 0 : 1; pass < 2; ++pass)
+         {
+            mgr->resetCacheStatistics();
+            startBarrier = new OpenThreads::Barrier(threads);
+            endBarrier = new OpenThreads::Barrier(threads + 1); // Main thread too.
+            for (ossim_uint32 idx = 0; idx < threads; ++idx)
+            {
+               delete threadList[idx];
+               threadList[idx] = new BenchmarkThread(database, mslFlag, batch);
+               threadList[idx]->m_points.swap(points[idx]);
+               threadList[idx]->start();
+            }
+            endBarrier->block();
+            for (ossim_uint32 idx = 0; idx < threads; ++idx)
+            {
+               threadList[idx]->join();
+               points[idx].swap(threadList[idx]->m_points);
+            }
+            delete startBarrier;
+            delete endBarrier;
+            startBarrier = 0;
+            endBarrier = 0;
+         }
+
+         std::vector<float> latencies;
+         ossim_uint64 nulls = 0;
+         double seconds = 0.0;
+         for (ossim_uint32 idx = 0; idx < threads; ++idx)
+         {
+            latencies.insert(latencies.end(), threadList[idx]->m_latencies.begin(),
+                             threadList[idx]->m_latencies.end());
+            nulls += threadList[idx]->m_nulls;
+            seconds = std::max(seconds, threadList[idx]->m_seconds);
+            delete threadList[idx];
+         }
+         std::sort(latencies.begin(), latencies.end());
+
+         ossim_uint64 total = (ossim_uint64)queries * threads;
+         std::string prefix = "benchmark." + patterns[p].string() + ".threads" +
+            ossimString::toString(threads).string() + ".";
+         kwl.add(prefix.c_str(), "queries", total, true);
+         kwl.add(prefix.c_str(), "seconds", seconds, true);
+         kwl.add(prefix.c_str(), "queries_per_second", (seconds > 0.0) ? (total / seconds) : 0.0, true);
+         kwl.add(prefix.c_str(), "latency_p50_us", percentile(latencies, 0.50), true);
+         kwl.add(prefix.c_str(), "latency_p90_us", percentile(latencies, 0.90), true);
+         kwl.add(prefix.c_str(), "latency_p99_us", percentile(latencies, 0.99), true);
+         kwl.add(prefix.c_str(), "latency_p999_us", percentile(latencies, 0.999), true);
+         kwl.add(prefix.c_str(), "latency_max_us", latencies.empty() ? 0.0 : latencies.back(), true);
+         kwl.add(prefix.c_str(), "null_fraction", total ? ((double)nulls / total) : 0.0, true);
+
+         // Last cell hits never reach a database, so they count as cache hits.
+         ossim_uint64 lastCellHits = database ? 0 : mgr->getLastCellHits();
+         ossim_uint64 allHits = lastCellHits;
+         ossim_uint64 allMisses = 0;
+         kwl.add(prefix.c_str(), "last_cell_hits", lastCellHits, true);
+         for (ossim_uint32 idx = 0; idx < numberOfDatabases; ++idx)
+         {
+            ossim_uint64 hits = 0;
+            ossim_uint64 misses = 0;
+            if (mgr->getCacheStatistics(idx, hits, misses))
+            {
+               std::string dbPrefix = prefix + "database" + ossimString::toString(idx).string() + ".";
+               kwl.add(dbPrefix.c_str(), "cache_hits", hits, true);
+               kwl.add(dbPrefix.c_str(), "cache_misses", misses, true);
+               allHits += hits;
+               allMisses += misses;
+            }
+         }
+         kwl.add(prefix.c_str(), "cache_hit_rate",
+                 (allHits + allMisses) ? ((double)allHits / (allHits + allMisses)) : 0.0, true);
+      }
+   }
+
+   if (outputFile.size())
+   {
+      if (!kwl.write(outputFile.c_str()))
+      {
+         ossimNotify(ossimNotifyLevel_WARN) << "Could not write " << outputFile << std::endl;
+         return 1;
+      }
+   }
+   else
+   {
+      std::cout << kwl << std::endl;
+   }
+   return 0;
+}
@@ -0,0 +1,389 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// File: ossim-image-data-kernels-test.cpp
+//
+// Description: Test app:
+//
+// Runs the ossimImageData pixel kernels (normalize, unnormalize, bip/band
+// interleave conversions, null counting, min/max scans, histogram counting, weighted
+// accumulation) at every SIMD level the cpu supports and checks the output is bit for bit
+// identical to the scalar code.
+//
+// Returns 0 on success and outputs PASSED, 1 on failure and outputs FAILED.
+//
+// $Id$
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimArgumentParser.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimSimd.h>
+#include <ossim/imaging/ossimImageDataKernels.h>
+#include <ossim/init/ossimInit.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+static const ossim::SimdLevel LEVELS[] =
+{ ossim::SIMD_SSE2, ossim::SIMD_SSSE3, ossim::SIMD_AVX2 };
+
+template <class S, class D>
+static int testNormalize(const char* name, double minPix, double maxPix, double nullPix)
+{
+   int errors = 0;
+   const ossim_uint32 N = 1031; // Odd size to exercise the scalar tails.
+   vector<S> s(N);
+   for (ossim_uint32 i = 0; i < N; ++i)
+   {
+      s[i] = (S)( minPix + (rand() % 1000) * (maxPix - minPix) / 1000.0 );
+      if ( i % 7 == 0 ) s[i] = (S)nullPix;
+      if ( i % 11 == 0 ) s[i] = (S)minPix;
+   }
+   vector<D> expected(N);
+   vector<D> result(N);
+
+   ossim::setSimdLevel(ossim::SIMD_SCALAR);
+   ossim::normalize(&s[0], &expected[0], N, minPix, maxPix, nullPix);
+
+   for (ossim_uint32 level = 0; level < 3; ++level)
+   {
+      ossim::setSimdLevel(LEVELS[level]);
+      ossim::normalize(&s[0], &result[0], N, minPix, maxPix, nullPix);
+      if ( memcmp(&expected[0], &result[0], N*sizeof(D)) != 0 )
+      {
+         cerr << name << " normalize mismatch at "
+              << ossim::simdLevelString(ossim::getSimdLevel()) << endl;
+         ++errors;
+      }
+   }
+   return errors;
+}
+
+template <class S, class D>
+static int testUnnormalize(const char* name, double minPix, double maxPix, double nullPix,
+                           bool clampFlag)
+{
+   int errors = 0;
+   const ossim_uint32 N = 1031;
+   vector<S> s(N);
+   for (ossim_uint32 i = 0; i < N; ++i)
+   {
+      s[i] = ( i % 5 == 0 ) ? (S)0 : (S)( (rand() % 1001) / 1000.0 );
+   }
+   vector<D> expected(N);
+   vector<D> result(N);
+
+   ossim::setSimdLevel(ossim::SIMD_SCALAR);
+   ossim::unnormalize(&s[0], &expected[0], N, minPix, maxPix, nullPix, clampFlag);
+
+   for (ossim_uint32 level = 0; level < 3; ++level)
+   {
+      ossim::setSimdLevel(LEVELS[level]);
+      ossim::unnormalize(&s[0], &result[0], N, minPix, maxPix, nullPix, clampFlag);
+      if ( memcmp(&expected[0], &result[0], N*sizeof(D)) != 0 )
+      {
+         cerr << name << " unnormalize mismatch at "
+              << ossim::simdLevelString(ossim::getSimdLevel()) << endl;
+         ++errors;
+      }
+   }
+   return errors;
+}
+
+template <class T>
+static int testInterleave(const char* name)
+{
+   int errors = 0;
+   const ossim_uint32 N = 517;
+   for (ossim_uint32 bands = 1; bands <= 5; ++bands)
+   {
+      vector<T> bip(N*bands);
+      vector<T> bipOut(N*bands);
+      for (ossim_uint32 i = 0; i < bip.size(); ++i) bip[i] = (T)rand();
+      vector< vector<T> > bsq(bands, vector<T>(N));
+      vector<void*> d(bands);
+      vector<const void*> s(bands);
+      for (ossim_uint32 b = 0; b < bands; ++b)
+      {
+         d[b] = &bsq[b][0];
+         s[b] = &bsq[b][0];
+      }
+
+      for (ossim_uint32 level = 0; level < 3; ++level)
+      {
+         ossim::setSimdLevel(LEVELS[level]);
+         ossim::bipToBands(&bip[0], &d[0], sizeof(T), bands, N);
+         for (ossim_uint32 b = 0; b < bands; ++b)
+         {
+            for (ossim_uint32 i = 0; i < N; ++i)
+            {
+               if ( bsq[b][i] != bip[i*bands+b] )
+               {
+                  cerr << name << " bipToBands mismatch, bands=" << bands << " at "
+                       << ossim::simdLevelString(ossim::getSimdLevel()) << endl;
+                  ++errors;
+                  b = bands;
+                  break;
+               }
+            }
+         }
+         memset(&bipOut[0], 0, bipOut.size()*sizeof(T));
+         ossim::bandsToBip(&s[0], &bipOut[0], sizeof(T), bands, N);
+         if ( bip != bipOut )
+         {
+            cerr << name << " bandsToBip mismatch, bands=" << bands << " at "
+                 << ossim::simdLevelString(ossim::getSimdLevel()) << endl;
+            ++errors;
+         }
+      }
+   }
+   return errors;
+}
+
+template <class T>
+static int testCountNull(const char* name, T nullPix)
+{
+   int errors = 0;
+
+   // Large enough to wrap the kernels' 8 bit lane counters several times.
+   const ossim_uint32 N = 256*32*3 + 29;
+   vector<T> s(N);
+   ossim_uint32 expected = 0;
+   for (ossim_uint32 i = 0; i < N; ++i)
+   {
+      s[i] = ( (rand() % 3) == 0 ) ? nullPix : (T)(nullPix + 1 + rand() % 100);
+      if ( s[i] == nullPix ) ++expected;
+   }
+
+   for (ossim_uint32 level = 0; level < 3; ++level)
+   {
+      ossim::setSimdLevel(LEVELS[level]);
+      if ( ossim::countNull(&s[0], N, nullPix) != expected )
+      {
+         cerr << name << " countNull mismatch at "
+              << ossim::simdLevelString(ossim::getSimdLevel()) << endl;
+         ++errors;
+      }
+   }
+   return errors;
+}
+
+//---
+// Samples in [lo, hi], skipPix one in five, whose low end drops partway through so the null and
+// min of the in order scans change after the first blocks.
+//---
+template <class T>
+static vector<T> rangeSamples(ossim_uint32 n, double lo, double hi, T skipPix)
+{
+   vector<T> s(n);
+   for (ossim_uint32 i = 0; i < n; ++i)
+   {
+      const double floor = (i < n/2) ? lo + (hi - lo)/4.0 : lo;
+      s[i] = (T)( floor + (rand() % 1000) * (hi - floor) / 1000.0 );
+      if ( rand() % 5 == 0 ) s[i] = skipPix;
+   }
+   for (ossim_uint32 i = 0; i < 40; ++i)
+   {
+      s[i] = (T)(hi - 1 - i); // Leading run lowering the min.
+   }
+   return s;
+}
+
+template <class T>
+static int testMinMax(const char* name, double lo, double hi, T skipPix)
+{
+   int errors = 0;
+   const ossim_uint32 N = 512*9 + 77;
+   const vector<T> s = rangeSamples<T>(N, lo, hi, skipPix);
+
+   // As ossimImageData starts a scan: min at the max pixel and max at the min pixel. The
+   // samples go in three calls as three tiles.
+   const ossim_uint32 PART = 512*3 + 5;
+   double expected[5] = { hi, lo, hi, lo, hi };
+   for (ossim_uint32 i = 0; i < N; i += PART)
+   {
+      const ossim_uint32 n = (N - i < PART) ? N - i : PART;
+      ossim::minMax<T>(&s[i], n, skipPix, expected[0], expected[1]);
+      ossim::minMaxNul<T>(&s[i], n, skipPix, expected[2], expected[3], expected[4]);
+   }
+
+   for (ossim_uint32 level = 0; level < 3; ++level)
+   {
+      ossim::setSimdLevel(LEVELS[level]);
+      double result[5] = { hi, lo, hi, lo, hi };
+      for (ossim_uint32 i = 0; i < N; i += PART)
+      {
+         const ossim_uint32 n = (N - i < PART) ? N - i : PART;
+         ossim::minMax(&s[i], n, skipPix, result[0], result[1]);
+         ossim::minMaxNul(&s[i], n, skipPix, result[2], result[3], result[4]);
+      }
+      if ( memcmp(expected, result, sizeof(expected)) != 0 )
+      {
+         cerr << name << " minMax/minMaxNul mismatch at "
+              << ossim::simdLevelString(ossim::getSimdLevel()) << endl;
+         ++errors;
+      }
+   }
+   return errors;
+}
+
+template <class T>
+static int testCountUnitBins(const char* name, double lo, double hi,
+                             ossim_int64 first, ossim_uint32 binCount)
+{
+   int errors = 0;
+   const ossim_uint32 N = 256*17 + 13;
+   vector<T> s = rangeSamples<T>(N, lo, hi, (T)lo);
+   for (ossim_uint32 i = 1000; i < 1300; ++i)
+   {
+      s[i] = (T)first; // A run of one value.
+   }
+   vector<ossim_uint64> expected(binCount, 3);
+   ossim::countUnitBins<T>(&s[0], N, first, binCount, &expected[0]);
+
+   for (ossim_uint32 level = 0; level < 4; ++level)
+   {
+      ossim::setSimdLevel(level ? LEVELS[level-1] : ossim::SIMD_SCALAR);
+      vector<ossim_uint64> result(binCount, 3);
+      ossim::countUnitBins(&s[0], N, first, binCount, &result[0]);
+      if ( result != expected )
+      {
+         cerr << name << " countUnitBins(" << first << ", " << binCount << ") mismatch at "
+              << ossim::simdLevelString(ossim::getSimdLevel()) << endl;
+         ++errors;
+      }
+   }
+   return errors;
+}
+
+static int testBinIndex()
+{
+   int errors = 0;
+   const ossim_uint32 N = 1031;
+   vector<ossim_float32> s = rangeSamples<ossim_float32>(N, -20.0, 300.0, -99999.0f);
+   s[3] = ossim::nan();
+   const ossim_float32 VMIN  = -10.0f;
+   const ossim_float32 VMAX  = 290.0f;
+   const ossim_int32   BINS  = 300;
+   const ossim_float32 DELTA = (VMAX - VMIN) / (BINS - 1);
+   vector<ossim_int32> expected(N);
+   vector<ossim_int32> result(N);
+
+   ossim::setSimdLevel(ossim::SIMD_SCALAR);
+   ossim::binIndex(&s[0], N, VMIN, VMAX, DELTA, BINS, &expected[0]);
+
+   for (ossim_uint32 level = 0; level < 3; ++level)
+   {
+      ossim::setSimdLevel(LEVELS[level]);
+      ossim::binIndex(&s[0], N, VMIN, VMAX, DELTA, BINS, &result[0]);
+      if ( expected != result )
+      {
+         cerr << "binIndex mismatch at "
+              << ossim::simdLevelString(ossim::getSimdLevel()) << endl;
+         ++errors;
+      }
+   }
+   return errors;
+}
+
+static int testAddWeighted()
+{
+   int errors = 0;
+   const ossim_uint32 N = 263;
+   vector<ossim_float64> s(N);
+   vector<ossim_float64> expected(N);
+   for (ossim_uint32 i = 0; i < N; ++i)
+   {
+      s[i] = (rand() % 100000) / 7.0;
+      expected[i] = (rand() % 100000) / 3.0;
+   }
+   const vector<ossim_float64> d0 = expected;
+   const ossim_float64 W = 0.3183098861837907;
+
+   ossim::setSimdLevel(ossim::SIMD_SCALAR);
+   ossim::addWeighted(&s[0], &expected[0], N, W);
+
+   for (ossim_uint32 level = 0; level < 3; ++level)
+   {
+      ossim::setSimdLevel(LEVELS[level]);
+      vector<ossim_float64> result = d0;
+      ossim::addWeighted(&s[0], &result[0], N, W);
+      if ( memcmp(&expected[0], &result[0], N*sizeof(ossim_float64)) != 0 )
+      {
+         cerr << "addWeighted mismatch at "
+              << ossim::simdLevelString(ossim::getSimdLevel()) << endl;
+         ++errors;
+      }
+   }
+   return errors;
+}
+
+int main( int argc, char* argv[] )
+{
+   enum
+   {
+      PASSED = 0,
+      FAILED = 1
+   };
+
+   ossimArgumentParser ap(&argc, argv);
+   ossimInit::instance()->addOptions(ap);
+   ossimInit::instance()->initialize(ap);
+
+   cout << "cpu simd level: " << ossim::simdLevelString(ossim::getCpuSimdLevel()) << endl;
+
+   int errors = 0;
+   errors += testNormalize<ossim_uint8, ossim_float32>("u8->f32", 1, 255, 0);
+   errors += testNormalize<ossim_uint8, ossim_float64>("u8->f64", 1, 255, 0);
+   errors += testNormalize<ossim_uint16, ossim_float32>("u16->f32", 1, 2047, 0);
+   errors += testNormalize<ossim_uint16, ossim_float64>("u16->f64", 1, 65535, 0);
+   errors += testNormalize<ossim_sint16, ossim_float32>("s16->f32", -32767, 32767, -32768);
+   errors += testNormalize<ossim_sint16, ossim_float64>("s16->f64", -32767, 32767, -32768);
+   errors += testNormalize<ossim_float32, ossim_float32>("f32->f32", -10.5, 300.25, -99999);
+   errors += testNormalize<ossim_float32, ossim_float64>("f32->f64", -10.5, 300.25, -99999);
+
+   errors += testUnnormalize<ossim_float32, ossim_uint8>("f32->u8", 1, 255, 0, true);
+   errors += testUnnormalize<ossim_float64, ossim_uint8>("f64->u8", 1, 255, 0, false);
+   errors += testUnnormalize<ossim_float32, ossim_uint16>("f32->u16", 1, 65535, 0, true);
+   errors += testUnnormalize<ossim_float64, ossim_uint16>("f64->u16", 1, 2047, 0, true);
+   errors += testUnnormalize<ossim_float32, ossim_sint16>("f32->s16", -32767, 32767, -32768, true);
+   errors += testUnnormalize<ossim_float64, ossim_sint16>("f64->s16", -32767, 32767, -32768, false);
+   errors += testUnnormalize<ossim_float32, ossim_float32>("f32->f32", -3.5, 1000, -99999, true);
+   errors += testUnnormalize<ossim_float64, ossim_float32>("f64->f32", -3.5, 1000, -99999, false);
+
+   errors += testInterleave<ossim_uint8>("u8");
+   errors += testInterleave<ossim_uint16>("u16");
+   errors += testInterleave<ossim_float32>("f32");
+   errors += testInterleave<ossim_float64>("f64");
+
+   errors += testCountNull<ossim_uint8>("u8", 0);
+   errors += testCountNull<ossim_uint16>("u16", 0);
+   errors += testCountNull<ossim_sint16>("s16", -32768);
+   errors += testCountNull<ossim_float32>("f32", -99999.0f);
+
+   errors += testMinMax<ossim_uint8>("u8", 1, 255, 0);
+   errors += testMinMax<ossim_uint16>("u11", 1, 2047, 0);
+   errors += testMinMax<ossim_uint16>("u16", 1, 65535, 0);
+   errors += testMinMax<ossim_sint16>("s16", -32767, 32767, -32768);
+   errors += testMinMax<ossim_float32>("f32", -10.5, 300.25, -99999.0f);
+
+   errors += testCountUnitBins<ossim_uint8>("u8", 0, 255, 0, 256);
+   errors += testCountUnitBins<ossim_uint8>("u8", 0, 255, 20, 200);
+   errors += testCountUnitBins<ossim_uint16>("u11", 0, 2047, 0, 2048);
+   errors += testCountUnitBins<ossim_uint16>("u16", 0, 65535, 0, 65536);
+   errors += testCountUnitBins<ossim_uint16>("u16", 100, 5000, 1000, 3000);
+   errors += testCountUnitBins<ossim_sint16>("s16", -2000, 2000, -1500, 4001);
+
+   errors += testBinIndex();
+
+   errors += testAddWeighted();
+
+   int status = errors ? FAILED : PASSED;
+   cout << "ossim-image-data-kernels-test: " << (status == PASSED ? "PASSED" : "FAILED")  << endl;
+   return status;
+}
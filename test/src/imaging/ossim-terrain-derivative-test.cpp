@@ -0,0 +1,121 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// File: ossim-terrain-derivative-test.cpp
+//
+// Description: Test app:
+//
+// Computes the NORMAL_X/Y/Z bands of ossimTerrainDerivativeSource on a synthetic elevation
+// tile with scattered nulls at every SIMD level the cpu supports and checks them against
+// ossimImageToPlaneNormalFilter.
+//
+// Returns 0 on success and outputs PASSED, 1 on failure and outputs FAILED.
+//
+// $Id$
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimSimd.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageToPlaneNormalFilter.h>
+#include <ossim/imaging/ossimMemoryImageSource.h>
+#include <ossim/imaging/ossimTerrainDerivativeSource.h>
+#include <ossim/init/ossimInit.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+static const ossim::SimdLevel LEVELS[] =
+{ ossim::SIMD_SCALAR, ossim::SIMD_SSE2, ossim::SIMD_SSSE3, ossim::SIMD_AVX2 };
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   // Odd width to exercise the scalar tails.
+   const ossim_uint32 W = 203;
+   const ossim_uint32 H = 101;
+   ossimRefPtr<ossimImageData> dem =
+      new ossimImageData(0, OSSIM_FLOAT32, 1, W, H);
+   dem->initialize();
+   const ossim_float32 NULL_PIX = (ossim_float32) dem->getNullPix(0);
+   ossim_float32* buf = static_cast<ossim_float32*>(dem->getBuf(0));
+   srand(1);
+   for (ossim_uint32 i = 0; i < W*H; ++i)
+   {
+      const double x = (double)(i % W);
+      const double y = (double)(i / W);
+      buf[i] = (ossim_float32)(100.0 + 20.0*sin(x/9.0)*cos(y/13.0) + (rand() % 100)/50.0);
+      if ( rand() % 23 == 0 ) buf[i] = NULL_PIX;
+   }
+   dem->validate();
+
+   ossimRefPtr<ossimMemoryImageSource> source = new ossimMemoryImageSource();
+   source->setImage(dem);
+
+   ossimRefPtr<ossimImageToPlaneNormalFilter> reference =
+      new ossimImageToPlaneNormalFilter(source.get());
+   reference->setTrackScaleFlag(false);
+   reference->initialize();
+
+   ossimRefPtr<ossimTerrainDerivativeSource> derivatives =
+      new ossimTerrainDerivativeSource(source.get());
+   vector<ossimTerrainDerivativeSource::Product> products;
+   products.push_back(ossimTerrainDerivativeSource::NORMAL_X);
+   products.push_back(ossimTerrainDerivativeSource::NORMAL_Y);
+   products.push_back(ossimTerrainDerivativeSource::NORMAL_Z);
+   derivatives->setProducts(products);
+   derivatives->setTrackScaleFlag(false);
+   derivatives->initialize();
+
+   const ossimIrect RECT(0, 0, W - 1, H - 1);
+   ossimRefPtr<ossimImageData> expected = reference->getTile(RECT);
+   if ( !expected.valid() )
+   {
+      cout << "no reference tile FAILED" << endl;
+      return 1;
+   }
+   expected = (ossimImageData*) expected->dup();
+
+   int errors = 0;
+   for (ossim_uint32 level = 0; level < 4; ++level)
+   {
+      ossim::setSimdLevel(LEVELS[level]);
+      ossimRefPtr<ossimImageData> result = derivatives->getTile(RECT);
+      if ( !result.valid() || (result->getNumberOfBands() != 3) )
+      {
+         cerr << "no tile at " << ossim::simdLevelString(ossim::getSimdLevel()) << endl;
+         ++errors;
+         continue;
+      }
+      ossim_uint32 mismatches = 0;
+      for (ossim_uint32 band = 0; band < 3; ++band)
+      {
+         const double* e = static_cast<const double*>(expected->getBuf(band));
+         const ossim_float32* r = static_cast<const ossim_float32*>(result->getBuf(band));
+         const double E_NULL = expected->getNullPix(band);
+         const ossim_float32 R_NULL = (ossim_float32) result->getNullPix(band);
+         for (ossim_uint32 i = 0; i < W*H; ++i)
+         {
+            if ( e[i] == E_NULL )
+               mismatches += (r[i] != R_NULL);
+            else
+               mismatches += ( (r[i] == R_NULL) || (fabs(r[i] - e[i]) > 1.0e-5) );
+         }
+      }
+      if ( mismatches )
+      {
+         cerr << mismatches << " mismatches at "
+              << ossim::simdLevelString(ossim::getSimdLevel()) << endl;
+         ++errors;
+      }
+   }
+
+   cout << "ossimTerrainDerivativeSource " << (errors ? "FAILED" : "PASSED") << endl;
+   return errors ? 1 : 0;
+}
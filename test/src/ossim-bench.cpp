@@ -0,0 +1,913 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Benchmark suite for tracking performance between releases.
+//
+// Microbenchmarks time small kernels (tile load/unload/validate, resampler kernels, projection
+// transforms, elevation lookups, keyword list parsing) in memory.  Each is run with enough
+// iterations to last --min-time seconds, --repeats times, and the median is reported.
+//
+// Macrobenchmarks write a synthetic scene like ossim-image-synth's to --work-dir, then time an
+// ortho of it, an overview build and a two image mosaic with the library classes the
+// applications use.
+//
+// The report is JSON with the environment (version, compiler, cpu count, SIMD level, elevation
+// setup) so runs on the same machine can be compared.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/base/ossimArgumentParser.h>
+#include <ossim/base/ossimApplicationUsage.h>
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimKeywordNames.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimSimd.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/elevation/ossimElevManager.h>
+#include <ossim/imaging/ossimFilterResampler.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageGeometry.h>
+#include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimImageHandlerRegistry.h>
+#include <ossim/imaging/ossimMemoryImageSource.h>
+#include <ossim/imaging/ossimOverviewBuilderBase.h>
+#include <ossim/imaging/ossimOverviewBuilderFactoryRegistry.h>
+#include <ossim/imaging/ossimTiffWriter.h>
+#include <ossim/init/ossimInit.h>
+#include <ossim/projection/ossimEquDistCylProjection.h>
+#include <ossim/projection/ossimRpcModel.h>
+#include <ossim/projection/ossimUtmProjection.h>
+#include <ossim/util/ossimChipperUtil.h>
+#include <OpenThreads/Thread>
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+// Results land here so the compiler cannot drop the timed work.
+static volatile double theSink = 0.0;
+
+// Small LCG so every run fills buffers and picks points the same way on every platform.
+static double nextRandom(ossim_uint64& state)
+{
+   state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+   return (double)(state >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double median(std::vector<double> values)
+{
+   if (values.empty())
+   {
+      return 0.0;
+   }
+   std::sort(values.begin(), values.end());
+   size_t mid = values.size() / 2;
+   return (values.size() % 2) ? values[mid] : 0.5 * (values[mid - 1] + values[mid]);
+}
+
+static std::string jsonString(const std::string& s)
+{
+   std::string result = "\"";
+   for (std::string::size_type i = 0; i < s.size(); ++i)
+   {
+      const char c = s[i];
+      if ( (c == '"') || (c == '\\') )
+      {
+         result += '\\';
+         result += c;
+      }
+      else if (c == '\n')
+      {
+         result += "\\n";
+      }
+      else if ( (unsigned char)c < 0x20 )
+      {
+         char buf[8];
+         sprintf(buf, "\\u%04x", (unsigned int)c);
+         result += buf;
+      }
+      else
+      {
+         result += c;
+      }
+   }
+   result += "\"";
+   return result;
+}
+
+//---
+// Microbenchmarks
+//---
+
+class MicroBenchmark
+{
+public:
+   MicroBenchmark(const std::string& name, const std::string& unit, double itemsPerIteration)
+      : m_name(name), m_unit(unit), m_items(itemsPerIteration) {}
+   virtual ~MicroBenchmark() {}
+
+   /** Runs the timed work iterations times. */
+   virtual void run(ossim_uint64 iterations) = 0;
+
+   std::string m_name;
+   std::string m_unit;  //!< What an item is, e.g. "pixel" or "point".
+   double      m_items; //!< Items per iteration.
+};
+
+class TileLoadBenchmark : public MicroBenchmark
+{
+public:
+   TileLoadBenchmark()
+      : MicroBenchmark("image_data.load_tile.u8_3band_bip", "pixel", 256.0 * 256.0),
+        m_rect(0, 0, 255, 255),
+        m_buffer(256 * 256 * 3)
+   {
+      m_tile = ossimImageDataFactory::instance()->create(0, OSSIM_UINT8, 3, 256, 256);
+      m_tile->initialize();
+      ossim_uint64 state = 1;
+      for (size_t i = 0; i < m_buffer.size(); ++i)
+      {
+         m_buffer[i] = (ossim_uint8)(1 + nextRandom(state) * 254.0);
+      }
+   }
+   virtual void run(ossim_uint64 iterations)
+   {
+      for (ossim_uint64 i = 0; i < iterations; ++i)
+      {
+         m_tile->loadTile(&m_buffer.front(), m_rect, OSSIM_BIP);
+      }
+      theSink = theSink + m_tile->getUcharBuf()[0];
+   }
+protected:
+   ossimRefPtr<ossimImageData> m_tile;
+   ossimIrect                  m_rect;
+   std::vector<ossim_uint8>    m_buffer;
+};
+
+class TileUnloadBenchmark : public TileLoadBenchmark
+{
+public:
+   TileUnloadBenchmark()
+      : TileLoadBenchmark()
+   {
+      m_name = "image_data.unload_tile.u8_3band_bip";
+      m_tile->loadTile(&m_buffer.front(), m_rect, OSSIM_BIP);
+   }
+   virtual void run(ossim_uint64 iterations)
+   {
+      for (ossim_uint64 i = 0; i < iterations; ++i)
+      {
+         m_tile->unloadTile(&m_buffer.front(), m_rect, OSSIM_BIP);
+      }
+      theSink = theSink + m_buffer[0];
+   }
+};
+
+class TileValidateBenchmark : public MicroBenchmark
+{
+public:
+   /** Null pixels every nullStep pixels, none if 0. */
+   TileValidateBenchmark(const std::string& name, ossim_uint32 nullStep)
+      : MicroBenchmark(name, "pixel", 256.0 * 256.0)
+   {
+      m_tile = ossimImageDataFactory::instance()->create(0, OSSIM_UINT16, 1, 256, 256);
+      m_tile->initialize();
+      ossim_uint16* buf = m_tile->getUshortBuf();
+      for (ossim_uint32 i = 0; i < 256 * 256; ++i)
+      {
+         buf[i] = ( nullStep && ((i % nullStep) == nullStep - 1) ) ? 0 : (ossim_uint16)(1 + i % 2047);
+      }
+   }
+   virtual void run(ossim_uint64 iterations)
+   {
+      for (ossim_uint64 i = 0; i < iterations; ++i)
+      {
+         m_tile->invalidateStatus();
+         theSink = theSink + m_tile->validate();
+      }
+   }
+private:
+   ossimRefPtr<ossimImageData> m_tile;
+};
+
+class ResamplerBenchmark : public MicroBenchmark
+{
+public:
+   ResamplerBenchmark(const std::string& filter)
+      : MicroBenchmark("filter_resampler." + filter, "pixel", 256.0 * 256.0),
+        m_resampler()
+   {
+      m_resampler.setFilterType(ossimString(filter));
+
+      // Input with room for the kernel around the rotated, slightly minified output.
+      m_input = ossimImageDataFactory::instance()->create(0, OSSIM_UINT8, 1, 384, 384);
+      m_input->setOrigin(ossimIpt(-64, -64));
+      m_input->initialize();
+      ossim_uint8* buf = m_input->getUcharBuf();
+      ossim_uint64 state = 2;
+      for (ossim_uint32 i = 0; i < 384 * 384; ++i)
+      {
+         buf[i] = (ossim_uint8)(1 + nextRandom(state) * 254.0);
+      }
+      m_input->validate();
+
+      m_output = ossimImageDataFactory::instance()->create(0, OSSIM_UINT8, 1, 256, 256);
+      m_output->initialize();
+
+      // 5 degree rotation, 1.1 scale: input points of the output corners.
+      const double c = 1.1 * 0.99619469809;
+      const double s = 1.1 * 0.08715574274;
+      m_ul = ossimDpt(0.0, 0.0);
+      m_ur = ossimDpt(255.0 * c, 255.0 * s);
+      m_deltaUl = ossimDpt(-s, c);
+      m_deltaUr = m_deltaUl;
+      m_length = ossimDpt(256.0, 256.0);
+   }
+   virtual void run(ossim_uint64 iterations)
+   {
+      for (ossim_uint64 i = 0; i < iterations; ++i)
+      {
+         m_resampler.resample(m_input, m_output, m_ul, m_ur, m_deltaUl, m_deltaUr, m_length);
+      }
+      theSink = theSink + m_output->getUcharBuf()[128 * 256 + 128];
+   }
+private:
+   ossimFilterResampler        m_resampler;
+   ossimRefPtr<ossimImageData> m_input;
+   ossimRefPtr<ossimImageData> m_output;
+   ossimDpt m_ul, m_ur, m_deltaUl, m_deltaUr, m_length;
+};
+
+/** Points over the 0.1 degree box around (35, -105) the projections below cover. */
+static void makeGroundPoints(ossim_uint32 count, std::vector<ossimGpt>& points)
+{
+   points.resize(count);
+   ossim_uint64 state = 3;
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      points[i] = ossimGpt(34.95 + 0.1 * nextRandom(state),
+                           -105.05 + 0.1 * nextRandom(state),
+                           1000.0 + 500.0 * nextRandom(state));
+   }
+}
+
+class ProjectionBenchmark : public MicroBenchmark
+{
+public:
+   enum Direction
+   {
+      FORWARD,  //!< worldToLineSamples
+      INVERSE   //!< lineSampleToWorlds
+   };
+
+   ProjectionBenchmark(const std::string& name, ossimProjection* proj, Direction direction)
+      : MicroBenchmark(name, "point", 1024.0),
+        m_proj(proj),
+        m_direction(direction)
+   {
+      makeGroundPoints(1024, m_gpts);
+      m_dpts.resize(m_gpts.size());
+      m_proj->worldToLineSamples(&m_gpts.front(), &m_dpts.front(), (ossim_uint32)m_gpts.size());
+   }
+   virtual void run(ossim_uint64 iterations)
+   {
+      const ossim_uint32 COUNT = (ossim_uint32)m_gpts.size();
+      if (m_direction == FORWARD)
+      {
+         for (ossim_uint64 i = 0; i < iterations; ++i)
+         {
+            m_proj->worldToLineSamples(&m_gpts.front(), &m_dpts.front(), COUNT);
+         }
+         theSink = theSink + m_dpts[0].x;
+      }
+      else
+      {
+         for (ossim_uint64 i = 0; i < iterations; ++i)
+         {
+            m_proj->lineSampleToWorlds(&m_dpts.front(), &m_gpts.front(), COUNT);
+         }
+         theSink = theSink + m_gpts[0].lat;
+      }
+   }
+private:
+   ossimRefPtr<ossimProjection> m_proj;
+   Direction                    m_direction;
+   std::vector<ossimGpt>        m_gpts;
+   std::vector<ossimDpt>        m_dpts;
+};
+
+class RpcHeightBenchmark : public MicroBenchmark
+{
+public:
+   RpcHeightBenchmark(ossimRpcModel* rpc)
+      : MicroBenchmark("projection.rpc.line_sample_height_to_world", "point", 1024.0),
+        m_rpc(rpc)
+   {
+      makeGroundPoints(1024, m_gpts);
+      m_dpts.resize(m_gpts.size());
+      m_rpc->worldToLineSamples(&m_gpts.front(), &m_dpts.front(), (ossim_uint32)m_gpts.size());
+   }
+   virtual void run(ossim_uint64 iterations)
+   {
+      ossimGpt gpt;
+      for (ossim_uint64 i = 0; i < iterations; ++i)
+      {
+         for (size_t p = 0; p < m_dpts.size(); ++p)
+         {
+            m_rpc->lineSampleHeightToWorld(m_dpts[p], m_gpts[p].hgt, gpt);
+         }
+      }
+      theSink = theSink + gpt.lat;
+   }
+private:
+   ossimRefPtr<ossimRpcModel> m_rpc;
+   std::vector<ossimGpt>      m_gpts;
+   std::vector<ossimDpt>      m_dpts;
+};
+
+class ElevationBenchmark : public MicroBenchmark
+{
+public:
+   ElevationBenchmark(bool batchFlag)
+      : MicroBenchmark(batchFlag ? "elevation.heights_above_ellipsoid"
+                                 : "elevation.height_above_ellipsoid", "point", 1024.0),
+        m_batchFlag(batchFlag)
+   {
+      makeGroundPoints(1024, m_gpts);
+      m_heights.resize(m_gpts.size());
+   }
+   virtual void run(ossim_uint64 iterations)
+   {
+      ossimElevManager* mgr = ossimElevManager::instance();
+      const ossim_uint32 COUNT = (ossim_uint32)m_gpts.size();
+      for (ossim_uint64 i = 0; i < iterations; ++i)
+      {
+         if (m_batchFlag)
+         {
+            mgr->getHeightsAboveEllipsoid(&m_gpts.front(), &m_heights.front(), COUNT);
+         }
+         else
+         {
+            for (ossim_uint32 p = 0; p < COUNT; ++p)
+            {
+               m_heights[p] = mgr->getHeightAboveEllipsoid(m_gpts[p]);
+            }
+         }
+      }
+      theSink = theSink + m_heights[0];
+   }
+private:
+   bool                  m_batchFlag;
+   std::vector<ossimGpt> m_gpts;
+   std::vector<double>   m_heights;
+};
+
+class KeywordlistBenchmark : public MicroBenchmark
+{
+public:
+   KeywordlistBenchmark()
+      : MicroBenchmark("keywordlist.parse_string", "line", 0.0)
+   {
+      // A chain-sized list: 100 objects of 20 keywords.
+      std::ostringstream os;
+      for (ossim_uint32 obj = 0; obj < 100; ++obj)
+      {
+         os << "// object " << obj << "\n";
+         for (ossim_uint32 key = 0; key < 20; ++key)
+         {
+            os << "object" << obj << ".key" << key << ":  value " << (obj * 20 + key) << "\n";
+         }
+      }
+      m_text = os.str();
+      m_items = 100.0 * 21.0;
+   }
+   virtual void run(ossim_uint64 iterations)
+   {
+      for (ossim_uint64 i = 0; i < iterations; ++i)
+      {
+         ossimKeywordlist kwl;
+         kwl.parseString(m_text);
+         theSink = theSink + kwl.getSize();
+      }
+   }
+private:
+   std::string m_text;
+};
+
+struct MicroResult
+{
+   std::string  m_name;
+   std::string  m_unit;
+   double       m_items;
+   ossim_uint64 m_iterations;
+   std::vector<double> m_nsPerIteration; //!< One per repeat.
+};
+
+static MicroResult runMicro(MicroBenchmark& bench, double minTime, ossim_uint32 repeats)
+{
+   ossimTimer* timer = ossimTimer::instance();
+   MicroResult result;
+   result.m_name = bench.m_name;
+   result.m_unit = bench.m_unit;
+   result.m_items = bench.m_items;
+
+   // Untimed pass for caches and lazy setup, then grow the count until one run takes minTime.
+   bench.run(1);
+   ossim_uint64 iterations = 1;
+   while (true)
+   {
+      ossimTimer::Timer_t t0 = timer->tick();
+      bench.run(iterations);
+      double seconds = timer->delta_s(t0, timer->tick());
+      if ( (seconds >= minTime) || (iterations >= (1ULL << 40)) )
+      {
+         break;
+      }
+      double scale = (seconds > 0.0) ? (1.2 * minTime / seconds) : 10.0;
+      scale = std::min(10.0, std::max(2.0, scale));
+      iterations = (ossim_uint64)(iterations * scale);
+   }
+   result.m_iterations = iterations;
+
+   for (ossim_uint32 r = 0; r < repeats; ++r)
+   {
+      ossimTimer::Timer_t t0 = timer->tick();
+      bench.run(iterations);
+      result.m_nsPerIteration.push_back(timer->delta_n(t0, timer->tick()) / iterations);
+   }
+   return result;
+}
+
+//---
+// Macrobenchmarks
+//---
+
+/** Writes a 3 band U8 geographic scene of size pixels with its upper left at (ulLat, ulLon). */
+static bool writeScene(const ossimFilename& file, ossim_uint32 size, double ulLat, double ulLon)
+{
+   ossimRefPtr<ossimImageData> image =
+      ossimImageDataFactory::instance()->create(0, OSSIM_UINT8, 3, size, size);
+   image->initialize();
+
+   // Gradients plus noise, so the writer and resamplers see realistic content.
+   ossim_uint64 state = 4;
+   for (ossim_uint32 band = 0; band < 3; ++band)
+   {
+      ossim_uint8* buf = image->getUcharBuf(band);
+      for (ossim_uint32 y = 0; y < size; ++y)
+      {
+         for (ossim_uint32 x = 0; x < size; ++x)
+         {
+            double v = 32.0 + 160.0 * ((band == 0) ? x : ((band == 1) ? y : (x + y) / 2)) / size;
+            buf[y * size + x] = (ossim_uint8)(v + 60.0 * nextRandom(state));
+         }
+      }
+   }
+   image->validate();
+
+   ossimRefPtr<ossimEquDistCylProjection> proj = new ossimEquDistCylProjection();
+   proj->setOrigin(ossimGpt(ulLat, ulLon));
+   proj->setMetersPerPixel(ossimDpt(1.0, 1.0));
+   proj->setElevationLookupFlag(false);
+   proj->setUlTiePoints(ossimGpt(ulLat, ulLon));
+   ossimRefPtr<ossimImageGeometry> geom = new ossimImageGeometry(0, proj.get());
+   geom->setImageSize(ossimIpt(size, size));
+
+   ossimRefPtr<ossimMemoryImageSource> source = new ossimMemoryImageSource();
+   source->setImage(image);
+   source->setImageGeometry(geom.get());
+
+   ossimRefPtr<ossimTiffWriter> writer = new ossimTiffWriter();
+   writer->connectMyInputTo(0, source.get());
+   writer->setFilename(file);
+   writer->setGeotiffFlag(true);
+   bool status = writer->execute();
+   writer->disconnect();
+   return status;
+}
+
+/** Runs an ortho or mosaic of images through ossimChipperUtil. */
+static bool chip(const std::vector<ossimFilename>& images, const ossimFilename& output,
+                 const char* projection)
+{
+   ossimKeywordlist kwl;
+   kwl.add("operation", "ortho");
+   kwl.add(ossimKeywordNames::PROJECTION_KW, projection);
+   kwl.add("resampler_filter", "bilinear");
+   for (ossim_uint32 i = 0; i < images.size(); ++i)
+   {
+      std::string prefix = "image" + ossimString::toString(i).string() + ".";
+      kwl.add(prefix.c_str(), "file", images[i].c_str());
+   }
+   kwl.add(ossimKeywordNames::OUTPUT_FILE_KW, output.c_str());
+
+   ossimRefPtr<ossimChipperUtil> chipper = new ossimChipperUtil();
+   chipper->initialize(kwl);
+   chipper->execute();
+   return output.exists();
+}
+
+static bool buildOverviews(const ossimFilename& image)
+{
+   bool status = false;
+   ossimRefPtr<ossimImageHandler> ih = ossimImageHandlerRegistry::instance()->open(image);
+   ossimRefPtr<ossimOverviewBuilderBase> builder =
+      ossimOverviewBuilderFactoryRegistry::instance()->createBuilder(ossimString("ossim_tiff_box"));
+   if ( ih.valid() && builder.valid() )
+   {
+      ossimFilename ovr = image;
+      ovr.setExtension("ovr");
+      builder->setInputSource(ih.get());
+      builder->setOutputFile(ovr);
+      status = builder->execute();
+   }
+   return status;
+}
+
+struct MacroResult
+{
+   std::string         m_name;
+   bool                m_status;
+   std::vector<double> m_seconds; //!< One per repeat.
+};
+
+int main(int argc, char* argv[])
+{
+   ossimString tempString;
+   ossimArgumentParser::ossimParameter stringParam(tempString);
+   ossimArgumentParser argumentParser(&argc, argv);
+   ossimInit::instance()->addOptions(argumentParser);
+   ossimInit::instance()->initialize(argumentParser);
+
+   double minTime = 0.2;
+   ossim_uint32 repeats = 5;
+   ossim_uint32 macroRepeats = 3;
+   ossim_uint32 sceneSize = 4096;
+   bool microFlag = true;
+   bool macroFlag = true;
+   bool keepFlag = false;
+   std::vector<ossimString> filters;
+   ossimFilename workDir = ".";
+   ossimFilename outputFile;
+
+   ossimApplicationUsage* au = argumentParser.getApplicationUsage();
+   au->setCommandLineUsage(argumentParser.getApplicationName() + " [options]");
+   au->setDescription("Runs the ossim micro and macro benchmarks and writes the timings with the environment as JSON.");
+   au->addCommandLineOption("-h or --help", "Display this information");
+   au->addCommandLineOption("--filter", "<list> Comma separated substrings; only benchmarks with a name containing one run");
+   au->addCommandLineOption("--micro-only", "Skip the macrobenchmarks");
+   au->addCommandLineOption("--macro-only", "Skip the microbenchmarks");
+   au->addCommandLineOption("--min-time", "<seconds> Least time of each microbenchmark repeat, default 0.2");
+   au->addCommandLineOption("--repeats", "<int> Timed repeats of each microbenchmark, default 5");
+   au->addCommandLineOption("--macro-repeats", "<int> Timed repeats of each macrobenchmark, default 3");
+   au->addCommandLineOption("--scene-size", "<pixels> Width and height of the synthetic scenes, default 4096");
+   au->addCommandLineOption("--work-dir", "<dir> Directory for the macrobenchmark files, default the current directory");
+   au->addCommandLineOption("--keep", "Keep the macrobenchmark files");
+   au->addCommandLineOption("--output", "<file> Write the report to <file> instead of standard output");
+
+   if (argumentParser.read("-h") || argumentParser.read("--help"))
+   {
+      au->write(ossimNotify(ossimNotifyLevel_INFO));
+      return 0;
+   }
+   if (argumentParser.read("--filter", stringParam))
+   {
+      tempString.split(filters, ",", true);
+   }
+   if (argumentParser.read("--min-time", stringParam))
+   {
+      minTime = std::max(0.001, tempString.toDouble());
+   }
+   if (argumentParser.read("--repeats", stringParam))
+   {
+      repeats = std::max((ossim_uint32)1, tempString.toUInt32());
+   }
+   if (argumentParser.read("--macro-repeats", stringParam))
+   {
+      macroRepeats = std::max((ossim_uint32)1, tempString.toUInt32());
+   }
+   if (argumentParser.read("--scene-size", stringParam))
+   {
+      sceneSize = std::max((ossim_uint32)256, tempString.toUInt32());
+   }
+   if (argumentParser.read("--work-dir", stringParam))
+   {
+      workDir = tempString;
+   }
+   if (argumentParser.read("--output", stringParam))
+   {
+      outputFile = tempString;
+   }
+   if (argumentParser.read("--micro-only"))
+   {
+      macroFlag = false;
+   }
+   if (argumentParser.read("--macro-only"))
+   {
+      microFlag = false;
+   }
+   keepFlag = argumentParser.read("--keep");
+
+   ossimTimer* timer = ossimTimer::instance();
+   std::vector<MicroResult> microResults;
+   std::vector<MacroResult> macroResults;
+
+   if (microFlag)
+   {
+      // Synthetic RPC over the ground point box: sample from longitude, line from latitude,
+      // with small cross and height terms so the polynomials are not trivial.
+      std::vector<double> sNum(20, 0.0), sDen(20, 0.0), lNum(20, 0.0), lDen(20, 0.0);
+      sNum[1] = 1.0;  sNum[2] = 0.01;  sNum[3] = 0.02;  sNum[4] = 0.001;
+      lNum[2] = -1.0; lNum[1] = 0.01;  lNum[3] = -0.02; lNum[7] = 0.001;
+      sDen[0] = 1.0;  sDen[1] = 0.0005;
+      lDen[0] = 1.0;  lDen[2] = 0.0005;
+      ossimRefPtr<ossimRpcModel> rpc = new ossimRpcModel();
+      rpc->setAttributes(5000.0, 5000.0, 5000.0, 5000.0,
+                         35.0, -105.0, 1250.0, 0.05, 0.05, 500.0,
+                         sNum, sDen, lNum, lDen);
+      rpc->setImageSize(ossimDpt(10000.0, 10000.0));
+
+      ossimRefPtr<ossimUtmProjection> utm = new ossimUtmProjection(13);
+      utm->setHemisphere('N');
+      utm->setMetersPerPixel(ossimDpt(1.0, 1.0));
+      utm->setUlTiePoints(ossimGpt(35.05, -105.05));
+      utm->setElevationLookupFlag(false);
+
+      ossimRefPtr<ossimEquDistCylProjection> eqdc = new ossimEquDistCylProjection();
+      eqdc->setOrigin(ossimGpt(35.0, -105.0));
+      eqdc->setMetersPerPixel(ossimDpt(1.0, 1.0));
+      eqdc->setUlTiePoints(ossimGpt(35.05, -105.05));
+      eqdc->setElevationLookupFlag(false);
+
+      std::vector<MicroBenchmark*> benches;
+      benches.push_back(new TileLoadBenchmark());
+      benches.push_back(new TileUnloadBenchmark());
+      benches.push_back(new TileValidateBenchmark("image_data.validate.u16_full", 0));
+      benches.push_back(new TileValidateBenchmark("image_data.validate.u16_partial", 97));
+      benches.push_back(new ResamplerBenchmark("nearest"));
+      benches.push_back(new ResamplerBenchmark("bilinear"));
+      benches.push_back(new ResamplerBenchmark("cubic"));
+      benches.push_back(new ResamplerBenchmark("lanczos"));
+      benches.push_back(new ProjectionBenchmark("projection.rpc.world_to_line_sample",
+                                                rpc.get(), ProjectionBenchmark::FORWARD));
+      benches.push_back(new RpcHeightBenchmark(rpc.get()));
+      benches.push_back(new ProjectionBenchmark("projection.utm.world_to_line_sample",
+                                                utm.get(), ProjectionBenchmark::FORWARD));
+      benches.push_back(new ProjectionBenchmark("projection.utm.line_sample_to_world",
+                                                utm.get(), ProjectionBenchmark::INVERSE));
+      benches.push_back(new ProjectionBenchmark("projection.equdistcyl.world_to_line_sample",
+                                                eqdc.get(), ProjectionBenchmark::FORWARD));
+      benches.push_back(new ProjectionBenchmark("projection.equdistcyl.line_sample_to_world",
+                                                eqdc.get(), ProjectionBenchmark::INVERSE));
+      benches.push_back(new ElevationBenchmark(false));
+      benches.push_back(new ElevationBenchmark(true));
+      benches.push_back(new KeywordlistBenchmark());
+
+      for (ossim_uint32 i = 0; i < benches.size(); ++i)
+      {
+         bool selected = filters.empty();
+         for (ossim_uint32 f = 0; !selected && (f < filters.size()); ++f)
+         {
+            selected = ossimString(benches[i]->m_name).contains(filters[f]);
+         }
+         if (selected)
+         {
+            ossimNotify(ossimNotifyLevel_INFO) << "Running " << benches[i]->m_name << std::endl;
+            microResults.push_back(runMicro(*benches[i], minTime, repeats));
+         }
+         delete benches[i];
+      }
+   }
+
+   if (macroFlag)
+   {
+      if ( !workDir.exists() )
+      {
+         workDir.createDirectory(true);
+      }
+      const ossimFilename SCENE  = workDir.dirCat("ossim-bench-scene.tif");
+      const ossimFilename SCENE2 = workDir.dirCat("ossim-bench-scene2.tif");
+      const ossimFilename ORTHO  = workDir.dirCat("ossim-bench-ortho.tif");
+      const ossimFilename MOSAIC = workDir.dirCat("ossim-bench-mosaic.tif");
+
+      // Second scene half a scene east, so the mosaic overlaps.
+      const double DEG_PER_METER = 1.0 / 111319.49;
+      const double UL_LAT = 35.0;
+      const double UL_LON = -105.0;
+      const double UL_LON2 = UL_LON + 0.5 * sceneSize * DEG_PER_METER / 0.81915204428; // cos(35)
+
+      const char* NAMES[] = { "macro.write_synthetic_scene", "macro.ortho_utm",
+                              "macro.overviews_tiff_box", "macro.mosaic_geo" };
+      for (ossim_uint32 m = 0; m < 4; ++m)
+      {
+         bool selected = filters.empty();
+         for (ossim_uint32 f = 0; !selected && (f < filters.size()); ++f)
+         {
+            selected = ossimString(NAMES[m]).contains(filters[f]);
+         }
+         if (!selected)
+         {
+            continue;
+         }
+         ossimNotify(ossimNotifyLevel_INFO) << "Running " << NAMES[m] << std::endl;
+
+         MacroResult result;
+         result.m_name = NAMES[m];
+         result.m_status = true;
+
+         // Every step but the first reads the scenes; write them untimed if needed.
+         if ( (m > 0) && !SCENE.exists() )
+         {
+            result.m_status = writeScene(SCENE, sceneSize, UL_LAT, UL_LON);
+         }
+         if ( (m == 3) && !SCENE2.exists() )
+         {
+            result.m_status = result.m_status && writeScene(SCENE2, sceneSize, UL_LAT, UL_LON2);
+         }
+
+         for (ossim_uint32 r = 0; result.m_status && (r < macroRepeats); ++r)
+         {
+            ossimTimer::Timer_t t0 = 0;
+            switch (m)
+            {
+               case 0:
+               {
+                  ossimFilename::wildcardRemove(workDir.dirCat("ossim-bench-scene.*"));
+                  t0 = timer->tick();
+                  result.m_status = writeScene(SCENE, sceneSize, UL_LAT, UL_LON);
+                  break;
+               }
+               case 1:
+               {
+                  ossimFilename::wildcardRemove(workDir.dirCat("ossim-bench-ortho.*"));
+                  std::vector<ossimFilename> images(1, SCENE);
+                  t0 = timer->tick();
+                  result.m_status = chip(images, ORTHO, "utm");
+                  break;
+               }
+               case 2:
+               {
+                  ossimFilename ovr = SCENE;
+                  ovr.setExtension("ovr");
+                  ovr.remove();
+                  t0 = timer->tick();
+                  result.m_status = buildOverviews(SCENE);
+                  break;
+               }
+               default:
+               {
+                  ossimFilename::wildcardRemove(workDir.dirCat("ossim-bench-mosaic.*"));
+                  std::vector<ossimFilename> images;
+                  images.push_back(SCENE);
+                  images.push_back(SCENE2);
+                  t0 = timer->tick();
+                  result.m_status = chip(images, MOSAIC, "geo");
+                  break;
+               }
+            }
+            result.m_seconds.push_back(timer->delta_s(t0, timer->tick()));
+         }
+         if (!result.m_status)
+         {
+            ossimNotify(ossimNotifyLevel_WARN) << NAMES[m] << " failed." << std::endl;
+         }
+         macroResults.push_back(result);
+      }
+
+      if (!keepFlag)
+      {
+         ossimFilename::wildcardRemove(workDir.dirCat("ossim-bench-*"));
+      }
+   }
+
+   //---
+   // Report
+   //---
+   std::ostringstream os;
+   os << std::setprecision(10);
+
+   char date[32] = { 0 };
+   time_t now = time(0);
+   strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+#if defined(__clang__)
+   const std::string COMPILER = std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+   const std::string COMPILER = std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+   const std::string COMPILER = "msvc " + ossimString::toString(_MSC_VER).string();
+#else
+   const std::string COMPILER = "unknown";
+#endif
+#if defined(_WIN32)
+   const std::string PLATFORM = "windows";
+#elif defined(__APPLE__)
+   const std::string PLATFORM = "darwin";
+#elif defined(__linux__)
+   const std::string PLATFORM = "linux";
+#else
+   const std::string PLATFORM = "unknown";
+#endif
+#if defined(NDEBUG)
+   const bool ASSERTIONS = false;
+#else
+   const bool ASSERTIONS = true;
+#endif
+
+   ossimElevManager* mgr = ossimElevManager::instance();
+   os << "{\n  \"environment\": {\n"
+      << "    \"ossim_version\": " << jsonString(ossimInit::instance()->version().string()) << ",\n"
+      << "    \"date\": " << jsonString(date) << ",\n"
+      << "    \"platform\": " << jsonString(PLATFORM) << ",\n"
+      << "    \"compiler\": " << jsonString(COMPILER) << ",\n"
+      << "    \"assertions\": " << (ASSERTIONS ? "true" : "false") << ",\n"
+      << "    \"pointer_bits\": " << (sizeof(void*) * 8) << ",\n"
+      << "    \"processors\": " << OpenThreads::GetNumberOfProcessors() << ",\n"
+      << "    \"simd_level\": " << jsonString(ossim::simdLevelString(ossim::getSimdLevel())) << ",\n"
+      << "    \"cpu_simd_level\": " << jsonString(ossim::simdLevelString(ossim::getCpuSimdLevel())) << ",\n"
+      << "    \"elevation_databases\": [";
+   for (ossim_uint32 idx = 0; idx < mgr->getNumberOfElevationDatabases(); ++idx)
+   {
+      os << (idx ? ", " : "") << jsonString(mgr->getElevationDatabase(idx)->getClassName().string());
+   }
+   os << "]\n  },\n"
+      << "  \"settings\": {\n"
+      << "    \"min_time_seconds\": " << minTime << ",\n"
+      << "    \"repeats\": " << repeats << ",\n"
+      << "    \"macro_repeats\": " << macroRepeats << ",\n"
+      << "    \"scene_size\": " << sceneSize << "\n"
+      << "  },\n"
+      << "  \"micro\": [";
+   for (ossim_uint32 i = 0; i < microResults.size(); ++i)
+   {
+      const MicroResult& r = microResults[i];
+      const double MEDIAN = median(r.m_nsPerIteration);
+      os << (i ? "," : "") << "\n    {\n"
+         << "      \"name\": " << jsonString(r.m_name) << ",\n"
+         << "      \"iterations\": " << r.m_iterations << ",\n"
+         << "      \"items_per_iteration\": " << r.m_items << ",\n"
+         << "      \"item\": " << jsonString(r.m_unit) << ",\n"
+         << "      \"ns_per_iteration_median\": " << MEDIAN << ",\n"
+         << "      \"ns_per_iteration_min\": "
+         << *std::min_element(r.m_nsPerIteration.begin(), r.m_nsPerIteration.end()) << ",\n"
+         << "      \"ns_per_iteration_max\": "
+         << *std::max_element(r.m_nsPerIteration.begin(), r.m_nsPerIteration.end()) << ",\n"
+         << "      \"items_per_second\": " << ((MEDIAN > 0.0) ? (r.m_items * 1.0e9 / MEDIAN) : 0.0)
+         << "\n    }";
+   }
+   os << (microResults.empty() ? "" : "\n  ") << "],\n"
+      << "  \"macro\": [";
+   for (ossim_uint32 i = 0; i < macroResults.size(); ++i)
+   {
+      const MacroResult& r = macroResults[i];
+      os << (i ? "," : "") << "\n    {\n"
+         << "      \"name\": " << jsonString(r.m_name) << ",\n"
+         << "      \"status\": " << (r.m_status ? "\"ok\"" : "\"failed\"") << ",\n"
+         << "      \"runs\": " << r.m_seconds.size() << ",\n"
+         << "      \"seconds_median\": " << median(r.m_seconds) << ",\n"
+         << "      \"seconds_min\": " << (r.m_seconds.empty() ? 0.0 :
+                                           *std::min_element(r.m_seconds.begin(), r.m_seconds.end()))
+         << ",\n"
+         << "      \"seconds_max\": " << (r.m_seconds.empty() ? 0.0 :
+                                           *std::max_element(r.m_seconds.begin(), r.m_seconds.end()))
+         << "\n    }";
+   }
+   os << (macroResults.empty() ? "" : "\n  ") << "]\n}\n";
+
+   bool status = true;
+   for (ossim_uint32 i = 0; i < macroResults.size(); ++i)
+   {
+      status = status && macroResults[i].m_status;
+   }
+
+   if (outputFile.size())
+   {
+      std::ofstream out(outputFile.c_str());
+      if (!out)
+      {
+         ossimNotify(ossimNotifyLevel_WARN) << "Could not write " << outputFile << std::endl;
+         return 1;
+      }
+      out << os.str();
+   }
+   else
+   {
+      std::cout << os.str();
+   }
+   return status ? 0 : 1;
+}
@@ -7,6 +7,7 @@
 #include <ossim/init/ossimInit.h>
 #include <OpenThreads/Thread>
 #include <iostream>
+#include <vector>
 static const int INITIAL_THREADS = 10;
 static const int INITIAL_JOBS = 20;
 class ossimTestJob : public ossimJob
@@ -48,11 +49,37 @@ int main(int argc, char *argv[])
    ossimArgumentParser ap(&argc, argv);
    ossimInit::instance()->addOptions(ap);
    ossimInit::instance()->initialize(ap);
+   ossim_uint32 idx = 0;
    
+   // Priority order and drop of canceled jobs, no threads involved:
+   {
+      ossimRefPtr<ossimJobQueue> pq = new ossimJobQueue();
+      const double PRIORITIES[] = { 0.0, 1.0, 0.0, 2.0, 1.0 };
+      std::vector< ossimRefPtr<ossimJob> > jobs;
+      for(idx = 0; idx < 5; ++idx)
+      {
+         ossimRefPtr<ossimJob> job = new ossimTestJob(ossimString::toString(idx));
+         job->setPriority(PRIORITIES[idx]);
+         jobs.push_back(job);
+         pq->add(job.get());
+      }
+      jobs[4]->cancel();
+
+      // Expect 3 (2.0), 1 (1.0), 0 and 2 (0.0 in order added); 4 was canceled.
+      ossimString order;
+      ossimRefPtr<ossimJob> job = pq->nextJob(false);
+      while(job.valid())
+      {
+         order += job->name();
+         job = pq->nextJob(false);
+      }
+      std::cout << "priority order: " << order
+                << ((order == "3102") ? " PASSED" : " FAILED") << std::endl;
+   }
+
    ossimRefPtr<ossimJobQueue> q = new ossimJobQueue();
    ossimRefPtr<ossimJobMultiThreadQueue> threadQueue = new ossimJobMultiThreadQueue(q.get(), INITIAL_THREADS);
    ossimRefPtr<ossimTestJobCallback> callback = new ossimTestJobCallback();
-   ossim_uint32 idx = 0;
    for(idx = 0; idx < INITIAL_JOBS; ++idx)
    {
       ossimRefPtr<ossimTestJob> job = new ossimTestJob(ossimString::toString(idx+1));
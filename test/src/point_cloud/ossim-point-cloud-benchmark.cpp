@@ -0,0 +1,382 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Repeatable point cloud throughput benchmark.  Times full file scans, bounded
+// getBlock() queries of several sizes and ossimPointCloudImageHandler rasterization at several
+// GSDs and thread counts, and writes points per second and peak memory as a keyword list.
+//
+// The cloud is the file given, opened through ossimPointCloudHandlerRegistry, or else a
+// synthetic cloud held in memory, so handler and layout changes can be compared on one input.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/base/ossimArgumentParser.h>
+#include <ossim/base/ossimApplicationUsage.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimGrect.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/init/ossimInit.h>
+#include <ossim/point_cloud/ossimGenericPointCloudHandler.h>
+#include <ossim/point_cloud/ossimPointCloudHandlerRegistry.h>
+#include <ossim/point_cloud/ossimPointCloudImageHandler.h>
+#include <OpenThreads/Thread>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+// Small LCG so every run with the same seed makes the same cloud and queries on every platform.
+static double nextRandom(ossim_uint64& state)
+{
+   state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+   return (double)(state >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Peak resident memory of the process so far in KB, 0 where not available.
+static ossim_uint64 peakMemoryKb()
+{
+#if defined(_WIN32)
+   return 0;
+#else
+   struct rusage usage;
+   if (getrusage(RUSAGE_SELF, &usage) != 0)
+   {
+      return 0;
+   }
+#if defined(__APPLE__)
+   return (ossim_uint64)usage.ru_maxrss / 1024; // bytes on macOS
+#else
+   return (ossim_uint64)usage.ru_maxrss;
+#endif
+#endif
+}
+
+static void parseList(const ossimString& s, std::vector<double>& values)
+{
+   std::vector<ossimString> splitArray;
+   s.split(splitArray, ",");
+   values.clear();
+   for (ossim_uint32 i = 0; i < splitArray.size(); ++i)
+   {
+      double v = splitArray[i].toDouble();
+      if (v > 0.0) values.push_back(v);
+   }
+}
+
+// Rasterizes every threads'th tile of the list, starting at its own index.
+class RasterThread : public OpenThreads::Thread
+{
+public:
+   RasterThread(ossimPointCloudImageHandler* handler,
+                const std::vector<ossimIrect>& tiles,
+                ossim_uint32 first,
+                ossim_uint32 stride)
+      : m_handler(handler),
+        m_tiles(tiles),
+        m_first(first),
+        m_stride(stride),
+        m_pixels(0)
+   {
+   }
+
+   virtual void run()
+   {
+      for (ossim_uint32 i = m_first; i < m_tiles.size(); i += m_stride)
+      {
+         ossimRefPtr<ossimImageData> tile = m_handler->getTile(m_tiles[i], 0);
+         if (tile.valid())
+         {
+            m_pixels += (ossim_uint64)tile->getWidth() * tile->getHeight();
+         }
+      }
+   }
+
+   ossimPointCloudImageHandler*   m_handler;
+   const std::vector<ossimIrect>& m_tiles;
+   ossim_uint32                   m_first;
+   ossim_uint32                   m_stride;
+   ossim_uint64                   m_pixels;
+};
+
+int main(int argc, char* argv[])
+{
+   ossimString tempString;
+   ossimArgumentParser::ossimParameter stringParam(tempString);
+   ossimArgumentParser argumentParser(&argc, argv);
+   ossimInit::instance()->addOptions(argumentParser);
+   ossimInit::instance()->initialize(argumentParser);
+
+   std::vector<double> threadCounts;
+   std::vector<double> querySizes;
+   std::vector<double> gsdFactors;
+   ossim_uint32 syntheticPoints = 4000000;
+   ossim_uint32 queries = 100;
+   ossim_uint32 maxTiles = 64;
+   ossim_uint32 blockSize = 0x100000;
+   ossim_uint32 seed = 0;
+   ossimFilename outputFile;
+
+   ossimApplicationUsage* au = argumentParser.getApplicationUsage();
+   au->setCommandLineUsage(argumentParser.getApplicationName() + " [options] [<point-cloud-file>]");
+   au->setDescription("Measures point cloud scan, query and rasterization throughput of the file given, or of a synthetic cloud.");
+   au->addCommandLineOption("-h or --help", "Display this information");
+   au->addCommandLineOption("--synthetic", "<int> Points of the synthetic cloud used when no file is given, default 4000000");
+   au->addCommandLineOption("--block-size", "<int> Points per getFileBlock() of the full scans, default 1048576");
+   au->addCommandLineOption("--query-sizes", "<list> Comma separated query box sizes as fractions of the cloud's width and height, default 0.01,0.05,0.2");
+   au->addCommandLineOption("--queries", "<int> Bounded queries per size, default 100");
+   au->addCommandLineOption("--gsd-factors", "<list> Comma separated multiples of the nominal GSD to rasterize at, default 1,4,16");
+   au->addCommandLineOption("--threads", "<list> Comma separated rasterization thread counts, default 1,2,4,8");
+   au->addCommandLineOption("--max-tiles", "<int> Most tiles rasterized per run, default 64");
+   au->addCommandLineOption("--random-seed", "<int> Seed for the synthetic cloud and the queries, default 0");
+   au->addCommandLineOption("--output", "<file> Write the report to <file> instead of standard output");
+
+   if (argumentParser.read("-h") || argumentParser.read("--help"))
+   {
+      au->write(ossimNotify(ossimNotifyLevel_INFO));
+      return 0;
+   }
+   if (argumentParser.read("--synthetic", stringParam))
+   {
+      syntheticPoints = std::max((ossim_uint32)1, tempString.toUInt32());
+   }
+   if (argumentParser.read("--block-size", stringParam))
+   {
+      blockSize = std::max((ossim_uint32)1, tempString.toUInt32());
+   }
+   if (argumentParser.read("--query-sizes", stringParam))
+   {
+      parseList(tempString, querySizes);
+   }
+   if (argumentParser.read("--queries", stringParam))
+   {
+      queries = tempString.toUInt32();
+   }
+   if (argumentParser.read("--gsd-factors", stringParam))
+   {
+      parseList(tempString, gsdFactors);
+   }
+   if (argumentParser.read("--threads", stringParam))
+   {
+      parseList(tempString, threadCounts);
+   }
+   if (argumentParser.read("--max-tiles", stringParam))
+   {
+      maxTiles = std::max((ossim_uint32)1, tempString.toUInt32());
+   }
+   if (argumentParser.read("--random-seed", stringParam))
+   {
+      seed = tempString.toUInt32();
+   }
+   if (argumentParser.read("--output", stringParam))
+   {
+      outputFile = tempString;
+   }
+
+   if (querySizes.empty())
+   {
+      querySizes.push_back(0.01);
+      querySizes.push_back(0.05);
+      querySizes.push_back(0.2);
+   }
+   if (gsdFactors.empty())
+   {
+      gsdFactors.push_back(1.0);
+      gsdFactors.push_back(4.0);
+      gsdFactors.push_back(16.0);
+   }
+   if (threadCounts.empty())
+   {
+      threadCounts.push_back(1);
+      threadCounts.push_back(2);
+      threadCounts.push_back(4);
+      threadCounts.push_back(8);
+   }
+
+   ossimTimer* timer = ossimTimer::instance();
+   ossimKeywordlist kwl;
+   ossimRefPtr<ossimPointCloudHandler> pch;
+   ossimTimer::Timer_t t0 = timer->tick();
+   if (argumentParser.argc() > 1)
+   {
+      ossimFilename pcFile = argumentParser[1];
+      pch = ossimPointCloudHandlerRegistry::instance()->open(pcFile);
+      if (!pch.valid())
+      {
+         ossimNotify(ossimNotifyLevel_WARN) << "Could not open point cloud " << pcFile << std::endl;
+         return 1;
+      }
+      kwl.add("benchmark.", "input", pcFile.c_str(), true);
+   }
+   else
+   {
+      // Gently rolling terrain over a 0.1 degree square:
+      ossim_uint64 state = (ossim_uint64)seed * 0x9E3779B97F4A7C15ULL + 1;
+      std::vector<ossimGpt> gpts(syntheticPoints);
+      for (ossim_uint32 i = 0; i < syntheticPoints; ++i)
+      {
+         double lat = 38.0 + 0.1 * nextRandom(state);
+         double lon = -105.0 + 0.1 * nextRandom(state);
+         gpts[i] = ossimGpt(lat, lon, 1500.0 + 50.0 * nextRandom(state));
+      }
+      pch = new ossimGenericPointCloudHandler(gpts);
+      kwl.add("benchmark.", "input", "synthetic", true);
+   }
+   kwl.add("benchmark.", "points", pch->getNumPoints(), true);
+   kwl.add("benchmark.", "open_seconds", timer->delta_s(t0, timer->tick()), true);
+   kwl.add("benchmark.", "open_peak_memory_kb", peakMemoryKb(), true);
+
+   // Full scans, column blocks as the handlers fill them and ossimPointRecord blocks:
+   for (ossim_uint32 pass = 0; pass < 2; ++pass)
+   {
+      const char* prefix = pass ? "benchmark.scan_records." : "benchmark.scan_columns.";
+      ossimPointColumnBlock columns(pch->getFieldCode());
+      ossimPointBlock records;
+      records.setFieldCode(pch->getFieldCode());
+      ossim_uint64 count = 0;
+      t0 = timer->tick();
+      for (ossim_uint32 offset = 0; offset < pch->getNumPoints(); offset += blockSize)
+      {
+         ossim_uint32 n = 0;
+         if (pass)
+         {
+            pch->getFileBlock(offset, records, blockSize);
+            n = records.size();
+         }
+         else
+         {
+            pch->getFileBlock(offset, columns, blockSize);
+            n = columns.size();
+         }
+         if (n == 0) break;
+         count += n;
+      }
+      double seconds = timer->delta_s(t0, timer->tick());
+      kwl.add(prefix, "points", count, true);
+      kwl.add(prefix, "seconds", seconds, true);
+      kwl.add(prefix, "points_per_second", (seconds > 0.0) ? (count / seconds) : 0.0, true);
+      kwl.add(prefix, "peak_memory_kb", peakMemoryKb(), true);
+   }
+
+   // Bounded queries; the first one also builds or loads the spatial index, timed apart:
+   ossimGrect bounds;
+   pch->getBounds(bounds);
+   const double minLat = bounds.ll().lat;
+   const double minLon = bounds.ll().lon;
+   const double dLat = bounds.ur().lat - minLat;
+   const double dLon = bounds.ur().lon - minLon;
+   t0 = timer->tick();
+   pch->getSpatialIndex();
+   kwl.add("benchmark.", "index_seconds", timer->delta_s(t0, timer->tick()), true);
+
+   for (ossim_uint32 s = 0; s < querySizes.size(); ++s)
+   {
+      const double size = std::min(1.0, querySizes[s]);
+      ossim_uint64 state = (ossim_uint64)seed * 0x9E3779B97F4A7C15ULL + s + 2;
+      ossimPointColumnBlock block;
+      ossim_uint64 count = 0;
+      t0 = timer->tick();
+      for (ossim_uint32 q = 0; q < queries; ++q)
+      {
+         double lat = minLat + nextRandom(state) * dLat * (1.0 - size);
+         double lon = minLon + nextRandom(state) * dLon * (1.0 - size);
+         ossimGrect box(ossimGpt(lat + size * dLat, lon, ossim::nan()),
+                        ossimGpt(lat, lon + size * dLon, ossim::nan()));
+         pch->getBlock(box, block);
+         count += block.size();
+      }
+      double seconds = timer->delta_s(t0, timer->tick());
+      std::string prefix = "benchmark.query_" + ossimString::toString(size).string() + ".";
+      kwl.add(prefix.c_str(), "queries", queries, true);
+      kwl.add(prefix.c_str(), "points", count, true);
+      kwl.add(prefix.c_str(), "seconds", seconds, true);
+      kwl.add(prefix.c_str(), "queries_per_second", (seconds > 0.0) ? (queries / seconds) : 0.0, true);
+      kwl.add(prefix.c_str(), "points_per_second", (seconds > 0.0) ? (count / seconds) : 0.0, true);
+      kwl.add(prefix.c_str(), "peak_memory_kb", peakMemoryKb(), true);
+   }
+
+   // Rasterization: setGSD() drops the tile cache, so every run rasterizes its tiles afresh.
+   ossimRefPtr<ossimPointCloudImageHandler> pcih = new ossimPointCloudImageHandler;
+   if (!pcih->setPointCloudHandler(pch.get()))
+   {
+      ossimNotify(ossimNotifyLevel_WARN) << "Could not rasterize the point cloud." << std::endl;
+      return 1;
+   }
+   ossimDpt nominalGsd;
+   pcih->getGSD(nominalGsd, 0);
+   kwl.add("benchmark.", "nominal_gsd", nominalGsd.x, true);
+
+   for (ossim_uint32 g = 0; g < gsdFactors.size(); ++g)
+   {
+      const double gsd = nominalGsd.x * gsdFactors[g];
+      for (ossim_uint32 t = 0; t < threadCounts.size(); ++t)
+      {
+         ossim_uint32 threads = std::max((ossim_uint32)1, (ossim_uint32)threadCounts[t]);
+         pcih->setGSD(gsd);
+
+         std::vector<ossimIrect> tiles;
+         const ossim_uint32 tw = pcih->getTileWidth();
+         const ossim_uint32 th = pcih->getTileHeight();
+         const ossim_uint32 samples = pcih->getNumberOfSamples(0);
+         const ossim_uint32 lines = pcih->getNumberOfLines(0);
+         for (ossim_uint32 y = 0; (y < lines) && (tiles.size() < maxTiles); y += th)
+         {
+            for (ossim_uint32 x = 0; (x < samples) && (tiles.size() < maxTiles); x += tw)
+            {
+               tiles.push_back(ossimIrect(x, y, x + tw - 1, y + th - 1));
+            }
+         }
+
+         std::vector<RasterThread*> threadList;
+         t0 = timer->tick();
+         for (ossim_uint32 idx = 1; idx < threads; ++idx)
+         {
+            threadList.push_back(new RasterThread(pcih.get(), tiles, idx, threads));
+            threadList.back()->start();
+         }
+         RasterThread mainPart(pcih.get(), tiles, 0, threads);
+         mainPart.run();
+         ossim_uint64 pixels = mainPart.m_pixels;
+         for (ossim_uint32 idx = 0; idx < threadList.size(); ++idx)
+         {
+            threadList[idx]->join();
+            pixels += threadList[idx]->m_pixels;
+            delete threadList[idx];
+         }
+         double seconds = timer->delta_s(t0, timer->tick());
+
+         std::string prefix = "benchmark.raster_gsd" + ossimString::toString(gsdFactors[g]).string() +
+            ".threads" + ossimString::toString(threads).string() + ".";
+         kwl.add(prefix.c_str(), "gsd", gsd, true);
+         kwl.add(prefix.c_str(), "tiles", (ossim_uint32)tiles.size(), true);
+         kwl.add(prefix.c_str(), "seconds", seconds, true);
+         kwl.add(prefix.c_str(), "tiles_per_second", (seconds > 0.0) ? (tiles.size() / seconds) : 0.0, true);
+         kwl.add(prefix.c_str(), "megapixels_per_second", (seconds > 0.0) ? (pixels / seconds * 1e-6) : 0.0, true);
+         kwl.add(prefix.c_str(), "peak_memory_kb", peakMemoryKb(), true);
+      }
+   }
+
+   if (outputFile.size())
+   {
+      if (!kwl.write(outputFile.c_str()))
+      {
+         ossimNotify(ossimNotifyLevel_WARN) << "Could not write " << outputFile << std::endl;
+         return 1;
+      }
+   }
+   else
+   {
+      std::cout << kwl << std::endl;
+   }
+   return 0;
+}
@@ -0,0 +1,164 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  LGPL -- See LICENSE.txt file in the top level directory for more details.
+//
+// Description: Checks ossimPointColumnBlock against the ossimPointRecord blocks it adapts to, and
+// bounded queries through the point cloud spatial index and point filters.
+//
+//**************************************************************************************************
+// $Id$
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/point_cloud/ossimGenericPointCloudHandler.h>
+#include <ossim/point_cloud/ossimPointColumnBlock.h>
+#include <ossim/point_cloud/ossimPointFilter.h>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+   bool status = true;
+
+   // Fields round trip through the column block and its record adapter:
+   const ossim_uint32 CODE = ossimPointRecord::Intensity | ossimPointRecord::ReturnNumber |
+      ossimPointRecord::Red | ossimPointRecord::Green | ossimPointRecord::Blue;
+   ossimPointColumnBlock columns (CODE);
+   for (ossim_uint32 i=0; i<1000; ++i)
+   {
+      ossimPointRecord record (CODE);
+      record.setPointId(i + 1);
+      record.setPosition(ossimGpt(40.0 + i*1e-4, -105.0 - i*1e-4, i*0.5));
+      record.setField(ossimPointRecord::Intensity, i*0.25f);
+      record.setField(ossimPointRecord::ReturnNumber, (ossim_float32)(i % 4 + 1));
+      record.setField(ossimPointRecord::Red, 1.0f);
+      record.setField(ossimPointRecord::Green, 0.5f);
+      record.setField(ossimPointRecord::Blue, 0.0f);
+      columns.addPoint(record);
+   }
+   ossimPointBlock records;
+   columns.appendTo(records);
+   status &= (records.size() == columns.size());
+   for (ossim_uint32 i=0; status && (i<records.size()); ++i)
+   {
+      status &= (records[i]->getPointId() == i + 1);
+      status &= (records[i]->getPosition() == columns.getPosition(i));
+      status &= (records[i]->getField(ossimPointRecord::Intensity) == i*0.25f);
+      status &= (records[i]->getField(ossimPointRecord::ReturnNumber) == (i % 4 + 1));
+      status &= (columns.getByteField(ossimPointRecord::ReturnNumber)[i] == i % 4 + 1);
+      status &= records[i]->hasFields(CODE);
+   }
+   cout << "column block round trip " << (status ? "PASSED" : "FAILED") << endl;
+
+   // Handler blocks read both ways give the same points:
+   vector<ossimGpt> gpts;
+   for (ossim_uint32 i=0; i<2500; ++i)
+      gpts.push_back(ossimGpt(10.0 + (i%50)*0.01, 20.0 + (i/50)*0.01, i));
+   ossimRefPtr<ossimGenericPointCloudHandler> handler = new ossimGenericPointCloudHandler(gpts);
+
+   ossim_uint32 count = 0;
+   ossimPointColumnBlock column_block;
+   ossimPointBlock record_block;
+   for (ossim_uint32 offset=0; offset<gpts.size(); offset+=1024)
+   {
+      handler->getFileBlock(offset, column_block, 1024);
+      handler->getFileBlock(offset, record_block, 1024);
+      status &= (column_block.size() == record_block.size());
+      for (ossim_uint32 i=0; status && (i<column_block.size()); ++i)
+      {
+         status &= (column_block.getPosition(i) == gpts[offset + i]);
+         status &= (record_block[i]->getPosition() == gpts[offset + i]);
+      }
+      count += column_block.size();
+   }
+   status &= (count == gpts.size());
+
+   // getBlock() reads the chunks the spatial index lists for the bounds:
+   ossimGrect bounds (ossimGpt(10.205, 20.005, ossim::nan()),
+                      ossimGpt(10.095, 20.105, ossim::nan()));
+   ossim_uint32 inside = 0;
+   for (ossim_uint32 i=0; i<gpts.size(); ++i)
+      inside += bounds.pointWithin(gpts[i]);
+   handler->getBlock(bounds, record_block);
+   status &= (inside > 0) && (record_block.size() == inside);
+   status &= (handler->getSpatialIndex() != 0);
+
+   cout << "file blocks: " << count << " points " << (status ? "PASSED" : "FAILED") << endl;
+
+   // Filter chain narrows a selection: ground (class 2) last returns between heights 100 and 400.
+   columns.setFieldCode(CODE | ossimPointRecord::NumberOfReturns | ossimPointRecord::Classification);
+   columns.resize(1000);
+   for (ossim_uint32 i=0; i<columns.size(); ++i)
+   {
+      columns.setPosition(i, ossimGpt(40.0, -105.0, i*0.5));
+      columns.setField(i, ossimPointRecord::ReturnNumber, (ossim_float32)(i % 4 + 1));
+      columns.setField(i, ossimPointRecord::NumberOfReturns, 4.0f);
+      columns.setField(i, ossimPointRecord::Classification, (i % 3) ? 1.0f : 2.0f);
+   }
+   ossimRefPtr<ossimPointClassFilter> classFilter = new ossimPointClassFilter;
+   classFilter->addClass(2);
+   ossimRefPtr<ossimPointReturnFilter> returnFilter = new ossimPointReturnFilter;
+   returnFilter->setKeepLast(true);
+   ossimRefPtr<ossimPointFilterChain> chain = new ossimPointFilterChain;
+   chain->addFilter(classFilter.get());
+   chain->addFilter(returnFilter.get());
+   chain->addFilter(new ossimPointZRangeFilter(100.0, 400.0));
+   ossimPointFilter::Selection selection;
+   ossimPointFilter::selectAll(columns, selection);
+   chain->filter(columns, selection);
+   ossim_uint32 expected = 0;
+   for (ossim_uint32 i=0; i<columns.size(); ++i)
+      expected += ((i % 3) == 0) && ((i % 4) == 3) && (i >= 200) && (i <= 800);
+   status &= (selection.size() == expected);
+   ossimPointColumnBlock selected;
+   selected.append(columns, selection);
+   status &= (selected.size() == expected);
+   for (ossim_uint32 k=0; status && (k<selected.size()); ++k)
+      status &= (selected.getPosition(k) == columns.getPosition(selection[k]));
+
+   // The handler applies its filter to getBlock():
+   handler->setPointFilter(new ossimPointZRangeFilter(500.0, 1500.0));
+   inside = 0;
+   for (ossim_uint32 i=0; i<gpts.size(); ++i)
+      inside += bounds.pointWithin(gpts[i]) && (gpts[i].hgt >= 500.0) && (gpts[i].hgt <= 1500.0);
+   handler->getBlock(bounds, record_block);
+   status &= (inside > 0) && (record_block.size() == inside);
+
+   cout << "point filters: " << expected << " points " << (status ? "PASSED" : "FAILED") << endl;
+
+   // Text points parse the same from the file and from its binary sidecar:
+   ossimFilename textFile ("ossim-point-column-block-test.xyz");
+   ossimFilename sidecar = ossimGenericPointCloudHandler::getSidecarFile(textFile);
+   sidecar.remove();
+   {
+      ofstream out (textFile.c_str());
+      out << "// X Y Z I\n";
+      for (ossim_uint32 i=0; i<gpts.size(); ++i)
+         out << gpts[i].lon << ", " << gpts[i].lat << ", " << gpts[i].hgt << ", " << i % 256 << "\r\n";
+   }
+   for (ossim_uint32 pass=0; pass<2; ++pass)
+   {
+      ossimRefPtr<ossimGenericPointCloudHandler> text = new ossimGenericPointCloudHandler;
+      status &= text->open(textFile) && (text->getNumPoints() == gpts.size());
+      status &= (text->getFieldCode() == ossimPointRecord::Intensity);
+      status &= (pass == 0) || sidecar.exists();
+      column_block.setFieldCode(ossimPointRecord::Intensity);
+      text->getFileBlock(0, column_block);
+      for (ossim_uint32 i=0; status && (i<column_block.size()); ++i)
+      {
+         status &= (column_block.getPosition(i) == gpts[i]);
+         status &= (column_block.getField(i, ossimPointRecord::Intensity) == i % 256);
+      }
+   }
+   textFile.remove();
+   sidecar.remove();
+
+   cout << "text points " << (status ? "PASSED" : "FAILED") << endl;
+
+   return status ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+// Description: Compares the batch worldToLineSamples()/lineSampleToWorlds() of the common map
+// projections with the per point calls, at each SIMD level.
+//
+//**************************************************************************************************
+//  $Id$
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimGpt.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimSimd.h>
+#include <ossim/projection/ossimEquDistCylProjection.h>
+#include <ossim/projection/ossimGoogleProjection.h>
+#include <ossim/projection/ossimMercatorProjection.h>
+#include <ossim/projection/ossimTransMercatorProjection.h>
+#include <ossim/projection/ossimUtmProjection.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+static const ossim_uint32 COUNT = 1001; // Not a multiple of any vector width.
+
+static bool check(const char* name, ossimMapProjection* proj, const ossimGpt& ul, double extent)
+{
+   vector<ossimGpt> gpts(COUNT);
+   srand(1);
+   for (ossim_uint32 i = 0; i < COUNT; ++i)
+   {
+      gpts[i] = ossimGpt(ul.lat - extent * rand() / RAND_MAX,
+                         ul.lon + extent * rand() / RAND_MAX, 0.0);
+   }
+   gpts[3].makeNan();
+
+   vector<ossimDpt> ipts(COUNT);
+   vector<ossimGpt> worlds(COUNT);
+   for (ossim_uint32 i = 0; i < COUNT; ++i)
+   {
+      proj->worldToLineSample(gpts[i], ipts[i]);
+      proj->lineSampleToWorld(ipts[i], worlds[i]);
+   }
+
+   bool status = true;
+   const ossim::SimdLevel LEVELS[3] = { ossim::SIMD_SCALAR, ossim::SIMD_SSE2, ossim::SIMD_AVX2 };
+   for (int level = 0; level < 3; ++level)
+   {
+      ossim::setSimdLevel(LEVELS[level]);
+
+      vector<ossimDpt> batchIpts(COUNT);
+      vector<ossimGpt> batchWorlds(COUNT);
+      proj->worldToLineSamples(&gpts.front(), &batchIpts.front(), COUNT);
+      proj->lineSampleToWorlds(&ipts.front(), &batchWorlds.front(), COUNT);
+
+      double maxPixel = 0.0;
+      double maxDegree = 0.0;
+      bool nanMismatch = false;
+      for (ossim_uint32 i = 0; i < COUNT; ++i)
+      {
+         if ( ipts[i].hasNans() || worlds[i].isLatNan() )
+         {
+            nanMismatch |= !batchIpts[i].hasNans() || !batchWorlds[i].isLatNan();
+            continue;
+         }
+         maxPixel = std::max(maxPixel, std::fabs(batchIpts[i].x - ipts[i].x));
+         maxPixel = std::max(maxPixel, std::fabs(batchIpts[i].y - ipts[i].y));
+         maxDegree = std::max(maxDegree, std::fabs(batchWorlds[i].lat - worlds[i].lat));
+         maxDegree = std::max(maxDegree, std::fabs(batchWorlds[i].lon - worlds[i].lon));
+      }
+
+      const bool passed = (maxPixel < 1.0e-6) && (maxDegree < 1.0e-11) && !nanMismatch;
+      cout << name << " " << ossim::simdLevelString(ossim::getSimdLevel())
+           << " max pixel diff: " << maxPixel << " max degree diff: " << maxDegree
+           << (passed ? " PASSED" : " FAILED") << endl;
+      status &= passed;
+   }
+   ossim::setSimdLevel(ossim::getCpuSimdLevel());
+   return status;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   bool status = true;
+
+   ossimRefPtr<ossimUtmProjection> utm = new ossimUtmProjection(17);
+   ossimGpt ul(38.9, -81.0, 0.0);
+   utm->setUlTiePoints(ul);
+   utm->setMetersPerPixel(ossimDpt(0.5, 0.5));
+   status &= check("utm", utm.get(), ul, 0.5);
+
+   ossimRefPtr<ossimTransMercatorProjection> tm =
+      new ossimTransMercatorProjection(ossimEllipsoid(), ossimGpt(0.0, 9.0), 500000.0, 0.0, 0.9996);
+   ul = ossimGpt(48.0, 8.0, 0.0);
+   tm->setUlTiePoints(ul);
+   tm->setMetersPerPixel(ossimDpt(2.0, 2.0));
+   status &= check("tm", tm.get(), ul, 2.0);
+
+   ossimRefPtr<ossimMercatorProjection> merc = new ossimMercatorProjection();
+   ul = ossimGpt(60.0, -10.0, 0.0);
+   merc->setUlTiePoints(ul);
+   merc->setMetersPerPixel(ossimDpt(30.0, 30.0));
+   status &= check("mercator", merc.get(), ul, 20.0);
+
+   ossimRefPtr<ossimEquDistCylProjection> eqc = new ossimEquDistCylProjection();
+   ul = ossimGpt(38.0, -77.0, 0.0);
+   eqc->setUlTiePoints(ul);
+   eqc->setDecimalDegreesPerPixel(ossimDpt(0.0001, 0.0001));
+   status &= check("eqc", eqc.get(), ul, 1.0);
+
+   ossimRefPtr<ossimGoogleProjection> google = new ossimGoogleProjection();
+   ul = ossimGpt(50.0, 0.0, 0.0);
+   google->setUlTiePoints(ul);
+   google->setMetersPerPixel(ossimDpt(10.0, 10.0));
+   status &= check("google", google.get(), ul, 5.0);
+
+   return status ? 0 : 1;
+}
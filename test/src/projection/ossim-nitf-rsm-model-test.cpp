@@ -11,6 +11,7 @@
 #include <ossim/base/ossimGpt.h>
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimSimd.h>
 #include <ossim/imaging/ossimImageGeometry.h>
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/imaging/ossimImageHandlerRegistry.h>
@@ -24,6 +25,8 @@
 #include <ossim/support_data/ossimNitfRsmpiaTag.h>
 #include <ossim/support_data/ossimNitfTagFactoryRegistry.h>
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -38,6 +41,7 @@ static ossimRefPtr<ossimNitfRsmModel> getModelFromExtFile( const ossimFilename&
 static ossimRefPtr<ossimNitfRsmModel> getModelFromImage( const ossimFilename& file );
 static void testGpts( ossimRefPtr<ossimNitfRsmModel>& model, const ossimKeywordlist& kwl );
 static void testIpts( ossimRefPtr<ossimNitfRsmModel>& model, const ossimKeywordlist& kwl );
+static void testBatch( ossimRefPtr<ossimNitfRsmModel>& model, const ossimKeywordlist& kwl );
 
 int main(int argc, char *argv[])
 {
@@ -54,6 +58,7 @@ int main(int argc, char *argv[])
          {
             testGpts( model, kwl );
             testIpts( model, kwl );
+            testBatch( model, kwl );
          }
          else
          {
@@ -74,6 +79,9 @@ int main(int argc, char *argv[])
            << "\nmodel->worldToLineSample(...), model->lineSampleToWorld(...)"
            << "\nipts test:"
            << "\nmodel->lineSampleHeightToWorld(...), model->worldToLineSample(...)"
+           << "\nbatch test:"
+           << "\nmodel->worldToLineSamples(...), model->lineSampleToWorlds(...) against the"
+           << "\nper point calls at each simd level."
            << "\noptions.kwl format example:\n"
 
            << "\n// Input line, sample type: area=upper left corner, point = center of pixel."
@@ -465,3 +473,97 @@ void testIpts( ossimRefPtr<ossimNitfRsmModel>& model, const ossimKeywordlist& kw
    }
    
 } // End: testIpts
+
+void testBatch( ossimRefPtr<ossimNitfRsmModel>& model, const ossimKeywordlist& kwl )
+{
+   if ( model.valid() )
+   {
+      // The gtest world points and the image points they project to, plus the itest image points:
+      std::vector<ossimGpt> gpts;
+      std::vector<ossimDpt> ipts;
+      const ossim_uint32 GPTS = kwl.numberOf( "gtest_id" );
+      const ossim_uint32 IPTS = kwl.numberOf( "itest_id" );
+      for ( ossim_uint32 i = 0; i < std::max( GPTS, IPTS ) + 100; ++i )
+      {
+         std::string value = kwl.findKey( std::string("gtest_gpt") +
+                                          ossimString::toString( i ).string() );
+         if ( value.size() )
+         {
+            ossimGpt wpt;
+            ossimDpt ipt;
+            wpt.toPoint( value );
+            gpts.push_back( wpt );
+            model->worldToLineSample( wpt, ipt );
+            ipts.push_back( ipt );
+         }
+         value = kwl.findKey( std::string("itest_ipt") + ossimString::toString( i ).string() );
+         if ( value.size() )
+         {
+            ossimDpt ipt;
+            ipt.toPoint( value );
+            ipts.push_back( ipt );
+         }
+      }
+
+      cout << "\nbatch test begin ********************************\n\n"
+           << "number_of_world_points: " << gpts.size() << "\n"
+           << "number_of_line_sample_points: " << ipts.size() << "\n";
+
+      std::vector<ossimDpt> scalarIpts( gpts.size() );
+      for ( ossim_uint32 i = 0; i < gpts.size(); ++i )
+      {
+         model->worldToLineSample( gpts[i], scalarIpts[i] );
+      }
+      std::vector<ossimGpt> scalarGpts( ipts.size() );
+      for ( ossim_uint32 i = 0; i < ipts.size(); ++i )
+      {
+         model->lineSampleToWorld( ipts[i], scalarGpts[i] );
+      }
+
+      const ossim::SimdLevel LEVELS[3] = { ossim::SIMD_SCALAR, ossim::SIMD_SSE2, ossim::SIMD_AVX2 };
+      for ( int level = 0; level < 3; ++level )
+      {
+         ossim::setSimdLevel( LEVELS[level] );
+
+         double maxPixel = 0.0;
+         if ( gpts.size() )
+         {
+            std::vector<ossimDpt> batchIpts( gpts.size() );
+            model->worldToLineSamples( &gpts.front(), &batchIpts.front(),
+                                       (ossim_uint32)gpts.size() );
+            for ( ossim_uint32 i = 0; i < gpts.size(); ++i )
+            {
+               if ( !scalarIpts[i].hasNans() )
+               {
+                  maxPixel = std::max( maxPixel, (batchIpts[i] - scalarIpts[i]).length() );
+               }
+            }
+         }
+
+         double maxDegree = 0.0;
+         if ( ipts.size() )
+         {
+            std::vector<ossimGpt> batchGpts( ipts.size() );
+            model->lineSampleToWorlds( &ipts.front(), &batchGpts.front(),
+                                       (ossim_uint32)ipts.size() );
+            for ( ossim_uint32 i = 0; i < ipts.size(); ++i )
+            {
+               if ( !scalarGpts[i].hasNans() )
+               {
+                  maxDegree = std::max( maxDegree, std::fabs(batchGpts[i].lat - scalarGpts[i].lat) );
+                  maxDegree = std::max( maxDegree, std::fabs(batchGpts[i].lon - scalarGpts[i].lon) );
+               }
+            }
+         }
+
+         cout << "batch_" << ossim::simdLevelString( ossim::getSimdLevel() )
+              << "_max_pixel_delta:  " << maxPixel << "\n"
+              << "batch_" << ossim::simdLevelString( ossim::getSimdLevel() )
+              << "_max_degree_delta: " << maxDegree << "\n";
+      }
+      ossim::setSimdLevel( ossim::getCpuSimdLevel() );
+
+      cout << "\nbatch test end **********************************\n\n";
+   }
+   
+} // End: testBatch